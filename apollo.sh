@@ -85,6 +85,17 @@ function check_esd_files() {
   fi
 }
 
+function check_tensorrt_files() {
+  INFERENCE="caffe"
+
+  if [ -f /usr/include/x86_64-linux-gnu/NvInfer.h \
+      -a -f /usr/include/x86_64-linux-gnu/NvCaffeParser.h ] \
+      || [ -f /usr/include/aarch64-linux-gnu/NvInfer.h \
+      -a -f /usr/include/aarch64-linux-gnu/NvCaffeParser.h ]; then
+      INFERENCE="tensorrt"
+  fi
+}
+
 function generate_build_targets() {
   if [ -z $NOT_BUILD_PERCEPTION ] ; then
     BUILD_TARGETS=`bazel query //...`
@@ -390,6 +401,24 @@ function citest() {
   fi
 }
 
+function run_benchmark() {
+  START_TIME=$(get_now)
+
+  # The results are written in the JSON format of Google Benchmark, to be
+  # compared between revisions, e.g. with compare.py of Google Benchmark.
+  local BENCHMARK_DIR="${APOLLO_ROOT_DIR}/data/benchmark"
+  mkdir -p "${BENCHMARK_DIR}"
+  bazel run $DEFINES -c opt //modules/common/math:math_benchmark -- \
+    --benchmark_out="${BENCHMARK_DIR}/math_benchmark.json" $@
+  if [ $? -eq 0 ]; then
+    success "Benchmark results in ${BENCHMARK_DIR}/math_benchmark.json"
+    return 0
+  else
+    fail 'Benchmark failed!'
+    return 1
+  fi
+}
+
 function run_cpp_lint() {
   generate_build_targets
   echo "$BUILD_TARGETS" | xargs bazel test --config=cpplint -c dbg
@@ -574,6 +603,7 @@ function print_usage() {
   ${BLUE}build_fe${NONE}: compile frontend javascript code, this requires all the node_modules to be installed already
   ${BLUE}build_no_perception [dbg|opt]${NONE}: run build build skip building perception module, useful when some perception dependencies are not satisified, e.g., CUDA, CUDNN, LIDAR, etc.
   ${BLUE}build_prof${NONE}: build for gprof support.
+  ${BLUE}benchmark${NONE}: run the math benchmarks and write the results in data/benchmark
   ${BLUE}buildify${NONE}: fix style of BUILD files
   ${BLUE}check${NONE}: run build/lint/test, please make sure it passes before checking in new code
   ${BLUE}clean${NONE}: run Bazel clean
@@ -593,6 +623,7 @@ function main() {
   apollo_check_system_config
   check_machine_arch
   check_esd_files
+  check_tensorrt_files
 
   DEFINES="--define ARCH=${MACHINE_ARCH} --define CAN_CARD=${CAN_CARD} --cxxopt=-DUSE_ESD_CAN=${USE_ESD_CAN}"
 
@@ -636,11 +667,11 @@ function main() {
       apollo_build_opt $@
       ;;
     build_gpu)
-      DEFINES="${DEFINES} --cxxopt=-DUSE_CAFFE_GPU"
+      DEFINES="${DEFINES} --cxxopt=-DUSE_CAFFE_GPU --define INFERENCE=${INFERENCE}"
       apollo_build_dbg $@
       ;;
     build_opt_gpu)
-      DEFINES="${DEFINES} --cxxopt=-DUSE_CAFFE_GPU"
+      DEFINES="${DEFINES} --cxxopt=-DUSE_CAFFE_GPU --define INFERENCE=${INFERENCE}"
       apollo_build_opt $@
       ;;
     build_fe)
@@ -678,8 +709,12 @@ function main() {
       DEFINES="${DEFINES} --cxxopt=-DCPU_ONLY"
       citest $@
       ;;
+    benchmark)
+      DEFINES="${DEFINES} --cxxopt=-DCPU_ONLY"
+      run_benchmark $@
+      ;;
     test_gpu)
-      DEFINES="${DEFINES} --cxxopt=-DUSE_CAFFE_GPU"
+      DEFINES="${DEFINES} --cxxopt=-DUSE_CAFFE_GPU --define INFERENCE=${INFERENCE}"
       USE_GPU="1"
       run_test $@
       ;;
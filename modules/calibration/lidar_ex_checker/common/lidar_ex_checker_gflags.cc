@@ -23,6 +23,14 @@ DEFINE_int32(capture_cloud_count, 3, "the number of cloud count to capture");
 
 DEFINE_double(capture_distance, 15.0, "the distance between two clouds");
 
+DEFINE_double(accumulation_voxel_size, 0.1,
+              "meters, the size of the voxels the clouds are accumulated in, "
+              "each keeping the centroid of its points");
+
+DEFINE_int32(max_accumulated_voxels, 2000000,
+             "the maximum number of voxels the clouds are accumulated in, "
+             "beyond which the points in new voxels are dropped");
+
 DEFINE_string(adapter_config_filename,
               "/apollo/modules/calibration/lidar_ex_checker/conf/adapter.conf",
               "The adapter config file");
@@ -25,6 +25,10 @@ DECLARE_string(node_name);
 DECLARE_int32(capture_cloud_count);
 // the distance between two clouds
 DECLARE_double(capture_distance);
+// the size of the voxels the clouds are accumulated in
+DECLARE_double(accumulation_voxel_size);
+// the maximum number of voxels the clouds are accumulated in
+DECLARE_int32(max_accumulated_voxels);
 
 DECLARE_string(adapter_config_filename);
 
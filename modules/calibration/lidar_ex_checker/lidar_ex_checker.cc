@@ -14,6 +14,10 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "eigen_conversions/eigen_msg.h"
 #include "pcl/io/pcd_io.h"
 #include "pcl/visualization/cloud_viewer.h"
@@ -34,6 +38,29 @@ using apollo::common::adapter::AdapterManager;
 using apollo::common::Status;
 using apollo::common::ErrorCode;
 
+namespace {
+
+// the voxel indices are packed in 21 bits each
+constexpr int64_t kVoxelIndexOffset = 1 << 20;
+
+bool GetVoxelKey(const Eigen::Vector3f& point, const float inv_voxel_size,
+                 int64_t* key) {
+  int64_t packed = 0;
+  for (int i = 0; i < 3; ++i) {
+    const int64_t index =
+        static_cast<int64_t>(std::floor(point[i] * inv_voxel_size)) +
+        kVoxelIndexOffset;
+    if (index < 0 || index >= 2 * kVoxelIndexOffset) {
+      return false;
+    }
+    packed = (packed << 21) | index;
+  }
+  *key = packed;
+  return true;
+}
+
+}  // namespace
+
 std::string LidarExChecker::Name() const { return "lidar_extrinsics_checker"; }
 
 Status LidarExChecker::Init() {
@@ -46,6 +73,10 @@ Status LidarExChecker::Init() {
   cloud_count_ = FLAGS_capture_cloud_count;
   capture_distance_ = FLAGS_capture_distance;
 
+  captured_cloud_count_ = 0;
+  has_extrinsics_ = false;
+  voxels_.clear();
+
   position_type_ = 0;
 
   AdapterManager::Init(FLAGS_adapter_config_filename);
@@ -81,42 +112,127 @@ bool LidarExChecker::GetExtrinsics() {
 }
 
 void LidarExChecker::VisualizeClouds() {
-  if (!GetExtrinsics()) {
+  AccumulateClouds();
+  if (!has_extrinsics_) {
     return;
   }
 
+  // a cloud for the voxels of every captured cloud, to color them apart
+  std::map<uint32_t, pcl::PointCloud<pcl::PointXYZ>::Ptr> tf_clds;
+  for (const auto& key_voxel : voxels_) {
+    const Voxel& voxel = key_voxel.second;
+    auto& tf_cld_ptr = tf_clds[voxel.seed];
+    if (tf_cld_ptr == nullptr) {
+      tf_cld_ptr.reset(new pcl::PointCloud<pcl::PointXYZ>);
+    }
+    pcl::PointXYZ tf_pt;
+    tf_pt.x = voxel.x / voxel.count;
+    tf_pt.y = voxel.y / voxel.count;
+    tf_pt.z = voxel.z / voxel.count;
+    tf_cld_ptr->points.push_back(tf_pt);
+  }
+  AINFO << "Visualize " << voxels_.size() << " voxels of "
+        << captured_cloud_count_ << " clouds.";
+
   boost::shared_ptr<pcl::visualization::PCLVisualizer> pcl_vis;
   pcl_vis.reset(new pcl::visualization::PCLVisualizer("3D Viewer"));
-  for (uint32_t i = 0; i < clouds_.size(); ++i) {
-    pcl::PointCloud<PointXYZIT> cld = clouds_[i];
-    pcl::PointCloud<pcl::PointXYZ>::Ptr tf_cld_ptr(
-        new pcl::PointCloud<pcl::PointXYZ>);
-    double timestamp = cld.points.back().timestamp;
-    timestamp = round(timestamp * 100) / 100.0;
-    Eigen::Affine3d pose = gps_poses_[timestamp];
-
-    for (uint32_t j = 0; j < cld.points.size(); ++j) {
-      PointXYZIT pt = cld.points[j];
-      Eigen::Vector3d pt_vec(pt.x, pt.y, pt.z);
-      Eigen::Vector3d tf_pt_vec = pose * extrinsics_ * pt_vec;
-
-      pcl::PointXYZ tf_pt;
-      tf_pt.x = tf_pt_vec[0];
-      tf_pt.y = tf_pt_vec[1];
-      tf_pt.z = tf_pt_vec[2];
-      tf_cld_ptr->points.push_back(tf_pt);
-    }
-    uint32_t seed = static_cast<uint32_t>(timestamp);
+  for (const auto& seed_cld : tf_clds) {
+    uint32_t seed = seed_cld.first;
     int r = rand_r(&seed) % 255;
     int g = rand_r(&seed) % 255;
     int b = rand_r(&seed) % 255;
     pcl::visualization::PointCloudColorHandlerCustom<pcl::PointXYZ> handler(
-        tf_cld_ptr, r, g, b);
-    pcl_vis->addPointCloud(tf_cld_ptr, handler, "clouds" + i);
+        seed_cld.second, r, g, b);
+    pcl_vis->addPointCloud(seed_cld.second, handler,
+                           "clouds" + std::to_string(seed_cld.first));
   }
   pcl_vis->spin();
 }
 
+void LidarExChecker::AccumulateClouds() {
+  while (!pending_clouds_.empty()) {
+    const PendingCloud& pending_cloud = pending_clouds_.front();
+    const auto pose_iter = gps_poses_.find(pending_cloud.timestamp);
+    if (pose_iter == gps_poses_.end()) {
+      // the poses come in order, so a pose still missing after a later one
+      // won't come
+      if (gps_poses_.empty() ||
+          gps_poses_.rbegin()->first < pending_cloud.timestamp + 1.0) {
+        break;
+      }
+      AWARN << "Drop the cloud at " << pending_cloud.timestamp
+            << " without a pose.";
+      pending_clouds_.pop_front();
+      continue;
+    }
+    if (!has_extrinsics_) {
+      if (!GetExtrinsics()) {
+        return;
+      }
+      has_extrinsics_ = true;
+    }
+    AccumulateCloud(pending_cloud.cloud, pose_iter->second,
+                    static_cast<uint32_t>(pending_cloud.timestamp));
+    pending_clouds_.pop_front();
+  }
+
+  // only the poses for the clouds to come are kept
+  if (!gps_poses_.empty()) {
+    double oldest_timestamp = gps_poses_.rbegin()->first;
+    if (!pending_clouds_.empty()) {
+      oldest_timestamp =
+          std::min(oldest_timestamp, pending_clouds_.front().timestamp);
+    }
+    gps_poses_.erase(gps_poses_.begin(),
+                     gps_poses_.lower_bound(oldest_timestamp - 1.0));
+  }
+}
+
+void LidarExChecker::AccumulateCloud(const pcl::PointCloud<PointXYZIT>& cloud,
+                                     const Eigen::Affine3d& pose,
+                                     const uint32_t seed) {
+  CHECK_GT(FLAGS_accumulation_voxel_size, 0.0);
+  const float inv_voxel_size =
+      static_cast<float>(1.0 / FLAGS_accumulation_voxel_size);
+  const size_t max_voxel_count =
+      static_cast<size_t>(std::max(FLAGS_max_accumulated_voxels, 0));
+  // the points are transformed and binned in the same pass
+  const Eigen::Affine3f transform = (pose * extrinsics_).cast<float>();
+  uint32_t dropped_count = 0;
+  for (const auto& pt : cloud.points) {
+    if (!pcl_isfinite(pt.x)) {
+      continue;
+    }
+    const Eigen::Vector3f tf_pt = transform * Eigen::Vector3f(pt.x, pt.y, pt.z);
+    int64_t key = 0;
+    if (!GetVoxelKey(tf_pt, inv_voxel_size, &key)) {
+      ++dropped_count;
+      continue;
+    }
+    auto voxel_iter = voxels_.find(key);
+    if (voxel_iter == voxels_.end()) {
+      if (voxels_.size() >= max_voxel_count) {
+        ++dropped_count;
+        continue;
+      }
+      voxel_iter = voxels_.emplace(key, Voxel()).first;
+      voxel_iter->second.seed = seed;
+    }
+    Voxel& voxel = voxel_iter->second;
+    voxel.x += tf_pt.x();
+    voxel.y += tf_pt.y();
+    voxel.z += tf_pt.z();
+    ++voxel.count;
+  }
+  AINFO << "Accumulated a cloud of " << cloud.points.size() << " points into "
+        << voxels_.size() << " voxels.";
+  if (dropped_count > 0) {
+    AWARN << "Dropped " << dropped_count
+          << " points out of the voxel grid, which is bounded by "
+          << "--max_accumulated_voxels.";
+  }
+}
+
 void LidarExChecker::OnPointCloud(const sensor_msgs::PointCloud2& message) {
   if (top_redundant_cloud_count_ < 50) {
     top_redundant_cloud_count_++;
@@ -144,28 +260,33 @@ void LidarExChecker::OnPointCloud(const sensor_msgs::PointCloud2& message) {
     return;
   }
 
-  pcl::PointCloud<PointXYZIT> cld;
-  pcl::fromROSMsg(message, cld);
-
-  pcl::PointCloud<PointXYZIT> tmp_cld;
-  tmp_cld.header = cld.header;
-  for (uint32_t i = 0; i < cld.points.size(); ++i) {
-    if (pcl_isfinite(cld.points[i].x)) {
-      tmp_cld.push_back(cld.points[i]);
+  PendingCloud pending_cloud;
+  pcl::fromROSMsg(message, pending_cloud.cloud);
+  // the cloud is stamped by its last valid point
+  pending_cloud.timestamp = std::numeric_limits<double>::quiet_NaN();
+  const auto& points = pending_cloud.cloud.points;
+  for (auto iter = points.rbegin(); iter != points.rend(); ++iter) {
+    if (pcl_isfinite(iter->x)) {
+      pending_cloud.timestamp = round(iter->timestamp * 100) / 100.0;
+      break;
     }
   }
-  cld = tmp_cld;
+  if (std::isnan(pending_cloud.timestamp)) {
+    return;
+  }
 
-  if (clouds_.size() < cloud_count_) {
+  if (captured_cloud_count_ < cloud_count_) {
     last_position_ = position;
-    clouds_.push_back(cld);
+    pending_clouds_.push_back(std::move(pending_cloud));
+    ++captured_cloud_count_;
   }
 
-  if (clouds_.size() >= cloud_count_) {
+  if (captured_cloud_count_ >= cloud_count_) {
     enough_data_ = true;
   } else {
     enough_data_ = false;
   }
+  AccumulateClouds();
 }
 
 void LidarExChecker::OnGps(const localization::Gps& message) {
@@ -192,6 +313,7 @@ void LidarExChecker::OnGps(const localization::Gps& message) {
     timestamp = round(timestamp * 100) / 100.0;
 
     gps_poses_.insert(std::make_pair(timestamp, new_pose));
+    AccumulateClouds();
   }
 }
 
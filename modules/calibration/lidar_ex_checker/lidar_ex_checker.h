@@ -21,8 +21,11 @@
 #ifndef MODEULES_CALIBRATION_LIDAR_EX_CHECKER_H_
 #define MODEULES_CALIBRATION_LIDAR_EX_CHECKER_H_
 
+#include <cstdint>
+#include <deque>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
@@ -57,6 +60,11 @@ class LidarExChecker : public apollo::common::ApolloApp {
   bool GetExtrinsics();
   // visualize the checking result
   void VisualizeClouds();
+  // accumulate the captured clouds whose poses are received
+  void AccumulateClouds();
+  // transform a cloud by its pose and add its points to the voxels
+  void AccumulateCloud(const pcl::PointCloud<PointXYZIT>& cloud,
+                       const Eigen::Affine3d& pose, uint32_t seed);
 
   // Upon receiving point cloud data
   void OnPointCloud(const sensor_msgs::PointCloud2& message);
@@ -71,10 +79,30 @@ class LidarExChecker : public apollo::common::ApolloApp {
   Eigen::Affine3d offset_;
   Eigen::Affine3d extrinsics_;
 
-  // the complete pose data;
+  // the pose data, kept until the clouds captured before are accumulated
   std::map<double, Eigen::Affine3d> gps_poses_;
-  // the complete cloud data;
-  std::vector<pcl::PointCloud<PointXYZIT>> clouds_;
+
+  // a captured cloud waiting for the pose of its timestamp
+  struct PendingCloud {
+    double timestamp;
+    pcl::PointCloud<PointXYZIT> cloud;
+  };
+  std::deque<PendingCloud> pending_clouds_;
+  // the number of clouds captured
+  uint32_t captured_cloud_count_ = 0;
+
+  // the clouds are accumulated as they come in a bounded grid of voxels,
+  // each keeping the centroid of its points and the color seed of the first
+  // cloud in it, so that the clouds of a bad extrinsics show apart
+  struct Voxel {
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+    uint32_t count = 0;
+    uint32_t seed = 0;
+  };
+  std::unordered_map<int64_t, Voxel> voxels_;
+  bool has_extrinsics_ = false;
 
   // to ensure the pose of given timestamp can be found,
   // we pad some redundant clouds
@@ -84,6 +84,11 @@ Status Canbus::Init() {
       ErrorCode::OK) {
     return OnError("Failed to init can sender.");
   }
+  can_sender_.SetThreadConfig(
+      canbus_conf_.sender_thread_priority(),
+      std::vector<int>(canbus_conf_.sender_cpu_affinity().begin(),
+                       canbus_conf_.sender_cpu_affinity().end()));
+  can_sender_.SetMinSendInterval(canbus_conf_.min_send_interval());
   AINFO << "The can sender is successfully initialized.";
 
   vehicle_controller_ = vehicle_object->CreateVehicleController();
@@ -98,6 +103,14 @@ Status Canbus::Init() {
   }
   AINFO << "The vehicle controller is successfully initialized.";
 
+  if (FLAGS_chassis_detail_keyframe_interval > 0) {
+    chassis_detail_encoder_.reset(
+        new ChassisDetailDeltaEncoder(FLAGS_chassis_detail_keyframe_interval));
+    AINFO << "The chassis detail is published in deltas, with a keyframe "
+          << "every " << FLAGS_chassis_detail_keyframe_interval
+          << " messages.";
+  }
+
   return Status::OK();
 }
 
@@ -150,6 +163,12 @@ void Canbus::PublishChassisDetail() {
   message_manager_->GetSensorData(&chassis_detail);
   ADEBUG << chassis_detail.ShortDebugString();
 
+  if (chassis_detail_encoder_ != nullptr) {
+    ChassisDetail message;
+    chassis_detail_encoder_->Encode(chassis_detail, &message);
+    AdapterManager::PublishChassisDetail(message);
+    return;
+  }
   AdapterManager::PublishChassisDetail(chassis_detail);
 }
 
@@ -192,6 +211,11 @@ void Canbus::OnControlCommand(const ControlCommand &control_command) {
     return;
   }
   can_sender_.Update();
+  if (canbus_conf_.enable_immediate_send() &&
+      can_sender_.SendUpdated() != ErrorCode::OK) {
+    AERROR << "Failed to send the control command right away, it is left to "
+              "the periodic send.";
+  }
 }
 
 // Send the error to monitor and return it
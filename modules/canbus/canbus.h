@@ -28,6 +28,7 @@
 
 #include "ros/include/ros/ros.h"
 
+#include "modules/canbus/common/chassis_detail_delta.h"
 #include "modules/canbus/proto/chassis_detail.pb.h"
 #include "modules/canbus/vehicle/vehicle_controller.h"
 #include "modules/common/apollo_app.h"
@@ -96,6 +97,8 @@ class Canbus : public apollo::common::ApolloApp {
   std::unique_ptr<MessageManager<::apollo::canbus::ChassisDetail>>
       message_manager_;
   std::unique_ptr<VehicleController> vehicle_controller_;
+  // Set in the delta publishing of the chassis detail.
+  std::unique_ptr<ChassisDetailDeltaEncoder> chassis_detail_encoder_;
 
   int64_t last_timestamp_ = 0;
   ros::Timer timer_;
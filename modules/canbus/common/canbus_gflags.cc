@@ -33,6 +33,10 @@ DEFINE_int64(min_cmd_interval, 5, "Minimum control command interval in ms.");
 
 // chassis_detail message publish
 DEFINE_bool(enable_chassis_detail_pub, false, "Chassis Detail message publish");
+DEFINE_int32(chassis_detail_keyframe_interval, 0,
+             "If positive, the chassis detail is published as a full keyframe "
+             "every this number of messages, and as the deltas of the fields "
+             "changed since the keyframe in between.");
 
 // canbus test files
 DEFINE_string(canbus_test_file, "modules/canbus/testdata/canbus_test.pb.txt",
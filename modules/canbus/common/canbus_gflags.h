@@ -34,6 +34,7 @@ DECLARE_int64(min_cmd_interval);
 
 // chassis_detail message publish
 DECLARE_bool(enable_chassis_detail_pub);
+DECLARE_int32(chassis_detail_keyframe_interval);
 
 // canbus test files
 DECLARE_string(canbus_test_file);
@@ -0,0 +1,179 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/canbus/common/chassis_detail_delta.h"
+
+#include <vector>
+
+#include "google/protobuf/util/message_differencer.h"
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace canbus {
+
+namespace {
+
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Message;
+using google::protobuf::Reflection;
+using google::protobuf::util::MessageDifferencer;
+
+bool FieldEquals(const Message &a, const Message &b,
+                 const FieldDescriptor *field) {
+  const std::vector<const FieldDescriptor *> fields = {field};
+  MessageDifferencer differencer;
+  return differencer.CompareWithFields(a, b, fields, fields);
+}
+
+void CopyScalarField(const Message &from, const FieldDescriptor *field,
+                     Message *to) {
+  const Reflection *from_reflection = from.GetReflection();
+  const Reflection *to_reflection = to->GetReflection();
+  switch (field->cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+      to_reflection->SetInt32(to, field,
+                              from_reflection->GetInt32(from, field));
+      break;
+    case FieldDescriptor::CPPTYPE_INT64:
+      to_reflection->SetInt64(to, field,
+                              from_reflection->GetInt64(from, field));
+      break;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      to_reflection->SetUInt32(to, field,
+                               from_reflection->GetUInt32(from, field));
+      break;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      to_reflection->SetUInt64(to, field,
+                               from_reflection->GetUInt64(from, field));
+      break;
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      to_reflection->SetDouble(to, field,
+                               from_reflection->GetDouble(from, field));
+      break;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      to_reflection->SetFloat(to, field,
+                              from_reflection->GetFloat(from, field));
+      break;
+    case FieldDescriptor::CPPTYPE_BOOL:
+      to_reflection->SetBool(to, field, from_reflection->GetBool(from, field));
+      break;
+    case FieldDescriptor::CPPTYPE_ENUM:
+      to_reflection->SetEnum(to, field, from_reflection->GetEnum(from, field));
+      break;
+    case FieldDescriptor::CPPTYPE_STRING:
+      to_reflection->SetString(to, field,
+                               from_reflection->GetString(from, field));
+      break;
+    case FieldDescriptor::CPPTYPE_MESSAGE:
+      to_reflection->MutableMessage(to, field)
+          ->CopyFrom(from_reflection->GetMessage(from, field));
+      break;
+  }
+}
+
+// Fills the empty delta with the fields of the message which differ from the
+// base, so that merging the delta into the base gives the message. Returns
+// false if there is no such delta, because some field of the base is cleared
+// in the message, or some repeated field is changed, which a merge appends to.
+bool FillDelta(const Message &base, const Message &message, Message *delta) {
+  const Reflection *reflection = message.GetReflection();
+  std::vector<const FieldDescriptor *> fields;
+  reflection->ListFields(base, &fields);
+  for (const FieldDescriptor *field : fields) {
+    if (field->is_repeated() ? reflection->FieldSize(message, field) == 0
+                             : !reflection->HasField(message, field)) {
+      return false;
+    }
+  }
+
+  fields.clear();
+  reflection->ListFields(message, &fields);
+  for (const FieldDescriptor *field : fields) {
+    if (field->is_repeated()) {
+      if (!FieldEquals(base, message, field)) {
+        return false;
+      }
+    } else if (field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE &&
+               reflection->HasField(base, field)) {
+      Message *sub_delta = reflection->MutableMessage(delta, field);
+      if (!FillDelta(reflection->GetMessage(base, field),
+                     reflection->GetMessage(message, field), sub_delta)) {
+        return false;
+      }
+      std::vector<const FieldDescriptor *> sub_delta_fields;
+      sub_delta->GetReflection()->ListFields(*sub_delta, &sub_delta_fields);
+      if (sub_delta_fields.empty()) {
+        reflection->ClearField(delta, field);
+      }
+    } else if (!FieldEquals(base, message, field)) {
+      CopyScalarField(message, field, delta);
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+ChassisDetailDeltaEncoder::ChassisDetailDeltaEncoder(int keyframe_interval)
+    : keyframe_interval_(keyframe_interval) {}
+
+void ChassisDetailDeltaEncoder::Encode(const ChassisDetail &chassis_detail,
+                                       ChassisDetail *message) {
+  CHECK_NOTNULL(message);
+  message->Clear();
+  if (has_keyframe_ && delta_count_ + 1 < keyframe_interval_) {
+    if (FillDelta(keyframe_, chassis_detail, message)) {
+      ++delta_count_;
+      message->set_is_delta(true);
+      message->set_keyframe_id(keyframe_id_);
+      return;
+    }
+    ADEBUG << "The chassis detail can't be a delta, publish a keyframe.";
+    message->Clear();
+  }
+
+  keyframe_.CopyFrom(chassis_detail);
+  has_keyframe_ = true;
+  delta_count_ = 0;
+  message->CopyFrom(keyframe_);
+  message->clear_is_delta();
+  message->set_keyframe_id(++keyframe_id_);
+}
+
+bool ChassisDetailDeltaDecoder::Decode(const ChassisDetail &message,
+                                       ChassisDetail *chassis_detail) {
+  CHECK_NOTNULL(chassis_detail);
+  if (!message.is_delta()) {
+    keyframe_.CopyFrom(message);
+    has_keyframe_ = true;
+    chassis_detail->CopyFrom(message);
+    return true;
+  }
+  if (!has_keyframe_ || keyframe_.keyframe_id() != message.keyframe_id()) {
+    ADEBUG << "The keyframe " << message.keyframe_id()
+           << " of the chassis detail delta is not received.";
+    return false;
+  }
+  chassis_detail->CopyFrom(keyframe_);
+  chassis_detail->MergeFrom(message);
+  chassis_detail->clear_is_delta();
+  return true;
+}
+
+}  // namespace canbus
+}  // namespace apollo
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_CANBUS_COMMON_CHASSIS_DETAIL_DELTA_H_
+#define MODULES_CANBUS_COMMON_CHASSIS_DETAIL_DELTA_H_
+
+#include <cstdint>
+
+#include "modules/canbus/proto/chassis_detail.pb.h"
+
+/**
+ * @namespace apollo::canbus
+ * @brief apollo::canbus
+ */
+namespace apollo {
+namespace canbus {
+
+/**
+ * @class ChassisDetailDeltaEncoder
+ *
+ * @brief Turns the chassis details into the messages of the delta publishing:
+ * a full keyframe every keyframe interval, and in between the deltas of the
+ * fields changed since the keyframe. A chassis detail with some field of the
+ * keyframe cleared makes a new keyframe, since a delta can't clear a field.
+ */
+class ChassisDetailDeltaEncoder {
+ public:
+  /**
+   * @brief Constructor.
+   * @param keyframe_interval The number of messages between the keyframes.
+   */
+  explicit ChassisDetailDeltaEncoder(int keyframe_interval);
+
+  /**
+   * @brief Fills the message to publish for a chassis detail.
+   * @param chassis_detail The full chassis detail.
+   * @param message The keyframe or the delta to publish.
+   */
+  void Encode(const ChassisDetail &chassis_detail, ChassisDetail *message);
+
+ private:
+  const int keyframe_interval_;
+  // The number of deltas since the keyframe.
+  int delta_count_ = 0;
+  bool has_keyframe_ = false;
+  uint32_t keyframe_id_ = 0;
+  // The chassis detail of the keyframe.
+  ChassisDetail keyframe_;
+};
+
+/**
+ * @class ChassisDetailDeltaDecoder
+ *
+ * @brief Reconstructs the full chassis details from the messages of the delta
+ * publishing, on the consumer side. The full messages of the publishing
+ * without deltas are passed as they are.
+ */
+class ChassisDetailDeltaDecoder {
+ public:
+  /**
+   * @brief Reconstructs the chassis detail of a message.
+   * @param message The received keyframe or delta.
+   * @param chassis_detail The full chassis detail.
+   * @return False if the message is a delta whose keyframe is not received,
+   * in which case the chassis detail is not changed.
+   */
+  bool Decode(const ChassisDetail &message, ChassisDetail *chassis_detail);
+
+ private:
+  bool has_keyframe_ = false;
+  ChassisDetail keyframe_;
+};
+
+}  // namespace canbus
+}  // namespace apollo
+
+#endif  // MODULES_CANBUS_COMMON_CHASSIS_DETAIL_DELTA_H_
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/canbus/common/chassis_detail_delta.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/common/util/util.h"
+
+namespace apollo {
+namespace canbus {
+
+using apollo::common::util::IsProtoEqual;
+
+namespace {
+
+ChassisDetail MakeChassisDetail(double speed) {
+  ChassisDetail chassis_detail;
+  chassis_detail.set_car_type(ChassisDetail::CHANGAN_RUICHENG);
+  chassis_detail.mutable_vehicle_spd()->set_is_vehicle_spd_valid(true);
+  chassis_detail.mutable_vehicle_spd()->set_vehicle_spd(speed);
+  chassis_detail.mutable_light()->set_is_brake_lamp_on(false);
+  chassis_detail.mutable_battery()->set_battery_percent(80.0);
+  return chassis_detail;
+}
+
+}  // namespace
+
+TEST(ChassisDetailDeltaTest, Deltas) {
+  ChassisDetailDeltaEncoder encoder(3);
+  ChassisDetailDeltaDecoder decoder;
+  ChassisDetail message;
+  ChassisDetail decoded;
+
+  ChassisDetail chassis_detail = MakeChassisDetail(1.0);
+  encoder.Encode(chassis_detail, &message);
+  EXPECT_FALSE(message.is_delta());
+  EXPECT_TRUE(decoder.Decode(message, &decoded));
+  decoded.clear_keyframe_id();
+  EXPECT_TRUE(IsProtoEqual(chassis_detail, decoded));
+
+  // only the speed is changed
+  chassis_detail = MakeChassisDetail(2.0);
+  encoder.Encode(chassis_detail, &message);
+  EXPECT_TRUE(message.is_delta());
+  EXPECT_FALSE(message.has_car_type());
+  EXPECT_FALSE(message.has_light());
+  EXPECT_FALSE(message.has_battery());
+  EXPECT_FALSE(message.vehicle_spd().has_is_vehicle_spd_valid());
+  EXPECT_DOUBLE_EQ(2.0, message.vehicle_spd().vehicle_spd());
+  EXPECT_TRUE(decoder.Decode(message, &decoded));
+  decoded.clear_keyframe_id();
+  EXPECT_TRUE(IsProtoEqual(chassis_detail, decoded));
+
+  // a new field, against the keyframe
+  chassis_detail.mutable_eps()->set_is_eps_fail(false);
+  encoder.Encode(chassis_detail, &message);
+  EXPECT_TRUE(message.is_delta());
+  EXPECT_TRUE(message.has_eps());
+  EXPECT_DOUBLE_EQ(2.0, message.vehicle_spd().vehicle_spd());
+  EXPECT_TRUE(decoder.Decode(message, &decoded));
+  decoded.clear_keyframe_id();
+  EXPECT_TRUE(IsProtoEqual(chassis_detail, decoded));
+
+  // the keyframe interval
+  encoder.Encode(chassis_detail, &message);
+  EXPECT_FALSE(message.is_delta());
+  EXPECT_TRUE(decoder.Decode(message, &decoded));
+  decoded.clear_keyframe_id();
+  EXPECT_TRUE(IsProtoEqual(chassis_detail, decoded));
+}
+
+TEST(ChassisDetailDeltaTest, ClearedField) {
+  ChassisDetailDeltaEncoder encoder(10);
+  ChassisDetail message;
+  encoder.Encode(MakeChassisDetail(1.0), &message);
+  EXPECT_FALSE(message.is_delta());
+
+  ChassisDetail chassis_detail = MakeChassisDetail(1.0);
+  chassis_detail.clear_battery();
+  encoder.Encode(chassis_detail, &message);
+  EXPECT_FALSE(message.is_delta());
+  EXPECT_FALSE(message.has_battery());
+}
+
+TEST(ChassisDetailDeltaTest, MissedKeyframe) {
+  ChassisDetailDeltaEncoder encoder(10);
+  ChassisDetailDeltaDecoder decoder;
+  ChassisDetail message;
+  ChassisDetail decoded;
+
+  encoder.Encode(MakeChassisDetail(1.0), &message);
+  encoder.Encode(MakeChassisDetail(2.0), &message);
+  EXPECT_TRUE(message.is_delta());
+  EXPECT_FALSE(decoder.Decode(message, &decoded));
+
+  // the next keyframe
+  ChassisDetail chassis_detail = MakeChassisDetail(2.0);
+  chassis_detail.clear_light();
+  encoder.Encode(chassis_detail, &message);
+  EXPECT_FALSE(message.is_delta());
+  EXPECT_TRUE(decoder.Decode(message, &decoded));
+  encoder.Encode(MakeChassisDetail(3.0), &message);
+  EXPECT_TRUE(message.is_delta());
+  EXPECT_TRUE(decoder.Decode(message, &decoded));
+  EXPECT_DOUBLE_EQ(3.0, decoded.vehicle_spd().vehicle_spd());
+  EXPECT_TRUE(decoded.has_light());
+}
+
+}  // namespace canbus
+}  // namespace apollo
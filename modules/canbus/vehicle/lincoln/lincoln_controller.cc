@@ -107,9 +107,10 @@ ErrorCode LincolnController::Init(
     return ErrorCode::CANBUS_ERROR;
   }
 
-  can_sender_->AddMessage(Brake60::ID, brake_60_, false);
-  can_sender_->AddMessage(Throttle62::ID, throttle_62_, false);
-  can_sender_->AddMessage(Steering64::ID, steering_64_, false);
+  // the actuation frames may be sent as soon as a control command comes
+  can_sender_->AddMessage(Brake60::ID, brake_60_, false, true);
+  can_sender_->AddMessage(Throttle62::ID, throttle_62_, false, true);
+  can_sender_->AddMessage(Steering64::ID, steering_64_, false, true);
   can_sender_->AddMessage(Gear66::ID, gear_66_, false);
   can_sender_->AddMessage(Turnsignal68::ID, turnsignal_68_, false);
 
@@ -21,13 +21,17 @@
 #ifndef MODULES_ADAPTERS_ADAPTER_H_
 #define MODULES_ADAPTERS_ADAPTER_H_
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
 #include <functional>
 #include <limits>
-#include <list>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <type_traits>
+#include <unordered_set>
 #include <vector>
 
 #include "glog/logging.h"
@@ -35,6 +39,10 @@
 #include "google/protobuf/message.h"
 
 #include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/adapters/adapter_stats.h"
+#include "modules/common/adapters/component_context.h"
+#include "modules/common/adapters/proto/adapter_config.pb.h"
+#include "modules/common/adapters/proto/adapter_stats.pb.h"
 #include "modules/common/proto/header.pb.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/file.h"
@@ -57,6 +65,9 @@ namespace adapter {
 template <bool B, class T = void>
 using enable_if_t = typename std::enable_if<B, T>::type;
 
+/// Runs a task on the threads of the component which registered a callback.
+typedef std::function<void(std::function<void()>)> CallbackExecutor;
+
 /**
  * @class AdapterBase
  * @brief Base interface of all concrete adapters.
@@ -90,6 +101,12 @@ class AdapterBase {
    */
   virtual double GetDelaySec() const = 0;
 
+  /**
+   * @brief Gets the number of messages received so far. It is counted even
+   * with --enable_adapter_stats off, so it can be sampled to get the rate.
+   */
+  virtual uint64_t GetReceivedCount() const = 0;
+
   /**
    * @brief Clear the data received so far.
    */
@@ -99,6 +116,18 @@ class AdapterBase {
    * @brief Dumps the latest received data to file.
    */
   virtual bool DumpLatestMessage() = 0;
+
+  /**
+   * @brief Fills the instrumentation statistics of the adapter.
+   * @return false if --enable_adapter_stats was off when the adapter was
+   * created.
+   */
+  virtual bool GetStats(AdapterStats* stats) const = 0;
+
+  /**
+   * @brief Fills the memory held by the messages the adapter keeps.
+   */
+  virtual void GetMemory(AdapterMemory* memory) const = 0;
 };
 
 /**
@@ -114,14 +143,26 @@ class AdapterBase {
  * its corresponding data type.
  *
  * \par
- * Under the hood, a queue is used to store the current and historical
- * messages. In most cases, the underlying data type is a proto, though
- * this is not necessary.
+ * Under the hood, the current and historical messages are kept in an
+ * immutable snapshot which is rebuilt (copy-on-write) upon every
+ * received message and published by swapping a shared pointer. In most
+ * cases, the underlying data type is a proto, though this is not
+ * necessary.
+ *
+ * \par
+ * Each component co-located in the process by the component runtime
+ * observes its own snapshot, see CurrentComponent().
+ *
+ * \par
+ * Which messages the snapshot keeps is set by the retention policy, see
+ * Adapter::SetRetentionPolicy(). The memory they hold is accounted for
+ * every message, see Adapter::GetMemory().
  *
  * \note
- * Adapter::Observe() is thread-safe, but calling it from
- * multiple threads may introduce unexpected behavior. Adapter is
- * thread-safe w.r.t. data access and update.
+ * Adapter::Observe() is thread-safe and O(1): it only swaps the
+ * observed snapshot, so it never waits on the receive callback, but
+ * calling it from multiple threads may introduce unexpected behavior.
+ * Adapter is thread-safe w.r.t. data access and update.
  */
 template <typename D>
 class Adapter : public AdapterBase {
@@ -130,7 +171,9 @@ class Adapter : public AdapterBase {
   /// underlying data.
   typedef D DataType;
 
-  typedef typename std::list<std::shared_ptr<D>>::const_iterator Iterator;
+  /// An immutable view of the messages, the most recent one first.
+  typedef std::vector<std::shared_ptr<D>> Snapshot;
+  typedef typename Snapshot::const_iterator Iterator;
   typedef typename std::function<void(const D&)> Callback;
 
   /**
@@ -145,8 +188,10 @@ class Adapter : public AdapterBase {
    */
   Adapter(const std::string& adapter_name, const std::string& topic_name,
           size_t message_num, const std::string& dump_dir = "/tmp")
-      : topic_name_(topic_name),
+      : adapter_name_(adapter_name),
+        topic_name_(topic_name),
         message_num_(message_num),
+        data_snapshot_(std::make_shared<const Snapshot>()),
         enable_dump_(FLAGS_enable_adapter_dump),
         dump_path_(dump_dir + "/" + adapter_name) {
     if (HasSequenceNumber<D>()) {
@@ -164,6 +209,11 @@ class Adapter : public AdapterBase {
     } else {
       enable_dump_ = false;
     }
+    if (FLAGS_enable_adapter_stats) {
+      stats_.reset(
+          new AdapterStatistics(adapter_name, topic_name, message_num));
+    }
+    observed_snapshots_.fill(data_snapshot_);
   }
 
   /**
@@ -171,6 +221,23 @@ class Adapter : public AdapterBase {
    */
   const std::string& topic_name() const override { return topic_name_; }
 
+  /**
+   * @brief sets which of the received messages are kept, besides the latest
+   * one, within the message_num of the constructor. The policy applies from
+   * the next received message.
+   * @param policy the retention policy.
+   * @param window_sec the age of the oldest message kept by TIME_WINDOW.
+   * @param byte_budget the memory of the messages kept by BYTE_BUDGET.
+   */
+  void SetRetentionPolicy(const AdapterConfig::RetentionPolicy policy,
+                          const double window_sec = 0.0,
+                          const size_t byte_budget = 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retention_policy_ = policy;
+    retention_window_sec_ = window_sec;
+    retention_byte_budget_ = byte_budget;
+  }
+
   /**
    * @brief reads the proto message from the file, and push it into
    * the adapter's data queue.
@@ -195,34 +262,52 @@ class Adapter : public AdapterBase {
    * @param message the newly received message.
    */
   void OnReceive(const D& message) {
-    last_receive_time_ = apollo::common::time::Clock::NowInSeconds();
-    EnqueueData(message);
-    FireCallbacks(message);
+    OnReceiveMessage(message, nullptr);
+  }
+
+  /**
+   * @brief the callback that will be invoked whenever a new message is
+   * received as a shared pointer, e.g. from the same process. The message is
+   * kept as it is, without copy.
+   * @param message the newly received message, which must not be modified.
+   */
+  void OnReceiveShared(const std::shared_ptr<const D>& message) {
+    // The snapshots never modify their messages.
+    OnReceiveMessage(*message, std::const_pointer_cast<D>(message));
   }
 
   /**
-   * @brief copy the data_queue_ into the observing queue to create a
-   * view of data up to the call time for the user.
+   * @brief publish the latest data snapshot as the observing queue to
+   * create a view of data up to the call time for the user. No message
+   * is copied.
    */
   void Observe() override {
-    std::lock_guard<std::mutex> lock(mutex_);
-    observed_queue_ = data_queue_;
+    std::shared_ptr<const Snapshot> previous;
+    {
+      SnapshotGuard guard(&snapshot_flag_);
+      auto& observed = observed_snapshots_[CurrentComponent()];
+      previous = observed;
+      observed = data_snapshot_;
+    }
+    // The previous view, if unreferenced, is released outside of the
+    // critical section.
+    if (stats_) {
+      stats_->OnObserve();
+    }
   }
 
   /**
    * @brief returns TRUE if the observing queue is empty.
    */
   bool Empty() const override {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return observed_queue_.empty();
+    return LoadSnapshot(ObservedSnapshot())->empty();
   }
 
   /**
    * @brief returns TRUE if the adapter has received any message.
    */
   bool HasReceived() const override {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return !data_queue_.empty();
+    return !LoadSnapshot(data_snapshot_)->empty();
   }
 
   /**
@@ -233,12 +318,12 @@ class Adapter : public AdapterBase {
    * queue before calling GetOldestObserved().
    */
   const D& GetLatestObserved() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    DCHECK(!observed_queue_.empty())
+    const auto observed = LoadSnapshot(ObservedSnapshot());
+    DCHECK(!observed->empty())
         << "The view of data queue is empty. No data is received yet or you "
            "forgot to call Observe()"
         << ":" << topic_name_;
-    return *observed_queue_.front();
+    return *observed->front();
   }
   /**
    * @brief returns the most recent message pointer in the observing queue.
@@ -248,12 +333,12 @@ class Adapter : public AdapterBase {
    * queue before calling GetLatestObservedPtr().
    */
   std::shared_ptr<const D> GetLatestObservedPtr() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    DCHECK(!observed_queue_.empty())
+    const auto observed = LoadSnapshot(ObservedSnapshot());
+    DCHECK(!observed->empty())
     << "The view of data queue is empty. No data is received yet or you "
         "forgot to call Observe()"
     << ":" << topic_name_;
-    return observed_queue_.front();
+    return observed->front();
   }
   /**
    * @brief returns the oldest message in the observing queue.
@@ -263,35 +348,40 @@ class Adapter : public AdapterBase {
    * queue before calling GetOldestObserved().
    */
   const D& GetOldestObserved() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    DCHECK(!observed_queue_.empty())
+    const auto observed = LoadSnapshot(ObservedSnapshot());
+    DCHECK(!observed->empty())
         << "The view of data queue is empty. No data is received yet or you "
            "forgot to call Observe().";
-    return *observed_queue_.back();
+    return *observed->back();
   }
 
   /**
    * @brief returns an iterator representing the head of the observing
    * queue. The caller can use it to iterate over the observed data
    * from the head. The API also supports range based for loop.
+   *
+   * \note
+   * The iterators stay valid until the next call to Observe().
    */
-  Iterator begin() const { return observed_queue_.begin(); }
+  Iterator begin() const { return LoadSnapshot(ObservedSnapshot())->begin(); }
 
   /**
    * @brief returns an iterator representing the tail of the observing
    * queue. The caller can use it to iterate over the observed data
    * from the head. The API also supports range based for loop.
    */
-  Iterator end() const { return observed_queue_.end(); }
+  Iterator end() const { return LoadSnapshot(ObservedSnapshot())->end(); }
 
   /**
    * @brief registers the provided callback function to the adapter,
    * so that the callback function will be called once right after the
    * message hits the adapter.
    * @param callback the callback with signature void(const D &).
+   * @param executor if set, the callback is run by it instead of the
+   * receiving thread, with the message kept until then.
    */
-  void AddCallback(Callback callback) {
-    receive_callbacks_.push_back(callback);
+  void AddCallback(Callback callback, CallbackExecutor executor = nullptr) {
+    receive_callbacks_.push_back({callback, executor});
   }
 
   /**
@@ -323,7 +413,13 @@ class Adapter : public AdapterBase {
   uint32_t GetSeqNum() const { return seq_num_; }
 
   void SetLatestPublished(const D& data) {
-    latest_published_data_.reset(new D(data));
+    // Assigning to the existing copy reuses its memory; large messages such
+    // as the planning trajectory are published every cycle.
+    if (latest_published_data_) {
+      *latest_published_data_ = data;
+    } else {
+      latest_published_data_.reset(new D(data));
+    }
   }
 
   const D* GetLatestPublished() { return latest_published_data_.get(); }
@@ -339,14 +435,23 @@ class Adapter : public AdapterBase {
     }
   }
 
+  uint64_t GetReceivedCount() const override {
+    return received_count_.load(std::memory_order_relaxed);
+  }
+
   /**
    * @brief Clear the data received so far.
    */
   void ClearData() override {
+    const auto empty = std::make_shared<const Snapshot>();
     // Lock the queue.
     std::lock_guard<std::mutex> lock(mutex_);
-    data_queue_.clear();
-    observed_queue_.clear();
+    StoreSnapshot(empty, SnapshotMemory(), &data_snapshot_, &data_memory_);
+    {
+      SnapshotGuard guard(&snapshot_flag_);
+      observed_snapshots_.fill(empty);
+    }
+    data_infos_.clear();
   }
 
   /**
@@ -363,10 +468,155 @@ class Adapter : public AdapterBase {
     return false;
   }
 
+  /**
+   * @brief Fills the instrumentation statistics of the adapter.
+   */
+  bool GetStats(AdapterStats* stats) const override {
+    if (!stats_) {
+      return false;
+    }
+    stats_->GetStats(stats);
+    return true;
+  }
+
+  /**
+   * @brief Fills the memory held by the messages the adapter keeps. A
+   * message both received and observed is only counted once.
+   */
+  void GetMemory(AdapterMemory* memory) const override {
+    memory->set_adapter_name(adapter_name_);
+    memory->set_topic_name(topic_name_);
+    std::shared_ptr<const Snapshot> data;
+    SnapshotMemory data_memory;
+    std::array<std::shared_ptr<const Snapshot>, kMaxComponents> observed;
+    {
+      SnapshotGuard guard(&snapshot_flag_);
+      data = data_snapshot_;
+      data_memory = data_memory_;
+      observed = observed_snapshots_;
+    }
+    size_t count = data_memory.count;
+    size_t bytes = data_memory.bytes;
+    // The observed snapshots were data snapshots, so they mostly hold the
+    // received messages. Only the other ones are added.
+    std::unordered_set<const D*> counted;
+    for (const auto& message : *data) {
+      counted.insert(message.get());
+    }
+    for (size_t i = 0; i < observed.size(); ++i) {
+      if (observed[i] == data ||
+          std::find(observed.begin(), observed.begin() + i, observed[i]) !=
+              observed.begin() + i) {
+        continue;
+      }
+      for (const auto& message : *observed[i]) {
+        if (counted.insert(message.get()).second) {
+          ++count;
+          bytes += MessageBytes(*message);
+        }
+      }
+    }
+    memory->set_message_count(count);
+    memory->set_bytes(bytes);
+  }
+
  private:
   template <typename T>
   struct IdentifierType {};
 
+  /// The received message of a snapshot.
+  struct MessageInfo {
+    double receive_time = 0.0;
+    size_t bytes = 0;
+  };
+
+  /// The messages of a snapshot.
+  struct SnapshotMemory {
+    size_t count = 0;
+    size_t bytes = 0;
+  };
+
+  /// A registered callback.
+  struct CallbackEntry {
+    Callback callback;
+    CallbackExecutor executor;
+  };
+
+  /**
+   * @class SnapshotGuard
+   * @brief spins on the flag guarding the snapshot pointers. It is only
+   * held for the duration of a shared pointer copy, so it never waits
+   * on the message copy done by the receive callback.
+   */
+  class SnapshotGuard {
+   public:
+    explicit SnapshotGuard(std::atomic_flag* flag) : flag_(flag) {
+      while (flag_->test_and_set(std::memory_order_acquire)) {
+      }
+    }
+    ~SnapshotGuard() { flag_->clear(std::memory_order_release); }
+
+   private:
+    std::atomic_flag* flag_;
+  };
+
+  const std::shared_ptr<const Snapshot>& ObservedSnapshot() const {
+    return observed_snapshots_[CurrentComponent()];
+  }
+
+  std::shared_ptr<const Snapshot> LoadSnapshot(
+      const std::shared_ptr<const Snapshot>& snapshot) const {
+    SnapshotGuard guard(&snapshot_flag_);
+    return snapshot;
+  }
+
+  void StoreSnapshot(std::shared_ptr<const Snapshot> snapshot,
+                     const SnapshotMemory& memory,
+                     std::shared_ptr<const Snapshot>* target,
+                     SnapshotMemory* target_memory) {
+    SnapshotGuard guard(&snapshot_flag_);
+    target->swap(snapshot);
+    *target_memory = memory;
+    // The swapped-out snapshot is released once the guard is gone.
+  }
+
+  // The heap size of a message: SpaceUsed() for the protos, the buffers for
+  // the ROS messages, the object itself for the others.
+  size_t MessageBytes(const D& message) const {
+    return MessageBytes(message, IdentifierType<D>());
+  }
+  template <class T>
+  size_t MessageBytes(const D& message, IdentifierType<T>) const {
+    return SpaceUsed<D>(message);
+  }
+  size_t MessageBytes(const ::sensor_msgs::PointCloud2& message,
+                      IdentifierType<::sensor_msgs::PointCloud2>) const {
+    return sizeof(message) + message.data.size() +
+           message.fields.size() * sizeof(::sensor_msgs::PointField);
+  }
+  size_t MessageBytes(const ::sensor_msgs::CompressedImage& message,
+                      IdentifierType<::sensor_msgs::CompressedImage>) const {
+    return sizeof(message) + message.data.size();
+  }
+  size_t MessageBytes(const ::sensor_msgs::Image& message,
+                      IdentifierType<::sensor_msgs::Image>) const {
+    return sizeof(message) + message.data.size();
+  }
+  template <typename InputMessageType>
+  static size_t SpaceUsed(
+      const enable_if_t<std::is_base_of<google::protobuf::Message,
+                                        InputMessageType>::value,
+                        InputMessageType>& message) {
+    return message.SpaceUsed();
+  }
+  template <typename InputMessageType>
+  static size_t SpaceUsed(
+      const enable_if_t<!std::is_base_of<google::protobuf::Message,
+                                         InputMessageType>::value,
+                        InputMessageType>& message) {
+    return sizeof(message);
+  }
+
   template <class T>
   bool FeedFile(const std::string& message_file, IdentifierType<T>) {
     D data;
@@ -456,22 +706,60 @@ class Adapter : public AdapterBase {
         message, util::StrCat(dump_path_, "/", sequence_num, ".pb.txt"));
   }
 
+  void OnReceiveMessage(const D& message, std::shared_ptr<D> shared) {
+    last_receive_time_ = apollo::common::time::Clock::NowInSeconds();
+    received_count_.fetch_add(1, std::memory_order_relaxed);
+    if (stats_) {
+      stats_->OnReceive();
+    }
+    EnqueueData(message, &shared);
+    FireCallbacks(message, shared);
+  }
+
   /**
    * @brief proactively invokes the callbacks one by one registered with the
    * specified data.
    * @param data the specified data.
+   * @param shared the data as a shared pointer, if any, which the callbacks
+   * run by an executor keep.
    */
-  void FireCallbacks(const D& data) {
-    for (const auto& callback : receive_callbacks_) {
+  void FireCallbacks(const D& data, std::shared_ptr<const D> shared) {
+    for (size_t i = 0; i < receive_callbacks_.size(); ++i) {
+      const CallbackEntry& entry = receive_callbacks_[i];
+      if (!entry.executor) {
+        RunCallback(i, entry.callback, data);
+        continue;
+      }
+      if (!shared) {
+        shared = std::make_shared<const D>(data);
+      }
+      const Callback callback = entry.callback;
+      entry.executor([this, i, callback, shared]() {
+        RunCallback(i, callback, *shared);
+      });
+    }
+  }
+
+  void RunCallback(const size_t index, const Callback& callback,
+                   const D& data) {
+    if (!stats_) {
       callback(data);
+      return;
     }
+    const double start = AdapterStatistics::MonotonicNowInSeconds();
+    callback(data);
+    stats_->OnCallback(index,
+                       AdapterStatistics::MonotonicNowInSeconds() - start);
   }
 
   /**
    * @brief push the shared-pointer-guarded data to the data queue of
    * the adapter.
+   * @param data the data.
+   * @param shared the data as a shared pointer, which is enqueued if set, and
+   * else set to the enqueued copy.
    */
-  void EnqueueData(const D& data) {
+  void EnqueueData(const D& data, std::shared_ptr<D>* shared = nullptr) {
     if (enable_dump_) {
       DumpMessage<D>(data);
     }
@@ -481,33 +769,88 @@ class Adapter : public AdapterBase {
       return;
     }
 
-    // Lock the queue.
+    std::shared_ptr<D> message;
+    if (shared != nullptr && *shared) {
+      message = *shared;
+    } else {
+      message = std::make_shared<D>(data);
+      if (shared != nullptr) {
+        *shared = message;
+      }
+    }
+    MessageInfo info;
+    info.receive_time = apollo::common::time::Clock::NowInSeconds();
+    info.bytes = MessageBytes(*message);
+    // Lock the queue. Only writers modify data_snapshot_ and data_infos_, so
+    // they can be read directly while holding the mutex.
     std::lock_guard<std::mutex> lock(mutex_);
-    if (data_queue_.size() + 1 > message_num_) {
-      data_queue_.pop_back();
+    const size_t max_count =
+        retention_policy_ == AdapterConfig::LATEST_ONLY ? 1 : message_num_;
+    const Snapshot& latest = *data_snapshot_;
+    auto next = std::make_shared<Snapshot>();
+    next->reserve(std::min(latest.size() + 1, max_count));
+    next->push_back(std::move(message));
+    SnapshotMemory memory;
+    memory.count = 1;
+    memory.bytes = info.bytes;
+    // data_infos_ is in the order of the snapshot, the most recent first.
+    for (size_t i = 0; i < latest.size() && next->size() < max_count; ++i) {
+      const MessageInfo& older = data_infos_[i];
+      if ((retention_policy_ == AdapterConfig::TIME_WINDOW &&
+           older.receive_time < info.receive_time - retention_window_sec_) ||
+          (retention_policy_ == AdapterConfig::BYTE_BUDGET &&
+           memory.bytes + older.bytes > retention_byte_budget_)) {
+        break;
+      }
+      next->push_back(latest[i]);
+      ++memory.count;
+      memory.bytes += older.bytes;
     }
-    data_queue_.push_front(std::make_shared<D>(data));
+    data_infos_.resize(next->size() - 1);
+    data_infos_.push_front(info);
+    StoreSnapshot(std::move(next), memory, &data_snapshot_, &data_memory_);
   }
 
+  /// The name of the adapter.
+  std::string adapter_name_;
+
   /// The topic name that the adapter listens to.
   std::string topic_name_;
 
-  /// The maximum size of data_queue_ and observed_queue_
+  /// The maximum size of data_snapshot_ and observed_snapshots_
   size_t message_num_ = 0;
 
-  /// The received data. Its size is no more than message_num_
-  std::list<std::shared_ptr<D>> data_queue_;
+  /// The received data. Its size is no more than message_num_. It is
+  /// never modified in place, a new snapshot replaces it instead.
+  std::shared_ptr<const Snapshot> data_snapshot_;
+
+  /// The snapshots of the data queue observed by every component. The
+  /// snapshot of a component is taken when it calls Observe().
+  std::array<std::shared_ptr<const Snapshot>, kMaxComponents>
+      observed_snapshots_;
+
+  /// The memory of data_snapshot_, guarded like the pointers.
+  SnapshotMemory data_memory_;
 
-  /// It is the snapshot of the data queue. The snapshot is taken when
-  /// Observe() is called.
-  std::list<std::shared_ptr<D>> observed_queue_;
+  /// The received messages of data_snapshot_, in the same order, guarded by
+  /// mutex_.
+  std::deque<MessageInfo> data_infos_;
+
+  /// The retention policy, guarded by mutex_.
+  AdapterConfig::RetentionPolicy retention_policy_ =
+      AdapterConfig::HISTORY_LIMIT;
+  double retention_window_sec_ = 0.0;
+  size_t retention_byte_budget_ = 0;
 
   /// User defined function when receiving a message
-  std::vector<Callback> receive_callbacks_;
+  std::vector<CallbackEntry> receive_callbacks_;
 
-  /// The mutex guarding data_queue_ and observed_queue_
+  /// The mutex serializing the writers of data_snapshot_
   mutable std::mutex mutex_;
 
+  /// The flag guarding the data_snapshot_ and observed_snapshots_ pointers
+  mutable std::atomic_flag snapshot_flag_ = ATOMIC_FLAG_INIT;
+
   /// Whether dumping is enabled.
   bool enable_dump_ = false;
 
@@ -522,6 +865,10 @@ class Adapter : public AdapterBase {
   std::unique_ptr<D> latest_published_data_;
 
   double last_receive_time_ = 0;
+  std::atomic<uint64_t> received_count_{0};
+
+  /// The instrumentation, only created if --enable_adapter_stats is set.
+  std::unique_ptr<AdapterStatistics> stats_;
 };
 
 }  // namespace adapter
@@ -19,6 +19,17 @@
 DEFINE_bool(enable_adapter_dump, false,
             "Whether enable dumping the messages to "
             "/tmp/adapters/<topic_name>/<seq_num>.txt for debugging purposes.");
+DEFINE_bool(enable_adapter_stats, false,
+            "Whether to record the receive-to-observe latency, drop count "
+            "and callback execution time of every adapter.");
+DEFINE_double(adapter_stats_report_interval_sec, 10.0,
+              "The interval to report the adapter stats when "
+              "enable_adapter_stats is true.");
+DEFINE_string(tf2_cached_frame_pairs,
+              "world:localization,world:novatel,novatel:velodyne64,"
+              "novatel:radar",
+              "The frame_id:child_frame_id pairs, separated by commas, of "
+              "the transforms also kept in AdapterManager::Tf2Cache().");
 DEFINE_string(gps_topic, "/apollo/sensor/gnss/odometry", "GPS topic name");
 DEFINE_string(imu_topic, "/apollo/sensor/gnss/corrected_imu", "IMU topic name");
 DEFINE_string(raw_imu_topic, "/apollo/sensor/gnss/imu", "Raw IMU topic name");
@@ -60,6 +71,8 @@ DEFINE_string(system_status_topic, "/apollo/monitor/system_status",
               "System status topic name");
 DEFINE_string(static_info_topic, "/apollo/monitor/static_info",
               "Static info topic name");
+DEFINE_string(resource_status_topic, "/apollo/monitor/resource_status",
+              "Resource status topic name");
 DEFINE_string(mobileye_topic, "/apollo/sensor/mobileye", "mobileye topic name");
 DEFINE_string(delphi_esr_topic, "/apollo/sensor/delphi_esr",
               "delphi esr radar topic name");
@@ -20,6 +20,9 @@
 #include "gflags/gflags.h"
 
 DECLARE_bool(enable_adapter_dump);
+DECLARE_bool(enable_adapter_stats);
+DECLARE_double(adapter_stats_report_interval_sec);
+DECLARE_string(tf2_cached_frame_pairs);
 DECLARE_string(monitor_topic);
 DECLARE_string(gps_topic);
 DECLARE_string(imu_topic);
@@ -44,6 +47,7 @@ DECLARE_string(ins_status_topic);
 DECLARE_string(gnss_status_topic);
 DECLARE_string(system_status_topic);
 DECLARE_string(static_info_topic);
+DECLARE_string(resource_status_topic);
 DECLARE_string(mobileye_topic);
 DECLARE_string(delphi_esr_topic);
 DECLARE_string(conti_radar_topic);
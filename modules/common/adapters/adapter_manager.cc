@@ -16,19 +16,163 @@
 
 #include "modules/common/adapters/adapter_manager.h"
 
+#include <functional>
+#include <utility>
+
 #include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/util/string_util.h"
 #include "modules/common/util/util.h"
 
 namespace apollo {
 namespace common {
 namespace adapter {
 
+namespace {
+
+thread_local ros::CallbackQueue *component_callback_queue = nullptr;
+
+/**
+ * @class TaskCallback
+ * @brief Runs a task in the context of a component as a ROS callback.
+ */
+class TaskCallback : public ros::CallbackInterface {
+ public:
+  TaskCallback(const int component, std::function<void()> task)
+      : component_(component), task_(std::move(task)) {}
+
+  CallResult call() override {
+    ScopedComponent scoped_component(component_);
+    task_();
+    return Success;
+  }
+
+ private:
+  const int component_;
+  const std::function<void()> task_;
+};
+
+}  // namespace
+
 AdapterManager::AdapterManager() {}
 
+void AdapterManager::EnableIntraProcess() {
+  CHECK(!Initialized()) << "Enable the intra-process mode before Init().";
+  instance()->intra_process_ = true;
+}
+
+void AdapterManager::SetComponentCallbackQueue(ros::CallbackQueue *queue) {
+  component_callback_queue = queue;
+}
+
+ros::CallbackQueue *AdapterManager::ComponentCallbackQueue() {
+  return component_callback_queue;
+}
+
+CallbackExecutor AdapterManager::ComponentExecutor() {
+  ros::CallbackQueue *queue = component_callback_queue;
+  if (queue == nullptr) {
+    return nullptr;
+  }
+  const int component = CurrentComponent();
+  return [queue, component](std::function<void()> task) {
+    queue->addCallback(
+        boost::make_shared<TaskCallback>(component, std::move(task)));
+  };
+}
+
+AdapterConfig::Mode AdapterManager::MergeMode(
+    const AdapterConfig::Mode mode, const AdapterConfig::Mode other_mode) {
+  return mode == other_mode ? mode : AdapterConfig::DUPLEX;
+}
+
 void AdapterManager::Observe() {
   for (const auto observe : instance()->observers_) {
     observe();
   }
+  if (FLAGS_enable_adapter_stats) {
+    const double now = AdapterStatistics::MonotonicNowInSeconds();
+    if (now - instance()->last_stats_report_time_ >=
+        FLAGS_adapter_stats_report_interval_sec) {
+      instance()->last_stats_report_time_ = now;
+      instance()->ReportStats();
+    }
+  }
+}
+
+TransformCache &AdapterManager::MutableTf2Cache() {
+  static TransformCache tf2_cache(
+      TransformCache::ParseFramePairs(FLAGS_tf2_cached_frame_pairs));
+  return tf2_cache;
+}
+
+void AdapterManager::GetStats(AdapterManagerStats *stats) {
+  stats->Clear();
+  auto *header = stats->mutable_header();
+  header->set_timestamp_sec(apollo::common::time::Clock::NowInSeconds());
+  for (const auto &get_stats : instance()->stats_getters_) {
+    AdapterStats adapter_stats;
+    if (get_stats(&adapter_stats)) {
+      stats->add_adapter()->Swap(&adapter_stats);
+    }
+  }
+}
+
+void AdapterManager::GetMemory(AdapterManagerMemory *memory) {
+  memory->Clear();
+  auto *header = memory->mutable_header();
+  header->set_timestamp_sec(apollo::common::time::Clock::NowInSeconds());
+  uint64_t total_bytes = 0;
+  for (const auto &get_memory : instance()->memory_getters_) {
+    auto *adapter_memory = memory->add_adapter();
+    get_memory(adapter_memory);
+    total_bytes += adapter_memory->bytes();
+  }
+  memory->set_total_bytes(total_bytes);
+}
+
+void AdapterManager::ReportStats() {
+  AdapterManagerStats stats;
+  GetStats(&stats);
+  monitor::MonitorMessage monitor_message;
+  for (const auto &adapter_stats : stats.adapter()) {
+    const auto &latency = adapter_stats.receive_to_observe_latency();
+    AINFO << "Adapter " << adapter_stats.adapter_name() << " ["
+          << adapter_stats.topic_name()
+          << "]: received=" << adapter_stats.received_count()
+          << ", dropped=" << adapter_stats.dropped_count()
+          << ", rate=" << adapter_stats.receive_rate_hz()
+          << "Hz, receive_to_observe mean=" << latency.mean_ms()
+          << "ms max=" << latency.max_ms() << "ms";
+    for (const auto &callback : adapter_stats.callback()) {
+      AINFO << "Adapter " << adapter_stats.adapter_name() << " callback "
+            << callback.index()
+            << ": mean=" << callback.execution_time().mean_ms()
+            << "ms max=" << callback.execution_time().max_ms() << "ms";
+    }
+    if (adapter_stats.dropped_count() > 0) {
+      auto *item = monitor_message.add_item();
+      item->set_log_level(monitor::MonitorMessageItem::WARN);
+      item->set_msg(util::StrCat(
+          "Adapter ", adapter_stats.adapter_name(), " dropped ",
+          adapter_stats.dropped_count(), " unobserved messages out of ",
+          adapter_stats.received_count()));
+    }
+  }
+  AdapterManagerMemory memory;
+  GetMemory(&memory);
+  for (const auto &adapter_memory : memory.adapter()) {
+    if (adapter_memory.message_count() > 0) {
+      AINFO << "Adapter " << adapter_memory.adapter_name() << " keeps "
+            << adapter_memory.message_count() << " messages of "
+            << adapter_memory.bytes() << " bytes";
+    }
+  }
+  AINFO << "Adapters keep " << memory.total_bytes() << " bytes of messages";
+  if (monitor_message.item_size() > 0 && Monitor_ &&
+      Monitorconfig_.mode() != AdapterConfig::RECEIVE_ONLY) {
+    Monitor_->FillHeader("adapter_manager", &monitor_message);
+    InternalPublishMonitor(monitor_message);
+  }
 }
 
 bool AdapterManager::Initialized() {
@@ -38,6 +182,8 @@ bool AdapterManager::Initialized() {
 void AdapterManager::Reset() {
   instance()->initialized_ = false;
   instance()->observers_.clear();
+  instance()->stats_getters_.clear();
+  instance()->memory_getters_.clear();
 }
 
 void AdapterManager::Init(const std::string &adapter_config_filename) {
@@ -50,12 +196,13 @@ void AdapterManager::Init(const std::string &adapter_config_filename) {
 }
 
 void AdapterManager::Init(const AdapterManagerConfig &configs) {
-  if (Initialized()) {
+  // With the intra-process mode, every co-located app enables its adapters.
+  if (Initialized() && !instance()->intra_process_) {
     return;
   }
 
   instance()->initialized_ = true;
-  if (configs.is_ros()) {
+  if (configs.is_ros() && !instance()->node_handle_) {
     instance()->node_handle_.reset(new ros::NodeHandle());
   }
 
@@ -128,6 +275,9 @@ void AdapterManager::Init(const AdapterManagerConfig &configs) {
       case AdapterConfig::STATIC_INFO:
         EnableStaticInfo(FLAGS_static_info_topic, config);
         break;
+      case AdapterConfig::RESOURCE_STATUS:
+        EnableResourceStatus(FLAGS_resource_status_topic, config);
+        break;
       case AdapterConfig::MOBILEYE:
         EnableMobileye(FLAGS_mobileye_topic, config);
         break;
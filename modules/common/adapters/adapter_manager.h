@@ -27,13 +27,20 @@
 #include <type_traits>
 #include <vector>
 
+#include "boost/make_shared.hpp"
+
 #include "modules/common/adapters/adapter.h"
+#include "modules/common/adapters/component_context.h"
 #include "modules/common/adapters/message_adapters.h"
 #include "modules/common/adapters/proto/adapter_config.pb.h"
+#include "modules/common/adapters/proto/adapter_stats.pb.h"
+#include "modules/common/adapters/shm_transport.h"
 #include "modules/common/log.h"
 #include "modules/common/macro.h"
+#include "modules/common/transform_listener/transform_cache.h"
 #include "modules/common/transform_listener/transform_listener.h"
 
+#include "ros/include/ros/callback_queue.h"
 #include "ros/include/ros/ros.h"
 
 /**
@@ -74,6 +81,10 @@ namespace adapter {
   static void Publish##name(const name##Adapter::DataType &data) {             \
     instance()->InternalPublish##name(data);                                   \
   }                                                                            \
+  /* Returns whether anyone receives the published data of the adapter. */     \
+  static bool Has##name##Subscribers() {                                       \
+    return instance()->InternalHas##name##Subscribers();                       \
+  }                                                                            \
   template <typename T>                                                        \
   static void Fill##name##Header(const std::string &module_name, T *data) {    \
     static_assert(std::is_same<name##Adapter::DataType, T>::value,             \
@@ -83,7 +94,7 @@ namespace adapter {
   static void Add##name##Callback(name##Adapter::Callback callback) {          \
     CHECK(instance()->name##_)                                                 \
         << "Initialize adapter before setting callback";                       \
-    instance()->name##_->AddCallback(callback);                                \
+    instance()->name##_->AddCallback(callback, ComponentExecutor());           \
   }                                                                            \
   template <class T>                                                           \
   static void Add##name##Callback(                                             \
@@ -104,33 +115,75 @@ namespace adapter {
   std::unique_ptr<name##Adapter> name##_;                                      \
   ros::Publisher name##publisher_;                                             \
   ros::Subscriber name##subscriber_;                                           \
+  std::unique_ptr<ShmWriter> name##shm_writer_;                                \
+  std::unique_ptr<ShmReader> name##shm_reader_;                                \
   AdapterConfig name##config_;                                                 \
                                                                                \
   void InternalEnable##name(const std::string &topic_name,                     \
                             const AdapterConfig &config) {                     \
+    if (intra_process_ && name##_) {                                           \
+      /* Another app of the process enabled it, keep its callbacks. */         \
+      name##config_.set_mode(MergeMode(name##config_.mode(), config.mode()));  \
+      ConnectRos(topic_name, name##config_, name##_.get(), &name##publisher_,  \
+                 &name##subscriber_);                                          \
+      return;                                                                  \
+    }                                                                          \
+    /* The shared memory reader calls the adapter back, stop it first. */      \
+    name##shm_reader_.reset();                                                 \
+    name##shm_writer_.reset();                                                 \
     name##_.reset(                                                             \
         new name##Adapter(#name, topic_name, config.message_history_limit())); \
-    if (config.mode() != AdapterConfig::PUBLISH_ONLY && IsRos()) {             \
-      name##subscriber_ =                                                      \
-          node_handle_->subscribe(topic_name, config.message_history_limit(),  \
-                                  &name##Adapter::OnReceive, name##_.get());   \
+    name##_->SetRetentionPolicy(config.retention_policy(),                     \
+                                config.retention_window_sec(),                 \
+                                config.retention_byte_budget());               \
+    const bool use_shm =                                                       \
+        config.use_shared_memory() && IsRos() && !intra_process_;              \
+    if (config.mode() != AdapterConfig::PUBLISH_ONLY && use_shm) {             \
+      name##shm_reader_ = SubscribeShm<name##Adapter::DataType>(               \
+          topic_name, std::bind(&name##Adapter::OnReceive, name##_.get(),      \
+                                std::placeholders::_1));                       \
     }                                                                          \
-    if (config.mode() != AdapterConfig::RECEIVE_ONLY && IsRos()) {             \
-      name##publisher_ = node_handle_->advertise<name##Adapter::DataType>(     \
-          topic_name, config.message_history_limit(), config.latch());         \
+    name##publisher_ = ros::Publisher();                                       \
+    name##subscriber_ = ros::Subscriber();                                     \
+    ConnectRos(topic_name, config, name##_.get(), &name##publisher_,           \
+               use_shm ? nullptr : &name##subscriber_);                        \
+    if (config.mode() != AdapterConfig::RECEIVE_ONLY && use_shm) {             \
+      name##shm_writer_.reset(                                                 \
+          new ShmWriter(topic_name, config.shared_memory_slot_count(),         \
+                        config.shared_memory_slot_size()));                    \
+      if (!name##shm_writer_->IsValid()) {                                     \
+        AERROR << #name << " only publishes through ROS.";                     \
+        name##shm_writer_.reset();                                             \
+      }                                                                        \
     }                                                                          \
                                                                                \
     observers_.push_back([this]() { name##_->Observe(); });                    \
+    stats_getters_.push_back(                                                  \
+        [this](AdapterStats *stats) { return name##_->GetStats(stats); });     \
+    memory_getters_.push_back(                                                 \
+        [this](AdapterMemory *memory) { name##_->GetMemory(memory); });        \
     name##config_ = config;                                                    \
   }                                                                            \
   name##Adapter *InternalGet##name() { return name##_.get(); }                 \
+  bool InternalHas##name##Subscribers() {                                      \
+    /* For non-ROS mode, the published data always triggers the callback. */   \
+    return !IsRos() || name##publisher_.getNumSubscribers() > 0 ||             \
+           (name##shm_writer_ && name##shm_writer_->HasReaders());             \
+  }                                                                            \
   void InternalPublish##name(const name##Adapter::DataType &data) {            \
     /* Only publish ROS msg if node handle is initialized. */                  \
     if (IsRos()) {                                                             \
-      if (!name##publisher_.getTopic().empty()) {                              \
-        name##publisher_.publish(data);                                        \
-      } else {                                                                 \
+      if (name##shm_writer_) {                                                 \
+        WriteShmMessage(data, name##shm_writer_.get());                        \
+      }                                                                        \
+      if (name##publisher_.getTopic().empty()) {                               \
         AERROR << #name << " is not valid.";                                   \
+      } else if (intra_process_) {                                             \
+        PublishShared(data, name##config_, &name##publisher_);                 \
+      } else if (!name##shm_writer_ ||                                         \
+                 name##publisher_.getNumSubscribers() > 0) {                   \
+        /* With shared memory, ROS only serves the ROS subscribers. */         \
+        name##publisher_.publish(data);                                        \
       }                                                                        \
     } else {                                                                   \
       /* For non-ROS mode, just triggers the callback. */                      \
@@ -186,23 +239,73 @@ class AdapterManager {
    */
   static bool Initialized();
 
+  /**
+   * @brief Observes all the enabled adapters. If --enable_adapter_stats is
+   * set, the adapter stats are also reported every
+   * --adapter_stats_report_interval_sec.
+   */
   static void Observe();
 
+  /**
+   * @brief Collects the instrumentation stats of all the enabled adapters.
+   * Adapters are only instrumented when --enable_adapter_stats is set.
+   * @param stats the output stats, one entry per instrumented adapter.
+   */
+  static void GetStats(AdapterManagerStats *stats);
+
+  /**
+   * @brief Collects the memory held by the messages of all the enabled
+   * adapters.
+   * @param memory the output memory, one entry per adapter, and their total.
+   */
+  static void GetMemory(AdapterManagerMemory *memory);
+
   /**
    * @brief Returns whether AdapterManager is running ROS mode.
    */
   static bool IsRos() { return instance()->node_handle_ != nullptr; }
 
+  /**
+   * @brief Makes the Apollo apps co-located in the process by the component
+   * runtime share the adapters. Every Init() then enables its adapters, the
+   * ones already enabled keeping their callbacks. The messages are published
+   * as shared pointers, which ROS passes as they are to the subscribers of
+   * the process, and only serializes for the other processes. The shared
+   * memory transport is not used. It must be called before Init().
+   */
+  static void EnableIntraProcess();
+
+  /**
+   * @brief Sets the callback queue of the component set up by the calling
+   * thread. The callbacks it adds to the adapters and the timers it creates
+   * are then run by the threads spinning the queue, in the context of the
+   * component, see CurrentComponent().
+   * @param queue the callback queue, or nullptr for the default one.
+   */
+  static void SetComponentCallbackQueue(ros::CallbackQueue *queue);
+
   /**
    * @brief Returns a reference to static tf2 buffer.
    */
   static tf2_ros::Buffer &Tf2Buffer() {
     static tf2_ros::Buffer tf2_buffer;
     static TransformListener tf2Listener(&tf2_buffer,
-                                         instance()->node_handle_.get());
+                                         instance()->node_handle_.get(), true,
+                                         &MutableTf2Cache());
     return tf2_buffer;
   }
 
+  /**
+   * @brief Returns a reference to the static cache of the transforms of the
+   * frame pairs in --tf2_cached_frame_pairs, which the listener of
+   * Tf2Buffer() fills. Its lookups take no lock and do not walk the tf2
+   * tree, so look the frequent transforms up there before Tf2Buffer().
+   */
+  static const TransformCache &Tf2Cache() {
+    Tf2Buffer();
+    return MutableTf2Cache();
+  }
+
   /**
    * @brief create a timer which will call a callback at the specified
    * rate. It takes a class member function, and a bare pointer to the
@@ -214,6 +317,18 @@ class AdapterManager {
                                 T *obj, bool oneshot = false,
                                 bool autostart = true) {
     if (IsRos()) {
+      ros::CallbackQueue *queue = ComponentCallbackQueue();
+      if (queue != nullptr) {
+        const int component = CurrentComponent();
+        ros::TimerOptions options(
+            period,
+            [callback, obj, component](const ros::TimerEvent &event) {
+              ScopedComponent scoped_component(component);
+              (obj->*callback)(event);
+            },
+            queue, oneshot, autostart);
+        return instance()->node_handle_->createTimer(options);
+      }
       return instance()->node_handle_->createTimer(period, callback, obj,
                                                    oneshot, autostart);
     } else {
@@ -224,6 +339,70 @@ class AdapterManager {
   }
 
  private:
+  static TransformCache &MutableTf2Cache();
+
+  static ros::CallbackQueue *ComponentCallbackQueue();
+
+  /// The executor of the callbacks added by the calling thread, nullptr to
+  /// run them on receipt.
+  static CallbackExecutor ComponentExecutor();
+
+  static AdapterConfig::Mode MergeMode(const AdapterConfig::Mode mode,
+                                       const AdapterConfig::Mode other_mode);
+
+  /**
+   * @brief Creates the ROS publisher and subscriber of an adapter the config
+   * needs, unless they are already created.
+   * @param subscriber the subscriber, nullptr if the adapter receives through
+   * the shared memory.
+   */
+  template <typename A>
+  void ConnectRos(const std::string &topic_name, const AdapterConfig &config,
+                  A *adapter, ros::Publisher *publisher,
+                  ros::Subscriber *subscriber) {
+    typedef typename A::DataType D;
+    if (!IsRos()) {
+      return;
+    }
+    if (config.mode() != AdapterConfig::PUBLISH_ONLY && subscriber &&
+        subscriber->getTopic().empty()) {
+      if (intra_process_) {
+        *subscriber = node_handle_->subscribe<D>(
+            topic_name, config.message_history_limit(),
+            boost::function<void(const boost::shared_ptr<const D> &)>(
+                [adapter](const boost::shared_ptr<const D> &message) {
+                  // The adapter keeps the ROS message as it is.
+                  adapter->OnReceiveShared(std::shared_ptr<const D>(
+                      message.get(), [message](const D *) {}));
+                }));
+      } else {
+        *subscriber =
+            node_handle_->subscribe(topic_name, config.message_history_limit(),
+                                    &A::OnReceive, adapter);
+      }
+    }
+    if (config.mode() != AdapterConfig::RECEIVE_ONLY &&
+        publisher->getTopic().empty()) {
+      *publisher = node_handle_->advertise<D>(
+          topic_name, config.message_history_limit(), config.latch());
+    }
+  }
+
+  /**
+   * @brief Publishes a message as a shared pointer, which is only copied if
+   * someone subscribes.
+   */
+  template <typename D>
+  static void PublishShared(const D &data, const AdapterConfig &config,
+                            ros::Publisher *publisher) {
+    if (publisher->getNumSubscribers() > 0 || config.latch()) {
+      publisher->publish(boost::make_shared<D>(data));
+    }
+  }
+
+  /// Whether the apps of the process share the adapters.
+  bool intra_process_ = false;
+
   /// The node handler of ROS, owned by the /class AdapterManager
   /// singleton.
   std::unique_ptr<ros::NodeHandle> node_handle_;
@@ -232,8 +411,23 @@ class AdapterManager {
   /// of enabled adapters.
   std::vector<std::function<void()>> observers_;
 
+  /// GetStats() callbacks of enabled adapters.
+  std::vector<std::function<bool(AdapterStats *)>> stats_getters_;
+
+  /// GetMemory() callbacks of enabled adapters.
+  std::vector<std::function<void(AdapterMemory *)>> memory_getters_;
+
+  /// Monotonic time of the last stats report.
+  double last_stats_report_time_ = 0.0;
+
   bool initialized_ = false;
 
+  /**
+   * @brief Logs the adapter stats, and publishes a monitor message about
+   * adapters dropping messages if the Monitor adapter is enabled.
+   */
+  void ReportStats();
+
   /// The following code registered all the adapters of interest.
   REGISTER_ADAPTER(Chassis);
   REGISTER_ADAPTER(ChassisDetail);
@@ -259,6 +453,7 @@ class AdapterManager {
   REGISTER_ADAPTER(GnssStatus);
   REGISTER_ADAPTER(SystemStatus);
   REGISTER_ADAPTER(StaticInfo);
+  REGISTER_ADAPTER(ResourceStatus);
   REGISTER_ADAPTER(Mobileye);
   REGISTER_ADAPTER(DelphiESR);
   REGISTER_ADAPTER(ContiRadar);
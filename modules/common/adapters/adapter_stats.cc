@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/adapters/adapter_stats.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace apollo {
+namespace common {
+namespace adapter {
+
+namespace {
+
+// Upper bounds of the histogram buckets in milliseconds.
+const double kBucketUpperBoundsMs[] = {1.0,   2.0,   5.0,   10.0,  20.0,
+                                       50.0,  100.0, 200.0, 500.0, 1000.0};
+const size_t kNumBounds =
+    sizeof(kBucketUpperBoundsMs) / sizeof(kBucketUpperBoundsMs[0]);
+
+}  // namespace
+
+LatencyRecorder::LatencyRecorder() : counts_(kNumBounds + 1, 0) {}
+
+void LatencyRecorder::Add(const double latency_ms) {
+  const double* bucket = std::lower_bound(
+      kBucketUpperBoundsMs, kBucketUpperBoundsMs + kNumBounds, latency_ms);
+  ++counts_[bucket - kBucketUpperBoundsMs];
+  ++total_count_;
+  sum_ms_ += latency_ms;
+  max_ms_ = std::max(max_ms_, latency_ms);
+}
+
+void LatencyRecorder::ToProto(LatencyHistogram* histogram) const {
+  histogram->Clear();
+  for (size_t i = 0; i < kNumBounds; ++i) {
+    histogram->add_upper_bound_ms(kBucketUpperBoundsMs[i]);
+  }
+  for (const uint64_t count : counts_) {
+    histogram->add_count(count);
+  }
+  histogram->set_total_count(total_count_);
+  if (total_count_ > 0) {
+    histogram->set_mean_ms(sum_ms_ / static_cast<double>(total_count_));
+  }
+  histogram->set_max_ms(max_ms_);
+}
+
+AdapterStatistics::AdapterStatistics(const std::string& adapter_name,
+                                     const std::string& topic_name,
+                                     size_t message_num)
+    : adapter_name_(adapter_name),
+      topic_name_(topic_name),
+      message_num_(message_num) {}
+
+double AdapterStatistics::MonotonicNowInSeconds() {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void AdapterStatistics::OnReceive() {
+  const double now = MonotonicNowInSeconds();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (received_count_ == 0) {
+    first_receive_time_ = now;
+  }
+  last_receive_time_ = now;
+  ++received_count_;
+
+  // Messages are not stored at all if the history size is 0.
+  if (message_num_ == 0) {
+    return;
+  }
+  pending_receive_times_.push_back(now);
+  if (pending_receive_times_.size() > message_num_) {
+    pending_receive_times_.pop_front();
+    ++dropped_count_;
+  }
+}
+
+void AdapterStatistics::OnObserve() {
+  const double now = MonotonicNowInSeconds();
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const double receive_time : pending_receive_times_) {
+    observe_latency_.Add((now - receive_time) * 1000.0);
+  }
+  pending_receive_times_.clear();
+}
+
+void AdapterStatistics::OnCallback(const size_t index,
+                                   const double duration_sec) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (callback_latency_.size() <= index) {
+    callback_latency_.resize(index + 1);
+  }
+  callback_latency_[index].Add(duration_sec * 1000.0);
+}
+
+void AdapterStatistics::GetStats(AdapterStats* stats) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats->Clear();
+  stats->set_adapter_name(adapter_name_);
+  stats->set_topic_name(topic_name_);
+  stats->set_received_count(received_count_);
+  stats->set_dropped_count(dropped_count_);
+  if (received_count_ > 1 && last_receive_time_ > first_receive_time_) {
+    stats->set_receive_rate_hz(static_cast<double>(received_count_ - 1) /
+                               (last_receive_time_ - first_receive_time_));
+  }
+  observe_latency_.ToProto(stats->mutable_receive_to_observe_latency());
+  for (size_t i = 0; i < callback_latency_.size(); ++i) {
+    auto* callback = stats->add_callback();
+    callback->set_index(static_cast<uint32_t>(i));
+    callback_latency_[i].ToProto(callback->mutable_execution_time());
+  }
+}
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_ADAPTERS_ADAPTER_STATS_H_
+#define MODULES_ADAPTERS_ADAPTER_STATS_H_
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "modules/common/adapters/proto/adapter_stats.pb.h"
+
+/**
+ * @namespace apollo::common::adapter
+ * @brief apollo::common::adapter
+ */
+namespace apollo {
+namespace common {
+namespace adapter {
+
+/**
+ * @class LatencyRecorder
+ * @brief A fixed-bucket histogram of durations in milliseconds.
+ */
+class LatencyRecorder {
+ public:
+  LatencyRecorder();
+
+  /**
+   * @brief adds one sample.
+   * @param latency_ms the duration in milliseconds.
+   */
+  void Add(const double latency_ms);
+
+  uint64_t total_count() const { return total_count_; }
+
+  /**
+   * @brief fills the histogram proto with the samples recorded so far.
+   */
+  void ToProto(LatencyHistogram* histogram) const;
+
+ private:
+  std::vector<uint64_t> counts_;
+  uint64_t total_count_ = 0;
+  double sum_ms_ = 0.0;
+  double max_ms_ = 0.0;
+};
+
+/**
+ * @class AdapterStatistics
+ * @brief Records the receive-to-observe latency, the drop count and the
+ * callback execution time of one adapter. All the methods are
+ * thread-safe.
+ *
+ * \par
+ * It is only created when --enable_adapter_stats is set, so adapters pay
+ * nothing when the instrumentation is off.
+ */
+class AdapterStatistics {
+ public:
+  /**
+   * @param adapter_name the name of the adapter.
+   * @param topic_name the topic that the adapter listens to.
+   * @param message_num the history size of the adapter. Messages beyond
+   * it that have not been observed are counted as dropped.
+   */
+  AdapterStatistics(const std::string& adapter_name,
+                    const std::string& topic_name, size_t message_num);
+
+  /**
+   * @brief records that a message has just been received.
+   */
+  void OnReceive();
+
+  /**
+   * @brief records that the adapter has just been observed. Every
+   * message received since the previous observation gets a latency
+   * sample.
+   */
+  void OnObserve();
+
+  /**
+   * @brief records the execution time of a receive callback.
+   * @param index the index of the callback in the order it was added.
+   * @param duration_sec the execution time in seconds.
+   */
+  void OnCallback(const size_t index, const double duration_sec);
+
+  /**
+   * @brief fills the stats proto with what was recorded so far.
+   */
+  void GetStats(AdapterStats* stats) const;
+
+  /**
+   * @brief returns the current time of a monotonic clock in seconds.
+   */
+  static double MonotonicNowInSeconds();
+
+ private:
+  std::string adapter_name_;
+  std::string topic_name_;
+  size_t message_num_ = 0;
+
+  uint64_t received_count_ = 0;
+  uint64_t dropped_count_ = 0;
+  double first_receive_time_ = 0.0;
+  double last_receive_time_ = 0.0;
+
+  /// Receive time of the messages not observed yet, oldest first.
+  std::deque<double> pending_receive_times_;
+
+  LatencyRecorder observe_latency_;
+  std::vector<LatencyRecorder> callback_latency_;
+
+  mutable std::mutex mutex_;
+};
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_ADAPTERS_ADAPTER_STATS_H_
@@ -18,6 +18,8 @@
 
 #include <string>
 #include <cmath>
+#include <thread>
+#include <vector>
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "modules/common/adapters/adapter_gflags.h"
@@ -113,6 +115,62 @@ TEST(AdapterTest, History) {
   }
 }
 
+TEST(AdapterTest, ObservedSnapshotIsImmutable) {
+  IntegerAdapter adapter("Integer", "integer_topic", 3);
+  adapter.OnReceive(1);
+  adapter.OnReceive(2);
+  adapter.Observe();
+
+  auto begin = adapter.begin();
+  auto end = adapter.end();
+  std::shared_ptr<const int> latest = adapter.GetLatestObservedPtr();
+
+  std::thread receiver([&adapter]() {
+    for (int i = 0; i < 1000; ++i) {
+      adapter.OnReceive(i + 100);
+    }
+  });
+  receiver.join();
+
+  // Messages received after Observe() do not touch the observed view.
+  EXPECT_EQ(2, std::distance(begin, end));
+  EXPECT_EQ(2, **begin);
+  EXPECT_EQ(2, *latest);
+  EXPECT_TRUE(adapter.HasReceived());
+
+  adapter.Observe();
+  EXPECT_EQ(3, std::distance(adapter.begin(), adapter.end()));
+  EXPECT_EQ(1099, adapter.GetLatestObserved());
+  EXPECT_EQ(1097, adapter.GetOldestObserved());
+  // The previous latest message is still alive through its pointer.
+  EXPECT_EQ(2, *latest);
+}
+
+TEST(AdapterTest, ClearData) {
+  IntegerAdapter adapter("Integer", "integer_topic", 3);
+  adapter.OnReceive(1);
+  adapter.Observe();
+  EXPECT_FALSE(adapter.Empty());
+
+  adapter.ClearData();
+  EXPECT_TRUE(adapter.Empty());
+  EXPECT_FALSE(adapter.HasReceived());
+  adapter.Observe();
+  EXPECT_TRUE(adapter.Empty());
+}
+
+TEST(AdapterTest, ReceivedCount) {
+  IntegerAdapter adapter("Integer", "integer_topic", 1);
+  EXPECT_EQ(0u, adapter.GetReceivedCount());
+  for (int i = 0; i < 5; ++i) {
+    adapter.OnReceive(i);
+  }
+  // Counted even though the history only keeps one message.
+  EXPECT_EQ(5u, adapter.GetReceivedCount());
+  adapter.ClearData();
+  EXPECT_EQ(5u, adapter.GetReceivedCount());
+}
+
 TEST(AdapterTest, Callback) {
   IntegerAdapter adapter("Integer", "integer_topic", 3);
 
@@ -126,8 +184,180 @@ TEST(AdapterTest, Callback) {
   EXPECT_EQ(11 + 41 + 31, count);
 }
 
+TEST(AdapterTest, CallbackExecutor) {
+  IntegerAdapter adapter("Integer", "integer_topic", 3);
+
+  std::vector<std::function<void()>> tasks;
+  int count = 0;
+  adapter.AddCallback([&count](int x) { count += x; },
+                      [&tasks](std::function<void()> task) {
+                        tasks.push_back(task);
+                      });
+
+  adapter.OnReceive(11);
+  adapter.OnReceive(41);
+  EXPECT_EQ(0, count);
+  ASSERT_EQ(2, tasks.size());
+  for (const auto& task : tasks) {
+    task();
+  }
+  EXPECT_EQ(11 + 41, count);
+}
+
+TEST(AdapterTest, ReceiveShared) {
+  IntegerAdapter adapter("Integer", "integer_topic", 3);
+  const int* received = nullptr;
+  adapter.AddCallback([&received](const int& x) { received = &x; });
+
+  auto message = std::make_shared<const int>(7);
+  adapter.OnReceiveShared(message);
+  adapter.Observe();
+  // The message is neither copied to the callback nor to the snapshot.
+  EXPECT_EQ(message.get(), received);
+  EXPECT_EQ(message.get(), &adapter.GetLatestObserved());
+}
+
+TEST(AdapterTest, ComponentObserve) {
+  IntegerAdapter adapter("Integer", "integer_topic", 3);
+  adapter.OnReceive(1);
+  {
+    ScopedComponent component(1);
+    adapter.Observe();
+    EXPECT_EQ(1, adapter.GetLatestObserved());
+    EXPECT_EQ(1, CurrentComponent());
+  }
+  EXPECT_EQ(0, CurrentComponent());
+  EXPECT_TRUE(adapter.Empty());
+
+  adapter.OnReceive(2);
+  adapter.Observe();
+  EXPECT_EQ(2, adapter.GetLatestObserved());
+  {
+    ScopedComponent component(1);
+    EXPECT_EQ(1, adapter.GetLatestObserved());
+  }
+
+  adapter.OnReceive(3);
+  adapter.OnReceive(4);
+  AdapterMemory memory;
+  // Received [4, 3, 2], observed [2, 1] and [1].
+  adapter.GetMemory(&memory);
+  EXPECT_EQ(4, memory.message_count());
+}
+
+TEST(AdapterTest, Stats) {
+  {
+    IntegerAdapter adapter("Integer", "integer_topic", 2);
+    AdapterStats stats;
+    EXPECT_FALSE(adapter.GetStats(&stats));
+  }
+
+  FLAGS_enable_adapter_stats = true;
+  IntegerAdapter adapter("Integer", "integer_topic", 2);
+  adapter.AddCallback([](int x) {});
+  adapter.OnReceive(1);
+  adapter.OnReceive(2);
+  adapter.OnReceive(3);
+  adapter.Observe();
+  // Nothing new to observe.
+  adapter.Observe();
+  FLAGS_enable_adapter_stats = false;
+
+  AdapterStats stats;
+  EXPECT_TRUE(adapter.GetStats(&stats));
+  EXPECT_EQ("Integer", stats.adapter_name());
+  EXPECT_EQ("integer_topic", stats.topic_name());
+  EXPECT_EQ(3, stats.received_count());
+  // Message 1 was pushed out of the history before being observed.
+  EXPECT_EQ(1, stats.dropped_count());
+  const auto& latency = stats.receive_to_observe_latency();
+  EXPECT_EQ(2, latency.total_count());
+  EXPECT_EQ(latency.upper_bound_ms_size() + 1, latency.count_size());
+  EXPECT_GE(latency.max_ms(), 0.0);
+  ASSERT_EQ(1, stats.callback_size());
+  EXPECT_EQ(3, stats.callback(0).execution_time().total_count());
+}
+
+TEST(AdapterTest, LatestOnly) {
+  IntegerAdapter adapter("Integer", "integer_topic", 10);
+  adapter.SetRetentionPolicy(AdapterConfig::LATEST_ONLY);
+  adapter.OnReceive(1);
+  adapter.OnReceive(2);
+  adapter.Observe();
+  std::vector<std::shared_ptr<int>> history(adapter.begin(), adapter.end());
+  ASSERT_EQ(1, history.size());
+  EXPECT_EQ(2, *history[0]);
+}
+
+TEST(AdapterTest, ByteBudget) {
+  IntegerAdapter adapter("Integer", "integer_topic", 10);
+  adapter.SetRetentionPolicy(AdapterConfig::BYTE_BUDGET, 0.0,
+                             2 * sizeof(int));
+  for (int i = 1; i <= 4; ++i) {
+    adapter.OnReceive(i);
+  }
+  adapter.Observe();
+  std::vector<std::shared_ptr<int>> history(adapter.begin(), adapter.end());
+  ASSERT_EQ(2, history.size());
+  EXPECT_EQ(4, *history[0]);
+  EXPECT_EQ(3, *history[1]);
+}
+
+TEST(AdapterTest, TimeWindow) {
+  using apollo::common::time::Clock;
+  Clock::SetMode(Clock::MOCK);
+  IntegerAdapter adapter("Integer", "integer_topic", 10);
+  adapter.SetRetentionPolicy(AdapterConfig::TIME_WINDOW, 1.5);
+  for (int i = 1; i <= 4; ++i) {
+    Clock::SetNow(apollo::common::time::From(i).time_since_epoch());
+    adapter.OnReceive(i);
+  }
+  adapter.Observe();
+  Clock::SetMode(Clock::SYSTEM);
+  // Message 2 is 2 seconds older than message 4.
+  std::vector<std::shared_ptr<int>> history(adapter.begin(), adapter.end());
+  ASSERT_EQ(2, history.size());
+  EXPECT_EQ(4, *history[0]);
+  EXPECT_EQ(3, *history[1]);
+}
+
+TEST(AdapterTest, Memory) {
+  IntegerAdapter adapter("Integer", "integer_topic", 3);
+  AdapterMemory memory;
+  adapter.GetMemory(&memory);
+  EXPECT_EQ("Integer", memory.adapter_name());
+  EXPECT_EQ(0, memory.message_count());
+  EXPECT_EQ(0, memory.bytes());
+
+  adapter.OnReceive(1);
+  adapter.OnReceive(2);
+  adapter.Observe();
+  adapter.OnReceive(3);
+  adapter.OnReceive(4);
+  // Received [4, 3, 2] and observed [2, 1].
+  adapter.GetMemory(&memory);
+  EXPECT_EQ(4, memory.message_count());
+  EXPECT_EQ(4 * sizeof(int), memory.bytes());
+
+  adapter.ClearData();
+  adapter.GetMemory(&memory);
+  EXPECT_EQ(0, memory.message_count());
+  EXPECT_EQ(0, memory.bytes());
+}
+
 using MyLocalizationAdapter = Adapter<localization::LocalizationEstimate>;
 
+TEST(AdapterTest, ProtoMemory) {
+  MyLocalizationAdapter adapter("local", "local_topic", 3);
+  localization::LocalizationEstimate msg;
+  msg.mutable_pose()->mutable_position()->set_x(1.0);
+  adapter.OnReceive(msg);
+  AdapterMemory memory;
+  adapter.GetMemory(&memory);
+  EXPECT_EQ(1, memory.message_count());
+  EXPECT_EQ(msg.SpaceUsed(), memory.bytes());
+}
+
 TEST(AdapterTest, Dump) {
   FLAGS_enable_adapter_dump = true;
   std::string temp_dir = std::getenv("TEST_TMPDIR");
@@ -0,0 +1,45 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/adapters/component_context.h"
+
+#include "glog/logging.h"
+
+namespace apollo {
+namespace common {
+namespace adapter {
+
+namespace {
+
+thread_local int current_component = 0;
+
+}  // namespace
+
+int CurrentComponent() { return current_component; }
+
+ScopedComponent::ScopedComponent(int component)
+    : previous_component_(current_component) {
+  CHECK_GE(component, 0);
+  CHECK_LT(component, kMaxComponents);
+  current_component = component;
+}
+
+ScopedComponent::~ScopedComponent() { current_component = previous_component_; }
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
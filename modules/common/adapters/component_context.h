@@ -0,0 +1,60 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_ADAPTERS_COMPONENT_CONTEXT_H_
+#define MODULES_ADAPTERS_COMPONENT_CONTEXT_H_
+
+/**
+ * @namespace apollo::common::adapter
+ * @brief apollo::common::adapter
+ */
+namespace apollo {
+namespace common {
+namespace adapter {
+
+/// The max number of Apollo apps co-located in a process by the component
+/// runtime. Each of them observes the adapters on its own.
+constexpr int kMaxComponents = 8;
+
+/**
+ * @brief Gets the component the calling thread works for, 0 out of the
+ * component runtime.
+ */
+int CurrentComponent();
+
+/**
+ * @class ScopedComponent
+ * @brief Makes the calling thread work for a component during its scope.
+ */
+class ScopedComponent {
+ public:
+  explicit ScopedComponent(int component);
+  ~ScopedComponent();
+
+ private:
+  int previous_component_;
+};
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_ADAPTERS_COMPONENT_CONTEXT_H_
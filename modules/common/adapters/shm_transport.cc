@@ -0,0 +1,315 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/adapters/shm_transport.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace adapter {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x41534d31;  // "ASM1"
+constexpr size_t kAlignment = 64;
+// The refs of a slot being written.
+constexpr int32_t kWriting = -1;
+// How long the readers wait for a message before checking whether the
+// segment was replaced.
+constexpr int kWaitTimeoutMs = 100;
+// How long the writer waits for the readers of the slot to reuse.
+constexpr int kWriteTimeoutMs = 10;
+
+size_t Align(const size_t size) {
+  return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+std::string SegmentName(const std::string &topic_name) {
+  std::string name = "/apollo";
+  for (const char c : topic_name) {
+    name += (c == '/' ? '_' : c);
+  }
+  return name;
+}
+
+// Waits until the word does not hold the value anymore, or the timeout.
+void FutexWait(std::atomic<uint32_t> *word, const uint32_t value,
+               const int timeout_ms) {
+  struct timespec timeout;
+  timeout.tv_sec = timeout_ms / 1000;
+  timeout.tv_nsec = (timeout_ms % 1000) * 1000000L;
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT, value,
+          &timeout, nullptr, 0);
+}
+
+void FutexWakeAll(std::atomic<uint32_t> *word) {
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE,
+          INT32_MAX, nullptr, nullptr, 0);
+}
+
+}  // namespace
+
+struct ShmSlot {
+  // The sequence number of the message in the slot, from 1.
+  std::atomic<uint64_t> sequence;
+  // The number of readers of the slot, or kWriting.
+  std::atomic<int32_t> refs;
+  uint64_t size;
+};
+
+struct ShmSegment {
+  std::atomic<uint32_t> magic;
+  std::atomic<uint32_t> closed;
+  uint64_t slot_count;
+  uint64_t slot_size;
+  // The sequence number of the latest message.
+  std::atomic<uint64_t> write_sequence;
+  // Incremented on every message for the readers to wait on.
+  std::atomic<uint32_t> notify;
+  // Attached readers. A crashed reader is never detached.
+  std::atomic<int32_t> num_readers;
+
+  static size_t SlotStride(const size_t slot_size) {
+    return Align(sizeof(ShmSlot)) + Align(slot_size);
+  }
+  static size_t MappedSize(const size_t slot_count, const size_t slot_size) {
+    return Align(sizeof(ShmSegment)) + slot_count * SlotStride(slot_size);
+  }
+
+  ShmSlot *Slot(const uint64_t sequence) {
+    return reinterpret_cast<ShmSlot *>(
+        reinterpret_cast<uint8_t *>(this) + Align(sizeof(ShmSegment)) +
+        (sequence - 1) % slot_count * SlotStride(slot_size));
+  }
+  static uint8_t *Data(ShmSlot *slot) {
+    return reinterpret_cast<uint8_t *>(slot) + Align(sizeof(ShmSlot));
+  }
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "The atomics shared between processes must be lock free");
+
+ShmWriter::ShmWriter(const std::string &topic_name, const size_t slot_count,
+                     const size_t slot_size)
+    : name_(SegmentName(topic_name)) {
+  if (slot_count == 0 || slot_size == 0) {
+    AERROR << "Invalid shared memory ring for " << topic_name;
+    return;
+  }
+  // The segment of a previous writer is unlinked, its readers move to the
+  // new one.
+  shm_unlink(name_.c_str());
+  const int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+  if (fd < 0) {
+    AERROR << "Failed to create shared memory " << name_ << ": "
+           << strerror(errno);
+    return;
+  }
+  mapped_size_ = ShmSegment::MappedSize(slot_count, slot_size);
+  void *address = MAP_FAILED;
+  if (ftruncate(fd, mapped_size_) == 0) {
+    address = mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   fd, 0);
+  }
+  close(fd);
+  if (address == MAP_FAILED) {
+    AERROR << "Failed to map shared memory " << name_ << ": "
+           << strerror(errno);
+    shm_unlink(name_.c_str());
+    return;
+  }
+  // The truncated file is zero filled, so every slot is free and empty.
+  segment_ = new (address) ShmSegment();
+  segment_->closed = 0;
+  segment_->slot_count = slot_count;
+  segment_->slot_size = slot_size;
+  segment_->write_sequence = 0;
+  segment_->notify = 0;
+  segment_->num_readers = 0;
+  segment_->magic.store(kMagic, std::memory_order_release);
+}
+
+ShmWriter::~ShmWriter() {
+  if (segment_ == nullptr) {
+    return;
+  }
+  segment_->closed = 1;
+  segment_->notify.fetch_add(1);
+  FutexWakeAll(&segment_->notify);
+  munmap(segment_, mapped_size_);
+  shm_unlink(name_.c_str());
+}
+
+bool ShmWriter::HasReaders() const {
+  return segment_ != nullptr && segment_->num_readers.load() > 0;
+}
+
+bool ShmWriter::Write(const size_t size,
+                      const std::function<bool(uint8_t *)> &serialize) {
+  if (segment_ == nullptr || size > segment_->slot_size) {
+    ++dropped_count_;
+    return false;
+  }
+  const uint64_t sequence =
+      segment_->write_sequence.load(std::memory_order_relaxed) + 1;
+  ShmSlot *slot = segment_->Slot(sequence);
+  // The readers only hold the slot while they parse the message.
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(kWriteTimeoutMs);
+  int32_t refs = 0;
+  while (!slot->refs.compare_exchange_weak(refs, kWriting)) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      AERROR_EVERY(100) << "The slot of " << name_
+                        << " is still read, dropping the message";
+      ++dropped_count_;
+      return false;
+    }
+    refs = 0;
+    std::this_thread::yield();
+  }
+  const bool serialized = serialize(ShmSegment::Data(slot));
+  if (serialized) {
+    slot->size = size;
+    slot->sequence.store(sequence, std::memory_order_release);
+  }
+  slot->refs.store(0, std::memory_order_release);
+  if (!serialized) {
+    ++dropped_count_;
+    return false;
+  }
+  segment_->write_sequence.store(sequence, std::memory_order_release);
+  segment_->notify.fetch_add(1);
+  if (segment_->num_readers.load() > 0) {
+    FutexWakeAll(&segment_->notify);
+  }
+  return true;
+}
+
+ShmReader::ShmReader(const std::string &topic_name, Callback callback)
+    : name_(SegmentName(topic_name)), callback_(std::move(callback)) {
+  thread_ = std::thread(&ShmReader::ThreadFunc, this);
+}
+
+ShmReader::~ShmReader() {
+  running_ = false;
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void ShmReader::ThreadFunc() {
+  while (running_) {
+    const int fd = shm_open(name_.c_str(), O_RDWR, 0);
+    struct stat status;
+    void *address = MAP_FAILED;
+    if (fd >= 0) {
+      if (fstat(fd, &status) == 0 &&
+          status.st_size >= static_cast<off_t>(sizeof(ShmSegment))) {
+        address = mmap(nullptr, status.st_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, fd, 0);
+      }
+      close(fd);
+    }
+    if (address == MAP_FAILED) {
+      // The writer has not created the segment yet.
+      std::this_thread::sleep_for(std::chrono::milliseconds(kWaitTimeoutMs));
+      continue;
+    }
+    auto *segment = static_cast<ShmSegment *>(address);
+    if (segment->magic.load(std::memory_order_acquire) == kMagic &&
+        ShmSegment::MappedSize(segment->slot_count, segment->slot_size) ==
+            static_cast<size_t>(status.st_size)) {
+      ReadSegment(segment, status.st_ino);
+    } else {
+      // The writer is still initializing the segment.
+      std::this_thread::sleep_for(std::chrono::milliseconds(kWaitTimeoutMs));
+    }
+    munmap(address, status.st_size);
+  }
+}
+
+void ShmReader::ReadSegment(ShmSegment *segment, const uint64_t inode) {
+  segment->num_readers.fetch_add(1);
+  // Starts with the latest message, as the subscribers of a latched topic.
+  uint64_t next = std::max<uint64_t>(segment->write_sequence.load(), 1);
+  while (running_ && segment->closed.load() == 0) {
+    const uint32_t notify = segment->notify.load();
+    const uint64_t latest =
+        segment->write_sequence.load(std::memory_order_acquire);
+    if (latest < next) {
+      FutexWait(&segment->notify, notify, kWaitTimeoutMs);
+      if (segment->notify.load() != notify) {
+        continue;
+      }
+      // No message for a while: the writer may have replaced the segment.
+      const int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+      struct stat status;
+      const bool replaced = fd < 0 || fstat(fd, &status) != 0 ||
+                            static_cast<uint64_t>(status.st_ino) != inode;
+      if (fd >= 0) {
+        close(fd);
+      }
+      if (replaced) {
+        break;
+      }
+      continue;
+    }
+    if (latest - next >= segment->slot_count) {
+      // The writer is a whole ring ahead.
+      const uint64_t first = latest - segment->slot_count + 1;
+      lost_count_ += first - next;
+      next = first;
+    }
+    ShmSlot *slot = segment->Slot(next);
+    int32_t refs = slot->refs.load();
+    while (refs != kWriting &&
+           !slot->refs.compare_exchange_weak(refs, refs + 1)) {
+    }
+    if (refs == kWriting) {
+      // The slot is being overwritten by a newer message.
+      ++lost_count_;
+    } else {
+      if (slot->sequence.load(std::memory_order_acquire) == next) {
+        callback_(ShmSegment::Data(slot), slot->size);
+      } else {
+        ++lost_count_;
+      }
+      slot->refs.fetch_sub(1, std::memory_order_release);
+    }
+    ++next;
+  }
+  segment->num_readers.fetch_sub(1);
+}
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,233 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_ADAPTERS_SHM_TRANSPORT_H_
+#define MODULES_ADAPTERS_SHM_TRANSPORT_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "google/protobuf/message.h"
+
+#include "ros/include/ros/serialization.h"
+
+/**
+ * @namespace apollo::common::adapter
+ * @brief apollo::common::adapter
+ */
+namespace apollo {
+namespace common {
+namespace adapter {
+
+struct ShmSegment;
+
+/**
+ * @class ShmWriter
+ * @brief Publishes the messages of a topic to the processes of the host
+ * through a ring of slots in /dev/shm, without going through the network
+ * stack.
+ *
+ * \par
+ * A message is serialized straight into its slot and parsed straight from
+ * it by the readers, which hold a reference on the slot meanwhile. The
+ * slot of a message is only reused by the message published slot_count
+ * messages later, once no reader references it anymore.
+ *
+ * \note
+ * A topic has at most one writer in the host: the segment of a previous
+ * writer of the topic is replaced.
+ */
+class ShmWriter {
+ public:
+  /**
+   * @brief Creates the segment of the topic.
+   * @param topic_name the topic of the messages.
+   * @param slot_count the number of messages the ring holds.
+   * @param slot_size the max serialized size of a message.
+   */
+  ShmWriter(const std::string &topic_name, size_t slot_count,
+            size_t slot_size);
+
+  /**
+   * @brief Removes the segment, the readers stop reading it.
+   */
+  ~ShmWriter();
+
+  /**
+   * @brief returns false if the segment could not be created.
+   */
+  bool IsValid() const { return segment_ != nullptr; }
+
+  /**
+   * @brief Writes a message to the next slot and wakes the readers up.
+   * @param size the serialized size of the message.
+   * @param serialize serializes the message into the given buffer of size
+   * bytes.
+   * @return false if the message is larger than a slot, or if the slot is
+   * still read, in which case the message is not published.
+   */
+  bool Write(size_t size, const std::function<bool(uint8_t *)> &serialize);
+
+  /**
+   * @brief returns TRUE if a reader is attached to the segment.
+   */
+  bool HasReaders() const;
+
+  /**
+   * @brief returns the number of messages which could not be written.
+   */
+  uint64_t dropped_count() const { return dropped_count_; }
+
+ private:
+  std::string name_;
+  ShmSegment *segment_ = nullptr;
+  size_t mapped_size_ = 0;
+  std::atomic<uint64_t> dropped_count_{0};
+};
+
+/**
+ * @class ShmReader
+ * @brief Receives the messages a ShmWriter publishes to the topic, on a
+ * thread of its own. The reader waits for the segment if it does not exist
+ * yet, and moves to the new segment if the writer restarts.
+ */
+class ShmReader {
+ public:
+  typedef std::function<void(const uint8_t *, size_t)> Callback;
+
+  /**
+   * @brief Starts receiving the messages, from the latest one published.
+   * @param topic_name the topic of the messages.
+   * @param callback called for every message with its serialized bytes,
+   * which are only valid during the call.
+   */
+  ShmReader(const std::string &topic_name, Callback callback);
+
+  /**
+   * @brief Stops the receiving thread.
+   */
+  ~ShmReader();
+
+  /**
+   * @brief returns the number of messages overwritten before they were
+   * read.
+   */
+  uint64_t lost_count() const { return lost_count_; }
+
+ private:
+  void ThreadFunc();
+
+  // Reads the messages of the segment until it is closed or replaced, or
+  // the reader is stopped.
+  void ReadSegment(ShmSegment *segment, uint64_t inode);
+
+  std::string name_;
+  Callback callback_;
+  std::atomic<bool> running_{true};
+  std::atomic<uint64_t> lost_count_{0};
+  std::thread thread_;
+};
+
+/**
+ * @brief Publishes a proto message to the segment.
+ */
+template <typename D>
+bool WriteShmMessage(
+    const D &message, ShmWriter *writer,
+    typename std::enable_if<
+        std::is_base_of<google::protobuf::Message, D>::value>::type * =
+        nullptr) {
+  const int size = message.ByteSize();
+  return writer->Write(size, [&message](uint8_t *buffer) {
+    message.SerializeWithCachedSizesToArray(buffer);
+    return true;
+  });
+}
+
+/**
+ * @brief Publishes a ROS message to the segment.
+ */
+template <typename D>
+bool WriteShmMessage(
+    const D &message, ShmWriter *writer,
+    typename std::enable_if<
+        !std::is_base_of<google::protobuf::Message, D>::value>::type * =
+        nullptr) {
+  const uint32_t size = ros::serialization::serializationLength(message);
+  return writer->Write(size, [&message, size](uint8_t *buffer) {
+    ros::serialization::OStream stream(buffer, size);
+    ros::serialization::serialize(stream, message);
+    return true;
+  });
+}
+
+/**
+ * @brief Parses a proto message read from a segment.
+ */
+template <typename D>
+bool ReadShmMessage(
+    const uint8_t *data, size_t size, D *message,
+    typename std::enable_if<
+        std::is_base_of<google::protobuf::Message, D>::value>::type * =
+        nullptr) {
+  return message->ParseFromArray(data, static_cast<int>(size));
+}
+
+/**
+ * @brief Parses a ROS message read from a segment.
+ */
+template <typename D>
+bool ReadShmMessage(
+    const uint8_t *data, size_t size, D *message,
+    typename std::enable_if<
+        !std::is_base_of<google::protobuf::Message, D>::value>::type * =
+        nullptr) {
+  ros::serialization::IStream stream(const_cast<uint8_t *>(data),
+                                     static_cast<uint32_t>(size));
+  ros::serialization::deserialize(stream, *message);
+  return true;
+}
+
+/**
+ * @brief Creates a reader calling the callback with the parsed messages.
+ */
+template <typename D>
+std::unique_ptr<ShmReader> SubscribeShm(
+    const std::string &topic_name, std::function<void(const D &)> callback) {
+  return std::unique_ptr<ShmReader>(new ShmReader(
+      topic_name, [callback](const uint8_t *data, size_t size) {
+        D message;
+        if (ReadShmMessage(data, size, &message)) {
+          callback(message);
+        }
+      }));
+}
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_ADAPTERS_SHM_TRANSPORT_H_
@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/adapters/shm_transport.h"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/localization/proto/localization.pb.h"
+
+namespace apollo {
+namespace common {
+namespace adapter {
+
+using apollo::localization::LocalizationEstimate;
+
+namespace {
+
+class Received {
+ public:
+  void Add(const LocalizationEstimate& message) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sequence_nums_.push_back(message.header().sequence_num());
+  }
+
+  // Waits for the number of messages, returns the received ones.
+  std::vector<uint32_t> WaitFor(const size_t count) {
+    for (int i = 0; i < 200; ++i) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (sequence_nums_.size() >= count) {
+          return sequence_nums_;
+        }
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return sequence_nums_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<uint32_t> sequence_nums_;
+};
+
+bool WaitForReaders(const ShmWriter& writer) {
+  for (int i = 0; i < 200 && !writer.HasReaders(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return writer.HasReaders();
+}
+
+LocalizationEstimate MakeMessage(const uint32_t sequence_num) {
+  LocalizationEstimate message;
+  message.mutable_header()->set_sequence_num(sequence_num);
+  message.mutable_pose()->mutable_position()->set_x(sequence_num);
+  return message;
+}
+
+}  // namespace
+
+TEST(ShmTransportTest, WriteRead) {
+  ShmWriter writer("/shm_transport_test/write_read", 4, 1024);
+  ASSERT_TRUE(writer.IsValid());
+  EXPECT_FALSE(writer.HasReaders());
+  // The latest message is received by the readers attached later.
+  EXPECT_TRUE(WriteShmMessage(MakeMessage(1), &writer));
+
+  Received received;
+  auto reader = SubscribeShm<LocalizationEstimate>(
+      "/shm_transport_test/write_read",
+      [&received](const LocalizationEstimate& message) {
+        received.Add(message);
+      });
+  ASSERT_TRUE(WaitForReaders(writer));
+  EXPECT_EQ(std::vector<uint32_t>({1}), received.WaitFor(1));
+  for (uint32_t i = 2; i <= 10; ++i) {
+    EXPECT_TRUE(WriteShmMessage(MakeMessage(i), &writer));
+    // Keeps the writer less than a ring ahead of the reader.
+    received.WaitFor(i);
+  }
+  const auto sequence_nums = received.WaitFor(10);
+  ASSERT_EQ(10, sequence_nums.size());
+  for (uint32_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(i + 1, sequence_nums[i]);
+  }
+  EXPECT_EQ(0, writer.dropped_count());
+  EXPECT_EQ(0, reader->lost_count());
+
+  reader.reset();
+  EXPECT_FALSE(writer.HasReaders());
+}
+
+TEST(ShmTransportTest, TooLarge) {
+  ShmWriter writer("/shm_transport_test/too_large", 2, 8);
+  ASSERT_TRUE(writer.IsValid());
+  EXPECT_FALSE(WriteShmMessage(MakeMessage(1), &writer));
+  EXPECT_EQ(1, writer.dropped_count());
+}
+
+TEST(ShmTransportTest, WriterRestart) {
+  Received received;
+  // The reader waits for the segment to be created.
+  auto reader = SubscribeShm<LocalizationEstimate>(
+      "/shm_transport_test/restart",
+      [&received](const LocalizationEstimate& message) {
+        received.Add(message);
+      });
+  {
+    ShmWriter writer("/shm_transport_test/restart", 4, 1024);
+    ASSERT_TRUE(WaitForReaders(writer));
+    EXPECT_TRUE(WriteShmMessage(MakeMessage(1), &writer));
+    EXPECT_EQ(1, received.WaitFor(1).size());
+  }
+  ShmWriter writer("/shm_transport_test/restart", 4, 1024);
+  ASSERT_TRUE(WaitForReaders(writer));
+  EXPECT_TRUE(WriteShmMessage(MakeMessage(2), &writer));
+  EXPECT_EQ(std::vector<uint32_t>({1, 2}), received.WaitFor(2));
+}
+
+}  // namespace adapter
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Replaces the global operator new and delete to count the heap
+ * allocations with the AllocTracker. Link it into a binary to track it.
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include "modules/common/alloc_tracker/alloc_tracker.h"
+
+namespace {
+
+using apollo::common::alloc_tracker::AllocTracker;
+
+// Inlined into the operators, so that the sampled call stacks skip a known
+// number of frames.
+inline __attribute__((always_inline)) void *Allocate(const size_t size) {
+  const size_t alloc_size = size == 0 ? 1 : size;
+  while (true) {
+    void *ptr = std::malloc(alloc_size);
+    if (ptr != nullptr) {
+      AllocTracker::OnAlloc(size);
+      return ptr;
+    }
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void *AllocateNoThrow(const size_t size) noexcept {
+  try {
+    return Allocate(size);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void Deallocate(void *ptr) noexcept {
+  if (ptr != nullptr) {
+    AllocTracker::OnFree();
+    std::free(ptr);
+  }
+}
+
+struct HooksRegistration {
+  HooksRegistration() { AllocTracker::SetHooksLinked(); }
+} hooks_registration;
+
+}  // namespace
+
+void *operator new(size_t size) { return Allocate(size); }
+
+void *operator new[](size_t size) { return Allocate(size); }
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  return AllocateNoThrow(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  return AllocateNoThrow(size);
+}
+
+void operator delete(void *ptr) noexcept { Deallocate(ptr); }
+
+void operator delete[](void *ptr) noexcept { Deallocate(ptr); }
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  Deallocate(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  Deallocate(ptr);
+}
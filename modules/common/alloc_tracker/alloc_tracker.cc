@@ -0,0 +1,335 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#include "modules/common/alloc_tracker/alloc_tracker.h"
+
+#include <execinfo.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+DEFINE_bool(enable_alloc_tracking, false,
+            "Count the heap allocations of the app per thread and per code "
+            "region, if the binary links the allocation hooks.");
+DEFINE_int64(alloc_sampling_bytes, 1 << 20,
+             "Sampling interval in bytes of the call stacks of the heap "
+             "allocations, none are sampled if it is 0.");
+DEFINE_int32(alloc_report_sites, 10,
+             "Number of the hottest allocation sites reported.");
+
+namespace apollo {
+namespace common {
+namespace alloc_tracker {
+
+namespace {
+
+// The threads after the first kMaxThreads ones share the last slot.
+constexpr int kMaxThreads = 256;
+// The number of distinct call stacks sampled, the next ones are dropped.
+constexpr int kMaxSites = 1024;
+constexpr int kMaxFrames = 8;
+// Sample(), AllocTracker::OnAlloc() and the operator new.
+constexpr int kSkippedFrames = 3;
+
+// The counters of a thread, only written by the thread unless it shares the
+// last slot.
+struct ThreadSlot {
+  std::atomic<int64_t> tid{0};
+  std::atomic<uint64_t> num_allocs{0};
+  std::atomic<uint64_t> num_bytes{0};
+  std::atomic<uint64_t> num_frees{0};
+};
+
+struct Site {
+  // 0 for an unused site
+  uint64_t hash = 0;
+  int num_frames = 0;
+  void *frames[kMaxFrames];
+  uint64_t num_samples = 0;
+  uint64_t num_bytes = 0;
+};
+
+std::atomic<bool> g_enabled(false);
+std::atomic<bool> g_hooks_linked(false);
+std::atomic<uint64_t> g_sampling_bytes(0);
+
+ThreadSlot g_thread_slots[kMaxThreads];
+std::atomic<int> g_num_thread_slots(0);
+
+// The sites are recorded without any allocation, as the hooks call it.
+std::mutex g_sites_mutex;
+Site g_sites[kMaxSites];
+uint64_t g_num_dropped_samples = 0;
+
+std::mutex g_regions_mutex;
+// Never destroyed, the threads may still enter regions at exit.
+std::map<std::string, RegionStats> *g_regions =
+    new std::map<std::string, RegionStats>();
+
+thread_local int tls_slot = -1;
+thread_local int64_t tls_bytes_until_sample = 0;
+// Set while the tracker works on the thread, so that its own allocations
+// are neither counted nor sampled.
+thread_local bool tls_in_tracker = false;
+
+class TrackerScope {
+ public:
+  TrackerScope() : previous_(tls_in_tracker) { tls_in_tracker = true; }
+  ~TrackerScope() { tls_in_tracker = previous_; }
+
+ private:
+  bool previous_;
+};
+
+ThreadSlot *CurrentSlot() {
+  if (tls_slot < 0) {
+    tls_slot = std::min(g_num_thread_slots.fetch_add(1), kMaxThreads - 1);
+    g_thread_slots[tls_slot].tid = syscall(SYS_gettid);
+    tls_bytes_until_sample = static_cast<int64_t>(g_sampling_bytes.load());
+  }
+  return &g_thread_slots[tls_slot];
+}
+
+__attribute__((noinline)) void Sample(const size_t size) {
+  TrackerScope scope;
+  void *frames[kMaxFrames + kSkippedFrames];
+  const int depth = backtrace(frames, kMaxFrames + kSkippedFrames);
+  const int num_frames = std::max(depth - kSkippedFrames, 0);
+  void **site_frames = frames + kSkippedFrames;
+
+  // FNV-1a of the return addresses
+  uint64_t hash = 14695981039346656037ULL;
+  for (int i = 0; i < num_frames; ++i) {
+    hash ^= reinterpret_cast<uintptr_t>(site_frames[i]);
+    hash *= 1099511628211ULL;
+  }
+  hash |= 1;
+
+  std::lock_guard<std::mutex> lock(g_sites_mutex);
+  for (int probe = 0; probe < kMaxSites; ++probe) {
+    Site &site = g_sites[(hash + probe) % kMaxSites];
+    if (site.hash == 0) {
+      site.hash = hash;
+      site.num_frames = num_frames;
+      std::copy(site_frames, site_frames + num_frames, site.frames);
+    } else if (site.hash != hash || site.num_frames != num_frames ||
+               !std::equal(site_frames, site_frames + num_frames,
+                           site.frames)) {
+      continue;
+    }
+    ++site.num_samples;
+    site.num_bytes += size;
+    return;
+  }
+  ++g_num_dropped_samples;
+}
+
+std::string ThreadName(const int64_t tid) {
+  std::ifstream fin("/proc/self/task/" + std::to_string(tid) + "/comm");
+  std::string name;
+  if (!std::getline(fin, name)) {
+    return "exited";
+  }
+  return name;
+}
+
+}  // namespace
+
+AllocCounts &AllocCounts::operator+=(const AllocCounts &other) {
+  num_allocs += other.num_allocs;
+  num_bytes += other.num_bytes;
+  num_frees += other.num_frees;
+  return *this;
+}
+
+AllocCounts AllocCounts::operator-(const AllocCounts &other) const {
+  AllocCounts counts;
+  counts.num_allocs = num_allocs - other.num_allocs;
+  counts.num_bytes = num_bytes - other.num_bytes;
+  counts.num_frees = num_frees - other.num_frees;
+  return counts;
+}
+
+void AllocTracker::Enable(const uint64_t sampling_bytes) {
+  g_sampling_bytes = sampling_bytes;
+  g_enabled = true;
+}
+
+void AllocTracker::Disable() { g_enabled = false; }
+
+bool AllocTracker::enabled() {
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+bool AllocTracker::hooks_linked() { return g_hooks_linked; }
+
+void AllocTracker::SetHooksLinked() { g_hooks_linked = true; }
+
+void AllocTracker::OnAlloc(const size_t size) {
+  if (!g_enabled.load(std::memory_order_relaxed) || tls_in_tracker) {
+    return;
+  }
+  ThreadSlot *slot = CurrentSlot();
+  slot->num_allocs.fetch_add(1, std::memory_order_relaxed);
+  slot->num_bytes.fetch_add(size, std::memory_order_relaxed);
+  const uint64_t sampling_bytes =
+      g_sampling_bytes.load(std::memory_order_relaxed);
+  if (sampling_bytes == 0) {
+    return;
+  }
+  tls_bytes_until_sample -= static_cast<int64_t>(size);
+  if (tls_bytes_until_sample <= 0) {
+    // not a tail call, which would drop the frame of OnAlloc()
+    Sample(size);
+    tls_bytes_until_sample = static_cast<int64_t>(sampling_bytes);
+  }
+}
+
+void AllocTracker::OnFree() {
+  if (!g_enabled.load(std::memory_order_relaxed) || tls_in_tracker) {
+    return;
+  }
+  CurrentSlot()->num_frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+AllocCounts AllocTracker::ThreadCounts() {
+  AllocCounts counts;
+  if (tls_slot < 0) {
+    return counts;
+  }
+  const ThreadSlot &slot = g_thread_slots[tls_slot];
+  counts.num_allocs = slot.num_allocs.load(std::memory_order_relaxed);
+  counts.num_bytes = slot.num_bytes.load(std::memory_order_relaxed);
+  counts.num_frees = slot.num_frees.load(std::memory_order_relaxed);
+  return counts;
+}
+
+void AllocTracker::AddRegionEntry(const std::string &name,
+                                  const AllocCounts &counts) {
+  TrackerScope scope;
+  std::lock_guard<std::mutex> lock(g_regions_mutex);
+  RegionStats &stats = (*g_regions)[name];
+  ++stats.num_entries;
+  stats.counts += counts;
+  stats.max_allocs = std::max(stats.max_allocs, counts.num_allocs);
+}
+
+std::vector<std::pair<std::string, RegionStats>>
+AllocTracker::GetRegionStats() {
+  TrackerScope scope;
+  std::lock_guard<std::mutex> lock(g_regions_mutex);
+  return std::vector<std::pair<std::string, RegionStats>>(g_regions->begin(),
+                                                          g_regions->end());
+}
+
+std::string AllocTracker::Report(const int num_sites) {
+  TrackerScope scope;
+  std::ostringstream oss;
+  oss << "allocations per thread:";
+  const int num_slots = std::min(g_num_thread_slots.load(), kMaxThreads);
+  for (int i = 0; i < num_slots; ++i) {
+    const ThreadSlot &slot = g_thread_slots[i];
+    const int64_t tid = slot.tid;
+    oss << "\n  " << ThreadName(tid) << " (" << tid << ")"
+        << (i == kMaxThreads - 1 ? " and the next threads" : "") << ": "
+        << slot.num_allocs << " allocs, " << slot.num_bytes << " bytes, "
+        << slot.num_frees << " frees";
+  }
+
+  auto regions = GetRegionStats();
+  std::sort(regions.begin(), regions.end(),
+            [](const std::pair<std::string, RegionStats> &a,
+               const std::pair<std::string, RegionStats> &b) {
+              return a.second.counts.num_bytes > b.second.counts.num_bytes;
+            });
+  oss << "\nallocations per region:";
+  for (const auto &region : regions) {
+    const RegionStats &stats = region.second;
+    oss << "\n  " << region.first << ": " << stats.num_entries
+        << " entries, " << stats.counts.num_allocs / stats.num_entries
+        << " allocs and " << stats.counts.num_bytes / stats.num_entries
+        << " bytes per entry, at most " << stats.max_allocs << " allocs";
+  }
+
+  std::vector<Site> sites;
+  uint64_t num_samples = 0;
+  uint64_t num_dropped_samples = 0;
+  {
+    std::lock_guard<std::mutex> lock(g_sites_mutex);
+    for (const Site &site : g_sites) {
+      if (site.hash != 0) {
+        sites.push_back(site);
+        num_samples += site.num_samples;
+      }
+    }
+    num_dropped_samples = g_num_dropped_samples;
+  }
+  std::sort(sites.begin(), sites.end(), [](const Site &a, const Site &b) {
+    return a.num_samples > b.num_samples;
+  });
+  oss << "\nhot allocation sites, of " << num_samples << " samples ("
+      << num_dropped_samples << " dropped):";
+  for (int i = 0; i < std::min(num_sites, static_cast<int>(sites.size()));
+       ++i) {
+    const Site &site = sites[i];
+    oss << "\n  #" << i << ": " << site.num_samples << " samples ("
+        << 100.0 * site.num_samples / num_samples << "%), "
+        << site.num_bytes / site.num_samples << " bytes per sample";
+    char **symbols = backtrace_symbols(site.frames, site.num_frames);
+    for (int j = 0; j < site.num_frames; ++j) {
+      oss << "\n    " << (symbols != nullptr ? symbols[j] : "?");
+    }
+    free(symbols);
+  }
+  return oss.str();
+}
+
+ScopedAllocRegion::ScopedAllocRegion(const std::string &name)
+    : enabled_(AllocTracker::enabled()) {
+  if (enabled_) {
+    name_ = name;
+    start_counts_ = AllocTracker::ThreadCounts();
+  }
+}
+
+ScopedAllocRegion::~ScopedAllocRegion() {
+  if (enabled_) {
+    AllocTracker::AddRegionEntry(name_, Elapsed());
+  }
+}
+
+AllocCounts ScopedAllocRegion::Elapsed() const {
+  if (!enabled_) {
+    return AllocCounts();
+  }
+  return AllocTracker::ThreadCounts() - start_counts_;
+}
+
+}  // namespace alloc_tracker
+}  // namespace common
+}  // namespace apollo
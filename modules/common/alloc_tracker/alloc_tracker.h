@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Counting of the heap allocations per thread and per code region.
+ */
+
+#ifndef MODULES_COMMON_ALLOC_TRACKER_ALLOC_TRACKER_H_
+#define MODULES_COMMON_ALLOC_TRACKER_ALLOC_TRACKER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+DECLARE_bool(enable_alloc_tracking);
+DECLARE_int64(alloc_sampling_bytes);
+DECLARE_int32(alloc_report_sites);
+
+/**
+ * @namespace apollo::common::alloc_tracker
+ * @brief apollo::common::alloc_tracker
+ */
+namespace apollo {
+namespace common {
+namespace alloc_tracker {
+
+/**
+ * @struct AllocCounts
+ * @brief The allocations of a thread or of a code region.
+ */
+struct AllocCounts {
+  uint64_t num_allocs = 0;
+  uint64_t num_bytes = 0;
+  uint64_t num_frees = 0;
+
+  AllocCounts &operator+=(const AllocCounts &other);
+  AllocCounts operator-(const AllocCounts &other) const;
+};
+
+/**
+ * @struct RegionStats
+ * @brief The allocations of the entries in a code region, inclusive of the
+ * regions nested in it.
+ */
+struct RegionStats {
+  uint64_t num_entries = 0;
+  AllocCounts counts;
+  // the most allocations of an entry
+  uint64_t max_allocs = 0;
+};
+
+/**
+ * @class AllocTracker
+ * @brief Counts the allocations made with the operator new, when the hooks of
+ * alloc_hooks are linked into the binary and the tracking is enabled. The
+ * call stacks of the allocations are sampled about once every sampling
+ * interval of bytes a thread allocates, to find the hot allocation sites.
+ */
+class AllocTracker {
+ public:
+  /**
+   * @brief Starts the tracking.
+   * @param sampling_bytes the sampling interval, no sampling if it is 0
+   */
+  static void Enable(uint64_t sampling_bytes);
+
+  static void Disable();
+
+  static bool enabled();
+
+  /**
+   * @brief Whether the hooks are linked into the binary.
+   */
+  static bool hooks_linked();
+
+  /**
+   * @brief Gets the allocations of the calling thread since it started.
+   */
+  static AllocCounts ThreadCounts();
+
+  /**
+   * @brief Gets the allocations of the code regions, by name.
+   */
+  static std::vector<std::pair<std::string, RegionStats>> GetRegionStats();
+
+  /**
+   * @brief Gets a report of the allocations per thread, per region and of
+   * the hottest sampled sites.
+   * @param num_sites the number of hot sites to report
+   */
+  static std::string Report(int num_sites);
+
+  // Called by the hooks.
+  static void OnAlloc(size_t size);
+  static void OnFree();
+  static void SetHooksLinked();
+
+  // Called by ScopedAllocRegion.
+  static void AddRegionEntry(const std::string &name,
+                             const AllocCounts &counts);
+};
+
+/**
+ * @class ScopedAllocRegion
+ * @brief Counts the allocations of the calling thread during its scope into
+ * a named code region.
+ */
+class ScopedAllocRegion {
+ public:
+  explicit ScopedAllocRegion(const std::string &name);
+  ~ScopedAllocRegion();
+
+  /**
+   * @brief Gets the allocations of the thread since the region started.
+   */
+  AllocCounts Elapsed() const;
+
+ private:
+  std::string name_;
+  bool enabled_ = false;
+  AllocCounts start_counts_;
+};
+
+}  // namespace alloc_tracker
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_ALLOC_TRACKER_ALLOC_TRACKER_H_
@@ -0,0 +1,112 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/alloc_tracker/alloc_tracker.h"
+
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace alloc_tracker {
+
+namespace {
+
+constexpr int kNumAllocs = 10;
+
+__attribute__((noinline)) void AllocateAndFree(const size_t size) {
+  char *buffers[kNumAllocs];
+  for (int i = 0; i < kNumAllocs; ++i) {
+    buffers[i] = new char[size];
+  }
+  for (int i = 0; i < kNumAllocs; ++i) {
+    delete[] buffers[i];
+  }
+}
+
+}  // namespace
+
+class AllocTrackerTest : public ::testing::Test {
+ protected:
+  void SetUp() override { AllocTracker::Enable(0); }
+  void TearDown() override { AllocTracker::Disable(); }
+};
+
+TEST_F(AllocTrackerTest, ThreadCounts) {
+  ASSERT_TRUE(AllocTracker::hooks_linked());
+  AllocCounts counts;
+  std::thread thread([&counts]() {
+    const AllocCounts start = AllocTracker::ThreadCounts();
+    AllocateAndFree(16);
+    counts = AllocTracker::ThreadCounts() - start;
+  });
+  thread.join();
+  EXPECT_EQ(kNumAllocs, counts.num_allocs);
+  EXPECT_EQ(kNumAllocs * 16, counts.num_bytes);
+  EXPECT_EQ(kNumAllocs, counts.num_frees);
+}
+
+TEST_F(AllocTrackerTest, Region) {
+  AllocCounts elapsed;
+  {
+    ScopedAllocRegion region("test_region");
+    AllocateAndFree(32);
+    elapsed = region.Elapsed();
+  }
+  EXPECT_EQ(kNumAllocs, elapsed.num_allocs);
+  EXPECT_EQ(kNumAllocs * 32, elapsed.num_bytes);
+
+  bool found = false;
+  for (const auto &region : AllocTracker::GetRegionStats()) {
+    if (region.first == "test_region") {
+      found = true;
+      EXPECT_EQ(1, region.second.num_entries);
+      EXPECT_EQ(kNumAllocs, region.second.counts.num_allocs);
+      EXPECT_EQ(kNumAllocs, region.second.max_allocs);
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
+TEST_F(AllocTrackerTest, Disabled) {
+  AllocTracker::Disable();
+  const AllocCounts start = AllocTracker::ThreadCounts();
+  AllocateAndFree(16);
+  EXPECT_EQ(0, (AllocTracker::ThreadCounts() - start).num_allocs);
+  ScopedAllocRegion region("disabled_region");
+  AllocateAndFree(16);
+  EXPECT_EQ(0, region.Elapsed().num_allocs);
+}
+
+TEST_F(AllocTrackerTest, Report) {
+  AllocTracker::Enable(64);
+  AllocateAndFree(128);
+  {
+    ScopedAllocRegion region("report_region");
+    AllocateAndFree(8);
+  }
+  const std::string report = AllocTracker::Report(3);
+  EXPECT_NE(std::string::npos, report.find("allocations per thread:"));
+  EXPECT_NE(std::string::npos, report.find("report_region: 1 entries"));
+  EXPECT_NE(std::string::npos, report.find("#0: "));
+}
+
+}  // namespace alloc_tracker
+}  // namespace common
+}  // namespace apollo
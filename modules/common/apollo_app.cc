@@ -22,7 +22,9 @@
 #include <vector>
 
 #include "gflags/gflags.h"
+#include "modules/common/alloc_tracker/alloc_tracker.h"
 #include "modules/common/log.h"
+#include "modules/common/scheduling/scheduler.h"
 #include "modules/common/status/status.h"
 #include "modules/common/util/string_util.h"
 
@@ -54,6 +56,10 @@ void ApolloApp::ExportFlags() const {
 }
 
 int ApolloApp::Spin() {
+  // The threads created from now on inherit the scheduling of the main thread.
+  if (!FLAGS_scheduling_config_file.empty()) {
+    scheduling::Scheduler::instance()->Init(FLAGS_scheduling_config_file);
+  }
   std::unique_ptr<ros::AsyncSpinner> spinner;
   if (callback_thread_num_ > 1) {
     spinner = std::unique_ptr<ros::AsyncSpinner>(
@@ -70,6 +76,20 @@ int ApolloApp::Spin() {
     return -2;
   }
   ExportFlags();
+  // Only the allocations of the steady state are tracked, not the ones of
+  // the initialization.
+  if (FLAGS_enable_alloc_tracking) {
+    if (alloc_tracker::AllocTracker::hooks_linked()) {
+      alloc_tracker::AllocTracker::Enable(FLAGS_alloc_sampling_bytes);
+    } else {
+      AWARN << Name() << " is not linked with the allocation hooks, "
+            << "the allocations are not tracked.";
+    }
+  }
+  if (!FLAGS_scheduling_config_file.empty()) {
+    AINFO << Name() << " scheduling:\n"
+          << scheduling::Scheduler::instance()->Report();
+  }
   if (spinner) {
     spinner->start();
   } else {
@@ -77,6 +97,11 @@ int ApolloApp::Spin() {
   }
   ros::waitForShutdown();
   Stop();
+  if (alloc_tracker::AllocTracker::enabled()) {
+    alloc_tracker::AllocTracker::Disable();
+    AINFO << Name() << " allocations:\n"
+          << alloc_tracker::AllocTracker::Report(FLAGS_alloc_report_sites);
+  }
   AINFO << Name() << " exited.";
   return 0;
 }
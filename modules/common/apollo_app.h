@@ -25,11 +25,18 @@
 #include <string>
 
 #include "gflags/gflags.h"
+#include "modules/common/async_logger.h"
 #include "modules/common/log.h"
 #include "modules/common/status/status.h"
 
 #include "ros/include/ros/ros.h"
 
+namespace apollo {
+namespace runtime {
+class ApolloAppRuntime;
+}  // namespace runtime
+}  // namespace apollo
+
 /**
  * @namespace apollo::common
  * @brief apollo::common
@@ -102,6 +109,8 @@ class ApolloApp {
   uint32_t callback_thread_num_ = 1;
 
  private:
+  friend class apollo::runtime::ApolloAppRuntime;
+
   /**
    * @brief Export flag values to <FLAGS_log_dir>/<name>.flags.
    */
@@ -117,6 +126,11 @@ void apollo_app_sigint_handler(int signal_num);
   int main(int argc, char **argv) {                            \
     google::InitGoogleLogging(argv[0]);                        \
     google::ParseCommandLineFlags(&argc, &argv, true);         \
+    if (FLAGS_log_async) {                                     \
+      apollo::common::AsyncLogger::Install(                    \
+          static_cast<size_t>(FLAGS_log_async_buffer_mb) *     \
+          1024 * 1024);                                        \
+    }                                                          \
     signal(SIGINT, apollo::common::apollo_app_sigint_handler); \
     APP apollo_app_;                                           \
     ros::init(argc, argv, apollo_app_.Name());                 \
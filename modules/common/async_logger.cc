@@ -0,0 +1,167 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/async_logger.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <utility>
+
+DEFINE_bool(log_async, false,
+            "Whether the log files are written by a background thread "
+            "instead of the logging threads.");
+DEFINE_int32(log_async_buffer_mb, 16,
+             "The max size of the messages of a severity queued for the "
+             "background thread, beyond which they are dropped.");
+
+namespace apollo {
+namespace common {
+
+namespace {
+
+// How long the messages may wait in the queue.
+constexpr std::chrono::milliseconds kFlushInterval(500);
+
+std::mutex installed_mutex;
+// The installed loggers, indexed by severity.
+std::vector<std::unique_ptr<AsyncLogger>> installed_loggers;
+
+}  // namespace
+
+AsyncLogger::AsyncLogger(google::base::Logger *wrapped,
+                         const size_t max_buffer_bytes)
+    : wrapped_(wrapped),
+      max_buffer_bytes_(max_buffer_bytes),
+      active_(new Buffer()),
+      flushing_(new Buffer()) {
+  flusher_thread_ = std::thread(&AsyncLogger::FlusherThreadFunc, this);
+}
+
+AsyncLogger::~AsyncLogger() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  wake_flusher_.notify_one();
+  flusher_thread_.join();
+}
+
+void AsyncLogger::Write(const bool force_flush, const time_t timestamp,
+                        const char *message, const int message_len) {
+  // glog starts the messages with the severity.
+  if (force_flush && message_len > 0 && message[0] == 'F') {
+    // The process is about to abort, the message and the ones before it
+    // are written right away.
+    Flush();
+    wrapped_->Write(true, timestamp, message, message_len);
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (active_->bytes + message_len > max_buffer_bytes_) {
+    ++dropped_count_;
+  } else {
+    Message queued;
+    queued.timestamp = timestamp;
+    queued.text.assign(message, message_len);
+    active_->messages.push_back(std::move(queued));
+    active_->bytes += message_len;
+    active_->force_flush |= force_flush;
+  }
+  if (force_flush || active_->bytes >= max_buffer_bytes_ / 2) {
+    wake_flusher_.notify_one();
+  }
+}
+
+void AsyncLogger::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (stopped_) {
+    return;
+  }
+  // The next swapped buffer holds all the messages queued so far.
+  const uint64_t target = num_swapped_ + 1;
+  flush_requested_ = true;
+  wake_flusher_.notify_one();
+  flushed_.wait(lock, [this, target]() { return num_written_ >= target; });
+}
+
+google::uint32 AsyncLogger::LogSize() { return wrapped_->LogSize(); }
+
+uint64_t AsyncLogger::dropped_count() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return dropped_count_;
+}
+
+void AsyncLogger::FlusherThreadFunc() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_flusher_.wait_for(lock, kFlushInterval, [this]() {
+      return stopped_ || flush_requested_ || active_->force_flush ||
+             active_->bytes >= max_buffer_bytes_ / 2;
+    });
+    if (active_->messages.empty() && !flush_requested_) {
+      if (stopped_) {
+        break;
+      }
+      continue;
+    }
+    active_.swap(flushing_);
+    const bool flush = flush_requested_ || flushing_->force_flush;
+    flush_requested_ = false;
+    const uint64_t swapped = ++num_swapped_;
+    lock.unlock();
+
+    // flushing_ is only touched by this thread until it is swapped again.
+    for (const auto &message : flushing_->messages) {
+      wrapped_->Write(false, message.timestamp, message.text.data(),
+                      static_cast<int>(message.text.size()));
+    }
+    if (flush) {
+      wrapped_->Flush();
+    }
+    flushing_->messages.clear();
+    flushing_->bytes = 0;
+    flushing_->force_flush = false;
+
+    lock.lock();
+    num_written_ = swapped;
+    flushed_.notify_all();
+  }
+}
+
+void AsyncLogger::Install(const size_t max_buffer_bytes) {
+  std::lock_guard<std::mutex> lock(installed_mutex);
+  if (!installed_loggers.empty()) {
+    return;
+  }
+  for (int severity = 0; severity < google::NUM_SEVERITIES; ++severity) {
+    installed_loggers.emplace_back(new AsyncLogger(
+        google::base::GetLogger(severity), max_buffer_bytes));
+    google::base::SetLogger(severity, installed_loggers.back().get());
+  }
+  std::atexit(&AsyncLogger::Uninstall);
+}
+
+void AsyncLogger::Uninstall() {
+  std::lock_guard<std::mutex> lock(installed_mutex);
+  for (size_t severity = 0; severity < installed_loggers.size(); ++severity) {
+    google::base::SetLogger(severity, installed_loggers[severity]->wrapped_);
+  }
+  // The destructors write the queued messages.
+  installed_loggers.clear();
+}
+
+}  // namespace common
+}  // namespace apollo
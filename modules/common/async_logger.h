@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_COMMON_ASYNC_LOGGER_H_
+#define MODULES_COMMON_ASYNC_LOGGER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "glog/logging.h"
+
+#include "modules/common/macro.h"
+
+DECLARE_bool(log_async);
+DECLARE_int32(log_async_buffer_mb);
+
+/**
+ * @namespace apollo::common
+ * @brief apollo::common
+ */
+namespace apollo {
+namespace common {
+
+/**
+ * @class AsyncLogger
+ * @brief A glog logger which queues the formatted messages and writes them
+ * to the wrapped logger, e.g. the glog log file, on a background thread, so
+ * that logging never waits for the disk.
+ *
+ * \par
+ * glog formats the messages and calls Write() under its own mutex, so the
+ * queue is only contended by the swap of the background thread. The output
+ * files are written by glog itself and keep their format and rotation.
+ *
+ * \par
+ * The messages are dropped, and counted, while the queue is full. A FATAL
+ * message waits for all the queued messages to be written before glog
+ * aborts.
+ */
+class AsyncLogger : public google::base::Logger {
+ public:
+  /**
+   * @brief Constructor.
+   * @param wrapped the logger writing the messages, not owned.
+   * @param max_buffer_bytes the max size of the queued messages.
+   */
+  AsyncLogger(google::base::Logger *wrapped, size_t max_buffer_bytes);
+
+  /**
+   * @brief Writes the queued messages and stops the background thread.
+   */
+  ~AsyncLogger();
+
+  void Write(bool force_flush, time_t timestamp, const char *message,
+             int message_len) override;
+
+  /**
+   * @brief Waits for the messages queued so far to be written, then flushes
+   * the wrapped logger.
+   */
+  void Flush() override;
+
+  google::uint32 LogSize() override;
+
+  /**
+   * @brief returns the number of messages dropped on a full queue.
+   */
+  uint64_t dropped_count() const;
+
+  /**
+   * @brief Wraps the loggers of all the severities with async loggers.
+   * The wrapped loggers are restored at exit, after the queued messages
+   * are written.
+   * @param max_buffer_bytes the max size of the queued messages of a
+   * severity.
+   */
+  static void Install(size_t max_buffer_bytes);
+
+  /**
+   * @brief Writes the queued messages and restores the wrapped loggers.
+   */
+  static void Uninstall();
+
+ private:
+  struct Message {
+    time_t timestamp;
+    std::string text;
+  };
+
+  struct Buffer {
+    std::vector<Message> messages;
+    size_t bytes = 0;
+    bool force_flush = false;
+  };
+
+  void FlusherThreadFunc();
+
+  google::base::Logger *const wrapped_;
+  const size_t max_buffer_bytes_;
+
+  mutable std::mutex mutex_;
+  // Signaled when the flusher has work, or for it to stop.
+  std::condition_variable wake_flusher_;
+  // Signaled when the flusher has written a buffer.
+  std::condition_variable flushed_;
+  // The buffer Write() appends to, and the one being written.
+  std::unique_ptr<Buffer> active_;
+  std::unique_ptr<Buffer> flushing_;
+  // The number of buffers swapped and written, to know when the messages
+  // queued before Flush() are written.
+  uint64_t num_swapped_ = 0;
+  uint64_t num_written_ = 0;
+  bool flush_requested_ = false;
+  bool stopped_ = false;
+  uint64_t dropped_count_ = 0;
+  std::thread flusher_thread_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncLogger);
+};
+
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_ASYNC_LOGGER_H_
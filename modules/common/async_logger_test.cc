@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/async_logger.h"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace common {
+
+namespace {
+
+class RecordingLogger : public google::base::Logger {
+ public:
+  void Write(bool force_flush, time_t timestamp, const char *message,
+             int message_len) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    messages_.emplace_back(message, message_len);
+  }
+
+  void Flush() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++num_flushes_;
+  }
+
+  google::uint32 LogSize() override { return 0; }
+
+  std::vector<std::string> messages() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return messages_;
+  }
+
+  int num_flushes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_flushes_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<std::string> messages_;
+  int num_flushes_ = 0;
+};
+
+void Write(AsyncLogger *logger, const std::string &message,
+           bool force_flush = false) {
+  logger->Write(force_flush, 0, message.data(), message.size());
+}
+
+}  // namespace
+
+TEST(AsyncLoggerTest, Flush) {
+  RecordingLogger recording;
+  AsyncLogger logger(&recording, 1024);
+  Write(&logger, "I first\n");
+  Write(&logger, "I second\n");
+  logger.Flush();
+  EXPECT_EQ(std::vector<std::string>({"I first\n", "I second\n"}),
+            recording.messages());
+  EXPECT_EQ(1, recording.num_flushes());
+}
+
+TEST(AsyncLoggerTest, WrittenInBackground) {
+  RecordingLogger recording;
+  {
+    AsyncLogger logger(&recording, 1024);
+    Write(&logger, "W warning\n", true);
+    for (int i = 0; i < 100 && recording.messages().empty(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(1, recording.messages().size());
+    Write(&logger, "I info\n");
+  }
+  // The queued messages are written on destruction.
+  EXPECT_EQ(2, recording.messages().size());
+}
+
+TEST(AsyncLoggerTest, DropsOnFullQueue) {
+  RecordingLogger recording;
+  AsyncLogger logger(&recording, 16);
+  Write(&logger, "I 0123456789\n");
+  Write(&logger, "I 0123456789\n");
+  logger.Flush();
+  EXPECT_LE(1, recording.messages().size());
+  EXPECT_EQ(2, recording.messages().size() + logger.dropped_count());
+}
+
+TEST(AsyncLoggerTest, Fatal) {
+  RecordingLogger recording;
+  AsyncLogger logger(&recording, 1024);
+  Write(&logger, "I info\n");
+  // A fatal message and the ones before it are written before the call
+  // returns.
+  Write(&logger, "F fatal\n", true);
+  EXPECT_EQ(std::vector<std::string>({"I info\n", "F fatal\n"}),
+            recording.messages());
+}
+
+TEST(AsyncLoggerTest, EverySec) {
+  int num_logged = 0;
+  for (int i = 0; i < 10; ++i) {
+    AINFO_EVERY_SEC(60.0) << "logged " << ++num_logged;
+  }
+  EXPECT_EQ(1, num_logged);
+}
+
+}  // namespace common
+}  // namespace apollo
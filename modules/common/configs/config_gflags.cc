@@ -30,6 +30,27 @@ DEFINE_string(routing_map_filename, "routing_map.bin|routing_map.txt",
               "Routing map files in the map_dir, search in order.");
 DEFINE_string(end_way_point_filename, "default_end_way_point.txt",
               "End way point of the map, will be sent in RoutingRequest.");
+DEFINE_bool(use_path_segment_index, false,
+            "Build a KD-tree over the segments of long map paths to speed up "
+            "point projection.");
+DEFINE_int32(map_tile_cache_capacity, 64,
+             "The maximum number of map tiles in memory when the base map is "
+             "a tile index.");
+DEFINE_int32(map_tile_prefetch_radius, 1,
+             "The map tiles within this many tiles of a query are loaded in "
+             "the background, 0 to disable.");
+DEFINE_bool(use_nearest_lane_cache, false,
+            "Cache the results of GetNearestLane and GetNearestLaneWithHeading "
+            "by the quantized query.");
+DEFINE_int32(nearest_lane_cache_size, 4096,
+             "The number of entries of each nearest lane cache.");
+DEFINE_double(nearest_lane_cache_resolution, 0.05,
+              "The position resolution of the nearest lane cache in meters.");
+DEFINE_double(nearest_lane_cache_heading_resolution, 0.02,
+              "The heading resolution of the nearest lane cache in radians.");
+DEFINE_int32(opendrive_parse_threads, 0,
+             "The number of threads that convert an OpenDRIVE map, 0 for "
+             "all the hardware threads and 1 to convert it sequentially.");
 
 DEFINE_string(vehicle_config_path, "modules/common/data/mkz_config.pb.txt",
               "the file path of vehicle config file");
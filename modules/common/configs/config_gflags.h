@@ -28,6 +28,14 @@ DECLARE_string(base_map_filename);
 DECLARE_string(sim_map_filename);
 DECLARE_string(routing_map_filename);
 DECLARE_string(end_way_point_filename);
+DECLARE_bool(use_path_segment_index);
+DECLARE_int32(map_tile_cache_capacity);
+DECLARE_int32(map_tile_prefetch_radius);
+DECLARE_bool(use_nearest_lane_cache);
+DECLARE_int32(nearest_lane_cache_size);
+DECLARE_double(nearest_lane_cache_resolution);
+DECLARE_double(nearest_lane_cache_heading_resolution);
+DECLARE_int32(opendrive_parse_threads);
 
 DECLARE_string(vehicle_config_path);
 
@@ -17,17 +17,32 @@
 
 #include <leveldb/env.h>
 #include <leveldb/options.h>
+#include <leveldb/write_batch.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 
 #include "gflags/gflags.h"
 #include "modules/common/util/file.h"
 #include "modules/common/util/util.h"
 
 DEFINE_string(kv_db_path, "/apollo/data/kv_db", "Path to param DB file.");
+DEFINE_double(kv_db_idle_close_sec, 0.5,
+              "Seconds without use after which the DB handle is closed, "
+              "releasing the DB to the other processes.");
+DEFINE_double(kv_db_read_cache_sec, 1.0,
+              "Seconds a value read from the DB is served from memory.");
 
 namespace apollo {
 namespace common {
 namespace {
 
+using SteadyClock = std::chrono::steady_clock;
+
 class BlockingEnv : public leveldb::EnvWrapper {
  public:
   BlockingEnv() : leveldb::EnvWrapper(leveldb::Env::Default()) {}
@@ -50,42 +65,331 @@ leveldb::Options DBOptions() {
   return options;
 }
 
+double SecondsSince(const SteadyClock::time_point time) {
+  return std::chrono::duration<double>(SteadyClock::now() - time).count();
+}
+
+// The process-wide state of the DB: the open handle, the cache of the values,
+// and the queue of the asynchronous updates, with the thread which writes
+// them and closes the idle handle.
+class DBState {
+ public:
+  static DBState *Instance() {
+    static DBState instance;
+    return &instance;
+  }
+
+  // Writes the queued updates before the process exits.
+  ~DBState() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    cvar_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  std::mutex &mutex() { return mutex_; }
+
+  std::shared_ptr<leveldb::DB> GetDBLocked() {
+    if (db_ == nullptr) {
+      static const auto options = DBOptions();
+      leveldb::DB *db = nullptr;
+      CHECK(apollo::common::util::EnsureDirectory(FLAGS_kv_db_path));
+      const auto status = leveldb::DB::Open(options, FLAGS_kv_db_path, &db);
+      CHECK(status.ok()) << "Unable to open DB path " << FLAGS_kv_db_path
+                         << "\n" << status.ToString();
+      db_.reset(db);
+      if (!thread_.joinable()) {
+        thread_ = std::thread(&DBState::ThreadFunc, this);
+      }
+      cvar_.notify_all();
+    }
+    last_use_time_ = SteadyClock::now();
+    return db_;
+  }
+
+  // Queues an update, a deletion if value is null.
+  void QueueLocked(const std::string &key, const std::string *value) {
+    CacheEntry &entry = cache_[key];
+    entry.found = value != nullptr;
+    entry.value = value != nullptr ? *value : "";
+    ++entry.queued;
+    if (value != nullptr) {
+      queued_batch_.Put(key, *value);
+    } else {
+      queued_batch_.Delete(key);
+    }
+    queued_keys_.push_back(key);
+    ++write_count_;
+  }
+
+  void NotifyWriterLocked() {
+    if (!thread_.joinable()) {
+      thread_ = std::thread(&DBState::ThreadFunc, this);
+    }
+    cvar_.notify_all();
+  }
+
+  // The number of the writes so far. A value read is only cached if no
+  // write happened during the read, since it may be older than the write.
+  uint64_t WriteCountLocked() const { return write_count_; }
+
+  // Caches a value written or read, a missing key if value is null. The
+  // value of a queued update is newer and is kept.
+  void CacheLocked(const std::string &key, const std::string *value) {
+    if (cache_.size() > kMaxCacheSize) {
+      EvictLocked();
+    }
+    CacheEntry &entry = cache_[key];
+    if (entry.queued > 0) {
+      return;
+    }
+    entry.found = value != nullptr;
+    entry.value = value != nullptr ? *value : "";
+    entry.time = SteadyClock::now();
+  }
+
+  // Looks a key up in the cache. found tells whether the key is in the DB.
+  bool LookupCacheLocked(const std::string &key, bool *found,
+                         std::string *value) const {
+    const auto it = cache_.find(key);
+    if (it == cache_.end() || (it->second.queued == 0 &&
+                               SecondsSince(it->second.time) >=
+                                   FLAGS_kv_db_read_cache_sec)) {
+      return false;
+    }
+    *found = it->second.found;
+    if (value != nullptr) {
+      *value = it->second.value;
+    }
+    return true;
+  }
+
+  // Updates of keys to values, null for a deletion.
+  using Updates = std::vector<std::pair<std::string, const std::string *>>;
+
+  // Writes the queued updates and then the given ones, in one write. The
+  // writes are serialized, so the updates reach the DB in their order.
+  leveldb::Status Write(const leveldb::WriteOptions &options,
+                        const Updates &updates);
+
+  // Whether all the queued updates written since the last call succeeded.
+  bool TakeQueuedWritesOk() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const bool ok = queued_writes_ok_;
+    queued_writes_ok_ = true;
+    return ok;
+  }
+
+ private:
+  struct CacheEntry {
+    std::string value;
+    bool found = false;
+    // The number of the queued updates not written yet. The entry does not
+    // expire while there is any.
+    int queued = 0;
+    SteadyClock::time_point time;
+  };
+
+  static constexpr size_t kMaxCacheSize = 1024;
+
+  DBState() = default;
+
+  void EvictLocked() {
+    for (auto it = cache_.begin(); it != cache_.end();) {
+      if (it->second.queued == 0 &&
+          SecondsSince(it->second.time) >= FLAGS_kv_db_read_cache_sec) {
+        it = cache_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  void ThreadFunc();
+
+  // Serializes the writes, taken before mutex_.
+  std::mutex write_mutex_;
+  // Guards the members below.
+  std::mutex mutex_;
+  std::condition_variable cvar_;
+  std::shared_ptr<leveldb::DB> db_;
+  SteadyClock::time_point last_use_time_;
+  std::unordered_map<std::string, CacheEntry> cache_;
+  leveldb::WriteBatch queued_batch_;
+  std::vector<std::string> queued_keys_;
+  bool queued_writes_ok_ = true;
+  uint64_t write_count_ = 0;
+  bool stopped_ = false;
+  std::thread thread_;
+};
+
+constexpr size_t DBState::kMaxCacheSize;
+
+leveldb::Status DBState::Write(const leveldb::WriteOptions &options,
+                               const Updates &updates) {
+  std::lock_guard<std::mutex> write_lock(write_mutex_);
+  leveldb::WriteBatch write_batch;
+  std::vector<std::string> queued_keys;
+  std::shared_ptr<leveldb::DB> db;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::swap(write_batch, queued_batch_);
+    std::swap(queued_keys, queued_keys_);
+    if (queued_keys.empty() && updates.empty()) {
+      return leveldb::Status::OK();
+    }
+    db = GetDBLocked();
+  }
+  for (const auto &update : updates) {
+    if (update.second == nullptr) {
+      write_batch.Delete(update.first);
+    } else {
+      write_batch.Put(update.first, *update.second);
+    }
+  }
+  const auto status = db->Write(options, &write_batch);
+  AERROR_IF(!status.ok()) << status.ToString();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++write_count_;
+  last_use_time_ = SteadyClock::now();
+  for (const auto &key : queued_keys) {
+    CacheEntry &entry = cache_[key];
+    --entry.queued;
+    entry.time = last_use_time_;
+  }
+  if (!queued_keys.empty() && !status.ok()) {
+    queued_writes_ok_ = false;
+  }
+  if (status.ok()) {
+    for (const auto &update : updates) {
+      CacheLocked(update.first, update.second);
+    }
+  }
+  return status;
+}
+
+void DBState::ThreadFunc() {
+  const leveldb::WriteOptions options;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    if (!queued_keys_.empty()) {
+      lock.unlock();
+      Write(options, Updates());
+      lock.lock();
+      continue;
+    }
+    if (stopped_) {
+      break;
+    }
+    if (db_ == nullptr) {
+      cvar_.wait(lock);
+      continue;
+    }
+    const double idle_sec = SecondsSince(last_use_time_);
+    if (idle_sec >= FLAGS_kv_db_idle_close_sec) {
+      // users still holding the handle keep the DB open until they are done
+      db_.reset();
+      continue;
+    }
+    cvar_.wait_for(lock, std::chrono::duration<double>(
+                             FLAGS_kv_db_idle_close_sec - idle_sec));
+  }
+}
+
 }  // namespace
 
-std::unique_ptr<leveldb::DB> KVDB::GetDB() {
-  static const auto options = DBOptions();
-  leveldb::DB *db = nullptr;
-  CHECK(apollo::common::util::EnsureDirectory(FLAGS_kv_db_path));
-  const auto status = leveldb::DB::Open(options, FLAGS_kv_db_path, &db);
-  CHECK(status.ok()) << "Unable to open DB path " << FLAGS_kv_db_path
-                     << "\n" << status.ToString();
-  return std::unique_ptr<leveldb::DB>(db);
+void KVDB::WriteBatch::Put(const std::string &key, const std::string &value) {
+  updates_.push_back({key, value, false});
+}
+
+void KVDB::WriteBatch::Delete(const std::string &key) {
+  updates_.push_back({key, "", true});
+}
+
+std::shared_ptr<leveldb::DB> KVDB::GetDB() {
+  auto *state = DBState::Instance();
+  std::lock_guard<std::mutex> lock(state->mutex());
+  return state->GetDBLocked();
 }
 
 bool KVDB::Put(const std::string &key, const std::string &value,
                const bool sync) {
-  leveldb::WriteOptions options;
-  options.sync = sync;
-
-  const auto status = GetDB()->Put(options, key, value);
-  AERROR_IF(!status.ok()) << status.ToString();
-  return status.ok();
+  WriteBatch batch;
+  batch.Put(key, value);
+  return Write(batch, sync);
 }
 
 bool KVDB::Delete(const std::string &key, const bool sync) {
+  WriteBatch batch;
+  batch.Delete(key);
+  return Write(batch, sync);
+}
+
+bool KVDB::Write(const WriteBatch &batch, const bool sync) {
   leveldb::WriteOptions options;
   options.sync = sync;
+  DBState::Updates updates;
+  updates.reserve(batch.updates_.size());
+  for (const auto &update : batch.updates_) {
+    updates.emplace_back(update.key,
+                         update.is_delete ? nullptr : &update.value);
+  }
+  return DBState::Instance()->Write(options, updates).ok();
+}
 
-  const auto status = GetDB()->Delete(options, key);
-  AERROR_IF(!status.ok()) << status.ToString();
-  return status.ok();
+void KVDB::WriteAsync(const WriteBatch &batch) {
+  if (batch.Empty()) {
+    return;
+  }
+  auto *state = DBState::Instance();
+  std::lock_guard<std::mutex> lock(state->mutex());
+  for (const auto &update : batch.updates_) {
+    state->QueueLocked(update.key, update.is_delete ? nullptr : &update.value);
+  }
+  state->NotifyWriterLocked();
+}
+
+void KVDB::PutAsync(const std::string &key, const std::string &value) {
+  WriteBatch batch;
+  batch.Put(key, value);
+  WriteAsync(batch);
+}
+
+bool KVDB::Flush() {
+  auto *state = DBState::Instance();
+  state->Write(leveldb::WriteOptions(), DBState::Updates());
+  return state->TakeQueuedWritesOk();
 }
 
 bool KVDB::Has(const std::string &key) {
   static leveldb::ReadOptions options;
 
+  auto *state = DBState::Instance();
+  bool found = false;
+  std::shared_ptr<leveldb::DB> db;
+  uint64_t write_count = 0;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex());
+    if (state->LookupCacheLocked(key, &found, nullptr)) {
+      return found;
+    }
+    db = state->GetDBLocked();
+    write_count = state->WriteCountLocked();
+  }
+
   std::string value;
-  const auto status = GetDB()->Get(options, key, &value);
+  const auto status = db->Get(options, key, &value);
+  if (status.ok() || status.IsNotFound()) {
+    std::lock_guard<std::mutex> lock(state->mutex());
+    if (state->WriteCountLocked() == write_count) {
+      state->CacheLocked(key, status.ok() ? &value : nullptr);
+    }
+  }
   return !status.IsNotFound();
 }
 
@@ -93,8 +397,27 @@ std::string KVDB::Get(const std::string &key,
                       const std::string &default_value) {
   static leveldb::ReadOptions options;
 
+  auto *state = DBState::Instance();
+  bool found = false;
   std::string value;
-  const auto status = GetDB()->Get(options, key, &value);
+  std::shared_ptr<leveldb::DB> db;
+  uint64_t write_count = 0;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex());
+    if (state->LookupCacheLocked(key, &found, &value)) {
+      return found ? value : default_value;
+    }
+    db = state->GetDBLocked();
+    write_count = state->WriteCountLocked();
+  }
+
+  const auto status = db->Get(options, key, &value);
+  if (status.ok() || status.IsNotFound()) {
+    std::lock_guard<std::mutex> lock(state->mutex());
+    if (state->WriteCountLocked() == write_count) {
+      state->CacheLocked(key, status.ok() ? &value : nullptr);
+    }
+  }
   return status.ok() ? value : default_value;
 }
 
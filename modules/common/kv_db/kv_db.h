@@ -20,6 +20,7 @@
 #include <leveldb/db.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 /**
  * @namespace apollo::common
@@ -33,9 +34,36 @@ namespace common {
  *
  * @brief Lightweight key-value database to store system-wide parameters.
  *        We prefer keys like "apollo:data:commit_id".
+ *
+ * The DB is shared with other processes, which wait for its lock. The handle
+ * is kept open while the process uses it, and closed after
+ * kv_db_idle_close_sec without use. The values this process wrote, and the
+ * ones it read in the last kv_db_read_cache_sec, are served from memory.
  */
 class KVDB {
  public:
+  /**
+   * @class WriteBatch
+   *
+   * @brief A group of updates, which are applied atomically and in order.
+   */
+  class WriteBatch {
+   public:
+    void Put(const std::string &key, const std::string &value);
+    void Delete(const std::string &key);
+    bool Empty() const { return updates_.empty(); }
+    void Clear() { updates_.clear(); }
+
+   private:
+    friend class KVDB;
+    struct Update {
+      std::string key;
+      std::string value;
+      bool is_delete;
+    };
+    std::vector<Update> updates_;
+  };
+
   /**
    * @brief Store {key, value} to DB.
    * @param sync Whether flush right after writing.
@@ -52,13 +80,38 @@ class KVDB {
   static bool Delete(const std::string &key,
                      const bool sync = false);
 
+  /**
+   * @brief Apply the updates of a batch in one write.
+   * @param sync Whether flush right after writing.
+   * @return Success or not.
+   */
+  static bool Write(const WriteBatch &batch, const bool sync = false);
+
+  /**
+   * @brief Queue the updates of a batch for a background thread to write,
+   *        without waiting for the disk. They are seen right away by Get()
+   *        and Has() of this process, and by other processes once written.
+   */
+  static void WriteAsync(const WriteBatch &batch);
+
+  /**
+   * @brief Queue a {key, value} for a background thread to write.
+   */
+  static void PutAsync(const std::string &key, const std::string &value);
+
+  /**
+   * @brief Wait for the queued updates to be written.
+   * @return Whether all the updates written since the last Flush() succeeded.
+   */
+  static bool Flush();
+
   static bool Has(const std::string &key);
 
   static std::string Get(const std::string &key,
                          const std::string &default_value = "");
 
  private:
-  static std::unique_ptr<leveldb::DB> GetDB();
+  static std::shared_ptr<leveldb::DB> GetDB();
 };
 
 }  // namespace common
@@ -15,10 +15,18 @@
  *****************************************************************************/
 #include "modules/common/kv_db/kv_db.h"
 
+#include <leveldb/db.h>
+
+#include <chrono>
+#include <string>
 #include <thread>
 
+#include "gflags/gflags.h"
 #include "gtest/gtest.h"
 
+DECLARE_string(kv_db_path);
+DECLARE_double(kv_db_idle_close_sec);
+
 namespace apollo {
 namespace common {
 
@@ -64,5 +72,67 @@ TEST(KVDBTest, MultiThreads) {
   }
 }
 
+TEST(KVDBTest, WriteBatch) {
+  KVDB::WriteBatch batch;
+  EXPECT_TRUE(batch.Empty());
+  batch.Put("test_key", "val0");
+  batch.Put("test_key_2", "val2");
+  batch.Delete("test_key");
+  EXPECT_FALSE(batch.Empty());
+  EXPECT_TRUE(KVDB::Write(batch));
+  EXPECT_FALSE(KVDB::Has("test_key"));
+  EXPECT_EQ("val2", KVDB::Get("test_key_2"));
+
+  batch.Clear();
+  EXPECT_TRUE(batch.Empty());
+  batch.Delete("test_key_2");
+  EXPECT_TRUE(KVDB::Write(batch, true));
+  EXPECT_FALSE(KVDB::Has("test_key_2"));
+}
+
+TEST(KVDBTest, WriteAsync) {
+  // the queued updates are seen before they are written
+  for (int i = 0; i < 100; ++i) {
+    KVDB::PutAsync("test_key", std::to_string(i));
+    EXPECT_EQ(std::to_string(i), KVDB::Get("test_key"));
+  }
+  KVDB::WriteBatch batch;
+  batch.Put("test_key_2", "val2");
+  batch.Delete("test_key");
+  KVDB::WriteAsync(batch);
+  EXPECT_FALSE(KVDB::Has("test_key"));
+  EXPECT_EQ("val2", KVDB::Get("test_key_2"));
+  EXPECT_TRUE(KVDB::Flush());
+  EXPECT_FALSE(KVDB::Has("test_key"));
+  EXPECT_EQ("val2", KVDB::Get("test_key_2"));
+
+  // a synchronous write comes after the queued ones
+  KVDB::PutAsync("test_key", "val0");
+  EXPECT_TRUE(KVDB::Delete("test_key"));
+  EXPECT_TRUE(KVDB::Delete("test_key_2"));
+  EXPECT_TRUE(KVDB::Flush());
+  EXPECT_FALSE(KVDB::Has("test_key"));
+  EXPECT_FALSE(KVDB::Has("test_key_2"));
+}
+
+TEST(KVDBTest, ReleaseIdleHandle) {
+  // the handle opened by the previous tests is closed with the old delay
+  FLAGS_kv_db_idle_close_sec = 0.1;
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  EXPECT_TRUE(KVDB::Put("test_key", "val0"));
+
+  // the handle is held while in use, and the DB is locked
+  leveldb::DB *db = nullptr;
+  EXPECT_FALSE(leveldb::DB::Open(leveldb::Options(), FLAGS_kv_db_path, &db)
+                   .ok());
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  ASSERT_TRUE(leveldb::DB::Open(leveldb::Options(), FLAGS_kv_db_path, &db)
+                  .ok());
+  delete db;
+
+  EXPECT_EQ("val0", KVDB::Get("test_key"));
+  EXPECT_TRUE(KVDB::Delete("test_key"));
+}
+
 }  // namespace common
 }  // namespace apollo
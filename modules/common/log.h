@@ -21,6 +21,10 @@
 #ifndef MODULES_COMMON_LOG_H_
 #define MODULES_COMMON_LOG_H_
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
 #include "glog/logging.h"
 #include "glog/raw_logging.h"
 
@@ -40,6 +44,21 @@
 #define AWARN_EVERY(freq) LOG_EVERY_N(WARNING, freq)
 #define AERROR_EVERY(freq) LOG_EVERY_N(ERROR, freq)
 
+// LOG_EVERY_SEC: at most once every period_sec seconds per call site, from
+// any thread. The skipped messages are not formatted.
+#define ALOG_EVERY_SEC_(period_sec)                          \
+  [](const double period) {                                  \
+    static std::atomic<int64_t> next_log_time_ns(0);         \
+    return apollo::common::log_internal::ShouldLogNow(       \
+        period, &next_log_time_ns);                          \
+  }(period_sec)
+#define AINFO_EVERY_SEC(period_sec) \
+  LOG_IF(INFO, ALOG_EVERY_SEC_(period_sec))
+#define AWARN_EVERY_SEC(period_sec) \
+  LOG_IF(WARNING, ALOG_EVERY_SEC_(period_sec))
+#define AERROR_EVERY_SEC(period_sec) \
+  LOG_IF(ERROR, ALOG_EVERY_SEC_(period_sec))
+
 #define RETURN_IF_NULL(ptr)               \
     if (ptr == nullptr) {                 \
         AWARN << #ptr << " is nullptr.";  \
@@ -64,4 +83,27 @@
         return val;                            \
     }
 
+namespace apollo {
+namespace common {
+namespace log_internal {
+
+// Returns whether the period has passed since the last time it returned
+// true for the same next_log_time_ns.
+inline bool ShouldLogNow(const double period_sec,
+                         std::atomic<int64_t> *next_log_time_ns) {
+  const int64_t now_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count();
+  int64_t next_ns = next_log_time_ns->load(std::memory_order_relaxed);
+  return now_ns >= next_ns &&
+         next_log_time_ns->compare_exchange_strong(
+             next_ns, now_ns + static_cast<int64_t>(period_sec * 1e9),
+             std::memory_order_relaxed);
+}
+
+}  // namespace log_internal
+}  // namespace common
+}  // namespace apollo
+
 #endif  // MODULES_COMMON_LOG_H_
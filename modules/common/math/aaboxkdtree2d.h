@@ -16,17 +16,22 @@
 
 /**
  * @file
- * @brief Defines the templated AABoxKDTree2dNode class.
+ * @brief Defines the templated AABoxKDTree2d class.
  */
 
 #ifndef MODULES_COMMON_MATH_AABOXKDTREE2D_H_
 #define MODULES_COMMON_MATH_AABOXKDTREE2D_H_
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
 #include <vector>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "modules/common/log.h"
 
 #include "modules/common/math/aabox2d.h"
@@ -54,63 +59,90 @@ struct AABoxKDTreeParams {
 };
 
 /**
- * @class AABoxKDTree2dNode
- * @brief The class of KD-tree node of axis-aligned bounding box.
+ * @class AABoxKDTree2d
+ * @brief The class of KD-tree of Aligned Axis Bounding Box(AABox).
+ *
+ * \par
+ * The nodes are stored in one array in preorder, and the objects of all the
+ * nodes in two shared arrays in the same order, so that the objects of a
+ * subtree are contiguous. The bounding boxes of the objects are kept next to
+ * them in structure-of-arrays layout, so that a range search accepts or
+ * rejects most objects by their boxes without touching the objects.
  */
 template <class ObjectType>
-class AABoxKDTree2dNode {
+class AABoxKDTree2d {
  public:
   using ObjectPtr = const ObjectType *;
+
   /**
-   * @brief Constructor which takes a vector of objects,
-   *        parameters and depth of the node.
-   * @param objects Objects to build the KD-tree node.
+   * @brief Contructor which takes a vector of objects and parameters.
    * @param params Parameters to build the KD-tree.
-   * @param depth Depth of the KD-tree node.
    */
-  AABoxKDTree2dNode(const std::vector<ObjectPtr> &objects,
-                    const AABoxKDTreeParams &params, int depth)
-      : depth_(depth) {
-    CHECK(!objects.empty());
-
-    ComputeBoundary(objects);
-    ComputePartition();
-
-    if (SplitToSubNodes(objects, params)) {
-      std::vector<ObjectPtr> left_subnode_objects;
-      std::vector<ObjectPtr> right_subnode_objects;
-      PartitionObjects(objects, &left_subnode_objects, &right_subnode_objects);
-
-      // Split to sub-nodes.
-      if (!left_subnode_objects.empty()) {
-        left_subnode_.reset(new AABoxKDTree2dNode<ObjectType>(
-            left_subnode_objects, params, depth + 1));
-      }
-      if (!right_subnode_objects.empty()) {
-        right_subnode_.reset(new AABoxKDTree2dNode<ObjectType>(
-            right_subnode_objects, params, depth + 1));
+  AABoxKDTree2d(const std::vector<ObjectType> &objects,
+                const AABoxKDTreeParams &params) {
+    if (!objects.empty()) {
+      std::vector<ObjectPtr> object_ptrs;
+      object_ptrs.reserve(objects.size());
+      for (const auto &object : objects) {
+        object_ptrs.push_back(&object);
       }
-    } else {
-      InitObjects(objects);
+      objects_sorted_by_min_.Reserve(objects.size());
+      objects_sorted_by_max_.Reserve(objects.size());
+      BuildNode(object_ptrs, params, 0);
     }
   }
 
   /**
-   * @brief Get the nearest object to a target point by the KD-tree
-   *        rooted at this node.
+   * @brief Get the nearest object to a target point.
    * @param point The target point. Search it's nearest object.
    * @return The nearest object to the target point.
    */
   ObjectPtr GetNearestObject(const Vec2d &point) const {
     ObjectPtr nearest_object = nullptr;
+    if (nodes_.empty()) {
+      return nearest_object;
+    }
     double min_distance_sqr = std::numeric_limits<double>::infinity();
-    GetNearestObjectInternal(point, &min_distance_sqr, &nearest_object);
+    // As in a recursive search, the nearer subnode of a node is searched
+    // first, then the objects of the node, then the farther subnode. The
+    // stack holds the nodes whose nearer subnode is being searched.
+    int stack[kMaxStackSize];
+    int stack_size = 0;
+    int index = 0;
+    while (true) {
+      while (index >= 0) {
+        const Node &node = nodes_[index];
+        if (node.LowerDistanceSquareToPoint(point) >=
+            min_distance_sqr - kMathEpsilon) {
+          break;
+        }
+        stack[stack_size++] = index;
+        index = node.IsNearLeft(point) ? node.left : node.right;
+      }
+      if (stack_size == 0) {
+        break;
+      }
+      const Node &node = nodes_[stack[--stack_size]];
+      const bool search_left_first = node.IsNearLeft(point);
+      const double pvalue =
+          (node.partition == PARTITION_X ? point.x() : point.y());
+      if (search_left_first) {
+        GetNearestObjectInNode(objects_sorted_by_min_, node, point, pvalue,
+                               true, &min_distance_sqr, &nearest_object);
+      } else {
+        GetNearestObjectInNode(objects_sorted_by_max_, node, point, pvalue,
+                               false, &min_distance_sqr, &nearest_object);
+      }
+      if (min_distance_sqr <= kMathEpsilon) {
+        break;
+      }
+      index = search_left_first ? node.right : node.left;
+    }
     return nearest_object;
   }
 
   /**
-   * @brief Get objects within a distance to a point by the KD-tree
-   *        rooted at this node.
+   * @brief Get objects within a distance to a point.
    * @param point The center point of the range to search objects.
    * @param distance The radius of the range to search objects.
    * @return All objects within the specified distance to the specified point.
@@ -118,350 +150,413 @@ class AABoxKDTree2dNode {
   std::vector<ObjectPtr> GetObjects(const Vec2d &point,
                                     const double distance) const {
     std::vector<ObjectPtr> result_objects;
-    GetObjectsInternal(point, distance, Square(distance), &result_objects);
+    GetObjects(point, distance, &result_objects);
     return result_objects;
   }
 
+  /**
+   * @brief Append the objects within a distance to a point to a buffer,
+   *        which lets the caller reuse the buffer across queries.
+   * @param point The center point of the range to search objects.
+   * @param distance The radius of the range to search objects.
+   * @param result_objects The buffer the objects are appended to.
+   */
+  void GetObjects(const Vec2d &point, const double distance,
+                  std::vector<ObjectPtr> *const result_objects) const {
+    if (nodes_.empty()) {
+      return;
+    }
+    const double distance_sqr = Square(distance);
+    int stack[kMaxStackSize];
+    int stack_size = 0;
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+      const Node &node = nodes_[stack[--stack_size]];
+      if (node.LowerDistanceSquareToPoint(point) > distance_sqr) {
+        continue;
+      }
+      if (node.UpperDistanceSquareToPoint(point) <= distance_sqr) {
+        // The whole subtree is in range.
+        const auto &objects = objects_sorted_by_min_.objects;
+        result_objects->insert(result_objects->end(),
+                               objects.begin() + node.begin,
+                               objects.begin() + node.subtree_end);
+        continue;
+      }
+      const double pvalue =
+          (node.partition == PARTITION_X ? point.x() : point.y());
+      if (pvalue < node.partition_position) {
+        const double limit = pvalue + distance;
+        const auto &bounds = objects_sorted_by_min_.bounds;
+        const int end = std::partition_point(
+                            bounds.begin() + node.begin,
+                            bounds.begin() + node.end,
+                            [limit](double bound) { return bound <= limit; }) -
+                        bounds.begin();
+        GetObjectsInRange(objects_sorted_by_min_, node.begin, end, point,
+                          distance_sqr, result_objects);
+      } else {
+        const double limit = pvalue - distance;
+        const auto &bounds = objects_sorted_by_max_.bounds;
+        const int end = std::partition_point(
+                            bounds.begin() + node.begin,
+                            bounds.begin() + node.end,
+                            [limit](double bound) { return bound >= limit; }) -
+                        bounds.begin();
+        GetObjectsInRange(objects_sorted_by_max_, node.begin, end, point,
+                          distance_sqr, result_objects);
+      }
+      if (node.right >= 0) {
+        stack[stack_size++] = node.right;
+      }
+      if (node.left >= 0) {
+        stack[stack_size++] = node.left;
+      }
+    }
+  }
+
   /**
    * @brief Get the axis-aligned bounding box of the objects.
    * @return The axis-aligned bounding box of the objects.
    */
   AABox2d GetBoundingBox() const {
-    return AABox2d({min_x_, min_y_}, {max_x_, max_y_});
+    if (nodes_.empty()) {
+      return AABox2d();
+    }
+    const Node &root = nodes_.front();
+    return AABox2d({root.min_x, root.min_y}, {root.max_x, root.max_y});
   }
 
  private:
-  void InitObjects(const std::vector<ObjectPtr> &objects) {
-    num_objects_ = objects.size();
-    objects_sorted_by_min_ = objects;
-    objects_sorted_by_max_ = objects;
-    std::sort(objects_sorted_by_min_.begin(), objects_sorted_by_min_.end(),
+  // Deeper nodes are not split further, which bounds the traversal stack.
+  static constexpr int kMaxDepth = 60;
+  static constexpr int kMaxStackSize = kMaxDepth + 2;
+
+  enum Partition {
+    PARTITION_X = 1,
+    PARTITION_Y = 2,
+  };
+
+  struct Node {
+    // Boundary
+    double min_x = 0.0;
+    double max_x = 0.0;
+    double min_y = 0.0;
+    double max_y = 0.0;
+
+    double partition_position = 0.0;
+
+    // The objects of this node are [begin, end) in the object arrays, and
+    // the objects of its subtree are [begin, subtree_end).
+    int begin = 0;
+    int end = 0;
+    int subtree_end = 0;
+
+    // The indices of the subnodes, or -1.
+    int left = -1;
+    int right = -1;
+
+    Partition partition = PARTITION_X;
+
+    // Whether the left subnode is on the side of the point.
+    bool IsNearLeft(const Vec2d &point) const {
+      return (partition == PARTITION_X ? point.x() : point.y()) <
+             partition_position;
+    }
+
+    double LowerDistanceSquareToPoint(const Vec2d &point) const {
+      double dx = 0.0;
+      if (point.x() < min_x) {
+        dx = min_x - point.x();
+      } else if (point.x() > max_x) {
+        dx = point.x() - max_x;
+      }
+      double dy = 0.0;
+      if (point.y() < min_y) {
+        dy = min_y - point.y();
+      } else if (point.y() > max_y) {
+        dy = point.y() - max_y;
+      }
+      return dx * dx + dy * dy;
+    }
+
+    double UpperDistanceSquareToPoint(const Vec2d &point) const {
+      const double dx = std::max(point.x() - min_x, max_x - point.x());
+      const double dy = std::max(point.y() - min_y, max_y - point.y());
+      return dx * dx + dy * dy;
+    }
+  };
+
+  // The objects of the nodes, each node sorted by the min (or max) bound of
+  // the objects on its partition axis.
+  struct SortedObjects {
+    std::vector<ObjectPtr> objects;
+    std::vector<double> bounds;
+    std::vector<double> min_x;
+    std::vector<double> min_y;
+    std::vector<double> max_x;
+    std::vector<double> max_y;
+
+    void Reserve(const size_t size) {
+      objects.reserve(size);
+      bounds.reserve(size);
+      min_x.reserve(size);
+      min_y.reserve(size);
+      max_x.reserve(size);
+      max_y.reserve(size);
+    }
+
+    void Append(ObjectPtr object, const double bound) {
+      const AABox2d &aabox = object->aabox();
+      objects.push_back(object);
+      bounds.push_back(bound);
+      min_x.push_back(aabox.min_x());
+      min_y.push_back(aabox.min_y());
+      max_x.push_back(aabox.max_x());
+      max_y.push_back(aabox.max_y());
+    }
+
+    // The squared distances from a point to the nearest and the farthest
+    // point of the bounding box of an object, which bound the squared
+    // distance to the object itself.
+    double LowerDistanceSquareToPoint(const int i, const Vec2d &point) const {
+      const double dx =
+          std::max(std::max(min_x[i] - point.x(), point.x() - max_x[i]), 0.0);
+      const double dy =
+          std::max(std::max(min_y[i] - point.y(), point.y() - max_y[i]), 0.0);
+      return dx * dx + dy * dy;
+    }
+
+    double UpperDistanceSquareToPoint(const int i, const Vec2d &point) const {
+      const double dx = std::max(point.x() - min_x[i], max_x[i] - point.x());
+      const double dy = std::max(point.y() - min_y[i], max_y[i] - point.y());
+      return dx * dx + dy * dy;
+    }
+  };
+
+  int BuildNode(const std::vector<ObjectPtr> &objects,
+                const AABoxKDTreeParams &params, const int depth) {
+    CHECK(!objects.empty());
+    const int index = static_cast<int>(nodes_.size());
+    nodes_.emplace_back();
+
+    Node node;
+    ComputeBoundary(objects, &node);
+    ComputePartition(&node);
+    node.begin = static_cast<int>(objects_sorted_by_min_.objects.size());
+
+    std::vector<ObjectPtr> left_subnode_objects;
+    std::vector<ObjectPtr> right_subnode_objects;
+    if (SplitToSubNodes(objects, node, params, depth)) {
+      std::vector<ObjectPtr> other_objects;
+      PartitionObjects(objects, node, &left_subnode_objects,
+                       &right_subnode_objects, &other_objects);
+      AppendObjects(other_objects, node.partition);
+    } else {
+      AppendObjects(objects, node.partition);
+    }
+    node.end = static_cast<int>(objects_sorted_by_min_.objects.size());
+
+    // Split to sub-nodes. They are appended after this node, so the nodes
+    // and the objects of the subtree stay contiguous.
+    if (!left_subnode_objects.empty()) {
+      node.left = BuildNode(left_subnode_objects, params, depth + 1);
+    }
+    if (!right_subnode_objects.empty()) {
+      node.right = BuildNode(right_subnode_objects, params, depth + 1);
+    }
+    node.subtree_end = static_cast<int>(objects_sorted_by_min_.objects.size());
+    nodes_[index] = node;
+    return index;
+  }
+
+  void AppendObjects(const std::vector<ObjectPtr> &objects,
+                     const Partition partition) {
+    std::vector<ObjectPtr> objects_sorted_by_min = objects;
+    std::vector<ObjectPtr> objects_sorted_by_max = objects;
+    std::sort(objects_sorted_by_min.begin(), objects_sorted_by_min.end(),
               [&](ObjectPtr obj1, ObjectPtr obj2) {
-                return partition_ == PARTITION_X
+                return partition == PARTITION_X
                            ? obj1->aabox().min_x() < obj2->aabox().min_x()
                            : obj1->aabox().min_y() < obj2->aabox().min_y();
               });
-    std::sort(objects_sorted_by_max_.begin(), objects_sorted_by_max_.end(),
+    std::sort(objects_sorted_by_max.begin(), objects_sorted_by_max.end(),
               [&](ObjectPtr obj1, ObjectPtr obj2) {
-                return partition_ == PARTITION_X
+                return partition == PARTITION_X
                            ? obj1->aabox().max_x() > obj2->aabox().max_x()
                            : obj1->aabox().max_y() > obj2->aabox().max_y();
               });
-    objects_sorted_by_min_bound_.reserve(num_objects_);
-    for (ObjectPtr object : objects_sorted_by_min_) {
-      objects_sorted_by_min_bound_.push_back(partition_ == PARTITION_X
-                                                 ? object->aabox().min_x()
-                                                 : object->aabox().min_y());
+    for (ObjectPtr object : objects_sorted_by_min) {
+      objects_sorted_by_min_.Append(object, partition == PARTITION_X
+                                                ? object->aabox().min_x()
+                                                : object->aabox().min_y());
     }
-    objects_sorted_by_max_bound_.reserve(num_objects_);
-    for (ObjectPtr object : objects_sorted_by_max_) {
-      objects_sorted_by_max_bound_.push_back(partition_ == PARTITION_X
-                                                 ? object->aabox().max_x()
-                                                 : object->aabox().max_y());
+    for (ObjectPtr object : objects_sorted_by_max) {
+      objects_sorted_by_max_.Append(object, partition == PARTITION_X
+                                                ? object->aabox().max_x()
+                                                : object->aabox().max_y());
     }
   }
 
   bool SplitToSubNodes(const std::vector<ObjectPtr> &objects,
-                       const AABoxKDTreeParams &params) {
-    if (params.max_depth >= 0 && depth_ >= params.max_depth) {
+                       const Node &node, const AABoxKDTreeParams &params,
+                       const int depth) const {
+    if (depth >= kMaxDepth) {
+      return false;
+    }
+    if (params.max_depth >= 0 && depth >= params.max_depth) {
       return false;
     }
     if (static_cast<int>(objects.size()) <= std::max(1, params.max_leaf_size)) {
       return false;
     }
     if (params.max_leaf_dimension >= 0.0 &&
-        std::max(max_x_ - min_x_, max_y_ - min_y_) <=
+        std::max(node.max_x - node.min_x, node.max_y - node.min_y) <=
             params.max_leaf_dimension) {
       return false;
     }
     return true;
   }
 
-  double LowerDistanceSquareToPoint(const Vec2d &point) const {
-    double dx = 0.0;
-    if (point.x() < min_x_) {
-      dx = min_x_ - point.x();
-    } else if (point.x() > max_x_) {
-      dx = point.x() - max_x_;
-    }
-    double dy = 0.0;
-    if (point.y() < min_y_) {
-      dy = min_y_ - point.y();
-    } else if (point.y() > max_y_) {
-      dy = point.y() - max_y_;
-    }
-    return dx * dx + dy * dy;
-  }
-
-  double UpperDistanceSquareToPoint(const Vec2d &point) const {
-    const double dx =
-        (point.x() > mid_x_ ? (point.x() - min_x_) : (point.x() - max_x_));
-    const double dy =
-        (point.y() > mid_y_ ? (point.y() - min_y_) : (point.y() - max_y_));
-    return dx * dx + dy * dy;
-  }
-
-  void GetAllObjects(std::vector<ObjectPtr> *const result_objects) const {
-    result_objects->insert(result_objects->end(),
-                           objects_sorted_by_min_.begin(),
-                           objects_sorted_by_min_.end());
-    if (left_subnode_ != nullptr) {
-      left_subnode_->GetAllObjects(result_objects);
-    }
-    if (right_subnode_ != nullptr) {
-      right_subnode_->GetAllObjects(result_objects);
-    }
-  }
-
-  void GetObjectsInternal(const Vec2d &point, const double distance,
-                          const double distance_sqr,
-                          std::vector<ObjectPtr> *const result_objects) const {
-    if (LowerDistanceSquareToPoint(point) > distance_sqr) {
-      return;
-    }
-    if (UpperDistanceSquareToPoint(point) <= distance_sqr) {
-      GetAllObjects(result_objects);
-      return;
-    }
-    const double pvalue = (partition_ == PARTITION_X ? point.x() : point.y());
-    if (pvalue < partition_position_) {
-      const double limit = pvalue + distance;
-      for (int i = 0; i < num_objects_; ++i) {
-        if (objects_sorted_by_min_bound_[i] > limit) {
-          break;
-        }
-        ObjectPtr object = objects_sorted_by_min_[i];
-        if (object->DistanceSquareTo(point) <= distance_sqr) {
-          result_objects->push_back(object);
-        }
+  // Searches the objects of a node in the order they were sorted along the
+  // partition axis, until no further object can be nearer.
+  static void GetNearestObjectInNode(const SortedObjects &sorted,
+                                     const Node &node, const Vec2d &point,
+                                     const double pvalue,
+                                     const bool sorted_by_min,
+                                     double *const min_distance_sqr,
+                                     ObjectPtr *const nearest_object) {
+    double min_distance = *min_distance_sqr;
+    for (int i = node.begin; i < node.end; ++i) {
+      const double bound = sorted.bounds[i];
+      if ((sorted_by_min ? bound > pvalue : bound < pvalue) &&
+          Square(bound - pvalue) > min_distance) {
+        break;
       }
-    } else {
-      const double limit = pvalue - distance;
-      for (int i = 0; i < num_objects_; ++i) {
-        if (objects_sorted_by_max_bound_[i] < limit) {
-          break;
-        }
-        ObjectPtr object = objects_sorted_by_max_[i];
-        if (object->DistanceSquareTo(point) <= distance_sqr) {
-          result_objects->push_back(object);
-        }
+      ObjectPtr object = sorted.objects[i];
+      const double distance_sqr = object->DistanceSquareTo(point);
+      if (distance_sqr < min_distance) {
+        min_distance = distance_sqr;
+        *nearest_object = object;
       }
     }
-    if (left_subnode_ != nullptr) {
-      left_subnode_->GetObjectsInternal(point, distance, distance_sqr,
-                                        result_objects);
-    }
-    if (right_subnode_ != nullptr) {
-      right_subnode_->GetObjectsInternal(point, distance, distance_sqr,
-                                         result_objects);
-    }
+    *min_distance_sqr = min_distance;
   }
 
-  void GetNearestObjectInternal(const Vec2d &point,
-                                double *const min_distance_sqr,
-                                ObjectPtr *const nearest_object) const {
-    if (LowerDistanceSquareToPoint(point) >= *min_distance_sqr - kMathEpsilon) {
-      return;
-    }
-    const double pvalue = (partition_ == PARTITION_X ? point.x() : point.y());
-    const bool search_left_first = (pvalue < partition_position_);
-    if (search_left_first) {
-      if (left_subnode_ != nullptr) {
-        left_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                nearest_object);
-      }
-    } else {
-      if (right_subnode_ != nullptr) {
-        right_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                 nearest_object);
+  // Appends the objects in [begin, end) within the range. An object is
+  // decided by its bounding box alone when the box is entirely in or out
+  // of the range.
+  static void GetObjectsInRange(const SortedObjects &sorted, const int begin,
+                                const int end, const Vec2d &point,
+                                const double distance_sqr,
+                                std::vector<ObjectPtr> *const result_objects) {
+    int i = begin;
+#ifdef __SSE2__
+    // Two boxes at a time.
+    const __m128d px = _mm_set1_pd(point.x());
+    const __m128d py = _mm_set1_pd(point.y());
+    const __m128d zero = _mm_setzero_pd();
+    for (; i + 1 < end; i += 2) {
+      const __m128d dx_min = _mm_sub_pd(_mm_loadu_pd(&sorted.min_x[i]), px);
+      const __m128d dx_max = _mm_sub_pd(px, _mm_loadu_pd(&sorted.max_x[i]));
+      const __m128d dy_min = _mm_sub_pd(_mm_loadu_pd(&sorted.min_y[i]), py);
+      const __m128d dy_max = _mm_sub_pd(py, _mm_loadu_pd(&sorted.max_y[i]));
+      const __m128d lower_dx = _mm_max_pd(_mm_max_pd(dx_min, dx_max), zero);
+      const __m128d lower_dy = _mm_max_pd(_mm_max_pd(dy_min, dy_max), zero);
+      const __m128d upper_dx = _mm_max_pd(
+          _mm_max_pd(dx_min, _mm_sub_pd(zero, dx_min)),
+          _mm_max_pd(dx_max, _mm_sub_pd(zero, dx_max)));
+      const __m128d upper_dy = _mm_max_pd(
+          _mm_max_pd(dy_min, _mm_sub_pd(zero, dy_min)),
+          _mm_max_pd(dy_max, _mm_sub_pd(zero, dy_max)));
+      double lower[2];
+      double upper[2];
+      _mm_storeu_pd(lower, _mm_add_pd(_mm_mul_pd(lower_dx, lower_dx),
+                                      _mm_mul_pd(lower_dy, lower_dy)));
+      _mm_storeu_pd(upper, _mm_add_pd(_mm_mul_pd(upper_dx, upper_dx),
+                                      _mm_mul_pd(upper_dy, upper_dy)));
+      for (int k = 0; k < 2; ++k) {
+        AddObjectInRange(sorted.objects[i + k], lower[k], upper[k], point,
+                         distance_sqr, result_objects);
       }
     }
-    if (*min_distance_sqr <= kMathEpsilon) {
-      return;
+#endif
+    for (; i < end; ++i) {
+      AddObjectInRange(sorted.objects[i],
+                       sorted.LowerDistanceSquareToPoint(i, point),
+                       sorted.UpperDistanceSquareToPoint(i, point), point,
+                       distance_sqr, result_objects);
     }
+  }
 
-    if (search_left_first) {
-      for (int i = 0; i < num_objects_; ++i) {
-        const double bound = objects_sorted_by_min_bound_[i];
-        if (bound > pvalue && Square(bound - pvalue) > *min_distance_sqr) {
-          break;
-        }
-        ObjectPtr object = objects_sorted_by_min_[i];
-        const double distance_sqr = object->DistanceSquareTo(point);
-        if (distance_sqr < *min_distance_sqr) {
-          *min_distance_sqr = distance_sqr;
-          *nearest_object = object;
-        }
-      }
-    } else {
-      for (int i = 0; i < num_objects_; ++i) {
-        const double bound = objects_sorted_by_max_bound_[i];
-        if (bound < pvalue && Square(bound - pvalue) > *min_distance_sqr) {
-          break;
-        }
-        ObjectPtr object = objects_sorted_by_max_[i];
-        const double distance_sqr = object->DistanceSquareTo(point);
-        if (distance_sqr < *min_distance_sqr) {
-          *min_distance_sqr = distance_sqr;
-          *nearest_object = object;
-        }
-      }
-    }
-    if (*min_distance_sqr <= kMathEpsilon) {
+  static void AddObjectInRange(ObjectPtr object, const double lower,
+                               const double upper, const Vec2d &point,
+                               const double distance_sqr,
+                               std::vector<ObjectPtr> *const result_objects) {
+    if (lower > distance_sqr) {
       return;
     }
-    if (search_left_first) {
-      if (right_subnode_ != nullptr) {
-        right_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                 nearest_object);
-      }
-    } else {
-      if (left_subnode_ != nullptr) {
-        left_subnode_->GetNearestObjectInternal(point, min_distance_sqr,
-                                                nearest_object);
-      }
+    if (upper <= distance_sqr ||
+        object->DistanceSquareTo(point) <= distance_sqr) {
+      result_objects->push_back(object);
     }
   }
 
-  void ComputeBoundary(const std::vector<ObjectPtr> &objects) {
-    min_x_ = std::numeric_limits<double>::infinity();
-    min_y_ = std::numeric_limits<double>::infinity();
-    max_x_ = -std::numeric_limits<double>::infinity();
-    max_y_ = -std::numeric_limits<double>::infinity();
+  static void ComputeBoundary(const std::vector<ObjectPtr> &objects,
+                              Node *const node) {
+    node->min_x = std::numeric_limits<double>::infinity();
+    node->min_y = std::numeric_limits<double>::infinity();
+    node->max_x = -std::numeric_limits<double>::infinity();
+    node->max_y = -std::numeric_limits<double>::infinity();
     for (ObjectPtr object : objects) {
-      min_x_ = std::min(min_x_, object->aabox().min_x());
-      max_x_ = std::max(max_x_, object->aabox().max_x());
-      min_y_ = std::min(min_y_, object->aabox().min_y());
-      max_y_ = std::max(max_y_, object->aabox().max_y());
+      node->min_x = std::min(node->min_x, object->aabox().min_x());
+      node->max_x = std::max(node->max_x, object->aabox().max_x());
+      node->min_y = std::min(node->min_y, object->aabox().min_y());
+      node->max_y = std::max(node->max_y, object->aabox().max_y());
     }
-    mid_x_ = (min_x_ + max_x_) / 2.0;
-    mid_y_ = (min_y_ + max_y_) / 2.0;
   }
 
-  void ComputePartition() {
-    if (max_x_ - min_x_ >= max_y_ - min_y_) {
-      partition_ = PARTITION_X;
-      partition_position_ = (min_x_ + max_x_) / 2.0;
+  static void ComputePartition(Node *const node) {
+    if (node->max_x - node->min_x >= node->max_y - node->min_y) {
+      node->partition = PARTITION_X;
+      node->partition_position = (node->min_x + node->max_x) / 2.0;
     } else {
-      partition_ = PARTITION_Y;
-      partition_position_ = (min_y_ + max_y_) / 2.0;
+      node->partition = PARTITION_Y;
+      node->partition_position = (node->min_y + node->max_y) / 2.0;
     }
   }
 
-  void PartitionObjects(const std::vector<ObjectPtr> &objects,
-                        std::vector<ObjectPtr> *const left_subnode_objects,
-                        std::vector<ObjectPtr> *const right_subnode_objects) {
-    left_subnode_objects->clear();
-    right_subnode_objects->clear();
-    std::vector<ObjectPtr> other_objects;
-    if (partition_ == PARTITION_X) {
+  static void PartitionObjects(
+      const std::vector<ObjectPtr> &objects, const Node &node,
+      std::vector<ObjectPtr> *const left_subnode_objects,
+      std::vector<ObjectPtr> *const right_subnode_objects,
+      std::vector<ObjectPtr> *const other_objects) {
+    if (node.partition == PARTITION_X) {
       for (ObjectPtr object : objects) {
-        if (object->aabox().max_x() <= partition_position_) {
+        if (object->aabox().max_x() <= node.partition_position) {
           left_subnode_objects->push_back(object);
-        } else if (object->aabox().min_x() >= partition_position_) {
+        } else if (object->aabox().min_x() >= node.partition_position) {
           right_subnode_objects->push_back(object);
         } else {
-          other_objects.push_back(object);
+          other_objects->push_back(object);
         }
       }
     } else {
       for (ObjectPtr object : objects) {
-        if (object->aabox().max_y() <= partition_position_) {
+        if (object->aabox().max_y() <= node.partition_position) {
           left_subnode_objects->push_back(object);
-        } else if (object->aabox().min_y() >= partition_position_) {
+        } else if (object->aabox().min_y() >= node.partition_position) {
           right_subnode_objects->push_back(object);
         } else {
-          other_objects.push_back(object);
+          other_objects->push_back(object);
         }
       }
     }
-    InitObjects(other_objects);
-  }
-
- private:
-  int num_objects_ = 0;
-  std::vector<ObjectPtr> objects_sorted_by_min_;
-  std::vector<ObjectPtr> objects_sorted_by_max_;
-  std::vector<double> objects_sorted_by_min_bound_;
-  std::vector<double> objects_sorted_by_max_bound_;
-  int depth_ = 0;
-
-  // Boundary
-  double min_x_ = 0.0;
-  double max_x_ = 0.0;
-  double min_y_ = 0.0;
-  double max_y_ = 0.0;
-  double mid_x_ = 0.0;
-  double mid_y_ = 0.0;
-
-  enum Partition {
-    PARTITION_X = 1,
-    PARTITION_Y = 2,
-  };
-  Partition partition_ = PARTITION_X;
-  double partition_position_ = 0.0;
-
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> left_subnode_ = nullptr;
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> right_subnode_ = nullptr;
-};
-
-/**
- * @class AABoxKDTree2d
- * @brief The class of KD-tree of Aligned Axis Bounding Box(AABox).
- */
-template <class ObjectType>
-class AABoxKDTree2d {
- public:
-  using ObjectPtr = const ObjectType *;
-
-  /**
-   * @brief Contructor which takes a vector of objects and parameters.
-   * @param params Parameters to build the KD-tree.
-   */
-  AABoxKDTree2d(const std::vector<ObjectType> &objects,
-                const AABoxKDTreeParams &params) {
-    if (!objects.empty()) {
-      std::vector<ObjectPtr> object_ptrs;
-      for (const auto &object : objects) {
-        object_ptrs.push_back(&object);
-      }
-      root_.reset(new AABoxKDTree2dNode<ObjectType>(object_ptrs, params, 0));
-    }
-  }
-
-  /**
-   * @brief Get the nearest object to a target point.
-   * @param point The target point. Search it's nearest object.
-   * @return The nearest object to the target point.
-   */
-  ObjectPtr GetNearestObject(const Vec2d &point) const {
-    return root_ == nullptr ? nullptr : root_->GetNearestObject(point);
-  }
-
-  /**
-   * @brief Get objects within a distance to a point.
-   * @param point The center point of the range to search objects.
-   * @param distance The radius of the range to search objects.
-   * @return All objects within the specified distance to the specified point.
-   */
-  std::vector<ObjectPtr> GetObjects(const Vec2d &point,
-                                    const double distance) const {
-    if (root_ == nullptr) {
-      return {};
-    }
-    return root_->GetObjects(point, distance);
   }
 
-  /**
-   * @brief Get the axis-aligned bounding box of the objects.
-   * @return The axis-aligned bounding box of the objects.
-   */
-  AABox2d GetBoundingBox() const {
-    return root_ == nullptr ? AABox2d() : root_->GetBoundingBox();
-  }
-
- private:
-  std::unique_ptr<AABoxKDTree2dNode<ObjectType>> root_ = nullptr;
+  std::vector<Node> nodes_;
+  SortedObjects objects_sorted_by_min_;
+  SortedObjects objects_sorted_by_max_;
 };
 
 }  // namespace math
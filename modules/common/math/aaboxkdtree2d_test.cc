@@ -16,7 +16,10 @@
 
 #include "modules/common/math/aaboxkdtree2d.h"
 
+#include <limits>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -118,6 +121,56 @@ TEST(AABoxKDTree2dNode, OverallTests) {
   }
 }
 
+TEST(AABoxKDTree2d, DeepTree) {
+  // Many identical objects cannot be separated by any split, and many small
+  // ones make a deep tree with leaves of one object.
+  unsigned int seed = 1;
+  std::vector<Object> objects;
+  for (int i = 0; i < 100; ++i) {
+    objects.emplace_back(1.0, 1.0, 1.0, 1.0, i);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    const double x = RandomDouble(-100.0, 100.0, ++seed);
+    const double y = RandomDouble(-100.0, 100.0, ++seed);
+    objects.emplace_back(x, y, x + 0.01, y, 100 + i);
+  }
+  AABoxKDTreeParams params;
+  params.max_leaf_size = 1;
+  const AABoxKDTree2d<Object> kdtree(objects, params);
+  EXPECT_NEAR(-100.0, kdtree.GetBoundingBox().min_x(), 1.0);
+
+  const Object *nearest_object = kdtree.GetNearestObject({1.0, 1.0});
+  ASSERT_TRUE(nearest_object != nullptr);
+  EXPECT_NEAR(0.0, nearest_object->DistanceTo({1.0, 1.0}), 1e-9);
+
+  std::vector<const Object *> result_objects = {&objects.back()};
+  kdtree.GetObjects({1.0, 1.0}, 1e-6, &result_objects);
+  ASSERT_GE(result_objects.size(), 101);
+  EXPECT_EQ(&objects.back(), result_objects.front());
+
+  for (int i = 0; i < 100; ++i) {
+    const Vec2d point(RandomDouble(-150.0, 150.0, ++seed),
+                      RandomDouble(-150.0, 150.0, ++seed));
+    const double distance = RandomDouble(0.0, 50.0, ++seed);
+    int expected_count = 0;
+    double expected_distance = std::numeric_limits<double>::infinity();
+    for (const auto &object : objects) {
+      const double d = object.DistanceTo(point);
+      expected_count += (d <= distance ? 1 : 0);
+      expected_distance = std::min(expected_distance, d);
+    }
+    EXPECT_EQ(expected_count, kdtree.GetObjects(point, distance).size());
+    EXPECT_NEAR(expected_distance,
+                kdtree.GetNearestObject(point)->DistanceTo(point), 1e-9);
+  }
+}
+
+TEST(AABoxKDTree2d, Empty) {
+  const AABoxKDTree2d<Object> kdtree({}, AABoxKDTreeParams());
+  EXPECT_TRUE(kdtree.GetNearestObject({0.0, 0.0}) == nullptr);
+  EXPECT_TRUE(kdtree.GetObjects({0.0, 0.0}, 10.0).empty());
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
@@ -23,6 +23,7 @@
 #include "modules/common/log.h"
 #include "modules/common/util/string_util.h"
 
+#include "modules/common/math/fast_trig.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/math/polygon2d.h"
 
@@ -57,9 +58,8 @@ Box2d::Box2d(const Vec2d &center, const double heading, const double length,
       width_(width),
       half_length_(length / 2.0),
       half_width_(width / 2.0),
-      heading_(heading),
-      cos_heading_(cos(heading)),
-      sin_heading_(sin(heading)) {
+      heading_(heading) {
+  FastSinCos(heading, &sin_heading_, &cos_heading_);
   CHECK_GT(length_, -kMathEpsilon);
   CHECK_GT(width_, -kMathEpsilon);
   InitCorners();
@@ -319,8 +319,7 @@ AABox2d Box2d::GetAABox() const {
 
 void Box2d::RotateFromCenter(const double rotate_angle) {
   heading_ = NormalizeAngle(heading_ + rotate_angle);
-  cos_heading_ = std::cos(heading_);
-  sin_heading_ = std::sin(heading_);
+  FastSinCos(heading_, &sin_heading_, &cos_heading_);
   InitCorners();
 }
 
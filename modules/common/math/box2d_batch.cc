@@ -0,0 +1,483 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/box2d_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+// The boxes are tested by blocks of this size, for the results to stay on
+// the stack.
+constexpr size_t kBlockSize = 64;
+
+double DistanceSquareToBox(const double x, const double y,
+                           const double center_x, const double center_y,
+                           const double cos_heading, const double sin_heading,
+                           const double half_length, const double half_width) {
+  const double x0 = x - center_x;
+  const double y0 = y - center_y;
+  const double dx = std::max(
+      std::abs(x0 * cos_heading + y0 * sin_heading) - half_length, 0.0);
+  const double dy = std::max(
+      std::abs(x0 * sin_heading - y0 * cos_heading) - half_width, 0.0);
+  return dx * dx + dy * dy;
+}
+
+#ifdef __SSE2__
+inline __m128d Abs(const __m128d value) {
+  return _mm_andnot_pd(_mm_set1_pd(-0.0), value);
+}
+
+// The projections of (x, y) on the heading axis and on its normal.
+inline __m128d ProjectOnHeading(const __m128d x, const __m128d y,
+                                const __m128d cos_heading,
+                                const __m128d sin_heading) {
+  return _mm_add_pd(_mm_mul_pd(x, cos_heading), _mm_mul_pd(y, sin_heading));
+}
+
+inline __m128d ProjectOnNormal(const __m128d x, const __m128d y,
+                               const __m128d cos_heading,
+                               const __m128d sin_heading) {
+  return _mm_sub_pd(_mm_mul_pd(x, sin_heading), _mm_mul_pd(y, cos_heading));
+}
+
+inline __m128d DistanceSquareToBox(const __m128d x, const __m128d y,
+                                   const __m128d center_x,
+                                   const __m128d center_y,
+                                   const __m128d cos_heading,
+                                   const __m128d sin_heading,
+                                   const __m128d half_length,
+                                   const __m128d half_width) {
+  const __m128d x0 = _mm_sub_pd(x, center_x);
+  const __m128d y0 = _mm_sub_pd(y, center_y);
+  const __m128d zero = _mm_setzero_pd();
+  const __m128d dx = _mm_max_pd(
+      _mm_sub_pd(Abs(ProjectOnHeading(x0, y0, cos_heading, sin_heading)),
+                 half_length),
+      zero);
+  const __m128d dy = _mm_max_pd(
+      _mm_sub_pd(Abs(ProjectOnNormal(x0, y0, cos_heading, sin_heading)),
+                 half_width),
+      zero);
+  return _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+}
+#endif
+
+}  // namespace
+
+struct Box2dBatch::Query {
+  double center_x = 0.0;
+  double center_y = 0.0;
+  double cos_heading = 0.0;
+  double sin_heading = 0.0;
+  double half_length = 0.0;
+  double half_width = 0.0;
+  double min_x = 0.0;
+  double max_x = 0.0;
+  double min_y = 0.0;
+  double max_y = 0.0;
+  // The half axes, as in Box2d::HasOverlap().
+  double dx1 = 0.0;
+  double dy1 = 0.0;
+  double dx2 = 0.0;
+  double dy2 = 0.0;
+  double corner_x[4];
+  double corner_y[4];
+
+  Query(const double x, const double y, const double cos_value,
+        const double sin_value, const double half_length_value,
+        const double half_width_value)
+      : center_x(x),
+        center_y(y),
+        cos_heading(cos_value),
+        sin_heading(sin_value),
+        half_length(half_length_value),
+        half_width(half_width_value),
+        dx1(cos_value * half_length_value),
+        dy1(sin_value * half_length_value),
+        dx2(sin_value * half_width_value),
+        dy2(-cos_value * half_width_value) {
+    // In the order of Box2d::GetAllCorners().
+    corner_x[0] = x + dx1 + dx2;
+    corner_y[0] = y + dy1 + dy2;
+    corner_x[1] = x + dx1 - dx2;
+    corner_y[1] = y + dy1 - dy2;
+    corner_x[2] = x - dx1 - dx2;
+    corner_y[2] = y - dy1 - dy2;
+    corner_x[3] = x - dx1 + dx2;
+    corner_y[3] = y - dy1 + dy2;
+    min_x = *std::min_element(corner_x, corner_x + 4);
+    max_x = *std::max_element(corner_x, corner_x + 4);
+    min_y = *std::min_element(corner_y, corner_y + 4);
+    max_y = *std::max_element(corner_y, corner_y + 4);
+  }
+};
+
+Box2dBatch::Box2dBatch(const std::vector<Box2d> &boxes) {
+  Reserve(boxes.size());
+  for (const auto &box : boxes) {
+    Add(box);
+  }
+}
+
+void Box2dBatch::Add(const Box2d &box) {
+  const Query query = MakeQuery(box);
+  center_x_.push_back(query.center_x);
+  center_y_.push_back(query.center_y);
+  cos_heading_.push_back(query.cos_heading);
+  sin_heading_.push_back(query.sin_heading);
+  half_length_.push_back(query.half_length);
+  half_width_.push_back(query.half_width);
+  heading_.push_back(box.heading());
+  min_x_.push_back(query.min_x);
+  max_x_.push_back(query.max_x);
+  min_y_.push_back(query.min_y);
+  max_y_.push_back(query.max_y);
+}
+
+void Box2dBatch::Reserve(const size_t size) {
+  for (auto *values : {&center_x_, &center_y_, &cos_heading_, &sin_heading_,
+                       &half_length_, &half_width_, &heading_, &min_x_,
+                       &max_x_, &min_y_, &max_y_}) {
+    values->reserve(size);
+  }
+}
+
+void Box2dBatch::Clear() {
+  for (auto *values : {&center_x_, &center_y_, &cos_heading_, &sin_heading_,
+                       &half_length_, &half_width_, &heading_, &min_x_,
+                       &max_x_, &min_y_, &max_y_}) {
+    values->clear();
+  }
+}
+
+Box2d Box2dBatch::box(const size_t index) const {
+  return Box2d({center_x_[index], center_y_[index]}, heading_[index],
+               half_length_[index] * 2.0, half_width_[index] * 2.0);
+}
+
+Box2dBatch::Query Box2dBatch::MakeQuery(const Box2d &box) {
+  return Query(box.center_x(), box.center_y(), box.cos_heading(),
+               box.sin_heading(), box.half_length(), box.half_width());
+}
+
+Box2dBatch::Query Box2dBatch::MakeQuery(const size_t index) const {
+  return Query(center_x_[index], center_y_[index], cos_heading_[index],
+               sin_heading_[index], half_length_[index], half_width_[index]);
+}
+
+bool Box2dBatch::HasOverlap(const Box2d &box) const {
+  const Query query = MakeQuery(box);
+  bool overlaps[kBlockSize];
+  for (size_t begin = 0; begin < size(); begin += kBlockSize) {
+    const size_t end = std::min(begin + kBlockSize, size());
+    HasOverlap(query, begin, end, overlaps);
+    if (std::find(overlaps, overlaps + (end - begin), true) !=
+        overlaps + (end - begin)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Box2dBatch::GetOverlaps(const Box2d &box,
+                             std::vector<int> *const indices) const {
+  indices->clear();
+  const Query query = MakeQuery(box);
+  bool overlaps[kBlockSize];
+  for (size_t begin = 0; begin < size(); begin += kBlockSize) {
+    const size_t end = std::min(begin + kBlockSize, size());
+    HasOverlap(query, begin, end, overlaps);
+    for (size_t i = begin; i < end; ++i) {
+      if (overlaps[i - begin]) {
+        indices->push_back(static_cast<int>(i));
+      }
+    }
+  }
+}
+
+void Box2dBatch::GetOverlaps(
+    const Box2dBatch &other,
+    std::vector<std::pair<int, int>> *const pairs) const {
+  pairs->clear();
+  bool overlaps[kBlockSize];
+  for (size_t j = 0; j < other.size(); ++j) {
+    const Query query = other.MakeQuery(j);
+    for (size_t begin = 0; begin < size(); begin += kBlockSize) {
+      const size_t end = std::min(begin + kBlockSize, size());
+      HasOverlap(query, begin, end, overlaps);
+      for (size_t i = begin; i < end; ++i) {
+        if (overlaps[i - begin]) {
+          pairs->emplace_back(static_cast<int>(i), static_cast<int>(j));
+        }
+      }
+    }
+  }
+}
+
+void Box2dBatch::DistanceTo(const Box2d &box,
+                            std::vector<double> *const distances) const {
+  distances->resize(size());
+  const Query query = MakeQuery(box);
+  for (size_t begin = 0; begin < size(); begin += kBlockSize) {
+    const size_t end = std::min(begin + kBlockSize, size());
+    DistanceSquareTo(query, begin, end, distances->data() + begin);
+  }
+  for (double &distance : *distances) {
+    distance = std::sqrt(distance);
+  }
+}
+
+double Box2dBatch::MinDistanceTo(const Box2d &box) const {
+  const Query query = MakeQuery(box);
+  double min_distance_sqr = std::numeric_limits<double>::infinity();
+  double distances_sqr[kBlockSize];
+  for (size_t begin = 0; begin < size(); begin += kBlockSize) {
+    const size_t end = std::min(begin + kBlockSize, size());
+    DistanceSquareTo(query, begin, end, distances_sqr);
+    min_distance_sqr = std::min(
+        min_distance_sqr,
+        *std::min_element(distances_sqr, distances_sqr + (end - begin)));
+  }
+  return std::sqrt(min_distance_sqr);
+}
+
+void Box2dBatch::HasOverlap(const Query &query, const size_t begin,
+                            const size_t end, bool *const overlaps) const {
+  size_t i = begin;
+#ifdef __SSE2__
+  // Two boxes at a time, with the separating axis tests of
+  // Box2d::HasOverlap().
+  const __m128d query_x = _mm_set1_pd(query.center_x);
+  const __m128d query_y = _mm_set1_pd(query.center_y);
+  const __m128d query_cos = _mm_set1_pd(query.cos_heading);
+  const __m128d query_sin = _mm_set1_pd(query.sin_heading);
+  const __m128d query_half_length = _mm_set1_pd(query.half_length);
+  const __m128d query_half_width = _mm_set1_pd(query.half_width);
+  const __m128d dx1 = _mm_set1_pd(query.dx1);
+  const __m128d dy1 = _mm_set1_pd(query.dy1);
+  const __m128d dx2 = _mm_set1_pd(query.dx2);
+  const __m128d dy2 = _mm_set1_pd(query.dy2);
+  const __m128d zero = _mm_setzero_pd();
+  for (; i + 1 < end; i += 2) {
+    // Bounding boxes.
+    __m128d separated = _mm_or_pd(
+        _mm_or_pd(_mm_cmplt_pd(_mm_loadu_pd(&max_x_[i]),
+                               _mm_set1_pd(query.min_x)),
+                  _mm_cmpgt_pd(_mm_loadu_pd(&min_x_[i]),
+                               _mm_set1_pd(query.max_x))),
+        _mm_or_pd(_mm_cmplt_pd(_mm_loadu_pd(&max_y_[i]),
+                               _mm_set1_pd(query.min_y)),
+                  _mm_cmpgt_pd(_mm_loadu_pd(&min_y_[i]),
+                               _mm_set1_pd(query.max_y))));
+    if (_mm_movemask_pd(separated) == 3) {
+      // Most boxes are far from each other.
+      overlaps[i - begin] = false;
+      overlaps[i + 1 - begin] = false;
+      continue;
+    }
+
+    const __m128d cos_heading = _mm_loadu_pd(&cos_heading_[i]);
+    const __m128d sin_heading = _mm_loadu_pd(&sin_heading_[i]);
+    const __m128d half_length = _mm_loadu_pd(&half_length_[i]);
+    const __m128d half_width = _mm_loadu_pd(&half_width_[i]);
+    const __m128d shift_x = _mm_sub_pd(_mm_loadu_pd(&center_x_[i]), query_x);
+    const __m128d shift_y = _mm_sub_pd(_mm_loadu_pd(&center_y_[i]), query_y);
+    const __m128d dx3 = _mm_mul_pd(cos_heading, half_length);
+    const __m128d dy3 = _mm_mul_pd(sin_heading, half_length);
+    const __m128d dx4 = _mm_mul_pd(sin_heading, half_width);
+    const __m128d dy4 = _mm_sub_pd(zero, _mm_mul_pd(cos_heading, half_width));
+
+    // The axes of the query box.
+    separated = _mm_or_pd(
+        separated,
+        _mm_cmpgt_pd(
+            Abs(ProjectOnHeading(shift_x, shift_y, query_cos, query_sin)),
+            _mm_add_pd(
+                _mm_add_pd(
+                    Abs(ProjectOnHeading(dx3, dy3, query_cos, query_sin)),
+                    Abs(ProjectOnHeading(dx4, dy4, query_cos, query_sin))),
+                query_half_length)));
+    separated = _mm_or_pd(
+        separated,
+        _mm_cmpgt_pd(
+            Abs(ProjectOnNormal(shift_x, shift_y, query_cos, query_sin)),
+            _mm_add_pd(
+                _mm_add_pd(
+                    Abs(ProjectOnNormal(dx3, dy3, query_cos, query_sin)),
+                    Abs(ProjectOnNormal(dx4, dy4, query_cos, query_sin))),
+                query_half_width)));
+    // The axes of the boxes of the batch.
+    separated = _mm_or_pd(
+        separated,
+        _mm_cmpgt_pd(
+            Abs(ProjectOnHeading(shift_x, shift_y, cos_heading, sin_heading)),
+            _mm_add_pd(
+                _mm_add_pd(
+                    Abs(ProjectOnHeading(dx1, dy1, cos_heading, sin_heading)),
+                    Abs(ProjectOnHeading(dx2, dy2, cos_heading, sin_heading))),
+                half_length)));
+    separated = _mm_or_pd(
+        separated,
+        _mm_cmpgt_pd(
+            Abs(ProjectOnNormal(shift_x, shift_y, cos_heading, sin_heading)),
+            _mm_add_pd(
+                _mm_add_pd(
+                    Abs(ProjectOnNormal(dx1, dy1, cos_heading, sin_heading)),
+                    Abs(ProjectOnNormal(dx2, dy2, cos_heading, sin_heading))),
+                half_width)));
+    const int mask = _mm_movemask_pd(separated);
+    overlaps[i - begin] = (mask & 1) == 0;
+    overlaps[i + 1 - begin] = (mask & 2) == 0;
+  }
+#endif
+  for (; i < end; ++i) {
+    if (max_x_[i] < query.min_x || min_x_[i] > query.max_x ||
+        max_y_[i] < query.min_y || min_y_[i] > query.max_y) {
+      overlaps[i - begin] = false;
+      continue;
+    }
+    const double cos_heading = cos_heading_[i];
+    const double sin_heading = sin_heading_[i];
+    const double shift_x = center_x_[i] - query.center_x;
+    const double shift_y = center_y_[i] - query.center_y;
+    const double dx3 = cos_heading * half_length_[i];
+    const double dy3 = sin_heading * half_length_[i];
+    const double dx4 = sin_heading * half_width_[i];
+    const double dy4 = -cos_heading * half_width_[i];
+    overlaps[i - begin] =
+        std::abs(shift_x * query.cos_heading + shift_y * query.sin_heading) <=
+            std::abs(dx3 * query.cos_heading + dy3 * query.sin_heading) +
+                std::abs(dx4 * query.cos_heading + dy4 * query.sin_heading) +
+                query.half_length &&
+        std::abs(shift_x * query.sin_heading - shift_y * query.cos_heading) <=
+            std::abs(dx3 * query.sin_heading - dy3 * query.cos_heading) +
+                std::abs(dx4 * query.sin_heading - dy4 * query.cos_heading) +
+                query.half_width &&
+        std::abs(shift_x * cos_heading + shift_y * sin_heading) <=
+            std::abs(query.dx1 * cos_heading + query.dy1 * sin_heading) +
+                std::abs(query.dx2 * cos_heading + query.dy2 * sin_heading) +
+                half_length_[i] &&
+        std::abs(shift_x * sin_heading - shift_y * cos_heading) <=
+            std::abs(query.dx1 * sin_heading - query.dy1 * cos_heading) +
+                std::abs(query.dx2 * sin_heading - query.dy2 * cos_heading) +
+                half_width_[i];
+  }
+}
+
+void Box2dBatch::DistanceSquareTo(const Query &query, const size_t begin,
+                                  const size_t end,
+                                  double *const distances_sqr) const {
+  // The distance between two separated boxes is the one from a corner of
+  // one of them to the other.
+  bool overlaps[kBlockSize];
+  for (size_t block = begin; block < end; block += kBlockSize) {
+    const size_t block_end = std::min(block + kBlockSize, end);
+    HasOverlap(query, block, block_end, overlaps);
+    size_t i = block;
+#ifdef __SSE2__
+    const __m128d query_x = _mm_set1_pd(query.center_x);
+    const __m128d query_y = _mm_set1_pd(query.center_y);
+    const __m128d query_cos = _mm_set1_pd(query.cos_heading);
+    const __m128d query_sin = _mm_set1_pd(query.sin_heading);
+    const __m128d query_half_length = _mm_set1_pd(query.half_length);
+    const __m128d query_half_width = _mm_set1_pd(query.half_width);
+    for (; i + 1 < block_end; i += 2) {
+      const __m128d center_x = _mm_loadu_pd(&center_x_[i]);
+      const __m128d center_y = _mm_loadu_pd(&center_y_[i]);
+      const __m128d cos_heading = _mm_loadu_pd(&cos_heading_[i]);
+      const __m128d sin_heading = _mm_loadu_pd(&sin_heading_[i]);
+      const __m128d half_length = _mm_loadu_pd(&half_length_[i]);
+      const __m128d half_width = _mm_loadu_pd(&half_width_[i]);
+      __m128d min_distance_sqr = _mm_set1_pd(
+          std::numeric_limits<double>::infinity());
+      // The corners of the query to the boxes.
+      for (int k = 0; k < 4; ++k) {
+        min_distance_sqr = _mm_min_pd(
+            min_distance_sqr,
+            DistanceSquareToBox(_mm_set1_pd(query.corner_x[k]),
+                                _mm_set1_pd(query.corner_y[k]), center_x,
+                                center_y, cos_heading, sin_heading,
+                                half_length, half_width));
+      }
+      // The corners of the boxes to the query.
+      const __m128d dx1 = _mm_mul_pd(cos_heading, half_length);
+      const __m128d dy1 = _mm_mul_pd(sin_heading, half_length);
+      const __m128d dx2 = _mm_mul_pd(sin_heading, half_width);
+      const __m128d dy2 = _mm_sub_pd(_mm_setzero_pd(),
+                                     _mm_mul_pd(cos_heading, half_width));
+      for (int k = 0; k < 4; ++k) {
+        const __m128d sign1 = _mm_set1_pd(k < 2 ? 1.0 : -1.0);
+        const __m128d sign2 = _mm_set1_pd(k == 0 || k == 3 ? 1.0 : -1.0);
+        const __m128d corner_x = _mm_add_pd(
+            center_x, _mm_add_pd(_mm_mul_pd(sign1, dx1),
+                                 _mm_mul_pd(sign2, dx2)));
+        const __m128d corner_y = _mm_add_pd(
+            center_y, _mm_add_pd(_mm_mul_pd(sign1, dy1),
+                                 _mm_mul_pd(sign2, dy2)));
+        min_distance_sqr = _mm_min_pd(
+            min_distance_sqr,
+            DistanceSquareToBox(corner_x, corner_y, query_x, query_y,
+                                query_cos, query_sin, query_half_length,
+                                query_half_width));
+      }
+      _mm_storeu_pd(&distances_sqr[i - begin], min_distance_sqr);
+      for (size_t k = i; k < i + 2; ++k) {
+        if (overlaps[k - block]) {
+          distances_sqr[k - begin] = 0.0;
+        }
+      }
+    }
+#endif
+    for (; i < block_end; ++i) {
+      if (overlaps[i - block]) {
+        distances_sqr[i - begin] = 0.0;
+        continue;
+      }
+      const Query box = MakeQuery(i);
+      double min_distance_sqr = std::numeric_limits<double>::infinity();
+      for (int k = 0; k < 4; ++k) {
+        min_distance_sqr = std::min(
+            min_distance_sqr,
+            DistanceSquareToBox(query.corner_x[k], query.corner_y[k],
+                                box.center_x, box.center_y, box.cos_heading,
+                                box.sin_heading, box.half_length,
+                                box.half_width));
+        min_distance_sqr = std::min(
+            min_distance_sqr,
+            DistanceSquareToBox(box.corner_x[k], box.corner_y[k],
+                                query.center_x, query.center_y,
+                                query.cos_heading, query.sin_heading,
+                                query.half_length, query.half_width));
+      }
+      distances_sqr[i - begin] = min_distance_sqr;
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
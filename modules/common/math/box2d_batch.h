@@ -0,0 +1,156 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief The class of Box2dBatch, overlap and distance tests of one box
+ *        against many.
+ */
+
+#ifndef MODULES_COMMON_MATH_BOX2D_BATCH_H_
+#define MODULES_COMMON_MATH_BOX2D_BATCH_H_
+
+#include <utility>
+#include <vector>
+
+#include "modules/common/math/box2d.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class Box2dBatch
+ * @brief A set of boxes stored in structure-of-arrays layout, to test a box
+ *        against all of them at once.
+ *
+ * \par
+ * The tests give the results of Box2d::HasOverlap() and Box2d::DistanceTo()
+ * on every pair, up to rounding for the distances, and are vectorized with
+ * SSE2 when available, two boxes at a time.
+ */
+class Box2dBatch {
+ public:
+  Box2dBatch() = default;
+
+  /**
+   * @brief Constructor which takes the boxes.
+   * @param boxes The boxes of the batch, in the order of their indices.
+   */
+  explicit Box2dBatch(const std::vector<Box2d> &boxes);
+
+  /**
+   * @brief Appends a box to the batch.
+   * @param box The box to append, of index size() - 1 afterwards.
+   */
+  void Add(const Box2d &box);
+
+  /**
+   * @brief Reserves the room of a number of boxes.
+   */
+  void Reserve(const size_t size);
+
+  /**
+   * @brief Removes all the boxes.
+   */
+  void Clear();
+
+  /**
+   * @brief Gets the number of boxes.
+   */
+  size_t size() const { return center_x_.size(); }
+
+  /**
+   * @brief Gets a box of the batch.
+   * @param index The index of the box.
+   * @return The box.
+   */
+  Box2d box(const size_t index) const;
+
+  /**
+   * @brief Tests whether a box overlaps any box of the batch.
+   * @param box The box to test.
+   * @return True if the box overlaps with some box of the batch.
+   */
+  bool HasOverlap(const Box2d &box) const;
+
+  /**
+   * @brief Gets the boxes of the batch a box overlaps with.
+   * @param box The box to test.
+   * @param indices The indices of the overlapped boxes, in increasing order.
+   */
+  void GetOverlaps(const Box2d &box, std::vector<int> *const indices) const;
+
+  /**
+   * @brief Gets the pairs of overlapping boxes of two batches.
+   * @param other The other batch.
+   * @param pairs The pairs of indices, in this batch and in the other one,
+   *        ordered by the index in the other batch then in this one.
+   */
+  void GetOverlaps(const Box2dBatch &other,
+                   std::vector<std::pair<int, int>> *const pairs) const;
+
+  /**
+   * @brief Computes the distances from a box to every box of the batch.
+   * @param box The box to compute the distances from.
+   * @param distances The distances, 0 for the overlapped boxes.
+   */
+  void DistanceTo(const Box2d &box, std::vector<double> *const distances) const;
+
+  /**
+   * @brief Computes the distance from a box to the nearest box of the batch.
+   * @param box The box to compute the distance from.
+   * @return The distance, infinity for an empty batch.
+   */
+  double MinDistanceTo(const Box2d &box) const;
+
+ private:
+  // The box tested against the batch, with its derived values.
+  struct Query;
+
+  static Query MakeQuery(const Box2d &box);
+  Query MakeQuery(const size_t index) const;
+
+  // Gets whether the query overlaps the boxes [begin, end) of the batch.
+  void HasOverlap(const Query &query, const size_t begin, const size_t end,
+                  bool *const overlaps) const;
+  // Gets the square distances from the query to the boxes [begin, end).
+  void DistanceSquareTo(const Query &query, const size_t begin,
+                        const size_t end, double *const distances_sqr) const;
+
+  std::vector<double> center_x_;
+  std::vector<double> center_y_;
+  std::vector<double> cos_heading_;
+  std::vector<double> sin_heading_;
+  std::vector<double> half_length_;
+  std::vector<double> half_width_;
+  std::vector<double> heading_;
+  // Axis-aligned bounding boxes, for an early rejection.
+  std::vector<double> min_x_;
+  std::vector<double> max_x_;
+  std::vector<double> min_y_;
+  std::vector<double> max_y_;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_MATH_BOX2D_BATCH_H_
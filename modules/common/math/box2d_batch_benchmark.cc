@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file box2d_batch_benchmark.cc
+ * @brief Compares the overlap and distance tests of Box2dBatch with the ones
+ * of Box2d, on random boxes, and reports the time per pair of boxes.
+ *
+ * \par
+ * bazel run -c opt //modules/common/math:box2d_batch_benchmark --
+ *     --benchmark_num_boxes=200 --benchmark_num_queries=1000
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/box2d_batch.h"
+
+DEFINE_int32(benchmark_num_boxes, 200,
+             "The number of boxes of the batch, as the obstacles.");
+DEFINE_int32(benchmark_num_queries, 1000,
+             "The number of boxes tested against the batch, as the vehicle "
+             "boxes along a trajectory.");
+DEFINE_double(benchmark_range, 50.0,
+              "Half the size of the square the boxes are spread on (m).");
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+std::vector<Box2d> RandomBoxes(const int num_boxes, std::mt19937 *random) {
+  std::uniform_real_distribution<double> position(-FLAGS_benchmark_range,
+                                                  FLAGS_benchmark_range);
+  std::uniform_real_distribution<double> heading(0.0, M_PI * 2.0);
+  std::uniform_real_distribution<double> length(1.0, 5.0);
+  std::uniform_real_distribution<double> width(1.0, 3.0);
+  std::vector<Box2d> boxes;
+  boxes.reserve(num_boxes);
+  for (int i = 0; i < num_boxes; ++i) {
+    const Vec2d center(position(*random), position(*random));
+    const double box_heading = heading(*random);
+    const double box_length = length(*random);
+    boxes.emplace_back(center, box_heading, box_length, width(*random));
+  }
+  return boxes;
+}
+
+// Runs the function and returns its time per pair of boxes, in nanoseconds.
+double TimePerPair(const std::function<void()> &function,
+                   const double num_pairs) {
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         num_pairs;
+}
+
+void Run() {
+  std::mt19937 random(1);
+  const auto boxes = RandomBoxes(FLAGS_benchmark_num_boxes, &random);
+  const auto queries = RandomBoxes(FLAGS_benchmark_num_queries, &random);
+  const Box2dBatch batch(boxes);
+  const double num_pairs = static_cast<double>(boxes.size()) * queries.size();
+
+  // The counts keep the tests from being optimized away, and are checked to
+  // match.
+  int scalar_overlaps = 0;
+  const double scalar_overlap_ns = TimePerPair(
+      [&]() {
+        for (const auto &query : queries) {
+          for (const auto &box : boxes) {
+            scalar_overlaps += query.HasOverlap(box);
+          }
+        }
+      },
+      num_pairs);
+  int batch_overlaps = 0;
+  std::vector<int> indices;
+  const double batch_overlap_ns = TimePerPair(
+      [&]() {
+        for (const auto &query : queries) {
+          batch.GetOverlaps(query, &indices);
+          batch_overlaps += indices.size();
+        }
+      },
+      num_pairs);
+
+  double scalar_distance = 0.0;
+  const double scalar_distance_ns = TimePerPair(
+      [&]() {
+        for (const auto &query : queries) {
+          for (const auto &box : boxes) {
+            scalar_distance += query.DistanceTo(box);
+          }
+        }
+      },
+      num_pairs);
+  double batch_distance = 0.0;
+  std::vector<double> distances;
+  const double batch_distance_ns = TimePerPair(
+      [&]() {
+        for (const auto &query : queries) {
+          batch.DistanceTo(query, &distances);
+          for (const double distance : distances) {
+            batch_distance += distance;
+          }
+        }
+      },
+      num_pairs);
+
+  printf("%d boxes x %d queries\n", FLAGS_benchmark_num_boxes,
+         FLAGS_benchmark_num_queries);
+  printf("%-10s %12s %12s %8s\n", "test", "Box2d(ns)", "batch(ns)",
+         "speedup");
+  printf("%-10s %12.2f %12.2f %7.1fx  (%d / %d overlaps)\n", "overlap",
+         scalar_overlap_ns, batch_overlap_ns,
+         scalar_overlap_ns / batch_overlap_ns, scalar_overlaps,
+         batch_overlaps);
+  printf("%-10s %12.2f %12.2f %7.1fx  (mean %.6f / %.6f m)\n", "distance",
+         scalar_distance_ns, batch_distance_ns,
+         scalar_distance_ns / batch_distance_ns, scalar_distance / num_pairs,
+         batch_distance / num_pairs);
+}
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::common::math::Run();
+  return 0;
+}
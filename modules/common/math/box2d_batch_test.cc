@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/box2d_batch.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+std::vector<Box2d> RandomBoxes(const int num_boxes, std::mt19937 *random) {
+  std::uniform_real_distribution<double> position(-20.0, 20.0);
+  std::uniform_real_distribution<double> heading(0.0, M_PI * 2.0);
+  std::uniform_real_distribution<double> size(1.0, 5.0);
+  std::vector<Box2d> boxes;
+  for (int i = 0; i < num_boxes; ++i) {
+    const Vec2d center(position(*random), position(*random));
+    const double box_heading = heading(*random);
+    const double length = size(*random);
+    boxes.emplace_back(center, box_heading, length, size(*random));
+  }
+  return boxes;
+}
+
+}  // namespace
+
+TEST(Box2dBatchTest, AddAndClear) {
+  Box2dBatch batch;
+  EXPECT_EQ(0u, batch.size());
+  EXPECT_FALSE(batch.HasOverlap(Box2d({0, 0}, 0, 2, 2)));
+  EXPECT_EQ(std::numeric_limits<double>::infinity(),
+            batch.MinDistanceTo(Box2d({0, 0}, 0, 2, 2)));
+
+  batch.Add(Box2d({1, 2}, 0.5, 4, 2));
+  ASSERT_EQ(1u, batch.size());
+  EXPECT_NEAR(1.0, batch.box(0).center_x(), 1e-9);
+  EXPECT_NEAR(2.0, batch.box(0).center_y(), 1e-9);
+  EXPECT_NEAR(0.5, batch.box(0).heading(), 1e-9);
+  EXPECT_NEAR(4.0, batch.box(0).length(), 1e-9);
+  EXPECT_NEAR(2.0, batch.box(0).width(), 1e-9);
+
+  batch.Clear();
+  EXPECT_EQ(0u, batch.size());
+}
+
+TEST(Box2dBatchTest, HasOverlap) {
+  const Box2dBatch batch({Box2d({0, 0}, 0, 4, 2), Box2d({10, 0}, 0, 4, 2),
+                          Box2d({0, 10}, M_PI_4, 4, 2)});
+  std::vector<int> indices;
+  batch.GetOverlaps(Box2d({2, 0}, 0, 2, 2), &indices);
+  EXPECT_EQ(std::vector<int>({0}), indices);
+  batch.GetOverlaps(Box2d({5, 5}, 0, 20, 20), &indices);
+  EXPECT_EQ(std::vector<int>({0, 1, 2}), indices);
+  batch.GetOverlaps(Box2d({5, 5}, 0, 1, 1), &indices);
+  EXPECT_TRUE(indices.empty());
+  EXPECT_FALSE(batch.HasOverlap(Box2d({5, 5}, 0, 1, 1)));
+  EXPECT_TRUE(batch.HasOverlap(Box2d({10, 1.5}, 0, 1, 1)));
+}
+
+TEST(Box2dBatchTest, DistanceTo) {
+  const Box2dBatch batch({Box2d({0, 0}, 0, 4, 2), Box2d({10, 0}, 0, 4, 2),
+                          Box2d({0, 0}, M_PI_2, 4, 2)});
+  std::vector<double> distances;
+  batch.DistanceTo(Box2d({5, 0}, 0, 2, 2), &distances);
+  ASSERT_EQ(3u, distances.size());
+  EXPECT_NEAR(2.0, distances[0], 1e-9);
+  EXPECT_NEAR(2.0, distances[1], 1e-9);
+  EXPECT_NEAR(3.0, distances[2], 1e-9);
+  EXPECT_NEAR(2.0, batch.MinDistanceTo(Box2d({5, 0}, 0, 2, 2)), 1e-9);
+  EXPECT_NEAR(0.0, batch.MinDistanceTo(Box2d({0, 1}, 0, 1, 1)), 1e-9);
+}
+
+TEST(Box2dBatchTest, TestByRandom) {
+  std::mt19937 random(1);
+  // An odd number of boxes, more than a block, to test the scalar tail.
+  const std::vector<Box2d> boxes = RandomBoxes(203, &random);
+  const Box2dBatch batch(boxes);
+  const std::vector<Box2d> queries = RandomBoxes(50, &random);
+  std::vector<int> indices;
+  std::vector<double> distances;
+  for (const auto &query : queries) {
+    batch.GetOverlaps(query, &indices);
+    batch.DistanceTo(query, &distances);
+    ASSERT_EQ(boxes.size(), distances.size());
+    std::vector<int> expected_indices;
+    double min_distance = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      if (query.HasOverlap(boxes[i])) {
+        expected_indices.push_back(static_cast<int>(i));
+      }
+      const double distance = query.DistanceTo(boxes[i]);
+      EXPECT_NEAR(distance, distances[i], 1e-6);
+      min_distance = std::min(min_distance, distance);
+    }
+    EXPECT_EQ(expected_indices, indices);
+    EXPECT_EQ(!expected_indices.empty(), batch.HasOverlap(query));
+    EXPECT_NEAR(min_distance, batch.MinDistanceTo(query), 1e-6);
+  }
+
+  std::vector<std::pair<int, int>> pairs;
+  batch.GetOverlaps(Box2dBatch(queries), &pairs);
+  std::vector<std::pair<int, int>> expected_pairs;
+  for (size_t j = 0; j < queries.size(); ++j) {
+    for (size_t i = 0; i < boxes.size(); ++i) {
+      if (boxes[i].HasOverlap(queries[j])) {
+        expected_pairs.emplace_back(i, j);
+      }
+    }
+  }
+  EXPECT_EQ(expected_pairs, pairs);
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
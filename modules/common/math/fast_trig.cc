@@ -0,0 +1,50 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/math/fast_trig.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+// The loops have no dependencies between their iterations, for the compiler
+// to vectorize them.
+
+void FastSinCos(const double *angles, const int size, double *sin_angles,
+                double *cos_angles) {
+  for (int i = 0; i < size; ++i) {
+    FastSinCos(angles[i], sin_angles + i, cos_angles + i);
+  }
+}
+
+void FastAtan2(const double *ys, const double *xs, const int size,
+               double *angles) {
+  for (int i = 0; i < size; ++i) {
+    angles[i] = FastAtan2(ys[i], xs[i]);
+  }
+}
+
+void FastNormalizeAngle(const double *angles, const int size,
+                        double *normalized_angles) {
+  for (int i = 0; i < size; ++i) {
+    normalized_angles[i] = FastNormalizeAngle(angles[i]);
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,244 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Fast approximations of the trigonometric functions, for one value
+ *        or for arrays of values.
+ */
+
+#ifndef MODULES_COMMON_MATH_FAST_TRIG_H_
+#define MODULES_COMMON_MATH_FAST_TRIG_H_
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * \par
+ * The functions reduce the angles to [-pi/4, pi/4] and evaluate fixed
+ * polynomials there, without branches nor calls to the libm, so that the
+ * loops calling them can be inlined and vectorized. Compared to the functions
+ * of the standard library:
+ * - FastSinCos(), FastSin() and FastCos() are within 1e-15 of them for
+ *   |angle| <= 1e4 and within 1e-12 for |angle| <= 1e7; larger angles are
+ *   not supported.
+ * - FastAtan2() is within 1e-15 of std::atan2(), signed zeros included.
+ * - FastNormalizeAngle() is in [-pi, pi), within 1e-15 of the exact
+ *   reduction for |angle| <= 1e4 and within 1e-12 for |angle| <= 1e7. It is
+ *   more accurate than NormalizeAngle(), which rounds on large angles.
+ * NaNs and infinities give unspecified results.
+ */
+
+namespace fast_trig_internal {
+
+// pi / 2 split in three parts, the first two with trailing zero bits so that
+// their products by the quadrant are exact.
+constexpr double kPiOver2Hi = 1.57079625129699707031e+00;
+constexpr double kPiOver2Mid = 7.54978941586159635336e-08;
+constexpr double kPiOver2Lo = 5.39030285815811905290e-15;
+constexpr double kTwoOverPi = 0.636619772367581343076;
+constexpr double kOneOverTwoPi = 0.159154943091895335769;
+// Adding then subtracting it rounds a double of magnitude below 2^51 to the
+// nearest integer, with the default rounding mode.
+constexpr double kRoundMagic = 6755399441055744.0;
+
+inline double Round(const double value) {
+  return (value + kRoundMagic) - kRoundMagic;
+}
+
+// Minimax polynomials of sin and cos on [-pi/4, pi/4], from Cephes.
+inline double SinKernel(const double x) {
+  const double z = x * x;
+  return x +
+         x * z *
+             ((((((1.58962301576546568060e-10 * z -
+                   2.50507477628578072866e-08) *
+                      z +
+                  2.75573136213857245213e-06) *
+                     z -
+                 1.98412698295895385996e-04) *
+                    z +
+                8.33333333332211858878e-03) *
+                   z -
+               1.66666666666666307295e-01));
+}
+
+inline double CosKernel(const double x) {
+  const double z = x * x;
+  return 1.0 - 0.5 * z +
+         z * z *
+             (((((-1.13585365213876817300e-11 * z +
+                  2.08757008419747316778e-09) *
+                     z -
+                 2.75573141792967388112e-07) *
+                    z +
+                2.48015872888517045348e-05) *
+                   z -
+               1.38888888888730564116e-03) *
+                  z +
+              4.16666666666665929218e-02);
+}
+
+// Rational approximation of atan on [-0.66, 0.66], from Cephes.
+inline double AtanKernel(const double x) {
+  const double z = x * x;
+  const double p =
+      (((-8.750608600031904122785e-01 * z - 1.615753718733365076637e+01) * z -
+        7.500855792314704667340e+01) *
+           z -
+       1.228866684490136173410e+02) *
+          z -
+      6.485021904942025371773e+01;
+  const double q =
+      ((((z + 2.485846490142306297962e+01) * z + 1.650270098316988542046e+02) *
+            z +
+        4.328810604912902668951e+02) *
+           z +
+       4.853903996359136964868e+02) *
+          z +
+      1.945506571482613964425e+02;
+  return x + x * z * p / q;
+}
+
+}  // namespace fast_trig_internal
+
+/**
+ * @brief Computes the sine and the cosine of an angle.
+ * @param angle The angle in radians.
+ * @param sin_angle The sine of the angle.
+ * @param cos_angle The cosine of the angle.
+ */
+inline void FastSinCos(const double angle, double *const sin_angle,
+                       double *const cos_angle) {
+  using namespace fast_trig_internal;  // NOLINT
+  const double q = Round(angle * kTwoOverPi);
+  const double r =
+      ((angle - q * kPiOver2Hi) - q * kPiOver2Mid) - q * kPiOver2Lo;
+  const double s = SinKernel(r);
+  const double c = CosKernel(r);
+  const int32_t quadrant = static_cast<int32_t>(q);
+  const double sin_value = (quadrant & 1) ? c : s;
+  const double cos_value = (quadrant & 1) ? s : c;
+  *sin_angle = (quadrant & 2) ? -sin_value : sin_value;
+  *cos_angle = ((quadrant + 1) & 2) ? -cos_value : cos_value;
+}
+
+/**
+ * @brief Computes the sine of an angle.
+ * @param angle The angle in radians.
+ * @return The sine of the angle.
+ */
+inline double FastSin(const double angle) {
+  double sin_angle = 0.0;
+  double cos_angle = 0.0;
+  FastSinCos(angle, &sin_angle, &cos_angle);
+  return sin_angle;
+}
+
+/**
+ * @brief Computes the cosine of an angle.
+ * @param angle The angle in radians.
+ * @return The cosine of the angle.
+ */
+inline double FastCos(const double angle) {
+  double sin_angle = 0.0;
+  double cos_angle = 0.0;
+  FastSinCos(angle, &sin_angle, &cos_angle);
+  return cos_angle;
+}
+
+/**
+ * @brief Computes the angle of a vector, as std::atan2().
+ * @param y The y coordinate of the vector.
+ * @param x The x coordinate of the vector.
+ * @return The angle of the vector in [-pi, pi].
+ */
+inline double FastAtan2(const double y, const double x) {
+  using namespace fast_trig_internal;  // NOLINT
+  const double abs_x = std::abs(x);
+  const double abs_y = std::abs(y);
+  const bool steep = abs_y > abs_x;
+  const double num = steep ? abs_x : abs_y;
+  const double den = steep ? abs_y : abs_x;
+  // In [0, 1], and 0 for the null vector.
+  const double t = den > 0.0 ? num / den : 0.0;
+  // Beyond 0.66, atan(t) = pi / 4 + atan((t - 1) / (t + 1)).
+  const bool shifted = t > 0.66;
+  const double u = shifted ? (t - 1.0) / (t + 1.0) : t;
+  double angle = AtanKernel(u) + (shifted ? M_PI_4 : 0.0);
+  angle = steep ? M_PI_2 - angle : angle;
+  angle = std::signbit(x) ? M_PI - angle : angle;
+  return std::signbit(y) ? -angle : angle;
+}
+
+/**
+ * @brief Normalizes an angle to [-pi, pi), as NormalizeAngle().
+ * @param angle The angle in radians.
+ * @return The normalized angle.
+ */
+inline double FastNormalizeAngle(const double angle) {
+  using namespace fast_trig_internal;  // NOLINT
+  const double q = Round(angle * kOneOverTwoPi);
+  const double a = ((angle - q * (4.0 * kPiOver2Hi)) -
+                    q * (4.0 * kPiOver2Mid)) -
+                   q * (4.0 * kPiOver2Lo);
+  return a >= M_PI ? a - 2.0 * M_PI : (a < -M_PI ? a + 2.0 * M_PI : a);
+}
+
+/**
+ * @brief Computes the sines and the cosines of an array of angles.
+ * @param angles The angles in radians.
+ * @param size The number of angles.
+ * @param sin_angles The sines of the angles, size values.
+ * @param cos_angles The cosines of the angles, size values.
+ */
+void FastSinCos(const double *angles, const int size, double *sin_angles,
+                double *cos_angles);
+
+/**
+ * @brief Computes the angles of an array of vectors, as std::atan2().
+ * @param ys The y coordinates of the vectors.
+ * @param xs The x coordinates of the vectors.
+ * @param size The number of vectors.
+ * @param angles The angles of the vectors, size values.
+ */
+void FastAtan2(const double *ys, const double *xs, const int size,
+               double *angles);
+
+/**
+ * @brief Normalizes an array of angles to [-pi, pi).
+ * @param angles The angles in radians.
+ * @param size The number of angles.
+ * @param normalized_angles The normalized angles, size values, which may be
+ *        the angles themselves.
+ */
+void FastNormalizeAngle(const double *angles, const int size,
+                        double *normalized_angles);
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_MATH_FAST_TRIG_H_
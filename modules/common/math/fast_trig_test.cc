@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/math/fast_trig.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "modules/common/math/math_utils.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+std::vector<double> RandomValues(const int size, const double range,
+                                 std::mt19937 *random) {
+  std::uniform_real_distribution<double> value(-range, range);
+  std::vector<double> values;
+  for (int i = 0; i < size; ++i) {
+    values.push_back(value(*random));
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST(FastTrigTest, SinCos) {
+  for (const double angle : {0.0, -0.0, M_PI_4, M_PI_2, M_PI, -M_PI_2,
+                             3.0 * M_PI_4, 1e4, -1e4}) {
+    double sin_angle = 0.0;
+    double cos_angle = 0.0;
+    FastSinCos(angle, &sin_angle, &cos_angle);
+    EXPECT_NEAR(std::sin(angle), sin_angle, 1e-15) << angle;
+    EXPECT_NEAR(std::cos(angle), cos_angle, 1e-15) << angle;
+    EXPECT_EQ(sin_angle, FastSin(angle));
+    EXPECT_EQ(cos_angle, FastCos(angle));
+  }
+
+  std::mt19937 random(0);
+  for (const double range : {M_PI, 1e4}) {
+    for (const double angle : RandomValues(10000, range, &random)) {
+      EXPECT_NEAR(std::sin(angle), FastSin(angle), 1e-15) << angle;
+      EXPECT_NEAR(std::cos(angle), FastCos(angle), 1e-15) << angle;
+    }
+  }
+  for (const double angle : RandomValues(10000, 1e7, &random)) {
+    EXPECT_NEAR(std::sin(angle), FastSin(angle), 1e-12) << angle;
+    EXPECT_NEAR(std::cos(angle), FastCos(angle), 1e-12) << angle;
+  }
+}
+
+TEST(FastTrigTest, Atan2) {
+  for (const double y : {0.0, -0.0, 1.0, -1.0, 0.5, 3.0}) {
+    for (const double x : {0.0, -0.0, 1.0, -1.0, 0.7, -2.0}) {
+      const double angle = FastAtan2(y, x);
+      EXPECT_NEAR(std::atan2(y, x), angle, 1e-15) << y << ", " << x;
+      EXPECT_EQ(std::signbit(std::atan2(y, x)), std::signbit(angle))
+          << y << ", " << x;
+    }
+  }
+
+  std::mt19937 random(0);
+  const std::vector<double> ys = RandomValues(10000, 10.0, &random);
+  const std::vector<double> xs = RandomValues(10000, 10.0, &random);
+  for (size_t i = 0; i < ys.size(); ++i) {
+    EXPECT_NEAR(std::atan2(ys[i], xs[i]), FastAtan2(ys[i], xs[i]), 1e-15)
+        << ys[i] << ", " << xs[i];
+  }
+}
+
+TEST(FastTrigTest, NormalizeAngle) {
+  for (const double angle : {0.0, M_PI, -M_PI, 3.0 * M_PI, 2.0 * M_PI}) {
+    EXPECT_NEAR(0.0, NormalizeAngle(NormalizeAngle(angle) -
+                                    FastNormalizeAngle(angle)),
+                1e-15)
+        << angle;
+  }
+
+  std::mt19937 random(0);
+  for (const double angle : RandomValues(10000, 10.0, &random)) {
+    EXPECT_NEAR(NormalizeAngle(angle), FastNormalizeAngle(angle), 1e-14)
+        << angle;
+  }
+  // NormalizeAngle() rounds on large angles; the sines and cosines check the
+  // exact reduction instead.
+  for (const double range : {1e4, 1e7}) {
+    const double tolerance = range > 1e4 ? 1e-12 : 1e-15;
+    for (const double angle : RandomValues(10000, range, &random)) {
+      const double normalized = FastNormalizeAngle(angle);
+      EXPECT_GE(normalized, -M_PI);
+      EXPECT_LT(normalized, M_PI);
+      EXPECT_NEAR(std::sin(angle), std::sin(normalized), tolerance) << angle;
+      EXPECT_NEAR(std::cos(angle), std::cos(normalized), tolerance) << angle;
+    }
+  }
+}
+
+TEST(FastTrigTest, Arrays) {
+  std::mt19937 random(0);
+  const int size = 1001;
+  const std::vector<double> ys = RandomValues(size, 10.0, &random);
+  const std::vector<double> xs = RandomValues(size, 10.0, &random);
+  std::vector<double> sins(size);
+  std::vector<double> coss(size);
+  FastSinCos(ys.data(), size, sins.data(), coss.data());
+  std::vector<double> angles(size);
+  FastAtan2(ys.data(), xs.data(), size, angles.data());
+  std::vector<double> normalized(ys);
+  FastNormalizeAngle(normalized.data(), size, normalized.data());
+  for (int i = 0; i < size; ++i) {
+    EXPECT_EQ(FastSin(ys[i]), sins[i]);
+    EXPECT_EQ(FastCos(ys[i]), coss[i]);
+    EXPECT_EQ(FastAtan2(ys[i], xs[i]), angles[i]);
+    EXPECT_EQ(FastNormalizeAngle(ys[i]), normalized[i]);
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -262,9 +262,15 @@ inline void KalmanFilter<T, XN, ZN, UN>::Correct(
   CHECK(is_initialized_);
   y_ = z - H_ * x_;
 
-  S_ = H_ * P_ * H_.transpose() + R_;
-
-  K_ = P_ * H_.transpose() * PseudoInverse<T, ZN>(S_);
+  // S is symmetric positive definite unless the covariances are degenerate,
+  // so K = P * H^T * S^-1 is solved with a fixed-size Cholesky
+  // decomposition of S instead of inverting it. The pseudo inverse is kept
+  // for the (near) singular S.
+  const Eigen::Matrix<T, XN, ZN> PHt = P_ * H_.transpose();
+  S_ = H_ * PHt + R_;
+  if (!CholeskySolveRight<T, ZN, XN>(S_, PHt, &K_)) {
+    K_ = PHt * PseudoInverse<T, ZN>(S_);
+  }
 
   x_ = x_ + K_ * y_;
 
@@ -0,0 +1,517 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Defines the templated KalmanFilterBatch class.
+ */
+
+#ifndef MODULES_COMMON_MATH_KALMAN_FILTER_BATCH_H_
+#define MODULES_COMMON_MATH_KALMAN_FILTER_BATCH_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "Eigen/Dense"
+
+#include "modules/common/log.h"
+#include "modules/common/math/matrix_operations.h"
+
+/**
+ * @namespace apollo::common::math
+ * @brief apollo::common::math
+ */
+namespace apollo {
+namespace common {
+namespace math {
+
+/**
+ * @class KalmanFilterBatch
+ *
+ * @brief Implements many discrete-time Kalman filters without control, of
+ * the same dimensions and sharing the noise covariances and the observation
+ * matrix, stepped together.
+ *
+ * Each coefficient of the states, of the covariances and of the transition
+ * matrices is stored contiguously for all the filters, so that Predict() and
+ * Correct() run vectorized Eigen array operations over the filters for each
+ * coefficient. The covariances are taken as symmetric, and the coefficients
+ * of the transition matrices which are zero for all the filters are skipped.
+ * Adding a filter only allocates when the batch grows beyond its largest size
+ * so far.
+ *
+ * @param XN dimension of state
+ * @param ZN dimension of observations
+ */
+template <typename T, unsigned int XN, unsigned int ZN>
+class KalmanFilterBatch {
+ public:
+  /**
+   * @brief Constructor of an empty batch, with identity observation matrix
+   * and zero noises.
+   */
+  KalmanFilterBatch() {
+    std::fill(F_nonzero_, F_nonzero_ + XN * XN, false);
+    Q_.setZero();
+    H_.setIdentity();
+    R_.setZero();
+  }
+
+  /**
+   * @brief Get the number of filters.
+   * @return The number of filters
+   */
+  size_t size() const { return x_[0].size(); }
+
+  /**
+   * @brief Adds a filter.
+   *
+   * @param F Transition matrix of the filter
+   * @param x Mean of the state belief distribution
+   * @param P Covariance of the state belief distribution
+   * @return The index of the filter
+   */
+  size_t Add(const Eigen::Matrix<T, XN, XN> &F,
+             const Eigen::Matrix<T, XN, 1> &x,
+             const Eigen::Matrix<T, XN, XN> &P) {
+    for (unsigned int r = 0; r < XN; ++r) {
+      x_[r].push_back(x(r, 0));
+      for (unsigned int c = 0; c < XN; ++c) {
+        F_[r * XN + c].push_back(F(r, c));
+        F_nonzero_[r * XN + c] |= F(r, c) != T(0);
+        P_[r * XN + c].push_back(P(r, c));
+      }
+    }
+    return size() - 1;
+  }
+
+  /**
+   * @brief Removes a filter. The last filter is moved to its index.
+   *
+   * @param index Index of the filter
+   */
+  void Remove(const size_t index) {
+    CHECK_LT(index, size());
+    const size_t last = size() - 1;
+    for (unsigned int r = 0; r < XN; ++r) {
+      MoveAndPop(index, last, &x_[r]);
+    }
+    for (unsigned int i = 0; i < XN * XN; ++i) {
+      MoveAndPop(index, last, &F_[i]);
+      MoveAndPop(index, last, &P_[i]);
+    }
+  }
+
+  /**
+   * @brief Removes all the filters.
+   */
+  void Clear() {
+    for (unsigned int r = 0; r < XN; ++r) {
+      x_[r].clear();
+    }
+    for (unsigned int i = 0; i < XN * XN; ++i) {
+      F_[i].clear();
+      P_[i].clear();
+      F_nonzero_[i] = false;
+    }
+  }
+
+  /**
+   * @brief Changes the covariance matrix of the transition noise.
+   *
+   * @param Q New covariance matrix
+   */
+  void SetTransitionNoise(const Eigen::Matrix<T, XN, XN> &Q) { Q_ = Q; }
+
+  /**
+   * @brief Changes the observation matrix, which maps states to observations.
+   *
+   * @param H New observation matrix
+   */
+  void SetObservationMatrix(const Eigen::Matrix<T, ZN, XN> &H) { H_ = H; }
+
+  /**
+   * @brief Changes the covariance matrix of the observation noise.
+   *
+   * @param R New covariance matrix
+   */
+  void SetObservationNoise(const Eigen::Matrix<T, ZN, ZN> &R) { R_ = R; }
+
+  /**
+   * @brief Changes a coefficient of the transition matrix of a filter.
+   *
+   * @param index Index of the filter
+   * @param row Row of the coefficient
+   * @param col Column of the coefficient
+   * @param value New value of the coefficient
+   */
+  void SetTransitionCoeff(const size_t index, const unsigned int row,
+                          const unsigned int col, const T value) {
+    F_[row * XN + col][index] = value;
+    F_nonzero_[row * XN + col] |= value != T(0);
+  }
+
+  /**
+   * @brief Changes a coefficient of the transition matrices of all the
+   * filters, as a time step.
+   *
+   * @param row Row of the coefficient
+   * @param col Column of the coefficient
+   * @param value New value of the coefficient
+   */
+  void SetTransitionCoeff(const unsigned int row, const unsigned int col,
+                          const T value) {
+    auto &coeffs = F_[row * XN + col];
+    std::fill(coeffs.begin(), coeffs.end(), value);
+    F_nonzero_[row * XN + col] = value != T(0);
+  }
+
+  /**
+   * @brief Sets the observation of a filter for the next Correct().
+   *
+   * @param index Index of the filter
+   * @param z Observation
+   */
+  void SetObservation(const size_t index, const Eigen::Matrix<T, ZN, 1> &z) {
+    ResizeWorkspace();
+    for (unsigned int i = 0; i < ZN; ++i) {
+      z_[i][index] = z(i, 0);
+    }
+  }
+
+  /**
+   * @brief Get the transition matrix of a filter.
+   *
+   * @param index Index of the filter
+   * @return Transition matrix
+   */
+  Eigen::Matrix<T, XN, XN> GetTransitionMatrix(const size_t index) const {
+    return Gather<XN, XN>(F_, index);
+  }
+
+  /**
+   * @brief Gets mean of the state belief distribution of a filter
+   *
+   * @param index Index of the filter
+   * @return State vector
+   */
+  Eigen::Matrix<T, XN, 1> GetStateEstimate(const size_t index) const {
+    return Gather<XN, 1>(x_, index);
+  }
+
+  /**
+   * @brief Gets covariance of the state belief distribution of a filter
+   *
+   * @param index Index of the filter
+   * @return Covariance matrix
+   */
+  Eigen::Matrix<T, XN, XN> GetStateCovariance(const size_t index) const {
+    return Gather<XN, XN>(P_, index);
+  }
+
+  /**
+   * @brief Updates the state belief distributions of all the filters.
+   */
+  void Predict();
+
+  /**
+   * @brief Updates the state belief distributions of all the filters given
+   * the observations set with SetObservation().
+   */
+  void Correct();
+
+ private:
+  using Coeffs = std::vector<T>;
+  using Array = Eigen::Array<T, Eigen::Dynamic, 1>;
+
+  // The coefficients of all the filters as an Eigen array.
+  static Eigen::Map<Array> AsArray(Coeffs *const coeffs) {
+    return Eigen::Map<Array>(coeffs->data(), coeffs->size());
+  }
+
+  static Eigen::Map<const Array> AsArray(const Coeffs &coeffs) {
+    return Eigen::Map<const Array>(coeffs.data(), coeffs.size());
+  }
+
+  static void MoveAndPop(const size_t index, const size_t last,
+                         Coeffs *const coeffs) {
+    (*coeffs)[index] = (*coeffs)[last];
+    coeffs->pop_back();
+  }
+
+  template <unsigned int ROWS, unsigned int COLS>
+  static Eigen::Matrix<T, ROWS, COLS> Gather(const Coeffs *const coeffs,
+                                             const size_t index) {
+    CHECK_LT(index, coeffs[0].size());
+    Eigen::Matrix<T, ROWS, COLS> matrix;
+    for (unsigned int r = 0; r < ROWS; ++r) {
+      for (unsigned int c = 0; c < COLS; ++c) {
+        matrix(r, c) = coeffs[r * COLS + c][index];
+      }
+    }
+    return matrix;
+  }
+
+  void ResizeWorkspace();
+
+  // Solves the gain of a filter with (near) singular S by the pseudo
+  // inverse.
+  void CorrectSingular(const size_t index);
+
+  // Mean of current state belief distributions
+  Coeffs x_[XN];
+
+  // Covariances of current state belief distributions
+  Coeffs P_[XN * XN];
+
+  // State transition matrices
+  Coeffs F_[XN * XN];
+
+  // Whether a coefficient of the transition matrices may be nonzero for
+  // some filter. The others are skipped, as most of F is usually constant.
+  bool F_nonzero_[XN * XN];
+
+  // Covariance of the state transition noise
+  Eigen::Matrix<T, XN, XN> Q_;
+
+  // Observation matrix
+  Eigen::Matrix<T, ZN, XN> H_;
+
+  // Covariance of observation noise
+  Eigen::Matrix<T, ZN, ZN> R_;
+
+  // The rest is workspace, as members to prevent memory re-allocation.
+  // Observations
+  Coeffs z_[ZN];
+
+  // Innovations
+  Coeffs y_[ZN];
+
+  // P * H^T
+  Coeffs PHt_[XN * ZN];
+
+  // Lower Cholesky factors of the innovation covariances S, with their
+  // inverse diagonals, then the Kalman gains.
+  Coeffs L_[ZN * ZN];
+  Coeffs inv_diag_[ZN];
+  Coeffs K_[XN * ZN];
+
+  // F * P for the prediction, and the predicted states.
+  Coeffs FP_[XN * XN];
+  Coeffs next_x_[XN];
+
+  // Indices of the filters whose S is (near) singular.
+  std::vector<size_t> singular_;
+
+  // The pivot of the Cholesky decomposition below which S is taken as
+  // singular, as in CholeskySolveRight.
+  static constexpr double kMinCholeskyPivot = 1e-6;
+};
+
+template <typename T, unsigned int XN, unsigned int ZN>
+constexpr double KalmanFilterBatch<T, XN, ZN>::kMinCholeskyPivot;
+
+template <typename T, unsigned int XN, unsigned int ZN>
+inline void KalmanFilterBatch<T, XN, ZN>::ResizeWorkspace() {
+  const size_t n = size();
+  if (z_[0].size() == n) {
+    return;
+  }
+  for (unsigned int i = 0; i < ZN; ++i) {
+    z_[i].resize(n);
+    y_[i].resize(n);
+    inv_diag_[i].resize(n);
+  }
+  for (unsigned int i = 0; i < XN * ZN; ++i) {
+    PHt_[i].resize(n);
+    K_[i].resize(n);
+  }
+  for (unsigned int i = 0; i < ZN * ZN; ++i) {
+    L_[i].resize(n);
+  }
+  for (unsigned int i = 0; i < XN * XN; ++i) {
+    FP_[i].resize(n);
+  }
+  for (unsigned int i = 0; i < XN; ++i) {
+    next_x_[i].resize(n);
+  }
+}
+
+template <typename T, unsigned int XN, unsigned int ZN>
+inline void KalmanFilterBatch<T, XN, ZN>::Predict() {
+  ResizeWorkspace();
+  for (unsigned int r = 0; r < XN; ++r) {
+    // x = F * x
+    auto next_x = AsArray(&next_x_[r]);
+    next_x.setZero();
+    for (unsigned int c = 0; c < XN; ++c) {
+      if (F_nonzero_[r * XN + c]) {
+        next_x += AsArray(F_[r * XN + c]) * AsArray(x_[c]);
+      }
+    }
+    // F * P
+    for (unsigned int c = 0; c < XN; ++c) {
+      auto fp = AsArray(&FP_[r * XN + c]);
+      fp.setZero();
+      for (unsigned int m = 0; m < XN; ++m) {
+        if (F_nonzero_[r * XN + m]) {
+          fp += AsArray(F_[r * XN + m]) * AsArray(P_[m * XN + c]);
+        }
+      }
+    }
+  }
+  for (unsigned int r = 0; r < XN; ++r) {
+    x_[r].swap(next_x_[r]);
+    // P = F * P * F^T + Q, computing the upper half of the symmetric P.
+    for (unsigned int c = r; c < XN; ++c) {
+      auto p = AsArray(&P_[r * XN + c]);
+      p.setConstant(Q_(r, c));
+      for (unsigned int m = 0; m < XN; ++m) {
+        if (F_nonzero_[c * XN + m]) {
+          p += AsArray(FP_[r * XN + m]) * AsArray(F_[c * XN + m]);
+        }
+      }
+      if (c != r) {
+        P_[c * XN + r] = P_[r * XN + c];
+      }
+    }
+  }
+}
+
+template <typename T, unsigned int XN, unsigned int ZN>
+inline void KalmanFilterBatch<T, XN, ZN>::Correct() {
+  ResizeWorkspace();
+  // y = z - H * x and P * H^T, skipping the zeros of H.
+  for (unsigned int i = 0; i < ZN; ++i) {
+    auto y = AsArray(&y_[i]);
+    y = AsArray(z_[i]);
+    for (unsigned int j = 0; j < XN; ++j) {
+      if (H_(i, j) != T(0)) {
+        y -= H_(i, j) * AsArray(x_[j]);
+      }
+    }
+    for (unsigned int r = 0; r < XN; ++r) {
+      auto pht = AsArray(&PHt_[r * ZN + i]);
+      pht.setZero();
+      for (unsigned int j = 0; j < XN; ++j) {
+        if (H_(i, j) != T(0)) {
+          pht += H_(i, j) * AsArray(P_[r * XN + j]);
+        }
+      }
+    }
+  }
+
+  // S = H * P * H^T + R, decomposed as L * L^T column by column, the lower
+  // half of S first stored in L.
+  for (unsigned int i = 0; i < ZN; ++i) {
+    for (unsigned int l = i; l < ZN; ++l) {
+      auto s = AsArray(&L_[l * ZN + i]);
+      s.setConstant(R_(l, i));
+      for (unsigned int j = 0; j < XN; ++j) {
+        if (H_(l, j) != T(0)) {
+          s += H_(l, j) * AsArray(PHt_[j * ZN + i]);
+        }
+      }
+    }
+  }
+  singular_.clear();
+  for (unsigned int i = 0; i < ZN; ++i) {
+    auto diag = AsArray(&L_[i * ZN + i]);
+    for (unsigned int m = 0; m < i; ++m) {
+      diag -= AsArray(L_[i * ZN + m]).square();
+    }
+    if (!(diag > T(kMinCholeskyPivot)).all()) {
+      for (size_t k = 0; k < size(); ++k) {
+        if (!(diag(k) > kMinCholeskyPivot)) {
+          singular_.push_back(k);
+        }
+      }
+    }
+    // The singular S are solved apart, the factor only has to stay finite.
+    diag = (diag > T(kMinCholeskyPivot)).select(diag.sqrt(), T(1));
+    auto inv_diag = AsArray(&inv_diag_[i]);
+    inv_diag = diag.inverse();
+    for (unsigned int l = i + 1; l < ZN; ++l) {
+      auto lli = AsArray(&L_[l * ZN + i]);
+      for (unsigned int m = 0; m < i; ++m) {
+        lli -= AsArray(L_[l * ZN + m]) * AsArray(L_[i * ZN + m]);
+      }
+      lli *= inv_diag;
+    }
+  }
+
+  // Each row of K solves K * L * L^T = P * H^T, forward then backward.
+  for (unsigned int r = 0; r < XN; ++r) {
+    for (unsigned int i = 0; i < ZN; ++i) {
+      auto w = AsArray(&K_[r * ZN + i]);
+      w = AsArray(PHt_[r * ZN + i]);
+      for (unsigned int m = 0; m < i; ++m) {
+        w -= AsArray(L_[i * ZN + m]) * AsArray(K_[r * ZN + m]);
+      }
+      w *= AsArray(inv_diag_[i]);
+    }
+    for (unsigned int i = ZN; i-- > 0;) {
+      auto kri = AsArray(&K_[r * ZN + i]);
+      for (unsigned int m = i + 1; m < ZN; ++m) {
+        kri -= AsArray(L_[m * ZN + i]) * AsArray(K_[r * ZN + m]);
+      }
+      kri *= AsArray(inv_diag_[i]);
+    }
+  }
+  for (const size_t index : singular_) {
+    CorrectSingular(index);
+  }
+
+  // x = x + K * y and P = (I - K * H) * P, where H * P = (P * H^T)^T as P
+  // is symmetric, computing the upper half of P.
+  for (unsigned int r = 0; r < XN; ++r) {
+    auto x = AsArray(&x_[r]);
+    for (unsigned int i = 0; i < ZN; ++i) {
+      x += AsArray(K_[r * ZN + i]) * AsArray(y_[i]);
+    }
+    for (unsigned int c = r; c < XN; ++c) {
+      auto p = AsArray(&P_[r * XN + c]);
+      for (unsigned int i = 0; i < ZN; ++i) {
+        p -= AsArray(K_[r * ZN + i]) * AsArray(PHt_[c * ZN + i]);
+      }
+      if (c != r) {
+        P_[c * XN + r] = P_[r * XN + c];
+      }
+    }
+  }
+}
+
+template <typename T, unsigned int XN, unsigned int ZN>
+inline void KalmanFilterBatch<T, XN, ZN>::CorrectSingular(
+    const size_t index) {
+  const Eigen::Matrix<T, XN, XN> P = GetStateCovariance(index);
+  const Eigen::Matrix<T, ZN, ZN> S = H_ * P * H_.transpose() + R_;
+  const Eigen::Matrix<T, XN, ZN> K =
+      P * H_.transpose() * PseudoInverse<T, ZN>(S);
+  for (unsigned int r = 0; r < XN; ++r) {
+    for (unsigned int i = 0; i < ZN; ++i) {
+      K_[r * ZN + i][index] = K(r, i);
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+#endif /* MODULES_COMMON_MATH_KALMAN_FILTER_BATCH_H_ */
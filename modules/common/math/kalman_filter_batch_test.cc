@@ -0,0 +1,165 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/math/kalman_filter_batch.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/math/kalman_filter.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+class KalmanFilterBatchTest : public ::testing::Test {
+ protected:
+  using Filter = KalmanFilter<double, 4, 2, 0>;
+
+  void SetUp() override {
+    Q_.setIdentity();
+    Q_ *= 0.01;
+    H_.setZero();
+    H_(0, 0) = 1.0;
+    H_(1, 1) = 1.0;
+    R_.setIdentity();
+    R_ *= 0.25;
+    batch_.SetTransitionNoise(Q_);
+    batch_.SetObservationMatrix(H_);
+    batch_.SetObservationNoise(R_);
+  }
+
+  // Adds the same random filter to the batch and to the filters.
+  void AddFilter() {
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+    Eigen::Matrix<double, 4, 4> F;
+    F.setIdentity();
+    F(1, 1) = 0.5 + 0.5 * value(random_);
+    Eigen::Matrix<double, 4, 1> x;
+    for (int i = 0; i < 4; ++i) {
+      x(i, 0) = 10.0 * value(random_);
+    }
+    Eigen::Matrix<double, 4, 4> A;
+    for (int r = 0; r < 4; ++r) {
+      for (int c = 0; c < 4; ++c) {
+        A(r, c) = value(random_);
+      }
+    }
+    const Eigen::Matrix<double, 4, 4> P = A * A.transpose();
+
+    Filter filter(x, P);
+    filter.SetTransitionMatrix(F);
+    filter.SetTransitionNoise(Q_);
+    filter.SetObservationMatrix(H_);
+    filter.SetObservationNoise(R_);
+    filters_.push_back(filter);
+    EXPECT_EQ(filters_.size() - 1, batch_.Add(F, x, P));
+  }
+
+  // Steps the filters by dt with random observations.
+  void Step(const double dt) {
+    std::uniform_real_distribution<double> value(-10.0, 10.0);
+    batch_.SetTransitionCoeff(0, 2, dt);
+    batch_.SetTransitionCoeff(0, 3, 0.5 * dt * dt);
+    batch_.SetTransitionCoeff(2, 3, dt);
+    for (size_t k = 0; k < filters_.size(); ++k) {
+      auto F = filters_[k].GetTransitionMatrix();
+      F(0, 2) = dt;
+      F(0, 3) = 0.5 * dt * dt;
+      F(2, 3) = dt;
+      filters_[k].SetTransitionMatrix(F);
+      filters_[k].Predict();
+      Eigen::Matrix<double, 2, 1> z;
+      z(0, 0) = value(random_);
+      z(1, 0) = value(random_);
+      filters_[k].Correct(z);
+      batch_.SetObservation(k, z);
+    }
+    batch_.Predict();
+    batch_.Correct();
+  }
+
+  void ExpectSameFilters() {
+    ASSERT_EQ(filters_.size(), batch_.size());
+    for (size_t k = 0; k < filters_.size(); ++k) {
+      EXPECT_TRUE(filters_[k].GetTransitionMatrix().isApprox(
+          batch_.GetTransitionMatrix(k)));
+      EXPECT_TRUE(filters_[k].GetStateEstimate().isApprox(
+          batch_.GetStateEstimate(k), 1e-9));
+      EXPECT_TRUE(filters_[k].GetStateCovariance().isApprox(
+          batch_.GetStateCovariance(k), 1e-9));
+    }
+  }
+
+  std::mt19937 random_{1};
+  Eigen::Matrix<double, 4, 4> Q_;
+  Eigen::Matrix<double, 2, 4> H_;
+  Eigen::Matrix<double, 2, 2> R_;
+  std::vector<Filter> filters_;
+  KalmanFilterBatch<double, 4, 2> batch_;
+};
+
+TEST_F(KalmanFilterBatchTest, SameAsKalmanFilter) {
+  for (int i = 0; i < 37; ++i) {
+    AddFilter();
+  }
+  ExpectSameFilters();
+  for (int step = 0; step < 20; ++step) {
+    Step(0.1);
+    ExpectSameFilters();
+  }
+}
+
+TEST_F(KalmanFilterBatchTest, AddAndRemove) {
+  for (int i = 0; i < 8; ++i) {
+    AddFilter();
+  }
+  Step(0.1);
+  // the last filter is moved to the index of the removed one
+  batch_.Remove(2);
+  filters_[2] = filters_.back();
+  filters_.pop_back();
+  batch_.Remove(6);
+  filters_.pop_back();
+  ExpectSameFilters();
+  AddFilter();
+  Step(0.2);
+  ExpectSameFilters();
+  batch_.Clear();
+  EXPECT_EQ(0, batch_.size());
+}
+
+TEST_F(KalmanFilterBatchTest, SingularInnovationCovariance) {
+  // without noise, the certain state is not corrected
+  batch_.SetTransitionNoise(Eigen::Matrix<double, 4, 4>::Zero());
+  batch_.SetObservationNoise(Eigen::Matrix<double, 2, 2>::Zero());
+  Eigen::Matrix<double, 4, 4> F;
+  F.setIdentity();
+  Eigen::Matrix<double, 4, 1> x;
+  x << 1.0, 2.0, 3.0, 4.0;
+  batch_.Add(F, x, Eigen::Matrix<double, 4, 4>::Zero());
+  batch_.SetObservation(0, Eigen::Vector2d(5.0, 6.0));
+  batch_.Predict();
+  batch_.Correct();
+  EXPECT_TRUE(x.isApprox(batch_.GetStateEstimate(0)));
+  EXPECT_TRUE(batch_.GetStateCovariance(0).isZero());
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,534 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file math_benchmark.cc
+ * @brief Times the math and geometry primitives used on the planning and
+ * control paths, at the sizes they run at on the vehicle, and reports the
+ * time per operation. With --benchmark_out, the results are also written in
+ * the JSON format of Google Benchmark, so that two runs can be compared with
+ * its tools, e.g. compare.py.
+ *
+ * \par
+ * bazel run -c opt //modules/common/math:math_benchmark --
+ *     --benchmark_out=/tmp/math_benchmark.json
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Eigen/Core"
+#include "gflags/gflags.h"
+
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/kalman_filter.h"
+#include "modules/common/math/line_segment2d.h"
+#include "modules/common/math/linear_quadratic_regulator.h"
+#include "modules/common/math/mpc_solver.h"
+#include "modules/common/math/polygon2d.h"
+#include "modules/common/math/qp_solver/admm_qp_solver.h"
+#include "modules/common/math/vec2d.h"
+
+DEFINE_string(benchmark_filter, "",
+              "Only the benchmarks whose name contains it are run.");
+DEFINE_double(benchmark_min_time, 0.5,
+              "The minimum time each benchmark is run for (s).");
+DEFINE_string(benchmark_out, "",
+              "The file the results are written to in JSON, if not empty.");
+DEFINE_int32(benchmark_num_obstacles, 200,
+             "The number of obstacle boxes, as around the vehicle in a busy "
+             "street.");
+DEFINE_int32(benchmark_num_lane_segments, 20000,
+             "The number of lane segments in the KD-tree, as in the map "
+             "around the vehicle.");
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+constexpr double kRange = 100.0;
+
+// Written by the benchmarks so that the operations are not optimized away.
+volatile double sink = 0.0;
+
+struct Benchmark {
+  std::string name;
+  // Runs the operation the given number of times.
+  std::function<void(int)> run;
+};
+
+struct Result {
+  std::string name;
+  int iterations = 0;
+  double real_ns = 0.0;
+  double cpu_ns = 0.0;
+};
+
+Vec2d RandomPoint(std::mt19937 *random) {
+  std::uniform_real_distribution<double> position(-kRange, kRange);
+  const double x = position(*random);
+  return Vec2d(x, position(*random));
+}
+
+std::vector<Vec2d> RandomPoints(const int num_points, std::mt19937 *random) {
+  std::vector<Vec2d> points;
+  points.reserve(num_points);
+  for (int i = 0; i < num_points; ++i) {
+    points.push_back(RandomPoint(random));
+  }
+  return points;
+}
+
+std::vector<Box2d> RandomBoxes(const int num_boxes, std::mt19937 *random) {
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::uniform_real_distribution<double> length(1.0, 5.0);
+  std::uniform_real_distribution<double> width(1.0, 3.0);
+  std::vector<Box2d> boxes;
+  boxes.reserve(num_boxes);
+  for (int i = 0; i < num_boxes; ++i) {
+    const Vec2d center = RandomPoint(random);
+    const double box_heading = heading(*random);
+    const double box_length = length(*random);
+    boxes.emplace_back(center, box_heading, box_length, width(*random));
+  }
+  return boxes;
+}
+
+// Lanes of 1 m segments, as the lane segments of a map.
+std::vector<LineSegment2d> RandomLaneSegments(const int num_segments,
+                                              std::mt19937 *random) {
+  constexpr int kSegmentsPerLane = 200;
+  std::uniform_real_distribution<double> heading(-M_PI, M_PI);
+  std::uniform_real_distribution<double> turn(-0.02, 0.02);
+  std::vector<LineSegment2d> segments;
+  segments.reserve(num_segments);
+  while (static_cast<int>(segments.size()) < num_segments) {
+    Vec2d start = RandomPoint(random);
+    double lane_heading = heading(*random);
+    for (int i = 0; i < kSegmentsPerLane &&
+                    static_cast<int>(segments.size()) < num_segments;
+         ++i) {
+      const Vec2d end = start + Vec2d::CreateUnitVec2d(lane_heading);
+      segments.emplace_back(start, end);
+      start = end;
+      lane_heading += turn(*random);
+    }
+  }
+  return segments;
+}
+
+class LaneSegment {
+ public:
+  explicit LaneSegment(const LineSegment2d &segment)
+      : segment_(segment),
+        aabox_(segment.start(), segment.end()) {}
+  const AABox2d &aabox() const { return aabox_; }
+  double DistanceTo(const Vec2d &point) const {
+    return segment_.DistanceTo(point);
+  }
+  double DistanceSquareTo(const Vec2d &point) const {
+    return segment_.DistanceSquareTo(point);
+  }
+
+ private:
+  LineSegment2d segment_;
+  AABox2d aabox_;
+};
+
+void AddGeometryBenchmarks(std::vector<Benchmark> *benchmarks) {
+  std::mt19937 random(1);
+  const auto points = RandomPoints(1024, &random);
+  const auto boxes = RandomBoxes(FLAGS_benchmark_num_obstacles, &random);
+  const auto segments = RandomLaneSegments(1024, &random);
+  std::vector<Polygon2d> polygons;
+  for (const auto &box : boxes) {
+    polygons.emplace_back(box);
+  }
+  const size_t mask = points.size() - 1;
+
+  benchmarks->push_back({"Vec2d/DistanceTo", [=](int iterations) {
+    double sum = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+      sum += points[i & mask].DistanceTo(points[(i + 1) & mask]);
+    }
+    sink = sum;
+  }});
+  benchmarks->push_back({"Vec2d/Normalize", [=](int iterations) {
+    double sum = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+      Vec2d point = points[i & mask];
+      point.Normalize();
+      sum += point.x();
+    }
+    sink = sum;
+  }});
+  benchmarks->push_back({"LineSegment2d/DistanceTo", [=](int iterations) {
+    double sum = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+      sum += segments[i & mask].DistanceTo(points[i & mask]);
+    }
+    sink = sum;
+  }});
+  benchmarks->push_back({"LineSegment2d/GetIntersect", [=](int iterations) {
+    int count = 0;
+    Vec2d point;
+    for (int i = 0; i < iterations; ++i) {
+      count += segments[i & mask].GetIntersect(segments[(i + 1) & mask],
+                                               &point);
+    }
+    sink = count;
+  }});
+  // Each operation is the test of a box of the trajectory against all the
+  // obstacles.
+  benchmarks->push_back({"Box2d/HasOverlap/obstacles", [=](int iterations) {
+    int count = 0;
+    for (int i = 0; i < iterations; ++i) {
+      const Box2d &query = boxes[i % boxes.size()];
+      for (const auto &box : boxes) {
+        count += query.HasOverlap(box);
+      }
+    }
+    sink = count;
+  }});
+  benchmarks->push_back({"Box2d/DistanceTo/obstacles", [=](int iterations) {
+    double sum = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+      const Vec2d &point = points[i & mask];
+      for (const auto &box : boxes) {
+        sum += box.DistanceTo(point);
+      }
+    }
+    sink = sum;
+  }});
+  benchmarks->push_back({"Polygon2d/HasOverlap/obstacles",
+                         [=](int iterations) {
+    int count = 0;
+    for (int i = 0; i < iterations; ++i) {
+      const Polygon2d &query = polygons[i % polygons.size()];
+      for (const auto &polygon : polygons) {
+        count += query.HasOverlap(polygon);
+      }
+    }
+    sink = count;
+  }});
+  benchmarks->push_back({"Polygon2d/DistanceTo/obstacles",
+                         [=](int iterations) {
+    double sum = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+      const Vec2d &point = points[i & mask];
+      for (const auto &polygon : polygons) {
+        sum += polygon.DistanceTo(point);
+      }
+    }
+    sink = sum;
+  }});
+}
+
+void AddKDTreeBenchmarks(std::vector<Benchmark> *benchmarks) {
+  std::mt19937 random(2);
+  const auto points = RandomPoints(1024, &random);
+  const size_t mask = points.size() - 1;
+  // Shared by the benchmarks, as the tree points to them.
+  const auto lane_segments = std::make_shared<std::vector<LaneSegment>>();
+  for (const auto &segment :
+       RandomLaneSegments(FLAGS_benchmark_num_lane_segments, &random)) {
+    lane_segments->emplace_back(segment);
+  }
+  // The parameters of the lane segment KD-tree of the HDMap.
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;
+  params.max_leaf_size = 16;
+  using LaneSegmentKDTree = AABoxKDTree2d<LaneSegment>;
+  const auto tree = std::make_shared<LaneSegmentKDTree>(*lane_segments, params);
+
+  benchmarks->push_back({"AABoxKDTree2d/Build", [=](int iterations) {
+    for (int i = 0; i < iterations; ++i) {
+      LaneSegmentKDTree built_tree(*lane_segments, params);
+      sink = built_tree.GetNearestObject(points[i & mask]) != nullptr;
+    }
+  }});
+  benchmarks->push_back({"AABoxKDTree2d/GetNearestObject",
+                         [=](int iterations) {
+    int count = 0;
+    for (int i = 0; i < iterations; ++i) {
+      count += tree->GetNearestObject(points[i & mask]) != nullptr;
+    }
+    sink = count;
+  }});
+  std::vector<const LaneSegment *> objects;
+  benchmarks->push_back({"AABoxKDTree2d/GetObjects/5m",
+                         [=](int iterations) mutable {
+    size_t count = 0;
+    for (int i = 0; i < iterations; ++i) {
+      tree->GetObjects(points[i & mask], 5.0, &objects);
+      count += objects.size();
+    }
+    sink = count;
+  }});
+}
+
+void AddControlBenchmarks(std::vector<Benchmark> *benchmarks) {
+  // The constant velocity tracker of the obstacles: the position and the
+  // velocity, observed by the position.
+  benchmarks->push_back({"KalmanFilter/4x2/PredictCorrect",
+                         [](int iterations) {
+    constexpr double kDt = 0.1;
+    Eigen::Matrix4d F = Eigen::Matrix4d::Identity();
+    F(0, 2) = kDt;
+    F(1, 3) = kDt;
+    Eigen::Matrix<double, 2, 4> H = Eigen::Matrix<double, 2, 4>::Zero();
+    H(0, 0) = 1.0;
+    H(1, 1) = 1.0;
+    KalmanFilter<double, 4, 2, 1> filter(Eigen::Vector4d::Zero(),
+                                         Eigen::Matrix4d::Identity());
+    filter.SetTransitionMatrix(F);
+    filter.SetTransitionNoise(Eigen::Matrix4d::Identity() * 0.01);
+    filter.SetObservationMatrix(H);
+    filter.SetObservationNoise(Eigen::Matrix2d::Identity() * 0.1);
+    for (int i = 0; i < iterations; ++i) {
+      filter.Predict();
+      const double t = i * kDt;
+      filter.Correct(Eigen::Vector2d(t, std::sin(t)));
+    }
+    sink = filter.GetStateEstimate()(0);
+  }});
+
+  // The lateral error dynamics of the lat controller for the Lincoln MKZ at
+  // 10 m/s, discretized as it does.
+  constexpr double kTs = 0.01;
+  constexpr double kSpeed = 10.0;
+  constexpr double kCf = 155494.663;
+  constexpr double kCr = 155494.663;
+  constexpr double kMassFront = 1040.0;
+  constexpr double kMassRear = 1040.0;
+  constexpr double kWheelbase = 2.8448;
+  const double mass = kMassFront + kMassRear;
+  const double lf = kWheelbase * (1.0 - kMassFront / mass);
+  const double lr = kWheelbase * (1.0 - kMassRear / mass);
+  const double iz = lf * lf * kMassFront + lr * lr * kMassRear;
+  Eigen::MatrixXd lat_a = Eigen::MatrixXd::Zero(4, 4);
+  lat_a(0, 1) = 1.0;
+  lat_a(1, 1) = -(kCf + kCr) / mass / kSpeed;
+  lat_a(1, 2) = (kCf + kCr) / mass;
+  lat_a(1, 3) = (lr * kCr - lf * kCf) / mass / kSpeed;
+  lat_a(2, 3) = 1.0;
+  lat_a(3, 1) = (lr * kCr - lf * kCf) / iz / kSpeed;
+  lat_a(3, 2) = (lf * kCf - lr * kCr) / iz;
+  lat_a(3, 3) = -(lf * lf * kCf + lr * lr * kCr) / iz / kSpeed;
+  const Eigen::MatrixXd identity = Eigen::MatrixXd::Identity(4, 4);
+  const Eigen::MatrixXd lat_ad = (identity + kTs * 0.5 * lat_a) *
+                                 (identity - kTs * 0.5 * lat_a).inverse();
+  Eigen::MatrixXd lat_bd = Eigen::MatrixXd::Zero(4, 1);
+  lat_bd(1, 0) = kCf / mass * kTs;
+  lat_bd(3, 0) = lf * kCf / iz * kTs;
+  Eigen::MatrixXd lat_q = Eigen::MatrixXd::Zero(4, 4);
+  lat_q(0, 0) = 0.05;
+  lat_q(2, 2) = 1.0;
+  const Eigen::MatrixXd lat_r = Eigen::MatrixXd::Identity(1, 1);
+  benchmarks->push_back({"SolveLQRProblem/4x1", [=](int iterations) {
+    Eigen::MatrixXd k;
+    for (int i = 0; i < iterations; ++i) {
+      SolveLQRProblem(lat_ad, lat_bd, lat_q, lat_r, 0.01, 150, &k);
+    }
+    sink = k(0, 0);
+  }});
+
+  // The 6 states, 2 controls and horizon of 10 of the MPC controller.
+  constexpr int kStates = 6;
+  constexpr int kControls = 2;
+  constexpr int kHorizon = 10;
+  Eigen::MatrixXd mpc_a = Eigen::MatrixXd::Identity(kStates, kStates);
+  mpc_a.topLeftCorner(4, 4) = lat_ad;
+  mpc_a(4, 5) = kTs;
+  Eigen::MatrixXd mpc_b = Eigen::MatrixXd::Zero(kStates, kControls);
+  mpc_b.topLeftCorner(4, 1) = lat_bd;
+  mpc_b(5, 1) = -kTs;
+  const Eigen::MatrixXd mpc_c = Eigen::MatrixXd::Zero(kStates, 1);
+  const Eigen::MatrixXd mpc_q = Eigen::MatrixXd::Identity(kStates, kStates);
+  const Eigen::MatrixXd mpc_r = Eigen::MatrixXd::Identity(kControls,
+                                                          kControls);
+  Eigen::MatrixXd lower_bound(kControls, 1);
+  lower_bound << -0.5, -4.0;
+  Eigen::MatrixXd upper_bound(kControls, 1);
+  upper_bound << 0.5, 4.0;
+  Eigen::MatrixXd initial_state(kStates, 1);
+  initial_state << 0.5, 0.0, 0.05, 0.0, 1.0, 0.5;
+  const std::vector<Eigen::MatrixXd> reference(
+      kHorizon, Eigen::MatrixXd::Zero(kStates, 1));
+  benchmarks->push_back({"SolveLinearMPC/6x2/10", [=](int iterations) {
+    std::vector<Eigen::MatrixXd> control(
+        kHorizon, Eigen::MatrixXd::Zero(kControls, 1));
+    for (int i = 0; i < iterations; ++i) {
+      SolveLinearMPC(mpc_a, mpc_b, mpc_c, mpc_q, mpc_r, lower_bound,
+                     upper_bound, initial_state, reference, 0.01, 150,
+                     &control);
+    }
+    sink = control[0](0);
+  }});
+
+  // The smoothing of the lateral offsets of 50 path points between bounds,
+  // as the QP path optimizers do.
+  constexpr int kNumParams = 50;
+  Eigen::MatrixXd difference = Eigen::MatrixXd::Zero(kNumParams - 2,
+                                                     kNumParams);
+  for (int i = 0; i + 2 < kNumParams; ++i) {
+    difference(i, i) = 1.0;
+    difference(i, i + 1) = -2.0;
+    difference(i, i + 2) = 1.0;
+  }
+  const Eigen::MatrixXd kernel =
+      Eigen::MatrixXd::Identity(kNumParams, kNumParams) +
+      1000.0 * difference.transpose() * difference;
+  Eigen::MatrixXd offset(kNumParams, 1);
+  for (int i = 0; i < kNumParams; ++i) {
+    offset(i, 0) = -2.0 * std::sin(i * 0.2);
+  }
+  // The inequality constraints are A x >= b: x >= -1 and -x >= -1.
+  Eigen::MatrixXd inequality_matrix(2 * kNumParams, kNumParams);
+  inequality_matrix << Eigen::MatrixXd::Identity(kNumParams, kNumParams),
+      -Eigen::MatrixXd::Identity(kNumParams, kNumParams);
+  const Eigen::MatrixXd inequality_boundary =
+      -Eigen::MatrixXd::Ones(2 * kNumParams, 1);
+  const Eigen::MatrixXd equality_matrix;
+  const Eigen::MatrixXd equality_boundary;
+  benchmarks->push_back({"AdmmQpSolver/Solve/50", [=](int iterations) {
+    double sum = 0.0;
+    for (int i = 0; i < iterations; ++i) {
+      AdmmQpSolver solver(kernel, offset, inequality_matrix,
+                          inequality_boundary, equality_matrix,
+                          equality_boundary);
+      solver.Solve();
+      sum += solver.params()(0, 0);
+    }
+    sink = sum;
+  }});
+}
+
+double CpuSeconds() {
+  return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+// Runs the benchmark a growing number of times, until the run takes the
+// minimum time, as Google Benchmark does.
+Result RunBenchmark(const Benchmark &benchmark) {
+  Result result;
+  result.name = benchmark.name;
+  int iterations = 1;
+  while (true) {
+    const auto start = std::chrono::steady_clock::now();
+    const double cpu_start = CpuSeconds();
+    benchmark.run(iterations);
+    const double cpu_seconds = CpuSeconds() - cpu_start;
+    const double seconds = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+    if (seconds >= FLAGS_benchmark_min_time || iterations >= 1000000000) {
+      result.iterations = iterations;
+      result.real_ns = seconds * 1e9 / iterations;
+      result.cpu_ns = cpu_seconds * 1e9 / iterations;
+      return result;
+    }
+    // Aims at 1.4 times the minimum time, growing by at most 10 times.
+    const double scale =
+        seconds > 0.0 ? FLAGS_benchmark_min_time * 1.4 / seconds : 10.0;
+    iterations = static_cast<int>(
+        std::min(1e9, iterations * std::max(1.1, std::min(10.0, scale))));
+  }
+}
+
+bool WriteJson(const std::vector<Result> &results, const std::string &path) {
+  FILE *file = fopen(path.c_str(), "w");
+  if (file == nullptr) {
+    return false;
+  }
+  char date[64];
+  const std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S",
+                std::localtime(&now));
+  fprintf(file, "{\n  \"context\": {\n");
+  fprintf(file, "    \"date\": \"%s\",\n", date);
+  fprintf(file, "    \"executable\": \"math_benchmark\",\n");
+  fprintf(file, "    \"library_build_type\": \"%s\"\n",
+#ifdef NDEBUG
+          "release"
+#else
+          "debug"
+#endif
+          );
+  fprintf(file, "  },\n  \"benchmarks\": [\n");
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result &result = results[i];
+    fprintf(file,
+            "    {\n"
+            "      \"name\": \"%s\",\n"
+            "      \"iterations\": %d,\n"
+            "      \"real_time\": %.3f,\n"
+            "      \"cpu_time\": %.3f,\n"
+            "      \"time_unit\": \"ns\"\n"
+            "    }%s\n",
+            result.name.c_str(), result.iterations, result.real_ns,
+            result.cpu_ns, i + 1 < results.size() ? "," : "");
+  }
+  fprintf(file, "  ]\n}\n");
+  return fclose(file) == 0;
+}
+
+int Run() {
+  std::vector<Benchmark> benchmarks;
+  AddGeometryBenchmarks(&benchmarks);
+  AddKDTreeBenchmarks(&benchmarks);
+  AddControlBenchmarks(&benchmarks);
+
+  std::vector<Result> results;
+  printf("%-36s %14s %14s %12s\n", "benchmark", "time(ns)", "cpu(ns)",
+         "iterations");
+  for (const auto &benchmark : benchmarks) {
+    if (benchmark.name.find(FLAGS_benchmark_filter) == std::string::npos) {
+      continue;
+    }
+    results.push_back(RunBenchmark(benchmark));
+    const Result &result = results.back();
+    printf("%-36s %14.1f %14.1f %12d\n", result.name.c_str(), result.real_ns,
+           result.cpu_ns, result.iterations);
+  }
+  if (!FLAGS_benchmark_out.empty() &&
+      !WriteJson(results, FLAGS_benchmark_out)) {
+    fprintf(stderr, "Failed to write %s\n", FLAGS_benchmark_out.c_str());
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::common::math::Run();
+}
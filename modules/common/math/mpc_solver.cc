@@ -19,7 +19,6 @@
 
 #include "modules/common/log.h"
 #include "modules/common/math/qp_solver/active_set_qp_solver.h"
-#include "modules/common/math/qp_solver/qp_solver.h"
 
 namespace apollo {
 namespace common {
@@ -43,99 +42,100 @@ bool SolveLinearMPC(const Matrix &matrix_a, const Matrix &matrix_b,
     return false;
   }
 
-  unsigned int horizon = reference.size();
-
-  // Update augment reference matrix_t
-  Matrix matrix_t = Matrix::Zero(matrix_b.rows() * horizon, 1);
-  for (unsigned int j = 0; j < horizon; ++j) {
-    matrix_t.block(j * reference[0].size(), 0, reference[0].size(), 1) =
-        reference[j];
+  const unsigned int horizon = reference.size();
+  const int num_state = matrix_a.rows();
+  const int num_control = matrix_b.cols();
+
+  // The stacked states are X = K * U + M, where M is the free response from
+  // the initial state and K is block lower triangular with the block
+  // A^(r - c + 1) * B at block (r, c). Only the distinct blocks of K are kept.
+  const Matrix matrix_ab = matrix_a * matrix_b;
+  std::vector<Matrix> matrix_a_power_b(horizon);
+  std::vector<Matrix> matrix_q_a_power_b(horizon);
+  matrix_a_power_b[0] = matrix_ab;
+  for (unsigned int i = 1; i < horizon; ++i) {
+    matrix_a_power_b[i] = matrix_a * matrix_a_power_b[i - 1];
   }
-
-  // Update augment control matrix_v
-  Matrix matrix_v = Matrix::Zero((*control)[0].rows() * horizon, 1);
-  for (unsigned int j = 0; j < horizon; ++j) {
-    matrix_v.block(j * (*control)[0].rows(), 0, (*control)[0].rows(), 1) =
-        (*control)[j];
+  for (unsigned int i = 0; i < horizon; ++i) {
+    matrix_q_a_power_b[i] = matrix_q * matrix_a_power_b[i];
   }
 
-  std::vector<Matrix> matrix_a_power(horizon);
-  matrix_a_power[0] = matrix_a;
-  for (unsigned int i = 1; i < matrix_a_power.size(); ++i) {
-    matrix_a_power[i] = matrix_a * matrix_a_power[i - 1];
+  // Tracking error of the free response, M - T
+  std::vector<Matrix> matrix_e(horizon);
+  Matrix matrix_m = matrix_a * matrix_initial_state + matrix_c;
+  for (unsigned int i = 0; i < horizon; ++i) {
+    if (i > 0) {
+      matrix_m = matrix_a * matrix_m + matrix_c;
+    }
+    matrix_e[i] = matrix_m - reference[i];
   }
 
-  Matrix matrix_k =
-      Matrix::Zero(matrix_b.rows() * horizon, matrix_b.cols() * horizon);
-  for (unsigned int r = 0; r < horizon; ++r) {
-    for (unsigned int c = 0; c <= r; ++c) {
-      matrix_k.block(r * matrix_b.rows(), c * matrix_b.cols(), matrix_b.rows(),
-                     matrix_b.cols()) = matrix_a_power[r - c] * matrix_b;
+  // Kernel K^T * Q * K + R of the QP. Its block (i, j) sums
+  // (A^(r - i + 1) * B)^T * Q * A^(r - j + 1) * B over r from max(i, j),
+  // so it is the block (i + 1, j + 1) plus the term of the last step.
+  const int num_param = num_control * horizon;
+  Matrix matrix_m1 = Matrix::Zero(num_param, num_param);
+  for (int i = horizon - 1; i >= 0; --i) {
+    for (int j = 0; j <= i; ++j) {
+      auto block = matrix_m1.block(i * num_control, j * num_control,
+                                   num_control, num_control);
+      block = matrix_a_power_b[horizon - 1 - i].transpose() *
+              matrix_q_a_power_b[horizon - 1 - j];
+      if (i + 1 < static_cast<int>(horizon)) {
+        block += matrix_m1.block((i + 1) * num_control, (j + 1) * num_control,
+                                 num_control, num_control);
+      }
     }
   }
-  // Initialize matrix_k, matrix_m, matrix_t and matrix_v, matrix_qq, matrix_rr,
-  // vector of matrix A power
-  Matrix matrix_m = Matrix::Zero(matrix_b.rows() * horizon, 1);
-  Matrix matrix_qq = Matrix::Zero(matrix_k.rows(), matrix_k.rows());
-  Matrix matrix_rr = Matrix::Zero(matrix_k.cols(), matrix_k.cols());
-  Matrix matrix_ll = Matrix::Zero(horizon * matrix_lower.rows(), 1);
-  Matrix matrix_uu = Matrix::Zero(horizon * matrix_upper.rows(), 1);
+  for (unsigned int i = 0; i < horizon; ++i) {
+    for (unsigned int j = i + 1; j < horizon; ++j) {
+      matrix_m1.block(i * num_control, j * num_control, num_control,
+                      num_control) =
+          matrix_m1
+              .block(j * num_control, i * num_control, num_control,
+                     num_control)
+              .transpose();
+    }
+    matrix_m1.block(i * num_control, i * num_control, num_control,
+                    num_control) += matrix_r;
+  }
 
-  // Compute matrix_m
-  matrix_m.block(0, 0, matrix_a.rows(), 1) =
-      matrix_a * matrix_initial_state + matrix_c;
-  for (unsigned int i = 1; i < horizon; ++i) {
-    matrix_m.block(i * matrix_a.rows(), 0, matrix_a.rows(), 1) =
-        matrix_a *
-            matrix_m.block((i - 1) * matrix_a.rows(), 0, matrix_a.rows(), 1) +
-        matrix_c;
+  // Offset K^T * Q * (M - T) of the QP, by the backward recursion
+  // lambda(i) = Q * e(i) + A^T * lambda(i + 1),
+  // offset(i) = (A * B)^T * lambda(i)
+  Matrix matrix_m2 = Matrix::Zero(num_param, 1);
+  Matrix matrix_lambda = Matrix::Zero(num_state, 1);
+  for (int i = horizon - 1; i >= 0; --i) {
+    matrix_lambda =
+        matrix_q * matrix_e[i] + matrix_a.transpose() * matrix_lambda;
+    matrix_m2.block(i * num_control, 0, num_control, 1) =
+        matrix_ab.transpose() * matrix_lambda;
   }
 
-  // Compute matrix_ll, matrix_uu, matrix_qq, matrix_rr
+  // The control limits are bounds of the QP parameters, and the given
+  // control sequence is the initial guess
+  Matrix matrix_ll = Matrix::Zero(num_param, 1);
+  Matrix matrix_uu = Matrix::Zero(num_param, 1);
+  Matrix matrix_v = Matrix::Zero(num_param, 1);
   for (unsigned int i = 0; i < horizon; ++i) {
-    matrix_ll.block(i * (*control)[0].rows(), 0, (*control)[0].rows(), 1) =
-        matrix_lower;
-    matrix_uu.block(i * (*control)[0].rows(), 0, (*control)[0].rows(), 1) =
-        matrix_upper;
-    matrix_qq.block(i * matrix_q.rows(), i * matrix_q.rows(), matrix_q.rows(),
-                    matrix_q.rows()) = matrix_q;
-    matrix_rr.block(i * matrix_r.rows(), i * matrix_r.rows(), matrix_r.cols(),
-                    matrix_r.cols()) = matrix_r;
+    matrix_ll.block(i * num_control, 0, num_control, 1) = matrix_lower;
+    matrix_uu.block(i * num_control, 0, num_control, 1) = matrix_upper;
+    matrix_v.block(i * num_control, 0, num_control, 1) = (*control)[i];
   }
 
-  // Update matrix_m1, matrix_m2, convert MPC problem to QP problem done
-  Matrix matrix_m1 = matrix_k.transpose() * matrix_qq * matrix_k + matrix_rr;
-  Matrix matrix_m2 = matrix_k.transpose() * matrix_qq * (matrix_m - matrix_t);
-
   // Format in qp_solver
   /**
    * *           min_x  : q(x) = 0.5 * x^T * Q * x  + x^T c
    * *           with respect to:  A * x = b (equality constraint)
    * *                             C * x >= d (inequality constraint)
    * **/
-
-  // TODO(QiL) : change qp solver to box constraint or substitute QPOASES
-  // Method 1: QPOASES
-  Matrix matrix_inequality_constrain_ll =
-      Matrix::Identity(matrix_ll.rows(), matrix_ll.rows());
-  Matrix matrix_inequality_constrain_uu =
-      Matrix::Identity(matrix_uu.rows(), matrix_uu.rows());
-  Matrix matrix_inequality_constrain =
-      Matrix::Zero(matrix_ll.rows() + matrix_uu.rows(), matrix_ll.rows());
-  matrix_inequality_constrain << matrix_inequality_constrain_ll,
-      -matrix_inequality_constrain_uu;
-  Matrix matrix_inequality_boundary =
-      Matrix::Zero(matrix_ll.rows() + matrix_uu.rows(), matrix_ll.cols());
-  matrix_inequality_boundary << matrix_ll, -matrix_uu;
-  Matrix matrix_equality_constrain =
-      Matrix::Zero(matrix_ll.rows() + matrix_uu.rows(), matrix_ll.rows());
-  Matrix matrix_equality_boundary =
-      Matrix::Zero(matrix_ll.rows() + matrix_uu.rows(), matrix_ll.cols());
-
-  std::unique_ptr<QpSolver> qp_solver(new ActiveSetQpSolver(
-      matrix_m1, matrix_m2, matrix_inequality_constrain,
-      matrix_inequality_boundary, matrix_equality_constrain,
-      matrix_equality_boundary));
+  const Matrix matrix_no_constrain = Matrix::Zero(0, num_param);
+  const Matrix matrix_no_boundary = Matrix::Zero(0, 1);
+  std::unique_ptr<ActiveSetQpSolver> qp_solver(new ActiveSetQpSolver(
+      matrix_m1, matrix_m2, matrix_no_constrain, matrix_no_boundary,
+      matrix_no_constrain, matrix_no_boundary));
+  qp_solver->set_param_bounds(matrix_ll, matrix_uu);
+  qp_solver->set_initial_guess(matrix_v);
   auto result = qp_solver->Solve();
   if (!result) {
     AERROR << "Linear MPC solver failed";
@@ -144,8 +144,7 @@ bool SolveLinearMPC(const Matrix &matrix_a, const Matrix &matrix_b,
   matrix_v = qp_solver->params();
 
   for (unsigned int i = 0; i < horizon; ++i) {
-    (*control)[i] =
-        matrix_v.block(i * (*control)[0].rows(), 0, (*control)[0].rows(), 1);
+    (*control)[i] = matrix_v.block(i * num_control, 0, num_control, 1);
   }
   return true;
 }
@@ -138,6 +138,62 @@ TEST(MPCSolverTest, MPC) {
     EXPECT_NEAR(0.0, control2[0](0), 1e-7);
   }
 }
+
+TEST(MPCSolverTest, WarmStart) {
+  const int STATES = 4;
+  const int CONTROLS = 1;
+  const int HORIZON = 20;
+  const double EPS = 0.01;
+  const int MAX_ITER = 100;
+
+  Eigen::MatrixXd A(STATES, STATES);
+  A << 1, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, 0, 0, 1;
+
+  Eigen::MatrixXd B(STATES, CONTROLS);
+  B << 0, 0, 1, 0;
+
+  Eigen::MatrixXd C(STATES, 1);
+  C << 0, 0, 0, 0.1;
+
+  Eigen::MatrixXd Q(STATES, STATES);
+  Q << 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0;
+
+  Eigen::MatrixXd R(CONTROLS, CONTROLS);
+  R << 1;
+
+  Eigen::MatrixXd lower_bound(CONTROLS, 1);
+  lower_bound << -1;
+
+  Eigen::MatrixXd upper_bound(CONTROLS, 1);
+  upper_bound << 1;
+
+  Eigen::MatrixXd initial_state(STATES, 1);
+  initial_state << 30, 30, 0, 0;
+
+  Eigen::MatrixXd reference_state(STATES, 1);
+  reference_state << 0, 0, 0, 0;
+
+  std::vector<Eigen::MatrixXd> reference(HORIZON, reference_state);
+
+  Eigen::MatrixXd control_matrix(CONTROLS, 1);
+  control_matrix << 0;
+  std::vector<Eigen::MatrixXd> cold_control(HORIZON, control_matrix);
+  EXPECT_TRUE(SolveLinearMPC(A, B, C, Q, R, lower_bound, upper_bound,
+                             initial_state, reference, EPS, MAX_ITER,
+                             &cold_control));
+
+  // the solution does not depend on the initial guess
+  std::vector<Eigen::MatrixXd> warm_control = cold_control;
+  EXPECT_TRUE(SolveLinearMPC(A, B, C, Q, R, lower_bound, upper_bound,
+                             initial_state, reference, EPS, MAX_ITER,
+                             &warm_control));
+  for (int i = 0; i < HORIZON; ++i) {
+    EXPECT_NEAR(cold_control[i](0), warm_control[i](0), 1e-6);
+    EXPECT_LE(warm_control[i](0), upper_bound(0) + 1e-6);
+    EXPECT_GE(warm_control[i](0), lower_bound(0) - 1e-6);
+  }
+}
+
 }  // namespace math
 }  // namespace common
 }  // namespace apollo
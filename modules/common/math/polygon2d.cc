@@ -28,6 +28,125 @@
 namespace apollo {
 namespace common {
 namespace math {
+namespace {
+
+// Relative tolerance on the square distance for GJK to stop.
+constexpr double kGjkTolerance = 1e-10;
+
+// The point farthest along the direction.
+const Vec2d &Support(const std::vector<Vec2d> &points,
+                     const Vec2d &direction) {
+  size_t farthest = 0;
+  double max_proj = points[0].InnerProd(direction);
+  for (size_t i = 1; i < points.size(); ++i) {
+    const double proj = points[i].InnerProd(direction);
+    if (proj > max_proj) {
+      max_proj = proj;
+      farthest = i;
+    }
+  }
+  return points[farthest];
+}
+
+// Reduces the simplex [start, end] to the vertices of the feature nearest
+// to the origin, and returns the point of that feature nearest to the
+// origin.
+Vec2d ReduceSegment(Vec2d *const simplex, int *const size) {
+  const Vec2d &start = simplex[0];
+  const Vec2d &end = simplex[1];
+  const Vec2d edge = end - start;
+  const double length_sqr = edge.LengthSquare();
+  const double ratio =
+      length_sqr > 0.0 ? -start.InnerProd(edge) / length_sqr : 0.0;
+  if (ratio <= 0.0) {
+    *size = 1;
+    return start;
+  }
+  if (ratio >= 1.0) {
+    simplex[0] = end;
+    *size = 1;
+    return end;
+  }
+  return start + edge * ratio;
+}
+
+// The same for a triangle, returning false if it contains the origin.
+bool ReduceTriangle(Vec2d *const simplex, int *const size,
+                    Vec2d *const nearest) {
+  const double area = CrossProd(simplex[0], simplex[1], simplex[2]);
+  if (std::abs(area) > kMathEpsilon * kMathEpsilon) {
+    const Vec2d origin(0.0, 0.0);
+    const double side0 = CrossProd(simplex[0], simplex[1], origin);
+    const double side1 = CrossProd(simplex[1], simplex[2], origin);
+    const double side2 = CrossProd(simplex[2], simplex[0], origin);
+    if (area > 0.0 ? (side0 >= 0.0 && side1 >= 0.0 && side2 >= 0.0)
+                   : (side0 <= 0.0 && side1 <= 0.0 && side2 <= 0.0)) {
+      return false;
+    }
+  }
+  // Otherwise the nearest point is on one of the edges.
+  double min_distance_sqr = std::numeric_limits<double>::infinity();
+  Vec2d best_simplex[2];
+  int best_size = 0;
+  for (const auto &edge : {std::make_pair(0, 1), std::make_pair(0, 2),
+                           std::make_pair(1, 2)}) {
+    Vec2d edge_simplex[2] = {simplex[edge.first], simplex[edge.second]};
+    int edge_size = 2;
+    const Vec2d point = ReduceSegment(edge_simplex, &edge_size);
+    const double distance_sqr = point.LengthSquare();
+    if (distance_sqr < min_distance_sqr) {
+      min_distance_sqr = distance_sqr;
+      *nearest = point;
+      best_simplex[0] = edge_simplex[0];
+      best_simplex[1] = edge_simplex[1];
+      best_size = edge_size;
+    }
+  }
+  simplex[0] = best_simplex[0];
+  simplex[1] = best_simplex[1];
+  *size = best_size;
+  return true;
+}
+
+// Computes the distance between two convex polygons with the GJK algorithm,
+// which walks the Minkowski difference of the polygons toward the origin,
+// in O(n + m) per iteration. Returns false when it does not converge.
+bool ConvexDistance(const std::vector<Vec2d> &points1,
+                    const std::vector<Vec2d> &points2,
+                    double *const distance) {
+  Vec2d simplex[3];
+  int size = 1;
+  simplex[0] = points1[0] - points2[0];
+  Vec2d nearest = simplex[0];
+  const int max_iterations =
+      2 * static_cast<int>(points1.size() + points2.size()) + 8;
+  for (int iteration = 0; iteration < max_iterations; ++iteration) {
+    const double distance_sqr = nearest.LengthSquare();
+    if (distance_sqr <= kMathEpsilon * kMathEpsilon) {
+      *distance = 0.0;
+      return true;
+    }
+    const Vec2d direction = nearest * -1.0;
+    const Vec2d vertex =
+        Support(points1, direction) - Support(points2, nearest);
+    // The Minkowski difference gets no nearer along the direction.
+    if (distance_sqr - nearest.InnerProd(vertex) <=
+        kGjkTolerance * distance_sqr) {
+      *distance = std::sqrt(distance_sqr);
+      return true;
+    }
+    simplex[size++] = vertex;
+    if (size == 2) {
+      nearest = ReduceSegment(simplex, &size);
+    } else if (!ReduceTriangle(simplex, &size, &nearest)) {
+      *distance = 0.0;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
 
 Polygon2d::Polygon2d(const Box2d &box) {
   box.GetAllCorners(&points_);
@@ -95,10 +214,16 @@ double Polygon2d::DistanceTo(const Polygon2d &polygon) const {
   CHECK_GE(points_.size(), 3);
   CHECK_GE(polygon.num_points(), 3);
 
-  if (IsPointIn(polygon.points()[0])) {
-    return 0.0;
+  if (is_convex_ && polygon.is_convex()) {
+    double distance = 0.0;
+    if (ConvexDistance(points_, polygon.points(), &distance)) {
+      return distance;
+    }
   }
-  if (polygon.IsPointIn(points_[0])) {
+  // Neither polygon can contain a point of the other if their bounding
+  // boxes are apart.
+  if (!IsAABoxApart(polygon) &&
+      (IsPointIn(polygon.points()[0]) || polygon.IsPointIn(points_[0]))) {
     return 0.0;
   }
   double distance = std::numeric_limits<double>::infinity();
@@ -144,8 +269,7 @@ bool Polygon2d::IsPointIn(const Vec2d &point) const {
 
 bool Polygon2d::HasOverlap(const Polygon2d &polygon) const {
   CHECK_GE(points_.size(), 3);
-  if (polygon.max_x() < min_x() || polygon.min_x() > max_x() ||
-      polygon.max_y() < min_y() || polygon.min_y() > max_y()) {
+  if (IsAABoxApart(polygon)) {
     return false;
   }
   return DistanceTo(polygon) <= kMathEpsilon;
@@ -188,6 +312,11 @@ bool Polygon2d::Contains(const Polygon2d &polygon) const {
                      });
 }
 
+bool Polygon2d::IsAABoxApart(const Polygon2d &polygon) const {
+  return polygon.max_x() < min_x() || polygon.min_x() > max_x() ||
+         polygon.max_y() < min_y() || polygon.min_y() > max_y();
+}
+
 int Polygon2d::Next(int at) const { return at >= num_points_ - 1 ? 0 : at + 1; }
 
 int Polygon2d::Prev(int at) const { return at == 0 ? num_points_ - 1 : at - 1; }
@@ -334,6 +463,9 @@ bool Polygon2d::ComputeOverlap(const Polygon2d &other_polygon,
   CHECK_GE(points_.size(), 3);
   CHECK_NOTNULL(overlap_polygon);
   CHECK(is_convex_ && other_polygon.is_convex());
+  if (IsAABoxApart(other_polygon)) {
+    return false;
+  }
   std::vector<Vec2d> points = other_polygon.points();
   for (int i = 0; i < num_points_; ++i) {
     if (!ClipConvexHull(line_segments_[i], &points)) {
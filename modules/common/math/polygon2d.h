@@ -137,7 +137,8 @@ class Polygon2d {
    *        If the other polygon is within this polygon, or it has overlap with
    *        this polygon, return 0. Otherwise, this distance is
    *        the minimal distance among the distances from the edges
-   *        of the other polygon to this polygon.
+   *        of the other polygon to this polygon. For two convex polygons it
+   *        is computed by the GJK algorithm, in linear time per iteration.
    * @param polygon The polygon to compute whose distance to this polygon.
    * @return The distance from the other polygon to this polygon.
    */
@@ -296,6 +297,9 @@ class Polygon2d {
 
  protected:
   void BuildFromPoints();
+  // Whether the axis-aligned bounding boxes of the polygons are apart, in
+  // which case the polygons do not overlap.
+  bool IsAABoxApart(const Polygon2d &polygon) const;
   int Next(int at) const;
   int Prev(int at) const;
 
@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file polygon2d_benchmark.cc
+ * @brief Times the distance and overlap tests of Polygon2d on random convex
+ * polygons of several sizes, against the test of all the edge pairs, and
+ * reports the time per pair of polygons.
+ *
+ * \par
+ * bazel run -c opt //modules/common/math:polygon2d_benchmark --
+ *     --benchmark_num_polygons=200
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/math/polygon2d.h"
+
+DEFINE_int32(benchmark_num_polygons, 200,
+             "The number of polygons of each size, tested pairwise.");
+DEFINE_double(benchmark_range, 20.0,
+              "Half the size of the square the polygons are spread on (m).");
+
+namespace apollo {
+namespace common {
+namespace math {
+namespace {
+
+// Random convex polygons of about num_points points on a circle.
+std::vector<Polygon2d> RandomPolygons(const int num_points,
+                                      std::mt19937 *random) {
+  std::uniform_real_distribution<double> position(-FLAGS_benchmark_range,
+                                                  FLAGS_benchmark_range);
+  std::uniform_real_distribution<double> radius(1.0, 4.0);
+  std::uniform_real_distribution<double> angle(0.0, M_PI * 2.0);
+  std::vector<Polygon2d> polygons;
+  polygons.reserve(FLAGS_benchmark_num_polygons);
+  while (static_cast<int>(polygons.size()) < FLAGS_benchmark_num_polygons) {
+    const Vec2d center(position(*random), position(*random));
+    const double polygon_radius = radius(*random);
+    std::vector<Vec2d> points;
+    for (int i = 0; i < num_points; ++i) {
+      points.push_back(center +
+                       Vec2d::CreateUnitVec2d(angle(*random)) * polygon_radius);
+    }
+    Polygon2d polygon;
+    if (Polygon2d::ComputeConvexHull(points, &polygon)) {
+      polygons.push_back(polygon);
+    }
+  }
+  return polygons;
+}
+
+// The distance from all the edge pairs, as computed before the convex
+// polygons were handled apart.
+double EdgePairDistance(const Polygon2d &polygon1,
+                        const Polygon2d &polygon2) {
+  if (polygon1.IsPointIn(polygon2.points()[0]) ||
+      polygon2.IsPointIn(polygon1.points()[0])) {
+    return 0.0;
+  }
+  double distance = std::numeric_limits<double>::infinity();
+  for (const auto &segment : polygon1.line_segments()) {
+    distance = std::min(distance, polygon2.DistanceTo(segment));
+  }
+  return distance;
+}
+
+// Runs the function and returns its time per pair of polygons, in
+// nanoseconds.
+double TimePerPair(const std::function<void()> &function,
+                   const double num_pairs) {
+  const auto start = std::chrono::steady_clock::now();
+  function();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         num_pairs;
+}
+
+void Run(const int num_points, std::mt19937 *random) {
+  const auto polygons = RandomPolygons(num_points, random);
+  const double num_pairs =
+      static_cast<double>(polygons.size()) * polygons.size();
+
+  // The sums keep the tests from being optimized away, and are checked to
+  // match.
+  double edge_pair_distance = 0.0;
+  const double edge_pair_ns = TimePerPair(
+      [&]() {
+        for (const auto &polygon1 : polygons) {
+          for (const auto &polygon2 : polygons) {
+            edge_pair_distance += EdgePairDistance(polygon1, polygon2);
+          }
+        }
+      },
+      num_pairs);
+  double distance = 0.0;
+  const double distance_ns = TimePerPair(
+      [&]() {
+        for (const auto &polygon1 : polygons) {
+          for (const auto &polygon2 : polygons) {
+            distance += polygon1.DistanceTo(polygon2);
+          }
+        }
+      },
+      num_pairs);
+
+  int overlaps = 0;
+  const double overlap_ns = TimePerPair(
+      [&]() {
+        for (const auto &polygon1 : polygons) {
+          for (const auto &polygon2 : polygons) {
+            overlaps += polygon1.HasOverlap(polygon2);
+          }
+        }
+      },
+      num_pairs);
+  int computed_overlaps = 0;
+  Polygon2d overlap_polygon;
+  const double compute_overlap_ns = TimePerPair(
+      [&]() {
+        for (const auto &polygon1 : polygons) {
+          for (const auto &polygon2 : polygons) {
+            computed_overlaps +=
+                polygon1.ComputeOverlap(polygon2, &overlap_polygon);
+          }
+        }
+      },
+      num_pairs);
+
+  printf("%6d %14.1f %12.1f %7.1fx %12.1f %12.1f  (%.4f / %.4f m, %d / %d)\n",
+         num_points, edge_pair_ns, distance_ns, edge_pair_ns / distance_ns,
+         overlap_ns, compute_overlap_ns, edge_pair_distance / num_pairs,
+         distance / num_pairs, overlaps, computed_overlaps);
+}
+
+}  // namespace
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  printf("%d polygons per size, tested pairwise, time per pair (ns)\n",
+         FLAGS_benchmark_num_polygons);
+  printf("%6s %14s %12s %8s %12s %12s\n", "points", "edge pairs",
+         "DistanceTo", "speedup", "HasOverlap", "ComputeOver");
+  std::mt19937 random(1);
+  for (const int num_points : {4, 8, 16, 32, 64}) {
+    apollo::common::math::Run(num_points, &random);
+  }
+  return 0;
+}
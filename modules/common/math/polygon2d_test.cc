@@ -16,7 +16,10 @@
 
 #include "modules/common/math/polygon2d.h"
 
+#include <algorithm>
+#include <random>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -49,6 +52,25 @@ bool ProjectByXSlow(const std::vector<Vec2d> &points, double x,
   return *min_y <= *max_y;
 }
 
+// The distance from the edge pairs, as for non-convex polygons.
+double DistanceSlow(const Polygon2d &polygon1, const Polygon2d &polygon2) {
+  if (polygon1.IsPointIn(polygon2.points()[0]) ||
+      polygon2.IsPointIn(polygon1.points()[0])) {
+    return 0.0;
+  }
+  double distance = std::numeric_limits<double>::infinity();
+  for (const auto &segment1 : polygon1.line_segments()) {
+    for (const auto &segment2 : polygon2.line_segments()) {
+      if (segment1.HasIntersect(segment2)) {
+        return 0.0;
+      }
+      distance = std::min({distance, segment1.DistanceTo(segment2.start()),
+                           segment2.DistanceTo(segment1.start())});
+    }
+  }
+  return distance;
+}
+
 }  // namespace
 
 TEST(Polygon2dTest, polygon_IsPointIn) {
@@ -259,6 +281,34 @@ TEST(Polygon2dTest, DistanceToPolygon) {
   EXPECT_NEAR(poly4.DistanceTo(poly3), 0.0, 1e-5);
 }
 
+TEST(Polygon2dTest, DistanceToConvexPolygonByRandom) {
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> center(-10.0, 10.0);
+  std::uniform_real_distribution<double> offset(-3.0, 3.0);
+  std::uniform_int_distribution<int> num_points(3, 40);
+  auto random_polygon = [&]() {
+    const Vec2d polygon_center(center(random), center(random));
+    std::vector<Vec2d> points;
+    const int n = num_points(random);
+    for (int i = 0; i < n; ++i) {
+      points.push_back(polygon_center + Vec2d(offset(random), offset(random)));
+    }
+    Polygon2d polygon;
+    EXPECT_TRUE(Polygon2d::ComputeConvexHull(points, &polygon));
+    return polygon;
+  };
+  for (int iter = 0; iter < 2000; ++iter) {
+    const Polygon2d polygon1 = random_polygon();
+    const Polygon2d polygon2 = random_polygon();
+    ASSERT_TRUE(polygon1.is_convex());
+    ASSERT_TRUE(polygon2.is_convex());
+    const double expected = DistanceSlow(polygon1, polygon2);
+    EXPECT_NEAR(expected, polygon1.DistanceTo(polygon2), 1e-6);
+    EXPECT_NEAR(expected, polygon2.DistanceTo(polygon1), 1e-6);
+    EXPECT_EQ(expected <= kMathEpsilon, polygon1.HasOverlap(polygon2));
+  }
+}
+
 TEST(Polygon2dTest, ContainPolygon) {
   const Polygon2d poly1(Box2d::CreateAABox({0, 0}, {3, 3}));
   const Polygon2d poly2(Box2d::CreateAABox({1, 1}, {2, 2}));
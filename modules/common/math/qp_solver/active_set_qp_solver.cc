@@ -92,9 +92,13 @@ bool ActiveSetQpSolver::Solve() {
   double upper_bound[num_param_];  // NOLINT
 
   // TODO(fanhaoyang): Haoyang Fan change this to a configurable version
+  const bool has_param_bounds = param_lower_bound_.rows() == num_param_ &&
+                                param_upper_bound_.rows() == num_param_;
   for (int i = 0; i < num_param_; ++i) {
-    lower_bound[i] = l_lower_bound_;
-    upper_bound[i] = l_upper_bound_;
+    lower_bound[i] =
+        has_param_bounds ? param_lower_bound_(i, 0) : l_lower_bound_;
+    upper_bound[i] =
+        has_param_bounds ? param_upper_bound_(i, 0) : l_upper_bound_;
   }
 
   // constraint matrix construction
@@ -132,9 +136,16 @@ bool ActiveSetQpSolver::Solve() {
   // initialize problem
   int max_iter = std::max(max_iteration_, num_constraint_);
 
+  double initial_guess[num_param_];  // NOLINT
+  const bool has_initial_guess = initial_guess_.rows() == num_param_;
+  for (int i = 0; has_initial_guess && i < num_param_; ++i) {
+    initial_guess[i] = initial_guess_(i, 0);
+  }
+
   auto ret = qp_problem.init(h_matrix, g_matrix, affine_constraint_matrix,
                              lower_bound, upper_bound, constraint_lower_bound,
-                             constraint_upper_bound, max_iter);
+                             constraint_upper_bound, max_iter, nullptr,
+                             has_initial_guess ? initial_guess : nullptr);
   if (ret != qpOASES::SUCCESSFUL_RETURN) {
     if (ret == qpOASES::RET_MAX_NWSR_REACHED) {
       AERROR << "qpOASES solver failed due to reached max iteration";
@@ -194,6 +205,17 @@ void ActiveSetQpSolver::set_constraint_upper_bound(
   constraint_upper_bound_ = la_upper_bound;
 }
 
+void ActiveSetQpSolver::set_param_bounds(const Eigen::MatrixXd& lower_bound,
+                                         const Eigen::MatrixXd& upper_bound) {
+  param_lower_bound_ = lower_bound;
+  param_upper_bound_ = upper_bound;
+}
+
+void ActiveSetQpSolver::set_initial_guess(
+    const Eigen::MatrixXd& initial_guess) {
+  initial_guess_ = initial_guess;
+}
+
 void ActiveSetQpSolver::set_max_iteration(const int max_iter) {
   max_iteration_ = max_iter;
 }
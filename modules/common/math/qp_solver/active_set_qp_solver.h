@@ -52,6 +52,15 @@ class ActiveSetQpSolver : public QpSolver {
   void set_l_upper_bound(const double l_upper_bound);
   void set_constraint_upper_bound(const double la_upper_bound);
 
+  // per parameter search bounds, which replace l_lower_bound and
+  // l_upper_bound; cheaper for the solver than affine box constraints
+  void set_param_bounds(const Eigen::MatrixXd& lower_bound,
+                        const Eigen::MatrixXd& upper_bound);
+
+  // guess of the solution, e.g. the shifted solution of the last cycle, from
+  // which the active set is guessed to warm start the solver
+  void set_initial_guess(const Eigen::MatrixXd& initial_guess);
+
   double qp_eps_num() const;
   double qp_eps_den() const;
   double qp_eps_iter_ref() const;
@@ -99,6 +108,13 @@ class ActiveSetQpSolver : public QpSolver {
   double l_lower_bound_ = -1e10;
   double l_upper_bound_ = 1e10;
 
+  // per parameter search bounds, empty when not set
+  Eigen::MatrixXd param_lower_bound_;
+  Eigen::MatrixXd param_upper_bound_;
+
+  // empty when not set
+  Eigen::MatrixXd initial_guess_;
+
   // constraint search upper bound
   double constraint_upper_bound_ = 1e10;
   int max_iteration_ = 1000;
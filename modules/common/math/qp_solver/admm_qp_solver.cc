@@ -0,0 +1,480 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file: admm_qp_solver.cc
+ **/
+#include "modules/common/math/qp_solver/admm_qp_solver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+// bounds at least this large are treated as unbounded
+constexpr double kUnboundedThreshold = 1e10;
+constexpr double kSigma = 1e-6;
+constexpr double kAlpha = 1.6;
+constexpr double kDefaultRho = 0.1;
+constexpr double kMinRho = 1e-6;
+constexpr double kMaxRho = 1e6;
+constexpr double kEqualityRhoRatio = 1e3;
+constexpr int kNumScalingIteration = 10;
+constexpr int kCheckInterval = 25;
+// accuracy at which the active constraints are guessed for polishing
+constexpr double kPolishEps = 1e-2;
+constexpr double kPolishDelta = 1e-9;
+constexpr double kPolishTolerance = 1e-7;
+constexpr int kMaxPolishIteration = 10;
+constexpr int kNumRefinementIteration = 5;
+
+double InfNorm(const Eigen::VectorXd& v) {
+  return v.size() == 0 ? 0.0 : v.lpNorm<Eigen::Infinity>();
+}
+
+// scaling factor from an infinity norm, leaving (almost) empty rows and
+// columns untouched
+double ScalingFactor(const double norm) {
+  return norm < 1e-4 ? 1.0 : 1.0 / std::sqrt(norm);
+}
+
+}  // namespace
+
+AdmmQpSolver::AdmmQpSolver(const Eigen::MatrixXd& kernel_matrix,
+                           const Eigen::MatrixXd& offset,
+                           const Eigen::MatrixXd& affine_inequality_matrix,
+                           const Eigen::MatrixXd& affine_inequality_boundary,
+                           const Eigen::MatrixXd& affine_equality_matrix,
+                           const Eigen::MatrixXd& affine_equality_boundary)
+    : QpSolver(kernel_matrix, offset, affine_inequality_matrix,
+               affine_inequality_boundary, affine_equality_matrix,
+               affine_equality_boundary),
+      num_param_(kernel_matrix.rows()) {}
+
+void AdmmQpSolver::SetWarmStart(const Eigen::MatrixXd& primal,
+                                const Eigen::MatrixXd& dual) {
+  primal_guess_ = primal;
+  dual_guess_ = dual;
+}
+
+bool AdmmQpSolver::Solve() {
+  if (!sanity_check()) {
+    AERROR << "AdmmQpSolver input dimensions mismatch.";
+    return false;
+  }
+  rho_scale_ = kDefaultRho;
+  BuildProblem();
+  ScaleProblem();
+  if (!Factorize()) {
+    AERROR << "AdmmQpSolver failed to factorize the kkt matrix.";
+    return false;
+  }
+
+  const int num_affine_constraint =
+      affine_equality_matrix_.rows() + affine_inequality_matrix_.rows();
+
+  Eigen::VectorXd x = Eigen::VectorXd::Zero(num_param_);
+  if (primal_guess_.rows() == num_param_ && primal_guess_.cols() == 1) {
+    x = primal_guess_.col(0).cwiseQuotient(d_);
+  }
+  Eigen::VectorXd y = Eigen::VectorXd::Zero(num_constraint_);
+  if (dual_guess_.rows() == num_affine_constraint && dual_guess_.cols() == 1) {
+    y.head(num_affine_constraint) =
+        cost_scale_ *
+        dual_guess_.col(0).cwiseQuotient(e_.head(num_affine_constraint));
+  }
+  Eigen::VectorXd z = (a_ * x).cwiseMax(lower_).cwiseMin(upper_);
+
+  bool converged = false;
+  num_iteration_ = 0;
+  while (num_iteration_ < max_iteration_) {
+    ++num_iteration_;
+    const Eigen::VectorXd rhs =
+        kSigma * x - q_ + a_.transpose() * (rho_.cwiseProduct(z) - y);
+    const Eigen::VectorXd x_tilde = ldlt_.solve(rhs);
+    const Eigen::VectorXd z_tilde = a_ * x_tilde;
+    x = kAlpha * x_tilde + (1.0 - kAlpha) * x;
+    const Eigen::VectorXd z_relaxed = kAlpha * z_tilde + (1.0 - kAlpha) * z;
+    const Eigen::VectorXd z_next = (z_relaxed + y.cwiseQuotient(rho_))
+                                       .cwiseMax(lower_)
+                                       .cwiseMin(upper_);
+    y += rho_.cwiseProduct(z_relaxed - z_next);
+    z = z_next;
+
+    if (num_iteration_ % kCheckInterval != 0 &&
+        num_iteration_ != max_iteration_) {
+      continue;
+    }
+
+    if (IsConverged(x, z, y, eps_abs_, eps_rel_)) {
+      converged = true;
+      break;
+    }
+    if (IsConverged(x, z, y, kPolishEps, kPolishEps)) {
+      Eigen::VectorXd x_polished;
+      Eigen::VectorXd y_polished;
+      if (Polish(z, y, &x_polished, &y_polished)) {
+        const Eigen::VectorXd z_polished =
+            (a_ * x_polished).cwiseMax(lower_).cwiseMin(upper_);
+        if (IsConverged(x_polished, z_polished, y_polished, eps_abs_,
+                        eps_rel_)) {
+          x = x_polished;
+          y = y_polished;
+          converged = true;
+          break;
+        }
+      }
+    }
+
+    const Eigen::VectorXd ax = a_ * x;
+    const Eigen::VectorXd px = p_ * x;
+    const Eigen::VectorXd aty = a_.transpose() * y;
+    // rebalance the primal and dual residuals of the scaled problem
+    const double scaled_prim_ratio =
+        InfNorm(ax - z) / (std::max(InfNorm(ax), InfNorm(z)) + 1e-10);
+    const double scaled_dual_ratio =
+        InfNorm(px + q_ + aty) /
+        (std::max(std::max(InfNorm(px), InfNorm(aty)), InfNorm(q_)) + 1e-10);
+    const double rho_new = std::min(
+        std::max(rho_scale_ * std::sqrt(scaled_prim_ratio /
+                                        (scaled_dual_ratio + 1e-10)),
+                 kMinRho),
+        kMaxRho);
+    if (rho_new > 5.0 * rho_scale_ || rho_new < 0.2 * rho_scale_) {
+      rho_ *= rho_new / rho_scale_;
+      rho_scale_ = rho_new;
+      if (!Factorize()) {
+        AERROR << "AdmmQpSolver failed to refactorize the kkt matrix.";
+        return false;
+      }
+    }
+  }
+
+  params_ = d_.cwiseProduct(x);
+  dual_params_ = e_.head(num_affine_constraint)
+                     .cwiseProduct(y.head(num_affine_constraint)) /
+                 cost_scale_;
+  if (!converged) {
+    AERROR << "AdmmQpSolver failed to converge in " << max_iteration_
+           << " iterations.";
+  }
+  return converged;
+}
+
+void AdmmQpSolver::BuildProblem() {
+  const int num_equality = affine_equality_matrix_.rows();
+  const int num_inequality = affine_inequality_matrix_.rows();
+  const bool has_param_bound = l_lower_bound_ > -kUnboundedThreshold ||
+                               l_upper_bound_ < kUnboundedThreshold;
+  num_constraint_ =
+      num_equality + num_inequality + (has_param_bound ? num_param_ : 0);
+
+  p_ = (0.5 * (kernel_matrix_ + kernel_matrix_.transpose())).sparseView();
+  q_ = offset_.rows() == num_param_ ? Eigen::VectorXd(offset_.col(0))
+                                    : Eigen::VectorXd::Zero(num_param_);
+
+  std::vector<Eigen::Triplet<double>> triplets;
+  lower_.resize(num_constraint_);
+  upper_.resize(num_constraint_);
+  int row = 0;
+  for (int r = 0; r < num_equality; ++r, ++row) {
+    for (int c = 0; c < num_param_; ++c) {
+      if (affine_equality_matrix_(r, c) != 0.0) {
+        triplets.emplace_back(row, c, affine_equality_matrix_(r, c));
+      }
+    }
+    lower_(row) = affine_equality_boundary_(r, 0);
+    upper_(row) = affine_equality_boundary_(r, 0);
+  }
+  const double constraint_upper_bound =
+      constraint_upper_bound_ < kUnboundedThreshold ? constraint_upper_bound_
+                                                    : kInfinity;
+  for (int r = 0; r < num_inequality; ++r, ++row) {
+    for (int c = 0; c < num_param_; ++c) {
+      if (affine_inequality_matrix_(r, c) != 0.0) {
+        triplets.emplace_back(row, c, affine_inequality_matrix_(r, c));
+      }
+    }
+    lower_(row) = affine_inequality_boundary_(r, 0);
+    upper_(row) = constraint_upper_bound;
+  }
+  if (has_param_bound) {
+    for (int c = 0; c < num_param_; ++c, ++row) {
+      triplets.emplace_back(row, c, 1.0);
+      lower_(row) =
+          l_lower_bound_ > -kUnboundedThreshold ? l_lower_bound_ : -kInfinity;
+      upper_(row) =
+          l_upper_bound_ < kUnboundedThreshold ? l_upper_bound_ : kInfinity;
+    }
+  }
+  a_.resize(num_constraint_, num_param_);
+  a_.setFromTriplets(triplets.begin(), triplets.end());
+}
+
+void AdmmQpSolver::ScaleProblem() {
+  // modified Ruiz equilibration of the kkt matrix [P A^T; A 0]
+  d_ = Eigen::VectorXd::Ones(num_param_);
+  e_ = Eigen::VectorXd::Ones(num_constraint_);
+  for (int iter = 0; iter < kNumScalingIteration; ++iter) {
+    Eigen::VectorXd col_norm = Eigen::VectorXd::Zero(num_param_);
+    Eigen::VectorXd row_norm = Eigen::VectorXd::Zero(num_constraint_);
+    for (int c = 0; c < p_.outerSize(); ++c) {
+      for (Eigen::SparseMatrix<double>::InnerIterator it(p_, c); it; ++it) {
+        col_norm(c) = std::max(col_norm(c), std::fabs(it.value()));
+      }
+    }
+    for (int c = 0; c < a_.outerSize(); ++c) {
+      for (Eigen::SparseMatrix<double>::InnerIterator it(a_, c); it; ++it) {
+        const double value = std::fabs(it.value());
+        col_norm(c) = std::max(col_norm(c), value);
+        row_norm(it.row()) = std::max(row_norm(it.row()), value);
+      }
+    }
+    const Eigen::VectorXd d_delta = col_norm.unaryExpr(&ScalingFactor);
+    const Eigen::VectorXd e_delta = row_norm.unaryExpr(&ScalingFactor);
+    p_ = d_delta.asDiagonal() * p_ * d_delta.asDiagonal();
+    a_ = e_delta.asDiagonal() * a_ * d_delta.asDiagonal();
+    q_ = q_.cwiseProduct(d_delta);
+    d_ = d_.cwiseProduct(d_delta);
+    e_ = e_.cwiseProduct(e_delta);
+  }
+
+  double mean_col_norm = 0.0;
+  for (int c = 0; c < p_.outerSize(); ++c) {
+    double norm = 0.0;
+    for (Eigen::SparseMatrix<double>::InnerIterator it(p_, c); it; ++it) {
+      norm = std::max(norm, std::fabs(it.value()));
+    }
+    mean_col_norm += norm;
+  }
+  mean_col_norm /= std::max(num_param_, 1);
+  const double cost_norm = std::max(mean_col_norm, InfNorm(q_));
+  cost_scale_ = cost_norm < 1e-4 ? 1.0 : 1.0 / cost_norm;
+  p_ *= cost_scale_;
+  q_ *= cost_scale_;
+
+  lower_ = lower_.cwiseProduct(e_);
+  upper_ = upper_.cwiseProduct(e_);
+
+  rho_.resize(num_constraint_);
+  for (int r = 0; r < num_constraint_; ++r) {
+    if (lower_(r) == -kInfinity && upper_(r) == kInfinity) {
+      rho_(r) = kMinRho;
+    } else if (lower_(r) == upper_(r)) {
+      rho_(r) = kEqualityRhoRatio * rho_scale_;
+    } else {
+      rho_(r) = rho_scale_;
+    }
+  }
+}
+
+bool AdmmQpSolver::Factorize() {
+  Eigen::SparseMatrix<double> identity(num_param_, num_param_);
+  identity.setIdentity();
+  const Eigen::SparseMatrix<double> kkt =
+      p_ + kSigma * identity +
+      Eigen::SparseMatrix<double>(a_.transpose() * rho_.asDiagonal() * a_);
+  ldlt_.compute(kkt);
+  return ldlt_.info() == Eigen::Success;
+}
+
+bool AdmmQpSolver::IsConverged(const Eigen::VectorXd& x,
+                               const Eigen::VectorXd& z,
+                               const Eigen::VectorXd& y, const double eps_abs,
+                               const double eps_rel) const {
+  const Eigen::VectorXd ax = a_ * x;
+  const Eigen::VectorXd px = p_ * x;
+  const Eigen::VectorXd aty = a_.transpose() * y;
+  const double prim_res = InfNorm((ax - z).cwiseQuotient(e_));
+  const double prim_norm =
+      std::max(InfNorm(ax.cwiseQuotient(e_)), InfNorm(z.cwiseQuotient(e_)));
+  const double dual_res =
+      InfNorm((px + q_ + aty).cwiseQuotient(d_)) / cost_scale_;
+  const double dual_norm =
+      std::max(std::max(InfNorm(px.cwiseQuotient(d_)),
+                        InfNorm(aty.cwiseQuotient(d_))),
+               InfNorm(q_.cwiseQuotient(d_))) /
+      cost_scale_;
+  return prim_res <= eps_abs + eps_rel * prim_norm &&
+         dual_res <= eps_abs + eps_rel * dual_norm;
+}
+
+bool AdmmQpSolver::Polish(const Eigen::VectorXd& z, const Eigen::VectorXd& y,
+                          Eigen::VectorXd* x_polished,
+                          Eigen::VectorXd* y_polished) const {
+  // -1: pinned to the lower bound, 1: pinned to the upper bound, 0: free
+  std::vector<int> active(num_constraint_, 0);
+  for (int r = 0; r < num_constraint_; ++r) {
+    if (lower_(r) == upper_(r) || z(r) - lower_(r) < -y(r)) {
+      active[r] = -1;
+    } else if (upper_(r) - z(r) < y(r)) {
+      active[r] = 1;
+    }
+  }
+
+  // correct the guess with a few active set iterations
+  for (int iter = 0; iter < kMaxPolishIteration; ++iter) {
+    if (!SolveActiveSet(active, x_polished, y_polished)) {
+      return false;
+    }
+    const Eigen::VectorXd ax = a_ * (*x_polished);
+    bool changed = false;
+    for (int r = 0; r < num_constraint_; ++r) {
+      if (lower_(r) == upper_(r)) {
+        continue;
+      }
+      if (active[r] != 0) {
+        // a wrongly guessed active constraint pulls instead of pushes
+        if (y_polished->coeff(r) * active[r] < -kPolishTolerance) {
+          active[r] = 0;
+          changed = true;
+        }
+      } else if (ax(r) < lower_(r) - kPolishTolerance) {
+        active[r] = -1;
+        changed = true;
+      } else if (ax(r) > upper_(r) + kPolishTolerance) {
+        active[r] = 1;
+        changed = true;
+      }
+    }
+    if (!changed) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AdmmQpSolver::SolveActiveSet(const std::vector<int>& active,
+                                  Eigen::VectorXd* x,
+                                  Eigen::VectorXd* y) const {
+  std::vector<int> active_index(num_constraint_, -1);
+  std::vector<int> active_rows;
+  for (int r = 0; r < num_constraint_; ++r) {
+    if (active[r] != 0) {
+      active_index[r] = static_cast<int>(active_rows.size());
+      active_rows.push_back(r);
+    }
+  }
+  const int num_active = static_cast<int>(active_rows.size());
+  const int dim = num_param_ + num_active;
+
+  // quasi-definite KKT system [P + delta * I, A_a^T; A_a, -delta * I]
+  std::vector<Eigen::Triplet<double>> triplets;
+  for (int c = 0; c < p_.outerSize(); ++c) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(p_, c); it; ++it) {
+      triplets.emplace_back(it.row(), c, it.value());
+    }
+  }
+  for (int c = 0; c < a_.outerSize(); ++c) {
+    for (Eigen::SparseMatrix<double>::InnerIterator it(a_, c); it; ++it) {
+      const int index = active_index[it.row()];
+      if (index >= 0) {
+        triplets.emplace_back(num_param_ + index, c, it.value());
+        triplets.emplace_back(c, num_param_ + index, it.value());
+      }
+    }
+  }
+  Eigen::SparseMatrix<double> exact_kkt(dim, dim);
+  exact_kkt.setFromTriplets(triplets.begin(), triplets.end());
+  for (int i = 0; i < dim; ++i) {
+    triplets.emplace_back(i, i, i < num_param_ ? kPolishDelta : -kPolishDelta);
+  }
+  Eigen::SparseMatrix<double> kkt(dim, dim);
+  kkt.setFromTriplets(triplets.begin(), triplets.end());
+
+  Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt(kkt);
+  if (ldlt.info() != Eigen::Success) {
+    return false;
+  }
+  Eigen::VectorXd rhs(dim);
+  rhs.head(num_param_) = -q_;
+  for (int i = 0; i < num_active; ++i) {
+    const int r = active_rows[i];
+    rhs(num_param_ + i) = active[r] < 0 ? lower_(r) : upper_(r);
+  }
+  // iterative refinement against the exact KKT matrix
+  Eigen::VectorXd solution = ldlt.solve(rhs);
+  for (int iter = 0; iter < kNumRefinementIteration; ++iter) {
+    solution += ldlt.solve(rhs - exact_kkt * solution);
+  }
+  if (!solution.allFinite()) {
+    return false;
+  }
+
+  *x = solution.head(num_param_);
+  *y = Eigen::VectorXd::Zero(num_constraint_);
+  for (int i = 0; i < num_active; ++i) {
+    y->coeffRef(active_rows[i]) = solution(num_param_ + i);
+  }
+  return true;
+}
+
+void AdmmQpSolver::set_max_iteration(const int max_iter) {
+  max_iteration_ = max_iter;
+}
+
+void AdmmQpSolver::set_l_lower_bound(const double l_lower_bound) {
+  l_lower_bound_ = l_lower_bound;
+}
+
+void AdmmQpSolver::set_l_upper_bound(const double l_upper_bound) {
+  l_upper_bound_ = l_upper_bound;
+}
+
+void AdmmQpSolver::set_constraint_upper_bound(const double la_upper_bound) {
+  constraint_upper_bound_ = la_upper_bound;
+}
+
+int AdmmQpSolver::max_iteration() const { return max_iteration_; }
+
+double AdmmQpSolver::l_lower_bound() const { return l_lower_bound_; }
+
+double AdmmQpSolver::l_upper_bound() const { return l_upper_bound_; }
+
+double AdmmQpSolver::constraint_upper_bound() const {
+  return constraint_upper_bound_;
+}
+
+const Eigen::MatrixXd& AdmmQpSolver::dual_params() const {
+  return dual_params_;
+}
+
+int AdmmQpSolver::num_iteration() const { return num_iteration_; }
+
+bool AdmmQpSolver::sanity_check() {
+  const auto matches = [this](const Eigen::MatrixXd& matrix,
+                              const Eigen::MatrixXd& boundary) {
+    return (matrix.rows() == 0 && boundary.rows() == 0) ||
+           (matrix.cols() == kernel_matrix_.rows() &&
+            matrix.rows() == boundary.rows() && boundary.cols() == 1);
+  };
+  return kernel_matrix_.rows() == kernel_matrix_.cols() &&
+         matches(affine_inequality_matrix_, affine_inequality_boundary_) &&
+         matches(affine_equality_matrix_, affine_equality_boundary_);
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file: admm_qp_solver.h
+ * @brief: sparse operator splitting (ADMM) quadratic programming solver
+ *
+ *        The problem is solved in the form
+ *          min_x  : 0.5 * x^T * Q * x  + x^T c
+ *          with respect to:  l <= M * x <= u
+ *        where M stacks the equality and inequality constraints. Q and M are
+ *        stored in compressed sparse column format and the linear system of
+ *        every iteration is solved from a single sparse LDLT factorization.
+ *        Once the iterate is moderately accurate, the active constraints are
+ *        guessed and the solution is polished by solving their KKT system.
+ **/
+
+#ifndef MODULES_COMMON_MATH_QP_SOLVER_ADMM_QP_SOLVER_H_
+#define MODULES_COMMON_MATH_QP_SOLVER_ADMM_QP_SOLVER_H_
+
+#include <vector>
+
+#include "Eigen/Core"
+#include "Eigen/SparseCholesky"
+#include "Eigen/SparseCore"
+
+#include "modules/common/math/qp_solver/qp_solver.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+class AdmmQpSolver : public QpSolver {
+ public:
+  AdmmQpSolver(const Eigen::MatrixXd& kernel_matrix,
+               const Eigen::MatrixXd& offset,
+               const Eigen::MatrixXd& affine_inequality_matrix,
+               const Eigen::MatrixXd& affine_inequality_boundary,
+               const Eigen::MatrixXd& affine_equality_matrix,
+               const Eigen::MatrixXd& affine_equality_boundary);
+  virtual ~AdmmQpSolver() = default;
+
+  bool Solve() override;
+
+  void SetTerminationTolerance(const double tolerance) override {
+    eps_abs_ = tolerance;
+    eps_rel_ = tolerance;
+  }
+
+  /**
+   * @brief Start the iterations from a previous solution instead of zero.
+   * Guesses whose dimensions do not match the problem are ignored.
+   * @param primal the guessed params, num_param x 1
+   * @param dual the guessed dual variables of the stacked equality and
+   * inequality constraints, num_constraint x 1
+   */
+  void SetWarmStart(const Eigen::MatrixXd& primal,
+                    const Eigen::MatrixXd& dual);
+
+  void set_max_iteration(const int max_iter);
+  void set_l_lower_bound(const double l_lower_bound);
+  void set_l_upper_bound(const double l_upper_bound);
+  void set_constraint_upper_bound(const double la_upper_bound);
+
+  int max_iteration() const;
+  double l_lower_bound() const;
+  double l_upper_bound() const;
+  double constraint_upper_bound() const;
+
+  /**
+   * @brief the dual variables of the stacked equality and inequality
+   * constraints, can be used to warm start the next solve.
+   */
+  const Eigen::MatrixXd& dual_params() const;
+
+  /**
+   * @brief number of iterations used by the last Solve().
+   */
+  int num_iteration() const;
+
+ private:
+  bool sanity_check() override;
+
+  void BuildProblem();
+  void ScaleProblem();
+  bool Factorize();
+
+  // residuals of the unscaled problem at the scaled iterate (x, z, y)
+  bool IsConverged(const Eigen::VectorXd& x, const Eigen::VectorXd& z,
+                   const Eigen::VectorXd& y, const double eps_abs,
+                   const double eps_rel) const;
+
+  // solve the equality constrained problem of the constraints active at
+  // (z, y) to refine a moderately accurate ADMM iterate
+  bool Polish(const Eigen::VectorXd& z, const Eigen::VectorXd& y,
+              Eigen::VectorXd* x_polished, Eigen::VectorXd* y_polished) const;
+
+  // solve the KKT system with the rows of non-zero active pinned to their
+  // lower (-1) or upper (1) bound
+  bool SolveActiveSet(const std::vector<int>& active, Eigen::VectorXd* x,
+                      Eigen::VectorXd* y) const;
+
+ private:
+  // equality constriant + inequality constraint (+ parameter bound)
+  int num_constraint_ = 0;
+  // number of parameters
+  int num_param_ = 0;
+
+  // parameter search bound, ignored if the bound is not tighter than 1e10
+  double l_lower_bound_ = -1e10;
+  double l_upper_bound_ = 1e10;
+
+  // constraint search upper bound
+  double constraint_upper_bound_ = 1e10;
+  int max_iteration_ = 4000;
+  int num_iteration_ = 0;
+
+  double eps_abs_ = 1e-6;
+  double eps_rel_ = 1e-6;
+
+  // scaled problem
+  Eigen::SparseMatrix<double> p_;
+  Eigen::VectorXd q_;
+  Eigen::SparseMatrix<double> a_;
+  Eigen::VectorXd lower_;
+  Eigen::VectorXd upper_;
+  Eigen::VectorXd rho_;
+  double rho_scale_ = 0.0;
+
+  // scaling: x = d * x_scaled, y = e * y_scaled / cost_scale
+  Eigen::VectorXd d_;
+  Eigen::VectorXd e_;
+  double cost_scale_ = 1.0;
+
+  Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt_;
+
+  Eigen::MatrixXd primal_guess_;
+  Eigen::MatrixXd dual_guess_;
+  Eigen::MatrixXd dual_params_;
+};
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_MATH_QP_SOLVER_ADMM_QP_SOLVER_H_
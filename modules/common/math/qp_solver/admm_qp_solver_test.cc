@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+#include "modules/common/math/qp_solver/admm_qp_solver.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace math {
+
+using Eigen::MatrixXd;
+
+TEST(AdmmQpSolver, unconstrained) {
+  MatrixXd kernel_matrix = MatrixXd::Zero(1, 1);
+  kernel_matrix(0, 0) = 1.0;
+  MatrixXd offset = MatrixXd::Zero(1, 1);
+  offset(0, 0) = -8.0;
+  MatrixXd affine_inequality_matrix;
+  MatrixXd affine_inequality_boundary;
+  MatrixXd affine_equality_matrix;
+  MatrixXd affine_equality_boundary;
+  AdmmQpSolver solver(kernel_matrix, offset, affine_inequality_matrix,
+                      affine_inequality_boundary, affine_equality_matrix,
+                      affine_equality_boundary);
+  EXPECT_TRUE(solver.Solve());
+  EXPECT_NEAR(solver.params()(0, 0), 8.0, 1e-5);
+}
+
+TEST(AdmmQpSolver, constrained) {
+  // min (x - 1)^2 + (y - 2)^2, x + y = 1, x >= 0.5
+  MatrixXd kernel_matrix = 2.0 * MatrixXd::Identity(2, 2);
+  MatrixXd offset(2, 1);
+  offset << -2.0, -4.0;
+  MatrixXd affine_equality_matrix(1, 2);
+  affine_equality_matrix << 1.0, 1.0;
+  MatrixXd affine_equality_boundary(1, 1);
+  affine_equality_boundary << 1.0;
+  MatrixXd affine_inequality_matrix(1, 2);
+  affine_inequality_matrix << 1.0, 0.0;
+  MatrixXd affine_inequality_boundary(1, 1);
+  affine_inequality_boundary << 0.5;
+
+  AdmmQpSolver solver(kernel_matrix, offset, affine_inequality_matrix,
+                      affine_inequality_boundary, affine_equality_matrix,
+                      affine_equality_boundary);
+  EXPECT_TRUE(solver.Solve());
+  EXPECT_NEAR(solver.params()(0, 0), 0.5, 1e-4);
+  EXPECT_NEAR(solver.params()(1, 0), 0.5, 1e-4);
+}
+
+TEST(AdmmQpSolver, param_bound) {
+  MatrixXd kernel_matrix = MatrixXd::Identity(1, 1);
+  MatrixXd offset = MatrixXd::Zero(1, 1);
+  offset(0, 0) = -5.0;
+  MatrixXd empty;
+  AdmmQpSolver solver(kernel_matrix, offset, empty, empty, empty, empty);
+  solver.set_l_upper_bound(2.0);
+  EXPECT_TRUE(solver.Solve());
+  EXPECT_NEAR(solver.params()(0, 0), 2.0, 1e-4);
+}
+
+TEST(AdmmQpSolver, banded_problem_warm_start) {
+  // smooth x toward a ramp with a curvature penalty, bounded below by 0 and
+  // pinned at the first point
+  const int n = 60;
+  MatrixXd kernel_matrix = MatrixXd::Identity(n, n);
+  for (int i = 1; i + 1 < n; ++i) {
+    // (x[i - 1] - 2 x[i] + x[i + 1])^2
+    const int idx[3] = {i - 1, i, i + 1};
+    const double coef[3] = {1.0, -2.0, 1.0};
+    for (int a = 0; a < 3; ++a) {
+      for (int b = 0; b < 3; ++b) {
+        kernel_matrix(idx[a], idx[b]) += 10.0 * coef[a] * coef[b];
+      }
+    }
+  }
+  kernel_matrix *= 2.0;
+  MatrixXd offset(n, 1);
+  for (int i = 0; i < n; ++i) {
+    offset(i, 0) = -2.0 * (i % 10 - 4.0);
+  }
+  MatrixXd affine_equality_matrix = MatrixXd::Zero(1, n);
+  affine_equality_matrix(0, 0) = 1.0;
+  MatrixXd affine_equality_boundary = MatrixXd::Zero(1, 1);
+  MatrixXd affine_inequality_matrix = MatrixXd::Identity(n, n);
+  MatrixXd affine_inequality_boundary = MatrixXd::Zero(n, 1);
+
+  AdmmQpSolver cold_solver(kernel_matrix, offset, affine_inequality_matrix,
+                           affine_inequality_boundary, affine_equality_matrix,
+                           affine_equality_boundary);
+  EXPECT_TRUE(cold_solver.Solve());
+  const MatrixXd& x = cold_solver.params();
+  EXPECT_NEAR(x(0, 0), 0.0, 1e-4);
+  for (int i = 0; i < n; ++i) {
+    EXPECT_GT(x(i, 0), -1e-4);
+  }
+  // KKT stationarity of the free (inactive) variables
+  const MatrixXd gradient = kernel_matrix * x + offset;
+  for (int i = 1; i < n; ++i) {
+    if (x(i, 0) > 1e-3) {
+      EXPECT_NEAR(gradient(i, 0), 0.0, 1e-3);
+    }
+  }
+
+  AdmmQpSolver warm_solver(kernel_matrix, offset, affine_inequality_matrix,
+                           affine_inequality_boundary, affine_equality_matrix,
+                           affine_equality_boundary);
+  warm_solver.SetWarmStart(cold_solver.params(), cold_solver.dual_params());
+  EXPECT_TRUE(warm_solver.Solve());
+  EXPECT_LT(warm_solver.num_iteration(), cold_solver.num_iteration());
+  for (int i = 0; i < n; ++i) {
+    EXPECT_NEAR(warm_solver.params()(i, 0), x(i, 0), 1e-4);
+  }
+}
+
+}  // namespace math
+}  // namespace common
+}  // namespace apollo
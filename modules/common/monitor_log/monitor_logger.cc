@@ -13,9 +13,20 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  *****************************************************************************/
+
 #include "modules/common/monitor_log/monitor_logger.h"
 
+#include <algorithm>
+#include <chrono>
+#include <map>
+
 #include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/util/string_util.h"
+
+DEFINE_double(monitor_log_batch_window_sec, 0.1,
+              "The period the monitor messages are batched for before they "
+              "are published by a background thread, 0 to publish them "
+              "right away.");
 
 namespace apollo {
 namespace common {
@@ -23,24 +34,129 @@ namespace monitor {
 
 using apollo::common::adapter::AdapterManager;
 
+MonitorLogger::~MonitorLogger() {
+  {
+    std::lock_guard<std::mutex> lock(thread_mutex_);
+    stopped_ = true;
+  }
+  stop_cvar_.notify_all();
+  if (publish_thread_.joinable()) {
+    publish_thread_.join();
+  }
+  // The derived class is already destroyed, the queued messages can no
+  // longer be published.
+  for (PendingItem *pending = pending_.exchange(nullptr); pending != nullptr;) {
+    PendingItem *next = pending->next;
+    delete pending;
+    pending = next;
+  }
+}
+
 void MonitorLogger::Publish(const std::vector<MessageItem> &messages) const {
+  if (messages.empty()) {
+    return;
+  }
+  if (FLAGS_monitor_log_batch_window_sec <= 0.0) {
+    PublishBatch(messages);
+    return;
+  }
+  for (const auto &msg_item : messages) {
+    auto *pending = new PendingItem();
+    pending->item = msg_item;
+    pending->next = pending_.load(std::memory_order_relaxed);
+    while (!pending_.compare_exchange_weak(pending->next, pending,
+                                           std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+    }
+  }
+  if (!thread_started_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(thread_mutex_);
+    if (!thread_started_ && !stopped_) {
+      publish_thread_ = std::thread(&MonitorLogger::PublishThreadFunc, this);
+      thread_started_ = true;
+    }
+  }
+}
+
+void MonitorLogger::Flush() const {
+  {
+    std::lock_guard<std::mutex> lock(thread_mutex_);
+    stopped_ = true;
+  }
+  stop_cvar_.notify_all();
+  if (publish_thread_.joinable()) {
+    publish_thread_.join();
+  }
+  PublishBatch(TakePending());
+  std::lock_guard<std::mutex> lock(thread_mutex_);
+  stopped_ = false;
+  thread_started_ = false;
+}
+
+std::vector<MessageItem> MonitorLogger::TakePending() const {
+  std::vector<MessageItem> messages;
+  PendingItem *pending = pending_.exchange(nullptr, std::memory_order_acquire);
+  while (pending != nullptr) {
+    messages.push_back(std::move(pending->item));
+    PendingItem *next = pending->next;
+    delete pending;
+    pending = next;
+  }
+  std::reverse(messages.begin(), messages.end());
+  return messages;
+}
+
+void MonitorLogger::PublishBatch(
+    const std::vector<MessageItem> &messages) const {
   // compose a monitor message
   if (messages.empty()) {
     return;
   }
   MonitorMessage monitor_msg;
 
+  // The repeated messages are merged into the first of them.
+  std::map<MessageItem, std::pair<int, int>> repeats;
   for (const auto &msg_item : messages) {
+    const auto inserted =
+        repeats.emplace(msg_item, std::make_pair(monitor_msg.item_size(), 0));
+    ++inserted.first->second.second;
+    if (!inserted.second) {
+      continue;
+    }
     MonitorMessageItem *monitor_msg_item = monitor_msg.add_item();
     monitor_msg_item->set_source(source_);
     monitor_msg_item->set_log_level(msg_item.first);
     monitor_msg_item->set_msg(msg_item.second);
   }
+  for (const auto &repeat : repeats) {
+    if (repeat.second.second > 1) {
+      auto *monitor_msg_item = monitor_msg.mutable_item(repeat.second.first);
+      monitor_msg_item->set_msg(
+          util::StrCat(monitor_msg_item->msg(), " (repeated ",
+                       repeat.second.second, " times)"));
+    }
+  }
 
   // publish monitor messages
   DoPublish(&monitor_msg);
 }
 
+void MonitorLogger::PublishThreadFunc() const {
+  const auto window = std::chrono::duration<double>(
+      FLAGS_monitor_log_batch_window_sec);
+  std::unique_lock<std::mutex> lock(thread_mutex_);
+  while (true) {
+    if (stop_cvar_.wait_for(lock, window, [this]() { return stopped_; })) {
+      // The messages queued meanwhile are published by Flush(), or dropped
+      // on destruction.
+      break;
+    }
+    lock.unlock();
+    PublishBatch(TakePending());
+    lock.lock();
+  }
+}
+
 void MonitorLogger::DoPublish(MonitorMessage *message) const {
   DCHECK(AdapterManager::Initialized())
       << "AdapterManager must be initialized before using monitor.";
@@ -22,12 +22,20 @@
 #ifndef MODULES_COMMON_MONITOR_LOG_MONITOR_LOGGER_H_
 #define MODULES_COMMON_MONITOR_LOG_MONITOR_LOGGER_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include "gflags/gflags.h"
+
 #include "modules/common/monitor_log/proto/monitor_log.pb.h"
 
+DECLARE_double(monitor_log_batch_window_sec);
+
 /**
  * @namespace apollo::common::monitor
  * @brief apollo::common::monitor
@@ -45,6 +53,18 @@ using MessageItem = std::pair<MonitorMessageItem::LogLevel, std::string>;
  * topic. A module who wants to publish message can use macro
  * `MONITOR(log_level, log_msg)` to record messages, and call
  * Publish to broadcast the message to other modules.
+ *
+ * \par
+ * Publish() only queues the messages. They are published by a background
+ * thread every --monitor_log_batch_window_sec, in one MonitorMessage where
+ * the repeated messages of the window are merged, so that the threads
+ * logging them never wait for the publishing. A window of 0 publishes the
+ * messages right away.
+ *
+ * \note
+ * The messages still queued on destruction are dropped, call Flush() to
+ * publish them. A subclass overriding DoPublish() must call Flush() in its
+ * destructor, if it publishes in the background.
  */
 class MonitorLogger {
  public:
@@ -55,7 +75,7 @@ class MonitorLogger {
    */
   explicit MonitorLogger(const MonitorMessageItem::MessageSource &source)
       : source_(source) {}
-  virtual ~MonitorLogger() = default;
+  virtual ~MonitorLogger();
 
   /**
    * @brief Publish the messages.
@@ -63,10 +83,40 @@ class MonitorLogger {
    */
   virtual void Publish(const std::vector<MessageItem> &messages) const;
 
+  /**
+   * @brief Publishes the queued messages now, and stops the background
+   * thread until the next Publish(). Not to be called concurrently.
+   */
+  void Flush() const;
+
  private:
+  struct PendingItem {
+    MessageItem item;
+    PendingItem *next = nullptr;
+  };
+
   virtual void DoPublish(MonitorMessage *message) const;
 
+  // Takes the queued messages out, the oldest first.
+  std::vector<MessageItem> TakePending() const;
+
+  // Publishes the messages with the repeated ones merged.
+  void PublishBatch(const std::vector<MessageItem> &messages) const;
+
+  void PublishThreadFunc() const;
+
   MonitorMessageItem::MessageSource source_;
+
+  // The queued messages, the latest first. Publish() pushes to it without
+  // a lock, and the background thread takes the whole list at once.
+  mutable std::atomic<PendingItem *> pending_{nullptr};
+
+  // Guards the background thread.
+  mutable std::mutex thread_mutex_;
+  mutable std::condition_variable stop_cvar_;
+  mutable std::thread publish_thread_;
+  mutable std::atomic<bool> thread_started_{false};
+  mutable bool stopped_ = false;
 };
 
 }  // namespace monitor
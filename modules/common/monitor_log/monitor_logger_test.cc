@@ -15,7 +15,10 @@
  *****************************************************************************/
 #include "modules/common/monitor_log/monitor_logger.h"
 
+#include <chrono>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -28,9 +31,21 @@ class MonitorTest : public MonitorLogger {
  public:
   explicit MonitorTest(const MonitorMessageItem::MessageSource &source)
       : MonitorLogger(source) {}
+  ~MonitorTest() { Flush(); }
+
+  std::vector<MonitorMessage> published() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return published_;
+  }
 
  private:
-  void DoPublish(MonitorMessage *) const override {}
+  void DoPublish(MonitorMessage *message) const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    published_.push_back(*message);
+  }
+
+  mutable std::mutex mutex_;
+  mutable std::vector<MonitorMessage> published_;
 };
 
 TEST(MonitorTest, Publish) {
@@ -43,6 +58,42 @@ TEST(MonitorTest, Publish) {
   monitor.Publish(items);
 }
 
+TEST(MonitorTest, Batch) {
+  MonitorTest monitor(MonitorMessageItem::CONTROL);
+  monitor.Publish({{MonitorMessageItem::WARN, "warn message"}});
+  monitor.Publish({{MonitorMessageItem::ERROR, "error message"},
+                   {MonitorMessageItem::WARN, "warn message"}});
+  // Nothing is published by the caller.
+  EXPECT_TRUE(monitor.published().empty());
+  monitor.Flush();
+
+  const auto published = monitor.published();
+  ASSERT_EQ(1, published.size());
+  ASSERT_EQ(2, published[0].item_size());
+  EXPECT_EQ(MonitorMessageItem::CONTROL, published[0].item(0).source());
+  EXPECT_EQ(MonitorMessageItem::WARN, published[0].item(0).log_level());
+  EXPECT_EQ("warn message (repeated 2 times)", published[0].item(0).msg());
+  EXPECT_EQ("error message", published[0].item(1).msg());
+}
+
+TEST(MonitorTest, PublishInBackground) {
+  MonitorTest monitor(MonitorMessageItem::CONTROL);
+  monitor.Publish({{MonitorMessageItem::INFO, "info message"}});
+  for (int i = 0; i < 100 && monitor.published().empty(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(1, monitor.published().size());
+  EXPECT_EQ("info message", monitor.published()[0].item(0).msg());
+}
+
+TEST(MonitorTest, PublishRightAway) {
+  FLAGS_monitor_log_batch_window_sec = 0.0;
+  MonitorTest monitor(MonitorMessageItem::CONTROL);
+  monitor.Publish({{MonitorMessageItem::INFO, "info message"}});
+  FLAGS_monitor_log_batch_window_sec = 0.1;
+  EXPECT_EQ(1, monitor.published().size());
+}
+
 }  // namespace monitor
 }  // namespace common
 }  // namespace apollo
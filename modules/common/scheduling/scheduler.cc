@@ -0,0 +1,214 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#include "modules/common/scheduling/scheduler.h"
+
+#include <alloca.h>
+#include <errno.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include <sstream>
+#include <string>
+
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+
+DEFINE_string(scheduling_config_file, "",
+              "The SchedulingConfig of the app, none is applied if empty.");
+
+namespace apollo {
+namespace common {
+namespace scheduling {
+
+namespace {
+
+// The max length of a thread name, without the terminating null.
+const size_t kMaxThreadNameLength = 15;
+
+const size_t kPageSize = 4096;
+
+// Touches a page in every page of a stack frame of the size, so that the
+// stack below the calling frame is resident.
+__attribute__((noinline)) void PrefaultStack(const size_t size) {
+  volatile char *stack = static_cast<volatile char *>(alloca(size));
+  for (size_t i = 0; i < size; i += kPageSize) {
+    stack[i] = 0;
+  }
+}
+
+std::string PolicyName(const int policy) {
+  switch (policy) {
+    case SCHED_FIFO:
+      return "SCHED_FIFO";
+    case SCHED_RR:
+      return "SCHED_RR";
+    case SCHED_OTHER:
+      return "SCHED_OTHER";
+    default:
+      return std::to_string(policy);
+  }
+}
+
+}  // namespace
+
+ThreadSchedule MakeThreadSchedule(const int priority,
+                                  const std::vector<int> &cpus) {
+  ThreadSchedule schedule;
+  schedule.set_priority(priority);
+  for (const int cpu : cpus) {
+    schedule.add_cpu(cpu);
+  }
+  return schedule;
+}
+
+Scheduler::Scheduler() {}
+
+void Scheduler::Init(const SchedulingConfig &config) {
+  config_ = config;
+  if (config_.lock_memory() && !memory_locked_) {
+    memory_locked_ = LockMemory();
+  }
+  // The main thread keeps the name of the process unless one is configured.
+  ApplyToCurrentThread(config_.main_thread().name(), config_.main_thread());
+}
+
+bool Scheduler::Init(const std::string &config_file) {
+  SchedulingConfig config;
+  if (!util::GetProtoFromFile(config_file, &config)) {
+    AERROR << "Unable to load the scheduling config " << config_file;
+    return false;
+  }
+  Init(config);
+  return true;
+}
+
+bool Scheduler::LockMemory() {
+  if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+    AWARN << "failed to lock the memory: " << strerror(errno);
+    return false;
+  }
+  return true;
+}
+
+const ThreadSchedule *Scheduler::FindThreadSchedule(
+    const std::string &name) const {
+  for (const auto &schedule : config_.thread()) {
+    if (schedule.name() == name) {
+      return &schedule;
+    }
+  }
+  return nullptr;
+}
+
+void Scheduler::ApplyToCurrentThread(const std::string &name) {
+  const ThreadSchedule *schedule = FindThreadSchedule(name);
+  ApplyToCurrentThread(
+      name, schedule != nullptr ? *schedule : ThreadSchedule::default_instance());
+}
+
+void Scheduler::ApplyToCurrentThread(const std::string &name,
+                                     const ThreadSchedule &schedule) {
+  ApplyToThread(pthread_self(), name, schedule);
+  if (config_.prefault_stack_kb() > 0) {
+    PrefaultStack(static_cast<size_t>(config_.prefault_stack_kb()) * 1024);
+  }
+}
+
+bool Scheduler::ApplyToThread(pthread_t thread, const std::string &name,
+                              const ThreadSchedule &schedule) {
+  if (!name.empty()) {
+    pthread_setname_np(thread, name.substr(0, kMaxThreadNameLength).c_str());
+  }
+  bool ok = true;
+  if (schedule.priority() > 0) {
+    sched_param param;
+    param.sched_priority = schedule.priority();
+    const int result = pthread_setschedparam(thread, SCHED_FIFO, &param);
+    if (result != 0) {
+      AWARN << "failed to set the priority of thread " << name << " to "
+            << schedule.priority() << ": " << strerror(result);
+      ok = false;
+    }
+  }
+  if (schedule.cpu_size() > 0) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (const int cpu : schedule.cpu()) {
+      if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        AWARN << "invalid cpu " << cpu << " of thread " << name;
+        continue;
+      }
+      CPU_SET(cpu, &cpu_set);
+    }
+    const int result =
+        pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+    if (result != 0) {
+      AWARN << "failed to set the cpu affinity of thread " << name << ": "
+            << strerror(result);
+      ok = false;
+    }
+  }
+
+  const ThreadReport report = GetEffectiveSchedule(thread, name);
+  std::lock_guard<std::mutex> lock(mutex_);
+  reports_.push_back(report);
+  return ok;
+}
+
+Scheduler::ThreadReport Scheduler::GetEffectiveSchedule(
+    pthread_t thread, const std::string &name) const {
+  ThreadReport report;
+  report.name = name.empty() ? "main" : name;
+  sched_param param;
+  if (pthread_getschedparam(thread, &report.policy, &param) == 0) {
+    report.priority = param.sched_priority;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (pthread_getaffinity_np(thread, sizeof(cpu_set), &cpu_set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &cpu_set)) {
+        report.cpus.push_back(cpu);
+      }
+    }
+  }
+  return report;
+}
+
+std::string Scheduler::Report() const {
+  std::ostringstream oss;
+  oss << "memory locked: " << (memory_locked_ ? "yes" : "no");
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto &report : reports_) {
+    oss << "\n" << report.name << ": " << PolicyName(report.policy)
+        << ", priority " << report.priority << ", cpus";
+    for (const int cpu : report.cpus) {
+      oss << " " << cpu;
+    }
+  }
+  return oss.str();
+}
+
+}  // namespace scheduling
+}  // namespace common
+}  // namespace apollo
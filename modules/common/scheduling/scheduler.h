@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_COMMON_SCHEDULING_SCHEDULER_H_
+#define MODULES_COMMON_SCHEDULING_SCHEDULER_H_
+
+#include <pthread.h>
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "modules/common/macro.h"
+#include "modules/common/scheduling/proto/scheduling_config.pb.h"
+
+DECLARE_string(scheduling_config_file);
+
+/**
+ * @namespace apollo::common::scheduling
+ * @brief apollo::common::scheduling
+ */
+namespace apollo {
+namespace common {
+namespace scheduling {
+
+/**
+ * @brief Makes the settings of a thread from a SCHED_FIFO priority, 0 for the
+ * default scheduler, and the cpus to pin it to, all if empty.
+ */
+ThreadSchedule MakeThreadSchedule(int priority, const std::vector<int> &cpus);
+
+/**
+ * @class Scheduler
+ * @brief Applies the real-time priorities, cpu affinities and memory locking
+ * of a SchedulingConfig to the threads of the process, and reports the
+ * settings they effectively got. Failing to apply a setting, e.g. without the
+ * privilege of real-time priorities, only warns.
+ */
+class Scheduler {
+ public:
+  /**
+   * @brief Locks the memory and sets up the calling thread as the main
+   * thread, as configured.
+   */
+  void Init(const SchedulingConfig &config);
+
+  /**
+   * @brief Loads the config from a file, then initializes with it.
+   * @return false if the file cannot be loaded.
+   */
+  bool Init(const std::string &config_file);
+
+  /**
+   * @brief Gets the configured settings of a named thread, nullptr if it has
+   * none.
+   */
+  const ThreadSchedule *FindThreadSchedule(const std::string &name) const;
+
+  /**
+   * @brief Names the calling thread and applies its configured settings, if
+   * any. The threads which should be configurable by name call it first.
+   */
+  void ApplyToCurrentThread(const std::string &name);
+
+  /**
+   * @brief Names the calling thread and applies settings to it, in place of
+   * the configured ones.
+   */
+  void ApplyToCurrentThread(const std::string &name,
+                            const ThreadSchedule &schedule);
+
+  /**
+   * @brief Names a thread, unless the name is empty, and applies settings to
+   * it.
+   * @return false if a setting could not be applied.
+   */
+  bool ApplyToThread(pthread_t thread, const std::string &name,
+                     const ThreadSchedule &schedule);
+
+  /**
+   * @brief Gets the effective settings of the threads set up so far, one line
+   * per thread.
+   */
+  std::string Report() const;
+
+ private:
+  struct ThreadReport {
+    std::string name;
+    int policy = 0;
+    int priority = 0;
+    std::vector<int> cpus;
+  };
+
+  bool LockMemory();
+  ThreadReport GetEffectiveSchedule(pthread_t thread,
+                                    const std::string &name) const;
+
+  SchedulingConfig config_;
+  bool memory_locked_ = false;
+  mutable std::mutex mutex_;
+  std::vector<ThreadReport> reports_;
+
+  DECLARE_SINGLETON(Scheduler);
+};
+
+}  // namespace scheduling
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_SCHEDULING_SCHEDULER_H_
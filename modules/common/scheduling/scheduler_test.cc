@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/scheduling/scheduler.h"
+
+#include <sched.h>
+
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace scheduling {
+
+TEST(SchedulerTest, MakeThreadSchedule) {
+  const auto schedule = MakeThreadSchedule(80, {1, 3});
+  EXPECT_EQ(80, schedule.priority());
+  ASSERT_EQ(2, schedule.cpu_size());
+  EXPECT_EQ(1, schedule.cpu(0));
+  EXPECT_EQ(3, schedule.cpu(1));
+}
+
+TEST(SchedulerTest, ApplyToCurrentThread) {
+  SchedulingConfig config;
+  config.set_prefault_stack_kb(64);
+  auto *worker = config.add_thread();
+  worker->set_name("TestWorker");
+  worker->add_cpu(0);
+  auto *scheduler = Scheduler::instance();
+  scheduler->Init(config);
+  ASSERT_NE(nullptr, scheduler->FindThreadSchedule("TestWorker"));
+  EXPECT_EQ(nullptr, scheduler->FindThreadSchedule("OtherWorker"));
+
+  bool pinned = false;
+  std::thread thread([scheduler, &pinned]() {
+    scheduler->ApplyToCurrentThread("TestWorker");
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    ASSERT_EQ(0, sched_getaffinity(0, sizeof(cpu_set), &cpu_set));
+    pinned = CPU_COUNT(&cpu_set) == 1 && CPU_ISSET(0, &cpu_set);
+  });
+  thread.join();
+  EXPECT_TRUE(pinned);
+  EXPECT_NE(std::string::npos,
+            scheduler->Report().find(
+                "TestWorker: SCHED_OTHER, priority 0, cpus 0"));
+}
+
+TEST(SchedulerTest, ReportUnconfiguredThread) {
+  auto *scheduler = Scheduler::instance();
+  scheduler->Init(SchedulingConfig());
+  std::thread thread(
+      [scheduler]() { scheduler->ApplyToCurrentThread("IdleWorker"); });
+  thread.join();
+  EXPECT_NE(std::string::npos,
+            scheduler->Report().find("IdleWorker: SCHED_OTHER, priority 0"));
+}
+
+}  // namespace scheduling
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/trace/latency_analyzer.h"
+
+namespace apollo {
+namespace common {
+namespace trace {
+
+bool LatencyAnalyzer::Analyze(const Header &header,
+                              TraceLatency *latency) const {
+  latency->Clear();
+  if (!header.has_trace()) {
+    return false;
+  }
+  const auto &trace = header.trace();
+  double last_timestamp_sec = trace.origin_timestamp_sec();
+  for (const auto &upstream : trace.hop()) {
+    auto *hop = latency->add_hop();
+    hop->set_module_name(upstream.module_name());
+    hop->set_latency_ms((upstream.timestamp_sec() - last_timestamp_sec) *
+                        1000);
+    last_timestamp_sec = upstream.timestamp_sec();
+  }
+  auto *hop = latency->add_hop();
+  hop->set_module_name(header.module_name());
+  hop->set_latency_ms((header.timestamp_sec() - last_timestamp_sec) * 1000);
+
+  const double total_ms =
+      (header.timestamp_sec() - trace.origin_timestamp_sec()) * 1000;
+  latency->set_total_ms(total_ms);
+  latency->set_over_budget(budget_ms_ > 0.0 && total_ms > budget_ms_);
+  return true;
+}
+
+}  // namespace trace
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Defines the LatencyAnalyzer class.
+ */
+
+#ifndef MODULES_COMMON_TRACE_LATENCY_ANALYZER_H_
+#define MODULES_COMMON_TRACE_LATENCY_ANALYZER_H_
+
+#include "modules/common/proto/header.pb.h"
+
+/**
+ * @namespace apollo::common::trace
+ * @brief apollo::common::trace
+ */
+namespace apollo {
+namespace common {
+namespace trace {
+
+/**
+ * @class LatencyAnalyzer
+ * @brief Computes the latency of the traced messages along their chain, from
+ * the sensor data, and checks it against a budget.
+ */
+class LatencyAnalyzer {
+ public:
+  /**
+   * @brief constructor
+   * @param budget_ms the budget of the latency from the sensor data to a
+   * message, none if it is not positive
+   */
+  explicit LatencyAnalyzer(const double budget_ms = 0.0)
+      : budget_ms_(budget_ms) {}
+
+  /**
+   * @brief Computes the latency of a message along its trace.
+   * @param header the header of the message, as published
+   * @param latency filled with the latency of the hops and the total one
+   * @return false if the message is not traced
+   */
+  bool Analyze(const Header &header, TraceLatency *latency) const;
+
+  double budget_ms() const { return budget_ms_; }
+
+ private:
+  double budget_ms_ = 0.0;
+};
+
+}  // namespace trace
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_TRACE_LATENCY_ANALYZER_H_
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/trace/latency_analyzer.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/common/trace/trace.h"
+
+namespace apollo {
+namespace common {
+namespace trace {
+
+namespace {
+
+Header MakeHeader(const std::string &module_name, const uint32_t sequence_num,
+                  const double timestamp_sec) {
+  Header header;
+  header.set_module_name(module_name);
+  header.set_sequence_num(sequence_num);
+  header.set_timestamp_sec(timestamp_sec);
+  return header;
+}
+
+}  // namespace
+
+TEST(TraceTest, PropagateTrace) {
+  Header perception = MakeHeader("perception", 3, 100.05);
+  StartTrace("lidar", 100.0, &perception);
+  Header prediction = MakeHeader("prediction", 7, 100.08);
+  PropagateTrace(perception, &prediction);
+
+  const auto &trace = prediction.trace();
+  EXPECT_EQ("lidar", trace.origin_sensor());
+  EXPECT_DOUBLE_EQ(100.0, trace.origin_timestamp_sec());
+  ASSERT_EQ(1, trace.hop_size());
+  EXPECT_EQ("perception", trace.hop(0).module_name());
+  EXPECT_EQ(3, trace.hop(0).sequence_num());
+  EXPECT_DOUBLE_EQ(100.05, trace.hop(0).timestamp_sec());
+
+  // an untraced upstream message clears the former trace
+  PropagateTrace(MakeHeader("perception", 4, 100.15), &prediction);
+  EXPECT_FALSE(prediction.has_trace());
+}
+
+TEST(LatencyAnalyzerTest, Analyze) {
+  Header perception = MakeHeader("perception", 1, 100.05);
+  StartTrace("lidar", 100.0, &perception);
+  Header prediction = MakeHeader("prediction", 1, 100.07);
+  PropagateTrace(perception, &prediction);
+  Header planning = MakeHeader("planning", 1, 100.17);
+  PropagateTrace(prediction, &planning);
+  Header control = MakeHeader("control", 1, 100.18);
+  PropagateTrace(planning, &control);
+
+  TraceLatency latency;
+  EXPECT_TRUE(LatencyAnalyzer(200.0).Analyze(control, &latency));
+  ASSERT_EQ(4, latency.hop_size());
+  EXPECT_EQ("perception", latency.hop(0).module_name());
+  EXPECT_NEAR(50.0, latency.hop(0).latency_ms(), 1e-6);
+  EXPECT_EQ("prediction", latency.hop(1).module_name());
+  EXPECT_NEAR(20.0, latency.hop(1).latency_ms(), 1e-6);
+  EXPECT_EQ("planning", latency.hop(2).module_name());
+  EXPECT_NEAR(100.0, latency.hop(2).latency_ms(), 1e-6);
+  EXPECT_EQ("control", latency.hop(3).module_name());
+  EXPECT_NEAR(10.0, latency.hop(3).latency_ms(), 1e-6);
+  EXPECT_NEAR(180.0, latency.total_ms(), 1e-6);
+  EXPECT_FALSE(latency.over_budget());
+
+  EXPECT_TRUE(LatencyAnalyzer(150.0).Analyze(control, &latency));
+  EXPECT_TRUE(latency.over_budget());
+
+  EXPECT_FALSE(LatencyAnalyzer().Analyze(MakeHeader("control", 2, 100.28),
+                                         &latency));
+  EXPECT_EQ(0, latency.hop_size());
+}
+
+}  // namespace trace
+}  // namespace common
+}  // namespace apollo
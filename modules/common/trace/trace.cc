@@ -0,0 +1,47 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/trace/trace.h"
+
+namespace apollo {
+namespace common {
+namespace trace {
+
+void StartTrace(const std::string &sensor, const double timestamp_sec,
+                Header *header) {
+  auto *trace = header->mutable_trace();
+  trace->Clear();
+  trace->set_origin_sensor(sensor);
+  trace->set_origin_timestamp_sec(timestamp_sec);
+}
+
+void PropagateTrace(const Header &upstream, Header *header) {
+  if (!upstream.has_trace()) {
+    header->clear_trace();
+    return;
+  }
+  auto *trace = header->mutable_trace();
+  *trace = upstream.trace();
+  auto *hop = trace->add_hop();
+  hop->set_module_name(upstream.module_name());
+  hop->set_sequence_num(upstream.sequence_num());
+  hop->set_timestamp_sec(upstream.timestamp_sec());
+}
+
+}  // namespace trace
+}  // namespace common
+}  // namespace apollo
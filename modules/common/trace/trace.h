@@ -0,0 +1,59 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Propagation of the trace of the messages from the sensor data.
+ */
+
+#ifndef MODULES_COMMON_TRACE_TRACE_H_
+#define MODULES_COMMON_TRACE_TRACE_H_
+
+#include <string>
+
+#include "modules/common/proto/header.pb.h"
+
+/**
+ * @namespace apollo::common::trace
+ * @brief apollo::common::trace
+ */
+namespace apollo {
+namespace common {
+namespace trace {
+
+/**
+ * @brief Starts the trace of a message produced from sensor data.
+ * @param sensor the name of the sensor
+ * @param timestamp_sec the capture time of the sensor data in seconds
+ * @param header the header of the message
+ */
+void StartTrace(const std::string &sensor, const double timestamp_sec,
+                Header *header);
+
+/**
+ * @brief Traces a message produced from an upstream one, in place of its
+ * former trace. The message is not traced if the upstream one is not.
+ * @param upstream the header of the upstream message, as published
+ * @param header the header of the message
+ */
+void PropagateTrace(const Header &upstream, Header *header);
+
+}  // namespace trace
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_TRACE_TRACE_H_
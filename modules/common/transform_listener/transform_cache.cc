@@ -0,0 +1,236 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/transform_listener/transform_cache.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "modules/common/log.h"
+#include "modules/common/util/string_tokenizer.h"
+
+namespace apollo {
+namespace common {
+
+using apollo::common::util::StringTokenizer;
+
+TransformCache::TransformCache(const std::vector<FramePair> &frame_pairs,
+                               size_t capacity) {
+  while (capacity_ < capacity) {
+    capacity_ <<= 1;
+  }
+  for (const auto &frame_pair : frame_pairs) {
+    if (FindRing(frame_pair.first, frame_pair.second) != nullptr ||
+        FindRing(frame_pair.second, frame_pair.first) != nullptr) {
+      AWARN << "Duplicated frame pair " << frame_pair.first << ":"
+            << frame_pair.second;
+      continue;
+    }
+    rings_.emplace_back(new Ring(frame_pair, capacity_));
+  }
+}
+
+std::vector<TransformCache::FramePair> TransformCache::ParseFramePairs(
+    const std::string &frame_pairs) {
+  std::vector<FramePair> result;
+  for (const auto &frame_pair : StringTokenizer::Split(frame_pairs, ", ")) {
+    const auto frames = StringTokenizer::Split(frame_pair, ":");
+    if (frames.size() != 2) {
+      AERROR << "Invalid frame pair " << frame_pair;
+      continue;
+    }
+    result.emplace_back(frames[0], frames[1]);
+  }
+  return result;
+}
+
+TransformCache::Ring *TransformCache::FindRing(
+    const std::string &frame_id, const std::string &child_frame_id) const {
+  // There are only a few rings, a scan is faster than hashing the frames.
+  for (const auto &ring : rings_) {
+    if (ring->frame_pair.first == frame_id &&
+        ring->frame_pair.second == child_frame_id) {
+      return ring.get();
+    }
+  }
+  return nullptr;
+}
+
+bool TransformCache::SetTransform(const std::string &frame_id,
+                                  const std::string &child_frame_id,
+                                  const double timestamp,
+                                  const Eigen::Vector3d &translation,
+                                  const Eigen::Quaterniond &rotation,
+                                  const bool is_static) {
+  Ring *ring = FindRing(frame_id, child_frame_id);
+  if (ring == nullptr) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  const uint64_t index = ring->count.load(std::memory_order_relaxed);
+  if (!is_static && index > ring->first.load(std::memory_order_relaxed)) {
+    const Slot &last = ring->slots[(index - 1) & (capacity_ - 1)];
+    if (timestamp < last.values[0].load(std::memory_order_relaxed)) {
+      ADEBUG << "Dropped an old transform from " << child_frame_id << " to "
+             << frame_id;
+      return false;
+    }
+  }
+
+  Slot &slot = ring->slots[index & (capacity_ - 1)];
+  slot.version.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  const double values[8] = {timestamp,       translation.x(),
+                            translation.y(), translation.z(),
+                            rotation.x(),    rotation.y(),
+                            rotation.z(),    rotation.w()};
+  for (int i = 0; i < 8; ++i) {
+    slot.values[i].store(values[i], std::memory_order_relaxed);
+  }
+  slot.version.store(2 * index + 2, std::memory_order_release);
+  ring->count.store(index + 1, std::memory_order_release);
+  if (is_static) {
+    // A static transform holds alone.
+    ring->first.store(index, std::memory_order_release);
+  }
+  ring->is_static.store(is_static, std::memory_order_release);
+  return true;
+}
+
+bool TransformCache::Read(const Ring &ring, const uint64_t index,
+                          Sample *sample) const {
+  const Slot &slot = ring.slots[index & (capacity_ - 1)];
+  const uint64_t version = 2 * index + 2;
+  if (slot.version.load(std::memory_order_acquire) != version) {
+    return false;
+  }
+  double values[8];
+  for (int i = 0; i < 8; ++i) {
+    values[i] = slot.values[i].load(std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slot.version.load(std::memory_order_relaxed) != version) {
+    return false;
+  }
+  sample->timestamp = values[0];
+  sample->translation = Eigen::Vector3d(values[1], values[2], values[3]);
+  sample->rotation =
+      Eigen::Quaterniond(values[7], values[4], values[5], values[6]);
+  return true;
+}
+
+bool TransformCache::Lookup(const Ring &ring, const double timestamp,
+                            Eigen::Affine3d *transform) const {
+  const uint64_t count = ring.count.load(std::memory_order_acquire);
+  uint64_t oldest = ring.first.load(std::memory_order_acquire);
+  if (count <= oldest) {
+    return false;
+  }
+  const uint64_t newest = count - 1;
+  Sample latest;
+  if (!Read(ring, newest, &latest)) {
+    return false;
+  }
+  const bool is_static = ring.is_static.load(std::memory_order_acquire);
+  if (timestamp > latest.timestamp && !is_static) {
+    // No extrapolation, as tf2.
+    return false;
+  }
+  if (is_static || timestamp == 0.0 || timestamp == latest.timestamp) {
+    *transform = Eigen::Translation3d(latest.translation) * latest.rotation;
+    return true;
+  }
+
+  // The oldest transforms may be overwritten meanwhile.
+  if (count > capacity_) {
+    oldest = std::max(oldest, count - capacity_);
+  }
+  Sample before;
+  while (!Read(ring, oldest, &before)) {
+    if (++oldest >= newest) {
+      return false;
+    }
+  }
+  if (timestamp < before.timestamp || oldest >= newest) {
+    return false;
+  }
+
+  // Guesses the transform before the time from the mean period, then walks
+  // to it, which takes a step or two on transforms of a steady rate.
+  uint64_t index = oldest;
+  const double period = (latest.timestamp - before.timestamp) /
+                        static_cast<double>(newest - oldest);
+  if (period > 0.0) {
+    const double offset = std::floor((timestamp - before.timestamp) / period);
+    index += std::min(static_cast<uint64_t>(std::max(offset, 0.0)),
+                      newest - oldest - 1);
+    if (index != oldest && !Read(ring, index, &before)) {
+      return false;
+    }
+  }
+  while (before.timestamp > timestamp && index > oldest) {
+    if (!Read(ring, --index, &before)) {
+      return false;
+    }
+  }
+  Sample after;
+  if (!Read(ring, index + 1, &after)) {
+    return false;
+  }
+  while (after.timestamp < timestamp && index + 1 < newest) {
+    before = after;
+    if (!Read(ring, ++index + 1, &after)) {
+      return false;
+    }
+  }
+
+  const double span = after.timestamp - before.timestamp;
+  const double ratio = span > 0.0 ? (timestamp - before.timestamp) / span : 0.0;
+  *transform = Eigen::Translation3d(before.translation +
+                                    ratio * (after.translation -
+                                             before.translation)) *
+               before.rotation.slerp(ratio, after.rotation);
+  return true;
+}
+
+bool TransformCache::LookupTransform(const std::string &frame_id,
+                                     const std::string &child_frame_id,
+                                     const double timestamp,
+                                     Eigen::Affine3d *transform) const {
+  CHECK_NOTNULL(transform);
+  const Ring *ring = FindRing(frame_id, child_frame_id);
+  if (ring != nullptr) {
+    return Lookup(*ring, timestamp, transform);
+  }
+  ring = FindRing(child_frame_id, frame_id);
+  if (ring != nullptr && Lookup(*ring, timestamp, transform)) {
+    *transform = transform->inverse(Eigen::Isometry);
+    return true;
+  }
+  return false;
+}
+
+void TransformCache::Clear() {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  for (auto &ring : rings_) {
+    ring->first.store(ring->count.load(std::memory_order_relaxed),
+                      std::memory_order_release);
+    ring->is_static.store(false, std::memory_order_release);
+  }
+}
+
+}  // namespace common
+}  // namespace apollo
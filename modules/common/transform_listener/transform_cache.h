@@ -0,0 +1,166 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Defines the TransformCache class.
+ */
+
+#ifndef MODULES_COMMON_TRANSFORM_LISTENER_TRANSFORM_CACHE_H_
+#define MODULES_COMMON_TRANSFORM_LISTENER_TRANSFORM_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Eigen/Geometry"
+
+/**
+ * @namespace apollo::common
+ * @brief apollo::common
+ */
+namespace apollo {
+namespace common {
+
+/**
+ * @class TransformCache
+ *
+ * @brief Keeps the recent transforms of a few frame pairs, as the
+ * novatel to world and the lidar to novatel ones, for lookups which take no
+ * lock and do not walk the tf2 tree.
+ *
+ * The transforms of each frame pair are kept in a ring indexed by time.
+ * A lookup guesses the position of its time from the rate of the
+ * transforms, which is O(1) for transforms of a steady rate, and
+ * interpolates between the transforms around it, as tf2 does. Each slot of
+ * a ring has a version, written before and after the slot, so that a
+ * lookup detects and skips the slots being overwritten instead of locking
+ * out the writer.
+ */
+class TransformCache {
+ public:
+  using FramePair = std::pair<std::string, std::string>;
+
+  /**
+   * @brief Constructor.
+   * @param frame_pairs The (frame_id, child_frame_id) pairs to cache the
+   * transforms of.
+   * @param capacity The number of transforms kept for each pair, rounded up
+   * to a power of two.
+   */
+  explicit TransformCache(const std::vector<FramePair> &frame_pairs,
+                          size_t capacity = 1024);
+
+  /**
+   * @brief Parses frame pairs written as "frame_id:child_frame_id,...".
+   * @param frame_pairs The frame pairs as a string.
+   * @return The frame pairs, without the malformed ones.
+   */
+  static std::vector<FramePair> ParseFramePairs(const std::string &frame_pairs);
+
+  /**
+   * @brief Stores a transform, if its frame pair is cached. A static
+   * transform replaces the previous ones and holds at any time. The
+   * transforms of a pair are expected in time order, an older one is
+   * dropped.
+   * @param frame_id The frame the transform maps into.
+   * @param child_frame_id The frame the transform maps from.
+   * @param timestamp The time of the transform, in seconds.
+   * @param translation The translation of the transform.
+   * @param rotation The rotation of the transform.
+   * @param is_static Whether the transform does not change.
+   * @return False if the transform is not stored.
+   */
+  bool SetTransform(const std::string &frame_id,
+                    const std::string &child_frame_id, const double timestamp,
+                    const Eigen::Vector3d &translation,
+                    const Eigen::Quaterniond &rotation, const bool is_static);
+
+  /**
+   * @brief Looks up the transform from child_frame_id into frame_id at a
+   * time, interpolated between the transforms around it. The transform of
+   * a cached pair is also looked up in the reverse direction.
+   * @param frame_id The frame the transform maps into.
+   * @param child_frame_id The frame the transform maps from.
+   * @param timestamp The time, in seconds, or zero for the latest transform.
+   * @param transform The transform.
+   * @return False if the pair is not cached or the time is not in the
+   * cached range.
+   */
+  bool LookupTransform(const std::string &frame_id,
+                       const std::string &child_frame_id,
+                       const double timestamp,
+                       Eigen::Affine3d *transform) const;
+
+  /**
+   * @brief Drops all the transforms, as on a jump back in time.
+   */
+  void Clear();
+
+ private:
+  struct Slot {
+    // 2 * (index of the write) + 1 while the slot is written, and + 2 once
+    // it is.
+    std::atomic<uint64_t> version{0};
+    // timestamp, translation, then rotation as x, y, z, w.
+    std::atomic<double> values[8];
+  };
+
+  struct Sample {
+    double timestamp = 0.0;
+    Eigen::Vector3d translation;
+    Eigen::Quaterniond rotation;
+  };
+
+  struct Ring {
+    Ring(const FramePair &frame_pair, const size_t capacity)
+        : frame_pair(frame_pair), slots(new Slot[capacity]) {}
+
+    FramePair frame_pair;
+    std::unique_ptr<Slot[]> slots;
+    // The number of writes, and the index of the first one since the last
+    // Clear().
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> first{0};
+    std::atomic<bool> is_static{false};
+  };
+
+  // Reads the sample of a write, false if the write is overwritten or not
+  // complete.
+  bool Read(const Ring &ring, const uint64_t index, Sample *sample) const;
+
+  bool Lookup(const Ring &ring, const double timestamp,
+              Eigen::Affine3d *transform) const;
+
+  Ring *FindRing(const std::string &frame_id,
+                 const std::string &child_frame_id) const;
+
+  size_t capacity_ = 1;
+  // The rings are created by the constructor, so that the lookups need no
+  // lock to find them.
+  std::vector<std::unique_ptr<Ring>> rings_;
+  // Serializes the writers, the readers take no lock.
+  std::mutex write_mutex_;
+};
+
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_TRANSFORM_LISTENER_TRANSFORM_CACHE_H_
@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/transform_listener/transform_cache.h"
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+
+namespace {
+
+Eigen::Quaterniond Yaw(const double yaw) {
+  return Eigen::Quaterniond(Eigen::AngleAxisd(yaw, Eigen::Vector3d::UnitZ()));
+}
+
+}  // namespace
+
+TEST(TransformCacheTest, ParseFramePairs) {
+  const auto frame_pairs =
+      TransformCache::ParseFramePairs("world:novatel, novatel:velodyne64,bad");
+  ASSERT_EQ(2, frame_pairs.size());
+  EXPECT_EQ("world", frame_pairs[0].first);
+  EXPECT_EQ("novatel", frame_pairs[0].second);
+  EXPECT_EQ("novatel", frame_pairs[1].first);
+  EXPECT_EQ("velodyne64", frame_pairs[1].second);
+}
+
+TEST(TransformCacheTest, Interpolate) {
+  TransformCache cache({{"world", "novatel"}}, 8);
+  Eigen::Affine3d transform;
+  EXPECT_FALSE(cache.LookupTransform("world", "novatel", 0.0, &transform));
+  EXPECT_FALSE(cache.SetTransform("world", "velodyne64", 1.0,
+                                  Eigen::Vector3d::Zero(), Yaw(0.0), false));
+
+  // Twenty transforms, of which the ring keeps the last eight.
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_TRUE(cache.SetTransform("world", "novatel", 0.1 * i,
+                                   Eigen::Vector3d(i, 2.0 * i, 0.0),
+                                   Yaw(0.05 * i), false));
+  }
+  EXPECT_FALSE(cache.SetTransform("world", "novatel", 1.0,
+                                  Eigen::Vector3d::Zero(), Yaw(0.0), false));
+
+  ASSERT_TRUE(cache.LookupTransform("world", "novatel", 0.0, &transform));
+  EXPECT_NEAR(19.0, transform.translation().x(), 1e-9);
+
+  ASSERT_TRUE(cache.LookupTransform("world", "novatel", 1.55, &transform));
+  EXPECT_NEAR(15.5, transform.translation().x(), 1e-9);
+  EXPECT_NEAR(31.0, transform.translation().y(), 1e-9);
+  EXPECT_NEAR(0.775, Eigen::AngleAxisd(transform.rotation()).angle(), 1e-9);
+
+  ASSERT_TRUE(cache.LookupTransform("world", "novatel", 1.21, &transform));
+  EXPECT_NEAR(12.1, transform.translation().x(), 1e-9);
+
+  // The transforms older than the ring and newer than the latest one.
+  EXPECT_FALSE(cache.LookupTransform("world", "novatel", 1.1, &transform));
+  EXPECT_FALSE(cache.LookupTransform("world", "novatel", 2.0, &transform));
+
+  // The reverse transform.
+  ASSERT_TRUE(cache.LookupTransform("novatel", "world", 1.55, &transform));
+  const Eigen::Vector3d origin = transform * Eigen::Vector3d(15.5, 31.0, 0.0);
+  EXPECT_NEAR(0.0, origin.norm(), 1e-9);
+  EXPECT_FALSE(cache.LookupTransform("novatel", "radar", 1.55, &transform));
+
+  cache.Clear();
+  EXPECT_FALSE(cache.LookupTransform("world", "novatel", 0.0, &transform));
+  ASSERT_TRUE(cache.SetTransform("world", "novatel", 0.0,
+                                 Eigen::Vector3d::Zero(), Yaw(0.0), false));
+  EXPECT_TRUE(cache.LookupTransform("world", "novatel", 0.0, &transform));
+}
+
+TEST(TransformCacheTest, IrregularRate) {
+  TransformCache cache({{"world", "novatel"}}, 16);
+  const double timestamps[] = {0.0, 0.01, 0.02, 0.5, 0.51, 0.52, 2.0, 2.01};
+  for (const double timestamp : timestamps) {
+    ASSERT_TRUE(cache.SetTransform("world", "novatel", timestamp,
+                                   Eigen::Vector3d(timestamp, 0.0, 0.0),
+                                   Yaw(0.0), false));
+  }
+  Eigen::Affine3d transform;
+  for (const double timestamp : {0.005, 0.3, 0.515, 1.0, 2.005}) {
+    ASSERT_TRUE(
+        cache.LookupTransform("world", "novatel", timestamp, &transform));
+    EXPECT_NEAR(timestamp, transform.translation().x(), 1e-9);
+  }
+}
+
+TEST(TransformCacheTest, StaticTransform) {
+  TransformCache cache({{"novatel", "velodyne64"}}, 4);
+  ASSERT_TRUE(cache.SetTransform("novatel", "velodyne64", 5.0,
+                                 Eigen::Vector3d(1.0, 0.0, 0.0), Yaw(0.0),
+                                 true));
+  Eigen::Affine3d transform;
+  for (const double timestamp : {0.0, 1.0, 10.0}) {
+    ASSERT_TRUE(cache.LookupTransform("novatel", "velodyne64", timestamp,
+                                      &transform));
+    EXPECT_NEAR(1.0, transform.translation().x(), 1e-9);
+  }
+}
+
+TEST(TransformCacheTest, ConcurrentLookups) {
+  TransformCache cache({{"world", "novatel"}}, 64);
+  std::atomic<bool> done(false);
+  // The translation and the rotation of a transform are written apart, a
+  // torn read would not match them.
+  std::thread writer([&cache, &done]() {
+    for (int i = 0; i < 100000; ++i) {
+      cache.SetTransform("world", "novatel", 0.01 * i,
+                         Eigen::Vector3d(0.01 * i, 0.0, 0.0),
+                         Yaw(std::fmod(0.01 * i, 1.0)), false);
+    }
+    done = true;
+  });
+  int num_lookups = 0;
+  while (!done) {
+    Eigen::Affine3d transform;
+    if (!cache.LookupTransform("world", "novatel", 0.0, &transform)) {
+      continue;
+    }
+    const double time = transform.translation().x();
+    EXPECT_NEAR(std::fmod(time, 1.0),
+                Eigen::AngleAxisd(transform.rotation()).angle(), 1e-6);
+    ++num_lookups;
+  }
+  writer.join();
+  EXPECT_LT(0, num_lookups);
+}
+
+}  // namespace common
+}  // namespace apollo
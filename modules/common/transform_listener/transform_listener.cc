@@ -29,9 +29,11 @@ using tf2_msgs::TFMessage;
 using std::placeholders::_1;
 
 TransformListener::TransformListener(tf2::BufferCore* buffer,
-                                     ros::NodeHandle* nh, bool spin_thread)
+                                     ros::NodeHandle* nh, bool spin_thread,
+                                     TransformCache* cache)
     : node_(nh),
       buffer_(buffer),
+      cache_(cache),
       using_dedicated_thread_(spin_thread),
       last_update_(0.0) {
   if (node_ == nullptr) {
@@ -94,6 +96,9 @@ void TransformListener::CallbackImpl(const tf2_msgs::TFMessage::ConstPtr& tf,
   if (now < last_update_) {
     AWARN << "Detected jump back in time. Clearing TF buffer.";
     buffer_->clear();
+    if (cache_ != nullptr) {
+      cache_->Clear();
+    }
   }
   last_update_ = now;
   for (size_t i = 0; i < tf->transforms.size(); i++) {
@@ -105,6 +110,17 @@ void TransformListener::CallbackImpl(const tf2_msgs::TFMessage::ConstPtr& tf,
              << tf->transforms[i].header.frame_id
              << " with error: " << ex.what();
     }
+    if (cache_ != nullptr) {
+      const auto& transform = tf->transforms[i];
+      const auto& translation = transform.transform.translation;
+      const auto& rotation = transform.transform.rotation;
+      cache_->SetTransform(
+          transform.header.frame_id, transform.child_frame_id,
+          transform.header.stamp.toSec(),
+          Eigen::Vector3d(translation.x, translation.y, translation.z),
+          Eigen::Quaterniond(rotation.w, rotation.x, rotation.y, rotation.z),
+          is_static);
+    }
   }
 }
 
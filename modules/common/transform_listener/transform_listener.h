@@ -25,6 +25,8 @@
 #include "ros/include/tf2_msgs/TFMessage.h"
 #include "ros/include/tf2_ros/buffer.h"
 
+#include "modules/common/transform_listener/transform_cache.h"
+
 /**
  * @namespace apollo::common
  * @brief apollo::common
@@ -34,8 +36,17 @@ namespace common {
 
 class TransformListener {
  public:
+  /**
+   * @brief Constructor.
+   * @param buffer The buffer to fill with the received transforms.
+   * @param nh The node handle to subscribe with.
+   * @param spin_thread Whether to receive the transforms on a thread of the
+   * listener.
+   * @param cache The cache to fill with the received transforms of its frame
+   * pairs too, if any. Not owned.
+   */
   TransformListener(tf2::BufferCore* buffer, ros::NodeHandle* nh,
-                    bool spin_thread = true);
+                    bool spin_thread = true, TransformCache* cache = nullptr);
 
   ~TransformListener();
 
@@ -57,6 +68,7 @@ class TransformListener {
   ros::Subscriber tf_subscriber_;
   ros::Subscriber tf_static_subscriber_;
   tf2::BufferCore* buffer_;
+  TransformCache* cache_;  // Doesn't own TransformCache
   bool using_dedicated_thread_;
   double last_update_;
 
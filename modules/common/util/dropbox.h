@@ -22,6 +22,7 @@
 #ifndef MODULES_COMMON_UTIL_DROPBOX_H_
 #define MODULES_COMMON_UTIL_DROPBOX_H_
 
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -36,11 +37,20 @@ using KeyType = std::string;
 
 /**
  * @brief Dropbox class is a map based key-value storage container utility.
+ *
+ * \par
+ * Getting, setting and removing values is thread safe. The pointers
+ * returned by Get() stay valid until the value is removed, but reading
+ * through them races with a Set() of the same key on another thread, so
+ * the code which may run concurrently, as the traffic rules of the
+ * reference lines planned in parallel, copies the value with Get(key,
+ * value) instead.
  */
 template <class T>
 class Dropbox {
  public:
   const T* Get(const KeyType& key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
     auto iter = _store.find(key);
     if (iter == _store.end()) {
       return nullptr;
@@ -50,6 +60,7 @@ class Dropbox {
   }
 
   T* Get(const KeyType& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
     auto iter = _store.find(key);
     if (iter == _store.end()) {
       return nullptr;
@@ -58,9 +69,30 @@ class Dropbox {
     }
   }
 
-  void Set(const KeyType& key, const T& t) { _store[key] = t; }
+  /**
+   * @brief Copies the value of the key.
+   * @return false if there is no value for the key, in which case value is
+   * not changed.
+   */
+  bool Get(const KeyType& key, T* value) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = _store.find(key);
+    if (iter == _store.end()) {
+      return false;
+    }
+    *value = iter->second;
+    return true;
+  }
+
+  void Set(const KeyType& key, const T& t) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    _store[key] = t;
+  }
 
-  void Remove(const KeyType& key) { _store.erase(key); }
+  void Remove(const KeyType& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    _store.erase(key);
+  }
 
   static Dropbox<T>* Open() {
     static Dropbox<T> _static_store;
@@ -69,6 +101,7 @@ class Dropbox {
 
  private:
   std::unordered_map<KeyType, T> _store;
+  mutable std::mutex mutex_;
   Dropbox<T>() {}
   Dropbox<T>(const Dropbox& other) = delete;
 };
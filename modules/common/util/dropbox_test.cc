@@ -21,6 +21,10 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "modules/common/util/dropbox.h"
 
 namespace apollo {
@@ -81,6 +85,47 @@ TEST(Dropbox, case_vector_int) {
   Dropbox<std::vector<int>>::Open()->Remove("a");
 }
 
+TEST(Dropbox, case_copy) {
+  std::vector<int> value{5};
+  EXPECT_FALSE(Dropbox<std::vector<int>>::Open()->Get("copy", &value));
+  EXPECT_EQ(std::vector<int>{5}, value);
+  Dropbox<std::vector<int>>::Open()->Set("copy", {1, 2});
+  EXPECT_TRUE(Dropbox<std::vector<int>>::Open()->Get("copy", &value));
+  EXPECT_EQ((std::vector<int>{1, 2}), value);
+  Dropbox<std::vector<int>>::Open()->Remove("copy");
+}
+
+TEST(Dropbox, case_concurrent) {
+  constexpr int kNumThreads = 4;
+  constexpr int kNumValues = 1000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([i]() {
+      auto* dropbox = Dropbox<std::vector<int>>::Open();
+      std::vector<int> value;
+      for (int j = 0; j < kNumValues; ++j) {
+        dropbox->Set("shared", std::vector<int>(j % 10, i));
+        dropbox->Set("thread_" + std::to_string(i) + "_" + std::to_string(j),
+                     {j});
+        if (dropbox->Get("shared", &value)) {
+          EXPECT_LT(value.size(), 10);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int i = 0; i < kNumThreads; ++i) {
+    for (int j = 0; j < kNumValues; ++j) {
+      const auto* value = Dropbox<std::vector<int>>::Open()->Get(
+          "thread_" + std::to_string(i) + "_" + std::to_string(j));
+      ASSERT_NE(nullptr, value);
+      EXPECT_EQ(std::vector<int>{j}, *value);
+    }
+  }
+}
+
 }  // namespace util
 }  // namespace common
 }  // namespace apollo
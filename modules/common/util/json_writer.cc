@@ -0,0 +1,463 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/util/json_writer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/util/json_util.h"
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+namespace {
+
+using google::protobuf::Descriptor;
+using google::protobuf::FieldDescriptor;
+using google::protobuf::Reflection;
+
+void AppendEscaped(const std::string &value, std::string *json) {
+  static const char kHex[] = "0123456789abcdef";
+  json->push_back('"');
+  // The runs of characters which need no escaping are appended at once.
+  size_t run_begin = 0;
+  for (size_t i = 0; i < value.size(); ++i) {
+    const char c = value[i];
+    if (c != '"' && c != '\\' && static_cast<unsigned char>(c) >= 0x20) {
+      continue;
+    }
+    json->append(value, run_begin, i - run_begin);
+    run_begin = i + 1;
+    switch (c) {
+      case '"':
+        json->append("\\\"");
+        break;
+      case '\\':
+        json->append("\\\\");
+        break;
+      case '\b':
+        json->append("\\b");
+        break;
+      case '\f':
+        json->append("\\f");
+        break;
+      case '\n':
+        json->append("\\n");
+        break;
+      case '\r':
+        json->append("\\r");
+        break;
+      case '\t':
+        json->append("\\t");
+        break;
+      default:
+        json->append("\\u00");
+        json->push_back(kHex[(c >> 4) & 0xf]);
+        json->push_back(kHex[c & 0xf]);
+    }
+  }
+  json->append(value, run_begin, value.size() - run_begin);
+  json->push_back('"');
+}
+
+void AppendBase64(const std::string &value, std::string *json) {
+  static const char kChars[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  json->push_back('"');
+  size_t i = 0;
+  for (; i + 2 < value.size(); i += 3) {
+    const uint32_t bits = (static_cast<uint8_t>(value[i]) << 16) |
+                          (static_cast<uint8_t>(value[i + 1]) << 8) |
+                          static_cast<uint8_t>(value[i + 2]);
+    json->push_back(kChars[(bits >> 18) & 0x3f]);
+    json->push_back(kChars[(bits >> 12) & 0x3f]);
+    json->push_back(kChars[(bits >> 6) & 0x3f]);
+    json->push_back(kChars[bits & 0x3f]);
+  }
+  if (i < value.size()) {
+    const bool two = i + 1 < value.size();
+    const uint32_t bits =
+        (static_cast<uint8_t>(value[i]) << 16) |
+        (two ? static_cast<uint8_t>(value[i + 1]) << 8 : 0);
+    json->push_back(kChars[(bits >> 18) & 0x3f]);
+    json->push_back(kChars[(bits >> 12) & 0x3f]);
+    json->push_back(two ? kChars[(bits >> 6) & 0x3f] : '=');
+    json->push_back('=');
+  }
+  json->push_back('"');
+}
+
+// Writes NaN and the infinities as strings, as protobuf does.
+template <typename T>
+bool AppendNonFinite(const T value, std::string *json) {
+  if (std::isnan(value)) {
+    json->append("\"NaN\"");
+  } else if (std::isinf(value)) {
+    json->append(value > 0 ? "\"Infinity\"" : "\"-Infinity\"");
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Appends the decimal digits of an integer, without allocation.
+void AppendUint(uint64_t value, std::string *json) {
+  char buffer[20];
+  int size = 0;
+  do {
+    buffer[size++] = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  while (size > 0) {
+    json->push_back(buffer[--size]);
+  }
+}
+
+void AppendInt(const int64_t value, std::string *json) {
+  if (value < 0) {
+    json->push_back('-');
+    // Also right for the min int64.
+    AppendUint(0 - static_cast<uint64_t>(value), json);
+  } else {
+    AppendUint(static_cast<uint64_t>(value), json);
+  }
+}
+
+// Appends a double with at most 15 significant digits in the fixed notation
+// of %.15g, which is then the same, if it has such digits which give it
+// back, e.g. 0.1 but not 1.0 / 3.0. A quotient of doubles being rounded
+// correctly, as strtod is, the digits give the double back if their quotient
+// by the power of ten does.
+bool AppendShortDouble(const double value, std::string *json) {
+  static const double kPowersOf10[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,
+      1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19};
+  const double magnitude = std::abs(value);
+  if (!(magnitude >= 1e-4 && magnitude < 1e15)) {
+    return false;
+  }
+  for (int decimals = 0; decimals < 20; ++decimals) {
+    const double scaled = magnitude * kPowersOf10[decimals];
+    if (scaled >= 1e15) {
+      return false;
+    }
+    const double digits = std::round(scaled);
+    if (digits / kPowersOf10[decimals] != magnitude) {
+      continue;
+    }
+    // The digits from the last one, with the point and a zero before it if
+    // below 1.
+    char buffer[24];
+    int size = 0;
+    uint64_t rest = static_cast<uint64_t>(digits);
+    for (int i = 0; i <= decimals || rest != 0; ++i) {
+      if (i == decimals && decimals > 0) {
+        buffer[size++] = '.';
+      }
+      buffer[size++] = static_cast<char>('0' + rest % 10);
+      rest /= 10;
+    }
+    if (value < 0) {
+      json->push_back('-');
+    }
+    while (size > 0) {
+      json->push_back(buffer[--size]);
+    }
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+JsonWriter::JsonWriter(std::string *json, bool always_print_primitive_fields)
+    : json_(json),
+      always_print_primitive_fields_(always_print_primitive_fields) {
+  CHECK_NOTNULL(json_);
+}
+
+void JsonWriter::BeforeValue() {
+  if (after_key_) {
+    after_key_ = false;
+    return;
+  }
+  if (!has_value_.empty()) {
+    if (has_value_.back()) {
+      json_->push_back(',');
+    }
+    has_value_.back() = true;
+  }
+}
+
+void JsonWriter::BeginObject() {
+  BeforeValue();
+  json_->push_back('{');
+  has_value_.push_back(false);
+}
+
+void JsonWriter::EndObject() {
+  has_value_.pop_back();
+  json_->push_back('}');
+}
+
+void JsonWriter::BeginArray() {
+  BeforeValue();
+  json_->push_back('[');
+  has_value_.push_back(false);
+}
+
+void JsonWriter::EndArray() {
+  has_value_.pop_back();
+  json_->push_back(']');
+}
+
+void JsonWriter::Key(const std::string &key) {
+  BeforeValue();
+  AppendEscaped(key, json_);
+  json_->push_back(':');
+  after_key_ = true;
+}
+
+void JsonWriter::String(const std::string &value) {
+  BeforeValue();
+  AppendEscaped(value, json_);
+}
+
+void JsonWriter::Bool(const bool value) {
+  BeforeValue();
+  json_->append(value ? "true" : "false");
+}
+
+void JsonWriter::Int(const int64_t value) {
+  BeforeValue();
+  AppendInt(value, json_);
+}
+
+void JsonWriter::Uint(const uint64_t value) {
+  BeforeValue();
+  AppendUint(value, json_);
+}
+
+void JsonWriter::Double(const double value) {
+  BeforeValue();
+  if (AppendNonFinite(value, json_) || AppendShortDouble(value, json_)) {
+    return;
+  }
+  // The fewest digits which give the double back, as protobuf's SimpleDtoa,
+  // out of the range or the digits of AppendShortDouble.
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.15g", value);
+  if (std::strtod(buffer, nullptr) != value) {
+    snprintf(buffer, sizeof(buffer), "%.17g", value);
+  }
+  json_->append(buffer);
+}
+
+void JsonWriter::Float(const float value) {
+  BeforeValue();
+  if (AppendNonFinite(value, json_)) {
+    return;
+  }
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.6g", value);
+  if (std::strtof(buffer, nullptr) != value) {
+    snprintf(buffer, sizeof(buffer), "%.9g", value);
+  }
+  json_->append(buffer);
+}
+
+void JsonWriter::StringArray(const std::vector<std::string> &values) {
+  BeginArray();
+  for (const auto &value : values) {
+    String(value);
+  }
+  EndArray();
+}
+
+void JsonWriter::Raw(const std::string &json) {
+  BeforeValue();
+  json_->append(json);
+}
+
+void JsonWriter::Message(const google::protobuf::Message &message) {
+  const Descriptor *descriptor = message.GetDescriptor();
+  const Reflection *reflection = message.GetReflection();
+  BeginObject();
+  if (always_print_primitive_fields_) {
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+      const FieldDescriptor *field = descriptor->field(i);
+      if (field->is_repeated() || reflection->HasField(message, field) ||
+          (field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE &&
+           field->containing_oneof() == nullptr)) {
+        Field(message, field);
+      }
+    }
+  } else {
+    std::vector<const FieldDescriptor *> fields;
+    reflection->ListFields(message, &fields);
+    for (const FieldDescriptor *field : fields) {
+      Field(message, field);
+    }
+  }
+  EndObject();
+}
+
+void JsonWriter::Field(const google::protobuf::Message &message,
+                       const FieldDescriptor *field) {
+  const Reflection *reflection = message.GetReflection();
+  // The names of the fields need no escaping.
+  BeforeValue();
+  json_->push_back('"');
+  json_->append(field->json_name());
+  json_->append("\":");
+  after_key_ = true;
+  if (field->is_map()) {
+    const FieldDescriptor *key_field = field->message_type()->field(0);
+    const FieldDescriptor *value_field = field->message_type()->field(1);
+    BeginObject();
+    for (int i = 0; i < reflection->FieldSize(message, field); ++i) {
+      const auto &entry = reflection->GetRepeatedMessage(message, field, i);
+      const Reflection *entry_reflection = entry.GetReflection();
+      // The keys are strings in json whatever their types.
+      std::string key;
+      switch (key_field->cpp_type()) {
+        case FieldDescriptor::CPPTYPE_STRING:
+          key = entry_reflection->GetString(entry, key_field);
+          break;
+        case FieldDescriptor::CPPTYPE_BOOL:
+          key = entry_reflection->GetBool(entry, key_field) ? "true" : "false";
+          break;
+        default: {
+          std::string number;
+          JsonWriter key_writer(&number);
+          key_writer.FieldValue(entry, key_field, -1);
+          // The 64-bit integers are quoted already.
+          key = number.front() == '"' ? number.substr(1, number.size() - 2)
+                                      : number;
+        }
+      }
+      Key(key);
+      FieldValue(entry, value_field, -1);
+    }
+    EndObject();
+  } else if (field->is_repeated()) {
+    BeginArray();
+    for (int i = 0; i < reflection->FieldSize(message, field); ++i) {
+      FieldValue(message, field, i);
+    }
+    EndArray();
+  } else {
+    FieldValue(message, field, -1);
+  }
+}
+
+void JsonWriter::FieldValue(const google::protobuf::Message &message,
+                            const FieldDescriptor *field, const int index) {
+  const Reflection *reflection = message.GetReflection();
+  const bool repeated = index >= 0;
+  switch (field->cpp_type()) {
+    case FieldDescriptor::CPPTYPE_INT32:
+      Int(repeated ? reflection->GetRepeatedInt32(message, field, index)
+                   : reflection->GetInt32(message, field));
+      break;
+    case FieldDescriptor::CPPTYPE_UINT32:
+      Uint(repeated ? reflection->GetRepeatedUInt32(message, field, index)
+                    : reflection->GetUInt32(message, field));
+      break;
+    case FieldDescriptor::CPPTYPE_INT64:
+      // Quoted as they may not fit in the doubles of javascript.
+      BeforeValue();
+      json_->push_back('"');
+      AppendInt(repeated ? reflection->GetRepeatedInt64(message, field, index)
+                         : reflection->GetInt64(message, field),
+                json_);
+      json_->push_back('"');
+      break;
+    case FieldDescriptor::CPPTYPE_UINT64:
+      BeforeValue();
+      json_->push_back('"');
+      AppendUint(repeated ? reflection->GetRepeatedUInt64(message, field, index)
+                          : reflection->GetUInt64(message, field),
+                 json_);
+      json_->push_back('"');
+      break;
+    case FieldDescriptor::CPPTYPE_DOUBLE:
+      Double(repeated ? reflection->GetRepeatedDouble(message, field, index)
+                      : reflection->GetDouble(message, field));
+      break;
+    case FieldDescriptor::CPPTYPE_FLOAT:
+      Float(repeated ? reflection->GetRepeatedFloat(message, field, index)
+                     : reflection->GetFloat(message, field));
+      break;
+    case FieldDescriptor::CPPTYPE_BOOL:
+      Bool(repeated ? reflection->GetRepeatedBool(message, field, index)
+                    : reflection->GetBool(message, field));
+      break;
+    case FieldDescriptor::CPPTYPE_ENUM:
+      String((repeated ? reflection->GetRepeatedEnum(message, field, index)
+                       : reflection->GetEnum(message, field))
+                 ->name());
+      break;
+    case FieldDescriptor::CPPTYPE_STRING: {
+      std::string scratch;
+      const std::string &value =
+          repeated ? reflection->GetRepeatedStringReference(message, field,
+                                                            index, &scratch)
+                   : reflection->GetStringReference(message, field, &scratch);
+      BeforeValue();
+      if (field->type() == FieldDescriptor::TYPE_BYTES) {
+        AppendBase64(value, json_);
+      } else {
+        AppendEscaped(value, json_);
+      }
+      break;
+    }
+    case FieldDescriptor::CPPTYPE_MESSAGE: {
+      const auto &value =
+          repeated ? reflection->GetRepeatedMessage(message, field, index)
+                   : reflection->GetMessage(message, field);
+      // The well known types have json forms of their own.
+      if (value.GetDescriptor()->file()->package() == "google.protobuf") {
+        std::string json;
+        google::protobuf::util::JsonOptions options;
+        options.always_print_primitive_fields = always_print_primitive_fields_;
+        google::protobuf::util::MessageToJsonString(value, &json, options);
+        Raw(json);
+      } else {
+        Message(value);
+      }
+      break;
+    }
+  }
+}
+
+void JsonWriter::MessageToJson(const google::protobuf::Message &message,
+                               std::string *json,
+                               const bool always_print_primitive_fields) {
+  json->clear();
+  JsonWriter writer(json, always_print_primitive_fields);
+  writer.Message(message);
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief A json writer which streams protos and values into a string,
+ * without building a json document first.
+ */
+
+#ifndef MODULES_COMMON_UTIL_JSON_WRITER_H_
+#define MODULES_COMMON_UTIL_JSON_WRITER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "google/protobuf/message.h"
+
+/**
+ * @namespace apollo::common::util
+ * @brief apollo::common::util
+ */
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class JsonWriter
+ * @brief Appends json to a string, which is owned by the caller so that its
+ * memory is reused from one json to the next. The protos are written as
+ * google::protobuf::util::MessageToJsonString does, with the lowerCamelCase
+ * names of their fields, the 64-bit integers as strings, and the enums by
+ * name.
+ *
+ * The values are written one after the other, inside objects and arrays
+ * which are opened and closed by the caller; each value of an object goes
+ * after a Key.
+ */
+class JsonWriter {
+ public:
+  /**
+   * @param json the string the json is appended to, which must outlive the
+   * writer
+   * @param always_print_primitive_fields whether the unset singular fields
+   * of the protos are written, with their default values, along with their
+   * empty repeated fields, as with JsonOptions::always_print_primitive_fields
+   */
+  explicit JsonWriter(std::string *json,
+                      bool always_print_primitive_fields = false);
+
+  void BeginObject();
+  void EndObject();
+  void BeginArray();
+  void EndArray();
+
+  /**
+   * @brief Writes the key of the next value of the current object.
+   */
+  void Key(const std::string &key);
+
+  void String(const std::string &value);
+  void Bool(bool value);
+  void Int(int64_t value);
+  void Uint(uint64_t value);
+  /**
+   * @brief Writes a double with up to 17 significant digits, as few as give
+   * the double back, or "NaN", "Infinity" or "-Infinity".
+   */
+  void Double(double value);
+  void Float(float value);
+  void StringArray(const std::vector<std::string> &values);
+
+  /**
+   * @brief Writes a proto as a json object.
+   */
+  void Message(const google::protobuf::Message &message);
+
+  /**
+   * @brief Writes a value which is json already.
+   */
+  void Raw(const std::string &json);
+
+  /**
+   * @brief Replaces the json with that of a proto.
+   */
+  static void MessageToJson(const google::protobuf::Message &message,
+                            std::string *json,
+                            bool always_print_primitive_fields = false);
+
+ private:
+  // Writes the comma before a value which is not the first one of its object
+  // or array, or nothing after a key.
+  void BeforeValue();
+
+  void Field(const google::protobuf::Message &message,
+             const google::protobuf::FieldDescriptor *field);
+  void FieldValue(const google::protobuf::Message &message,
+                  const google::protobuf::FieldDescriptor *field, int index);
+
+  std::string *json_;
+  const bool always_print_primitive_fields_;
+  // Whether the current object or array has a value already, for each one
+  // which is open.
+  std::vector<bool> has_value_;
+  bool after_key_ = false;
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_UTIL_JSON_WRITER_H_
@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/util/json_writer.h"
+
+#include <limits>
+#include <string>
+
+#include "google/protobuf/util/json_util.h"
+#include "gtest/gtest.h"
+#include "third_party/json/json.hpp"
+
+#include "modules/common/proto/header.pb.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+using Json = nlohmann::json;
+
+namespace {
+
+Header MakeHeader() {
+  Header header;
+  header.set_timestamp_sec(1513807824.581);
+  header.set_module_name("planning \"main\"\n");
+  header.set_sequence_num(42);
+  header.set_lidar_timestamp(1513807824581000000);
+  header.mutable_status()->set_error_code(ErrorCode::PLANNING_ERROR);
+  auto *trace = header.mutable_trace();
+  trace->set_origin_sensor("velodyne64");
+  for (int i = 0; i < 3; ++i) {
+    auto *hop = trace->add_hop();
+    hop->set_module_name("hop");
+    hop->set_sequence_num(i);
+    hop->set_timestamp_sec(0.1 * i);
+  }
+  return header;
+}
+
+Json ProtobufJson(const google::protobuf::Message &message,
+                  bool always_print_primitive_fields) {
+  google::protobuf::util::JsonOptions options;
+  options.always_print_primitive_fields = always_print_primitive_fields;
+  std::string json;
+  google::protobuf::util::MessageToJsonString(message, &json, options);
+  return Json::parse(json);
+}
+
+}  // namespace
+
+TEST(JsonWriterTest, MessageAsProtobuf) {
+  const Header header = MakeHeader();
+  std::string json = "not cleared";
+  JsonWriter::MessageToJson(header, &json);
+  EXPECT_EQ(ProtobufJson(header, false), Json::parse(json));
+  EXPECT_EQ("1513807824581000000", Json::parse(json)["lidarTimestamp"]);
+  EXPECT_EQ("PLANNING_ERROR", Json::parse(json)["status"]["errorCode"]);
+
+  JsonWriter::MessageToJson(header, &json, true);
+  EXPECT_EQ(ProtobufJson(header, true), Json::parse(json));
+
+  JsonWriter::MessageToJson(Header(), &json);
+  EXPECT_EQ("{}", json);
+  JsonWriter::MessageToJson(Header(), &json, true);
+  EXPECT_EQ(ProtobufJson(Header(), true), Json::parse(json));
+}
+
+TEST(JsonWriterTest, Values) {
+  std::string json;
+  JsonWriter writer(&json);
+  writer.BeginObject();
+  writer.Key("type");
+  writer.String("a\tb\x01");
+  writer.Key("numbers");
+  writer.BeginArray();
+  writer.Int(-3);
+  writer.Uint(4);
+  writer.Double(0.1);
+  writer.Double(1.0 / 3.0);
+  writer.Double(2.0);
+  writer.Float(0.1f);
+  writer.Double(std::numeric_limits<double>::quiet_NaN());
+  writer.Double(-std::numeric_limits<double>::infinity());
+  writer.EndArray();
+  writer.Key("ids");
+  writer.StringArray({"1", "2"});
+  writer.Key("empty");
+  writer.StringArray({});
+  writer.Key("raw");
+  writer.Raw("{\"x\":1}");
+  writer.Key("flag");
+  writer.Bool(false);
+  writer.EndObject();
+  EXPECT_EQ(
+      "{\"type\":\"a\\tb\\u0001\",\"numbers\":[-3,4,0.1,0.33333333333333331,"
+      "2,0.1,\"NaN\",\"-Infinity\"],\"ids\":[\"1\",\"2\"],\"empty\":[],"
+      "\"raw\":{\"x\":1},\"flag\":false}",
+      json);
+  EXPECT_EQ("a\tb\x01", Json::parse(json)["type"]);
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,147 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief A single-slot mailbox in which the latest message wins.
+ */
+
+#ifndef MODULES_COMMON_UTIL_LATEST_MAILBOX_H_
+#define MODULES_COMMON_UTIL_LATEST_MAILBOX_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+/**
+ * @namespace apollo::common::util
+ * @brief apollo::common::util
+ */
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class LatestMailbox
+ * @brief Hands messages from producers over to a consumer thread, keeping
+ * only the latest one: a message put before the previous one was taken
+ * replaces it, and the replaced message is counted as dropped. A slow
+ * consumer therefore always gets the freshest message instead of working
+ * through a backlog.
+ *
+ * \par
+ * All the methods are thread safe.
+ */
+template <typename T>
+class LatestMailbox {
+ public:
+  /**
+   * @brief Put a message into the mailbox, replacing the one not taken yet.
+   * Does nothing once the mailbox is closed.
+   * @param message The message.
+   */
+  void Put(T message) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (closed_) {
+        return;
+      }
+      if (has_message_) {
+        ++num_dropped_;
+      }
+      message_ = std::move(message);
+      has_message_ = true;
+      ++num_put_;
+    }
+    condition_.notify_one();
+  }
+
+  /**
+   * @brief Wait for a message and take it out of the mailbox.
+   * @param message The taken message.
+   * @return False if the mailbox was closed before a message came.
+   */
+  bool Take(T* message) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return has_message_ || closed_; });
+    return TakeLocked(message);
+  }
+
+  /**
+   * @brief Take the message out of the mailbox, without waiting.
+   * @param message The taken message.
+   * @return False if the mailbox holds no message.
+   */
+  bool TryTake(T* message) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return TakeLocked(message);
+  }
+
+  /**
+   * @brief Close the mailbox: the message not taken yet is discarded, and
+   * the consumers waiting in Take() return.
+   */
+  void Close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+      has_message_ = false;
+    }
+    condition_.notify_all();
+  }
+
+  /**
+   * @brief Get the number of messages put into the mailbox.
+   */
+  std::uint64_t num_put() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_put_;
+  }
+
+  /**
+   * @brief Get the number of messages replaced before they were taken.
+   */
+  std::uint64_t num_dropped() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_dropped_;
+  }
+
+ private:
+  bool TakeLocked(T* message) {
+    if (!has_message_) {
+      return false;
+    }
+    *message = std::move(message_);
+    has_message_ = false;
+    return true;
+  }
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  T message_;
+  bool has_message_ = false;
+  bool closed_ = false;
+  std::uint64_t num_put_ = 0;
+  std::uint64_t num_dropped_ = 0;
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_UTIL_LATEST_MAILBOX_H_
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/util/latest_mailbox.h"
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(LatestMailbox, LatestWins) {
+  LatestMailbox<int> mailbox;
+  int message = 0;
+  EXPECT_FALSE(mailbox.TryTake(&message));
+
+  mailbox.Put(1);
+  mailbox.Put(2);
+  mailbox.Put(3);
+  EXPECT_TRUE(mailbox.TryTake(&message));
+  EXPECT_EQ(3, message);
+  EXPECT_FALSE(mailbox.TryTake(&message));
+  EXPECT_EQ(3, mailbox.num_put());
+  EXPECT_EQ(2, mailbox.num_dropped());
+
+  mailbox.Put(4);
+  EXPECT_TRUE(mailbox.Take(&message));
+  EXPECT_EQ(4, message);
+  EXPECT_EQ(2, mailbox.num_dropped());
+}
+
+TEST(LatestMailbox, Close) {
+  LatestMailbox<int> mailbox;
+  mailbox.Put(1);
+  mailbox.Close();
+  int message = 0;
+  EXPECT_FALSE(mailbox.Take(&message));
+  mailbox.Put(2);
+  EXPECT_FALSE(mailbox.TryTake(&message));
+  EXPECT_EQ(1, mailbox.num_put());
+}
+
+TEST(LatestMailbox, Consumer) {
+  LatestMailbox<int> mailbox;
+  std::atomic<int> last_message(0);
+  int num_taken = 0;
+  std::thread consumer([&] {
+    int message = 0;
+    while (mailbox.Take(&message)) {
+      // The messages are taken in order, some of them skipped.
+      EXPECT_LT(last_message.load(), message);
+      last_message = message;
+      ++num_taken;
+    }
+  });
+  for (int i = 1; i <= 1000; ++i) {
+    mailbox.Put(i);
+  }
+  while (last_message < 1000) {
+    std::this_thread::yield();
+  }
+  mailbox.Close();
+  consumer.join();
+  EXPECT_EQ(1000, last_message.load());
+  EXPECT_EQ(1000, mailbox.num_put());
+  EXPECT_EQ(1000 - num_taken, mailbox.num_dropped());
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
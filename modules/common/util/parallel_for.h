@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief Defines ParallelFor, which runs the iterations of a loop on several
+ * threads.
+ */
+
+#ifndef MODULES_COMMON_UTIL_PARALLEL_FOR_H_
+#define MODULES_COMMON_UTIL_PARALLEL_FOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @brief Calls func(i) for every i in [0, size) on up to num_threads threads,
+ * including the calling thread, and returns when all the calls are done.
+ * The iterations are handed out one by one, so iterations of uneven cost are
+ * balanced over the threads.
+ * @param size The number of iterations.
+ * @param num_threads The maximum number of threads; 0 or less means the
+ * number of hardware threads.
+ * @param func The body of the loop. It is called concurrently.
+ */
+inline void ParallelFor(const int size, int num_threads,
+                        const std::function<void(int)>& func) {
+  if (num_threads <= 0) {
+    num_threads = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  num_threads = std::max(1, std::min(size, num_threads));
+  std::atomic<int> next(0);
+  const auto worker = [size, &next, &func]() {
+    for (int i = next++; i < size; i = next++) {
+      func(i);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int t = 1; t < num_threads; ++t) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_UTIL_PARALLEL_FOR_H_
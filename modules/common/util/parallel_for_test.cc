@@ -0,0 +1,50 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/parallel_for.h"
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(ParallelForTest, CallsEveryIterationOnce) {
+  for (const int num_threads : {0, 1, 4, 100}) {
+    std::vector<std::atomic<int>> counts(1000);
+    for (auto& count : counts) {
+      count = 0;
+    }
+    ParallelFor(static_cast<int>(counts.size()), num_threads,
+                [&counts](const int i) { ++counts[i]; });
+    for (const auto& count : counts) {
+      EXPECT_EQ(1, count);
+    }
+  }
+}
+
+TEST(ParallelForTest, Empty) {
+  int num_calls = 0;
+  ParallelFor(0, 4, [&num_calls](const int) { ++num_calls; });
+  EXPECT_EQ(0, num_calls);
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
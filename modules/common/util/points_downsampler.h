@@ -22,6 +22,7 @@
 #define MODULES_COMMON_UTIL_POINTS_DOWNSAMPLER_H_
 
 #include <cmath>
+#include <utility>
 #include <vector>
 
 #include "modules/common/log.h"
@@ -163,6 +164,85 @@ std::vector<int> DownsampleByDistance(const Points &points,
   return sampled_indices;
 }
 
+/**
+ * @brief Downsample the points on the path by the Douglas-Peucker algorithm,
+ * which keeps the points farthest from the simplified path until all the
+ * dropped points are close enough to it.
+ * @param points Points on the path.
+ * @param tolerance The max distance from a dropped point to the segment of
+ * the sampled points around it.
+ * @return sampled_indices Indices of all sampled points, or empty when fail.
+ */
+template <typename Points>
+std::vector<int> DownsampleByDouglasPeucker(const Points &points,
+                                            const double tolerance) {
+  std::vector<int> sampled_indices;
+  if (tolerance < 0.0) {
+    AERROR << "Input tolerance is negative.";
+    return sampled_indices;
+  }
+  if (points.size() <= 2) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      sampled_indices.push_back(i);
+    }
+    return sampled_indices;
+  }
+
+  using apollo::common::math::Vec2d;
+  std::vector<bool> sampled(points.size(), false);
+  sampled.front() = true;
+  sampled.back() = true;
+  // The ranges of points still to be simplified, handled without recursion
+  // as a path may have thousands of points.
+  std::vector<std::pair<size_t, size_t>> ranges;
+  ranges.emplace_back(0, points.size() - 1);
+  while (!ranges.empty()) {
+    const size_t start = ranges.back().first;
+    const size_t end = ranges.back().second;
+    ranges.pop_back();
+    if (end - start < 2) {
+      continue;
+    }
+
+    const Vec2d start_point(points[start].x(), points[start].y());
+    const Vec2d segment =
+        Vec2d(points[end].x(), points[end].y()) - start_point;
+    const double length = segment.Length();
+    double max_distance = -1.0;
+    size_t max_index = start;
+    for (size_t i = start + 1; i < end; ++i) {
+      const Vec2d vec = Vec2d(points[i].x(), points[i].y()) - start_point;
+      double distance = 0.0;
+      const double proj = length > 0.0 ? vec.InnerProd(segment) / length : 0.0;
+      if (proj <= 0.0) {
+        distance = vec.Length();
+      } else if (proj >= length) {
+        distance = vec.DistanceTo(segment);
+      } else {
+        distance = std::fabs(vec.CrossProd(segment)) / length;
+      }
+      if (distance > max_distance) {
+        max_distance = distance;
+        max_index = i;
+      }
+    }
+    if (max_distance > tolerance) {
+      sampled[max_index] = true;
+      ranges.emplace_back(start, max_index);
+      ranges.emplace_back(max_index, end);
+    }
+  }
+
+  for (size_t i = 0; i < points.size(); ++i) {
+    if (sampled[i]) {
+      sampled_indices.push_back(i);
+    }
+  }
+  ADEBUG << "Point Vector is downsampled from " << points.size() << " to "
+         << sampled_indices.size();
+  return sampled_indices;
+}
+
 }  // namespace util
 }  // namespace common
 }  // namespace apollo
@@ -83,6 +83,32 @@ TEST(DownSamplerTest, DownsampleByDistanceSteepTurn) {
   EXPECT_EQ(4, sampled_indices[4]);
 }
 
+TEST(DownSamplerTest, DownsampleByDouglasPeucker) {
+  std::vector<Vec2d> points;
+  // A straight line with noise, a corner, then a line back.
+  points.emplace_back(0, 0);
+  points.emplace_back(1, 0.05);
+  points.emplace_back(2, -0.05);
+  points.emplace_back(3, 0);
+  points.emplace_back(4, 1);
+  points.emplace_back(5, 2.02);
+  points.emplace_back(6, 3);
+
+  std::vector<int> sampled_indices = DownsampleByDouglasPeucker(points, 0.1);
+  EXPECT_EQ(3, sampled_indices.size());
+  EXPECT_EQ(0, sampled_indices[0]);
+  EXPECT_EQ(3, sampled_indices[1]);
+  EXPECT_EQ(6, sampled_indices[2]);
+
+  // All the points are kept with no tolerance.
+  EXPECT_EQ(7, DownsampleByDouglasPeucker(points, 0.0).size());
+  EXPECT_TRUE(DownsampleByDouglasPeucker(points, -1.0).empty());
+
+  points.resize(2);
+  sampled_indices = DownsampleByDouglasPeucker(points, 10.0);
+  EXPECT_EQ(2, sampled_indices.size());
+}
+
 }  // namespace util
 }  // namespace common
 }  // namespace apollo
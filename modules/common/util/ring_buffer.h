@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A fixed-capacity ring buffer that reuses its elements.
+ */
+
+#ifndef MODULES_COMMON_UTIL_RING_BUFFER_H_
+#define MODULES_COMMON_UTIL_RING_BUFFER_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "modules/common/log.h"
+
+/**
+ * @namespace apollo::common::util
+ * @brief apollo::common::util
+ */
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class RingBuffer
+ * @brief A history of at most capacity() elements, the newest at the front.
+ *
+ * \par
+ * The elements are never destroyed before the buffer: pushing an element
+ * reuses the slot of one that was dropped, so that elements owning memory,
+ * e.g. protobuf messages, keep it from push to push. A new element is
+ * written in place in next_front(), then pushed with PushFront(); the slot
+ * is not an element of the buffer in between, so the elements stay valid
+ * while it is written.
+ */
+template <typename T>
+class RingBuffer {
+ public:
+  explicit RingBuffer(const std::size_t capacity) : capacity_(capacity) {
+    CHECK_GT(capacity, 0);
+  }
+
+  std::size_t capacity() const { return capacity_; }
+
+  std::size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+  /**
+   * @brief the i-th newest element.
+   */
+  const T& operator[](const std::size_t i) const {
+    DCHECK_LT(i, size_);
+    return slots_[SlotIndex(i)];
+  }
+
+  T& operator[](const std::size_t i) {
+    DCHECK_LT(i, size_);
+    return slots_[SlotIndex(i)];
+  }
+
+  const T& front() const { return (*this)[0]; }
+
+  T& front() { return (*this)[0]; }
+
+  const T& back() const { return (*this)[size_ - 1]; }
+
+  T& back() { return (*this)[size_ - 1]; }
+
+  /**
+   * @brief the slot of the next element, with the value left by its last
+   * use, or a default constructed one.
+   */
+  T* next_front() {
+    if (next_ == slots_.size()) {
+      // The slots are created on demand, up to one more than the capacity
+      // so that the next slot of a full buffer is not one of its elements.
+      slots_.reserve(capacity_ + 1);
+      slots_.emplace_back();
+    }
+    return &slots_[next_];
+  }
+
+  /**
+   * @brief makes next_front() the newest element, and drops the oldest one
+   * if the buffer is full.
+   */
+  void PushFront() {
+    next_front();
+    next_ = (next_ + 1) % (capacity_ + 1);
+    if (size_ < capacity_) {
+      ++size_;
+    }
+  }
+
+  /**
+   * @brief drops the oldest element. Its slot is kept for reuse.
+   */
+  void PopBack() {
+    DCHECK_GT(size_, 0);
+    --size_;
+  }
+
+  /**
+   * @brief drops all the elements. Their slots are kept for reuse.
+   */
+  void Clear() { size_ = 0; }
+
+ private:
+  // Until all the slots exist, the elements are the slots before next_,
+  // which are never wrapped.
+  std::size_t SlotIndex(const std::size_t i) const {
+    return (next_ + slots_.size() - 1 - i) % slots_.size();
+  }
+
+  std::size_t capacity_ = 0;
+  std::vector<T> slots_;
+  // The slot of the next element.
+  std::size_t next_ = 0;
+  std::size_t size_ = 0;
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_UTIL_RING_BUFFER_H_
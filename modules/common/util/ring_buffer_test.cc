@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/common/util/ring_buffer.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(RingBuffer, PushAndPop) {
+  RingBuffer<int> buffer(3);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(3, buffer.capacity());
+  for (int i = 0; i < 5; ++i) {
+    *buffer.next_front() = i;
+    buffer.PushFront();
+    EXPECT_EQ(i, buffer.front());
+  }
+  ASSERT_EQ(3, buffer.size());
+  EXPECT_EQ(4, buffer[0]);
+  EXPECT_EQ(3, buffer[1]);
+  EXPECT_EQ(2, buffer[2]);
+  EXPECT_EQ(2, buffer.back());
+
+  buffer.PopBack();
+  ASSERT_EQ(2, buffer.size());
+  EXPECT_EQ(3, buffer.back());
+  *buffer.next_front() = 5;
+  buffer.PushFront();
+  EXPECT_EQ(5, buffer[0]);
+  EXPECT_EQ(4, buffer[1]);
+  EXPECT_EQ(3, buffer[2]);
+
+  buffer.Clear();
+  EXPECT_TRUE(buffer.empty());
+  *buffer.next_front() = 6;
+  buffer.PushFront();
+  ASSERT_EQ(1, buffer.size());
+  EXPECT_EQ(6, buffer.front());
+}
+
+TEST(RingBuffer, ReuseSlots) {
+  RingBuffer<std::string> buffer(2);
+  // The next slot is not an element, even when the buffer is full.
+  for (int i = 0; i < 4; ++i) {
+    std::string* next = buffer.next_front();
+    for (std::size_t j = 0; j < buffer.size(); ++j) {
+      EXPECT_NE(next, &buffer[j]);
+    }
+    *next = std::string(100, 'a' + i);
+    buffer.PushFront();
+  }
+  // A slot keeps its value, and its memory, until it is written again.
+  std::string* next = buffer.next_front();
+  EXPECT_EQ(std::string(100, 'b'), *next);
+  const char* data = next->data();
+  next->assign(50, 'e');
+  EXPECT_EQ(data, next->data());
+  buffer.PushFront();
+  EXPECT_EQ(std::string(50, 'e'), buffer[0]);
+  EXPECT_EQ(std::string(100, 'd'), buffer[1]);
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,372 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief A thread-safe LRU cache sharded by key hash, with no allocation
+ * once constructed.
+ */
+
+#ifndef MODULES_COMMON_UTIL_SHARDED_LRU_CACHE_H_
+#define MODULES_COMMON_UTIL_SHARDED_LRU_CACHE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "modules/common/log.h"
+
+/**
+ * @namespace apollo::common::util
+ * @brief apollo::common::util
+ */
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class ShardedLRUCache
+ * @brief A cache of at most capacity() entries, which are evicted
+ * least recently used first, shared by threads.
+ *
+ * \par
+ * The keys are split by hash into shards of their own lock, LRU list and
+ * capacity, so that threads on different keys rarely wait on each other. An
+ * entry is evicted as the least recently used of its shard. Every shard
+ * preallocates its nodes and an open addressing index of the nodes, so a
+ * put does not allocate; an evicted node is reused with its key and value,
+ * which keep their memory. K and V must be default constructible and
+ * assignable.
+ *
+ * \par
+ * A value is copied out of the cache under the lock of its shard, so it
+ * stays valid whatever the other threads do.
+ */
+template <class K, class V, class Hash = std::hash<K>>
+class ShardedLRUCache {
+ public:
+  /**
+   * @brief the counters of the cache since its construction or the last
+   * ResetStats().
+   */
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+  };
+
+  /**
+   * @param capacity the number of entries. It is split evenly over the
+   * shards, rounded up, so the cache may hold a few more.
+   * @param shard_num the number of shards, at most the capacity.
+   */
+  explicit ShardedLRUCache(const std::size_t capacity,
+                           const std::size_t shard_num = kDefaultShardNum) {
+    CHECK_GT(capacity, 0);
+    CHECK_GT(shard_num, 0);
+    CHECK_LT(capacity, static_cast<std::size_t>(kNone));
+    const std::size_t num = std::min(shard_num, capacity);
+    const std::size_t shard_capacity = (capacity + num - 1) / num;
+    for (std::size_t i = 0; i < num; ++i) {
+      shards_.emplace_back(new Shard(shard_capacity));
+    }
+  }
+
+  std::size_t capacity() const {
+    return shards_.size() * shards_[0]->nodes.size();
+  }
+
+  std::size_t shard_num() const { return shards_.size(); }
+
+  std::size_t size() const {
+    std::size_t size = 0;
+    for (const auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      size += shard->size;
+    }
+    return size;
+  }
+
+  /**
+   * @brief copies the value of a key into val and makes the entry the most
+   * recently used one.
+   * @return false on a miss, when val is left unchanged.
+   */
+  bool Get(const K& key, V* val) { return Get(key, val, false); }
+
+  /**
+   * @brief like Get(), without touching the recency of the entry nor the
+   * counters.
+   */
+  bool GetSilently(const K& key, V* val) { return Get(key, val, true); }
+
+  bool Contains(const K& key) const {
+    const uint64_t hash = HashOf(key);
+    const Shard& shard = ShardOf(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.Find(key, hash) != kNone;
+  }
+
+  /**
+   * @brief adds a key or updates its value, and makes the entry the most
+   * recently used one. A new key evicts the least recently used entry of a
+   * full shard.
+   */
+  template <typename VV>
+  void Put(const K& key, VV&& val) {
+    const uint64_t hash = HashOf(key);
+    Shard& shard = ShardOf(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    uint32_t node = shard.Find(key, hash);
+    if (node == kNone) {
+      if (shard.free == kNone) {
+        shard.Remove(shard.tail);
+        ++shard.stats.evictions;
+      }
+      node = shard.free;
+      shard.free = shard.nodes[node].next;
+      shard.nodes[node].key = key;
+      shard.nodes[node].hash = hash;
+      shard.Insert(node);
+    } else {
+      shard.Detach(node);
+    }
+    shard.nodes[node].val = std::forward<VV>(val);
+    shard.AttachFront(node);
+  }
+
+  /**
+   * @return false if the key is not in the cache.
+   */
+  bool Erase(const K& key) {
+    const uint64_t hash = HashOf(key);
+    Shard& shard = ShardOf(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const uint32_t node = shard.Find(key, hash);
+    if (node == kNone) {
+      return false;
+    }
+    shard.Remove(node);
+    return true;
+  }
+
+  /**
+   * @brief drops all the entries. The nodes keep their keys and values until
+   * they are reused.
+   */
+  void Clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->Reset();
+    }
+  }
+
+  Stats GetStats() const {
+    Stats stats;
+    for (const auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      stats.hits += shard->stats.hits;
+      stats.misses += shard->stats.misses;
+      stats.evictions += shard->stats.evictions;
+    }
+    return stats;
+  }
+
+  void ResetStats() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard->mutex);
+      shard->stats = Stats();
+    }
+  }
+
+ private:
+  static constexpr std::size_t kDefaultShardNum = 16;
+  static constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+
+  struct Node {
+    K key{};
+    V val{};
+    uint64_t hash = 0;
+    uint32_t prev = kNone;
+    uint32_t next = kNone;
+  };
+
+  /**
+   * @brief the entries of a shard: the nodes in a LRU list, the free nodes
+   * in a list through next, and a linear probing index of the nodes in use
+   * over twice as many slots.
+   */
+  struct Shard {
+    explicit Shard(const std::size_t capacity) : nodes(capacity) {
+      std::size_t slot_num = 1;
+      while (slot_num < 2 * capacity) {
+        slot_num <<= 1;
+      }
+      slots.resize(slot_num);
+      Reset();
+    }
+
+    void Reset() {
+      for (std::size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].prev = kNone;
+        nodes[i].next = i + 1 < nodes.size() ? static_cast<uint32_t>(i + 1)
+                                             : kNone;
+      }
+      free = 0;
+      head = kNone;
+      tail = kNone;
+      size = 0;
+      std::fill(slots.begin(), slots.end(), kNone);
+    }
+
+    std::size_t HomeSlot(const uint64_t hash) const {
+      return static_cast<std::size_t>(hash) & (slots.size() - 1);
+    }
+
+    std::size_t FindSlot(const K& key, const uint64_t hash) const {
+      for (std::size_t i = HomeSlot(hash);; i = (i + 1) & (slots.size() - 1)) {
+        const uint32_t node = slots[i];
+        if (node == kNone ||
+            (nodes[node].hash == hash && nodes[node].key == key)) {
+          return i;
+        }
+      }
+    }
+
+    uint32_t Find(const K& key, const uint64_t hash) const {
+      return slots[FindSlot(key, hash)];
+    }
+
+    void Insert(const uint32_t node) {
+      slots[FindSlot(nodes[node].key, nodes[node].hash)] = node;
+      ++size;
+    }
+
+    /**
+     * @brief removes a node in use from the index and the LRU list, and
+     * frees it. The entries probed past its slot are shifted back, so that
+     * the index needs no tombstone.
+     */
+    void Remove(const uint32_t node) {
+      const std::size_t mask = slots.size() - 1;
+      std::size_t hole = FindSlot(nodes[node].key, nodes[node].hash);
+      for (std::size_t i = (hole + 1) & mask; slots[i] != kNone;
+           i = (i + 1) & mask) {
+        const std::size_t home = HomeSlot(nodes[slots[i]].hash);
+        // the entry stays if its home slot is cyclically in (hole, i]
+        const bool stays =
+            hole < i ? (hole < home && home <= i) : (hole < home || home <= i);
+        if (!stays) {
+          slots[hole] = slots[i];
+          hole = i;
+        }
+      }
+      slots[hole] = kNone;
+      --size;
+      Detach(node);
+      nodes[node].next = free;
+      free = node;
+    }
+
+    void Detach(const uint32_t node) {
+      Node& n = nodes[node];
+      (n.prev == kNone ? head : nodes[n.prev].next) = n.next;
+      (n.next == kNone ? tail : nodes[n.next].prev) = n.prev;
+      n.prev = kNone;
+      n.next = kNone;
+    }
+
+    void AttachFront(const uint32_t node) {
+      nodes[node].prev = kNone;
+      nodes[node].next = head;
+      (head == kNone ? tail : nodes[head].prev) = node;
+      head = node;
+    }
+
+    mutable std::mutex mutex;
+    std::vector<Node> nodes;
+    std::vector<uint32_t> slots;
+    uint32_t free = kNone;
+    /// the most and the least recently used nodes
+    uint32_t head = kNone;
+    uint32_t tail = kNone;
+    std::size_t size = 0;
+    Stats stats;
+  };
+
+  bool Get(const K& key, V* val, const bool silent) {
+    const uint64_t hash = HashOf(key);
+    Shard& shard = ShardOf(hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const uint32_t node = shard.Find(key, hash);
+    if (node == kNone) {
+      if (!silent) {
+        ++shard.stats.misses;
+      }
+      return false;
+    }
+    if (!silent) {
+      ++shard.stats.hits;
+      shard.Detach(node);
+      shard.AttachFront(node);
+    }
+    *val = shard.nodes[node].val;
+    return true;
+  }
+
+  /**
+   * @brief the hash of a key, mixed so that the shard and the slot, taken
+   * from different bits, are both spread even for an identity hash.
+   */
+  static uint64_t HashOf(const K& key) {
+    uint64_t hash = static_cast<uint64_t>(Hash()(key));
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+
+  Shard& ShardOf(const uint64_t hash) {
+    return *shards_[static_cast<std::size_t>(hash >> 32) % shards_.size()];
+  }
+
+  const Shard& ShardOf(const uint64_t hash) const {
+    return *shards_[static_cast<std::size_t>(hash >> 32) % shards_.size()];
+  }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+template <class K, class V, class Hash>
+constexpr std::size_t ShardedLRUCache<K, V, Hash>::kDefaultShardNum;
+
+template <class K, class V, class Hash>
+constexpr uint32_t ShardedLRUCache<K, V, Hash>::kNone;
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_UTIL_SHARDED_LRU_CACHE_H_
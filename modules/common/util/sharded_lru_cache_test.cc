@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/util/sharded_lru_cache.h"
+
+#include <cstdlib>
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(ShardedLRUCacheTest, EvictsTheLeastRecentlyUsed) {
+  ShardedLRUCache<int, std::string> cache(3, 1);
+  EXPECT_EQ(3, cache.capacity());
+  EXPECT_EQ(1, cache.shard_num());
+  cache.Put(1, "a");
+  cache.Put(2, "b");
+  cache.Put(3, "c");
+  std::string val;
+  EXPECT_TRUE(cache.Get(1, &val));
+  EXPECT_EQ("a", val);
+  // 2 is the least recently used
+  cache.Put(4, "d");
+  EXPECT_EQ(3, cache.size());
+  EXPECT_FALSE(cache.Contains(2));
+  EXPECT_FALSE(cache.Get(2, &val));
+  EXPECT_EQ("a", val);
+  // an update makes the entry the most recently used
+  cache.Put(3, "cc");
+  cache.Put(5, "e");
+  EXPECT_FALSE(cache.Contains(1));
+  EXPECT_TRUE(cache.GetSilently(3, &val));
+  EXPECT_EQ("cc", val);
+
+  const auto stats = cache.GetStats();
+  EXPECT_EQ(1, stats.hits);
+  EXPECT_EQ(1, stats.misses);
+  EXPECT_EQ(2, stats.evictions);
+  cache.ResetStats();
+  EXPECT_EQ(0, cache.GetStats().hits);
+
+  EXPECT_TRUE(cache.Erase(4));
+  EXPECT_FALSE(cache.Erase(4));
+  EXPECT_EQ(2, cache.size());
+  cache.Clear();
+  EXPECT_EQ(0, cache.size());
+  EXPECT_FALSE(cache.Contains(3));
+  cache.Put(6, "f");
+  EXPECT_TRUE(cache.Get(6, &val));
+  EXPECT_EQ("f", val);
+}
+
+TEST(ShardedLRUCacheTest, SplitsTheCapacity) {
+  ShardedLRUCache<int, int> cache(10, 4);
+  EXPECT_EQ(4, cache.shard_num());
+  EXPECT_EQ(12, cache.capacity());
+  ShardedLRUCache<int, int> small_cache(2, 16);
+  EXPECT_EQ(2, small_cache.shard_num());
+  EXPECT_EQ(2, small_cache.capacity());
+}
+
+// the cache in one shard behaves as a plain LRU list, through many removals
+// shifting the entries of the index
+TEST(ShardedLRUCacheTest, MatchesAReferenceList) {
+  srand(5);
+  ShardedLRUCache<int, int> cache(16, 1);
+  std::list<std::pair<int, int>> reference;
+  for (int i = 0; i < 20000; ++i) {
+    const int key = rand() % 40;
+    auto it = reference.begin();
+    while (it != reference.end() && it->first != key) {
+      ++it;
+    }
+    int val = -1;
+    switch (rand() % 3) {
+      case 0:
+        cache.Put(key, i);
+        if (it != reference.end()) {
+          reference.erase(it);
+        } else if (reference.size() == 16) {
+          reference.pop_back();
+        }
+        reference.emplace_front(key, i);
+        break;
+      case 1:
+        ASSERT_EQ(it != reference.end(), cache.Get(key, &val));
+        if (it != reference.end()) {
+          ASSERT_EQ(it->second, val);
+          reference.splice(reference.begin(), reference, it);
+        }
+        break;
+      default:
+        ASSERT_EQ(it != reference.end(), cache.Erase(key));
+        if (it != reference.end()) {
+          reference.erase(it);
+        }
+        break;
+    }
+    ASSERT_EQ(reference.size(), cache.size());
+  }
+  for (const auto& entry : reference) {
+    int val = -1;
+    EXPECT_TRUE(cache.GetSilently(entry.first, &val));
+    EXPECT_EQ(entry.second, val);
+  }
+}
+
+TEST(ShardedLRUCacheTest, ConcurrentAccess) {
+  ShardedLRUCache<int, int> cache(256, 8);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < 20000; ++i) {
+        const int key = (i * 7 + t) % 512;
+        int val = 0;
+        if (!cache.Get(key, &val)) {
+          cache.Put(key, key * 2);
+        } else {
+          EXPECT_EQ(key * 2, val);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto stats = cache.GetStats();
+  EXPECT_EQ(80000, stats.hits + stats.misses);
+  EXPECT_LE(cache.size(), cache.capacity());
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
@@ -0,0 +1,246 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#include "modules/common/util/work_stealing_thread_pool.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+namespace {
+
+// The pool and the worker index of the current thread, if it is a worker.
+thread_local const WorkStealingThreadPool* tls_pool = nullptr;
+thread_local int tls_worker_index = -1;
+
+// The number of tasks per thread ParallelFor splits a range into, to
+// balance uneven tasks.
+const size_t kTasksPerThread = 4;
+
+}  // namespace
+
+WorkStealingThreadPool::WorkStealingThreadPool(const int num_threads,
+                                               const std::vector<int>& cpu_ids)
+    : next_worker_(0), num_pending_(0), is_stop_(false) {
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.emplace_back(new Worker());
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    const int cpu_id = cpu_ids.empty() ? -1 : cpu_ids[i % cpu_ids.size()];
+    workers_[i]->thread =
+        std::thread(&WorkStealingThreadPool::WorkerLoop, this, i, cpu_id);
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() { Stop(); }
+
+void WorkStealingThreadPool::Stop() {
+  if (is_stop_.exchange(true)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+  }
+  sleep_cv_.notify_all();
+  for (auto& worker : workers_) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+  }
+}
+
+void WorkStealingThreadPool::Schedule(Task task) {
+  if (workers_.empty() || is_stop_) {
+    task();
+    return;
+  }
+  size_t index = 0;
+  if (tls_pool == this) {
+    index = static_cast<size_t>(tls_worker_index);
+  } else {
+    index = next_worker_.fetch_add(1) % workers_.size();
+  }
+  {
+    Worker* worker = workers_[index].get();
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    worker->tasks.push_back(std::move(task));
+    ++num_pending_;
+  }
+  {
+    // Makes sure a worker about to sleep sees the new task.
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+  }
+  sleep_cv_.notify_one();
+}
+
+bool WorkStealingThreadPool::PopTask(const int index, Task* task) {
+  if (index >= 0) {
+    Worker* worker = workers_[index].get();
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    if (!worker->tasks.empty()) {
+      *task = std::move(worker->tasks.back());
+      worker->tasks.pop_back();
+      --num_pending_;
+      return true;
+    }
+  }
+  const int num_workers = size();
+  const int start = index >= 0 ? index + 1 : 0;
+  for (int i = 0; i < num_workers; ++i) {
+    const int victim_index = (start + i) % num_workers;
+    if (victim_index == index) {
+      continue;
+    }
+    Worker* victim = workers_[victim_index].get();
+    std::lock_guard<std::mutex> lock(victim->mutex);
+    if (!victim->tasks.empty()) {
+      *task = std::move(victim->tasks.front());
+      victim->tasks.pop_front();
+      --num_pending_;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WorkStealingThreadPool::RunPendingTask() {
+  if (num_pending_ <= 0) {
+    return false;
+  }
+  Task task;
+  const int index = tls_pool == this ? tls_worker_index : -1;
+  if (!PopTask(index, &task)) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+void WorkStealingThreadPool::WorkerLoop(const int index, const int cpu_id) {
+  tls_pool = this;
+  tls_worker_index = index;
+  if (cpu_id >= 0) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu_id, &cpu_set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) !=
+        0) {
+      AWARN << "Failed to pin worker " << index << " to cpu " << cpu_id;
+    }
+  }
+  while (true) {
+    Task task;
+    if (PopTask(index, &task)) {
+      task();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    sleep_cv_.wait(lock, [this]() { return is_stop_ || num_pending_ > 0; });
+    if (is_stop_ && num_pending_ <= 0) {
+      return;
+    }
+  }
+}
+
+void WorkStealingThreadPool::ParallelFor(
+    const size_t begin, const size_t end,
+    const std::function<void(size_t)>& func, const size_t grain_size) {
+  if (begin >= end) {
+    return;
+  }
+  const size_t num_indices = end - begin;
+  const size_t max_tasks = workers_.size() * kTasksPerThread;
+  size_t chunk_size = std::max<size_t>(grain_size, 1);
+  if (max_tasks > 0) {
+    chunk_size =
+        std::max(chunk_size, (num_indices + max_tasks - 1) / max_tasks);
+  }
+  if (workers_.empty() || chunk_size >= num_indices) {
+    for (size_t i = begin; i < end; ++i) {
+      func(i);
+    }
+    return;
+  }
+  TaskGroup group(this);
+  for (size_t chunk_begin = begin; chunk_begin < end;
+       chunk_begin += chunk_size) {
+    const size_t chunk_end = std::min(end, chunk_begin + chunk_size);
+    group.Run([&func, chunk_begin, chunk_end]() {
+      for (size_t i = chunk_begin; i < chunk_end; ++i) {
+        func(i);
+      }
+    });
+  }
+  group.Wait();
+}
+
+TaskGroup::TaskGroup(WorkStealingThreadPool* pool)
+    : pool_(pool), num_unfinished_(0) {}
+
+TaskGroup::~TaskGroup() { Wait(); }
+
+void TaskGroup::Run(WorkStealingThreadPool::Task task) {
+  if (pool_ == nullptr) {
+    task();
+    return;
+  }
+  ++num_unfinished_;
+  pool_->Schedule([this, task]() {
+    task();
+    OnTaskDone();
+  });
+}
+
+void TaskGroup::OnTaskDone() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (--num_unfinished_ == 0) {
+    cv_.notify_all();
+  }
+}
+
+void TaskGroup::Wait() {
+  while (num_unfinished_ > 0) {
+    if (pool_ != nullptr && pool_->RunPendingTask()) {
+      continue;
+    }
+    // All the tasks are taken. Wake up now and then in case the running
+    // ones fork more work the calling thread could help with.
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait_for(lock, std::chrono::milliseconds(1),
+                 [this]() { return num_unfinished_ <= 0; });
+  }
+  // Makes sure the last task is done with the group before it can be
+  // destroyed.
+  std::lock_guard<std::mutex> lock(mutex_);
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
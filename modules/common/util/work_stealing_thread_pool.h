@@ -0,0 +1,178 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief A work-stealing thread pool with fork/join helpers.
+ */
+
+#ifndef MODULES_COMMON_UTIL_WORK_STEALING_THREAD_POOL_H_
+#define MODULES_COMMON_UTIL_WORK_STEALING_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "modules/common/macro.h"
+
+/**
+ * @namespace apollo::common::util
+ * @brief apollo::common::util
+ */
+namespace apollo {
+namespace common {
+namespace util {
+
+/**
+ * @class WorkStealingThreadPool
+ * @brief A thread pool where every worker owns a task deque. A worker
+ * pops the most recently pushed task of its own deque, and steals the
+ * oldest task of the other deques when its own is empty, so that small
+ * tasks do not serialize on one shared queue.
+ *
+ * \par
+ * Tasks scheduled from a worker go to the deque of that worker, tasks
+ * scheduled from other threads are dealt to the workers round robin.
+ * With zero threads, tasks run inline in the scheduling thread.
+ */
+class WorkStealingThreadPool {
+ public:
+  typedef std::function<void()> Task;
+
+  /**
+   * @brief Constructor.
+   * @param num_threads the number of worker threads.
+   * @param cpu_ids if not empty, worker i is pinned to the cpu
+   * cpu_ids[i % cpu_ids.size()].
+   */
+  explicit WorkStealingThreadPool(
+      const int num_threads,
+      const std::vector<int>& cpu_ids = std::vector<int>());
+
+  /**
+   * @brief Runs all the pending tasks, then joins the workers.
+   */
+  ~WorkStealingThreadPool();
+
+  /**
+   * @brief returns the number of worker threads.
+   */
+  int size() const { return static_cast<int>(workers_.size()); }
+
+  /**
+   * @brief schedules a task to be run by one of the workers.
+   */
+  void Schedule(Task task);
+
+  /**
+   * @brief runs func(i) for every i in [begin, end) and returns when all
+   * of them are done. The calling thread takes part in the work.
+   * @param grain_size the minimum number of indices run by one task.
+   */
+  void ParallelFor(const size_t begin, const size_t end,
+                   const std::function<void(size_t)>& func,
+                   const size_t grain_size = 1);
+
+  /**
+   * @brief runs one pending task in the calling thread.
+   * @return false if there was no pending task.
+   */
+  bool RunPendingTask();
+
+  /**
+   * @brief runs all the pending tasks, then joins the workers. Tasks
+   * scheduled afterwards run inline.
+   */
+  void Stop();
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::thread thread;
+  };
+
+  void WorkerLoop(const int index, const int cpu_id);
+
+  /**
+   * @brief pops a task from the deque of the given worker, or steals one
+   * from the others. A negative index only steals.
+   */
+  bool PopTask(const int index, Task* task);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  std::atomic<size_t> next_worker_;
+
+  /// The number of tasks sitting in the deques.
+  std::atomic<int> num_pending_;
+
+  std::atomic<bool> is_stop_;
+
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingThreadPool);
+};
+
+/**
+ * @class TaskGroup
+ * @brief A set of tasks run by a WorkStealingThreadPool that can be
+ * waited for together (fork/join). Wait() runs pending tasks in the
+ * calling thread, so groups can be nested inside tasks. With a null
+ * pool, the tasks run inline.
+ */
+class TaskGroup {
+ public:
+  explicit TaskGroup(WorkStealingThreadPool* pool);
+
+  /**
+   * @brief waits for the unfinished tasks.
+   */
+  ~TaskGroup();
+
+  /**
+   * @brief schedules a task of the group.
+   */
+  void Run(WorkStealingThreadPool::Task task);
+
+  /**
+   * @brief returns when all the tasks of the group are done.
+   */
+  void Wait();
+
+ private:
+  void OnTaskDone();
+
+  WorkStealingThreadPool* pool_ = nullptr;
+  std::atomic<int> num_unfinished_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskGroup);
+};
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
+
+#endif  // MODULES_COMMON_UTIL_WORK_STEALING_THREAD_POOL_H_
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/common/util/work_stealing_thread_pool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace common {
+namespace util {
+
+TEST(WorkStealingThreadPoolTest, Schedule) {
+  std::atomic<int> n(0);
+  {
+    WorkStealingThreadPool pool(4);
+    EXPECT_EQ(4, pool.size());
+    for (int i = 0; i < 1000; ++i) {
+      pool.Schedule([&n]() { ++n; });
+    }
+    // The destructor runs all the pending tasks.
+  }
+  EXPECT_EQ(1000, n.load());
+}
+
+TEST(WorkStealingThreadPoolTest, TaskGroup) {
+  WorkStealingThreadPool pool(3);
+  std::atomic<int> n(0);
+  for (int round = 0; round < 10; ++round) {
+    TaskGroup group(&pool);
+    for (int i = 0; i < 100; ++i) {
+      group.Run([&n]() { ++n; });
+    }
+    group.Wait();
+    EXPECT_EQ((round + 1) * 100, n.load());
+  }
+}
+
+TEST(WorkStealingThreadPoolTest, NestedTaskGroup) {
+  WorkStealingThreadPool pool(2);
+  std::atomic<int> n(0);
+  TaskGroup outer(&pool);
+  for (int i = 0; i < 8; ++i) {
+    outer.Run([&pool, &n]() {
+      TaskGroup inner(&pool);
+      for (int j = 0; j < 8; ++j) {
+        inner.Run([&n]() { ++n; });
+      }
+      inner.Wait();
+    });
+  }
+  outer.Wait();
+  EXPECT_EQ(64, n.load());
+}
+
+TEST(WorkStealingThreadPoolTest, ParallelFor) {
+  WorkStealingThreadPool pool(4, {0});
+  std::vector<int> values(1001, 0);
+  pool.ParallelFor(1, values.size(),
+                   [&values](size_t i) { values[i] = static_cast<int>(i); });
+  EXPECT_EQ(0, values[0]);
+  for (size_t i = 1; i < values.size(); ++i) {
+    EXPECT_EQ(static_cast<int>(i), values[i]);
+  }
+
+  // An empty range.
+  pool.ParallelFor(3, 3, [&values](size_t i) { values[i] = -1; });
+  EXPECT_EQ(3, values[3]);
+}
+
+TEST(WorkStealingThreadPoolTest, NoThread) {
+  WorkStealingThreadPool pool(0);
+  int n = 0;
+  pool.Schedule([&n]() { ++n; });
+  // Runs inline.
+  EXPECT_EQ(1, n);
+  TaskGroup group(&pool);
+  group.Run([&n]() { ++n; });
+  group.Wait();
+  EXPECT_EQ(2, n);
+  pool.ParallelFor(0, 10, [&n](size_t) { ++n; });
+  EXPECT_EQ(12, n);
+
+  TaskGroup no_pool_group(nullptr);
+  no_pool_group.Run([&n]() { ++n; });
+  EXPECT_EQ(13, n);
+  no_pool_group.Wait();
+}
+
+}  // namespace util
+}  // namespace common
+}  // namespace apollo
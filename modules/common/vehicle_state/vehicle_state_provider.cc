@@ -29,7 +29,8 @@
 namespace apollo {
 namespace common {
 
-VehicleStateProvider::VehicleStateProvider() {}
+VehicleStateProvider::VehicleStateProvider()
+    : snapshot_(std::make_shared<const VehicleStateSnapshot>()) {}
 
 Status VehicleStateProvider::Update(
     const localization::LocalizationEstimate &localization,
@@ -59,6 +60,7 @@ Status VehicleStateProvider::Update(
   }
   vehicle_state_.set_driving_mode(chassis.driving_mode());
 
+  PublishSnapshot();
   return Status::OK();
 }
 
@@ -174,60 +176,119 @@ const localization::Pose &VehicleStateProvider::pose() const {
 
 void VehicleStateProvider::set_linear_velocity(const double linear_velocity) {
   vehicle_state_.set_linear_velocity(linear_velocity);
+  PublishSnapshot();
 }
 
 const VehicleState &VehicleStateProvider::vehicle_state() const {
   return vehicle_state_;
 }
 
+std::shared_ptr<const VehicleStateSnapshot> VehicleStateProvider::snapshot()
+    const {
+  LockSnapshot();
+  std::shared_ptr<const VehicleStateSnapshot> snapshot = snapshot_;
+  UnlockSnapshot();
+  return snapshot;
+}
+
+void VehicleStateProvider::PublishSnapshot() {
+  auto new_snapshot = std::make_shared<VehicleStateSnapshot>();
+  FillSnapshot(new_snapshot.get());
+  std::shared_ptr<const VehicleStateSnapshot> snapshot(
+      std::move(new_snapshot));
+  LockSnapshot();
+  snapshot_.swap(snapshot);
+  UnlockSnapshot();
+  // The replaced snapshot is released here, out of the spin lock.
+}
+
+void VehicleStateProvider::LockSnapshot() const {
+  while (snapshot_flag_.test_and_set(std::memory_order_acquire)) {
+  }
+}
+
+void VehicleStateProvider::UnlockSnapshot() const {
+  snapshot_flag_.clear(std::memory_order_release);
+}
+
+void VehicleStateProvider::FillSnapshot(
+    VehicleStateSnapshot *snapshot) const {
+  snapshot->timestamp = vehicle_state_.timestamp();
+  snapshot->x = vehicle_state_.x();
+  snapshot->y = vehicle_state_.y();
+  snapshot->z = vehicle_state_.z();
+  snapshot->roll = vehicle_state_.roll();
+  snapshot->pitch = vehicle_state_.pitch();
+  snapshot->yaw = vehicle_state_.yaw();
+  snapshot->heading = vehicle_state_.heading();
+  snapshot->kappa = vehicle_state_.kappa();
+  snapshot->linear_velocity = vehicle_state_.linear_velocity();
+  snapshot->angular_velocity = vehicle_state_.angular_velocity();
+  snapshot->linear_acceleration = vehicle_state_.linear_acceleration();
+  snapshot->gear = vehicle_state_.gear();
+  snapshot->driving_mode = vehicle_state_.driving_mode();
+  snapshot->has_orientation = vehicle_state_.pose().has_orientation();
+  const auto &orientation = vehicle_state_.pose().orientation();
+  snapshot->qw = orientation.qw();
+  snapshot->qx = orientation.qx();
+  snapshot->qy = orientation.qy();
+  snapshot->qz = orientation.qz();
+}
+
 math::Vec2d VehicleStateProvider::EstimateFuturePosition(const double t) const {
+  VehicleStateSnapshot snapshot;
+  FillSnapshot(&snapshot);
+  return snapshot.EstimateFuturePosition(t);
+}
+
+math::Vec2d VehicleStateProvider::ComputeCOMPosition(
+    const double rear_to_com_distance) const {
+  VehicleStateSnapshot snapshot;
+  FillSnapshot(&snapshot);
+  return snapshot.ComputeCOMPosition(rear_to_com_distance);
+}
+
+math::Vec2d VehicleStateSnapshot::EstimateFuturePosition(const double t) const {
   Eigen::Vector3d vec_distance(0.0, 0.0, 0.0);
-  double v = vehicle_state_.linear_velocity();
-  if (vehicle_state_.gear() == canbus::Chassis::GEAR_REVERSE) {
-    v = -vehicle_state_.linear_velocity();
+  double v = linear_velocity;
+  if (gear == canbus::Chassis::GEAR_REVERSE) {
+    v = -linear_velocity;
   }
   // Predict distance travel vector
-  if (std::fabs(vehicle_state_.angular_velocity()) < 0.0001) {
+  if (std::fabs(angular_velocity) < 0.0001) {
     vec_distance[0] = 0.0;
     vec_distance[1] = v * t;
   } else {
-    vec_distance[0] = -v / vehicle_state_.angular_velocity() *
-                      (1.0 - std::cos(vehicle_state_.angular_velocity() * t));
-    vec_distance[1] = std::sin(vehicle_state_.angular_velocity() * t) * v /
-                      vehicle_state_.angular_velocity();
+    vec_distance[0] =
+        -v / angular_velocity * (1.0 - std::cos(angular_velocity * t));
+    vec_distance[1] = std::sin(angular_velocity * t) * v / angular_velocity;
   }
 
   // If we have rotation information, take it into consideration.
-  if (vehicle_state_.pose().has_orientation()) {
-    const auto &orientation = vehicle_state_.pose().orientation();
-    Eigen::Quaternion<double> quaternion(orientation.qw(), orientation.qx(),
-                                         orientation.qy(), orientation.qz());
-    Eigen::Vector3d pos_vec(vehicle_state_.x(), vehicle_state_.y(),
-                            vehicle_state_.z());
-    auto future_pos_3d = quaternion.toRotationMatrix() * vec_distance + pos_vec;
+  if (has_orientation) {
+    Eigen::Quaternion<double> quaternion(qw, qx, qy, qz);
+    Eigen::Vector3d pos_vec(x, y, z);
+    const Eigen::Vector3d future_pos_3d =
+        quaternion.toRotationMatrix() * vec_distance + pos_vec;
     return math::Vec2d(future_pos_3d[0], future_pos_3d[1]);
   }
 
   // If no valid rotation information provided from localization,
   // return the estimated future position without rotation.
-  return math::Vec2d(vec_distance[0] + vehicle_state_.x(),
-                     vec_distance[1] + vehicle_state_.y());
+  return math::Vec2d(vec_distance[0] + x, vec_distance[1] + y);
 }
 
-math::Vec2d VehicleStateProvider::ComputeCOMPosition(
+math::Vec2d VehicleStateSnapshot::ComputeCOMPosition(
     const double rear_to_com_distance) const {
   // set length as distance between rear wheel and center of mass.
   Eigen::Vector3d v(0.0, rear_to_com_distance, 0.0);
-  Eigen::Vector3d pos_vec(vehicle_state_.x(), vehicle_state_.y(),
-                          vehicle_state_.z());
+  Eigen::Vector3d pos_vec(x, y, z);
   // Initialize the COM position without rotation
   Eigen::Vector3d com_pos_3d = v + pos_vec;
 
   // If we have rotation information, take it into consideration.
-  if (vehicle_state_.pose().has_orientation()) {
-    const auto &orientation = vehicle_state_.pose().orientation();
-    Eigen::Quaternion<double> quaternion(orientation.qw(), orientation.qx(),
-                                         orientation.qy(), orientation.qz());
+  if (has_orientation) {
+    Eigen::Quaternion<double> quaternion(qw, qx, qy, qz);
     // Update the COM position with rotation
     com_pos_3d = quaternion.toRotationMatrix() * v + pos_vec;
   }
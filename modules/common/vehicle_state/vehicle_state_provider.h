@@ -21,6 +21,7 @@
 #ifndef MODULES_COMMON_VEHICLE_STATE_VEHICLE_STATE_PROVIDER_H_
 #define MODULES_COMMON_VEHICLE_STATE_VEHICLE_STATE_PROVIDER_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -40,11 +41,61 @@
 namespace apollo {
 namespace common {
 
+/**
+ * @struct VehicleStateSnapshot
+ * @brief The fields of the vehicle state set by one update, for the readers
+ *        on other threads.
+ */
+struct VehicleStateSnapshot {
+  double timestamp = 0.0;
+  double x = 0.0;
+  double y = 0.0;
+  double z = 0.0;
+  double roll = 0.0;
+  double pitch = 0.0;
+  double yaw = 0.0;
+  double heading = 0.0;
+  double kappa = 0.0;
+  double linear_velocity = 0.0;
+  double angular_velocity = 0.0;
+  double linear_acceleration = 0.0;
+  canbus::Chassis::GearPosition gear = canbus::Chassis::GEAR_NONE;
+  canbus::Chassis::DrivingMode driving_mode = canbus::Chassis::COMPLETE_MANUAL;
+  // The orientation of the pose, if localization has it.
+  bool has_orientation = false;
+  double qw = 1.0;
+  double qx = 0.0;
+  double qy = 0.0;
+  double qz = 0.0;
+
+  /**
+   * @brief Estimate future position from current position and heading,
+   *        along a period of time, by constant linear velocity,
+   *        linear acceleration, angular velocity.
+   * @param t The length of time period.
+   * @return The estimated future position in time t.
+   */
+  math::Vec2d EstimateFuturePosition(const double t) const;
+
+  /**
+   * @brief Compute the position of center of mass(COM) of the vehicle,
+   *        given the distance from rear wheels to the center of mass.
+   * @param rear_to_com_distance Distance from rear wheels to
+   *        the vehicle's center of mass.
+   * @return The position of the vehicle's center of mass.
+   */
+  math::Vec2d ComputeCOMPosition(const double rear_to_com_distance) const;
+};
+
 /**
  * @class VehicleStateProvider
  * @brief The class of vehicle state.
  *        It includes basic information and computation
  *        about the state of the vehicle.
+ *
+ * The accessors read the state being updated, so they are only consistent
+ * on the thread calling Update(). The other threads read snapshot(), which
+ * each successful update replaces as a whole.
  */
 class VehicleStateProvider {
  public:
@@ -171,12 +222,34 @@ class VehicleStateProvider {
 
   const VehicleState& vehicle_state() const;
 
+  /**
+   * @brief Get the vehicle state of the last successful update, which no
+   *        later update changes. Takes no lock of the provider.
+   * @return The snapshot of the vehicle state.
+   */
+  std::shared_ptr<const VehicleStateSnapshot> snapshot() const;
+
  private:
   bool ConstructExceptLinearVelocity(
       const localization::LocalizationEstimate& localization);
 
+  // Replaces the snapshot with the fields of vehicle_state_.
+  void PublishSnapshot();
+
+  void FillSnapshot(VehicleStateSnapshot* snapshot) const;
+
+  // Spin on snapshot_flag_, as the Adapter does for its snapshots: it is
+  // only held for the copy of the snapshot pointer. The libstdc++ of the
+  // toolchain has no std::atomic_load() for shared pointers.
+  void LockSnapshot() const;
+  void UnlockSnapshot() const;
+
   common::VehicleState vehicle_state_;
 
+  // Guarded by snapshot_flag_.
+  std::shared_ptr<const VehicleStateSnapshot> snapshot_;
+  mutable std::atomic_flag snapshot_flag_ = ATOMIC_FLAG_INIT;
+
   DECLARE_SINGLETON(VehicleStateProvider);
 };
 
@@ -16,7 +16,10 @@
 
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 
+#include <atomic>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "Eigen/Core"
 #include "gtest/gtest.h"
@@ -78,6 +81,63 @@ TEST_F(VehicleStateProviderTest, EstimateFuturePosition) {
   EXPECT_NEAR(future_position.y(), 90.393, 1e-3);
 }
 
+TEST_F(VehicleStateProviderTest, Snapshot) {
+  auto* vehicle_state_provider = VehicleStateProvider::instance();
+  vehicle_state_provider->Update(localization_, chassis_);
+  const auto snapshot = vehicle_state_provider->snapshot();
+  ASSERT_NE(nullptr, snapshot);
+  EXPECT_DOUBLE_EQ(vehicle_state_provider->x(), snapshot->x);
+  EXPECT_DOUBLE_EQ(vehicle_state_provider->y(), snapshot->y);
+  EXPECT_DOUBLE_EQ(vehicle_state_provider->heading(), snapshot->heading);
+  EXPECT_DOUBLE_EQ(vehicle_state_provider->linear_velocity(),
+                   snapshot->linear_velocity);
+  EXPECT_EQ(canbus::Chassis::GEAR_DRIVE, snapshot->gear);
+  const auto future_position = snapshot->EstimateFuturePosition(1.0);
+  EXPECT_NEAR(future_position.x(), 356.707, 1e-3);
+  EXPECT_NEAR(future_position.y(), 93.276, 1e-3);
+
+  // A later update replaces the snapshot instead of changing it.
+  vehicle_state_provider->set_linear_velocity(5.0);
+  EXPECT_DOUBLE_EQ(3.0, snapshot->linear_velocity);
+  EXPECT_DOUBLE_EQ(5.0, vehicle_state_provider->snapshot()->linear_velocity);
+
+  // A failed update keeps the last snapshot.
+  LocalizationEstimate no_pose;
+  EXPECT_FALSE(vehicle_state_provider->Update(no_pose, chassis_).ok());
+  EXPECT_DOUBLE_EQ(snapshot->x, vehicle_state_provider->snapshot()->x);
+}
+
+TEST_F(VehicleStateProviderTest, ConcurrentSnapshots) {
+  auto* vehicle_state_provider = VehicleStateProvider::instance();
+  auto* position = localization_.mutable_pose()->mutable_position();
+  position->set_x(0.0);
+  position->set_y(0.0);
+  position->set_z(0.0);
+  ASSERT_TRUE(vehicle_state_provider->Update(localization_, chassis_).ok());
+  std::atomic<bool> done(false);
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 2; ++i) {
+    readers.emplace_back([vehicle_state_provider, &done]() {
+      while (!done) {
+        const auto snapshot = vehicle_state_provider->snapshot();
+        // Every update sets the same x, y and z.
+        EXPECT_DOUBLE_EQ(snapshot->x, snapshot->y);
+        EXPECT_DOUBLE_EQ(snapshot->x, snapshot->z);
+      }
+    });
+  }
+  for (int i = 1; i <= 1000; ++i) {
+    position->set_x(i);
+    position->set_y(i);
+    position->set_z(i);
+    vehicle_state_provider->Update(localization_, chassis_);
+  }
+  done = true;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
+
 }  // namespace vehicle_state_provider
 }  // namespace common
 }  // namespace apollo
@@ -56,3 +56,14 @@ DEFINE_double(query_relative_time, 1.5,
               "Temp flag to query target by relative time");
 DEFINE_bool(use_mpc, false, "Use MPC controller for both lat/lon control");
 DEFINE_bool(enable_slope_offset, false, "Enable slope offset compensation");
+
+DEFINE_bool(trigger_control_by_localization, false,
+            "Compute control command upon each new localization, and upon "
+            "the timer only when localization is late");
+DEFINE_double(control_latency_report_period, 1.0,
+              "Period in seconds of the latency reports attached to the "
+              "control commands");
+
+DEFINE_double(end_to_end_latency_budget_ms, 300.0,
+              "Budget of the latency from the sensor data to the control "
+              "command in ms, not checked if it is not positive");
@@ -52,4 +52,8 @@ DECLARE_double(query_relative_time);
 DECLARE_bool(use_mpc);
 DECLARE_bool(enable_slope_offset);
 
+DECLARE_bool(trigger_control_by_localization);
+DECLARE_double(control_latency_report_period);
+DECLARE_double(end_to_end_latency_budget_ms);
+
 #endif  // MODULES_CONTROL_COMMON_CONTROL_GFLAGS_H_
@@ -43,14 +43,39 @@ bool Interpolation1D::Init(const DataType& xy) {
   y_end_ = data.back().second;
 
   // Spline fitting here. X values are scaled down to [0, 1] for this.
-  spline_.reset(new Eigen::Spline<double, 1>(
-      Eigen::SplineFitting<Eigen::Spline<double, 1>>::Interpolate(
-          y.transpose(),
-          // No more than cubic spline, but accept short vectors.
-          std::min<int>(x.size() - 1, 3), ScaledValues(x))));
+  BuildSegments(Eigen::SplineFitting<Eigen::Spline<double, 1>>::Interpolate(
+      y.transpose(),
+      // No more than cubic spline, but accept short vectors.
+      std::min<int>(x.size() - 1, 3), ScaledValues(x)));
   return true;
 }
 
+void Interpolation1D::BuildSegments(const Eigen::Spline<double, 1>& spline) {
+  segments_.clear();
+  segment_starts_.clear();
+  const int degree = static_cast<int>(spline.degree());
+  const auto& knots = spline.knots();
+  // the spans between the clamped end knots
+  for (int i = degree; i + degree + 1 < knots.size(); ++i) {
+    if (knots(i + 1) <= knots(i) && !segments_.empty()) {
+      continue;
+    }
+    Segment segment;
+    segment.start = knots(i);
+    // the Taylor expansion at the start of the span is the polynomial
+    const auto derivatives = spline.derivatives(segment.start, degree);
+    double factorial = 1.0;
+    for (int k = 0; k <= degree; ++k) {
+      if (k > 0) {
+        factorial *= k;
+      }
+      segment.coefficients[k] = derivatives(0, k) / factorial;
+    }
+    segments_.push_back(segment);
+    segment_starts_.push_back(segment.start);
+  }
+}
+
 double Interpolation1D::Interpolate(double x) const {
   if (x < x_min_) {
     return y_start_;
@@ -59,7 +84,16 @@ double Interpolation1D::Interpolate(double x) const {
     return y_end_;
   }
   // x values need to be scaled down in extraction as well.
-  return (*spline_)(ScaledValue(x))(0);
+  const double u = ScaledValue(x);
+  size_t index = std::upper_bound(segment_starts_.begin(),
+                                  segment_starts_.end(), u) -
+                 segment_starts_.begin();
+  index = index > 0 ? index - 1 : 0;
+  const Segment& segment = segments_[index];
+  const double t = u - segment.start;
+  return segment.coefficients[0] +
+         t * (segment.coefficients[1] +
+              t * (segment.coefficients[2] + t * segment.coefficients[3]));
 }
 
 double Interpolation1D::ScaledValue(double x) const {
@@ -16,7 +16,6 @@ limitations under the License.
 #ifndef MODULES_CONTROL_COMMON_INTERPOLATION_1D_H_
 #define MODULES_CONTROL_COMMON_INTERPOLATION_1D_H_
 
-#include <memory>
 #include <utility>
 #include <vector>
 
@@ -40,6 +39,15 @@ class Interpolation1D {
   double Interpolate(double x) const;
 
  private:
+  // Polynomial of the spline on a knot span, in the scaled x from the start
+  // of the span, so that no allocation nor knot search by Eigen is needed.
+  struct Segment {
+    double start = 0.0;
+    double coefficients[4] = {0.0, 0.0, 0.0, 0.0};
+  };
+
+  void BuildSegments(const Eigen::Spline<double, 1>& spline);
+
   // Helpers to scale X values down to [0, 1]
   double ScaledValue(double x) const;
 
@@ -50,8 +58,10 @@ class Interpolation1D {
   double y_start_ = 0.0;
   double y_end_ = 0.0;
 
-  // Spline of one-dimensional "points."
-  std::unique_ptr<Eigen::Spline<double, 1>> spline_;
+  // The spline of one-dimensional "points" as polynomials of the knot spans,
+  // by increasing start.
+  std::vector<Segment> segments_;
+  std::vector<double> segment_starts_;
 };
 
 }  // namespace control
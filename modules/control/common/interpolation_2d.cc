@@ -16,7 +16,9 @@
 
 #include "modules/control/common/interpolation_2d.h"
 
+#include <algorithm>
 #include <cmath>
+#include <map>
 
 #include "modules/common/log.h"
 
@@ -34,30 +36,63 @@ bool Interpolation2D::Init(const DataType &xyz) {
     AERROR << "empty input.";
     return false;
   }
+  std::map<double, std::map<double, double>> xyz_table;
   for (const auto &t : xyz) {
-    xyz_[std::get<0>(t)][std::get<1>(t)] = std::get<2>(t);
+    xyz_table[std::get<0>(t)][std::get<1>(t)] = std::get<2>(t);
+  }
+
+  xs_.clear();
+  row_begins_.clear();
+  ys_.clear();
+  zs_.clear();
+  xs_.reserve(xyz_table.size());
+  row_begins_.reserve(xyz_table.size() + 1);
+  ys_.reserve(xyz.size());
+  zs_.reserve(xyz.size());
+  for (const auto &x_row : xyz_table) {
+    xs_.push_back(x_row.first);
+    row_begins_.push_back(ys_.size());
+    for (const auto &yz : x_row.second) {
+      ys_.push_back(yz.first);
+      zs_.push_back(yz.second);
+    }
+  }
+  row_begins_.push_back(ys_.size());
+
+  inv_x_step_ = 0.0;
+  if (xs_.size() > 2) {
+    const double x_step = (xs_.back() - xs_.front()) / (xs_.size() - 1);
+    bool evenly_spaced = true;
+    for (size_t i = 1; i < xs_.size(); ++i) {
+      if (std::fabs(xs_[i] - xs_[i - 1] - x_step) > 0.1 * x_step) {
+        evenly_spaced = false;
+        break;
+      }
+    }
+    if (evenly_spaced) {
+      inv_x_step_ = 1.0 / x_step;
+    }
   }
   return true;
 }
 
 double Interpolation2D::Interpolate(const KeyType &xy) const {
-  double max_x = xyz_.rbegin()->first;
-  double min_x = xyz_.begin()->first;
+  double max_x = xs_.back();
+  double min_x = xs_.front();
   if (xy.first >= max_x - kDoubleEpsilon) {
-    return InterpolateYz(xyz_.rbegin()->second, xy.second);
+    return InterpolateYz(xs_.size() - 1, xy.second);
   }
   if (xy.first <= min_x + kDoubleEpsilon) {
-    return InterpolateYz(xyz_.begin()->second, xy.second);
+    return InterpolateYz(0, xy.second);
   }
 
-  auto itr_after = xyz_.lower_bound(xy.first);
-  auto itr_before = itr_after;
-  --itr_before;
+  const size_t row_before = FindRowBefore(xy.first);
+  const size_t row_after = row_before + 1;
 
-  double x_before = itr_before->first;
-  double z_before = InterpolateYz(itr_before->second, xy.second);
-  double x_after = itr_after->first;
-  double z_after = InterpolateYz(itr_after->second, xy.second);
+  double x_before = xs_[row_before];
+  double z_before = InterpolateYz(row_before, xy.second);
+  double x_after = xs_[row_after];
+  double z_after = InterpolateYz(row_after, xy.second);
 
   double x_diff_before = std::fabs(xy.first - x_before);
   double x_diff_after = std::fabs(xy.first - x_after);
@@ -65,32 +100,50 @@ double Interpolation2D::Interpolate(const KeyType &xy) const {
   return InterpolateValue(z_before, x_diff_before, z_after, x_diff_after);
 }
 
-double Interpolation2D::InterpolateYz(const std::map<double, double> &yz_table,
-                                      double y) const {
-  if (yz_table.empty()) {
+size_t Interpolation2D::FindRowBefore(const double x) const {
+  if (inv_x_step_ > 0.0) {
+    // the guess is off by at most one row for the rows which are not exactly
+    // evenly spaced
+    const double offset = (x - xs_.front()) * inv_x_step_;
+    size_t row = std::min(static_cast<size_t>(std::max(offset, 0.0)),
+                          xs_.size() - 2);
+    if (row > 0 && xs_[row] >= x) {
+      --row;
+    } else if (row + 2 < xs_.size() && xs_[row + 1] < x) {
+      ++row;
+    }
+    if (xs_[row] < x && x <= xs_[row + 1]) {
+      return row;
+    }
+  }
+  return std::lower_bound(xs_.begin(), xs_.end(), x) - xs_.begin() - 1;
+}
+
+double Interpolation2D::InterpolateYz(const size_t row, double y) const {
+  const double *ys_begin = ys_.data() + row_begins_[row];
+  const double *ys_end = ys_.data() + row_begins_[row + 1];
+  const double *zs_begin = zs_.data() + row_begins_[row];
+  if (ys_begin == ys_end) {
     AERROR << "Unable to interpolateYz because yz_table is empty.";
     return y;
   }
-  double max_y = yz_table.rbegin()->first;
-  double min_y = yz_table.begin()->first;
+  const size_t last = ys_end - ys_begin - 1;
+  double max_y = ys_begin[last];
+  double min_y = ys_begin[0];
   if (y >= max_y - kDoubleEpsilon) {
-    return yz_table.rbegin()->second;
+    return zs_begin[last];
   }
   if (y <= min_y + kDoubleEpsilon) {
-    return yz_table.begin()->second;
+    return zs_begin[0];
   }
 
-  auto itr_after = yz_table.lower_bound(y);
-  auto itr_before = itr_after;
-
-  if (itr_before != yz_table.begin()) {
-    --itr_before;
-  }
+  const size_t after = std::lower_bound(ys_begin, ys_end, y) - ys_begin;
+  const size_t before = after > 0 ? after - 1 : after;
 
-  double y_before = itr_before->first;
-  double z_before = itr_before->second;
-  double y_after = itr_after->first;
-  double z_after = itr_after->second;
+  double y_before = ys_begin[before];
+  double z_before = zs_begin[before];
+  double y_after = ys_begin[after];
+  double z_after = zs_begin[after];
 
   double y_diff_before = std::fabs(y - y_before);
   double y_diff_after = std::fabs(y - y_after);
@@ -21,8 +21,7 @@
 #ifndef MODULES_CONTROL_COMMON_INTERPOLATION_2D_H_
 #define MODULES_CONTROL_COMMON_INTERPOLATION_2D_H_
 
-#include <map>
-#include <memory>
+#include <cstddef>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -37,6 +36,11 @@ namespace control {
  * @class Interpolation2D
  *
  * @brief linear interpolation from key (double, double) to one double value.
+ *
+ * The table is kept as rows of increasing x, each with its (y, z) samples of
+ * increasing y, all stored contiguously. The row of an x is found by index
+ * computation when the rows are evenly spaced, as in the calibration tables,
+ * and by binary search otherwise.
  */
 class Interpolation2D {
  public:
@@ -60,14 +64,25 @@ class Interpolation2D {
   double Interpolate(const KeyType &xy) const;
 
  private:
-  double InterpolateYz(const std::map<double, double> &yz_table,
-                       double y) const;
+  // Gets the index of the last x row before x, which is strictly between the
+  // first and the last rows.
+  size_t FindRowBefore(double x) const;
+
+  double InterpolateYz(size_t row, double y) const;
 
   double InterpolateValue(const double value_before, const double dist_before,
                           const double value_after,
                           const double dist_after) const;
 
-  std::map<double, std::map<double, double>> xyz_;
+  // The x of the rows.
+  std::vector<double> xs_;
+  // The samples of row i are at [row_begins_[i], row_begins_[i + 1]).
+  std::vector<size_t> row_begins_;
+  std::vector<double> ys_;
+  std::vector<double> zs_;
+  // The inverse of the spacing of the rows, or 0 if they are not evenly
+  // spaced.
+  double inv_x_step_ = 0.0;
 };
 
 }  // namespace control
@@ -71,6 +71,34 @@ TEST_F(Interpolation2DTest, normal) {
   EXPECT_DOUBLE_EQ(30.5, estimator.Interpolate(std::make_pair(40, 40)));
 }
 
+TEST_F(Interpolation2DTest, rows) {
+  // evenly spaced rows of z = 50 * x + y + 1
+  Interpolation2D::DataType xyz;
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      xyz.push_back(
+          std::make_tuple(0.2 * i, 2.0 * j - 1.0, 10.0 * i + 2.0 * j));
+    }
+  }
+  Interpolation2D estimator;
+  EXPECT_TRUE(estimator.Init(xyz));
+
+  EXPECT_DOUBLE_EQ(12.0, estimator.Interpolate(std::make_pair(0.2, 1.0)));
+  EXPECT_DOUBLE_EQ(6.25, estimator.Interpolate(std::make_pair(0.1, 0.25)));
+  EXPECT_DOUBLE_EQ(38.0, estimator.Interpolate(std::make_pair(0.7, 2.0)));
+  EXPECT_DOUBLE_EQ(33.0, estimator.Interpolate(std::make_pair(0.65, -0.5)));
+  EXPECT_DOUBLE_EQ(44.0, estimator.Interpolate(std::make_pair(1.5, 4.0)));
+
+  // unevenly spaced rows
+  xyz.push_back(std::make_tuple(5.0, -1.0, 100.0));
+  xyz.push_back(std::make_tuple(5.0, 3.0, 100.0));
+  EXPECT_TRUE(estimator.Init(xyz));
+
+  EXPECT_DOUBLE_EQ(6.25, estimator.Interpolate(std::make_pair(0.1, 0.25)));
+  EXPECT_DOUBLE_EQ(38.0, estimator.Interpolate(std::make_pair(0.7, 2.0)));
+  EXPECT_DOUBLE_EQ(70.0, estimator.Interpolate(std::make_pair(2.9, -1.0)));
+}
+
 TEST_F(Interpolation2DTest, calibration_table) {
   const auto &calibration_table =
       control_conf_.lon_controller_conf().calibration_table();
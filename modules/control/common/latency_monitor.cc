@@ -0,0 +1,162 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/control/common/latency_monitor.h"
+
+#include <algorithm>
+
+namespace apollo {
+namespace control {
+
+LatencyMonitor::LatencyMonitor(const double report_period)
+    : report_period_(report_period) {}
+
+bool LatencyMonitor::Add(const double cycle_start_time,
+                         const LatencyStats &stats, LatencyReport *report) {
+  if (num_cycles_ == 0) {
+    report_start_time_ = cycle_start_time;
+  }
+  // the period is also measured across two reports
+  if (last_cycle_start_time_ > 0.0) {
+    cycle_period_.Add((cycle_start_time - last_cycle_start_time_) * 1000);
+  }
+  last_cycle_start_time_ = cycle_start_time;
+  ++num_cycles_;
+
+  if (stats.has_timer_lateness_ms()) {
+    timer_lateness_.Add(stats.timer_lateness_ms());
+  }
+  if (stats.has_total_time_ms()) {
+    total_time_.Add(stats.total_time_ms());
+  }
+  if (controller_time_.size() <
+      static_cast<size_t>(stats.controller_time_ms_size())) {
+    controller_time_.resize(stats.controller_time_ms_size());
+  }
+  for (int i = 0; i < stats.controller_time_ms_size(); ++i) {
+    controller_time_[i].Add(stats.controller_time_ms(i));
+  }
+  if (stats.has_send_time_ms()) {
+    send_time_.Add(stats.send_time_ms());
+  }
+  if (stats.has_localization_age_ms()) {
+    localization_age_.Add(stats.localization_age_ms());
+  }
+  if (stats.has_chassis_age_ms()) {
+    chassis_age_.Add(stats.chassis_age_ms());
+  }
+  if (stats.has_trajectory_age_ms()) {
+    trajectory_age_.Add(stats.trajectory_age_ms());
+  }
+  if (stats.has_trace_latency()) {
+    const auto &trace_latency = stats.trace_latency();
+    end_to_end_.Add(trace_latency.total_ms());
+    const size_t num_hops = trace_latency.hop_size();
+    if (trace_hop_.size() < num_hops) {
+      trace_hop_.resize(num_hops);
+      trace_hop_name_.resize(num_hops);
+    }
+    for (size_t i = 0; i < num_hops; ++i) {
+      trace_hop_[i].Add(trace_latency.hop(i).latency_ms());
+      trace_hop_name_[i] = trace_latency.hop(i).module_name();
+    }
+    if (trace_latency.over_budget()) {
+      ++num_over_budget_;
+    }
+  }
+
+  if (cycle_start_time - report_start_time_ < report_period_) {
+    return false;
+  }
+
+  report->Clear();
+  report->set_num_cycles(num_cycles_);
+  if (!cycle_period_.empty()) {
+    cycle_period_.Fill(report->mutable_cycle_period());
+  }
+  if (!timer_lateness_.empty()) {
+    timer_lateness_.Fill(report->mutable_timer_lateness());
+  }
+  if (!total_time_.empty()) {
+    total_time_.Fill(report->mutable_total_time());
+  }
+  for (const auto &controller_time : controller_time_) {
+    controller_time.Fill(report->add_controller_time());
+  }
+  if (!send_time_.empty()) {
+    send_time_.Fill(report->mutable_send_time());
+  }
+  if (!localization_age_.empty()) {
+    localization_age_.Fill(report->mutable_localization_age());
+  }
+  if (!chassis_age_.empty()) {
+    chassis_age_.Fill(report->mutable_chassis_age());
+  }
+  if (!trajectory_age_.empty()) {
+    trajectory_age_.Fill(report->mutable_trajectory_age());
+  }
+  if (!end_to_end_.empty()) {
+    end_to_end_.Fill(report->mutable_end_to_end());
+    for (size_t i = 0; i < trace_hop_.size(); ++i) {
+      report->add_trace_hop_name(trace_hop_name_[i]);
+      trace_hop_[i].Fill(report->add_trace_hop());
+    }
+    report->set_num_over_budget(num_over_budget_);
+  }
+  Clear();
+  return true;
+}
+
+void LatencyMonitor::Clear() {
+  num_cycles_ = 0;
+  cycle_period_.Clear();
+  timer_lateness_.Clear();
+  total_time_.Clear();
+  controller_time_.clear();
+  send_time_.Clear();
+  localization_age_.Clear();
+  chassis_age_.Clear();
+  trajectory_age_.Clear();
+  end_to_end_.Clear();
+  trace_hop_.clear();
+  trace_hop_name_.clear();
+  num_over_budget_ = 0;
+}
+
+void LatencyMonitor::Accumulator::Add(const double value) {
+  if (count_ == 0) {
+    sum_ = 0.0;
+    min_ = value;
+    max_ = value;
+  }
+  ++count_;
+  sum_ += value;
+  min_ = std::min(min_, value);
+  max_ = std::max(max_, value);
+}
+
+void LatencyMonitor::Accumulator::Fill(LatencyReport::Stat *stat) const {
+  if (count_ == 0) {
+    return;
+  }
+  stat->set_min_ms(min_);
+  stat->set_mean_ms(sum_ / count_);
+  stat->set_max_ms(max_);
+}
+
+}  // namespace control
+}  // namespace apollo
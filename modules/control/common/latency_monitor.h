@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file latency_monitor.h
+ * @brief Defines the LatencyMonitor class.
+ */
+
+#ifndef MODULES_CONTROL_COMMON_LATENCY_MONITOR_H_
+#define MODULES_CONTROL_COMMON_LATENCY_MONITOR_H_
+
+#include <string>
+#include <vector>
+
+#include "modules/control/proto/control_cmd.pb.h"
+
+/**
+ * @namespace apollo::control
+ * @brief apollo::control
+ */
+namespace apollo {
+namespace control {
+
+/**
+ * @class LatencyMonitor
+ * @brief accumulates the latency of the control cycles and reports their
+ * statistics periodically, to tell the scheduling problems of the control
+ * loop.
+ */
+class LatencyMonitor {
+ public:
+  /**
+   * @brief constructor
+   * @param report_period period of the reports in seconds
+   */
+  explicit LatencyMonitor(const double report_period = 1.0);
+
+  /**
+   * @brief record the latency of a control cycle
+   * @param cycle_start_time start time of the cycle in seconds
+   * @param stats latency of the cycle
+   * @param report filled with the statistics of the cycles since the last
+   * report, including this one, when the report period is over
+   * @return true if the report is filled
+   */
+  bool Add(const double cycle_start_time, const LatencyStats &stats,
+           LatencyReport *report);
+
+ private:
+  class Accumulator {
+   public:
+    void Add(const double value);
+    void Fill(LatencyReport::Stat *stat) const;
+    void Clear() { count_ = 0; }
+    bool empty() const { return count_ == 0; }
+
+   private:
+    int count_ = 0;
+    double sum_ = 0.0;
+    double min_ = 0.0;
+    double max_ = 0.0;
+  };
+
+  void Clear();
+
+  double report_period_ = 1.0;
+  double report_start_time_ = 0.0;
+  double last_cycle_start_time_ = 0.0;
+  int num_cycles_ = 0;
+
+  Accumulator cycle_period_;
+  Accumulator timer_lateness_;
+  Accumulator total_time_;
+  std::vector<Accumulator> controller_time_;
+  Accumulator send_time_;
+  Accumulator localization_age_;
+  Accumulator chassis_age_;
+  Accumulator trajectory_age_;
+  Accumulator end_to_end_;
+  std::vector<Accumulator> trace_hop_;
+  std::vector<std::string> trace_hop_name_;
+  int num_over_budget_ = 0;
+};
+
+}  // namespace control
+}  // namespace apollo
+
+#endif  // MODULES_CONTROL_COMMON_LATENCY_MONITOR_H_
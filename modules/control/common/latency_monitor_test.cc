@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/control/common/latency_monitor.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace control {
+
+TEST(LatencyMonitorTest, Report) {
+  LatencyMonitor latency_monitor(0.095);
+  LatencyReport report;
+  // cycles of 10 ms, the ones triggered by the timer are 1 ms late
+  for (int i = 0; i < 10; ++i) {
+    LatencyStats stats;
+    stats.set_total_time_ms(1.0 + i);
+    stats.add_controller_time_ms(0.5 * i);
+    stats.add_controller_time_ms(0.1);
+    stats.set_localization_age_ms(5.0);
+    if (i % 2 == 0) {
+      stats.set_timer_lateness_ms(1.0);
+    }
+    EXPECT_FALSE(latency_monitor.Add(100.0 + 0.01 * i, stats, &report));
+  }
+
+  LatencyStats stats;
+  stats.set_total_time_ms(20.0);
+  stats.set_send_time_ms(21.0);
+  ASSERT_TRUE(latency_monitor.Add(100.1, stats, &report));
+  EXPECT_EQ(11, report.num_cycles());
+  EXPECT_NEAR(10.0, report.cycle_period().min_ms(), 1e-6);
+  EXPECT_NEAR(10.0, report.cycle_period().mean_ms(), 1e-6);
+  EXPECT_NEAR(10.0, report.cycle_period().max_ms(), 1e-6);
+  EXPECT_DOUBLE_EQ(1.0, report.timer_lateness().mean_ms());
+  EXPECT_DOUBLE_EQ(1.0, report.total_time().min_ms());
+  EXPECT_DOUBLE_EQ(75.0 / 11, report.total_time().mean_ms());
+  EXPECT_DOUBLE_EQ(20.0, report.total_time().max_ms());
+  ASSERT_EQ(2, report.controller_time_size());
+  EXPECT_DOUBLE_EQ(4.5, report.controller_time(0).max_ms());
+  EXPECT_DOUBLE_EQ(0.1, report.controller_time(1).mean_ms());
+  EXPECT_DOUBLE_EQ(21.0, report.send_time().max_ms());
+  EXPECT_DOUBLE_EQ(5.0, report.localization_age().max_ms());
+  EXPECT_FALSE(report.has_chassis_age());
+  EXPECT_FALSE(report.has_trajectory_age());
+
+  // the next report only covers the cycles after this one, the period of
+  // its first cycle is measured from the last cycle of the previous report
+  stats.Clear();
+  EXPECT_FALSE(latency_monitor.Add(100.125, stats, &report));
+  ASSERT_TRUE(latency_monitor.Add(100.23, stats, &report));
+  EXPECT_EQ(2, report.num_cycles());
+  EXPECT_NEAR(25.0, report.cycle_period().min_ms(), 1e-6);
+  EXPECT_NEAR(105.0, report.cycle_period().max_ms(), 1e-6);
+  EXPECT_FALSE(report.has_total_time());
+  EXPECT_EQ(0, report.controller_time_size());
+}
+
+TEST(LatencyMonitorTest, TraceLatency) {
+  LatencyMonitor latency_monitor(0.015);
+  LatencyReport report;
+  for (int i = 0; i < 2; ++i) {
+    LatencyStats stats;
+    auto *trace_latency = stats.mutable_trace_latency();
+    auto *hop = trace_latency->add_hop();
+    hop->set_module_name("planning");
+    hop->set_latency_ms(100.0 + 20.0 * i);
+    hop = trace_latency->add_hop();
+    hop->set_module_name("control");
+    hop->set_latency_ms(10.0);
+    trace_latency->set_total_ms(110.0 + 20.0 * i);
+    trace_latency->set_over_budget(i == 1);
+    EXPECT_FALSE(latency_monitor.Add(100.0 + 0.01 * i, stats, &report));
+  }
+
+  // a cycle without trace only counts in the number of cycles
+  ASSERT_TRUE(latency_monitor.Add(100.02, LatencyStats(), &report));
+  EXPECT_EQ(3, report.num_cycles());
+  EXPECT_DOUBLE_EQ(110.0, report.end_to_end().min_ms());
+  EXPECT_DOUBLE_EQ(120.0, report.end_to_end().mean_ms());
+  EXPECT_DOUBLE_EQ(130.0, report.end_to_end().max_ms());
+  ASSERT_EQ(2, report.trace_hop_size());
+  ASSERT_EQ(2, report.trace_hop_name_size());
+  EXPECT_EQ("planning", report.trace_hop_name(0));
+  EXPECT_DOUBLE_EQ(120.0, report.trace_hop(0).max_ms());
+  EXPECT_EQ("control", report.trace_hop_name(1));
+  EXPECT_DOUBLE_EQ(10.0, report.trace_hop(1).mean_ms());
+  EXPECT_EQ(1, report.num_over_budget());
+}
+
+}  // namespace control
+}  // namespace apollo
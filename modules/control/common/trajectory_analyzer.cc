@@ -18,12 +18,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <utility>
 
 #include "modules/common/log.h"
 #include "modules/common/math/linear_interpolation.h"
 #include "modules/common/math/math_utils.h"
-#include "modules/common/math/search.h"
 
 namespace math = apollo::common::math;
 using apollo::common::PathPoint;
@@ -61,34 +61,56 @@ TrajectoryAnalyzer::TrajectoryAnalyzer(
     trajectory_points_.push_back(
         planning_published_trajectory->trajectory_point(i));
   }
+
+  for (size_t i = 1; i < trajectory_points_.size(); ++i) {
+    Segment segment;
+    segment.dx = trajectory_points_[i].path_point().x() -
+                 trajectory_points_[i - 1].path_point().x();
+    segment.dy = trajectory_points_[i].path_point().y() -
+                 trajectory_points_[i - 1].path_point().y();
+    segment.length_square = segment.dx * segment.dx + segment.dy * segment.dy;
+    segments_.push_back(segment);
+  }
+}
+
+bool TrajectoryAnalyzer::Analyzes(
+    const planning::ADCTrajectory &trajectory) const {
+  return trajectory.header().sequence_num() == seq_num_ &&
+         trajectory.header().timestamp_sec() == header_time_ &&
+         static_cast<size_t>(trajectory.trajectory_point_size()) ==
+             trajectory_points_.size();
 }
 
 PathPoint TrajectoryAnalyzer::QueryMatchedPathPoint(const double x,
                                                     const double y) const {
-  double d_min = PointDistanceSquare(trajectory_points_.front(), x, y);
-  size_t index_min = 0;
+  const size_t index_min = QueryNearestPointIndex(x, y);
 
-  for (size_t i = 1; i < trajectory_points_.size(); ++i) {
-    double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
+  // the matched point is the closest projection on the segments before and
+  // after the nearest point, the segments too short in s are skipped.
+  const double kEpsilon = 0.001;
+  double d_min = std::numeric_limits<double>::infinity();
+  size_t segment_min = segments_.size();
+  double ratio_min = 0.0;
+  const size_t segment_start = index_min == 0 ? 0 : index_min - 1;
+  for (size_t i = segment_start; i <= index_min && i < segments_.size();
+       ++i) {
+    if (std::fabs(trajectory_points_[i + 1].path_point().s() -
+                  trajectory_points_[i].path_point().s()) <= kEpsilon) {
+      continue;
+    }
+    double ratio = 0.0;
+    const double d_temp = ProjectOnSegment(i, x, y, &ratio);
     if (d_temp < d_min) {
       d_min = d_temp;
-      index_min = i;
+      segment_min = i;
+      ratio_min = ratio;
     }
   }
 
-  size_t index_start = index_min == 0 ? index_min : index_min - 1;
-  size_t index_end =
-      index_min + 1 == trajectory_points_.size() ? index_min : index_min + 1;
-
-  const double kEpsilon = 0.001;
-  if (index_start == index_end ||
-      std::fabs(trajectory_points_[index_start].path_point().s() -
-                trajectory_points_[index_end].path_point().s()) <= kEpsilon) {
-    return TrajectoryPointToPathPoint(trajectory_points_[index_start]);
+  if (segment_min == segments_.size()) {
+    return TrajectoryPointToPathPoint(trajectory_points_[index_min]);
   }
-
-  return FindMinDistancePoint(trajectory_points_[index_start],
-                              trajectory_points_[index_end], x, y);
+  return InterpolateOnSegment(segment_min, ratio_min);
 }
 
 // reference: Optimal trajectory generation for dynamic street scenarios in a
@@ -175,17 +197,7 @@ TrajectoryPoint TrajectoryAnalyzer::QueryNearestPointByRelativeTime(
 
 TrajectoryPoint TrajectoryAnalyzer::QueryNearestPointByPosition(
     const double x, const double y) const {
-  double d_min = PointDistanceSquare(trajectory_points_.front(), x, y);
-  size_t index_min = 0;
-
-  for (size_t i = 1; i < trajectory_points_.size(); ++i) {
-    double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
-    if (d_temp < d_min) {
-      d_min = d_temp;
-      index_min = i;
-    }
-  }
-  return trajectory_points_[index_min];
+  return trajectory_points_[QueryNearestPointIndex(x, y)];
 }
 
 const std::vector<TrajectoryPoint> &TrajectoryAnalyzer::trajectory_points()
@@ -193,35 +205,86 @@ const std::vector<TrajectoryPoint> &TrajectoryAnalyzer::trajectory_points()
   return trajectory_points_;
 }
 
-PathPoint TrajectoryAnalyzer::FindMinDistancePoint(const TrajectoryPoint &p0,
-                                                   const TrajectoryPoint &p1,
-                                                   const double x,
-                                                   const double y) const {
+size_t TrajectoryAnalyzer::QueryNearestPointIndex(const double x,
+                                                  const double y) const {
+  // the position moves little between two queries, so the nearest point is
+  // searched downhill from the last matched one. The local minimum is only
+  // trusted when it is close to the position, otherwise the position jumped
+  // or the trajectory loops back, and the whole trajectory is scanned.
+  const double kMaxLocalMatchDistanceSquare = 4.0;
+
+  size_t index_min = std::min(matched_index_hint_,
+                              trajectory_points_.size() - 1);
+  double d_min = PointDistanceSquare(trajectory_points_[index_min], x, y);
+  while (index_min > 0) {
+    const double d_temp =
+        PointDistanceSquare(trajectory_points_[index_min - 1], x, y);
+    if (d_temp >= d_min) {
+      break;
+    }
+    d_min = d_temp;
+    --index_min;
+  }
+  while (index_min + 1 < trajectory_points_.size()) {
+    const double d_temp =
+        PointDistanceSquare(trajectory_points_[index_min + 1], x, y);
+    if (d_temp >= d_min) {
+      break;
+    }
+    d_min = d_temp;
+    ++index_min;
+  }
+
+  if (d_min > kMaxLocalMatchDistanceSquare) {
+    d_min = PointDistanceSquare(trajectory_points_.front(), x, y);
+    index_min = 0;
+    for (size_t i = 1; i < trajectory_points_.size(); ++i) {
+      const double d_temp = PointDistanceSquare(trajectory_points_[i], x, y);
+      if (d_temp < d_min) {
+        d_min = d_temp;
+        index_min = i;
+      }
+    }
+  }
+
+  matched_index_hint_ = index_min;
+  return index_min;
+}
+
+double TrajectoryAnalyzer::ProjectOnSegment(const size_t index,
+                                            const double x, const double y,
+                                            double *ratio) const {
   // given the fact that the discretized trajectory is dense enough,
   // we assume linear trajectory between consecutive trajectory points.
-  auto dist_square = [&p0, &p1, &x, &y](const double s) {
-    double px = math::lerp(p0.path_point().x(), p0.path_point().s(),
-                           p1.path_point().x(), p1.path_point().s(), s);
-    double py = math::lerp(p0.path_point().y(), p0.path_point().s(),
-                           p1.path_point().y(), p1.path_point().s(), s);
-    double dx = px - x;
-    double dy = py - y;
-    return dx * dx + dy * dy;
-  };
+  const Segment &segment = segments_[index];
+  const PathPoint &p0 = trajectory_points_[index].path_point();
+  const double dx = x - p0.x();
+  const double dy = y - p0.y();
+  *ratio = 0.0;
+  if (segment.length_square > 0.0) {
+    *ratio = math::Clamp(
+        (dx * segment.dx + dy * segment.dy) / segment.length_square, 0.0,
+        1.0);
+  }
+  const double ex = dx - *ratio * segment.dx;
+  const double ey = dy - *ratio * segment.dy;
+  return ex * ex + ey * ey;
+}
+
+PathPoint TrajectoryAnalyzer::InterpolateOnSegment(const size_t index,
+                                                   const double ratio) const {
+  const Segment &segment = segments_[index];
+  const PathPoint &p0 = trajectory_points_[index].path_point();
+  const PathPoint &p1 = trajectory_points_[index + 1].path_point();
 
-  PathPoint p = p0.path_point();
-  double s = math::GoldenSectionSearch(dist_square, p0.path_point().s(),
-                                       p1.path_point().s());
+  PathPoint p = p0;
+  const double s = p0.s() + ratio * (p1.s() - p0.s());
   p.set_s(s);
-  p.set_x(math::lerp(p0.path_point().x(), p0.path_point().s(),
-                     p1.path_point().x(), p1.path_point().s(), s));
-  p.set_y(math::lerp(p0.path_point().y(), p0.path_point().s(),
-                     p1.path_point().y(), p1.path_point().s(), s));
-  p.set_theta(math::slerp(p0.path_point().theta(), p0.path_point().s(),
-                          p1.path_point().theta(), p1.path_point().s(), s));
+  p.set_x(p0.x() + ratio * segment.dx);
+  p.set_y(p0.y() + ratio * segment.dy);
+  p.set_theta(math::slerp(p0.theta(), p0.s(), p1.theta(), p1.s(), s));
   // approximate the curvature at the intermediate point
-  p.set_kappa(math::lerp(p0.path_point().kappa(), p0.path_point().s(),
-                         p1.path_point().kappa(), p1.path_point().s(), s));
+  p.set_kappa(math::lerp(p0.kappa(), p0.s(), p1.kappa(), p1.s(), s));
   return p;
 }
 
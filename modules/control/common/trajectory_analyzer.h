@@ -64,7 +64,15 @@ class TrajectoryAnalyzer {
    * @brief get sequence number of the trajecotry
    * @return sequence number.
    */
-  unsigned int seq_num() { return seq_num_; }
+  unsigned int seq_num() const { return seq_num_; }
+
+  /**
+   * @brief whether the analyzer was built from a trajectory, told by its
+   * header and its number of points.
+   * @param trajectory trajectory data generated by planning module
+   * @return true if the analyzer analyzes the trajectory.
+   */
+  bool Analyzes(const planning::ADCTrajectory &trajectory) const;
 
   /**
    * @brief query a point of trajectery that its absolute time is closest
@@ -84,7 +92,9 @@ class TrajectoryAnalyzer {
 
   /**
    * @brief query a point of trajectery that its position is closest
-   * to the given position.
+   * to the given position. The search starts from the point matched by the
+   * previous query and only scans the whole trajectory when no point close
+   * to the position is found around it.
    * @param x value of x-coordination in the given position
    * @param y value of y-coordination in the given position
    * @return a point of trajectory
@@ -127,11 +137,29 @@ class TrajectoryAnalyzer {
   const std::vector<common::TrajectoryPoint> &trajectory_points() const;
 
  private:
-  common::PathPoint FindMinDistancePoint(const common::TrajectoryPoint &p0,
-                                         const common::TrajectoryPoint &p1,
-                                         const double x, const double y) const;
+  // the segment from a trajectory point to the next one
+  struct Segment {
+    double dx = 0.0;
+    double dy = 0.0;
+    double length_square = 0.0;
+  };
+
+  size_t QueryNearestPointIndex(const double x, const double y) const;
+
+  // projects the position on the segment from the point of the given index
+  // to the next point, returns the squared distance to the projection
+  double ProjectOnSegment(const size_t index, const double x, const double y,
+                          double *ratio) const;
+
+  common::PathPoint InterpolateOnSegment(const size_t index,
+                                         const double ratio) const;
 
   std::vector<common::TrajectoryPoint> trajectory_points_;
+  std::vector<Segment> segments_;
+
+  // index of the point matched by the last position query, where the next
+  // query starts searching
+  mutable size_t matched_index_hint_ = 0;
 
   double header_time_ = 0.0;
   unsigned int seq_num_ = 0;
@@ -16,7 +16,9 @@
 
 #include "modules/control/common/trajectory_analyzer.h"
 
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -115,6 +117,62 @@ TEST_F(TrajectoryAnalyzerTest, QueryMatchedPathPoint) {
   EXPECT_NEAR(point.y(), 1.53, 1e-3);
 }
 
+TEST_F(TrajectoryAnalyzerTest, QueryNearestPointByPosition) {
+  // two turns of radius 10 and 13, so the trajectory loops back
+  planning::ADCTrajectory adc_trajectory;
+  std::vector<double> xs;
+  std::vector<double> ys;
+  std::vector<double> ss;
+  const int kNumPoints = 200;
+  for (int i = 0; i < kNumPoints; ++i) {
+    const double angle = 4.0 * M_PI * i / kNumPoints;
+    const double radius = i < kNumPoints / 2 ? 10.0 : 13.0;
+    xs.push_back(radius * std::cos(angle));
+    ys.push_back(radius * std::sin(angle));
+    ss.push_back(10.0 * angle);
+  }
+  SetTrajectory(xs, ys, ss, &adc_trajectory);
+  TrajectoryAnalyzer trajectory_analyzer(&adc_trajectory);
+
+  auto nearest_index = [&xs, &ys](const double x, const double y) {
+    size_t index_min = 0;
+    double d_min = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < xs.size(); ++i) {
+      const double d = std::hypot(xs[i] - x, ys[i] - y);
+      if (d < d_min) {
+        d_min = d;
+        index_min = i;
+      }
+    }
+    return index_min;
+  };
+
+  // the position moves along the first turn, off the trajectory
+  for (int i = 0; i + 1 < kNumPoints / 2; ++i) {
+    const double angle = 4.0 * M_PI * (i + 0.3) / kNumPoints;
+    const double x = 10.5 * std::cos(angle);
+    const double y = 10.5 * std::sin(angle);
+    const TrajectoryPoint point =
+        trajectory_analyzer.QueryNearestPointByPosition(x, y);
+    const size_t index = nearest_index(x, y);
+    EXPECT_DOUBLE_EQ(xs[index], point.path_point().x());
+    EXPECT_DOUBLE_EQ(ys[index], point.path_point().y());
+
+    const PathPoint matched = trajectory_analyzer.QueryMatchedPathPoint(x, y);
+    EXPECT_NEAR(10.0, std::hypot(matched.x(), matched.y()), 0.01);
+    EXPECT_NEAR(10.0 * angle, matched.s(), 0.05);
+  }
+
+  // jumps to the other side of the circle
+  TrajectoryPoint point = trajectory_analyzer.QueryNearestPointByPosition(
+      -10.0, 0.0);
+  EXPECT_NEAR(-10.0, point.path_point().x(), 1e-6);
+  EXPECT_NEAR(0.0, point.path_point().y(), 1e-6);
+  point = trajectory_analyzer.QueryNearestPointByPosition(100.0, 0.0);
+  EXPECT_NEAR(13.0, point.path_point().x(), 1e-6);
+  EXPECT_NEAR(0.0, point.path_point().y(), 1e-6);
+}
+
 TEST_F(TrajectoryAnalyzerTest, ToTrajectoryFrame) {
   planning::ADCTrajectory adc_trajectory;
   std::vector<double> xs = {0.8, 0.9, 1.0, 1.1, 1.2};
@@ -25,6 +25,7 @@
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/log.h"
 #include "modules/common/time/time.h"
+#include "modules/common/trace/trace.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/control/common/control_gflags.h"
 
@@ -63,6 +64,9 @@ Status Control::Init() {
     buffer.ERROR(error_msg);
     return Status(ErrorCode::CONTROL_INIT_ERROR, error_msg);
   }
+  latency_monitor_ = LatencyMonitor(FLAGS_control_latency_report_period);
+  latency_analyzer_ =
+      common::trace::LatencyAnalyzer(FLAGS_end_to_end_latency_budget_ms);
 
   // lock it in case for after sub, init_vehicle not ready, but msg trigger
   // come
@@ -98,6 +102,9 @@ Status Control::Start() {
         << DrivingAction_Name(control_conf_.action());
   pad_msg_.set_action(control_conf_.action());
 
+  if (FLAGS_trigger_control_by_localization) {
+    AdapterManager::AddLocalizationCallback(&Control::OnLocalization, this);
+  }
   timer_ = AdapterManager::CreateTimer(
       ros::Duration(control_conf_.control_period()), &Control::OnTimer, this);
 
@@ -209,8 +216,32 @@ Status Control::ProduceControlCommand(ControlCommand *control_command) {
   return status;
 }
 
-void Control::OnTimer(const ros::TimerEvent &) {
+void Control::OnLocalization(const LocalizationEstimate &) {
+  // the controllers assume cycles of about control_period, so a faster
+  // localization does not trigger every time
+  if (Clock::NowInSeconds() - last_cycle_time_ <
+      0.5 * control_conf_.control_period()) {
+    return;
+  }
+  RunControlCycle(true, 0.0);
+}
+
+void Control::OnTimer(const ros::TimerEvent &event) {
+  // when triggered by localization, the timer only runs the cycles that
+  // localization is late for
+  if (FLAGS_trigger_control_by_localization &&
+      Clock::NowInSeconds() - last_cycle_time_ <
+          control_conf_.control_period()) {
+    return;
+  }
+  RunControlCycle(
+      false, (event.current_real - event.current_expected).toSec() * 1000);
+}
+
+void Control::RunControlCycle(const bool triggered_by_localization,
+                              const double timer_lateness_ms) {
   double start_timestamp = Clock::NowInSeconds();
+  last_cycle_time_ = start_timestamp;
 
   if (FLAGS_is_control_test_mode && FLAGS_control_test_duration > 0 &&
       (start_timestamp - init_time_) > FLAGS_control_test_duration) {
@@ -232,7 +263,24 @@ void Control::OnTimer(const ros::TimerEvent &) {
   }
 
   const double time_diff_ms = (end_timestamp - start_timestamp) * 1000;
-  control_command.mutable_latency_stats()->set_total_time_ms(time_diff_ms);
+  auto *latency_stats = control_command.mutable_latency_stats();
+  latency_stats->set_total_time_ms(time_diff_ms);
+  latency_stats->set_triggered_by_localization(triggered_by_localization);
+  if (!triggered_by_localization) {
+    latency_stats->set_timer_lateness_ms(timer_lateness_ms);
+  }
+  if (localization_.has_header()) {
+    latency_stats->set_localization_age_ms(
+        (start_timestamp - localization_.header().timestamp_sec()) * 1000);
+  }
+  if (chassis_.has_header()) {
+    latency_stats->set_chassis_age_ms(
+        (start_timestamp - chassis_.header().timestamp_sec()) * 1000);
+  }
+  if (trajectory_.has_header()) {
+    latency_stats->set_trajectory_age_ms(
+        (start_timestamp - trajectory_.header().timestamp_sec()) * 1000);
+  }
   ADEBUG << "control cycle time is: " << time_diff_ms << " ms.";
   status.Save(control_command.mutable_header()->mutable_status());
 
@@ -331,6 +379,28 @@ Status Control::CheckTimestamp() {
 void Control::SendCmd(ControlCommand *control_command) {
   // set header
   AdapterManager::FillControlCommandHeader(Name(), control_command);
+  common::trace::PropagateTrace(trajectory_.header(),
+                                control_command->mutable_header());
+
+  auto *latency_stats = control_command->mutable_latency_stats();
+  latency_stats->set_send_time_ms(
+      (Clock::NowInSeconds() - last_cycle_time_) * 1000);
+  if (latency_analyzer_.Analyze(control_command->header(),
+                                latency_stats->mutable_trace_latency())) {
+    const auto &trace_latency = latency_stats->trace_latency();
+    if (trace_latency.over_budget()) {
+      AWARN_EVERY_SEC(1.0) << "The command is " << trace_latency.total_ms()
+                           << " ms after the sensor data, over the budget of "
+                           << latency_analyzer_.budget_ms()
+                           << " ms: " << trace_latency.ShortDebugString();
+    }
+  } else {
+    latency_stats->clear_trace_latency();
+  }
+  LatencyReport report;
+  if (latency_monitor_.Add(last_cycle_time_, *latency_stats, &report)) {
+    latency_stats->mutable_report()->Swap(&report);
+  }
 
   ADEBUG << control_command->ShortDebugString();
   if (FLAGS_is_control_test_mode) {
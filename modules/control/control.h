@@ -30,7 +30,9 @@
 #include "modules/planning/proto/planning.pb.h"
 
 #include "modules/common/apollo_app.h"
+#include "modules/common/trace/latency_analyzer.h"
 #include "modules/common/util/util.h"
+#include "modules/control/common/latency_monitor.h"
 #include "modules/control/controller/controller_agent.h"
 
 /**
@@ -88,9 +90,17 @@ class Control : public apollo::common::ApolloApp {
   void OnMonitor(
       const apollo::common::monitor::MonitorMessage &monitor_message);
 
+  // Upon receiving localization message, when control is triggered by it
+  void OnLocalization(
+      const apollo::localization::LocalizationEstimate &localization);
+
   // Watch dog timer
   void OnTimer(const ros::TimerEvent &);
 
+  // timer_lateness_ms is only used for the cycles triggered by the timer
+  void RunControlCycle(const bool triggered_by_localization,
+                       const double timer_lateness_ms);
+
   common::Status ProduceControlCommand(ControlCommand *control_command);
   common::Status CheckInput();
   common::Status CheckTimestamp();
@@ -100,6 +110,7 @@ class Control : public apollo::common::ApolloApp {
 
  private:
   double init_time_ = 0.0;
+  double last_cycle_time_ = 0.0;
 
   localization::LocalizationEstimate localization_;
   canbus::Chassis chassis_;
@@ -107,6 +118,8 @@ class Control : public apollo::common::ApolloApp {
   PadMessage pad_msg_;
 
   ControllerAgent controller_agent_;
+  LatencyMonitor latency_monitor_;
+  common::trace::LatencyAnalyzer latency_analyzer_;
 
   bool estop_ = false;
   bool pad_received_ = false;
@@ -23,7 +23,9 @@
 #define MODULES_CONTROL_CONTROLLER_CONTROLLER_H_
 
 #include <cmath>
+#include <memory>
 #include <string>
+#include <utility>
 
 #include "modules/control/proto/control_cmd.pb.h"
 #include "modules/control/proto/control_conf.pb.h"
@@ -31,6 +33,7 @@
 #include "modules/planning/proto/planning.pb.h"
 
 #include "modules/common/status/status.h"
+#include "modules/control/common/trajectory_analyzer.h"
 
 /**
  * @namespace apollo::control
@@ -93,6 +96,42 @@ class Controller {
    * @brief stop controller
    */
   virtual void Stop() = 0;
+
+  /**
+   * @brief share the analyzer of the trajectory of the next
+   *        ComputeControlCommand() calls, so that the controllers do not
+   *        each build one
+   * @param trajectory_analyzer the analyzer, built from the trajectory
+   */
+  void SetTrajectoryAnalyzer(
+      std::shared_ptr<const TrajectoryAnalyzer> trajectory_analyzer) {
+    shared_trajectory_analyzer_ = std::move(trajectory_analyzer);
+  }
+
+ protected:
+  /**
+   * @brief get the analyzer of a trajectory: the shared one if it was built
+   *        from the trajectory, or else one built by the controller and kept
+   *        until the trajectory changes
+   * @param trajectory trajectory generated by planning
+   * @return the analyzer of the trajectory
+   */
+  const TrajectoryAnalyzer &GetTrajectoryAnalyzer(
+      const planning::ADCTrajectory *trajectory) {
+    if (shared_trajectory_analyzer_ != nullptr &&
+        shared_trajectory_analyzer_->Analyzes(*trajectory)) {
+      return *shared_trajectory_analyzer_;
+    }
+    if (own_trajectory_analyzer_ == nullptr ||
+        !own_trajectory_analyzer_->Analyzes(*trajectory)) {
+      own_trajectory_analyzer_.reset(new TrajectoryAnalyzer(trajectory));
+    }
+    return *own_trajectory_analyzer_;
+  }
+
+ private:
+  std::shared_ptr<const TrajectoryAnalyzer> shared_trajectory_analyzer_;
+  std::unique_ptr<TrajectoryAnalyzer> own_trajectory_analyzer_;
 };
 
 }  // namespace control
@@ -90,8 +90,15 @@ Status ControllerAgent::ComputeControlCommand(
     const localization::LocalizationEstimate *localization,
     const canbus::Chassis *chassis, const planning::ADCTrajectory *trajectory,
     control::ControlCommand *cmd) {
+  // planning publishes a trajectory every few control cycles, which is
+  // analyzed once for all the controllers
+  if (trajectory_analyzer_ == nullptr ||
+      !trajectory_analyzer_->Analyzes(*trajectory)) {
+    trajectory_analyzer_ = std::make_shared<TrajectoryAnalyzer>(trajectory);
+  }
   for (auto &controller : controller_list_) {
     ADEBUG << "controller:" << controller->Name() << " processing ...";
+    controller->SetTrajectoryAnalyzer(trajectory_analyzer_);
     double start_timestamp = Clock::NowInSeconds();
     controller->ComputeControlCommand(localization, chassis, trajectory, cmd);
     double end_timestamp = Clock::NowInSeconds();
@@ -100,6 +107,7 @@ Status ControllerAgent::ComputeControlCommand(
     ADEBUG << "controller: " << controller->Name()
            << " calculation time is: " << time_diff_ms << " ms.";
     cmd->mutable_latency_stats()->add_controller_time_ms(time_diff_ms);
+    cmd->mutable_latency_stats()->add_controller_name(controller->Name());
   }
   return Status::OK();
 }
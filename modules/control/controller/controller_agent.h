@@ -33,6 +33,7 @@
 #include "modules/planning/proto/planning.pb.h"
 
 #include "modules/common/util/factory.h"
+#include "modules/control/common/trajectory_analyzer.h"
 #include "modules/control/controller/controller.h"
 
 /**
@@ -90,6 +91,8 @@ class ControllerAgent {
   common::util::Factory<ControlConf::ControllerType, Controller>
       controller_factory_;
   std::vector<std::unique_ptr<Controller>> controller_list_;
+  // the analyzer of the latest trajectory, shared by the controllers
+  std::shared_ptr<const TrajectoryAnalyzer> trajectory_analyzer_;
 };
 
 }  // namespace control
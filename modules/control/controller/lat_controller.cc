@@ -221,6 +221,9 @@ Status LatController::Init(const ControlConf *control_conf) {
   InitializeFilters(control_conf);
   auto &lat_controller_conf = control_conf->lat_controller_conf();
   LoadLatGainScheduler(lat_controller_conf);
+  if (lat_controller_conf.enable_lqr_gain_schedule()) {
+    BuildLqrGainSchedule(lat_controller_conf);
+  }
   LogInitParameters();
   return Status::OK();
 }
@@ -255,6 +258,41 @@ void LatController::LoadLatGainScheduler(
       << "Fail to load heading error gain scheduler";
 }
 
+void LatController::BuildLqrGainSchedule(
+    const LatControllerConf &lat_controller_conf) {
+  const double max_speed = lat_controller_conf.lqr_gain_schedule_max_speed();
+  const double resolution = lat_controller_conf.lqr_gain_schedule_resolution();
+  // UpdateMatrix() uses 0.2 m/s for the lower speeds, so the schedule starts
+  // there and returns its first gains below it
+  const double min_speed = 0.2;
+  if (max_speed <= min_speed || resolution <= 0.0) {
+    AWARN << "Invalid lqr gain schedule, the gains are solved online";
+    return;
+  }
+  const int num_speeds =
+      static_cast<int>(std::ceil((max_speed - min_speed) / resolution - 1e-6)) +
+      1;
+  std::vector<Interpolation1D::DataType> gains(matrix_k_.cols());
+  for (int i = 0; i < num_speeds; ++i) {
+    const double speed = std::min(min_speed + i * resolution, max_speed);
+    SolveLqrGain(speed);
+    for (int j = 0; j < matrix_k_.cols(); ++j) {
+      gains[j].emplace_back(speed, matrix_k_(0, j));
+    }
+  }
+  matrix_k_.setZero();
+
+  lqr_gain_interpolations_.clear();
+  for (const auto &gain : gains) {
+    lqr_gain_interpolations_.emplace_back(new Interpolation1D);
+    CHECK(lqr_gain_interpolations_.back()->Init(gain))
+        << "Fail to build lqr gain schedule";
+  }
+  lqr_gain_schedule_max_speed_ = max_speed;
+  AINFO << "Lqr gain schedule solved at " << num_speeds << " speeds up to "
+        << max_speed << " m/s";
+}
+
 void LatController::Stop() {
   CloseLogFile();
 }
@@ -270,8 +308,7 @@ Status LatController::ComputeControlCommand(
     ControlCommand *cmd) {
   VehicleStateProvider::instance()->set_linear_velocity(chassis->speed_mps());
 
-  trajectory_analyzer_ =
-      std::move(TrajectoryAnalyzer(planning_published_trajectory));
+  trajectory_analyzer_ = &GetTrajectoryAnalyzer(planning_published_trajectory);
 
   SimpleLateralDebug *debug = cmd->mutable_debug()->mutable_simple_lat_debug();
   debug->Clear();
@@ -280,28 +317,16 @@ Status LatController::ComputeControlCommand(
   // Error Rate, preview lateral error1 , preview lateral error2, ...]
   UpdateStateAnalyticalMatching(debug);
 
-  UpdateMatrix();
-
-  // Compound discrete matrix with road preview model
-  UpdateMatrixCompound();
-
-  // Add gain sheduler for higher speed steering
-  if (FLAGS_enable_gain_scheduler) {
-    matrix_q_updated_(0, 0) =
-        matrix_q_(0, 0) *
-        lat_err_interpolation_->Interpolate(
-            VehicleStateProvider::instance()->linear_velocity());
-    matrix_q_updated_(2, 2) =
-        matrix_q_(2, 2) *
-        heading_err_interpolation_->Interpolate(
-            VehicleStateProvider::instance()->linear_velocity());
-    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_updated_,
-                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
-                                  &matrix_k_);
+  const double linear_velocity =
+      VehicleStateProvider::instance()->linear_velocity();
+  if (!lqr_gain_interpolations_.empty() &&
+      linear_velocity <= lqr_gain_schedule_max_speed_) {
+    for (int i = 0; i < matrix_k_.cols(); ++i) {
+      matrix_k_(0, i) = lqr_gain_interpolations_[i]->Interpolate(
+          linear_velocity);
+    }
   } else {
-    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_,
-                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
-                                  &matrix_k_);
+    SolveLqrGain(linear_velocity);
   }
 
   // feedback = - K * state
@@ -382,14 +407,14 @@ void LatController::UpdateStateAnalyticalMatching(SimpleLateralDebug *debug) {
     ComputeLateralErrors(0.0, 0.0, VehicleStateProvider::instance()->heading(),
                          VehicleStateProvider::instance()->linear_velocity(),
                          VehicleStateProvider::instance()->angular_velocity(),
-                         trajectory_analyzer_, debug);
+                         *trajectory_analyzer_, debug);
   } else {
     const auto &com = VehicleStateProvider::instance()->ComputeCOMPosition(lr_);
     ComputeLateralErrors(com.x(), com.y(),
                          VehicleStateProvider::instance()->heading(),
                          VehicleStateProvider::instance()->linear_velocity(),
                          VehicleStateProvider::instance()->angular_velocity(),
-                         trajectory_analyzer_, debug);
+                         *trajectory_analyzer_, debug);
   }
 
   // Reverse heading error if vehicle is going in reverse
@@ -409,10 +434,11 @@ void LatController::UpdateStateAnalyticalMatching(SimpleLateralDebug *debug) {
   for (int i = 0; i < preview_window_; ++i) {
     const double preview_time = ts_ * (i + 1);
     const auto preview_point =
-        trajectory_analyzer_.QueryNearestPointByRelativeTime(preview_time);
+        trajectory_analyzer_->QueryNearestPointByRelativeTime(preview_time);
 
-    const auto matched_point = trajectory_analyzer_.QueryNearestPointByPosition(
-        preview_point.path_point().x(), preview_point.path_point().y());
+    const auto matched_point =
+        trajectory_analyzer_->QueryNearestPointByPosition(
+            preview_point.path_point().x(), preview_point.path_point().y());
 
     const double dx =
         preview_point.path_point().x() - matched_point.path_point().x();
@@ -430,9 +456,31 @@ void LatController::UpdateStateAnalyticalMatching(SimpleLateralDebug *debug) {
   }
 }
 
-void LatController::UpdateMatrix() {
-  const double v =
-      std::max(VehicleStateProvider::instance()->linear_velocity(), 0.2);
+void LatController::SolveLqrGain(const double linear_velocity) {
+  UpdateMatrix(linear_velocity);
+
+  // Compound discrete matrix with road preview model
+  UpdateMatrixCompound();
+
+  // Add gain sheduler for higher speed steering
+  if (FLAGS_enable_gain_scheduler) {
+    matrix_q_updated_(0, 0) =
+        matrix_q_(0, 0) * lat_err_interpolation_->Interpolate(linear_velocity);
+    matrix_q_updated_(2, 2) =
+        matrix_q_(2, 2) *
+        heading_err_interpolation_->Interpolate(linear_velocity);
+    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_updated_,
+                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
+                                  &matrix_k_);
+  } else {
+    common::math::SolveLQRProblem(matrix_adc_, matrix_bdc_, matrix_q_,
+                                  matrix_r_, lqr_eps_, lqr_max_iteration_,
+                                  &matrix_k_);
+  }
+}
+
+void LatController::UpdateMatrix(const double linear_velocity) {
+  const double v = std::max(linear_velocity, 0.2);
   matrix_a_(1, 1) = matrix_a_coeff_(1, 1) / v;
   matrix_a_(1, 3) = matrix_a_coeff_(1, 3) / v;
   matrix_a_(3, 1) = matrix_a_coeff_(3, 1) / v;
@@ -479,7 +527,7 @@ double LatController::ComputeFeedForward(double ref_curvature) const {
 double LatController::GetLateralError(const common::math::Vec2d &point,
                                       TrajectoryPoint *traj_point) const {
   const auto closest =
-      trajectory_analyzer_.QueryNearestPointByPosition(point.x(), point.y());
+      trajectory_analyzer_->QueryNearestPointByPosition(point.x(), point.y());
 
   const double point_angle = std::atan2(point.y() - closest.path_point().y(),
                                         point.x() - closest.path_point().x());
@@ -25,6 +25,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "Eigen/Core"
 
@@ -104,10 +105,16 @@ class LatController : public Controller {
  protected:
   void UpdateStateAnalyticalMatching(SimpleLateralDebug *debug);
 
-  void UpdateMatrix();
+  void UpdateMatrix(const double linear_velocity);
 
   void UpdateMatrixCompound();
 
+  // solves the lqr gain matrix_k_ at the speed
+  void SolveLqrGain(const double linear_velocity);
+
+  // solves the lqr gains on the speed grid of the gain schedule
+  void BuildLqrGainSchedule(const LatControllerConf &lat_controller_conf);
+
   double ComputeFeedForward(double ref_curvature) const;
 
   double GetLateralError(
@@ -131,7 +138,8 @@ class LatController : public Controller {
   common::VehicleParam vehicle_param_;
 
   // a proxy to analyze the planning trajectory
-  TrajectoryAnalyzer trajectory_analyzer_;
+  // the analyzer of the trajectory of the current cycle
+  const TrajectoryAnalyzer *trajectory_analyzer_ = nullptr;
 
   // the following parameters are vehicle physics related.
   // control time interval
@@ -219,6 +227,12 @@ class LatController : public Controller {
 
   std::unique_ptr<Interpolation1D> heading_err_interpolation_;
 
+  // lqr gain schedule over speed, one interpolation per column of matrix_k_;
+  // empty when the gains are solved online
+  std::vector<std::unique_ptr<Interpolation1D>> lqr_gain_interpolations_;
+  // the maximum speed of the gain schedule
+  double lqr_gain_schedule_max_speed_ = 0.0;
+
   // MeanFilter heading_rate_filter_;
   common::MeanFilter lateral_error_filter_;
   common::MeanFilter heading_error_filter_;
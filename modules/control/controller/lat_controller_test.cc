@@ -16,9 +16,11 @@
 
 #include "modules/control/controller/lat_controller.h"
 
+#include <cmath>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -46,10 +48,9 @@ class LatControllerTest : public ::testing::Test, LatController {
     FLAGS_v = 3;
     std::string control_conf_file =
         "modules/control/testdata/conf/lincoln.pb.txt";
-    ControlConf control_conf;
     CHECK(apollo::common::util::GetProtoFromFile(control_conf_file,
-                                                 &control_conf));
-    lateral_conf_ = control_conf.lat_controller_conf();
+                                                 &control_conf_));
+    lateral_conf_ = control_conf_.lat_controller_conf();
 
     timestamp_ = Clock::NowInSeconds();
   }
@@ -62,6 +63,22 @@ class LatControllerTest : public ::testing::Test, LatController {
                                         trajectory_analyzer, debug);
   }
 
+  common::Status Init(const ControlConf *control_conf) {
+    return LatController::Init(control_conf);
+  }
+
+  // the lqr gains solved at the speed, and interpolated from the schedule
+  void GetLqrGains(const double speed, std::vector<double> *solved_gains,
+                   std::vector<double> *scheduled_gains) {
+    SolveLqrGain(speed);
+    solved_gains->assign(matrix_k_.data(),
+                         matrix_k_.data() + matrix_k_.size());
+    scheduled_gains->clear();
+    for (const auto &interpolation : lqr_gain_interpolations_) {
+      scheduled_gains->push_back(interpolation->Interpolate(speed));
+    }
+  }
+
  protected:
   LocalizationPb LoadLocalizaionPb(const std::string &filename) {
     LocalizationPb localization_pb;
@@ -88,6 +105,7 @@ class LatControllerTest : public ::testing::Test, LatController {
     return std::move(planning_trajectory_pb);
   }
 
+  ControlConf control_conf_;
   LatControllerConf lateral_conf_;
 
   double timestamp_ = 0.0;
@@ -131,5 +149,25 @@ TEST_F(LatControllerTest, ComputeLateralErrors) {
   EXPECT_NEAR(debug->curvature(), matched_kappa_expected, 0.001);
 }
 
+TEST_F(LatControllerTest, LqrGainSchedule) {
+  auto *lat_controller_conf = control_conf_.mutable_lat_controller_conf();
+  lat_controller_conf->set_enable_lqr_gain_schedule(true);
+  lat_controller_conf->set_lqr_gain_schedule_max_speed(10.0);
+  ASSERT_TRUE(Init(&control_conf_).ok());
+
+  // the interpolated gains between the grid speeds follow the solved ones
+  std::vector<double> solved_gains;
+  std::vector<double> scheduled_gains;
+  for (const double speed : {0.1, 0.45, 1.3, 5.75, 9.9}) {
+    GetLqrGains(speed, &solved_gains, &scheduled_gains);
+    ASSERT_EQ(solved_gains.size(), scheduled_gains.size());
+    for (size_t i = 0; i < solved_gains.size(); ++i) {
+      EXPECT_NEAR(solved_gains[i], scheduled_gains[i],
+                  0.01 * std::abs(solved_gains[i]) + 1e-6)
+          << "speed " << speed << " gain " << i;
+    }
+  }
+}
+
 }  // namespace control
 }  // namespace apollo
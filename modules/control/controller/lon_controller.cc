@@ -155,11 +155,7 @@ Status LonController::ComputeControlCommand(
                   "Fail to initialize calibration table.");
   }
 
-  if (trajectory_analyzer_ == nullptr ||
-      trajectory_analyzer_->seq_num() !=
-          trajectory_message_->header().sequence_num()) {
-    trajectory_analyzer_.reset(new TrajectoryAnalyzer(trajectory_message_));
-  }
+  trajectory_analyzer_ = &GetTrajectoryAnalyzer(trajectory_message_);
   const LonControllerConf &lon_controller_conf =
       control_conf_->lon_controller_conf();
 
@@ -177,7 +173,7 @@ Status LonController::ComputeControlCommand(
     AERROR << error_msg;
     return Status(ErrorCode::CONTROL_COMPUTE_ERROR, error_msg);
   }
-  ComputeLongitudinalErrors(trajectory_analyzer_.get(), preview_time, debug);
+  ComputeLongitudinalErrors(trajectory_analyzer_, preview_time, debug);
 
   double station_error_limit = lon_controller_conf.station_error_limit();
   double station_error_limited = 0.0;
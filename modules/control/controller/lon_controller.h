@@ -118,7 +118,8 @@ class LonController : public Controller {
 
   std::unique_ptr<Interpolation2D> control_interpolation_;
   const planning::ADCTrajectory *trajectory_message_ = nullptr;
-  std::unique_ptr<TrajectoryAnalyzer> trajectory_analyzer_;
+  // the analyzer of the trajectory of the current cycle
+  const TrajectoryAnalyzer *trajectory_analyzer_ = nullptr;
 
   std::string name_;
   bool controller_initialized_ = false;
@@ -272,13 +272,12 @@ Status MPCController::ComputeControlCommand(
   VehicleStateProvider::instance()->set_linear_velocity(
       std::max(chassis->speed_mps(), kMinSpeedProtection));
 
-  trajectory_analyzer_ =
-      std::move(TrajectoryAnalyzer(planning_published_trajectory));
+  trajectory_analyzer_ = &GetTrajectoryAnalyzer(planning_published_trajectory);
 
   SimpleMPCDebug *debug = cmd->mutable_debug()->mutable_simple_mpc_debug();
   debug->Clear();
 
-  ComputeLongitudinalErrors(&trajectory_analyzer_, debug);
+  ComputeLongitudinalErrors(trajectory_analyzer_, debug);
 
   // Update state
   UpdateStateAnalyticalMatching(debug);
@@ -327,7 +326,14 @@ Status MPCController::ComputeControlCommand(
   upper_bound << steer_single_direction_max_degree_,
       vehicle_param_.max_acceleration();
 
-  std::vector<Eigen::MatrixXd> control(horizon_, control_matrix);
+  // warm start the solver from the last solution shifted by one cycle
+  std::vector<Eigen::MatrixXd> &control = control_sequence_;
+  if (control.size() != static_cast<size_t>(horizon_)) {
+    control.assign(horizon_, control_matrix);
+  } else {
+    std::rotate(control.begin(), control.begin() + 1, control.end());
+    control.back() = control_matrix;
+  }
 
   double mpc_start_timestamp = Clock::NowInSeconds();
   if (common::math::SolveLinearMPC(
@@ -335,6 +341,7 @@ Status MPCController::ComputeControlCommand(
           matrix_r_updated_, lower_bound, upper_bound, matrix_state_, reference,
           mpc_eps_, mpc_max_iteration_, &control) != true) {
     AERROR << "MPC solver failed";
+    control.assign(horizon_, control_matrix);
   }
 
   double mpc_end_timestamp = Clock::NowInSeconds();
@@ -431,6 +438,7 @@ Status MPCController::ComputeControlCommand(
 Status MPCController::Reset() {
   previous_heading_error_ = 0.0;
   previous_lateral_error_ = 0.0;
+  control_sequence_.clear();
   return Status::OK();
 }
 
@@ -457,7 +465,7 @@ void MPCController::UpdateStateAnalyticalMatching(SimpleMPCDebug *debug) {
                        VehicleStateProvider::instance()->heading(),
                        VehicleStateProvider::instance()->linear_velocity(),
                        VehicleStateProvider::instance()->angular_velocity(),
-                       trajectory_analyzer_, debug);
+                       *trajectory_analyzer_, debug);
 
   // State matrix update;
   matrix_state_(0, 0) = debug->lateral_error();
@@ -492,7 +500,7 @@ void MPCController::UpdateMatrix() {
 double MPCController::GetLateralError(const common::math::Vec2d &point,
                                       TrajectoryPoint *traj_point) const {
   const auto closest =
-      trajectory_analyzer_.QueryNearestPointByPosition(point.x(), point.y());
+      trajectory_analyzer_->QueryNearestPointByPosition(point.x(), point.y());
 
   const double point_angle = std::atan2(point.y() - closest.path_point().y(),
                                         point.x() - closest.path_point().x());
@@ -25,6 +25,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "Eigen/Core"
 
@@ -133,7 +134,8 @@ class MPCController : public Controller {
   common::VehicleParam vehicle_param_;
 
   // a proxy to analyze the planning trajectory
-  TrajectoryAnalyzer trajectory_analyzer_;
+  // the analyzer of the trajectory of the current cycle
+  const TrajectoryAnalyzer *trajectory_analyzer_ = nullptr;
 
   void LoadControlCalibrationTable(
       const MPCControllerConf &mpc_controller_conf);
@@ -230,6 +232,9 @@ class MPCController : public Controller {
   // parameters for mpc solver; threshold for computation
   double mpc_eps_ = 0.0;
 
+  // control sequence solved in the last cycle, the warm start of the next
+  std::vector<Eigen::MatrixXd> control_sequence_;
+
   common::DigitalFilter digital_filter_;
 
   std::unique_ptr<Interpolation1D> lat_err_interpolation_;
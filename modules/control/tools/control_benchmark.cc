@@ -0,0 +1,328 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file control_benchmark.cc
+ * @brief Replays recorded localization, chassis and planning messages
+ * through ControllerAgent::ComputeControlCommand() as fast as possible, one
+ * agent per controller, and reports the latency of every step and the
+ * tracking errors of every controller.
+ *
+ * \par
+ * A step is run upon every recorded localization, with the latest recorded
+ * chassis and trajectory, and the clock mocked to the localization time.
+ * The replay is open loop: the vehicle follows the recorded states, not the
+ * commands, so the tracking errors compare the controllers on the same
+ * inputs rather than predict how the vehicle would drive.
+ *
+ * \par
+ * bazel run //modules/control/tools:control_benchmark --
+ *     --benchmark_recordings=/data/bag/a.bag,/data/bag/b.bag
+ *     --benchmark_controllers=LAT_CONTROLLER,LON_CONTROLLER,MPC_CONTROLLER
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "rosbag/bag.h"
+#include "rosbag/view.h"
+
+#include "modules/canbus/proto/chassis.pb.h"
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/time/time.h"
+#include "modules/common/util/file.h"
+#include "modules/common/util/string_tokenizer.h"
+#include "modules/common/vehicle_state/vehicle_state_provider.h"
+#include "modules/control/common/control_gflags.h"
+#include "modules/control/controller/controller_agent.h"
+#include "modules/control/proto/control_cmd.pb.h"
+#include "modules/control/proto/control_conf.pb.h"
+#include "modules/localization/proto/localization.pb.h"
+#include "modules/planning/proto/planning.pb.h"
+
+DEFINE_string(benchmark_recordings, "",
+              "Comma separated rosbag files of recorded localization, chassis "
+              "and planning messages.");
+DEFINE_string(benchmark_controllers,
+              "LAT_CONTROLLER,LON_CONTROLLER,MPC_CONTROLLER",
+              "Comma separated controllers to benchmark.");
+DEFINE_int32(benchmark_num_iterations, 5,
+             "The number of times all the steps are replayed.");
+DEFINE_int32(benchmark_num_warmup_iterations, 1,
+             "The number of replays before the measured ones.");
+
+namespace apollo {
+namespace control {
+
+using apollo::canbus::Chassis;
+using apollo::common::VehicleStateProvider;
+using apollo::common::time::Clock;
+using apollo::localization::LocalizationEstimate;
+using apollo::planning::ADCTrajectory;
+
+namespace {
+
+struct Step {
+  LocalizationEstimate localization;
+  Chassis chassis;
+  // index in the recorded trajectories
+  size_t trajectory_index = 0;
+};
+
+// Drops the trajectories that the control module does not follow, and
+// zeroes the speeds below the resolution, as Control::CheckInput() does.
+bool PrepareTrajectory(const ControlConf& control_conf,
+                       ADCTrajectory* trajectory) {
+  if (trajectory->estop().is_estop() ||
+      trajectory->trajectory_point_size() == 0) {
+    return false;
+  }
+  for (auto& trajectory_point : *trajectory->mutable_trajectory_point()) {
+    if (trajectory_point.v() < control_conf.minimum_speed_resolution()) {
+      trajectory_point.set_v(0.0);
+      trajectory_point.set_a(0.0);
+    }
+  }
+  return true;
+}
+
+bool LoadRecording(const std::string& recording,
+                   const ControlConf& control_conf, std::vector<Step>* steps,
+                   std::vector<ADCTrajectory>* trajectories) {
+  rosbag::Bag bag;
+  try {
+    bag.open(recording, rosbag::bagmode::Read);
+  } catch (const rosbag::BagException& e) {
+    AERROR << "Failed to open " << recording << ": " << e.what();
+    return false;
+  }
+  rosbag::View view(bag, rosbag::TopicQuery(std::vector<std::string>{
+                             FLAGS_localization_topic, FLAGS_chassis_topic,
+                             FLAGS_planning_trajectory_topic}));
+
+  // the steps of a recording never use the trajectory of another one
+  const size_t first_trajectory = trajectories->size();
+  Chassis chassis;
+  bool has_chassis = false;
+  for (const rosbag::MessageInstance& message : view) {
+    if (message.getTopic() == FLAGS_chassis_topic) {
+      const auto recorded_chassis = message.instantiate<Chassis>();
+      if (recorded_chassis != nullptr) {
+        chassis = *recorded_chassis;
+        has_chassis = true;
+      }
+    } else if (message.getTopic() == FLAGS_planning_trajectory_topic) {
+      const auto trajectory = message.instantiate<ADCTrajectory>();
+      if (trajectory != nullptr) {
+        trajectories->push_back(*trajectory);
+        if (!PrepareTrajectory(control_conf, &trajectories->back())) {
+          trajectories->pop_back();
+        }
+      }
+    } else {
+      const auto localization = message.instantiate<LocalizationEstimate>();
+      if (localization == nullptr || !has_chassis ||
+          trajectories->size() == first_trajectory) {
+        continue;
+      }
+      steps->emplace_back();
+      steps->back().localization = *localization;
+      steps->back().chassis = chassis;
+      steps->back().trajectory_index = trajectories->size() - 1;
+    }
+  }
+  bag.close();
+  AINFO << "Loaded " << recording;
+  return true;
+}
+
+// Absolute tracking errors of the controller in the command
+void CollectErrors(const ControlConf::ControllerType controller_type,
+                   const ControlCommand& control_command,
+                   std::map<std::string, std::vector<double>>* errors) {
+  const auto& debug = control_command.debug();
+  switch (controller_type) {
+    case ControlConf::LAT_CONTROLLER:
+      (*errors)["lateral error (m)"].push_back(
+          std::fabs(debug.simple_lat_debug().lateral_error()));
+      (*errors)["heading error (rad)"].push_back(
+          std::fabs(debug.simple_lat_debug().heading_error()));
+      break;
+    case ControlConf::LON_CONTROLLER:
+      (*errors)["station error (m)"].push_back(
+          std::fabs(debug.simple_lon_debug().station_error()));
+      (*errors)["speed error (m/s)"].push_back(
+          std::fabs(debug.simple_lon_debug().speed_error()));
+      break;
+    case ControlConf::MPC_CONTROLLER:
+      (*errors)["lateral error (m)"].push_back(
+          std::fabs(debug.simple_mpc_debug().lateral_error()));
+      (*errors)["heading error (rad)"].push_back(
+          std::fabs(debug.simple_mpc_debug().heading_error()));
+      (*errors)["station error (m)"].push_back(
+          std::fabs(debug.simple_mpc_debug().station_error()));
+      (*errors)["speed error (m/s)"].push_back(
+          std::fabs(debug.simple_mpc_debug().speed_error()));
+      break;
+    default:
+      break;
+  }
+}
+
+double Percentile(const std::vector<double>& sorted_values,
+                  const double percentile) {
+  if (sorted_values.empty()) {
+    return 0.0;
+  }
+  const std::size_t index = static_cast<std::size_t>(
+      percentile * (sorted_values.size() - 1) + 0.5);
+  return sorted_values[std::min(index, sorted_values.size() - 1)];
+}
+
+void PrintStats(const std::string& name, std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  double sum = 0.0;
+  for (const double value : values) {
+    sum += value;
+  }
+  const double mean = values.empty() ? 0.0 : sum / values.size();
+  std::printf("%-32s %8zu %10.3f %10.3f %10.3f %10.3f\n", name.c_str(),
+              values.size(), mean, Percentile(values, 0.5),
+              Percentile(values, 0.99),
+              values.empty() ? 0.0 : values.back());
+}
+
+bool BenchmarkController(const ControlConf& control_conf,
+                         const ControlConf::ControllerType controller_type,
+                         const std::vector<Step>& steps,
+                         const std::vector<ADCTrajectory>& trajectories) {
+  ControlConf agent_conf = control_conf;
+  agent_conf.clear_active_controllers();
+  agent_conf.add_active_controllers(controller_type);
+  // the agent registers either the LQR and PID controllers or the MPC one
+  FLAGS_use_mpc = controller_type == ControlConf::MPC_CONTROLLER;
+  ControllerAgent controller_agent;
+  if (!controller_agent.Init(&agent_conf).ok()) {
+    AERROR << "Failed to init "
+           << ControlConf::ControllerType_Name(controller_type);
+    return false;
+  }
+
+  // the latency is measured on the steady clock, as the clock of the
+  // controllers is mocked to the recorded time
+  std::vector<double> step_time_ms;
+  std::map<std::string, std::vector<double>> errors;
+  const int num_iterations =
+      FLAGS_benchmark_num_warmup_iterations + FLAGS_benchmark_num_iterations;
+  for (int iteration = 0; iteration < num_iterations; ++iteration) {
+    const bool is_measured =
+        iteration >= FLAGS_benchmark_num_warmup_iterations;
+    controller_agent.Reset();
+    for (const auto& step : steps) {
+      Clock::SetNow(common::time::From(
+                        step.localization.header().timestamp_sec())
+                        .time_since_epoch());
+      VehicleStateProvider::instance()->Update(step.localization,
+                                               step.chassis);
+      ControlCommand control_command;
+      const auto start_time = std::chrono::steady_clock::now();
+      controller_agent.ComputeControlCommand(
+          &step.localization, &step.chassis,
+          &trajectories[step.trajectory_index], &control_command);
+      const auto end_time = std::chrono::steady_clock::now();
+      if (!is_measured) {
+        continue;
+      }
+      step_time_ms.push_back(
+          std::chrono::duration<double, std::milli>(end_time - start_time)
+              .count());
+      CollectErrors(controller_type, control_command, &errors);
+    }
+  }
+
+  std::printf("%s\n",
+              ControlConf::ControllerType_Name(controller_type).c_str());
+  PrintStats("step time (ms)", step_time_ms);
+  for (const auto& error : errors) {
+    PrintStats(error.first, error.second);
+  }
+  return true;
+}
+
+int RunBenchmark() {
+  ControlConf control_conf;
+  if (!common::util::GetProtoFromFile(FLAGS_control_conf_file,
+                                      &control_conf)) {
+    AERROR << "Failed to load " << FLAGS_control_conf_file;
+    return EXIT_FAILURE;
+  }
+  std::vector<ControlConf::ControllerType> controller_types;
+  for (const auto& name : common::util::StringTokenizer::Split(
+           FLAGS_benchmark_controllers, ",")) {
+    ControlConf::ControllerType controller_type;
+    if (!ControlConf::ControllerType_Parse(name, &controller_type)) {
+      AERROR << "Unknown controller " << name;
+      return EXIT_FAILURE;
+    }
+    controller_types.push_back(controller_type);
+  }
+
+  std::vector<Step> steps;
+  std::vector<ADCTrajectory> trajectories;
+  for (const auto& recording : common::util::StringTokenizer::Split(
+           FLAGS_benchmark_recordings, ",")) {
+    if (!LoadRecording(recording, control_conf, &steps, &trajectories)) {
+      return EXIT_FAILURE;
+    }
+  }
+  if (steps.empty()) {
+    AERROR << "No step found in --benchmark_recordings.";
+    return EXIT_FAILURE;
+  }
+
+  Clock::SetMode(Clock::MOCK);
+  std::printf("%zu steps, %zu trajectories, %d iterations\n", steps.size(),
+              trajectories.size(), FLAGS_benchmark_num_iterations);
+  std::printf("%-32s %8s %10s %10s %10s %10s\n", "", "count", "mean", "p50",
+              "p99", "max");
+  for (const auto controller_type : controller_types) {
+    if (!BenchmarkController(control_conf, controller_type, steps,
+                             trajectories)) {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace control
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  return apollo::control::RunBenchmark();
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Writes the DriveIndex of the bags of a drive next to them, for the
+ * tools to find their messages with DriveIndexReader.
+ */
+
+#include <string>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/proto/drive_event.pb.h"
+#include "modules/common/util/file.h"
+#include "modules/data/proto/drive_index.pb.h"
+#include "modules/data/util/bag_index.h"
+#include "modules/data/util/drive_index_reader.h"
+#include "modules/data/util/info_collector.h"
+
+DEFINE_string(bag_dir, "", "The directory of the bags to index.");
+DEFINE_string(drive_index_file, "drive_index.bin",
+              "The name of the index written in the directory of the bags.");
+
+namespace apollo {
+namespace data {
+namespace {
+
+using apollo::common::DriveEvent;
+using apollo::common::util::SetProtoToBinaryFile;
+
+int IndexDrive() {
+  DriveIndex index;
+  if (IndexBags(FLAGS_bag_dir, &index) == 0) {
+    AERROR << "No closed bag to index in " << FLAGS_bag_dir;
+    return -1;
+  }
+  *index.mutable_static_info() = InfoCollector::GetStaticInfo();
+
+  // The drive events are few, and read from the chunks which have them.
+  const DriveIndexReader reader(index, FLAGS_bag_dir);
+  const double end_time = index.bag(index.bag_size() - 1).end_time_sec();
+  if (reader.ReadMessages(
+          0.0, end_time, {FLAGS_drive_event_topic},
+          [&index](const rosbag::MessageInstance &message) {
+            const auto event = message.instantiate<DriveEvent>();
+            if (event != nullptr) {
+              *index.add_drive_event() = *event;
+            }
+          }) < 0) {
+    return -1;
+  }
+
+  const std::string index_file =
+      FLAGS_bag_dir + "/" + FLAGS_drive_index_file;
+  if (!SetProtoToBinaryFile(index, index_file)) {
+    AERROR << "Failed to write " << index_file;
+    return -1;
+  }
+  AINFO << "Indexed " << index.bag_size() << " bags and "
+        << index.drive_event_size() << " drive events in " << index_file;
+  return 0;
+}
+
+}  // namespace
+}  // namespace data
+}  // namespace apollo
+
+int main(int argc, char **argv) {
+  google::InitGoogleLogging(argv[0]);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  return apollo::data::IndexDrive();
+}
@@ -424,8 +424,17 @@ class DataRecorderManager(object):
         timer_publish.shutdown()
         for worker in self.worker_list:
             worker.join()
+        self.index_drive(rosbag_path)
         return 0
 
+    def index_drive(self, bag_path):
+        """Write the time index of the recorded bags next to them."""
+        cmd = "bazel-bin/modules/data/tools/drive_indexer --bag_dir=" + bag_path
+        ret, rst = commands.getstatusoutput(cmd)
+        if ret != 0:
+            logging.warn("Failed to index the bags in %s, %s", bag_path, rst)
+        return ret
+
     def shutdown_hook(self, signum, frame):
         """Handle signal."""
         logging.info("Catch signal, signum=%s", str(signum))
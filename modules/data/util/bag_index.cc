@@ -0,0 +1,325 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/data/util/bag_index.h"
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace data {
+namespace {
+
+// The records of the bag format 2.0, see
+// http://wiki.ros.org/Bags/Format/2.0.
+constexpr char kBagMagic[] = "#ROSBAG V2.0\n";
+constexpr size_t kBagMagicSize = sizeof(kBagMagic) - 1;
+constexpr uint8_t kOpBagHeader = 0x03;
+constexpr uint8_t kOpChunkInfo = 0x06;
+constexpr uint8_t kOpConnection = 0x07;
+constexpr char kBagExtension[] = ".bag";
+
+using Fields = std::unordered_map<std::string, std::string>;
+
+struct Record {
+  Fields header;
+  std::string data;
+};
+
+bool ReadUint32(std::istream *stream, uint32_t *value) {
+  unsigned char bytes[4];
+  if (!stream->read(reinterpret_cast<char *>(bytes), sizeof(bytes))) {
+    return false;
+  }
+  *value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+           (static_cast<uint32_t>(bytes[3]) << 24);
+  return true;
+}
+
+uint32_t GetUint32(const std::string &bytes, const size_t pos) {
+  const auto *data = reinterpret_cast<const unsigned char *>(bytes.data());
+  return data[pos] | (data[pos + 1] << 8) | (data[pos + 2] << 16) |
+         (static_cast<uint32_t>(data[pos + 3]) << 24);
+}
+
+uint64_t GetUint64(const std::string &bytes) {
+  return GetUint32(bytes, 0) |
+         (static_cast<uint64_t>(GetUint32(bytes, 4)) << 32);
+}
+
+// The times are the seconds and the nanoseconds, both uint32.
+double GetTime(const std::string &bytes) {
+  return GetUint32(bytes, 0) + GetUint32(bytes, 4) * 1e-9;
+}
+
+// Parses the fields of a header, each one a length and then name=value.
+bool ParseFields(const std::string &bytes, Fields *fields) {
+  fields->clear();
+  size_t pos = 0;
+  while (pos + 4 <= bytes.size()) {
+    const uint32_t size = GetUint32(bytes, pos);
+    pos += 4;
+    if (size > bytes.size() - pos) {
+      return false;
+    }
+    const size_t separator = bytes.find('=', pos);
+    if (separator == std::string::npos || separator >= pos + size) {
+      return false;
+    }
+    (*fields)[bytes.substr(pos, separator - pos)] =
+        bytes.substr(separator + 1, pos + size - separator - 1);
+    pos += size;
+  }
+  return pos == bytes.size();
+}
+
+// The sizes are checked against the one of the file, for a broken bag not to
+// make huge strings.
+bool ReadRecord(std::istream *stream, const uint64_t file_size,
+                Record *record) {
+  uint32_t size = 0;
+  std::string header;
+  if (!ReadUint32(stream, &size) || size > file_size) {
+    return false;
+  }
+  header.resize(size);
+  if (!stream->read(&header[0], size) ||
+      !ParseFields(header, &record->header) || !ReadUint32(stream, &size) ||
+      size > file_size) {
+    return false;
+  }
+  record->data.resize(size);
+  return static_cast<bool>(stream->read(&record->data[0], size));
+}
+
+// Checks the op of a record, and the sizes of the fields to be read.
+bool CheckRecord(const Record &record, const uint8_t op,
+                 const std::map<std::string, size_t> &field_sizes) {
+  const auto op_field = record.header.find("op");
+  if (op_field == record.header.end() || op_field->second.size() != 1 ||
+      static_cast<uint8_t>(op_field->second[0]) != op) {
+    return false;
+  }
+  for (const auto &field_size : field_sizes) {
+    const auto field = record.header.find(field_size.first);
+    if (field == record.header.end() ||
+        (field_size.second > 0 && field->second.size() != field_size.second)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool EndsWith(const std::string &text, const std::string &suffix) {
+  return text.size() >= suffix.size() &&
+         text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}  // namespace
+
+bool IndexBag(const std::string &bag_file, BagIndex *index) {
+  index->Clear();
+  std::ifstream stream(bag_file, std::ios::binary | std::ios::ate);
+  const uint64_t file_size = stream.tellg();
+  stream.seekg(0);
+  char magic[kBagMagicSize];
+  if (!stream.read(magic, kBagMagicSize) ||
+      std::memcmp(magic, kBagMagic, kBagMagicSize) != 0) {
+    AERROR << "Not a bag of format 2.0: " << bag_file;
+    return false;
+  }
+
+  Record record;
+  if (!ReadRecord(&stream, file_size, &record) ||
+      !CheckRecord(record, kOpBagHeader,
+                   {{"index_pos", 8}, {"conn_count", 4}, {"chunk_count", 4}})) {
+    AERROR << "Failed to read the header of " << bag_file;
+    return false;
+  }
+  const uint64_t index_pos = GetUint64(record.header["index_pos"]);
+  const uint32_t conn_count = GetUint32(record.header["conn_count"], 0);
+  const uint32_t chunk_count = GetUint32(record.header["chunk_count"], 0);
+  if (index_pos == 0) {
+    AERROR << "The bag has not been closed: " << bag_file;
+    return false;
+  }
+  stream.seekg(index_pos);
+
+  // The topics by connection, several connections having the same topic
+  // when it has several publishers.
+  std::unordered_map<uint32_t, TopicIndex *> topic_of_connection;
+  std::map<std::string, TopicIndex> topics;
+  for (uint32_t i = 0; i < conn_count; ++i) {
+    Fields connection_header;
+    if (!ReadRecord(&stream, file_size, &record) ||
+        !CheckRecord(record, kOpConnection, {{"conn", 4}, {"topic", 0}}) ||
+        !ParseFields(record.data, &connection_header)) {
+      AERROR << "Failed to read the connections of " << bag_file;
+      return false;
+    }
+    TopicIndex *topic = &topics[record.header["topic"]];
+    topic->set_topic(record.header["topic"]);
+    topic->set_message_type(connection_header["type"]);
+    topic_of_connection[GetUint32(record.header["conn"], 0)] = topic;
+  }
+
+  double start_time = 0.0;
+  double end_time = 0.0;
+  for (uint32_t i = 0; i < chunk_count; ++i) {
+    if (!ReadRecord(&stream, file_size, &record) ||
+        !CheckRecord(record, kOpChunkInfo,
+                     {{"chunk_pos", 8},
+                      {"start_time", 8},
+                      {"end_time", 8},
+                      {"count", 4}}) ||
+        record.data.size() != GetUint32(record.header["count"], 0) * 8u) {
+      AERROR << "Failed to read the chunk infos of " << bag_file;
+      return false;
+    }
+    ChunkIndex chunk;
+    chunk.set_offset(GetUint64(record.header["chunk_pos"]));
+    chunk.set_start_time_sec(GetTime(record.header["start_time"]));
+    chunk.set_end_time_sec(GetTime(record.header["end_time"]));
+    if (i == 0 || chunk.start_time_sec() < start_time) {
+      start_time = chunk.start_time_sec();
+    }
+    end_time = std::max(end_time, chunk.end_time_sec());
+
+    // The message counts of the connections, added up by topic.
+    std::map<TopicIndex *, uint32_t> counts;
+    for (size_t pos = 0; pos < record.data.size(); pos += 8) {
+      const auto topic = topic_of_connection.find(GetUint32(record.data, pos));
+      if (topic != topic_of_connection.end()) {
+        counts[topic->second] += GetUint32(record.data, pos + 4);
+      }
+    }
+    for (const auto &count : counts) {
+      chunk.set_message_count(count.second);
+      *count.first->add_chunk() = chunk;
+      count.first->set_message_count(count.first->message_count() +
+                                     count.second);
+    }
+  }
+
+  const size_t name_pos = bag_file.find_last_of('/');
+  index->set_bag_file(name_pos == std::string::npos
+                          ? bag_file
+                          : bag_file.substr(name_pos + 1));
+  index->set_file_size(file_size);
+  index->set_start_time_sec(start_time);
+  index->set_end_time_sec(end_time);
+  for (auto &topic : topics) {
+    index->add_topic()->Swap(&topic.second);
+  }
+  return true;
+}
+
+int IndexBags(const std::string &bag_dir, DriveIndex *index) {
+  index->clear_bag();
+  DIR *directory = opendir(bag_dir.c_str());
+  if (directory == nullptr) {
+    AERROR << "Cannot open directory " << bag_dir;
+    return 0;
+  }
+  std::vector<std::string> bag_files;
+  struct dirent *entry;
+  while ((entry = readdir(directory)) != nullptr) {
+    // The bags being recorded end with .bag.active.
+    if (EndsWith(entry->d_name, kBagExtension)) {
+      bag_files.emplace_back(entry->d_name);
+    }
+  }
+  closedir(directory);
+
+  std::vector<BagIndex> bags(bag_files.size());
+  size_t num_bags = 0;
+  for (const auto &bag_file : bag_files) {
+    if (IndexBag(bag_dir + "/" + bag_file, &bags[num_bags])) {
+      ++num_bags;
+    }
+  }
+  bags.resize(num_bags);
+  std::sort(bags.begin(), bags.end(),
+            [](const BagIndex &a, const BagIndex &b) {
+              return a.start_time_sec() < b.start_time_sec() ||
+                     (a.start_time_sec() == b.start_time_sec() &&
+                      a.bag_file() < b.bag_file());
+            });
+  for (auto &bag : bags) {
+    index->add_bag()->Swap(&bag);
+  }
+  return static_cast<int>(num_bags);
+}
+
+std::vector<BagChunks> FindChunks(const DriveIndex &index,
+                                  const std::string &index_dir,
+                                  const double start_time_sec,
+                                  const double end_time_sec,
+                                  const std::vector<std::string> &topics) {
+  const std::unordered_set<std::string> topic_set(topics.begin(),
+                                                  topics.end());
+  std::vector<BagChunks> result;
+  for (const auto &bag : index.bag()) {
+    if (bag.end_time_sec() < start_time_sec ||
+        bag.start_time_sec() > end_time_sec) {
+      continue;
+    }
+    BagChunks chunks;
+    for (const auto &topic : bag.topic()) {
+      if (!topic_set.empty() && topic_set.count(topic.topic()) == 0) {
+        continue;
+      }
+      for (const auto &chunk : topic.chunk()) {
+        if (chunk.end_time_sec() < start_time_sec ||
+            chunk.start_time_sec() > end_time_sec) {
+          continue;
+        }
+        chunks.offsets.push_back(chunk.offset());
+        if (chunks.offsets.size() == 1 ||
+            chunk.start_time_sec() < chunks.start_time_sec) {
+          chunks.start_time_sec = chunk.start_time_sec();
+        }
+        chunks.end_time_sec =
+            std::max(chunks.end_time_sec, chunk.end_time_sec());
+      }
+    }
+    if (chunks.offsets.empty()) {
+      continue;
+    }
+    // The topics may share chunks.
+    std::sort(chunks.offsets.begin(), chunks.offsets.end());
+    chunks.offsets.erase(
+        std::unique(chunks.offsets.begin(), chunks.offsets.end()),
+        chunks.offsets.end());
+    chunks.bag_file = index_dir + "/" + bag.bag_file();
+    result.push_back(std::move(chunks));
+  }
+  return result;
+}
+
+}  // namespace data
+}  // namespace apollo
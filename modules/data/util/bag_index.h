@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Indexes the bags of a drive by time and topic.
+ */
+
+#ifndef MODULES_DATA_UTIL_BAG_INDEX_H_
+#define MODULES_DATA_UTIL_BAG_INDEX_H_
+
+#include <string>
+#include <vector>
+
+#include "modules/data/proto/drive_index.pb.h"
+
+/**
+ * @namespace apollo::data
+ * @brief apollo::data
+ */
+namespace apollo {
+namespace data {
+
+/**
+ * @brief Indexes a bag of format 2.0 from the connection and chunk info
+ * records at its end, without reading its chunks, which takes a few reads
+ * whatever the size of the bag.
+ * @param bag_file the path of the bag
+ * @param index the index to fill, with the name of the bag as its bag_file
+ * @return False if the bag fails to be read, or has not been closed.
+ */
+bool IndexBag(const std::string &bag_file, BagIndex *index);
+
+/**
+ * @brief Indexes the closed bags of a directory, in the order of their start
+ * times, and leaves out the others, e.g. the ones being recorded.
+ * @param bag_dir the directory of the bags
+ * @param index the index the bags of which are to be replaced
+ * @return The number of bags indexed.
+ */
+int IndexBags(const std::string &bag_dir, DriveIndex *index);
+
+/**
+ * @brief The chunks of a DriveIndex within a time window.
+ */
+struct BagChunks {
+  // The path of the bag, in the directory of the index.
+  std::string bag_file;
+  // The offsets of the chunks with messages of the topics, ascending.
+  std::vector<uint64_t> offsets;
+  double start_time_sec = 0.0;
+  double end_time_sec = 0.0;
+};
+
+/**
+ * @brief Finds the chunks which may have messages of some topics within a
+ * time window, so that only their bags are opened.
+ * @param index the index of the drive
+ * @param index_dir the directory of the index, the bags of which are in
+ * @param start_time_sec the start of the window
+ * @param end_time_sec the end of the window
+ * @param topics the topics, or all of them if empty
+ * @return The chunks by bag, in the order of the bags.
+ */
+std::vector<BagChunks> FindChunks(const DriveIndex &index,
+                                  const std::string &index_dir,
+                                  double start_time_sec, double end_time_sec,
+                                  const std::vector<std::string> &topics);
+
+}  // namespace data
+}  // namespace apollo
+
+#endif  // MODULES_DATA_UTIL_BAG_INDEX_H_
@@ -0,0 +1,199 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/data/util/bag_index.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace data {
+namespace {
+
+struct Chunk {
+  uint32_t start_sec;
+  uint32_t end_sec;
+  // The message counts by connection.
+  std::vector<std::pair<uint32_t, uint32_t>> counts;
+};
+
+std::string Uint32(const uint32_t value) {
+  std::string bytes(4, '\0');
+  for (int i = 0; i < 4; ++i) {
+    bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+  return bytes;
+}
+
+std::string Uint64(const uint64_t value) {
+  return Uint32(static_cast<uint32_t>(value)) +
+         Uint32(static_cast<uint32_t>(value >> 32));
+}
+
+std::string Time(const uint32_t sec) { return Uint32(sec) + Uint32(0); }
+
+std::string Field(const std::string &name, const std::string &value) {
+  return Uint32(static_cast<uint32_t>(name.size() + 1 + value.size())) + name +
+         "=" + value;
+}
+
+std::string Record(const std::string &header, const std::string &data) {
+  return Uint32(static_cast<uint32_t>(header.size())) + header +
+         Uint32(static_cast<uint32_t>(data.size())) + data;
+}
+
+// Writes a bag of format 2.0 with the connections and chunks, the chunks of
+// which have no messages in them since they are not read.
+void WriteBag(const std::string &file,
+              const std::vector<std::pair<std::string, std::string>> &topics,
+              const std::vector<Chunk> &chunks, bool closed = true) {
+  std::string body;
+  const size_t header_size = 13 + 4096;
+  std::vector<uint64_t> chunk_pos;
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    chunk_pos.push_back(header_size + body.size());
+    body += Record(Field("op", "\x05") + Field("compression", "none") +
+                       Field("size", Uint32(16)),
+                   std::string(16, 'm'));
+  }
+  const uint64_t index_pos = closed ? header_size + body.size() : 0;
+  for (size_t i = 0; i < topics.size(); ++i) {
+    const std::string conn = Uint32(static_cast<uint32_t>(i));
+    body += Record(Field("op", "\x07") + Field("conn", conn) +
+                       Field("topic", topics[i].first),
+                   Field("topic", topics[i].first) +
+                       Field("type", topics[i].second) + Field("md5sum", "*"));
+  }
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    std::string data;
+    for (const auto &count : chunks[i].counts) {
+      data += Uint32(count.first) + Uint32(count.second);
+    }
+    body += Record(
+        Field("op", "\x06") + Field("ver", Uint32(1)) +
+            Field("chunk_pos", Uint64(chunk_pos[i])) +
+            Field("start_time", Time(chunks[i].start_sec)) +
+            Field("end_time", Time(chunks[i].end_sec)) +
+            Field("count", Uint32(static_cast<uint32_t>(
+                               chunks[i].counts.size()))),
+        data);
+  }
+  std::string header = Record(
+      Field("op", "\x03") + Field("index_pos", Uint64(index_pos)) +
+          Field("conn_count", Uint32(static_cast<uint32_t>(topics.size()))) +
+          Field("chunk_count", Uint32(static_cast<uint32_t>(chunks.size()))),
+      "");
+  header.resize(4096, ' ');
+  std::ofstream(file, std::ios::binary) << "#ROSBAG V2.0\n" << header << body;
+}
+
+class BagIndexTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char dir[] = "/tmp/bag_index_test_XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(dir));
+    dir_ = dir;
+    // The second connection of the chassis is another publisher.
+    WriteBag(dir_ + "/b.bag",
+             {{"/apollo/canbus/chassis", "pb_msgs/Chassis"},
+              {"/apollo/localization/pose", "pb_msgs/LocalizationEstimate"},
+              {"/apollo/canbus/chassis", "pb_msgs/Chassis"}},
+             {{100, 110, {{0, 5}, {1, 10}, {2, 1}}}, {110, 120, {{1, 8}}}});
+    WriteBag(dir_ + "/a.bag",
+             {{"/apollo/canbus/chassis", "pb_msgs/Chassis"}},
+             {{40, 50, {{0, 3}}}, {50, 60, {{0, 4}}}});
+    WriteBag(dir_ + "/c.bag.active",
+             {{"/apollo/canbus/chassis", "pb_msgs/Chassis"}}, {});
+    WriteBag(dir_ + "/d.bag", {{"/apollo/canbus/chassis", "pb_msgs/Chassis"}},
+             {{130, 140, {{0, 3}}}}, false);
+  }
+
+  void TearDown() override {
+    for (const char *name : {"a.bag", "b.bag", "c.bag.active", "d.bag"}) {
+      unlink((dir_ + "/" + name).c_str());
+    }
+    rmdir(dir_.c_str());
+  }
+
+  std::string dir_;
+};
+
+TEST_F(BagIndexTest, IndexBag) {
+  BagIndex index;
+  ASSERT_TRUE(IndexBag(dir_ + "/b.bag", &index));
+  EXPECT_EQ("b.bag", index.bag_file());
+  EXPECT_DOUBLE_EQ(100.0, index.start_time_sec());
+  EXPECT_DOUBLE_EQ(120.0, index.end_time_sec());
+  ASSERT_EQ(2, index.topic_size());
+
+  const TopicIndex &chassis = index.topic(0);
+  EXPECT_EQ("/apollo/canbus/chassis", chassis.topic());
+  EXPECT_EQ("pb_msgs/Chassis", chassis.message_type());
+  EXPECT_EQ(6, chassis.message_count());
+  ASSERT_EQ(1, chassis.chunk_size());
+  EXPECT_EQ(6, chassis.chunk(0).message_count());
+  EXPECT_EQ(13 + 4096, chassis.chunk(0).offset());
+
+  const TopicIndex &pose = index.topic(1);
+  EXPECT_EQ("/apollo/localization/pose", pose.topic());
+  EXPECT_EQ(18, pose.message_count());
+  ASSERT_EQ(2, pose.chunk_size());
+  EXPECT_EQ(chassis.chunk(0).offset(), pose.chunk(0).offset());
+  EXPECT_LT(pose.chunk(0).offset(), pose.chunk(1).offset());
+  EXPECT_DOUBLE_EQ(110.0, pose.chunk(1).start_time_sec());
+  EXPECT_DOUBLE_EQ(120.0, pose.chunk(1).end_time_sec());
+
+  EXPECT_FALSE(IndexBag(dir_ + "/d.bag", &index));
+  EXPECT_FALSE(IndexBag(dir_ + "/none.bag", &index));
+}
+
+TEST_F(BagIndexTest, IndexBagsAndFindChunks) {
+  DriveIndex index;
+  // The unclosed and active bags are left out.
+  ASSERT_EQ(2, IndexBags(dir_, &index));
+  EXPECT_EQ("a.bag", index.bag(0).bag_file());
+  EXPECT_EQ("b.bag", index.bag(1).bag_file());
+
+  auto chunks = FindChunks(index, dir_, 55.0, 115.0, {});
+  ASSERT_EQ(2, chunks.size());
+  EXPECT_EQ(dir_ + "/a.bag", chunks[0].bag_file);
+  EXPECT_EQ(1, chunks[0].offsets.size());
+  EXPECT_DOUBLE_EQ(50.0, chunks[0].start_time_sec);
+  EXPECT_EQ(2, chunks[1].offsets.size());
+  EXPECT_DOUBLE_EQ(120.0, chunks[1].end_time_sec);
+
+  chunks = FindChunks(index, dir_, 111.0, 200.0,
+                      {"/apollo/canbus/chassis"});
+  EXPECT_TRUE(chunks.empty());
+
+  chunks = FindChunks(index, dir_, 0.0, 105.0, {"/apollo/canbus/chassis"});
+  ASSERT_EQ(2, chunks.size());
+  EXPECT_EQ(2, chunks[0].offsets.size());
+  EXPECT_EQ(1, chunks[1].offsets.size());
+}
+
+}  // namespace
+}  // namespace data
+}  // namespace apollo
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/data/util/drive_index_reader.h"
+
+#include <memory>
+
+#include "rosbag/bag.h"
+
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+
+namespace apollo {
+namespace data {
+
+using apollo::common::util::GetProtoFromBinaryFile;
+
+DriveIndexReader::DriveIndexReader(const DriveIndex &index,
+                                   const std::string &index_dir)
+    : index_(index), index_dir_(index_dir) {}
+
+bool DriveIndexReader::Open(const std::string &index_file) {
+  if (!GetProtoFromBinaryFile(index_file, &index_)) {
+    AERROR << "Failed to read the drive index " << index_file;
+    return false;
+  }
+  const size_t dir_pos = index_file.find_last_of('/');
+  index_dir_ =
+      dir_pos == std::string::npos ? "." : index_file.substr(0, dir_pos);
+  return true;
+}
+
+std::vector<BagChunks> DriveIndexReader::FindChunks(
+    const double start_time_sec, const double end_time_sec,
+    const std::vector<std::string> &topics) const {
+  return apollo::data::FindChunks(index_, index_dir_, start_time_sec,
+                                  end_time_sec, topics);
+}
+
+int DriveIndexReader::ReadMessages(const double start_time_sec,
+                                   const double end_time_sec,
+                                   const std::vector<std::string> &topics,
+                                   const MessageCallback &callback) const {
+  // The bags are read through a single view, which merges the messages of
+  // the bags recorded at the same time, e.g. by several topic groups.
+  std::vector<std::unique_ptr<rosbag::Bag>> bags;
+  rosbag::View view;
+  const ros::Time start_time(start_time_sec);
+  const ros::Time end_time(end_time_sec);
+  for (const auto &chunks : FindChunks(start_time_sec, end_time_sec, topics)) {
+    bags.emplace_back(new rosbag::Bag());
+    try {
+      bags.back()->open(chunks.bag_file, rosbag::bagmode::Read);
+    } catch (const rosbag::BagException &e) {
+      AERROR << "Failed to open " << chunks.bag_file << ": " << e.what();
+      return -1;
+    }
+    if (topics.empty()) {
+      view.addQuery(*bags.back(), start_time, end_time);
+    } else {
+      view.addQuery(*bags.back(), rosbag::TopicQuery(topics), start_time,
+                    end_time);
+    }
+  }
+
+  int num_messages = 0;
+  for (const rosbag::MessageInstance &message : view) {
+    callback(message);
+    ++num_messages;
+  }
+  return num_messages;
+}
+
+}  // namespace data
+}  // namespace apollo
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_DATA_UTIL_DRIVE_INDEX_READER_H_
+#define MODULES_DATA_UTIL_DRIVE_INDEX_READER_H_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "rosbag/view.h"
+
+#include "modules/data/proto/drive_index.pb.h"
+#include "modules/data/util/bag_index.h"
+
+/**
+ * @namespace apollo::data
+ * @brief apollo::data
+ */
+namespace apollo {
+namespace data {
+
+/**
+ * @class DriveIndexReader
+ * @brief Reads the messages of a drive within a time window, for some topics,
+ * from the bags which its DriveIndex finds them in. The other bags are not
+ * opened, and rosbag seeks to the chunks of the messages in the ones which
+ * are.
+ */
+class DriveIndexReader {
+ public:
+  using MessageCallback = std::function<void(const rosbag::MessageInstance &)>;
+
+  DriveIndexReader() = default;
+
+  /**
+   * @param index the index of the drive
+   * @param index_dir the directory of the bags of the index
+   */
+  DriveIndexReader(const DriveIndex &index, const std::string &index_dir);
+
+  /**
+   * @brief Loads an index written by the drive_indexer, next to its bags.
+   * @return False if the index fails to be read.
+   */
+  bool Open(const std::string &index_file);
+
+  const DriveIndex &index() const { return index_; }
+
+  /**
+   * @brief Finds the chunks of the bags within the time window with messages
+   * of the topics, or of all of them if empty.
+   */
+  std::vector<BagChunks> FindChunks(
+      double start_time_sec, double end_time_sec,
+      const std::vector<std::string> &topics) const;
+
+  /**
+   * @brief Reads the messages of the topics, or of all of them if empty,
+   * within the time window, in the order of their times across the bags.
+   * @param callback the function called with each message
+   * @return The number of messages read, or -1 if a bag fails to be opened.
+   */
+  int ReadMessages(double start_time_sec, double end_time_sec,
+                   const std::vector<std::string> &topics,
+                   const MessageCallback &callback) const;
+
+ private:
+  DriveIndex index_;
+  std::string index_dir_;
+};
+
+}  // namespace data
+}  // namespace apollo
+
+#endif  // MODULES_DATA_UTIL_DRIVE_INDEX_READER_H_
@@ -61,6 +61,57 @@ DEFINE_double(sim_map_radius, 300.0,
               "The radius within which Dreamview will find all the map "
               "elements around the car.");
 
+DEFINE_double(map_tile_size, 100.0,
+              "The side length in meters of the square tiles the map is "
+              "served in.");
+
+DEFINE_int32(map_tile_cache_size, 4096,
+             "The max number of serialized map tiles cached by Dreamview.");
+
+DEFINE_double(image_max_fps, 10.0,
+              "The max number of camera images sent to a client per second.");
+
+DEFINE_double(image_scale, 0.2,
+              "The scale used to resize the raw camera images sent to the "
+              "clients.");
+
+DEFINE_double(compressed_image_scale, 1.0,
+              "The scale used to resize the compressed camera images sent to "
+              "the clients.");
+
+DEFINE_double(point_cloud_max_fps, 5.0,
+              "The max number of point clouds sent to a client per second.");
+
+DEFINE_int32(point_cloud_max_points, 30000,
+             "The max number of points of the downsampled point clouds sent "
+             "to the clients, whatever they ask for.");
+
+DEFINE_double(point_cloud_resolution, 0.01,
+              "The length in meters of a unit of the int16 coordinates of the "
+              "points sent to the clients.");
+
+DEFINE_double(point_cloud_min_voxel_size, 0.1,
+              "The side length in meters of the finest voxels the point clouds "
+              "sent to the clients are downsampled to.");
+
+DEFINE_bool(sim_control_lockstep, false,
+            "True to run SimControl on a simulated clock, published on "
+            "/clock, which only moves on once planning has planned for it. "
+            "The other modules have to run with use_ros_time and the ROS "
+            "parameter /use_sim_time set.");
+
+DEFINE_double(sim_control_speed_ratio, 0.0,
+              "The max ratio of the simulated time to the wall time in "
+              "lockstep mode, or 0 to run as fast as the modules allow.");
+
+DEFINE_double(sim_control_planning_period, 0.1,
+              "The simulated seconds between the planning cycles SimControl "
+              "waits for in lockstep mode.");
+
+DEFINE_double(sim_control_planning_timeout, 1.0,
+              "The max wall seconds SimControl waits for a planning cycle in "
+              "lockstep mode.");
+
 DEFINE_int32(dreamview_worker_num, 3, "number of dreamview thread workers");
 DEFINE_bool(enable_update_size_check, true,
             "True to check if the update byte number is less than threshold");
@@ -41,6 +41,32 @@ DECLARE_string(ssl_certificate);
 
 DECLARE_double(sim_map_radius);
 
+DECLARE_double(map_tile_size);
+
+DECLARE_int32(map_tile_cache_size);
+
+DECLARE_double(image_max_fps);
+
+DECLARE_double(image_scale);
+
+DECLARE_double(compressed_image_scale);
+
+DECLARE_double(point_cloud_max_fps);
+
+DECLARE_int32(point_cloud_max_points);
+
+DECLARE_double(point_cloud_resolution);
+
+DECLARE_double(point_cloud_min_voxel_size);
+
+DECLARE_bool(sim_control_lockstep);
+
+DECLARE_double(sim_control_speed_ratio);
+
+DECLARE_double(sim_control_planning_period);
+
+DECLARE_double(sim_control_planning_timeout);
+
 DECLARE_int32(dreamview_worker_num);
 DECLARE_bool(enable_update_size_check);
 DECLARE_uint32(max_update_size);
@@ -64,6 +64,8 @@ Status Dreamview::Init() {
       << "CompressedImageAdapter is not initialized.";
   CHECK(AdapterManager::GetImageShort())
       << "ImageShortAdapter is not initialized.";
+  CHECK(AdapterManager::GetPointCloud())
+      << "PointCloudAdapter is not initialized.";
 
   // Initialize and run the web server which serves the dreamview htmls and
   // javascripts and handles websocket requests.
@@ -81,16 +83,22 @@ Status Dreamview::Init() {
 
   image_.reset(new ImageHandler());
   websocket_.reset(new WebSocketHandler());
+  point_cloud_websocket_.reset(new WebSocketHandler());
   map_service_.reset(new MapService());
+  map_tile_.reset(new MapTileHandler(map_service_.get()));
   sim_control_.reset(new SimControl(map_service_.get()));
 
   sim_world_updater_.reset(
       new SimulationWorldUpdater(websocket_.get(), sim_control_.get(),
                                  map_service_.get(), FLAGS_routing_from_file));
+  point_cloud_updater_.reset(
+      new PointCloudUpdater(point_cloud_websocket_.get(), map_service_.get()));
   hmi_.reset(new HMI(websocket_.get(), map_service_.get()));
 
   server_->addWebSocketHandler("/websocket", *websocket_);
+  server_->addWebSocketHandler("/pointcloud", *point_cloud_websocket_);
   server_->addHandler("/image", *image_);
+  server_->addHandler("/map_tile", *map_tile_);
 
   ApolloApp::SetCallbackThreadNumber(FLAGS_dreamview_worker_num);
 
@@ -25,9 +25,11 @@
 #include "modules/common/apollo_app.h"
 
 #include "modules/dreamview/backend/handlers/image.h"
+#include "modules/dreamview/backend/handlers/map_tile.h"
 #include "modules/dreamview/backend/handlers/websocket.h"
 #include "modules/dreamview/backend/hmi/hmi.h"
 #include "modules/dreamview/backend/map/map_service.h"
+#include "modules/dreamview/backend/point_cloud/point_cloud_updater.h"
 #include "modules/dreamview/backend/sim_control/sim_control.h"
 #include "modules/dreamview/backend/simulation_world/simulation_world_updater.h"
 
@@ -52,7 +54,12 @@ class Dreamview : public apollo::common::ApolloApp {
   std::unique_ptr<SimControl> sim_control_;
   std::unique_ptr<WebSocketHandler> websocket_;
   std::unique_ptr<ImageHandler> image_;
+  // The point clouds have their own websocket, for their frames not to
+  // delay the SimulationWorld ones.
+  std::unique_ptr<WebSocketHandler> point_cloud_websocket_;
+  std::unique_ptr<PointCloudUpdater> point_cloud_updater_;
   std::unique_ptr<MapService> map_service_;
+  std::unique_ptr<MapTileHandler> map_tile_;
   std::unique_ptr<HMI> hmi_;
 };
 
@@ -18,9 +18,15 @@ limitations under the License.
 
 #include "modules/dreamview/backend/handlers/image.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/log.h"
 #include "modules/common/time/time.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 #include "modules/perception/traffic_light/util/color_space.h"
 
 #include "opencv2/opencv.hpp"
@@ -30,13 +36,12 @@ namespace dreamview {
 
 using apollo::common::adapter::AdapterManager;
 
-constexpr double ImageHandler::kImageScale;
-
 template <>
-void ImageHandler::OnImage(const sensor_msgs::Image &image) {
+bool ImageHandler::Encode(const sensor_msgs::Image &image,
+                          std::vector<uchar> *jpeg) {
   if (image.encoding != "yuyv") {
     AERROR_EVERY(100) << "Image format not support: " << image.encoding;
-    return;
+    return false;
   }
 
   unsigned char *yuv = (unsigned char *)&(image.data[0]);
@@ -46,37 +51,114 @@ void ImageHandler::OnImage(const sensor_msgs::Image &image) {
   cv::cvtColor(mat, mat, CV_RGB2BGR);
 
   cv::resize(mat, mat,
-             cv::Size(image.width * ImageHandler::kImageScale,
-                      image.height * ImageHandler::kImageScale),
+             cv::Size(image.width * FLAGS_image_scale,
+                      image.height * FLAGS_image_scale),
              0, 0, CV_INTER_LINEAR);
 
-  std::unique_lock<std::mutex> lock(mutex_);
-  cv::imencode(".jpg", mat, send_buffer_, std::vector<int>() /* params */);
-  cvar_.notify_all();
+  cv::imencode(".jpg", mat, *jpeg, std::vector<int>() /* params */);
+  return true;
 }
 
 template <>
-void ImageHandler::OnImage(const sensor_msgs::CompressedImage &image) {
+bool ImageHandler::Encode(const sensor_msgs::CompressedImage &image,
+                          std::vector<uchar> *jpeg) {
   try {
-    std::unique_lock<std::mutex> lock(mutex_);
     auto current_image = cv_bridge::toCvCopy(image);
-    cv::imencode(".jpg", current_image->image, send_buffer_,
-                 std::vector<int>() /* params */);
-    cvar_.notify_all();
+    cv::Mat &mat = current_image->image;
+    if (FLAGS_compressed_image_scale != 1.0) {
+      // INTER_AREA avoids the aliasing of the other interpolations when
+      // shrinking.
+      cv::resize(mat, mat, cv::Size(), FLAGS_compressed_image_scale,
+                 FLAGS_compressed_image_scale, CV_INTER_AREA);
+    }
+    cv::imencode(".jpg", mat, *jpeg, std::vector<int>() /* params */);
   } catch (cv_bridge::Exception &e) {
     AERROR << "Error when converting ROS image to CV image: " << e.what();
+    return false;
+  }
+  return true;
+}
+
+template <typename SensorMsgsImage>
+void ImageHandler::OnImage(const SensorMsgsImage &image) {
+  // Nobody would see the image.
+  if (num_clients_ == 0) {
     return;
   }
+
+  // Only the copy is made on the callback thread, the image is encoded when
+  // a client asks for it.
+  auto latest = std::make_shared<const SensorMsgsImage>(image);
+  std::unique_lock<std::mutex> lock(mutex_);
+  encode_latest_ = [latest](std::vector<uchar> *jpeg) {
+    return Encode(*latest, jpeg);
+  };
+  ++image_seq_;
+  cvar_.notify_all();
 }
 
 ImageHandler::ImageHandler() {
-  AdapterManager::AddCompressedImageCallback(&ImageHandler::OnImage, this);
-  AdapterManager::AddImageShortCallback(&ImageHandler::OnImage, this);
+  AdapterManager::AddCompressedImageCallback(
+      &ImageHandler::OnImage<sensor_msgs::CompressedImage>, this);
+  AdapterManager::AddImageShortCallback(
+      &ImageHandler::OnImage<sensor_msgs::Image>, this);
+}
+
+ImageHandler::JpegPtr ImageHandler::GetLatestJpeg(uint64_t *seq) {
+  std::unique_lock<std::mutex> encode_lock(encode_mutex_);
+  std::function<bool(std::vector<uchar> *)> encode;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    *seq = image_seq_;
+    if (jpeg_seq_ == image_seq_) {
+      return jpeg_;
+    }
+    encode = encode_latest_;
+  }
+
+  // The newer images received while encoding wait for the next call.
+  std::shared_ptr<std::vector<uchar>> jpeg(new std::vector<uchar>());
+  if (!encode || !encode(jpeg.get())) {
+    jpeg.reset();
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  jpeg_ = jpeg;
+  jpeg_seq_ = *seq;
+  return jpeg_;
 }
 
 bool ImageHandler::handleGet(CivetServer *server, struct mg_connection *conn) {
-  if (send_buffer_.empty()) {
-    return true;
+  double max_fps = FLAGS_image_max_fps;
+  std::string fps;
+  if (CivetServer::getParam(conn, "fps", fps)) {
+    const double requested_fps = std::atof(fps.c_str());
+    if (requested_fps > 0.0 && (max_fps <= 0.0 || requested_fps < max_fps)) {
+      max_fps = requested_fps;
+    }
+  }
+
+  ++num_clients_;
+  const bool ret = StreamImages(conn, max_fps);
+  if (--num_clients_ == 0) {
+    // Release the last image, the next client waits for a new one anyway.
+    std::unique_lock<std::mutex> lock(mutex_);
+    encode_latest_ = nullptr;
+    jpeg_.reset();
+  }
+  return ret;
+}
+
+bool ImageHandler::StreamImages(struct mg_connection *conn, double max_fps) {
+  // The images received before the client connected are not kept, wait for
+  // the first one for a short while.
+  uint64_t sent_seq = 0;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    sent_seq = image_seq_;
+    if (!cvar_.wait_for(lock, std::chrono::seconds(1),
+                        [this, sent_seq] { return image_seq_ != sent_seq; })) {
+      return true;
+    }
   }
 
   mg_printf(conn,
@@ -90,26 +172,30 @@ bool ImageHandler::handleGet(CivetServer *server, struct mg_connection *conn) {
             "boundary=--BoundaryString\r\n"
             "\r\n");
 
+  const auto min_interval =
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(max_fps > 0.0 ? 1.0 / max_fps : 0.0));
   while (true) {
-    std::vector<uchar> to_send;
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-      to_send = send_buffer_;
-    }
-    // Sends the image data
-    mg_printf(conn,
-              "--BoundaryString\r\n"
-              "Content-type: image/jpeg\r\n"
-              "Content-Length: %zu\r\n"
-              "\r\n",
-              to_send.size());
-    if (mg_write(conn, &to_send[0], to_send.size()) <= 0) {
-      return false;
+    const auto next_time = std::chrono::steady_clock::now() + min_interval;
+    JpegPtr to_send = GetLatestJpeg(&sent_seq);
+    if (to_send != nullptr && !to_send->empty()) {
+      // Sends the image data
+      mg_printf(conn,
+                "--BoundaryString\r\n"
+                "Content-type: image/jpeg\r\n"
+                "Content-Length: %zu\r\n"
+                "\r\n",
+                to_send->size());
+      if (mg_write(conn, &(*to_send)[0], to_send->size()) <= 0) {
+        return false;
+      }
+      mg_printf(conn, "\r\n\r\n");
     }
-    mg_printf(conn, "\r\n\r\n");
 
+    // The images received until then are skipped but the latest.
+    std::this_thread::sleep_until(next_time);
     std::unique_lock<std::mutex> lock(mutex_);
-    cvar_.wait(lock);
+    cvar_.wait(lock, [this, sent_seq] { return image_seq_ != sent_seq; });
   }
   return true;
 }
@@ -21,7 +21,11 @@
 #ifndef MODULES_DREAMVIEW_BACKEND_HANDLERS_IMAGE_H_
 #define MODULES_DREAMVIEW_BACKEND_HANDLERS_IMAGE_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -42,25 +46,51 @@ namespace dreamview {
  *
  * @brief The ImageHandler, built on top of CivetHandler, converts the received
  * ROS image message to a image stream, wrapped by MJPEG Streaming Protocol.
+ * The images are only kept while clients are connected, and each image is
+ * encoded once, when the first client is ready for it. A client gets at most
+ * FLAGS_image_max_fps images per second, or the fps asked by its request
+ * (/image?fps=<fps>) if lower, and skips the images received in between.
  */
 class ImageHandler : public CivetHandler {
  public:
-  // The scale used to resize images sent to frontend
-  static constexpr double kImageScale = 0.2;
-
   ImageHandler();
 
   bool handleGet(CivetServer *server, struct mg_connection *conn);
 
  private:
+  using JpegPtr = std::shared_ptr<const std::vector<uchar>>;
+
   template <typename SensorMsgsImage>
   void OnImage(const SensorMsgsImage &image);
 
-  std::vector<uchar> send_buffer_;
+  // Streams the images to the client until the connection is closed.
+  bool StreamImages(struct mg_connection *conn, double max_fps);
+
+  template <typename SensorMsgsImage>
+  static bool Encode(const SensorMsgsImage &image, std::vector<uchar> *jpeg);
+
+  /**
+   * @brief Gets the JPEG of the latest image, which is encoded if no client
+   * has asked for it yet.
+   * @param seq the sequence number of the image
+   * @return The JPEG, or nullptr if the image fails to be encoded.
+   */
+  JpegPtr GetLatestJpeg(uint64_t *seq);
+
+  std::atomic<int> num_clients_{0};
+
+  // Encodes the latest image, the sequence number of which is image_seq_.
+  std::function<bool(std::vector<uchar> *)> encode_latest_;
+  uint64_t image_seq_ = 0;
+  // The JPEG of the image of jpeg_seq_.
+  JpegPtr jpeg_;
+  uint64_t jpeg_seq_ = 0;
 
   // mutex lock and condition variable to protect the received image
   std::mutex mutex_;
   std::condition_variable cvar_;
+  // Taken while encoding, so that an image is not encoded by two clients.
+  std::mutex encode_mutex_;
 };
 
 }  // namespace dreamview
@@ -0,0 +1,105 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "sensor_msgs/Image.h"
+#include "modules/dreamview/backend/handlers/map_tile.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+bool GetIntParam(struct mg_connection *conn, const char *name, int *value) {
+  std::string text;
+  if (!CivetServer::getParam(conn, name, text) || text.empty()) {
+    return false;
+  }
+  char *end = nullptr;
+  const long parsed = std::strtol(text.c_str(), &end, 10);  // NOLINT
+  if (*end != '\0') {
+    return false;
+  }
+  *value = static_cast<int>(parsed);
+  return true;
+}
+
+}  // namespace
+
+MapTileHandler::MapTileHandler(const MapService *map_service)
+    : map_service_(map_service) {}
+
+bool MapTileHandler::handleGet(CivetServer *server,
+                               struct mg_connection *conn) {
+  int x = 0;
+  int y = 0;
+  if (!GetIntParam(conn, "x", &x) || !GetIntParam(conn, "y", &y)) {
+    mg_printf(conn,
+              "HTTP/1.1 400 Bad Request\r\n"
+              "Content-Length: 0\r\n"
+              "\r\n");
+    return true;
+  }
+
+  auto tile = map_service_->GetMapTile(x, y);
+  if (tile == nullptr) {
+    mg_printf(conn,
+              "HTTP/1.1 503 Service Unavailable\r\n"
+              "Content-Length: 0\r\n"
+              "\r\n");
+    return true;
+  }
+
+  // The tile only changes with the map, the clients may keep it but have to
+  // check whether it is still valid.
+  const char *if_none_match = CivetServer::getHeader(conn, "If-None-Match");
+  if (if_none_match != nullptr && tile->etag == if_none_match) {
+    mg_printf(conn,
+              "HTTP/1.1 304 Not Modified\r\n"
+              "ETag: %s\r\n"
+              "Cache-Control: no-cache\r\n"
+              "\r\n",
+              tile->etag.c_str());
+    return true;
+  }
+
+  const char *accept_encoding = CivetServer::getHeader(conn, "Accept-Encoding");
+  const bool gzip = accept_encoding != nullptr &&
+                    std::strstr(accept_encoding, "gzip") != nullptr;
+  const std::string &data = gzip ? tile->compressed_data : tile->data;
+  mg_printf(conn,
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: application/octet-stream\r\n"
+            "%s"
+            "Content-Length: %zu\r\n"
+            "ETag: %s\r\n"
+            "Cache-Control: no-cache\r\n"
+            "Vary: Accept-Encoding\r\n"
+            "\r\n",
+            gzip ? "Content-Encoding: gzip\r\n" : "", data.size(),
+            tile->etag.c_str());
+  if (!data.empty() && mg_write(conn, data.data(), data.size()) <= 0) {
+    AWARN << "Failed to send the map tile " << x << ", " << y;
+  }
+  return true;
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "modules/dreamview/backend/handlers/websocket.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -29,10 +30,35 @@ namespace dreamview {
 using apollo::common::util::StrCat;
 using apollo::common::util::ContainsKey;
 
+WebSocketHandler::WebSocketHandler(int num_sender_threads,
+                                   size_t max_queued_frames)
+    : max_queued_frames_(max_queued_frames > 0 ? max_queued_frames : 1) {
+  for (int i = 0; i < std::max(num_sender_threads, 1); ++i) {
+    sender_threads_.emplace_back(&WebSocketHandler::SenderThreadFunc, this);
+  }
+}
+
+WebSocketHandler::~WebSocketHandler() {
+  {
+    std::unique_lock<std::mutex> lock(run_mutex_);
+    stopped_ = true;
+  }
+  run_cvar_.notify_all();
+  for (auto &thread : sender_threads_) {
+    thread.join();
+  }
+}
+
 void WebSocketHandler::handleReadyState(CivetServer *server, Connection *conn) {
+  auto state = std::make_shared<ConnectionState>();
+  const struct mg_request_info *info = mg_get_request_info(conn);
+  if (info != nullptr) {
+    state->stats.remote_address =
+        StrCat(info->remote_addr, ":", info->remote_port);
+  }
   {
     std::unique_lock<std::mutex> lock(mutex_);
-    connections_.emplace(conn, std::make_shared<std::mutex>());
+    connections_.emplace(conn, state);
     AINFO << "Accepted connection. Total connections: " << connections_.size();
   }
 
@@ -44,19 +70,34 @@ void WebSocketHandler::handleReadyState(CivetServer *server, Connection *conn) {
 
 void WebSocketHandler::handleClose(CivetServer *server,
                                    const Connection *conn) {
+  Connection *connection = const_cast<Connection *>(conn);
+  ConnectionStatePtr state;
   {
     std::unique_lock<std::mutex> lock(mutex_);
 
-    // Remove from the store of currently open connections. Copy the mutex out
-    // so that it won't be reclaimed during map.erase().
-    Connection *connection = const_cast<Connection *>(conn);
-    std::shared_ptr<std::mutex> connection_lock = connections_[connection];
-    {
-      std::unique_lock<std::mutex> lock(*connection_lock);
-      connections_.erase(connection);
+    // Remove from the store of currently open connections.
+    auto iter = connections_.find(connection);
+    if (iter == connections_.end()) {
+      return;
     }
+    state = iter->second;
+    connections_.erase(iter);
     AINFO << "Connection closed. Total connections: " << connections_.size();
   }
+
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->closed = true;
+    state->frames.clear();
+  }
+
+  // Trigger registered closed connection handlers.
+  for (const auto &handler : connection_close_handlers_) {
+    handler(connection);
+  }
+  // Wait for the frame being written, the connection is released after this
+  // callback.
+  std::unique_lock<std::mutex> send_lock(state->send_mutex);
 }
 
 bool WebSocketHandler::BroadcastData(const std::string &data, bool skippable) {
@@ -84,42 +125,150 @@ bool WebSocketHandler::BroadcastData(const std::string &data, bool skippable) {
 
 bool WebSocketHandler::SendData(Connection *conn, const std::string &data,
                                 bool skippable) {
-  std::shared_ptr<std::mutex> connection_lock;
+  return SendData(conn, data, skippable, WEBSOCKET_OPCODE_TEXT);
+}
+
+bool WebSocketHandler::SendBinaryData(Connection *conn,
+                                      const std::string &data,
+                                      bool skippable) {
+  return SendData(conn, data, skippable, WEBSOCKET_OPCODE_BINARY);
+}
+
+bool WebSocketHandler::SendData(Connection *conn, const std::string &data,
+                                bool skippable, int op_code) {
+  ConnectionStatePtr state;
   {
     std::unique_lock<std::mutex> lock(mutex_);
-    if (!ContainsKey(connections_, conn)) {
+    auto iter = connections_.find(conn);
+    if (iter == connections_.end()) {
       AERROR << "Trying to send to an uncached connection, skipping.";
       return false;
     }
-    // Copy the lock so that it still exists if the connection is closed after
-    // this block.
-    connection_lock = connections_[conn];
+    state = iter->second;
   }
 
-  // Lock the connection while sending.
-  if (!connection_lock->try_lock()) {
-    // Skip sending data if:
-    // 1. Data is skippable according to sender and there's higher priority data
-    // being sent.
-    // 2. The connection has been closed.
-    if (skippable) {
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (state->closed) {
       return false;
-    } else {
-      connection_lock->lock();  // Block to acquire the lock.
-      if (!ContainsKey(connections_, conn)) {
+    }
+    if (skippable) {
+      // Only the latest of the skippable frames is worth sending.
+      for (auto &frame : state->frames) {
+        if (frame.skippable) {
+          frame.data = data;
+          frame.op_code = op_code;
+          frame.queue_time = std::chrono::steady_clock::now();
+          ++state->stats.dropped_frames;
+          return true;
+        }
+      }
+      if (state->frames.size() >= max_queued_frames_) {
+        ++state->stats.dropped_frames;
         return false;
       }
     }
+    // The frames that are not skippable are always queued, they are the
+    // responses to the requests of the client.
+    state->frames.emplace_back();
+    Frame &frame = state->frames.back();
+    frame.data = data;
+    frame.op_code = op_code;
+    frame.skippable = skippable;
+    frame.queue_time = std::chrono::steady_clock::now();
+    if (state->scheduled) {
+      return true;
+    }
+    state->scheduled = true;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(run_mutex_);
+    run_queue_.emplace_back(conn, state);
+  }
+  run_cvar_.notify_one();
+  return true;
+}
+
+void WebSocketHandler::SenderThreadFunc() {
+  while (true) {
+    std::pair<Connection *, ConnectionStatePtr> item;
+    {
+      std::unique_lock<std::mutex> lock(run_mutex_);
+      run_cvar_.wait(lock, [this] { return stopped_ || !run_queue_.empty(); });
+      if (stopped_) {
+        return;
+      }
+      item = std::move(run_queue_.front());
+      run_queue_.pop_front();
+    }
+    Connection *conn = item.first;
+    ConnectionState *state = item.second.get();
+
+    Frame frame;
+    {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      if (state->closed || state->frames.empty()) {
+        state->scheduled = false;
+        continue;
+      }
+      frame = std::move(state->frames.front());
+      state->frames.pop_front();
+    }
+
+    bool success = false;
+    {
+      // Note that while we are holding the send lock, the connection won't be
+      // closed and removed.
+      std::unique_lock<std::mutex> send_lock(state->send_mutex);
+      bool closed = false;
+      {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        closed = state->closed;
+      }
+      if (!closed) {
+        success = WriteFrame(conn, frame);
+      }
+    }
+
+    const double latency_ms =
+        std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - frame.queue_time)
+            .count();
+    bool more_frames = false;
+    {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      ConnectionStats &stats = state->stats;
+      if (success) {
+        ++stats.sent_frames;
+        stats.sent_bytes += frame.data.size();
+        stats.mean_latency_ms +=
+            (latency_ms - stats.mean_latency_ms) / stats.sent_frames;
+        stats.max_latency_ms = std::max(stats.max_latency_ms, latency_ms);
+      } else {
+        ++stats.failed_frames;
+      }
+      more_frames = !state->closed && !state->frames.empty();
+      state->scheduled = more_frames;
+    }
+    // Take turns with the other connections for the next frame.
+    if (more_frames) {
+      {
+        std::unique_lock<std::mutex> lock(run_mutex_);
+        run_queue_.push_back(std::move(item));
+      }
+      run_cvar_.notify_one();
+    }
   }
-  // Note that while we are holding the connection lock, the connection won't be
-  // closed and removed.
+}
+
+bool WebSocketHandler::WriteFrame(Connection *conn, const Frame &frame) {
+  const std::string &data = frame.data;
   int ret;
   PERF_BLOCK(StrCat("Writing ", data.size(), " bytes via websocket took"),
              0.1) {
-    ret = mg_websocket_write(conn, WEBSOCKET_OPCODE_TEXT, data.c_str(),
-                             data.size());
+    ret = mg_websocket_write(conn, frame.op_code, data.c_str(), data.size());
   }
-  connection_lock->unlock();
 
   if (ret != static_cast<int>(data.size())) {
     // Determine error message based on return value.
@@ -139,6 +288,24 @@ bool WebSocketHandler::SendData(Connection *conn, const std::string &data,
   return true;
 }
 
+std::vector<WebSocketHandler::ConnectionStats>
+WebSocketHandler::GetConnectionStats() const {
+  std::vector<ConnectionStatePtr> states;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (const auto &kv : connections_) {
+      states.push_back(kv.second);
+    }
+  }
+  std::vector<ConnectionStats> stats;
+  for (const auto &state : states) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    stats.push_back(state->stats);
+    stats.back().queued_frames = state->frames.size();
+  }
+  return stats;
+}
+
 bool WebSocketHandler::handleData(CivetServer *server, Connection *conn,
                                   int bits, char *data, size_t data_len) {
   // Ignore connection close request.
@@ -21,11 +21,16 @@
 #ifndef MODULES_DREAMVIEW_BACKEND_HANDLERS_WEBSOCKET_H_
 #define MODULES_DREAMVIEW_BACKEND_HANDLERS_WEBSOCKET_H_
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "CivetServer.h"
@@ -46,6 +51,11 @@ namespace dreamview {
  * events.
  * the server and a client endpoint. The SendData() method is used to push data
  * to all the connected clients.
+ *
+ * The data are not written by the callers: every connection has a queue of
+ * frames, written in order by a pool of sender threads, so a slow client only
+ * delays its own frames. A skippable frame replaces the skippable one still
+ * queued, so a slow client gets the latest data instead of a backlog.
  */
 class WebSocketHandler : public CivetWebSocketHandler {
  public:
@@ -53,6 +63,34 @@ class WebSocketHandler : public CivetWebSocketHandler {
   using Connection = struct mg_connection;
   using MessageHandler = std::function<void(const Json &, Connection *)>;
   using ConnectionReadyHandler = std::function<void(Connection *)>;
+  using ConnectionCloseHandler = std::function<void(Connection *)>;
+
+  /**
+   * @brief Statistics of the data sent to a client.
+   */
+  struct ConnectionStats {
+    std::string remote_address;
+    uint64_t sent_frames = 0;
+    uint64_t sent_bytes = 0;
+    // Skippable frames replaced by a newer one or dropped on a full queue.
+    uint64_t dropped_frames = 0;
+    uint64_t failed_frames = 0;
+    size_t queued_frames = 0;
+    // Time from the queueing of a frame to the end of its writing.
+    double mean_latency_ms = 0.0;
+    double max_latency_ms = 0.0;
+  };
+
+  /**
+   * @brief Constructor.
+   * @param num_sender_threads The number of threads writing the frames.
+   * @param max_queued_frames The number of frames a connection can queue,
+   * beyond which the skippable frames are dropped.
+   */
+  explicit WebSocketHandler(int num_sender_threads = 2,
+                            size_t max_queued_frames = 16);
+
+  ~WebSocketHandler();
 
   /**
    * @brief Callback method for when the client intends to establish a websocket
@@ -101,6 +139,7 @@ class WebSocketHandler : public CivetWebSocketHandler {
   /**
    * @brief Sends the provided data to all the connected clients.
    * @param data The message string to be sent.
+   * @return False if the data is not queued for some client.
    */
   bool BroadcastData(const std::string &data, bool skippable = false);
 
@@ -111,10 +150,24 @@ class WebSocketHandler : public CivetWebSocketHandler {
    * @param data The message string to be sent.
    * @param skippable whether the data is allowed to be skipped if some other is
    * being sent to this connection.
+   * @return False if the data is not queued.
    */
   bool SendData(Connection *conn, const std::string &data,
                 bool skippable = false);
 
+  /**
+   * @brief Sends the provided data to a specific connected client in a binary
+   * frame.
+   *
+   * @param conn The connection to send to.
+   * @param data The bytes to be sent.
+   * @param skippable whether the data is allowed to be skipped if some other is
+   * being sent to this connection.
+   * @return False if the data is not queued.
+   */
+  bool SendBinaryData(Connection *conn, const std::string &data,
+                      bool skippable = false);
+
   /**
    * @brief Add a new message handler for a message type.
    * @param type The name/key to identify the message type.
@@ -132,20 +185,74 @@ class WebSocketHandler : public CivetWebSocketHandler {
     connection_ready_handlers_.emplace_back(handler);
   }
 
+  /**
+   * @brief Add a new handler for closed connections.
+   * @param handler The function to handle the connection being closed, after
+   * which nothing is sent to it.
+   */
+  void RegisterConnectionCloseHandler(ConnectionCloseHandler handler) {
+    connection_close_handlers_.emplace_back(handler);
+  }
+
+  /**
+   * @brief Gets the statistics of the connected clients.
+   */
+  std::vector<ConnectionStats> GetConnectionStats() const;
+
  private:
+  struct Frame {
+    std::string data;
+    int op_code = 0;
+    bool skippable = false;
+    std::chrono::steady_clock::time_point queue_time;
+  };
+
+  struct ConnectionState {
+    // Guards all but send_mutex.
+    std::mutex mutex;
+    std::deque<Frame> frames;
+    // Whether the connection is in the run queue or being sent to.
+    bool scheduled = false;
+    bool closed = false;
+    ConnectionStats stats;
+    // Held while writing, so that the connection is not closed meanwhile.
+    std::mutex send_mutex;
+  };
+
+  using ConnectionStatePtr = std::shared_ptr<ConnectionState>;
+
+  bool SendData(Connection *conn, const std::string &data, bool skippable,
+                int op_code);
+
+  // Writes the frames of the connections in the run queue, one frame at a
+  // time so that the connections with many frames take turns with others.
+  void SenderThreadFunc();
+
+  bool WriteFrame(Connection *conn, const Frame &frame);
+
   // Message handlers keyed by message type.
   std::unordered_map<std::string, MessageHandler> message_handlers_;
   // New connection ready handlers.
   std::vector<ConnectionReadyHandler> connection_ready_handlers_;
+  // Closed connection handlers.
+  std::vector<ConnectionCloseHandler> connection_close_handlers_;
 
   // The mutex guarding the connection set. We are not using read
   // write lock, as the server is not expected to get many clients
   // (connections).
   mutable std::mutex mutex_;
 
-  // The pool of all maintained connections. Each connection has a lock to
-  // against simultaneous write.
-  std::unordered_map<Connection *, std::shared_ptr<std::mutex>> connections_;
+  // The pool of all maintained connections with their frame queues.
+  std::unordered_map<Connection *, ConnectionStatePtr> connections_;
+
+  const size_t max_queued_frames_;
+
+  // The connections with frames to send, for the sender threads.
+  std::mutex run_mutex_;
+  std::condition_variable run_cvar_;
+  std::deque<std::pair<Connection *, ConnectionStatePtr>> run_queue_;
+  bool stopped_ = false;
+  std::vector<std::thread> sender_threads_;
 };
 
 }  // namespace dreamview
@@ -80,6 +80,12 @@ TEST(WebSocketTest, IntegrationTest) {
 
   // Check that the 3 messages are successfully received and processed.
   EXPECT_THAT(client.GetReceivedMessages(), ElementsAre("0", "1", "2"));
+
+  const auto stats = handler.GetConnectionStats();
+  ASSERT_EQ(1u, stats.size());
+  EXPECT_EQ(3u, stats[0].sent_frames);
+  EXPECT_EQ(0u, stats[0].dropped_frames);
+  EXPECT_EQ(0u, stats[0].queued_frames);
 }
 
 }  // namespace dreamview
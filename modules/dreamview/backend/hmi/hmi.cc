@@ -285,6 +285,15 @@ void HMI::RegisterMessageHandlers() {
         *status_.mutable_system_status() = system_status;
         BroadcastHMIStatus();
       });
+
+  // Received new resource usage, broadcast to clients.
+  if (AdapterManager::GetResourceStatus()) {
+    AdapterManager::AddResourceStatusCallback(
+        [this](const monitor::ResourceStatus &resource_status) {
+          *status_.mutable_resource_status() = resource_status;
+          BroadcastHMIStatus();
+        });
+  }
 }
 
 void HMI::BroadcastHMIStatus() const {
@@ -350,7 +359,7 @@ void HMI::ChangeMapTo(const std::string &map_name) {
     return;
   }
   status_.set_current_map(map_name);
-  apollo::common::KVDB::Put("apollo:dreamview:map", map_name);
+  apollo::common::KVDB::PutAsync("apollo:dreamview:map", map_name);
 
   FLAGS_map_dir = *map_dir;
   // Append new map_dir flag to global flagfile.
@@ -374,7 +383,7 @@ void HMI::ChangeVehicleTo(const std::string &vehicle_name) {
     return;
   }
   status_.set_current_vehicle(vehicle_name);
-  apollo::common::KVDB::Put("apollo:dreamview:vehicle", vehicle_name);
+  apollo::common::KVDB::PutAsync("apollo:dreamview:vehicle", vehicle_name);
 
   CHECK(VehicleManager::instance()->UseVehicle(*vehicle));
   RunModeCommand("stop");
@@ -393,7 +402,7 @@ void HMI::ChangeModeTo(const std::string &mode_name) {
   }
   const std::string previous_mode = status_.current_mode();
   status_.set_current_mode(mode_name);
-  apollo::common::KVDB::Put("apollo:dreamview:mode", mode_name);
+  apollo::common::KVDB::PutAsync("apollo:dreamview:mode", mode_name);
 
   RunModeCommand(previous_mode, "stop");
   BroadcastHMIStatus();
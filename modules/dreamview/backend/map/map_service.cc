@@ -17,10 +17,16 @@
 #include "modules/dreamview/backend/map/map_service.h"
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <functional>
+
+#include "google/protobuf/io/gzip_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
 
 #include "modules/common/util/json_util.h"
 #include "modules/common/util/string_util.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
 #include "modules/map/hdmap/hdmap_util.h"
 
 namespace apollo {
@@ -28,14 +34,11 @@ namespace dreamview {
 
 using apollo::common::PointENU;
 using apollo::common::util::JsonUtil;
+using apollo::common::util::JsonWriter;
 using apollo::hdmap::Map;
+using apollo::hdmap::MapElements;
 using apollo::hdmap::Id;
 using apollo::hdmap::LaneInfoConstPtr;
-using apollo::hdmap::CrosswalkInfoConstPtr;
-using apollo::hdmap::JunctionInfoConstPtr;
-using apollo::hdmap::SignalInfoConstPtr;
-using apollo::hdmap::StopSignInfoConstPtr;
-using apollo::hdmap::YieldSignInfoConstPtr;
 using apollo::hdmap::HDMapUtil;
 using apollo::hdmap::Path;
 using apollo::hdmap::PncMap;
@@ -43,6 +46,8 @@ using apollo::hdmap::RouteSegments;
 using apollo::hdmap::SimMapFile;
 using apollo::routing::RoutingResponse;
 using apollo::routing::RoutingRequest;
+using google::protobuf::io::GzipOutputStream;
+using google::protobuf::io::StringOutputStream;
 
 namespace {
 
@@ -71,6 +76,14 @@ void ExtractOverlapIds(const std::vector<MapElementInfoConstPtr> &items,
   std::sort(ids->begin(), ids->end());
 }
 
+bool Compress(const Map &map, std::string *compressed) {
+  StringOutputStream raw_output(compressed);
+  GzipOutputStream::Options options;
+  options.format = GzipOutputStream::GZIP;
+  GzipOutputStream gzip_output(&raw_output, options);
+  return map.SerializeToZeroCopyStream(&gzip_output) && gzip_output.Close();
+}
+
 }  // namespace
 
 MapElementIds::MapElementIds(const nlohmann::json &json_object)
@@ -109,6 +122,25 @@ nlohmann::json MapElementIds::Json() const {
   return result;
 }
 
+void MapElementIds::WriteJson(JsonWriter *writer) const {
+  writer->BeginObject();
+  writer->Key("lane");
+  writer->StringArray(lane);
+  writer->Key("crosswalk");
+  writer->StringArray(crosswalk);
+  writer->Key("junction");
+  writer->StringArray(junction);
+  writer->Key("signal");
+  writer->StringArray(signal);
+  writer->Key("stopSign");
+  writer->StringArray(stop_sign);
+  writer->Key("yield");
+  writer->StringArray(yield);
+  writer->Key("overlap");
+  writer->StringArray(overlap);
+  writer->EndObject();
+}
+
 MapService::MapService(bool use_sim_map) : use_sim_map_(use_sim_map) {
   ReloadMap(false);
 }
@@ -127,6 +159,12 @@ bool MapService::ReloadMap(bool force_reload) {
   } else {
     pending_ = false;
   }
+  {
+    std::lock_guard<std::mutex> lock(tile_mutex_);
+    ++map_version_;
+    tiles_.clear();
+    tile_order_.clear();
+  }
 
   // Update the x,y-offsets if present.
   UpdateOffsets();
@@ -187,43 +225,23 @@ MapElementIds MapService::CollectMapElementIds(const PointENU &point,
   }
   boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
 
-  std::vector<LaneInfoConstPtr> lanes;
-  if (sim_map_->GetLanes(point, radius, &lanes) != 0) {
-    AERROR << "Fail to get lanes from sim_map.";
-  }
-  ExtractIds(lanes, &result.lane);
-
-  std::vector<CrosswalkInfoConstPtr> crosswalks;
-  if (sim_map_->GetCrosswalks(point, radius, &crosswalks) != 0) {
-    AERROR << "Fail to get crosswalks from sim_map.";
-  }
-  ExtractIds(crosswalks, &result.crosswalk);
-
-  std::vector<JunctionInfoConstPtr> junctions;
-  if (sim_map_->GetJunctions(point, radius, &junctions) != 0) {
-    AERROR << "Fail to get junctions from sim_map.";
-  }
-  ExtractIds(junctions, &result.junction);
-
-  std::vector<SignalInfoConstPtr> signals;
-  if (sim_map_->GetSignals(point, radius, &signals) != 0) {
-    AERROR << "Failed to get signals from sim_map.";
-  }
-
-  ExtractIds(signals, &result.signal);
-  ExtractOverlapIds(signals, &result.overlap);
-
-  std::vector<StopSignInfoConstPtr> stop_signs;
-  if (sim_map_->GetStopSigns(point, radius, &stop_signs) != 0) {
-    AERROR << "Failed to get stop signs from sim_map.";
+  // All the kinds are found by a single query of the map.
+  MapElements elements;
+  if (sim_map_->GetMapElements(
+          point, radius,
+          hdmap::MAP_ELEMENT_LANE | hdmap::MAP_ELEMENT_CROSSWALK |
+              hdmap::MAP_ELEMENT_JUNCTION | hdmap::MAP_ELEMENT_SIGNAL |
+              hdmap::MAP_ELEMENT_STOP_SIGN | hdmap::MAP_ELEMENT_YIELD_SIGN,
+          &elements) != 0) {
+    AERROR << "Fail to get map elements from sim_map.";
   }
-  ExtractIds(stop_signs, &result.stop_sign);
-
-  std::vector<YieldSignInfoConstPtr> yield_signs;
-  if (sim_map_->GetYieldSigns(point, radius, &yield_signs) != 0) {
-    AERROR << "Failed to get yield signs from sim_map.";
-  }
-  ExtractIds(yield_signs, &result.yield);
+  ExtractIds(elements.lanes, &result.lane);
+  ExtractIds(elements.crosswalks, &result.crosswalk);
+  ExtractIds(elements.junctions, &result.junction);
+  ExtractIds(elements.signals, &result.signal);
+  ExtractOverlapIds(elements.signals, &result.overlap);
+  ExtractIds(elements.stop_signs, &result.stop_sign);
+  ExtractIds(elements.yield_signs, &result.yield);
 
   return result;
 }
@@ -296,6 +314,59 @@ Map MapService::RetrieveMapElements(const MapElementIds &ids) const {
   return result;
 }
 
+std::shared_ptr<const MapTile> MapService::GetMapTile(int x, int y) const {
+  const auto key = std::make_pair(x, y);
+  uint64_t map_version = 0;
+  {
+    std::lock_guard<std::mutex> lock(tile_mutex_);
+    auto iter = tiles_.find(key);
+    if (iter != tiles_.end()) {
+      return iter->second;
+    }
+    map_version = map_version_;
+  }
+  if (pending_) {
+    return nullptr;
+  }
+
+  // The elements within the circle through the corners of the tile cover it.
+  // An element near a border is in all the tiles it reaches.
+  const double tile_size = FLAGS_map_tile_size;
+  PointENU center;
+  center.set_x((x + 0.5) * tile_size);
+  center.set_y((y + 0.5) * tile_size);
+  const Map map = RetrieveMapElements(
+      CollectMapElementIds(center, tile_size * M_SQRT1_2));
+
+  auto tile = std::make_shared<MapTile>();
+  tile->x = x;
+  tile->y = y;
+  if (!map.SerializeToString(&tile->data) ||
+      !Compress(map, &tile->compressed_data)) {
+    AERROR << "Failed to serialize the map tile " << x << ", " << y;
+    return nullptr;
+  }
+  tile->etag = apollo::common::util::StrCat(
+      "\"", std::hash<std::string>()(tile->data), "\"");
+
+  std::lock_guard<std::mutex> lock(tile_mutex_);
+  if (map_version != map_version_ || FLAGS_map_tile_cache_size <= 0) {
+    return tile;
+  }
+  auto inserted = tiles_.emplace(key, tile);
+  if (!inserted.second) {
+    // Built by another request in the meantime.
+    return inserted.first->second;
+  }
+  tile_order_.push_back(key);
+  while (tile_order_.size() >
+         static_cast<size_t>(FLAGS_map_tile_cache_size)) {
+    tiles_.erase(tile_order_.front());
+    tile_order_.pop_front();
+  }
+  return tile;
+}
+
 bool MapService::GetNearestLane(const double x, const double y,
                                 LaneInfoConstPtr *nearest_lane,
                                 double *nearest_s, double *nearest_l) const {
@@ -21,12 +21,19 @@
 #ifndef MODULES_DREAMVIEW_BACKEND_MAP_MAP_SERVICE_H_
 #define MODULES_DREAMVIEW_BACKEND_MAP_MAP_SERVICE_H_
 
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "boost/thread/locks.hpp"
 #include "boost/thread/shared_mutex.hpp"
 
+#include "modules/common/util/json_writer.h"
 #include "modules/map/pnc_map/pnc_map.h"
 #include "third_party/json/json.hpp"
 
@@ -61,6 +68,20 @@ struct MapElementIds {
 
   size_t Hash() const;
   nlohmann::json Json() const;
+  // Writes the same json as Json() without building it.
+  void WriteJson(apollo::common::util::JsonWriter *writer) const;
+};
+
+// A square of the map, FLAGS_map_tile_size meters wide, with the serialized
+// hdmap::Map of the map elements around it.
+struct MapTile {
+  int x = 0;
+  int y = 0;
+  std::string data;
+  // The data compressed by gzip.
+  std::string compressed_data;
+  // Changes only when the data does.
+  std::string etag;
 };
 
 class MapService {
@@ -81,6 +102,17 @@ class MapService {
   // javascript clients.
   hdmap::Map RetrieveMapElements(const MapElementIds &ids) const;
 
+  /**
+   * @brief Gets the tile covering [x, x + 1) * FLAGS_map_tile_size on the x
+   * axis and [y, y + 1) * FLAGS_map_tile_size on the y axis. The tiles are
+   * built on their first request and cached until the map is reloaded.
+   * @param x the column of the tile
+   * @param y the row of the tile
+   * @return The tile, which has every map element within the circle around
+   * it, or nullptr if the map is not loaded yet.
+   */
+  std::shared_ptr<const MapTile> GetMapTile(int x, int y) const;
+
   bool GetPoseWithRegardToLane(const double x, const double y, double *theta,
                                double *s) const;
 
@@ -124,6 +156,16 @@ class MapService {
 
   // RW lock to protect map data
   mutable boost::shared_mutex mutex_;
+
+  // The cached tiles in the order of their building, the oldest are evicted
+  // first. Guarded by tile_mutex_, which is taken after mutex_ if both are.
+  mutable std::map<std::pair<int, int>, std::shared_ptr<const MapTile>>
+      tiles_;
+  mutable std::deque<std::pair<int, int>> tile_order_;
+  // Increased on every reload, so that a tile built from the previous map is
+  // not cached.
+  uint64_t map_version_ = 0;
+  mutable std::mutex tile_mutex_;
 };
 
 }  // namespace dreamview
@@ -94,6 +94,35 @@ TEST_F(MapServiceTest, RetrieveMapElements) {
   EXPECT_EQ("l1", map.lane(0).id().id());
 }
 
+TEST_F(MapServiceTest, GetMapTile) {
+  // The tile of the start point of the lane.
+  auto tile = map_service->GetMapTile(-19, -31);
+  ASSERT_NE(nullptr, tile);
+  EXPECT_EQ(-19, tile->x);
+  EXPECT_EQ(-31, tile->y);
+  Map map;
+  ASSERT_TRUE(map.ParseFromString(tile->data));
+  ASSERT_EQ(1, map.lane_size());
+  EXPECT_EQ("l1", map.lane(0).id().id());
+  EXPECT_FALSE(tile->compressed_data.empty());
+  EXPECT_FALSE(tile->etag.empty());
+
+  // The tile is cached.
+  EXPECT_EQ(tile, map_service->GetMapTile(-19, -31));
+
+  auto empty_tile = map_service->GetMapTile(0, 0);
+  ASSERT_NE(nullptr, empty_tile);
+  EXPECT_TRUE(empty_tile->data.empty());
+  EXPECT_NE(tile->etag, empty_tile->etag);
+
+  // The tile is built again from the reloaded map, with the same data.
+  ASSERT_TRUE(map_service->ReloadMap(false));
+  auto reloaded_tile = map_service->GetMapTile(-19, -31);
+  ASSERT_NE(nullptr, reloaded_tile);
+  EXPECT_NE(tile, reloaded_tile);
+  EXPECT_EQ(tile->etag, reloaded_tile->etag);
+}
+
 TEST_F(MapServiceTest, GetStartPoint) {
   PointENU start_point;
   EXPECT_TRUE(map_service->GetStartPoint(&start_point));
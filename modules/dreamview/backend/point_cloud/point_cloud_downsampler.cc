@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/dreamview/backend/point_cloud/point_cloud_downsampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+namespace apollo {
+namespace dreamview {
+namespace {
+
+// The voxel coordinates are packed in 21 bits each.
+constexpr int kVoxelBits = 21;
+constexpr uint32_t kMaxVoxelIndex = (1u << kVoxelBits) - 1;
+constexpr int kQuantizedMax = std::numeric_limits<int16_t>::max();
+
+inline uint64_t VoxelKey(const uint32_t *voxel, const int level) {
+  return (static_cast<uint64_t>(voxel[0] >> level) << (2 * kVoxelBits)) |
+         (static_cast<uint64_t>(voxel[1] >> level) << kVoxelBits) |
+         static_cast<uint64_t>(voxel[2] >> level);
+}
+
+inline void AppendInt16(const int value, std::string *bytes) {
+  const uint16_t bits = static_cast<uint16_t>(static_cast<int16_t>(value));
+  bytes->push_back(static_cast<char>(bits & 0xff));
+  bytes->push_back(static_cast<char>(bits >> 8));
+}
+
+}  // namespace
+
+void DownsamplePointCloud(const std::vector<float> &xyz, const int max_points,
+                          const double resolution,
+                          const double min_voxel_size, PointCloud *cloud) {
+  // The voxels tile the quantized range from its lower corner, so that their
+  // indices are not negative, and are at least a few units large so that the
+  // indices fit.
+  const double range = kQuantizedMax * resolution;
+  const double voxel_size = std::max(
+      min_voxel_size, 2.0 * range / static_cast<double>(kMaxVoxelIndex));
+  const size_t num_input = xyz.size() / 3;
+  std::vector<int16_t> quantized;
+  std::vector<uint32_t> voxels;
+  quantized.reserve(num_input * 3);
+  voxels.reserve(num_input * 3);
+  for (size_t i = 0; i < num_input; ++i) {
+    const float *point = &xyz[i * 3];
+    int16_t quantized_point[3];
+    bool in_range = true;
+    for (int j = 0; j < 3; ++j) {
+      // Also false for NaN.
+      if (!(std::abs(point[j]) <= range)) {
+        in_range = false;
+        break;
+      }
+      quantized_point[j] =
+          static_cast<int16_t>(std::lround(point[j] / resolution));
+    }
+    if (!in_range) {
+      continue;
+    }
+    for (int j = 0; j < 3; ++j) {
+      quantized.push_back(quantized_point[j]);
+      voxels.push_back(std::min(
+          kMaxVoxelIndex,
+          static_cast<uint32_t>((point[j] + range) / voxel_size)));
+    }
+  }
+  const size_t num_points = max_points > 0 ? quantized.size() / 3 : 0;
+
+  // Finds the finest level of voxels which gives few enough points, with an
+  // early stop on the levels which give too many.
+  const size_t budget = static_cast<size_t>(std::max(max_points, 0));
+  std::unordered_map<uint64_t, uint32_t> voxel_index;
+  voxel_index.reserve(std::min(num_points, budget + 1));
+  int level = 0;
+  for (; level <= kVoxelBits; ++level) {
+    voxel_index.clear();
+    bool fits = true;
+    for (size_t i = 0; i < num_points; ++i) {
+      const auto inserted = voxel_index.emplace(
+          VoxelKey(&voxels[i * 3], level),
+          static_cast<uint32_t>(voxel_index.size()));
+      if (inserted.second && voxel_index.size() > budget) {
+        fits = false;
+        break;
+      }
+    }
+    if (fits) {
+      break;
+    }
+  }
+
+  // The centroids of the points of each voxel.
+  std::vector<int64_t> sums(voxel_index.size() * 3, 0);
+  std::vector<int> counts(voxel_index.size(), 0);
+  for (size_t i = 0; i < num_points; ++i) {
+    const uint32_t index = voxel_index[VoxelKey(&voxels[i * 3], level)];
+    for (int j = 0; j < 3; ++j) {
+      sums[index * 3 + j] += quantized[i * 3 + j];
+    }
+    ++counts[index];
+  }
+  std::string *bytes = cloud->mutable_points();
+  bytes->clear();
+  bytes->reserve(counts.size() * 3 * sizeof(int16_t));
+  for (size_t i = 0; i < counts.size(); ++i) {
+    for (int j = 0; j < 3; ++j) {
+      AppendInt16(static_cast<int>(std::llround(
+                      static_cast<double>(sums[i * 3 + j]) / counts[i])),
+                  bytes);
+    }
+  }
+  cloud->set_resolution(resolution);
+  cloud->set_voxel_size(voxel_size * static_cast<double>(1 << level));
+  cloud->set_num_points(static_cast<uint32_t>(counts.size()));
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,56 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_DOWNSAMPLER_H_
+#define MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_DOWNSAMPLER_H_
+
+#include <vector>
+
+#include "modules/dreamview/proto/point_cloud.pb.h"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @brief Downsamples the points to the centroids of the voxels they fall in,
+ * with the smallest voxels from min_voxel_size up, doubled each time, which
+ * give at most max_points points. The centroids are quantized to int16
+ * numbers of resolutions, and the points out of their range are dropped.
+ * @param xyz the x, y and z coordinates of each point, one after the other
+ * @param max_points the max number of points of the downsampled cloud
+ * @param resolution the length in meters of a unit of the quantized
+ * coordinates
+ * @param min_voxel_size the smallest side length in meters of the voxels
+ * @param cloud the cloud whose resolution, voxel_size, num_points and points
+ * are to be filled
+ */
+void DownsamplePointCloud(const std::vector<float> &xyz, int max_points,
+                          double resolution, double min_voxel_size,
+                          PointCloud *cloud);
+
+}  // namespace dreamview
+}  // namespace apollo
+
+#endif  // MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_DOWNSAMPLER_H_
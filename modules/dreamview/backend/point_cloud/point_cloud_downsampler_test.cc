@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/dreamview/backend/point_cloud/point_cloud_downsampler.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+std::vector<int> Points(const PointCloud &cloud) {
+  std::vector<int> points;
+  const std::string &bytes = cloud.points();
+  for (size_t i = 0; i + 1 < bytes.size(); i += 2) {
+    const uint16_t bits = static_cast<uint8_t>(bytes[i]) |
+                          (static_cast<uint8_t>(bytes[i + 1]) << 8);
+    points.push_back(static_cast<int16_t>(bits));
+  }
+  return points;
+}
+
+}  // namespace
+
+TEST(PointCloudDownsamplerTest, QuantizeAndMerge) {
+  // The first two points share a voxel of 1 meter, the voxels being tiled
+  // from -327.67 meters, the third one is alone and the last two are out of
+  // range.
+  const std::vector<float> xyz = {
+      1.8f, 2.4f, -0.5f, 1.9f, 2.5f, -0.6f, -5.0f, 0.0f, 3.0f,
+      400.0f, 0.0f, 0.0f, std::numeric_limits<float>::quiet_NaN(), 0.0f,
+      0.0f};
+  PointCloud cloud;
+  DownsamplePointCloud(xyz, 10, 0.01, 1.0, &cloud);
+  EXPECT_EQ(2, cloud.num_points());
+  EXPECT_DOUBLE_EQ(0.01, cloud.resolution());
+  EXPECT_DOUBLE_EQ(1.0, cloud.voxel_size());
+  EXPECT_EQ(std::vector<int>({185, 245, -55, -500, 0, 300}), Points(cloud));
+
+  DownsamplePointCloud(xyz, 0, 0.01, 1.0, &cloud);
+  EXPECT_EQ(0, cloud.num_points());
+  EXPECT_TRUE(cloud.points().empty());
+}
+
+TEST(PointCloudDownsamplerTest, Budget) {
+  std::mt19937 random(0);
+  std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+  std::vector<float> xyz;
+  for (int i = 0; i < 100000 * 3; ++i) {
+    xyz.push_back(coordinate(random));
+  }
+
+  for (const int max_points : {1, 100, 5000, 200000}) {
+    PointCloud cloud;
+    DownsamplePointCloud(xyz, max_points, 0.01, 0.1, &cloud);
+    EXPECT_LE(cloud.num_points(), max_points);
+    EXPECT_EQ(cloud.num_points() * 3 * 2, cloud.points().size());
+    // A finer level would give too many points.
+    if (cloud.voxel_size() > 0.1) {
+      PointCloud finer;
+      DownsamplePointCloud(xyz, 1000000, 0.01, cloud.voxel_size() / 2.0,
+                           &finer);
+      EXPECT_GT(finer.num_points(), max_points);
+    }
+  }
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,222 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/dreamview/backend/point_cloud/point_cloud_updater.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/log.h"
+#include "modules/dreamview/backend/common/dreamview_gflags.h"
+#include "modules/dreamview/backend/point_cloud/point_cloud_downsampler.h"
+#include "modules/dreamview/proto/point_cloud.pb.h"
+
+namespace apollo {
+namespace dreamview {
+
+using apollo::common::adapter::AdapterManager;
+using apollo::localization::LocalizationEstimate;
+using Json = nlohmann::json;
+
+PointCloudUpdater::PointCloudUpdater(WebSocketHandler *websocket,
+                                     const MapService *map_service)
+    : websocket_(websocket), map_service_(map_service) {
+  AdapterManager::AddPointCloudCallback(&PointCloudUpdater::OnPointCloud,
+                                        this);
+  AdapterManager::AddLocalizationCallback(&PointCloudUpdater::OnLocalization,
+                                          this);
+
+  websocket_->RegisterMessageHandler(
+      "RequestPointCloud",
+      [this](const Json &json, WebSocketHandler::Connection *conn) {
+        OnRequest(json, conn);
+      });
+
+  websocket_->RegisterConnectionCloseHandler(
+      [this](WebSocketHandler::Connection *conn) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        clients_.erase(conn);
+        if (clients_.empty()) {
+          // Nobody would see the cloud.
+          cloud_.reset();
+          xyz_.reset();
+          frames_.clear();
+        }
+      });
+}
+
+void PointCloudUpdater::OnPointCloud(const sensor_msgs::PointCloud2 &cloud) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (clients_.empty()) {
+      return;
+    }
+  }
+
+  // Only the copy is made on the callback thread, the cloud is decoded and
+  // downsampled when a client asks for it.
+  auto latest = std::make_shared<const sensor_msgs::PointCloud2>(cloud);
+  std::unique_lock<std::mutex> lock(mutex_);
+  cloud_ = latest;
+  cloud_pose_ = pose_;
+  ++cloud_seq_;
+}
+
+void PointCloudUpdater::OnLocalization(
+    const LocalizationEstimate &localization) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  pose_ = localization.pose();
+}
+
+void PointCloudUpdater::OnRequest(const Json &json,
+                                  WebSocketHandler::Connection *conn) {
+  int max_points = FLAGS_point_cloud_max_points;
+  auto requested = json.find("maxPoints");
+  if (requested != json.end() && requested->is_number()) {
+    max_points = std::min(max_points, std::max(0, requested->get<int>()));
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  ClientState state;
+  {
+    // The client is recorded even if there is no cloud to send yet, for the
+    // next clouds to be kept.
+    std::unique_lock<std::mutex> lock(mutex_);
+    state = clients_[conn];
+    if (FLAGS_point_cloud_max_fps > 0.0 &&
+        now - state.send_time <
+            std::chrono::duration<double>(1.0 / FLAGS_point_cloud_max_fps)) {
+      return;
+    }
+  }
+
+  uint64_t seq = 0;
+  auto frame = GetLatestFrame(max_points, &seq);
+  // The client has the latest cloud already, or there is none.
+  if (frame == nullptr || seq == state.seq) {
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto iter = clients_.find(conn);
+    if (iter == clients_.end()) {
+      // Closed meanwhile.
+      return;
+    }
+    iter->second.seq = seq;
+    iter->second.send_time = now;
+  }
+  websocket_->SendBinaryData(conn, *frame, true);
+}
+
+std::shared_ptr<const std::string> PointCloudUpdater::GetLatestFrame(
+    const int max_points, uint64_t *seq) {
+  CloudPtr cloud;
+  localization::Pose pose;
+  std::shared_ptr<const std::vector<float>> xyz;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    *seq = cloud_seq_;
+    if (cloud_ == nullptr) {
+      return nullptr;
+    }
+    if (xyz_seq_ == cloud_seq_) {
+      auto iter = frames_.find(max_points);
+      if (iter != frames_.end()) {
+        return iter->second;
+      }
+      xyz = xyz_;
+    }
+    cloud = cloud_;
+    pose = cloud_pose_;
+  }
+
+  // The clients asking for the same cloud at the same time may both build
+  // it, which is not worth a lock around the downsampling.
+  if (xyz == nullptr) {
+    std::shared_ptr<std::vector<float>> points(new std::vector<float>());
+    if (!ExtractXyz(*cloud, points.get())) {
+      AERROR_EVERY(100) << "The point cloud has no FLOAT32 x, y and z.";
+    }
+    xyz = points;
+  }
+  PointCloud point_cloud;
+  point_cloud.set_sequence_num(*seq);
+  point_cloud.set_timestamp_sec(cloud->header.stamp.toSec());
+  point_cloud.set_frame_id(cloud->header.frame_id);
+  point_cloud.set_adc_position_x(pose.position().x() +
+                                 map_service_->GetXOffset());
+  point_cloud.set_adc_position_y(pose.position().y() +
+                                 map_service_->GetYOffset());
+  point_cloud.set_adc_heading(pose.heading());
+  DownsamplePointCloud(*xyz, max_points, FLAGS_point_cloud_resolution,
+                       FLAGS_point_cloud_min_voxel_size, &point_cloud);
+  auto frame = std::make_shared<std::string>();
+  point_cloud.SerializeToString(frame.get());
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (cloud_seq_ == *seq) {
+    if (xyz_seq_ != *seq) {
+      xyz_seq_ = *seq;
+      xyz_ = xyz;
+      frames_.clear();
+    }
+    frames_[max_points] = frame;
+  }
+  return frame;
+}
+
+bool PointCloudUpdater::ExtractXyz(const sensor_msgs::PointCloud2 &cloud,
+                                   std::vector<float> *xyz) {
+  xyz->clear();
+  int offsets[3] = {-1, -1, -1};
+  static const char *kNames[3] = {"x", "y", "z"};
+  for (const auto &field : cloud.fields) {
+    for (int j = 0; j < 3; ++j) {
+      if (field.name == kNames[j] &&
+          field.datatype == sensor_msgs::PointField::FLOAT32) {
+        offsets[j] = static_cast<int>(field.offset);
+      }
+    }
+  }
+  const size_t point_step = cloud.point_step;
+  for (int j = 0; j < 3; ++j) {
+    if (offsets[j] < 0 || offsets[j] + sizeof(float) > point_step) {
+      return false;
+    }
+  }
+  // The floats are copied as they are, the clouds being little endian as
+  // the hosts.
+  if (cloud.is_bigendian) {
+    return false;
+  }
+
+  const size_t num_points = cloud.data.size() / point_step;
+  xyz->resize(num_points * 3);
+  const uint8_t *data = cloud.data.data();
+  for (size_t i = 0; i < num_points; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      std::memcpy(&(*xyz)[i * 3 + j], data + i * point_step + offsets[j],
+                  sizeof(float));
+    }
+  }
+  return true;
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_UPDATER_H_
+#define MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_UPDATER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "sensor_msgs/PointCloud2.h"
+
+#include "modules/dreamview/backend/handlers/websocket.h"
+#include "modules/dreamview/backend/map/map_service.h"
+#include "modules/localization/proto/localization.pb.h"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class PointCloudUpdater
+ * @brief Sends the latest point cloud to the clients of its websocket which
+ * ask for it with RequestPointCloud, as a PointCloud binary frame. The cloud
+ * is downsampled to the max number of points asked by the client, at most
+ * FLAGS_point_cloud_max_points, and a client gets at most
+ * FLAGS_point_cloud_max_fps clouds per second. The clouds are only kept
+ * while a client is connected, and each one is decoded and downsampled once
+ * per max number of points.
+ */
+class PointCloudUpdater {
+ public:
+  /**
+   * @brief Constructor with the websocket handler.
+   * @param websocket Pointer of the websocket handler that has been attached
+   * to the server.
+   * @param map_service Pointer of the map service, the offsets of which are
+   * applied to the position of the car.
+   */
+  PointCloudUpdater(WebSocketHandler *websocket,
+                    const MapService *map_service);
+
+ private:
+  using CloudPtr = std::shared_ptr<const sensor_msgs::PointCloud2>;
+
+  struct ClientState {
+    // The sequence number of the last cloud sent.
+    uint64_t seq = 0;
+    std::chrono::steady_clock::time_point send_time;
+  };
+
+  void OnPointCloud(const sensor_msgs::PointCloud2 &cloud);
+
+  void OnLocalization(const localization::LocalizationEstimate &localization);
+
+  void OnRequest(const nlohmann::json &json,
+                 WebSocketHandler::Connection *conn);
+
+  /**
+   * @brief Gets the serialized PointCloud of the latest cloud downsampled to
+   * max_points, which is built if no client has asked for it yet.
+   * @param seq the sequence number of the cloud, 0 if there is none yet
+   * @return The serialized PointCloud, or nullptr if there is no cloud.
+   */
+  std::shared_ptr<const std::string> GetLatestFrame(int max_points,
+                                                    uint64_t *seq);
+
+  /**
+   * @brief Gets the x, y and z coordinates of the points of a cloud, one
+   * after the other.
+   * @return False if the cloud has no FLOAT32 x, y and z fields.
+   */
+  static bool ExtractXyz(const sensor_msgs::PointCloud2 &cloud,
+                         std::vector<float> *xyz);
+
+  WebSocketHandler *websocket_;
+  const MapService *map_service_;
+
+  // Guards all the members below.
+  std::mutex mutex_;
+  std::unordered_map<WebSocketHandler::Connection *, ClientState> clients_;
+
+  // The latest cloud, the sequence number of which is cloud_seq_, and the
+  // latest pose of the car when it was received.
+  CloudPtr cloud_;
+  uint64_t cloud_seq_ = 0;
+  localization::Pose cloud_pose_;
+  localization::Pose pose_;
+
+  // The points of cloud_seq_, decoded when first asked for, and its frames
+  // keyed by max number of points.
+  uint64_t xyz_seq_ = 0;
+  std::shared_ptr<const std::vector<float>> xyz_;
+  std::unordered_map<int, std::shared_ptr<const std::string>> frames_;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
+
+#endif  // MODULES_DREAMVIEW_BACKEND_POINT_CLOUD_POINT_CLOUD_UPDATER_H_
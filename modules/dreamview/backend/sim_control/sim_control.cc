@@ -16,8 +16,12 @@
 
 #include "modules/dreamview/backend/sim_control/sim_control.h"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 
+#include "rosgraph_msgs/Clock.h"
+
 #include "modules/common/math/math_utils.h"
 #include "modules/common/math/quaternion.h"
 #include "modules/common/time/time.h"
@@ -68,6 +72,8 @@ SimControl::SimControl(const MapService* map_service)
       re_routing_triggered_(false),
       enabled_(FLAGS_enable_sim_control) {}
 
+SimControl::~SimControl() { Stop(); }
+
 void SimControl::Init(bool set_start_point, double start_velocity,
                       double start_acceleration) {
   // Setup planning and routing result data callback.
@@ -118,12 +124,18 @@ void SimControl::SetStartPoint(const double x, const double y) {
 }
 
 void SimControl::ClearPlanning() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ResetPlanning();
+}
+
+void SimControl::ResetPlanning() {
   current_trajectory_.Clear();
   received_planning_ = false;
   planning_count_ = 0;
 }
 
 void SimControl::OnRoutingResponse(const RoutingResponse& routing) {
+  std::lock_guard<std::mutex> lock(mutex_);
   CHECK_LE(2, routing.routing_request().waypoint_size());
   const auto& start_pose = routing.routing_request().waypoint(0).pose();
 
@@ -133,20 +145,103 @@ void SimControl::OnRoutingResponse(const RoutingResponse& routing) {
   re_routing_triggered_ =
       routing.routing_request().header().module_name() == "planning";
   if (!re_routing_triggered_) {
-    ClearPlanning();
+    ResetPlanning();
     SetStartPoint(start_pose.x(), start_pose.y());
   }
 }
 
 void SimControl::Start() {
-  if (enabled_) {
+  if (!enabled_) {
+    return;
+  }
+  if (!FLAGS_sim_control_lockstep) {
     sim_control_timer_.start();
+    return;
+  }
+  if (lockstep_running_.exchange(true)) {
+    return;
+  }
+
+  // The simulated time starts from now, and is shared with the rest of
+  // Dreamview through the mock clock.
+  sim_time_ = Clock::NowInSeconds();
+  Clock::SetMode(Clock::MOCK);
+  Clock::SetNow(apollo::common::time::From(sim_time_).time_since_epoch());
+  if (ros::isInitialized()) {
+    clock_publisher_ =
+        ros::NodeHandle().advertise<rosgraph_msgs::Clock>("/clock", 1);
+  }
+  lockstep_thread_ = std::thread(&SimControl::RunLockstep, this);
+}
+
+void SimControl::Stop() {
+  sim_control_timer_.stop();
+  if (lockstep_running_.exchange(false)) {
+    planning_cvar_.notify_all();
+    lockstep_thread_.join();
+  }
+}
+
+void SimControl::RunLockstep() {
+  const double planning_period = FLAGS_sim_control_planning_period;
+  double next_planning_time = sim_time_ + planning_period;
+  const double sim_start_time = sim_time_;
+  const auto wall_start_time = std::chrono::steady_clock::now();
+  while (lockstep_running_) {
+    StepLockstep();
+
+    if (planning_period > 0.0 && sim_time_ >= next_planning_time - 1e-9) {
+      if (!WaitForPlanning(next_planning_time)) {
+        AWARN_EVERY(100) << "No planning for the cycle at "
+                         << next_planning_time << ", moving on.";
+      }
+      next_planning_time += planning_period;
+    }
+
+    if (FLAGS_sim_control_speed_ratio > 0.0) {
+      std::this_thread::sleep_until(
+          wall_start_time +
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>((sim_time_ - sim_start_time) /
+                                            FLAGS_sim_control_speed_ratio)));
+    }
   }
 }
 
-void SimControl::Stop() { sim_control_timer_.stop(); }
+void SimControl::StepLockstep() {
+  sim_time_ += kSimControlInterval;
+  Clock::SetNow(apollo::common::time::From(sim_time_).time_since_epoch());
+  // The messages of the step are published before the clock reaches it, so
+  // that a planning cycle started by the clock finds them.
+  RunOnce();
+  if (clock_publisher_) {
+    rosgraph_msgs::Clock clock;
+    clock.clock = ros::Time(sim_time_);
+    clock_publisher_.publish(clock);
+  }
+}
+
+bool SimControl::WaitForPlanning(double timestamp_sec) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  // Nothing to wait for until planning is up.
+  if (latest_planning_time_ <= 0.0) {
+    return true;
+  }
+  return planning_cvar_.wait_for(
+      lock,
+      std::chrono::duration<double>(FLAGS_sim_control_planning_timeout),
+      [this, timestamp_sec] {
+        return latest_planning_time_ >= timestamp_sec - 1e-6 ||
+               !lockstep_running_;
+      });
+}
 
 void SimControl::OnPlanning(const apollo::planning::ADCTrajectory& trajectory) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  latest_planning_time_ =
+      std::max(latest_planning_time_, trajectory.header().timestamp_sec());
+  planning_cvar_.notify_all();
+
   // Reset current trajectory and the indices upon receiving a new trajectory.
   // The routing SimControl owns must match with the one Planning has.
   if (re_routing_triggered_ ||
@@ -162,7 +257,7 @@ void SimControl::OnPlanning(const apollo::planning::ADCTrajectory& trajectory) {
       received_planning_ = true;
     }
   } else {
-    ClearPlanning();
+    ResetPlanning();
   }
 }
 
@@ -185,6 +280,7 @@ bool SimControl::NextPointWithinRange() {
 void SimControl::TimerCallback(const ros::TimerEvent& event) { RunOnce(); }
 
 void SimControl::RunOnce() {
+  std::lock_guard<std::mutex> lock(mutex_);
   // Result of the interpolation.
   double lambda = 0.0;
   auto current_time = Clock::NowInSeconds();
@@ -21,7 +21,11 @@
 #ifndef MODULES_DREAMVIEW_BACKEND_SIM_CONTROL_SIM_CONTROL_H_
 #define MODULES_DREAMVIEW_BACKEND_SIM_CONTROL_SIM_CONTROL_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "gtest/gtest_prod.h"
 #include "modules/common/adapters/adapter_manager.h"
@@ -40,6 +44,10 @@ namespace dreamview {
  * @brief A module that simulates a 'perfect control' algorithm, which assumes
  * an ideal world where the car can be perfectly placed wherever the planning
  * asks it to be, with the expected speed, acceleration, etc.
+ * With FLAGS_sim_control_lockstep, it runs on a simulated clock instead of a
+ * timer. Each step advances the clock by kSimControlInterval, and at every
+ * planning cycle it waits for the trajectory planned for the cycle, so the
+ * simulation runs as fast as planning does and does not depend on the load.
  */
 class SimControl {
  public:
@@ -49,6 +57,8 @@ class SimControl {
    */
   explicit SimControl(const MapService *map_service);
 
+  ~SimControl();
+
   /**
    * @brief setup callbacks and timer
    * @param set_start_point initialize localization.
@@ -57,13 +67,13 @@ class SimControl {
             double start_acceleration = 0.0);
 
   /**
-   * @brief Starts the timer to publish simulated localization and chassis
-   * messages.
+   * @brief Starts the timer, or the lockstep thread, to publish simulated
+   * localization and chassis messages.
    */
   void Start();
 
   /**
-   * @brief Stops the timer.
+   * @brief Stops the timer and the lockstep thread.
    */
   void Stop();
 
@@ -87,6 +97,17 @@ class SimControl {
 
   void Freeze();
 
+  // ClearPlanning() with mutex_ held.
+  void ResetPlanning();
+
+  // Runs the steps in lockstep with planning until stopped.
+  void RunLockstep();
+  // Advances the simulated clock by one step and publishes the messages.
+  void StepLockstep();
+  // Waits for a trajectory planned at or after the time, for at most
+  // FLAGS_sim_control_planning_timeout seconds.
+  bool WaitForPlanning(double timestamp_sec);
+
   double AbsoluteTimeOfNextPoint();
   bool NextPointWithinRange();
 
@@ -108,6 +129,20 @@ class SimControl {
   // Time interval of the timer, in seconds.
   static constexpr double kSimControlInterval = 0.01;
 
+  // The thread running the lockstep mode, which publishes the simulated time
+  // on /clock.
+  std::thread lockstep_thread_;
+  std::atomic<bool> lockstep_running_{false};
+  double sim_time_ = 0.0;
+  ros::Publisher clock_publisher_;
+
+  // Guards the states below, as the steps and the callbacks run on different
+  // threads in lockstep mode.
+  std::mutex mutex_;
+  std::condition_variable planning_cvar_;
+  // The header time of the latest planning trajectory.
+  double latest_planning_time_ = 0.0;
+
   // The latest received planning trajectory.
   apollo::planning::ADCTrajectory current_trajectory_;
   // The index of the previous and next point with regard to the
@@ -139,6 +174,7 @@ class SimControl {
   static constexpr int kPlanningCountToStart = 5;
 
   FRIEND_TEST(SimControlTest, Test);
+  FRIEND_TEST(SimControlTest, Lockstep);
 };
 
 }  // namespace dreamview
@@ -16,6 +16,8 @@
 
 #include "modules/dreamview/backend/sim_control/sim_control.h"
 
+#include <thread>
+
 #include "ros/include/ros/ros.h"
 
 #include "modules/common/adapters/proto/adapter_config.pb.h"
@@ -178,5 +180,42 @@ TEST_F(SimControlTest, Test) {
   }
 }
 
+TEST_F(SimControlTest, Lockstep) {
+  Clock::SetMode(Clock::MOCK);
+  Clock::SetNow(apollo::common::time::From(100.0).time_since_epoch());
+  sim_control_->SetStartPoint(1.0, 1.0);
+
+  // Each step moves the simulated clock on.
+  sim_control_->sim_time_ = 100.0;
+  sim_control_->StepLockstep();
+  sim_control_->StepLockstep();
+  EXPECT_NEAR(100.02, Clock::NowInSeconds(), 1e-6);
+  const LocalizationEstimate *localization =
+      AdapterManager::GetLocalization()->GetLatestPublished();
+  EXPECT_NEAR(100.02, localization->header().timestamp_sec(), 1e-6);
+  EXPECT_NEAR(1.0, localization->pose().position().x(), 1e-6);
+
+  // Nothing to wait for before the first planning.
+  sim_control_->lockstep_running_ = true;
+  EXPECT_TRUE(sim_control_->WaitForPlanning(100.1));
+
+  FLAGS_sim_control_planning_timeout = 0.01;
+  planning::ADCTrajectory adc_trajectory;
+  adc_trajectory.mutable_header()->set_timestamp_sec(100.0);
+  sim_control_->OnPlanning(adc_trajectory);
+  EXPECT_FALSE(sim_control_->WaitForPlanning(100.1));
+
+  FLAGS_sim_control_planning_timeout = 10.0;
+  std::thread planning([this]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    planning::ADCTrajectory adc_trajectory;
+    adc_trajectory.mutable_header()->set_timestamp_sec(100.1);
+    sim_control_->OnPlanning(adc_trajectory);
+  });
+  EXPECT_TRUE(sim_control_->WaitForPlanning(100.1));
+  planning.join();
+  sim_control_->lockstep_running_ = false;
+}
+
 }  // namespace dreamview
 }  // namespace apollo
@@ -0,0 +1,160 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/simulation_world/level_of_detail.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "modules/common/math/vec2d.h"
+#include "modules/common/util/points_downsampler.h"
+
+namespace apollo {
+namespace dreamview {
+
+using apollo::common::math::Vec2d;
+using apollo::common::util::DownsampleByDouglasPeucker;
+using google::protobuf::RepeatedPtrField;
+using Json = nlohmann::json;
+
+namespace {
+
+bool GetNumber(const Json &json_object, const char *key, double *value) {
+  auto iter = json_object.find(key);
+  if (iter == json_object.end() || !iter->is_number()) {
+    return false;
+  }
+  *value = *iter;
+  return true;
+}
+
+// Keeps the elements of the increasing indices only.
+template <typename T>
+void KeepElements(const std::vector<int> &indices,
+                  RepeatedPtrField<T> *elements) {
+  int size = 0;
+  for (const int index : indices) {
+    elements->SwapElements(size++, index);
+  }
+  elements->DeleteSubrange(size, elements->size() - size);
+}
+
+template <typename T>
+void SimplifyPoints(double tolerance, RepeatedPtrField<T> *points,
+                    int min_size = 2) {
+  const std::vector<int> indices =
+      DownsampleByDouglasPeucker(*points, tolerance);
+  if (static_cast<int>(indices.size()) >= min_size) {
+    KeepElements(indices, points);
+  }
+}
+
+void SimplifyTrajectory(double tolerance, RepeatedPtrField<Object> *points) {
+  std::vector<Vec2d> positions;
+  positions.reserve(points->size());
+  for (const auto &point : *points) {
+    positions.emplace_back(point.position_x(), point.position_y());
+  }
+  KeepElements(DownsampleByDouglasPeucker(positions, tolerance), points);
+}
+
+class Extent {
+ public:
+  void Add(double x, double y) {
+    min_x_ = std::min(min_x_, x);
+    min_y_ = std::min(min_y_, y);
+    max_x_ = std::max(max_x_, x);
+    max_y_ = std::max(max_y_, y);
+  }
+
+  bool Overlaps(const LevelOfDetail &lod) const {
+    return min_x_ <= lod.max_x && max_x_ >= lod.min_x && min_y_ <= lod.max_y &&
+           max_y_ >= lod.min_y;
+  }
+
+ private:
+  double min_x_ = std::numeric_limits<double>::max();
+  double min_y_ = std::numeric_limits<double>::max();
+  double max_x_ = std::numeric_limits<double>::lowest();
+  double max_y_ = std::numeric_limits<double>::lowest();
+};
+
+// Whether any part of the object, including its predicted trajectories, is
+// in the viewport.
+bool InViewport(const LevelOfDetail &lod, const Object &object) {
+  Extent extent;
+  extent.Add(object.position_x(), object.position_y());
+  for (const auto &point : object.polygon_point()) {
+    extent.Add(point.x(), point.y());
+  }
+  for (const auto &prediction : object.prediction()) {
+    for (const auto &point : prediction.predicted_trajectory()) {
+      extent.Add(point.x(), point.y());
+    }
+  }
+  return extent.Overlaps(lod);
+}
+
+}  // namespace
+
+bool LevelOfDetail::FromJson(const Json &json_object, LevelOfDetail *lod) {
+  *lod = LevelOfDetail();
+  auto viewport = json_object.find("viewport");
+  if (viewport != json_object.end() && viewport->is_object()) {
+    lod->has_viewport = GetNumber(*viewport, "minX", &lod->min_x) &&
+                        GetNumber(*viewport, "minY", &lod->min_y) &&
+                        GetNumber(*viewport, "maxX", &lod->max_x) &&
+                        GetNumber(*viewport, "maxY", &lod->max_y) &&
+                        lod->min_x <= lod->max_x && lod->min_y <= lod->max_y;
+  }
+  if (!GetNumber(json_object, "resolution", &lod->resolution) ||
+      lod->resolution < 0.0) {
+    lod->resolution = 0.0;
+  }
+  return lod->has_viewport || lod->resolution > 0.0;
+}
+
+void ApplyLevelOfDetail(const LevelOfDetail &lod, SimulationWorld *world) {
+  if (lod.has_viewport) {
+    std::vector<int> visible_objects;
+    for (int i = 0; i < world->object_size(); ++i) {
+      if (InViewport(lod, world->object(i))) {
+        visible_objects.push_back(i);
+      }
+    }
+    KeepElements(visible_objects, world->mutable_object());
+  }
+
+  if (lod.resolution <= 0.0) {
+    return;
+  }
+  const double tolerance = lod.resolution;
+  SimplifyTrajectory(tolerance, world->mutable_planning_trajectory());
+  for (auto &route_path : *world->mutable_route_path()) {
+    SimplifyPoints(tolerance, route_path.mutable_point());
+  }
+  for (auto &object : *world->mutable_object()) {
+    // A polygon of less than 3 points would not be drawn.
+    SimplifyPoints(tolerance, object.mutable_polygon_point(), 3);
+    for (auto &prediction : *object.mutable_prediction()) {
+      SimplifyPoints(tolerance, prediction.mutable_predicted_trajectory());
+    }
+  }
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_LEVEL_OF_DETAIL_H_
+#define MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_LEVEL_OF_DETAIL_H_
+
+#include "modules/dreamview/proto/simulation_world.pb.h"
+#include "third_party/json/json.hpp"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @struct LevelOfDetail
+ * @brief The part of the SimulationWorld a client displays, and how much
+ * detail it can display.
+ */
+struct LevelOfDetail {
+  // The area the client displays, in the coordinates of the SimulationWorld.
+  bool has_viewport = false;
+  double min_x = 0.0;
+  double min_y = 0.0;
+  double max_x = 0.0;
+  double max_y = 0.0;
+  // The length in meters a pixel of the client covers. The paths are
+  // simplified as long as they move by less than that.
+  double resolution = 0.0;
+
+  /**
+   * @brief Parses the level of detail of the json object, which looks like
+   * {"viewport": {"minX": -10, "minY": -10, "maxX": 10, "maxY": 10},
+   *  "resolution": 0.1}. Both fields are optional.
+   * @param json_object the json object
+   * @param lod the level of detail to be filled
+   * @return False if the json object has neither a valid viewport nor a
+   * positive resolution.
+   */
+  static bool FromJson(const nlohmann::json &json_object, LevelOfDetail *lod);
+};
+
+/**
+ * @brief Drops the obstacles out of the viewport, and simplifies the planning
+ * trajectory, the routing paths, the prediction trajectories and the polygons
+ * of the obstacles by the Douglas-Peucker algorithm with the resolution as
+ * tolerance. The main vehicle and the other single objects are kept as is.
+ * @param lod the level of detail
+ * @param world the SimulationWorld to be simplified
+ */
+void ApplyLevelOfDetail(const LevelOfDetail &lod, SimulationWorld *world);
+
+}  // namespace dreamview
+}  // namespace apollo
+
+#endif  // MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_LEVEL_OF_DETAIL_H_
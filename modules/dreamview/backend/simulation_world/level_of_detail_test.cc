@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/dreamview/backend/simulation_world/level_of_detail.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace dreamview {
+
+using Json = nlohmann::json;
+
+namespace {
+
+void AddPoint(double x, double y, PolygonPoint *point) {
+  point->set_x(x);
+  point->set_y(y);
+}
+
+}  // namespace
+
+TEST(LevelOfDetailTest, FromJson) {
+  LevelOfDetail lod;
+  EXPECT_FALSE(LevelOfDetail::FromJson(Json::object(), &lod));
+  EXPECT_FALSE(LevelOfDetail::FromJson(
+      Json::parse("{\"viewport\": {\"minX\": 1}, \"resolution\": -1}"), &lod));
+
+  ASSERT_TRUE(LevelOfDetail::FromJson(
+      Json::parse("{\"viewport\": {\"minX\": -1, \"minY\": -2, \"maxX\": 3, "
+                  "\"maxY\": 4}}"),
+      &lod));
+  EXPECT_TRUE(lod.has_viewport);
+  EXPECT_DOUBLE_EQ(-1.0, lod.min_x);
+  EXPECT_DOUBLE_EQ(-2.0, lod.min_y);
+  EXPECT_DOUBLE_EQ(3.0, lod.max_x);
+  EXPECT_DOUBLE_EQ(4.0, lod.max_y);
+  EXPECT_DOUBLE_EQ(0.0, lod.resolution);
+
+  ASSERT_TRUE(
+      LevelOfDetail::FromJson(Json::parse("{\"resolution\": 0.5}"), &lod));
+  EXPECT_FALSE(lod.has_viewport);
+  EXPECT_DOUBLE_EQ(0.5, lod.resolution);
+}
+
+TEST(LevelOfDetailTest, ApplyLevelOfDetail) {
+  SimulationWorld world;
+  // In the viewport.
+  Object *object = world.add_object();
+  object->set_id("inside");
+  object->set_position_x(5.0);
+  object->set_position_y(5.0);
+  AddPoint(4.0, 4.0, object->add_polygon_point());
+  AddPoint(6.0, 4.0, object->add_polygon_point());
+  AddPoint(6.0, 6.0, object->add_polygon_point());
+  AddPoint(4.0, 6.0, object->add_polygon_point());
+  // Only its prediction comes into the viewport.
+  object = world.add_object();
+  object->set_id("coming");
+  object->set_position_x(-20.0);
+  object->set_position_y(5.0);
+  Prediction *prediction = object->add_prediction();
+  for (int i = 0; i <= 10; ++i) {
+    AddPoint(-20.0 + 2.0 * i, 5.0 + 0.01 * (i % 2),
+             prediction->add_predicted_trajectory());
+  }
+  object = world.add_object();
+  object->set_id("outside");
+  object->set_position_x(50.0);
+  object->set_position_y(50.0);
+
+  // A straight trajectory, then a turn.
+  for (int i = 0; i <= 10; ++i) {
+    object = world.add_planning_trajectory();
+    object->set_position_x(i);
+    object->set_position_y(0.0);
+  }
+  object = world.add_planning_trajectory();
+  object->set_position_x(10.0);
+  object->set_position_y(5.0);
+  RoutePath *route_path = world.add_route_path();
+  for (int i = 0; i <= 10; ++i) {
+    AddPoint(0.0, i, route_path->add_point());
+  }
+
+  LevelOfDetail lod;
+  lod.has_viewport = true;
+  lod.min_x = 0.0;
+  lod.min_y = 0.0;
+  lod.max_x = 10.0;
+  lod.max_y = 10.0;
+  lod.resolution = 0.1;
+  ApplyLevelOfDetail(lod, &world);
+
+  ASSERT_EQ(2, world.object_size());
+  EXPECT_EQ("inside", world.object(0).id());
+  // The polygon is kept as it would have less than 3 points.
+  EXPECT_EQ(4, world.object(0).polygon_point_size());
+  EXPECT_EQ("coming", world.object(1).id());
+  ASSERT_EQ(1, world.object(1).prediction_size());
+  EXPECT_EQ(2, world.object(1).prediction(0).predicted_trajectory_size());
+
+  ASSERT_EQ(3, world.planning_trajectory_size());
+  EXPECT_DOUBLE_EQ(0.0, world.planning_trajectory(0).position_x());
+  EXPECT_DOUBLE_EQ(10.0, world.planning_trajectory(1).position_x());
+  EXPECT_DOUBLE_EQ(0.0, world.planning_trajectory(1).position_y());
+  EXPECT_DOUBLE_EQ(5.0, world.planning_trajectory(2).position_y());
+  ASSERT_EQ(1, world.route_path_size());
+  EXPECT_EQ(2, world.route_path(0).point_size());
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,231 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_encoder.h"
+
+#include <unordered_set>
+
+#include "google/protobuf/io/gzip_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace dreamview {
+
+using google::protobuf::RepeatedPtrField;
+using google::protobuf::io::ArrayInputStream;
+using google::protobuf::io::GzipInputStream;
+using google::protobuf::io::GzipOutputStream;
+using google::protobuf::io::StringOutputStream;
+
+namespace {
+
+std::string SerializeObjects(const RepeatedPtrField<Object> &objects) {
+  std::string serialized;
+  for (const auto &object : objects) {
+    object.AppendToString(&serialized);
+  }
+  return serialized;
+}
+
+std::string SerializeRoutePaths(const RepeatedPtrField<RoutePath> &paths) {
+  std::string serialized;
+  for (const auto &path : paths) {
+    path.AppendToString(&serialized);
+  }
+  return serialized;
+}
+
+}  // namespace
+
+SimulationWorldEncoder::SimulationWorldEncoder(const size_t max_num_bases)
+    : max_num_bases_(max_num_bases > 0 ? max_num_bases : 1) {}
+
+void SimulationWorldEncoder::AddUpdate(const SimulationWorldUpdate &update) {
+  Base base;
+  base.update.CopyFrom(update);
+  for (const auto &object : update.world().object()) {
+    base.objects[object.id()] = object.SerializeAsString();
+  }
+  base.route_path = SerializeRoutePaths(update.world().route_path());
+  base.planning_trajectory =
+      SerializeObjects(update.world().planning_trajectory());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // The sequence number starts over when the world is reset, and the older
+  // updates cannot be told apart from the new ones anymore.
+  if (!bases_.empty() && bases_.back().update.world().sequence_num() >=
+                             update.world().sequence_num()) {
+    bases_.clear();
+  }
+  bases_.push_back(std::move(base));
+  while (bases_.size() > max_num_bases_) {
+    bases_.pop_front();
+  }
+  encoded_.clear();
+}
+
+bool SimulationWorldEncoder::Encode(const int64_t base_sequence_num,
+                                    const bool compress, std::string *data) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (bases_.empty()) {
+    return false;
+  }
+  const Base &latest = bases_.back();
+  const int64_t latest_sequence_num = latest.update.world().sequence_num();
+  if (base_sequence_num == latest_sequence_num) {
+    return false;
+  }
+
+  const Base *base = nullptr;
+  for (const auto &kept : bases_) {
+    if (kept.update.world().sequence_num() == base_sequence_num) {
+      base = &kept;
+      break;
+    }
+  }
+  // A client whose base is not kept anymore gets the whole world.
+  const auto key = std::make_pair(base == nullptr ? -1 : base_sequence_num,
+                                  compress);
+  const auto iter = encoded_.find(key);
+  if (iter != encoded_.end()) {
+    *data = iter->second;
+    return true;
+  }
+
+  SimulationWorldUpdate delta;
+  if (base != nullptr) {
+    EncodeLocked(*base, &delta);
+  }
+  const SimulationWorldUpdate &update =
+      base == nullptr ? latest.update : delta;
+  std::string encoded;
+  if (compress) {
+    StringOutputStream raw_output(&encoded);
+    GzipOutputStream gzip_output(&raw_output);
+    if (!update.SerializeToZeroCopyStream(&gzip_output) ||
+        !gzip_output.Close()) {
+      AERROR << "Failed to compress the simulation world update.";
+      return false;
+    }
+  } else {
+    update.SerializeToString(&encoded);
+  }
+  encoded_[key] = encoded;
+  data->swap(encoded);
+  return true;
+}
+
+void SimulationWorldEncoder::EncodeLocked(
+    const Base &base, SimulationWorldUpdate *update) const {
+  const Base &latest = bases_.back();
+  const SimulationWorld &world = latest.update.world();
+
+  if (latest.update.has_timestamp()) {
+    update->set_timestamp(latest.update.timestamp());
+  }
+  update->set_base_sequence_num(base.update.world().sequence_num());
+  SimulationWorld *delta = update->mutable_world();
+  delta->CopyFrom(world);
+  delta->clear_object();
+  for (const auto &object : world.object()) {
+    const auto iter = base.objects.find(object.id());
+    if (iter == base.objects.end() ||
+        iter->second != latest.objects.at(object.id())) {
+      delta->add_object()->CopyFrom(object);
+    }
+  }
+  for (const auto &object : base.update.world().object()) {
+    if (latest.objects.count(object.id()) == 0) {
+      update->add_removed_object_id(object.id());
+    }
+  }
+  if (latest.route_path == base.route_path) {
+    delta->clear_route_path();
+    update->set_route_path_unchanged(true);
+  }
+  if (latest.planning_trajectory == base.planning_trajectory) {
+    delta->clear_planning_trajectory();
+    update->set_planning_trajectory_unchanged(true);
+  }
+
+  if (latest.update.has_map_hash()) {
+    update->set_map_hash(latest.update.map_hash());
+  }
+  if (latest.update.has_map_radius()) {
+    update->set_map_radius(latest.update.map_radius());
+  }
+  if (latest.update.has_map_element_ids() &&
+      (!latest.update.has_map_hash() ||
+       latest.update.map_hash() != base.update.map_hash())) {
+    update->set_map_element_ids(latest.update.map_element_ids());
+  }
+  if (latest.update.has_planning_data()) {
+    update->mutable_planning_data()->CopyFrom(latest.update.planning_data());
+  }
+}
+
+bool SimulationWorldEncoder::Decode(const std::string &data,
+                                    const bool compressed,
+                                    SimulationWorldUpdate *update) {
+  if (!compressed) {
+    return update->ParseFromString(data);
+  }
+  ArrayInputStream raw_input(data.data(), static_cast<int>(data.size()));
+  GzipInputStream gzip_input(&raw_input);
+  return update->ParseFromZeroCopyStream(&gzip_input);
+}
+
+void SimulationWorldEncoder::Apply(const SimulationWorldUpdate &update,
+                                   SimulationWorldUpdate *world_update) {
+  if (!update.has_base_sequence_num()) {
+    world_update->CopyFrom(update);
+    return;
+  }
+
+  SimulationWorldUpdate result = update;
+  SimulationWorld *world = result.mutable_world();
+  const SimulationWorld &base = world_update->world();
+  std::unordered_set<std::string> skipped(update.removed_object_id().begin(),
+                                          update.removed_object_id().end());
+  for (const auto &object : update.world().object()) {
+    skipped.insert(object.id());
+  }
+  for (const auto &object : base.object()) {
+    if (skipped.count(object.id()) == 0) {
+      world->add_object()->CopyFrom(object);
+    }
+  }
+  if (update.route_path_unchanged()) {
+    *world->mutable_route_path() = base.route_path();
+  }
+  if (update.planning_trajectory_unchanged()) {
+    *world->mutable_planning_trajectory() = base.planning_trajectory();
+  }
+  if (!update.has_map_element_ids()) {
+    result.set_map_element_ids(world_update->map_element_ids());
+  }
+  result.clear_base_sequence_num();
+  result.clear_removed_object_id();
+  result.clear_route_path_unchanged();
+  result.clear_planning_trajectory_unchanged();
+  world_update->Swap(&result);
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_SIM_WORLD_ENCODER_H_
+#define MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_SIM_WORLD_ENCODER_H_
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "modules/dreamview/proto/simulation_world.pb.h"
+
+/**
+ * @namespace apollo::dreamview
+ * @brief apollo::dreamview
+ */
+namespace apollo {
+namespace dreamview {
+
+/**
+ * @class SimulationWorldEncoder
+ * @brief Encodes the latest SimulationWorldUpdate for the binary frames
+ * pushed to the frontend, against the update that the client got last, so
+ * that the unchanged objects are not sent again. The last few updates are
+ * kept as bases. A client names its base in its request, so the frames
+ * that are skipped or lost do not break the decoding of the next ones.
+ * The encodings of the latest update are cached, as the clients usually
+ * share their bases.
+ */
+class SimulationWorldEncoder {
+ public:
+  /**
+   * @brief Constructor.
+   * @param max_num_bases The number of recent updates kept as bases.
+   */
+  explicit SimulationWorldEncoder(const size_t max_num_bases = 10);
+
+  /**
+   * @brief Makes the update the latest one. It holds the whole world.
+   * @param update The latest update.
+   */
+  void AddUpdate(const SimulationWorldUpdate &update);
+
+  /**
+   * @brief Encodes the latest update against the kept update of the given
+   * sequence number, or as a whole when no such update is kept.
+   * @param base_sequence_num The sequence number of the world the client
+   * has, negative if it has none.
+   * @param compress Whether to gzip compress the encoded update.
+   * @param data The serialized update.
+   * @return False if there is no new update for the client, i.e. no update
+   * at all or the client already has the latest one.
+   */
+  bool Encode(const int64_t base_sequence_num, const bool compress,
+              std::string *data);
+
+  /**
+   * @brief Parses an encoded update, as a client does.
+   * @param data The serialized update.
+   * @param compressed Whether it is gzip compressed.
+   * @param update The parsed update.
+   * @return False if the data cannot be parsed.
+   */
+  static bool Decode(const std::string &data, const bool compressed,
+                     SimulationWorldUpdate *update);
+
+  /**
+   * @brief Applies an update on its base, as a client does.
+   * @param update The update encoded against the base.
+   * @param world_update The base, replaced by the whole update.
+   */
+  static void Apply(const SimulationWorldUpdate &update,
+                    SimulationWorldUpdate *world_update);
+
+ private:
+  struct Base {
+    SimulationWorldUpdate update;
+    // Serialized objects by id, and serialized route paths and planning
+    // trajectory, to tell the changes of the next updates.
+    std::unordered_map<std::string, std::string> objects;
+    std::string route_path;
+    std::string planning_trajectory;
+  };
+
+  void EncodeLocked(const Base &base, SimulationWorldUpdate *update) const;
+
+  const size_t max_num_bases_;
+  // The kept updates, the latest at the back.
+  std::deque<Base> bases_;
+  // The encodings of the latest update keyed by base sequence number and
+  // compression.
+  std::map<std::pair<int64_t, bool>, std::string> encoded_;
+  std::mutex mutex_;
+};
+
+}  // namespace dreamview
+}  // namespace apollo
+
+#endif  // MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_SIM_WORLD_ENCODER_H_
@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/dreamview/backend/simulation_world/simulation_world_encoder.h"
+
+#include <algorithm>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/util/util.h"
+
+namespace apollo {
+namespace dreamview {
+
+namespace {
+
+void AddObject(const std::string &id, const double x, SimulationWorld *world) {
+  Object *object = world->add_object();
+  object->set_id(id);
+  object->set_position_x(x);
+}
+
+// Sorts the objects by id, as their order does not matter.
+void SortObjects(SimulationWorldUpdate *update) {
+  auto *objects = update->mutable_world()->mutable_object();
+  std::sort(objects->begin(), objects->end(),
+            [](const Object &a, const Object &b) { return a.id() < b.id(); });
+}
+
+}  // namespace
+
+class SimulationWorldEncoderTest : public ::testing::Test {
+ public:
+  virtual void SetUp() {
+    SimulationWorld *world = first_.mutable_world();
+    world->set_sequence_num(1);
+    AddObject("a", 1.0, world);
+    AddObject("b", 2.0, world);
+    AddObject("c", 3.0, world);
+    world->add_route_path()->add_point()->set_x(10.0);
+    world->add_planning_trajectory()->set_position_x(20.0);
+    first_.set_map_hash(7);
+    first_.set_map_element_ids("{\"lane\":[\"l1\"]}");
+
+    second_ = first_;
+    world = second_.mutable_world();
+    world->set_sequence_num(2);
+    world->clear_object();
+    AddObject("d", 4.0, world);
+    AddObject("a", 1.0, world);
+    AddObject("b", 2.5, world);
+    world->mutable_planning_trajectory(0)->set_position_x(21.0);
+  }
+
+ protected:
+  SimulationWorldUpdate first_;
+  SimulationWorldUpdate second_;
+};
+
+TEST_F(SimulationWorldEncoderTest, EncodeAgainstBase) {
+  SimulationWorldEncoder encoder;
+  std::string data;
+  EXPECT_FALSE(encoder.Encode(-1, false, &data));
+
+  encoder.AddUpdate(first_);
+  ASSERT_TRUE(encoder.Encode(-1, false, &data));
+  SimulationWorldUpdate client;
+  ASSERT_TRUE(SimulationWorldEncoder::Decode(data, false, &client));
+  EXPECT_TRUE(common::util::IsProtoEqual(first_, client));
+  EXPECT_FALSE(encoder.Encode(1, false, &data));
+
+  encoder.AddUpdate(second_);
+  ASSERT_TRUE(encoder.Encode(1, false, &data));
+  SimulationWorldUpdate update;
+  ASSERT_TRUE(SimulationWorldEncoder::Decode(data, false, &update));
+  EXPECT_EQ(1, update.base_sequence_num());
+  SortObjects(&update);
+  ASSERT_EQ(2, update.world().object_size());
+  EXPECT_EQ("b", update.world().object(0).id());
+  EXPECT_EQ("d", update.world().object(1).id());
+  ASSERT_EQ(1, update.removed_object_id_size());
+  EXPECT_EQ("c", update.removed_object_id(0));
+  EXPECT_TRUE(update.route_path_unchanged());
+  EXPECT_EQ(0, update.world().route_path_size());
+  EXPECT_FALSE(update.planning_trajectory_unchanged());
+  EXPECT_EQ(1, update.world().planning_trajectory_size());
+  EXPECT_FALSE(update.has_map_element_ids());
+  EXPECT_EQ(7, update.map_hash());
+
+  SimulationWorldEncoder::Apply(update, &client);
+  SortObjects(&client);
+  SimulationWorldUpdate expected = second_;
+  SortObjects(&expected);
+  EXPECT_TRUE(common::util::IsProtoEqual(expected, client))
+      << client.DebugString();
+
+  // the compressed update is the same once decoded
+  std::string compressed;
+  ASSERT_TRUE(encoder.Encode(1, true, &compressed));
+  EXPECT_NE(data, compressed);
+  SimulationWorldUpdate decompressed;
+  ASSERT_TRUE(SimulationWorldEncoder::Decode(compressed, true, &decompressed));
+  SortObjects(&decompressed);
+  EXPECT_TRUE(common::util::IsProtoEqual(update, decompressed));
+
+  // a client with an unknown base gets the whole world
+  ASSERT_TRUE(encoder.Encode(5, false, &data));
+  ASSERT_TRUE(SimulationWorldEncoder::Decode(data, false, &update));
+  EXPECT_TRUE(common::util::IsProtoEqual(second_, update));
+}
+
+TEST_F(SimulationWorldEncoderTest, KeptBases) {
+  SimulationWorldEncoder encoder(2);
+  encoder.AddUpdate(first_);
+  encoder.AddUpdate(second_);
+  SimulationWorldUpdate third = second_;
+  third.mutable_world()->set_sequence_num(3);
+  encoder.AddUpdate(third);
+
+  // only the last two updates are kept
+  std::string data;
+  SimulationWorldUpdate update;
+  ASSERT_TRUE(encoder.Encode(1, false, &data));
+  ASSERT_TRUE(SimulationWorldEncoder::Decode(data, false, &update));
+  EXPECT_FALSE(update.has_base_sequence_num());
+  ASSERT_TRUE(encoder.Encode(2, false, &data));
+  ASSERT_TRUE(SimulationWorldEncoder::Decode(data, false, &update));
+  EXPECT_EQ(2, update.base_sequence_num());
+  EXPECT_EQ(0, update.world().object_size());
+
+  // the sequence number starts over when the world is reset
+  encoder.AddUpdate(first_);
+  ASSERT_TRUE(encoder.Encode(2, false, &data));
+  ASSERT_TRUE(SimulationWorldEncoder::Decode(data, false, &update));
+  EXPECT_FALSE(update.has_base_sequence_num());
+  EXPECT_TRUE(common::util::IsProtoEqual(first_, update));
+}
+
+}  // namespace dreamview
+}  // namespace apollo
@@ -21,13 +21,13 @@
 #include <unordered_set>
 #include <vector>
 
-#include "google/protobuf/util/json_util.h"
 #include "modules/canbus/proto/chassis.pb.h"
 #include "modules/common/math/quaternion.h"
 #include "modules/common/proto/geometry.pb.h"
 #include "modules/common/proto/vehicle_signal.pb.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/file.h"
+#include "modules/common/util/json_writer.h"
 #include "modules/common/util/map_util.h"
 #include "modules/common/util/points_downsampler.h"
 #include "modules/common/util/util.h"
@@ -60,6 +60,7 @@ using apollo::common::time::ToSecond;
 using apollo::common::time::millis;
 using apollo::common::util::DownsampleByAngle;
 using apollo::common::util::GetProtoFromFile;
+using apollo::common::util::JsonWriter;
 using apollo::hdmap::Path;
 using apollo::localization::LocalizationEstimate;
 using apollo::perception::PerceptionObstacle;
@@ -74,7 +75,6 @@ using apollo::prediction::PredictionObstacles;
 using apollo::routing::RoutingResponse;
 
 using Json = nlohmann::json;
-using ::google::protobuf::util::MessageToJsonString;
 
 namespace {
 
@@ -213,7 +213,9 @@ SimulationWorldService::SimulationWorldService(const MapService *map_service,
   auto_driving_car->set_length(vehicle_param.length());
 }
 
-void SimulationWorldService::Update() {
+void SimulationWorldService::Update(const bool with_planning_data) {
+  with_planning_data_ = with_planning_data;
+  bool cleared = false;
   if (to_clear_) {
     // Clears received data.
     AdapterManager::GetChassis()->ClearData();
@@ -228,28 +230,50 @@ void SimulationWorldService::Update() {
     auto car = world_.auto_driving_car();
     world_.Clear();
     *world_.mutable_auto_driving_car() = car;
+    last_observed_.clear();
     to_clear_ = false;
+    cleared = true;
   }
 
   AdapterManager::Observe();
-  UpdateWithLatestObserved("Chassis", AdapterManager::GetChassis());
-  UpdateWithLatestObserved("Localization", AdapterManager::GetLocalization());
-
-  // Clear objects received from last frame and populate with the new objects.
-  // TODO(siyangy, unacao): For now we are assembling the simulation_world with
-  // latest received perception, prediction and planning message. However, they
-  // may not always be perfectly aligned and belong to the same frame.
-  obj_map_.clear();
-  world_.clear_object();
-  UpdateWithLatestObserved("PerceptionObstacles",
-                           AdapterManager::GetPerceptionObstacles());
-  UpdateWithLatestObserved("PerceptionTrafficLight",
-                           AdapterManager::GetTrafficLightDetection());
-  UpdateWithLatestObserved("PredictionObstacles",
-                           AdapterManager::GetPrediction());
-  UpdateWithLatestObserved("Planning", AdapterManager::GetPlanning());
-  for (const auto &kv : obj_map_) {
-    *world_.add_object() = kv.second;
+  if (HasNewObserved("Chassis", AdapterManager::GetChassis())) {
+    UpdateWithLatestObserved("Chassis", AdapterManager::GetChassis());
+  }
+  if (HasNewObserved("Localization", AdapterManager::GetLocalization())) {
+    UpdateWithLatestObserved("Localization",
+                             AdapterManager::GetLocalization());
+  }
+
+  // The objects are assembled from the perception, prediction and planning
+  // messages together, so they are rebuilt only when one of them is new, and
+  // then from all of them.
+  bool new_objects = cleared;
+  new_objects |= HasNewObserved("PerceptionObstacles",
+                                AdapterManager::GetPerceptionObstacles());
+  new_objects |= HasNewObserved("PerceptionTrafficLight",
+                                AdapterManager::GetTrafficLightDetection());
+  new_objects |= HasNewObserved("PredictionObstacles",
+                                AdapterManager::GetPrediction());
+  new_objects |= HasNewObserved("Planning", AdapterManager::GetPlanning());
+  if (new_objects) {
+    // Clear objects received from last frame and populate with the new
+    // objects.
+    // TODO(siyangy, unacao): For now we are assembling the simulation_world
+    // with latest received perception, prediction and planning message.
+    // However, they may not always be perfectly aligned and belong to the
+    // same frame.
+    obj_map_.clear();
+    world_.clear_object();
+    UpdateWithLatestObserved("PerceptionObstacles",
+                             AdapterManager::GetPerceptionObstacles());
+    UpdateWithLatestObserved("PerceptionTrafficLight",
+                             AdapterManager::GetTrafficLightDetection());
+    UpdateWithLatestObserved("PredictionObstacles",
+                             AdapterManager::GetPrediction());
+    UpdateWithLatestObserved("Planning", AdapterManager::GetPlanning());
+    for (const auto &kv : obj_map_) {
+      *world_.add_object() = kv.second;
+    }
   }
 
   UpdateDelays();
@@ -271,26 +295,50 @@ void SimulationWorldService::UpdateDelays() {
       SecToMs(AdapterManager::GetTrafficLightDetection()->GetDelaySec()));
 }
 
-Json SimulationWorldService::GetUpdateAsJson(double radius) const {
-  std::string sim_world_json_string;
-  MessageToJsonString(world_, &sim_world_json_string);
-
-  Json update = GetMapElements(radius);
-  update["type"] = "SimWorldUpdate";
-  update["timestamp"] = apollo::common::time::AsInt64<millis>(Clock::Now());
-  update["world"] = sim_world_json_string;
-
-  return update;
-}
-
-Json SimulationWorldService::GetPlanningData() const {
-  std::string planning_data_json;
-  MessageToJsonString(planning_data_, &planning_data_json);
-
-  return Json::parse(planning_data_json);
-}
-
-Json SimulationWorldService::GetMapElements(double radius) const {
+void SimulationWorldService::GetUpdateAsJson(
+    const std::string &world_json, const MapElementIds &map_element_ids,
+    const double radius, const int64_t timestamp_ms,
+    const PlanningData *planning_data, std::string *json) {
+  json->clear();
+  JsonWriter writer(json);
+  writer.BeginObject();
+  writer.Key("type");
+  writer.String("SimWorldUpdate");
+  writer.Key("timestamp");
+  writer.Int(timestamp_ms);
+  writer.Key("world");
+  writer.String(world_json);
+  writer.Key("mapElementIds");
+  map_element_ids.WriteJson(&writer);
+  writer.Key("mapHash");
+  writer.Uint(map_element_ids.Hash());
+  writer.Key("mapRadius");
+  writer.Double(radius);
+  if (planning_data != nullptr) {
+    writer.Key("planningData");
+    writer.Message(*planning_data);
+  }
+  writer.EndObject();
+}
+
+void SimulationWorldService::GetUpdate(double radius, bool with_planning_data,
+                                       SimulationWorldUpdate *update) const {
+  update->Clear();
+  update->set_timestamp(apollo::common::time::AsInt64<millis>(Clock::Now()));
+  *update->mutable_world() = world_;
+
+  const MapElementIds map_element_ids = GetMapElementIds(radius);
+  JsonWriter writer(update->mutable_map_element_ids());
+  map_element_ids.WriteJson(&writer);
+  update->set_map_hash(map_element_ids.Hash());
+  update->set_map_radius(radius);
+
+  if (with_planning_data) {
+    *update->mutable_planning_data() = planning_data_;
+  }
+}
+
+MapElementIds SimulationWorldService::GetMapElementIds(double radius) const {
   // Gather required map element ids based on current location.
   apollo::common::PointENU point;
   point.set_x(
@@ -298,8 +346,11 @@ Json SimulationWorldService::GetMapElements(double radius) const {
   point.set_y(
       world_.auto_driving_car().position_y() + map_service_->GetYOffset());
 
-  MapElementIds map_element_ids =
-      map_service_->CollectMapElementIds(point, radius);
+  return map_service_->CollectMapElementIds(point, radius);
+}
+
+Json SimulationWorldService::GetMapElements(double radius) const {
+  const MapElementIds map_element_ids = GetMapElementIds(radius);
 
   Json map;
   map["mapElementIds"] = map_element_ids.Json();
@@ -769,7 +820,11 @@ void SimulationWorldService::UpdateSimulationWorld(
 
   UpdateDecision(trajectory.decision(), header_time);
 
-  UpdatePlanningData(trajectory.debug().planning_data());
+  if (with_planning_data_) {
+    UpdatePlanningData(trajectory.debug().planning_data());
+  } else {
+    planning_data_.Clear();
+  }
 
   world_.mutable_latency()->set_planning(
       trajectory.latency_stats().total_time_ms());
@@ -21,7 +21,9 @@
 #ifndef MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_SIM_WORLD_H_
 #define MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_SIM_WORLD_H_
 
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -75,17 +77,46 @@ class SimulationWorldService {
   }
 
   /**
-   * @brief Returns the json representation of the SimulationWorld object.
+   * @brief Writes the json of an update pushed to the frontend, with the
+   * fields of GetMapElements, and the json of the SimulationWorld object as
+   * a string. The json is written without building a json object first,
+   * into a string whose memory is reused.
+   * @param world_json the json of the SimulationWorld object
+   * @param map_element_ids the ids of the map elements around the car
+   * @param radius the search distance from the car of the map elements
+   * @param timestamp_ms the timestamp of the update
+   * @param planning_data the planning debug data to add, or nullptr
+   * @param json the string the json replaces the contents of
+   */
+  static void GetUpdateAsJson(
+      const std::string &world_json, const MapElementIds &map_element_ids,
+      double radius, int64_t timestamp_ms,
+      const apollo::planning_internal::PlanningData *planning_data,
+      std::string *json);
+
+  /**
+   * @brief Fills the update pushed in binary frames with the whole
+   * SimulationWorld object.
    * @param radius the search distance from the current car location
-   * @return Json object equivalence of the SimulationWorld object.
+   * @param with_planning_data whether to add the planning debug data
+   * @param update the update to be filled
    */
-  nlohmann::json GetUpdateAsJson(double radius) const;
+  void GetUpdate(double radius, bool with_planning_data,
+                 SimulationWorldUpdate *update) const;
 
   /**
-   * @brief Returns the json representation of the planning debug data.
-   * @return Json object equivalence of the PlanningData object.
+   * @brief Get a read-only view of the planning debug data.
    */
-  nlohmann::json GetPlanningData() const;
+  const apollo::planning_internal::PlanningData &planning_data() const {
+    return planning_data_;
+  }
+
+  /**
+   * @brief Returns the ids of the map elements within the given radius from
+   * the car.
+   * @param radius the search distance from the current car location
+   */
+  MapElementIds GetMapElementIds(double radius) const;
 
   /**
    * @brief Returns the json representation of the map element Ids and hash
@@ -98,9 +129,12 @@ class SimulationWorldService {
   /**
    * @brief The function Update() is periodically called to check for updates
    * from the adapters. All the updates will be written to the SimulationWorld
-   * object to reflect the latest status.
+   * object to reflect the latest status. Only the adapters which received
+   * new messages since the last update are processed.
+   * @param with_planning_data whether to update the planning debug data,
+   * which only the PnC monitor displays
    */
-  void Update();
+  void Update(bool with_planning_data = true);
 
   /**
    * @brief Sets the flag to clear the owned simulation world object.
@@ -179,6 +213,24 @@ class SimulationWorldService {
     UpdateSimulationWorld(adapter->GetLatestObserved());
   }
 
+  /**
+   * @brief Checks whether the latest observed message of an adapter is not
+   * the one of the last update, and remembers it.
+   */
+  template <typename AdapterType>
+  bool HasNewObserved(const std::string &adapter_name, AdapterType *adapter) {
+    if (adapter->Empty()) {
+      return false;
+    }
+    std::shared_ptr<const void> latest = adapter->GetLatestObservedPtr();
+    std::shared_ptr<const void> &last = last_observed_[adapter_name];
+    if (latest == last) {
+      return false;
+    }
+    last = std::move(latest);
+    return true;
+  }
+
   void RegisterMessageCallbacks();
 
   void ReadRoutingFromFile(const std::string &routing_response_file);
@@ -211,6 +263,12 @@ class SimulationWorldService {
   // frontend request.
   bool to_clear_ = false;
 
+  // Whether the planning debug data is updated.
+  bool with_planning_data_ = true;
+
+  // The latest message processed of each adapter, kept to tell the new ones.
+  std::unordered_map<std::string, std::shared_ptr<const void>> last_observed_;
+
   FRIEND_TEST(SimulationWorldServiceTest, UpdateMonitorSuccess);
   FRIEND_TEST(SimulationWorldServiceTest, UpdateMonitorRemove);
   FRIEND_TEST(SimulationWorldServiceTest, UpdateMonitorTruncate);
@@ -221,6 +279,7 @@ class SimulationWorldService {
   FRIEND_TEST(SimulationWorldServiceTest, UpdateDecision);
   FRIEND_TEST(SimulationWorldServiceTest, UpdatePrediction);
   FRIEND_TEST(SimulationWorldServiceTest, UpdateRouting);
+  FRIEND_TEST(SimulationWorldServiceTest, UpdateOnlyNewMessages);
 };
 
 }  // namespace dreamview
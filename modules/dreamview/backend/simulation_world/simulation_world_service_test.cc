@@ -481,5 +481,54 @@ TEST_F(SimulationWorldServiceTest, UpdateRouting) {
   }
 }
 
+TEST_F(SimulationWorldServiceTest, UpdateOnlyNewMessages) {
+  AdapterManagerConfig config;
+  config.set_is_ros(false);
+  for (const auto type :
+       {AdapterConfig::CHASSIS, AdapterConfig::LOCALIZATION,
+        AdapterConfig::PERCEPTION_OBSTACLES,
+        AdapterConfig::TRAFFIC_LIGHT_DETECTION, AdapterConfig::PREDICTION,
+        AdapterConfig::PLANNING_TRAJECTORY, AdapterConfig::MONITOR,
+        AdapterConfig::ROUTING_RESPONSE}) {
+    auto* sub_config = config.add_config();
+    sub_config->set_mode(AdapterConfig::RECEIVE_ONLY);
+    sub_config->set_type(type);
+  }
+  AdapterManager::Reset();
+  AdapterManager::Init(config);
+  sim_world_service_.reset(new SimulationWorldService(map_service_.get()));
+  auto& world = sim_world_service_->world_;
+
+  Chassis chassis;
+  chassis.set_speed_mps(25);
+  AdapterManager::GetChassis()->OnReceive(chassis);
+  PerceptionObstacles obstacles;
+  auto* obstacle = obstacles.add_perception_obstacle();
+  obstacle->set_id(1);
+  obstacle->set_type(PerceptionObstacle::VEHICLE);
+  AdapterManager::GetPerceptionObstacles()->OnReceive(obstacles);
+  sim_world_service_->Update();
+  EXPECT_DOUBLE_EQ(25.0, world.auto_driving_car().speed());
+  EXPECT_EQ(1, world.object_size());
+
+  // The messages already processed are not processed again.
+  world.mutable_auto_driving_car()->set_speed(10.0);
+  world.clear_object();
+  sim_world_service_->Update();
+  EXPECT_DOUBLE_EQ(10.0, world.auto_driving_car().speed());
+  EXPECT_EQ(0, world.object_size());
+
+  // A new message of an object adapter rebuilds the objects.
+  AdapterManager::GetPrediction()->OnReceive(PredictionObstacles());
+  sim_world_service_->Update();
+  EXPECT_DOUBLE_EQ(10.0, world.auto_driving_car().speed());
+  EXPECT_EQ(1, world.object_size());
+
+  // A new message is processed even if equal to the last one.
+  AdapterManager::GetChassis()->OnReceive(chassis);
+  sim_world_service_->Update();
+  EXPECT_DOUBLE_EQ(25.0, world.auto_driving_car().speed());
+}
+
 }  // namespace dreamview
 }  // namespace apollo
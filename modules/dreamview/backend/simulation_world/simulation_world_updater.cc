@@ -16,7 +16,8 @@
 
 #include "modules/dreamview/backend/simulation_world/simulation_world_updater.h"
 
-#include "modules/common/util/json_util.h"
+#include "modules/common/time/time.h"
+#include "modules/common/util/json_writer.h"
 #include "modules/common/util/map_util.h"
 #include "modules/dreamview/backend/common/dreamview_gflags.h"
 #include "modules/map/hdmap/hdmap_util.h"
@@ -26,9 +27,12 @@ namespace dreamview {
 
 using apollo::common::adapter::AdapterManager;
 using apollo::common::monitor::MonitorMessageItem;
+using apollo::common::time::AsInt64;
+using apollo::common::time::Clock;
+using apollo::common::time::millis;
 using apollo::common::util::ContainsKey;
 using apollo::common::util::GetProtoFromASCIIFile;
-using apollo::common::util::JsonUtil;
+using apollo::common::util::JsonWriter;
 using apollo::hdmap::EndWayPointFile;
 using apollo::routing::RoutingRequest;
 using Json = nlohmann::json;
@@ -41,6 +45,11 @@ SimulationWorldUpdater::SimulationWorldUpdater(WebSocketHandler *websocket,
       map_service_(map_service),
       websocket_(websocket),
       sim_control_(sim_control) {
+  websocket_->RegisterConnectionCloseHandler(
+      [this](WebSocketHandler::Connection *conn) {
+        std::unique_lock<std::mutex> lock(subscription_mutex_);
+        subscriptions_.erase(conn);
+      });
 
   websocket_->RegisterMessageHandler(
       "RetrieveMapData",
@@ -49,8 +58,15 @@ SimulationWorldUpdater::SimulationWorldUpdater(WebSocketHandler *websocket,
         if (iter != json.end()) {
           MapElementIds map_element_ids(*iter);
           auto retrieved = map_service_->RetrieveMapElements(map_element_ids);
-          websocket_->SendData(
-              conn, JsonUtil::ProtoToTypedJson("MapData", retrieved).dump());
+          std::string response;
+          JsonWriter writer(&response, true);
+          writer.BeginObject();
+          writer.Key("type");
+          writer.String("MapData");
+          writer.Key("data");
+          writer.Message(retrieved);
+          writer.EndObject();
+          websocket_->SendData(conn, response);
         }
       });
 
@@ -99,25 +115,95 @@ SimulationWorldUpdater::SimulationWorldUpdater(WebSocketHandler *websocket,
   websocket_->RegisterMessageHandler(
       "RequestSimulationWorld",
       [this](const Json &json, WebSocketHandler::Connection *conn) {
+        // The subscription is recorded even if the data is not ready, for
+        // the timer to update it.
+        Subscription subscription = GetSubscription(conn);
+        auto planning = json.find("planning");
+        if (planning != json.end() && planning->is_boolean()) {
+          subscription.planning_data = *planning;
+        }
+        auto binary = json.find("binary");
+        subscription.binary =
+            binary != json.end() && binary->is_boolean() && *binary;
+        LevelOfDetail lod;
+        auto lod_json = json.find("levelOfDetail");
+        subscription.level_of_detail =
+            !subscription.binary && !subscription.planning_data &&
+            lod_json != json.end() && LevelOfDetail::FromJson(*lod_json, &lod);
+        subscription.json = !subscription.binary;
+        {
+          std::unique_lock<std::mutex> lock(subscription_mutex_);
+          subscriptions_[conn] = subscription;
+        }
+
         if (!sim_world_service_.ReadyToPush()) {
           AWARN_EVERY(100)
               << "Not sending simulation world as the data is not ready!";
           return;
         }
 
-        auto planning = json.find("planning");
-        if (planning != json.end() && planning->is_boolean()) {
-          enable_pnc_monitor_ = json["planning"];
+        // The binary update is encoded against the world the client has.
+        if (subscription.binary) {
+          int64_t base_sequence_num = -1;
+          auto base = json.find("baseSequenceNum");
+          if (base != json.end() && base->is_number_integer()) {
+            base_sequence_num = *base;
+          }
+          auto compress = json.find("compress");
+          const bool to_compress = compress != json.end() &&
+                                   compress->is_boolean() && *compress;
+          std::string to_send;
+          if (sim_world_encoder_.Encode(base_sequence_num, to_compress,
+                                        &to_send)) {
+            websocket_->SendBinaryData(conn, to_send, true);
+          }
+          return;
+        }
+
+        // The planning data is for debugging, it is sent with all the details.
+        if (subscription.level_of_detail) {
+          std::shared_ptr<const SimulationWorld> world_snapshot;
+          MapElementIds map_element_ids;
+          int64_t timestamp_ms = 0;
+          {
+            boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
+            world_snapshot = world_snapshot_;
+            if (world_snapshot != nullptr) {
+              map_element_ids = snapshot_map_element_ids_;
+              timestamp_ms = snapshot_timestamp_ms_;
+            }
+          }
+          // Until the timer has kept the first snapshot, the whole world is
+          // sent.
+          if (world_snapshot != nullptr) {
+            SimulationWorld world = *world_snapshot;
+            ApplyLevelOfDetail(lod, &world);
+            std::string world_json;
+            JsonWriter::MessageToJson(world, &world_json);
+            std::string to_send;
+            SimulationWorldService::GetUpdateAsJson(
+                world_json, map_element_ids, FLAGS_sim_map_radius,
+                timestamp_ms, nullptr, &to_send);
+            if (FLAGS_enable_update_size_check &&
+                to_send.size() > FLAGS_max_update_size) {
+              AWARN << "update size is too big:" << to_send.size();
+              return;
+            }
+            websocket_->SendData(conn, to_send, true);
+            return;
+          }
         }
+
         std::string to_send;
         {
           // Pay the price to copy the data instead of sending data over the
           // wire while holding the lock.
           boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
-          to_send = enable_pnc_monitor_ ? simulation_world_with_planning_json_
-                                        : simulation_world_json_;
+          to_send = subscription.planning_data
+                        ? simulation_world_with_planning_json_
+                        : simulation_world_json_;
         }
-        if (FLAGS_enable_update_size_check && !enable_pnc_monitor_ &&
+        if (FLAGS_enable_update_size_check && !subscription.planning_data &&
             to_send.size() > FLAGS_max_update_size) {
           AWARN << "update size is too big:" << to_send.size();
           return;
@@ -254,19 +340,65 @@ void SimulationWorldUpdater::Start() {
 }
 
 void SimulationWorldUpdater::OnTimer(const ros::TimerEvent &event) {
-  sim_world_service_.Update();
+  Subscription subscription;
+  if (!GetSubscriptions(&subscription)) {
+    return;
+  }
+  sim_world_service_.Update(subscription.planning_data);
+
+  if (subscription.json) {
+    // The jsons are written out of the lock, the world once for both.
+    const MapElementIds map_element_ids =
+        sim_world_service_.GetMapElementIds(FLAGS_sim_map_radius);
+    const int64_t timestamp_ms = AsInt64<millis>(Clock::Now());
+    JsonWriter::MessageToJson(sim_world_service_.world(), &world_json_);
+    SimulationWorldService::GetUpdateAsJson(
+        world_json_, map_element_ids, FLAGS_sim_map_radius, timestamp_ms,
+        nullptr, &next_simulation_world_json_);
+    if (subscription.planning_data) {
+      SimulationWorldService::GetUpdateAsJson(
+          world_json_, map_element_ids, FLAGS_sim_map_radius, timestamp_ms,
+          &sim_world_service_.planning_data(),
+          &next_simulation_world_with_planning_json_);
+    }
 
-  {
     boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
-    Json simulation_world =
-        sim_world_service_.GetUpdateAsJson(FLAGS_sim_map_radius);
-    simulation_world_json_ = simulation_world.dump();
-
-    if (enable_pnc_monitor_) {
-      simulation_world["planningData"] = sim_world_service_.GetPlanningData();
-      simulation_world_with_planning_json_ = simulation_world.dump();
+    simulation_world_json_.swap(next_simulation_world_json_);
+    if (subscription.planning_data) {
+      simulation_world_with_planning_json_.swap(
+          next_simulation_world_with_planning_json_);
+    }
+    if (subscription.level_of_detail) {
+      world_snapshot_.reset(new SimulationWorld(sim_world_service_.world()));
+      snapshot_map_element_ids_ = map_element_ids;
+      snapshot_timestamp_ms_ = timestamp_ms;
     }
   }
+
+  if (subscription.binary) {
+    SimulationWorldUpdate update;
+    sim_world_service_.GetUpdate(FLAGS_sim_map_radius,
+                                 subscription.planning_data, &update);
+    sim_world_encoder_.AddUpdate(update);
+  }
+}
+
+SimulationWorldUpdater::Subscription SimulationWorldUpdater::GetSubscription(
+    WebSocketHandler::Connection *conn) {
+  std::unique_lock<std::mutex> lock(subscription_mutex_);
+  auto iter = subscriptions_.find(conn);
+  return iter == subscriptions_.end() ? Subscription() : iter->second;
+}
+
+bool SimulationWorldUpdater::GetSubscriptions(Subscription *subscription) {
+  std::unique_lock<std::mutex> lock(subscription_mutex_);
+  for (const auto &kv : subscriptions_) {
+    subscription->json |= kv.second.json;
+    subscription->planning_data |= kv.second.planning_data;
+    subscription->level_of_detail |= kv.second.level_of_detail;
+    subscription->binary |= kv.second.binary;
+  }
+  return !subscriptions_.empty();
 }
 
 bool SimulationWorldUpdater::LoadPOI() {
@@ -21,7 +21,11 @@
 #ifndef MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_SIM_WORLD_UPDATER_H_
 #define MODULES_DREAMVIEW_BACKEND_SIMULATION_WORLD_SIM_WORLD_UPDATER_H_
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 #include "boost/thread/locks.hpp"
 #include "boost/thread/shared_mutex.hpp"
@@ -31,6 +35,8 @@
 #include "modules/dreamview/backend/handlers/websocket.h"
 #include "modules/dreamview/backend/map/map_service.h"
 #include "modules/dreamview/backend/sim_control/sim_control.h"
+#include "modules/dreamview/backend/simulation_world/level_of_detail.h"
+#include "modules/dreamview/backend/simulation_world/simulation_world_encoder.h"
 #include "modules/dreamview/backend/simulation_world/simulation_world_service.h"
 #include "modules/routing/proto/poi.pb.h"
 
@@ -72,13 +78,39 @@ class SimulationWorldUpdater {
   static constexpr double kSimWorldTimeIntervalMs = 100;
 
  private:
+  /**
+   * @brief What a client gets for its RequestSimulationWorld, as of its last
+   * request.
+   */
+  struct Subscription {
+    // The json of the whole SimulationWorld, which the level of detail
+    // clients also get until the first snapshot.
+    bool json = false;
+    bool planning_data = false;
+    bool level_of_detail = false;
+    bool binary = false;
+  };
+
   /**
    * @brief The callback function to get updates from SimulationWorldService,
-   * and update simulation_world_json_.
+   * and update simulation_world_json_. Only what the connected clients
+   * subscribe to is computed, and nothing without clients.
    * @param event Timer event
    */
   void OnTimer(const ros::TimerEvent &event);
 
+  /**
+   * @brief Gets the subscription of a client, empty before its first request.
+   */
+  Subscription GetSubscription(WebSocketHandler::Connection *conn);
+
+  /**
+   * @brief Gets what the clients subscribe to, all together.
+   * @param subscription the union of the subscriptions to be filled
+   * @return False if no client subscribes.
+   */
+  bool GetSubscriptions(Subscription *subscription);
+
   /**
    * @brief The function to construct a routing request from the given json,
    * @param json that contains start, end, and waypoints
@@ -136,7 +168,26 @@ class SimulationWorldUpdater {
   // NOTE: Use boost until we have std version of rwlock support.
   boost::shared_mutex mutex_;
 
-  bool enable_pnc_monitor_ = false;
+  // The jsons written by the timer before they are swapped with the ones
+  // above, so that the memory of both is reused.
+  std::string world_json_;
+  std::string next_simulation_world_json_;
+  std::string next_simulation_world_with_planning_json_;
+
+  // The SimulationWorld and the rest of its json update, kept by the timer
+  // while a client asks for a level of detail, which is applied to a copy
+  // for each request. Also protected by mutex_.
+  std::shared_ptr<const SimulationWorld> world_snapshot_;
+  MapElementIds snapshot_map_element_ids_;
+  int64_t snapshot_timestamp_ms_ = 0;
+
+  // The binary updates, encoded while a client asks for them.
+  SimulationWorldEncoder sim_world_encoder_;
+
+  // The subscriptions of the connected clients, removed when they close.
+  std::mutex subscription_mutex_;
+  std::unordered_map<WebSocketHandler::Connection *, Subscription>
+      subscriptions_;
 };
 
 }  // namespace dreamview
@@ -0,0 +1,21 @@
+import React from "react";
+import { observer } from "mobx-react";
+
+@observer
+export default class ResourceDisplay extends React.Component {
+    render() {
+        const { title, resource } = this.props;
+
+        return (
+            <div className="status-display">
+                <div className="name">{title}</div>
+                <div className="status">
+                    <span>
+                        CPU {resource.cpuUsage.toFixed(1)}%
+                        &nbsp;RSS {(resource.rssBytes / 1048576).toFixed(0)} MB
+                    </span>
+                </div>
+            </div>
+        );
+    }
+}
@@ -2,6 +2,7 @@ import React from "react";
 import { inject, observer } from "mobx-react";
 
 import CheckboxItem from "components/common/CheckboxItem";
+import ResourceDisplay from "components/ModuleController/ResourceDisplay";
 import StatusDisplay from "components/ModuleController/StatusDisplay";
 import WS from "store/websocket";
 
@@ -9,7 +10,8 @@ import WS from "store/websocket";
 export default class Header extends React.Component {
     render() {
         const { modes, currentMode,
-                moduleStatus, hardwareStatus, displayName } = this.props.store.hmi;
+                moduleStatus, hardwareStatus, moduleResource,
+                displayName } = this.props.store.hmi;
 
         const liveModules = (currentMode !== 'none')
                               ? modes[currentMode].liveModules : Array.from(moduleStatus.keys());
@@ -33,6 +35,11 @@ export default class Header extends React.Component {
                                            title={displayName[key]}
                                            status={hardwareStatus.get(key)}/>;
                 });
+        const resourceEntries = Array.from(moduleResource.keys()).sort().map((key) => {
+                  return <ResourceDisplay key={key}
+                                          title={displayName[key] || key}
+                                          resource={moduleResource.get(key)}/>;
+                });
 
         return (
             <div className="module-controller">
@@ -48,6 +55,12 @@ export default class Header extends React.Component {
                         {moduleEntries}
                     </div>
                 </div>
+                <div className="card">
+                    <div className="card-header"><span>Resources</span></div>
+                    <div className="card-content-column">
+                        {resourceEntries}
+                    </div>
+                </div>
             </div>
         );
     }
@@ -15,6 +15,7 @@ export default class HMI {
 
     @observable moduleStatus = observable.map();
     @observable hardwareStatus = observable.map();
+    @observable moduleResource = observable.map();
     @observable enableStartAuto = false;
 
     displayName = {};
@@ -65,6 +66,16 @@ export default class HMI {
                 }
             }
         }
+        if (newStatus.resourceStatus) {
+            this.moduleResource.clear();
+            (newStatus.resourceStatus.process || []).forEach(process => {
+                // The 64 bits integers are serialized as strings.
+                this.moduleResource.set(process.moduleName, {
+                    cpuUsage: process.cpuUsage || 0,
+                    rssBytes: Number(process.rssBytes || 0),
+                });
+            });
+        }
     }
 
     @action update(world) {
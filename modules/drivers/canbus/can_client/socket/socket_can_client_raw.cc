@@ -89,8 +89,9 @@ ErrorCode SocketCanClientRaw::Start() {
     return ErrorCode::CAN_CLIENT_ERROR_BASE;
   }
 
-  // strcpy(ifr.ifr_name, "can0");
-  std::strncpy(ifr.ifr_name, "can0", IFNAMSIZ);
+  // bind to the interface of the channel, i.e. can0, can1 ...
+  const std::string ifname = "can" + std::to_string(port_);
+  std::strncpy(ifr.ifr_name, ifname.c_str(), IFNAMSIZ);
   if (ioctl(dev_handler_, SIOCGIFINDEX, &ifr) < 0) {
     AERROR << "ioctl error";
     return ErrorCode::CAN_CLIENT_ERROR_BASE;
@@ -157,7 +158,9 @@ ErrorCode SocketCanClientRaw::Send(const std::vector<CanFrame> &frames,
   return ErrorCode::OK;
 }
 
-// buf size must be 8 bytes, every time, we receive only one frame
+// Receives up to frame_num frames in one recvmmsg call, which waits for the
+// first frame only and returns the ones already queued with it. frame_num is
+// set to the number of frames received.
 ErrorCode SocketCanClientRaw::Receive(std::vector<CanFrame> *const frames,
                                       int32_t *const frame_num) {
   if (!is_started_) {
@@ -171,15 +174,28 @@ ErrorCode SocketCanClientRaw::Receive(std::vector<CanFrame> *const frames,
     // TODO(Authors): check the difference of returning frame_num/error_code
     return ErrorCode::CAN_CLIENT_ERROR_FRAME_NUM;
   }
+  if (*frame_num == 0) {
+    return ErrorCode::OK;
+  }
 
-  for (int32_t i = 0; i < *frame_num && i < MAX_CAN_RECV_FRAME_LEN; ++i) {
-    CanFrame cf;
-    int ret = read(dev_handler_, &recv_frames_[i], sizeof(recv_frames_[i]));
+  struct mmsghdr msgs[MAX_CAN_RECV_FRAME_LEN];
+  struct iovec iovs[MAX_CAN_RECV_FRAME_LEN];
+  std::memset(msgs, 0, sizeof(msgs));
+  for (int32_t i = 0; i < *frame_num; ++i) {
+    iovs[i].iov_base = &recv_frames_[i];
+    iovs[i].iov_len = sizeof(recv_frames_[i]);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  const int ret =
+      recvmmsg(dev_handler_, msgs, *frame_num, MSG_WAITFORONE, nullptr);
+  if (ret < 0) {
+    AERROR << "receive message failed, error code: " << ret;
+    return ErrorCode::CAN_CLIENT_ERROR_BASE;
+  }
 
-    if (ret < 0) {
-      AERROR << "receive message failed, error code: " << ret;
-      return ErrorCode::CAN_CLIENT_ERROR_BASE;
-    }
+  *frame_num = ret;
+  for (int32_t i = 0; i < ret; ++i) {
     if (recv_frames_[i].can_dlc != CANBUS_MESSAGE_LENGTH) {
       AERROR << "recv_frames_[" << i
              << "].can_dlc = " << recv_frames_[i].can_dlc
@@ -187,6 +203,7 @@ ErrorCode SocketCanClientRaw::Receive(std::vector<CanFrame> *const frames,
              << CANBUS_MESSAGE_LENGTH << ").";
       return ErrorCode::CAN_CLIENT_ERROR_RECV_FAILED;
     }
+    CanFrame cf;
     cf.id = recv_frames_[i].can_id;
     cf.len = recv_frames_[i].can_dlc;
     std::memcpy(cf.data, recv_frames_[i].data, recv_frames_[i].can_dlc);
@@ -32,6 +32,7 @@
 #include "modules/common/log.h"
 #include "modules/common/macro.h"
 #include "modules/common/proto/error_code.pb.h"
+#include "modules/common/scheduling/scheduler.h"
 #include "modules/drivers/canbus/can_client/can_client.h"
 #include "modules/drivers/canbus/can_comm/message_manager.h"
 #include "modules/drivers/canbus/common/canbus_consts.h"
@@ -130,6 +131,8 @@ template <typename SensorType>
 template <typename SensorType>
 void CanReceiver<SensorType>::RecvThreadFunc() {
   AINFO << "Can client receiver thread starts.";
+  common::scheduling::Scheduler::instance()->ApplyToCurrentThread(
+      "CanReceiver");
   CHECK_NOTNULL(can_client_);
   CHECK_NOTNULL(pt_manager_);
 
@@ -166,12 +169,9 @@ void CanReceiver<SensorType>::RecvThreadFunc() {
     }
     receive_none_count = 0;
 
-    for (const auto &frame : buf) {
-      uint8_t len = frame.len;
-      uint32_t uid = frame.id;
-      const uint8_t *data = frame.data;
-      pt_manager_->Parse(uid, data, len);
-      if (enable_log_) {
+    pt_manager_->ParseFrames(buf);
+    if (enable_log_) {
+      for (const auto &frame : buf) {
         ADEBUG << "recv_can_frame#" << frame.CanFrameString();
       }
     }
@@ -22,12 +22,19 @@
 #ifndef MODULES_DRIVERS_CANBUS_CAN_COMM_CAN_SENDER_H_
 #define MODULES_DRIVERS_CANBUS_CAN_COMM_CAN_SENDER_H_
 
+#include <time.h>
+
 #include <algorithm>
 #include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <queue>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest_prod.h"
@@ -35,6 +42,7 @@
 #include "modules/common/log.h"
 #include "modules/common/macro.h"
 #include "modules/common/proto/error_code.pb.h"
+#include "modules/common/scheduling/scheduler.h"
 #include "modules/common/time/time.h"
 #include "modules/drivers/canbus/can_client/can_client.h"
 #include "modules/drivers/canbus/can_comm/protocol_data.h"
@@ -47,6 +55,24 @@ namespace apollo {
 namespace drivers {
 namespace canbus {
 
+/**
+ * @brief Upper bounds in us of the buckets of the send jitter histogram, the
+ *        last bucket counts the larger jitters.
+ */
+const int64_t kSendJitterBounds[] = {50, 100, 250, 500, 1000, 2500, 5000};
+const size_t kNumSendJitterBuckets =
+    sizeof(kSendJitterBounds) / sizeof(kSendJitterBounds[0]) + 1;
+
+/**
+ * @brief Upper bounds in us of the buckets of the histogram of the latency
+ *        from an update of the data to its send, the last bucket counts the
+ *        larger latencies.
+ */
+const int64_t kSendLatencyBounds[] = {100,  250,   500,   1000,
+                                      2500, 5000, 10000, 20000};
+const size_t kNumSendLatencyBuckets =
+    sizeof(kSendLatencyBounds) / sizeof(kSendLatencyBounds[0]) + 1;
+
 /**
  * @class SenderMessage
  * @brief This class defines the message to send.
@@ -111,12 +137,82 @@ class SenderMessage {
    */
   int32_t curr_period() const;
 
+  /**
+   * @brief Get the period to send messages from protocol data.
+   * @return The period in us.
+   */
+  int32_t period() const;
+
+  /**
+   * @brief Count a send in the jitter histogram.
+   * @param jitter The distance in us between the send and its deadline.
+   */
+  void RecordSendJitter(const int64_t jitter);
+
+  /**
+   * @brief Get the histogram of the send jitters.
+   * @return The number of sends in each bucket of kSendJitterBounds.
+   */
+  const std::array<uint64_t, kNumSendJitterBuckets> &send_jitter_histogram()
+      const;
+
+  /**
+   * @brief Mark the message to be sent as soon as its data is updated.
+   * @param immediate If the message is sent on updates.
+   */
+  void set_immediate(const bool immediate);
+
+  /**
+   * @brief Get if the message is sent as soon as its data is updated.
+   * @return If the message is sent on updates.
+   */
+  bool immediate() const;
+
+  /**
+   * @brief Note an update of the data not sent yet.
+   * @param time The time of the update in us.
+   */
+  void MarkUpdated(const int64_t time);
+
+  /**
+   * @brief Note a send and count the latency of the data it carried.
+   * @param update_time The time in us of the update of the data sent, 0 if
+   *        it was sent already.
+   * @param time The time of the send in us.
+   */
+  void MarkSent(const int64_t update_time, const int64_t time);
+
+  /**
+   * @brief Get the time of the update of the data not sent yet.
+   * @return The time in us, 0 if the data was sent.
+   */
+  int64_t update_time() const;
+
+  /**
+   * @brief Get the time of the last send.
+   * @return The time in us, 0 if the message was never sent.
+   */
+  int64_t last_send_time() const;
+
+  /**
+   * @brief Get the histogram of the latencies from updates to sends.
+   * @return The number of updates in each bucket of kSendLatencyBounds.
+   */
+  const std::array<uint64_t, kNumSendLatencyBuckets> &send_latency_histogram()
+      const;
+
  private:
   uint32_t message_id_ = 0;
   ProtocolData<SensorType> *protocol_data_ = nullptr;
 
   int32_t period_ = 0;
   int32_t curr_period_ = 0;
+  std::array<uint64_t, kNumSendJitterBuckets> send_jitter_histogram_ = {{}};
+
+  bool immediate_ = false;
+  int64_t update_time_ = 0;
+  int64_t last_send_time_ = 0;
+  std::array<uint64_t, kNumSendLatencyBuckets> send_latency_histogram_ = {{}};
 
  private:
   static std::mutex mutex_;
@@ -149,6 +245,15 @@ class CanSender {
    */
   common::ErrorCode Init(CanClient *can_client, bool enable_log);
 
+  /**
+   * @brief Set the scheduling of the sending thread, called before Start().
+   * @param sched_priority The SCHED_FIFO priority of the thread, from 1 to
+   *        99. The default scheduling is kept if it is not positive.
+   * @param cpu_affinity The cpus to run the thread on, all if it is empty.
+   */
+  void SetThreadConfig(const int sched_priority,
+                       const std::vector<int> &cpu_affinity);
+
   /**
    * @brief Add a message with its ID, protocol data.
    * @param message_id The message ID.
@@ -156,9 +261,18 @@ class CanSender {
    *        which contains the content to send.
    * @param init_with_one If it is true, then initialize all bits in
    *        the protocal data as one. By default, it is false.
+   * @param immediate If it is true, the message is sent by SendUpdated()
+   *        as well as on its period. By default, it is false.
    */
   void AddMessage(uint32_t message_id, ProtocolData<SensorType> *protocol_data,
-                  bool init_one = false);
+                  bool init_one = false, bool immediate = false);
+
+  /**
+   * @brief Set the minimum interval between two sends of a message, which
+   *        holds back the out of period sends.
+   * @param min_send_interval The interval in us.
+   */
+  void SetMinSendInterval(const int64_t min_send_interval);
 
   /**
    * @brief Start the CAN sender.
@@ -171,6 +285,14 @@ class CanSender {
    */
   void Update();
 
+  /**
+   * @brief Send right away the immediate messages updated since their last
+   *        send, instead of waiting for their period. A message sent less
+   *        than the minimum send interval ago is left to its period.
+   * @return The error code of the send, OK if nothing had to be sent.
+   */
+  apollo::common::ErrorCode SendUpdated();
+
   /**
    * @brief Stop the CAN sender.
    */
@@ -184,11 +306,45 @@ class CanSender {
   bool IsRunning() const;
   bool enable_log() const;
 
+  /**
+   * @brief Get the histogram of the send jitters of a message.
+   * @param message_id The message ID.
+   * @param histogram The number of sends in each bucket of
+   *        kSendJitterBounds, to be filled.
+   * @return If the message is sent by this CAN sender.
+   */
+  bool GetSendJitterHistogram(const uint32_t message_id,
+                              std::vector<uint64_t> *const histogram) const;
+
+  /**
+   * @brief Get the histogram of the latencies of a message from the updates
+   *        of its data to their sends on the CAN bus.
+   * @param message_id The message ID.
+   * @param histogram The number of updates in each bucket of
+   *        kSendLatencyBounds, to be filled.
+   * @return If the message is sent by this CAN sender.
+   */
+  bool GetSendLatencyHistogram(const uint32_t message_id,
+                               std::vector<uint64_t> *const histogram) const;
+
   FRIEND_TEST(CanSenderTest, OneRunCase);
 
  private:
   void PowerSendThreadFunc();
 
+  void ApplyThreadConfig();
+
+  // sends the frames and notes the sends of the messages, which carried the
+  // data of the update times
+  common::ErrorCode SendFrames(
+      const std::vector<CanFrame> &can_frames,
+      const std::vector<std::pair<size_t, int64_t>> &sent_updates);
+
+  // time of CLOCK_MONOTONIC in us, which the sending deadlines follow
+  static int64_t MonotonicTime();
+
+  static void SleepUntil(const int64_t time);
+
   bool NeedSend(const SenderMessage<SensorType> &msg,
                 const int32_t delta_period);
   bool is_init_ = false;
@@ -199,6 +355,14 @@ class CanSender {
   std::unique_ptr<std::thread> thread_;
   bool enable_log_ = false;
 
+  int sched_priority_ = 0;
+  std::vector<int> cpu_affinity_;
+  int64_t min_send_interval_ = 0;
+  // guards the send times and histograms of send_messages_
+  mutable std::mutex stat_mutex_;
+  // serializes the periodic sends and the ones of SendUpdated()
+  std::mutex send_mutex_;
+
   DISALLOW_COPY_AND_ASSIGN(CanSender);
 };
 
@@ -270,58 +434,207 @@ int32_t SenderMessage<SensorType>::curr_period() const {
 }
 
 template <typename SensorType>
-void CanSender<SensorType>::PowerSendThreadFunc() {
-  CHECK_NOTNULL(can_client_);
+int32_t SenderMessage<SensorType>::period() const {
+  return period_;
+}
 
-  const int32_t INIT_PERIOD = 5000;  // 5ms
-  int32_t delta_period = INIT_PERIOD;
-  int32_t new_delta_period = INIT_PERIOD;
+template <typename SensorType>
+void SenderMessage<SensorType>::RecordSendJitter(const int64_t jitter) {
+  size_t bucket = 0;
+  while (bucket + 1 < kNumSendJitterBuckets &&
+         jitter > kSendJitterBounds[bucket]) {
+    ++bucket;
+  }
+  ++send_jitter_histogram_[bucket];
+}
 
-  int64_t tm_start = 0;
-  int64_t tm_end = 0;
-  int64_t sleep_interval = 0;
+template <typename SensorType>
+const std::array<uint64_t, kNumSendJitterBuckets>
+    &SenderMessage<SensorType>::send_jitter_histogram() const {
+  return send_jitter_histogram_;
+}
+
+template <typename SensorType>
+void SenderMessage<SensorType>::set_immediate(const bool immediate) {
+  immediate_ = immediate;
+}
+
+template <typename SensorType>
+bool SenderMessage<SensorType>::immediate() const {
+  return immediate_;
+}
+
+template <typename SensorType>
+void SenderMessage<SensorType>::MarkUpdated(const int64_t time) {
+  update_time_ = time;
+}
+
+template <typename SensorType>
+void SenderMessage<SensorType>::MarkSent(const int64_t update_time,
+                                         const int64_t time) {
+  last_send_time_ = time;
+  if (update_time <= 0) {
+    return;
+  }
+  size_t bucket = 0;
+  while (bucket + 1 < kNumSendLatencyBuckets &&
+         time - update_time > kSendLatencyBounds[bucket]) {
+    ++bucket;
+  }
+  ++send_latency_histogram_[bucket];
+  // an update after the frame was taken is still to be sent
+  if (update_time_ == update_time) {
+    update_time_ = 0;
+  }
+}
+
+template <typename SensorType>
+int64_t SenderMessage<SensorType>::update_time() const {
+  return update_time_;
+}
+
+template <typename SensorType>
+int64_t SenderMessage<SensorType>::last_send_time() const {
+  return last_send_time_;
+}
+
+template <typename SensorType>
+const std::array<uint64_t, kNumSendLatencyBuckets>
+    &SenderMessage<SensorType>::send_latency_histogram() const {
+  return send_latency_histogram_;
+}
+
+template <typename SensorType>
+void CanSender<SensorType>::PowerSendThreadFunc() {
+  CHECK_NOTNULL(can_client_);
+  ApplyThreadConfig();
+
+  // wake up at least every 5ms to notice Stop()
+  const int64_t MAX_SLEEP = 5000;
+  // frames due within 0.1ms of the first one are sent in the same batch
+  const int64_t BATCH_WINDOW = 100;
+
+  // min-heap of the next deadline of each message in send_messages_
+  typedef std::pair<int64_t, size_t> Deadline;
+  std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>>
+      deadlines;
+  const int64_t start = MonotonicTime();
+  for (size_t i = 0; i < send_messages_.size(); ++i) {
+    deadlines.emplace(start, i);
+  }
+  std::vector<CanFrame> can_frames;
+  std::vector<std::pair<size_t, int64_t>> sent_updates;
 
   AINFO << "Can client sender thread starts.";
 
   while (is_running_) {
-    tm_start = common::time::AsInt64<common::time::micros>(
-        common::time::Clock::Now());
-    new_delta_period = INIT_PERIOD;
-
-    for (auto &message : send_messages_) {
-      bool need_send = NeedSend(message, delta_period);
-      message.UpdateCurrPeriod(delta_period);
-      new_delta_period = std::min(new_delta_period, message.curr_period());
+    const int64_t now = MonotonicTime();
+    if (deadlines.empty() || deadlines.top().first > now) {
+      SleepUntil(deadlines.empty()
+                     ? now + MAX_SLEEP
+                     : std::min(deadlines.top().first, now + MAX_SLEEP));
+      continue;
+    }
 
-      if (!need_send) {
-        continue;
-      }
-      std::vector<CanFrame> can_frames;
-      CanFrame can_frame = message.CanFrame();
-      can_frames.push_back(can_frame);
-      if (can_client_->SendSingleFrame(can_frames) != common::ErrorCode::OK) {
-        AERROR << "Send msg failed:" << can_frame.CanFrameString();
-      }
-      if (enable_log()) {
-        ADEBUG << "send_can_frame#" << can_frame.CanFrameString();
+    can_frames.clear();
+    sent_updates.clear();
+    {
+      std::lock_guard<std::mutex> lock(stat_mutex_);
+      while (!deadlines.empty() &&
+             deadlines.top().first <= now + BATCH_WINDOW) {
+        const Deadline deadline = deadlines.top();
+        deadlines.pop();
+        auto &message = send_messages_[deadline.second];
+        // a frame sent out of period just before is not repeated unless its
+        // data changed since
+        const bool resend = message.update_time() == 0 &&
+                            message.last_send_time() > 0 &&
+                            now - message.last_send_time() < min_send_interval_;
+        if (!resend) {
+          can_frames.push_back(message.CanFrame());
+          sent_updates.emplace_back(deadline.second, message.update_time());
+          message.RecordSendJitter(std::abs(now - deadline.first));
+        }
+
+        // keep the deadlines on the grid of the period, unless whole periods
+        // were missed
+        const int64_t period = std::max(message.period(), 1);
+        int64_t next = deadline.first + period;
+        if (next <= now) {
+          next = now + period;
+        }
+        deadlines.emplace(next, deadline.second);
       }
     }
-    delta_period = new_delta_period;
-    tm_end = common::time::AsInt64<common::time::micros>(
-        common::time::Clock::Now());
-    sleep_interval = delta_period - (tm_end - tm_start);
-
-    if (sleep_interval > 0) {
-      std::this_thread::sleep_for(std::chrono::microseconds(sleep_interval));
-    } else {
-      // do not sleep
-      AWARN << "Too much time for calculation: " << tm_end - tm_start
-            << "us is more than minimum period: " << delta_period << "us";
+
+    if (!can_frames.empty()) {
+      SendFrames(can_frames, sent_updates);
     }
   }
   AINFO << "Can client sender thread stopped!";
 }
 
+template <typename SensorType>
+common::ErrorCode CanSender<SensorType>::SendFrames(
+    const std::vector<CanFrame> &can_frames,
+    const std::vector<std::pair<size_t, int64_t>> &sent_updates) {
+  common::ErrorCode error_code = common::ErrorCode::OK;
+  {
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    int32_t frame_num = static_cast<int32_t>(can_frames.size());
+    error_code = can_client_->Send(can_frames, &frame_num);
+  }
+  if (error_code != common::ErrorCode::OK) {
+    for (const auto &can_frame : can_frames) {
+      AERROR << "Send msg failed:" << can_frame.CanFrameString();
+    }
+  } else {
+    const int64_t now = MonotonicTime();
+    std::lock_guard<std::mutex> lock(stat_mutex_);
+    for (const auto &sent_update : sent_updates) {
+      send_messages_[sent_update.first].MarkSent(sent_update.second, now);
+    }
+  }
+  if (enable_log()) {
+    for (const auto &can_frame : can_frames) {
+      ADEBUG << "send_can_frame#" << can_frame.CanFrameString();
+    }
+  }
+  return error_code;
+}
+
+template <typename SensorType>
+void CanSender<SensorType>::ApplyThreadConfig() {
+  // The scheduling set by the module takes precedence over the one of the
+  // scheduling config.
+  auto *scheduler = common::scheduling::Scheduler::instance();
+  if (sched_priority_ > 0 || !cpu_affinity_.empty()) {
+    scheduler->ApplyToCurrentThread(
+        "CanSender",
+        common::scheduling::MakeThreadSchedule(sched_priority_, cpu_affinity_));
+  } else {
+    scheduler->ApplyToCurrentThread("CanSender");
+  }
+}
+
+template <typename SensorType>
+int64_t CanSender<SensorType>::MonotonicTime() {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+}
+
+template <typename SensorType>
+void CanSender<SensorType>::SleepUntil(const int64_t time) {
+  // an absolute wake up time does not drift with the time spent sending
+  timespec wake_up;
+  wake_up.tv_sec = time / 1000000;
+  wake_up.tv_nsec = (time % 1000000) * 1000;
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake_up, nullptr) ==
+         EINTR) {
+  }
+}
+
 template <typename SensorType>
 common::ErrorCode CanSender<SensorType>::Init(CanClient *can_client,
                                               bool enable_log) {
@@ -339,19 +652,36 @@ common::ErrorCode CanSender<SensorType>::Init(CanClient *can_client,
   return common::ErrorCode::OK;
 }
 
+template <typename SensorType>
+void CanSender<SensorType>::SetThreadConfig(
+    const int sched_priority, const std::vector<int> &cpu_affinity) {
+  if (is_running_) {
+    AWARN << "The thread config only applies when can sender starts.";
+  }
+  sched_priority_ = sched_priority;
+  cpu_affinity_ = cpu_affinity;
+}
+
 template <typename SensorType>
 void CanSender<SensorType>::AddMessage(uint32_t message_id,
                                        ProtocolData<SensorType> *protocol_data,
-                                       bool init_with_one) {
+                                       bool init_with_one, bool immediate) {
   if (protocol_data == nullptr) {
     AERROR << "invalid protocol data.";
     return;
   }
   send_messages_.emplace_back(
       SenderMessage<SensorType>(message_id, protocol_data, init_with_one));
+  send_messages_.back().set_immediate(immediate);
   AINFO << "Add send message:" << std::hex << message_id;
 }
 
+template <typename SensorType>
+void CanSender<SensorType>::SetMinSendInterval(
+    const int64_t min_send_interval) {
+  min_send_interval_ = std::max<int64_t>(min_send_interval, 0);
+}
+
 template <typename SensorType>
 common::ErrorCode CanSender<SensorType>::Start() {
   if (is_running_) {
@@ -366,9 +696,41 @@ common::ErrorCode CanSender<SensorType>::Start() {
 
 template <typename SensorType>
 void CanSender<SensorType>::Update() {
+  const int64_t now = MonotonicTime();
+  std::lock_guard<std::mutex> lock(stat_mutex_);
   for (auto &message : send_messages_) {
     message.Update();
+    message.MarkUpdated(now);
+  }
+}
+
+template <typename SensorType>
+common::ErrorCode CanSender<SensorType>::SendUpdated() {
+  if (!is_running_) {
+    return common::ErrorCode::OK;
+  }
+  std::vector<CanFrame> can_frames;
+  std::vector<std::pair<size_t, int64_t>> sent_updates;
+  {
+    const int64_t now = MonotonicTime();
+    std::lock_guard<std::mutex> lock(stat_mutex_);
+    for (size_t i = 0; i < send_messages_.size(); ++i) {
+      auto &message = send_messages_[i];
+      if (!message.immediate() || message.update_time() == 0) {
+        continue;
+      }
+      if (message.last_send_time() > 0 &&
+          now - message.last_send_time() < min_send_interval_) {
+        continue;
+      }
+      can_frames.push_back(message.CanFrame());
+      sent_updates.emplace_back(i, message.update_time());
+    }
   }
+  if (can_frames.empty()) {
+    return common::ErrorCode::OK;
+  }
+  return SendFrames(can_frames, sent_updates);
 }
 
 template <typename SensorType>
@@ -397,6 +759,36 @@ bool CanSender<SensorType>::enable_log() const {
   return enable_log_;
 }
 
+template <typename SensorType>
+bool CanSender<SensorType>::GetSendJitterHistogram(
+    const uint32_t message_id, std::vector<uint64_t> *const histogram) const {
+  CHECK_NOTNULL(histogram);
+  std::lock_guard<std::mutex> lock(stat_mutex_);
+  for (const auto &message : send_messages_) {
+    if (message.message_id() == message_id) {
+      const auto &message_histogram = message.send_jitter_histogram();
+      histogram->assign(message_histogram.begin(), message_histogram.end());
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename SensorType>
+bool CanSender<SensorType>::GetSendLatencyHistogram(
+    const uint32_t message_id, std::vector<uint64_t> *const histogram) const {
+  CHECK_NOTNULL(histogram);
+  std::lock_guard<std::mutex> lock(stat_mutex_);
+  for (const auto &message : send_messages_) {
+    if (message.message_id() == message_id) {
+      const auto &message_histogram = message.send_latency_histogram();
+      histogram->assign(message_histogram.begin(), message_histogram.end());
+      return true;
+    }
+  }
+  return false;
+}
+
 template <typename SensorType>
 bool CanSender<SensorType>::NeedSend(const SenderMessage<SensorType> &msg,
                                      const int32_t delta_period) {
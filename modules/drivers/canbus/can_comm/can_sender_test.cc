@@ -16,6 +16,11 @@
 
 #include "modules/drivers/canbus/can_comm/can_sender.h"
 
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "modules/canbus/proto/chassis_detail.pb.h"
@@ -27,6 +32,25 @@ namespace apollo {
 namespace drivers {
 namespace canbus {
 
+class BatchCanClient : public can::FakeCanClient {
+ public:
+  common::ErrorCode Send(const std::vector<CanFrame> &frames,
+                         int32_t *const frame_num) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    batch_sizes_.push_back(frames.size());
+    return FakeCanClient::Send(frames, frame_num);
+  }
+
+  std::vector<size_t> batch_sizes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batch_sizes_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<size_t> batch_sizes_;
+};
+
 TEST(CanSenderTest, OneRunCase) {
   CanSender<::apollo::canbus::ChassisDetail> sender;
   can::FakeCanClient can_client;
@@ -51,6 +75,79 @@ TEST(CanSenderTest, OneRunCase) {
   EXPECT_FALSE(sender.IsRunning());
 }
 
+TEST(CanSenderTest, BatchSend) {
+  CanSender<::apollo::canbus::ChassisDetail> sender;
+  BatchCanClient can_client;
+  sender.Init(&can_client, false);
+  sender.SetThreadConfig(0, {});
+
+  ProtocolData<::apollo::canbus::ChassisDetail> mpd;
+  sender.AddMessage(1, &mpd);
+  sender.AddMessage(2, &mpd);
+  EXPECT_EQ(sender.Start(), common::ErrorCode::OK);
+  // less than the 100ms period of the messages
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  sender.Stop();
+
+  // the messages due at the same time are sent in one batch
+  EXPECT_EQ(std::vector<size_t>({2}), can_client.batch_sizes());
+  std::vector<uint64_t> histogram;
+  ASSERT_TRUE(sender.GetSendJitterHistogram(2, &histogram));
+  ASSERT_EQ(kNumSendJitterBuckets, histogram.size());
+  uint64_t num_sends = 0;
+  for (const uint64_t count : histogram) {
+    num_sends += count;
+  }
+  EXPECT_EQ(1u, num_sends);
+  EXPECT_FALSE(sender.GetSendJitterHistogram(3, &histogram));
+}
+
+TEST(CanSenderTest, SendUpdated) {
+  CanSender<::apollo::canbus::ChassisDetail> sender;
+  BatchCanClient can_client;
+  sender.Init(&can_client, false);
+  sender.SetMinSendInterval(20000);
+
+  ProtocolData<::apollo::canbus::ChassisDetail> mpd;
+  sender.AddMessage(1, &mpd, false, true);
+  sender.AddMessage(2, &mpd);
+  // nothing is sent before the sender starts
+  sender.Update();
+  EXPECT_EQ(common::ErrorCode::OK, sender.SendUpdated());
+  EXPECT_TRUE(can_client.batch_sizes().empty());
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+  EXPECT_EQ(sender.Start(), common::ErrorCode::OK);
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  // the periodic send carried the update already
+  EXPECT_EQ(std::vector<size_t>({2}), can_client.batch_sizes());
+  EXPECT_EQ(common::ErrorCode::OK, sender.SendUpdated());
+  EXPECT_EQ(1u, can_client.batch_sizes().size());
+
+  // only the immediate message is sent out of period
+  sender.Update();
+  EXPECT_EQ(common::ErrorCode::OK, sender.SendUpdated());
+  EXPECT_EQ(std::vector<size_t>({2, 1}), can_client.batch_sizes());
+
+  // and not again within the minimum send interval
+  sender.Update();
+  EXPECT_EQ(common::ErrorCode::OK, sender.SendUpdated());
+  EXPECT_EQ(2u, can_client.batch_sizes().size());
+  sender.Stop();
+
+  std::vector<uint64_t> histogram;
+  ASSERT_TRUE(sender.GetSendLatencyHistogram(1, &histogram));
+  ASSERT_EQ(kNumSendLatencyBuckets, histogram.size());
+  uint64_t num_sends = 0;
+  for (const uint64_t count : histogram) {
+    num_sends += count;
+  }
+  EXPECT_EQ(2u, num_sends);
+  // the out of period send is faster than the periodic one
+  EXPECT_EQ(1u, histogram[0]);
+  EXPECT_FALSE(sender.GetSendLatencyHistogram(3, &histogram));
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
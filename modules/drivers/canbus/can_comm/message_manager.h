@@ -32,6 +32,7 @@
 #include "modules/common/log.h"
 #include "modules/common/proto/error_code.pb.h"
 #include "modules/common/time/time.h"
+#include "modules/drivers/canbus/can_client/can_client.h"
 #include "modules/drivers/canbus/can_comm/protocol_data.h"
 #include "modules/drivers/canbus/common/byte.h"
 
@@ -86,6 +87,13 @@ class MessageManager {
   virtual void Parse(const uint32_t message_id, const uint8_t *data,
                      int32_t length);
 
+  /**
+   * @brief parse a batch of received frames, locking the sensor data once
+   *        for the whole batch
+   * @param frames the frames to be parsed
+   */
+  void ParseFrames(const std::vector<CanFrame> &frames);
+
   void ClearSensorData();
 
   std::condition_variable* GetMutableCVar();
@@ -99,8 +107,8 @@ class MessageManager {
       const uint32_t message_id);
 
   /**
-   * @brief get chassis detail. used lock_guard in this function to avoid
-   * concurrent read/write issue.
+   * @brief get chassis detail. It is copied from the snapshot taken after
+   * the last parse, so it does not wait for the parsing in progress.
    * @param chassis_detail chassis_detail to be filled.
    */
   common::ErrorCode GetSensorData(SensorType *const sensor_data);
@@ -111,6 +119,26 @@ class MessageManager {
   void ResetSendMessages();
 
  protected:
+  /**
+   * @brief parse data into sensor data, called with sensor_data_mutex_ held
+   * @param message_id the id of the message
+   * @param data a pointer to the data array to be parsed
+   * @param length the length of data array
+   */
+  virtual void ParseLocked(const uint32_t message_id, const uint8_t *data,
+                           int32_t length);
+
+  /**
+   * @brief record the receive time of a message in its protocol data
+   */
+  void RecordReceive(const uint32_t message_id, const int64_t time);
+
+  /**
+   * @brief replace the snapshot read by GetSensorData() with a copy of
+   * sensor_data_, called with sensor_data_mutex_ held
+   */
+  void UpdateSnapshot();
+
   template <class T, bool need_check>
   void AddRecvProtocolData();
 
@@ -124,13 +152,70 @@ class MessageManager {
   std::unordered_map<uint32_t, CheckIdArg> check_ids_;
   std::set<uint32_t> received_ids_;
 
+  /**
+   * @brief The protocol data and the period check of the standard 11-bit
+   * message ids, indexed by id, so that a frame is dispatched without a map
+   * lookup. The larger ids go through the maps above.
+   */
+  struct DispatchEntry {
+    ProtocolData<SensorType> *protocol_data = nullptr;
+    // points into check_ids_, whose elements do not move
+    CheckIdArg *check_id = nullptr;
+  };
+  static constexpr uint32_t kDispatchTableSize = 0x800;
+  std::vector<DispatchEntry> dispatch_table_ =
+      std::vector<DispatchEntry>(kDispatchTableSize);
+
+  /**
+   * @brief register a protocol data in the maps and the dispatch table
+   */
+  void AddProtocolData(ProtocolData<SensorType> *protocol_data,
+                       const uint32_t message_id, const bool need_check);
+
   std::mutex sensor_data_mutex_;
   SensorType sensor_data_;
   bool is_received_on_time_ = false;
 
+  // whether Parse() and ParseFrames() update the snapshot, false for the
+  // managers which update it themselves once the sensor data is complete
+  bool update_snapshot_on_parse_ = true;
+
+  // copy of sensor_data_ for the readers, and the previous copy, reused when
+  // no reader holds it anymore. snapshot_mutex_ only guards the pointer swap.
+  std::shared_ptr<const SensorType> snapshot_{new SensorType()};
+  std::shared_ptr<SensorType> spare_snapshot_;
+  std::mutex snapshot_mutex_;
+
   std::condition_variable cvar_;
 };
 
+template <typename SensorType>
+constexpr uint32_t MessageManager<SensorType>::kDispatchTableSize;
+
+template <typename SensorType>
+void MessageManager<SensorType>::AddProtocolData(
+    ProtocolData<SensorType> *protocol_data, const uint32_t message_id,
+    const bool need_check) {
+  protocol_data_map_[message_id] = protocol_data;
+  CheckIdArg *check_id = nullptr;
+  if (need_check) {
+    check_id = &check_ids_[message_id];
+    check_id->period = protocol_data->GetPeriod();
+    check_id->real_period = 0;
+    check_id->last_time = 0;
+    check_id->error_count = 0;
+  } else {
+    const auto it = check_ids_.find(message_id);
+    if (it != check_ids_.end()) {
+      check_id = &it->second;
+    }
+  }
+  if (message_id < kDispatchTableSize) {
+    dispatch_table_[message_id].protocol_data = protocol_data;
+    dispatch_table_[message_id].check_id = check_id;
+  }
+}
+
 template <typename SensorType>
 template <class T, bool need_check>
 void MessageManager<SensorType>::AddRecvProtocolData() {
@@ -139,13 +224,7 @@ void MessageManager<SensorType>::AddRecvProtocolData() {
   if (dt == nullptr) {
     return;
   }
-  protocol_data_map_[T::ID] = dt;
-  if (need_check) {
-    check_ids_[T::ID].period = dt->GetPeriod();
-    check_ids_[T::ID].real_period = 0;
-    check_ids_[T::ID].last_time = 0;
-    check_ids_[T::ID].error_count = 0;
-  }
+  AddProtocolData(dt, T::ID, need_check);
 }
 
 template <typename SensorType>
@@ -156,53 +235,123 @@ void MessageManager<SensorType>::AddSendProtocolData() {
   if (dt == nullptr) {
     return;
   }
-  protocol_data_map_[T::ID] = dt;
-  if (need_check) {
-    check_ids_[T::ID].period = dt->GetPeriod();
-    check_ids_[T::ID].real_period = 0;
-    check_ids_[T::ID].last_time = 0;
-    check_ids_[T::ID].error_count = 0;
-  }
+  AddProtocolData(dt, T::ID, need_check);
 }
 
 template <typename SensorType>
 ProtocolData<SensorType>
     *MessageManager<SensorType>::GetMutableProtocolDataById(
         const uint32_t message_id) {
-  if (protocol_data_map_.find(message_id) == protocol_data_map_.end()) {
+  if (message_id < kDispatchTableSize) {
+    ProtocolData<SensorType> *protocol_data =
+        dispatch_table_[message_id].protocol_data;
+    if (protocol_data == nullptr) {
+      ADEBUG << "Unable to get protocol data because of invalid message_id:"
+             << Byte::byte_to_hex(message_id);
+    }
+    return protocol_data;
+  }
+  const auto it = protocol_data_map_.find(message_id);
+  if (it == protocol_data_map_.end()) {
     ADEBUG << "Unable to get protocol data because of invalid message_id:"
            << Byte::byte_to_hex(message_id);
     return nullptr;
   }
-  return protocol_data_map_[message_id];
+  return it->second;
 }
 
 template <typename SensorType>
 void MessageManager<SensorType>::Parse(const uint32_t message_id,
                                        const uint8_t *data, int32_t length) {
+  RecordReceive(message_id,
+                apollo::common::time::AsInt64<micros>(Clock::Now()));
+  std::lock_guard<std::mutex> lock(sensor_data_mutex_);
+  ParseLocked(message_id, data, length);
+  if (update_snapshot_on_parse_) {
+    UpdateSnapshot();
+  }
+}
+
+template <typename SensorType>
+void MessageManager<SensorType>::ParseFrames(
+    const std::vector<CanFrame> &frames) {
+  const int64_t time = apollo::common::time::AsInt64<micros>(Clock::Now());
+  for (const auto &frame : frames) {
+    RecordReceive(frame.id, time);
+  }
+  std::lock_guard<std::mutex> lock(sensor_data_mutex_);
+  for (const auto &frame : frames) {
+    ParseLocked(frame.id, frame.data, frame.len);
+  }
+  if (update_snapshot_on_parse_) {
+    UpdateSnapshot();
+  }
+}
+
+template <typename SensorType>
+void MessageManager<SensorType>::RecordReceive(const uint32_t message_id,
+                                               const int64_t time) {
+  ProtocolData<SensorType> *protocol_data = nullptr;
+  if (message_id < kDispatchTableSize) {
+    protocol_data = dispatch_table_[message_id].protocol_data;
+  } else {
+    const auto it = protocol_data_map_.find(message_id);
+    if (it != protocol_data_map_.end()) {
+      protocol_data = it->second;
+    }
+  }
+  if (protocol_data != nullptr) {
+    protocol_data->RecordReceive(time);
+  }
+}
+
+template <typename SensorType>
+void MessageManager<SensorType>::UpdateSnapshot() {
+  if (spare_snapshot_ == nullptr || spare_snapshot_.use_count() > 1) {
+    spare_snapshot_.reset(new SensorType());
+  }
+  spare_snapshot_->CopyFrom(sensor_data_);
+  std::shared_ptr<const SensorType> snapshot = spare_snapshot_;
+  {
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    snapshot_.swap(snapshot);
+  }
+  // keep the previous snapshot for reuse, a reader copying it still holds it
+  spare_snapshot_ = std::const_pointer_cast<SensorType>(snapshot);
+}
+
+template <typename SensorType>
+void MessageManager<SensorType>::ParseLocked(const uint32_t message_id,
+                                             const uint8_t *data,
+                                             int32_t length) {
   ProtocolData<SensorType> *protocol_data =
       GetMutableProtocolDataById(message_id);
   if (protocol_data == nullptr) {
     return;
   }
-  {
-    std::lock_guard<std::mutex> lock(sensor_data_mutex_);
-    protocol_data->Parse(data, length, &sensor_data_);
-  }
+  protocol_data->Parse(data, length, &sensor_data_);
   received_ids_.insert(message_id);
   // check if need to check period
-  const auto it = check_ids_.find(message_id);
-  if (it != check_ids_.end()) {
+  CheckIdArg *check_id = nullptr;
+  if (message_id < kDispatchTableSize) {
+    check_id = dispatch_table_[message_id].check_id;
+  } else {
+    const auto it = check_ids_.find(message_id);
+    if (it != check_ids_.end()) {
+      check_id = &it->second;
+    }
+  }
+  if (check_id != nullptr) {
     const int64_t time = apollo::common::time::AsInt64<micros>(Clock::Now());
-    it->second.real_period = time - it->second.last_time;
+    check_id->real_period = time - check_id->last_time;
     // if period 1.5 large than base period, inc error_count
     const double period_multiplier = 1.5;
-    if (it->second.real_period > (it->second.period * period_multiplier)) {
-      it->second.error_count += 1;
+    if (check_id->real_period > (check_id->period * period_multiplier)) {
+      check_id->error_count += 1;
     } else {
-      it->second.error_count = 0;
+      check_id->error_count = 0;
     }
-    it->second.last_time = time;
+    check_id->last_time = time;
   }
 }
 
@@ -210,6 +359,7 @@ template <typename SensorType>
 void MessageManager<SensorType>::ClearSensorData() {
   std::lock_guard<std::mutex> lock(sensor_data_mutex_);
   sensor_data_.Clear();
+  UpdateSnapshot();
 }
 
 template <typename SensorType>
@@ -224,8 +374,12 @@ ErrorCode MessageManager<SensorType>::GetSensorData(
     AERROR << "Failed to get sensor_data due to nullptr.";
     return ErrorCode::CANBUS_ERROR;
   }
-  std::lock_guard<std::mutex> lock(sensor_data_mutex_);
-  sensor_data->CopyFrom(sensor_data_);
+  std::shared_ptr<const SensorType> snapshot;
+  {
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    snapshot = snapshot_;
+  }
+  sensor_data->CopyFrom(*snapshot);
   return ErrorCode::OK;
 }
 
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -34,6 +35,10 @@ class MockProtocolData : public ProtocolData<::apollo::canbus::ChassisDetail> {
  public:
   static const int32_t ID = 0x111;
   MockProtocolData() {}
+  void Parse(const uint8_t *bytes, int32_t length,
+             ::apollo::canbus::ChassisDetail *chassis_detail) const override {
+    chassis_detail->set_car_type(::apollo::canbus::ChassisDetail::QIRUI_EQ_15);
+  }
 };
 
 class MockMessageManager
@@ -43,6 +48,8 @@ class MockMessageManager
     AddRecvProtocolData<MockProtocolData, true>();
     AddSendProtocolData<MockProtocolData, true>();
   }
+
+  const std::set<uint32_t> &received_ids() const { return received_ids_; }
 };
 
 TEST(MessageManagerTest, GetMutableProtocolDataById) {
@@ -59,6 +66,50 @@ TEST(MessageManagerTest, GetMutableProtocolDataById) {
   EXPECT_EQ(manager.GetSensorData(nullptr), ErrorCode::CANBUS_ERROR);
 }
 
+TEST(MessageManagerTest, ParseFrames) {
+  MockMessageManager manager;
+  std::vector<CanFrame> frames(3);
+  frames[0].id = MockProtocolData::ID;
+  frames[1].id = 0x222;
+  frames[2].id = MockProtocolData::ID;
+  for (auto &frame : frames) {
+    frame.len = 8;
+  }
+  manager.ParseFrames(frames);
+
+  // the frame of an unknown id is skipped
+  EXPECT_EQ(std::set<uint32_t>({MockProtocolData::ID}),
+            manager.received_ids());
+
+  // the receive time of both frames of the known id is recorded
+  const ReceiveStat stat =
+      manager.GetMutableProtocolDataById(MockProtocolData::ID)
+          ->GetReceiveStat();
+  EXPECT_EQ(2u, stat.count);
+  EXPECT_EQ(0, stat.average_period);
+  EXPECT_GT(stat.last_time, 0);
+}
+
+TEST(MessageManagerTest, SensorDataSnapshot) {
+  MockMessageManager manager;
+  ::apollo::canbus::ChassisDetail chassis_detail;
+  EXPECT_EQ(manager.GetSensorData(&chassis_detail), ErrorCode::OK);
+  EXPECT_FALSE(chassis_detail.has_car_type());
+
+  uint8_t mock_data[8] = {0};
+  manager.Parse(MockProtocolData::ID, mock_data, 8);
+  EXPECT_EQ(manager.GetSensorData(&chassis_detail), ErrorCode::OK);
+  EXPECT_EQ(::apollo::canbus::ChassisDetail::QIRUI_EQ_15,
+            chassis_detail.car_type());
+
+  // a copy already taken is not touched by the later updates
+  manager.ClearSensorData();
+  EXPECT_EQ(::apollo::canbus::ChassisDetail::QIRUI_EQ_15,
+            chassis_detail.car_type());
+  EXPECT_EQ(manager.GetSensorData(&chassis_detail), ErrorCode::OK);
+  EXPECT_FALSE(chassis_detail.has_car_type());
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
@@ -22,6 +22,7 @@
 #ifndef MODULES_DRIVERS_CANBUS_CAN_COMM_PROTOCOL_DATA_H_
 #define MODULES_DRIVERS_CANBUS_CAN_COMM_PROTOCOL_DATA_H_
 
+#include <atomic>
 #include <cmath>
 #include <numeric>
 
@@ -41,6 +42,21 @@ namespace canbus {
  *
  * @brief This is the base class of protocol data.
  */
+/**
+ * @struct ReceiveStat
+ * @brief Receive statistics of a message id.
+ */
+struct ReceiveStat {
+  // number of received messages
+  uint64_t count = 0;
+  // receive time of the last message in us (1e-6s)
+  int64_t last_time = 0;
+  // receive period in us, averaged over about the last 16 messages
+  int64_t average_period = 0;
+  // longest receive period in us
+  int64_t max_period = 0;
+};
+
 template <typename SensorType>
 class ProtocolData {
  public:
@@ -88,6 +104,19 @@ class ProtocolData {
    */
   virtual void UpdateData(uint8_t *data);
 
+  /*
+   * @brief record the receive time of a message of this protocol. Called by
+   * the receiving thread only.
+   * @param time the receive time in us (1e-6s)
+   */
+  void RecordReceive(const int64_t time);
+
+  /*
+   * @brief get the receive statistics, which may be read by any thread
+   * @return the receive statistics
+   */
+  ReceiveStat GetReceiveStat() const;
+
   /*
    * @brief reset the protocol data
    */
@@ -101,6 +130,10 @@ class ProtocolData {
 
  private:
   const int32_t data_length_ = CANBUS_MESSAGE_LENGTH;
+  std::atomic<uint64_t> receive_count_{0};
+  std::atomic<int64_t> last_receive_time_{0};
+  std::atomic<int64_t> average_receive_period_{0};
+  std::atomic<int64_t> max_receive_period_{0};
 };
 
 template <typename SensorType>
@@ -146,6 +179,34 @@ void ProtocolData<SensorType>::UpdateData(uint8_t * /*data*/) {}
 template <typename SensorType>
 void ProtocolData<SensorType>::Reset() {}
 
+template <typename SensorType>
+void ProtocolData<SensorType>::RecordReceive(const int64_t time) {
+  const uint64_t count = receive_count_.load(std::memory_order_relaxed);
+  if (count > 0) {
+    const int64_t period =
+        time - last_receive_time_.load(std::memory_order_relaxed);
+    int64_t average = average_receive_period_.load(std::memory_order_relaxed);
+    average = count == 1 ? period : average + (period - average) / 16;
+    average_receive_period_.store(average, std::memory_order_relaxed);
+    if (period > max_receive_period_.load(std::memory_order_relaxed)) {
+      max_receive_period_.store(period, std::memory_order_relaxed);
+    }
+  }
+  last_receive_time_.store(time, std::memory_order_relaxed);
+  receive_count_.store(count + 1, std::memory_order_release);
+}
+
+template <typename SensorType>
+ReceiveStat ProtocolData<SensorType>::GetReceiveStat() const {
+  ReceiveStat stat;
+  stat.count = receive_count_.load(std::memory_order_acquire);
+  stat.last_time = last_receive_time_.load(std::memory_order_relaxed);
+  stat.average_period =
+      average_receive_period_.load(std::memory_order_relaxed);
+  stat.max_period = max_receive_period_.load(std::memory_order_relaxed);
+  return stat;
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
@@ -33,6 +33,26 @@ TEST(ProtocolDataTest, CheckSum) {
   EXPECT_EQ(0xE7, result);
 }
 
+TEST(ProtocolDataTest, RecordReceive) {
+  ProtocolData<ChassisDetail> protocol_data;
+  EXPECT_EQ(0u, protocol_data.GetReceiveStat().count);
+
+  protocol_data.RecordReceive(1000);
+  protocol_data.RecordReceive(11000);
+  ReceiveStat stat = protocol_data.GetReceiveStat();
+  EXPECT_EQ(2u, stat.count);
+  EXPECT_EQ(11000, stat.last_time);
+  EXPECT_EQ(10000, stat.average_period);
+  EXPECT_EQ(10000, stat.max_period);
+
+  // the average moves by a sixteenth of the difference
+  protocol_data.RecordReceive(37000);
+  stat = protocol_data.GetReceiveStat();
+  EXPECT_EQ(3u, stat.count);
+  EXPECT_EQ(11000, stat.average_period);
+  EXPECT_EQ(26000, stat.max_period);
+}
+
 }  // namespace canbus
 }  // namespace drivers
 }  // namespace apollo
@@ -38,10 +38,6 @@ const uint8_t RANG_MASK_0_L[] = {0xFE, 0XFC, 0xF8, 0xF0,
 
 }  // namespace
 
-Byte::Byte(const uint8_t *value) : value_(const_cast<uint8_t *>(value)) {}
-
-Byte::Byte(const Byte &value) : value_(value.value_) {}
-
 std::string Byte::byte_to_hex(const uint8_t value) {
   uint8_t high = value >> 4;
   uint8_t low = value & 0x0F;
@@ -78,13 +74,6 @@ void Byte::set_bit_0(const int32_t pos) {
   *value_ &= BIT_MASK_0[pos];
 }
 
-bool Byte::is_bit_1(const int32_t pos) const {
-  if (pos > BYTE_LENGTH - 1 || pos < 0) {
-    return false;
-  }
-  return (*value_ >> pos) % 2 == 1;
-}
-
 void Byte::set_value(const uint8_t value) {
   if (value_ != nullptr) {
     *value_ = value;
@@ -114,23 +103,10 @@ void Byte::set_value(const uint8_t value, const int32_t start_pos,
   *value_ = current_value_high + middle_value + current_value_low;
 }
 
-uint8_t Byte::get_byte() const { return *value_; }
-
 uint8_t Byte::get_byte_high_4_bits() const { return get_byte(4, 4); }
 
 uint8_t Byte::get_byte_low_4_bits() const { return get_byte(0, 4); }
 
-uint8_t Byte::get_byte(const int32_t start_pos, const int32_t length) const {
-  if (start_pos > BYTE_LENGTH - 1 || start_pos < 0 || length < 1) {
-    return 0x00;
-  }
-  int32_t end_pos = std::min(start_pos + length - 1, BYTE_LENGTH - 1);
-  int32_t real_len = end_pos + 1 - start_pos;
-  uint8_t result = *value_ >> start_pos;
-  result &= RANG_MASK_1_L[real_len - 1];
-  return result;
-}
-
 std::string Byte::to_hex_string() const { return byte_to_hex(*value_); }
 
 std::string Byte::to_binary_string() const { return byte_to_binary(*value_); }
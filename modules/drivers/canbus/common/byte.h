@@ -22,6 +22,7 @@
 #ifndef MODULES_DRIVERS_CANBUS_COMMON_BYTE_H_
 #define MODULES_DRIVERS_CANBUS_COMMON_BYTE_H_
 
+#include <cstdint>
 #include <string>
 
 /**
@@ -43,13 +44,13 @@ class Byte {
    * @brief Constructor which takes a pointer to a one-byte unsigned integer.
    * @param value The pointer to a one-byte unsigned integer for construction.
    */
-  explicit Byte(const uint8_t *value);
+  explicit Byte(const uint8_t *value) : value_(const_cast<uint8_t *>(value)) {}
 
   /**
    * @brief Constructor which takes a reference to a one-byte unsigned integer.
    * @param value The reference to a one-byte unsigned integer for construction.
    */
-  Byte(const Byte &value);
+  Byte(const Byte &value) : value_(value.value_) {}
 
   /**
    * @brief Desctructor.
@@ -97,7 +98,12 @@ class Byte {
    * @param pos The position of the bit to check.
    * @return If the bit on a specified position is one.
    */
-  bool is_bit_1(const int32_t pos) const;
+  bool is_bit_1(const int32_t pos) const {
+    if (pos > 7 || pos < 0) {
+      return false;
+    }
+    return (*value_ >> pos) & 0x01;
+  }
 
   /**
    * @brief Reset this Byte by a specified one-byte unsigned integer.
@@ -136,7 +142,7 @@ class Byte {
    * @brief Get the one-byte unsigned integer.
    * @return The one-byte unsigned integer.
    */
-  uint8_t get_byte() const;
+  uint8_t get_byte() const { return *value_; }
 
   /**
    * @brief Get a one-byte unsigned integer representing the higher 4 bits.
@@ -157,7 +163,29 @@ class Byte {
    * @param length The length of the selected consecutive bits.
    * @return The one-byte unsigned integer representing the selected bits.
    */
-  uint8_t get_byte(const int32_t start_pos, const int32_t length) const;
+  uint8_t get_byte(const int32_t start_pos, const int32_t length) const {
+    if (start_pos > 7 || start_pos < 0 || length < 1) {
+      return 0x00;
+    }
+    const int32_t real_len = length < 8 - start_pos ? length : 8 - start_pos;
+    return (*value_ >> start_pos) & (0xFF >> (8 - real_len));
+  }
+
+  /**
+   * @brief Get the consecutive bits of a byte from a position (from lowest)
+   *        by a length, both known at compile time, so that the shift and
+   *        the mask are constants. The generated protocols decode the
+   *        signals with it.
+   * @param value The byte.
+   * @return The one-byte unsigned integer representing the selected bits.
+   */
+  template <int32_t start_pos, int32_t length>
+  static constexpr uint8_t get_bits(const uint8_t value) {
+    static_assert(start_pos >= 0 && length >= 1 && start_pos + length <= 8,
+                  "The bits must fit in the byte.");
+    return static_cast<uint8_t>((value >> start_pos) &
+                                (0xFF >> (8 - length)));
+  }
 
   /**
    * @brief Transform to its hexadecimal represented by a string.
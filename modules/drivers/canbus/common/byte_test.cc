@@ -84,6 +84,20 @@ TEST(ByteTest, GetValue) {
   EXPECT_EQ(0x1A, value.get_byte(0, 10));
 }
 
+TEST(ByteTest, GetBits) {
+  static_assert(Byte::get_bits<1, 3>(0x1A) == 0x05,
+                "get_bits is evaluated at compile time");
+  for (int i = 0; i < 256; ++i) {
+    const uint8_t byte_value = static_cast<uint8_t>(i);
+    Byte value(&byte_value);
+    EXPECT_EQ(value.get_byte(0, 8), (Byte::get_bits<0, 8>(byte_value)));
+    EXPECT_EQ(value.get_byte(2, 5), (Byte::get_bits<2, 5>(byte_value)));
+    EXPECT_EQ(value.get_byte(4, 4), (Byte::get_bits<4, 4>(byte_value)));
+    EXPECT_EQ(value.get_byte(7, 1), (Byte::get_bits<7, 1>(byte_value)));
+    EXPECT_EQ(value.is_bit_1(3), (Byte::get_bits<3, 1>(byte_value) == 1));
+  }
+}
+
 TEST(ByteTest, SetGetHighLowBit) {
   unsigned char byte_value = 0x37;
   Byte value(&byte_value);
@@ -45,6 +45,8 @@ ContiRadarMessageManager::ContiRadarMessageManager() {
   AddRecvProtocolData<ObjectGeneralInfo60B, true>();
   AddRecvProtocolData<ObjectListStatus60A, true>();
   AddRecvProtocolData<ObjectQualityInfo60C, true>();
+  // the snapshot is updated with the complete cycles only
+  update_snapshot_on_parse_ = false;
 }
 
 void ContiRadarMessageManager::set_radar_conf(RadarConf radar_conf) {
@@ -56,6 +58,29 @@ void ContiRadarMessageManager::set_can_client(
   can_client_ = can_client;
 }
 
+uint64_t ContiRadarMessageManager::num_published_cycles() {
+  std::lock_guard<std::mutex> lock(sensor_data_mutex_);
+  return num_published_cycles_;
+}
+
+uint64_t ContiRadarMessageManager::num_dropped_cycles() {
+  std::lock_guard<std::mutex> lock(sensor_data_mutex_);
+  return num_dropped_cycles_;
+}
+
+int ContiRadarMessageManager::NumCycleMessages() {
+  const RadarConf &conf = radar_config_.radar_conf();
+  // a general info per object or cluster, then the optional ones
+  if (sensor_data_.has_cluster_list_status()) {
+    const int num_clusters = sensor_data_.cluster_list_status().near() +
+                             sensor_data_.cluster_list_status().far();
+    return num_clusters * (conf.send_quality() ? 2 : 1);
+  }
+  const int num_objects = sensor_data_.object_list_status().nof_objects();
+  return num_objects *
+         (1 + (conf.send_quality() ? 1 : 0) + (conf.send_ext_info() ? 1 : 0));
+}
+
 ProtocolData<ContiRadar> *ContiRadarMessageManager::GetMutableProtocolDataById(
     const uint32_t message_id) {
   uint32_t converted_message_id = message_id;
@@ -68,37 +93,56 @@ ProtocolData<ContiRadar> *ContiRadarMessageManager::GetMutableProtocolDataById(
   return protocol_data_map_[converted_message_id];
 }
 
-void ContiRadarMessageManager::Parse(const uint32_t message_id,
-                                     const uint8_t *data, int32_t length) {
+void ContiRadarMessageManager::ParseLocked(const uint32_t message_id,
+                                           const uint8_t *data,
+                                           int32_t length) {
   ProtocolData<ContiRadar> *sensor_protocol_data =
       GetMutableProtocolDataById(message_id);
   if (sensor_protocol_data == nullptr) {
     return;
   }
 
-  std::lock_guard<std::mutex> lock(sensor_data_mutex_);
   if (!is_configured_ && message_id != RadarState201::ID) {
     // read radar state message first
     return;
   }
 
-  // trigger publishment
-  if (message_id == ClusterListStatus600::ID ||
-      message_id == ObjectListStatus60A::ID) {
-    ADEBUG << sensor_data_.ShortDebugString();
-
-    if (sensor_data_.contiobs_size() <=
-        sensor_data_.object_list_status().nof_objects()) {
-      // maybe lost a object_list_status msg
-      AdapterManager::PublishContiRadar(sensor_data_);
+  // a list status message starts a cycle
+  const bool is_list_status = message_id == ClusterListStatus600::ID ||
+                              message_id == ObjectListStatus60A::ID;
+  if (is_list_status) {
+    if (is_cycle_started_ && !is_cycle_published_) {
+      ++num_dropped_cycles_;
+      AWARN << "Dropped a radar cycle with " << num_cycle_messages_ << " of "
+            << num_expected_messages_ << " messages, "
+            << num_dropped_cycles_ << " dropped in total.";
     }
+    // the cleared obstacles are reused by the next cycle
     sensor_data_.Clear();
     // fill header when recieve the general info message
     AdapterManager::FillContiRadarHeader(FLAGS_sensor_node_name, &sensor_data_);
+    is_cycle_started_ = true;
+    is_cycle_published_ = false;
+    num_cycle_messages_ = 0;
   }
 
   sensor_protocol_data->Parse(data, length, &sensor_data_);
 
+  if (is_cycle_started_ && !is_cycle_published_) {
+    if (is_list_status) {
+      num_expected_messages_ = NumCycleMessages();
+    } else if (message_id != RadarState201::ID) {
+      ++num_cycle_messages_;
+    }
+    if (num_cycle_messages_ >= num_expected_messages_) {
+      ADEBUG << sensor_data_.ShortDebugString();
+      AdapterManager::PublishContiRadar(sensor_data_);
+      UpdateSnapshot();
+      is_cycle_published_ = true;
+      ++num_published_cycles_;
+    }
+  }
+
   if (message_id == RadarState201::ID) {
     ADEBUG << sensor_data_.ShortDebugString();
     if (sensor_data_.radar_state().send_quality() ==
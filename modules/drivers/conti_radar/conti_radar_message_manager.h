@@ -21,6 +21,7 @@
 #ifndef MODULES_DRIVERS_CONTI_RADAR_CONTI_RADAR_MESSAGE_MANAGER_H_
 #define MODULES_DRIVERS_CONTI_RADAR_CONTI_RADAR_MESSAGE_MANAGER_H_
 
+#include <cstdint>
 #include <memory>
 #include "modules/drivers/canbus/can_client/can_client_factory.h"
 #include "modules/drivers/canbus/can_comm/can_sender.h"
@@ -52,11 +53,39 @@ class ContiRadarMessageManager : public MessageManager<ContiRadar> {
   void set_radar_conf(RadarConf radar_conf);
   ProtocolData<ContiRadar> *GetMutableProtocolDataById(
       const uint32_t message_id);
-  void Parse(const uint32_t message_id, const uint8_t *data, int32_t length);
   void set_can_client(std::shared_ptr<CanClient> can_client);
 
+  /**
+   * @brief the number of radar cycles published
+   */
+  uint64_t num_published_cycles();
+
+  /**
+   * @brief the number of radar cycles dropped for a missing message
+   */
+  uint64_t num_dropped_cycles();
+
+ protected:
+  /**
+   * @brief assemble the messages of a radar cycle, from its list status to
+   * its last object message, and publish it as soon as it is complete. A
+   * cycle still incomplete when the next one starts is dropped.
+   */
+  void ParseLocked(const uint32_t message_id, const uint8_t *data,
+                   int32_t length) override;
+
  private:
+  // the number of messages of a cycle, once its list status is parsed
+  int NumCycleMessages();
+
   bool is_configured_ = false;
+  // the state of the cycle being received, guarded by sensor_data_mutex_
+  bool is_cycle_started_ = false;
+  bool is_cycle_published_ = false;
+  int num_cycle_messages_ = 0;
+  int num_expected_messages_ = 0;
+  uint64_t num_published_cycles_ = 0;
+  uint64_t num_dropped_cycles_ = 0;
   RadarConfig200 radar_config_;
   std::shared_ptr<CanClient> can_client_;
 };
@@ -18,7 +18,9 @@
 // messages must be
 // logged in order for this parser to work properly.
 //
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -109,9 +111,14 @@ class NovatelParser : public Parser {
   virtual MessageType get_message(MessagePtr& message_ptr);
 
  private:
-  bool check_crc();
+  // Returns the total length of the record starting at record, 0 if the sync
+  // bytes are wrong, or the max of size_t if the header is incomplete.
+  static size_t record_length(const uint8_t* record, size_t length);
 
-  Parser::MessageType prepare_message(MessagePtr& message_ptr);
+  bool check_crc(const uint8_t* record, size_t length);
+
+  Parser::MessageType prepare_message(const uint8_t* record, size_t length,
+                                      MessagePtr& message_ptr);
 
   // The handle_xxx functions return whether a message is ready.
   bool handle_best_pos(const novatel::BestPos* pos, uint16_t gps_week,
@@ -159,10 +166,10 @@ class NovatelParser : public Parser {
 
   double _imu_measurement_time_previous = -1.0;
 
+  // Holds a record split across updates.
   std::vector<uint8_t> _buffer;
 
-  size_t _header_length = 0;
-
+  // Total length of the record in _buffer, 0 while its header is incomplete.
   size_t _total_length = 0;
 
   // -1 is an unused value.
@@ -204,55 +211,61 @@ Parser::MessageType NovatelParser::get_message(MessagePtr& message_ptr) {
   }
 
   while (_data < _data_end) {
-    if (_buffer.size() == 0) {  // Looking for SYNC0
-      if (*_data == novatel::SYNC_0) {
-        _buffer.push_back(*_data);
+    if (_buffer.empty()) {
+      // Records lying in the data are decoded in place. Only a record split
+      // across two updates is copied into _buffer.
+      const uint8_t* sync = static_cast<const uint8_t*>(
+          memchr(_data, novatel::SYNC_0, _data_end - _data));
+      if (sync == nullptr) {
+        _data = _data_end;
+        break;
       }
-      ++_data;
-    } else if (_buffer.size() == 1) {  // Looking for SYNC1
-      if (*_data == novatel::SYNC_1) {
-        _buffer.push_back(*_data++);
-      } else {
-        _buffer.clear();
+      _data = sync;
+      const size_t total_length = record_length(_data, _data_end - _data);
+      if (total_length == 0) {  // Wrong sync bytes.
+        ++_data;
+        continue;
       }
-    } else if (_buffer.size() == 2) {  // Looking for SYNC2
-      switch (*_data) {
-        case novatel::SYNC_2_LONG_HEADER:
-          _buffer.push_back(*_data++);
-          _header_length = sizeof(novatel::LongHeader);
-          break;
-        case novatel::SYNC_2_SHORT_HEADER:
-          _buffer.push_back(*_data++);
-          _header_length = sizeof(novatel::ShortHeader);
-          break;
-        default:
-          _buffer.clear();
+      if (total_length == std::numeric_limits<size_t>::max() ||
+          total_length > static_cast<size_t>(_data_end - _data)) {
+        // Incomplete record, keep the bytes up to the end of the data.
+        if (total_length != std::numeric_limits<size_t>::max()) {
+          _total_length = total_length;
+        }
+        _buffer.assign(_data, _data_end);
+        _data = _data_end;
+        break;
+      }
+      const uint8_t* record = _data;
+      _data += total_length;
+      MessageType type = prepare_message(record, total_length, message_ptr);
+      if (type != MessageType::NONE) {
+        return type;
       }
-    } else if (_header_length > 0) {  // Working on header.
-      if (_buffer.size() < _header_length) {
+    } else {
+      if (_total_length == 0) {  // Working on header.
         _buffer.push_back(*_data++);
-      } else {
-        if (_header_length == sizeof(novatel::LongHeader)) {
-          _total_length = _header_length + novatel::CRC_LENGTH +
-                          reinterpret_cast<novatel::LongHeader*>(_buffer.data())
-                              ->message_length;
-        } else if (_header_length == sizeof(novatel::ShortHeader)) {
-          _total_length =
-              _header_length + novatel::CRC_LENGTH +
-              reinterpret_cast<novatel::ShortHeader*>(_buffer.data())
-                  ->message_length;
-        } else {
-          ROS_ERROR("Incorrect _header_length. Should never reach here.");
+        const size_t total_length =
+            record_length(_buffer.data(), _buffer.size());
+        if (total_length == 0) {
+          // Wrong sync bytes, the last byte may start another record.
+          --_data;
           _buffer.clear();
+        } else if (total_length != std::numeric_limits<size_t>::max()) {
+          _total_length = total_length;
         }
-        _header_length = 0;
-      }
-    } else if (_total_length > 0) {
-      if (_buffer.size() < _total_length) {  // Working on body.
-        _buffer.push_back(*_data++);
         continue;
       }
-      MessageType type = prepare_message(message_ptr);
+      // Working on body.
+      const size_t needed = std::min(static_cast<size_t>(_data_end - _data),
+                                     _total_length - _buffer.size());
+      _buffer.insert(_buffer.end(), _data, _data + needed);
+      _data += needed;
+      if (_buffer.size() < _total_length) {
+        break;
+      }
+      MessageType type =
+          prepare_message(_buffer.data(), _buffer.size(), message_ptr);
       _buffer.clear();
       _total_length = 0;
       if (type != MessageType::NONE) {
@@ -263,33 +276,68 @@ Parser::MessageType NovatelParser::get_message(MessagePtr& message_ptr) {
   return MessageType::NONE;
 }
 
-bool NovatelParser::check_crc() {
-  size_t l = _buffer.size() - novatel::CRC_LENGTH;
-  return crc32_block(_buffer.data(), l) ==
-         *reinterpret_cast<uint32_t*>(_buffer.data() + l);
+size_t NovatelParser::record_length(const uint8_t* record, size_t length) {
+  if (length < 1 || record[0] != novatel::SYNC_0) {
+    return 0;
+  }
+  if (length < 2) {
+    return std::numeric_limits<size_t>::max();
+  }
+  if (record[1] != novatel::SYNC_1) {
+    return 0;
+  }
+  if (length < 3) {
+    return std::numeric_limits<size_t>::max();
+  }
+  if (record[2] == novatel::SYNC_2_LONG_HEADER) {
+    if (length < sizeof(novatel::LongHeader)) {
+      return std::numeric_limits<size_t>::max();
+    }
+    return sizeof(novatel::LongHeader) + novatel::CRC_LENGTH +
+           reinterpret_cast<const novatel::LongHeader*>(record)
+               ->message_length;
+  }
+  if (record[2] == novatel::SYNC_2_SHORT_HEADER) {
+    if (length < sizeof(novatel::ShortHeader)) {
+      return std::numeric_limits<size_t>::max();
+    }
+    return sizeof(novatel::ShortHeader) + novatel::CRC_LENGTH +
+           reinterpret_cast<const novatel::ShortHeader*>(record)
+               ->message_length;
+  }
+  return 0;
+}
+
+bool NovatelParser::check_crc(const uint8_t* record, size_t length) {
+  size_t l = length - novatel::CRC_LENGTH;
+  uint32_t crc = 0;
+  memcpy(&crc, record + l, sizeof(crc));
+  return crc32_block(record, l) == crc;
 }
 
-Parser::MessageType NovatelParser::prepare_message(MessagePtr& message_ptr) {
-  if (!check_crc()) {
+Parser::MessageType NovatelParser::prepare_message(const uint8_t* record,
+                                                   size_t length,
+                                                   MessagePtr& message_ptr) {
+  if (!check_crc(record, length)) {
     ROS_ERROR("CRC check failed.");
     return MessageType::NONE;
   }
 
-  uint8_t* message = nullptr;
+  const uint8_t* message = nullptr;
   novatel::MessageId message_id;
   uint16_t message_length;
   uint16_t gps_week;
   uint32_t gps_millisecs;
-  if (_buffer[2] == novatel::SYNC_2_LONG_HEADER) {
-    auto header = reinterpret_cast<const novatel::LongHeader*>(_buffer.data());
-    message = _buffer.data() + sizeof(novatel::LongHeader);
+  if (record[2] == novatel::SYNC_2_LONG_HEADER) {
+    auto header = reinterpret_cast<const novatel::LongHeader*>(record);
+    message = record + sizeof(novatel::LongHeader);
     gps_week = header->gps_week;
     gps_millisecs = header->gps_millisecs;
     message_id = header->message_id;
     message_length = header->message_length;
   } else {
-    auto header = reinterpret_cast<const novatel::ShortHeader*>(_buffer.data());
-    message = _buffer.data() + sizeof(novatel::ShortHeader);
+    auto header = reinterpret_cast<const novatel::ShortHeader*>(record);
+    message = record + sizeof(novatel::ShortHeader);
     gps_week = header->gps_week;
     gps_millisecs = header->gps_millisecs;
     message_id = header->message_id;
@@ -301,8 +349,9 @@ Parser::MessageType NovatelParser::prepare_message(MessagePtr& message_ptr) {
         ROS_ERROR("Incorrect message_length");
         break;
       }
-      if (handle_gnss_bestpos(reinterpret_cast<novatel::BestPos*>(message),
-                              gps_week, gps_millisecs)) {
+      if (handle_gnss_bestpos(
+              reinterpret_cast<const novatel::BestPos*>(message), gps_week,
+              gps_millisecs)) {
         message_ptr = &_bestpos;
         return MessageType::BEST_GNSS_POS;
       }
@@ -316,7 +365,7 @@ Parser::MessageType NovatelParser::prepare_message(MessagePtr& message_ptr) {
         ROS_ERROR("Incorrect message_length");
         break;
       }
-      if (handle_best_pos(reinterpret_cast<novatel::BestPos*>(message),
+      if (handle_best_pos(reinterpret_cast<const novatel::BestPos*>(message),
                           gps_week, gps_millisecs)) {
         message_ptr = &_gnss;
         return MessageType::GNSS;
@@ -332,7 +381,7 @@ Parser::MessageType NovatelParser::prepare_message(MessagePtr& message_ptr) {
         ROS_ERROR("Incorrect message_length");
         break;
       }
-      if (handle_best_vel(reinterpret_cast<novatel::BestVel*>(message),
+      if (handle_best_vel(reinterpret_cast<const novatel::BestVel*>(message),
                           gps_week, gps_millisecs)) {
         message_ptr = &_gnss;
         return MessageType::GNSS;
@@ -349,7 +398,7 @@ Parser::MessageType NovatelParser::prepare_message(MessagePtr& message_ptr) {
       }
 
       if (handle_corr_imu_data(
-              reinterpret_cast<novatel::CorrImuData*>(message))) {
+              reinterpret_cast<const novatel::CorrImuData*>(message))) {
         message_ptr = &_ins;
         return MessageType::INS;
       }
@@ -364,7 +413,7 @@ Parser::MessageType NovatelParser::prepare_message(MessagePtr& message_ptr) {
         break;
       }
 
-      if (handle_ins_cov(reinterpret_cast<novatel::InsCov*>(message))) {
+      if (handle_ins_cov(reinterpret_cast<const novatel::InsCov*>(message))) {
         message_ptr = &_ins;
         return MessageType::INS;
       }
@@ -379,7 +428,7 @@ Parser::MessageType NovatelParser::prepare_message(MessagePtr& message_ptr) {
         break;
       }
 
-      if (handle_ins_pva(reinterpret_cast<novatel::InsPva*>(message))) {
+      if (handle_ins_pva(reinterpret_cast<const novatel::InsPva*>(message))) {
         message_ptr = &_ins;
         return MessageType::INS;
       }
@@ -394,7 +443,8 @@ Parser::MessageType NovatelParser::prepare_message(MessagePtr& message_ptr) {
         break;
       }
 
-      if (handle_raw_imu_x(reinterpret_cast<novatel::RawImuX*>(message))) {
+      if (handle_raw_imu_x(
+              reinterpret_cast<const novatel::RawImuX*>(message))) {
         message_ptr = &_imu;
         return MessageType::IMU;
       }
@@ -407,7 +457,7 @@ Parser::MessageType NovatelParser::prepare_message(MessagePtr& message_ptr) {
         break;
       }
 
-      if (handle_raw_imu(reinterpret_cast<novatel::RawImu*>(message))) {
+      if (handle_raw_imu(reinterpret_cast<const novatel::RawImu*>(message))) {
         message_ptr = &_imu;
         return MessageType::IMU;
       }
@@ -419,7 +469,7 @@ Parser::MessageType NovatelParser::prepare_message(MessagePtr& message_ptr) {
         break;
       }
 
-      if (handle_ins_pvax(reinterpret_cast<novatel::InsPvaX*>(message),
+      if (handle_ins_pvax(reinterpret_cast<const novatel::InsPvaX*>(message),
                           gps_week, gps_millisecs)) {
         message_ptr = &_ins_stat;
         return MessageType::INS_STAT;
@@ -431,7 +481,8 @@ Parser::MessageType NovatelParser::prepare_message(MessagePtr& message_ptr) {
         ROS_ERROR("Incorrect BDSEPHEMERIS message_length");
         break;
       }
-      if (handle_bds_eph(reinterpret_cast<novatel::BDS_Ephemeris*>(message))) {
+      if (handle_bds_eph(
+              reinterpret_cast<const novatel::BDS_Ephemeris*>(message))) {
         message_ptr = &_gnss_ephemeris;
         return MessageType::BDSEPHEMERIDES;
       }
@@ -442,7 +493,8 @@ Parser::MessageType NovatelParser::prepare_message(MessagePtr& message_ptr) {
         ROS_ERROR("Incorrect GPSEPHEMERIS message_length");
         break;
       }
-      if (handle_gps_eph(reinterpret_cast<novatel::GPS_Ephemeris*>(message))) {
+      if (handle_gps_eph(
+              reinterpret_cast<const novatel::GPS_Ephemeris*>(message))) {
         message_ptr = &_gnss_ephemeris;
         return MessageType::GPSEPHEMERIDES;
       }
@@ -453,15 +505,15 @@ Parser::MessageType NovatelParser::prepare_message(MessagePtr& message_ptr) {
         ROS_ERROR("Incorrect GLOEPHEMERIS message length");
         break;
       }
-      if (handle_glo_eph(reinterpret_cast<novatel::GLO_Ephemeris*>(message))) {
+      if (handle_glo_eph(
+              reinterpret_cast<const novatel::GLO_Ephemeris*>(message))) {
         message_ptr = &_gnss_ephemeris;
         return MessageType::GLOEPHEMERIDES;
       }
       break;
 
     case novatel::RANGE:
-      if (decode_gnss_observation(_buffer.data(),
-                                  _buffer.data() + _buffer.size())) {
+      if (decode_gnss_observation(record, record + length)) {
         message_ptr = &_gnss_observation;
         return MessageType::OBSERVATION;
       }
@@ -118,9 +118,10 @@ private:
     };
 
     int init_mjpeg_decoder(int image_width, int image_height);
-    void mjpeg2rgb(char *MJPEG, int len, char *RGB, int NumPixels);
-    bool process_image(const void * src, int len, boost::shared_ptr<CameraImage> dest);
-    int read_frame();
+    bool mjpeg2rgb(char *MJPEG, int len, char *RGB, int NumPixels);
+    // processes a captured frame right into the message
+    bool process_image(const void * src, int len, sensor_msgs::Image* msg);
+    int read_frame(sensor_msgs::Image* msg);
     void uninit_device(void);
     void init_read(unsigned int buffer_size);
     void init_mmap(void);
@@ -130,7 +131,8 @@ private:
     void open_device(void);
     // TODO
     //void reset_device(void);
-    bool grab_image(int timeout);
+    // waits for a frame to be captured
+    bool wait_for_image(int timeout);
 
     bool is_capturing_;
     std::string camera_dev_;
@@ -312,11 +312,9 @@ int UsbCam::init_mjpeg_decoder(int image_width, int image_height) {
   return 1;
 }
 
-void UsbCam::mjpeg2rgb(char *MJPEG, int len, char *RGB, int NumPixels) {
+bool UsbCam::mjpeg2rgb(char *MJPEG, int len, char *RGB, int NumPixels) {
   int got_picture;
 
-  memset(RGB, 0, avframe_rgb_size_);
-
 #if LIBAVCODEC_VERSION_MAJOR > 52
   int decoded_len;
   AVPacket avpkt;
@@ -329,7 +327,7 @@ void UsbCam::mjpeg2rgb(char *MJPEG, int len, char *RGB, int NumPixels) {
 
   if (decoded_len < 0) {
     ROS_ERROR("Error while decoding frame.");
-    return;
+    return false;
   }
 #else
   avcodec_decode_video(avcodec_context_, avframe_camera_, &got_picture,
@@ -338,7 +336,7 @@ void UsbCam::mjpeg2rgb(char *MJPEG, int len, char *RGB, int NumPixels) {
 
   if (!got_picture) {
     ROS_ERROR("Webcam: expected picture but didn't get it...");
-    return;
+    return false;
   }
 
   int xsize = avcodec_context_->width;
@@ -347,33 +345,57 @@ void UsbCam::mjpeg2rgb(char *MJPEG, int len, char *RGB, int NumPixels) {
   if (pic_size != avframe_camera_size_) {
     ROS_ERROR("outbuf size mismatch.  pic_size: %d bufsize: %d", pic_size,
               avframe_camera_size_);
-    return;
+    return false;
   }
 
-  video_sws_ =
-      sws_getContext(xsize, ysize, avcodec_context_->pix_fmt, xsize, ysize,
-                     PIX_FMT_RGB24, SWS_BILINEAR, NULL, NULL, NULL);
-  sws_scale(video_sws_, avframe_camera_->data, avframe_camera_->linesize, 0,
-            ysize, avframe_rgb_->data, avframe_rgb_->linesize);
-  sws_freeContext(video_sws_);
-
-  int size = avpicture_layout((AVPicture *)avframe_rgb_, PIX_FMT_RGB24, xsize,
-                              ysize, (uint8_t *)RGB, avframe_rgb_size_);
-  if (size != avframe_rgb_size_) {
-    ROS_ERROR("webcam: avpicture_layout error: %d", size);
-    return;
+  // the scaler is kept across the frames, and converts the decoded picture
+  // right into the output buffer
+  video_sws_ = sws_getCachedContext(video_sws_, xsize, ysize,
+                                    avcodec_context_->pix_fmt, xsize, ysize,
+                                    PIX_FMT_RGB24, SWS_BILINEAR, NULL, NULL,
+                                    NULL);
+  if (!video_sws_) {
+    ROS_ERROR("webcam: cannot create the rgb24 scaler");
+    return false;
   }
+  uint8_t *rgb_data[4] = {(uint8_t *)RGB, NULL, NULL, NULL};
+  int rgb_linesize[4] = {3 * xsize, 0, 0, 0};
+  sws_scale(video_sws_, avframe_camera_->data, avframe_camera_->linesize, 0,
+            ysize, rgb_data, rgb_linesize);
+  return true;
 }
 
 bool UsbCam::process_image(const void *src, int len,
-                           boost::shared_ptr<CameraImage> dest) {
-  if (src == NULL || dest == NULL) {
+                           sensor_msgs::Image *msg) {
+  if (src == NULL || msg == NULL) {
     ROS_ERROR("process image error. len: %d, width: %d, height: %d", len,
-              dest->width, dest->height);
+              image_->width, image_->height);
     return false;
   }
-  if (pixelformat_ == V4L2_PIX_FMT_YUYV || pixelformat_ == V4L2_PIX_FMT_UYVY) {
-    memcpy(dest->image, src, dest->width * dest->height * 2);
+  // the frame is written once, from the capture buffer to the message,
+  // whose data keeps its storage across the frames
+  const int width = image_->width;
+  const int height = image_->height;
+  msg->height = height;
+  msg->width = width;
+  msg->is_bigendian = 0;
+  if (monochrome_) {
+    // the luminance bytes of the first half, as before
+    msg->encoding = "mono8";
+    msg->step = width;
+    msg->data.resize(width * height);
+    memcpy(&msg->data[0], src, width * height);
+  } else if (pixelformat_ == V4L2_PIX_FMT_YUYV ||
+             pixelformat_ == V4L2_PIX_FMT_UYVY) {
+    msg->encoding = "yuyv";
+    msg->step = 2 * width;
+    msg->data.resize(width * height * 2);
+    memcpy(&msg->data[0], src, width * height * 2);
+  } else if (pixelformat_ == V4L2_PIX_FMT_MJPEG) {
+    msg->encoding = "rgb8";
+    msg->step = 3 * width;
+    msg->data.resize(width * height * 3);
+    return mjpeg2rgb((char *)src, len, (char *)&msg->data[0], width * height);
   } else {
     ROS_ERROR("unsupported pixel format: %d", pixelformat_);
     return false;
@@ -381,7 +403,7 @@ bool UsbCam::process_image(const void *src, int len,
   return true;
 }
 
-int UsbCam::read_frame() {
+int UsbCam::read_frame(sensor_msgs::Image *msg) {
   struct v4l2_buffer buf;
   unsigned int i;
   int len;
@@ -405,7 +427,7 @@ int UsbCam::read_frame() {
         }
       }
 
-      result = process_image(buffers_[0].start, len, image_);
+      result = process_image(buffers_[0].start, len, msg);
       if (!result) {
         return 0;
       }
@@ -439,13 +461,14 @@ int UsbCam::read_frame() {
       image_->tv_usec = buf.timestamp.tv_usec;
       ROS_DEBUG("new image timestamp: %d.%d", image_->tv_sec, image_->tv_usec);
 
-      result = process_image(buffers_[buf.index].start, len, image_);
+      result = process_image(buffers_[buf.index].start, len, msg);
+
+      // the buffer is queued back even if the frame is not processed
+      if (-1 == xioctl(fd_, VIDIOC_QBUF, &buf)) errno_exit("VIDIOC_QBUF");
       if (!result) {
         return 0;
       }
 
-      if (-1 == xioctl(fd_, VIDIOC_QBUF, &buf)) errno_exit("VIDIOC_QBUF");
-
       break;
 
     case IO_METHOD_USERPTR:
@@ -476,13 +499,14 @@ int UsbCam::read_frame() {
 
       assert(i < n_buffers_);
       len = buf.bytesused;
-      result = process_image((void *)buf.m.userptr, len, image_);
+      result = process_image((void *)buf.m.userptr, len, msg);
+
+      // the buffer is queued back even if the frame is not processed
+      if (-1 == xioctl(fd_, VIDIOC_QBUF, &buf)) errno_exit("VIDIOC_QBUF");
       if (!result) {
         return 0;
       }
 
-      if (-1 == xioctl(fd_, VIDIOC_QBUF, &buf)) errno_exit("VIDIOC_QBUF");
-
       break;
   }
 
@@ -891,11 +915,8 @@ void UsbCam::start(const std::string &dev, io_method io_method,
 
   image_->image_size = image_->width * image_->height * image_->bytes_per_pixel;
   image_->is_new = 0;
-  image_->image = new char[image_->image_size]();
-  if (!image_->image) {
-    ROS_ERROR("Outof memory!");
-    exit(EXIT_FAILURE);
-  }
+  // the frames are processed right into the published messages
+  image_->image = NULL;
 }
 
 void UsbCam::shutdown(void) {
@@ -912,37 +933,30 @@ void UsbCam::shutdown(void) {
   avframe_camera_ = NULL;
   if (avframe_rgb_) av_free(avframe_rgb_);
   avframe_rgb_ = NULL;
+  if (video_sws_) sws_freeContext(video_sws_);
+  video_sws_ = NULL;
 }
 
 bool UsbCam::grab_image(sensor_msgs::Image *msg, int timeout) {
-  // grab the image
-  bool get_new_image = grab_image(timeout);
+  // wait for the image
+  bool has_new_image = wait_for_image(timeout);
+  if (!has_new_image) {
+    return false;
+  }
+  // process it into the message
+  int get_new_image = read_frame(msg);
   if (!get_new_image) {
+    ROS_ERROR("read frame error.");
     return false;
   }
+  image_->is_new = 1;
   // stamp the image
   msg->header.stamp.sec = image_->tv_sec;
   msg->header.stamp.nsec = 1000 * image_->tv_usec;
-  // fill the info
-  if (monochrome_) {
-    fillImage(*msg, "mono8", image_->height, image_->width, image_->width,
-              image_->image);
-  } else {
-    // fillImage(*msg, "rgb8", image_->height, image_->width, 3 * image_->width,
-    //           image_->image);
-    msg->encoding = "yuyv";
-    msg->height = image_->height;
-    msg->width = image_->width;
-    msg->step = 2 * image_->width;
-    size_t len = image_->width * image_->height * 2;
-    msg->data.resize(len);
-    memcpy(&msg->data[0], image_->image, len);
-    msg->is_bigendian = 0;
-  }
   return true;
 }
 
-bool UsbCam::grab_image(int timeout) {
+bool UsbCam::wait_for_image(int timeout) {
   fd_set fds;
   struct timeval tv;
   int r = 0;
@@ -972,13 +986,6 @@ bool UsbCam::grab_image(int timeout) {
     exit(EXIT_FAILURE);
   }
 
-  int get_new_image = read_frame();
-  if (!get_new_image) {
-    ROS_ERROR("read frame error.");
-    return false;
-  }
-
-  image_->is_new = 1;
   return true;
 }
 
@@ -33,9 +33,21 @@ namespace velodyne {
 
 class Compensator {
  public:
-  Compensator(ros::NodeHandle node, ros::NodeHandle private_nh);
+  /**
+  * @brief advertise the compensated point cloud. The point cloud topic is
+  *   only subscribed when subscribe_pointcloud is true, otherwise the
+  *   clouds are handed over by compensate_in_place().
+  */
+  Compensator(ros::NodeHandle node, ros::NodeHandle private_nh,
+              bool subscribe_pointcloud = true);
   virtual ~Compensator() {}
 
+  /**
+  * @brief compensate a pointcloud2 msg owned by the caller in place and
+  *   publish it, without the copy made for a subscribed msg
+  */
+  void compensate_in_place(const sensor_msgs::PointCloud2::Ptr& msg);
+
  private:
   /**
   * @brief get pointcloud2 msg, compensate it,publish pointcloud2 after
@@ -43,6 +55,12 @@ class Compensator {
   */
   void pointcloud_callback(const sensor_msgs::PointCloud2ConstPtr& msg);
   /**
+  * @brief compensate msg into q_msg and publish q_msg, q_msg is a copy of
+  *   msg when it is null
+  */
+  void compensate(const sensor_msgs::PointCloud2ConstPtr& msg,
+                  sensor_msgs::PointCloud2::Ptr q_msg);
+  /**
   * @brief get pose affine from tf2 by gps timestamp
   *   novatel-preprocess broadcast the tf2 transfrom.
   */
@@ -54,7 +72,8 @@ class Compensator {
   */
   bool check_message(const sensor_msgs::PointCloud2ConstPtr& msg);
   /**
-  * @brief motion compensation for point cloud
+  * @brief motion compensation for point cloud, applying a transform per
+  *   time bucket when the rotation is significant
   */
   template <typename Scalar>
   void motion_compensation(sensor_msgs::PointCloud2::Ptr& msg,
@@ -85,6 +104,10 @@ class Compensator {
   // transform child frame id(world -> child frame)
   std::string child_frame_id_;
   float tf_timeout_;
+  // number of time buckets a scan is interpolated in
+  int compensation_buckets_;
+  // number of openmp threads compensating a scan
+  int compensation_threads_;
 
   // varibes for point fields value, we get point x,y,z by these offset
   int x_offset_;
@@ -23,6 +23,9 @@
 #include <sensor_msgs/PointCloud2.h>
 #include <std_msgs/Time.h>
 
+#include <memory>
+
+#include "velodyne_pointcloud/compensator.h"
 #include "velodyne_pointcloud/velodyne_parser.h"
 
 namespace apollo {
@@ -45,6 +48,9 @@ class Convert {
 
   // RawData class for converting data to point cloud
   VelodyneParser* parser_;
+  // compensates the converted cloud in this nodelet when motion_compensation
+  // is set, so the cloud is not handed to a compensator nodelet over a topic
+  std::unique_ptr<Compensator> compensator_;
 
   ros::Subscriber velodyne_scan_;
   ros::Publisher pointcloud_pub_;
@@ -134,6 +134,41 @@ union RawDistance {
   uint8_t bytes[2];
 };
 
+static const int MAX_LASER_NUM = 64;
+
+/** \brief Laser corrections in arrays indexed by the laser number.
+*
+*  The firings of a block are computed in loops over these arrays, which the
+*  compiler vectorizes, instead of looking up the std::map of the calibration
+*  for every point. The types are the ones of LaserCorrection, so the coords
+*  are the same as computed from it.
+*/
+struct LaserCorrectionTable {
+  float dist_correction[MAX_LASER_NUM];
+  float dist_correction_x[MAX_LASER_NUM];
+  float dist_correction_y[MAX_LASER_NUM];
+  float vert_offset_correction[MAX_LASER_NUM];
+  float horiz_offset_correction[MAX_LASER_NUM];
+  float cos_rot_correction[MAX_LASER_NUM];
+  float sin_rot_correction[MAX_LASER_NUM];
+  float cos_vert_correction[MAX_LASER_NUM];
+  float sin_vert_correction[MAX_LASER_NUM];
+  float focal_slope[MAX_LASER_NUM];
+  float focal_offset[MAX_LASER_NUM];
+  int max_intensity[MAX_LASER_NUM];
+  int min_intensity[MAX_LASER_NUM];
+};
+
+/** \brief The coords of the firings of a block, and the mask of the firings
+*  in the range */
+struct BlockCoords {
+  float x[SCANS_PER_BLOCK];
+  float y[SCANS_PER_BLOCK];
+  float z[SCANS_PER_BLOCK];
+  uint16_t raw_distance[SCANS_PER_BLOCK];
+  bool valid[SCANS_PER_BLOCK];
+};
+
 static const int PACKET_SIZE = 1206;
 static const int BLOCKS_PER_PACKET = 12;
 static const int PACKET_STATUS_SIZE = 4;
@@ -222,6 +257,7 @@ class VelodyneParser {
   const float (*inner_time_)[12][32];
 
   Calibration calibration_;
+  LaserCorrectionTable laser_table_;
   float sin_rot_table_[ROTATION_MAX_UNITS];
   float cos_rot_table_[ROTATION_MAX_UNITS];
   Config config_;
@@ -233,16 +269,21 @@ class VelodyneParser {
   VPoint get_nan_point(double timestamp);
   void init_angle_params(double view_direction, double view_width);
   /**
-   * \brief Compute coords with the data in block
+   * \brief Copy the calibration to laser_table_, after it is read
+   */
+  void init_laser_correction_table();
+  /**
+   * \brief Compute the coords of consecutive firings of a block at once
    *
-   * @param tmp A two bytes union store the value of laser distance infomation
-   * @param index The index of block
+   * @param data The raw data of the first firing, 3 bytes per firing
+   * @param rotations The rotation of each firing
+   * @param first_laser The laser number of the first firing, the next
+   *        firings are of the next lasers
+   * @param num The number of firings, at most SCANS_PER_BLOCK
+   * @param coords The coords, and whether each firing is in the range
    */
-  void compute_coords(const union RawDistance &raw_distance,
-                      const LaserCorrection &corrections,
-                      const uint16_t &rotation, VPoint &point);
-
-  bool is_scan_valid(int rotation, float distance);
+  void compute_block_coords(const uint8_t *data, const uint16_t *rotations,
+                            int first_laser, int num, BlockCoords *coords);
 
   /**
    * \brief Unpack velodyne packet
@@ -277,8 +318,8 @@ class Velodyne64Parser : public VelodyneParser {
                        uint16_t laser_block_id);
   void unpack(const velodyne_msgs::VelodynePacket &pkt, VPointCloud &pc);
   void init_offsets();
-  int intensity_compensate(const LaserCorrection &corrections,
-                           const uint16_t &raw_distance, int intensity);
+  int intensity_compensate(int laser_number, const uint16_t &raw_distance,
+                           int intensity);
   // Previous Velodyne packet time stamp. (offset to the top hour)
   double previous_packet_stamp_[4];
   uint64_t gps_base_usec_[4];  // full time
@@ -17,11 +17,15 @@
 #include "velodyne_pointcloud/compensator.h"
 #include "ros/this_node.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace apollo {
 namespace drivers {
 namespace velodyne {
 
-Compensator::Compensator(ros::NodeHandle node, ros::NodeHandle private_nh)
+Compensator::Compensator(ros::NodeHandle node, ros::NodeHandle private_nh,
+                         bool subscribe_pointcloud)
     : tf2_transform_listener_(tf2_buffer_, node),
       x_offset_(-1),
       y_offset_(-1),
@@ -35,17 +39,32 @@ Compensator::Compensator(ros::NodeHandle node, ros::NodeHandle private_nh)
   private_nh.param("topic_pointcloud", topic_pointcloud_, TOPIC_POINTCLOUD);
   private_nh.param("queue_size", queue_size_, 10);
   private_nh.param("tf_query_timeout", tf_timeout_, float(0.1));
+  private_nh.param("compensation_buckets", compensation_buckets_, 2000);
+  private_nh.param("compensation_threads", compensation_threads_, 1);
 
   // advertise output point cloud (before subscribing to input data)
   compensation_pub_ = node.advertise<sensor_msgs::PointCloud2>(
       topic_compensated_pointcloud_, queue_size_);
-  pointcloud_sub_ =
-      node.subscribe(topic_pointcloud_, queue_size_,
-                     &Compensator::pointcloud_callback, (Compensator*)this);
+  if (subscribe_pointcloud) {
+    pointcloud_sub_ =
+        node.subscribe(topic_pointcloud_, queue_size_,
+                       &Compensator::pointcloud_callback, (Compensator*)this);
+  }
 }
 
 void Compensator::pointcloud_callback(
     const sensor_msgs::PointCloud2ConstPtr& msg) {
+  // the msg may be shared by other subscribers, so it is copied
+  compensate(msg, sensor_msgs::PointCloud2::Ptr());
+}
+
+void Compensator::compensate_in_place(
+    const sensor_msgs::PointCloud2::Ptr& msg) {
+  compensate(msg, msg);
+}
+
+void Compensator::compensate(const sensor_msgs::PointCloud2ConstPtr& msg,
+                             sensor_msgs::PointCloud2::Ptr q_msg) {
   if (!check_message(msg)) {
     ROS_FATAL("MotionCompensation : Input point cloud data field is invalid");
     return;
@@ -62,8 +81,9 @@ void Compensator::pointcloud_callback(
   if (query_pose_affine_from_tf2(timestamp_min, pose_min_time) &&
       query_pose_affine_from_tf2(timestamp_max, pose_max_time)) {
     // we change message after motion compesation
-    sensor_msgs::PointCloud2::Ptr q_msg(new sensor_msgs::PointCloud2());
-    *q_msg = *msg;
+    if (!q_msg) {
+      q_msg.reset(new sensor_msgs::PointCloud2(*msg));
+    }
     motion_compensation<float>(q_msg, timestamp_min, timestamp_max,
                                pose_min_time, pose_max_time);
     q_msg->header.stamp.fromSec(timestamp_max);
@@ -224,11 +244,14 @@ void Compensator::motion_compensation(sensor_msgs::PointCloud2::Ptr& msg,
   q1.normalize();
   translation = q_max.conjugate() * translation;
 
-  int total = msg->width * msg->height;
+  const int total = msg->width * msg->height;
 
   double d = q0.dot(q1);
   double abs_d = abs(d);
-  double f = 1.0 / (timestamp_max - timestamp_min);
+  // all points of a single firing share one timestamp and need no scaling
+  double f = timestamp_max > timestamp_min
+                 ? 1.0 / (timestamp_max - timestamp_min)
+                 : 0.0;
 
   // Threshold for a "significant" rotation from min_time to max_time:
   // The LiDAR range accuracy is ~2 cm. Over 70 meters range, it means an angle
@@ -240,6 +263,28 @@ void Compensator::motion_compensation(sensor_msgs::PointCloud2::Ptr& msg,
     double theta = acos(abs_d);
     double sin_theta = sin(theta);
     double c1_sign = (d > 0) ? 1 : -1;
+    // The points are moved by the transform slerped at the center of the time
+    // bucket they fall in, instead of a slerp per point. A scan of 0.1 s in
+    // 2000 buckets is off by 25 us at most, i.e. less than 1 mm at 30 m/s.
+    const int num_buckets = std::max(1, compensation_buckets_);
+    // row major 3x4 matrices
+    std::vector<double> transforms(num_buckets * 12);
+    for (int b = 0; b < num_buckets; ++b) {
+      double t = (b + 0.5) / num_buckets;
+      double c0 = sin((1 - t) * theta) / sin_theta;
+      double c1 = sin(t * theta) / sin_theta * c1_sign;
+      Eigen::Quaterniond qi(c0 * q0.coeffs() + c1 * q1.coeffs());
+      Eigen::Matrix3d rotation = qi.toRotationMatrix();
+      double* m = &transforms[b * 12];
+      for (int r = 0; r < 3; ++r) {
+        m[r * 4] = rotation(r, 0);
+        m[r * 4 + 1] = rotation(r, 1);
+        m[r * 4 + 2] = rotation(r, 2);
+        m[r * 4 + 3] = t * translation(r);
+      }
+    }
+#pragma omp parallel for num_threads(compensation_threads_) \
+    if (compensation_threads_ > 1)
     for (int i = 0; i < total; ++i) {
       size_t offset = i * msg->point_step;
       Scalar* x_scalar =
@@ -252,28 +297,27 @@ void Compensator::motion_compensation(sensor_msgs::PointCloud2::Ptr& msg,
           reinterpret_cast<Scalar*>(&msg->data[offset + y_offset_]);
       Scalar* z_scalar =
           reinterpret_cast<Scalar*>(&msg->data[offset + z_offset_]);
-      Eigen::Vector3d p(*x_scalar, *y_scalar, *z_scalar);
+      const double px = *x_scalar;
+      const double py = *y_scalar;
+      const double pz = *z_scalar;
 
       double tp = 0.0;
-      memcpy(&tp, &msg->data[i * msg->point_step + timestamp_offset_],
+      memcpy(&tp, &msg->data[offset + timestamp_offset_],
              timestamp_data_size_);
       double t = (timestamp_max - tp) * f;
+      int bucket = std::min(num_buckets - 1,
+                            std::max(0, static_cast<int>(t * num_buckets)));
 
-      Eigen::Translation3d ti(t * translation);
-
-      double c0 = sin((1 - t) * theta) / sin_theta;
-      double c1 = sin(t * theta) / sin_theta * c1_sign;
-      Eigen::Quaterniond qi(c0 * q0.coeffs() + c1 * q1.coeffs());
-
-      Eigen::Affine3d trans = ti * qi;
-      p = trans * p;
-      *x_scalar = p.x();
-      *y_scalar = p.y();
-      *z_scalar = p.z();
+      const double* m = &transforms[bucket * 12];
+      *x_scalar = m[0] * px + m[1] * py + m[2] * pz + m[3];
+      *y_scalar = m[4] * px + m[5] * py + m[6] * pz + m[7];
+      *z_scalar = m[8] * px + m[9] * py + m[10] * pz + m[11];
     }
     return;
   }
   // Not a "significant" rotation. Do translation only.
+#pragma omp parallel for num_threads(compensation_threads_) \
+    if (compensation_threads_ > 1)
   for (int i = 0; i < total; ++i) {
     Scalar* x_scalar =
         reinterpret_cast<Scalar*>(&msg->data[i * msg->point_step + x_offset_]);
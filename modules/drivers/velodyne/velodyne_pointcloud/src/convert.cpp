@@ -40,6 +40,8 @@ void Convert::init(ros::NodeHandle& node, ros::NodeHandle& private_nh) {
   private_nh.param("topic_pointcloud", topic_pointcloud_, TOPIC_POINTCLOUD);
   // we use beijing time by default
   private_nh.param("queue_size", queue_size_, 10);
+  bool motion_compensation = false;
+  private_nh.param("motion_compensation", motion_compensation, false);
 
   parser_ = VelodyneParserFactory::create_parser(config_);
   if (parser_ == nullptr) {
@@ -63,6 +65,11 @@ void Convert::init(ros::NodeHandle& node, ros::NodeHandle& private_nh) {
   velodyne_scan_ = node.subscribe(
       topic_packets_, queue_size_, &Convert::convert_packets_to_pointcloud,
       (Convert*)this, ros::TransportHints().tcpNoDelay(true));
+
+  if (motion_compensation) {
+    // the compensator reads its parameters from the same private namespace
+    compensator_.reset(new Compensator(node, private_nh, false));
+  }
 }
 
 Convert::~Convert() {
@@ -91,8 +98,20 @@ void Convert::convert_packets_to_pointcloud(
     parser_->order(pointcloud);
   }
 
-  // publish the accumulated cloud message
-  pointcloud_pub_.publish(pointcloud);
+  if (compensator_ == nullptr) {
+    // publish the accumulated cloud message
+    pointcloud_pub_.publish(pointcloud);
+    return;
+  }
+
+  // the uncompensated cloud is only published when it is listened to
+  if (pointcloud_pub_.getNumSubscribers() > 0) {
+    pointcloud_pub_.publish(pointcloud);
+  }
+  // the msg is owned here, so it is compensated without a copy
+  sensor_msgs::PointCloud2::Ptr msg(new sensor_msgs::PointCloud2());
+  pcl::toROSMsg(*pointcloud, *msg);
+  compensator_->compensate_in_place(msg);
 }
 
 }  // namespace velodyne
@@ -86,23 +86,25 @@ void Velodyne16Parser::unpack(const velodyne_msgs::VelodynePacket& pkt,
     }
 
     for (int firing = 0, k = 0; firing < VLP16_FIRINGS_PER_BLOCK; ++firing) {
-      for (int dsr = 0; dsr < VLP16_SCANS_PER_FIRING;
-           ++dsr, k += RAW_SCAN_SIZE) {
-        LaserCorrection& corrections = calibration_.laser_corrections_[dsr];
-
-        /** Position Calculation */
-        union RawDistance raw_distance;
-        raw_distance.bytes[0] = raw->blocks[block].data[k];
-        raw_distance.bytes[1] = raw->blocks[block].data[k + 1];
-
-        /** correct for the laser rotation as a function of timing during the
-         * firings **/
+      /** correct for the laser rotation as a function of timing during the
+       * firings **/
+      uint16_t rotations[VLP16_SCANS_PER_FIRING];
+      for (int dsr = 0; dsr < VLP16_SCANS_PER_FIRING; ++dsr) {
         azimuth_corrected_f =
             azimuth + (azimuth_diff * ((dsr * VLP16_DSR_TOFFSET) +
                                        (firing * VLP16_FIRING_TOFFSET)) /
                        VLP16_BLOCK_TDURATION);
         azimuth_corrected = (int)round(fmod(azimuth_corrected_f, 36000.0));
+        rotations[dsr] = azimuth_corrected;
+      }
+
+      // all the firings of the firing sequence are computed at once
+      BlockCoords coords;
+      compute_block_coords(raw->blocks[block].data + k, rotations, 0,
+                           VLP16_SCANS_PER_FIRING, &coords);
 
+      for (int dsr = 0; dsr < VLP16_SCANS_PER_FIRING;
+           ++dsr, k += RAW_SCAN_SIZE) {
         // set 4th param to LOWER_BANK, only use lower_gps_base_usec_ and
         // lower_previous_packet_stamp_
         double timestamp = get_timestamp(
@@ -117,13 +119,7 @@ void Velodyne16Parser::unpack(const velodyne_msgs::VelodynePacket& pkt,
           pc.header.stamp = static_cast<uint64_t>(timestamp * 1e6);
         }
 
-        VPoint point;
-        point.timestamp = timestamp;
-        float distance = raw_distance.raw_distance * DISTANCE_RESOLUTION +
-                         corrections.dist_correction;
-
-        if (raw_distance.raw_distance == 0 ||
-            !is_scan_valid(azimuth_corrected, distance)) {
+        if (!coords.valid[dsr]) {
           // if orgnized append a nan point to the cloud
           if (config_.organized) {
             pc.points.push_back(get_nan_point(timestamp));
@@ -133,8 +129,11 @@ void Velodyne16Parser::unpack(const velodyne_msgs::VelodynePacket& pkt,
           continue;
         }
 
-        // append this point to the cloud
-        compute_coords(raw_distance, corrections, azimuth_corrected, point);
+        VPoint point;
+        point.timestamp = timestamp;
+        point.x = coords.x[dsr];
+        point.y = coords.y[dsr];
+        point.z = coords.z[dsr];
         point.intensity = raw->blocks[block].data[k + 2];
         // append this point to the cloud
         pc.points.push_back(point);
@@ -18,6 +18,8 @@
 
 #include <ros/ros.h>
 
+#include <algorithm>
+
 namespace apollo {
 namespace drivers {
 namespace velodyne {
@@ -153,6 +155,7 @@ void Velodyne64Parser::generate_pointcloud(
       return;
     }
     calibration_ = online_calibration_.calibration();
+    init_laser_correction_table();
     if (config_.organized) {
       init_offsets();
     }
@@ -212,19 +215,20 @@ double Velodyne64Parser::get_timestamp(double base_time, float time_offset,
   return timestamp;
 }
 
-int Velodyne64Parser::intensity_compensate(const LaserCorrection& corrections,
+int Velodyne64Parser::intensity_compensate(int laser_number,
                                            const uint16_t& raw_distance,
                                            int intensity) {
+  const LaserCorrectionTable& t = laser_table_;
   float tmp = 1 - static_cast<float>(raw_distance) / 65535;
-  intensity += corrections.focal_slope *
-               (fabs(corrections.focal_offset - 256 * tmp * tmp));
+  intensity += t.focal_slope[laser_number] *
+               (fabs(t.focal_offset[laser_number] - 256 * tmp * tmp));
 
-  if (intensity < corrections.min_intensity) {
-    intensity = corrections.min_intensity;
+  if (intensity < t.min_intensity[laser_number]) {
+    intensity = t.min_intensity[laser_number];
   }
 
-  if (intensity > corrections.max_intensity) {
-    intensity = corrections.max_intensity;
+  if (intensity > t.max_intensity[laser_number]) {
+    intensity = t.max_intensity[laser_number];
   }
   return intensity;
 }
@@ -244,18 +248,20 @@ void Velodyne64Parser::unpack(const velodyne_msgs::VelodynePacket& pkt,
 
     // upper bank lasers are numbered [0..31], lower bank lasers are [32..63]
     // NOTE: this is a change from the old velodyne_common implementation
-    int bank_origin = (raw->blocks[i].laser_block_id == LOWER_BANK) ? 32 : 0;
+    const RawBlock& block = raw->blocks[i];
+    int bank_origin = (block.laser_block_id == LOWER_BANK) ? 32 : 0;
+
+    // all the firings of the block are computed at once
+    uint16_t rotations[SCANS_PER_BLOCK];
+    std::fill(rotations, rotations + SCANS_PER_BLOCK, block.rotation);
+    BlockCoords coords;
+    compute_block_coords(block.data, rotations, bank_origin, SCANS_PER_BLOCK,
+                         &coords);
 
     for (int j = 0, k = 0; j < SCANS_PER_BLOCK;
          ++j, k += RAW_SCAN_SIZE) {  // 32, 3
       // One point
       uint8_t laser_number = j + bank_origin;  // hardware larse number
-      LaserCorrection& corrections =
-          calibration_.laser_corrections_[laser_number];
-
-      union RawDistance raw_distance;
-      raw_distance.bytes[0] = raw->blocks[i].data[k];
-      raw_distance.bytes[1] = raw->blocks[i].data[k + 1];
 
       // compute time
       double timestamp = get_timestamp(basetime, (*inner_time_)[i][j], i);
@@ -265,11 +271,7 @@ void Velodyne64Parser::unpack(const velodyne_msgs::VelodynePacket& pkt,
         pc.header.stamp = static_cast<uint64_t>(timestamp * 1000000);
       }
 
-      float distance = raw_distance.raw_distance * DISTANCE_RESOLUTION +
-                       corrections.dist_correction;
-
-      if (raw_distance.raw_distance == 0 ||
-          !is_scan_valid(raw->blocks[i].rotation, distance)) {
+      if (!coords.valid[j]) {
         // if orgnized append a nan point to the cloud
         if (config_.organized) {
           pc.points.emplace_back(get_nan_point(timestamp));
@@ -279,10 +281,11 @@ void Velodyne64Parser::unpack(const velodyne_msgs::VelodynePacket& pkt,
 
       VPoint point;
       point.timestamp = timestamp;
-      // Position Calculation, append this point to the cloud
-      compute_coords(raw_distance, corrections, raw->blocks[i].rotation, point);
+      point.x = coords.x[j];
+      point.y = coords.y[j];
+      point.z = coords.z[j];
       point.intensity = intensity_compensate(
-          corrections, raw_distance.raw_distance, raw->blocks[i].data[k + 2]);
+          laser_number, coords.raw_distance[j], block.data[k + 2]);
       // append this point to the cloud
       pc.points.emplace_back(point);
     }
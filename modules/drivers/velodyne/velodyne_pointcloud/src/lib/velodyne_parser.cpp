@@ -109,101 +109,130 @@ void VelodyneParser::setup() {
   init_angle_params(config_.view_direction, config_.view_width);
   init_sin_cos_rot_table(sin_rot_table_, cos_rot_table_, ROTATION_MAX_UNITS,
                          ROTATION_RESOLUTION);
+  init_laser_correction_table();
 }
 
-bool VelodyneParser::is_scan_valid(int rotation, float range) {
-  // check range first
-  if (range < config_.min_range || range > config_.max_range) {
-    return false;
+void VelodyneParser::init_laser_correction_table() {
+  LaserCorrectionTable &table = laser_table_;
+  for (int i = 0; i < MAX_LASER_NUM; ++i) {
+    // a laser out of the calibration has no correction, as the default
+    // LaserCorrection the std::map would insert
+    LaserCorrection corrections = LaserCorrection();
+    auto itr = calibration_.laser_corrections_.find(i);
+    if (itr != calibration_.laser_corrections_.end()) {
+      corrections = itr->second;
+    }
+    table.dist_correction[i] = corrections.dist_correction;
+    table.dist_correction_x[i] = corrections.dist_correction_x;
+    table.dist_correction_y[i] = corrections.dist_correction_y;
+    table.vert_offset_correction[i] = corrections.vert_offset_correction;
+    table.horiz_offset_correction[i] = corrections.horiz_offset_correction;
+    table.cos_rot_correction[i] = corrections.cos_rot_correction;
+    table.sin_rot_correction[i] = corrections.sin_rot_correction;
+    table.cos_vert_correction[i] = corrections.cos_vert_correction;
+    table.sin_vert_correction[i] = corrections.sin_vert_correction;
+    table.focal_slope[i] = corrections.focal_slope;
+    table.focal_offset[i] = corrections.focal_offset;
+    table.max_intensity[i] = corrections.max_intensity;
+    table.min_intensity[i] = corrections.min_intensity;
   }
-  // condition added to avoid calculating points which are not
-  // in the interesting defined area (min_angle < area < max_angle)
-  // not used now
-  // if ((config_.min_angle > config_.max_angle && (rotation <=
-  // config_.max_angle || rotation >= config_.min_angle))
-  //     || (config_.min_angle < config_.max_angle && rotation >=
-  //     config_.min_angle
-  //         && rotation <= config_.max_angle)) {
-  //     return true;
-  // }
-  return true;
 }
 
-void VelodyneParser::compute_coords(const union RawDistance &raw_distance,
-                                    const LaserCorrection &corrections,
-                                    const uint16_t &rotation, VPoint &point) {
-  ROS_ASSERT_MSG(rotation < 36000, "rotation must between 0 and 35999");
-  double x = 0.0;
-  double y = 0.0;
-  double z = 0.0;
-
-  double distance1 = raw_distance.raw_distance * DISTANCE_RESOLUTION;
-  double distance = distance1 + corrections.dist_correction;
-
-  // cos(a-b) = cos(a)*cos(b) + sin(a)*sin(b)
-  // sin(a-b) = sin(a)*cos(b) - cos(a)*sin(b)
-  double cos_rot_angle =
-      cos_rot_table_[rotation] * corrections.cos_rot_correction +
-      sin_rot_table_[rotation] * corrections.sin_rot_correction;
-  double sin_rot_angle =
-      sin_rot_table_[rotation] * corrections.cos_rot_correction -
-      cos_rot_table_[rotation] * corrections.sin_rot_correction;
-
-  // double vert_offset = corrections.vert_offset_correction;
-
-  // Compute the distance in the xy plane (w/o accounting for rotation)
-  double xy_distance = distance * corrections.cos_vert_correction;
-
-  // Calculate temporal X, use absolute value.
-  double xx = fabs(xy_distance * sin_rot_angle -
-                   corrections.horiz_offset_correction * cos_rot_angle);
-  // Calculate temporal Y, use absolute value
-  double yy = fabs(xy_distance * cos_rot_angle +
-                   corrections.horiz_offset_correction * sin_rot_angle);
-
-  // Get 2points calibration values,Linear interpolation to get distance
-  // correction for X and Y, that means distance correction use
-  // different value at different distance
-  double distance_corr_x = 0;
-  double distance_corr_y = 0;
-
-  if (need_two_pt_correction_ && distance1 <= 2500) {
-    distance_corr_x =
-        (corrections.dist_correction - corrections.dist_correction_x) *
-            (xx - 2.4) / 22.64 +
-        corrections.dist_correction_x;  // 22.64 = 25.04 - 2.4
-    distance_corr_y =
-        (corrections.dist_correction - corrections.dist_correction_y) *
-            (yy - 1.93) / 23.11 +
-        corrections.dist_correction_y;  // 23.11 = 25.04 - 1.93
-  } else {
-    distance_corr_x = distance_corr_y = corrections.dist_correction;
+void VelodyneParser::compute_block_coords(const uint8_t *data,
+                                          const uint16_t *rotations,
+                                          int first_laser, int num,
+                                          BlockCoords *coords) {
+  ROS_ASSERT_MSG(first_laser + num <= MAX_LASER_NUM, "too many lasers");
+  ROS_ASSERT_MSG(num <= SCANS_PER_BLOCK, "too many firings");
+  const LaserCorrectionTable &t = laser_table_;
+  const float *dist_correction = t.dist_correction + first_laser;
+  const float *dist_correction_x = t.dist_correction_x + first_laser;
+  const float *dist_correction_y = t.dist_correction_y + first_laser;
+  const float *vert_offset = t.vert_offset_correction + first_laser;
+  const float *horiz_offset = t.horiz_offset_correction + first_laser;
+  const float *cos_rot_correction = t.cos_rot_correction + first_laser;
+  const float *sin_rot_correction = t.sin_rot_correction + first_laser;
+  const float *cos_vert_correction = t.cos_vert_correction + first_laser;
+  const float *sin_vert_correction = t.sin_vert_correction + first_laser;
+
+  // the raw distances are packed misaligned, they're gathered first so the
+  // next loops run on arrays
+  uint16_t *raw_distance = coords->raw_distance;
+  float cos_rot[SCANS_PER_BLOCK];
+  float sin_rot[SCANS_PER_BLOCK];
+  for (int j = 0; j < num; ++j) {
+    raw_distance[j] = static_cast<uint16_t>(
+        data[j * RAW_SCAN_SIZE] | (data[j * RAW_SCAN_SIZE + 1] << 8));
+    ROS_ASSERT_MSG(rotations[j] < ROTATION_MAX_UNITS,
+                   "rotation must between 0 and 36000");
+    cos_rot[j] = cos_rot_table_[rotations[j]];
+    sin_rot[j] = sin_rot_table_[rotations[j]];
   }
 
-  double distance_x = distance1 + distance_corr_x;
-
-  xy_distance = distance_x * corrections.cos_vert_correction;
-  // xy_distance = distance_x * cos_vert_correction - vert_offset *
-  // sin_vert_correction;
-
-  x = xy_distance * sin_rot_angle -
-      corrections.horiz_offset_correction * cos_rot_angle;
-
-  double distance_y = distance1 + distance_corr_y;
-  xy_distance = distance_y * corrections.cos_vert_correction;
-  // xy_distance = distance_y * cos_vert_correction - vert_offset *
-  // sin_vert_correction;
-  y = xy_distance * cos_rot_angle +
-      corrections.horiz_offset_correction * sin_rot_angle;
-
-  z = distance * corrections.sin_vert_correction +
-      corrections.vert_offset_correction;
-  // z = distance * sin_vert_correction + vert_offset * cos_vert_correction;
+  // range filtering with a mask instead of a branch per firing
+  const double min_range = config_.min_range;
+  const double max_range = config_.max_range;
+  for (int j = 0; j < num; ++j) {
+    float distance = raw_distance[j] * DISTANCE_RESOLUTION +
+                     dist_correction[j];
+    coords->valid[j] = raw_distance[j] != 0 && !(distance < min_range) &&
+                       !(distance > max_range);
+  }
 
-  /** Use standard ROS coordinate system (right-hand rule) */
-  point.x = float(y);
-  point.y = float(-x);
-  point.z = float(z);
+  // the same computation as LaserCorrection based one, for all the firings
+  for (int j = 0; j < num; ++j) {
+    double distance1 = raw_distance[j] * DISTANCE_RESOLUTION;
+    double distance = distance1 + dist_correction[j];
+
+    // cos(a-b) = cos(a)*cos(b) + sin(a)*sin(b)
+    // sin(a-b) = sin(a)*cos(b) - cos(a)*sin(b)
+    double cos_rot_angle = cos_rot[j] * cos_rot_correction[j] +
+                           sin_rot[j] * sin_rot_correction[j];
+    double sin_rot_angle = sin_rot[j] * cos_rot_correction[j] -
+                           cos_rot[j] * sin_rot_correction[j];
+
+    // Compute the distance in the xy plane (w/o accounting for rotation)
+    double xy_distance = distance * cos_vert_correction[j];
+
+    // Calculate temporal X, use absolute value.
+    double xx =
+        fabs(xy_distance * sin_rot_angle - horiz_offset[j] * cos_rot_angle);
+    // Calculate temporal Y, use absolute value
+    double yy =
+        fabs(xy_distance * cos_rot_angle + horiz_offset[j] * sin_rot_angle);
+
+    // Get 2points calibration values,Linear interpolation to get distance
+    // correction for X and Y, that means distance correction use
+    // different value at different distance
+    const bool two_pt_correction =
+        need_two_pt_correction_ && distance1 <= 2500;
+    double distance_corr_x =
+        two_pt_correction
+            ? (dist_correction[j] - dist_correction_x[j]) * (xx - 2.4) /
+                      22.64 +
+                  dist_correction_x[j]  // 22.64 = 25.04 - 2.4
+            : dist_correction[j];
+    double distance_corr_y =
+        two_pt_correction
+            ? (dist_correction[j] - dist_correction_y[j]) * (yy - 1.93) /
+                      23.11 +
+                  dist_correction_y[j]  // 23.11 = 25.04 - 1.93
+            : dist_correction[j];
+
+    double distance_x = distance1 + distance_corr_x;
+    xy_distance = distance_x * cos_vert_correction[j];
+    double x = xy_distance * sin_rot_angle - horiz_offset[j] * cos_rot_angle;
+
+    double distance_y = distance1 + distance_corr_y;
+    xy_distance = distance_y * cos_vert_correction[j];
+    double y = xy_distance * cos_rot_angle + horiz_offset[j] * sin_rot_angle;
+    double z = distance * sin_vert_correction[j] + vert_offset[j];
+
+    /** Use standard ROS coordinate system (right-hand rule) */
+    coords->x[j] = float(y);
+    coords->y[j] = float(-x);
+    coords->z[j] = float(z);
+  }
 }
 
 VelodyneParser *VelodyneParserFactory::create_parser(Config config) {
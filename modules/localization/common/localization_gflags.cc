@@ -43,6 +43,14 @@ DEFINE_bool(enable_gps_imu_interprolate, true, "enable GPU/IMU interprolate");
 DEFINE_bool(enable_map_reference_unify, true,
             "enable IMU data convert to map reference");
 DEFINE_bool(enable_watchdog, true, "enable watchdog");
+DEFINE_bool(enable_imu_rate_localization, false,
+            "publish the RTK localization on every IMU message, extrapolated "
+            "from the last GPS message, instead of on the timer");
+DEFINE_double(imu_rate_localization_max_extrapolation_sec, 0.1,
+              "the longest time the RTK localization is extrapolated from a "
+              "GPS message (sec)");
+DEFINE_int32(rtk_imu_buffer_size, 256,
+             "the number of IMU messages kept to match the GPS messages");
 
 DEFINE_double(gps_time_delay_tolerance, 1.0,
               "gps message time delay tolerance (sec)");
@@ -90,6 +98,9 @@ DEFINE_double(lidar_map_coverage_theshold, 0.9,
               "Threshold to detect wether vehicle is out of map");
 DEFINE_bool(lidar_debug_log_flag, false, "Lidar Debug switch.");
 DEFINE_int32(point_cloud_step, 2, "Point cloud step");
+DEFINE_int32(lidar_timing_report_frames, 100,
+             "Number of lidar frames between the reports of the matching "
+             "time, 0 to disable the reports.");
 
 // integ module
 DEFINE_bool(integ_ins_can_self_align, false, "");
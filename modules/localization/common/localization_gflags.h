@@ -36,6 +36,9 @@ DECLARE_string(msf_visual_adapter_config_file);
 DECLARE_bool(enable_gps_imu_interprolate);
 DECLARE_bool(enable_map_reference_unify);
 DECLARE_bool(enable_watchdog);
+DECLARE_bool(enable_imu_rate_localization);
+DECLARE_double(imu_rate_localization_max_extrapolation_sec);
+DECLARE_int32(rtk_imu_buffer_size);
 
 DECLARE_double(gps_time_delay_tolerance);
 DECLARE_double(gps_imu_timestamp_sec_diff_tolerance);
@@ -63,6 +66,7 @@ DECLARE_double(lidar_imu_max_delay_time);
 DECLARE_double(lidar_map_coverage_theshold);
 DECLARE_bool(lidar_debug_log_flag);
 DECLARE_int32(point_cloud_step);
+DECLARE_int32(lidar_timing_report_frames);
 
 // integ module
 DECLARE_bool(integ_ins_can_self_align);
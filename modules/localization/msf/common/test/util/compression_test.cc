@@ -16,6 +16,7 @@
 
 #include "modules/localization/msf/common/util/compression.h"
 #include <gtest/gtest.h>
+#include <memory>
 
 namespace apollo {
 namespace localization {
@@ -47,6 +48,35 @@ TEST_F(CompressionTestSuite, ZlibStrategyTest) {
   }
 }
 
+/**@brief Lz4StrategyTest. */
+TEST_F(CompressionTestSuite, Lz4StrategyTest) {
+  Lz4Strategy lz4;
+  std::vector<unsigned char> buf_uncompressed;
+  std::vector<unsigned char> buf_compressed;
+  for (int i = 0; i < 100000; i++) {
+    buf_uncompressed.push_back((unsigned char)(i / 100));
+  }
+
+  std::vector<unsigned char> buf_uncompressed2;
+  ASSERT_EQ(lz4.Encode(&buf_uncompressed, &buf_compressed), 0);
+  ASSERT_LT(buf_compressed.size(), buf_uncompressed.size());
+  ASSERT_EQ(lz4.Decode(&buf_compressed, &buf_uncompressed2), 0);
+  ASSERT_EQ(buf_uncompressed2, buf_uncompressed);
+
+  // a truncated block is rejected
+  buf_compressed.resize(buf_compressed.size() / 2);
+  ASSERT_NE(lz4.Decode(&buf_compressed, &buf_uncompressed2), 0);
+}
+
+/**@brief CreateCompressionStrategyTest. */
+TEST_F(CompressionTestSuite, CreateCompressionStrategyTest) {
+  std::unique_ptr<CompressionStrategy> zlib(CreateCompressionStrategy("zlib"));
+  ASSERT_TRUE(dynamic_cast<ZlibStrategy*>(zlib.get()) != nullptr);
+  std::unique_ptr<CompressionStrategy> lz4(CreateCompressionStrategy("lz4"));
+  ASSERT_TRUE(dynamic_cast<Lz4Strategy*>(lz4.get()) != nullptr);
+  ASSERT_TRUE(CreateCompressionStrategy("unknown") == nullptr);
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/localization/msf/common/util/voxel_grid_covariance_hdmap.h"
+#include <gtest/gtest.h>
+#include <cstdlib>
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+class VoxelGridCovarianceTestSuite : public ::testing::Test {
+ protected:
+  typedef pcl::PointXYZI PointT;
+  typedef pcl::PointCloud<PointT> PointCloudT;
+
+  VoxelGridCovarianceTestSuite() {}
+  virtual ~VoxelGridCovarianceTestSuite() {}
+  virtual void SetUp() {
+    srand(5);
+    cloud_.reset(new PointCloudT);
+    for (int i = 0; i < 20000; ++i) {
+      PointT point;
+      point.x = 0.001f * (rand() % 20000);
+      point.y = 0.001f * (rand() % 10000);
+      point.z = 0.0005f * (rand() % 4000);
+      point.intensity = static_cast<float>(rand() % 256);
+      cloud_->points.push_back(point);
+    }
+    cloud_->width = static_cast<uint32_t>(cloud_->points.size());
+    cloud_->height = 1;
+  }
+  virtual void TearDown() {}
+
+  /**@brief Get the points of the cloud in the voxel of the point. */
+  PointCloudT PointsInVoxel(const PointT& point) const {
+    PointCloudT points;
+    for (const PointT& p : cloud_->points) {
+      if (floor(p.x) == floor(point.x) && floor(p.y) == floor(point.y) &&
+          floor(p.z) == floor(point.z)) {
+        points.points.push_back(p);
+      }
+    }
+    return points;
+  }
+
+  PointCloudT::Ptr cloud_;
+};
+
+/**@brief The leaves hold the points of their voxels. */
+TEST_F(VoxelGridCovarianceTestSuite, LeavesTest) {
+  VoxelGridCovariance<PointT> vgc;
+  vgc.setInputCloud(cloud_);
+  vgc.setLeafSize(1.0, 1.0, 1.0);
+  vgc.SetMinPointPerVoxel(6);
+  PointCloudT::Ptr centroids(new PointCloudT);
+  vgc.Filter(centroids);
+  // 20 x 10 x 2 voxels
+  ASSERT_EQ(400u, vgc.GetLeaves().size());
+  ASSERT_EQ(400u, centroids->points.size());
+  int point_count = 0;
+  for (size_t i = 0; i < vgc.GetLeaves().size(); ++i) {
+    point_count += vgc.GetLeaves()[i].GetPointCount();
+    if (i > 0) {
+      ASSERT_LT(vgc.GetLeafVoxelIndices()[i - 1], vgc.GetLeafVoxelIndices()[i]);
+    }
+  }
+  ASSERT_EQ(20000, point_count);
+
+  const PointT& point = cloud_->points[123];
+  const VoxelGridCovariance<PointT>::Leaf* leaf = vgc.GetLeaf(point);
+  ASSERT_TRUE(leaf != NULL);
+  PointCloudT points = PointsInVoxel(point);
+  ASSERT_EQ(static_cast<int>(points.points.size()), leaf->GetPointCount());
+  ASSERT_EQ(points.points.size(), leaf->cloud_.points.size());
+  Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+  for (size_t i = 0; i < points.points.size(); ++i) {
+    // the points are in the order of the cloud
+    ASSERT_EQ(points.points[i].x, leaf->cloud_.points[i].x);
+    mean += Eigen::Vector3d(points.points[i].x, points.points[i].y,
+                            points.points[i].z);
+  }
+  mean /= static_cast<double>(points.points.size());
+  ASSERT_LT((mean - leaf->GetMean()).norm(), 1e-9);
+  ASSERT_GT(leaf->GetEvals()(0), 0.0);
+}
+
+/**@brief The leaves do not depend on the threads, and are rebuilt. */
+TEST_F(VoxelGridCovarianceTestSuite, ThreadTest) {
+  VoxelGridCovariance<PointT> serial_vgc;
+  serial_vgc.setInputCloud(cloud_);
+  serial_vgc.setLeafSize(0.5, 0.5, 0.5);
+  serial_vgc.Filter(false);
+
+  VoxelGridCovariance<PointT> vgc;
+  vgc.SetThreadNum(4);
+  ASSERT_EQ(4u, vgc.GetThreadNum());
+  PointCloudT::Ptr small_cloud(new PointCloudT);
+  small_cloud->points.assign(cloud_->points.begin(),
+                             cloud_->points.begin() + 100);
+  vgc.setInputCloud(small_cloud);
+  vgc.setLeafSize(2.0, 2.0, 2.0);
+  vgc.Filter(false);
+  vgc.setInputCloud(cloud_);
+  vgc.setLeafSize(0.5, 0.5, 0.5);
+  vgc.Filter(false);
+
+  ASSERT_EQ(serial_vgc.GetLeaves().size(), vgc.GetLeaves().size());
+  for (size_t i = 0; i < vgc.GetLeaves().size(); ++i) {
+    const VoxelGridCovariance<PointT>::Leaf& serial_leaf =
+        serial_vgc.GetLeaves()[i];
+    const VoxelGridCovariance<PointT>::Leaf& leaf = vgc.GetLeaves()[i];
+    ASSERT_EQ(serial_vgc.GetLeafVoxelIndices()[i],
+              vgc.GetLeafVoxelIndices()[i]);
+    ASSERT_EQ(serial_leaf.GetPointCount(), leaf.GetPointCount());
+    ASSERT_EQ(serial_leaf.cloud_.points.size(), leaf.cloud_.points.size());
+    ASSERT_TRUE(serial_leaf.GetMean() == leaf.GetMean());
+    ASSERT_TRUE(serial_leaf.GetCov() == leaf.GetCov());
+    ASSERT_TRUE(serial_leaf.GetEvals() == leaf.GetEvals());
+  }
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -16,6 +16,7 @@
 
 #include "modules/localization/msf/common/util/compression.h"
 
+#include <lz4.h>
 #include <zlib.h>
 #include <cstdio>
 
@@ -26,6 +27,7 @@ namespace localization {
 namespace msf {
 
 const unsigned int ZlibStrategy::zlib_chunk = 16384;
+const unsigned int Lz4Strategy::lz4_header_size = 4;
 
 unsigned int ZlibStrategy::Encode(BufferStr* buf, BufferStr* buf_compressed) {
   return ZlibCompress(buf, buf_compressed);
@@ -153,6 +155,62 @@ unsigned int ZlibStrategy::ZlibUncompress(BufferStr* src, BufferStr* dst) {
   return ret == Z_STREAM_END ? Z_OK : Z_DATA_ERROR;
 }
 
+unsigned int Lz4Strategy::Encode(BufferStr* buf, BufferStr* buf_compressed) {
+  const unsigned int src_size = buf->size();
+  const int max_dst_size = LZ4_compressBound(src_size);
+  if (src_size == 0 || max_dst_size <= 0) {
+    return 1;
+  }
+  buf_compressed->resize(lz4_header_size + max_dst_size);
+  for (unsigned int i = 0; i < lz4_header_size; ++i) {
+    (*buf_compressed)[i] = static_cast<unsigned char>(src_size >> (8 * i));
+  }
+  const char* src = reinterpret_cast<const char*>(&((*buf)[0]));
+  char* dst = reinterpret_cast<char*>(&((*buf_compressed)[lz4_header_size]));
+#if defined(LZ4_VERSION_NUMBER) && LZ4_VERSION_NUMBER >= 10700
+  const int dst_size = LZ4_compress_default(src, dst, src_size, max_dst_size);
+#else
+  const int dst_size = LZ4_compress(src, dst, src_size);
+#endif
+  if (dst_size <= 0) {
+    buf_compressed->clear();
+    return 1;
+  }
+  buf_compressed->resize(lz4_header_size + dst_size);
+  return 0;
+}
+
+unsigned int Lz4Strategy::Decode(BufferStr* buf, BufferStr* buf_uncompressed) {
+  if (buf->size() <= lz4_header_size) {
+    return 1;
+  }
+  unsigned int dst_size = 0;
+  for (unsigned int i = 0; i < lz4_header_size; ++i) {
+    dst_size |= static_cast<unsigned int>((*buf)[i]) << (8 * i);
+  }
+  buf_uncompressed->resize(dst_size);
+  const char* src = reinterpret_cast<const char*>(&((*buf)[lz4_header_size]));
+  char* dst = reinterpret_cast<char*>(&((*buf_uncompressed)[0]));
+  const int size = LZ4_decompress_safe(src, dst, buf->size() - lz4_header_size,
+                                       dst_size);
+  if (size < 0 || static_cast<unsigned int>(size) != dst_size) {
+    AERROR << "Failed to decode the lz4 block.";
+    buf_uncompressed->clear();
+    return 1;
+  }
+  return 0;
+}
+
+CompressionStrategy* CreateCompressionStrategy(const std::string& codec) {
+  if (codec == "zlib") {
+    return new ZlibStrategy();
+  }
+  if (codec == "lz4") {
+    return new Lz4Strategy();
+  }
+  return nullptr;
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
@@ -17,6 +17,7 @@
 #ifndef MODULES_LOCALIZATION_MSF_COMMON_COMPRESSION_H_
 #define MODULES_LOCALIZATION_MSF_COMMON_COMPRESSION_H_
 
+#include <string>
 #include <vector>
 
 namespace apollo {
@@ -44,6 +45,22 @@ class ZlibStrategy : public CompressionStrategy {
   unsigned int ZlibUncompress(BufferStr* src, BufferStr* dst);
 };
 
+/**@brief The LZ4 block codec. It compresses a bit less than zlib, but
+ * decodes several times faster. The size of the uncompressed data is stored
+ * in the 4 bytes before the block. */
+class Lz4Strategy : public CompressionStrategy {
+ public:
+  virtual unsigned int Encode(BufferStr* buf, BufferStr* buf_compressed);
+  virtual unsigned int Decode(BufferStr* buf, BufferStr* buf_uncompressed);
+
+ protected:
+  static const unsigned int lz4_header_size;
+};
+
+/**@brief Create the compression strategy of the codec, "zlib" or "lz4".
+ * @param <return> nullptr if the codec is unknown. */
+CompressionStrategy* CreateCompressionStrategy(const std::string& codec);
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
@@ -21,8 +21,9 @@
 #include <pcl/sample_consensus/sac_model_plane.h>
 #include <pcl/sample_consensus/impl/ransac.hpp>
 #include <pcl/sample_consensus/impl/sac_model_plane.hpp>
+#include <algorithm>
 #include <cmath>
-#include <map>
+#include <thread>
 #include <vector>
 #include "modules/localization/msf/common/util/voxel_grid_covariance_hdmap.h"
 
@@ -96,28 +97,30 @@ class FeatureXYPlane {
     std::clock_t plane_time;
     plane_time = std::clock();
     int total_plane_num = 0;
+    // the leaves are built in parallel, and their storage is reused by the
+    // iterations
+    VoxelGridCovariance<PointT> vgc;
+    vgc.SetThreadNum(std::max(std::thread::hardware_concurrency(), 1u));
+    vgc.SetMinPointPerVoxel(min_planepoints_number_);
     for (int iter = 0; iter <= iter_num; ++iter) {
       double grid_size = max_grid_size_ / Power2(iter);
-      VoxelGridCovariance<PointT> vgc;
       vgc.setInputCloud(pointcloud_ptr);
-      vgc.SetMinPointPerVoxel(min_planepoints_number_);
       vgc.setLeafSize(grid_size, grid_size, grid_size);
       vgc.Filter(false);
 
       PointCloudT cloud_tmp;
       int plane_num = 0;
-      typename std::map<size_t, VoxelGridCovariance<PointT>::Leaf>::iterator it;
-      for (it = vgc.GetLeaves().begin(); it != vgc.GetLeaves().end(); it++) {
-        if (it->second.GetPointCount() < min_planepoints_number_) {
-          cloud_tmp += it->second.cloud_;
+      for (const auto& leaf : vgc.GetLeaves()) {
+        if (leaf.GetPointCount() < min_planepoints_number_) {
+          cloud_tmp += leaf.cloud_;
           continue;
         }
         PointCloudT cloud_outlier;
-        if (GetPlaneFeaturePoint(it->second.cloud_, &cloud_outlier)) {
+        if (GetPlaneFeaturePoint(leaf.cloud_, &cloud_outlier)) {
           cloud_tmp += cloud_outlier;
           plane_num++;
         } else {
-          cloud_tmp += it->second.cloud_;
+          cloud_tmp += leaf.cloud_;
         }
       }
       std::cerr << "the " << iter << " interation: plane_num = " << plane_num
@@ -23,9 +23,12 @@
 #include <pcl/kdtree/kdtree_flann.h>
 #include <Eigen/Cholesky>
 #include <Eigen/Dense>
+#include <algorithm>
 #include <limits>
-#include <map>
+#include <memory>
+#include <unordered_map>
 #include <vector>
+#include "modules/localization/msf/common/util/threadpool.h"
 
 namespace apollo {
 namespace localization {
@@ -133,6 +136,8 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
   typedef Leaf* LeafPtr;
   // Const pointer to VoxelGridCovariance leaf structure.
   typedef const Leaf* LeafConstPtr;
+  // The leaves, whose points hold fixed size Eigen members.
+  typedef std::vector<Leaf, Eigen::aligned_allocator<Leaf>> LeafVector;
 
  public:
   VoxelGridCovariance()
@@ -142,7 +147,8 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
         leaves_(),
         voxel_centroids_(),
         voxel_centroidsleaf_indices_(),
-        kdtree_() {
+        kdtree_(),
+        thread_num_(1) {
     downsample_all_data_ = false;
     save_leaf_layout_ = false;
     leaf_size_.setZero();
@@ -196,16 +202,8 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
     }
   }
 
-  // Get the voxel containing point p.
-  inline LeafConstPtr GetLeaf(int index) {
-    typename std::map<size_t, Leaf>::iterator leaf_iter = leaves_.find(index);
-    if (leaf_iter != leaves_.end()) {
-      LeafConstPtr ret(&(leaf_iter->second));
-      return ret;
-    } else {
-      return NULL;
-    }
-  }
+  // Get the voxel of index.
+  inline LeafConstPtr GetLeaf(int index) { return FindLeaf(index); }
 
   // Get the voxel containing point p.
   inline LeafConstPtr GetLeaf(const PointT& p) {
@@ -216,16 +214,7 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
 
     // Compute the centroid leaf index
     int idx = ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
-
-    // Find leaf associated with index
-    typename std::map<size_t, Leaf>::iterator leaf_iter = leaves_.find(idx);
-    if (leaf_iter != leaves_.end()) {
-      // If such a leaf exists return the pointer to the leaf structure
-      LeafConstPtr ret(&(leaf_iter->second));
-      return ret;
-    } else {
-      return NULL;
-    }
+    return FindLeaf(idx);
   }
 
   // Get the voxel containing point p.
@@ -240,25 +229,65 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
 
     // Compute the centroid leaf index
     int idx = ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
+    return FindLeaf(idx);
+  }
+
+  // Get the leaves, in the order of their voxel indices.
+  inline LeafVector& GetLeaves() {
+    return leaves_;
+  }
+
+  // Get the voxel indices of the leaves.
+  inline const std::vector<int>& GetLeafVoxelIndices() const {
+    return leaf_voxel_indices_;
+  }
+
+  // Set the number of threads building the leaves. With one thread the
+  // leaves are built in the calling thread.
+  inline void SetThreadNum(unsigned int thread_num) {
+    thread_num_ = std::max(thread_num, 1u);
+    pool_.reset(thread_num_ > 1 ? new ThreadPool(thread_num_) : nullptr);
+  }
 
-    // Find leaf associated with index
-    typename std::map<size_t, Leaf>::iterator leaf_iter = leaves_.find(idx);
-    if (leaf_iter != leaves_.end()) {
-      // If such a leaf exists return the pointer to the leaf structure
-      LeafConstPtr ret(&(leaf_iter->second));
-      return ret;
+  // Get the number of threads building the leaves.
+  inline unsigned int GetThreadNum() const {
+    return thread_num_;
+  }
+
+ private:
+  // Find the leaf of a voxel index.
+  inline LeafConstPtr FindLeaf(int index) const {
+    typename std::unordered_map<int, int>::const_iterator leaf_iter =
+        leaf_ids_.find(index);
+    if (leaf_iter != leaf_ids_.end()) {
+      return &leaves_[leaf_iter->second];
     } else {
       return NULL;
     }
   }
 
-  // Get the leaf structure map.
-  inline std::map<size_t, Leaf>& GetLeaves() {
-    return leaves_;
+  // Run function(begin, end) over bands of [0, size) on the thread pool.
+  template <typename Function>
+  void ParallelFor(size_t size, const Function& function) {
+    const size_t band_num =
+        pool_ == nullptr ? 1 : std::min(static_cast<size_t>(thread_num_), size);
+    if (band_num <= 1) {
+      function(0, size);
+      return;
+    }
+    for (size_t band = 0; band < band_num; ++band) {
+      const size_t begin = size * band / band_num;
+      const size_t end = size * (band + 1) / band_num;
+      pool_->schedule([&function, begin, end]() { function(begin, end); });
+    }
+    pool_->wait();
   }
 
- private:
   // Filter cloud and initializes voxel structure.
+  // The voxels of the points are computed in parallel, the points are bucketed
+  // by leaf in their order, then every leaf is accumulated and decomposed in
+  // parallel. A leaf sums its points in the input order, so the leaves do not
+  // depend on the number of threads.
   void ApplyFilter(PointCloudPtr output) {
     voxel_centroidsleaf_indices_.clear();
 
@@ -312,8 +341,6 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
     // Compute the number of divisions needed along all axis
     div_b_ = max_b_ - min_b_ + Eigen::Vector4i::Ones();
     div_b_[3] = 0;
-    // Clear the leaves
-    leaves_.clear();
     // Set up the division multiplier
     divb_mul_ = Eigen::Vector4i(1, div_b_[0], div_b_[0] * div_b_[1], 0);
     int centroid_size = 4;
@@ -333,6 +360,7 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
     }
     // If we don't want to process the entire cloud,
     // but rather filter points far away from the viewpoint first.
+    int distance_offset = -1;
     if (!filter_field_name_.empty()) {
       // Get the distance field index
       std::vector<pcl::PCLPointField> fields;
@@ -343,258 +371,251 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
             "[pcl::%s::ApplyFilter] Invalid filter field name. Index is %d.\n",
             getClassName().c_str(), distance_idx);
       }
-      // First pass: go over all points and insert them into the right leaf
-      for (size_t cp = 0; cp < input_->points.size(); ++cp) {
-        if (!input_->is_dense) {
-          // Check if the point is invalid
-          if (!pcl_isfinite(input_->points[cp].x) ||
-              !pcl_isfinite(input_->points[cp].y) ||
-              !pcl_isfinite(input_->points[cp].z)) {
-            continue;
-          }
-        }
-        // Get the distance value
-        const uint8_t* pt_data =
-            reinterpret_cast<const uint8_t*>(&input_->points[cp]);
-        float distance_value = 0;
-        memcpy(&distance_value, pt_data + fields[distance_idx].offset,
-               sizeof(float));
-
-        if (filter_limit_negative_) {
-          // Use a threshold for cutting out points which inside the interval
-          if ((distance_value < filter_limit_max_) &&
-              (distance_value > filter_limit_min_)) {
-            continue;
-          }
-        } else {
-          // Use a threshold for cutting out points which are too close/far away
-          if ((distance_value > filter_limit_max_) ||
-              (distance_value < filter_limit_min_)) {
-            continue;
-          }
-        }
-
-        int ijk0 = static_cast<int>(
-            floor(input_->points[cp].x * inverse_leaf_size_[0]) -
-            static_cast<float>(min_b_[0]));
-        int ijk1 = static_cast<int>(
-            floor(input_->points[cp].y * inverse_leaf_size_[1]) -
-            static_cast<float>(min_b_[1]));
-        int ijk2 = static_cast<int>(
-            floor(input_->points[cp].z * inverse_leaf_size_[2]) -
-            static_cast<float>(min_b_[2]));
-        // Compute the centroid leaf index
-        int idx =
-            ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
-
-        Leaf& leaf = leaves_[idx];
-        if (leaf.nr_points_ == 0) {
-          leaf.centroid.resize(centroid_size);
-          leaf.centroid.setZero();
-        }
+      distance_offset = fields[distance_idx].offset;
+    }
 
-        //! added by wangcheng
-        leaf.cloud_.points.push_back(input_->points[cp]);
-
-        Eigen::Vector3d pt3d(input_->points[cp].x, input_->points[cp].y,
-                             input_->points[cp].z);
-        // Accumulate point sum for centroid calculation
-        leaf.mean_ += pt3d;
-        // Accumulate x*xT for single pass covariance calculation
-        leaf.cov_ += pt3d * pt3d.transpose();
-
-        // Do we need to process all the fields?
-        if (!downsample_all_data_) {
-          Eigen::Vector4f pt(input_->points[cp].x, input_->points[cp].y,
-                             input_->points[cp].z, 0);
-          leaf.centroid.template head<4>() += pt;
-        } else {
-          // Copy all the fields
-          Eigen::VectorXf centroid = Eigen::VectorXf::Zero(centroid_size);
-          pcl::for_each_type<FieldList>(pcl::NdCopyPointEigenFunctor<PointT>(
-              input_->points[cp], centroid));
-          // ---[ RGB special case
-          if (rgba_index >= 0) {
-            // Fill r/g/b data, assuming that the order is BGRA
-            const pcl::RGB& rgb = *reinterpret_cast<const pcl::RGB*>(
-                reinterpret_cast<const char*>(&input_->points[cp]) +
-                rgba_index);
-            centroid[centroid_size - 4] = rgb.a;
-            centroid[centroid_size - 3] = rgb.r;
-            centroid[centroid_size - 2] = rgb.g;
-            centroid[centroid_size - 1] = rgb.b;
-          }
-          leaf.centroid += centroid;
-        }
-        ++leaf.nr_points_;
+    // First pass: compute the voxel index of every point, -1 if filtered
+    const size_t point_num = input_->points.size();
+    point_voxel_indices_.resize(point_num);
+    ParallelFor(point_num, [this, distance_offset](size_t begin, size_t end) {
+      for (size_t cp = begin; cp < end; ++cp) {
+        point_voxel_indices_[cp] = ComputeVoxelIndex(cp, distance_offset);
       }
-    } else {  // No distance filtering, process all data
-      // First pass: go over all points and insert them into the right leaf
-      for (size_t cp = 0; cp < input_->points.size(); ++cp) {
-        if (!input_->is_dense) {
-          // Check if the point is invalid
-          if (!pcl_isfinite(input_->points[cp].x) ||
-              !pcl_isfinite(input_->points[cp].y) ||
-              !pcl_isfinite(input_->points[cp].z)) {
-            continue;
-          }
-        }
-        int ijk0 = static_cast<int>(
-            floor(input_->points[cp].x * inverse_leaf_size_[0]) -
-            static_cast<float>(min_b_[0]));
-        int ijk1 = static_cast<int>(
-            floor(input_->points[cp].y * inverse_leaf_size_[1]) -
-            static_cast<float>(min_b_[1]));
-        int ijk2 = static_cast<int>(
-            floor(input_->points[cp].z * inverse_leaf_size_[2]) -
-            static_cast<float>(min_b_[2]));
-
-        // Compute the centroid leaf index
-        int idx =
-            ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
-
-        // int idx = (((input_->points[cp].getArray4fmap () *
-        // inverse_leaf_size_).template cast<int> ()).matrix ()
-        //    - min_b_).dot (divb_mul_);
-
-        Leaf& leaf = leaves_[idx];
-        if (leaf.nr_points_ == 0) {
-          leaf.centroid.resize(centroid_size);
-          leaf.centroid.setZero();
-        }
-
-        //! added by wangcheng
-        leaf.cloud_.points.push_back(input_->points[cp]);
-
-        Eigen::Vector3d pt3d(input_->points[cp].x, input_->points[cp].y,
-                             input_->points[cp].z);
-        // Accumulate point sum for centroid calculation
-        leaf.mean_ += pt3d;
-        // Accumulate x*xT for single pass covariance calculation
-        leaf.cov_ += pt3d * pt3d.transpose();
-
-        // Do we need to process all the fields?
-        if (!downsample_all_data_) {
-          Eigen::Vector4f pt(input_->points[cp].x, input_->points[cp].y,
-                             input_->points[cp].z, 0);
-          leaf.centroid.template head<4>() += pt;
-        } else {
-          // Copy all the fields
-          Eigen::VectorXf centroid = Eigen::VectorXf::Zero(centroid_size);
-          pcl::for_each_type<FieldList>(pcl::NdCopyPointEigenFunctor<PointT>(
-              input_->points[cp], centroid));
-          // ---[ RGB special case
-          if (rgba_index >= 0) {
-            // Fill r/g/b data, assuming that the order is BGRA
-            const pcl::RGB& rgb = *reinterpret_cast<const pcl::RGB*>(
-                reinterpret_cast<const char*>(&input_->points[cp]) +
-                rgba_index);
-            centroid[centroid_size - 4] = rgb.a;
-            centroid[centroid_size - 3] = rgb.r;
-            centroid[centroid_size - 2] = rgb.g;
-            centroid[centroid_size - 1] = rgb.b;
-          }
-          leaf.centroid += centroid;
-        }
-        ++leaf.nr_points_;
+    });
+
+    // Second pass: give the voxels their leaves in the order of the indices,
+    // and bucket the points by leaf in their order
+    leaf_ids_.clear();
+    leaf_voxel_indices_.clear();
+    for (size_t cp = 0; cp < point_num; ++cp) {
+      const int idx = point_voxel_indices_[cp];
+      if (idx >= 0 && leaf_ids_.emplace(idx, 0).second) {
+        leaf_voxel_indices_.push_back(idx);
+      }
+    }
+    std::sort(leaf_voxel_indices_.begin(), leaf_voxel_indices_.end());
+    const size_t leaf_num = leaf_voxel_indices_.size();
+    for (size_t i = 0; i < leaf_num; ++i) {
+      leaf_ids_[leaf_voxel_indices_[i]] = static_cast<int>(i);
+    }
+    leaf_point_offsets_.assign(leaf_num + 1, 0);
+    for (size_t cp = 0; cp < point_num; ++cp) {
+      int& idx = point_voxel_indices_[cp];
+      if (idx >= 0) {
+        idx = leaf_ids_[idx];
+        ++leaf_point_offsets_[idx + 1];
       }
     }
+    for (size_t i = 0; i < leaf_num; ++i) {
+      leaf_point_offsets_[i + 1] += leaf_point_offsets_[i];
+    }
+    leaf_points_.resize(leaf_point_offsets_[leaf_num]);
+    for (size_t cp = 0; cp < point_num; ++cp) {
+      const int leaf_id = point_voxel_indices_[cp];
+      if (leaf_id >= 0) {
+        leaf_points_[leaf_point_offsets_[leaf_id]++] = static_cast<int>(cp);
+      }
+    }
+    // the filling moved every offset to the begin of the next leaf
+    for (size_t i = leaf_num; i > 0; --i) {
+      leaf_point_offsets_[i] = leaf_point_offsets_[i - 1];
+    }
+    leaf_point_offsets_[0] = 0;
+
+    // Third pass: accumulate the leaves and compute their covariance. The
+    // leaves kept from the previous filtering keep their point storage.
+    leaves_.resize(leaf_num);
+    ParallelFor(leaf_num, [this, centroid_size, rgba_index](size_t begin,
+                                                            size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        BuildLeaf(i, centroid_size, rgba_index);
+      }
+    });
 
-    // Second pass: go over all leaves and compute centroids and covariance
-    output->points.reserve(leaves_.size());
+    // Last pass: output the centroids of the leaves with enough points
+    output->points.reserve(leaf_num);
     if (searchable_) {
-      voxel_centroidsleaf_indices_.reserve(leaves_.size());
+      voxel_centroidsleaf_indices_.reserve(leaf_num);
     }
     int cp = 0;
     if (save_leaf_layout_) {
       leaf_layout_.resize(div_b_[0] * div_b_[1] * div_b_[2], -1);
     }
-    // Eigen values and vectors calculated to prevent near singluar matrices
-    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigensolver;
-    Eigen::Matrix3d eigen_val;
-    Eigen::Vector3d pt_sum;
+    for (size_t i = 0; i < leaf_num; ++i) {
+      // the count of the points, which the leaf may have invalidated
+      if (leaf_point_offsets_[i + 1] - leaf_point_offsets_[i] <
+          min_points_per_voxel_) {
+        continue;
+      }
+      const Leaf& leaf = leaves_[i];
+      if (save_leaf_layout_) {
+        leaf_layout_[leaf_voxel_indices_[i]] = cp++;
+      }
+      output->push_back(PointT());
+      // Do we need to process all the fields?
+      if (!downsample_all_data_) {
+        output->points.back().x = leaf.centroid[0];
+        output->points.back().y = leaf.centroid[1];
+        output->points.back().z = leaf.centroid[2];
+      } else {
+        pcl::for_each_type<FieldList>(pcl::NdCopyEigenPointFunctor<PointT>(
+            leaf.centroid, output->back()));
+        // ---[ RGB special case
+        if (rgba_index >= 0) {
+          pcl::RGB& rgb = *reinterpret_cast<pcl::RGB*>(
+              reinterpret_cast<char*>(&output->points.back()) + rgba_index);
+          rgb.a = leaf.centroid[centroid_size - 4];
+          rgb.r = leaf.centroid[centroid_size - 3];
+          rgb.g = leaf.centroid[centroid_size - 2];
+          rgb.b = leaf.centroid[centroid_size - 1];
+        }
+      }
 
-    // Eigen values less than a threshold of max eigen value are
-    // inflated to a set fraction of the max eigen value.
-    double min_covar_eigvalue;
-
-    for (typename std::map<size_t, Leaf>::iterator it = leaves_.begin();
-         it != leaves_.end(); ++it) {
-      // Normalize the centroid
-      Leaf& leaf = it->second;
-
-      // Normalize the centroid
-      leaf.centroid /= static_cast<float>(leaf.nr_points_);
-      // Point sum used for single pass covariance calculation
-      pt_sum = leaf.mean_;
-      // Normalize mean
-      leaf.mean_ /= leaf.nr_points_;
-
-      if (leaf.nr_points_ >= min_points_per_voxel_) {
-        if (save_leaf_layout_) {
-          leaf_layout_[it->first] = cp++;
+      // Stores the voxel indice for fast access searching
+      if (searchable_) {
+        voxel_centroidsleaf_indices_.push_back(leaf_voxel_indices_[i]);
+      }
+    }
+    output->width = static_cast<uint32_t>(output->points.size());
+  }
+
+  // Get the voxel index of the point cp, -1 if the point is filtered out.
+  int ComputeVoxelIndex(size_t cp, int distance_offset) const {
+    const PointT& point = input_->points[cp];
+    if (!input_->is_dense) {
+      // Check if the point is invalid
+      if (!pcl_isfinite(point.x) || !pcl_isfinite(point.y) ||
+          !pcl_isfinite(point.z)) {
+        return -1;
+      }
+    }
+    if (!filter_field_name_.empty()) {
+      // Get the distance value
+      const uint8_t* pt_data = reinterpret_cast<const uint8_t*>(&point);
+      float distance_value = 0;
+      memcpy(&distance_value, pt_data + distance_offset, sizeof(float));
+
+      if (filter_limit_negative_) {
+        // Use a threshold for cutting out points which inside the interval
+        if ((distance_value < filter_limit_max_) &&
+            (distance_value > filter_limit_min_)) {
+          return -1;
         }
-        output->push_back(PointT());
-        // Do we need to process all the fields?
-        if (!downsample_all_data_) {
-          output->points.back().x = leaf.centroid[0];
-          output->points.back().y = leaf.centroid[1];
-          output->points.back().z = leaf.centroid[2];
-        } else {
-          pcl::for_each_type<FieldList>(pcl::NdCopyEigenPointFunctor<PointT>(
-              leaf.centroid, output->back()));
-          // ---[ RGB special case
-          if (rgba_index >= 0) {
-            pcl::RGB& rgb = *reinterpret_cast<pcl::RGB*>(
-                reinterpret_cast<char*>(&output->points.back()) + rgba_index);
-            rgb.a = leaf.centroid[centroid_size - 4];
-            rgb.r = leaf.centroid[centroid_size - 3];
-            rgb.g = leaf.centroid[centroid_size - 2];
-            rgb.b = leaf.centroid[centroid_size - 1];
-          }
+      } else {
+        // Use a threshold for cutting out points which are too close/far away
+        if ((distance_value > filter_limit_max_) ||
+            (distance_value < filter_limit_min_)) {
+          return -1;
         }
+      }
+    }
+    int ijk0 = static_cast<int>(floor(point.x * inverse_leaf_size_[0]) -
+                                static_cast<float>(min_b_[0]));
+    int ijk1 = static_cast<int>(floor(point.y * inverse_leaf_size_[1]) -
+                                static_cast<float>(min_b_[1]));
+    int ijk2 = static_cast<int>(floor(point.z * inverse_leaf_size_[2]) -
+                                static_cast<float>(min_b_[2]));
+    // Compute the centroid leaf index
+    return ijk0 * divb_mul_[0] + ijk1 * divb_mul_[1] + ijk2 * divb_mul_[2];
+  }
 
-        // Stores the voxel indice for fast access searching
-        if (searchable_) {
-          voxel_centroidsleaf_indices_.push_back(static_cast<int>(it->first));
+  // Accumulate the points of the i-th leaf and compute its covariance.
+  void BuildLeaf(size_t i, int centroid_size, int rgba_index) {
+    Leaf& leaf = leaves_[i];
+    // Reset the leaf, keeping the storage of its points
+    leaf.nr_points_ = 0;
+    leaf.mean_.setZero();
+    leaf.centroid.resize(centroid_size);
+    leaf.centroid.setZero();
+    leaf.cov_.setIdentity();
+    leaf.icov_.setZero();
+    leaf.evecs_.setIdentity();
+    leaf.evals_.setZero();
+    leaf.cloud_.points.clear();
+    leaf.cloud_.points.reserve(leaf_point_offsets_[i + 1] -
+                               leaf_point_offsets_[i]);
+
+    for (int k = leaf_point_offsets_[i]; k < leaf_point_offsets_[i + 1]; ++k) {
+      const PointT& point = input_->points[leaf_points_[k]];
+      //! added by wangcheng
+      leaf.cloud_.points.push_back(point);
+
+      Eigen::Vector3d pt3d(point.x, point.y, point.z);
+      // Accumulate point sum for centroid calculation
+      leaf.mean_ += pt3d;
+      // Accumulate x*xT for single pass covariance calculation
+      leaf.cov_ += pt3d * pt3d.transpose();
+
+      // Do we need to process all the fields?
+      if (!downsample_all_data_) {
+        Eigen::Vector4f pt(point.x, point.y, point.z, 0);
+        leaf.centroid.template head<4>() += pt;
+      } else {
+        // Copy all the fields
+        Eigen::VectorXf centroid = Eigen::VectorXf::Zero(centroid_size);
+        pcl::for_each_type<FieldList>(
+            pcl::NdCopyPointEigenFunctor<PointT>(point, centroid));
+        // ---[ RGB special case
+        if (rgba_index >= 0) {
+          // Fill r/g/b data, assuming that the order is BGRA
+          const pcl::RGB& rgb = *reinterpret_cast<const pcl::RGB*>(
+              reinterpret_cast<const char*>(&point) + rgba_index);
+          centroid[centroid_size - 4] = rgb.a;
+          centroid[centroid_size - 3] = rgb.r;
+          centroid[centroid_size - 2] = rgb.g;
+          centroid[centroid_size - 1] = rgb.b;
         }
+        leaf.centroid += centroid;
+      }
+      ++leaf.nr_points_;
+    }
 
-        // Single pass covariance calculation
-        leaf.cov_ = (leaf.cov_ - 2 * (pt_sum * leaf.mean_.transpose())) /
-                        leaf.nr_points_ +
-                    leaf.mean_ * leaf.mean_.transpose();
-        leaf.cov_ *= (leaf.nr_points_ - 1.0) / leaf.nr_points_;
-
-        // Normalize Eigen Val such that max no more than 100x min.
-        eigensolver.compute(leaf.cov_);
-        eigen_val = eigensolver.eigenvalues().asDiagonal();
-        leaf.evecs_ = eigensolver.eigenvectors();
-
-        if (eigen_val(0, 0) < 0 || eigen_val(1, 1) < 0 ||
-            eigen_val(2, 2) <= 0) {
-          leaf.nr_points_ = -1;
-          continue;
-        }
+    // Normalize the centroid
+    leaf.centroid /= static_cast<float>(leaf.nr_points_);
+    // Point sum used for single pass covariance calculation
+    Eigen::Vector3d pt_sum = leaf.mean_;
+    // Normalize mean
+    leaf.mean_ /= leaf.nr_points_;
 
-        // Avoids matrices near singularities (eq 6.11)[Magnusson 2009]
-        min_covar_eigvalue = min_covar_eigvalue_mult_ * eigen_val(2, 2);
-        if (eigen_val(0, 0) < min_covar_eigvalue) {
-          eigen_val(0, 0) = min_covar_eigvalue;
-          if (eigen_val(1, 1) < min_covar_eigvalue) {
-            eigen_val(1, 1) = min_covar_eigvalue;
-          }
-          leaf.cov_ = leaf.evecs_ * eigen_val * leaf.evecs_.inverse();
-        }
-        leaf.evals_ = eigen_val.diagonal();
+    if (leaf.nr_points_ < min_points_per_voxel_) {
+      return;
+    }
+    // Single pass covariance calculation
+    leaf.cov_ = (leaf.cov_ - 2 * (pt_sum * leaf.mean_.transpose())) /
+                    leaf.nr_points_ +
+                leaf.mean_ * leaf.mean_.transpose();
+    leaf.cov_ *= (leaf.nr_points_ - 1.0) / leaf.nr_points_;
 
-        leaf.icov_ = leaf.cov_.inverse();
-        if (leaf.icov_.maxCoeff() == std::numeric_limits<float>::infinity() ||
-            leaf.icov_.minCoeff() == -std::numeric_limits<float>::infinity()) {
-          leaf.nr_points_ = -1;
-        }
+    // Eigen values and vectors calculated to prevent near singluar matrices
+    // Normalize Eigen Val such that max no more than 100x min.
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigensolver;
+    eigensolver.compute(leaf.cov_);
+    Eigen::Matrix3d eigen_val = eigensolver.eigenvalues().asDiagonal();
+    leaf.evecs_ = eigensolver.eigenvectors();
+
+    if (eigen_val(0, 0) < 0 || eigen_val(1, 1) < 0 || eigen_val(2, 2) <= 0) {
+      leaf.nr_points_ = -1;
+      return;
+    }
+
+    // Eigen values less than a threshold of max eigen value are
+    // inflated to a set fraction of the max eigen value.
+    // Avoids matrices near singularities (eq 6.11)[Magnusson 2009]
+    double min_covar_eigvalue = min_covar_eigvalue_mult_ * eigen_val(2, 2);
+    if (eigen_val(0, 0) < min_covar_eigvalue) {
+      eigen_val(0, 0) = min_covar_eigvalue;
+      if (eigen_val(1, 1) < min_covar_eigvalue) {
+        eigen_val(1, 1) = min_covar_eigvalue;
       }
+      leaf.cov_ = leaf.evecs_ * eigen_val * leaf.evecs_.inverse();
+    }
+    leaf.evals_ = eigen_val.diagonal();
+
+    leaf.icov_ = leaf.cov_.inverse();
+    if (leaf.icov_.maxCoeff() == std::numeric_limits<float>::infinity() ||
+        leaf.icov_.minCoeff() == -std::numeric_limits<float>::infinity()) {
+      leaf.nr_points_ = -1;
     }
-    output->width = static_cast<uint32_t>(output->points.size());
   }
 
   // Flag to determine if voxel structure is searchable. */
@@ -606,8 +627,23 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
   // Minimum allowable ratio between eigenvalues.
   double min_covar_eigvalue_mult_;
 
-  // Voxel structure containing all leaf nodes.
-  std::map<size_t, Leaf> leaves_;
+  // Voxel structure containing all leaf nodes, in the order of the voxel
+  // indices. It is kept between the filterings to reuse the leaf storage.
+  LeafVector leaves_;
+
+  // The voxel index of every leaf.
+  std::vector<int> leaf_voxel_indices_;
+
+  // The leaf of every voxel index.
+  std::unordered_map<int, int> leaf_ids_;
+
+  // The voxel, then the leaf of every input point, -1 if filtered out.
+  std::vector<int> point_voxel_indices_;
+
+  // The input points of the leaves, from leaf_point_offsets_[i] to
+  // leaf_point_offsets_[i + 1] for the i-th leaf.
+  std::vector<int> leaf_points_;
+  std::vector<int> leaf_point_offsets_;
 
   /* Point cloud containing centroids of voxels
    * containing atleast minimum number of points. */
@@ -619,6 +655,10 @@ class VoxelGridCovariance : public pcl::VoxelGrid<PointT> {
 
   // KdTree used for searching.
   pcl::KdTreeFLANN<PointT> kdtree_;
+
+  // The threads building the leaves, none with one thread.
+  unsigned int thread_num_;
+  std::unique_ptr<ThreadPool> pool_;
 };
 
 }  // namespace msf
@@ -16,6 +16,13 @@
 
 #include "modules/localization/msf/local_map/base_map/base_map.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
 #include "modules/common/log.h"
 #include "modules/localization/msf/common/util/system_utility.h"
 
@@ -29,7 +36,8 @@ BaseMap::BaseMap(BaseMapConfig* map_config)
       map_node_cache_lvl2_(nullptr),
       map_node_pool_(nullptr),
       p_map_load_threads_(nullptr),
-      p_map_preload_threads_(nullptr) {}
+      p_map_preload_threads_(nullptr),
+      preload_lookahead_frames_(10) {}
 
 BaseMap::~BaseMap() {
   if (p_map_load_threads_) {
@@ -113,6 +121,11 @@ bool BaseMap::IsMapNodeExist(const MapNodeIndex& index) const {
   return map_node_cache_lvl1_->IsExist(index);
 }
 
+MapNodeLoadStat BaseMap::GetLoadStat() {
+  boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+  return load_stat_;
+}
+
 bool BaseMap::SetMapFolderPath(const std::string folder_path) {
   map_config_->map_folder_path_ = folder_path;
 
@@ -135,37 +148,59 @@ void BaseMap::AddDataset(const std::string dataset_path) {
 void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
   CHECK_LE(static_cast<int>(map_ids->size()), map_node_cache_lvl1_->Capacity());
   // std::cout << "LoadMapNodes size: " << map_ids->size() << std::endl;
-  // check in cacheL1
+  // check in cacheL1, which only this thread uses. The nodes in it are
+  // reserved in the cacheL2, so refreshing their order in the lru list of the
+  // cacheL2 is skipped rather than waiting for a loading thread.
+  boost::unique_lock<boost::recursive_mutex> fresh_lock(map_load_mutex_,
+                                                        boost::try_to_lock);
+  unsigned int cache_l1_hits = 0;
   typename std::set<MapNodeIndex>::iterator itr = map_ids->begin();
   while (itr != map_ids->end()) {
     if (map_node_cache_lvl1_->IsExist(*itr)) {
       // std::cout << "LoadMapNodes find in L1 cache" << std::endl;
-      boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
-      map_node_cache_lvl2_->IsExist(*itr);  // fresh lru list
-      lock.unlock();
+      if (fresh_lock.owns_lock()) {
+        map_node_cache_lvl2_->IsExist(*itr);  // fresh lru list
+      }
+      ++cache_l1_hits;
       itr = map_ids->erase(itr);
     } else {
       ++itr;
     }
   }
+  if (fresh_lock.owns_lock()) {
+    fresh_lock.unlock();
+  }
 
   // check in cacheL2
   itr = map_ids->begin();
   BaseMapNode* node = nullptr;
   boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
+  load_stat_.cache_l1_hits += cache_l1_hits;
   while (itr != map_ids->end()) {
     if (map_node_cache_lvl2_->Get(*itr, &node)) {
       // std::cout << "LoadMapNodes find in L2 cache" << std::endl;
       node->SetIsReserved(true);
       map_node_cache_lvl1_->Put(*itr, node);
+      ++load_stat_.cache_l2_hits;
       itr = map_ids->erase(itr);
     } else {
+      // the preload of the node is late or the node is not preloaded
+      if (map_preloading_task_index_.find(*itr) !=
+          map_preloading_task_index_.end()) {
+        ++load_stat_.preload_waits;
+      } else {
+        ++load_stat_.cache_misses;
+      }
       ++itr;
     }
   }
   lock.unlock();
+  if (map_ids->empty()) {
+    return;
+  }
 
   // load from disk sync
+  const auto stall_start = std::chrono::steady_clock::now();
   itr = map_ids->begin();
   while (itr != map_ids->end()) {
     p_map_load_threads_->schedule(
@@ -176,6 +211,12 @@ void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
   // std::cout << "before wait" << std::endl;
   p_map_load_threads_->wait();
   // std::cout << "after wait" << std::endl;
+  const double stall_ms =
+      std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - stall_start)
+          .count();
+  AWARN << "LoadMapNodes: waited " << stall_ms << " ms for "
+        << map_ids->size() << " map nodes not in cache.";
 
   // check in cacheL2 again
   itr = map_ids->begin();
@@ -193,6 +234,9 @@ void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
       ++itr;
     }
   }
+  ++load_stat_.stalls;
+  load_stat_.total_stall_ms += stall_ms;
+  load_stat_.max_stall_ms = std::max(load_stat_.max_stall_ms, stall_ms);
   lock2.unlock();
 
   CHECK(map_ids->empty());
@@ -202,41 +246,29 @@ void BaseMap::LoadMapNodes(std::set<MapNodeIndex>* map_ids) {
 void BaseMap::PreloadMapNodes(std::set<MapNodeIndex>* map_ids) {
   DCHECK_LE(static_cast<int>(map_ids->size()),
             map_node_cache_lvl2_->Capacity());
-  // check in cacheL2
+  // check in cacheL2 and whether in already preloading index set, in one
+  // hold of the lock the loading threads take too
+  boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
   typename std::set<MapNodeIndex>::iterator itr = map_ids->begin();
   while (itr != map_ids->end()) {
-    boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
-    bool is_exist = map_node_cache_lvl2_->IsExist(*itr);
-    lock.unlock();
-    if (is_exist) {
-      itr = map_ids->erase(itr);
-    } else {
-      ++itr;
-    }
-  }
-
-  // check whether in already preloading index set
-  itr = map_ids->begin();
-  auto preloading_itr = map_preloading_task_index_.end();
-  while (itr != map_ids->end()) {
-    boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
-    preloading_itr = map_preloading_task_index_.find(*itr);
-    lock.unlock();
-    if (preloading_itr !=
-        map_preloading_task_index_.end()) {  // already preloading
+    if (map_node_cache_lvl2_->IsExist(*itr) ||
+        map_preloading_task_index_.find(*itr) !=
+            map_preloading_task_index_.end()) {  // already preloading
       itr = map_ids->erase(itr);
     } else {
+      map_preloading_task_index_.insert(*itr);
       ++itr;
     }
   }
+  lock.unlock();
 
   // load form disk sync
   itr = map_ids->begin();
   while (itr != map_ids->end()) {
     AINFO << "Preload map node: " << *itr;
-    boost::unique_lock<boost::recursive_mutex> lock(map_load_mutex_);
-    map_preloading_task_index_.insert(*itr);
-    lock.unlock();
+    // the reads of all the nodes are queued in the kernel at once, even if
+    // the preloading threads are busy
+    ReadaheadMapNode(*itr);
     p_map_preload_threads_->schedule(
         boost::bind(&BaseMap::LoadMapNodeThreadSafety, this, *itr, false));
     ++itr;
@@ -249,7 +281,36 @@ void BaseMap::AttachMapNodePool(BaseMapNodePool* map_node_pool) {
   map_node_pool_ = map_node_pool;
 }
 
+void BaseMap::ReadaheadMapNode(const MapNodeIndex& index) {
+  std::string path;
+  if (!BaseMapNode::GetNodeFilePath(*map_config_, index, &path)) {
+    return;
+  }
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+  posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+  close(fd);
+}
+
 void BaseMap::LoadMapNodeThreadSafety(MapNodeIndex index, bool is_reserved) {
+  boost::unique_lock<boost::recursive_mutex> loading_lock(map_load_mutex_);
+  // don't read a node twice when the main thread needs a node which is
+  // still preloading, wait for the preload instead
+  while (map_loading_index_.find(index) != map_loading_index_.end()) {
+    if (!is_reserved) {
+      return;
+    }
+    map_loaded_condition_.wait(loading_lock);
+  }
+  if (map_node_cache_lvl2_->IsExist(index)) {
+    map_preloading_task_index_.erase(index);
+    return;
+  }
+  map_loading_index_.insert(index);
+  loading_lock.unlock();
+
   BaseMapNode* map_node = nullptr;
   while (map_node == nullptr) {
     map_node = map_node_pool_->AllocMapNode();
@@ -279,6 +340,8 @@ void BaseMap::LoadMapNodeThreadSafety(MapNodeIndex index, bool is_reserved) {
   if (node_remove) {
     map_node_pool_->FreeMapNode(node_remove);
   }
+  map_loading_index_.erase(index);
+  map_loaded_condition_.notify_all();
   return;
 }
 
@@ -415,6 +478,39 @@ void BaseMap::PreloadMapArea(const Eigen::Vector3d& location,
     map_ids.insert(map_id);
   }
 
+  // the nodes on the way of the next frames, predicted by the heading and the
+  // moving distance of a frame, from the nearest one
+  const double node_size_x =
+      this->map_config_->map_node_size_x_ * map_pixel_resolution;
+  const double node_size_y =
+      this->map_config_->map_node_size_y_ * map_pixel_resolution;
+  const double frame_distance =
+      std::sqrt(trans_diff[0] * trans_diff[0] + trans_diff[1] * trans_diff[1]);
+  const double lookahead_distance = frame_distance * preload_lookahead_frames_;
+  const double step = 0.5 * std::min(node_size_x, node_size_y);
+  const size_t max_preload_num =
+      static_cast<size_t>(map_node_cache_lvl2_->Capacity());
+  for (double distance = step;
+       frame_distance > 0.0 && distance <= lookahead_distance;
+       distance += step) {
+    const Eigen::Vector3d center =
+        location + trans_diff * (distance / frame_distance);
+    // the corners of the area LoadMapArea will load around the center
+    for (int i = -1; i < 2; i += 2) {
+      for (int j = -1; j < 2; j += 2) {
+        Eigen::Vector3d pt;
+        pt[0] = center[0] + i * node_size_x / 2.0;
+        pt[1] = center[1] + j * node_size_y / 2.0;
+        pt[2] = 0;
+        map_id = MapNodeIndex::GetMapNodeIndex(*(this->map_config_), pt,
+                                               resolution_id, zone_id);
+        if (map_ids.size() < max_preload_num) {
+          map_ids.insert(map_id);
+        }
+      }
+    }
+  }
+
   this->PreloadMapNodes(&map_ids);
   return;
 }
@@ -33,6 +33,23 @@ namespace apollo {
 namespace localization {
 namespace msf {
 
+/**@brief The statistics of the map node loads of LoadMapArea. */
+struct MapNodeLoadStat {
+  /**@brief The number of the nodes found in the cacheL1. */
+  unsigned int cache_l1_hits = 0;
+  /**@brief The number of the nodes found in the cacheL2. */
+  unsigned int cache_l2_hits = 0;
+  /**@brief The number of the nodes still preloading when they are needed. */
+  unsigned int preload_waits = 0;
+  /**@brief The number of the nodes not preloaded at all. */
+  unsigned int cache_misses = 0;
+  /**@brief The number of the LoadMapArea calls waiting for the disk. */
+  unsigned int stalls = 0;
+  /**@brief The total and the longest waiting time in ms. */
+  double total_stall_ms = 0.0;
+  double max_stall_ms = 0.0;
+};
+
 /**@brief The data structure of the base map. */
 class BaseMap {
  public:
@@ -76,6 +93,14 @@ class BaseMap {
                            unsigned int resolution_id, unsigned int zone_id,
                            int filter_size_x, int filter_size_y);
 
+  /**@brief Set the number of the next frames whose map nodes are preloaded
+   * along the heading, by the moving distance of a frame. */
+  void SetPreloadLookaheadFrames(int frames) {
+    preload_lookahead_frames_ = frames;
+  }
+  /**@brief Get the statistics of the map node loads. */
+  MapNodeLoadStat GetLoadStat();
+
   /**@brief Attach map node pointer. */
   void AttachMapNodePool(BaseMapNodePool* p_map_node_pool);
 
@@ -104,6 +129,9 @@ class BaseMap {
   void PreloadMapNodes(std::set<MapNodeIndex>* map_ids);
   /**@brief Load map node by index, thread_safety. */
   void LoadMapNodeThreadSafety(MapNodeIndex index, bool is_reserved = false);
+  /**@brief Ask the kernel to read the file of the map node ahead, so the
+   * preloading thread finds it in the page cache. */
+  void ReadaheadMapNode(const MapNodeIndex& index);
 
   /**@brief The map settings. */
   BaseMapConfig* map_config_;
@@ -122,8 +150,16 @@ class BaseMap {
   ThreadPool* p_map_preload_threads_;
   /**@bried Keep the index of preloading nodes. */
   std::set<MapNodeIndex> map_preloading_task_index_;
+  /**@bried Keep the index of the nodes being read from the disk. */
+  std::set<MapNodeIndex> map_loading_index_;
   /**@brief The mutex for preload map node. **/
   boost::recursive_mutex map_load_mutex_;
+  /**@brief Notified when a node is read from the disk. */
+  boost::condition_variable_any map_loaded_condition_;
+  /**@brief The number of the next frames to preload the map nodes for. */
+  int preload_lookahead_frames_;
+  /**@brief The statistics of the map node loads. */
+  MapNodeLoadStat load_stat_;
 };
 
 }  // namespace msf
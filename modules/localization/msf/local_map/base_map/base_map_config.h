@@ -65,6 +65,8 @@ class BaseMapConfig {
   float map_ground_height_offset_;
   /**@brief Enable the compression. */
   bool map_is_compression_;
+  /**@brief The codec of the compressed map nodes, "zlib" or "lz4". */
+  std::string map_compression_codec_;
 
   /**@brief The map folder path. */
   std::string map_folder_path_;
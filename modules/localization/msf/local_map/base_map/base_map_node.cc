@@ -51,6 +51,20 @@ void BaseMapNode::Init(const BaseMapConfig* map_config,
   is_reserved_ = false;
   data_is_ready_ = false;
   is_changed_ = false;
+  // the node types are constructed with zlib, switch to the codec of the map
+  if (compression_strategy_ != nullptr &&
+      compression_codec_ != map_config_->map_compression_codec_) {
+    CompressionStrategy* strategy =
+        CreateCompressionStrategy(map_config_->map_compression_codec_);
+    if (strategy == nullptr) {
+      AERROR << "Unknown map compression codec: "
+             << map_config_->map_compression_codec_;
+    } else {
+      delete compression_strategy_;
+      compression_strategy_ = strategy;
+      compression_codec_ = map_config_->map_compression_codec_;
+    }
+  }
   if (create_map_cells) {
     InitMapMatrix(map_config_);
   }
@@ -134,8 +148,18 @@ bool BaseMapNode::Save() {
 }
 
 bool BaseMapNode::Load() {
+  std::string path;
+  if (!GetNodeFilePath(*map_config_, index_, &path)) {
+    return false;
+  }
+  return Load(path.c_str());
+}
+
+bool BaseMapNode::GetNodeFilePath(const BaseMapConfig& option,
+                                  const MapNodeIndex& index,
+                                  std::string* file_path) {
   char buf[1024];
-  std::string path = map_config_->map_folder_path_;
+  std::string path = option.map_folder_path_;
   if (!DirectoryExists(path)) {
     return false;
   }
@@ -143,12 +167,12 @@ bool BaseMapNode::Load() {
   if (!DirectoryExists(path)) {
     return false;
   }
-  snprintf(buf, sizeof(buf), "/%03u", index_.resolution_id_);
+  snprintf(buf, sizeof(buf), "/%03u", index.resolution_id_);
   path = path + buf;
   if (!DirectoryExists(path)) {
     return false;
   }
-  if (index_.zone_id_ > 0) {
+  if (index.zone_id_ > 0) {
     path = path + "/north";
   } else {
     path = path + "/south";
@@ -156,20 +180,19 @@ bool BaseMapNode::Load() {
   if (!DirectoryExists(path)) {
     return false;
   }
-  snprintf(buf, sizeof(buf), "/%02d", abs(index_.zone_id_));
+  snprintf(buf, sizeof(buf), "/%02d", abs(index.zone_id_));
   path = path + buf;
   if (!DirectoryExists(path)) {
     return false;
   }
-  snprintf(buf, sizeof(buf), "/%08u", abs(index_.m_));
+  snprintf(buf, sizeof(buf), "/%08u", abs(index.m_));
   path = path + buf;
   if (!DirectoryExists(path)) {
     return false;
   }
-  snprintf(buf, sizeof(buf), "/%08u", abs(index_.n_));
-  path = path + buf;
-
-  return Load(path.c_str());
+  snprintf(buf, sizeof(buf), "/%08u", abs(index.n_));
+  *file_path = path + buf;
+  return true;
 }
 
 bool BaseMapNode::Load(const char* filename) {
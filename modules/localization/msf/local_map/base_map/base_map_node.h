@@ -127,6 +127,10 @@ class BaseMapNode {
   //                                                      index);
   static Eigen::Vector2d GetLeftTopCorner(const BaseMapConfig& option,
                                           const MapNodeIndex& index);
+  /**@brief Get the path of the file of the map node in the map folder.
+   * @param <return> False if a directory of the path doesn't exist. */
+  static bool GetNodeFilePath(const BaseMapConfig& option,
+                              const MapNodeIndex& index, std::string* path);
 
  protected:
   /**@brief Load the map cell from a binary chunk.
@@ -186,6 +190,8 @@ class BaseMapNode {
   mutable unsigned int file_body_binary_size_ = 0;
   /**@bried The compression strategy. */
   CompressionStrategy* compression_strategy_ = nullptr;
+  /**@brief The codec of the compression strategy. */
+  std::string compression_codec_ = "zlib";
   /**@brief The min altitude of point cloud in the node. */
   float min_altitude_ = 1e6;
 };
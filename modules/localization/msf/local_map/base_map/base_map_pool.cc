@@ -27,7 +27,14 @@ namespace msf {
 
 BaseMapNodePool::BaseMapNodePool(unsigned int pool_size,
                                  unsigned int thread_size)
-    : pool_size_(pool_size), node_reset_workers_(thread_size) {}
+    : slot_num_(0),
+      free_head_(kNullSlot),
+      pool_size_(pool_size),
+      node_reset_workers_(thread_size) {
+  for (unsigned int i = 0; i < kMaxSlotBlocks; ++i) {
+    slot_blocks_[i].store(nullptr);
+  }
+}
 
 BaseMapNodePool::~BaseMapNodePool() { Release(); }
 
@@ -38,49 +45,44 @@ void BaseMapNodePool::Initial(const BaseMapConfig* map_config,
   for (unsigned int i = 0; i < pool_size_; ++i) {
     BaseMapNode* node = AllocNewMapNode();
     InitNewMapNode(node);
-    free_list_.push_back(node);
+    PushFreeSlot(AddSlot(node));
   }
 }
 
 void BaseMapNodePool::Release() {
   node_reset_workers_.wait();
-  typename std::list<BaseMapNode*>::iterator i = free_list_.begin();
-  while (i != free_list_.end()) {
-    FinalizeMapNode(*i);
-    DellocMapNode(*i);
-    i++;
+  boost::unique_lock<boost::mutex> lock(mutex_);
+  const unsigned int slot_num = slot_num_.load();
+  for (unsigned int i = 0; i < slot_num; ++i) {
+    FinalizeMapNode(GetSlot(i)->node);
+    DellocMapNode(GetSlot(i)->node);
   }
-  free_list_.clear();
-  typename std::set<BaseMapNode*>::iterator j = busy_nodes_.begin();
-  while (j != busy_nodes_.end()) {
-    FinalizeMapNode(*j);
-    DellocMapNode(*j);
-    j++;
+  for (unsigned int i = 0; i < kMaxSlotBlocks; ++i) {
+    delete[] slot_blocks_[i].exchange(nullptr);
   }
-  busy_nodes_.clear();
+  slot_num_.store(0);
+  free_head_.store(kNullSlot);
   pool_size_ = 0;
 }
 
 BaseMapNode* BaseMapNodePool::AllocMapNode() {
-  if (free_list_.empty()) {
+  unsigned int index = PopFreeSlot();
+  if (index == kNullSlot) {
     node_reset_workers_.wait();
+    index = PopFreeSlot();
   }
-  boost::unique_lock<boost::mutex> lock(mutex_);
-  if (free_list_.empty()) {
-    if (is_fixed_size_) {
-      return NULL;
-    }
-    BaseMapNode* node = AllocNewMapNode();
-    InitNewMapNode(node);
-    pool_size_++;
-    busy_nodes_.insert(node);
-    return node;
-  } else {
-    BaseMapNode* node = free_list_.front();
-    free_list_.pop_front();
-    busy_nodes_.insert(node);
-    return node;
+  if (index != kNullSlot) {
+    return GetSlot(index)->node;
+  }
+  if (is_fixed_size_) {
+    return NULL;
   }
+  BaseMapNode* node = AllocNewMapNode();
+  InitNewMapNode(node);
+  boost::unique_lock<boost::mutex> lock(mutex_);
+  AddSlot(node);
+  pool_size_++;
+  return node;
 }
 
 void BaseMapNodePool::FreeMapNode(BaseMapNode* map_node) {
@@ -91,12 +93,61 @@ void BaseMapNodePool::FreeMapNode(BaseMapNode* map_node) {
 void BaseMapNodePool::FreeMapNodeTask(BaseMapNode* map_node) {
   FinalizeMapNode(map_node);
   ResetMapNode(map_node);
-  {
-    boost::unique_lock<boost::mutex> lock(mutex_);
-    typename std::set<BaseMapNode*>::iterator f = busy_nodes_.find(map_node);
-    DCHECK(f != busy_nodes_.end());
-    free_list_.push_back(*f);
-    busy_nodes_.erase(f);
+  // the pool is small, finding the slot of the node is cheaper than the reset
+  const unsigned int slot_num = slot_num_.load();
+  for (unsigned int i = 0; i < slot_num; ++i) {
+    if (GetSlot(i)->node == map_node) {
+      PushFreeSlot(i);
+      return;
+    }
+  }
+  DCHECK(false) << "The map node is not from the pool.";
+}
+
+unsigned int BaseMapNodePool::AddSlot(BaseMapNode* node) {
+  const unsigned int index = slot_num_.load();
+  const unsigned int block = index / kSlotBlockSize;
+  CHECK_LT(block, kMaxSlotBlocks);
+  if (slot_blocks_[block].load() == nullptr) {
+    slot_blocks_[block].store(new FreeListSlot[kSlotBlockSize]);
+  }
+  FreeListSlot* slot = GetSlot(index);
+  slot->node = node;
+  slot->next.store(kNullSlot);
+  // the slot is complete when the other threads see it
+  slot_num_.store(index + 1);
+  return index;
+}
+
+BaseMapNodePool::FreeListSlot* BaseMapNodePool::GetSlot(
+    unsigned int index) const {
+  return &slot_blocks_[index / kSlotBlockSize].load()[index % kSlotBlockSize];
+}
+
+void BaseMapNodePool::PushFreeSlot(unsigned int index) {
+  FreeListSlot* slot = GetSlot(index);
+  uint64_t head = free_head_.load();
+  uint64_t new_head = 0;
+  do {
+    slot->next.store(static_cast<unsigned int>(head));
+    new_head = (((head >> 32) + 1) << 32) | index;
+  } while (!free_head_.compare_exchange_weak(head, new_head));
+}
+
+unsigned int BaseMapNodePool::PopFreeSlot() {
+  uint64_t head = free_head_.load();
+  while (true) {
+    const unsigned int index = static_cast<unsigned int>(head);
+    if (index == kNullSlot) {
+      return kNullSlot;
+    }
+    // the slot may be popped by another thread meanwhile, then its next is
+    // stale, but the tag of the head has changed and the swap fails
+    const unsigned int next = GetSlot(index)->next.load();
+    const uint64_t new_head = (((head >> 32) + 1) << 32) | next;
+    if (free_head_.compare_exchange_weak(head, new_head)) {
+      return index;
+    }
   }
 }
 
@@ -17,8 +17,8 @@
 #ifndef MODULES_LOCALIZATION_MSF_LOCAL_MAP_BASE_MAP_BASE_MAP_POOL_H
 #define MODULES_LOCALIZATION_MSF_LOCAL_MAP_BASE_MAP_BASE_MAP_POOL_H
 
-#include <list>
-#include <set>
+#include <atomic>
+#include <cstdint>
 
 #include "boost/thread.hpp"
 
@@ -73,18 +73,42 @@ class BaseMapNodePool {
   /**@brief reset a map node. */
   virtual void ResetMapNode(BaseMapNode* node);
 
+  /**@brief A map node of the pool, linked in the free list when it's free. */
+  struct FreeListSlot {
+    BaseMapNode* node = nullptr;
+    std::atomic<unsigned int> next;
+  };
+  static const unsigned int kNullSlot = 0xffffffff;
+  static const unsigned int kSlotBlockSize = 64;
+  static const unsigned int kMaxSlotBlocks = 256;
+
+  /**@brief Add a map node to the pool in a new slot, as a busy node. */
+  unsigned int AddSlot(BaseMapNode* node);
+  /**@brief Get the slot of the index. */
+  FreeListSlot* GetSlot(unsigned int index) const;
+  /**@brief Push the slot of a free node to the free list. */
+  void PushFreeSlot(unsigned int index);
+  /**@brief Pop a slot from the free list, or kNullSlot if it is empty. */
+  unsigned int PopFreeSlot();
+
  protected:
   /**@brief The flag of pool auto expand. */
   bool is_fixed_size_;
-  /**@brief The list for free node. */
-  std::list<BaseMapNode*> free_list_;
-  /**@brief The set for used node. */
-  std::set<BaseMapNode*> busy_nodes_;
+  /**@brief The slots of all the nodes, in blocks which never move, so the
+   * free list works on them without lock while the pool expands. */
+  std::atomic<FreeListSlot*> slot_blocks_[kMaxSlotBlocks];
+  /**@brief The number of slots. */
+  std::atomic<unsigned int> slot_num_;
+  /**@brief The head of the lock-free free list: the index of the first free
+   * slot in the low 32 bits, and a tag counting the changes in the high 32
+   * bits, so a pop never succeeds on a head popped and pushed back since it
+   * was read. */
+  std::atomic<uint64_t> free_head_;
   /**@brief The size of memory pool. */
   unsigned int pool_size_;
   /**@brief The thread pool for release node. */
   ThreadPool node_reset_workers_;
-  /**@brief The mutex for release thread.*/
+  /**@brief The mutex for expanding the pool. */
   boost::mutex mutex_;
   /**@brief The mutex for release thread.*/
   const BaseMapConfig* map_config_;
@@ -27,6 +27,7 @@ LossyMapConfig2D::LossyMapConfig2D(std::string map_version)
   map_cache_size_ = 50;            // 80
   max_intensity_value_ = 255.0;
   max_intensity_var_value_ = 1000.0;
+  map_is_compact_ = false;
   map_is_compression_ = true;
   map_ground_height_offset_ = 1.7;  // Set the initial value here.
 }
@@ -38,6 +39,7 @@ void LossyMapConfig2D::CreateXml(boost::property_tree::ptree* config) const {
   config->put("map.map_runtime.max_intensity_value", max_intensity_value_);
   config->put("map.map_runtime.max_intensity_var_value",
              max_intensity_var_value_);
+  config->put("map.map_runtime.compact", map_is_compact_);
   return;
 }
 
@@ -49,6 +51,7 @@ void LossyMapConfig2D::LoadXml(const boost::property_tree::ptree& config) {
       config.get<float>("map.map_runtime.max_intensity_value");
   max_intensity_var_value_ =
       config.get<float>("map.map_runtime.max_intensity_var_value");
+  map_is_compact_ = config.get<bool>("map.map_runtime.compact", false);
   return;
 }
 
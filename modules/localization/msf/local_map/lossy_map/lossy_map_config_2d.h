@@ -43,6 +43,11 @@ class LossyMapConfig2D : public BaseMapConfig {
   /**@brief During the visualization (for example, call the function get_image()
    * of map node layer), the maximum intensity variance value in the image. */
   float max_intensity_var_value_;
+  /**@brief Keep the cells of the loaded map nodes as the quantized planes of
+   * the map files instead of float cells, which takes a third of the memory.
+   * The cells of a compact node are read only, through LossyMapMatrix2D
+   * GetCell(). */
+  bool map_is_compact_;
 
  protected:
   /**@brief Create the XML structure. */
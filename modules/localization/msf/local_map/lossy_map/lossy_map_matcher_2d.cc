@@ -0,0 +1,310 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_matcher_2d.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <utility>
+#include "Eigen/Core"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+LossyMapMatcher2D::LossyMapMatcher2D(unsigned int thread_num)
+    : thread_num_(std::max(thread_num, 1u)) {
+  if (thread_num_ > 1) {
+    pool_.reset(new ThreadPool(thread_num_));
+  }
+}
+
+LossyMapMatcher2D::~LossyMapMatcher2D() {}
+
+bool LossyMapMatcher2D::Match(const LossyMapMatrix2D& map,
+                              const LossyMapMatrix2D& frame, int frame_row,
+                              int frame_col, int window_radius,
+                              LossyMapMatchResult2D* result) {
+  if (window_radius < 0) {
+    return false;
+  }
+  const auto start_time = std::chrono::steady_clock::now();
+  CopyFrame(frame);
+  MatchWindow(map, frame_row, frame_col, window_radius, result);
+  RecordTime(start_time, result);
+  return true;
+}
+
+bool LossyMapMatcher2D::MatchCoarseToFine(
+    const std::vector<const LossyMapMatrix2D*>& map_levels,
+    const std::vector<const LossyMapMatrix2D*>& frame_levels, int frame_row,
+    int frame_col, int window_radius, int candidate_num,
+    LossyMapMatchResult2D* result) {
+  if (window_radius < 0 || candidate_num < 1 || map_levels.empty() ||
+      frame_levels.empty()) {
+    return false;
+  }
+  const auto start_time = std::chrono::steady_clock::now();
+  // A coarse offset covers two offsets of the next finer level, and the
+  // rounding of the frame position to the coarse cells may shift it by one
+  // more, so a candidate is refined over the offsets [-2, 2] around it.
+  const int refine_radius = 2;
+  const int level_num =
+      static_cast<int>(std::min(map_levels.size(), frame_levels.size()));
+
+  // the best offsets of the level before, at its resolution
+  std::vector<std::pair<int, int>> candidates;
+  int coarse_row = 0;
+  int coarse_col = 0;
+  unsigned int offset_num = 0;
+  LossyMapMatchResult2D window;
+  for (int level = level_num - 1; level >= 0; --level) {
+    // the first cell of the frame, rounded down to the cells of the level
+    const int scale = 1 << level;
+    const int level_row =
+        frame_row >= 0 ? frame_row / scale : -((scale - 1 - frame_row) / scale);
+    const int level_col =
+        frame_col >= 0 ? frame_col / scale : -((scale - 1 - frame_col) / scale);
+    // the coarse levels search one more cell for the rounding
+    const int radius = level == 0 ? window_radius : window_radius / scale + 1;
+    const int size = 2 * radius + 1;
+    result->window_radius = radius;
+    result->costs.assign(size * size, -1.0);
+    result->overlaps.assign(size * size, 0);
+
+    CopyFrame(*frame_levels[level]);
+    if (level == level_num - 1) {
+      candidates.assign(1, std::make_pair(0, 0));
+    } else {
+      for (auto& candidate : candidates) {
+        candidate.first = 2 * (coarse_row + candidate.first) - level_row;
+        candidate.second = 2 * (coarse_col + candidate.second) - level_col;
+      }
+    }
+    for (const auto& candidate : candidates) {
+      const int search_radius =
+          level == level_num - 1 ? radius : refine_radius;
+      MatchWindow(*map_levels[level], level_row + candidate.first,
+                  level_col + candidate.second, search_radius, &window);
+      const int window_size = 2 * search_radius + 1;
+      offset_num += window_size * window_size;
+      for (int i = 0; i < window_size * window_size; ++i) {
+        const int dy = candidate.first + i / window_size - search_radius;
+        const int dx = candidate.second + i % window_size - search_radius;
+        if (window.overlaps[i] == 0 || std::abs(dy) > radius ||
+            std::abs(dx) > radius) {
+          continue;
+        }
+        const int index = (dy + radius) * size + dx + radius;
+        result->costs[index] = window.costs[i];
+        result->overlaps[index] = window.overlaps[i];
+      }
+    }
+
+    // keep the best offsets of the level as the candidates of the next one
+    std::vector<int> indices;
+    for (int i = 0; i < size * size; ++i) {
+      if (result->overlaps[i] > 0) {
+        indices.push_back(i);
+      }
+    }
+    const size_t best_num =
+        std::min(indices.size(), static_cast<size_t>(candidate_num));
+    std::partial_sort(indices.begin(), indices.begin() + best_num,
+                      indices.end(), [result](int lhs, int rhs) {
+                        return result->costs[lhs] < result->costs[rhs];
+                      });
+    candidates.clear();
+    for (size_t i = 0; i < best_num; ++i) {
+      candidates.emplace_back(indices[i] / size - radius,
+                              indices[i] % size - radius);
+    }
+    coarse_row = level_row;
+    coarse_col = level_col;
+  }
+
+  result->best_cost = -1.0;
+  result->best_dx = 0;
+  result->best_dy = 0;
+  if (!candidates.empty()) {
+    const int size = 2 * window_radius + 1;
+    result->best_dy = candidates[0].first;
+    result->best_dx = candidates[0].second;
+    result->best_cost = result->costs[(result->best_dy + window_radius) * size +
+                                      result->best_dx + window_radius];
+  }
+  result->offset_num = offset_num;
+  RecordTime(start_time, result);
+  return true;
+}
+
+void LossyMapMatcher2D::BuildPyramid(const LossyMapMatrix2D& matrix,
+                                     unsigned int level_num,
+                                     std::vector<LossyMapMatrix2D>* levels) {
+  levels->resize(std::max(level_num, 1u));
+  (*levels)[0] = matrix;
+  for (size_t i = 1; i < levels->size(); ++i) {
+    const LossyMapMatrix2D& fine = (*levels)[i - 1];
+    LossyMapMatrix2D& coarse = (*levels)[i];
+    coarse.SetCompact(false);
+    coarse.Init(fine.GetRows() / 2, fine.GetCols() / 2);
+    coarse.SetDownsampled(fine, 0, 0);
+  }
+}
+
+void LossyMapMatcher2D::CopyFrame(const LossyMapMatrix2D& frame) {
+  // Lay the cells out as float arrays, so that the comparison of a row runs
+  // on contiguous memory and needs no bound check.
+  frame_rows_ = static_cast<int>(frame.GetRows());
+  frame_cols_ = static_cast<int>(frame.GetCols());
+  frame_intensity_.resize(frame_rows_ * frame_cols_);
+  frame_weight_.resize(frame_rows_ * frame_cols_);
+  for (int y = 0; y < frame_rows_; ++y) {
+    const int offset = y * frame_cols_;
+    CopyRow(frame, y, 0, frame_cols_, frame_intensity_.data() + offset,
+            frame_weight_.data() + offset);
+  }
+}
+
+void LossyMapMatcher2D::MatchWindow(const LossyMapMatrix2D& map,
+                                    int frame_row, int frame_col,
+                                    int window_radius,
+                                    LossyMapMatchResult2D* result) {
+  const int map_rows = static_cast<int>(map.GetRows());
+  const int map_cols = static_cast<int>(map.GetCols());
+  const int region_rows = frame_rows_ + 2 * window_radius;
+  map_region_cols_ = frame_cols_ + 2 * window_radius;
+  map_intensity_.assign(region_rows * map_region_cols_, 0.0f);
+  map_weight_.assign(region_rows * map_region_cols_, 0.0f);
+  const int region_row = frame_row - window_radius;
+  const int region_col = frame_col - window_radius;
+  const int y_begin = std::max(region_row, 0);
+  const int y_end = std::min(region_row + region_rows, map_rows);
+  const int x_begin = std::max(region_col, 0);
+  const int x_end = std::min(region_col + map_region_cols_, map_cols);
+  for (int y = y_begin; y < y_end; ++y) {
+    const int offset = (y - region_row) * map_region_cols_ - region_col;
+    if (x_begin < x_end) {
+      CopyRow(map, y, x_begin, x_end, &map_intensity_[offset + x_begin],
+              &map_weight_[offset + x_begin]);
+    }
+  }
+
+  const int window_size = 2 * window_radius + 1;
+  result->window_radius = window_radius;
+  result->costs.assign(window_size * window_size, -1.0);
+  result->overlaps.assign(window_size * window_size, 0);
+  if (frame_rows_ == 0 || frame_cols_ == 0) {
+    // nothing to compare, every offset is left without overlap
+  } else if (pool_ == nullptr || window_size == 1) {
+    MatchRows(0, window_size, result);
+  } else {
+    const int band_num = std::min(static_cast<int>(thread_num_), window_size);
+    for (int band = 0; band < band_num; ++band) {
+      const int row_begin = window_size * band / band_num;
+      const int row_end = window_size * (band + 1) / band_num;
+      pool_->schedule([this, row_begin, row_end, result]() {
+        MatchRows(row_begin, row_end, result);
+      });
+    }
+    pool_->wait();
+  }
+
+  result->best_cost = -1.0;
+  result->best_dx = 0;
+  result->best_dy = 0;
+  for (int i = 0; i < window_size * window_size; ++i) {
+    if (result->overlaps[i] > 0 &&
+        (result->best_cost < 0.0 || result->costs[i] < result->best_cost)) {
+      result->best_cost = result->costs[i];
+      result->best_dy = i / window_size - window_radius;
+      result->best_dx = i % window_size - window_radius;
+    }
+  }
+  result->offset_num = window_size * window_size;
+}
+
+void LossyMapMatcher2D::RecordTime(
+    std::chrono::steady_clock::time_point start_time,
+    LossyMapMatchResult2D* result) {
+  result->elapsed_ms = std::chrono::duration<double, std::milli>(
+                           std::chrono::steady_clock::now() - start_time)
+                           .count();
+  ++stats_.frame_count;
+  stats_.mean_elapsed_ms +=
+      (result->elapsed_ms - stats_.mean_elapsed_ms) / stats_.frame_count;
+  stats_.max_elapsed_ms = std::max(stats_.max_elapsed_ms, result->elapsed_ms);
+}
+
+void LossyMapMatcher2D::CopyRow(const LossyMapMatrix2D& matrix, int row,
+                                int col_begin, int col_end, float* intensity,
+                                float* weight) {
+  const int size = col_end - col_begin;
+  if (matrix.IsCompact()) {
+    // widen the bytes of the planes, which is vectorized
+    typedef Eigen::Array<unsigned char, Eigen::Dynamic, 1> ByteArray;
+    const int offset = row * static_cast<int>(matrix.GetCols()) + col_begin;
+    Eigen::Map<const ByteArray> intensity_plane(
+        matrix.GetIntensityPlane() + offset, size);
+    Eigen::Map<const ByteArray> count_plane(matrix.GetCountPlane() + offset,
+                                            size);
+    Eigen::Map<Eigen::ArrayXf>(intensity, size) =
+        intensity_plane.cast<float>();
+    Eigen::Map<Eigen::ArrayXf>(weight, size) =
+        count_plane.min(static_cast<unsigned char>(1)).cast<float>();
+    return;
+  }
+  const LossyMapCell2D* cells = matrix[row] + col_begin;
+  for (int x = 0; x < size; ++x) {
+    intensity[x] = cells[x].intensity;
+    weight[x] = cells[x].count > 0 ? 1.0f : 0.0f;
+  }
+}
+
+void LossyMapMatcher2D::MatchRows(int row_begin, int row_end,
+                                  LossyMapMatchResult2D* result) {
+  typedef Eigen::Map<const Eigen::ArrayXf> ConstArrayMap;
+  const int window_radius = result->window_radius;
+  const int window_size = 2 * window_radius + 1;
+  for (int row = row_begin; row < row_end; ++row) {
+    for (int col = 0; col < window_size; ++col) {
+      double sum = 0.0;
+      double overlap = 0.0;
+      for (int y = 0; y < frame_rows_; ++y) {
+        const int offset = (y + row) * map_region_cols_ + col;
+        ConstArrayMap map_intensity(&map_intensity_[offset], frame_cols_);
+        ConstArrayMap map_weight(&map_weight_[offset], frame_cols_);
+        ConstArrayMap frame_intensity(&frame_intensity_[y * frame_cols_],
+                                      frame_cols_);
+        ConstArrayMap frame_weight(&frame_weight_[y * frame_cols_],
+                                   frame_cols_);
+        sum += (map_weight * frame_weight *
+                (map_intensity - frame_intensity).square())
+                   .sum();
+        overlap += (map_weight * frame_weight).sum();
+      }
+      if (overlap > 0.0) {
+        const int index = row * window_size + col;
+        result->overlaps[index] = static_cast<unsigned int>(overlap + 0.5);
+        result->costs[index] = sum / overlap;
+      }
+    }
+  }
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
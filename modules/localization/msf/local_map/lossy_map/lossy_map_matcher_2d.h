@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULE_LOCALIZAION_MSF_LOCAL_MAP_LOSSY_MAP_LOSSY_MAP_MATCHER_2D_H_
+#define MODULE_LOCALIZAION_MSF_LOCAL_MAP_LOSSY_MAP_LOSSY_MAP_MATCHER_2D_H_
+
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "modules/localization/msf/common/util/threadpool.h"
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_matrix_2d.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+/**@brief The costs of a lidar grid over a search window of a map matrix. */
+struct LossyMapMatchResult2D {
+  /**@brief The search window radius, in cells. */
+  int window_radius = 0;
+  /**@brief The mean square intensity difference of the cells observed both
+   * in the map and in the frame, at every offset of the window, row major from
+   * (-radius, -radius). It is negative where no cell overlaps. */
+  std::vector<double> costs;
+  /**@brief The number of the overlapping cells at every offset. */
+  std::vector<unsigned int> overlaps;
+  /**@brief The offset of the lowest cost, in cells. */
+  int best_dx = 0;
+  int best_dy = 0;
+  double best_cost = -1.0;
+  /**@brief The number of the offsets evaluated, at all the levels. */
+  unsigned int offset_num = 0;
+  /**@brief The time spent in the matching. */
+  double elapsed_ms = 0.0;
+};
+
+/**@brief The timing of the frames matched by a matcher. */
+struct LossyMapMatchStats2D {
+  unsigned int frame_count = 0;
+  double mean_elapsed_ms = 0.0;
+  double max_elapsed_ms = 0.0;
+};
+
+/**@brief Matches the intensity grids of the lidar frames against a map.
+ * The search window is split in bands of rows computed on a thread pool,
+ * and the cells of a row are compared as float arrays, which are vectorized.
+ * The map and the frame may be compact matrices.
+ * Match is not thread-safe: a matcher serves one lidar stream. */
+class LossyMapMatcher2D {
+ public:
+  /**@brief The constructor.
+   * <thread_num> The number of the matching threads. With one thread the
+   * matching runs in the calling thread. */
+  explicit LossyMapMatcher2D(unsigned int thread_num = 1);
+  ~LossyMapMatcher2D();
+
+  /**@brief Compute the matching cost of a frame grid at every offset of the
+   * search window.
+   * <map> The map matrix.
+   * <frame> The intensity grid of the lidar frame, of the map resolution.
+   * <frame_row, frame_col> The cell of the map under the first cell of the
+   * frame at the zero offset. The frame may reach out of the map.
+   * <window_radius> The largest offset searched, in cells, on each axis.
+   * <return> False if the window radius is negative. */
+  bool Match(const LossyMapMatrix2D& map, const LossyMapMatrix2D& frame,
+             int frame_row, int frame_col, int window_radius,
+             LossyMapMatchResult2D* result);
+
+  /**@brief Compute the matching cost of a frame grid over a large window,
+   * coarse to fine on a map pyramid. The whole window is only searched at the
+   * coarsest level, and every finer level only searches around the
+   * <candidate_num> best offsets of the level before it, so the number of
+   * the offsets evaluated hardly grows with the window.
+   * <map_levels, frame_levels> The map and the frame at every level of the
+   * pyramid, from the finest, each level at half the resolution of the level
+   * before. The frame levels can be built by BuildPyramid, the map levels are
+   * the coarser resolutions of a map made by lossless_map_to_lossy_map.
+   * <frame_row, frame_col> The cell of the finest map under the first cell of
+   * the finest frame at the zero offset.
+   * <window_radius> The largest offset searched, in cells of the finest
+   * level, on each axis.
+   * <result> The costs at the finest level. The offsets not evaluated have no
+   * overlap.
+   * <return> False if the window radius is negative, there is no candidate
+   * or no level. */
+  bool MatchCoarseToFine(
+      const std::vector<const LossyMapMatrix2D*>& map_levels,
+      const std::vector<const LossyMapMatrix2D*>& frame_levels, int frame_row,
+      int frame_col, int window_radius, int candidate_num,
+      LossyMapMatchResult2D* result);
+
+  /**@brief Build the levels of the pyramid of a matrix, from the matrix
+   * itself, each level at half the resolution of the level before. */
+  static void BuildPyramid(const LossyMapMatrix2D& matrix,
+                           unsigned int level_num,
+                           std::vector<LossyMapMatrix2D>* levels);
+
+  /**@brief Get the timing of the frames matched so far. */
+  const LossyMapMatchStats2D& GetStats() const { return stats_; }
+  /**@brief Clear the timing. */
+  void ClearStats() { stats_ = LossyMapMatchStats2D(); }
+
+ private:
+  /**@brief Copy the intensities and the weights of the cells [col_begin,
+   * col_end) of a row, from the cells or from the planes of a compact matrix.
+   */
+  static void CopyRow(const LossyMapMatrix2D& matrix, int row, int col_begin,
+                      int col_end, float* intensity, float* weight);
+  /**@brief Lay the cells of the frame out as float arrays. */
+  void CopyFrame(const LossyMapMatrix2D& frame);
+  /**@brief Compute the costs of the copied frame over a window, and find the
+   * best offset. */
+  void MatchWindow(const LossyMapMatrix2D& map, int frame_row, int frame_col,
+                   int window_radius, LossyMapMatchResult2D* result);
+  /**@brief Record the time of a frame matched since start_time. */
+  void RecordTime(std::chrono::steady_clock::time_point start_time,
+                  LossyMapMatchResult2D* result);
+  /**@brief Compute the costs of the window rows [row_begin, row_end). */
+  void MatchRows(int row_begin, int row_end, LossyMapMatchResult2D* result);
+
+  unsigned int thread_num_;
+  std::unique_ptr<ThreadPool> pool_;
+  LossyMapMatchStats2D stats_;
+
+  /**@brief The intensities and weights of the map region the window covers,
+   * 0 weighted out of the map and in the cells without sample. */
+  std::vector<float> map_intensity_;
+  std::vector<float> map_weight_;
+  int map_region_cols_ = 0;
+  /**@brief The intensities and weights of the frame cells. */
+  std::vector<float> frame_intensity_;
+  std::vector<float> frame_weight_;
+  int frame_rows_ = 0;
+  int frame_cols_ = 0;
+};
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
+
+#endif  // MODULE_LOCALIZAION_MSF_LOCAL_MAP_LOSSY_MAP_LOSSY_MAP_MATCHER_2D_H_
@@ -15,6 +15,9 @@
  *****************************************************************************/
 
 #include "modules/localization/msf/local_map/lossy_map/lossy_map_matrix_2d.h"
+#include <algorithm>
+#include "modules/common/log.h"
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_config_2d.h"
 
 namespace apollo {
 namespace localization {
@@ -51,6 +54,11 @@ LossyMapMatrix2D::LossyMapMatrix2D() {
   rows_ = 0;
   cols_ = 0;
   map_cells_ = NULL;
+  is_compact_ = false;
+  alt_avg_min_ = 0.0;
+  alt_avg_max_ = 0.0;
+  alt_ground_min_ = 0.0;
+  alt_ground_max_ = 0.0;
 }
 
 LossyMapMatrix2D::~LossyMapMatrix2D() {
@@ -62,31 +70,49 @@ LossyMapMatrix2D::~LossyMapMatrix2D() {
 }
 
 LossyMapMatrix2D::LossyMapMatrix2D(const LossyMapMatrix2D& matrix)
-    : BaseMapMatrix(matrix), map_cells_(NULL) {
-  Init(matrix.rows_, matrix.cols_);
-  for (unsigned int y = 0; y < rows_; ++y) {
-    for (unsigned int x = 0; x < cols_; ++x) {
-      map_cells_[y * cols_ + x] = matrix[y][x];
-    }
-  }
+    : BaseMapMatrix(matrix),
+      map_cells_(NULL),
+      is_compact_(matrix.is_compact_) {
+  *this = matrix;
 }
 
 LossyMapMatrix2D& LossyMapMatrix2D::operator=(const LossyMapMatrix2D& matrix) {
+  if (this == &matrix) {
+    return *this;
+  }
+  is_compact_ = matrix.is_compact_;
   Init(matrix.rows_, matrix.cols_);
-  for (unsigned int y = 0; y < rows_; ++y) {
-    for (unsigned int x = 0; x < cols_; ++x) {
-      map_cells_[y * cols_ + x] = matrix[y][x];
+  if (is_compact_) {
+    count_plane_ = matrix.count_plane_;
+    intensity_plane_ = matrix.intensity_plane_;
+    intensity_var_plane_ = matrix.intensity_var_plane_;
+    altitude_plane_ = matrix.altitude_plane_;
+    altitude_ground_plane_ = matrix.altitude_ground_plane_;
+  } else {
+    for (unsigned int y = 0; y < rows_; ++y) {
+      for (unsigned int x = 0; x < cols_; ++x) {
+        map_cells_[y * cols_ + x] = matrix[y][x];
+      }
     }
   }
+  alt_avg_min_ = matrix.alt_avg_min_;
+  alt_avg_max_ = matrix.alt_avg_max_;
+  alt_ground_min_ = matrix.alt_ground_min_;
+  alt_ground_max_ = matrix.alt_ground_max_;
   return *this;
 }
 
 void LossyMapMatrix2D::Init(const BaseMapConfig* config) {
   unsigned int rows = config->map_node_size_y_;
   unsigned int cols = config->map_node_size_x_;
-  if (rows_ == rows && cols_ == cols) {
+  const LossyMapConfig2D* lossy_config =
+      dynamic_cast<const LossyMapConfig2D*>(config);
+  const bool is_compact =
+      lossy_config != nullptr && lossy_config->map_is_compact_;
+  if (rows_ == rows && cols_ == cols && is_compact_ == is_compact) {
     return;
   }
+  is_compact_ = is_compact;
   Init(rows, cols);
   return;
 }
@@ -96,23 +122,124 @@ void LossyMapMatrix2D::Init(unsigned int rows, unsigned int cols) {
     delete[] map_cells_;
     map_cells_ = NULL;
   }
-  map_cells_ = new LossyMapCell2D[rows * cols];
   rows_ = rows;
   cols_ = cols;
+  if (is_compact_) {
+    Reset(rows, cols);
+  } else {
+    std::vector<unsigned char>().swap(count_plane_);
+    std::vector<unsigned char>().swap(intensity_plane_);
+    std::vector<uint16_t>().swap(intensity_var_plane_);
+    std::vector<uint16_t>().swap(altitude_plane_);
+    std::vector<uint16_t>().swap(altitude_ground_plane_);
+    map_cells_ = new LossyMapCell2D[rows * cols];
+  }
+}
+
+void LossyMapMatrix2D::SetCompact(bool is_compact) {
+  if (is_compact_ == is_compact) {
+    return;
+  }
+  is_compact_ = is_compact;
+  Init(rows_, cols_);
+}
+
+void LossyMapMatrix2D::SetDownsampled(const LossyMapMatrix2D& fine,
+                                      unsigned int row, unsigned int col) {
+  DCHECK(!is_compact_);
+  const unsigned int rows = std::min(fine.GetRows() / 2, rows_ - row);
+  const unsigned int cols = std::min(fine.GetCols() / 2, cols_ - col);
+  LossyMapCell2D fine_cell;
+  for (unsigned int y = 0; y < rows; ++y) {
+    for (unsigned int x = 0; x < cols; ++x) {
+      double count = 0.0;
+      double intensity = 0.0;
+      double intensity_square = 0.0;
+      double altitude = 0.0;
+      double altitude_ground = 0.0;
+      unsigned int ground_count = 0;
+      for (unsigned int i = 0; i < 4; ++i) {
+        fine.GetCell(2 * y + i / 2, 2 * x + i % 2, &fine_cell);
+        if (fine_cell.is_ground_useful) {
+          altitude_ground += fine_cell.altitude_ground;
+          ++ground_count;
+        }
+        if (fine_cell.count == 0) {
+          continue;
+        }
+        count += fine_cell.count;
+        intensity += fine_cell.count * fine_cell.intensity;
+        intensity_square +=
+            fine_cell.count * (fine_cell.intensity_var +
+                               fine_cell.intensity * fine_cell.intensity);
+        altitude += fine_cell.count * fine_cell.altitude;
+      }
+      LossyMapCell2D& cell = map_cells_[(row + y) * cols_ + col + x];
+      cell.Reset();
+      if (count > 0.0) {
+        cell.count = static_cast<unsigned int>(count);
+        cell.intensity = static_cast<float>(intensity / count);
+        cell.intensity_var = static_cast<float>(std::max(
+            intensity_square / count - cell.intensity * cell.intensity, 0.0));
+        cell.altitude = static_cast<float>(altitude / count);
+      }
+      if (ground_count > 0) {
+        cell.is_ground_useful = true;
+        cell.altitude_ground =
+            static_cast<float>(altitude_ground / ground_count);
+      }
+    }
+  }
 }
 
 void LossyMapMatrix2D::Reset(const BaseMapConfig* config) {
+  // the configuration may have switched the mode since the initialization
+  Init(config);
   Reset(config->map_node_size_y_, config->map_node_size_x_);
   return;
 }
 
 void LossyMapMatrix2D::Reset(unsigned int rows, unsigned int cols) {
   unsigned int length = rows * cols;
+  if (is_compact_) {
+    // the planes of the default cell
+    const LossyMapCell2D cell;
+    count_plane_.assign(length, EncodeCount(cell));
+    intensity_plane_.assign(length, EncodeIntensity(cell));
+    intensity_var_plane_.assign(length, EncodeVar(cell));
+    altitude_plane_.assign(length, 0);
+    altitude_ground_plane_.assign(length, ground_void_flag_);
+    return;
+  }
   for (unsigned int i = 0; i < length; ++i) {
     map_cells_[i].Reset();
   }
 }
 
+void LossyMapMatrix2D::GetCell(unsigned int row, unsigned int col,
+                               LossyMapCell2D* cell) const {
+  const unsigned int id = row * cols_ + col;
+  if (!is_compact_) {
+    *cell = map_cells_[id];
+    return;
+  }
+  DecodeCount(count_plane_[id], cell);
+  DecodeIntensity(intensity_plane_[id], cell);
+  DecodeVar(intensity_var_plane_[id], cell);
+  if (cell->count > 0) {
+    DecodeAltitudeAvg(altitude_plane_[id], cell);
+  } else {
+    cell->altitude = 0.0;
+  }
+  if (altitude_ground_plane_[id] == ground_void_flag_) {
+    cell->is_ground_useful = false;
+    cell->altitude_ground = 0.0;
+  } else {
+    cell->is_ground_useful = true;
+    DecodeAltitudeGround(altitude_ground_plane_[id], cell);
+  }
+}
+
 unsigned char LossyMapMatrix2D::EncodeIntensity(
     const LossyMapCell2D& cell) const {
   int intensity = cell.intensity;
@@ -237,6 +364,10 @@ unsigned int LossyMapMatrix2D::LoadBinary(unsigned char* buf) {
   Init(rows_, cols_);
 
   unsigned char* pp = reinterpret_cast<unsigned char*>(pf);
+  if (is_compact_) {
+    LoadPlanes(pp);
+    return GetBinarySize();
+  }
   // count
   for (unsigned int row = 0; row < rows_; ++row) {
     for (unsigned int col = 0; col < cols_; ++col) {
@@ -317,6 +448,15 @@ unsigned int LossyMapMatrix2D::CreateBinary(unsigned char* buf,
     buf_size -= sizeof(unsigned int) * 2;
 
     float* pf = reinterpret_cast<float*>(p);
+    if (is_compact_) {
+      // the planes are encoded against the altitudes they were loaded with
+      *pf++ = alt_avg_min_;
+      *pf++ = alt_avg_max_;
+      *pf++ = alt_ground_min_;
+      *pf++ = alt_ground_max_;
+      CreatePlanesBinary(reinterpret_cast<unsigned char*>(pf));
+      return target_size;
+    }
     alt_avg_min_ = 1e8;
     alt_avg_max_ = -1e8;
     for (unsigned int y = 0; y < rows_; ++y) {
@@ -424,6 +564,54 @@ unsigned int LossyMapMatrix2D::CreateBinary(unsigned char* buf,
   return target_size;
 }
 
+void LossyMapMatrix2D::LoadPlanes(const unsigned char* buf) {
+  const unsigned int size = rows_ * cols_;
+  count_plane_.assign(buf, buf + size);
+  buf += size;
+  intensity_plane_.assign(buf, buf + size);
+  buf += size;
+  LoadPlane(buf, &intensity_var_plane_);
+  buf += 2 * size;
+  LoadPlane(buf, &altitude_plane_);
+  buf += 2 * size;
+  LoadPlane(buf, &altitude_ground_plane_);
+}
+
+void LossyMapMatrix2D::LoadPlane(const unsigned char* buf,
+                                 std::vector<uint16_t>* plane) const {
+  const unsigned int size = rows_ * cols_;
+  const unsigned char* buf_high = buf;
+  const unsigned char* buf_low = buf + size;
+  plane->resize(size);
+  for (unsigned int i = 0; i < size; ++i) {
+    (*plane)[i] = static_cast<uint16_t>(buf_high[i] * 256 + buf_low[i]);
+  }
+}
+
+void LossyMapMatrix2D::CreatePlanesBinary(unsigned char* buf) const {
+  const unsigned int size = rows_ * cols_;
+  std::copy(count_plane_.begin(), count_plane_.end(), buf);
+  buf += size;
+  std::copy(intensity_plane_.begin(), intensity_plane_.end(), buf);
+  buf += size;
+  CreatePlaneBinary(intensity_var_plane_, buf);
+  buf += 2 * size;
+  CreatePlaneBinary(altitude_plane_, buf);
+  buf += 2 * size;
+  CreatePlaneBinary(altitude_ground_plane_, buf);
+}
+
+void LossyMapMatrix2D::CreatePlaneBinary(const std::vector<uint16_t>& plane,
+                                         unsigned char* buf) const {
+  const unsigned int size = rows_ * cols_;
+  unsigned char* buf_high = buf;
+  unsigned char* buf_low = buf + size;
+  for (unsigned int i = 0; i < size; ++i) {
+    buf_high[i] = plane[i] / 256;
+    buf_low[i] = plane[i] % 256;
+  }
+}
+
 unsigned int LossyMapMatrix2D::GetBinarySize() const {
   unsigned int target_size =
       sizeof(unsigned int) * 2 + sizeof(float) * 4;  // rows and cols and alts
@@ -436,6 +624,11 @@ unsigned int LossyMapMatrix2D::GetBinarySize() const {
 
 void LossyMapMatrix2D::GetIntensityImg(cv::Mat* intensity_img) const {
   *intensity_img = cv::Mat(cv::Size(cols_, rows_), CV_8UC1);
+  if (is_compact_) {
+    std::copy(intensity_plane_.begin(), intensity_plane_.end(),
+              intensity_img->data);
+    return;
+  }
 
   for (unsigned int y = 0; y < rows_; ++y) {
     for (unsigned int x = 0; x < cols_; ++x) {
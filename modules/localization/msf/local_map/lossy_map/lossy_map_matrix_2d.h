@@ -58,12 +58,17 @@ struct LossyMapCell2D {
   bool is_ground_useful;
 };
 
+/**@brief The cells of a lossy map node. The matrix keeps either float cells,
+ * which can be written, or in the compact mode the quantized planes of the map
+ * files, a third of the size, which are read only. */
 class LossyMapMatrix2D : public BaseMapMatrix {
  public:
   LossyMapMatrix2D();
   ~LossyMapMatrix2D();
   LossyMapMatrix2D(const LossyMapMatrix2D& matrix);
 
+  /**@brief Initialize the matrix, compact if the configuration of a lossy
+   * map asks so. */
   virtual void Init(const BaseMapConfig* config);
   /**@brief Reset map cells data. */
   virtual void Reset(const BaseMapConfig* config);
@@ -86,6 +91,7 @@ class LossyMapMatrix2D : public BaseMapMatrix {
   /**@brief get intensity image of node. */
   virtual void GetIntensityImg(cv::Mat* intensity_img) const;
 
+  /**@brief Get the cells of a row. A compact matrix has no cell. */
   inline LossyMapCell2D* operator[](int row) {
     return map_cells_ + row * cols_;
   }
@@ -95,6 +101,44 @@ class LossyMapMatrix2D : public BaseMapMatrix {
 
   LossyMapMatrix2D& operator=(const LossyMapMatrix2D& matrix);
 
+  /**@brief Get the number of rows. */
+  inline unsigned int GetRows() const { return rows_; }
+  /**@brief Get the number of columns. */
+  inline unsigned int GetCols() const { return cols_; }
+
+  /**@brief Whether the matrix keeps the quantized planes instead of cells. */
+  inline bool IsCompact() const { return is_compact_; }
+  /**@brief Switch between the cells and the planes. The data are lost. */
+  void SetCompact(bool is_compact);
+  /**@brief Write a matrix at half its resolution into the cells from (row,
+   * col) on, for the coarser levels of a map pyramid. Every cell merges the
+   * samples of a 2x2 block of the fine cells: the counts add up, and the
+   * intensities, their variances and the altitudes are averaged weighted by
+   * the counts. The cells out of this matrix are dropped. The fine matrix may
+   * be compact, this one may not. */
+  void SetDownsampled(const LossyMapMatrix2D& fine, unsigned int row,
+                      unsigned int col);
+  /**@brief Get a cell, decoded from the planes in the compact mode. */
+  void GetCell(unsigned int row, unsigned int col, LossyMapCell2D* cell) const;
+  /**@brief Get the intensity of a cell. */
+  inline float GetIntensity(unsigned int row, unsigned int col) const {
+    const unsigned int id = row * cols_ + col;
+    return is_compact_ ? intensity_plane_[id] : map_cells_[id].intensity;
+  }
+  /**@brief Get whether a cell has samples. */
+  inline bool HasSample(unsigned int row, unsigned int col) const {
+    const unsigned int id = row * cols_ + col;
+    return is_compact_ ? count_plane_[id] > 0 : map_cells_[id].count > 0;
+  }
+  /**@brief Get the compact planes of the count exponents (0 if the cell has
+   * no sample) and of the intensities, row major. */
+  inline const unsigned char* GetCountPlane() const {
+    return count_plane_.data();
+  }
+  inline const unsigned char* GetIntensityPlane() const {
+    return intensity_plane_.data();
+  }
+
  protected:
   /**@brief The number of rows. */
   unsigned int rows_;
@@ -102,6 +146,14 @@ class LossyMapMatrix2D : public BaseMapMatrix {
   unsigned int cols_;
   /**@brief The matrix data structure. */
   LossyMapCell2D* map_cells_;
+  /**@brief Whether the planes are used instead of the cells. */
+  bool is_compact_;
+  /**@brief The planes of the compact mode, encoded as in the map files. */
+  std::vector<unsigned char> count_plane_;
+  std::vector<unsigned char> intensity_plane_;
+  std::vector<uint16_t> intensity_var_plane_;
+  std::vector<uint16_t> altitude_plane_;
+  std::vector<uint16_t> altitude_ground_plane_;
 
  protected:
   inline unsigned char EncodeIntensity(const LossyMapCell2D& cell) const;
@@ -114,6 +166,13 @@ class LossyMapMatrix2D : public BaseMapMatrix {
   inline void DecodeAltitudeAvg(uint16_t data, LossyMapCell2D* cell) const;
   inline unsigned char EncodeCount(const LossyMapCell2D& cell) const;
   inline void DecodeCount(unsigned char data, LossyMapCell2D* cell) const;
+  /**@brief Copy the planes of a map file, after its header. */
+  void LoadPlanes(const unsigned char* buf);
+  void LoadPlane(const unsigned char* buf, std::vector<uint16_t>* plane) const;
+  /**@brief Write the planes in the layout of the map files. */
+  void CreatePlanesBinary(unsigned char* buf) const;
+  void CreatePlaneBinary(const std::vector<uint16_t>& plane,
+                         unsigned char* buf) const;
   const int var_range_ = 1023;  // 65535;
   const int var_ratio_ = 4;     // 256;
   // const unsigned int _alt_range = 1023;//65535;
@@ -15,6 +15,10 @@
  *****************************************************************************/
 
 #include <gtest/gtest.h>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
 #include "modules/localization/msf/local_map/lossless_map/lossless_map_config.h"
 #include "modules/localization/msf/local_map/lossless_map/lossless_map_pool.h"
 
@@ -55,6 +59,53 @@ TEST_F(BaseMapPoolTestSuite, MapNodePoolTest) {
   ASSERT_EQ(pool_size, 0);
 }
 
+/**@brief Test the free list of a fixed size pool with concurrent threads.*/
+TEST_F(BaseMapPoolTestSuite, MapNodePoolMultiThreadTest) {
+  LosslessMapConfig option;
+  LosslessMapNodePool pool(4, 2);
+  pool.Initial(&option);
+
+  std::mutex busy_mutex;
+  std::set<BaseMapNode*> busy_nodes;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 20; ++i) {
+        BaseMapNode* node = pool.AllocMapNode();
+        if (node == nullptr) {
+          std::this_thread::yield();
+          continue;
+        }
+        {
+          // a node is never handed out twice
+          std::lock_guard<std::mutex> lock(busy_mutex);
+          ASSERT_TRUE(busy_nodes.insert(node).second);
+        }
+        std::this_thread::yield();
+        {
+          std::lock_guard<std::mutex> lock(busy_mutex);
+          busy_nodes.erase(node);
+        }
+        pool.FreeMapNode(node);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  // all the nodes are back in the free list
+  std::set<BaseMapNode*> nodes;
+  for (int i = 0; i < 4; ++i) {
+    BaseMapNode* node = pool.AllocMapNode();
+    ASSERT_TRUE(node != nullptr);
+    nodes.insert(node);
+  }
+  ASSERT_EQ(nodes.size(), 4);
+  ASSERT_TRUE(pool.AllocMapNode() == nullptr);
+  ASSERT_EQ(pool.GetPoolSize(), 4);
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
@@ -130,6 +130,16 @@ TEST_F(LosslessMapTestSuite, MapScheduleTest) {
     location += trans_diff;
   }
 
+  // every node needed by LoadMapArea is counted once
+  MapNodeLoadStat stat = map.GetLoadStat();
+  EXPECT_GT(stat.cache_l1_hits, 0u);
+  EXPECT_GT(stat.cache_misses + stat.preload_waits, 0u);
+  EXPECT_GE(stat.cache_l1_hits + stat.cache_l2_hits + stat.preload_waits +
+                stat.cache_misses,
+            100u);
+  EXPECT_LE(stat.stalls, 100u);
+  EXPECT_LE(stat.max_stall_ms, stat.total_stall_ms);
+
   LosslessMapNode* node =
       static_cast<LosslessMapNode*>(map.GetMapNodeSafe(index));
   node->SetLeftTopCorner(0.0, 0.0);
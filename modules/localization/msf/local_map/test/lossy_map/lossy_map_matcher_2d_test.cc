@@ -0,0 +1,199 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_matcher_2d.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+class LossyMapMatcher2DTestSuite : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    srand(7);
+    map_.Init(64, 80);
+    for (int y = 0; y < 64; ++y) {
+      for (int x = 0; x < 80; ++x) {
+        // a few cells of the map have no sample
+        map_[y][x].count = (x * 7 + y * 3) % 11 == 0 ? 0 : 1 + rand() % 5;
+        map_[y][x].intensity = static_cast<float>(rand() % 256);
+        map_[y][x].intensity_var = 1.0;
+      }
+    }
+  }
+
+  /**@brief Copy the map cells from (row, col) into the frame. */
+  void CopyFrame(int row, int col, int rows, int cols,
+                 LossyMapMatrix2D* frame) {
+    frame->Init(rows, cols);
+    for (int y = 0; y < rows; ++y) {
+      for (int x = 0; x < cols; ++x) {
+        (*frame)[y][x] = map_[row + y][col + x];
+      }
+    }
+  }
+
+  /**@brief The cost at an offset, computed cell by cell. */
+  double ReferenceCost(const LossyMapMatrix2D& frame, int frame_row,
+                       int frame_col, int dy, int dx, unsigned int* overlap) {
+    double sum = 0.0;
+    *overlap = 0;
+    for (unsigned int y = 0; y < frame.GetRows(); ++y) {
+      for (unsigned int x = 0; x < frame.GetCols(); ++x) {
+        const int map_y = frame_row + dy + static_cast<int>(y);
+        const int map_x = frame_col + dx + static_cast<int>(x);
+        if (map_y < 0 || map_y >= 64 || map_x < 0 || map_x >= 80 ||
+            map_[map_y][map_x].count == 0 || frame[y][x].count == 0) {
+          continue;
+        }
+        const double diff =
+            map_[map_y][map_x].intensity - frame[y][x].intensity;
+        sum += diff * diff;
+        ++*overlap;
+      }
+    }
+    return *overlap > 0 ? sum / *overlap : -1.0;
+  }
+
+  LossyMapMatrix2D map_;
+};
+
+TEST_F(LossyMapMatcher2DTestSuite, FindOffset) {
+  LossyMapMatrix2D frame;
+  CopyFrame(23, 18, 20, 30, &frame);
+  for (unsigned int thread_num : {1u, 3u}) {
+    LossyMapMatcher2D matcher(thread_num);
+    LossyMapMatchResult2D result;
+    // the frame is off by (3, -2) cells from its true place
+    ASSERT_TRUE(matcher.Match(map_, frame, 20, 20, 5, &result));
+    EXPECT_EQ(3, result.best_dy);
+    EXPECT_EQ(-2, result.best_dx);
+    EXPECT_NEAR(0.0, result.best_cost, 1e-9);
+    ASSERT_EQ(121u, result.costs.size());
+    for (int dy = -5; dy <= 5; ++dy) {
+      for (int dx = -5; dx <= 5; ++dx) {
+        unsigned int overlap = 0;
+        const double cost = ReferenceCost(frame, 20, 20, dy, dx, &overlap);
+        const int index = (dy + 5) * 11 + dx + 5;
+        EXPECT_EQ(overlap, result.overlaps[index]);
+        EXPECT_NEAR(cost, result.costs[index], 1e-3 * (1.0 + cost));
+      }
+    }
+    EXPECT_EQ(1u, matcher.GetStats().frame_count);
+    EXPECT_GE(matcher.GetStats().max_elapsed_ms, 0.0);
+  }
+}
+
+TEST_F(LossyMapMatcher2DTestSuite, FrameOutOfMap) {
+  LossyMapMatrix2D frame;
+  CopyFrame(0, 60, 10, 20, &frame);
+  LossyMapMatcher2D matcher(4);
+  LossyMapMatchResult2D result;
+  EXPECT_FALSE(matcher.Match(map_, frame, 0, 60, -1, &result));
+  ASSERT_TRUE(matcher.Match(map_, frame, -2, 62, 3, &result));
+  EXPECT_EQ(2, result.best_dy);
+  EXPECT_EQ(-2, result.best_dx);
+  for (int dy = -3; dy <= 3; ++dy) {
+    for (int dx = -3; dx <= 3; ++dx) {
+      unsigned int overlap = 0;
+      const double cost = ReferenceCost(frame, -2, 62, dy, dx, &overlap);
+      const int index = (dy + 3) * 7 + dx + 3;
+      EXPECT_EQ(overlap, result.overlaps[index]);
+      EXPECT_NEAR(cost, result.costs[index], 1e-3 * (1.0 + std::fabs(cost)));
+    }
+  }
+
+  // a frame entirely out of the map overlaps nowhere
+  ASSERT_TRUE(matcher.Match(map_, frame, 100, 100, 2, &result));
+  EXPECT_DOUBLE_EQ(-1.0, result.best_cost);
+  EXPECT_EQ(2u, matcher.GetStats().frame_count);
+  matcher.ClearStats();
+  EXPECT_EQ(0u, matcher.GetStats().frame_count);
+}
+
+TEST_F(LossyMapMatcher2DTestSuite, CoarseToFine) {
+  // a smooth map, whose coarse levels keep the structure of the fine one
+  LossyMapMatrix2D map;
+  map.Init(160, 192);
+  for (int y = 0; y < 160; ++y) {
+    for (int x = 0; x < 192; ++x) {
+      map[y][x].count = 1 + (x + y) % 3;
+      map[y][x].intensity = static_cast<float>(
+          128.0 + 60.0 * std::sin(x * 0.13 + 0.02 * y * y / 7.0) +
+          50.0 * std::cos(y * 0.11 - 0.015 * x * x / 9.0));
+    }
+  }
+  LossyMapMatrix2D frame;
+  frame.Init(48, 64);
+  for (int y = 0; y < 48; ++y) {
+    for (int x = 0; x < 64; ++x) {
+      frame[y][x] = map[61 + y][77 + x];
+    }
+  }
+  std::vector<LossyMapMatrix2D> map_pyramid;
+  std::vector<LossyMapMatrix2D> frame_pyramid;
+  LossyMapMatcher2D::BuildPyramid(map, 3, &map_pyramid);
+  LossyMapMatcher2D::BuildPyramid(frame, 3, &frame_pyramid);
+  ASSERT_EQ(3u, map_pyramid.size());
+  EXPECT_EQ(40u, map_pyramid[2].GetRows());
+  EXPECT_EQ(48u, map_pyramid[2].GetCols());
+  std::vector<const LossyMapMatrix2D*> map_levels;
+  std::vector<const LossyMapMatrix2D*> frame_levels;
+  for (int i = 0; i < 3; ++i) {
+    map_levels.push_back(&map_pyramid[i]);
+    frame_levels.push_back(&frame_pyramid[i]);
+  }
+
+  LossyMapMatcher2D matcher(2);
+  LossyMapMatchResult2D full;
+  LossyMapMatchResult2D result;
+  // the frame is off by (-9, 13) cells from its true place
+  ASSERT_TRUE(matcher.Match(map, frame, 70, 64, 24, &full));
+  ASSERT_TRUE(matcher.MatchCoarseToFine(map_levels, frame_levels, 70, 64, 24,
+                                        3, &result));
+  EXPECT_EQ(-9, full.best_dy);
+  EXPECT_EQ(13, full.best_dx);
+  EXPECT_EQ(-9, result.best_dy);
+  EXPECT_EQ(13, result.best_dx);
+  EXPECT_NEAR(0.0, result.best_cost, 1e-6);
+  EXPECT_EQ(24, result.window_radius);
+  ASSERT_EQ(full.costs.size(), result.costs.size());
+  // the offsets evaluated have the costs of the full search
+  for (size_t i = 0; i < result.costs.size(); ++i) {
+    if (result.overlaps[i] > 0) {
+      EXPECT_EQ(full.overlaps[i], result.overlaps[i]);
+      EXPECT_NEAR(full.costs[i], result.costs[i], 1e-3 * (1.0 + full.costs[i]));
+    }
+  }
+  EXPECT_LT(result.offset_num, full.offset_num / 4);
+  EXPECT_EQ(2u, matcher.GetStats().frame_count);
+
+  EXPECT_FALSE(matcher.MatchCoarseToFine(map_levels, frame_levels, 70, 64, 24,
+                                         0, &result));
+  // with one level the search is the full one
+  ASSERT_TRUE(matcher.MatchCoarseToFine({&map}, {&frame}, 70, 64, 24, 3,
+                                        &result));
+  EXPECT_EQ(full.offset_num, result.offset_num);
+  EXPECT_EQ(-9, result.best_dy);
+  EXPECT_EQ(13, result.best_dx);
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_matrix_2d.h"
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_config_2d.h"
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_matcher_2d.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+class LossyMapMatrix2DTestSuite : public ::testing::Test {
+ protected:
+  virtual void SetUp() {
+    srand(11);
+    LossyMapMatrix2D matrix;
+    matrix.Init(40, 50);
+    for (int y = 0; y < 40; ++y) {
+      for (int x = 0; x < 50; ++x) {
+        LossyMapCell2D& cell = matrix[y][x];
+        cell.count = (x + y) % 7 == 0 ? 0 : 1 + rand() % 9;
+        cell.intensity = static_cast<float>(rand() % 256);
+        cell.intensity_var = static_cast<float>(rand() % 100);
+        cell.altitude = 20.0 + 0.01 * (rand() % 500);
+        cell.is_ground_useful = (x * y) % 5 != 0;
+        cell.altitude_ground = cell.is_ground_useful ? cell.altitude - 1.5 : 0;
+      }
+    }
+    binary_.resize(matrix.GetBinarySize());
+    matrix.CreateBinary(binary_.data(), binary_.size());
+    cells_.LoadBinary(binary_.data());
+    compact_.SetCompact(true);
+    compact_.LoadBinary(binary_.data());
+  }
+
+  std::vector<unsigned char> binary_;
+  LossyMapMatrix2D cells_;
+  LossyMapMatrix2D compact_;
+};
+
+TEST_F(LossyMapMatrix2DTestSuite, CompactCellsAreTheLoadedCells) {
+  ASSERT_FALSE(cells_.IsCompact());
+  ASSERT_TRUE(compact_.IsCompact());
+  ASSERT_EQ(40u, compact_.GetRows());
+  ASSERT_EQ(50u, compact_.GetCols());
+  for (unsigned int y = 0; y < 40; ++y) {
+    for (unsigned int x = 0; x < 50; ++x) {
+      LossyMapCell2D cell;
+      compact_.GetCell(y, x, &cell);
+      const LossyMapCell2D& expected = cells_[y][x];
+      EXPECT_EQ(expected.count, cell.count);
+      EXPECT_FLOAT_EQ(expected.intensity, cell.intensity);
+      EXPECT_FLOAT_EQ(expected.intensity_var, cell.intensity_var);
+      EXPECT_FLOAT_EQ(expected.altitude, cell.altitude);
+      EXPECT_EQ(expected.is_ground_useful, cell.is_ground_useful);
+      EXPECT_FLOAT_EQ(expected.altitude_ground, cell.altitude_ground);
+      EXPECT_FLOAT_EQ(expected.intensity, compact_.GetIntensity(y, x));
+      EXPECT_EQ(expected.count > 0, compact_.HasSample(y, x));
+    }
+  }
+}
+
+TEST_F(LossyMapMatrix2DTestSuite, CompactBinaryIsUnchanged) {
+  std::vector<unsigned char> binary(compact_.GetBinarySize());
+  ASSERT_EQ(binary_.size(), binary.size());
+  compact_.CreateBinary(binary.data(), binary.size());
+  EXPECT_TRUE(binary == binary_);
+
+  LossyMapMatrix2D copy(compact_);
+  EXPECT_TRUE(copy.IsCompact());
+  copy.CreateBinary(binary.data(), binary.size());
+  EXPECT_TRUE(binary == binary_);
+
+  cv::Mat image;
+  compact_.GetIntensityImg(&image);
+  EXPECT_EQ(cells_[3][4].intensity, image.at<unsigned char>(3, 4));
+}
+
+TEST_F(LossyMapMatrix2DTestSuite, ConfigSelectsTheMode) {
+  LossyMapConfig2D config("lossy_map");
+  config.map_node_size_x_ = 8;
+  config.map_node_size_y_ = 6;
+  LossyMapMatrix2D matrix;
+  matrix.Init(&config);
+  EXPECT_FALSE(matrix.IsCompact());
+  config.map_is_compact_ = true;
+  matrix.Reset(&config);
+  EXPECT_TRUE(matrix.IsCompact());
+  LossyMapCell2D cell;
+  matrix.GetCell(5, 7, &cell);
+  EXPECT_EQ(0u, cell.count);
+  EXPECT_FALSE(cell.is_ground_useful);
+}
+
+TEST_F(LossyMapMatrix2DTestSuite, MatchCompactMatrix) {
+  LossyMapMatrix2D frame;
+  frame.Init(12, 16);
+  for (int y = 0; y < 12; ++y) {
+    for (int x = 0; x < 16; ++x) {
+      frame[y][x] = cells_[y + 14][x + 17];
+    }
+  }
+  LossyMapMatcher2D matcher;
+  LossyMapMatchResult2D cells_result;
+  LossyMapMatchResult2D compact_result;
+  ASSERT_TRUE(matcher.Match(cells_, frame, 12, 15, 4, &cells_result));
+  ASSERT_TRUE(matcher.Match(compact_, frame, 12, 15, 4, &compact_result));
+  EXPECT_EQ(2, compact_result.best_dy);
+  EXPECT_EQ(2, compact_result.best_dx);
+  EXPECT_TRUE(cells_result.costs == compact_result.costs);
+  EXPECT_TRUE(cells_result.overlaps == compact_result.overlaps);
+}
+
+TEST_F(LossyMapMatrix2DTestSuite, Downsample) {
+  // the fine matrix may be compact
+  for (const LossyMapMatrix2D* fine : {&cells_, &compact_}) {
+    LossyMapMatrix2D coarse;
+    coarse.Init(25, 30);
+    coarse.SetDownsampled(*fine, 2, 4);
+    for (unsigned int y = 0; y < 25; ++y) {
+      for (unsigned int x = 0; x < 30; ++x) {
+        // the 40x50 fine cells fill the coarse rows [2, 22) and cols [4, 29)
+        if (y < 2 || y >= 22 || x < 4 || x >= 29) {
+          EXPECT_EQ(0u, coarse[y][x].count);
+          continue;
+        }
+        unsigned int count = 0;
+        double intensity = 0.0;
+        double altitude = 0.0;
+        bool is_ground_useful = false;
+        for (unsigned int i = 0; i < 4; ++i) {
+          LossyMapCell2D cell;
+          fine->GetCell(2 * (y - 2) + i / 2, 2 * (x - 4) + i % 2, &cell);
+          count += cell.count;
+          intensity += cell.count * cell.intensity;
+          altitude += cell.count * cell.altitude;
+          is_ground_useful = is_ground_useful || cell.is_ground_useful;
+        }
+        ASSERT_EQ(count, coarse[y][x].count);
+        EXPECT_EQ(is_ground_useful, coarse[y][x].is_ground_useful);
+        if (count > 0) {
+          EXPECT_NEAR(intensity / count, coarse[y][x].intensity, 1e-3);
+          EXPECT_NEAR(altitude / count, coarse[y][x].altitude, 1e-3);
+          EXPECT_GE(coarse[y][x].intensity_var, 0.0);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
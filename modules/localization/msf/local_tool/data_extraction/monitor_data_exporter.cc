@@ -16,6 +16,8 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
+#include <string>
+#include <vector>
 #include "modules/localization/msf/local_tool/data_extraction/location_exporter.h"
 #include "modules/localization/msf/local_tool/data_extraction/pcd_exporter.h"
 #include "modules/localization/msf/local_tool/data_extraction/rosbag_reader.h"
@@ -28,8 +30,9 @@ using apollo::localization::msf::BaseExporter;
 int main(int argc, char **argv) {
   boost::program_options::options_description boost_desc("Allowed options");
   boost_desc.add_options()("help", "produce help message")(
-      "bag_file", boost::program_options::value<std::string>(),
-      "provide the bag file")("out_folder",
+      "bag_file",
+      boost::program_options::value<std::vector<std::string>>()->multitoken(),
+      "provide the bag files, read in order")("out_folder",
                               boost::program_options::value<std::string>(),
                               "provide the output folder")(
       "cloud_topic",
@@ -51,7 +54,15 @@ int main(int argc, char **argv) {
       "odometry_loc_topic",
       boost::program_options::value<std::string>()->default_value(
           "/apollo/sensor/gnss/odometry"),
-      "provide odometry localization topic");
+      "provide odometry localization topic")(
+      "pcd_writer_threads",
+      boost::program_options::value<unsigned int>()->default_value(4),
+      "provide the number of threads writing the pcd files, 0 writes them "
+      "while reading")(
+      "max_pcds_in_flight",
+      boost::program_options::value<unsigned int>()->default_value(0),
+      "provide the number of pcd files waiting or being written, "
+      "0 for twice the number of threads");
 
   boost::program_options::variables_map boost_args;
   boost::program_options::store(
@@ -65,7 +76,8 @@ int main(int argc, char **argv) {
     return 0;
   }
 
-  const std::string bag_file = boost_args["bag_file"].as<std::string>();
+  const std::vector<std::string> bag_files =
+      boost_args["bag_file"].as<std::vector<std::string>>();
   const std::string pcd_folder =
       boost_args["out_folder"].as<std::string>() + "/pcd";
   if (!boost::filesystem::exists(pcd_folder)) {
@@ -82,7 +94,10 @@ int main(int argc, char **argv) {
   const std::string odometry_loc_topic =
       boost_args["odometry_loc_topic"].as<std::string>();
 
-  PCDExporter::Ptr pcd_exporter(new PCDExporter(pcd_folder));
+  PCDExporter::Ptr pcd_exporter(
+      new PCDExporter(pcd_folder,
+                      boost_args["pcd_writer_threads"].as<unsigned int>(),
+                      boost_args["max_pcds_in_flight"].as<unsigned int>()));
   LocationExporter::Ptr loc_exporter(new LocationExporter(pcd_folder));
   RosbagReader reader;
   reader.Subscribe(
@@ -106,7 +121,8 @@ int main(int argc, char **argv) {
       (BaseExporter::OnRosmsgCallback)&LocationExporter::OdometryLocCallback,
       loc_exporter);
 
-  reader.Read(bag_file);
+  reader.Read(bag_files);
+  pcd_exporter->WaitForWriters();
 
-  return 0;
+  return pcd_exporter->failed_pcd_num() == 0 ? 0 : -1;
 }
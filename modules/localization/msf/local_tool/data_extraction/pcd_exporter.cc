@@ -17,14 +17,22 @@
 #include "modules/localization/msf/local_tool/data_extraction/pcd_exporter.h"
 #include <pcl/common/time.h>
 #include <pcl_conversions/pcl_conversions.h>
+#include <algorithm>
 #include <string>
 
 namespace apollo {
 namespace localization {
 namespace msf {
 
-PCDExporter::PCDExporter(const std::string &pcd_folder) {
+PCDExporter::PCDExporter(const std::string &pcd_folder,
+                         unsigned int num_threads,
+                         unsigned int max_pcds_in_flight) {
   pcd_folder_ = pcd_folder;
+  if (num_threads > 0) {
+    max_pcds_in_flight_ =
+        max_pcds_in_flight > 0 ? max_pcds_in_flight : 2 * num_threads;
+    writers_.reset(new ThreadPool(std::min(num_threads, max_pcds_in_flight_)));
+  }
   std::string stamp_file = pcd_folder_ + "/pcd_timestamp.txt";
 
   if ((stamp_file_handle_ = fopen(stamp_file.c_str(), "a")) == NULL) {
@@ -33,6 +41,11 @@ PCDExporter::PCDExporter(const std::string &pcd_folder) {
 }
 
 PCDExporter::~PCDExporter() {
+  WaitForWriters();
+  if (failed_pcd_num_ > 0) {
+    std::cerr << "Failed to write " << failed_pcd_num_ << " pcd files!"
+              << std::endl;
+  }
   if (stamp_file_handle_ != NULL) {
     fclose(stamp_file_handle_);
   }
@@ -44,24 +57,46 @@ void PCDExporter::CompensatedPcdCallback(
   sensor_msgs::PointCloud2::ConstPtr msg =
       msg_instance.instantiate<sensor_msgs::PointCloud2>();
 
-  static unsigned int index = 1;
-
   std::stringstream ss_pcd;
-  ss_pcd << pcd_folder_ << "/" << index << ".pcd";
+  ss_pcd << pcd_folder_ << "/" << index_ << ".pcd";
   std::string pcd_filename = ss_pcd.str();
 
-  WritePcdFile(pcd_filename, msg);
-  fprintf(stamp_file_handle_, "%u %lf\n", index, msg->header.stamp.toSec());
+  fprintf(stamp_file_handle_, "%u %lf\n", index_, msg->header.stamp.toSec());
+  ++index_;
+
+  if (writers_ == nullptr) {
+    if (!WritePcdFile(pcd_filename, msg)) {
+      ++failed_pcd_num_;
+    }
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    pcd_done_.wait(lock,
+                   [this]() { return pcds_in_flight_ < max_pcds_in_flight_; });
+    ++pcds_in_flight_;
+  }
+  writers_->schedule([this, pcd_filename, msg]() {
+    if (!WritePcdFile(pcd_filename, msg)) {
+      ++failed_pcd_num_;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    --pcds_in_flight_;
+    pcd_done_.notify_all();
+  });
+}
 
-  ++index;
+void PCDExporter::WaitForWriters() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  pcd_done_.wait(lock, [this]() { return pcds_in_flight_ == 0; });
 }
 
-void PCDExporter::WritePcdFile(const std::string &filename,
+bool PCDExporter::WritePcdFile(const std::string &filename,
                                const sensor_msgs::PointCloud2::ConstPtr &msg) {
   pcl::PCLPointCloud2 pcl_cloud;
   pcl_conversions::toPCL(*msg, pcl_cloud);
   pcl::PCDWriter writer;
-  writer.writeBinaryCompressed(filename, pcl_cloud);
+  return writer.writeBinaryCompressed(filename, pcl_cloud) == 0;
 }
 
 }  // namespace msf
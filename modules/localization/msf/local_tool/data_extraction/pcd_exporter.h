@@ -18,8 +18,12 @@
 #define MODULES_LOCALIZATION_MSF_LOCAL_TOOL_PCD_EXPORTER_H
 
 #include <sensor_msgs/PointCloud2.h>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include "modules/localization/msf/common/util/threadpool.h"
 #include "modules/localization/msf/local_tool/data_extraction/base_exporter.h"
 
 namespace apollo {
@@ -28,24 +32,50 @@ namespace msf {
 
 /**
  * @class PCDExporter
- * @brief Export pcd from rosbag.
+ * @brief Export pcd from rosbag. The pcd files are numbered and time stamped
+ * in the order of the messages, and converted and compressed on a pool of
+ * writer threads, at most max_pcds_in_flight at a time: the callback waits
+ * for the budget, so that the reading does not outrun the writing.
  */
 class PCDExporter : public BaseExporter {
  public:
   typedef std::shared_ptr<PCDExporter> Ptr;
   typedef std::shared_ptr<PCDExporter const> ConstPtr;
 
-  explicit PCDExporter(const std::string &pcd_folder);
+  /**
+   * @param num_threads The number of writer threads, 0 writes the pcd files
+   * in the callback.
+   * @param max_pcds_in_flight The number of pcd files waiting or being
+   * written, 0 for twice the number of threads.
+   */
+  explicit PCDExporter(const std::string &pcd_folder,
+                       unsigned int num_threads = 0,
+                       unsigned int max_pcds_in_flight = 0);
+  // Waits for the pcd files in flight.
   ~PCDExporter();
 
   void CompensatedPcdCallback(const rosbag::MessageInstance &msg);
 
+  /**@brief Waits for the pcd files in flight to be written. */
+  void WaitForWriters();
+
+  unsigned int failed_pcd_num() const { return failed_pcd_num_; }
+
  private:
-  void WritePcdFile(const std::string &filename,
+  bool WritePcdFile(const std::string &filename,
                     const sensor_msgs::PointCloud2::ConstPtr &msg);
 
   std::string pcd_folder_;
   FILE *stamp_file_handle_;
+  unsigned int index_ = 1;
+
+  unsigned int max_pcds_in_flight_ = 0;
+  std::mutex mutex_;
+  std::condition_variable pcd_done_;
+  unsigned int pcds_in_flight_ = 0;
+  std::atomic<unsigned int> failed_pcd_num_{0};
+  // the last member, so that its threads are joined first
+  std::unique_ptr<ThreadPool> writers_;
 };
 
 }  // namespace msf
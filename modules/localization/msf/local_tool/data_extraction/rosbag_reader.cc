@@ -62,6 +62,12 @@ void RosbagReader::Read(const std::string &file_name) {
   bag.close();
 }
 
+void RosbagReader::Read(const std::vector<std::string> &file_names) {
+  for (const std::string &file_name : file_names) {
+    Read(file_name);
+  }
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
@@ -39,6 +39,8 @@ class RosbagReader {
                  BaseExporter::OnRosmsgCallback call_back,
                  BaseExporter::Ptr exporter);
   void Read(const std::string& file_name);
+  /**@brief Reads the bags one after the other, in the order of the names. */
+  void Read(const std::vector<std::string>& file_names);
 
  private:
   std::vector<std::string> topics_;
@@ -89,6 +89,7 @@ void MapImageCache::Set(const MapImageKey &key, const cv::Mat &image) {
 VisualizationEngine::VisualizationEngine()
     : map_image_cache_(20),
       image_window_(1024, 1024, CV_8UC3, cv::Scalar(0, 0, 0)),
+      tiles_window_(3072, 3072, CV_8UC3),
       big_window_(3072, 3072, CV_8UC3),
       tips_window_(48, 1024, CV_8UC3, cv::Scalar(0, 0, 0)) {}
 
@@ -98,13 +99,15 @@ bool VisualizationEngine::Init(const std::string &map_folder,
                                const unsigned int resolution_id,
                                const int zone_id,
                                const Eigen::Affine3d &extrinsic,
-                               const unsigned int loc_info_num) {
+                               const unsigned int loc_info_num,
+                               const bool is_headless) {
   map_folder_ = map_folder;
   map_visual_folder_ = map_visual_folder;
   map_param_ = map_param;
   velodyne_extrinsic_ = extrinsic;
   loc_info_num_ = loc_info_num;
   expected_car_loc_id_ = loc_info_num;
+  is_headless_ = is_headless;
 
   trajectory_groups_.resize(loc_info_num_);
 
@@ -125,13 +128,6 @@ bool VisualizationEngine::Init(const std::string &map_folder,
   zone_id_ = zone_id;
   resolution_id_ = resolution_id;
 
-  cloud_img_ =
-      cv::Mat(cv::Size(map_param_.map_node_size_x, map_param_.map_node_size_y),
-              CV_8UC3);
-  cloud_img_mask_ =
-      cv::Mat(cv::Size(map_param_.map_node_size_x, map_param_.map_node_size_y),
-              CV_8UC1);
-
   Preprocess(map_folder, map_visual_folder);
 
   std::string params_file = image_visual_resolution_path_ + "/param.txt";
@@ -140,8 +136,10 @@ bool VisualizationEngine::Init(const std::string &map_folder,
     AERROR << "Init other params failed.";
   }
 
-  cv::namedWindow(window_name_, CV_WINDOW_NORMAL);
-  cv::resizeWindow(window_name_, 1024, 1024);
+  if (!is_headless_) {
+    cv::namedWindow(window_name_, CV_WINDOW_NORMAL);
+    cv::resizeWindow(window_name_, 1024, 1024);
+  }
 
   is_init_ = true;
 
@@ -151,14 +149,40 @@ bool VisualizationEngine::Init(const std::string &map_folder,
 void VisualizationEngine::Visualize(
     const std::vector<LocalizatonInfo> &loc_infos,
     const std::vector<Eigen::Vector3d> &cloud) {
+  if (!UpdateLocInfos(loc_infos)) {
+    return;
+  }
+  cloud_ = cloud;
+  Draw();
+}
+
+bool VisualizationEngine::Render(const std::vector<LocalizatonInfo> &loc_infos,
+                                 const std::vector<Eigen::Vector3d> &cloud,
+                                 cv::Mat *image) {
+  if (!UpdateLocInfos(loc_infos)) {
+    return false;
+  }
+  cloud_ = cloud;
+  RenderImage();
+  image_window_.copyTo(*image);
+  return true;
+}
+
+bool VisualizationEngine::SkipFrame(
+    const std::vector<LocalizatonInfo> &loc_infos) {
+  return UpdateLocInfos(loc_infos);
+}
+
+bool VisualizationEngine::UpdateLocInfos(
+    const std::vector<LocalizatonInfo> &loc_infos) {
   if (!is_init_) {
     AERROR << "Visualziation should be init first.";
-    return;
+    return false;
   }
 
   if (loc_infos.size() != loc_info_num_) {
     AERROR << "Please check the localization info num.";
-    return;
+    return false;
   }
 
   cur_loc_infos_ = loc_infos;
@@ -166,7 +190,7 @@ void VisualizationEngine::Visualize(
   if (!UpdateCarLocId(expected_car_loc_id_)) {
     if (!UpdateCarLocId(car_loc_id_)) {
       if (!UpdateCarLocId()) {
-        return;
+        return false;
       }
     } else {
       if (expected_car_loc_id_ == loc_info_num_) {
@@ -176,8 +200,7 @@ void VisualizationEngine::Visualize(
   }
 
   UpdateTrajectoryGroups();
-  cloud_ = cloud;
-  Draw();
+  return true;
 }
 
 void VisualizationEngine::SetAutoPlay(bool auto_play) {
@@ -230,6 +253,23 @@ void VisualizationEngine::Preprocess(const std::string &map_folder,
 }
 
 void VisualizationEngine::Draw() {
+  RenderImage();
+  if (is_headless_) {
+    return;
+  }
+
+  cv::namedWindow(window_name_, CV_WINDOW_NORMAL);
+  // cv::setMouseCallback(window_name_, processMouse, 0);
+  cv::imshow(window_name_, image_window_);
+
+  int waitTime = 0;
+  if (auto_play_) {
+    waitTime = 10;
+  }
+  ProcessKey(cv::waitKey(waitTime));
+}
+
+void VisualizationEngine::RenderImage() {
   UpdateLevel();
 
   if (follow_car_) {
@@ -238,27 +278,8 @@ void VisualizationEngine::Draw() {
 
   MapImageKey iamge_key;
   CoordToImageKey(_view_center, &iamge_key);
-
-  // get 3*3 images on that level
-  for (int i = -1; i <= 1; ++i) {
-    for (int j = -1; j <= 1; ++j) {
-      MapImageKey key = iamge_key;
-      key.node_north_id += i * cur_stride_;
-      key.node_east_id += j * cur_stride_;
-      if (LoadImageToCache(key)) {
-        map_image_cache_.Get(key, &subMat_[i + 1][j + 1]);
-      } else {
-        subMat_[i + 1][j + 1] =
-            cv::Mat(1024, 1024, CV_8UC3, cv::Scalar(0, 0, 0));
-      }
-    }
-  }
-
-  for (int i = 0; i < 3; ++i) {
-    for (int j = 0; j < 3; ++j) {
-      subMat_[i]
-             [j].copyTo(big_window_(cv::Rect(j * 1024, i * 1024, 1024, 1024)));
-    }
+  if (!is_tiles_composed_ || iamge_key < tiles_key_ || tiles_key_ < iamge_key) {
+    ComposeTiles(iamge_key);
   }
 
   cv::Point map_grid_index =
@@ -266,33 +287,53 @@ void VisualizationEngine::Draw() {
   cv::Point node_grid_index = MapGridIndexToNodeGridIndex(map_grid_index);
   cv::Point bias = node_grid_index - map_grid_index;
 
-  DrawTrajectory(bias);
-  DrawCloud(bias);
-  DrawLoc(bias);
-  DrawStd(bias);
-
   int width = static_cast<int>(1024 * cur_scale_) / cur_stride_;
   int dis = width / 2;
   int left_top_x = node_grid_index.x + 1024 - dis;
   int left_top_y = node_grid_index.y + 1024 - dis;
+  const cv::Rect view_rect(left_top_x, left_top_y, width, width);
+
+  // only the view is shown, so only the view is drawn on clean tiles
+  tiles_window_(view_rect).copyTo(big_window_(view_rect));
+
+  DrawTrajectory(bias);
+  DrawCloud(bias);
+  DrawLoc(bias);
+  DrawStd(bias);
 
-  cv::resize(big_window_(cv::Rect(left_top_x, left_top_y, width, width)),
-             image_window_, cv::Size(1024, 1024), 0, 0, CV_INTER_LINEAR);
+  cv::resize(big_window_(view_rect), image_window_, cv::Size(1024, 1024), 0, 0,
+             CV_INTER_LINEAR);
   cv::flip(image_window_, image_window_, 0);
 
   DrawLegend();
   DrawInfo();
   DrawTips();
+}
 
-  cv::namedWindow(window_name_, CV_WINDOW_NORMAL);
-  // cv::setMouseCallback(window_name_, processMouse, 0);
-  cv::imshow(window_name_, image_window_);
+void VisualizationEngine::ComposeTiles(const MapImageKey &center_key) {
+  // get 3*3 images on that level
+  for (int i = -1; i <= 1; ++i) {
+    for (int j = -1; j <= 1; ++j) {
+      MapImageKey key = center_key;
+      key.node_north_id += i * cur_stride_;
+      key.node_east_id += j * cur_stride_;
+      if (LoadImageToCache(key)) {
+        map_image_cache_.Get(key, &subMat_[i + 1][j + 1]);
+      } else {
+        subMat_[i + 1][j + 1] =
+            cv::Mat(1024, 1024, CV_8UC3, cv::Scalar(0, 0, 0));
+      }
+    }
+  }
 
-  int waitTime = 0;
-  if (auto_play_) {
-    waitTime = 10;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      subMat_[i][j].copyTo(
+          tiles_window_(cv::Rect(j * 1024, i * 1024, 1024, 1024)));
+    }
   }
-  ProcessKey(cv::waitKey(waitTime));
+  tiles_key_ = center_key;
+  is_tiles_composed_ = true;
 }
 
 void VisualizationEngine::DrawTrajectory(const cv::Point &bias) {
@@ -453,17 +494,23 @@ void VisualizationEngine::DrawCloud(const cv::Point &bias) {
 
   AINFO << "Draw cloud.";
   if (cur_level_ == 0) {
-    CloudToMat(car_pose_, velodyne_extrinsic_, cloud_, &cloud_img_,
-               &cloud_img_mask_);
+    CloudToPixels(car_pose_, velodyne_extrinsic_, cloud_, &cloud_pixels_);
     cv::Point lt;
     lt = CoordToMapGridIndex(cloud_img_lt_coord_, resolution_id_, cur_stride_);
     lt = lt + bias + cv::Point(1024, 1024);
 
-    cv::Point rb = lt + cv::Point(1024, 1024);
+    const int img_width = static_cast<int>(map_param_.map_node_size_x);
+    const int img_height = static_cast<int>(map_param_.map_node_size_y);
+    cv::Point rb = lt + cv::Point(img_width, img_height);
     if (lt.x >= 0 && lt.y >= 0 && rb.x <= 1024 * 3 && rb.y <= 1024 * 3) {
-      cloud_img_.copyTo(big_window_(cv::Rect(lt.x, lt.y, 1024, 1024)),
-                        cloud_img_mask_);
-      // cloud_img_.copyTo(big_window_(cv::Rect(lt.x, lt.y, 1024, 1024)));
+      // the points are drawn straight on the window, without a full image
+      const cv::Vec3b color(color_table[car_loc_id_ % 3][0],
+                            color_table[car_loc_id_ % 3][1],
+                            color_table[car_loc_id_ % 3][2]);
+      for (const int pixel : cloud_pixels_) {
+        big_window_.at<cv::Vec3b>(lt.y + pixel / img_width,
+                                  lt.x + pixel % img_width) = color;
+      }
     }
   }
 }
@@ -720,11 +767,9 @@ void VisualizationEngine::InitOtherParams(const int x_min, const int y_min,
   AINFO << "image_visual_leaf_path: " << image_visual_leaf_path_;
 }
 
-void VisualizationEngine::CloudToMat(const Eigen::Affine3d &cur_pose,
-                                     const Eigen::Affine3d &velodyne_extrinsic,
-                                     const std::vector<Eigen::Vector3d> &cloud,
-                                     cv::Mat *cloud_img,
-                                     cv::Mat *cloud_img_mask) {
+void VisualizationEngine::CloudToPixels(
+    const Eigen::Affine3d &cur_pose, const Eigen::Affine3d &velodyne_extrinsic,
+    const std::vector<Eigen::Vector3d> &cloud, std::vector<int> *pixels) {
   unsigned int img_width = map_param_.map_node_size_x;
   unsigned int img_height = map_param_.map_node_size_y;
   Eigen::Vector3d cen = car_pose_.translation();
@@ -733,28 +778,23 @@ void VisualizationEngine::CloudToMat(const Eigen::Affine3d &cur_pose,
   cloud_img_lt_coord_[1] =
       cen[1] - map_param_.map_resolutions[resolution_id_] * (img_height / 2.0f);
 
-  cloud_img_.setTo(cv::Scalar(0, 0, 0));
-  cloud_img_mask_.setTo(cv::Scalar(0));
-
+  pixels->clear();
+  pixels->reserve(cloud.size());
+  const Eigen::Affine3d transform = cur_pose * velodyne_extrinsic;
+  const double resolution = map_param_.map_resolutions[resolution_id_];
   for (unsigned int i = 0; i < cloud.size(); i++) {
     const Eigen::Vector3d &pt = cloud[i];
-    Eigen::Vector3d pt_global = cur_pose * velodyne_extrinsic * pt;
+    Eigen::Vector3d pt_global = transform * pt;
 
     int col = static_cast<int>((pt_global[0] - cloud_img_lt_coord_[0]) /
-                               map_param_.map_resolutions[resolution_id_]);
+                               resolution);
     int row = static_cast<int>((pt_global[1] - cloud_img_lt_coord_[1]) /
-                               map_param_.map_resolutions[resolution_id_]);
-    if (col < 0 || row < 0 ||
-        col >= static_cast<int>(map_param_.map_node_size_x) ||
-        row >= static_cast<int>(map_param_.map_node_size_y)) {
+                               resolution);
+    if (col < 0 || row < 0 || col >= static_cast<int>(img_width) ||
+        row >= static_cast<int>(img_height)) {
       continue;
     }
-
-    unsigned char b = color_table[car_loc_id_ % 3][0];
-    unsigned char g = color_table[car_loc_id_ % 3][1];
-    unsigned char r = color_table[car_loc_id_ % 3][2];
-    cloud_img->at<cv::Vec3b>(row, col) = cv::Vec3b(b, g, r);
-    cloud_img_mask->at<unsigned char>(row, col) = 1;
+    pixels->push_back(row * static_cast<int>(img_width) + col);
   }
 }
 
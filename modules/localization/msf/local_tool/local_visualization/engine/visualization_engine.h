@@ -162,18 +162,42 @@ class VisualizationEngine {
   ~VisualizationEngine() = default;
 
  public:
+  /**
+   * @brief Initialize the engine.
+   * @param is_headless Render the frames without showing them in a window,
+   * and without reading keys, for example to export them.
+   */
   bool Init(const std::string &map_folder, const std::string &map_visual_folder,
             const VisualMapParam &map_param, const unsigned int resolution_id,
             const int zone_id, const Eigen::Affine3d &extrinsic,
-            const unsigned int loc_info_num = 1);
+            const unsigned int loc_info_num = 1,
+            const bool is_headless = false);
   void Visualize(const std::vector<LocalizatonInfo> &loc_infos,
                  const std::vector<Eigen::Vector3d> &cloud);
+  /**
+   * @brief Render a frame into an image, without showing it.
+   * @return False if the frame has no valid localization to draw.
+   */
+  bool Render(const std::vector<LocalizatonInfo> &loc_infos,
+              const std::vector<Eigen::Vector3d> &cloud, cv::Mat *image);
+  /**
+   * @brief Update the trajectories and the followed localization with a
+   * frame, without drawing it. An engine rendering a part of a drive is fed
+   * the frames before, so that it draws the same trajectories.
+   */
+  bool SkipFrame(const std::vector<LocalizatonInfo> &loc_infos);
   void SetAutoPlay(bool auto_play);
 
  private:
   void Preprocess(const std::string &map_folder,
                   const std::string &map_visual_folder);
+  bool UpdateLocInfos(const std::vector<LocalizatonInfo> &loc_infos);
+  /**@brief Render the view into the image window, and show it unless the
+   * engine is headless.*/
   void Draw();
+  void RenderImage();
+  /**@brief Compose the 3*3 map images around a key in the tiles window.*/
+  void ComposeTiles(const MapImageKey &center_key);
   void DrawLoc(const cv::Point &bias);
   void DrawStd(const cv::Point &bias);
   void DrawCloud(const cv::Point &bias);
@@ -192,11 +216,12 @@ class VisualizationEngine {
                        const std::string &path);
   bool InitOtherParams(const std::string &params_file);
 
-  /**@brief Project point cloud ti mat.*/
-  void CloudToMat(const Eigen::Affine3d &cur_pose,
-                  const Eigen::Affine3d &velodyne_extrinsic,
-                  const std::vector<Eigen::Vector3d> &cloud, cv::Mat *cloud_img,
-                  cv::Mat *cloud_img_mask);
+  /**@brief Project point cloud to the pixels of a map node sized image,
+   * row major, centered on the car.*/
+  void CloudToPixels(const Eigen::Affine3d &cur_pose,
+                     const Eigen::Affine3d &velodyne_extrinsic,
+                     const std::vector<Eigen::Vector3d> &cloud,
+                     std::vector<int> *pixels);
   void CoordToImageKey(const Eigen::Vector2d &coord, MapImageKey *key);
   /**@brief Compute grid index in current map given global coordinate.*/
   cv::Point CoordToMapGridIndex(const Eigen::Vector2d &coord,
@@ -255,6 +280,11 @@ class VisualizationEngine {
 
   std::string window_name_ = "Local Visualizer";
   cv::Mat image_window_;
+  // The 3*3 map images, composed again only when the view moves to other
+  // images, and their copy in which the view is drawn.
+  cv::Mat tiles_window_;
+  MapImageKey tiles_key_;
+  bool is_tiles_composed_ = false;
   cv::Mat big_window_;
   cv::Mat subMat_[3][3];
   cv::Mat tips_window_;
@@ -267,13 +297,13 @@ class VisualizationEngine {
   int max_stride_ = 1;
 
   bool is_init_ = false;
+  bool is_headless_ = false;
   bool follow_car_ = true;
   bool auto_play_ = false;
 
   Eigen::Affine3d car_pose_;
   std::vector<Eigen::Vector3d> cloud_;
-  cv::Mat cloud_img_;
-  cv::Mat cloud_img_mask_;
+  std::vector<int> cloud_pixels_;
   Eigen::Vector2d cloud_img_lt_coord_;
   Eigen::Affine3d velodyne_extrinsic_;
 
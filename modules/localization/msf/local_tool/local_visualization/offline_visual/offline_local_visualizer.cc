@@ -16,12 +16,15 @@
 
 #include "modules/localization/msf/local_tool/local_visualization/offline_visual/offline_local_visualizer.h"
 
+#include <algorithm>
 #include <map>
+#include <thread>
 #include <vector>
 
 #include "boost/filesystem.hpp"
 
 #include "modules/common/log.h"
+#include "modules/common/util/file.h"
 #include "modules/localization/msf/common/io/velodyne_utility.h"
 
 namespace apollo {
@@ -106,13 +109,13 @@ bool OfflineLocalVisualizer::Init(
   }
   AINFO << "Get zone id succeed.";
 
-  VisualMapParam map_param;
-  map_param.set(map_config_.map_resolutions_, map_config_.map_node_size_x_,
-                map_config_.map_node_size_y_, map_config_.map_range_.GetMinX(),
-                map_config_.map_range_.GetMinY(),
-                map_config_.map_range_.GetMaxX(),
-                map_config_.map_range_.GetMaxY());
-  success = visual_engine_.Init(map_folder_, map_visual_folder_, map_param,
+  map_param_.set(map_config_.map_resolutions_, map_config_.map_node_size_x_,
+                 map_config_.map_node_size_y_,
+                 map_config_.map_range_.GetMinX(),
+                 map_config_.map_range_.GetMinY(),
+                 map_config_.map_range_.GetMaxX(),
+                 map_config_.map_range_.GetMaxY());
+  success = visual_engine_.Init(map_folder_, map_visual_folder_, map_param_,
                                 resolution_id_, zone_id_, velodyne_extrinsic_,
                                 LOC_INFO_NUM);
   if (!success) {
@@ -126,68 +129,150 @@ bool OfflineLocalVisualizer::Init(
 
 void OfflineLocalVisualizer::Visualize() {
   for (unsigned int idx = 0; idx < pcd_timestamps_.size(); idx++) {
-    LocalizatonInfo lidar_loc_info;
-    LocalizatonInfo gnss_loc_info;
-    LocalizatonInfo fusion_loc_info;
-
     AINFO << "Frame id: " << idx + 1;
-    auto pose_found_iter = lidar_poses_.find(idx);
-    auto std_found_iter = lidar_stds_.find(idx);
-    if (pose_found_iter != lidar_poses_.end() &&
-        std_found_iter != lidar_stds_.end()) {
-      AINFO << "Find lidar pose.";
-      const Eigen::Affine3d &lidar_pose = pose_found_iter->second;
-      const Eigen::Vector3d &lidar_std = std_found_iter->second;
-      // lidar_loc_info.set(lidar_pose, "Lidar.", pcd_timestamps_[idx], idx +
-      // 1);
-      lidar_loc_info.set(Eigen::Translation3d(lidar_pose.translation()),
-                         Eigen::Quaterniond(lidar_pose.linear()), lidar_std,
-                         "Lidar.", pcd_timestamps_[idx], idx + 1);
-    }
+    std::vector<LocalizatonInfo> loc_infos;
+    GetLocInfos(idx, &loc_infos);
+    std::vector<Eigen::Vector3d> pt3ds;
+    LoadCloud(idx, loc_infos[0].pose, &pt3ds);
+    visual_engine_.Visualize(loc_infos, pt3ds);
+  }
+}
 
-    pose_found_iter = gnss_poses_.find(idx);
-    std_found_iter = gnss_stds_.find(idx);
-    if (pose_found_iter != gnss_poses_.end() &&
-        std_found_iter != gnss_stds_.end()) {
-      AINFO << "Find gnss pose.";
-      const Eigen::Affine3d &gnss_pose = pose_found_iter->second;
-      const Eigen::Vector3d &gnss_std = std_found_iter->second;
-      // gnss_loc_info.set(gnss_pose, "GNSS.", pcd_timestamps_[idx], idx + 1);
-      gnss_loc_info.set(Eigen::Translation3d(gnss_pose.translation()), gnss_std,
-                        "GNSS.", pcd_timestamps_[idx], idx + 1);
-    }
+bool OfflineLocalVisualizer::ExportImages(const std::string &image_folder,
+                                          const unsigned int thread_num) {
+  if (!apollo::common::util::EnsureDirectory(image_folder)) {
+    AERROR << "Can't create the image folder: " << image_folder;
+    return false;
+  }
+  const unsigned int frame_num =
+      static_cast<unsigned int>(pcd_timestamps_.size());
+  const unsigned int band_num = std::max(std::min(thread_num, frame_num), 1u);
+  std::vector<std::thread> threads;
+  std::vector<unsigned int> failed_nums(band_num, 0);
+  for (unsigned int band = 0; band < band_num; ++band) {
+    const unsigned int begin = static_cast<unsigned int>(
+        static_cast<uint64_t>(frame_num) * band / band_num);
+    const unsigned int end = static_cast<unsigned int>(
+        static_cast<uint64_t>(frame_num) * (band + 1) / band_num);
+    threads.emplace_back([this, &image_folder, &failed_nums, band, begin,
+                          end]() {
+      failed_nums[band] = ExportBand(image_folder, begin, end);
+    });
+  }
+  unsigned int failed_num = 0;
+  for (unsigned int band = 0; band < band_num; ++band) {
+    threads[band].join();
+    failed_num += failed_nums[band];
+  }
+  if (failed_num > 0) {
+    AERROR << "Failed to export " << failed_num << " of " << frame_num
+           << " frames.";
+    return false;
+  }
+  AINFO << "Exported " << frame_num << " frames to " << image_folder;
+  return true;
+}
 
-    pose_found_iter = fusion_poses_.find(idx);
-    std_found_iter = fusion_stds_.find(idx);
-    if (pose_found_iter != fusion_poses_.end() &&
-        std_found_iter != fusion_stds_.end()) {
-      AINFO << "Find fusion pose.";
-      const Eigen::Affine3d &fusion_pose = pose_found_iter->second;
-      const Eigen::Vector3d &fusion_std = std_found_iter->second;
-      // fusion_loc_info.set(fusion_pose, "Fusion.", pcd_timestamps_[idx],
-      //                    idx + 1);
-      fusion_loc_info.set(Eigen::Translation3d(fusion_pose.translation()),
-                          Eigen::Quaterniond(fusion_pose.linear()), fusion_std,
-                          "Fusion.", pcd_timestamps_[idx], idx + 1);
-    }
+unsigned int OfflineLocalVisualizer::ExportBand(
+    const std::string &image_folder, const unsigned int begin,
+    const unsigned int end) const {
+  // every band has its own engine, fed the frames before the band to draw the
+  // same trajectories as a sequential run
+  VisualizationEngine engine;
+  if (!engine.Init(map_folder_, map_visual_folder_, map_param_, resolution_id_,
+                   zone_id_, velodyne_extrinsic_, LOC_INFO_NUM, true)) {
+    return end - begin;
+  }
+  engine.SetAutoPlay(true);
+  std::vector<LocalizatonInfo> loc_infos;
+  for (unsigned int idx = 0; idx < begin; ++idx) {
+    GetLocInfos(idx, &loc_infos);
+    engine.SkipFrame(loc_infos);
+  }
 
-    std::vector<LocalizatonInfo> loc_infos;
-    loc_infos.push_back(lidar_loc_info);
-    loc_infos.push_back(gnss_loc_info);
-    loc_infos.push_back(fusion_loc_info);
-
-    std::string pcd_file_path;
-    std::ostringstream ss;
-    ss << idx + 1;
-    pcd_file_path = pcd_folder_ + "/" + ss.str() + ".pcd";
-    // std::cout << "pcd_file_path: " << pcd_file_path << std::endl;
+  unsigned int failed_num = 0;
+  cv::Mat image;
+  for (unsigned int idx = begin; idx < end; ++idx) {
+    GetLocInfos(idx, &loc_infos);
     std::vector<Eigen::Vector3d> pt3ds;
-    std::vector<unsigned char> intensities;
-    apollo::localization::msf::velodyne::LoadPcds(
-        pcd_file_path, idx, lidar_loc_info.pose, &pt3ds, &intensities, false);
+    LoadCloud(idx, loc_infos[0].pose, &pt3ds);
+    if (!engine.Render(loc_infos, pt3ds, &image)) {
+      // a frame without localization is not drawn by the viewer either
+      continue;
+    }
+    char image_file[256];
+    snprintf(image_file, sizeof(image_file), "/%06u.png", idx + 1);
+    if (!cv::imwrite(image_folder + image_file, image)) {
+      AERROR << "Can't write the image: " << image_folder + image_file;
+      ++failed_num;
+    }
+  }
+  return failed_num;
+}
 
-    visual_engine_.Visualize(loc_infos, pt3ds);
+void OfflineLocalVisualizer::GetLocInfos(
+    const unsigned int idx, std::vector<LocalizatonInfo> *loc_infos) const {
+  LocalizatonInfo lidar_loc_info;
+  LocalizatonInfo gnss_loc_info;
+  LocalizatonInfo fusion_loc_info;
+
+  auto pose_found_iter = lidar_poses_.find(idx);
+  auto std_found_iter = lidar_stds_.find(idx);
+  if (pose_found_iter != lidar_poses_.end() &&
+      std_found_iter != lidar_stds_.end()) {
+    AINFO << "Find lidar pose.";
+    const Eigen::Affine3d &lidar_pose = pose_found_iter->second;
+    const Eigen::Vector3d &lidar_std = std_found_iter->second;
+    // lidar_loc_info.set(lidar_pose, "Lidar.", pcd_timestamps_[idx], idx +
+    // 1);
+    lidar_loc_info.set(Eigen::Translation3d(lidar_pose.translation()),
+                       Eigen::Quaterniond(lidar_pose.linear()), lidar_std,
+                       "Lidar.", pcd_timestamps_[idx], idx + 1);
+  }
+
+  pose_found_iter = gnss_poses_.find(idx);
+  std_found_iter = gnss_stds_.find(idx);
+  if (pose_found_iter != gnss_poses_.end() &&
+      std_found_iter != gnss_stds_.end()) {
+    AINFO << "Find gnss pose.";
+    const Eigen::Affine3d &gnss_pose = pose_found_iter->second;
+    const Eigen::Vector3d &gnss_std = std_found_iter->second;
+    // gnss_loc_info.set(gnss_pose, "GNSS.", pcd_timestamps_[idx], idx + 1);
+    gnss_loc_info.set(Eigen::Translation3d(gnss_pose.translation()), gnss_std,
+                      "GNSS.", pcd_timestamps_[idx], idx + 1);
+  }
+
+  pose_found_iter = fusion_poses_.find(idx);
+  std_found_iter = fusion_stds_.find(idx);
+  if (pose_found_iter != fusion_poses_.end() &&
+      std_found_iter != fusion_stds_.end()) {
+    AINFO << "Find fusion pose.";
+    const Eigen::Affine3d &fusion_pose = pose_found_iter->second;
+    const Eigen::Vector3d &fusion_std = std_found_iter->second;
+    // fusion_loc_info.set(fusion_pose, "Fusion.", pcd_timestamps_[idx],
+    //                    idx + 1);
+    fusion_loc_info.set(Eigen::Translation3d(fusion_pose.translation()),
+                        Eigen::Quaterniond(fusion_pose.linear()), fusion_std,
+                        "Fusion.", pcd_timestamps_[idx], idx + 1);
   }
+
+  loc_infos->clear();
+  loc_infos->push_back(lidar_loc_info);
+  loc_infos->push_back(gnss_loc_info);
+  loc_infos->push_back(fusion_loc_info);
+}
+
+void OfflineLocalVisualizer::LoadCloud(
+    const unsigned int idx, const Eigen::Affine3d &pose,
+    std::vector<Eigen::Vector3d> *pt3ds) const {
+  std::string pcd_file_path;
+  std::ostringstream ss;
+  ss << idx + 1;
+  pcd_file_path = pcd_folder_ + "/" + ss.str() + ".pcd";
+  // std::cout << "pcd_file_path: " << pcd_file_path << std::endl;
+  std::vector<unsigned char> intensities;
+  apollo::localization::msf::velodyne::LoadPcds(pcd_file_path, idx, pose,
+                                                 pt3ds, &intensities, false);
 }
 
 bool OfflineLocalVisualizer::PCDTimestampFileHandler() {
@@ -52,8 +52,26 @@ class OfflineLocalVisualizer {
             const std::string &extrinsic_file);
 
   void Visualize();
+  /**
+   * @brief Render all the frames to png images, on threads rendering
+   * contiguous parts of the drive, for example to make a video of them.
+   * @param image_folder The folder of the images, named by frame id.
+   * @param thread_num The number of the rendering threads.
+   */
+  bool ExportImages(const std::string &image_folder,
+                    const unsigned int thread_num);
 
  private:
+  /**@brief Render the frames [begin, end) to images.
+   * @return The number of the images which can't be written.*/
+  unsigned int ExportBand(const std::string &image_folder,
+                          const unsigned int begin,
+                          const unsigned int end) const;
+  void GetLocInfos(const unsigned int idx,
+                   std::vector<LocalizatonInfo> *loc_infos) const;
+  void LoadCloud(const unsigned int idx, const Eigen::Affine3d &pose,
+                 std::vector<Eigen::Vector3d> *pt3ds) const;
+
   bool PCDTimestampFileHandler();
   bool LidarLocFileHandler(const std::vector<double> &pcd_timestamps);
   bool GnssLocFileHandler(const std::vector<double> &pcd_timestamps);
@@ -95,6 +113,7 @@ class OfflineLocalVisualizer {
   std::map<unsigned int, Eigen::Vector3d> fusion_stds_;
 
   BaseMapConfig map_config_;
+  VisualMapParam map_param_;
   unsigned int resolution_id_;
   int zone_id_;
 
@@ -14,15 +14,23 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
+#include <thread>
 #include "modules/localization/msf/local_tool/local_visualization/offline_visual/offline_local_visualizer.h"
 
 int main(int argc, char **argv) {
   boost::program_options::options_description boost_desc("Allowed options");
   boost_desc.add_options()("help", "produce help message")(
       "basedir", boost::program_options::value<std::string>(),
-      "provide the data base dir");
+      "provide the data base dir")(
+      "export_folder", boost::program_options::value<std::string>(),
+      "render the frames to the images in this folder instead of showing them")(
+      "export_threads",
+      boost::program_options::value<unsigned int>()->default_value(
+          std::max(std::thread::hardware_concurrency(), 1u)),
+      "provide the number of the threads rendering the images");
 
   boost::program_options::variables_map boost_args;
   boost::program_options::store(
@@ -52,6 +60,12 @@ int main(int argc, char **argv) {
   if (!success) {
     return -1;
   }
+  if (boost_args.count("export_folder")) {
+    success = local_visualizer.ExportImages(
+        boost_args["export_folder"].as<std::string>(),
+        boost_args["export_threads"].as<unsigned int>());
+    return success ? 0 : -1;
+  }
   local_visualizer.Visualize();
 
   return 0;
@@ -16,24 +16,26 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
-#include "modules/localization/msf/local_map/lossless_map/lossless_map.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include "modules/localization/msf/common/util/threadpool.h"
 #include "modules/localization/msf/local_map/lossless_map/lossless_map_config.h"
 #include "modules/localization/msf/local_map/lossless_map/lossless_map_matrix.h"
-#include "modules/localization/msf/local_map/lossless_map/lossless_map_pool.h"
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_node.h"
 
-#include "modules/localization/msf/local_map/lossy_map/lossy_map_2d.h"
 #include "modules/localization/msf/local_map/lossy_map/lossy_map_config_2d.h"
 #include "modules/localization/msf/local_map/lossy_map/lossy_map_matrix_2d.h"
 #include "modules/localization/msf/local_map/lossy_map/lossy_map_node_2d.h"
-#include "modules/localization/msf/local_map/lossy_map/lossy_map_pool_2d.h"
 
 namespace apollo {
 namespace localization {
 namespace msf {
 
-typedef LossyMap2D LossyMap;
 typedef LossyMapNode2D LossyMapNode;
-typedef LossyMapNodePool2D LossyMapNodePool;
 typedef LossyMapMatrix2D LossyMapMatrix;
 typedef LossyMapConfig2D LossyMapConfig;
 
@@ -90,21 +92,119 @@ bool GetAllMapIndex(const std::string& src_map_folder,
   return true;
 }
 
+/**@brief Convert a lossless map node to the lossy map node of the same index.
+ * The two nodes are only in memory during the conversion. */
+bool ConvertMapNode(const MapNodeIndex& index,
+                    const LosslessMapConfig& lossless_config,
+                    const LossyMapConfig& lossy_config) {
+  LosslessMapNode lossless_node;
+  lossless_node.InitMapMatrix(&lossless_config);
+  lossless_node.Init(&lossless_config, index, false);
+  if (!lossless_node.Load()) {
+    std::cerr << "Failed to load the map node: " << index << std::endl;
+    return false;
+  }
+  LosslessMapMatrix& lossless_matrix =
+      static_cast<LosslessMapMatrix&>(lossless_node.GetMapCellMatrix());
+
+  LossyMapNode lossy_node;
+  lossy_node.InitMapMatrix(&lossy_config);
+  lossy_node.Init(&lossy_config, index, false);
+  LossyMapMatrix& lossy_matrix =
+      static_cast<LossyMapMatrix&>(lossy_node.GetMapCellMatrix());
+
+  int rows = lossless_config.map_node_size_y_;
+  int cols = lossless_config.map_node_size_x_;
+  for (int row = 0; row < rows; ++row) {
+    for (int col = 0; col < cols; ++col) {
+      float intensity = lossless_node.GetValue(row, col);
+      float intensity_var = lossless_node.GetVar(row, col);
+      unsigned int count = lossless_node.GetCount(row, col);
+
+      // Read altitude
+      float altitude_ground = 0.0;
+      float altitude_avg = 0.0;
+      bool is_ground_useful = false;
+      std::vector<float> layer_alts;
+      std::vector<unsigned int> layer_counts;
+      lossless_matrix.GetMapCell(row, col).GetCount(&layer_counts);
+      lossless_matrix.GetMapCell(row, col).GetAlt(&layer_alts);
+      if (layer_counts.size() == 0 || layer_alts.size() == 0) {
+        altitude_avg = lossless_node.GetAlt(row, col);
+        is_ground_useful = false;
+      } else {
+        altitude_avg = lossless_node.GetAlt(row, col);
+        altitude_ground = layer_alts[0];
+        is_ground_useful = true;
+      }
+
+      lossy_matrix[row][col].intensity = intensity;
+      lossy_matrix[row][col].intensity_var = intensity_var;
+      lossy_matrix[row][col].count = count;
+      lossy_matrix[row][col].altitude = altitude_avg;
+      lossy_matrix[row][col].altitude_ground = altitude_ground;
+      lossy_matrix[row][col].is_ground_useful = is_ground_useful;
+    }
+  }
+  if (!lossy_node.Save()) {
+    std::cerr << "Failed to save the map node: " << index << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/**@brief Build a map node of a coarser level of the map pyramid from the
+ * nodes of the finer level, of <fine_resolution_id>. The coarse node (m, n)
+ * covers the fine nodes (2m, 2n) to (2m + 1, 2n + 1) at half their
+ * resolution. The fine nodes not in <fine_indices> are out of the map. */
+bool BuildCoarseMapNode(const MapNodeIndex& index,
+                        unsigned int fine_resolution_id,
+                        const std::set<MapNodeIndex>& fine_indices,
+                        const LossyMapConfig& lossy_config) {
+  LossyMapNode coarse_node;
+  coarse_node.InitMapMatrix(&lossy_config);
+  coarse_node.Init(&lossy_config, index, false);
+  LossyMapMatrix& coarse_matrix =
+      static_cast<LossyMapMatrix&>(coarse_node.GetMapCellMatrix());
+
+  const unsigned int rows = lossy_config.map_node_size_y_;
+  const unsigned int cols = lossy_config.map_node_size_x_;
+  for (unsigned int i = 0; i < 4; ++i) {
+    MapNodeIndex fine_index = index;
+    fine_index.resolution_id_ = fine_resolution_id;
+    fine_index.m_ = 2 * index.m_ + i / 2;
+    fine_index.n_ = 2 * index.n_ + i % 2;
+    if (fine_indices.count(fine_index) == 0) {
+      continue;
+    }
+    LossyMapNode fine_node;
+    fine_node.InitMapMatrix(&lossy_config);
+    fine_node.Init(&lossy_config, fine_index, false);
+    if (!fine_node.Load()) {
+      std::cerr << "Failed to load the map node: " << fine_index << std::endl;
+      return false;
+    }
+    coarse_matrix.SetDownsampled(
+        static_cast<const LossyMapMatrix&>(fine_node.GetMapCellMatrix()),
+        i / 2 * rows / 2, i % 2 * cols / 2);
+  }
+  if (!coarse_node.Save()) {
+    std::cerr << "Failed to save the map node: " << index << std::endl;
+    return false;
+  }
+  return true;
+}
+
 }  // namespace msf
 }  // namespace localization
 }  // namespace apollo
 
-using apollo::localization::msf::LosslessMap;
+using apollo::localization::msf::BuildCoarseMapNode;
+using apollo::localization::msf::ConvertMapNode;
 using apollo::localization::msf::LosslessMapConfig;
-using apollo::localization::msf::LosslessMapMatrix;
-using apollo::localization::msf::LosslessMapNode;
-using apollo::localization::msf::LosslessMapNodePool;
-using apollo::localization::msf::LossyMap;
 using apollo::localization::msf::LossyMapConfig;
-using apollo::localization::msf::LossyMapMatrix;
-using apollo::localization::msf::LossyMapNode;
-using apollo::localization::msf::LossyMapNodePool;
 using apollo::localization::msf::MapNodeIndex;
+using apollo::localization::ThreadPool;
 
 int main(int argc, char** argv) {
   boost::program_options::options_description boost_desc("Allowed options");
@@ -112,7 +212,19 @@ int main(int argc, char** argv) {
       "srcdir", boost::program_options::value<std::string>(),
       "provide the data base dir")("dstdir",
                                    boost::program_options::value<std::string>(),
-                                   "provide the lossy map destination dir");
+                                   "provide the lossy map destination dir")(
+      "threads", boost::program_options::value<unsigned int>()->default_value(
+                     std::max(std::thread::hardware_concurrency(), 1u)),
+      "provide the number of the conversion threads")(
+      "max_nodes_in_flight",
+      boost::program_options::value<unsigned int>()->default_value(0),
+      "provide the maximum number of the map nodes converting or waiting to, "
+      "twice the threads by default")(
+      "pyramid_levels",
+      boost::program_options::value<unsigned int>()->default_value(1),
+      "provide the number of the levels of the map pyramid for the coarse to "
+      "fine matching, each level a coarser resolution at half the one "
+      "before");
 
   boost::program_options::variables_map boost_args;
   boost::program_options::store(
@@ -131,17 +243,11 @@ int main(int argc, char** argv) {
   std::string src_map_folder = src_path + "/";
 
   LosslessMapConfig lossless_config("lossless_map");
-  LosslessMapNodePool lossless_map_node_pool(25, 8);
-  lossless_map_node_pool.Initial(&lossless_config);
-
-  LosslessMap lossless_map(&lossless_config);
-  lossless_map.InitThreadPool(1, 6);
-  lossless_map.InitMapNodeCaches(12, 24);
-  lossless_map.AttachMapNodePool(&lossless_map_node_pool);
-  if (!lossless_map.SetMapFolderPath(src_map_folder)) {
+  if (!lossless_config.Load(src_map_folder + "config.xml")) {
     std::cerr << "Reflectance map folder is invalid!" << std::endl;
     return -1;
   }
+  lossless_config.map_folder_path_ = src_map_folder;
 
   // create lossy map
   std::string dst_map_folder = dst_path + "/lossy_map/";
@@ -161,76 +267,103 @@ int main(int argc, char** argv) {
   std::cout << "lossy map directory structure has built." << std::endl;
 
   LossyMapConfig lossy_config("lossy_map");
-  LossyMapNodePool lossy_map_node_pool(25, 8);
-  lossy_map_node_pool.Initial(&lossy_config);
-  LossyMap lossy_map(&lossy_config);
-  lossy_map.InitThreadPool(1, 6);
-  lossy_map.InitMapNodeCaches(12, 24);
-  lossy_map.AttachMapNodePool(&lossy_map_node_pool);
-  if (!lossy_map.SetMapFolderPath(dst_map_folder)) {
+  if (!lossy_config.Load(dst_map_folder + "config.xml")) {
     std::cout << "lossy_map config xml not exist" << std::endl;
   }
+  lossy_config.map_folder_path_ = dst_map_folder;
+
+  // every node is converted independently on the thread pool. A node
+  // waiting or converting counts in the budget, so at most the budget of
+  // nodes is scheduled, and at most one lossless and one lossy node per
+  // thread are in memory.
+  const unsigned int thread_num =
+      std::max(boost_args["threads"].as<unsigned int>(), 1u);
+  unsigned int max_nodes_in_flight =
+      boost_args["max_nodes_in_flight"].as<unsigned int>();
+  if (max_nodes_in_flight == 0) {
+    max_nodes_in_flight = 2 * thread_num;
+  }
+  ThreadPool converters(std::min(thread_num, max_nodes_in_flight));
+  std::mutex mutex;
+  std::condition_variable node_done;
+  unsigned int nodes_in_flight = 0;
+  std::atomic<unsigned int> converted_num(0);
+  std::atomic<unsigned int> failed_num(0);
 
   int index = 0;
   auto itr = buf.begin();
   for (; itr != buf.end(); ++itr, ++index) {
-    // int single_alt = 0;
-    // int double_alt = 0;
-    // float delta_alt_max = 0.0;
-    // float delta_alt_min = 100.0;
-    // int delta_alt_minus_num = 0;
-    // float alt_max = 0.0;
-    // float alt_min = 100.0;
-
-    LosslessMapNode* lossless_node =
-        static_cast<LosslessMapNode*>(lossless_map.GetMapNodeSafe(*itr));
-    if (lossless_node == NULL) {
-      std::cerr << "index: " << index << " is a NULL pointer!" << std::endl;
-      continue;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      node_done.wait(lock, [&]() {
+        return nodes_in_flight < max_nodes_in_flight;
+      });
+      ++nodes_in_flight;
     }
-    LosslessMapMatrix& lossless_matrix =
-        static_cast<LosslessMapMatrix&>(lossless_node->GetMapCellMatrix());
-
-    LossyMapNode* lossy_node =
-        static_cast<LossyMapNode*>(lossy_map.GetMapNodeSafe(*itr));
-    LossyMapMatrix& lossy_matrix =
-        static_cast<LossyMapMatrix&>(lossy_node->GetMapCellMatrix());
-
-    int rows = lossless_config.map_node_size_y_;
-    int cols = lossless_config.map_node_size_x_;
-    for (int row = 0; row < rows; ++row) {
-      for (int col = 0; col < cols; ++col) {
-        float intensity = lossless_node->GetValue(row, col);
-        float intensity_var = lossless_node->GetVar(row, col);
-        unsigned int count = lossless_node->GetCount(row, col);
-
-        // Read altitude
-        float altitude_ground = 0.0;
-        float altitude_avg = 0.0;
-        bool is_ground_useful = false;
-        std::vector<float> layer_alts;
-        std::vector<unsigned int> layer_counts;
-        lossless_matrix.GetMapCell(row, col).GetCount(&layer_counts);
-        lossless_matrix.GetMapCell(row, col).GetAlt(&layer_alts);
-        if (layer_counts.size() == 0 || layer_alts.size() == 0) {
-          altitude_avg = lossless_node->GetAlt(row, col);
-          is_ground_useful = false;
+    const MapNodeIndex map_index = *itr;
+    converters.schedule([&, map_index]() {
+      if (ConvertMapNode(map_index, lossless_config, lossy_config)) {
+        ++converted_num;
+      } else {
+        ++failed_num;
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      --nodes_in_flight;
+      node_done.notify_one();
+    });
+  }
+  converters.wait();
+
+  // the coarser levels of the map pyramid are the next resolutions of the
+  // map, each built from the level before
+  const unsigned int pyramid_levels =
+      std::max(boost_args["pyramid_levels"].as<unsigned int>(), 1u);
+  std::set<MapNodeIndex> fine_indices;
+  for (const auto& map_index : buf) {
+    if (map_index.resolution_id_ == 0) {
+      fine_indices.insert(map_index);
+    }
+  }
+  unsigned int fine_resolution_id = 0;
+  for (unsigned int level = 1; level < pyramid_levels && failed_num == 0;
+       ++level) {
+    const unsigned int resolution_id =
+        static_cast<unsigned int>(lossy_config.map_resolutions_.size());
+    const float resolution =
+        2.0f * lossy_config.map_resolutions_[fine_resolution_id];
+    lossy_config.map_resolutions_.push_back(resolution);
+    config_transform_lossy.map_resolutions_.push_back(resolution);
+
+    std::set<MapNodeIndex> coarse_indices;
+    for (const auto& fine_index : fine_indices) {
+      MapNodeIndex coarse_index = fine_index;
+      coarse_index.resolution_id_ = resolution_id;
+      coarse_index.m_ = fine_index.m_ / 2;
+      coarse_index.n_ = fine_index.n_ / 2;
+      coarse_indices.insert(coarse_index);
+    }
+    for (const auto& coarse_index : coarse_indices) {
+      converters.schedule([&, coarse_index]() {
+        if (BuildCoarseMapNode(coarse_index, fine_resolution_id, fine_indices,
+                               lossy_config)) {
+          ++converted_num;
         } else {
-          altitude_avg = lossless_node->GetAlt(row, col);
-          altitude_ground = layer_alts[0];
-          is_ground_useful = true;
+          ++failed_num;
         }
-
-        lossy_matrix[row][col].intensity = intensity;
-        lossy_matrix[row][col].intensity_var = intensity_var;
-        lossy_matrix[row][col].count = count;
-        lossy_matrix[row][col].altitude = altitude_avg;
-        lossy_matrix[row][col].altitude_ground = altitude_ground;
-        lossy_matrix[row][col].is_ground_useful = is_ground_useful;
-      }
+      });
     }
-    lossy_node->SetIsChanged(true);
+    converters.wait();
+    std::cout << "built " << coarse_indices.size()
+              << " map nodes of the pyramid level " << level
+              << " at the resolution " << resolution << "." << std::endl;
+    fine_indices.swap(coarse_indices);
+    fine_resolution_id = resolution_id;
+  }
+  if (pyramid_levels > 1) {
+    config_transform_lossy.Save(dst_map_folder + "config.xml");
   }
 
-  return 0;
+  std::cout << "converted " << converted_num << " map nodes, " << failed_num
+            << " failed." << std::endl;
+  return failed_num == 0 ? 0 : -1;
 }
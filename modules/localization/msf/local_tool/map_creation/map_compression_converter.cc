@@ -0,0 +1,205 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include <string>
+
+#include "boost/filesystem.hpp"
+#include "boost/program_options.hpp"
+#include "boost/property_tree/ptree.hpp"
+#include "boost/property_tree/xml_parser.hpp"
+
+#include "modules/localization/msf/common/util/compression.h"
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_config.h"
+#include "modules/localization/msf/local_map/lossless_map/lossless_map_node.h"
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_config_2d.h"
+#include "modules/localization/msf/local_map/lossy_map/lossy_map_node_2d.h"
+
+namespace apollo {
+namespace localization {
+namespace msf {
+
+bool GetAllMapIndex(const std::string& map_folder,
+                    std::list<MapNodeIndex>* buf) {
+  const std::string map_path = map_folder + "/map";
+  if (!boost::filesystem::exists(map_path)) {
+    return false;
+  }
+  buf->clear();
+  boost::filesystem::recursive_directory_iterator end_iter;
+  boost::filesystem::recursive_directory_iterator iter(map_path);
+  for (; iter != end_iter; ++iter) {
+    if (boost::filesystem::is_directory(*iter) ||
+        iter->path().extension() != "") {
+      continue;
+    }
+    // the path is /resolution/zone/zone_id/m/n
+    const std::string node_path =
+        iter->path().string().substr(map_path.length());
+    MapNodeIndex index;
+    char zone[100];
+    if (sscanf(node_path.c_str(), "/%03u/%05s/%02d/%08u/%08u",
+               &index.resolution_id_, zone, &index.zone_id_, &index.m_,
+               &index.n_) != 5) {
+      std::cerr << "Skip the file: " << iter->path().string() << std::endl;
+      continue;
+    }
+    if (std::string(zone) == "south") {
+      index.zone_id_ = -index.zone_id_;
+    }
+    buf->push_back(index);
+  }
+  return true;
+}
+
+/**@brief Encode all the map nodes of the source map with the codec, in the
+ * destination map, and report the sizes and the loading times. */
+template <class MapConfig, class MapNode>
+int ConvertMap(const std::string& map_version, const std::string& src_folder,
+               const std::string& dst_folder, const std::string& codec) {
+  MapConfig src_config(map_version);
+  if (!src_config.Load(src_folder + "/config.xml")) {
+    return -1;
+  }
+  src_config.map_folder_path_ = src_folder;
+  MapConfig dst_config = src_config;
+  dst_config.map_folder_path_ = dst_folder;
+  dst_config.map_compression_codec_ = codec;
+  if (!boost::filesystem::exists(dst_folder)) {
+    boost::filesystem::create_directories(dst_folder);
+  }
+  dst_config.Save(dst_folder + "/config.xml");
+
+  std::list<MapNodeIndex> indices;
+  if (!GetAllMapIndex(src_folder, &indices)) {
+    std::cerr << "No map node is found in " << src_folder << std::endl;
+    return -1;
+  }
+
+  MapNode node;
+  node.InitMapMatrix(&src_config);
+  uintmax_t src_size = 0;
+  uintmax_t dst_size = 0;
+  double src_load_ms = 0.0;
+  double dst_load_ms = 0.0;
+  for (const MapNodeIndex& index : indices) {
+    std::string src_path;
+    std::string dst_path;
+    node.Init(&src_config, index, false);
+    auto start = std::chrono::steady_clock::now();
+    if (!BaseMapNode::GetNodeFilePath(src_config, index, &src_path) ||
+        !node.Load(src_path.c_str())) {
+      std::cerr << "Failed to load the map node: " << index << std::endl;
+      return -1;
+    }
+    src_load_ms += std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+    node.Init(&dst_config, index, false);
+    if (!node.Save() ||
+        !BaseMapNode::GetNodeFilePath(dst_config, index, &dst_path)) {
+      std::cerr << "Failed to save the map node: " << index << std::endl;
+      return -1;
+    }
+    start = std::chrono::steady_clock::now();
+    if (!node.Load(dst_path.c_str())) {
+      std::cerr << "Failed to reload the map node: " << index << std::endl;
+      return -1;
+    }
+    dst_load_ms += std::chrono::duration<double, std::milli>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+    src_size += boost::filesystem::file_size(src_path);
+    dst_size += boost::filesystem::file_size(dst_path);
+  }
+
+  const double num = std::max<size_t>(indices.size(), 1);
+  std::cout << "Converted " << indices.size() << " map nodes from "
+            << src_config.map_compression_codec_ << " to " << codec << "."
+            << std::endl;
+  std::cout << "Size: " << src_size << " -> " << dst_size << " bytes."
+            << std::endl;
+  std::cout << "Average load time: " << src_load_ms / num << " -> "
+            << dst_load_ms / num << " ms." << std::endl;
+  return 0;
+}
+
+}  // namespace msf
+}  // namespace localization
+}  // namespace apollo
+
+using apollo::localization::msf::ConvertMap;
+using apollo::localization::msf::CreateCompressionStrategy;
+using apollo::localization::msf::CompressionStrategy;
+using apollo::localization::msf::LosslessMapConfig;
+using apollo::localization::msf::LosslessMapNode;
+using apollo::localization::msf::LossyMapConfig2D;
+using apollo::localization::msf::LossyMapNode2D;
+
+int main(int argc, char** argv) {
+  boost::program_options::options_description boost_desc("Allowed options");
+  boost_desc.add_options()("help", "produce help message")(
+      "srcdir", boost::program_options::value<std::string>(),
+      "provide the source map dir")(
+      "dstdir", boost::program_options::value<std::string>(),
+      "provide the converted map destination dir")(
+      "codec", boost::program_options::value<std::string>()->default_value(
+                   "lz4"),
+      "provide the compression codec of the converted map (zlib or lz4)");
+
+  boost::program_options::variables_map boost_args;
+  boost::program_options::store(
+      boost::program_options::parse_command_line(argc, argv, boost_desc),
+      boost_args);
+  boost::program_options::notify(boost_args);
+
+  if (boost_args.count("help") || !boost_args.count("srcdir") ||
+      !boost_args.count("dstdir")) {
+    std::cout << boost_desc << std::endl;
+    return 0;
+  }
+
+  const std::string src_folder = boost_args["srcdir"].as<std::string>();
+  const std::string dst_folder = boost_args["dstdir"].as<std::string>();
+  const std::string codec = boost_args["codec"].as<std::string>();
+  CompressionStrategy* strategy = CreateCompressionStrategy(codec);
+  if (strategy == nullptr) {
+    std::cerr << "Unknown compression codec: " << codec << std::endl;
+    return -1;
+  }
+  delete strategy;
+
+  // the node type is given by the version of the map
+  boost::property_tree::ptree config;
+  boost::property_tree::read_xml(src_folder + "/config.xml", config);
+  const std::string map_version =
+      config.get<std::string>("map.map_config.version");
+  if (map_version == "lossless_map") {
+    return ConvertMap<LosslessMapConfig, LosslessMapNode>(
+        map_version, src_folder, dst_folder, codec);
+  }
+  if (map_version == "lossy_map") {
+    return ConvertMap<LossyMapConfig2D, LossyMapNode2D>(
+        map_version, src_folder, dst_folder, codec);
+  }
+  std::cerr << "Unknown map version: " << map_version << std::endl;
+  return -1;
+}
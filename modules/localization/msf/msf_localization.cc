@@ -17,6 +17,8 @@
 #include "modules/localization/msf/msf_localization.h"
 
 #include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <chrono>
 #include <list>
 
 #include "modules/drivers/gnss/proto/config.pb.h"
@@ -243,7 +245,12 @@ void MSFLocalization::OnPointCloud(const sensor_msgs::PointCloud2 &message) {
     return;
   }
 
+  const auto start_time = std::chrono::steady_clock::now();
   localization_integ_.PcdProcess(message);
+  RecordLidarProcessTime(message.header.stamp.toSec(),
+                         std::chrono::duration<double, std::milli>(
+                             std::chrono::steady_clock::now() - start_time)
+                             .count());
 
   if (FLAGS_lidar_debug_log_flag) {
     std::list<LocalizationResult> lidar_localization_list;
@@ -265,6 +272,38 @@ void MSFLocalization::OnPointCloud(const sensor_msgs::PointCloud2 &message) {
   return;
 }
 
+void MSFLocalization::RecordLidarProcessTime(double timestamp_sec,
+                                             double elapsed_ms) {
+  const double period_ms = (timestamp_sec - last_pcd_timestamp_sec_) * 1000.0;
+  if (last_pcd_timestamp_sec_ > 0.0 && period_ms > 0.0 &&
+      elapsed_ms > period_ms) {
+    ++lidar_overrun_count_;
+  }
+  last_pcd_timestamp_sec_ = timestamp_sec;
+  ++lidar_frame_count_;
+  lidar_total_ms_ += elapsed_ms;
+  lidar_max_ms_ = std::max(lidar_max_ms_, elapsed_ms);
+
+  if (FLAGS_lidar_timing_report_frames <= 0 ||
+      lidar_frame_count_ <
+          static_cast<uint64_t>(FLAGS_lidar_timing_report_frames)) {
+    return;
+  }
+  AINFO << "Lidar matching of " << lidar_frame_count_
+        << " frames: mean " << lidar_total_ms_ / lidar_frame_count_
+        << " ms, max " << lidar_max_ms_ << " ms, " << lidar_overrun_count_
+        << " frames slower than the lidar period.";
+  if (lidar_overrun_count_ > 0) {
+    common::monitor::MonitorLogBuffer buffer(&monitor_logger_);
+    buffer.WARN() << lidar_overrun_count_ << " of " << lidar_frame_count_
+                  << " lidar frames took longer than the lidar period.";
+  }
+  lidar_frame_count_ = 0;
+  lidar_overrun_count_ = 0;
+  lidar_total_ms_ = 0.0;
+  lidar_max_ms_ = 0.0;
+}
+
 void MSFLocalization::OnRawImu(const drivers::gnss::Imu &imu_msg) {
   if (FLAGS_imu_coord_rfu) {
     localization_integ_.RawImuProcessRfu(imu_msg);
@@ -85,6 +85,10 @@ class MSFLocalization : public LocalizationBase {
 
   void PublishPoseBroadcastTF(const LocalizationEstimate &localization);
 
+  // Accounts the time the lidar matching took for a frame, and reports the
+  // timing every lidar_timing_report_frames frames.
+  void RecordLidarProcessTime(double timestamp_sec, double elapsed_ms);
+
  private:
   bool LoadGnssAntennaExtrinsic(const std::string &file_path,
                                 double *offset_x, double *offset_y,
@@ -99,6 +103,14 @@ class MSFLocalization : public LocalizationBase {
   LocalizationMeasureState localization_state_;
   uint64_t pcd_msg_index_;
 
+  // Timing of the lidar frames processed since the last report. A frame
+  // overruns when its processing takes longer than the time to the next one.
+  double last_pcd_timestamp_sec_ = 0.0;
+  uint64_t lidar_frame_count_ = 0;
+  uint64_t lidar_overrun_count_ = 0;
+  double lidar_total_ms_ = 0.0;
+  double lidar_max_ms_ = 0.0;
+
   MeasureState latest_lidar_localization_status_;
   MeasureState latest_gnss_localization_status_;
 
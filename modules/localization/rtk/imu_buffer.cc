@@ -0,0 +1,190 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/rtk/imu_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Eigen/Core"
+
+#include "modules/localization/common/localization_gflags.h"
+
+namespace apollo {
+namespace localization {
+
+namespace {
+
+using ImuValues = Eigen::Array<double, ImuSample::kNumValues, 1>;
+
+const common::Point3D *GetField(const Pose &imu, const ImuSample::Field field) {
+  switch (field) {
+    case ImuSample::ANGULAR_VELOCITY:
+      return imu.has_angular_velocity() ? &imu.angular_velocity() : nullptr;
+    case ImuSample::LINEAR_ACCELERATION:
+      return imu.has_linear_acceleration() ? &imu.linear_acceleration()
+                                           : nullptr;
+    case ImuSample::EULER_ANGLES:
+      return imu.has_euler_angles() ? &imu.euler_angles() : nullptr;
+  }
+  return nullptr;
+}
+
+common::Point3D *MutableField(Pose *imu, const ImuSample::Field field) {
+  switch (field) {
+    case ImuSample::ANGULAR_VELOCITY:
+      return imu->mutable_angular_velocity();
+    case ImuSample::LINEAR_ACCELERATION:
+      return imu->mutable_linear_acceleration();
+    case ImuSample::EULER_ANGLES:
+      return imu->mutable_euler_angles();
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+constexpr int ImuSample::kNumFields;
+constexpr int ImuSample::kNumValues;
+
+void ImuSample::FromImu(const Imu &imu) {
+  timestamp_sec = imu.header().timestamp_sec();
+  fields = 0;
+  std::fill(values, values + kNumValues,
+            std::numeric_limits<double>::quiet_NaN());
+  if (!imu.has_imu()) {
+    return;
+  }
+  for (int i = 0; i < kNumFields; ++i) {
+    const auto *point = GetField(imu.imu(), static_cast<Field>(i));
+    if (point != nullptr) {
+      fields |= 1 << i;
+      // A missing coordinate reads NaN, its default.
+      values[3 * i] = point->x();
+      values[3 * i + 1] = point->y();
+      values[3 * i + 2] = point->z();
+    }
+  }
+}
+
+void ImuSample::ToImu(Imu *imu) const {
+  imu->mutable_header()->set_timestamp_sec(timestamp_sec);
+  for (int i = 0; i < kNumFields; ++i) {
+    if (!has_field(static_cast<Field>(i))) {
+      continue;
+    }
+    auto *point = MutableField(imu->mutable_imu(), static_cast<Field>(i));
+    point->Clear();
+    if (!std::isnan(values[3 * i])) {
+      point->set_x(values[3 * i]);
+    }
+    if (!std::isnan(values[3 * i + 1])) {
+      point->set_y(values[3 * i + 1]);
+    }
+    if (!std::isnan(values[3 * i + 2])) {
+      point->set_z(values[3 * i + 2]);
+    }
+  }
+}
+
+void ImuSample::Interpolate(const ImuSample &sample1, const ImuSample &sample2,
+                            const double timestamp_sec, ImuSample *sample) {
+  *sample = sample1;
+  sample->timestamp_sec = timestamp_sec;
+  const double time_diff = sample2.timestamp_sec - sample1.timestamp_sec;
+  if (std::fabs(time_diff) < 0.001) {
+    return;
+  }
+  const double frac1 = (timestamp_sec - sample1.timestamp_sec) / time_diff;
+  const double frac2 = 1.0 - frac1;
+  // All the fields at once, a NaN coordinate in either sample stays NaN.
+  Eigen::Map<ImuValues>(sample->values) =
+      Eigen::Map<const ImuValues>(sample1.values) * frac2 +
+      Eigen::Map<const ImuValues>(sample2.values) * frac1;
+  for (int i = 0; i < kNumFields; ++i) {
+    if (sample1.has_field(static_cast<Field>(i)) &&
+        !sample2.has_field(static_cast<Field>(i))) {
+      std::copy(sample1.values + 3 * i, sample1.values + 3 * i + 3,
+                sample->values + 3 * i);
+    }
+  }
+}
+
+ImuBuffer::ImuBuffer(const size_t capacity) {
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  samples_.resize(size);
+  mask_ = size - 1;
+}
+
+bool ImuBuffer::Push(const Imu &imu) {
+  if (size_ > 0 && imu.header().timestamp_sec() < Newest().timestamp_sec) {
+    return false;
+  }
+  if (size_ == samples_.size()) {
+    head_ = (head_ + 1) & mask_;
+    --size_;
+  }
+  samples_[(head_ + size_) & mask_].FromImu(imu);
+  ++size_;
+  return true;
+}
+
+void ImuBuffer::Clear() {
+  head_ = 0;
+  size_ = 0;
+}
+
+ImuBuffer::LookupResult ImuBuffer::Lookup(const double timestamp_sec,
+                                          ImuSample *sample) const {
+  if (size_ == 0) {
+    return EMPTY;
+  }
+  // Binary search of the first sample newer than the time.
+  size_t first = 0;
+  size_t count = size_;
+  while (count > 0) {
+    const size_t step = count / 2;
+    if (at(first + step).timestamp_sec - timestamp_sec <=
+        FLAGS_timestamp_sec_tolerance) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  if (first == size_) {
+    *sample = Newest();
+    return TOO_NEW;
+  }
+  if (first == 0) {
+    *sample = Oldest();
+    return TOO_OLD;
+  }
+  const ImuSample &sample1 = at(first - 1);
+  if (timestamp_sec - sample1.timestamp_sec < FLAGS_timestamp_sec_tolerance) {
+    *sample = sample1;
+  } else {
+    ImuSample::Interpolate(sample1, at(first), timestamp_sec, sample);
+  }
+  return INTERPOLATED;
+}
+
+}  // namespace localization
+}  // namespace apollo
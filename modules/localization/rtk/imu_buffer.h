@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file imu_buffer.h
+ * @brief The class of ImuBuffer
+ */
+
+#ifndef MODULES_LOCALIZATION_RTK_IMU_BUFFER_H_
+#define MODULES_LOCALIZATION_RTK_IMU_BUFFER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "modules/localization/proto/imu.pb.h"
+
+/**
+ * @namespace apollo::localization
+ * @brief apollo::localization
+ */
+namespace apollo {
+namespace localization {
+
+/**
+ * @struct ImuSample
+ *
+ * @brief the fields of an Imu message used by the localization, without the
+ * proto overhead.
+ */
+struct ImuSample {
+  enum Field {
+    ANGULAR_VELOCITY = 0,
+    LINEAR_ACCELERATION = 1,
+    EULER_ANGLES = 2,
+  };
+  static constexpr int kNumFields = 3;
+  static constexpr int kNumValues = 3 * kNumFields;
+
+  double timestamp_sec = 0.0;
+  // x, y and z of each field, in the order of Field. A coordinate missing
+  // in the message is NaN.
+  double values[kNumValues];
+  // Bit i is set if the message has Field i.
+  uint8_t fields = 0;
+
+  bool has_field(const Field field) const { return fields & (1 << field); }
+  const double *field(const Field field) const { return values + 3 * field; }
+
+  /**
+   * @brief fill the sample from an Imu message
+   */
+  void FromImu(const Imu &imu);
+
+  /**
+   * @brief fill the fields of the sample into an Imu message, without
+   * clearing the others
+   */
+  void ToImu(Imu *imu) const;
+
+  /**
+   * @brief linearly interpolate two samples, as InterpolateXYZ of
+   * RTKLocalization: the result has the fields of both samples, and a
+   * coordinate missing in one is missing in the result. Samples closer than
+   * 1ms are not interpolated, the first one is taken instead.
+   * @param sample1 the sample before the given time
+   * @param sample2 the sample after the given time
+   * @param timestamp_sec the time to interpolate at
+   * @param sample the interpolated sample, at the given time
+   */
+  static void Interpolate(const ImuSample &sample1, const ImuSample &sample2,
+                          const double timestamp_sec, ImuSample *sample);
+};
+
+/**
+ * @class ImuBuffer
+ *
+ * @brief the latest IMU samples in a ring in time order, for the lookups of
+ * the sample at a given time in O(log(n)) instead of a scan of the IMU
+ * messages. It is not thread-safe.
+ */
+class ImuBuffer {
+ public:
+  /**
+   * @brief the result of a lookup
+   */
+  enum LookupResult {
+    EMPTY,       // no sample
+    TOO_OLD,     // older than the oldest sample, which is returned
+    TOO_NEW,     // newer than the newest sample, which is returned
+    INTERPOLATED,
+  };
+
+  /**
+   * @brief constructor
+   * @param capacity the number of samples kept, rounded up to a power of two
+   */
+  explicit ImuBuffer(const size_t capacity);
+
+  /**
+   * @brief append a message, dropping the oldest sample if full
+   * @return false if the message is older than the newest sample, and
+   * dropped
+   */
+  bool Push(const Imu &imu);
+
+  void Clear();
+
+  bool Empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  /**
+   * @brief the i-th sample, the oldest being the 0-th
+   */
+  const ImuSample &at(const size_t index) const {
+    return samples_[(head_ + index) & mask_];
+  }
+  const ImuSample &Oldest() const { return at(0); }
+  const ImuSample &Newest() const { return at(size_ - 1); }
+
+  /**
+   * @brief look up the sample at a time, interpolated between the samples
+   * around it, without extrapolation
+   * @param timestamp_sec the time
+   * @param sample the sample
+   * @return whether the time is in the buffer
+   */
+  LookupResult Lookup(const double timestamp_sec, ImuSample *sample) const;
+
+ private:
+  std::vector<ImuSample> samples_;
+  size_t mask_ = 0;
+  size_t head_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace localization
+}  // namespace apollo
+
+#endif  // MODULES_LOCALIZATION_RTK_IMU_BUFFER_H_
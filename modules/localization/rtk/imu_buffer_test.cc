@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/localization/rtk/imu_buffer.h"
+
+#include <cmath>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+
+namespace apollo {
+namespace localization {
+
+namespace {
+
+Imu LoadImu(const std::string &filename) {
+  Imu imu;
+  CHECK(common::util::GetProtoFromFile(filename, &imu))
+      << "Failed to open file " << filename;
+  return imu;
+}
+
+Imu MakeImu(const double timestamp_sec, const double value) {
+  Imu imu;
+  imu.mutable_header()->set_timestamp_sec(timestamp_sec);
+  auto *angular_velocity = imu.mutable_imu()->mutable_angular_velocity();
+  angular_velocity->set_x(value);
+  angular_velocity->set_y(-value);
+  angular_velocity->set_z(2.0 * value);
+  imu.mutable_imu()->mutable_linear_acceleration()->set_x(value);
+  return imu;
+}
+
+}  // namespace
+
+TEST(ImuSampleTest, Interpolate) {
+  // timestamp inbetween + time_diff is big enough(>0.001), interpolate
+  {
+    const Imu imu1 = LoadImu("modules/localization/testdata/1_imu_1.pb.txt");
+    const Imu imu2 = LoadImu("modules/localization/testdata/1_imu_2.pb.txt");
+    const Imu expected_result =
+        LoadImu("modules/localization/testdata/1_imu_result.pb.txt");
+
+    ImuSample sample1;
+    sample1.FromImu(imu1);
+    ImuSample sample2;
+    sample2.FromImu(imu2);
+    ImuSample sample;
+    ImuSample::Interpolate(sample1, sample2, 1173545122.69, &sample);
+    Imu imu = imu1;
+    sample.ToImu(&imu);
+    EXPECT_EQ(expected_result.DebugString(), imu.DebugString());
+  }
+
+  // timestamp inbetween + time_diff is too small(<0.001), no interpolate
+  {
+    const Imu imu1 = LoadImu("modules/localization/testdata/2_imu_1.pb.txt");
+    const Imu imu2 = LoadImu("modules/localization/testdata/2_imu_2.pb.txt");
+    const Imu expected_result =
+        LoadImu("modules/localization/testdata/2_imu_result.pb.txt");
+
+    ImuSample sample1;
+    sample1.FromImu(imu1);
+    ImuSample sample2;
+    sample2.FromImu(imu2);
+    ImuSample sample;
+    ImuSample::Interpolate(sample1, sample2, 1173545122.2001, &sample);
+    Imu imu = imu1;
+    sample.ToImu(&imu);
+    EXPECT_EQ(expected_result.DebugString(), imu.DebugString());
+  }
+}
+
+TEST(ImuSampleTest, MissingFields) {
+  Imu imu1 = MakeImu(1.0, 1.0);
+  imu1.mutable_imu()->mutable_euler_angles()->set_z(0.5);
+  Imu imu2 = MakeImu(2.0, 3.0);
+  imu2.mutable_imu()->clear_angular_velocity();
+
+  ImuSample sample1;
+  sample1.FromImu(imu1);
+  ImuSample sample2;
+  sample2.FromImu(imu2);
+  ImuSample sample;
+  ImuSample::Interpolate(sample1, sample2, 1.5, &sample);
+  Imu imu;
+  sample.ToImu(&imu);
+  EXPECT_DOUBLE_EQ(1.5, imu.header().timestamp_sec());
+  // the field missing in the second message is the one of the first
+  EXPECT_DOUBLE_EQ(1.0, imu.imu().angular_velocity().x());
+  EXPECT_DOUBLE_EQ(2.0, imu.imu().angular_velocity().z());
+  // the coordinates missing in either message are missing
+  EXPECT_DOUBLE_EQ(2.0, imu.imu().linear_acceleration().x());
+  EXPECT_FALSE(imu.imu().linear_acceleration().has_y());
+  EXPECT_TRUE(imu.imu().has_euler_angles());
+  EXPECT_DOUBLE_EQ(0.5, imu.imu().euler_angles().z());
+  EXPECT_FALSE(imu.imu().euler_angles().has_x());
+}
+
+TEST(ImuBufferTest, Lookup) {
+  ImuBuffer buffer(4);
+  ImuSample sample;
+  EXPECT_EQ(ImuBuffer::EMPTY, buffer.Lookup(1.0, &sample));
+
+  // six messages, of which the buffer keeps the last four
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_TRUE(buffer.Push(MakeImu(0.01 * i, i)));
+  }
+  EXPECT_FALSE(buffer.Push(MakeImu(0.0, 0.0)));
+  ASSERT_EQ(4, buffer.size());
+  EXPECT_DOUBLE_EQ(0.02, buffer.Oldest().timestamp_sec);
+  EXPECT_DOUBLE_EQ(0.05, buffer.Newest().timestamp_sec);
+
+  EXPECT_EQ(ImuBuffer::INTERPOLATED, buffer.Lookup(0.035, &sample));
+  EXPECT_DOUBLE_EQ(0.035, sample.timestamp_sec);
+  EXPECT_NEAR(3.5, sample.field(ImuSample::ANGULAR_VELOCITY)[0], 1e-9);
+  EXPECT_NEAR(7.0, sample.field(ImuSample::ANGULAR_VELOCITY)[2], 1e-9);
+
+  EXPECT_EQ(ImuBuffer::INTERPOLATED, buffer.Lookup(0.02, &sample));
+  EXPECT_DOUBLE_EQ(2.0, sample.field(ImuSample::ANGULAR_VELOCITY)[0]);
+
+  EXPECT_EQ(ImuBuffer::TOO_OLD, buffer.Lookup(0.01, &sample));
+  EXPECT_DOUBLE_EQ(0.02, sample.timestamp_sec);
+  EXPECT_EQ(ImuBuffer::TOO_NEW, buffer.Lookup(0.06, &sample));
+  EXPECT_DOUBLE_EQ(0.05, sample.timestamp_sec);
+
+  buffer.Clear();
+  EXPECT_TRUE(buffer.Empty());
+  EXPECT_EQ(ImuBuffer::EMPTY, buffer.Lookup(0.035, &sample));
+}
+
+}  // namespace localization
+}  // namespace apollo
@@ -16,6 +16,10 @@
 
 #include "modules/localization/rtk/rtk_localization.h"
 
+#include <cmath>
+
+#include "Eigen/Geometry"
+
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/math/quaternion.h"
 #include "modules/common/time/time.h"
@@ -26,14 +30,14 @@ namespace localization {
 
 using ::Eigen::Vector3d;
 using apollo::common::adapter::AdapterManager;
-using apollo::common::adapter::ImuAdapter;
 using apollo::common::monitor::MonitorMessageItem;
 using apollo::common::Status;
 using apollo::common::time::Clock;
 
 RTKLocalization::RTKLocalization()
     : monitor_logger_(MonitorMessageItem::LOCALIZATION),
-      map_offset_{FLAGS_map_offset_x, FLAGS_map_offset_y, FLAGS_map_offset_z} {}
+      map_offset_{FLAGS_map_offset_x, FLAGS_map_offset_y, FLAGS_map_offset_z},
+      imu_buffer_(FLAGS_rtk_imu_buffer_size) {}
 
 RTKLocalization::~RTKLocalization() {
   if (tf2_broadcaster_) {
@@ -60,6 +64,7 @@ Status RTKLocalization::Start() {
     buffer.PrintLog();
     return Status(common::LOCALIZATION_ERROR, "no IMU adapter");
   }
+  AdapterManager::AddImuCallback(&RTKLocalization::OnImu, this);
 
   tf2_broadcaster_ = new tf2_ros::TransformBroadcaster;
 
@@ -109,21 +114,25 @@ void RTKLocalization::OnTimer(const ros::TimerEvent &event) {
   last_received_timestamp_sec_ = common::time::ToSecond(Clock::Now());
 }
 
-template <class T>
-T RTKLocalization::InterpolateXYZ(const T &p1, const T &p2,
-                                  const double &frac1) {
-  T p;
-  double frac2 = 1.0 - frac1;
-  if (p1.has_x() && !std::isnan(p1.x()) && p2.has_x() && !std::isnan(p2.x())) {
-    p.set_x(p1.x() * frac2 + p2.x() * frac1);
-  }
-  if (p1.has_y() && !std::isnan(p1.y()) && p2.has_y() && !std::isnan(p2.y())) {
-    p.set_y(p1.y() * frac2 + p2.y() * frac1);
-  }
-  if (p1.has_z() && !std::isnan(p1.z()) && p2.has_z() && !std::isnan(p2.z())) {
-    p.set_z(p1.z() * frac2 + p2.z() * frac1);
+void RTKLocalization::OnImu(const localization::Imu &imu) {
+  LocalizationEstimate localization;
+  {
+    std::lock_guard<std::mutex> lock(imu_mutex_);
+    if (!imu_buffer_.Push(imu)) {
+      AWARN << "[OnImu]: dropped IMU message older than the newest one. "
+            << "Timestamp[" << imu.header().timestamp_sec() << "]";
+      return;
+    }
+    if (!FLAGS_enable_imu_rate_localization || !has_gps_localization_) {
+      return;
+    }
+    if (!ExtrapolateLocalization(gps_localization_, imu_buffer_.Newest(),
+                                 &localization)) {
+      return;
+    }
   }
-  return p;
+  AdapterManager::PublishLocalization(localization);
+  PublishPoseBroadcastTF(localization);
 }
 
 bool RTKLocalization::FindMatchingIMU(const double gps_timestamp_sec,
@@ -132,108 +141,40 @@ bool RTKLocalization::FindMatchingIMU(const double gps_timestamp_sec,
     AERROR << "imu_msg should NOT be nullptr.";
     return false;
   }
-  auto *imu_adapter = AdapterManager::GetImu();
-  if (imu_adapter->Empty()) {
-    AERROR << "[FindMatchingIMU]: Cannot find Matching IMU. "
-           << "IMU message Queue is empty! GPS timestamp[" << gps_timestamp_sec
-           << "]";
-    return false;
-  }
-
-  // scan imu buffer, find first imu message that is newer than the given
-  // timestamp
-  ImuAdapter::Iterator imu_it = imu_adapter->begin();
-  for (; imu_it != imu_adapter->end(); ++imu_it) {
-    if ((*imu_it)->header().timestamp_sec() - gps_timestamp_sec >
-        FLAGS_timestamp_sec_tolerance) {
-      break;
-    }
-  }
-
-  if (imu_it != imu_adapter->end()) {  // found one
-    if (imu_it == imu_adapter->begin()) {
+  ImuSample imu;
+  std::lock_guard<std::mutex> lock(imu_mutex_);
+  switch (imu_buffer_.Lookup(gps_timestamp_sec, &imu)) {
+    case ImuBuffer::EMPTY:
+      AERROR << "[FindMatchingIMU]: Cannot find Matching IMU. "
+             << "IMU message Queue is empty! GPS timestamp["
+             << gps_timestamp_sec << "]";
+      return false;
+    case ImuBuffer::TOO_OLD:
       AERROR << "[FindMatchingIMU]: IMU queue too short or request too old. "
-             << "Oldest timestamp["
-             << imu_adapter->GetOldestObserved().header().timestamp_sec()
-             << "], Newest timestamp["
-             << imu_adapter->GetLatestObserved().header().timestamp_sec()
+             << "Oldest timestamp[" << imu_buffer_.Oldest().timestamp_sec
+             << "], Newest timestamp[" << imu_buffer_.Newest().timestamp_sec
              << "], GPS timestamp[" << gps_timestamp_sec << "]";
-      *imu_msg = imu_adapter->GetOldestObserved();  // the oldest imu
-    } else {
+      break;
+    case ImuBuffer::TOO_NEW:
+      // the newest imu, without extrapolation
+      if (fabs(imu.timestamp_sec - gps_timestamp_sec) >
+          FLAGS_report_gps_imu_time_diff_threshold) {
+        // 20ms threshold to report error
+        AERROR << "[FindMatchingIMU]: Cannot find Matching IMU. "
+               << "IMU messages too old"
+               << "Newest timestamp[" << imu.timestamp_sec
+               << "], GPS timestamp[" << gps_timestamp_sec << "]";
+      }
+      break;
+    case ImuBuffer::INTERPOLATED:
       // here is the normal case
-      auto imu_it_1 = imu_it;
-      imu_it_1--;
-      InterpolateIMU(**imu_it_1, **imu_it, gps_timestamp_sec, imu_msg);
-    }
-  } else {
-    // give the newest imu, without extrapolation
-    *imu_msg = imu_adapter->GetLatestObserved();
-
-    if (fabs(imu_msg->header().timestamp_sec() - gps_timestamp_sec) >
-        FLAGS_report_gps_imu_time_diff_threshold) {
-      // 20ms threshold to report error
-      AERROR << "[FindMatchingIMU]: Cannot find Matching IMU. "
-             << "IMU messages too old"
-             << "Newest timestamp["
-             << imu_adapter->GetLatestObserved().header().timestamp_sec()
-             << "], GPS timestamp[" << gps_timestamp_sec << "]";
-    }
+      break;
   }
+  imu_msg->Clear();
+  imu.ToImu(imu_msg);
   return true;
 }
 
-void RTKLocalization::InterpolateIMU(const Imu &imu1, const Imu &imu2,
-                                     const double timestamp_sec, Imu *imu_msg) {
-  DCHECK_NOTNULL(imu_msg);
-  if (timestamp_sec - imu1.header().timestamp_sec() <
-      FLAGS_timestamp_sec_tolerance) {
-    AERROR << "[InterpolateIMU]: the given time stamp[" << timestamp_sec
-           << "] is older than the 1st message["
-           << imu1.header().timestamp_sec() << "]";
-    *imu_msg = imu1;
-  } else if (timestamp_sec - imu2.header().timestamp_sec() >
-             FLAGS_timestamp_sec_tolerance) {
-    AERROR << "[InterpolateIMU]: the given time stamp[" << timestamp_sec
-           << "] is newer than the 2nd message["
-           << imu2.header().timestamp_sec() << "]";
-    *imu_msg = imu1;
-  } else {
-    *imu_msg = imu1;
-    imu_msg->mutable_header()->set_timestamp_sec(timestamp_sec);
-
-    if (imu1.has_header() && imu1.header().has_timestamp_sec() &&
-        imu2.has_header() && imu2.header().has_timestamp_sec()) {
-      double time_diff =
-          imu2.header().timestamp_sec() - imu1.header().timestamp_sec();
-      if (fabs(time_diff) >= 0.001) {
-        double frac1 =
-            (timestamp_sec - imu1.header().timestamp_sec()) / time_diff;
-
-        if (imu1.has_imu() && imu1.imu().has_angular_velocity() &&
-            imu2.has_imu() && imu2.imu().has_angular_velocity()) {
-          auto val = InterpolateXYZ(imu1.imu().angular_velocity(),
-                                    imu2.imu().angular_velocity(), frac1);
-          imu_msg->mutable_imu()->mutable_angular_velocity()->CopyFrom(val);
-        }
-
-        if (imu1.has_imu() && imu1.imu().has_linear_acceleration() &&
-            imu2.has_imu() && imu2.imu().has_linear_acceleration()) {
-          auto val = InterpolateXYZ(imu1.imu().linear_acceleration(),
-                                    imu2.imu().linear_acceleration(), frac1);
-          imu_msg->mutable_imu()->mutable_linear_acceleration()->CopyFrom(val);
-        }
-
-        if (imu1.has_imu() && imu1.imu().has_euler_angles() && imu2.has_imu() &&
-            imu2.imu().has_euler_angles()) {
-          auto val = InterpolateXYZ(imu1.imu().euler_angles(),
-                                    imu2.imu().euler_angles(), frac1);
-          imu_msg->mutable_imu()->mutable_euler_angles()->CopyFrom(val);
-        }
-      }
-    }
-  }
-}
-
 void RTKLocalization::PrepareLocalizationMsg(
     LocalizationEstimate *localization) {
   const auto &gps_msg = AdapterManager::GetGps()->GetLatestObserved();
@@ -309,6 +250,12 @@ void RTKLocalization::ComposeLocalizationMsg(
     }
   }
 
+  ComposeImuFields(imu_msg, localization);
+}
+
+void RTKLocalization::ComposeImuFields(const localization::Imu &imu_msg,
+                                       LocalizationEstimate *localization) {
+  auto mutable_pose = localization->mutable_pose();
   if (imu_msg.has_imu()) {
     const auto &imu = imu_msg.imu();
     // linear acceleration
@@ -374,10 +321,96 @@ void RTKLocalization::ComposeLocalizationMsg(
   }
 }
 
+bool RTKLocalization::ExtrapolateLocalization(
+    const LocalizationEstimate &gps_localization, const ImuSample &imu,
+    LocalizationEstimate *localization) {
+  const double dt = imu.timestamp_sec - gps_localization.measurement_time();
+  if (dt < 0.0 || dt > FLAGS_imu_rate_localization_max_extrapolation_sec) {
+    ADEBUG << "[ExtrapolateLocalization]: IMU timestamp[" << imu.timestamp_sec
+           << "] too far from GPS timestamp["
+           << gps_localization.measurement_time() << "]";
+    return false;
+  }
+  localization->CopyFrom(gps_localization);
+  AdapterManager::FillLocalizationHeader(FLAGS_localization_module_name,
+                                         localization);
+  if (FLAGS_enable_gps_timestamp) {
+    localization->mutable_header()->set_timestamp_sec(imu.timestamp_sec);
+  }
+  localization->set_measurement_time(imu.timestamp_sec);
+
+  auto *pose = localization->mutable_pose();
+  const Eigen::Map<const Vector3d> acceleration_vrf(
+      imu.field(ImuSample::LINEAR_ACCELERATION));
+  const Eigen::Map<const Vector3d> angular_velocity_vrf(
+      imu.field(ImuSample::ANGULAR_VELOCITY));
+
+  // position and velocity, at the acceleration of the IMU sample
+  if (pose->has_position() && pose->has_linear_velocity()) {
+    Vector3d acceleration = Vector3d::Zero();
+    if (pose->has_orientation() &&
+        imu.has_field(ImuSample::LINEAR_ACCELERATION) &&
+        acceleration_vrf.allFinite()) {
+      acceleration =
+          common::math::QuaternionRotate(pose->orientation(), acceleration_vrf);
+    }
+    auto *position = pose->mutable_position();
+    auto *velocity = pose->mutable_linear_velocity();
+    position->set_x(position->x() + velocity->x() * dt +
+                    0.5 * acceleration[0] * dt * dt);
+    position->set_y(position->y() + velocity->y() * dt +
+                    0.5 * acceleration[1] * dt * dt);
+    position->set_z(position->z() + velocity->z() * dt +
+                    0.5 * acceleration[2] * dt * dt);
+    velocity->set_x(velocity->x() + acceleration[0] * dt);
+    velocity->set_y(velocity->y() + acceleration[1] * dt);
+    velocity->set_z(velocity->z() + acceleration[2] * dt);
+  }
+
+  // orientation, turned at the angular velocity of the IMU sample, which is
+  // in the vehicle reference
+  if (pose->has_orientation() && imu.has_field(ImuSample::ANGULAR_VELOCITY) &&
+      angular_velocity_vrf.allFinite()) {
+    const auto &orientation = pose->orientation();
+    Eigen::Quaterniond q(orientation.qw(), orientation.qx(), orientation.qy(),
+                         orientation.qz());
+    const double angle = angular_velocity_vrf.norm() * dt;
+    if (angle > 0.0) {
+      q = q * Eigen::Quaterniond(Eigen::AngleAxisd(
+                  angle, angular_velocity_vrf.normalized()));
+      q.normalize();
+    }
+    pose->mutable_orientation()->set_qw(q.w());
+    pose->mutable_orientation()->set_qx(q.x());
+    pose->mutable_orientation()->set_qy(q.y());
+    pose->mutable_orientation()->set_qz(q.z());
+    pose->set_heading(common::math::QuaternionToHeading(q));
+  }
+
+  // the IMU fields of the sample replace those at the GPS message
+  pose->clear_linear_acceleration();
+  pose->clear_linear_acceleration_vrf();
+  pose->clear_angular_velocity();
+  pose->clear_angular_velocity_vrf();
+  pose->clear_euler_angles();
+  Imu imu_msg;
+  imu.ToImu(&imu_msg);
+  ComposeImuFields(imu_msg, localization);
+  return true;
+}
+
 void RTKLocalization::PublishLocalization() {
   LocalizationEstimate localization;
   PrepareLocalizationMsg(&localization);
 
+  if (FLAGS_enable_imu_rate_localization) {
+    // OnImu() publishes, extrapolated from this GPS message
+    std::lock_guard<std::mutex> lock(imu_mutex_);
+    gps_localization_.Swap(&localization);
+    has_gps_localization_ = true;
+    return;
+  }
+
   // publish localization messages
   AdapterManager::PublishLocalization(localization);
   PublishPoseBroadcastTF(localization);
@@ -22,6 +22,7 @@
 #ifndef MODULES_LOCALIZATION_RTK_RTK_LOCALIZATION_H_
 #define MODULES_LOCALIZATION_RTK_RTK_LOCALIZATION_H_
 
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -40,6 +41,7 @@
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 #include "modules/common/status/status.h"
 #include "modules/localization/localization_base.h"
+#include "modules/localization/rtk/imu_buffer.h"
 
 /**
  * @namespace apollo::localization
@@ -72,6 +74,7 @@ class RTKLocalization : public LocalizationBase {
 
  private:
   void OnTimer(const ros::TimerEvent &event);
+  void OnImu(const localization::Imu &imu);
   void PublishLocalization();
   void PublishPoseBroadcastTF(const LocalizationEstimate &localization);
   void RunWatchDog();
@@ -80,11 +83,14 @@ class RTKLocalization : public LocalizationBase {
   void ComposeLocalizationMsg(const localization::Gps &gps,
                               const localization::Imu &imu,
                               LocalizationEstimate *localization);
+  void ComposeImuFields(const localization::Imu &imu,
+                        LocalizationEstimate *localization);
+  // Extrapolates the localization at a GPS message to the time of an IMU
+  // sample, false if the sample is older or too much newer.
+  bool ExtrapolateLocalization(const LocalizationEstimate &gps_localization,
+                               const ImuSample &imu,
+                               LocalizationEstimate *localization);
   bool FindMatchingIMU(const double gps_timestamp_sec, Imu *imu_msg);
-  void InterpolateIMU(const Imu &imu1, const Imu &imu2,
-                      const double timestamp_sec, Imu *msgbuf);
-  template <class T>
-  T InterpolateXYZ(const T &p1, const T &p2, const double &frac1);
 
  private:
   ros::Timer timer_;
@@ -95,8 +101,17 @@ class RTKLocalization : public LocalizationBase {
   double last_reported_timestamp_sec_ = 0.0;
   bool service_started_ = false;
 
-  FRIEND_TEST(RTKLocalizationTest, InterpolateIMU);
+  // The IMU messages, pushed by OnImu(), and the localization at the last
+  // GPS message, extrapolated along the IMU messages if
+  // --enable_imu_rate_localization is set. Guarded by imu_mutex_.
+  std::mutex imu_mutex_;
+  ImuBuffer imu_buffer_;
+  LocalizationEstimate gps_localization_;
+  bool has_gps_localization_ = false;
+
   FRIEND_TEST(RTKLocalizationTest, ComposeLocalizationMsg);
+  FRIEND_TEST(RTKLocalizationTest, FindMatchingIMU);
+  FRIEND_TEST(RTKLocalizationTest, ExtrapolateLocalization);
 };
 
 }  // namespace localization
@@ -59,80 +59,32 @@ class RTKLocalizationTest : public ::testing::Test {
   std::unique_ptr<RTKLocalization> rtk_localizatoin_;
 };
 
-TEST_F(RTKLocalizationTest, InterpolateIMU) {
-  // timestamp inbetween + time_diff is big enough(>0.001), interpolate
-  {
-    apollo::localization::Imu imu1;
-    load_data("modules/localization/testdata/1_imu_1.pb.txt", &imu1);
-
-    apollo::localization::Imu imu2;
-    load_data("modules/localization/testdata/1_imu_2.pb.txt", &imu2);
-
-    apollo::localization::Imu expected_result;
-    load_data("modules/localization/testdata/1_imu_result.pb.txt",
-              &expected_result);
-
-    apollo::localization::Imu imu;
-    double timestamp = 1173545122.69;
-    rtk_localizatoin_->InterpolateIMU(imu1, imu2, timestamp, &imu);
-
-    EXPECT_EQ(expected_result.DebugString(), imu.DebugString());
-  }
-
-  // timestamp inbetween + time_diff is too small(<0.001), no interpolate
-  {
-    apollo::localization::Imu imu1;
-    load_data("modules/localization/testdata/2_imu_1.pb.txt", &imu1);
-
-    apollo::localization::Imu imu2;
-    load_data("modules/localization/testdata/2_imu_2.pb.txt", &imu2);
-
-    apollo::localization::Imu expected_result;
-    load_data("modules/localization/testdata/2_imu_result.pb.txt",
-              &expected_result);
-
-    apollo::localization::Imu imu;
-    double timestamp = 1173545122.2001;
-    rtk_localizatoin_->InterpolateIMU(imu1, imu2, timestamp, &imu);
-
-    EXPECT_EQ(expected_result.DebugString(), imu.DebugString());
-  }
-
-  // timestamp < imu1.timestamp
-  {
-    apollo::localization::Imu imu1;
-    load_data("modules/localization/testdata/1_imu_1.pb.txt", &imu1);
-
-    apollo::localization::Imu imu2;
-    load_data("modules/localization/testdata/1_imu_2.pb.txt", &imu2);
-
-    apollo::localization::Imu expected_result;
-    load_data("modules/localization/testdata/1_imu_1.pb.txt", &expected_result);
-
-    apollo::localization::Imu imu;
-    double timestamp = 1173545122;
-    rtk_localizatoin_->InterpolateIMU(imu1, imu2, timestamp, &imu);
-
-    EXPECT_EQ(expected_result.DebugString(), imu.DebugString());
-  }
-
-  // timestamp > imu2.timestamp
-  {
-    apollo::localization::Imu imu1;
-    load_data("modules/localization/testdata/1_imu_1.pb.txt", &imu1);
-
-    apollo::localization::Imu imu2;
-    load_data("modules/localization/testdata/1_imu_2.pb.txt", &imu2);
-
-    apollo::localization::Imu expected_result;
-    load_data("modules/localization/testdata/1_imu_1.pb.txt", &expected_result);
-
-    apollo::localization::Imu imu;
-    double timestamp = 1173545122.70;
-    rtk_localizatoin_->InterpolateIMU(imu1, imu2, timestamp, &imu);
-
-    EXPECT_EQ(expected_result.DebugString(), imu.DebugString());
-  }
+TEST_F(RTKLocalizationTest, FindMatchingIMU) {
+  apollo::localization::Imu imu;
+  EXPECT_FALSE(rtk_localizatoin_->FindMatchingIMU(1173545122.5, &imu));
+
+  apollo::localization::Imu imu1;
+  load_data("modules/localization/testdata/1_imu_1.pb.txt", &imu1);
+  apollo::localization::Imu imu2;
+  load_data("modules/localization/testdata/1_imu_2.pb.txt", &imu2);
+  ASSERT_TRUE(rtk_localizatoin_->imu_buffer_.Push(imu1));
+  ASSERT_TRUE(rtk_localizatoin_->imu_buffer_.Push(imu2));
+
+  // timestamp inbetween, interpolate
+  const double frac = (1173545122.5 - 1173545122.2) / 0.49;
+  ASSERT_TRUE(rtk_localizatoin_->FindMatchingIMU(1173545122.5, &imu));
+  EXPECT_DOUBLE_EQ(1173545122.5, imu.header().timestamp_sec());
+  EXPECT_NEAR(imu1.imu().angular_velocity().x() * (1.0 - frac) +
+                  imu2.imu().angular_velocity().x() * frac,
+              imu.imu().angular_velocity().x(), 1e-9);
+
+  // timestamp < imu1.timestamp, the oldest imu
+  ASSERT_TRUE(rtk_localizatoin_->FindMatchingIMU(1173545122, &imu));
+  EXPECT_EQ(imu1.DebugString(), imu.DebugString());
+
+  // timestamp > imu2.timestamp, the newest imu
+  ASSERT_TRUE(rtk_localizatoin_->FindMatchingIMU(1173545123, &imu));
+  EXPECT_EQ(imu2.DebugString(), imu.DebugString());
 }
 
 TEST_F(RTKLocalizationTest, ComposeLocalizationMsg) {
@@ -185,5 +137,49 @@ TEST_F(RTKLocalizationTest, ComposeLocalizationMsg) {
   // TODO(Qi Luo) Update test once got new imu data for euler angle.
 }
 
+TEST_F(RTKLocalizationTest, ExtrapolateLocalization) {
+  FLAGS_enable_map_reference_unify = true;
+
+  apollo::localization::Gps gps;
+  load_data("modules/localization/testdata/3_gps_1.pb.txt", &gps);
+  apollo::localization::Imu imu;
+  load_data("modules/localization/testdata/3_imu_1.pb.txt", &imu);
+  apollo::localization::LocalizationEstimate gps_localization;
+  rtk_localizatoin_->ComposeLocalizationMsg(gps, imu, &gps_localization);
+
+  const double dt = 0.01;
+  ImuSample sample;
+  sample.FromImu(imu);
+  sample.timestamp_sec += dt;
+  apollo::localization::LocalizationEstimate localization;
+  ASSERT_TRUE(rtk_localizatoin_->ExtrapolateLocalization(gps_localization,
+                                                         sample,
+                                                         &localization));
+  EXPECT_DOUBLE_EQ(sample.timestamp_sec, localization.measurement_time());
+
+  const auto &gps_pose = gps_localization.pose();
+  const auto &pose = localization.pose();
+  EXPECT_NEAR(gps_pose.position().x() + gps_pose.linear_velocity().x() * dt,
+              pose.position().x(), 1e-4);
+  EXPECT_NEAR(gps_pose.position().y() + gps_pose.linear_velocity().y() * dt,
+              pose.position().y(), 1e-4);
+  EXPECT_NEAR(gps_pose.linear_velocity().x() +
+                  gps_pose.linear_acceleration().x() * dt,
+              pose.linear_velocity().x(), 1e-6);
+  // the vehicle is nearly level, so its heading turns at the yaw rate
+  EXPECT_NEAR(gps_pose.heading() + imu.imu().angular_velocity().z() * dt,
+              pose.heading(), 1e-5);
+  EXPECT_EQ(gps_pose.angular_velocity_vrf().DebugString(),
+            pose.angular_velocity_vrf().DebugString());
+
+  // no extrapolation backward in time, nor too far
+  sample.timestamp_sec = gps_localization.measurement_time() - dt;
+  EXPECT_FALSE(rtk_localizatoin_->ExtrapolateLocalization(
+      gps_localization, sample, &localization));
+  sample.timestamp_sec = gps_localization.measurement_time() + 1.0;
+  EXPECT_FALSE(rtk_localizatoin_->ExtrapolateLocalization(
+      gps_localization, sample, &localization));
+}
+
 }  // namespace localization
 }  // namespace apollo
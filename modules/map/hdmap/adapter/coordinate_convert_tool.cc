@@ -20,8 +20,37 @@ namespace apollo {
 namespace hdmap {
 namespace adapter {
 
+namespace {
+
+// The projections of one thread, built from the params of a version.
+struct ThreadProjections {
+  int version = -1;
+  projCtx context = NULL;
+  projPJ pj_from = NULL;
+  projPJ pj_to = NULL;
+
+  void Reset() {
+    if (pj_from) {
+      pj_free(pj_from);
+      pj_from = NULL;
+    }
+    if (pj_to) {
+      pj_free(pj_to);
+      pj_to = NULL;
+    }
+    if (context) {
+      pj_ctx_free(context);
+      context = NULL;
+    }
+  }
+
+  ~ThreadProjections() { Reset(); }
+};
+
+}  // namespace
+
 CoordinateConvertTool::CoordinateConvertTool()
-  : pj_from_(NULL), pj_to_(NULL) {}
+  : param_version_(0), pj_from_(NULL), pj_to_(NULL) {}
 
 CoordinateConvertTool::~CoordinateConvertTool() {
   if (pj_from_) {
@@ -42,6 +71,8 @@ CoordinateConvertTool* CoordinateConvertTool::GetInstance() {
 
 Status CoordinateConvertTool::SetConvertParam(const std::string &source_param,
                                              const std::string &dst_param) {
+  std::lock_guard<std::mutex> lock(param_mutex_);
+  ++param_version_;
   source_convert_param_ = source_param;
   dst_convert_param_ = dst_param;
   if (pj_from_) {
@@ -77,7 +108,22 @@ Status CoordinateConvertTool::CoordiateConvert(const double longitude,
   CHECK_NOTNULL(utm_x);
   CHECK_NOTNULL(utm_y);
   CHECK_NOTNULL(utm_z);
-  if (!pj_from_ || !pj_to_) {
+  thread_local ThreadProjections projections;
+  if (projections.version != param_version_) {
+    std::lock_guard<std::mutex> lock(param_mutex_);
+    projections.Reset();
+    projections.version = param_version_;
+    if (pj_from_ && pj_to_) {
+      projections.context = pj_ctx_alloc();
+      projections.pj_from = pj_init_plus_ctx(projections.context,
+                                             source_convert_param_.c_str());
+      projections.pj_to = pj_init_plus_ctx(projections.context,
+                                           dst_convert_param_.c_str());
+    }
+  }
+  projPJ pj_from = projections.pj_from;
+  projPJ pj_to = projections.pj_to;
+  if (!pj_from || !pj_to) {
       std::string err_msg = "no transform param";
       return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
   }
@@ -86,19 +132,19 @@ Status CoordinateConvertTool::CoordiateConvert(const double longitude,
   double gps_latitude = latitude;
   double gps_alt = height_ellipsoid;
 
-  if (pj_is_latlong(pj_from_)) {
+  if (pj_is_latlong(pj_from)) {
     gps_longitude *= DEG_TO_RAD;
     gps_latitude *= DEG_TO_RAD;
     gps_alt = height_ellipsoid;
   }
 
-  if (0 != pj_transform(pj_from_, pj_to_, 1, 1, &gps_longitude,
+  if (0 != pj_transform(pj_from, pj_to, 1, 1, &gps_longitude,
                           &gps_latitude, &gps_alt)) {
     std::string err_msg = "fail to transform coordinate";
     return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
   }
 
-  if (pj_is_latlong(pj_to_)) {
+  if (pj_is_latlong(pj_to)) {
     gps_longitude *= RAD_TO_DEG;
     gps_latitude *= RAD_TO_DEG;
   }
@@ -15,6 +15,8 @@ limitations under the License.
 #ifndef MODULES_MAP_MAP_LOADER_ADAPTER_COORDINATE_CONVERT_TOOL_H_
 #define MODULES_MAP_MAP_LOADER_ADAPTER_COORDINATE_CONVERT_TOOL_H_
 #include <proj_api.h>
+#include <atomic>
+#include <mutex>
 #include <string>
 #include "modules/map/hdmap/adapter/xml_parser/status.h"
 
@@ -33,6 +35,8 @@ class CoordinateConvertTool {
  public:
   Status SetConvertParam(const std::string &source_param,
                         const std::string &dst_param);
+  // Thread safe: proj4 projections must not be shared between threads, so
+  // every calling thread converts with projections of its own.
   Status CoordiateConvert(const double longitude, const double latitude,
                           const double height_ellipsoid, double* utm_x,
                           double* utm_y, double* utm_z);
@@ -40,6 +44,10 @@ class CoordinateConvertTool {
  private:
   std::string source_convert_param_;
   std::string dst_convert_param_;
+  // Incremented by SetConvertParam, so that every thread rebuilds its
+  // projections; the params are guarded by param_mutex_.
+  std::atomic<int> param_version_;
+  std::mutex param_mutex_;
 
   projPJ pj_from_;
   projPJ pj_to_;
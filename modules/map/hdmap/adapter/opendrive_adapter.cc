@@ -16,6 +16,7 @@ limitations under the License.
 
 #include <vector>
 
+#include "modules/common/configs/config_gflags.h"
 #include "modules/common/log.h"
 #include "modules/map/hdmap/adapter/proto_organizer.h"
 #include "modules/map/hdmap/adapter/xml_parser/status.h"
@@ -47,7 +48,8 @@ bool OpendriveAdapter::LoadData(const std::string& filename,
 
   // roads
   std::vector<RoadInternal> roads;
-  status = RoadsXmlParser::Parse(*root_node, &roads);
+  status = RoadsXmlParser::Parse(*root_node, FLAGS_opendrive_parse_threads,
+                                 &roads);
   if (!status.ok()) {
     AERROR << "fail to parse opendrive road, " << status.error_message();
     return false;
@@ -64,7 +66,8 @@ bool OpendriveAdapter::LoadData(const std::string& filename,
   ProtoOrganizer proto_organizer;
   proto_organizer.GetRoadElements(&roads);
   proto_organizer.GetJunctionElements(junctions);
-  proto_organizer.GetOverlapElements(roads, junctions);
+  proto_organizer.GetOverlapElements(roads, junctions,
+                                     FLAGS_opendrive_parse_threads);
   proto_organizer.OutputData(pb_map);
 
   return true;
@@ -25,6 +25,7 @@ limitations under the License.
 #include "modules/common/log.h"
 #include "modules/common/math/polygon2d.h"
 #include "modules/common/math/vec2d.h"
+#include "modules/common/util/parallel_for.h"
 
 namespace {
 
@@ -111,9 +112,10 @@ void ProtoOrganizer::GetJunctionElements(
   }
 }
 
-void ProtoOrganizer::GetLaneObjectOverlapElements(
+void ProtoOrganizer::CreateLaneObjectOverlaps(
     const std::string& lane_id,
-    const std::vector<OverlapWithLane>& overlap_with_lanes) {
+    const std::vector<OverlapWithLane>& overlap_with_lanes,
+    std::vector<PbOverlap>* overlaps) const {
   for (auto& overlap_object : overlap_with_lanes) {
     std::string object_id = overlap_object.object_id;
     if (proto_data_.pb_crosswalks.count(object_id) <= 0 &&
@@ -121,10 +123,8 @@ void ProtoOrganizer::GetLaneObjectOverlapElements(
         proto_data_.pb_speed_bumps.count(object_id) <= 0) {
       continue;
     }
-    PbOverlap overlap;
-    std::string overlap_id = CreateOverlapId();
-    proto_data_.pb_lanes[lane_id].add_overlap_id()->set_id(overlap_id);
-    overlap.mutable_id()->set_id(overlap_id);
+    overlaps->emplace_back();
+    PbOverlap& overlap = overlaps->back();
     PbObjectOverlapInfo* object_overlap = overlap.add_object();
     object_overlap->mutable_id()->set_id(lane_id);
     object_overlap->mutable_lane_overlap_info()->set_start_s(
@@ -136,26 +136,19 @@ void ProtoOrganizer::GetLaneObjectOverlapElements(
     object_overlap = overlap.add_object();
     object_overlap->mutable_id()->set_id(object_id);
     if (proto_data_.pb_crosswalks.count(object_id) > 0) {
-      proto_data_.pb_crosswalks[object_id].add_overlap_id()->set_id(overlap_id);
       object_overlap->mutable_crosswalk_overlap_info();
     } else if (proto_data_.pb_clear_areas.count(object_id) > 0) {
       object_overlap->mutable_clear_area_overlap_info();
-      proto_data_.pb_clear_areas[object_id].add_overlap_id()->set_id(
-          overlap_id);
-    } else if (proto_data_.pb_speed_bumps.count(object_id)) {
-      object_overlap->mutable_speed_bump_overlap_info();
-      proto_data_.pb_speed_bumps[object_id].add_overlap_id()->set_id(
-          overlap_id);
     } else {
-      AERROR << "unknown object, object id:" << object_id;
+      object_overlap->mutable_speed_bump_overlap_info();
     }
-    proto_data_.pb_overlaps[overlap_id] = overlap;
   }
 }
 
-void ProtoOrganizer::GetLaneSignalOverlapElements(
+void ProtoOrganizer::CreateLaneSignalOverlaps(
     const std::string& lane_id,
-    const std::vector<OverlapWithLane>& overlap_with_lanes) {
+    const std::vector<OverlapWithLane>& overlap_with_lanes,
+    std::vector<PbOverlap>* overlaps) const {
   for (auto& overlap_signal : overlap_with_lanes) {
     std::string object_id = overlap_signal.object_id;
     if (proto_data_.pb_signals.count(object_id) <= 0 &&
@@ -164,10 +157,8 @@ void ProtoOrganizer::GetLaneSignalOverlapElements(
       AINFO << "cannot find signal object_id:" << object_id;
       continue;
     }
-    PbOverlap overlap;
-    std::string overlap_id = CreateOverlapId();
-    proto_data_.pb_lanes[lane_id].add_overlap_id()->set_id(overlap_id);
-    overlap.mutable_id()->set_id(overlap_id);
+    overlaps->emplace_back();
+    PbOverlap& overlap = overlaps->back();
     PbObjectOverlapInfo* object_overlap = overlap.add_object();
     object_overlap->mutable_id()->set_id(lane_id);
     object_overlap->mutable_lane_overlap_info()->set_start_s(
@@ -180,34 +171,26 @@ void ProtoOrganizer::GetLaneSignalOverlapElements(
     object_overlap->mutable_id()->set_id(object_id);
     if (proto_data_.pb_signals.count(object_id) > 0) {
       object_overlap->mutable_signal_overlap_info();
-      proto_data_.pb_signals[object_id].add_overlap_id()->set_id(overlap_id);
     } else if (proto_data_.pb_stop_signs.count(object_id) > 0) {
       object_overlap->mutable_stop_sign_overlap_info();
-      proto_data_.pb_stop_signs[object_id].add_overlap_id()->set_id(overlap_id);
-    } else if (proto_data_.pb_yield_signs.count(object_id) > 0) {
-      object_overlap->mutable_yield_sign_overlap_info();
-      proto_data_.pb_yield_signs[object_id].add_overlap_id()->set_id(
-          overlap_id);
     } else {
-      AERROR << "unknown signal, signal id:" << object_id;
+      object_overlap->mutable_yield_sign_overlap_info();
     }
-    proto_data_.pb_overlaps[overlap_id] = overlap;
   }
 }
 
-void ProtoOrganizer::GetLaneJunctionOverlapElements(
+void ProtoOrganizer::CreateLaneJunctionOverlaps(
     const std::string& lane_id,
-    const std::vector<OverlapWithLane>& overlap_with_lanes) {
+    const std::vector<OverlapWithLane>& overlap_with_lanes,
+    std::vector<PbOverlap>* overlaps) const {
   for (auto& overlap_junction : overlap_with_lanes) {
     std::string object_id = overlap_junction.object_id;
     if (proto_data_.pb_junctions.count(object_id) <= 0) {
       AINFO << "cannot find junction object " << object_id;
       continue;
     }
-    PbOverlap overlap;
-    std::string overlap_id = CreateOverlapId();
-    proto_data_.pb_lanes[lane_id].add_overlap_id()->set_id(overlap_id);
-    overlap.mutable_id()->set_id(overlap_id);
+    overlaps->emplace_back();
+    PbOverlap& overlap = overlaps->back();
     PbObjectOverlapInfo* object_overlap = overlap.add_object();
     object_overlap->mutable_id()->set_id(lane_id);
     object_overlap->mutable_lane_overlap_info()->set_start_s(
@@ -218,14 +201,38 @@ void ProtoOrganizer::GetLaneJunctionOverlapElements(
         overlap_junction.is_merge);
     object_overlap = overlap.add_object();
     object_overlap->mutable_id()->set_id(object_id);
-    if (proto_data_.pb_junctions.count(object_id) > 0) {
-      object_overlap->mutable_junction_overlap_info();
-      proto_data_.pb_junctions[object_id].add_overlap_id()->set_id(overlap_id);
-    } else {
-      AERROR << "unknown junction overlap, id:" << object_id;
-    }
-    proto_data_.pb_overlaps[overlap_id] = overlap;
+    object_overlap->mutable_junction_overlap_info();
+  }
+}
+
+void ProtoOrganizer::AddLaneOverlap(PbOverlap* overlap) {
+  std::string overlap_id = CreateOverlapId();
+  overlap->mutable_id()->set_id(overlap_id);
+  const std::string& lane_id = overlap->object(0).id().id();
+  proto_data_.pb_lanes[lane_id].add_overlap_id()->set_id(overlap_id);
+  const PbObjectOverlapInfo& object_overlap = overlap->object(1);
+  const std::string& object_id = object_overlap.id().id();
+  if (object_overlap.has_crosswalk_overlap_info()) {
+    proto_data_.pb_crosswalks[object_id].add_overlap_id()->set_id(overlap_id);
+  } else if (object_overlap.has_clear_area_overlap_info()) {
+    proto_data_.pb_clear_areas[object_id].add_overlap_id()->set_id(
+        overlap_id);
+  } else if (object_overlap.has_speed_bump_overlap_info()) {
+    proto_data_.pb_speed_bumps[object_id].add_overlap_id()->set_id(
+        overlap_id);
+  } else if (object_overlap.has_signal_overlap_info()) {
+    proto_data_.pb_signals[object_id].add_overlap_id()->set_id(overlap_id);
+  } else if (object_overlap.has_stop_sign_overlap_info()) {
+    proto_data_.pb_stop_signs[object_id].add_overlap_id()->set_id(overlap_id);
+  } else if (object_overlap.has_yield_sign_overlap_info()) {
+    proto_data_.pb_yield_signs[object_id].add_overlap_id()->set_id(
+        overlap_id);
+  } else if (object_overlap.has_junction_overlap_info()) {
+    proto_data_.pb_junctions[object_id].add_overlap_id()->set_id(overlap_id);
+  } else {
+    AERROR << "unknown overlap object, id:" << object_id;
   }
+  proto_data_.pb_overlaps[overlap_id].Swap(overlap);
 }
 
 void ProtoOrganizer::GetLaneLaneOverlapElements(
@@ -313,61 +320,82 @@ void ProtoOrganizer::GetJunctionObjectOverlapElements(
 
 void ProtoOrganizer::GetOverlapElements(
     const std::vector<RoadInternal>& roads,
-    const std::vector<JunctionInternal>& junctions) {
-  std::unordered_map<std::pair<std::string, std::string>, OverlapWithLane,
-                     PairHash>
-      lane_lane_overlaps;
-  // overlap
+    const std::vector<JunctionInternal>& junctions, const int num_threads) {
+  std::vector<const LaneInternal*> lanes;
   for (auto& road_internal : roads) {
     for (auto& road_section : road_internal.sections) {
       for (auto& lane_internal : road_section.lanes) {
-        std::string lane_id = lane_internal.lane.id().id();
-        GetLaneObjectOverlapElements(lane_id, lane_internal.overlap_objects);
-        GetLaneSignalOverlapElements(lane_id, lane_internal.overlap_signals);
-        GetLaneJunctionOverlapElements(lane_id,
-                                       lane_internal.overlap_junctions);
-        for (auto& overlap_lane : lane_internal.overlap_lanes) {
-          lane_lane_overlaps[make_pair(lane_id, overlap_lane.object_id)] =
-              overlap_lane;
-        }
+        lanes.push_back(&lane_internal);
       }
     }
   }
 
+  // The overlaps of every lane are created concurrently, which only reads
+  // the proto data; their ids are then assigned in the order of the lanes,
+  // so that the output does not depend on the number of threads.
+  std::vector<std::vector<PbOverlap>> lane_overlaps(lanes.size());
+  apollo::common::util::ParallelFor(
+      static_cast<int>(lanes.size()), num_threads,
+      [this, &lanes, &lane_overlaps](const int i) {
+        const std::string& lane_id = lanes[i]->lane.id().id();
+        CreateLaneObjectOverlaps(lane_id, lanes[i]->overlap_objects,
+                                 &lane_overlaps[i]);
+        CreateLaneSignalOverlaps(lane_id, lanes[i]->overlap_signals,
+                                 &lane_overlaps[i]);
+        CreateLaneJunctionOverlaps(lane_id, lanes[i]->overlap_junctions,
+                                   &lane_overlaps[i]);
+      });
+
+  std::unordered_map<std::pair<std::string, std::string>, OverlapWithLane,
+                     PairHash>
+      lane_lane_overlaps;
+  // overlap
+  for (size_t i = 0; i < lanes.size(); ++i) {
+    for (auto& overlap : lane_overlaps[i]) {
+      AddLaneOverlap(&overlap);
+    }
+    const std::string& lane_id = lanes[i]->lane.id().id();
+    for (auto& overlap_lane : lanes[i]->overlap_lanes) {
+      lane_lane_overlaps[make_pair(lane_id, overlap_lane.object_id)] =
+          overlap_lane;
+    }
+  }
+
   GetLaneLaneOverlapElements(lane_lane_overlaps);
   GetJunctionObjectOverlapElements(junctions);
 }
 
 void ProtoOrganizer::OutputData(apollo::hdmap::Map* pb_map) {
+  // The elements are moved into the map, which leaves them empty here.
   for (auto& road_pair : proto_data_.pb_roads) {
-    *(pb_map->add_road()) = road_pair.second;
+    pb_map->add_road()->Swap(&road_pair.second);
   }
   for (auto& lane_pair : proto_data_.pb_lanes) {
-    *(pb_map->add_lane()) = lane_pair.second;
+    pb_map->add_lane()->Swap(&lane_pair.second);
   }
   for (auto& crosswalk_pair : proto_data_.pb_crosswalks) {
-    *(pb_map->add_crosswalk()) = crosswalk_pair.second;
+    pb_map->add_crosswalk()->Swap(&crosswalk_pair.second);
   }
   for (auto& clear_area_pair : proto_data_.pb_clear_areas) {
-    *(pb_map->add_clear_area()) = clear_area_pair.second;
+    pb_map->add_clear_area()->Swap(&clear_area_pair.second);
   }
   for (auto& speed_bump_pair : proto_data_.pb_speed_bumps) {
-    *(pb_map->add_speed_bump()) = speed_bump_pair.second;
+    pb_map->add_speed_bump()->Swap(&speed_bump_pair.second);
   }
   for (auto& signal_pair : proto_data_.pb_signals) {
-    *(pb_map->add_signal()) = signal_pair.second;
+    pb_map->add_signal()->Swap(&signal_pair.second);
   }
   for (auto& stop_sign_pair : proto_data_.pb_stop_signs) {
-    *(pb_map->add_stop_sign()) = stop_sign_pair.second;
+    pb_map->add_stop_sign()->Swap(&stop_sign_pair.second);
   }
   for (auto& yield_sign_pair : proto_data_.pb_yield_signs) {
-    *(pb_map->add_yield()) = yield_sign_pair.second;
+    pb_map->add_yield()->Swap(&yield_sign_pair.second);
   }
   for (auto& junction_pair : proto_data_.pb_junctions) {
-    *(pb_map->add_junction()) = junction_pair.second;
+    pb_map->add_junction()->Swap(&junction_pair.second);
   }
   for (auto& overlap_pair : proto_data_.pb_overlaps) {
-    *(pb_map->add_overlap()) = overlap_pair.second;
+    pb_map->add_overlap()->Swap(&overlap_pair.second);
   }
 
   AINFO << "hdmap statistics: roads-" << proto_data_.pb_roads.size()
@@ -51,20 +51,31 @@ class ProtoOrganizer {
  public:
   void GetRoadElements(std::vector<RoadInternal>* roads);
   void GetJunctionElements(const std::vector<JunctionInternal>& junctions);
+  // Creates the overlaps of the lanes on up to num_threads threads; 0 or
+  // less means the number of hardware threads.
   void GetOverlapElements(const std::vector<RoadInternal>& roads,
-                          const std::vector<JunctionInternal>& junctions);
+                          const std::vector<JunctionInternal>& junctions,
+                          const int num_threads);
+  // Moves the elements into pb_map, so it can be called only once.
   void OutputData(apollo::hdmap::Map* pb_map);
 
  private:
-  void GetLaneObjectOverlapElements(
+  // The overlaps of a lane with other elements, without ids.
+  void CreateLaneObjectOverlaps(
       const std::string& lane_id,
-      const std::vector<OverlapWithLane>& overlap_with_lanes);
-  void GetLaneSignalOverlapElements(
+      const std::vector<OverlapWithLane>& overlap_with_lanes,
+      std::vector<PbOverlap>* overlaps) const;
+  void CreateLaneSignalOverlaps(
       const std::string& lane_id,
-      const std::vector<OverlapWithLane>& overlap_with_lanes);
-  void GetLaneJunctionOverlapElements(
+      const std::vector<OverlapWithLane>& overlap_with_lanes,
+      std::vector<PbOverlap>* overlaps) const;
+  void CreateLaneJunctionOverlaps(
       const std::string& lane_id,
-      const std::vector<OverlapWithLane>& overlap_with_lanes);
+      const std::vector<OverlapWithLane>& overlap_with_lanes,
+      std::vector<PbOverlap>* overlaps) const;
+  // Assigns an id to an overlap created above, adds it to its lane and
+  // object, and moves it into the proto data.
+  void AddLaneOverlap(PbOverlap* overlap);
   void GetLaneLaneOverlapElements(
       const std::unordered_map<std::pair<std::string, std::string>,
                                OverlapWithLane, apollo::common::util::PairHash>&
@@ -12,9 +12,12 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 =========================================================================*/
+#include <algorithm>
+#include <iterator>
 #include <string>
 #include <vector>
 
+#include "modules/common/util/parallel_for.h"
 #include "modules/map/hdmap/adapter/xml_parser/lanes_xml_parser.h"
 #include "modules/map/hdmap/adapter/xml_parser/objects_xml_parser.h"
 #include "modules/map/hdmap/adapter/xml_parser/roads_xml_parser.h"
@@ -33,58 +36,82 @@ namespace hdmap {
 namespace adapter {
 
 Status RoadsXmlParser::Parse(const tinyxml2::XMLElement& xml_node,
+                             const int num_threads,
                              std::vector<RoadInternal>* roads) {
   CHECK_NOTNULL(roads);
 
+  std::vector<const tinyxml2::XMLElement*> road_nodes;
   auto road_node = xml_node.FirstChildElement("road");
   while (road_node) {
-    // road attributes
-    std::string id;
-    std::string junction_id;
-    int checker = UtilXmlParser::QueryStringAttribute(*road_node, "id", &id);
-    checker += UtilXmlParser::QueryStringAttribute(*road_node, "junction",
-                                                   &junction_id);
-    if (checker != tinyxml2::XML_SUCCESS) {
-      std::string err_msg = "Error parsing road attributes";
-      return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
-    }
-    RoadInternal road_internal;
-    road_internal.id = id;
-    road_internal.road.mutable_id()->set_id(id);
-    if (IsRoadBelongToJunction(junction_id)) {
-      road_internal.road.mutable_junction_id()->set_id(junction_id);
-    }
-    // lanes
-    RETURN_IF_ERROR(LanesXmlParser::Parse(*road_node, road_internal.id,
-                                          &road_internal.sections));
+    road_nodes.push_back(road_node);
+    road_node = road_node->NextSiblingElement("road");
+  }
 
-    // objects
-    auto sub_node = road_node->FirstChildElement("objects");
-    if (sub_node != nullptr) {
-      // stop line
-      ObjectsXmlParser::ParseStopLines(*sub_node, &road_internal.stop_lines);
-      // crosswalks
-      ObjectsXmlParser::ParseCrosswalks(*sub_node, &road_internal.crosswalks);
-      // clearareas
-      ObjectsXmlParser::ParseClearAreas(*sub_node, &road_internal.clear_areas);
-      // speed_bumps
-      ObjectsXmlParser::ParseSpeedBumps(*sub_node, &road_internal.speed_bumps);
-    }
+  // tinyxml2 decodes the strings of the document on their first read, so
+  // the subtree of every road is read by a single thread only. Every road
+  // is parsed into its own slot.
+  const int num_roads = static_cast<int>(road_nodes.size());
+  std::vector<RoadInternal> parsed_roads(num_roads);
+  std::vector<Status> statuses(num_roads);
+  apollo::common::util::ParallelFor(
+      num_roads, num_threads,
+      [&road_nodes, &parsed_roads, &statuses](const int i) {
+        statuses[i] = ParseRoad(*road_nodes[i], &parsed_roads[i]);
+      });
+  for (const auto& status : statuses) {
+    RETURN_IF_ERROR(status);
+  }
 
-    // signals
-    sub_node = road_node->FirstChildElement("signals");
-    if (sub_node != nullptr) {
-      // traffic lights
-      SignalsXmlParser::ParseTrafficLights(*sub_node,
-                                           &road_internal.traffic_lights);
-      // stop signs
-      SignalsXmlParser::ParseStopSigns(*sub_node, &road_internal.stop_signs);
-      // yield signs
-      SignalsXmlParser::ParseYieldSigns(*sub_node, &road_internal.yield_signs);
-    }
+  roads->reserve(roads->size() + parsed_roads.size());
+  std::move(parsed_roads.begin(), parsed_roads.end(),
+            std::back_inserter(*roads));
+  return Status::OK();
+}
 
-    roads->push_back(road_internal);
-    road_node = road_node->NextSiblingElement("road");
+Status RoadsXmlParser::ParseRoad(const tinyxml2::XMLElement& road_node,
+                                 RoadInternal* road_internal) {
+  // road attributes
+  std::string id;
+  std::string junction_id;
+  int checker = UtilXmlParser::QueryStringAttribute(road_node, "id", &id);
+  checker += UtilXmlParser::QueryStringAttribute(road_node, "junction",
+                                                 &junction_id);
+  if (checker != tinyxml2::XML_SUCCESS) {
+    std::string err_msg = "Error parsing road attributes";
+    return Status(apollo::common::ErrorCode::HDMAP_DATA_ERROR, err_msg);
+  }
+  road_internal->id = id;
+  road_internal->road.mutable_id()->set_id(id);
+  if (IsRoadBelongToJunction(junction_id)) {
+    road_internal->road.mutable_junction_id()->set_id(junction_id);
+  }
+  // lanes
+  RETURN_IF_ERROR(LanesXmlParser::Parse(road_node, road_internal->id,
+                                        &road_internal->sections));
+
+  // objects
+  auto sub_node = road_node.FirstChildElement("objects");
+  if (sub_node != nullptr) {
+    // stop line
+    ObjectsXmlParser::ParseStopLines(*sub_node, &road_internal->stop_lines);
+    // crosswalks
+    ObjectsXmlParser::ParseCrosswalks(*sub_node, &road_internal->crosswalks);
+    // clearareas
+    ObjectsXmlParser::ParseClearAreas(*sub_node, &road_internal->clear_areas);
+    // speed_bumps
+    ObjectsXmlParser::ParseSpeedBumps(*sub_node, &road_internal->speed_bumps);
+  }
+
+  // signals
+  sub_node = road_node.FirstChildElement("signals");
+  if (sub_node != nullptr) {
+    // traffic lights
+    SignalsXmlParser::ParseTrafficLights(*sub_node,
+                                         &road_internal->traffic_lights);
+    // stop signs
+    SignalsXmlParser::ParseStopSigns(*sub_node, &road_internal->stop_signs);
+    // yield signs
+    SignalsXmlParser::ParseYieldSigns(*sub_node, &road_internal->yield_signs);
   }
 
   return Status::OK();
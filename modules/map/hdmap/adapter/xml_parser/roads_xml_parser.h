@@ -30,8 +30,15 @@ namespace adapter {
 
 class RoadsXmlParser {
  public:
+  // Parses the <road> elements on up to num_threads threads; 0 or less
+  // means the number of hardware threads. The roads keep the order of the
+  // file.
   static Status Parse(const tinyxml2::XMLElement& xml_node,
-                      std::vector<RoadInternal>* roads);
+                      const int num_threads, std::vector<RoadInternal>* roads);
+
+ private:
+  static Status ParseRoad(const tinyxml2::XMLElement& road_node,
+                          RoadInternal* road_internal);
 };
 
 }  // namespace adapter
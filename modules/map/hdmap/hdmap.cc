@@ -22,100 +22,166 @@ namespace hdmap {
 
 int HDMap::LoadMapFromFile(const std::string& map_filename) {
   AINFO << "Loading HDMap: " << map_filename << "...";
+  if (TiledHDMapImpl::IsTileIndexFile(map_filename)) {
+    tiled_impl_.reset(new TiledHDMapImpl());
+    return tiled_impl_->LoadMapFromFile(map_filename);
+  }
+  tiled_impl_.reset();
   return impl_.LoadMapFromFile(map_filename);
 }
 
 LaneInfoConstPtr HDMap::GetLaneById(const Id& id) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetLaneById(id);
+  }
   return impl_.GetLaneById(id);
 }
 
 JunctionInfoConstPtr HDMap::GetJunctionById(const Id& id) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetJunctionById(id);
+  }
   return impl_.GetJunctionById(id);
 }
 
 SignalInfoConstPtr HDMap::GetSignalById(const Id& id) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetSignalById(id);
+  }
   return impl_.GetSignalById(id);
 }
 
 CrosswalkInfoConstPtr HDMap::GetCrosswalkById(const Id& id) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetCrosswalkById(id);
+  }
   return impl_.GetCrosswalkById(id);
 }
 
 StopSignInfoConstPtr HDMap::GetStopSignById(const Id& id) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetStopSignById(id);
+  }
   return impl_.GetStopSignById(id);
 }
 
 YieldSignInfoConstPtr HDMap::GetYieldSignById(const Id& id) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetYieldSignById(id);
+  }
   return impl_.GetYieldSignById(id);
 }
 
 ClearAreaInfoConstPtr HDMap::GetClearAreaById(const Id& id) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetClearAreaById(id);
+  }
   return impl_.GetClearAreaById(id);
 }
 
 SpeedBumpInfoConstPtr HDMap::GetSpeedBumpById(const Id& id) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetSpeedBumpById(id);
+  }
   return impl_.GetSpeedBumpById(id);
 }
 
 OverlapInfoConstPtr HDMap::GetOverlapById(const Id& id) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetOverlapById(id);
+  }
   return impl_.GetOverlapById(id);
 }
 
 RoadInfoConstPtr HDMap::GetRoadById(const Id& id) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetRoadById(id);
+  }
   return impl_.GetRoadById(id);
 }
 
 int HDMap::GetLanes(const apollo::common::PointENU& point, double distance,
                     std::vector<LaneInfoConstPtr>* lanes) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetLanes(point, distance, lanes);
+  }
   return impl_.GetLanes(point, distance, lanes);
 }
 
 int HDMap::GetJunctions(const apollo::common::PointENU& point, double distance,
                         std::vector<JunctionInfoConstPtr>* junctions) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetJunctions(point, distance, junctions);
+  }
   return impl_.GetJunctions(point, distance, junctions);
 }
 
 int HDMap::GetSignals(const apollo::common::PointENU& point, double distance,
                       std::vector<SignalInfoConstPtr>* signals) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetSignals(point, distance, signals);
+  }
   return impl_.GetSignals(point, distance, signals);
 }
 
 int HDMap::GetCrosswalks(const apollo::common::PointENU& point, double distance,
                          std::vector<CrosswalkInfoConstPtr>* crosswalks) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetCrosswalks(point, distance, crosswalks);
+  }
   return impl_.GetCrosswalks(point, distance, crosswalks);
 }
 
 int HDMap::GetStopSigns(const apollo::common::PointENU& point, double distance,
                         std::vector<StopSignInfoConstPtr>* stop_signs) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetStopSigns(point, distance, stop_signs);
+  }
   return impl_.GetStopSigns(point, distance, stop_signs);
 }
 
 int HDMap::GetYieldSigns(
     const apollo::common::PointENU& point, double distance,
     std::vector<YieldSignInfoConstPtr>* yield_signs) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetYieldSigns(point, distance, yield_signs);
+  }
   return impl_.GetYieldSigns(point, distance, yield_signs);
 }
 
 int HDMap::GetClearAreas(
     const apollo::common::PointENU& point, double distance,
     std::vector<ClearAreaInfoConstPtr>* clear_areas) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetClearAreas(point, distance, clear_areas);
+  }
   return impl_.GetClearAreas(point, distance, clear_areas);
 }
 
 int HDMap::GetSpeedBumps(
     const apollo::common::PointENU& point, double distance,
     std::vector<SpeedBumpInfoConstPtr>* speed_bumps) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetSpeedBumps(point, distance, speed_bumps);
+  }
   return impl_.GetSpeedBumps(point, distance, speed_bumps);
 }
 
 int HDMap::GetRoads(const apollo::common::PointENU& point, double distance,
                     std::vector<RoadInfoConstPtr>* roads) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetRoads(point, distance, roads);
+  }
   return impl_.GetRoads(point, distance, roads);
 }
 
 int HDMap::GetNearestLane(const common::PointENU& point,
                           LaneInfoConstPtr* nearest_lane, double* nearest_s,
                           double* nearest_l) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetNearestLane(point, nearest_lane, nearest_s,
+                                       nearest_l);
+  }
   return impl_.GetNearestLane(point, nearest_lane, nearest_s, nearest_l);
 }
 
@@ -126,6 +192,11 @@ int HDMap::GetNearestLaneWithHeading(const apollo::common::PointENU& point,
                                      LaneInfoConstPtr* nearest_lane,
                                      double* nearest_s,
                                      double* nearest_l) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetNearestLaneWithHeading(
+        point, distance, central_heading, max_heading_difference, nearest_lane,
+        nearest_s, nearest_l);
+  }
   return impl_.GetNearestLaneWithHeading(point, distance, central_heading,
                                          max_heading_difference, nearest_lane,
                                          nearest_s, nearest_l);
@@ -136,6 +207,10 @@ int HDMap::GetLanesWithHeading(const apollo::common::PointENU& point,
                                const double central_heading,
                                const double max_heading_difference,
                                std::vector<LaneInfoConstPtr>* lanes) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetLanesWithHeading(point, distance, central_heading,
+                                            max_heading_difference, lanes);
+  }
   return impl_.GetLanesWithHeading(point, distance, central_heading,
                                    max_heading_difference, lanes);
 }
@@ -144,6 +219,10 @@ int HDMap::GetRoadBoundaries(
     const apollo::common::PointENU& point, double radius,
     std::vector<RoadROIBoundaryPtr>* road_boundaries,
     std::vector<JunctionBoundaryPtr>* junctions) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetRoadBoundaries(point, radius, road_boundaries,
+                                          junctions);
+  }
   return impl_.GetRoadBoundaries(point, radius, road_boundaries, junctions);
 }
 
@@ -151,8 +230,30 @@ int HDMap::GetForwardNearestSignalsOnLane(
             const apollo::common::PointENU& point,
             const double distance,
             std::vector<SignalInfoConstPtr>* signals) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetForwardNearestSignalsOnLane(point, distance,
+                                                       signals);
+  }
   return impl_.GetForwardNearestSignalsOnLane(point, distance, signals);
 }
 
+int HDMap::GetMapElements(const apollo::common::PointENU& point,
+                          const double distance, const uint32_t type_mask,
+                          MapElements* elements) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetMapElements(point, distance, type_mask, elements);
+  }
+  return impl_.GetMapElements(point, distance, type_mask, elements);
+}
+
+int HDMap::GetMapElements(const std::vector<apollo::common::PointENU>& points,
+                          const double distance, const uint32_t type_mask,
+                          MapElements* elements) const {
+  if (tiled_impl_ != nullptr) {
+    return tiled_impl_->GetMapElements(points, distance, type_mask, elements);
+  }
+  return impl_.GetMapElements(points, distance, type_mask, elements);
+}
+
 }  // namespace hdmap
 }  // namespace apollo
@@ -25,6 +25,7 @@
 #include "modules/common/proto/geometry.pb.h"
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/map/hdmap/hdmap_impl.h"
+#include "modules/map/hdmap/tiled_hdmap_impl.h"
 #include "modules/map/proto/map_crosswalk.pb.h"
 #include "modules/map/proto/map_junction.pb.h"
 #include "modules/map/proto/map_lane.pb.h"
@@ -51,7 +52,8 @@ namespace hdmap {
 class HDMap {
  public:
   /**
-   * @brief load map from local file
+   * @brief load map from local file. A tile index written by map_tiler is
+   *        loaded as a tiled map, whose tiles are loaded on demand.
    * @param map_filename path of map data file
    * @return 0:success, otherwise failed
    */
@@ -215,9 +217,36 @@ class HDMap {
              const apollo::common::PointENU& point,
              const double distance,
              std::vector<SignalInfoConstPtr>* signals) const;
+  /**
+   * @brief get the map elements of several kinds within a certain range in
+   *        one query, e.g. MAP_ELEMENT_LANE | MAP_ELEMENT_JUNCTION
+   * @param point the central point
+   * @param distance the search radius
+   * @param type_mask the kinds of elements to get, OR-ed MapElementType
+   * @param elements the elements found; the vectors of the other kinds are
+   *        left empty
+   * @return 0:success, otherwise failed
+   */
+  int GetMapElements(const apollo::common::PointENU& point,
+                     const double distance, const uint32_t type_mask,
+                     MapElements* elements) const;
+  /**
+   * @brief get the map elements of several kinds within a certain range of
+   *        any of several points, each element only once
+   * @param points the central points
+   * @param distance the search radius
+   * @param type_mask the kinds of elements to get, OR-ed MapElementType
+   * @param elements the elements found
+   * @return 0:success, otherwise failed
+   */
+  int GetMapElements(const std::vector<apollo::common::PointENU>& points,
+                     const double distance, const uint32_t type_mask,
+                     MapElements* elements) const;
 
  private:
   HDMapImpl impl_;
+  // Set when the map is loaded from a tile index.
+  std::unique_ptr<TiledHDMapImpl> tiled_impl_;
 };
 
 }  // namespace hdmap
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef MODULES_MAP_HDMAP_HDMAP_COMMON_H_
 #define MODULES_MAP_HDMAP_HDMAP_COMMON_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -392,6 +393,50 @@ struct JunctionBoundary {
 
 using JunctionBoundaryPtr = std::shared_ptr<JunctionBoundary>;
 
+/**
+ * @brief the kinds of map elements of GetMapElements, OR-ed into a mask.
+ */
+enum MapElementType : uint32_t {
+  MAP_ELEMENT_LANE = 1 << 0,
+  MAP_ELEMENT_JUNCTION = 1 << 1,
+  MAP_ELEMENT_CROSSWALK = 1 << 2,
+  MAP_ELEMENT_SIGNAL = 1 << 3,
+  MAP_ELEMENT_STOP_SIGN = 1 << 4,
+  MAP_ELEMENT_YIELD_SIGN = 1 << 5,
+  MAP_ELEMENT_CLEAR_AREA = 1 << 6,
+  MAP_ELEMENT_SPEED_BUMP = 1 << 7,
+  MAP_ELEMENT_ROAD = 1 << 8,
+  MAP_ELEMENT_ALL = (1 << 9) - 1,
+};
+
+/**
+ * @brief the map elements found by GetMapElements. The vectors keep their
+ * capacity when the same MapElements is reused for the next query.
+ */
+struct MapElements {
+  std::vector<LaneInfoConstPtr> lanes;
+  std::vector<JunctionInfoConstPtr> junctions;
+  std::vector<CrosswalkInfoConstPtr> crosswalks;
+  std::vector<SignalInfoConstPtr> signals;
+  std::vector<StopSignInfoConstPtr> stop_signs;
+  std::vector<YieldSignInfoConstPtr> yield_signs;
+  std::vector<ClearAreaInfoConstPtr> clear_areas;
+  std::vector<SpeedBumpInfoConstPtr> speed_bumps;
+  std::vector<RoadInfoConstPtr> roads;
+
+  void Clear() {
+    lanes.clear();
+    junctions.clear();
+    crosswalks.clear();
+    signals.clear();
+    stop_signs.clear();
+    yield_signs.clear();
+    clear_areas.clear();
+    speed_bumps.clear();
+    roads.clear();
+  }
+};
+
 }  // namespace hdmap
 }  // namespace apollo
 
@@ -15,12 +15,21 @@ limitations under the License.
 
 #include "modules/map/hdmap/hdmap_impl.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <iostream>
 #include <algorithm>
+#include <functional>
+#include <future>
 #include <unordered_set>
 #include <limits>
 
+#include "modules/common/configs/config_gflags.h"
 #include "modules/common/util/file.h"
+#include "modules/common/util/parallel_for.h"
 #include "modules/common/util/string_util.h"
 #include "modules/map/hdmap/adapter/opendrive_adapter.h"
 
@@ -31,6 +40,7 @@ namespace {
 using apollo::common::math::AABoxKDTreeParams;
 using apollo::common::math::Vec2d;
 using apollo::common::PointENU;
+using apollo::common::util::ParallelFor;
 
 Id CreateHDMapId(const std::string& string_id) {
   Id id;
@@ -43,6 +53,35 @@ constexpr double kLanesSearchRange = 10.0;
 // backward search distance in GetForwardNearestSignalsOnLane
 constexpr int kBackwardDistance = 4;
 
+/**
+ * @brief parses a binary map through a read only mapping of the file. The
+ * kernel reads the file ahead and shares its pages with the other processes
+ * loading the same map, and unlike ParseFromIstream the parse is not bound
+ * by the 64MB limit of the default CodedInputStream.
+ */
+bool LoadBinaryMap(const std::string& map_filename, Map* const map) {
+  const int fd = open(map_filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0 ||
+      file_stat.st_size > std::numeric_limits<int>::max()) {
+    close(fd);
+    return false;
+  }
+  const size_t size = static_cast<size_t>(file_stat.st_size);
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+  madvise(data, size, MADV_SEQUENTIAL);
+  const bool success = map->ParseFromArray(data, static_cast<int>(size));
+  munmap(data, size);
+  return success;
+}
+
 }  // namespace
 
 int HDMapImpl::LoadMapFromFile(const std::string& map_filename) {
@@ -52,13 +91,22 @@ int HDMapImpl::LoadMapFromFile(const std::string& map_filename) {
     if (!adapter::OpendriveAdapter::LoadData(map_filename, &map_)) {
       return -1;
     }
-  } else if (!apollo::common::util::GetProtoFromFile(map_filename, &map_)) {
-    return -1;
+  } else if (!apollo::common::util::EndWith(map_filename, ".bin") ||
+             !LoadBinaryMap(map_filename, &map_)) {
+    map_.Clear();
+    if (!apollo::common::util::GetProtoFromFile(map_filename, &map_)) {
+      return -1;
+    }
   }
 
-
-  for (const auto& lane : map_.lane()) {
-    lane_table_[lane.id().id()].reset(new LaneInfo(lane));
+  // The lanes are most of a map and their geometry is independent of each
+  // other, so they are built concurrently.
+  std::vector<std::shared_ptr<LaneInfo>> lanes(map_.lane_size());
+  ParallelFor(map_.lane_size(), 0, [this, &lanes](const int i) {
+    lanes[i].reset(new LaneInfo(map_.lane(i)));
+  });
+  for (auto& lane : lanes) {
+    lane_table_[lane->id().id()] = std::move(lane);
   }
   for (const auto& junction : map_.junction()) {
     junction_table_[junction.id().id()].reset(new JunctionInfo(junction));
@@ -97,23 +145,50 @@ int HDMapImpl::LoadMapFromFile(const std::string& map_filename) {
     for (const auto& road_section : road_ptr_pair.second->sections()) {
       const auto& section_id = road_section.id();
       for (const auto& lane_id : road_section.lane_id()) {
-        lane_table_[lane_id.id()]->set_road_id(road_id);
-        lane_table_[lane_id.id()]->set_section_id(section_id);
+        // A map tile has the whole road but only some of its lanes.
+        const auto lane_it = lane_table_.find(lane_id.id());
+        if (lane_it == lane_table_.end()) {
+          continue;
+        }
+        lane_it->second->set_road_id(road_id);
+        lane_it->second->set_section_id(section_id);
       }
     }
   }
+  // PostProcess() only reads the tables and writes its own lane.
+  std::vector<LaneInfo*> lane_ptrs;
+  lane_ptrs.reserve(lane_table_.size());
   for (const auto& lane_ptr_pair : lane_table_) {
-    lane_ptr_pair.second->PostProcess(*this);
+    lane_ptrs.push_back(lane_ptr_pair.second.get());
+  }
+  ParallelFor(static_cast<int>(lane_ptrs.size()), 0,
+              [this, &lane_ptrs](const int i) {
+                lane_ptrs[i]->PostProcess(*this);
+              });
+
+  // Every KD-tree is built from its own table into its own members.
+  std::vector<std::future<void>> kdtree_futures;
+  for (const auto builder :
+       {&HDMapImpl::BuildLaneSegmentKDTree,
+        &HDMapImpl::BuildJunctionPolygonKDTree,
+        &HDMapImpl::BuildSignalSegmentKDTree,
+        &HDMapImpl::BuildCrosswalkPolygonKDTree,
+        &HDMapImpl::BuildStopSignSegmentKDTree,
+        &HDMapImpl::BuildYieldSignSegmentKDTree,
+        &HDMapImpl::BuildClearAreaPolygonKDTree,
+        &HDMapImpl::BuildSpeedBumpSegmentKDTree}) {
+    kdtree_futures.push_back(std::async(std::launch::async, builder, this));
+  }
+  for (auto& future : kdtree_futures) {
+    future.get();
   }
 
-  BuildLaneSegmentKDTree();
-  BuildJunctionPolygonKDTree();
-  BuildSignalSegmentKDTree();
-  BuildCrosswalkPolygonKDTree();
-  BuildStopSignSegmentKDTree();
-  BuildYieldSignSegmentKDTree();
-  BuildClearAreaPolygonKDTree();
-  BuildSpeedBumpSegmentKDTree();
+  if (FLAGS_use_nearest_lane_cache) {
+    nearest_lane_cache_.reset(
+        new NearestLaneCache(FLAGS_nearest_lane_cache_size));
+    nearest_lane_with_heading_cache_.reset(
+        new NearestLaneCache(FLAGS_nearest_lane_cache_size));
+  }
 
   return 0;
 }
@@ -407,14 +482,30 @@ int HDMapImpl::GetNearestLane(const Vec2d& point,
   CHECK_NOTNULL(nearest_lane);
   CHECK_NOTNULL(nearest_s);
   CHECK_NOTNULL(nearest_l);
-  const auto* segment_object = lane_segment_kdtree_->GetNearestObject(point);
-  if (segment_object == nullptr) {
-    return -1;
+  uint64_t cache_key = 0;
+  const LaneInfo* lane = nullptr;
+  int id = 0;
+  if (nearest_lane_cache_ != nullptr) {
+    cache_key = NearestLaneCache::MakeKey(
+        {NearestLaneCache::Quantize(point.x(),
+                                    FLAGS_nearest_lane_cache_resolution),
+         NearestLaneCache::Quantize(point.y(),
+                                    FLAGS_nearest_lane_cache_resolution)});
+    nearest_lane_cache_->Get(cache_key, &lane, &id);
+  }
+  if (lane == nullptr) {
+    const auto* segment_object = lane_segment_kdtree_->GetNearestObject(point);
+    if (segment_object == nullptr) {
+      return -1;
+    }
+    lane = segment_object->object();
+    id = segment_object->id();
+    if (nearest_lane_cache_ != nullptr) {
+      nearest_lane_cache_->Put(cache_key, lane, id);
+    }
   }
-  const Id& lane_id = segment_object->object()->id();
-  *nearest_lane = GetLaneById(lane_id);
+  *nearest_lane = GetLaneById(lane->id());
   CHECK(*nearest_lane);
-  const int id = segment_object->id();
   const auto& segment = (*nearest_lane)->segments()[id];
   Vec2d nearest_pt;
   segment.DistanceTo(point, &nearest_pt);
@@ -442,31 +533,66 @@ int HDMapImpl::GetNearestLaneWithHeading(
   CHECK_NOTNULL(nearest_s);
   CHECK_NOTNULL(nearest_l);
 
-  std::vector<LaneInfoConstPtr> lanes;
-  if (GetLanesWithHeading(point, distance, central_heading,
-                          max_heading_difference, &lanes) != 0) {
-    return -1;
-  }
-
   double s = 0;
   size_t s_index = 0;
   Vec2d map_point;
-  double min_distance = distance;
-  for (const auto& lane : lanes) {
-    double s_offset = 0.0;
-    int s_offset_index = 0;
-    double distance =
-        lane->DistanceTo(point, &map_point, &s_offset, &s_offset_index);
-    if (distance < min_distance) {
-      min_distance = distance;
-      *nearest_lane = lane;
-      s = s_offset;
-      s_index = s_offset_index;
+  uint64_t cache_key = 0;
+  bool is_cached = false;
+  if (nearest_lane_with_heading_cache_ != nullptr) {
+    const double resolution = FLAGS_nearest_lane_cache_resolution;
+    const double heading_resolution =
+        FLAGS_nearest_lane_cache_heading_resolution;
+    cache_key = NearestLaneCache::MakeKey(
+        {NearestLaneCache::Quantize(point.x(), resolution),
+         NearestLaneCache::Quantize(point.y(), resolution),
+         NearestLaneCache::Quantize(distance, resolution),
+         NearestLaneCache::Quantize(central_heading, heading_resolution),
+         NearestLaneCache::Quantize(max_heading_difference,
+                                    heading_resolution)});
+    const LaneInfo* cached_lane = nullptr;
+    int unused_index = 0;
+    if (nearest_lane_with_heading_cache_->Get(cache_key, &cached_lane,
+                                              &unused_index)) {
+      // The projection is redone for the exact point.
+      double s_offset = 0.0;
+      int s_offset_index = 0;
+      if (cached_lane->DistanceTo(point, &map_point, &s_offset,
+                                  &s_offset_index) <= distance) {
+        *nearest_lane = GetLaneById(cached_lane->id());
+        s = s_offset;
+        s_index = s_offset_index;
+        is_cached = true;
+      }
     }
   }
 
-  if (*nearest_lane == nullptr) {
-    return -1;
+  if (!is_cached) {
+    std::vector<LaneInfoConstPtr> lanes;
+    if (GetLanesWithHeading(point, distance, central_heading,
+                            max_heading_difference, &lanes) != 0) {
+      return -1;
+    }
+
+    double min_distance = distance;
+    for (const auto& lane : lanes) {
+      double s_offset = 0.0;
+      int s_offset_index = 0;
+      double distance =
+          lane->DistanceTo(point, &map_point, &s_offset, &s_offset_index);
+      if (distance < min_distance) {
+        min_distance = distance;
+        *nearest_lane = lane;
+        s = s_offset;
+        s_index = s_offset_index;
+      }
+    }
+
+    if (*nearest_lane == nullptr) {
+      return -1;
+    }
+    if (nearest_lane_with_heading_cache_ != nullptr) {
+      nearest_lane_with_heading_cache_->Put(cache_key, nearest_lane->get(), 0);
+    }
   }
 
   *nearest_s = s;
@@ -620,7 +746,11 @@ int HDMapImpl::GetForwardNearestSignalsOnLane(
   double s = nearest_s;
   while (s < back_distance) {
     for (const auto& predecessor_lane_id : lane_ptr->lane().predecessor_id()) {
-      lane_ptr = GetLaneById(predecessor_lane_id);
+      const auto predecessor_lane_ptr = GetLaneById(predecessor_lane_id);
+      if (predecessor_lane_ptr == nullptr) {
+        continue;
+      }
+      lane_ptr = predecessor_lane_ptr;
       if (lane_ptr->lane().turn() == apollo::hdmap::Lane::NO_TURN) {
         break;
       }
@@ -634,6 +764,9 @@ int HDMapImpl::GetForwardNearestSignalsOnLane(
     std::vector<SignalInfoConstPtr> min_dist_signal_ptr;
     for (const auto& overlap_id : lane_ptr->lane().overlap_id()) {
       OverlapInfoConstPtr overlap_ptr = GetOverlapById(overlap_id);
+      if (overlap_ptr == nullptr) {
+        continue;
+      }
       double lane_overlap_offset_s = 0.0;
       SignalInfoConstPtr signal_ptr = nullptr;
       for (int i = 0; i < overlap_ptr->overlap().object_size(); ++i) {
@@ -668,7 +801,11 @@ int HDMapImpl::GetForwardNearestSignalsOnLane(
     }
     LaneInfoConstPtr tmp_lane_ptr = nullptr;
     for (const auto& successor_lane_id : lane_ptr->lane().successor_id()) {
-      tmp_lane_ptr = GetLaneById(successor_lane_id);
+      const auto successor_lane_ptr = GetLaneById(successor_lane_id);
+      if (successor_lane_ptr == nullptr) {
+        continue;
+      }
+      tmp_lane_ptr = successor_lane_ptr;
       if (tmp_lane_ptr->lane().turn() == apollo::hdmap::Lane::NO_TURN) {
         break;
       }
@@ -679,6 +816,111 @@ int HDMapImpl::GetForwardNearestSignalsOnLane(
   return 0;
 }
 
+int HDMapImpl::GetMapElements(const PointENU& point, const double distance,
+                              const uint32_t type_mask,
+                              MapElements* elements) const {
+  return GetMapElements(std::vector<PointENU>{point}, distance, type_mask,
+                        elements);
+}
+
+int HDMapImpl::GetMapElements(const std::vector<PointENU>& points,
+                              const double distance, const uint32_t type_mask,
+                              MapElements* elements) const {
+  if (elements == nullptr) {
+    return -1;
+  }
+  elements->Clear();
+  std::vector<Vec2d> xy_points;
+  xy_points.reserve(points.size());
+  for (const auto& point : points) {
+    xy_points.emplace_back(point.x(), point.y());
+  }
+
+  if (type_mask & (MAP_ELEMENT_LANE | MAP_ELEMENT_ROAD)) {
+    SearchObjects(xy_points, distance, lane_segment_kdtree_, lane_table_,
+                  &elements->lanes);
+  }
+  if (type_mask & MAP_ELEMENT_JUNCTION) {
+    SearchObjects(xy_points, distance, junction_polygon_kdtree_,
+                  junction_table_, &elements->junctions);
+  }
+  if (type_mask & MAP_ELEMENT_CROSSWALK) {
+    SearchObjects(xy_points, distance, crosswalk_polygon_kdtree_,
+                  crosswalk_table_, &elements->crosswalks);
+  }
+  if (type_mask & MAP_ELEMENT_SIGNAL) {
+    SearchObjects(xy_points, distance, signal_segment_kdtree_, signal_table_,
+                  &elements->signals);
+  }
+  if (type_mask & MAP_ELEMENT_STOP_SIGN) {
+    SearchObjects(xy_points, distance, stop_sign_segment_kdtree_,
+                  stop_sign_table_, &elements->stop_signs);
+  }
+  if (type_mask & MAP_ELEMENT_YIELD_SIGN) {
+    SearchObjects(xy_points, distance, yield_sign_segment_kdtree_,
+                  yield_sign_table_, &elements->yield_signs);
+  }
+  if (type_mask & MAP_ELEMENT_CLEAR_AREA) {
+    SearchObjects(xy_points, distance, clear_area_polygon_kdtree_,
+                  clear_area_table_, &elements->clear_areas);
+  }
+  if (type_mask & MAP_ELEMENT_SPEED_BUMP) {
+    SearchObjects(xy_points, distance, speed_bump_segment_kdtree_,
+                  speed_bump_table_, &elements->speed_bumps);
+  }
+  if (type_mask & MAP_ELEMENT_ROAD) {
+    std::unordered_set<std::string> road_ids;
+    for (const auto& lane : elements->lanes) {
+      const auto& road_id = lane->road_id();
+      if (!road_ids.insert(road_id.id()).second) {
+        continue;
+      }
+      const auto road = GetRoadById(road_id);
+      if (road != nullptr) {
+        elements->roads.push_back(road);
+      }
+    }
+    if (!(type_mask & MAP_ELEMENT_LANE)) {
+      elements->lanes.clear();
+    }
+  }
+  return 0;
+}
+
+template <class KDTree, class Table, class InfoConstPtr>
+void HDMapImpl::SearchObjects(const std::vector<Vec2d>& points,
+                              const double radius,
+                              const std::unique_ptr<KDTree>& kdtree,
+                              const Table& table,
+                              std::vector<InfoConstPtr>* const results) {
+  if (kdtree == nullptr) {
+    return;
+  }
+  // The buffers are kept by the thread to reuse their memory. An object
+  // found by several points or segments is deduplicated by its address
+  // before its single table lookup.
+  static thread_local std::vector<typename KDTree::ObjectPtr> boxes;
+  static thread_local std::vector<typename InfoConstPtr::element_type*>
+      objects;
+  boxes.clear();
+  for (const auto& point : points) {
+    kdtree->GetObjects(point, radius, &boxes);
+  }
+  objects.clear();
+  for (const auto* box : boxes) {
+    objects.push_back(box->object());
+  }
+  std::sort(objects.begin(), objects.end());
+  objects.erase(std::unique(objects.begin(), objects.end()), objects.end());
+  results->reserve(results->size() + objects.size());
+  for (const auto* object : objects) {
+    const auto it = table.find(object->id().id());
+    if (it != table.end()) {
+      results->push_back(it->second);
+    }
+  }
+}
+
 template <class Table, class BoxTable, class KDTree>
 void HDMapImpl::BuildSegmentKDTree(const Table& table,
                                    const AABoxKDTreeParams& params,
@@ -792,6 +1034,9 @@ int HDMapImpl::SearchObjects(const Vec2d& center, const double radius,
 }
 
 void HDMapImpl::Clear() {
+  // The cached lanes are about to be freed.
+  nearest_lane_cache_.reset();
+  nearest_lane_with_heading_cache_.reset();
   map_.Clear();
   lane_table_.clear();
   junction_table_.clear();
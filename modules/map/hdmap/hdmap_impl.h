@@ -27,6 +27,7 @@ limitations under the License.
 #include "modules/common/math/polygon2d.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/map/hdmap/hdmap_common.h"
+#include "modules/map/hdmap/nearest_lane_cache.h"
 #include "modules/map/proto/map.pb.h"
 #include "modules/map/proto/map_crosswalk.pb.h"
 #include "modules/map/proto/map_geometry.pb.h"
@@ -238,6 +239,24 @@ class HDMapImpl {
              const apollo::common::PointENU& point,
              const double distance,
              std::vector<SignalInfoConstPtr>* signals) const;
+  int GetMapElements(const apollo::common::PointENU& point,
+                     const double distance, const uint32_t type_mask,
+                     MapElements* elements) const;
+  int GetMapElements(const std::vector<apollo::common::PointENU>& points,
+                     const double distance, const uint32_t type_mask,
+                     MapElements* elements) const;
+
+  /**
+   * @brief get the caches of GetNearestLane and GetNearestLaneWithHeading,
+   * nullptr unless FLAGS_use_nearest_lane_cache was set when the map was
+   * loaded.
+   */
+  const NearestLaneCache* nearest_lane_cache() const {
+    return nearest_lane_cache_.get();
+  }
+  const NearestLaneCache* nearest_lane_with_heading_cache() const {
+    return nearest_lane_with_heading_cache_.get();
+  }
 
  private:
   int GetLanes(const apollo::common::math::Vec2d& point, double distance,
@@ -296,6 +315,12 @@ class HDMapImpl {
                            const double radius, const KDTree& kdtree,
                            std::vector<std::string>* const results);
 
+  template <class KDTree, class Table, class InfoConstPtr>
+  static void SearchObjects(
+      const std::vector<apollo::common::math::Vec2d>& points,
+      const double radius, const std::unique_ptr<KDTree>& kdtree,
+      const Table& table, std::vector<InfoConstPtr>* const results);
+
   void Clear();
 
  private:
@@ -335,6 +360,9 @@ class HDMapImpl {
 
   std::vector<SpeedBumpSegmentBox> speed_bump_segment_boxes_;
   std::unique_ptr<SpeedBumpSegmentKDTree> speed_bump_segment_kdtree_;
+
+  std::unique_ptr<NearestLaneCache> nearest_lane_cache_;
+  std::unique_ptr<NearestLaneCache> nearest_lane_with_heading_cache_;
 };
 
 }  // namespace hdmap
@@ -13,11 +13,13 @@ See the License for the specific language governing permissions and
 limitations under the License.
 =========================================================================*/
 
+#include <algorithm>
 #include <algorithm>
 #include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "modules/common/configs/config_gflags.h"
 #include "modules/map/hdmap/hdmap_impl.h"
 
 namespace {
@@ -372,5 +374,106 @@ TEST_F(HDMapImplTestSuite, GetForwardNearestSignalsOnLane) {
   EXPECT_EQ("1278", signals[0]->id().id());
 }
 
+TEST(HDMapImplTest, NearestLaneCache) {
+  HDMapImpl cached_hdmap_impl;
+  HDMapImpl hdmap_impl;
+  FLAGS_use_nearest_lane_cache = true;
+  ASSERT_EQ(0, cached_hdmap_impl.LoadMapFromFile(kMapFilename));
+  FLAGS_use_nearest_lane_cache = false;
+  ASSERT_EQ(0, hdmap_impl.LoadMapFromFile(kMapFilename));
+  ASSERT_TRUE(cached_hdmap_impl.nearest_lane_cache() != nullptr);
+  EXPECT_TRUE(hdmap_impl.nearest_lane_cache() == nullptr);
+
+  apollo::common::PointENU point;
+  point.set_x(586424.09);
+  point.set_y(4140727.02);
+  for (int i = 0; i < 2; ++i) {
+    LaneInfoConstPtr lane = nullptr;
+    LaneInfoConstPtr cached_lane = nullptr;
+    double s = 0.0;
+    double l = 0.0;
+    double cached_s = 0.0;
+    double cached_l = 0.0;
+    EXPECT_EQ(0, hdmap_impl.GetNearestLane(point, &lane, &s, &l));
+    EXPECT_EQ(0, cached_hdmap_impl.GetNearestLane(point, &cached_lane,
+                                                  &cached_s, &cached_l));
+    EXPECT_EQ(lane->id().id(), cached_lane->id().id());
+    EXPECT_DOUBLE_EQ(s, cached_s);
+    EXPECT_DOUBLE_EQ(l, cached_l);
+
+    lane = nullptr;
+    cached_lane = nullptr;
+    EXPECT_EQ(0, hdmap_impl.GetNearestLaneWithHeading(point, 5.0, -2.35, 1.0,
+                                                      &lane, &s, &l));
+    EXPECT_EQ(0, cached_hdmap_impl.GetNearestLaneWithHeading(
+                     point, 5.0, -2.35, 1.0, &cached_lane, &cached_s,
+                     &cached_l));
+    EXPECT_EQ(lane->id().id(), cached_lane->id().id());
+    EXPECT_DOUBLE_EQ(s, cached_s);
+    EXPECT_DOUBLE_EQ(l, cached_l);
+  }
+  EXPECT_EQ(1, cached_hdmap_impl.nearest_lane_cache()->hits());
+  EXPECT_EQ(1, cached_hdmap_impl.nearest_lane_with_heading_cache()->hits());
+
+  // A reload drops the cache.
+  ASSERT_EQ(0, cached_hdmap_impl.LoadMapFromFile(kMapFilename));
+  EXPECT_TRUE(cached_hdmap_impl.nearest_lane_cache() == nullptr);
+}
+
+TEST_F(HDMapImplTestSuite, GetMapElements) {
+  apollo::common::PointENU point;
+  point.set_x(586424.09);
+  point.set_y(4140727.02);
+  point.set_z(0.0);
+  MapElements elements;
+  EXPECT_EQ(0, hdmap_impl_.GetMapElements(point, 50.0, MAP_ELEMENT_ALL,
+                                          &elements));
+  std::vector<LaneInfoConstPtr> lanes;
+  std::vector<JunctionInfoConstPtr> junctions;
+  std::vector<SignalInfoConstPtr> signals;
+  std::vector<RoadInfoConstPtr> roads;
+  EXPECT_EQ(0, hdmap_impl_.GetLanes(point, 50.0, &lanes));
+  EXPECT_EQ(0, hdmap_impl_.GetJunctions(point, 50.0, &junctions));
+  EXPECT_EQ(0, hdmap_impl_.GetSignals(point, 50.0, &signals));
+  EXPECT_EQ(0, hdmap_impl_.GetRoads(point, 50.0, &roads));
+  EXPECT_LT(0, elements.lanes.size());
+  EXPECT_EQ(lanes.size(), elements.lanes.size());
+  EXPECT_EQ(junctions.size(), elements.junctions.size());
+  EXPECT_EQ(signals.size(), elements.signals.size());
+  EXPECT_EQ(roads.size(), elements.roads.size());
+
+  // Only the kinds in the mask are searched.
+  EXPECT_EQ(0, hdmap_impl_.GetMapElements(point, 50.0, MAP_ELEMENT_ROAD,
+                                          &elements));
+  EXPECT_TRUE(elements.lanes.empty());
+  EXPECT_TRUE(elements.junctions.empty());
+  EXPECT_EQ(roads.size(), elements.roads.size());
+
+  // A lane near several points is returned once.
+  apollo::common::PointENU other_point = point;
+  other_point.set_x(point.x() + 10.0);
+  EXPECT_EQ(0, hdmap_impl_.GetMapElements({point, point, other_point}, 5.0,
+                                          MAP_ELEMENT_LANE, &elements));
+  std::vector<LaneInfoConstPtr> other_lanes;
+  EXPECT_EQ(0, hdmap_impl_.GetLanes(point, 5.0, &lanes));
+  EXPECT_EQ(0, hdmap_impl_.GetLanes(other_point, 5.0, &other_lanes));
+  std::vector<std::string> expected_ids;
+  for (const auto& lane : lanes) {
+    expected_ids.push_back(lane->id().id());
+  }
+  for (const auto& lane : other_lanes) {
+    expected_ids.push_back(lane->id().id());
+  }
+  std::sort(expected_ids.begin(), expected_ids.end());
+  expected_ids.erase(std::unique(expected_ids.begin(), expected_ids.end()),
+                     expected_ids.end());
+  std::vector<std::string> ids;
+  for (const auto& lane : elements.lanes) {
+    ids.push_back(lane->id().id());
+  }
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ(expected_ids, ids);
+}
+
 }  // namespace hdmap
 }  // namespace apollo
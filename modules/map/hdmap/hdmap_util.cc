@@ -68,19 +68,24 @@ std::unique_ptr<HDMap> CreateMap(const std::string& map_file_path) {
 }
 
 std::unique_ptr<HDMap> HDMapUtil::base_map_ = nullptr;
+std::atomic<const HDMap*> HDMapUtil::base_map_ptr_(nullptr);
 std::mutex HDMapUtil::base_map_mutex_;
 
 std::unique_ptr<HDMap> HDMapUtil::sim_map_ = nullptr;
+std::atomic<const HDMap*> HDMapUtil::sim_map_ptr_(nullptr);
 std::mutex HDMapUtil::sim_map_mutex_;
 
 const HDMap* HDMapUtil::BaseMapPtr() {
-  if (base_map_ == nullptr) {
+  const HDMap* base_map = base_map_ptr_.load(std::memory_order_acquire);
+  if (base_map == nullptr) {
     std::lock_guard<std::mutex> lock(base_map_mutex_);
     if (base_map_ == nullptr) {  // Double check.
       base_map_ = CreateMap(BaseMapFile());
+      base_map_ptr_.store(base_map_.get(), std::memory_order_release);
     }
+    base_map = base_map_.get();
   }
-  return base_map_.get();
+  return base_map;
 }
 
 const HDMap& HDMapUtil::BaseMap() {
@@ -88,13 +93,16 @@ const HDMap& HDMapUtil::BaseMap() {
 }
 
 const HDMap* HDMapUtil::SimMapPtr() {
-  if (sim_map_ == nullptr) {
+  const HDMap* sim_map = sim_map_ptr_.load(std::memory_order_acquire);
+  if (sim_map == nullptr) {
     std::lock_guard<std::mutex> lock(sim_map_mutex_);
     if (sim_map_ == nullptr) {  // Double check.
       sim_map_ = CreateMap(SimMapFile());
+      sim_map_ptr_.store(sim_map_.get(), std::memory_order_release);
     }
+    sim_map = sim_map_.get();
   }
-  return sim_map_.get();
+  return sim_map;
 }
 
 const HDMap& HDMapUtil::SimMap() {
@@ -102,15 +110,20 @@ const HDMap& HDMapUtil::SimMap() {
 }
 
 bool HDMapUtil::ReloadMaps() {
+  bool is_loaded = true;
   {
     std::lock_guard<std::mutex> lock(base_map_mutex_);
     base_map_ = CreateMap(BaseMapFile());
+    base_map_ptr_.store(base_map_.get(), std::memory_order_release);
+    is_loaded = is_loaded && base_map_ != nullptr;
   }
   {
     std::lock_guard<std::mutex> lock(sim_map_mutex_);
     sim_map_ = CreateMap(SimMapFile());
+    sim_map_ptr_.store(sim_map_.get(), std::memory_order_release);
+    is_loaded = is_loaded && sim_map_ != nullptr;
   }
-  return base_map_ != nullptr && sim_map_ != nullptr;
+  return is_loaded;
 }
 
 }  // namespace hdmap
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef MODULES_MAP_HDMAP_HDMAP_UTIL_H_
 #define MODULES_MAP_HDMAP_HDMAP_UTIL_H_
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -93,10 +94,15 @@ class HDMapUtil {
  private:
   HDMapUtil() = delete;
 
+  // The maps are owned by the unique_ptrs, which are only accessed under
+  // the mutexes; the atomic pointers let the loaded maps be read lock free
+  // from any thread.
   static std::unique_ptr<HDMap> base_map_;
+  static std::atomic<const HDMap*> base_map_ptr_;
   static std::mutex base_map_mutex_;
 
   static std::unique_ptr<HDMap> sim_map_;
+  static std::atomic<const HDMap*> sim_map_ptr_;
   static std::mutex sim_map_mutex_;
 };
 
@@ -0,0 +1,468 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+
+#include "modules/map/hdmap/map_tiler.h"
+
+#include <cmath>
+#include <limits>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+
+namespace apollo {
+namespace hdmap {
+namespace {
+
+using apollo::common::PointENU;
+using google::protobuf::RepeatedPtrField;
+
+// The objects which are put into tiles by their geometry.
+enum ObjectType {
+  LANE = 0,
+  JUNCTION,
+  SIGNAL,
+  CROSSWALK,
+  STOP_SIGN,
+  YIELD_SIGN,
+  CLEAR_AREA,
+  SPEED_BUMP,
+  NUM_OBJECT_TYPES,
+};
+
+struct Bound {
+  double min_x = std::numeric_limits<double>::infinity();
+  double min_y = std::numeric_limits<double>::infinity();
+  double max_x = -std::numeric_limits<double>::infinity();
+  double max_y = -std::numeric_limits<double>::infinity();
+
+  void Add(const PointENU& point) {
+    min_x = std::fmin(min_x, point.x());
+    min_y = std::fmin(min_y, point.y());
+    max_x = std::fmax(max_x, point.x());
+    max_y = std::fmax(max_y, point.y());
+  }
+  bool IsValid() const { return min_x <= max_x && min_y <= max_y; }
+};
+
+void AddCurve(const Curve& curve, Bound* const bound) {
+  for (const auto& segment : curve.segment()) {
+    for (const auto& point : segment.line_segment().point()) {
+      bound->Add(point);
+    }
+  }
+}
+
+void AddCurves(const RepeatedPtrField<Curve>& curves, Bound* const bound) {
+  for (const auto& curve : curves) {
+    AddCurve(curve, bound);
+  }
+}
+
+void AddPolygon(const Polygon& polygon, Bound* const bound) {
+  for (const auto& point : polygon.point()) {
+    bound->Add(point);
+  }
+}
+
+void AddGeometry(const Lane& lane, Bound* const bound) {
+  AddCurve(lane.central_curve(), bound);
+  AddCurve(lane.left_boundary().curve(), bound);
+  AddCurve(lane.right_boundary().curve(), bound);
+}
+
+void AddGeometry(const Junction& junction, Bound* const bound) {
+  AddPolygon(junction.polygon(), bound);
+}
+
+void AddGeometry(const Signal& signal, Bound* const bound) {
+  AddPolygon(signal.boundary(), bound);
+  AddCurves(signal.stop_line(), bound);
+}
+
+void AddGeometry(const Crosswalk& crosswalk, Bound* const bound) {
+  AddPolygon(crosswalk.polygon(), bound);
+}
+
+void AddGeometry(const StopSign& stop_sign, Bound* const bound) {
+  AddCurves(stop_sign.stop_line(), bound);
+}
+
+void AddGeometry(const YieldSign& yield_sign, Bound* const bound) {
+  AddCurves(yield_sign.stop_line(), bound);
+}
+
+void AddGeometry(const ClearArea& clear_area, Bound* const bound) {
+  AddPolygon(clear_area.polygon(), bound);
+}
+
+void AddGeometry(const SpeedBump& speed_bump, Bound* const bound) {
+  AddCurves(speed_bump.position(), bound);
+}
+
+template <class Object>
+void CopyObjects(const RepeatedPtrField<Object>& objects,
+                 const std::set<int>& indices,
+                 RepeatedPtrField<Object>* const tile_objects) {
+  tile_objects->Reserve(static_cast<int>(indices.size()));
+  for (const int index : indices) {
+    *tile_objects->Add() = objects.Get(index);
+  }
+}
+
+RepeatedPtrField<std::string>* MutableTileIds(const ObjectType type,
+                                              MapTile* const tile) {
+  switch (type) {
+    case LANE:
+      return tile->mutable_lane_id();
+    case JUNCTION:
+      return tile->mutable_junction_id();
+    case SIGNAL:
+      return tile->mutable_signal_id();
+    case CROSSWALK:
+      return tile->mutable_crosswalk_id();
+    case STOP_SIGN:
+      return tile->mutable_stop_sign_id();
+    case YIELD_SIGN:
+      return tile->mutable_yield_sign_id();
+    case CLEAR_AREA:
+      return tile->mutable_clear_area_id();
+    case SPEED_BUMP:
+      return tile->mutable_speed_bump_id();
+    default:
+      return nullptr;
+  }
+}
+
+using TileKey = std::pair<int, int>;
+
+struct TileContent {
+  // The indices of the objects in the map, ordered to keep the map order.
+  std::set<int> objects[NUM_OBJECT_TYPES];
+  std::set<int> overlaps;
+  std::set<int> roads;
+};
+
+class MapTiler {
+ public:
+  MapTiler(const Map& map, const double tile_size, const double margin)
+      : map_(map), tile_size_(tile_size), margin_(margin) {}
+
+  void Split(MapTileIndex* const index, std::vector<Map>* const tiles);
+
+ private:
+  template <class Object>
+  void AddObjects(const RepeatedPtrField<Object>& objects,
+                  const ObjectType type);
+  void AddOverlaps(TileContent* const content) const;
+  void AddRoads(TileContent* const content) const;
+  const RepeatedPtrField<Id>& OverlapIds(const ObjectType type,
+                                         const int index) const;
+  Map MakeTileMap(const TileContent& content) const;
+  bool FindHome(const std::string& id, TileKey* const home) const;
+
+  const Map& map_;
+  const double tile_size_;
+  const double margin_;
+
+  std::unordered_map<std::string, int> ids_[NUM_OBJECT_TYPES];
+  std::unordered_map<std::string, int> overlap_ids_;
+  // The road index of every lane id.
+  std::unordered_map<std::string, int> lane_roads_;
+  // The tile an object is looked up by id in.
+  std::vector<TileKey> homes_[NUM_OBJECT_TYPES];
+  std::map<TileKey, TileContent> tiles_;
+};
+
+template <class Object>
+void MapTiler::AddObjects(const RepeatedPtrField<Object>& objects,
+                          const ObjectType type) {
+  homes_[type].resize(objects.size());
+  for (int i = 0; i < objects.size(); ++i) {
+    const auto& object = objects.Get(i);
+    ids_[type][object.id().id()] = i;
+    Bound bound;
+    AddGeometry(object, &bound);
+    if (!bound.IsValid()) {
+      AWARN << "Object " << object.id().id() << " has no geometry, skipped.";
+      homes_[type][i] = {std::numeric_limits<int>::max(), 0};
+      continue;
+    }
+    const int min_x = MapTileCoordinate(bound.min_x - margin_, tile_size_);
+    const int max_x = MapTileCoordinate(bound.max_x + margin_, tile_size_);
+    const int min_y = MapTileCoordinate(bound.min_y - margin_, tile_size_);
+    const int max_y = MapTileCoordinate(bound.max_y + margin_, tile_size_);
+    for (int x = min_x; x <= max_x; ++x) {
+      for (int y = min_y; y <= max_y; ++y) {
+        tiles_[{x, y}].objects[type].insert(i);
+      }
+    }
+    homes_[type][i] = {
+        MapTileCoordinate((bound.min_x + bound.max_x) / 2.0, tile_size_),
+        MapTileCoordinate((bound.min_y + bound.max_y) / 2.0, tile_size_)};
+  }
+}
+
+const RepeatedPtrField<Id>& MapTiler::OverlapIds(const ObjectType type,
+                                                 const int index) const {
+  switch (type) {
+    case LANE:
+      return map_.lane(index).overlap_id();
+    case JUNCTION:
+      return map_.junction(index).overlap_id();
+    case SIGNAL:
+      return map_.signal(index).overlap_id();
+    case CROSSWALK:
+      return map_.crosswalk(index).overlap_id();
+    case STOP_SIGN:
+      return map_.stop_sign(index).overlap_id();
+    case YIELD_SIGN:
+      return map_.yield(index).overlap_id();
+    case CLEAR_AREA:
+      return map_.clear_area(index).overlap_id();
+    default:
+      return map_.speed_bump(index).overlap_id();
+  }
+}
+
+void MapTiler::AddOverlaps(TileContent* const content) const {
+  for (int type = 0; type < NUM_OBJECT_TYPES; ++type) {
+    for (const int index : content->objects[type]) {
+      for (const auto& overlap_id :
+           OverlapIds(static_cast<ObjectType>(type), index)) {
+        const auto it = overlap_ids_.find(overlap_id.id());
+        if (it != overlap_ids_.end()) {
+          content->overlaps.insert(it->second);
+        }
+      }
+    }
+  }
+  // LaneInfo tells the kind of an overlap by the objects it finds in the
+  // same map, so all the objects of an overlap go with it.
+  for (const int overlap_index : content->overlaps) {
+    for (const auto& object : map_.overlap(overlap_index).object()) {
+      for (int type = 0; type < NUM_OBJECT_TYPES; ++type) {
+        const auto it = ids_[type].find(object.id().id());
+        if (it != ids_[type].end()) {
+          content->objects[type].insert(it->second);
+        }
+      }
+    }
+  }
+}
+
+void MapTiler::AddRoads(TileContent* const content) const {
+  std::set<std::string> junction_ids;
+  for (const int lane_index : content->objects[LANE]) {
+    const auto& lane = map_.lane(lane_index);
+    if (lane.has_junction_id()) {
+      junction_ids.insert(lane.junction_id().id());
+    }
+    const auto it = lane_roads_.find(lane.id().id());
+    if (it == lane_roads_.end()) {
+      continue;
+    }
+    content->roads.insert(it->second);
+    const auto& road = map_.road(it->second);
+    if (road.has_junction_id()) {
+      junction_ids.insert(road.junction_id().id());
+    }
+  }
+  for (const auto& junction_id : junction_ids) {
+    const auto it = ids_[JUNCTION].find(junction_id);
+    if (it != ids_[JUNCTION].end()) {
+      content->objects[JUNCTION].insert(it->second);
+    }
+  }
+}
+
+Map MapTiler::MakeTileMap(const TileContent& content) const {
+  Map tile;
+  if (map_.has_header()) {
+    *tile.mutable_header() = map_.header();
+  }
+  CopyObjects(map_.lane(), content.objects[LANE], tile.mutable_lane());
+  CopyObjects(map_.junction(), content.objects[JUNCTION],
+              tile.mutable_junction());
+  CopyObjects(map_.signal(), content.objects[SIGNAL], tile.mutable_signal());
+  CopyObjects(map_.crosswalk(), content.objects[CROSSWALK],
+              tile.mutable_crosswalk());
+  CopyObjects(map_.stop_sign(), content.objects[STOP_SIGN],
+              tile.mutable_stop_sign());
+  CopyObjects(map_.yield(), content.objects[YIELD_SIGN], tile.mutable_yield());
+  CopyObjects(map_.clear_area(), content.objects[CLEAR_AREA],
+              tile.mutable_clear_area());
+  CopyObjects(map_.speed_bump(), content.objects[SPEED_BUMP],
+              tile.mutable_speed_bump());
+  CopyObjects(map_.overlap(), content.overlaps, tile.mutable_overlap());
+  CopyObjects(map_.road(), content.roads, tile.mutable_road());
+  return tile;
+}
+
+void MapTiler::Split(MapTileIndex* const index, std::vector<Map>* const tiles) {
+  for (int i = 0; i < map_.overlap_size(); ++i) {
+    overlap_ids_[map_.overlap(i).id().id()] = i;
+  }
+  for (int i = 0; i < map_.road_size(); ++i) {
+    for (const auto& section : map_.road(i).section()) {
+      for (const auto& lane_id : section.lane_id()) {
+        lane_roads_[lane_id.id()] = i;
+      }
+    }
+  }
+  AddObjects(map_.lane(), LANE);
+  AddObjects(map_.junction(), JUNCTION);
+  AddObjects(map_.signal(), SIGNAL);
+  AddObjects(map_.crosswalk(), CROSSWALK);
+  AddObjects(map_.stop_sign(), STOP_SIGN);
+  AddObjects(map_.yield(), YIELD_SIGN);
+  AddObjects(map_.clear_area(), CLEAR_AREA);
+  AddObjects(map_.speed_bump(), SPEED_BUMP);
+
+  index->Clear();
+  if (map_.has_header()) {
+    *index->mutable_header() = map_.header();
+  }
+  index->set_tile_length(tile_size_);
+  index->set_margin(margin_);
+  tiles->clear();
+  std::map<TileKey, MapTile*> index_tiles;
+  for (auto& key_content : tiles_) {
+    // The overlaps and roads come from the objects within the margin only.
+    AddOverlaps(&key_content.second);
+    AddRoads(&key_content.second);
+    tiles->push_back(MakeTileMap(key_content.second));
+
+    auto* tile = index->add_tile();
+    tile->set_x(key_content.first.first);
+    tile->set_y(key_content.first.second);
+    tile->set_filename("tile_" + std::to_string(key_content.first.first) +
+                       "_" + std::to_string(key_content.first.second) +
+                       ".bin");
+    index_tiles[key_content.first] = tile;
+  }
+
+  // An object is looked up in the tile of its center, which contains it by
+  // its geometry, and so contains its overlaps and its road as well.
+  for (int type = 0; type < NUM_OBJECT_TYPES; ++type) {
+    const auto& homes = homes_[type];
+    for (const auto& id_index : ids_[type]) {
+      const auto it = index_tiles.find(homes[id_index.second]);
+      if (it != index_tiles.end()) {
+        MutableTileIds(static_cast<ObjectType>(type), it->second)
+            ->Add()
+            ->assign(id_index.first);
+      }
+    }
+  }
+  for (const auto& overlap : map_.overlap()) {
+    for (const auto& object : overlap.object()) {
+      TileKey home;
+      if (!FindHome(object.id().id(), &home)) {
+        continue;
+      }
+      const auto it = index_tiles.find(home);
+      if (it != index_tiles.end()) {
+        it->second->add_overlap_id(overlap.id().id());
+        break;
+      }
+    }
+  }
+  for (const auto& road : map_.road()) {
+    MapTile* home_tile = nullptr;
+    for (const auto& section : road.section()) {
+      for (const auto& lane_id : section.lane_id()) {
+        const auto lane_it = ids_[LANE].find(lane_id.id());
+        if (lane_it == ids_[LANE].end()) {
+          continue;
+        }
+        const auto it = index_tiles.find(homes_[LANE][lane_it->second]);
+        if (it != index_tiles.end()) {
+          home_tile = it->second;
+          break;
+        }
+      }
+      if (home_tile != nullptr) {
+        home_tile->add_road_id(road.id().id());
+        break;
+      }
+    }
+  }
+}
+
+bool MapTiler::FindHome(const std::string& id, TileKey* const home) const {
+  for (int type = 0; type < NUM_OBJECT_TYPES; ++type) {
+    const auto it = ids_[type].find(id);
+    if (it != ids_[type].end()) {
+      *home = homes_[type][it->second];
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+int MapTileCoordinate(const double coordinate, const double tile_size) {
+  return static_cast<int>(std::floor(coordinate / tile_size));
+}
+
+bool SplitMapIntoTiles(const Map& map, const double tile_size,
+                       const double margin, MapTileIndex* index,
+                       std::vector<Map>* tiles) {
+  CHECK_NOTNULL(index);
+  CHECK_NOTNULL(tiles);
+  if (tile_size <= 0.0 || margin < 0.0) {
+    AERROR << "Invalid tile size " << tile_size << " or margin " << margin;
+    return false;
+  }
+  MapTiler(map, tile_size, margin).Split(index, tiles);
+  return true;
+}
+
+bool WriteMapTiles(const Map& map, const double tile_size,
+                   const double margin, const std::string& output_dir) {
+  MapTileIndex index;
+  std::vector<Map> tiles;
+  if (!SplitMapIntoTiles(map, tile_size, margin, &index, &tiles)) {
+    return false;
+  }
+  if (!apollo::common::util::EnsureDirectory(output_dir)) {
+    AERROR << "Failed to create " << output_dir;
+    return false;
+  }
+  for (int i = 0; i < index.tile_size(); ++i) {
+    const std::string filename = output_dir + "/" + index.tile(i).filename();
+    if (!apollo::common::util::SetProtoToBinaryFile(tiles[i], filename)) {
+      AERROR << "Failed to write " << filename;
+      return false;
+    }
+  }
+  const std::string index_filename =
+      output_dir + "/" + kMapTileIndexFilename;
+  if (!apollo::common::util::SetProtoToBinaryFile(index, index_filename)) {
+    AERROR << "Failed to write " << index_filename;
+    return false;
+  }
+  AINFO << "Wrote " << index.tile_size() << " tiles to " << output_dir;
+  return true;
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,77 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+
+#ifndef MODULES_MAP_HDMAP_MAP_TILER_H_
+#define MODULES_MAP_HDMAP_MAP_TILER_H_
+
+#include <string>
+#include <vector>
+
+#include "modules/map/proto/map.pb.h"
+#include "modules/map/proto/map_tile.pb.h"
+
+/**
+ * @namespace apollo::hdmap
+ * @brief apollo::hdmap
+ */
+namespace apollo {
+namespace hdmap {
+
+/**
+ * @brief the file name of the tile index in a directory of map tiles.
+ */
+constexpr char kMapTileIndexFilename[] = "tile_index.bin";
+
+/**
+ * @brief get the tile coordinate of a map coordinate.
+ * @param coordinate the x or y of a point
+ * @param tile_size the size of the tiles
+ * @return the x or y of the tile that contains the point
+ */
+int MapTileCoordinate(const double coordinate, const double tile_size);
+
+/**
+ * @brief split a map into square tiles. An object goes into every tile it
+ * has geometry within the margin of, so that a query within the margin of a
+ * point touches one tile only.
+ * @param map the map to split
+ * @param tile_size the size of the tiles in meters
+ * @param margin the margin of the tiles in meters
+ * @param index the index of the tiles, with the file name of tile i set to
+ *        "tile_<x>_<y>.bin"
+ * @param tiles the maps of the tiles, tiles[i] for index->tile(i)
+ * @return true on success
+ */
+bool SplitMapIntoTiles(const Map& map, const double tile_size,
+                       const double margin, MapTileIndex* index,
+                       std::vector<Map>* tiles);
+
+/**
+ * @brief split a map into tiles, and write the tiles and the tile index
+ * into a directory.
+ * @param map the map to split
+ * @param tile_size the size of the tiles in meters
+ * @param margin the margin of the tiles in meters
+ * @param output_dir the directory to write to
+ * @return true on success
+ */
+bool WriteMapTiles(const Map& map, const double tile_size,
+                   const double margin, const std::string& output_dir);
+
+}  // namespace hdmap
+}  // namespace apollo
+
+#endif  // MODULES_MAP_HDMAP_MAP_TILER_H_
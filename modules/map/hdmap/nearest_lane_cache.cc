@@ -0,0 +1,112 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+
+#include "modules/map/hdmap/nearest_lane_cache.h"
+
+#include <cmath>
+
+namespace apollo {
+namespace hdmap {
+
+NearestLaneCache::NearestLaneCache(const size_t num_slots)
+    : hits_(0), misses_(0) {
+  size_t size = 1;
+  while (size < num_slots) {
+    size <<= 1;
+  }
+  mask_ = size - 1;
+  slots_.reset(new Slot[size]);
+  for (size_t i = 0; i < size; ++i) {
+    slots_[i].sequence.store(0, std::memory_order_relaxed);
+  }
+  Clear();
+}
+
+uint64_t NearestLaneCache::MakeKey(std::initializer_list<int64_t> values) {
+  // FNV-1a over the values, then a final mix so that the low bits, which
+  // pick the slot, depend on all of them.
+  uint64_t key = 14695981039346656037ULL;
+  for (const int64_t value : values) {
+    key ^= static_cast<uint64_t>(value);
+    key *= 1099511628211ULL;
+  }
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  // 0 marks an empty slot.
+  return key == 0 ? 1 : key;
+}
+
+int64_t NearestLaneCache::Quantize(const double value,
+                                   const double resolution) {
+  return static_cast<int64_t>(std::floor(value / resolution));
+}
+
+bool NearestLaneCache::Get(const uint64_t key, const LaneInfo** lane,
+                           int* index) const {
+  const Slot& slot = slots_[key & mask_];
+  const uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+  if ((sequence & 1) == 0) {
+    const uint64_t slot_key = slot.key.load(std::memory_order_relaxed);
+    const LaneInfo* slot_lane = slot.lane.load(std::memory_order_relaxed);
+    const int slot_index = slot.index.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) == sequence &&
+        slot_key == key && slot_lane != nullptr) {
+      *lane = slot_lane;
+      *index = slot_index;
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+void NearestLaneCache::Put(const uint64_t key, const LaneInfo* lane,
+                           const int index) {
+  Slot& slot = slots_[key & mask_];
+  uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+  if ((sequence & 1) != 0 ||
+      !slot.sequence.compare_exchange_strong(sequence, sequence + 1,
+                                             std::memory_order_acquire)) {
+    return;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.key.store(key, std::memory_order_relaxed);
+  slot.lane.store(lane, std::memory_order_relaxed);
+  slot.index.store(index, std::memory_order_relaxed);
+  slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void NearestLaneCache::Clear() {
+  for (size_t i = 0; i <= mask_; ++i) {
+    slots_[i].key.store(0, std::memory_order_relaxed);
+    slots_[i].lane.store(nullptr, std::memory_order_relaxed);
+    slots_[i].index.store(0, std::memory_order_relaxed);
+  }
+  hits_.store(0, std::memory_order_relaxed);
+  misses_.store(0, std::memory_order_relaxed);
+}
+
+double NearestLaneCache::HitRate() const {
+  const uint64_t num_hits = hits();
+  const uint64_t total = num_hits + misses();
+  return total == 0 ? 0.0 : static_cast<double>(num_hits) / total;
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,105 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+
+#ifndef MODULES_MAP_HDMAP_NEAREST_LANE_CACHE_H_
+#define MODULES_MAP_HDMAP_NEAREST_LANE_CACHE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+
+/**
+ * @namespace apollo::hdmap
+ * @brief apollo::hdmap
+ */
+namespace apollo {
+namespace hdmap {
+
+class LaneInfo;
+
+/**
+ * @class NearestLaneCache
+ * @brief A fixed size, direct mapped cache of the nearest lane queries,
+ * keyed by the quantized query. Every slot is a sequence lock: Get() never
+ * blocks and never writes the slot, and a Put() racing on the same slot
+ * gives up instead of waiting.
+ *
+ * \par
+ * The cache does not own the lanes; it is cleared with the map.
+ */
+class NearestLaneCache {
+ public:
+  /**
+   * @brief Constructor
+   * @param num_slots the number of slots, rounded up to a power of two
+   */
+  explicit NearestLaneCache(const size_t num_slots);
+
+  /**
+   * @brief make the key of a query from its quantized values.
+   */
+  static uint64_t MakeKey(std::initializer_list<int64_t> values);
+
+  /**
+   * @brief quantize a value of a query.
+   */
+  static int64_t Quantize(const double value, const double resolution);
+
+  /**
+   * @brief look up a query.
+   * @param key the key of the query
+   * @param lane the cached lane
+   * @param index the cached index, e.g. the segment of the lane
+   * @return true on a hit
+   */
+  bool Get(const uint64_t key, const LaneInfo** lane, int* index) const;
+
+  /**
+   * @brief cache the result of a query.
+   */
+  void Put(const uint64_t key, const LaneInfo* lane, const int index);
+
+  /**
+   * @brief drop all the results. Not to be called concurrently with the
+   * other methods.
+   */
+  void Clear();
+
+  uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+  uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+  double HitRate() const;
+
+ private:
+  struct Slot {
+    // Odd while the slot is being written.
+    std::atomic<uint32_t> sequence;
+    std::atomic<uint64_t> key;
+    std::atomic<const LaneInfo*> lane;
+    std::atomic<int> index;
+  };
+
+  size_t mask_ = 0;
+  std::unique_ptr<Slot[]> slots_;
+  mutable std::atomic<uint64_t> hits_;
+  mutable std::atomic<uint64_t> misses_;
+};
+
+}  // namespace hdmap
+}  // namespace apollo
+
+#endif  // MODULES_MAP_HDMAP_NEAREST_LANE_CACHE_H_
@@ -0,0 +1,91 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+
+#include "modules/map/hdmap/nearest_lane_cache.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace hdmap {
+
+namespace {
+
+// The cache only stores the pointers.
+const LaneInfo* FakeLane(const int i) {
+  return reinterpret_cast<const LaneInfo*>(static_cast<uintptr_t>(8 * i + 8));
+}
+
+}  // namespace
+
+TEST(NearestLaneCache, GetAndPut) {
+  NearestLaneCache cache(100);
+  const uint64_t key = NearestLaneCache::MakeKey(
+      {NearestLaneCache::Quantize(10.02, 0.05),
+       NearestLaneCache::Quantize(-3.0, 0.05)});
+  EXPECT_EQ(key, NearestLaneCache::MakeKey(
+                     {NearestLaneCache::Quantize(10.04, 0.05),
+                      NearestLaneCache::Quantize(-2.99, 0.05)}));
+  EXPECT_NE(key, NearestLaneCache::MakeKey(
+                     {NearestLaneCache::Quantize(10.06, 0.05),
+                      NearestLaneCache::Quantize(-3.0, 0.05)}));
+
+  const LaneInfo* lane = nullptr;
+  int index = 0;
+  EXPECT_FALSE(cache.Get(key, &lane, &index));
+  cache.Put(key, FakeLane(1), 7);
+  EXPECT_TRUE(cache.Get(key, &lane, &index));
+  EXPECT_EQ(FakeLane(1), lane);
+  EXPECT_EQ(7, index);
+  EXPECT_EQ(1, cache.hits());
+  EXPECT_EQ(1, cache.misses());
+  EXPECT_DOUBLE_EQ(0.5, cache.HitRate());
+
+  cache.Clear();
+  EXPECT_FALSE(cache.Get(key, &lane, &index));
+  EXPECT_EQ(0, cache.hits());
+}
+
+TEST(NearestLaneCache, Concurrent) {
+  NearestLaneCache cache(64);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < 10000; ++i) {
+        const int value = (i + t) % 256;
+        const uint64_t key = NearestLaneCache::MakeKey({value});
+        const LaneInfo* lane = nullptr;
+        int index = 0;
+        if (cache.Get(key, &lane, &index)) {
+          // A hit is never a torn entry.
+          EXPECT_EQ(FakeLane(value), lane);
+          EXPECT_EQ(value, index);
+        } else {
+          cache.Put(key, FakeLane(value), value);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(40000, cache.hits() + cache.misses());
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,631 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+
+#include "modules/map/hdmap/tiled_hdmap_impl.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/common/util/string_util.h"
+#include "modules/map/hdmap/map_tiler.h"
+
+namespace apollo {
+namespace hdmap {
+
+using apollo::common::PointENU;
+using apollo::common::math::Vec2d;
+
+namespace {
+
+template <class InfoConstPtr>
+void AppendObjects(const std::shared_ptr<const HDMapImpl>& tile,
+                   const std::vector<InfoConstPtr>& objects,
+                   std::vector<InfoConstPtr>* const results) {
+  for (const auto& object : objects) {
+    // Shares the ownership of the tile, which owns the object.
+    results->push_back(InfoConstPtr(tile, object.get()));
+  }
+}
+
+template <class InfoConstPtr>
+void RemoveDuplicates(std::vector<InfoConstPtr>* const objects) {
+  std::sort(objects->begin(), objects->end(),
+            [](const InfoConstPtr& lhs, const InfoConstPtr& rhs) {
+              return lhs->id().id() < rhs->id().id();
+            });
+  objects->erase(
+      std::unique(objects->begin(), objects->end(),
+                  [](const InfoConstPtr& lhs, const InfoConstPtr& rhs) {
+                    return lhs->id().id() == rhs->id().id();
+                  }),
+      objects->end());
+}
+
+void RemoveDuplicates(MapElements* const elements) {
+  RemoveDuplicates(&elements->lanes);
+  RemoveDuplicates(&elements->junctions);
+  RemoveDuplicates(&elements->crosswalks);
+  RemoveDuplicates(&elements->signals);
+  RemoveDuplicates(&elements->stop_signs);
+  RemoveDuplicates(&elements->yield_signs);
+  RemoveDuplicates(&elements->clear_areas);
+  RemoveDuplicates(&elements->speed_bumps);
+  RemoveDuplicates(&elements->roads);
+}
+
+}  // namespace
+
+TiledHDMapImpl::TiledHDMapImpl()
+    : tiles_(static_cast<size_t>(std::max(1, FLAGS_map_tile_cache_capacity))) {
+}
+
+TiledHDMapImpl::~TiledHDMapImpl() { Clear(); }
+
+bool TiledHDMapImpl::IsTileIndexFile(const std::string& filename) {
+  return apollo::common::util::EndWith(filename, kMapTileIndexFilename);
+}
+
+int TiledHDMapImpl::LoadMapFromFile(const std::string& index_filename) {
+  Clear();
+
+  MapTileIndex index;
+  if (!apollo::common::util::GetProtoFromFile(index_filename, &index)) {
+    return -1;
+  }
+  if (index.tile_length() <= 0.0) {
+    AERROR << "Invalid tile length in " << index_filename;
+    return -1;
+  }
+  const auto slash = index_filename.find_last_of('/');
+  tile_dir_ =
+      slash == std::string::npos ? "." : index_filename.substr(0, slash);
+  tile_size_ = index.tile_length();
+  margin_ = index.margin();
+  for (const auto& tile : index.tile()) {
+    const TileKey key = MakeTileKey(tile.x(), tile.y());
+    tile_files_[key] = tile.filename();
+    const std::pair<ObjectType, const google::protobuf::RepeatedPtrField<
+                                    std::string>*> object_ids[] = {
+        {LANE, &tile.lane_id()},
+        {JUNCTION, &tile.junction_id()},
+        {SIGNAL, &tile.signal_id()},
+        {CROSSWALK, &tile.crosswalk_id()},
+        {STOP_SIGN, &tile.stop_sign_id()},
+        {YIELD_SIGN, &tile.yield_sign_id()},
+        {CLEAR_AREA, &tile.clear_area_id()},
+        {SPEED_BUMP, &tile.speed_bump_id()},
+        {OVERLAP, &tile.overlap_id()},
+        {ROAD, &tile.road_id()}};
+    for (const auto& type_ids : object_ids) {
+      for (const auto& id : *type_ids.second) {
+        object_tiles_[type_ids.first][id] = key;
+      }
+    }
+  }
+  AINFO << "Loaded the index of " << tile_files_.size() << " map tiles.";
+
+  if (FLAGS_map_tile_prefetch_radius > 0) {
+    stop_prefetch_ = false;
+    prefetch_thread_.reset(
+        new std::thread(&TiledHDMapImpl::PrefetchLoop, this));
+  }
+  return 0;
+}
+
+LaneInfoConstPtr TiledHDMapImpl::GetLaneById(const Id& id) const {
+  return GetObjectById(LANE, id, &HDMapImpl::GetLaneById);
+}
+
+JunctionInfoConstPtr TiledHDMapImpl::GetJunctionById(const Id& id) const {
+  return GetObjectById(JUNCTION, id, &HDMapImpl::GetJunctionById);
+}
+
+SignalInfoConstPtr TiledHDMapImpl::GetSignalById(const Id& id) const {
+  return GetObjectById(SIGNAL, id, &HDMapImpl::GetSignalById);
+}
+
+CrosswalkInfoConstPtr TiledHDMapImpl::GetCrosswalkById(const Id& id) const {
+  return GetObjectById(CROSSWALK, id, &HDMapImpl::GetCrosswalkById);
+}
+
+StopSignInfoConstPtr TiledHDMapImpl::GetStopSignById(const Id& id) const {
+  return GetObjectById(STOP_SIGN, id, &HDMapImpl::GetStopSignById);
+}
+
+YieldSignInfoConstPtr TiledHDMapImpl::GetYieldSignById(const Id& id) const {
+  return GetObjectById(YIELD_SIGN, id, &HDMapImpl::GetYieldSignById);
+}
+
+ClearAreaInfoConstPtr TiledHDMapImpl::GetClearAreaById(const Id& id) const {
+  return GetObjectById(CLEAR_AREA, id, &HDMapImpl::GetClearAreaById);
+}
+
+SpeedBumpInfoConstPtr TiledHDMapImpl::GetSpeedBumpById(const Id& id) const {
+  return GetObjectById(SPEED_BUMP, id, &HDMapImpl::GetSpeedBumpById);
+}
+
+OverlapInfoConstPtr TiledHDMapImpl::GetOverlapById(const Id& id) const {
+  return GetObjectById(OVERLAP, id, &HDMapImpl::GetOverlapById);
+}
+
+RoadInfoConstPtr TiledHDMapImpl::GetRoadById(const Id& id) const {
+  return GetObjectById(ROAD, id, &HDMapImpl::GetRoadById);
+}
+
+int TiledHDMapImpl::GetLanes(const PointENU& point, double distance,
+                             std::vector<LaneInfoConstPtr>* lanes) const {
+  return GetObjects(point, distance, &HDMapImpl::GetLanes, lanes);
+}
+
+int TiledHDMapImpl::GetJunctions(
+    const PointENU& point, double distance,
+    std::vector<JunctionInfoConstPtr>* junctions) const {
+  return GetObjects(point, distance, &HDMapImpl::GetJunctions, junctions);
+}
+
+int TiledHDMapImpl::GetCrosswalks(
+    const PointENU& point, double distance,
+    std::vector<CrosswalkInfoConstPtr>* crosswalks) const {
+  return GetObjects(point, distance, &HDMapImpl::GetCrosswalks, crosswalks);
+}
+
+int TiledHDMapImpl::GetSignals(const PointENU& point, double distance,
+                               std::vector<SignalInfoConstPtr>* signals) const {
+  return GetObjects(point, distance, &HDMapImpl::GetSignals, signals);
+}
+
+int TiledHDMapImpl::GetStopSigns(
+    const PointENU& point, double distance,
+    std::vector<StopSignInfoConstPtr>* stop_signs) const {
+  return GetObjects(point, distance, &HDMapImpl::GetStopSigns, stop_signs);
+}
+
+int TiledHDMapImpl::GetYieldSigns(
+    const PointENU& point, double distance,
+    std::vector<YieldSignInfoConstPtr>* yield_signs) const {
+  return GetObjects(point, distance, &HDMapImpl::GetYieldSigns, yield_signs);
+}
+
+int TiledHDMapImpl::GetClearAreas(
+    const PointENU& point, double distance,
+    std::vector<ClearAreaInfoConstPtr>* clear_areas) const {
+  return GetObjects(point, distance, &HDMapImpl::GetClearAreas, clear_areas);
+}
+
+int TiledHDMapImpl::GetSpeedBumps(
+    const PointENU& point, double distance,
+    std::vector<SpeedBumpInfoConstPtr>* speed_bumps) const {
+  return GetObjects(point, distance, &HDMapImpl::GetSpeedBumps, speed_bumps);
+}
+
+int TiledHDMapImpl::GetRoads(const PointENU& point, double distance,
+                             std::vector<RoadInfoConstPtr>* roads) const {
+  return GetObjects(point, distance, &HDMapImpl::GetRoads, roads);
+}
+
+int TiledHDMapImpl::GetNearestLane(const PointENU& point,
+                                   LaneInfoConstPtr* nearest_lane,
+                                   double* nearest_s,
+                                   double* nearest_l) const {
+  CHECK_NOTNULL(nearest_lane);
+  CHECK_NOTNULL(nearest_s);
+  CHECK_NOTNULL(nearest_l);
+  const int x = MapTileCoordinate(point.x(), tile_size_);
+  const int y = MapTileCoordinate(point.y(), tile_size_);
+  const Vec2d xy(point.x(), point.y());
+  // The nearest lane of the tile of the point is the nearest one of the map
+  // if it is within the margin; otherwise the tiles around are searched.
+  double min_distance = std::numeric_limits<double>::infinity();
+  for (int ring = 0; ring <= 1 && min_distance > margin_; ++ring) {
+    for (int dx = -ring; dx <= ring; ++dx) {
+      for (int dy = -ring; dy <= ring; ++dy) {
+        if (std::max(std::abs(dx), std::abs(dy)) != ring) {
+          continue;
+        }
+        const TilePtr tile = GetTile(MakeTileKey(x + dx, y + dy));
+        LaneInfoConstPtr lane = nullptr;
+        double s = 0.0;
+        double l = 0.0;
+        if (tile == nullptr ||
+            tile->GetNearestLane(point, &lane, &s, &l) != 0) {
+          continue;
+        }
+        const double distance = lane->DistanceTo(xy);
+        if (distance < min_distance) {
+          min_distance = distance;
+          *nearest_lane = InTile(tile, lane);
+          *nearest_s = s;
+          *nearest_l = l;
+        }
+      }
+    }
+  }
+  PrefetchAround(x, y);
+  return min_distance < std::numeric_limits<double>::infinity() ? 0 : -1;
+}
+
+int TiledHDMapImpl::GetNearestLaneWithHeading(
+    const PointENU& point, const double distance, const double central_heading,
+    const double max_heading_difference, LaneInfoConstPtr* nearest_lane,
+    double* nearest_s, double* nearest_l) const {
+  CHECK_NOTNULL(nearest_lane);
+  CHECK_NOTNULL(nearest_s);
+  CHECK_NOTNULL(nearest_l);
+  const Vec2d xy(point.x(), point.y());
+  double min_distance = std::numeric_limits<double>::infinity();
+  for (const auto& tile : GetTiles(point, distance)) {
+    LaneInfoConstPtr lane = nullptr;
+    double s = 0.0;
+    double l = 0.0;
+    if (tile->GetNearestLaneWithHeading(point, distance, central_heading,
+                                        max_heading_difference, &lane, &s,
+                                        &l) != 0) {
+      continue;
+    }
+    const double lane_distance = lane->DistanceTo(xy);
+    if (lane_distance < min_distance) {
+      min_distance = lane_distance;
+      *nearest_lane = InTile(tile, lane);
+      *nearest_s = s;
+      *nearest_l = l;
+    }
+  }
+  return min_distance < std::numeric_limits<double>::infinity() ? 0 : -1;
+}
+
+int TiledHDMapImpl::GetLanesWithHeading(
+    const PointENU& point, const double distance, const double central_heading,
+    const double max_heading_difference,
+    std::vector<LaneInfoConstPtr>* lanes) const {
+  CHECK_NOTNULL(lanes);
+  lanes->clear();
+  int status = -1;
+  std::unordered_set<std::string> lane_ids;
+  for (const auto& tile : GetTiles(point, distance)) {
+    std::vector<LaneInfoConstPtr> tile_lanes;
+    if (tile->GetLanesWithHeading(point, distance, central_heading,
+                                  max_heading_difference, &tile_lanes) != 0) {
+      continue;
+    }
+    status = 0;
+    for (const auto& lane : tile_lanes) {
+      if (lane_ids.insert(lane->id().id()).second) {
+        lanes->push_back(InTile(tile, lane));
+      }
+    }
+  }
+  return status;
+}
+
+int TiledHDMapImpl::GetRoadBoundaries(
+    const PointENU& point, double radius,
+    std::vector<RoadROIBoundaryPtr>* road_boundaries,
+    std::vector<JunctionBoundaryPtr>* junctions) const {
+  CHECK_NOTNULL(road_boundaries);
+  CHECK_NOTNULL(junctions);
+  road_boundaries->clear();
+  junctions->clear();
+  int status = -1;
+  // A road section or a junction may be found in several tiles.
+  std::unordered_set<std::string> road_boundary_keys;
+  std::unordered_set<std::string> junction_ids;
+  const std::vector<TilePtr> tiles = GetTiles(point, radius);
+  for (const auto& tile : tiles) {
+    std::vector<RoadROIBoundaryPtr> tile_road_boundaries;
+    std::vector<JunctionBoundaryPtr> tile_junctions;
+    if (tile->GetRoadBoundaries(point, radius, &tile_road_boundaries,
+                                &tile_junctions) != 0) {
+      continue;
+    }
+    status = 0;
+    for (const auto& road_boundary : tile_road_boundaries) {
+      if (tiles.size() == 1 ||
+          road_boundary_keys.insert(road_boundary->SerializeAsString())
+              .second) {
+        road_boundaries->push_back(road_boundary);
+      }
+    }
+    for (const auto& junction : tile_junctions) {
+      if (junction_ids.insert(junction->junction_info->id().id()).second) {
+        junction->junction_info = InTile(tile, junction->junction_info);
+        junctions->push_back(junction);
+      }
+    }
+  }
+  return status;
+}
+
+int TiledHDMapImpl::GetForwardNearestSignalsOnLane(
+    const PointENU& point, const double distance,
+    std::vector<SignalInfoConstPtr>* signals) const {
+  CHECK_NOTNULL(signals);
+  signals->clear();
+  const std::vector<TilePtr> tiles = GetTiles(point, 0.0);
+  if (tiles.empty() ||
+      tiles.front()->GetForwardNearestSignalsOnLane(point, distance,
+                                                    signals) != 0) {
+    return -1;
+  }
+  for (auto& signal : *signals) {
+    signal = InTile(tiles.front(), signal);
+  }
+  return 0;
+}
+
+int TiledHDMapImpl::GetMapElements(const PointENU& point,
+                                   const double distance,
+                                   const uint32_t type_mask,
+                                   MapElements* elements) const {
+  CHECK_NOTNULL(elements);
+  elements->Clear();
+  if (tile_files_.empty()) {
+    return -1;
+  }
+  AppendMapElements(point, distance, type_mask, elements);
+  RemoveDuplicates(elements);
+  return 0;
+}
+
+int TiledHDMapImpl::GetMapElements(const std::vector<PointENU>& points,
+                                   const double distance,
+                                   const uint32_t type_mask,
+                                   MapElements* elements) const {
+  CHECK_NOTNULL(elements);
+  elements->Clear();
+  if (tile_files_.empty()) {
+    return -1;
+  }
+  for (const auto& point : points) {
+    AppendMapElements(point, distance, type_mask, elements);
+  }
+  RemoveDuplicates(elements);
+  return 0;
+}
+
+size_t TiledHDMapImpl::NumLoadedTiles() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return tiles_.size();
+}
+
+TiledHDMapImpl::TileKey TiledHDMapImpl::MakeTileKey(const int x,
+                                                    const int y) {
+  return (static_cast<TileKey>(static_cast<uint32_t>(x)) << 32) |
+         static_cast<uint32_t>(y);
+}
+
+TiledHDMapImpl::TilePtr TiledHDMapImpl::GetTile(const TileKey key) const {
+  if (tile_files_.count(key) == 0) {
+    return nullptr;
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  return LoadTile(key, &lock);
+}
+
+TiledHDMapImpl::TilePtr TiledHDMapImpl::LoadTile(
+    const TileKey key, std::unique_lock<std::mutex>* const lock) const {
+  // Wait for the tile if someone else is loading it.
+  while (true) {
+    const TilePtr* tile = tiles_.Get(key);
+    if (tile != nullptr) {
+      return *tile;
+    }
+    if (loading_tiles_.count(key) == 0) {
+      break;
+    }
+    tile_loaded_.wait(*lock);
+  }
+  const auto it = tile_files_.find(key);
+  if (it == tile_files_.end()) {
+    return nullptr;
+  }
+  const std::string filename = tile_dir_ + "/" + it->second;
+  loading_tiles_.insert(key);
+  lock->unlock();
+
+  std::shared_ptr<HDMapImpl> tile(new HDMapImpl());
+  if (tile->LoadMapFromFile(filename) != 0) {
+    AERROR << "Failed to load map tile " << filename;
+    tile.reset();
+  }
+
+  lock->lock();
+  loading_tiles_.erase(key);
+  if (tile != nullptr) {
+    // The least recently used tile is dropped when the cache is full; its
+    // objects still held by the callers keep it alive until released.
+    tiles_.Put(key, TilePtr(tile));
+  }
+  tile_loaded_.notify_all();
+  return tile;
+}
+
+std::vector<TiledHDMapImpl::TilePtr> TiledHDMapImpl::GetTiles(
+    const PointENU& point, const double distance) const {
+  std::vector<TilePtr> tiles;
+  const int x = MapTileCoordinate(point.x(), tile_size_);
+  const int y = MapTileCoordinate(point.y(), tile_size_);
+  if (distance <= margin_) {
+    const TilePtr tile = GetTile(MakeTileKey(x, y));
+    if (tile != nullptr) {
+      tiles.push_back(tile);
+    }
+  } else {
+    const int min_x = MapTileCoordinate(point.x() - distance, tile_size_);
+    const int max_x = MapTileCoordinate(point.x() + distance, tile_size_);
+    const int min_y = MapTileCoordinate(point.y() - distance, tile_size_);
+    const int max_y = MapTileCoordinate(point.y() + distance, tile_size_);
+    for (int tile_x = min_x; tile_x <= max_x; ++tile_x) {
+      for (int tile_y = min_y; tile_y <= max_y; ++tile_y) {
+        const TilePtr tile = GetTile(MakeTileKey(tile_x, tile_y));
+        if (tile != nullptr) {
+          tiles.push_back(tile);
+        }
+      }
+    }
+  }
+  PrefetchAround(x, y);
+  return tiles;
+}
+
+TiledHDMapImpl::TilePtr TiledHDMapImpl::GetTileOfObject(
+    const ObjectType type, const Id& id) const {
+  const auto it = object_tiles_[type].find(id.id());
+  return it == object_tiles_[type].end() ? nullptr : GetTile(it->second);
+}
+
+void TiledHDMapImpl::Prefetch(const TileKey key) const {
+  if (tile_files_.count(key) == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  // A tile in use is kept from being dropped.
+  if (tiles_.Prioritize(key) || loading_tiles_.count(key) > 0 ||
+      std::find(prefetch_queue_.begin(), prefetch_queue_.end(), key) !=
+          prefetch_queue_.end()) {
+    return;
+  }
+  prefetch_queue_.push_back(key);
+  // The oldest requests are for where the vehicle was.
+  while (prefetch_queue_.size() > tiles_.capacity()) {
+    prefetch_queue_.pop_front();
+  }
+  prefetch_requested_.notify_one();
+}
+
+void TiledHDMapImpl::PrefetchAround(const int x, const int y) const {
+  if (prefetch_thread_ == nullptr) {
+    return;
+  }
+  const int radius = FLAGS_map_tile_prefetch_radius;
+  for (int dx = -radius; dx <= radius; ++dx) {
+    for (int dy = -radius; dy <= radius; ++dy) {
+      Prefetch(MakeTileKey(x + dx, y + dy));
+    }
+  }
+}
+
+void TiledHDMapImpl::PrefetchLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    prefetch_requested_.wait(lock, [this]() {
+      return stop_prefetch_ || !prefetch_queue_.empty();
+    });
+    if (stop_prefetch_) {
+      return;
+    }
+    const TileKey key = prefetch_queue_.front();
+    prefetch_queue_.pop_front();
+    if (!tiles_.Contains(key)) {
+      LoadTile(key, &lock);
+    }
+  }
+}
+
+template <class InfoConstPtr>
+InfoConstPtr TiledHDMapImpl::InTile(const TilePtr& tile,
+                                    const InfoConstPtr& info) {
+  // Shares the ownership of the tile, which owns the object.
+  return info == nullptr ? info : InfoConstPtr(tile, info.get());
+}
+
+template <class Info>
+std::shared_ptr<const Info> TiledHDMapImpl::GetObjectById(
+    const ObjectType type, const Id& id,
+    std::shared_ptr<const Info> (HDMapImpl::*get_by_id)(const Id&) const)
+    const {
+  const TilePtr tile = GetTileOfObject(type, id);
+  if (tile == nullptr) {
+    return nullptr;
+  }
+  return InTile(tile, ((*tile).*get_by_id)(id));
+}
+
+template <class InfoConstPtr>
+int TiledHDMapImpl::GetObjects(
+    const PointENU& point, const double distance,
+    int (HDMapImpl::*get_objects)(const PointENU&, double,
+                                  std::vector<InfoConstPtr>*) const,
+    std::vector<InfoConstPtr>* const objects) const {
+  CHECK_NOTNULL(objects);
+  objects->clear();
+  if (tile_files_.empty()) {
+    return -1;
+  }
+  std::unordered_set<std::string> ids;
+  for (const auto& tile : GetTiles(point, distance)) {
+    std::vector<InfoConstPtr> tile_objects;
+    if (((*tile).*get_objects)(point, distance, &tile_objects) != 0) {
+      continue;
+    }
+    for (const auto& object : tile_objects) {
+      if (ids.insert(object->id().id()).second) {
+        objects->push_back(InTile(tile, object));
+      }
+    }
+  }
+  return 0;
+}
+
+void TiledHDMapImpl::AppendMapElements(const PointENU& point,
+                                       const double distance,
+                                       const uint32_t type_mask,
+                                       MapElements* const elements) const {
+  MapElements tile_elements;
+  for (const auto& tile : GetTiles(point, distance)) {
+    if (tile->GetMapElements(point, distance, type_mask, &tile_elements) !=
+        0) {
+      continue;
+    }
+    AppendObjects(tile, tile_elements.lanes, &elements->lanes);
+    AppendObjects(tile, tile_elements.junctions, &elements->junctions);
+    AppendObjects(tile, tile_elements.crosswalks, &elements->crosswalks);
+    AppendObjects(tile, tile_elements.signals, &elements->signals);
+    AppendObjects(tile, tile_elements.stop_signs, &elements->stop_signs);
+    AppendObjects(tile, tile_elements.yield_signs, &elements->yield_signs);
+    AppendObjects(tile, tile_elements.clear_areas, &elements->clear_areas);
+    AppendObjects(tile, tile_elements.speed_bumps, &elements->speed_bumps);
+    AppendObjects(tile, tile_elements.roads, &elements->roads);
+  }
+}
+
+void TiledHDMapImpl::Clear() {
+  if (prefetch_thread_ != nullptr) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_prefetch_ = true;
+    }
+    prefetch_requested_.notify_all();
+    prefetch_thread_->join();
+    prefetch_thread_.reset();
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  tile_dir_.clear();
+  tile_size_ = 0.0;
+  margin_ = 0.0;
+  tile_files_.clear();
+  for (auto& object_tiles : object_tiles_) {
+    object_tiles.clear();
+  }
+  tiles_.Clear();
+  prefetch_queue_.clear();
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -0,0 +1,212 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+
+#ifndef MODULES_MAP_HDMAP_TILED_HDMAP_IMPL_H_
+#define MODULES_MAP_HDMAP_TILED_HDMAP_IMPL_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "modules/common/util/lru_cache.h"
+#include "modules/map/hdmap/hdmap_impl.h"
+
+/**
+ * @namespace apollo::hdmap
+ * @brief apollo::hdmap
+ */
+namespace apollo {
+namespace hdmap {
+
+/**
+ * @class TiledHDMapImpl
+ * @brief A map split into tiles by map_tiler, with the interface of
+ * HDMapImpl. Only the tile index is loaded up front; a tile is loaded when a
+ * query needs it, the tiles around it are loaded by a background thread,
+ * and the least recently used tiles are dropped when more than
+ * FLAGS_map_tile_cache_capacity are loaded.
+ *
+ * \par
+ * A query within the margin of a point is answered by the tile of the
+ * point alone, a wider query by all the tiles it covers. The objects
+ * returned keep their tile alive, so they stay valid when the tile is
+ * dropped; the same object from two tiles is two different objects with
+ * the same id. The lane walk of GetForwardNearestSignalsOnLane stays in
+ * the tile of the point.
+ */
+class TiledHDMapImpl {
+ public:
+  TiledHDMapImpl();
+  ~TiledHDMapImpl();
+
+  /**
+   * @brief check whether a file is a tile index written by map_tiler.
+   */
+  static bool IsTileIndexFile(const std::string& filename);
+
+  int LoadMapFromFile(const std::string& index_filename);
+
+  LaneInfoConstPtr GetLaneById(const Id& id) const;
+  JunctionInfoConstPtr GetJunctionById(const Id& id) const;
+  SignalInfoConstPtr GetSignalById(const Id& id) const;
+  CrosswalkInfoConstPtr GetCrosswalkById(const Id& id) const;
+  StopSignInfoConstPtr GetStopSignById(const Id& id) const;
+  YieldSignInfoConstPtr GetYieldSignById(const Id& id) const;
+  ClearAreaInfoConstPtr GetClearAreaById(const Id& id) const;
+  SpeedBumpInfoConstPtr GetSpeedBumpById(const Id& id) const;
+  OverlapInfoConstPtr GetOverlapById(const Id& id) const;
+  RoadInfoConstPtr GetRoadById(const Id& id) const;
+
+  int GetLanes(const apollo::common::PointENU& point, double distance,
+               std::vector<LaneInfoConstPtr>* lanes) const;
+  int GetJunctions(const apollo::common::PointENU& point, double distance,
+                   std::vector<JunctionInfoConstPtr>* junctions) const;
+  int GetCrosswalks(const apollo::common::PointENU& point, double distance,
+                    std::vector<CrosswalkInfoConstPtr>* crosswalks) const;
+  int GetSignals(const apollo::common::PointENU& point, double distance,
+                 std::vector<SignalInfoConstPtr>* signals) const;
+  int GetMapElements(const apollo::common::PointENU& point,
+                     const double distance, const uint32_t type_mask,
+                     MapElements* elements) const;
+  int GetMapElements(const std::vector<apollo::common::PointENU>& points,
+                     const double distance, const uint32_t type_mask,
+                     MapElements* elements) const;
+  int GetStopSigns(const apollo::common::PointENU& point, double distance,
+                   std::vector<StopSignInfoConstPtr>* stop_signs) const;
+  int GetYieldSigns(const apollo::common::PointENU& point, double distance,
+                    std::vector<YieldSignInfoConstPtr>* yield_signs) const;
+  int GetClearAreas(const apollo::common::PointENU& point, double distance,
+                    std::vector<ClearAreaInfoConstPtr>* clear_areas) const;
+  int GetSpeedBumps(const apollo::common::PointENU& point, double distance,
+                    std::vector<SpeedBumpInfoConstPtr>* speed_bumps) const;
+  int GetRoads(const apollo::common::PointENU& point, double distance,
+               std::vector<RoadInfoConstPtr>* roads) const;
+
+  int GetNearestLane(const apollo::common::PointENU& point,
+                     LaneInfoConstPtr* nearest_lane, double* nearest_s,
+                     double* nearest_l) const;
+  int GetNearestLaneWithHeading(const apollo::common::PointENU& point,
+                                const double distance,
+                                const double central_heading,
+                                const double max_heading_difference,
+                                LaneInfoConstPtr* nearest_lane,
+                                double* nearest_s, double* nearest_l) const;
+  int GetLanesWithHeading(const apollo::common::PointENU& point,
+                          const double distance, const double central_heading,
+                          const double max_heading_difference,
+                          std::vector<LaneInfoConstPtr>* lanes) const;
+  int GetRoadBoundaries(const apollo::common::PointENU& point, double radius,
+                        std::vector<RoadROIBoundaryPtr>* road_boundaries,
+                        std::vector<JunctionBoundaryPtr>* junctions) const;
+  int GetForwardNearestSignalsOnLane(
+      const apollo::common::PointENU& point, const double distance,
+      std::vector<SignalInfoConstPtr>* signals) const;
+
+  /**
+   * @brief get the number of tiles in memory.
+   */
+  size_t NumLoadedTiles() const;
+
+ private:
+  using TileKey = uint64_t;
+  using TilePtr = std::shared_ptr<const HDMapImpl>;
+
+  enum ObjectType {
+    LANE = 0,
+    JUNCTION,
+    SIGNAL,
+    CROSSWALK,
+    STOP_SIGN,
+    YIELD_SIGN,
+    CLEAR_AREA,
+    SPEED_BUMP,
+    OVERLAP,
+    ROAD,
+    NUM_OBJECT_TYPES,
+  };
+
+  static TileKey MakeTileKey(const int x, const int y);
+
+  /**
+   * @brief get a tile, and load it if it is not in memory.
+   * @return the tile, nullptr if there is no such tile
+   */
+  TilePtr GetTile(const TileKey key) const;
+  TilePtr LoadTile(const TileKey key,
+                   std::unique_lock<std::mutex>* const lock) const;
+
+  /**
+   * @brief get the tiles which have all the objects within the distance of
+   * a point, and queue the tiles around the point for loading.
+   */
+  std::vector<TilePtr> GetTiles(const apollo::common::PointENU& point,
+                                const double distance) const;
+  TilePtr GetTileOfObject(const ObjectType type, const Id& id) const;
+  void Prefetch(const TileKey key) const;
+  void PrefetchAround(const int x, const int y) const;
+  void PrefetchLoop();
+
+  template <class InfoConstPtr>
+  static InfoConstPtr InTile(const TilePtr& tile, const InfoConstPtr& info);
+
+  template <class Info>
+  std::shared_ptr<const Info> GetObjectById(
+      const ObjectType type, const Id& id,
+      std::shared_ptr<const Info> (HDMapImpl::*get_by_id)(const Id&) const)
+      const;
+
+  template <class InfoConstPtr>
+  int GetObjects(const apollo::common::PointENU& point, const double distance,
+                 int (HDMapImpl::*get_objects)(
+                     const apollo::common::PointENU&, double,
+                     std::vector<InfoConstPtr>*) const,
+                 std::vector<InfoConstPtr>* const objects) const;
+
+  void AppendMapElements(const apollo::common::PointENU& point,
+                         const double distance, const uint32_t type_mask,
+                         MapElements* const elements) const;
+
+  void Clear();
+
+ private:
+  std::string tile_dir_;
+  double tile_size_ = 0.0;
+  double margin_ = 0.0;
+  std::unordered_map<TileKey, std::string> tile_files_;
+  std::unordered_map<std::string, TileKey> object_tiles_[NUM_OBJECT_TYPES];
+
+  mutable std::mutex mutex_;
+  mutable std::condition_variable tile_loaded_;
+  mutable apollo::common::util::LRUCache<TileKey, TilePtr> tiles_;
+  // The tiles being loaded, by a query or by the prefetch thread.
+  mutable std::unordered_set<TileKey> loading_tiles_;
+  mutable std::deque<TileKey> prefetch_queue_;
+  mutable std::condition_variable prefetch_requested_;
+  bool stop_prefetch_ = false;
+  std::unique_ptr<std::thread> prefetch_thread_;
+};
+
+}  // namespace hdmap
+}  // namespace apollo
+
+#endif  // MODULES_MAP_HDMAP_TILED_HDMAP_IMPL_H_
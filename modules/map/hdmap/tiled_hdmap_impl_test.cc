@@ -0,0 +1,191 @@
+/* Copyright 2017 The Apollo Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+=========================================================================*/
+
+
+#include "modules/map/hdmap/tiled_hdmap_impl.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/util/file.h"
+#include "modules/map/hdmap/map_tiler.h"
+
+namespace {
+
+constexpr char kMapFilename[] = "modules/map/hdmap/test-data/base_map.bin";
+constexpr double kTileLength = 200.0;
+constexpr double kTileMargin = 20.0;
+
+}  // namespace
+
+namespace apollo {
+namespace hdmap {
+
+using apollo::common::PointENU;
+
+class TiledHDMapImplTestSuite : public ::testing::Test {
+ public:
+  TiledHDMapImplTestSuite() {
+    const char* tmp_dir = std::getenv("TEST_TMPDIR");
+    tile_dir_ = std::string(tmp_dir == nullptr ? "/tmp" : tmp_dir) +
+                "/tiled_hdmap_impl_test";
+    Map map;
+    EXPECT_TRUE(apollo::common::util::GetProtoFromFile(kMapFilename, &map));
+    EXPECT_TRUE(WriteMapTiles(map, kTileLength, kTileMargin, tile_dir_));
+    EXPECT_EQ(0, hdmap_impl_.LoadMapFromFile(kMapFilename));
+    // Points along the lanes of the map.
+    for (int i = 0; i < map.lane_size(); i += 10) {
+      for (const auto& segment : map.lane(i).central_curve().segment()) {
+        points_.push_back(segment.line_segment().point(0));
+      }
+    }
+  }
+
+  std::string IndexFilename() const {
+    return tile_dir_ + "/" + kMapTileIndexFilename;
+  }
+
+  template <class InfoConstPtr>
+  static std::vector<std::string> Ids(const std::vector<InfoConstPtr>& infos) {
+    std::vector<std::string> ids;
+    for (const auto& info : infos) {
+      ids.push_back(info->id().id());
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  }
+
+ public:
+  std::string tile_dir_;
+  HDMapImpl hdmap_impl_;
+  std::vector<PointENU> points_;
+};
+
+TEST_F(TiledHDMapImplTestSuite, SplitMapIntoTiles) {
+  Map map;
+  ASSERT_TRUE(apollo::common::util::GetProtoFromFile(kMapFilename, &map));
+  MapTileIndex index;
+  std::vector<Map> tiles;
+  ASSERT_TRUE(SplitMapIntoTiles(map, kTileLength, kTileMargin, &index,
+                                &tiles));
+  EXPECT_LT(1, index.tile_size());
+  ASSERT_EQ(index.tile_size(), tiles.size());
+  // Every object is looked up in exactly one tile, which has it.
+  int num_lanes = 0;
+  for (int i = 0; i < index.tile_size(); ++i) {
+    num_lanes += index.tile(i).lane_id_size();
+    for (const auto& lane_id : index.tile(i).lane_id()) {
+      EXPECT_TRUE(std::any_of(
+          tiles[i].lane().begin(), tiles[i].lane().end(),
+          [&lane_id](const Lane& lane) { return lane.id().id() == lane_id; }));
+    }
+  }
+  EXPECT_EQ(map.lane_size(), num_lanes);
+  EXPECT_FALSE(SplitMapIntoTiles(map, 0.0, kTileMargin, &index, &tiles));
+}
+
+TEST_F(TiledHDMapImplTestSuite, GetById) {
+  TiledHDMapImpl tiled_hdmap_impl;
+  ASSERT_EQ(0, tiled_hdmap_impl.LoadMapFromFile(IndexFilename()));
+  EXPECT_EQ(0, tiled_hdmap_impl.NumLoadedTiles());
+
+  Id id;
+  id.set_id("1272_1_-1");
+  const auto lane = tiled_hdmap_impl.GetLaneById(id);
+  ASSERT_TRUE(lane != nullptr);
+  EXPECT_EQ("1272_1_-1", lane->id().id());
+  EXPECT_EQ(hdmap_impl_.GetLaneById(id)->road_id().id(),
+            lane->road_id().id());
+  EXPECT_LE(1, tiled_hdmap_impl.NumLoadedTiles());
+  id.set_id("1183");
+  EXPECT_TRUE(tiled_hdmap_impl.GetJunctionById(id) != nullptr);
+  id.set_id("1278");
+  EXPECT_TRUE(tiled_hdmap_impl.GetSignalById(id) != nullptr);
+  id.set_id("1");
+  EXPECT_TRUE(tiled_hdmap_impl.GetLaneById(id) == nullptr);
+}
+
+TEST_F(TiledHDMapImplTestSuite, GetLanes) {
+  TiledHDMapImpl tiled_hdmap_impl;
+  ASSERT_EQ(0, tiled_hdmap_impl.LoadMapFromFile(IndexFilename()));
+  ASSERT_FALSE(points_.empty());
+  for (const auto& point : points_) {
+    for (const double distance : {5.0, kTileMargin, 300.0}) {
+      std::vector<LaneInfoConstPtr> lanes;
+      std::vector<LaneInfoConstPtr> tiled_lanes;
+      EXPECT_EQ(0, hdmap_impl_.GetLanes(point, distance, &lanes));
+      EXPECT_EQ(0, tiled_hdmap_impl.GetLanes(point, distance, &tiled_lanes));
+      EXPECT_EQ(Ids(lanes), Ids(tiled_lanes));
+    }
+    std::vector<JunctionInfoConstPtr> junctions;
+    std::vector<JunctionInfoConstPtr> tiled_junctions;
+    hdmap_impl_.GetJunctions(point, 100.0, &junctions);
+    tiled_hdmap_impl.GetJunctions(point, 100.0, &tiled_junctions);
+    EXPECT_EQ(Ids(junctions), Ids(tiled_junctions));
+
+    MapElements elements;
+    MapElements tiled_elements;
+    EXPECT_EQ(0, hdmap_impl_.GetMapElements(point, 100.0, MAP_ELEMENT_ALL,
+                                            &elements));
+    EXPECT_EQ(0, tiled_hdmap_impl.GetMapElements(point, 100.0, MAP_ELEMENT_ALL,
+                                                 &tiled_elements));
+    EXPECT_EQ(Ids(elements.lanes), Ids(tiled_elements.lanes));
+    EXPECT_EQ(Ids(elements.signals), Ids(tiled_elements.signals));
+    EXPECT_EQ(Ids(elements.roads), Ids(tiled_elements.roads));
+
+    LaneInfoConstPtr lane = nullptr;
+    LaneInfoConstPtr tiled_lane = nullptr;
+    double s = 0.0;
+    double l = 0.0;
+    double tiled_s = 0.0;
+    double tiled_l = 0.0;
+    EXPECT_EQ(0, hdmap_impl_.GetNearestLane(point, &lane, &s, &l));
+    EXPECT_EQ(0, tiled_hdmap_impl.GetNearestLane(point, &tiled_lane, &tiled_s,
+                                                 &tiled_l));
+    ASSERT_TRUE(tiled_lane != nullptr);
+    EXPECT_NEAR(lane->DistanceTo({point.x(), point.y()}),
+                tiled_lane->DistanceTo({point.x(), point.y()}), 1e-6);
+  }
+}
+
+TEST_F(TiledHDMapImplTestSuite, Eviction) {
+  FLAGS_map_tile_cache_capacity = 2;
+  FLAGS_map_tile_prefetch_radius = 0;
+  TiledHDMapImpl tiled_hdmap_impl;
+  ASSERT_EQ(0, tiled_hdmap_impl.LoadMapFromFile(IndexFilename()));
+  std::vector<LaneInfoConstPtr> first_lanes;
+  for (const auto& point : points_) {
+    std::vector<LaneInfoConstPtr> lanes;
+    EXPECT_EQ(0, tiled_hdmap_impl.GetLanes(point, 5.0, &lanes));
+    EXPECT_LE(tiled_hdmap_impl.NumLoadedTiles(), 2);
+    if (first_lanes.empty()) {
+      first_lanes = lanes;
+    }
+  }
+  // The lanes keep their tile alive after it is dropped.
+  for (const auto& lane : first_lanes) {
+    EXPECT_LT(0.0, lane->total_length());
+  }
+  FLAGS_map_tile_cache_capacity = 64;
+  FLAGS_map_tile_prefetch_radius = 1;
+}
+
+}  // namespace hdmap
+}  // namespace apollo
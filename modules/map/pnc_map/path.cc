@@ -21,6 +21,7 @@
 #include <limits>
 #include <unordered_map>
 
+#include "modules/common/configs/config_gflags.h"
 #include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/math/polygon2d.h"
@@ -30,6 +31,7 @@
 namespace apollo {
 namespace hdmap {
 
+using common::math::AABoxKDTreeParams;
 using common::math::LineSegment2d;
 using common::math::Polygon2d;
 using common::math::Vec2d;
@@ -42,6 +44,12 @@ namespace {
 
 const double kSampleDistance = 0.25;
 
+// Paths with fewer segments than this are scanned linearly.
+const int kMinNumSegmentsForIndex = 32;
+
+// Segments within this distance to the nearest one are projection candidates.
+const double kSegmentIndexTolerance = 1e-6;
+
 bool find_lane_segment(const MapPathPoint& p1, const MapPathPoint& p2,
                        LaneSegment* const lane_segment) {
   for (const auto& wp1 : p1.lane_waypoints()) {
@@ -216,12 +224,50 @@ Path::Path(std::vector<MapPathPoint> path_points,
   }
 }
 
+PathSegmentIndex::PathSegmentIndex(const std::vector<LineSegment2d>& segments)
+    : segments_(segments) {
+  segment_boxes_.reserve(segments_.size());
+  for (size_t i = 0; i < segments_.size(); ++i) {
+    segment_boxes_.emplace_back(common::math::AABox2d(segments_[i].start(),
+                                                      segments_[i].end()),
+                                this, &segments_[i], static_cast<int>(i));
+  }
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;  // meters.
+  params.max_leaf_size = 16;
+  segment_kdtree_.reset(new SegmentKDTree(segment_boxes_, params));
+}
+
+void PathSegmentIndex::GetCandidateSegments(
+    const Vec2d& point, std::vector<int>* const segment_ids) const {
+  CHECK_NOTNULL(segment_ids);
+  segment_ids->clear();
+  const auto* nearest = segment_kdtree_->GetNearestObject(point);
+  if (nearest == nullptr) {
+    return;
+  }
+  const double distance = nearest->DistanceTo(point) + kSegmentIndexTolerance;
+  for (const auto* box : segment_kdtree_->GetObjects(point, distance)) {
+    segment_ids->push_back(box->id());
+  }
+  std::sort(segment_ids->begin(), segment_ids->end());
+}
+
 void Path::Init() {
   InitPoints();
   InitLaneSegments();
   InitPointIndex();
   InitWidth();
   InitOverlaps();
+  InitSegmentIndex();
+}
+
+void Path::InitSegmentIndex() {
+  segment_index_.reset();
+  if (FLAGS_use_path_segment_index &&
+      num_segments_ >= kMinNumSegmentsForIndex) {
+    segment_index_ = std::make_shared<const PathSegmentIndex>(segments_);
+  }
 }
 
 void Path::InitPoints() {
@@ -390,6 +436,20 @@ void Path::GetAllOverlaps(GetOverlapFromLaneFunc get_overlaps_from_lane,
             });
 }
 
+PathOverlapRange Path::GetOverlapsStartingIn(
+    const std::vector<PathOverlap>& overlaps, const double start_s,
+    const double end_s) {
+  auto less = [](const PathOverlap& overlap, const double s) {
+    return overlap.start_s < s;
+  };
+  const auto begin =
+      std::lower_bound(overlaps.begin(), overlaps.end(), start_s, less);
+  const auto end =
+      end_s > start_s ? std::lower_bound(begin, overlaps.end(), end_s, less)
+                      : begin;
+  return PathOverlapRange(begin, end);
+}
+
 void Path::InitOverlaps() {
   GetAllOverlaps(std::bind(&LaneInfo::cross_lanes, _1), &lane_overlaps_);
   GetAllOverlaps(std::bind(&LaneInfo::signals, _1), &signal_overlaps_);
@@ -577,39 +637,104 @@ bool Path::GetProjection(const Vec2d& point, double* accumulate_s,
   CHECK_GE(num_points_, 2);
   *min_distance = std::numeric_limits<double>::infinity();
 
-  for (int i = 0; i < num_segments_; ++i) {
-    const auto& segment = segments_[i];
-    const double distance = segment.DistanceTo(point);
-    if (distance < *min_distance) {
-      const double proj = segment.ProjectOntoUnit(point);
-      if (proj < 0.0 && i > 0) {
-        continue;
-      }
-      if (proj > segment.length() && i + 1 < num_segments_) {
-        const auto& next_segment = segments_[i + 1];
-        if ((point - next_segment.start())
-                .InnerProd(next_segment.unit_direction()) >= 0.0) {
-          continue;
-        }
-      }
-      *min_distance = distance;
-      if (i + 1 >= num_segments_) {
-        *accumulate_s = accumulated_s_[i] + proj;
-      } else {
-        *accumulate_s = accumulated_s_[i] + std::min(proj, segment.length());
-      }
-      const double prod = segment.ProductOntoUnit(point);
-      if ((i == 0 && proj < 0.0) ||
-          (i + 1 == num_segments_ && proj > segment.length())) {
-        *lateral = prod;
-      } else {
-        *lateral = (prod > 0.0 ? distance : -distance);
-      }
+  if (segment_index_ != nullptr) {
+    // The candidates contain every segment the linear scan could select, so
+    // visiting them in ascending order gives the same result.
+    std::vector<int> segment_ids;
+    segment_index_->GetCandidateSegments(point, &segment_ids);
+    for (const int i : segment_ids) {
+      UpdateProjectionWithSegment(point, i, accumulate_s, lateral,
+                                  min_distance);
+    }
+    if (*min_distance < std::numeric_limits<double>::infinity()) {
+      return true;
     }
   }
+  for (int i = 0; i < num_segments_; ++i) {
+    UpdateProjectionWithSegment(point, i, accumulate_s, lateral, min_distance);
+  }
   return true;
 }
 
+bool Path::GetProjectionWithWarmStartS(const Vec2d& point,
+                                       const double warm_start_s,
+                                       double* accumulate_s, double* lateral,
+                                       double* min_distance) const {
+  if (segments_.empty()) {
+    return false;
+  }
+  if (accumulate_s == nullptr || lateral == nullptr ||
+      min_distance == nullptr) {
+    return false;
+  }
+  CHECK_GE(num_points_, 2);
+  const double s = std::max(0.0, std::min(warm_start_s, length_));
+  int index = std::min(GetIndexFromS(s).id, num_segments_ - 1);
+  double distance_sqr = segments_[index].DistanceSquareTo(point);
+  while (index > 0) {
+    const double prev_distance_sqr =
+        segments_[index - 1].DistanceSquareTo(point);
+    if (prev_distance_sqr >= distance_sqr) {
+      break;
+    }
+    --index;
+    distance_sqr = prev_distance_sqr;
+  }
+  while (index + 1 < num_segments_) {
+    const double next_distance_sqr =
+        segments_[index + 1].DistanceSquareTo(point);
+    if (next_distance_sqr >= distance_sqr) {
+      break;
+    }
+    ++index;
+    distance_sqr = next_distance_sqr;
+  }
+
+  *min_distance = std::numeric_limits<double>::infinity();
+  const int end_index = std::min(index + 2, num_segments_);
+  for (int i = std::max(index - 1, 0); i < end_index; ++i) {
+    UpdateProjectionWithSegment(point, i, accumulate_s, lateral, min_distance);
+  }
+  if (*min_distance < std::numeric_limits<double>::infinity()) {
+    return true;
+  }
+  return GetProjection(point, accumulate_s, lateral, min_distance);
+}
+
+void Path::UpdateProjectionWithSegment(const Vec2d& point, const int i,
+                                       double* accumulate_s, double* lateral,
+                                       double* min_distance) const {
+  const auto& segment = segments_[i];
+  const double distance = segment.DistanceTo(point);
+  if (distance >= *min_distance) {
+    return;
+  }
+  const double proj = segment.ProjectOntoUnit(point);
+  if (proj < 0.0 && i > 0) {
+    return;
+  }
+  if (proj > segment.length() && i + 1 < num_segments_) {
+    const auto& next_segment = segments_[i + 1];
+    if ((point - next_segment.start())
+            .InnerProd(next_segment.unit_direction()) >= 0.0) {
+      return;
+    }
+  }
+  *min_distance = distance;
+  if (i + 1 >= num_segments_) {
+    *accumulate_s = accumulated_s_[i] + proj;
+  } else {
+    *accumulate_s = accumulated_s_[i] + std::min(proj, segment.length());
+  }
+  const double prod = segment.ProductOntoUnit(point);
+  if ((i == 0 && proj < 0.0) ||
+      (i + 1 == num_segments_ && proj > segment.length())) {
+    *lateral = prod;
+  } else {
+    *lateral = (prod > 0.0 ? distance : -distance);
+  }
+}
+
 bool Path::GetHeadingAlongPath(const Vec2d& point, double* heading) const {
   if (heading == nullptr) {
     return false;
@@ -18,6 +18,7 @@
 #define MODULES_MAP_PNC_MAP_PATH_H_
 
 #include <cmath>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <sstream>
@@ -28,6 +29,7 @@
 #include "modules/map/proto/map_lane.pb.h"
 
 #include "modules/common/log.h"
+#include "modules/common/math/aaboxkdtree2d.h"
 #include "modules/common/math/box2d.h"
 #include "modules/common/math/line_segment2d.h"
 #include "modules/common/math/vec2d.h"
@@ -100,6 +102,26 @@ struct PathOverlap {
   std::string DebugString() const;
 };
 
+/**
+ * @brief A range of the overlaps of a path, which are sorted by start s.
+ */
+class PathOverlapRange {
+ public:
+  using const_iterator = std::vector<PathOverlap>::const_iterator;
+
+  PathOverlapRange(const_iterator begin, const_iterator end)
+      : begin_(begin), end_(end) {}
+
+  const_iterator begin() const { return begin_; }
+  const_iterator end() const { return end_; }
+  bool empty() const { return begin_ == end_; }
+  std::size_t size() const { return end_ - begin_; }
+
+ private:
+  const_iterator begin_;
+  const_iterator end_;
+};
+
 class MapPathPoint : public common::math::Vec2d {
  public:
   MapPathPoint() = default;
@@ -203,6 +225,35 @@ class InterpolatedIndex {
   double offset = 0.0;
 };
 
+/**
+ * @class PathSegmentIndex
+ * @brief A KD-tree over the segments of a path, used to avoid scanning every
+ * segment when projecting a point onto a long path.
+ */
+class PathSegmentIndex {
+ public:
+  explicit PathSegmentIndex(
+      const std::vector<common::math::LineSegment2d>& segments);
+
+  /**
+   * @brief Get the ids, in ascending order, of all segments whose distance
+   * to the point is within a small tolerance of the nearest segment.
+   * @param point The query point.
+   * @param segment_ids The output candidate segment ids.
+   */
+  void GetCandidateSegments(const common::math::Vec2d& point,
+                            std::vector<int>* const segment_ids) const;
+
+ private:
+  using SegmentBox =
+      ObjectWithAABox<PathSegmentIndex, common::math::LineSegment2d>;
+  using SegmentKDTree = common::math::AABoxKDTree2d<SegmentBox>;
+
+  std::vector<common::math::LineSegment2d> segments_;
+  std::vector<SegmentBox> segment_boxes_;
+  std::unique_ptr<SegmentKDTree> segment_kdtree_;
+};
+
 class Path {
  public:
   Path() = default;
@@ -232,6 +283,17 @@ class Path {
                                         const double hueristic_end_s,
                                         double* accumulate_s, double* lateral,
                                         double* min_distance) const;
+  /**
+   * @brief Project a point onto the path, starting the search from the
+   * segment at warm_start_s and walking towards the closer neighbors. When
+   * projecting a sequence of nearby points, passing the previous projected s
+   * makes each lookup touch only a few segments. Falls back to GetProjection
+   * if no valid projection is found around the warm start.
+   */
+  bool GetProjectionWithWarmStartS(const common::math::Vec2d& point,
+                                   const double warm_start_s,
+                                   double* accumulate_s, double* lateral,
+                                   double* min_distance) const;
   bool GetProjection(const common::math::Vec2d& point, double* accumulate_s,
                      double* lateral) const;
   bool GetProjection(const common::math::Vec2d& point, double* accumulate_s,
@@ -287,6 +349,16 @@ class Path {
     return speed_bump_overlaps_;
   }
 
+  /**
+   * @brief Gets the overlaps whose start s is in [start_s, end_s) in
+   * O(log n), from overlaps sorted by start s as the overlaps of a path are,
+   * e.g. GetOverlapsStartingIn(path.signal_overlaps(), s, kInf) for the
+   * signals ahead of s.
+   */
+  static PathOverlapRange GetOverlapsStartingIn(
+      const std::vector<PathOverlap>& overlaps, const double start_s,
+      const double end_s);
+
   double GetLeftWidth(const double s) const;
   double GetRightWidth(const double s) const;
   bool GetWidth(const double s, double* left_width, double* right_width) const;
@@ -303,6 +375,14 @@ class Path {
   void InitWidth();
   void InitPointIndex();
   void InitOverlaps();
+  void InitSegmentIndex();
+
+  // Update the projection result with segment i if it is closer than
+  // *min_distance, following the segment selection rules of GetProjection.
+  void UpdateProjectionWithSegment(const common::math::Vec2d& point,
+                                   const int i, double* accumulate_s,
+                                   double* lateral,
+                                   double* min_distance) const;
 
   double GetSample(const std::vector<double>& samples, const double s) const;
 
@@ -323,6 +403,9 @@ class Path {
   std::vector<common::math::LineSegment2d> segments_;
   bool use_path_approximation_ = false;
   PathApproximation approximation_;
+  // Shared between copies of the path, since segments_ never change after
+  // Init().
+  std::shared_ptr<const PathSegmentIndex> segment_index_;
 
   // Sampled every fixed length.
   int num_sample_points_ = 0;
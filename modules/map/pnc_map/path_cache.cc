@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/map/pnc_map/path_cache.h"
+
+#include <utility>
+
+#include "modules/common/log.h"
+#include "modules/common/util/string_util.h"
+#include "modules/map/pnc_map/pnc_map.h"
+
+namespace apollo {
+namespace hdmap {
+
+std::shared_ptr<const Path> PathCache::GetPath(const RouteSegments &segments) {
+  const std::string key = Key(segments);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = next_entries_.find(key);
+    if (iter == next_entries_.end()) {
+      iter = entries_.find(key);
+      if (iter != entries_.end()) {
+        iter = next_entries_.emplace(key, iter->second).first;
+      }
+    }
+    // The key is rounded, so the exact ranges are compared on a hit.
+    if (iter != next_entries_.end() &&
+        SameLaneRanges(iter->second.segments, segments)) {
+      ++hits_;
+      return iter->second.path;
+    }
+    ++misses_;
+  }
+  auto path = std::make_shared<Path>();
+  if (!PncMap::CreatePathFromLaneSegments(segments, path.get())) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  Entry &entry = next_entries_[key];
+  entry.segments = segments;
+  entry.path = std::move(path);
+  return entry.path;
+}
+
+void PathCache::NextCycle() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.swap(next_entries_);
+  next_entries_.clear();
+}
+
+void PathCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  next_entries_.clear();
+}
+
+size_t PathCache::Size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t size = next_entries_.size();
+  for (const auto &entry : entries_) {
+    size += next_entries_.count(entry.first) == 0 ? 1 : 0;
+  }
+  return size;
+}
+
+uint64_t PathCache::hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hits_;
+}
+
+uint64_t PathCache::misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return misses_;
+}
+
+std::string PathCache::Key(const RouteSegments &segments) {
+  std::string key;
+  for (const auto &segment : segments) {
+    key += common::util::StringPrintf("%s:%.2f:%.2f;",
+                                      segment.lane->id().id().c_str(),
+                                      segment.start_s, segment.end_s);
+  }
+  return key;
+}
+
+bool PathCache::SameLaneRanges(const RouteSegments &lhs,
+                               const RouteSegments &rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    if (lhs[i].lane != rhs[i].lane || lhs[i].start_s != rhs[i].start_s ||
+        lhs[i].end_s != rhs[i].end_s) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace hdmap
+}  // namespace apollo
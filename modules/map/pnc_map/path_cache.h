@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#ifndef MODULES_MAP_PNC_MAP_PATH_CACHE_H_
+#define MODULES_MAP_PNC_MAP_PATH_CACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "modules/map/pnc_map/path.h"
+#include "modules/map/pnc_map/route_segments.h"
+
+namespace apollo {
+namespace hdmap {
+
+/**
+ * @class PathCache
+ *
+ * @brief A cache of the paths created from route segments, so that the
+ * consecutive planning cycles on the same lane ranges share one immutable
+ * path instead of initializing a new one each time.
+ *
+ * The paths are keyed by the lane ids and the s ranges of the segments. An
+ * entry is kept as long as it is used between two calls of NextCycle().
+ */
+class PathCache {
+ public:
+  /**
+   * @brief Gets the path of the route segments, creating it on a miss.
+   * @return nullptr if the path cannot be created from the segments.
+   */
+  std::shared_ptr<const Path> GetPath(const RouteSegments &segments);
+
+  /**
+   * @brief Drops the paths not used since the last call.
+   */
+  void NextCycle();
+
+  void Clear();
+
+  size_t Size() const;
+  uint64_t hits() const;
+  uint64_t misses() const;
+
+  /**
+   * @brief The key of the lane ranges of the segments, rounded to
+   * centimeters.
+   */
+  static std::string Key(const RouteSegments &segments);
+
+ private:
+  struct Entry {
+    RouteSegments segments;
+    std::shared_ptr<const Path> path;
+  };
+
+  static bool SameLaneRanges(const RouteSegments &lhs,
+                             const RouteSegments &rhs);
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::unordered_map<std::string, Entry> next_entries_;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+};
+
+}  // namespace hdmap
+}  // namespace apollo
+
+#endif  // MODULES_MAP_PNC_MAP_PATH_CACHE_H_
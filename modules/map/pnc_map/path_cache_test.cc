@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/map/pnc_map/path_cache.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/map/hdmap/hdmap_common.h"
+
+namespace apollo {
+namespace hdmap {
+namespace {
+
+// The lane info refers to the lane, which has to outlive it.
+LaneInfoConstPtr MakeLane(const std::string &id, double x, Lane *lane_ptr) {
+  Lane &lane = *lane_ptr;
+  lane.mutable_id()->set_id(id);
+  auto *segment =
+      lane.mutable_central_curve()->add_segment()->mutable_line_segment();
+  for (int i = 0; i <= 10; ++i) {
+    auto *point = segment->add_point();
+    point->set_x(x + i);
+    point->set_y(0.0);
+  }
+  lane.set_length(10.0);
+  for (double s : {0.0, 10.0}) {
+    auto *left_sample = lane.add_left_sample();
+    left_sample->set_s(s);
+    left_sample->set_width(1.5);
+    auto *right_sample = lane.add_right_sample();
+    right_sample->set_s(s);
+    right_sample->set_width(1.5);
+  }
+  return LaneInfoConstPtr(new LaneInfo(lane));
+}
+
+}  // namespace
+
+class PathCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    lane1_ = MakeLane("1", 0.0, &lanes_[0]);
+    lane2_ = MakeLane("2", 10.0, &lanes_[1]);
+  }
+
+  RouteSegments MakeSegments(double start_s, double end_s) const {
+    RouteSegments segments;
+    segments.emplace_back(lane1_, start_s, 10.0);
+    segments.emplace_back(lane2_, 0.0, end_s);
+    return segments;
+  }
+
+  Lane lanes_[2];
+  LaneInfoConstPtr lane1_;
+  LaneInfoConstPtr lane2_;
+  PathCache cache_;
+};
+
+TEST_F(PathCacheTest, SharePath) {
+  auto path = cache_.GetPath(MakeSegments(1.0, 5.0));
+  ASSERT_TRUE(path != nullptr);
+  EXPECT_NEAR(14.0, path->length(), 1e-6);
+  EXPECT_EQ(2, path->lane_segments().size());
+  EXPECT_EQ(path, cache_.GetPath(MakeSegments(1.0, 5.0)));
+  EXPECT_EQ(1, cache_.hits());
+  EXPECT_EQ(1, cache_.misses());
+
+  auto other_path = cache_.GetPath(MakeSegments(2.0, 5.0));
+  ASSERT_TRUE(other_path != nullptr);
+  EXPECT_NE(path, other_path);
+  EXPECT_NEAR(13.0, other_path->length(), 1e-6);
+  EXPECT_EQ(2, cache_.Size());
+
+  // the same key, but not the same ranges
+  auto close_path = cache_.GetPath(MakeSegments(2.001, 5.0));
+  ASSERT_TRUE(close_path != nullptr);
+  EXPECT_NE(other_path, close_path);
+  EXPECT_NEAR(12.999, close_path->length(), 1e-6);
+  EXPECT_EQ(3, cache_.misses());
+
+  EXPECT_EQ(nullptr, cache_.GetPath(RouteSegments()));
+}
+
+TEST_F(PathCacheTest, NextCycle) {
+  auto path = cache_.GetPath(MakeSegments(1.0, 5.0));
+  cache_.GetPath(MakeSegments(2.0, 5.0));
+  cache_.NextCycle();
+  EXPECT_EQ(2, cache_.Size());
+
+  // only the path used in this cycle is kept in the next one
+  EXPECT_EQ(path, cache_.GetPath(MakeSegments(1.0, 5.0)));
+  cache_.NextCycle();
+  EXPECT_EQ(1, cache_.Size());
+  EXPECT_EQ(path, cache_.GetPath(MakeSegments(1.0, 5.0)));
+  EXPECT_EQ(2, cache_.hits());
+
+  // a path in use is still valid after it is dropped
+  cache_.Clear();
+  EXPECT_EQ(0, cache_.Size());
+  EXPECT_NEAR(14.0, path->length(), 1e-6);
+  EXPECT_NE(path, cache_.GetPath(MakeSegments(1.0, 5.0)));
+}
+
+}  // namespace hdmap
+}  // namespace apollo
@@ -17,11 +17,13 @@
 #include "modules/map/pnc_map/path.h"
 
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 #include "gflags/gflags.h"
 #include "gtest/gtest.h"
 
+#include "modules/common/configs/config_gflags.h"
 #include "modules/common/util/string_util.h"
 #include "modules/routing/proto/routing.pb.h"
 
@@ -715,6 +717,57 @@ TEST(TestSuite, hdmap_path_get_smooth_point) {
   EXPECT_NEAR(path.GetSFromIndex(index), segment_length * kNumSegments, 1e-6);
 }
 
+TEST(TestSuite, hdmap_path_segment_index) {
+  const int kNumSegments = 400;
+  std::vector<MapPathPoint> points;
+  for (int i = 0; i <= kNumSegments; ++i) {
+    const double x = 0.5 * i;
+    points.push_back(MakeMapPathPoint(x, 10.0 * sin(x / 15.0)));
+  }
+  FLAGS_use_path_segment_index = false;
+  const Path linear_path(points);
+  FLAGS_use_path_segment_index = true;
+  const Path indexed_path(points);
+  const Path copied_path = indexed_path;
+  FLAGS_use_path_segment_index = false;
+
+  double accumulate_s = 0.0;
+  double lateral = 0.0;
+  double distance = 0.0;
+  double other_accumulate_s = 0.0;
+  double other_lateral = 0.0;
+  double other_distance = 0.0;
+  for (int case_id = 0; case_id < 10000; ++case_id) {
+    const Vec2d point(RandomDouble(-20.0, 220.0), RandomDouble(-30.0, 30.0));
+    EXPECT_TRUE(linear_path.GetProjection(point, &accumulate_s, &lateral,
+                                          &distance));
+    EXPECT_TRUE(indexed_path.GetProjection(point, &other_accumulate_s,
+                                           &other_lateral, &other_distance));
+    EXPECT_DOUBLE_EQ(accumulate_s, other_accumulate_s);
+    EXPECT_DOUBLE_EQ(lateral, other_lateral);
+    EXPECT_DOUBLE_EQ(distance, other_distance);
+    EXPECT_TRUE(copied_path.GetProjection(point, &other_accumulate_s,
+                                          &other_lateral, &other_distance));
+    EXPECT_DOUBLE_EQ(accumulate_s, other_accumulate_s);
+  }
+
+  // Points close to the path, visited in order with the previous s as hint.
+  double warm_start_s = 0.0;
+  for (int case_id = 0; case_id < 1000; ++case_id) {
+    const double x = 0.2 * case_id;
+    const Vec2d point(x, 10.0 * sin(x / 15.0) + RandomDouble(-2.0, 2.0));
+    EXPECT_TRUE(linear_path.GetProjection(point, &accumulate_s, &lateral,
+                                          &distance));
+    EXPECT_TRUE(linear_path.GetProjectionWithWarmStartS(
+        point, warm_start_s, &other_accumulate_s, &other_lateral,
+        &other_distance));
+    EXPECT_NEAR(accumulate_s, other_accumulate_s, 1e-6);
+    EXPECT_NEAR(lateral, other_lateral, 1e-6);
+    EXPECT_NEAR(distance, other_distance, 1e-6);
+    warm_start_s = other_accumulate_s;
+  }
+}
+
 TEST(TestSuite, compute_lane_segments_from_points) {
   std::vector<MapPathPoint> points{
       MakeMapPathPoint(2, 0), MakeMapPathPoint(2, 1), MakeMapPathPoint(2, 2)};
@@ -815,5 +868,23 @@ TEST(TestSuite, lane_info) {
   EXPECT_NEAR(effective_width, 0.0, 1e-6);
 }
 
+TEST(TestSuite, hdmap_path_get_overlaps_starting_in) {
+  const std::vector<PathOverlap> overlaps{
+      {"a", 1.0, 3.0}, {"b", 2.0, 2.5}, {"c", 2.0, 4.0}, {"d", 5.0, 6.0}};
+  auto range = Path::GetOverlapsStartingIn(overlaps, 1.5, 5.0);
+  ASSERT_EQ(2, range.size());
+  EXPECT_EQ("b", range.begin()->object_id);
+  EXPECT_EQ("c", (range.begin() + 1)->object_id);
+
+  range = Path::GetOverlapsStartingIn(overlaps, 2.0,
+                                      std::numeric_limits<double>::infinity());
+  ASSERT_EQ(3, range.size());
+  EXPECT_EQ("d", (range.end() - 1)->object_id);
+
+  EXPECT_EQ(4, Path::GetOverlapsStartingIn(overlaps, 0.0, 10.0).size());
+  EXPECT_TRUE(Path::GetOverlapsStartingIn(overlaps, 5.5, 10.0).empty());
+  EXPECT_TRUE(Path::GetOverlapsStartingIn(overlaps, 3.0, 2.0).empty());
+}
+
 }  // namespace hdmap
 }  // namespace apollo
@@ -157,6 +157,7 @@ bool PncMap::UpdateVehicleState(const VehicleState &vehicle_state) {
     // position is reset, but not replan
     next_routing_waypoint_index_ = 0;
     route_index_.clear();
+    destination_search_index_.clear();
     stop_for_destination_ = false;
   }
 
@@ -177,10 +178,15 @@ bool PncMap::UpdateVehicleState(const VehicleState &vehicle_state) {
   UpdateNextRoutingWaypointIndex(route_index);
   route_index_ = route_index;
 
-  auto last_indices = GetWaypointIndex(routing_waypoint_index_.back().waypoint);
+  // the destination index searched from the route index only changes with it
+  if (destination_search_index_ != route_index_) {
+    destination_index_ =
+        GetWaypointIndex(routing_waypoint_index_.back().waypoint);
+    destination_search_index_ = route_index_;
+  }
   if (next_routing_waypoint_index_ == routing_waypoint_index_.size() - 1 ||
       (!stop_for_destination_ &&
-       last_indices == routing_waypoint_index_.back().index)) {
+       destination_index_ == routing_waypoint_index_.back().index)) {
     stop_for_destination_ = true;
   }
   return true;
@@ -251,7 +257,14 @@ bool PncMap::UpdateRoutingResponse(const routing::RoutingResponse &routing) {
   next_routing_waypoint_index_ = 0;
 
   routing_ = routing;
+  passage_segments_.clear();
+  for (const auto &road : routing_.road()) {
+    for (const auto &passage : road.passage()) {
+      PassageToSegments(passage, &passage_segments_[&passage]);
+    }
+  }
   route_index_.clear();
+  destination_search_index_.clear();
   adc_waypoint_ = LaneWaypoint();
   stop_for_destination_ = false;
   return true;
@@ -365,8 +378,31 @@ std::vector<int> PncMap::NextWaypointIndex(
   }
 }
 
+bool PncMap::IsWaypointOnIndex(const std::vector<int> &index,
+                               const LaneWaypoint &waypoint) const {
+  if (index.size() != 3 || index[0] < 0 || index[0] >= routing_.road_size()) {
+    return false;
+  }
+  const auto &road = routing_.road(index[0]);
+  if (index[1] < 0 || index[1] >= road.passage_size()) {
+    return false;
+  }
+  const auto &passage = road.passage(index[1]);
+  return index[2] >= 0 && index[2] < passage.segment_size() &&
+         RouteSegments::WithinLaneSegment(passage.segment(index[2]), waypoint);
+}
+
 std::vector<int> PncMap::GetWaypointIndex(const LaneWaypoint &waypoint) const {
   if (route_index_.size() == 3) {
+    // The waypoint is mostly on the current lane or the next one, where the
+    // forward search would stop before the backward one is needed.
+    if (IsWaypointOnIndex(route_index_, waypoint)) {
+      return route_index_;
+    }
+    const auto next_index = NextWaypointIndex(route_index_);
+    if (IsWaypointOnIndex(next_index, waypoint)) {
+      return next_index;
+    }
     // search forward
     std::vector<int> forward_index =
         SearchForwardWaypointIndex(route_index_, waypoint);
@@ -396,7 +432,7 @@ std::vector<int> PncMap::GetWaypointIndex(const LaneWaypoint &waypoint) const {
   return std::vector<int>();
 }
 
-bool PncMap::PassageToSegments(routing::Passage passage,
+bool PncMap::PassageToSegments(const routing::Passage &passage,
                                RouteSegments *segments) const {
   CHECK_NOTNULL(segments);
   segments->clear();
@@ -412,6 +448,16 @@ bool PncMap::PassageToSegments(routing::Passage passage,
   return !segments->empty();
 }
 
+bool PncMap::GetPassageSegments(const routing::Passage &passage,
+                                RouteSegments *segments) const {
+  auto iter = passage_segments_.find(&passage);
+  if (iter == passage_segments_.end()) {
+    return PassageToSegments(passage, segments);
+  }
+  *segments = iter->second;
+  return !segments->empty();
+}
+
 std::vector<int> PncMap::GetNeighborPassages(const routing::RoadSegment &road,
                                              int start_passage) const {
   CHECK_GE(start_passage, 0);
@@ -426,7 +472,7 @@ std::vector<int> PncMap::GetNeighborPassages(const routing::RoadSegment &road,
     return result;
   }
   RouteSegments source_segments;
-  if (!PassageToSegments(source_passage, &source_segments)) {
+  if (!GetPassageSegments(source_passage, &source_segments)) {
     AERROR << "failed to convert passage to segments";
     return result;
   }
@@ -491,7 +537,7 @@ bool PncMap::GetRouteSegments(const VehicleState &vehicle_state,
   for (const int index : drive_passages) {
     const auto &passage = road.passage(index);
     RouteSegments segments;
-    if (!PassageToSegments(passage, &segments)) {
+    if (!GetPassageSegments(passage, &segments)) {
       ADEBUG << "Failed to convert passage to lane segments.";
       continue;
     }
@@ -25,6 +25,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -92,9 +93,19 @@ class PncMap {
   bool GetNearestPointFromRouting(const common::VehicleState &point,
                                   LaneWaypoint *waypoint) const;
 
-  bool PassageToSegments(routing::Passage passage,
+  bool PassageToSegments(const routing::Passage &passage,
                          RouteSegments *segments) const;
 
+  /**
+   * @brief Gets the segments of a passage, which are converted once per
+   * routing for the passages of routing_.
+   */
+  bool GetPassageSegments(const routing::Passage &passage,
+                          RouteSegments *segments) const;
+
+  bool IsWaypointOnIndex(const std::vector<int> &index,
+                         const LaneWaypoint &waypoint) const;
+
   bool ProjectToSegments(const common::PointENU &point_enu,
                          const RouteSegments &segments,
                          LaneWaypoint *waypoint) const;
@@ -181,6 +192,17 @@ class PncMap {
    * A three element index: {road_index, passage_index, lane_index}
    */
   std::vector<int> route_index_;
+  /**
+   * The index of the destination searched from destination_search_index_,
+   * which is the route index it was searched from.
+   */
+  std::vector<int> destination_index_;
+  std::vector<int> destination_search_index_;
+  /**
+   * The segments of the passages of routing_, keyed by passage.
+   */
+  std::unordered_map<const routing::Passage *, RouteSegments>
+      passage_segments_;
   /**
    * The waypoint of the autonomous driving car
    */
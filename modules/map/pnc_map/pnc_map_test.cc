@@ -106,6 +106,35 @@ TEST_F(PncMapTest, UpdateWaypointIndex) {
   EXPECT_EQ(0, result[2]);
 }
 
+TEST_F(PncMapTest, GetWaypointIndex_FromRouteIndex) {
+  const auto route_index = pnc_map_->route_index_;
+  pnc_map_->route_index_ = {0, 0, 0};
+  const auto& passage = pnc_map_->routing_.road(0).passage(0);
+  for (int i = 0; i < passage.segment_size(); ++i) {
+    auto lane = hdmap_.GetLaneById(hdmap::MakeMapId(passage.segment(i).id()));
+    ASSERT_TRUE(lane);
+    LaneWaypoint waypoint(lane, passage.segment(i).start_s());
+    EXPECT_EQ(pnc_map_->SearchForwardWaypointIndex({0, 0, 0}, waypoint),
+              pnc_map_->GetWaypointIndex(waypoint));
+  }
+  pnc_map_->route_index_ = route_index;
+}
+
+TEST_F(PncMapTest, GetPassageSegments) {
+  const auto& passage = pnc_map_->routing_.road(0).passage(0);
+  EXPECT_EQ(1, pnc_map_->passage_segments_.count(&passage));
+  RouteSegments cached;
+  ASSERT_TRUE(pnc_map_->GetPassageSegments(passage, &cached));
+  RouteSegments converted;
+  ASSERT_TRUE(pnc_map_->PassageToSegments(passage, &converted));
+  ASSERT_EQ(converted.size(), cached.size());
+  for (size_t i = 0; i < converted.size(); ++i) {
+    EXPECT_EQ(converted[i].lane, cached[i].lane);
+    EXPECT_DOUBLE_EQ(converted[i].start_s, cached[i].start_s);
+    EXPECT_DOUBLE_EQ(converted[i].end_s, cached[i].end_s);
+  }
+}
+
 TEST_F(PncMapTest, GetRouteSegments_NoChangeLane) {
   auto lane = hdmap_.GetLaneById(hdmap::MakeMapId("9_1_-2"));
   ASSERT_TRUE(lane);
@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+// Times the spatial queries of the base map at random points near its
+// lanes, e.g.
+// bazel run //modules/map/tools:map_query_benchmark --
+//     --map_dir=modules/map/data/sunnyvale_loop
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/proto/geometry.pb.h"
+#include "modules/common/util/file.h"
+#include "modules/map/hdmap/hdmap_impl.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/map/proto/map.pb.h"
+
+DEFINE_int32(benchmark_num_queries, 100000, "The number of query points.");
+DEFINE_double(benchmark_point_offset, 5.0,
+              "The query points are up to this far from the lane points.");
+DEFINE_double(benchmark_radius, 10.0, "The radius of the range queries.");
+
+namespace {
+
+using apollo::common::PointENU;
+using apollo::hdmap::HDMapImpl;
+using apollo::hdmap::LaneInfoConstPtr;
+
+template <typename Query>
+void TimeQuery(const std::string& name, const std::vector<PointENU>& points,
+               const Query& query) {
+  int num_results = 0;
+  const auto start_time = std::chrono::steady_clock::now();
+  for (const auto& point : points) {
+    num_results += query(point);
+  }
+  const auto end_time = std::chrono::steady_clock::now();
+  const double time_us =
+      std::chrono::duration<double, std::micro>(end_time - start_time)
+          .count();
+  std::printf("%-28s %10.3f us/query %12d results\n", name.c_str(),
+              time_us / points.size(), num_results);
+}
+
+}  // namespace
+
+int main(int32_t argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_alsologtostderr = true;
+
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  const auto map_file = apollo::hdmap::BaseMapFile();
+  apollo::hdmap::Map map_pb;
+  CHECK(apollo::common::util::GetProtoFromFile(map_file, &map_pb))
+      << "Fail to open:" << map_file;
+  HDMapImpl hdmap;
+  CHECK_EQ(0, hdmap.LoadMapFromFile(map_file)) << "Fail to load:" << map_file;
+
+  std::vector<PointENU> lane_points;
+  for (const auto& lane : map_pb.lane()) {
+    for (const auto& segment : lane.central_curve().segment()) {
+      for (const auto& point : segment.line_segment().point()) {
+        lane_points.push_back(point);
+      }
+    }
+  }
+  CHECK(!lane_points.empty()) << "No lane in:" << map_file;
+
+  // A fixed seed makes the runs comparable.
+  std::mt19937 random_engine(0);
+  std::uniform_int_distribution<size_t> index_distribution(
+      0, lane_points.size() - 1);
+  std::uniform_real_distribution<double> offset_distribution(
+      -FLAGS_benchmark_point_offset, FLAGS_benchmark_point_offset);
+  std::vector<PointENU> points(FLAGS_benchmark_num_queries);
+  for (auto& point : points) {
+    point = lane_points[index_distribution(random_engine)];
+    point.set_x(point.x() + offset_distribution(random_engine));
+    point.set_y(point.y() + offset_distribution(random_engine));
+  }
+
+  TimeQuery("GetNearestLane", points, [&hdmap](const PointENU& point) {
+    LaneInfoConstPtr lane;
+    double s = 0.0;
+    double l = 0.0;
+    return hdmap.GetNearestLane(point, &lane, &s, &l) == 0 ? 1 : 0;
+  });
+  TimeQuery("GetLanes", points, [&hdmap](const PointENU& point) {
+    std::vector<LaneInfoConstPtr> lanes;
+    hdmap.GetLanes(point, FLAGS_benchmark_radius, &lanes);
+    return static_cast<int>(lanes.size());
+  });
+  TimeQuery("GetNearestLaneWithHeading", points,
+            [&hdmap](const PointENU& point) {
+              LaneInfoConstPtr lane;
+              double s = 0.0;
+              double l = 0.0;
+              return hdmap.GetNearestLaneWithHeading(
+                         point, FLAGS_benchmark_radius, 0.0, M_PI / 2.0,
+                         &lane, &s, &l) == 0
+                         ? 1
+                         : 0;
+            });
+  TimeQuery("GetMapElements", points, [&hdmap](const PointENU& point) {
+    apollo::hdmap::MapElements elements;
+    hdmap.GetMapElements(point, FLAGS_benchmark_radius,
+                         apollo::hdmap::MAP_ELEMENT_ALL, &elements);
+    return static_cast<int>(elements.lanes.size());
+  });
+  return 0;
+}
@@ -0,0 +1,51 @@
+/******************************************************************************
+  * Copyright 2017 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+// Splits the base map into tiles for the tiled map mode. Point
+// --base_map_filename to <output_dir>/tile_index.bin to use them.
+
+#include <string>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/map/hdmap/map_tiler.h"
+#include "modules/map/proto/map.pb.h"
+
+DEFINE_double(tile_length, 500.0, "The side length of the tiles in meters.");
+DEFINE_double(tile_margin, 50.0,
+              "Every object within this distance of a tile is part of it, "
+              "so that queries within this radius use a single tile.");
+DEFINE_string(output_dir, "/tmp/map_tiles", "output tile directory");
+
+int main(int32_t argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  FLAGS_alsologtostderr = true;
+
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  apollo::hdmap::Map map_pb;
+  const auto map_file = apollo::hdmap::BaseMapFile();
+  CHECK(apollo::common::util::GetProtoFromFile(map_file, &map_pb))
+      << "Fail to open:" << map_file;
+  CHECK(apollo::hdmap::WriteMapTiles(map_pb, FLAGS_tile_length,
+                                     FLAGS_tile_margin, FLAGS_output_dir))
+      << "Fail to write tiles to:" << FLAGS_output_dir;
+  return 0;
+}
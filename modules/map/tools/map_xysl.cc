@@ -17,6 +17,8 @@
 #include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include "gflags/gflags.h"
 
 #include "modules/common/configs/config_gflags.h"
@@ -44,6 +46,10 @@ DEFINE_string(from_lane, "", "from_lane");
 DEFINE_string(to_lane, "", "to_lane");
 DEFINE_double(s, 0.0, "s");
 DEFINE_double(l, 0.0, "l");
+DEFINE_string(batch, "",
+              "file of queries to answer in order, one per line, or - to read "
+              "them from stdin and answer each as soon as it is read; see the "
+              "usage for the queries");
 
 using apollo::common::PointENU;
 using apollo::hdmap::LaneBoundary;
@@ -144,22 +150,23 @@ std::ostream &operator<<(
 }
 
 void PrintLane(const apollo::hdmap::MapUtil &map_util,
-               LaneInfoConstPtr lane_ptr) {
+               LaneInfoConstPtr lane_ptr, const double s) {
   const auto &lane = lane_ptr->lane();
+  const std::string &lane_id = lane.id().id();
   PointENU start_point;
   double start_heading = 0.0;
-  map_util.sl_to_point(FLAGS_lane, 0, 0, &start_point, &start_heading);
+  map_util.sl_to_point(lane_id, 0, 0, &start_point, &start_heading);
 
   PointENU end_point;
   double end_heading = 0.0;
-  map_util.sl_to_point(FLAGS_lane, lane_ptr->total_length(), 0, &end_point,
+  map_util.sl_to_point(lane_id, lane_ptr->total_length(), 0, &end_point,
                        &end_heading);
 
   double left_width = 0.0;
   double right_width = 0.0;
-  lane_ptr->GetWidth(FLAGS_s, &left_width, &right_width);
+  lane_ptr->GetWidth(s, &left_width, &right_width);
 
-  std::cout << "lane[" << FLAGS_lane << std::fixed << "] length["
+  std::cout << "lane[" << lane_id << std::fixed << "] length["
             << lane_ptr->total_length() << "] type["
             << Lane_LaneType_Name(lane.type()) << "] turn["
             << Lane_LaneTurn_Name(lane.turn()) << "] speed_limit["
@@ -221,63 +228,173 @@ void PrintLane(const apollo::hdmap::MapUtil &map_util,
   }
 }
 
+void XyToSl(const apollo::hdmap::MapUtil &map_util, const double x,
+            const double y) {
+  PointENU point;
+  point.set_x(x);
+  point.set_y(y);
+  point.set_z(0);
+  std::string lane_id;
+  double s = 0.0;
+  double l = 0.0;
+  double heading = 0.0;
+  map_util.point_to_sl(point, &lane_id, &s, &l, &heading);
+  printf("lane_id[%s], s[%f], l[%f], heading[%f]\n", lane_id.c_str(), s, l,
+         heading);
+}
+
+void SlToXy(const apollo::hdmap::MapUtil &map_util, const std::string &lane,
+            const double s, const double l) {
+  PointENU point;
+  double heading = 0.0;
+  map_util.sl_to_point(lane, s, l, &point, &heading);
+  printf("x[%f] y[%f], heading[%f]\n", point.x(), point.y(), heading);
+}
+
+bool XyToLane(const apollo::hdmap::MapUtil &map_util, const double x,
+              const double y, const std::string &lane) {
+  double s = 0.0;
+  double l = 0.0;
+  double heading = 0.0;
+  int ret = map_util.lane_projection({x, y}, lane, &s, &l, &heading);
+  if (ret != 0) {
+    printf("lane_projection for x[%f], y[%f], lane_id[%s] failed\n", x, y,
+           lane.c_str());
+    return false;
+  }
+  printf("lane[%s] s[%f], l[%f], heading[%f]\n", lane.c_str(), s, l, heading);
+  return true;
+}
+
+bool LaneToLane(const apollo::hdmap::MapUtil &map_util,
+                const std::string &from_lane, const double s,
+                const std::string &to_lane) {
+  PointENU point;
+  double src_heading = 0.0;
+  map_util.sl_to_point(from_lane, s, 0.0, &point, &src_heading);
+  double target_s = 0.0;
+  double target_l = 0.0;
+  double target_heading = 0.0;
+  int ret = map_util.lane_projection({point.x(), point.y()}, to_lane,
+                                     &target_s, &target_l, &target_heading);
+  if (ret != 0) {
+    printf("lane_projection for lane[%s], s[%f] to lane_id[%s] failed\n",
+           from_lane.c_str(), s, to_lane.c_str());
+    return false;
+  }
+  printf("lane[%s] s[%f], l[%f], heading[%f]\n", to_lane.c_str(), target_s,
+         target_l, target_heading);
+  return true;
+}
+
+void PrintOverlap(const apollo::hdmap::MapUtil &map_util,
+                  const std::string &overlap_id) {
+  const auto *overlap_ptr = map_util.get_overlap(overlap_id);
+  if (overlap_ptr != nullptr) {
+    std::cout << "overlap[" << overlap_ptr->id().id() << "] info["
+              << overlap_ptr->overlap().DebugString() << "]" << std::endl;
+  }
+}
+
+void PrintSignal(const apollo::hdmap::MapUtil &map_util,
+                 const std::string &signal_id) {
+  const auto *signal_ptr = map_util.get_signal(signal_id);
+  if (signal_ptr) {
+    std::cout << "signal[" << signal_id << "] info["
+              << signal_ptr->signal().DebugString() << "]" << std::endl;
+  }
+}
+
+// Answers a query of the batch, written as the name of the flag of the
+// query followed by its arguments in the order of the usage, e.g.
+// "xy_to_sl 587000.0 4141000.0" or "lane_to_lane lane_1 10.0 lane_2".
+void AnswerQuery(const apollo::hdmap::MapUtil &map_util,
+                 const std::string &query) {
+  std::istringstream query_stream(query);
+  std::string type;
+  query_stream >> type;
+  double x = 0.0;
+  double y = 0.0;
+  double s = 0.0;
+  double l = 0.0;
+  std::string id;
+  std::string to_id;
+  if (type == "xy_to_sl" && query_stream >> x >> y) {
+    XyToSl(map_util, x, y);
+  } else if (type == "sl_to_xy" && query_stream >> id >> s >> l) {
+    SlToXy(map_util, id, s, l);
+  } else if (type == "xy_to_lane" && query_stream >> x >> y >> id) {
+    XyToLane(map_util, x, y, id);
+  } else if (type == "lane_to_lane" && query_stream >> id >> s >> to_id) {
+    LaneToLane(map_util, id, s, to_id);
+  } else if (type == "lane" && query_stream >> id) {
+    query_stream >> s;
+    const auto lane_ptr = map_util.get_lane(id);
+    if (!lane_ptr) {
+      std::cout << "Could not find lane " << id << std::endl;
+    } else {
+      PrintLane(map_util, lane_ptr, s);
+    }
+  } else if (type == "overlap" && query_stream >> id) {
+    PrintOverlap(map_util, id);
+  } else if (type == "signal_info" && query_stream >> id) {
+    PrintSignal(map_util, id);
+  } else {
+    printf("invalid query[%s]\n", query.c_str());
+  }
+}
+
+// Answers the queries of a stream in order. The map is loaded once for all of
+// them, and every answer is flushed, so that a script can keep the tool
+// running on a pipe and query it as a server.
+void AnswerQueries(const apollo::hdmap::MapUtil &map_util,
+                   std::istream *queries) {
+  std::string query;
+  while (std::getline(*queries, query)) {
+    const size_t begin = query.find_first_not_of(" \t\r");
+    if (begin == std::string::npos || query[begin] == '#') {
+      continue;
+    }
+    AnswerQuery(map_util, query.substr(begin));
+    std::cout.flush();
+    fflush(stdout);
+  }
+}
+
 int main(int argc, char *argv[]) {
   google::InitGoogleLogging(argv[0]);
   google::ParseCommandLineFlags(&argc, &argv, true);
   const std::string map_file = apollo::hdmap::BaseMapFile();
   apollo::hdmap::MapUtil map_util;
 
+  if (!FLAGS_batch.empty()) {
+    if (FLAGS_batch == "-") {
+      AnswerQueries(map_util, &std::cin);
+      return 0;
+    }
+    std::ifstream queries(FLAGS_batch);
+    if (!queries) {
+      std::cout << "Could not open the queries " << FLAGS_batch << std::endl;
+      return -1;
+    }
+    AnswerQueries(map_util, &queries);
+    return 0;
+  }
   if (FLAGS_xy_to_sl) {
-    double x = FLAGS_x;
-    double y = FLAGS_y;
-    PointENU point;
-    point.set_x(x);
-    point.set_y(y);
-    point.set_z(0);
-    std::string lane_id;
-    double s = 0.0;
-    double l = 0.0;
-    double heading = 0.0;
-    map_util.point_to_sl(point, &lane_id, &s, &l, &heading);
-    printf("lane_id[%s], s[%f], l[%f], heading[%f]\n", lane_id.c_str(), s, l,
-           heading);
+    XyToSl(map_util, FLAGS_x, FLAGS_y);
   }
   if (FLAGS_sl_to_xy) {
-    PointENU point;
-    double heading = 0.0;
-    map_util.sl_to_point(FLAGS_lane, FLAGS_s, FLAGS_l, &point, &heading);
-    printf("x[%f] y[%f], heading[%f]\n", point.x(), point.y(), heading);
+    SlToXy(map_util, FLAGS_lane, FLAGS_s, FLAGS_l);
   }
   if (FLAGS_xy_to_lane) {
-    double s = 0.0;
-    double l = 0.0;
-    double heading = 0.0;
-    int ret = map_util.lane_projection({FLAGS_x, FLAGS_y}, FLAGS_lane, &s, &l,
-                                       &heading);
-    if (ret != 0) {
-      printf("lane_projection for x[%f], y[%f], lane_id[%s] failed\n", FLAGS_x,
-             FLAGS_y, FLAGS_lane.c_str());
+    if (!XyToLane(map_util, FLAGS_x, FLAGS_y, FLAGS_lane)) {
       return -1;
     }
-    printf("lane[%s] s[%f], l[%f], heading[%f]\n", FLAGS_lane.c_str(), s, l,
-           heading);
   }
   if (FLAGS_lane_to_lane) {
-    PointENU point;
-    double src_heading = 0.0;
-    map_util.sl_to_point(FLAGS_from_lane, FLAGS_s, 0.0, &point, &src_heading);
-    double target_s = 0.0;
-    double target_l = 0.0;
-    double target_heading = 0.0;
-    int ret = map_util.lane_projection({point.x(), point.y()}, FLAGS_to_lane,
-                                       &target_s, &target_l, &target_heading);
-    if (ret != 0) {
-      printf("lane_projection for lane[%s], s[%f] to lane_id[%s] failed\n",
-             FLAGS_from_lane.c_str(), FLAGS_s, FLAGS_to_lane.c_str());
+    if (!LaneToLane(map_util, FLAGS_from_lane, FLAGS_s, FLAGS_to_lane)) {
       return -1;
     }
-    printf("lane[%s] s[%f], l[%f], heading[%f]\n", FLAGS_to_lane.c_str(),
-           target_s, target_l, target_heading);
   }
   if (!FLAGS_lane.empty()) {
     const auto lane_ptr = map_util.get_lane(FLAGS_lane);
@@ -286,21 +403,13 @@ int main(int argc, char *argv[]) {
                 << map_file;
       return 0;
     }
-    PrintLane(map_util, lane_ptr);
+    PrintLane(map_util, lane_ptr, FLAGS_s);
   }
   if (!FLAGS_overlap.empty()) {
-    const auto *overlap_ptr = map_util.get_overlap(FLAGS_overlap);
-    if (overlap_ptr != nullptr) {
-      std::cout << "overlap[" << overlap_ptr->id().id() << "] info["
-                << overlap_ptr->overlap().DebugString() << "]" << std::endl;
-    }
+    PrintOverlap(map_util, FLAGS_overlap);
   }
   if (!FLAGS_signal_info.empty()) {
-    const auto *signal_ptr = map_util.get_signal(FLAGS_signal_info);
-    if (signal_ptr) {
-      std::cout << "signal[" << FLAGS_signal_info << "] info["
-                << signal_ptr->signal().DebugString() << "]" << std::endl;
-    }
+    PrintSignal(map_util, FLAGS_signal_info);
   }
   if (!FLAGS_dump_txt_map.empty()) {
     apollo::hdmap::Map map;
@@ -327,6 +436,12 @@ int main(int argc, char *argv[]) {
     std::cout << "usage: --lane lane_id" << std::endl;
     std::cout << "usage: --signal_info signal_id" << std::endl;
     std::cout << "usage: --overlap overlap_id" << std::endl;
+    std::cout << "usage: --batch queries_file, or - for stdin, with a query "
+                 "per line, e.g. 'xy_to_sl x y', 'sl_to_xy lane_id s l', "
+                 "'xy_to_lane x y lane_id', 'lane_to_lane lane_id s lane_id', "
+                 "'lane lane_id [s]', 'signal_info signal_id' or "
+                 "'overlap overlap_id'"
+              << std::endl;
   }
   return 0;
 }
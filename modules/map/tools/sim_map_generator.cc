@@ -22,6 +22,7 @@
 #include "modules/common/configs/config_gflags.h"
 #include "modules/common/log.h"
 #include "modules/common/util/file.h"
+#include "modules/common/util/parallel_for.h"
 #include "modules/common/util/points_downsampler.h"
 #include "modules/map/hdmap/adapter/opendrive_adapter.h"
 #include "modules/map/hdmap/hdmap_util.h"
@@ -39,10 +40,14 @@ DEFINE_double(angle_threshold, 1 / 180 * M_PI, /* 1 degree */
 DEFINE_int32(downsample_distance, 5, "downsample rate for a normal path");
 DEFINE_int32(steep_turn_downsample_distance, 1,
              "downsample rate for a steep turn path");
+DEFINE_int32(downsample_threads, 0,
+             "the number of threads downsampling the lanes, 0 for the number "
+             "of hardware threads");
 
 using apollo::common::util::DownsampleByAngle;
 using apollo::common::util::DownsampleByDistance;
 using apollo::common::util::GetProtoFromFile;
+using apollo::common::util::ParallelFor;
 using apollo::common::PointENU;
 using apollo::hdmap::adapter::OpendriveAdapter;
 using apollo::hdmap::Curve;
@@ -79,14 +84,18 @@ void DownsampleCurve(Curve* curve) {
 }
 
 void DownsampleMap(Map* map_pb) {
-  for (int i = 0; i < map_pb->lane_size(); ++i) {
-    auto* lane = map_pb->mutable_lane(i);
-    AINFO << "Downsampling lane " << lane->id().id();
-
-    DownsampleCurve(lane->mutable_central_curve());
-    DownsampleCurve(lane->mutable_left_boundary()->mutable_curve());
-    DownsampleCurve(lane->mutable_right_boundary()->mutable_curve());
-  }
+  // The lanes are downsampled independently, each in place.
+  ParallelFor(map_pb->lane_size(), FLAGS_downsample_threads,
+              [map_pb](const int i) {
+                auto* lane = map_pb->mutable_lane(i);
+                AINFO << "Downsampling lane " << lane->id().id();
+
+                DownsampleCurve(lane->mutable_central_curve());
+                DownsampleCurve(
+                    lane->mutable_left_boundary()->mutable_curve());
+                DownsampleCurve(
+                    lane->mutable_right_boundary()->mutable_curve());
+              });
 }
 
 void OutputMap(const Map& map_pb) {
@@ -22,6 +22,7 @@
 #include "modules/monitor/reporters/static_info_reporter.h"
 #include "modules/monitor/reporters/vehicle_state_reporter.h"
 #include "modules/monitor/software/process_monitor.h"
+#include "modules/monitor/software/resource_monitor.h"
 #include "modules/monitor/software/summary_monitor.h"
 #include "modules/monitor/software/topic_monitor.h"
 
@@ -51,6 +52,11 @@ Status Monitor::Init() {
   monitor_thread_.RegisterRunner(make_unique<CanMonitor>());
   monitor_thread_.RegisterRunner(make_unique<GpsMonitor>());
   monitor_thread_.RegisterRunner(make_unique<ProcessMonitor>());
+  // Register ResourceMonitor after ProcessMonitor, which finds the processes
+  // of the modules.
+  if (AdapterManager::GetResourceStatus()) {
+    monitor_thread_.RegisterRunner(make_unique<ResourceMonitor>());
+  }
 
   const auto &config = MonitorManager::GetConfig();
   for (const auto &module : config.modules()) {
@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/software/proc_parser.h"
+
+#include <sstream>
+#include <vector>
+
+namespace apollo {
+namespace monitor {
+namespace {
+
+constexpr uint64_t kSectorBytes = 512;
+constexpr uint64_t kMebibyte = 1024 * 1024;
+
+std::vector<std::string> SplitFields(const std::string &line) {
+  std::istringstream stream(line);
+  std::vector<std::string> fields;
+  std::string field;
+  while (stream >> field) {
+    fields.push_back(field);
+  }
+  return fields;
+}
+
+std::string Trim(const std::string &str) {
+  const auto begin = str.find_first_not_of(" \t");
+  if (begin == std::string::npos) {
+    return "";
+  }
+  const auto end = str.find_last_not_of(" \t\r");
+  return str.substr(begin, end - begin + 1);
+}
+
+template <typename T>
+bool ToNumber(const std::string &str, T *value) {
+  std::istringstream stream(str);
+  return static_cast<bool>(stream >> *value);
+}
+
+}  // namespace
+
+bool ParseProcStat(const std::string &content, ProcStat *stat) {
+  // The command name is in parentheses, and may contain spaces and
+  // parentheses itself.
+  const auto comm_begin = content.find('(');
+  const auto comm_end = content.rfind(')');
+  if (comm_begin == std::string::npos || comm_end == std::string::npos ||
+      comm_end < comm_begin) {
+    return false;
+  }
+  stat->comm = content.substr(comm_begin + 1, comm_end - comm_begin - 1);
+  // Fields from the third one, the state, on.
+  const auto fields = SplitFields(content.substr(comm_end + 1));
+  if (fields.size() < 22) {
+    return false;
+  }
+  return ToNumber(fields[7], &stat->minor_faults) &&
+         ToNumber(fields[9], &stat->major_faults) &&
+         ToNumber(fields[11], &stat->utime) &&
+         ToNumber(fields[12], &stat->stime) && ToNumber(fields[21], &stat->rss);
+}
+
+bool ParseContextSwitches(const std::string &content, uint64_t *voluntary,
+                          uint64_t *involuntary) {
+  bool has_voluntary = false;
+  bool has_involuntary = false;
+  std::istringstream stream(content);
+  std::string line;
+  while (std::getline(stream, line)) {
+    const auto fields = SplitFields(line);
+    if (fields.size() != 2) {
+      continue;
+    }
+    if (fields[0] == "voluntary_ctxt_switches:") {
+      has_voluntary = ToNumber(fields[1], voluntary);
+    } else if (fields[0] == "nonvoluntary_ctxt_switches:") {
+      has_involuntary = ToNumber(fields[1], involuntary);
+    }
+  }
+  return has_voluntary && has_involuntary;
+}
+
+std::map<std::string, IoCounters> ParseDiskStats(const std::string &content) {
+  std::map<std::string, IoCounters> disks;
+  std::istringstream stream(content);
+  std::string line;
+  while (std::getline(stream, line)) {
+    // major minor name reads merged sectors_read ms writes merged
+    // sectors_written ...
+    const auto fields = SplitFields(line);
+    uint64_t sectors_read = 0;
+    uint64_t sectors_written = 0;
+    if (fields.size() < 10 || !ToNumber(fields[5], &sectors_read) ||
+        !ToNumber(fields[9], &sectors_written)) {
+      continue;
+    }
+    IoCounters &disk = disks[fields[2]];
+    disk.read_bytes = sectors_read * kSectorBytes;
+    disk.write_bytes = sectors_written * kSectorBytes;
+  }
+  return disks;
+}
+
+std::map<std::string, IoCounters> ParseNetDev(const std::string &content) {
+  std::map<std::string, IoCounters> interfaces;
+  std::istringstream stream(content);
+  std::string line;
+  while (std::getline(stream, line)) {
+    // The two header lines have no colon.
+    const auto colon = line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    // Receive bytes packets errs drop fifo frame compressed multicast, then
+    // transmit bytes ...
+    const auto fields = SplitFields(line.substr(colon + 1));
+    IoCounters counters;
+    if (fields.size() < 9 || !ToNumber(fields[0], &counters.read_bytes) ||
+        !ToNumber(fields[8], &counters.write_bytes)) {
+      continue;
+    }
+    interfaces[Trim(line.substr(0, colon))] = counters;
+  }
+  return interfaces;
+}
+
+bool ParseGpuQuery(const std::string &content,
+                   google::protobuf::RepeatedPtrField<GpuResource> *gpus) {
+  std::istringstream stream(content);
+  std::string line;
+  while (std::getline(stream, line)) {
+    if (Trim(line).empty()) {
+      continue;
+    }
+    std::vector<std::string> fields;
+    std::istringstream line_stream(line);
+    std::string field;
+    while (std::getline(line_stream, field, ',')) {
+      fields.push_back(Trim(field));
+    }
+    int index = 0;
+    double utilization = 0.0;
+    uint64_t memory_used = 0;
+    uint64_t memory_total = 0;
+    if (fields.size() != 5 || !ToNumber(fields[0], &index) ||
+        !ToNumber(fields[2], &utilization) ||
+        !ToNumber(fields[3], &memory_used) ||
+        !ToNumber(fields[4], &memory_total)) {
+      return false;
+    }
+    auto *gpu = gpus->Add();
+    gpu->set_index(index);
+    gpu->set_name(fields[1]);
+    gpu->set_utilization(utilization);
+    // In MiB.
+    gpu->set_memory_used_bytes(memory_used * kMebibyte);
+    gpu->set_memory_total_bytes(memory_total * kMebibyte);
+  }
+  return true;
+}
+
+}  // namespace monitor
+}  // namespace apollo
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_MONITOR_SOFTWARE_PROC_PARSER_H_
+#define MODULES_MONITOR_SOFTWARE_PROC_PARSER_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "google/protobuf/repeated_field.h"
+
+#include "modules/monitor/proto/resource_status.pb.h"
+
+/**
+ * @namespace apollo::monitor
+ * @brief apollo::monitor
+ */
+namespace apollo {
+namespace monitor {
+
+// The fields of /proc/<pid>/stat, or /proc/<pid>/task/<tid>/stat, used by
+// the resource monitor. Times are in clock ticks.
+struct ProcStat {
+  std::string comm;
+  uint64_t minor_faults = 0;
+  uint64_t major_faults = 0;
+  uint64_t utime = 0;
+  uint64_t stime = 0;
+  // In pages.
+  int64_t rss = 0;
+};
+
+// Transferred bytes of a disk or of a network interface.
+struct IoCounters {
+  uint64_t read_bytes = 0;
+  uint64_t write_bytes = 0;
+};
+
+bool ParseProcStat(const std::string &content, ProcStat *stat);
+
+// Parses the context switch counts of /proc/<pid>/task/<tid>/status.
+bool ParseContextSwitches(const std::string &content, uint64_t *voluntary,
+                          uint64_t *involuntary);
+
+// Parses /proc/diskstats into the counters keyed by device name.
+std::map<std::string, IoCounters> ParseDiskStats(const std::string &content);
+
+// Parses /proc/net/dev into the counters keyed by interface, the received
+// bytes as read_bytes and the transmitted ones as write_bytes.
+std::map<std::string, IoCounters> ParseNetDev(const std::string &content);
+
+// Parses the output of
+//   nvidia-smi --query-gpu=index,name,utilization.gpu,memory.used,
+//       memory.total --format=csv,noheader,nounits
+bool ParseGpuQuery(const std::string &content,
+                   google::protobuf::RepeatedPtrField<GpuResource> *gpus);
+
+}  // namespace monitor
+}  // namespace apollo
+
+#endif  // MODULES_MONITOR_SOFTWARE_PROC_PARSER_H_
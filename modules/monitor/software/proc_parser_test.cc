@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/software/proc_parser.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace monitor {
+
+TEST(ProcParserTest, ProcStat) {
+  ProcStat stat;
+  EXPECT_TRUE(ParseProcStat(
+      "1234 (my (pro) cess) S 1 1234 1234 0 -1 4194560 3000 0 7 0 250 40 0 "
+      "0 20 0 12 0 100 123456789 5120 18446744073709551615",
+      &stat));
+  EXPECT_EQ("my (pro) cess", stat.comm);
+  EXPECT_EQ(3000u, stat.minor_faults);
+  EXPECT_EQ(7u, stat.major_faults);
+  EXPECT_EQ(250u, stat.utime);
+  EXPECT_EQ(40u, stat.stime);
+  EXPECT_EQ(5120, stat.rss);
+
+  EXPECT_FALSE(ParseProcStat("1234 (truncated) S 1 1234", &stat));
+  EXPECT_FALSE(ParseProcStat("", &stat));
+}
+
+TEST(ProcParserTest, ContextSwitches) {
+  uint64_t voluntary = 0;
+  uint64_t involuntary = 0;
+  EXPECT_TRUE(ParseContextSwitches(
+      "Name:\tplanning\nThreads:\t12\nvoluntary_ctxt_switches:\t150\n"
+      "nonvoluntary_ctxt_switches:\t25\n",
+      &voluntary, &involuntary));
+  EXPECT_EQ(150u, voluntary);
+  EXPECT_EQ(25u, involuntary);
+  EXPECT_FALSE(ParseContextSwitches("Name:\tplanning\n", &voluntary,
+                                    &involuntary));
+}
+
+TEST(ProcParserTest, DiskStats) {
+  const auto disks = ParseDiskStats(
+      "   8       0 sda 100 0 2000 30 50 0 4000 60 0 80 90\n"
+      "   8       1 sda1 90 0 1000 25 40 0 3000 50 0 70 75\n");
+  ASSERT_EQ(2u, disks.size());
+  EXPECT_EQ(2000u * 512, disks.at("sda").read_bytes);
+  EXPECT_EQ(4000u * 512, disks.at("sda").write_bytes);
+  EXPECT_EQ(1000u * 512, disks.at("sda1").read_bytes);
+}
+
+TEST(ProcParserTest, NetDev) {
+  const auto interfaces = ParseNetDev(
+      "Inter-|   Receive                            |  Transmit\n"
+      " face |bytes    packets errs drop fifo frame compressed multicast|"
+      "bytes    packets errs drop fifo colls carrier compressed\n"
+      "    lo:    1000      10    0    0    0     0          0         0 "
+      "    1000      10    0    0    0     0       0          0\n"
+      "  eth0:12345678  9000    0    0    0     0          0         0 "
+      "  87654321   8000    0    0    0     0       0          0\n");
+  ASSERT_EQ(2u, interfaces.size());
+  EXPECT_EQ(12345678u, interfaces.at("eth0").read_bytes);
+  EXPECT_EQ(87654321u, interfaces.at("eth0").write_bytes);
+  EXPECT_EQ(1000u, interfaces.at("lo").read_bytes);
+}
+
+TEST(ProcParserTest, GpuQuery) {
+  google::protobuf::RepeatedPtrField<GpuResource> gpus;
+  EXPECT_TRUE(ParseGpuQuery(
+      "0, GeForce GTX 1080, 35, 1024, 8114\n1, Tesla P4, 0, 0, 7606\n",
+      &gpus));
+  ASSERT_EQ(2, gpus.size());
+  EXPECT_EQ(0, gpus.Get(0).index());
+  EXPECT_EQ("GeForce GTX 1080", gpus.Get(0).name());
+  EXPECT_DOUBLE_EQ(35.0, gpus.Get(0).utilization());
+  EXPECT_EQ(1024ull * 1024 * 1024, gpus.Get(0).memory_used_bytes());
+  EXPECT_EQ(7606ull * 1024 * 1024, gpus.Get(1).memory_total_bytes());
+
+  gpus.Clear();
+  EXPECT_FALSE(ParseGpuQuery("0, Tesla P4, [Not Supported], 0, 7606\n",
+                             &gpus));
+}
+
+}  // namespace monitor
+}  // namespace apollo
@@ -16,6 +16,10 @@
 
 #include "modules/monitor/software/process_monitor.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
 #include "gflags/gflags.h"
 #include "modules/common/log.h"
 #include "modules/common/util/file.h"
@@ -28,10 +32,19 @@ DEFINE_string(process_monitor_name, "ProcessMonitor",
 DEFINE_double(process_monitor_interval, 1.5,
               "Process status checking interval (s).");
 
+DEFINE_int32(process_monitor_full_scan_runs, 10,
+             "Every how many runs the command lines of all the processes "
+             "are read again, to catch a process which called exec.");
+
 namespace apollo {
 namespace monitor {
 namespace {
 
+bool ReadCmdline(const std::string &pid, std::string *cmdline) {
+  return common::util::GetContent(
+      common::util::StrCat("/proc/", pid, "/cmdline"), cmdline);
+}
+
 template <class Iterable>
 bool ContainsAll(const std::string &full, const Iterable &parts) {
   for (const auto &part : parts) {
@@ -50,32 +63,57 @@ ProcessMonitor::ProcessMonitor()
 }
 
 void ProcessMonitor::RunOnce(const double current_time) {
-  // Get running processes.
-  std::map<std::string, std::string> running_processes;
-  const auto procs = common::util::ListSubDirectories("/proc");
-  for (const auto &proc : procs) {
-    // Get process command string.
-    std::string cmd_string;
-    const auto cmd_file = common::util::StrCat("/proc/", proc, "/cmdline");
-    if (common::util::GetContent(cmd_file, &cmd_string)) {
-      running_processes.emplace(proc, cmd_string);
+  const int full_scan_runs = std::max(FLAGS_process_monitor_full_scan_runs, 1);
+  ScanProcesses(runs_++ % full_scan_runs == 0);
+  for (const auto &module : MonitorManager::GetConfig().modules()) {
+    if (module.has_process_conf()) {
+      UpdateModule(module.name(), module.process_conf());
     }
   }
+}
 
-  for (const auto &module : MonitorManager::GetConfig().modules()) {
-    if (module.has_process_conf()) {
-      UpdateModule(module.name(), module.process_conf(), running_processes);
+void ProcessMonitor::ScanProcesses(const bool full_scan) {
+  std::unordered_map<std::string, Process> processes;
+  for (const auto &pid : common::util::ListSubDirectories("/proc")) {
+    auto iter = running_processes_.find(pid);
+    if (iter != running_processes_.end()) {
+      processes.emplace(pid, std::move(iter->second));
+    }
+    Process &process = processes[pid];
+    if (full_scan || process.reads < 2) {
+      if (ReadCmdline(pid, &process.cmdline)) {
+        ++process.reads;
+      } else {
+        // Not a process, or it exited meanwhile.
+        processes.erase(pid);
+      }
     }
   }
+  running_processes_.swap(processes);
 }
 
-void ProcessMonitor::UpdateModule(
-    const std::string &module_name, const ProcessConf &config,
-    const std::map<std::string, std::string> &running_processes) {
+void ProcessMonitor::UpdateModule(const std::string &module_name,
+                                  const ProcessConf &config) {
   auto *status = MonitorManager::GetModuleStatus(module_name);
-  for (const auto &proc : running_processes) {
-    if (ContainsAll(proc.second, config.process_cmd_keywords())) {
+  // Check the process the module was running on first. Its command line is
+  // read again, in case the pid was reused.
+  const auto module_pid = module_pids_.find(module_name);
+  if (module_pid != module_pids_.end()) {
+    auto iter = running_processes_.find(module_pid->second);
+    if (iter != running_processes_.end() &&
+        ReadCmdline(iter->first, &iter->second.cmdline) &&
+        ContainsAll(iter->second.cmdline, config.process_cmd_keywords())) {
+      status->mutable_process_status()->set_running(true);
+      return;
+    }
+    module_pids_.erase(module_pid);
+  }
+
+  for (const auto &proc : running_processes_) {
+    if (ContainsAll(proc.second.cmdline, config.process_cmd_keywords())) {
       status->mutable_process_status()->set_running(true);
+      status->mutable_process_status()->set_pid(std::atoi(proc.first.c_str()));
+      module_pids_[module_name] = proc.first;
       ADEBUG << "Module " << module_name
              << " is running on process " << proc.first;
       return;
@@ -89,6 +127,7 @@ void ProcessMonitor::UpdateModule(
   }
 
   status->mutable_process_status()->set_running(false);
+  status->mutable_process_status()->clear_pid();
 }
 
 }  // namespace monitor
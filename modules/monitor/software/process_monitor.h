@@ -16,8 +16,8 @@
 #ifndef MODULES_MONITOR_SOFTWARE_PROCESS_MONITOR_H_
 #define MODULES_MONITOR_SOFTWARE_PROCESS_MONITOR_H_
 
-#include <map>
 #include <string>
+#include <unordered_map>
 
 #include "modules/monitor/common/recurrent_runner.h"
 #include "modules/monitor/proto/monitor_conf.pb.h"
@@ -31,9 +31,26 @@ class ProcessMonitor : public RecurrentRunner {
   void RunOnce(const double current_time) override;
 
  private:
-  static void UpdateModule(
-      const std::string &module_name, const ProcessConf &process_conf,
-      const std::map<std::string, std::string> &running_processes);
+  struct Process {
+    std::string cmdline;
+    // The number of scans which read the command line.
+    int reads = 0;
+  };
+
+  // Refreshes running_processes_ from the /proc entries. Only the command
+  // lines of the processes new since the last scan are read, and read again
+  // at the next scan in case the process was not done with exec yet. All of
+  // them are read every --process_monitor_full_scan_runs runs.
+  void ScanProcesses(const bool full_scan);
+
+  void UpdateModule(const std::string &module_name,
+                    const ProcessConf &process_conf);
+
+  // Running processes keyed by pid.
+  std::unordered_map<std::string, Process> running_processes_;
+  // The pid each module was found running on by the last run.
+  std::unordered_map<std::string, std::string> module_pids_;
+  int runs_ = 0;
 };
 
 }  // namespace monitor
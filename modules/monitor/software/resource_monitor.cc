@@ -0,0 +1,272 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/monitor/software/resource_monitor.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+#include "gflags/gflags.h"
+#include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/common/util/string_util.h"
+#include "modules/monitor/common/monitor_manager.h"
+
+DEFINE_string(resource_monitor_name, "ResourceMonitor",
+              "Name of the resource monitor.");
+
+DEFINE_double(resource_monitor_interval, 1.0,
+              "Resource usage reporting interval (s).");
+
+DEFINE_string(resource_monitor_gpu_query,
+              "nvidia-smi --query-gpu=index,name,utilization.gpu,memory.used,"
+              "memory.total --format=csv,noheader,nounits",
+              "Command printing the GPU usage, empty not to report it.");
+
+namespace apollo {
+namespace monitor {
+namespace {
+
+using apollo::common::adapter::AdapterManager;
+using apollo::common::util::GetContent;
+using apollo::common::util::StrCat;
+
+// Rate of a counter, 0 if it was reset.
+double Rate(const uint64_t previous, const uint64_t current,
+            const double interval) {
+  return current >= previous ? (current - previous) / interval : 0.0;
+}
+
+}  // namespace
+
+ResourceMonitor::ResourceMonitor()
+    : RecurrentRunner(FLAGS_resource_monitor_name,
+                      FLAGS_resource_monitor_interval),
+      ticks_per_sec_(sysconf(_SC_CLK_TCK)),
+      page_bytes_(sysconf(_SC_PAGESIZE)) {
+}
+
+void ResourceMonitor::RunOnce(const double current_time) {
+  // No rate is reported at the first run.
+  const double interval =
+      last_run_time_ > 0.0 ? current_time - last_run_time_ : 0.0;
+  last_run_time_ = current_time;
+
+  ResourceStatus status;
+  std::unordered_map<int, ProcessSample> previous_samples;
+  previous_samples.swap(process_samples_);
+  // Index in status.process() of the processes reported, in case several
+  // modules run on the same one.
+  std::unordered_map<int, int> reported_pids;
+  for (const auto &module : MonitorManager::GetConfig().modules()) {
+    if (!module.has_process_conf()) {
+      continue;
+    }
+    const auto &process_status =
+        MonitorManager::GetModuleStatus(module.name())->process_status();
+    if (!process_status.running() || !process_status.has_pid()) {
+      continue;
+    }
+    const int pid = process_status.pid();
+    const auto reported = reported_pids.find(pid);
+    if (reported != reported_pids.end()) {
+      auto *process = status.add_process();
+      process->CopyFrom(status.process(reported->second));
+      process->set_module_name(module.name());
+      continue;
+    }
+    auto iter = previous_samples.find(pid);
+    if (iter != previous_samples.end()) {
+      process_samples_.emplace(pid, std::move(iter->second));
+      previous_samples.erase(iter);
+    }
+    auto *process = status.add_process();
+    process->set_module_name(module.name());
+    if (!UpdateProcess(pid, interval, process)) {
+      // The process exited since ProcessMonitor found it.
+      status.mutable_process()->RemoveLast();
+      process_samples_.erase(pid);
+    } else {
+      reported_pids[pid] = status.process_size() - 1;
+    }
+  }
+
+  UpdateDisks(interval, &status);
+  UpdateNetwork(interval, &status);
+  UpdateGpus(&status);
+
+  AdapterManager::FillResourceStatusHeader(FLAGS_resource_monitor_name,
+                                           &status);
+  AdapterManager::PublishResourceStatus(status);
+}
+
+bool ResourceMonitor::UpdateProcess(const int pid, const double interval,
+                                    ProcessResource *process) {
+  const std::string proc_dir = StrCat("/proc/", pid);
+  std::string content;
+  ProcStat stat;
+  if (!GetContent(StrCat(proc_dir, "/stat"), &content) ||
+      !ParseProcStat(content, &stat)) {
+    return false;
+  }
+
+  // Thread CPU usages and the context switches, which are only counted per
+  // thread.
+  const bool has_sample = process_samples_.count(pid) > 0;
+  ProcessSample &sample = process_samples_[pid];
+  const bool has_rates = has_sample && interval > 0.0;
+  std::unordered_map<int, uint64_t> thread_ticks;
+  uint64_t voluntary_switches = 0;
+  uint64_t involuntary_switches = 0;
+  const std::string task_dir = StrCat(proc_dir, "/task");
+  for (const auto &tid_str : common::util::ListSubDirectories(task_dir)) {
+    const std::string thread_dir = StrCat(task_dir, "/", tid_str);
+    ProcStat thread_stat;
+    if (!GetContent(StrCat(thread_dir, "/stat"), &content) ||
+        !ParseProcStat(content, &thread_stat)) {
+      // The thread exited meanwhile.
+      continue;
+    }
+    uint64_t voluntary = 0;
+    uint64_t involuntary = 0;
+    if (GetContent(StrCat(thread_dir, "/status"), &content) &&
+        ParseContextSwitches(content, &voluntary, &involuntary)) {
+      voluntary_switches += voluntary;
+      involuntary_switches += involuntary;
+    }
+
+    const int tid = std::atoi(tid_str.c_str());
+    const uint64_t ticks = thread_stat.utime + thread_stat.stime;
+    thread_ticks[tid] = ticks;
+    auto *thread = process->add_thread();
+    thread->set_tid(tid);
+    thread->set_name(thread_stat.comm);
+    const auto previous_ticks = sample.thread_ticks.find(tid);
+    if (has_rates && previous_ticks != sample.thread_ticks.end()) {
+      thread->set_cpu_usage(
+          Rate(previous_ticks->second, ticks, interval) / ticks_per_sec_ *
+          100.0);
+    }
+  }
+
+  process->set_pid(pid);
+  process->set_rss_bytes(stat.rss * page_bytes_);
+  if (has_rates) {
+    const ProcStat &previous = sample.stat;
+    process->set_cpu_usage(Rate(previous.utime + previous.stime,
+                                stat.utime + stat.stime, interval) /
+                           ticks_per_sec_ * 100.0);
+    process->set_minor_page_fault_rate(
+        Rate(previous.minor_faults, stat.minor_faults, interval));
+    process->set_major_page_fault_rate(
+        Rate(previous.major_faults, stat.major_faults, interval));
+    // Exited threads take their switches away, which may decrease the sum.
+    process->set_voluntary_context_switch_rate(
+        Rate(sample.voluntary_switches, voluntary_switches, interval));
+    process->set_involuntary_context_switch_rate(
+        Rate(sample.involuntary_switches, involuntary_switches, interval));
+  }
+
+  sample.stat = stat;
+  sample.voluntary_switches = voluntary_switches;
+  sample.involuntary_switches = involuntary_switches;
+  sample.thread_ticks.swap(thread_ticks);
+  return true;
+}
+
+void ResourceMonitor::UpdateDisks(const double interval,
+                                  ResourceStatus *status) {
+  std::string content;
+  if (!GetContent("/proc/diskstats", &content)) {
+    return;
+  }
+  auto disks = ParseDiskStats(content);
+  for (const auto &disk : disks) {
+    // Only report the whole disks, not the partitions, nor the loop and
+    // ram devices.
+    const auto previous = disk_counters_.find(disk.first);
+    if (interval <= 0.0 || previous == disk_counters_.end() ||
+        disk.first.compare(0, 4, "loop") == 0 ||
+        disk.first.compare(0, 3, "ram") == 0 ||
+        !common::util::DirectoryExists(StrCat("/sys/block/", disk.first))) {
+      continue;
+    }
+    auto *resource = status->add_disk();
+    resource->set_name(disk.first);
+    resource->set_read_bytes_rate(
+        Rate(previous->second.read_bytes, disk.second.read_bytes, interval));
+    resource->set_write_bytes_rate(
+        Rate(previous->second.write_bytes, disk.second.write_bytes, interval));
+  }
+  disk_counters_.swap(disks);
+}
+
+void ResourceMonitor::UpdateNetwork(const double interval,
+                                    ResourceStatus *status) {
+  std::string content;
+  if (!GetContent("/proc/net/dev", &content)) {
+    return;
+  }
+  auto interfaces = ParseNetDev(content);
+  for (const auto &interface : interfaces) {
+    const auto previous = network_counters_.find(interface.first);
+    if (interval <= 0.0 || previous == network_counters_.end() ||
+        interface.first == "lo") {
+      continue;
+    }
+    auto *resource = status->add_network();
+    resource->set_interface(interface.first);
+    resource->set_receive_bytes_rate(Rate(previous->second.read_bytes,
+                                          interface.second.read_bytes,
+                                          interval));
+    resource->set_transmit_bytes_rate(Rate(previous->second.write_bytes,
+                                           interface.second.write_bytes,
+                                           interval));
+  }
+  network_counters_.swap(interfaces);
+}
+
+void ResourceMonitor::UpdateGpus(ResourceStatus *status) {
+  if (!query_gpus_ || FLAGS_resource_monitor_gpu_query.empty()) {
+    return;
+  }
+  FILE *pipe = popen(FLAGS_resource_monitor_gpu_query.c_str(), "r");
+  if (pipe == nullptr) {
+    AWARN << "Cannot run " << FLAGS_resource_monitor_gpu_query
+          << ", not reporting the GPU usage.";
+    query_gpus_ = false;
+    return;
+  }
+  std::string output;
+  char buffer[256];
+  size_t size = 0;
+  while ((size = fread(buffer, 1, sizeof(buffer), pipe)) > 0) {
+    output.append(buffer, size);
+  }
+  if (pclose(pipe) != 0 || !ParseGpuQuery(output, status->mutable_gpu())) {
+    AWARN << "Failed to query the GPU usage with "
+          << FLAGS_resource_monitor_gpu_query << ", not reporting it.";
+    status->clear_gpu();
+    query_gpus_ = false;
+  }
+}
+
+}  // namespace monitor
+}  // namespace apollo
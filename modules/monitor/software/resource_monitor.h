@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_MONITOR_SOFTWARE_RESOURCE_MONITOR_H_
+#define MODULES_MONITOR_SOFTWARE_RESOURCE_MONITOR_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include "modules/monitor/common/recurrent_runner.h"
+#include "modules/monitor/proto/resource_status.pb.h"
+#include "modules/monitor/software/proc_parser.h"
+
+namespace apollo {
+namespace monitor {
+
+// Publishes the CPU, memory, page faults and context switches of the
+// processes the modules run on, found by ProcessMonitor, with the GPU
+// usage and the disk and network I/O rates of the system.
+class ResourceMonitor : public RecurrentRunner {
+ public:
+  ResourceMonitor();
+  void RunOnce(const double current_time) override;
+
+ private:
+  // The counters of a process at the previous run, to get the rates.
+  struct ProcessSample {
+    ProcStat stat;
+    uint64_t voluntary_switches = 0;
+    uint64_t involuntary_switches = 0;
+    // CPU time of the threads keyed by tid, in clock ticks.
+    std::unordered_map<int, uint64_t> thread_ticks;
+  };
+
+  bool UpdateProcess(const int pid, const double interval,
+                     ProcessResource *process);
+  void UpdateDisks(const double interval, ResourceStatus *status);
+  void UpdateNetwork(const double interval, ResourceStatus *status);
+  void UpdateGpus(ResourceStatus *status);
+
+  std::unordered_map<int, ProcessSample> process_samples_;
+  std::map<std::string, IoCounters> disk_counters_;
+  std::map<std::string, IoCounters> network_counters_;
+  double last_run_time_ = 0.0;
+  // Cleared when the GPU query fails, not to run it again.
+  bool query_gpus_ = true;
+  const double ticks_per_sec_;
+  const int64_t page_bytes_;
+};
+
+}  // namespace monitor
+}  // namespace apollo
+
+#endif  // MODULES_MONITOR_SOFTWARE_RESOURCE_MONITOR_H_
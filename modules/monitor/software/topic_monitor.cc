@@ -71,6 +71,16 @@ TopicMonitor::TopicMonitor(const TopicConf &config, TopicStatus *status)
 
 void TopicMonitor::RunOnce(const double current_time) {
   auto *adapter = GetAdapterByMessageType(config_.type());
+  // The adapter counts the messages as it receives them, so the rate is
+  // sampled here instead of subscribing to the topic.
+  const uint64_t received_count = adapter->GetReceivedCount();
+  if (last_run_time_ > 0.0 && current_time > last_run_time_) {
+    status_->set_message_rate_hz((received_count - last_received_count_) /
+                                 (current_time - last_run_time_));
+  }
+  last_received_count_ = received_count;
+  last_run_time_ = current_time;
+
   if (!adapter->HasReceived()) {
     status_->set_message_delay(-1);
     return;
@@ -16,6 +16,7 @@
 #ifndef MODULES_MONITOR_SOFTWARE_TOPIC_MONITOR_H_
 #define MODULES_MONITOR_SOFTWARE_TOPIC_MONITOR_H_
 
+#include <cstdint>
 #include <string>
 
 #include "modules/common/adapters/adapter.h"
@@ -33,6 +34,9 @@ class TopicMonitor : public RecurrentRunner {
  private:
   const TopicConf &config_;
   TopicStatus *status_;
+  // The received count of the adapter at the previous run, to get the rate.
+  uint64_t last_received_count_ = 0;
+  double last_run_time_ = 0.0;
 };
 
 }  // namespace monitor
@@ -33,9 +33,26 @@ DEFINE_bool(is_serialize_point_cloud, false,
 DEFINE_double(map_radius, 60.0, "get map radius of car center");
 DEFINE_int32(map_sample_step, 1, "step for sample road boundary points");
 
+/// obstacle/lidar/roi_filter/hdmap_roi_filter/hdmap_roi_filter.cc
+DEFINE_bool(enable_hdmap_roi_bitmap_cache, false,
+            "keep the ROI bitmap in world coordinates across frames and only "
+            "draw the tiles entering the range of the vehicle");
+
+/// obstacle/lidar/object_builder/min_box/min_box.cc
+DEFINE_int32(min_box_object_builder_num_threads, 0,
+             "the number of worker threads building the objects, 0 builds "
+             "them in the calling thread");
+
+/// obstacle/lidar/tracker/hm_tracker/hungarian_matcher.cc
+DEFINE_int32(hm_tracker_num_matching_threads, 0,
+             "the number of worker threads matching the connected components "
+             "of tracks and objects, 0 matches them in the calling thread");
+
 /// obstacle/onboard/lidar_process.cc
 DEFINE_bool(enable_hdmap_input, false, "enable hdmap input for roi filter");
 DEFINE_string(onboard_roi_filter, "DummyROIFilter", "onboard roi filter");
+DEFINE_string(onboard_ground_detector, "DummyGroundDetector",
+              "onboard ground detector");
 DEFINE_string(onboard_segmentor, "DummySegmentation", "onboard segmentation");
 DEFINE_string(onboard_object_builder, "DummyObjectBuilder",
               "onboard object builder");
@@ -50,6 +67,20 @@ DEFINE_string(lidar_tf2_child_frame_id, "velodyne64",
 DEFINE_string(obstacle_module_name, "perception_obstacle",
               "perception obstacle module name");
 DEFINE_bool(enable_visualization, false, "enable visualization for debug");
+DEFINE_bool(enable_lidar_pipeline, false,
+            "run the segmentation and the tracking of consecutive lidar "
+            "frames in parallel stages");
+DEFINE_int32(lidar_pipeline_queue_size, 2,
+             "the max number of frames waiting for each pipeline stage");
+DEFINE_string(onboard_aux_lidar_topics, "",
+              "comma separated point cloud topics of the other lidars, merged "
+              "into the main point cloud before the segmentation");
+DEFINE_string(onboard_aux_lidar_tf2_child_frame_ids, "",
+              "comma separated tf2 child frame ids of the other lidars, in "
+              "the order of their topics");
+DEFINE_double(lidar_merge_sync_window, 0.05,
+              "the max time difference in seconds between a merged point "
+              "cloud and the main one");
 
 /// obstacle/perception.cc
 DEFINE_string(dag_config_path, "./conf/dag_streaming.config",
@@ -74,6 +105,11 @@ DEFINE_string(short_camera_extrinsic_file,
 DEFINE_string(onboard_fusion, "ProbabilisticFusion",
               "fusion name which enabled onboard");
 
+/// obstacle/fusion/probabilistic_fusion/probabilistic_fusion.cc
+DEFINE_int32(pbf_fusion_num_threads, 0,
+             "the number of worker threads matching and updating the fusion "
+             "tracks, 0 runs them in the calling thread");
+
 DEFINE_double(query_signal_range, 100.0, "max distance to front signals");
 DEFINE_bool(output_raw_img, false, "write raw image to disk");
 DEFINE_bool(output_debug_img, false, "write debug image to disk");
@@ -32,9 +32,19 @@ DECLARE_bool(is_serialize_point_cloud);
 DECLARE_double(map_radius);
 DECLARE_int32(map_sample_step);
 
+/// obstacle/lidar/roi_filter/hdmap_roi_filter/hdmap_roi_filter.cc
+DECLARE_bool(enable_hdmap_roi_bitmap_cache);
+
+/// obstacle/lidar/object_builder/min_box/min_box.cc
+DECLARE_int32(min_box_object_builder_num_threads);
+
+/// obstacle/lidar/tracker/hm_tracker/hungarian_matcher.cc
+DECLARE_int32(hm_tracker_num_matching_threads);
+
 /// obstacle/onboard/lidar_process_subnode.cc
 DECLARE_bool(enable_hdmap_input);
 DECLARE_string(onboard_roi_filter);
+DECLARE_string(onboard_ground_detector);
 DECLARE_string(onboard_segmentor);
 DECLARE_string(onboard_object_builder);
 DECLARE_string(onboard_tracker);
@@ -44,6 +54,11 @@ DECLARE_string(lidar_tf2_frame_id);
 DECLARE_string(lidar_tf2_child_frame_id);
 DECLARE_string(obstacle_module_name);
 DECLARE_bool(enable_visualization);
+DECLARE_bool(enable_lidar_pipeline);
+DECLARE_int32(lidar_pipeline_queue_size);
+DECLARE_string(onboard_aux_lidar_topics);
+DECLARE_string(onboard_aux_lidar_tf2_child_frame_ids);
+DECLARE_double(lidar_merge_sync_window);
 
 /// obstacle/onboard/radar_process_subnode.cc
 DECLARE_double(front_radar_forward_distance);
@@ -57,6 +72,9 @@ DECLARE_string(short_camera_extrinsic_file);
 /// obstacle/onboard/fusion_subnode.cc
 DECLARE_string(onboard_fusion);
 
+/// obstacle/fusion/probabilistic_fusion/probabilistic_fusion.cc
+DECLARE_int32(pbf_fusion_num_threads);
+
 /// traffic_light/onboard/preprocessor.cc
 DECLARE_double(query_signal_range);
 DECLARE_bool(output_raw_img);
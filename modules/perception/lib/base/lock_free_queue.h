@@ -0,0 +1,185 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_LIB_BASE_LOCK_FREE_QUEUE_H_
+#define MODULES_PERCEPTION_LIB_BASE_LOCK_FREE_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "modules/common/macro.h"
+#include "modules/perception/lib/base/mutex.h"
+
+namespace apollo {
+namespace perception {
+
+// A bounded multi-producer multi-consumer queue on a ring of cells, with the
+// same interface as FixedSizeConQueue. try_push() and try_pop() take no lock:
+// each cell has a sequence number telling whether it waits for a push or a
+// pop of the slot of a given position, and the producers and the consumers
+// claim their positions by compare and swap.
+// pop() only takes the mutex to sleep when the queue is empty, and push()
+// only takes it to wake a sleeping consumer up, so neither waits on a lock
+// while the queue is neither empty nor full.
+template <typename Data>
+class LockFreeBoundedQueue {
+ public:
+  explicit LockFreeBoundedQueue(size_t max_count)
+      : cells_(max_count > 0 ? max_count : 1) {
+    for (size_t i = 0; i < cells_.size(); ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~LockFreeBoundedQueue() {}
+
+  // @brief waits while the queue is full
+  void push(const Data& data) {
+    while (!try_push(data)) {
+      MutexLock lock(&mutex_);
+      ++waiting_producers_;
+      if (!full()) {
+        --waiting_producers_;
+        continue;
+      }
+      condition_full_.Wait(&mutex_);
+      --waiting_producers_;
+    }
+  }
+
+  bool try_push(const Data& data) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    while (true) {
+      cell = &cells_[pos % cells_.size()];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      if (sequence == pos) {
+        if (tail_.compare_exchange_weak(pos, pos + 1)) {
+          break;
+        }
+      } else if (sequence < pos) {
+        // the cell still holds the data pushed a round earlier
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = data;
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    Notify(&waiting_consumers_, &condition_variable_);
+    return true;
+  }
+
+  // @brief waits while the queue is empty
+  void pop(Data* data) {
+    while (!try_pop(data)) {
+      MutexLock lock(&mutex_);
+      ++waiting_consumers_;
+      if (!empty()) {
+        --waiting_consumers_;
+        continue;
+      }
+      condition_variable_.Wait(&mutex_);
+      --waiting_consumers_;
+    }
+  }
+
+  bool try_pop(Data* data) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    while (true) {
+      cell = &cells_[pos % cells_.size()];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      if (sequence == pos + 1) {
+        if (head_.compare_exchange_weak(pos, pos + 1)) {
+          break;
+        }
+      } else if (sequence < pos + 1) {
+        // the cell waits for the push of this position
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+    // moving the data out releases the storage it holds, as a pop of
+    // std::queue does
+    *data = std::move(cell->data);
+    cell->sequence.store(pos + cells_.size(), std::memory_order_release);
+    Notify(&waiting_producers_, &condition_full_);
+    return true;
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  bool full() const {
+    return size() >= static_cast<int>(cells_.size());
+  }
+
+  // @brief number of data pushed and not popped yet, exact when no push or
+  // pop is running
+  int size() const {
+    const size_t head = head_.load();
+    const size_t tail = tail_.load();
+    return tail > head ? static_cast<int>(tail - head) : 0;
+  }
+
+  void clear() {
+    Data data;
+    while (try_pop(&data)) {
+    }
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    Data data;
+  };
+
+  // Wakes the threads waiting on the condition up. A waiter registers itself
+  // and checks the queue again under the mutex before it sleeps, and the
+  // positions and the numbers of waiters are sequentially consistent, so
+  // either the waiter sees the change or it is seen here.
+  void Notify(std::atomic<int>* waiting, CondVar* condition) {
+    if (waiting->load() > 0) {
+      MutexLock lock(&mutex_);
+      condition->Signalall();
+    }
+  }
+
+  std::vector<Cell> cells_;
+  // positions of the next push and pop, padded apart so the producers and
+  // the consumers do not contend on a cache line
+  std::atomic<size_t> tail_{0};
+  char padding_[64];
+  std::atomic<size_t> head_{0};
+
+  Mutex mutex_;
+  CondVar condition_variable_;
+  CondVar condition_full_;
+  std::atomic<int> waiting_consumers_{0};
+  std::atomic<int> waiting_producers_{0};
+
+  DISALLOW_COPY_AND_ASSIGN(LockFreeBoundedQueue);
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_LIB_BASE_LOCK_FREE_QUEUE_H_
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lib/base/lock_free_queue.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+
+TEST(LockFreeBoundedQueueTest, PushPop) {
+  LockFreeBoundedQueue<int> queue(3);
+  EXPECT_TRUE(queue.empty());
+  int data = 0;
+  EXPECT_FALSE(queue.try_pop(&data));
+
+  // the ring wraps around several times
+  for (int round = 0; round < 5; ++round) {
+    EXPECT_TRUE(queue.try_push(3 * round));
+    EXPECT_TRUE(queue.try_push(3 * round + 1));
+    queue.push(3 * round + 2);
+    EXPECT_TRUE(queue.full());
+    EXPECT_EQ(3, queue.size());
+    EXPECT_FALSE(queue.try_push(-1));
+    for (int i = 0; i < 3; ++i) {
+      ASSERT_TRUE(queue.try_pop(&data));
+      EXPECT_EQ(3 * round + i, data);
+    }
+    EXPECT_TRUE(queue.empty());
+  }
+
+  queue.push(1);
+  queue.push(2);
+  queue.clear();
+  EXPECT_EQ(0, queue.size());
+  EXPECT_FALSE(queue.try_pop(&data));
+}
+
+TEST(LockFreeBoundedQueueTest, MultiThread) {
+  const int kNumThreads = 4;
+  const int kNumData = 10000;
+  LockFreeBoundedQueue<int> queue(16);
+  std::vector<std::thread> producers;
+  std::vector<std::thread> consumers;
+  std::vector<int64_t> sums(kNumThreads, 0);
+  for (int t = 0; t < kNumThreads; ++t) {
+    producers.emplace_back([&queue, t]() {
+      for (int i = 1; i <= kNumData; ++i) {
+        if (i % 2 == 0) {
+          queue.push(i);
+        } else {
+          while (!queue.try_push(i)) {
+            std::this_thread::yield();
+          }
+        }
+      }
+    });
+    consumers.emplace_back([&queue, &sums, t]() {
+      for (int i = 0; i < kNumData; ++i) {
+        int data = 0;
+        queue.pop(&data);
+        sums[t] += data;
+      }
+    });
+  }
+  for (int t = 0; t < kNumThreads; ++t) {
+    producers[t].join();
+    consumers[t].join();
+  }
+
+  // every pushed data is popped once
+  int64_t sum = 0;
+  for (const int64_t thread_sum : sums) {
+    sum += thread_sum;
+  }
+  EXPECT_EQ(static_cast<int64_t>(kNumThreads) * kNumData * (kNumData + 1) / 2,
+            sum);
+  EXPECT_TRUE(queue.empty());
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,173 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_LIB_BASE_OBJECT_POOL_H_
+#define MODULES_PERCEPTION_LIB_BASE_OBJECT_POOL_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "modules/common/macro.h"
+#include "modules/perception/lib/base/mutex.h"
+
+namespace apollo {
+namespace perception {
+
+// A thread safe pool of T handed out as shared pointers. When the last shared
+// pointer of an object is released, the object is reset by the given function
+// and kept for a later Get(), and so is the control block of the shared
+// pointer. Once the pool has served as many objects as are alive at the same
+// time, Get() does no heap allocation.
+// Ptr is the shared pointer type, std::shared_ptr<T> or boost::shared_ptr<T>,
+// both construct from a pointer, a deleter and an allocator.
+// The objects outlive the pool if they are still used when it is destroyed.
+template <typename T, typename Ptr = std::shared_ptr<T>>
+class ObjectPool {
+ public:
+  // @params[IN] capacity: maximum number of idle objects kept
+  // @params[IN] reset: restores a released object to the state of T()
+  ObjectPool(const size_t capacity, const std::function<void(T*)>& reset)
+      : storage_(std::make_shared<Storage>(capacity, reset)) {}
+
+  Ptr Get() {
+    T* object = nullptr;
+    {
+      MutexLock lock(&storage_->mutex);
+      if (!storage_->objects.empty()) {
+        object = storage_->objects.back();
+        storage_->objects.pop_back();
+      }
+    }
+    if (object == nullptr) {
+      object = new T();
+    }
+    return Ptr(object, Recycler(storage_), BlockAllocator<T>(storage_));
+  }
+
+  // @brief number of idle objects in the pool
+  size_t NumIdle() const {
+    MutexLock lock(&storage_->mutex);
+    return storage_->objects.size();
+  }
+
+ private:
+  struct Storage {
+    Storage(const size_t capacity, const std::function<void(T*)>& reset)
+        : capacity(capacity), reset(reset) {}
+    ~Storage() {
+      for (T* object : objects) {
+        delete object;
+      }
+      for (void* block : blocks) {
+        ::operator delete(block);
+      }
+    }
+
+    Mutex mutex;
+    const size_t capacity;
+    const std::function<void(T*)> reset;
+    std::vector<T*> objects;
+    // recycled control blocks, all of block_size bytes
+    std::vector<void*> blocks;
+    size_t block_size = 0;
+  };
+
+  struct Recycler {
+    explicit Recycler(const std::shared_ptr<Storage>& storage)
+        : storage(storage) {}
+    void operator()(T* object) const {
+      storage->reset(object);
+      {
+        MutexLock lock(&storage->mutex);
+        if (storage->objects.size() < storage->capacity) {
+          storage->objects.push_back(object);
+          return;
+        }
+      }
+      delete object;
+    }
+
+    std::shared_ptr<Storage> storage;
+  };
+
+  // Allocates the control blocks of the shared pointers from the blocks of
+  // the storage. A shared pointer type has a single control block type, so
+  // a block of any other size is left to the global operator new.
+  template <typename U>
+  struct BlockAllocator {
+    typedef U value_type;
+    template <typename V>
+    struct rebind {
+      typedef BlockAllocator<V> other;
+    };
+
+    explicit BlockAllocator(const std::shared_ptr<Storage>& storage)
+        : storage(storage) {}
+    template <typename V>
+    BlockAllocator(const BlockAllocator<V>& other)  // NOLINT
+        : storage(other.storage) {}
+
+    U* allocate(const size_t n, const void* hint = nullptr) {
+      if (n == 1) {
+        MutexLock lock(&storage->mutex);
+        if (storage->block_size == sizeof(U) && !storage->blocks.empty()) {
+          void* block = storage->blocks.back();
+          storage->blocks.pop_back();
+          return static_cast<U*>(block);
+        }
+      }
+      return static_cast<U*>(::operator new(n * sizeof(U)));
+    }
+
+    void deallocate(U* ptr, const size_t n) {
+      if (n == 1) {
+        MutexLock lock(&storage->mutex);
+        if (storage->block_size == 0) {
+          storage->block_size = sizeof(U);
+        }
+        if (storage->block_size == sizeof(U) &&
+            storage->blocks.size() < storage->capacity) {
+          storage->blocks.push_back(ptr);
+          return;
+        }
+      }
+      ::operator delete(ptr);
+    }
+
+    template <typename V>
+    bool operator==(const BlockAllocator<V>& other) const {
+      return storage == other.storage;
+    }
+    template <typename V>
+    bool operator!=(const BlockAllocator<V>& other) const {
+      return storage != other.storage;
+    }
+
+    std::shared_ptr<Storage> storage;
+  };
+
+  std::shared_ptr<Storage> storage_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObjectPool);
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_LIB_BASE_OBJECT_POOL_H_
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lib/base/object_pool.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+
+namespace {
+
+struct Item {
+  int value = 0;
+  std::vector<int> data;
+};
+
+void ResetItem(Item* item) {
+  item->value = 0;
+  item->data.clear();
+}
+
+}  // namespace
+
+TEST(ObjectPoolTest, Recycle) {
+  ObjectPool<Item> pool(2, ResetItem);
+  EXPECT_EQ(0, pool.NumIdle());
+
+  std::shared_ptr<Item> item = pool.Get();
+  item->value = 1;
+  item->data.assign(100, 1);
+  Item* address = item.get();
+  std::shared_ptr<Item> copy = item;
+  item.reset();
+  EXPECT_EQ(0, pool.NumIdle());
+  copy.reset();
+  EXPECT_EQ(1, pool.NumIdle());
+
+  // the released object is reset, and keeps its storage
+  item = pool.Get();
+  EXPECT_EQ(address, item.get());
+  EXPECT_EQ(0, item->value);
+  EXPECT_TRUE(item->data.empty());
+  EXPECT_LE(100, item->data.capacity());
+  EXPECT_EQ(0, pool.NumIdle());
+
+  // at most capacity objects are kept
+  std::vector<std::shared_ptr<Item>> items;
+  for (int i = 0; i < 5; ++i) {
+    items.push_back(pool.Get());
+  }
+  items.clear();
+  EXPECT_EQ(2, pool.NumIdle());
+}
+
+TEST(ObjectPoolTest, OutlivedByObjects) {
+  std::shared_ptr<Item> item;
+  {
+    ObjectPool<Item> pool(2, ResetItem);
+    item = pool.Get();
+    item->value = 1;
+  }
+  EXPECT_EQ(1, item->value);
+  item.reset();
+}
+
+TEST(ObjectPoolTest, MultiThread) {
+  ObjectPool<Item> pool(64, ResetItem);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&pool, t]() {
+      std::vector<std::shared_ptr<Item>> items;
+      for (int i = 0; i < 1000; ++i) {
+        items.push_back(pool.Get());
+        EXPECT_EQ(0, items.back()->value);
+        items.back()->value = t + 1;
+        if (items.size() > 8) {
+          items.clear();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_LE(pool.NumIdle(), 64);
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -19,6 +19,7 @@
 #include <signal.h>
 
 #include "modules/common/log.h"
+#include "modules/common/scheduling/scheduler.h"
 
 namespace apollo {
 namespace perception {
@@ -39,6 +40,24 @@ void Thread::Start() {
   CHECK_EQ(pthread_attr_destroy(&attr), 0);
 
   started_ = true;
+  ApplySchedConfig();
+}
+
+void Thread::ApplySchedConfig() {
+  // The scheduling set by the module takes precedence over the one of the
+  // scheduling config.
+  auto *scheduler = common::scheduling::Scheduler::instance();
+  if (sched_priority_ > 0 || !cpu_affinity_.empty()) {
+    scheduler->ApplyToThread(
+        tid_, thread_name_,
+        common::scheduling::MakeThreadSchedule(sched_priority_, cpu_affinity_));
+    return;
+  }
+  const auto *schedule = scheduler->FindThreadSchedule(thread_name_);
+  scheduler->ApplyToThread(tid_, thread_name_,
+                           schedule != nullptr
+                               ? *schedule
+                               : common::scheduling::ThreadSchedule());
 }
 
 void Thread::Join() {
@@ -19,6 +19,7 @@
 
 #include <pthread.h>
 #include <string>
+#include <vector>
 
 #include "modules/common/macro.h"
 
@@ -47,6 +48,15 @@ class Thread {
   std::string thread_name() const { return thread_name_; }
   void set_thread_name(const std::string& name) { thread_name_ = name; }
 
+  // @brief SCHED_FIFO priority given to the thread when it starts, from 1 to
+  // 99, 0 keeps it under the default scheduler.
+  void set_sched_priority(int priority) { sched_priority_ = priority; }
+  int sched_priority() const { return sched_priority_; }
+
+  // @brief cpus the thread is pinned to when it starts, all if empty.
+  void set_cpu_affinity(const std::vector<int>& cpus) { cpu_affinity_ = cpus; }
+  const std::vector<int>& cpu_affinity() const { return cpu_affinity_; }
+
  protected:
   virtual void Run() = 0;
 
@@ -62,6 +72,13 @@ class Thread {
   std::string thread_name_;
 
  private:
+  // failing to apply them, e.g. without the privilege of real-time
+  // priorities, only warns.
+  void ApplySchedConfig();
+
+  int sched_priority_ = 0;
+  std::vector<int> cpu_affinity_;
+
   DISALLOW_COPY_AND_ASSIGN(Thread);
 };
 
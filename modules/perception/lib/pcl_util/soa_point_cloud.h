@@ -0,0 +1,220 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_LIB_PCL_UTIL_SOA_POINT_CLOUD_H_
+#define MODULES_PERCEPTION_LIB_PCL_UTIL_SOA_POINT_CLOUD_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "modules/perception/lib/pcl_util/pcl_types.h"
+
+namespace apollo {
+namespace perception {
+namespace pcl_util {
+
+/**
+ * @class SoaPointCloud
+ * @brief A cloud of PointXYZIH laid out as a structure of arrays, one array
+ * per field, so that the loops over the points read contiguous floats. The
+ * storage is kept when the cloud is refilled.
+ */
+class SoaPointCloud {
+ public:
+  SoaPointCloud() = default;
+
+  explicit SoaPointCloud(const PointCloud& cloud) { FromPcl(cloud); }
+
+  size_t size() const { return x_.size(); }
+
+  bool empty() const { return x_.empty(); }
+
+  void reserve(size_t size) {
+    x_.reserve(size);
+    y_.reserve(size);
+    z_.reserve(size);
+    intensity_.reserve(size);
+    h_.reserve(size);
+  }
+
+  void resize(size_t size) {
+    x_.resize(size);
+    y_.resize(size);
+    z_.resize(size);
+    intensity_.resize(size);
+    h_.resize(size);
+  }
+
+  void clear() { resize(0); }
+
+  void push_back(const Point& point) {
+    x_.push_back(point.x);
+    y_.push_back(point.y);
+    z_.push_back(point.z);
+    intensity_.push_back(point.intensity);
+    h_.push_back(point.h);
+  }
+
+  const float* x() const { return x_.data(); }
+  const float* y() const { return y_.data(); }
+  const float* z() const { return z_.data(); }
+  const float* intensity() const { return intensity_.data(); }
+  const float* h() const { return h_.data(); }
+
+  float* mutable_x() { return x_.data(); }
+  float* mutable_y() { return y_.data(); }
+  float* mutable_z() { return z_.data(); }
+  float* mutable_intensity() { return intensity_.data(); }
+  float* mutable_h() { return h_.data(); }
+
+  /**
+   * @brief Gets the i-th point in the PCL layout.
+   */
+  Point point(size_t i) const {
+    Point point;
+    point.x = x_[i];
+    point.y = y_[i];
+    point.z = z_[i];
+    point.intensity = intensity_[i];
+    point.h = h_[i];
+    return point;
+  }
+
+  /**
+   * @brief Fills the cloud with all the points of a PCL cloud.
+   */
+  void FromPcl(const PointCloud& cloud) {
+    resize(cloud.points.size());
+    for (size_t i = 0; i < cloud.points.size(); ++i) {
+      Set(i, cloud.points[i]);
+    }
+  }
+
+  /**
+   * @brief Fills the cloud with the points of a PCL cloud at the indices, in
+   * their order.
+   */
+  void FromPcl(const PointCloud& cloud, const std::vector<int>& indices) {
+    resize(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+      Set(i, cloud.points[indices[i]]);
+    }
+  }
+
+  /**
+   * @brief Fills a PCL cloud with all the points.
+   */
+  void ToPcl(PointCloud* cloud) const {
+    cloud->points.resize(size());
+    for (size_t i = 0; i < size(); ++i) {
+      cloud->points[i] = point(i);
+    }
+    cloud->width = static_cast<uint32_t>(size());
+    cloud->height = 1;
+  }
+
+  /**
+   * @brief Fills a PCL cloud with the points at the indices, in their order.
+   */
+  void ToPcl(const std::vector<int>& indices, PointCloud* cloud) const {
+    cloud->points.resize(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+      cloud->points[i] = point(indices[i]);
+    }
+    cloud->width = static_cast<uint32_t>(indices.size());
+    cloud->height = 1;
+  }
+
+ private:
+  void Set(size_t i, const Point& point) {
+    x_[i] = point.x;
+    y_[i] = point.y;
+    z_[i] = point.z;
+    intensity_[i] = point.intensity;
+    h_[i] = point.h;
+  }
+
+  std::vector<float> x_;
+  std::vector<float> y_;
+  std::vector<float> z_;
+  std::vector<float> intensity_;
+  std::vector<float> h_;
+};
+
+/**
+ * @class SoaPointCloudView
+ * @brief The points of a SoaPointCloud at some indices, or all of them, as a
+ * subset which is not copied. The view owns neither the cloud nor the
+ * indices, which must outlive it.
+ */
+class SoaPointCloudView {
+ public:
+  SoaPointCloudView() = default;
+
+  explicit SoaPointCloudView(const SoaPointCloud& cloud) : cloud_(&cloud) {}
+
+  SoaPointCloudView(const SoaPointCloud& cloud,
+                    const std::vector<int>& indices)
+      : cloud_(&cloud), indices_(&indices) {}
+
+  bool valid() const { return cloud_ != nullptr; }
+
+  bool has_indices() const { return indices_ != nullptr; }
+
+  const SoaPointCloud& cloud() const { return *cloud_; }
+
+  size_t size() const {
+    return indices_ != nullptr ? indices_->size() : cloud_->size();
+  }
+
+  bool empty() const { return size() == 0; }
+
+  /**
+   * @brief Gets the index in the cloud of the i-th point of the view.
+   */
+  int index(size_t i) const {
+    return indices_ != nullptr ? (*indices_)[i] : static_cast<int>(i);
+  }
+
+  float x(size_t i) const { return cloud_->x()[index(i)]; }
+  float y(size_t i) const { return cloud_->y()[index(i)]; }
+  float z(size_t i) const { return cloud_->z()[index(i)]; }
+  float intensity(size_t i) const { return cloud_->intensity()[index(i)]; }
+  float h(size_t i) const { return cloud_->h()[index(i)]; }
+
+  Point point(size_t i) const { return cloud_->point(index(i)); }
+
+  /**
+   * @brief Fills a PCL cloud with the points of the view.
+   */
+  void ToPcl(PointCloud* cloud) const {
+    if (indices_ != nullptr) {
+      cloud_->ToPcl(*indices_, cloud);
+    } else {
+      cloud_->ToPcl(cloud);
+    }
+  }
+
+ private:
+  const SoaPointCloud* cloud_ = nullptr;
+  const std::vector<int>* indices_ = nullptr;
+};
+
+}  // namespace pcl_util
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_LIB_PCL_UTIL_SOA_POINT_CLOUD_H_
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/lib/pcl_util/soa_point_cloud.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace pcl_util {
+
+namespace {
+
+PointCloud MakeCloud(int num_points) {
+  PointCloud cloud;
+  for (int i = 0; i < num_points; ++i) {
+    Point point;
+    point.x = i;
+    point.y = 2.0f * i;
+    point.z = -1.0f * i;
+    point.intensity = 10.0f * i;
+    point.h = 0.5f * i;
+    cloud.push_back(point);
+  }
+  return cloud;
+}
+
+}  // namespace
+
+TEST(SoaPointCloudTest, FromToPcl) {
+  const PointCloud cloud = MakeCloud(5);
+  SoaPointCloud soa_cloud(cloud);
+  ASSERT_EQ(5u, soa_cloud.size());
+  for (size_t i = 0; i < soa_cloud.size(); ++i) {
+    EXPECT_FLOAT_EQ(cloud.points[i].x, soa_cloud.x()[i]);
+    EXPECT_FLOAT_EQ(cloud.points[i].y, soa_cloud.y()[i]);
+    EXPECT_FLOAT_EQ(cloud.points[i].z, soa_cloud.z()[i]);
+    EXPECT_FLOAT_EQ(cloud.points[i].intensity, soa_cloud.intensity()[i]);
+    EXPECT_FLOAT_EQ(cloud.points[i].h, soa_cloud.h()[i]);
+  }
+
+  PointCloud back;
+  soa_cloud.ToPcl(&back);
+  ASSERT_EQ(5u, back.points.size());
+  EXPECT_EQ(5u, back.width);
+  EXPECT_FLOAT_EQ(8.0f, back.points[4].y);
+  EXPECT_FLOAT_EQ(20.0f, back.points[2].intensity);
+
+  // refilling with a subset keeps only its points, in the order of indices
+  soa_cloud.FromPcl(cloud, {4, 1});
+  ASSERT_EQ(2u, soa_cloud.size());
+  EXPECT_FLOAT_EQ(4.0f, soa_cloud.x()[0]);
+  EXPECT_FLOAT_EQ(1.0f, soa_cloud.x()[1]);
+  soa_cloud.push_back(cloud.points[3]);
+  EXPECT_EQ(3u, soa_cloud.size());
+  EXPECT_FLOAT_EQ(1.5f, soa_cloud.point(2).h);
+}
+
+TEST(SoaPointCloudTest, View) {
+  const SoaPointCloud soa_cloud(MakeCloud(6));
+  const SoaPointCloudView all(soa_cloud);
+  EXPECT_FALSE(all.has_indices());
+  ASSERT_EQ(6u, all.size());
+  EXPECT_EQ(3, all.index(3));
+  EXPECT_FLOAT_EQ(6.0f, all.y(3));
+
+  const std::vector<int> indices = {5, 0, 2};
+  const SoaPointCloudView subset(soa_cloud, indices);
+  EXPECT_TRUE(subset.has_indices());
+  ASSERT_EQ(3u, subset.size());
+  EXPECT_EQ(5, subset.index(0));
+  EXPECT_FLOAT_EQ(5.0f, subset.x(0));
+  EXPECT_FLOAT_EQ(-2.0f, subset.z(2));
+  EXPECT_FLOAT_EQ(0.0f, subset.intensity(1));
+
+  PointCloud cloud;
+  subset.ToPcl(&cloud);
+  ASSERT_EQ(3u, cloud.points.size());
+  EXPECT_FLOAT_EQ(50.0f, cloud.points[0].intensity);
+  EXPECT_FLOAT_EQ(1.0f, cloud.points[2].h);
+
+  EXPECT_FALSE(SoaPointCloudView().valid());
+}
+
+}  // namespace pcl_util
+}  // namespace perception
+}  // namespace apollo
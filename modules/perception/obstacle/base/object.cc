@@ -20,6 +20,7 @@
 #include "modules/common/macro.h"
 #include "modules/common/util/string_util.h"
 #include "modules/perception/common/perception_gflags.h"
+#include "modules/perception/lib/base/object_pool.h"
 
 namespace apollo {
 namespace perception {
@@ -28,6 +29,66 @@ using Eigen::Vector3d;
 using apollo::common::util::Print;
 using apollo::common::util::StrCat;
 
+namespace {
+
+// Maximum numbers of idle objects and point clouds kept for the next frames.
+const size_t kObjectPoolCapacity = 4096;
+const size_t kPointCloudPoolCapacity = 4096;
+
+void ResetPointCloud(pcl_util::PointCloud* cloud) {
+  const pcl_util::PointCloud empty_cloud;
+  cloud->clear();
+  cloud->header = empty_cloud.header;
+  cloud->is_dense = empty_cloud.is_dense;
+  cloud->sensor_origin_ = empty_cloud.sensor_origin_;
+  cloud->sensor_orientation_ = empty_cloud.sensor_orientation_;
+}
+
+// Restores the state of Object(), keeping the storage of the containers. The
+// cloud is kept unless it is shared, e.g. by a clone.
+void ResetObject(Object* object) {
+  object->id = 0;
+  if (object->cloud == nullptr || object->cloud.use_count() > 1) {
+    object->cloud = GetPooledPointCloud();
+  } else {
+    ResetPointCloud(object->cloud.get());
+  }
+  object->polygon.clear();
+  object->direction = Vector3d(1, 0, 0);
+  object->theta = 0.0;
+  object->center = Vector3d::Zero();
+  object->length = 0.0;
+  object->width = 0.0;
+  object->height = 0.0;
+  object->shape_features.clear();
+  object->score = 0.0;
+  object->score_type = SCORE_CNN;
+  object->type = UNKNOWN;
+  object->type_probs.assign(MAX_OBJECT_TYPE, 0);
+  object->is_background = false;
+  object->track_id = 0;
+  object->velocity = Vector3d::Zero();
+  object->tracking_time = 0.0;
+  object->latest_tracked_time = 0.0;
+  object->anchor_point = Vector3d::Zero();
+  object->position_uncertainty << 0.01, 0, 0, 0, 0.01, 0, 0, 0, 0.01;
+  object->velocity_uncertainty << 0.01, 0, 0, 0, 0.01, 0, 0, 0, 0.01;
+  object->radar_supplement = nullptr;
+}
+
+}  // namespace
+
+ObjectPtr GetPooledObject() {
+  static ObjectPool<Object> pool(kObjectPoolCapacity, ResetObject);
+  return pool.Get();
+}
+
+pcl_util::PointCloudPtr GetPooledPointCloud() {
+  static ObjectPool<pcl_util::PointCloud, pcl_util::PointCloudPtr> pool(
+      kPointCloudPoolCapacity, ResetPointCloud);
+  return pool.Get();
+}
+
 Object::Object() {
   direction = Vector3d(1, 0, 0);
   center = Vector3d::Zero();
@@ -92,11 +92,21 @@ struct alignas(16) Object {
 
   // sensor particular suplplements, default nullptr
   RadarSupplementPtr radar_supplement = nullptr;
+  // NOTE: a new member must be reset in ResetObject() of object.cc too
 };
 
 typedef std::shared_ptr<Object> ObjectPtr;
 typedef std::shared_ptr<const Object> ObjectConstPtr;
 
+// Gets an object in the state of Object() from a pool of objects recycled
+// across frames, so that steady state processing does not allocate them.
+// Thread safe.
+ObjectPtr GetPooledObject();
+
+// Gets an empty point cloud from a pool of point clouds recycled across
+// frames. Thread safe.
+pcl_util::PointCloudPtr GetPooledPointCloud();
+
 // Sensor single frame objects.
 struct SensorObjects {
   SensorObjects() {
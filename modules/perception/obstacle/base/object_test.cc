@@ -103,6 +103,39 @@ TEST(ObjectTest, test_clone) {
   EXPECT_FLOAT_EQ(obj.latest_tracked_time, obj2.latest_tracked_time);
 }
 
+TEST(ObjectTest, test_GetPooledObject) {
+  ObjectPtr obj = GetPooledObject();
+  ASSERT_TRUE(obj->cloud != nullptr);
+  obj->id = 1;
+  obj->track_id = 2;
+  obj->type = BICYCLE;
+  obj->length = 0.1;
+  obj->shape_features.assign(10, 1.0);
+  obj->cloud->push_back(pcl_util::Point());
+  const Object* address = obj.get();
+  obj.reset();
+
+  // the recycled object is reset
+  obj = GetPooledObject();
+  EXPECT_EQ(address, obj.get());
+  EXPECT_EQ(0, obj->id);
+  EXPECT_EQ(0, obj->track_id);
+  EXPECT_EQ(UNKNOWN, obj->type);
+  EXPECT_FLOAT_EQ(0.0, obj->length);
+  EXPECT_TRUE(obj->shape_features.empty());
+  EXPECT_EQ(0, obj->cloud->size());
+  EXPECT_EQ(MAX_OBJECT_TYPE, obj->type_probs.size());
+
+  // a shared cloud is not reused
+  pcl_util::PointCloudPtr cloud = obj->cloud;
+  cloud->push_back(pcl_util::Point());
+  obj.reset();
+  obj = GetPooledObject();
+  EXPECT_NE(cloud.get(), obj->cloud.get());
+  EXPECT_EQ(0, obj->cloud->size());
+  EXPECT_EQ(1, cloud->size());
+}
+
 TEST(ObjectTest, test_ToString) {
   Object object;
   AINFO << object.ToString();
@@ -20,22 +20,36 @@
 namespace apollo {
 namespace perception {
 
+constexpr std::size_t ObjectSequence::s_max_track_length_;
+
+bool ObjectSequence::Track::Push(double timestamp, const ObjectPtr& object) {
+  if (size_ > 0 && timestamp <= back().timestamp) {
+    return false;
+  }
+  if (size_ == objects_.size()) {
+    PopFront();
+  }
+  TrackedObject& tracked_object = objects_[(begin_ + size_) % objects_.size()];
+  tracked_object.timestamp = timestamp;
+  tracked_object.object = object;
+  ++size_;
+  return true;
+}
+
+void ObjectSequence::Track::PopFront() {
+  // release the object now rather than when the slot is overwritten
+  objects_[begin_].object.reset();
+  begin_ = (begin_ + 1) % objects_.size();
+  --size_;
+}
+
 bool ObjectSequence::AddTrackedFrameObjects(
     const std::vector<ObjectPtr>& objects, double timestamp) {
   std::lock_guard<std::mutex> lock(mutex_);
   for (const auto& obj : objects) {
     int& track_id = obj->track_id;
-    auto iter = sequence_.find(track_id);
-    if (iter == sequence_.end()) {
-      auto res = sequence_.insert(std::make_pair(track_id, TrackedObjects()));
-      if (!res.second) {
-        AERROR << "Fail to insert track.";
-        return false;
-      }
-      iter = res.first;
-    }
-    auto res = iter->second.insert(std::make_pair(timestamp, obj));
-    if (!res.second) {
+    Track& track = sequence_[track_id];
+    if (!track.Push(timestamp, obj)) {
       AERROR << "Fail to insert object.";
       return false;
     }
@@ -58,9 +72,11 @@ bool ObjectSequence::GetTrackInTemporalWindow(int track_id,
   if (iter == sequence_.end()) {
     return false;
   }
-  for (auto& tobj : iter->second) {
-    if (tobj.first >= start_time) {
-      track->insert(tobj);
+  const Track& objects = iter->second;
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    const Track::TrackedObject& tobj = objects.at(i);
+    if (tobj.timestamp >= start_time) {
+      track->insert(track->end(), std::make_pair(tobj.timestamp, tobj.object));
     }
   }
   return true;
@@ -70,17 +86,13 @@ void ObjectSequence::RemoveStaleTracks(double current_stamp) {
   for (auto outer_iter = sequence_.begin(); outer_iter != sequence_.end();) {
     CHECK(outer_iter->second.size() > 0) << "Find empty tracks.";
     auto& track = outer_iter->second;
-    if (current_stamp - track.rbegin()->first > s_max_time_out_) {
+    if (current_stamp - track.back().timestamp > s_max_time_out_) {
       sequence_.erase(outer_iter++);
       continue;
     }
-    for (auto inner_iter = track.begin(); inner_iter != track.end();) {
-      if (current_stamp - inner_iter->first > s_max_time_out_) {
-        track.erase(inner_iter++);
-        continue;
-      } else {
-        break;
-      }
+    while (track.size() > 0 &&
+           current_stamp - track.at(0).timestamp > s_max_time_out_) {
+      track.PopFront();
     }
     if (track.size() == 0) {  // all element removed
       sequence_.erase(outer_iter++);
@@ -65,10 +65,53 @@ class ObjectSequence {
   void RemoveStaleTracks(double current_stamp);
 
  private:
+  /**
+   * @brief The objects of a track in time order, in a ring buffer of fixed
+   * size, the oldest object is overwritten when the buffer is full
+   */
+  class Track {
+   public:
+    struct TrackedObject {
+      double timestamp = 0.0;
+      ObjectPtr object;
+    };
+
+    Track() : objects_(s_max_track_length_) {}
+
+    /**
+     * @brief Add the object of a frame later than the ones in the track
+     * @return True if add successfully, false otherwise
+     */
+    bool Push(double timestamp, const ObjectPtr& object);
+
+    /**
+     * @brief Remove the oldest object
+     */
+    void PopFront();
+
+    /**
+     * @brief Get the i-th object from the oldest one
+     */
+    const TrackedObject& at(std::size_t i) const {
+      return objects_[(begin_ + i) % objects_.size()];
+    }
+
+    const TrackedObject& back() const { return at(size_ - 1); }
+
+    std::size_t size() const { return size_; }
+
+   private:
+    std::vector<TrackedObject> objects_;
+    std::size_t begin_ = 0;
+    std::size_t size_ = 0;
+  };
+
   double current_;
-  std::map<int, TrackedObjects> sequence_;
+  std::map<int, Track> sequence_;
   std::mutex mutex_;
   static constexpr double s_max_time_out_ = 5;  // 5 seconds
+  // 5 seconds of frames at up to 25 Hz
+  static constexpr std::size_t s_max_track_length_ = 128;
 };
 
 }  // namespace perception
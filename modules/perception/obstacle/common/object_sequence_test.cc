@@ -78,5 +78,25 @@ TEST_F(ObjectSequenceTest, TestAddAndGet) {
       sequence_.GetTrackInTemporalWindow(1, &tracked_objects, window_time));
 }
 
+TEST_F(ObjectSequenceTest, TestBoundedTrack) {
+  // the track is longer than its buffer, the oldest objects are dropped
+  std::vector<ObjectPtr> objects(1);
+  for (int i = 0; i < 200; ++i) {
+    objects[0].reset(new Object);
+    objects[0]->track_id = 0;
+    EXPECT_TRUE(sequence_.AddTrackedFrameObjects(objects, i * 0.01));
+  }
+  ObjectSequence::TrackedObjects tracked_objects;
+  EXPECT_TRUE(sequence_.GetTrackInTemporalWindow(0, &tracked_objects, 5.0));
+  EXPECT_EQ(tracked_objects.size(), 128);
+  EXPECT_DOUBLE_EQ(tracked_objects.begin()->first, 0.72);
+  EXPECT_EQ(tracked_objects.rbegin()->second, objects[0]);
+
+  // the timestamps of a track increase
+  EXPECT_FALSE(sequence_.AddTrackedFrameObjects(objects, 1.99));
+  EXPECT_TRUE(sequence_.GetTrackInTemporalWindow(0, &tracked_objects, 0.5));
+  EXPECT_EQ(tracked_objects.size(), 51);
+}
+
 }  // namespace perception
 }  // namespace apollo
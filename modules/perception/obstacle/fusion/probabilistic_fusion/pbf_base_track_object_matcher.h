@@ -20,6 +20,7 @@
 #include <vector>
 #include <string>
 #include "modules/common/macro.h"
+#include "modules/common/util/work_stealing_thread_pool.h"
 #include "modules/perception/obstacle/fusion/probabilistic_fusion/pbf_sensor_object.h"
 #include "modules/perception/obstacle/fusion/probabilistic_fusion/pbf_track.h"
 
@@ -30,6 +31,9 @@ typedef std::pair<int, int> TrackObjectPair;
 
 struct TrackObjectMatcherOptions {
   Eigen::Vector3d *ref_point = nullptr;
+  // the distances and the connected components are computed in parallel by
+  // the pool if it is set, in the calling thread otherwise
+  apollo::common::util::WorkStealingThreadPool *thread_pool = nullptr;
 };
 
 class PbfBaseTrackObjectMatcher {
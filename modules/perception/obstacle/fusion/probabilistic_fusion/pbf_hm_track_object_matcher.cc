@@ -51,7 +51,7 @@ bool PbfHmTrackObjectMatcher::Match(
   const Eigen::Vector3d &ref_point = *(options.ref_point);
   ComputeAssociationMat(fusion_tracks, sensor_objects,
                         *unassigned_fusion_tracks, *unassigned_sensor_objects,
-                        ref_point, &association_mat);
+                        ref_point, options.thread_pool, &association_mat);
 
   int num_track = fusion_tracks.size();
   int num_measurement = sensor_objects.size();
@@ -77,8 +77,8 @@ bool PbfHmTrackObjectMatcher::Match(
     return true;
   }
 
-  bool state = HmAssign(association_mat, assignments, unassigned_fusion_tracks,
-                        unassigned_sensor_objects);
+  bool state = HmAssign(association_mat, options.thread_pool, assignments,
+                        unassigned_fusion_tracks, unassigned_sensor_objects);
 
   for (size_t i = 0; i < assignments->size(); i++) {
     int track_ind = (*assignments)[i].first;
@@ -137,13 +137,16 @@ void PbfHmTrackObjectMatcher::ComputeAssociationMat(
     const std::vector<int> &unassigned_fusion_tracks,
     const std::vector<int> &unassigned_sensor_objects,
     const Eigen::Vector3d &ref_point,
+    apollo::common::util::WorkStealingThreadPool *thread_pool,
     std::vector<std::vector<double>> *association_mat) {
-  PbfTrackObjectDistance pbf_distance;
-  Eigen::Vector3d local_ref_point = ref_point;
-  TrackObjectDistanceOptions options;
-  options.ref_point = &local_ref_point;
   association_mat->resize(unassigned_fusion_tracks.size());
-  for (size_t i = 0; i < unassigned_fusion_tracks.size(); ++i) {
+  // the minimum distances of the unassigned tracks and objects are taken
+  // over the whole matrix, so every pair is computed
+  auto compute_row = [&](const size_t i) {
+    PbfTrackObjectDistance pbf_distance;
+    Eigen::Vector3d local_ref_point = ref_point;
+    TrackObjectDistanceOptions options;
+    options.ref_point = &local_ref_point;
     int fusion_idx = unassigned_fusion_tracks[i];
     (*association_mat)[i].resize(unassigned_sensor_objects.size());
     const PbfTrackPtr &fusion_track = fusion_tracks[fusion_idx];
@@ -155,6 +158,13 @@ void PbfHmTrackObjectMatcher::ComputeAssociationMat(
       ADEBUG << "sensor distance:" << distance;
       (*association_mat)[i][j] = distance;
     }
+  };
+  if (thread_pool == nullptr) {
+    for (size_t i = 0; i < unassigned_fusion_tracks.size(); ++i) {
+      compute_row(i);
+    }
+  } else {
+    thread_pool->ParallelFor(0, unassigned_fusion_tracks.size(), compute_row);
   }
 
   // AINFO << "association matrix :";
@@ -174,6 +184,7 @@ void PbfHmTrackObjectMatcher::ComputeAssociationMat(
 
 bool PbfHmTrackObjectMatcher::HmAssign(
     const std::vector<std::vector<double>> &association_mat,
+    apollo::common::util::WorkStealingThreadPool *thread_pool,
     std::vector<TrackObjectPair> *assignments,
     std::vector<int> *unassigned_fusion_tracks,
     std::vector<int> *unassigned_sensor_objects) {
@@ -187,59 +198,31 @@ bool PbfHmTrackObjectMatcher::HmAssign(
     AERROR << "fusion component size it not equal to sensor component size.";
     return false;
   }
-  for (size_t i = 0; i < fusion_components.size(); ++i) {
-    if (fusion_components[i].empty() || sensor_components[i].empty()) {
-      continue;
-    } else if (fusion_components[i].size() == 1 &&
-               sensor_components[i].size() == 1) {
-      int idx_f = fusion_components[i][0];
-      int idx_s = sensor_components[i][0];
-      if (association_mat[idx_f][idx_s] < max_dist) {
-        auto assignment = std::make_pair((*unassigned_fusion_tracks)[idx_f],
-                                         (*unassigned_sensor_objects)[idx_s]);
-        assignments->push_back(assignment);
-        (*unassigned_fusion_tracks)[idx_f] = -1;
-        (*unassigned_sensor_objects)[idx_s] = -1;
-      }
-      continue;
-    }
-
-    std::vector<std::vector<double>> loc_mat;
-    std::vector<int> fusion_l2g;
-    std::vector<int> sensor_l2g;
-    fusion_l2g.resize(fusion_components[i].size());
-    sensor_l2g.resize(sensor_components[i].size());
-    loc_mat.resize(fusion_components[i].size());
-    for (size_t j = 0; j < fusion_components[i].size(); ++j) {
-      loc_mat[j].resize(sensor_components[i].size());
-      fusion_l2g[j] = fusion_components[i][j];
-      for (size_t k = 0; k < sensor_components[i].size(); ++k) {
-        if (j == 0) {
-          sensor_l2g[k] = sensor_components[i][k];
-        }
-        loc_mat[j][k] =
-            association_mat[fusion_components[i][j]][sensor_components[i][k]];
-      }
-    }
-
-    std::vector<int> fusion_idxs;
-    std::vector<int> sensor_idxs;
-    if (loc_mat.size() != 0 && loc_mat[0].size() != 0) {
-      MinimizeAssignment(loc_mat, &fusion_idxs, &sensor_idxs);
+  // the components share no track or object, so they are matched
+  // independently, each into its own list of matrix indices
+  std::vector<std::vector<std::pair<int, int>>> component_assignments(
+      fusion_components.size());
+  auto match_component = [&](const size_t i) {
+    MatchComponent(association_mat, fusion_components[i],
+                   sensor_components[i], max_dist, &component_assignments[i]);
+  };
+  if (thread_pool == nullptr) {
+    for (size_t i = 0; i < fusion_components.size(); ++i) {
+      match_component(i);
     }
+  } else {
+    thread_pool->ParallelFor(0, fusion_components.size(), match_component);
+  }
 
-    for (size_t j = 0; j < fusion_idxs.size(); ++j) {
-      int f_idx = fusion_idxs[j];
-      int s_idx = sensor_idxs[j];
-      if (loc_mat[f_idx][s_idx] < max_dist) {
-        int gf_idx = fusion_l2g[f_idx];
-        int gs_idx = sensor_l2g[s_idx];
-        auto assignment = std::make_pair((*unassigned_fusion_tracks)[gf_idx],
-                                         (*unassigned_sensor_objects)[gs_idx]);
-        assignments->push_back(assignment);
-        (*unassigned_fusion_tracks)[gf_idx] = -1;
-        (*unassigned_sensor_objects)[gs_idx] = -1;
-      }
+  for (const auto &component_assignment : component_assignments) {
+    for (const auto &pair : component_assignment) {
+      int gf_idx = pair.first;
+      int gs_idx = pair.second;
+      auto assignment = std::make_pair((*unassigned_fusion_tracks)[gf_idx],
+                                       (*unassigned_sensor_objects)[gs_idx]);
+      assignments->push_back(assignment);
+      (*unassigned_fusion_tracks)[gf_idx] = -1;
+      (*unassigned_sensor_objects)[gs_idx] = -1;
     }
   }
 
@@ -263,6 +246,45 @@ bool PbfHmTrackObjectMatcher::HmAssign(
   return true;
 }
 
+void PbfHmTrackObjectMatcher::MatchComponent(
+    const std::vector<std::vector<double>> &association_mat,
+    const std::vector<int> &fusion_component,
+    const std::vector<int> &sensor_component, double max_dist,
+    std::vector<std::pair<int, int>> *component_assignments) {
+  if (fusion_component.empty() || sensor_component.empty()) {
+    return;
+  } else if (fusion_component.size() == 1 && sensor_component.size() == 1) {
+    int idx_f = fusion_component[0];
+    int idx_s = sensor_component[0];
+    if (association_mat[idx_f][idx_s] < max_dist) {
+      component_assignments->push_back(std::make_pair(idx_f, idx_s));
+    }
+    return;
+  }
+
+  std::vector<std::vector<double>> loc_mat;
+  loc_mat.resize(fusion_component.size());
+  for (size_t j = 0; j < fusion_component.size(); ++j) {
+    loc_mat[j].resize(sensor_component.size());
+    for (size_t k = 0; k < sensor_component.size(); ++k) {
+      loc_mat[j][k] = association_mat[fusion_component[j]][sensor_component[k]];
+    }
+  }
+
+  std::vector<int> fusion_idxs;
+  std::vector<int> sensor_idxs;
+  MinimizeAssignment(loc_mat, &fusion_idxs, &sensor_idxs);
+
+  for (size_t j = 0; j < fusion_idxs.size(); ++j) {
+    int f_idx = fusion_idxs[j];
+    int s_idx = sensor_idxs[j];
+    if (loc_mat[f_idx][s_idx] < max_dist) {
+      component_assignments->push_back(
+          std::make_pair(fusion_component[f_idx], sensor_component[s_idx]));
+    }
+  }
+}
+
 void PbfHmTrackObjectMatcher::MinimizeAssignment(
     const std::vector<std::vector<double>> &association_mat,
     std::vector<int> *ref_idx, std::vector<int> *new_idx) {
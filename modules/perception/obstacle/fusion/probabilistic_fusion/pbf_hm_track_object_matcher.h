@@ -55,11 +55,25 @@ class PbfHmTrackObjectMatcher : public PbfBaseTrackObjectMatcher {
       const std::vector<int> &unassigned_fusion_tracks,
       const std::vector<int> &unassigned_sensor_objects,
       const Eigen::Vector3d &ref_point,
+      apollo::common::util::WorkStealingThreadPool *thread_pool,
       std::vector<std::vector<double>> *association_mat);
   bool HmAssign(const std::vector<std::vector<double>> &association_mat,
+                apollo::common::util::WorkStealingThreadPool *thread_pool,
                 std::vector<TrackObjectPair> *assignments,
                 std::vector<int> *unassigned_fusion_tracks,
                 std::vector<int> *unassigned_sensor_objects);
+  // @brief match the tracks and the objects of a connected component
+  // @params[IN] association_mat: distances of the unassigned tracks (rows)
+  // and objects (columns)
+  // @params[IN] fusion_component: rows of the component
+  // @params[IN] sensor_component: columns of the component
+  // @params[IN] max_dist: distance from which a pair is not matched
+  // @params[OUT] component_assignments: matched rows and columns
+  void MatchComponent(const std::vector<std::vector<double>> &association_mat,
+                      const std::vector<int> &fusion_component,
+                      const std::vector<int> &sensor_component,
+                      double max_dist,
+                      std::vector<std::pair<int, int>> *component_assignments);
   void MinimizeAssignment(
       const std::vector<std::vector<double>> &association_mat,
       std::vector<int> *ref_idx, std::vector<int> *new_idx);
@@ -17,6 +17,7 @@
 
 #include "modules/perception/obstacle/fusion/probabilistic_fusion/pbf_sensor.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -30,30 +31,41 @@ PbfSensor::PbfSensor(const SensorType &type, const std::string &sensor_id)
 
 PbfSensor::~PbfSensor() {}
 
+size_t PbfSensor::UpperBound(double time_stamp) const {
+  size_t first = 0;
+  size_t count = num_frames_;
+  while (count > 0) {
+    const size_t step = count / 2;
+    if (Frame(first + step)->timestamp <= time_stamp) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  return first;
+}
+
 void PbfSensor::QueryLatestFrames(double time_stamp,
                                   std::vector<PbfSensorFramePtr> *frames) {
   if (frames == nullptr) {
     return;
   }
   frames->clear();
-  for (size_t i = 0; i < frames_.size(); i++) {
-    if (frames_[i]->timestamp > latest_query_timestamp_ &&
-        frames_[i]->timestamp <= time_stamp) {
-      (*frames).push_back(frames_[i]);
-    }
+  const size_t end = UpperBound(time_stamp);
+  for (size_t i = UpperBound(latest_query_timestamp_); i < end; i++) {
+    frames->push_back(Frame(i));
   }
   latest_query_timestamp_ = time_stamp;
 }
 
 PbfSensorFramePtr PbfSensor::QueryLatestFrame(double time_stamp) {
-  PbfSensorFramePtr latest_frame = nullptr;
-  for (size_t i = 0; i < frames_.size(); i++) {
-    if (frames_[i]->timestamp > latest_query_timestamp_ &&
-        frames_[i]->timestamp <= time_stamp) {
-      latest_frame = frames_[i];
-      latest_query_timestamp_ = frames_[i]->timestamp;
-    }
+  const size_t end = UpperBound(time_stamp);
+  if (end == 0 || Frame(end - 1)->timestamp <= latest_query_timestamp_) {
+    return nullptr;
   }
+  const PbfSensorFramePtr &latest_frame = Frame(end - 1);
+  latest_query_timestamp_ = latest_frame->timestamp;
   return latest_frame;
 }
 
@@ -68,17 +80,39 @@ void PbfSensor::AddFrame(const SensorObjects &frame) {
 
   pbf_frame->objects.resize(frame.objects.size());
   for (size_t i = 0; i < frame.objects.size(); i++) {
-    PbfSensorObjectPtr obj(new PbfSensorObject());
-    obj->timestamp = frame.timestamp;
-    obj->sensor_type = frame.sensor_type;
-    obj->object->clone(*(frame.objects[i]));
-    obj->sensor_id = GetSensorType(frame.sensor_type);
+    // a shallow copy, the point cloud is shared with the sensor object
+    ObjectPtr object = GetPooledObject();
+    *object = *(frame.objects[i]);
+    PbfSensorObjectPtr obj(
+        new PbfSensorObject(object, frame.sensor_type, frame.timestamp));
+    obj->sensor_id = pbf_frame->sensor_id;
     pbf_frame->objects[i] = obj;
   }
-  if (frames_.size() > s_max_cached_frame_number_) {
-    frames_.pop_front();
+
+  // the ring is rebuilt when the max cached frame number changes
+  const size_t capacity = s_max_cached_frame_number_ + 1;
+  if (frames_.size() != capacity) {
+    std::vector<PbfSensorFramePtr> frames(capacity);
+    const size_t num_kept = std::min(num_frames_, capacity - 1);
+    for (size_t i = 0; i < num_kept; i++) {
+      frames[i] = Frame(num_frames_ - num_kept + i);
+    }
+    frames_.swap(frames);
+    first_frame_ = 0;
+    num_frames_ = num_kept;
+  }
+  if (num_frames_ == capacity) {
+    frames_[first_frame_].reset();
+    first_frame_ = (first_frame_ + 1) % capacity;
+    num_frames_--;
   }
-  frames_.push_back(pbf_frame);
+
+  // frames come in time order, an older one is moved to its place
+  size_t i = num_frames_++;
+  for (; i > 0 && Frame(i - 1)->timestamp > pbf_frame->timestamp; i--) {
+    frames_[(first_frame_ + i) % capacity] = Frame(i - 1);
+  }
+  frames_[(first_frame_ + i) % capacity] = pbf_frame;
 }
 
 bool PbfSensor::GetPose(double time_stamp, Eigen::Matrix4d *pose) {
@@ -87,12 +121,17 @@ bool PbfSensor::GetPose(double time_stamp, Eigen::Matrix4d *pose) {
     return false;
   }
 
-  for (int i = frames_.size() - 1; i >= 0; i--) {
-    double time_diff = time_stamp - frames_[i]->timestamp;
-    if (fabs(time_diff) < 1.0e-3) {
-      *pose = frames_[i]->sensor2world_pose;
+  // the latest frame within the time tolerance
+  const double kTimeTolerance = 1.0e-3;
+  for (size_t i = UpperBound(time_stamp + kTimeTolerance); i > 0; i--) {
+    double time_diff = time_stamp - Frame(i - 1)->timestamp;
+    if (fabs(time_diff) < kTimeTolerance) {
+      *pose = Frame(i - 1)->sensor2world_pose;
       return true;
     }
+    if (time_diff >= kTimeTolerance) {
+      break;
+    }
   }
   AERROR << "Failed to find velodyne2world pose for timestamp: " << time_stamp;
 
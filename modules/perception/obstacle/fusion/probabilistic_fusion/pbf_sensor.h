@@ -16,7 +16,6 @@
 
 #ifndef MODULES_PERCEPTION_OBSTACLE_FUSION_PROBABILISTIC_FUSION_PBF_SENSOR_H_
 #define MODULES_PERCEPTION_OBSTACLE_FUSION_PROBABILISTIC_FUSION_PBF_SENSOR_H_
-#include <deque>
 #include <string>
 #include <vector>
 #include "modules/common/log.h"
@@ -41,7 +40,8 @@ class PbfSensor {
    * (_latest_fused_time_stamp, time_stamp]*/
   PbfSensorFramePtr QueryLatestFrame(double time_stamp);
 
-  /**@brief add a frame objects*/
+  /**@brief add a frame objects, sharing their point clouds and radar
+   * supplements, which are not modified once published*/
   void AddFrame(const SensorObjects &frame);
 
   /**@brief query pose at time_stamp, return false if not found*/
@@ -52,8 +52,23 @@ class PbfSensor {
   }
 
  protected:
-  /**@brief cached frames in FIFO*/
-  std::deque<PbfSensorFramePtr> frames_;
+  /**@brief number of cached frames*/
+  size_t NumFrames() const { return num_frames_; }
+
+  /**@brief i-th cached frame, in time stamp order*/
+  const PbfSensorFramePtr &Frame(size_t i) const {
+    return frames_[(first_frame_ + i) % frames_.size()];
+  }
+
+  /**@brief index of the first cached frame whose time stamp is greater than
+   * time_stamp, NumFrames() if none*/
+  size_t UpperBound(double time_stamp) const;
+
+  /**@brief cached frames in a ring, sorted by time stamp, of capacity
+   * s_max_cached_frame_number_ + 1*/
+  std::vector<PbfSensorFramePtr> frames_;
+  size_t first_frame_ = 0;
+  size_t num_frames_ = 0;
 
   std::string sensor_id_;
   SensorType sensor_type_;
@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/fusion/probabilistic_fusion/pbf_sensor.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace apollo {
+namespace perception {
+
+namespace {
+
+SensorObjects MakeFrame(double timestamp) {
+  SensorObjects frame;
+  frame.timestamp = timestamp;
+  frame.sensor_type = VELODYNE_64;
+  frame.sensor2world_pose = Eigen::Matrix4d::Identity();
+  frame.sensor2world_pose(0, 3) = timestamp;
+  ObjectPtr obj(new Object());
+  obj->id = static_cast<int>(timestamp);
+  frame.objects.push_back(obj);
+  return frame;
+}
+
+}  // namespace
+
+TEST(PbfSensorTest, QueryFrames) {
+  PbfSensor::SetMaxCachedFrameNumber(3);
+  PbfSensor sensor(VELODYNE_64, GetSensorType(VELODYNE_64));
+  // the frame 3.0 comes late, the frame 1.0 is dropped out of the ring
+  for (double timestamp : {1.0, 2.0, 4.0, 5.0, 3.0}) {
+    sensor.AddFrame(MakeFrame(timestamp));
+  }
+
+  Eigen::Matrix4d pose;
+  EXPECT_FALSE(sensor.GetPose(1.0, &pose));
+  EXPECT_TRUE(sensor.GetPose(3.0005, &pose));
+  EXPECT_DOUBLE_EQ(3.0, pose(0, 3));
+  EXPECT_FALSE(sensor.GetPose(4.5, &pose));
+
+  std::vector<PbfSensorFramePtr> frames;
+  sensor.QueryLatestFrames(4.0, &frames);
+  ASSERT_EQ(3, frames.size());
+  EXPECT_DOUBLE_EQ(2.0, frames[0]->timestamp);
+  EXPECT_DOUBLE_EQ(3.0, frames[1]->timestamp);
+  EXPECT_DOUBLE_EQ(4.0, frames[2]->timestamp);
+  sensor.QueryLatestFrames(4.5, &frames);
+  EXPECT_TRUE(frames.empty());
+
+  PbfSensorFramePtr frame = sensor.QueryLatestFrame(10.0);
+  ASSERT_TRUE(frame != nullptr);
+  EXPECT_DOUBLE_EQ(5.0, frame->timestamp);
+  EXPECT_TRUE(sensor.QueryLatestFrame(10.0) == nullptr);
+  PbfSensor::SetMaxCachedFrameNumber(10);
+}
+
+TEST(PbfSensorTest, SharedPointCloud) {
+  PbfSensor::SetMaxCachedFrameNumber(1);
+  PbfSensor sensor(VELODYNE_64, GetSensorType(VELODYNE_64));
+  SensorObjects frame = MakeFrame(1.0);
+  sensor.AddFrame(frame);
+  PbfSensorFramePtr pbf_frame = sensor.QueryLatestFrame(1.0);
+  ASSERT_TRUE(pbf_frame != nullptr);
+  ASSERT_EQ(1, pbf_frame->objects.size());
+  const ObjectPtr &object = pbf_frame->objects[0]->object;
+  EXPECT_NE(frame.objects[0], object);
+  EXPECT_EQ(1, object->id);
+  EXPECT_EQ(frame.objects[0]->cloud, object->cloud);
+  EXPECT_EQ(VELODYNE_64, pbf_frame->objects[0]->sensor_type);
+  EXPECT_DOUBLE_EQ(1.0, pbf_frame->objects[0]->timestamp);
+  PbfSensor::SetMaxCachedFrameNumber(10);
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -30,6 +30,7 @@ PbfTrackManager::PbfTrackManager() {}
 PbfTrackManager::~PbfTrackManager() {}
 
 int PbfTrackManager::RemoveLostTracks() {
+  MutexLock lock(&mutex_);
   size_t track_count = 0;
   for (size_t i = 0; i < tracks_.size(); i++) {
     if (!tracks_[i]->IsDead()) {
@@ -19,11 +19,16 @@
 
 #include <vector>
 #include "modules/common/macro.h"
+#include "modules/perception/lib/base/mutex.h"
 #include "modules/perception/obstacle/fusion/probabilistic_fusion/pbf_track.h"
 
 namespace apollo {
 namespace perception {
 
+// The list of tracks is guarded by the mutex of the manager, which is held
+// only to add or remove tracks. The tracks themselves are not guarded: the
+// fusion updates them from the list got by GetTracks(), each track by a
+// single thread, and no track is added or removed meanwhile.
 class PbfTrackManager {
  public:
   static PbfTrackManager *instance();
@@ -38,13 +43,21 @@ class PbfTrackManager {
   }
 
   void AddTrack(const PbfTrackPtr &track) {
+    MutexLock lock(&mutex_);
     tracks_.push_back(track);
   }
 
+  void AddTracks(const std::vector<PbfTrackPtr> &tracks) {
+    MutexLock lock(&mutex_);
+    tracks_.insert(tracks_.end(), tracks.begin(), tracks.end());
+  }
+
   int RemoveLostTracks();
 
  protected:
   std::vector<PbfTrackPtr> tracks_;
+  Mutex mutex_;
+
  private:
   PbfTrackManager();
   DISALLOW_COPY_AND_ASSIGN(PbfTrackManager);
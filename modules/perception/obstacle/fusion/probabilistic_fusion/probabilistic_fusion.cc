@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 #include "modules/common/macro.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/obstacle/fusion/probabilistic_fusion/pbf_base_track_object_matcher.h"
 #include "modules/perception/obstacle/fusion/probabilistic_fusion/pbf_hm_track_object_matcher.h"
@@ -155,6 +156,10 @@ bool ProbabilisticFusion::Init() {
     AERROR << "use_lidar not found";
   }
   AINFO << "use_lidar:" << use_lidar_;
+  if (FLAGS_pbf_fusion_num_threads > 0) {
+    thread_pool_.reset(new apollo::common::util::WorkStealingThreadPool(
+        FLAGS_pbf_fusion_num_threads));
+  }
   AINFO << "ProbabilisticFusion initialize successfully";
   return true;
 }
@@ -243,11 +248,13 @@ void ProbabilisticFusion::FuseFrame(const PbfSensorFramePtr &frame) {
 void ProbabilisticFusion::CreateNewTracks(
     const std::vector<PbfSensorObjectPtr> &sensor_objects,
     const std::vector<int> &unassigned_ids) {
+  std::vector<PbfTrackPtr> new_tracks;
+  new_tracks.reserve(unassigned_ids.size());
   for (size_t i = 0; i < unassigned_ids.size(); i++) {
     int id = unassigned_ids[i];
-    PbfTrackPtr track(new PbfTrack(sensor_objects[id]));
-    track_manager_->AddTrack(track);
+    new_tracks.push_back(PbfTrackPtr(new PbfTrack(sensor_objects[id])));
   }
+  track_manager_->AddTracks(new_tracks);
 }
 
 void ProbabilisticFusion::UpdateAssignedTracks(
@@ -255,11 +262,20 @@ void ProbabilisticFusion::UpdateAssignedTracks(
     const std::vector<PbfSensorObjectPtr> &sensor_objects,
     const std::vector<TrackObjectPair> &assignments,
     const std::vector<double> &track_object_dist) {
-  for (size_t i = 0; i < assignments.size(); i++) {
+  // each track is assigned at most one object, so the tracks are updated
+  // independently
+  auto update_track = [&](const size_t i) {
     int local_track_index = assignments[i].first;
     int local_obj_index = assignments[i].second;
     (*tracks)[local_track_index]->UpdateWithSensorObject(
         sensor_objects[local_obj_index], track_object_dist[local_track_index]);
+  };
+  if (thread_pool_ == nullptr) {
+    for (size_t i = 0; i < assignments.size(); i++) {
+      update_track(i);
+    }
+  } else {
+    thread_pool_->ParallelFor(0, assignments.size(), update_track);
   }
 }
 
@@ -267,11 +283,18 @@ void ProbabilisticFusion::UpdateUnassignedTracks(
     std::vector<PbfTrackPtr> *tracks, const std::vector<int> &unassigned_tracks,
     const std::vector<double> &track_object_dist, const SensorType &sensor_type,
     const std::string &sensor_id, double timestamp) {
-  for (size_t i = 0; i < unassigned_tracks.size(); i++) {
+  auto update_track = [&](const size_t i) {
     int local_track_index = unassigned_tracks[i];
     (*tracks)[local_track_index]->UpdateWithoutSensorObject(
         sensor_type, sensor_id, track_object_dist[local_track_index],
         timestamp);
+  };
+  if (thread_pool_ == nullptr) {
+    for (size_t i = 0; i < unassigned_tracks.size(); i++) {
+      update_track(i);
+    }
+  } else {
+    thread_pool_->ParallelFor(0, unassigned_tracks.size(), update_track);
   }
 }
 
@@ -329,6 +352,7 @@ void ProbabilisticFusion::FuseForegroundObjects(
 
   TrackObjectMatcherOptions options;
   options.ref_point = &ref_point;
+  options.thread_pool = thread_pool_.get();
 
   std::vector<double> track2measurements_dist;
   std::vector<double> measurement2tracks_dist;
@@ -16,9 +16,11 @@
 
 #ifndef MODULES_PERCEPTION_OBSTACLE_FUSION_PROBABILISTIC_FUSION_PROBABILISTIC_FUSION_H_ // NOLINT
 #define MODULES_PERCEPTION_OBSTACLE_FUSION_PROBABILISTIC_FUSION_PROBABILISTIC_FUSION_H_ // NOLINT
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
+#include "modules/common/util/work_stealing_thread_pool.h"
 #include "modules/perception/obstacle/base/object.h"
 #include "modules/perception/obstacle/fusion/interface/base_fusion.h"
 #include "modules/perception/obstacle/fusion/probabilistic_fusion/pbf_base_track_object_matcher.h"
@@ -91,6 +93,9 @@ class ProbabilisticFusion : public BaseFusion {
   std::mutex fusion_mutex_;
   bool use_radar_;
   bool use_lidar_;
+  // matches and updates the tracks in parallel, null when
+  // FLAGS_pbf_fusion_num_threads is 0
+  std::unique_ptr<apollo::common::util::WorkStealingThreadPool> thread_pool_;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(ProbabilisticFusion);
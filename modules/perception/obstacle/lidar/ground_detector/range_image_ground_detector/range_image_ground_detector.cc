@@ -0,0 +1,166 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/lidar/ground_detector/range_image_ground_detector/range_image_ground_detector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "modules/common/log.h"
+#include "modules/perception/lib/config_manager/config_manager.h"
+
+namespace apollo {
+namespace perception {
+
+namespace {
+constexpr double kDegToRad = M_PI / 180.0;
+}  // namespace
+
+bool RangeImageGroundDetector::Init() {
+  const ModelConfig* model_config = nullptr;
+  if (!ConfigManager::instance()->GetModelConfig(name(), &model_config)) {
+    AERROR << "Failed to get model: " << name();
+    return false;
+  }
+  const std::pair<const char*, double*> params[] = {
+      {"azimuth_resolution", &azimuth_resolution_},
+      {"range_resolution", &range_resolution_},
+      {"max_range", &max_range_},
+      {"sensor_height", &sensor_height_},
+      {"max_local_slope", &max_local_slope_},
+      {"max_global_slope", &max_global_slope_},
+      {"local_height_tolerance", &local_height_tolerance_},
+      {"ground_height_threshold", &ground_height_threshold_}};
+  for (const auto& param : params) {
+    if (!model_config->GetValue(param.first, param.second)) {
+      AERROR << "Can not find " << param.first << " in model: " << name();
+      return false;
+    }
+  }
+  return InitRangeImage();
+}
+
+bool RangeImageGroundDetector::InitRangeImage() {
+  if (azimuth_resolution_ <= 0.0 || range_resolution_ <= 0.0 ||
+      max_range_ < range_resolution_) {
+    AERROR << "Invalid range image: azimuth_resolution " << azimuth_resolution_
+           << ", range_resolution " << range_resolution_ << ", max_range "
+           << max_range_;
+    return false;
+  }
+  num_cols_ = static_cast<int>(std::ceil(360.0 / azimuth_resolution_));
+  num_rows_ = static_cast<int>(std::ceil(max_range_ / range_resolution_));
+  inv_azimuth_resolution_ =
+      static_cast<float>(1.0 / (azimuth_resolution_ * kDegToRad));
+  inv_range_resolution_ = static_cast<float>(1.0 / range_resolution_);
+  tan_local_slope_ = static_cast<float>(std::tan(max_local_slope_ * kDegToRad));
+  tan_global_slope_ =
+      static_cast<float>(std::tan(max_global_slope_ * kDegToRad));
+
+  const size_t num_cells = static_cast<size_t>(num_cols_) * num_rows_;
+  cell_min_z_.resize(num_cells);
+  cell_min_range_.resize(num_cells);
+  cell_ground_z_.resize(num_cells);
+  return true;
+}
+
+bool RangeImageGroundDetector::Detect(
+    const GroundDetectorOptions& options, pcl_util::PointCloudPtr cloud,
+    pcl_util::PointIndicesPtr non_ground_indices) {
+  if (num_cols_ <= 0 || num_rows_ <= 0) {
+    AERROR << name() << " is not initialized.";
+    return false;
+  }
+  auto& points = cloud->points;
+  const size_t num_points = points.size();
+
+  // the cell and the range of each point; the points are independent
+  point_cells_.resize(num_points);
+  point_ranges_.resize(num_points);
+  const int last_col = num_cols_ - 1;
+  const int last_row = num_rows_ - 1;
+  const float inv_azimuth_resolution = inv_azimuth_resolution_;
+  const float inv_range_resolution = inv_range_resolution_;
+  for (size_t i = 0; i < num_points; ++i) {
+    const float x = points[i].x;
+    const float y = points[i].y;
+    const float range = std::sqrt(x * x + y * y);
+    int col = static_cast<int>((std::atan2(y, x) + static_cast<float>(M_PI)) *
+                               inv_azimuth_resolution);
+    int row = static_cast<int>(range * inv_range_resolution);
+    col = std::min(std::max(col, 0), last_col);
+    row = std::min(row, last_row);
+    point_ranges_[i] = range;
+    point_cells_[i] = col * num_rows_ + row;
+  }
+
+  // the lowest point of each cell is its ground candidate
+  std::fill(cell_min_z_.begin(), cell_min_z_.end(),
+            std::numeric_limits<float>::max());
+  for (size_t i = 0; i < num_points; ++i) {
+    const int cell = point_cells_[i];
+    if (points[i].z < cell_min_z_[cell]) {
+      cell_min_z_[cell] = points[i].z;
+      cell_min_range_[cell] = point_ranges_[i];
+    }
+  }
+
+  // each sector is walked outwards from the lidar: a candidate is ground if
+  // it is on a gentle slope from the last ground of the sector and from the
+  // ground below the lidar, otherwise the last ground goes on under it
+  const float origin_z = static_cast<float>(-sensor_height_);
+  const float local_tolerance = static_cast<float>(local_height_tolerance_);
+  const float ground_threshold = static_cast<float>(ground_height_threshold_);
+  for (int col = 0; col < num_cols_; ++col) {
+    float last_range = 0.0f;
+    float last_z = origin_z;
+    const int first_cell = col * num_rows_;
+    for (int cell = first_cell; cell < first_cell + num_rows_; ++cell) {
+      const float z = cell_min_z_[cell];
+      if (z != std::numeric_limits<float>::max()) {
+        const float range = cell_min_range_[cell];
+        const bool local_ok =
+            std::fabs(z - last_z) <=
+            (range - last_range) * tan_local_slope_ + local_tolerance;
+        const bool global_ok = std::fabs(z - origin_z) <=
+                               range * tan_global_slope_ + ground_threshold;
+        if (local_ok && global_ok) {
+          last_range = range;
+          last_z = z;
+        }
+      }
+      cell_ground_z_[cell] = last_z;
+    }
+  }
+
+  non_ground_indices->indices.clear();
+  non_ground_indices->indices.reserve(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    const float height = points[i].z - cell_ground_z_[point_cells_[i]];
+    points[i].h = height;
+    if (height > ground_threshold) {
+      non_ground_indices->indices.push_back(static_cast<int>(i));
+    }
+  }
+  ADEBUG << name() << ": " << non_ground_indices->indices.size() << " of "
+         << num_points << " points are above the ground.";
+  return true;
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_OBSTACLE_LIDAR_GROUND_DETECTOR_RANGE_IMAGE_GROUND_DETECTOR_RANGE_IMAGE_GROUND_DETECTOR_H_  // NOLINT
+#define MODULES_PERCEPTION_OBSTACLE_LIDAR_GROUND_DETECTOR_RANGE_IMAGE_GROUND_DETECTOR_RANGE_IMAGE_GROUND_DETECTOR_H_  // NOLINT
+
+#include <string>
+#include <vector>
+
+#include "modules/common/macro.h"
+#include "modules/perception/lib/pcl_util/pcl_types.h"
+#include "modules/perception/obstacle/lidar/interface/base_ground_detector.h"
+
+namespace apollo {
+namespace perception {
+
+/**
+ * @class RangeImageGroundDetector
+ * @brief A ground detector on a polar range image of the cloud, in the
+ * lidar frame: the columns are azimuth sectors and the rows range bins. The
+ * lowest point of each cell is a ground candidate, accepted when its slope
+ * from the ground of the previous cell along the sector and from the ground
+ * below the lidar are small enough. The points close enough above the
+ * ground of their cell are ground points. The ground height of each point is
+ * stored in its h field. It takes a pass over the points and a pass over the
+ * cells, with flat arrays for the per-point state.
+ */
+class RangeImageGroundDetector : public BaseGroundDetector {
+ public:
+  RangeImageGroundDetector() : BaseGroundDetector() {}
+  ~RangeImageGroundDetector() = default;
+
+  bool Init() override;
+
+  /**
+   * @params[In] options: not used.
+   * @params[In/Out] cloud: the points in the lidar frame, whose h is set to
+   * their height above the ground.
+   * @params[Out] non_ground_indices: the indices of the points above the
+   * ground.
+   * @return true if the ground is detected successfully.
+   */
+  bool Detect(const GroundDetectorOptions &options,
+              pcl_util::PointCloudPtr cloud,
+              pcl_util::PointIndicesPtr non_ground_indices) override;
+
+  std::string name() const override { return "RangeImageGroundDetector"; }
+
+ protected:
+  // Sets up the range image from the parameters.
+  bool InitRangeImage();
+
+  // the size of the azimuth sectors, in degrees
+  double azimuth_resolution_ = 0.5;
+  // the size of the range bins and the range of the image, in meters; the
+  // points beyond it are in the last bin
+  double range_resolution_ = 0.5;
+  double max_range_ = 80.0;
+  // the height of the lidar above the ground, in meters
+  double sensor_height_ = 1.9;
+  // the slope of the ground between neighbouring cells, and from below the
+  // lidar, in degrees
+  double max_local_slope_ = 8.0;
+  double max_global_slope_ = 5.0;
+  // the height change allowed between neighbouring cells beyond the slope,
+  // for the noise, in meters
+  double local_height_tolerance_ = 0.1;
+  // the points up to this height above the ground are ground points
+  double ground_height_threshold_ = 0.25;
+
+ private:
+  int num_cols_ = 0;
+  int num_rows_ = 0;
+  float inv_azimuth_resolution_ = 0.0f;
+  float inv_range_resolution_ = 0.0f;
+  float tan_local_slope_ = 0.0f;
+  float tan_global_slope_ = 0.0f;
+
+  // the cell and the range of each point
+  std::vector<int> point_cells_;
+  std::vector<float> point_ranges_;
+  // the lowest point of each cell, and the ground height of the cells
+  std::vector<float> cell_min_z_;
+  std::vector<float> cell_min_range_;
+  std::vector<float> cell_ground_z_;
+
+  DISALLOW_COPY_AND_ASSIGN(RangeImageGroundDetector);
+};
+
+REGISTER_GROUNDDETECTOR(RangeImageGroundDetector);
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_OBSTACLE_LIDAR_GROUND_DETECTOR_RANGE_IMAGE_GROUND_DETECTOR_RANGE_IMAGE_GROUND_DETECTOR_H_  // NOLINT
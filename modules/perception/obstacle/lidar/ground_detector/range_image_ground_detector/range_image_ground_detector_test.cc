@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/lidar/ground_detector/range_image_ground_detector/range_image_ground_detector.h"
+
+#include <cmath>
+#include <set>
+
+#include "gtest/gtest.h"
+
+#include "modules/perception/common/perception_gflags.h"
+
+namespace apollo {
+namespace perception {
+
+class RangeImageGroundDetectorTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_work_root = "modules/perception";
+    FLAGS_config_manager_path = "conf/config_manager.config";
+    ASSERT_TRUE(detector_.Init());
+  }
+
+  void AddPoint(float x, float y, float z) {
+    pcl_util::Point point;
+    point.x = x;
+    point.y = y;
+    point.z = z;
+    cloud_->push_back(point);
+  }
+
+  RangeImageGroundDetector detector_;
+  pcl_util::PointCloudPtr cloud_{new pcl_util::PointCloud};
+  pcl_util::PointIndicesPtr non_ground_indices_{new pcl_util::PointIndices};
+};
+
+TEST_F(RangeImageGroundDetectorTest, Detect) {
+  EXPECT_EQ("RangeImageGroundDetector", detector_.name());
+  // a ground rising gently ahead of the car, flat elsewhere
+  for (float range = 3.0f; range < 40.0f; range += 0.3f) {
+    for (float angle = -M_PI; angle < M_PI; angle += 0.005f) {
+      const float x = range * std::cos(angle);
+      const float y = range * std::sin(angle);
+      const float z = -1.9f + (x > 20.0f ? 0.05f * (x - 20.0f) : 0.0f);
+      AddPoint(x, y, z);
+    }
+  }
+  const int num_ground_points = static_cast<int>(cloud_->size());
+  // a pole on the flat ground, and a box on the slope
+  for (float z = -1.8f; z < 1.0f; z += 0.1f) {
+    AddPoint(10.0f, 5.0f, z);
+  }
+  for (float y = -1.0f; y < 1.0f; y += 0.1f) {
+    for (float z = 0.0f; z < 1.5f; z += 0.1f) {
+      AddPoint(30.0f, y, -1.4f + z);
+    }
+  }
+  // a point below the ground is ground too
+  AddPoint(-15.0f, 0.0f, -2.1f);
+
+  GroundDetectorOptions options;
+  ASSERT_TRUE(detector_.Detect(options, cloud_, non_ground_indices_));
+  const std::set<int> non_ground(non_ground_indices_->indices.begin(),
+                                 non_ground_indices_->indices.end());
+  for (int i = 0; i < num_ground_points; ++i) {
+    ASSERT_EQ(0u, non_ground.count(i)) << i;
+    EXPECT_NEAR(0.0f, cloud_->points[i].h, 0.1f);
+  }
+  const int num_points = static_cast<int>(cloud_->size());
+  for (int i = num_ground_points; i < num_points - 1; ++i) {
+    EXPECT_EQ(cloud_->points[i].h > 0.25f, non_ground.count(i) == 1u);
+  }
+  // all the pole is above the ground but its lowest point
+  EXPECT_EQ(0u, non_ground.count(num_ground_points));
+  EXPECT_EQ(1u, non_ground.count(num_ground_points + 5));
+  EXPECT_NEAR(2.6f, cloud_->points[num_ground_points + 25].h, 1e-3);
+  // the box stands on the slope, 0.1 m below the lidar
+  EXPECT_NEAR(1.4f, cloud_->points[num_points - 2].h, 0.1f);
+  EXPECT_EQ(0u, non_ground.count(num_points - 1));
+  EXPECT_GT(non_ground.size(), 250u);
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -54,9 +54,12 @@
 // using segmentation to do somethings.
 // ////////////////////////////////////////////////////
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "Eigen/Core"
+
 #include "modules/common/macro.h"
 #include "modules/perception/lib/base/registerer.h"
 #include "modules/perception/lib/pcl_util/pcl_types.h"
@@ -72,6 +75,11 @@ struct SegmentationOptions {
   pcl_util::PointIndicesPtr roi_cloud_indices;
   // indices of non-ground points in original clound if enabled
   pcl_util::PointIndicesPtr non_ground_indices;
+  // time of the cloud, in seconds
+  double timestamp = 0.0;
+  // pose of the velodyne in the world if known, e.g. to derive the speed of
+  // the vehicle
+  std::shared_ptr<Eigen::Matrix4d> velodyne_trans;
 };
 
 class BaseSegmentation {
@@ -16,11 +16,13 @@
 
 #include "modules/perception/obstacle/lidar/object_builder/min_box/min_box.h"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <vector>
 
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/pcl_util/pcl_types.h"
-#include "modules/perception/obstacle/common/convex_hullxy.h"
 #include "modules/perception/obstacle/common/geometry_util.h"
 
 namespace apollo {
@@ -31,6 +33,98 @@ using pcl_util::PointCloudPtr;
 
 const float EPSILON = 1e-6;
 
+namespace {
+
+// The buffers of the convex hull computation, reused by each thread.
+struct ConvexHullBuffers {
+  std::vector<int> sorted_ids;
+  std::vector<int> hull_ids;
+};
+
+double Cross2dxy(const pcl_util::Point& o, const pcl_util::Point& a,
+                 const pcl_util::Point& b) {
+  return (static_cast<double>(a.x) - o.x) * (static_cast<double>(b.y) - o.y) -
+         (static_cast<double>(a.y) - o.y) * (static_cast<double>(b.x) - o.x);
+}
+
+// Computes the convex hull of the points in the xy plane with Andrew's
+// monotone chain. The ids of the vertices are clockwise, starting from the
+// one with the largest angle around their centroid, which is the order of
+// ConvexHull2DXY. Collinear points are not vertices.
+// Returns false if the hull has less than 3 vertices.
+bool ComputeConvexHull2dxy(const PointCloud& cloud,
+                           ConvexHullBuffers* buffers) {
+  const auto& points = cloud.points;
+  std::vector<int>& ids = buffers->sorted_ids;
+  ids.resize(points.size());
+  for (size_t i = 0; i < ids.size(); ++i) {
+    ids[i] = static_cast<int>(i);
+  }
+  std::sort(ids.begin(), ids.end(), [&points](const int lhs, const int rhs) {
+    return points[lhs].x < points[rhs].x ||
+           (points[lhs].x == points[rhs].x && points[lhs].y < points[rhs].y);
+  });
+
+  // The lower hull from left to right, then the upper hull back.
+  std::vector<int>& hull = buffers->hull_ids;
+  hull.resize(2 * ids.size());
+  size_t k = 0;
+  for (size_t i = 0; i < ids.size(); ++i) {
+    while (k >= 2 && Cross2dxy(points[hull[k - 2]], points[hull[k - 1]],
+                               points[ids[i]]) <= 0.0) {
+      --k;
+    }
+    hull[k++] = ids[i];
+  }
+  for (size_t i = ids.size() - 1, lower_size = k + 1; i > 0; --i) {
+    while (k >= lower_size && Cross2dxy(points[hull[k - 2]],
+                                        points[hull[k - 1]],
+                                        points[ids[i - 1]]) <= 0.0) {
+      --k;
+    }
+    hull[k++] = ids[i - 1];
+  }
+  // The first point is repeated at the end.
+  hull.resize(k > 0 ? k - 1 : 0);
+  if (hull.size() < 3u) {
+    return false;
+  }
+
+  double centroid_x = 0.0;
+  double centroid_y = 0.0;
+  for (const int id : hull) {
+    centroid_x += points[id].x;
+    centroid_y += points[id].y;
+  }
+  centroid_x /= hull.size();
+  centroid_y /= hull.size();
+  // The monotone chain is counterclockwise.
+  std::reverse(hull.begin(), hull.end());
+  size_t first = 0;
+  double max_angle = -std::numeric_limits<double>::max();
+  for (size_t i = 0; i < hull.size(); ++i) {
+    const double angle = std::atan2(points[hull[i]].y - centroid_y,
+                                    points[hull[i]].x - centroid_x);
+    if (angle > max_angle) {
+      max_angle = angle;
+      first = i;
+    }
+  }
+  std::rotate(hull.begin(), hull.begin() + first, hull.end());
+  return true;
+}
+
+}  // namespace
+
+bool MinBoxObjectBuilder::Init() {
+  thread_pool_.reset();
+  if (FLAGS_min_box_object_builder_num_threads > 0) {
+    thread_pool_.reset(new apollo::common::util::WorkStealingThreadPool(
+        FLAGS_min_box_object_builder_num_threads));
+  }
+  return true;
+}
+
 bool MinBoxObjectBuilder::Build(const ObjectBuilderOptions& options,
                                 std::vector<ObjectPtr>* objects) {
   if (objects == NULL) {
@@ -40,8 +134,21 @@ bool MinBoxObjectBuilder::Build(const ObjectBuilderOptions& options,
   for (size_t i = 0; i < objects->size(); ++i) {
     if ((*objects)[i]) {
       (*objects)[i]->id = i;
+    }
+  }
+
+  // Each object only touches its own cloud and geometry.
+  auto build_object = [&](const size_t i) {
+    if ((*objects)[i]) {
       BuildObject(options, (*objects)[i]);
     }
+  };
+  if (thread_pool_ == nullptr) {
+    for (size_t i = 0; i < objects->size(); ++i) {
+      build_object(i);
+    }
+  } else {
+    thread_pool_->ParallelFor(0, objects->size(), build_object);
   }
 
   return true;
@@ -51,6 +158,7 @@ double MinBoxObjectBuilder::ComputeAreaAlongOneEdge(
     ObjectPtr obj, size_t first_in_point, Eigen::Vector3d* center,
     double* lenth, double* width, Eigen::Vector3d* dir) {
   std::vector<Eigen::Vector3d> ns;
+  ns.reserve(obj->polygon.points.size());
   Eigen::Vector3d v(0.0, 0.0, 0.0);
   Eigen::Vector3d vn(0.0, 0.0, 0.0);
   Eigen::Vector3d n(0.0, 0.0, 0.0);
@@ -343,24 +451,18 @@ void MinBoxObjectBuilder::ComputePolygon2dxy(ObjectPtr obj) {
     cloud->points[1].x -= min_eps;
   }
 
-  PointCloudPtr pcd_xy(new PointCloud);
-  for (size_t i = 0; i < cloud->points.size(); ++i) {
-    pcl_util::Point p = cloud->points[i];
-    p.z = min_pt[2];
-    pcd_xy->push_back(p);
-  }
-
-  ConvexHull2DXY<pcl_util::Point> hull;
-  hull.setInputCloud(pcd_xy);
-  hull.setDimension(2);
-  std::vector<pcl::Vertices> poly_vt;
-  PointCloudPtr plane_hull(new PointCloud);
-  hull.Reconstruct2dxy(plane_hull, &poly_vt);
-
-  if (poly_vt.size() == 1u) {
-    std::vector<int> ind(poly_vt[0].vertices.begin(),
-                         poly_vt[0].vertices.end());
-    TransformPointCloud(plane_hull, ind, &obj->polygon);
+  static thread_local ConvexHullBuffers hull_buffers;
+  if (ComputeConvexHull2dxy(*cloud, &hull_buffers)) {
+    const std::vector<int>& hull = hull_buffers.hull_ids;
+    obj->polygon.points.resize(hull.size());
+    for (size_t i = 0; i < hull.size(); ++i) {
+      const pcl_util::Point& p = cloud->points[hull[i]];
+      pcl_util::PointD& vertex = obj->polygon.points[i];
+      vertex.x = p.x;
+      vertex.y = p.y;
+      vertex.z = min_pt[2];
+      vertex.intensity = p.intensity;
+    }
   } else {
     obj->polygon.points.resize(4);
     obj->polygon.points[0].x = static_cast<double>(min_pt[0]);
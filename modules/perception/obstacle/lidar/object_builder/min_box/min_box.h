@@ -17,9 +17,11 @@
 #ifndef MODULES_PERCEPTION_OBSTACLE_LIDAR_OBJECT_BUILDER_MIN_BOX_H
 #define MODULES_PERCEPTION_OBSTACLE_LIDAR_OBJECT_BUILDER_MIN_BOX_H
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "modules/common/util/work_stealing_thread_pool.h"
 #include "modules/perception/obstacle/base/object.h"
 #include "modules/perception/obstacle/lidar/interface/base_object_builder.h"
 
@@ -31,10 +33,12 @@ class MinBoxObjectBuilder : public BaseObjectBuilder {
   MinBoxObjectBuilder() : BaseObjectBuilder() {}
   virtual ~MinBoxObjectBuilder() {}
 
-  bool Init() override {
-    return true;
-  }
+  bool Init() override;
 
+  /**
+   * @brief Build the geometry of the objects. The objects are built in
+   * parallel when FLAGS_min_box_object_builder_num_threads is positive.
+   */
   bool Build(const ObjectBuilderOptions& options,
              std::vector<ObjectPtr>* objects) override;
   std::string name() const override {
@@ -55,6 +59,8 @@ class MinBoxObjectBuilder : public BaseObjectBuilder {
   void ComputeGeometricFeature(const Eigen::Vector3d& ref_ct, ObjectPtr obj);
 
  private:
+  std::unique_ptr<apollo::common::util::WorkStealingThreadPool> thread_pool_;
+
   DISALLOW_COPY_AND_ASSIGN(MinBoxObjectBuilder);
 };
 
@@ -20,6 +20,8 @@
 
 #include "gtest/gtest.h"
 
+#include "modules/perception/common/perception_gflags.h"
+
 namespace apollo {
 namespace perception {
 
@@ -74,6 +76,7 @@ TEST_F(MinBoxObjectBuilderTest, build) {
   ConstructPointCloud(&objects);
   EXPECT_EQ(5, objects.size());
   ObjectBuilderOptions options;
+  options.ref_center = Eigen::Vector3d::Zero();
   EXPECT_TRUE(min_box_object_builder_->Build(options, &objects));
   const double EPSILON = 1e-6;
   // obj 1
@@ -122,5 +125,34 @@ TEST_F(MinBoxObjectBuilderTest, build) {
   EXPECT_NEAR(0.0, objects[4]->direction[2], EPSILON);
 }
 
+TEST_F(MinBoxObjectBuilderTest, build_in_parallel) {
+  std::vector<ObjectPtr> expected_objects;
+  ConstructPointCloud(&expected_objects);
+  ObjectBuilderOptions options;
+  options.ref_center = Eigen::Vector3d::Zero();
+  EXPECT_TRUE(min_box_object_builder_->Build(options, &expected_objects));
+
+  FLAGS_min_box_object_builder_num_threads = 4;
+  MinBoxObjectBuilder object_builder;
+  EXPECT_TRUE(object_builder.Init());
+  FLAGS_min_box_object_builder_num_threads = 0;
+  for (int iteration = 0; iteration < 2; ++iteration) {
+    std::vector<ObjectPtr> objects;
+    ConstructPointCloud(&objects);
+    EXPECT_TRUE(object_builder.Build(options, &objects));
+    ASSERT_EQ(expected_objects.size(), objects.size());
+    for (size_t i = 0; i < objects.size(); ++i) {
+      EXPECT_EQ(i, objects[i]->id);
+      EXPECT_DOUBLE_EQ(expected_objects[i]->length, objects[i]->length);
+      EXPECT_DOUBLE_EQ(expected_objects[i]->width, objects[i]->width);
+      EXPECT_DOUBLE_EQ(expected_objects[i]->height, objects[i]->height);
+      EXPECT_EQ(expected_objects[i]->direction, objects[i]->direction);
+      EXPECT_EQ(expected_objects[i]->center, objects[i]->center);
+      EXPECT_EQ(expected_objects[i]->polygon.points.size(),
+                objects[i]->polygon.points.size());
+    }
+  }
+}
+
 }  // namespace perception
 }  // namespace apollo
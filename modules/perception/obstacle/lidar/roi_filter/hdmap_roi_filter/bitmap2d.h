@@ -74,6 +74,18 @@ class Bitmap2D {
    */
   bool Check(const Eigen::Vector2d& p) const;
 
+  /**
+   * @brief: Check whether the value of the grid with x id and y id is
+   * true(in ROI). The ids are not checked against the bitmap size.
+   */
+  inline bool CheckGrid(const size_t x_id, const size_t y_id) const {
+    const size_t major_id = dir_major_ == XMAJOR ? x_id : y_id;
+    const size_t op_major_id = dir_major_ == XMAJOR ? y_id : x_id;
+    const uint64_t first_one = static_cast<uint64_t>(1) << 63;
+    return bitmap_[major_id][op_major_id >> 6] &
+           (first_one >> (op_major_id & 63));
+  }
+
   void Set(double x, double min_y, double max_y);
   void Set(const uint64_t& x_id, const uint64_t& min_y_id,
            const uint64_t& max_y_id);
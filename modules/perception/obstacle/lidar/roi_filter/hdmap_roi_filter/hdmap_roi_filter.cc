@@ -26,6 +26,11 @@ bool HdmapROIFilter::Filter(const pcl_util::PointCloudPtr& cloud,
 
   Eigen::Affine3d temp_trans(*(roi_filter_options.velodyne_trans));
 
+  if (FLAGS_enable_hdmap_roi_bitmap_cache) {
+    return FilterWithBitmapCache(cloud, temp_trans, roi_filter_options.hdmap,
+                                 roi_indices);
+  }
+
   std::vector<PolygonDType> polygons;
   MergeHdmapStructToPolygons(roi_filter_options.hdmap, &polygons);
 
@@ -63,6 +68,58 @@ bool HdmapROIFilter::FilterWithPolygonMask(
   return Bitmap2dFilter(cloud, bitmap, roi_indices);
 }
 
+bool HdmapROIFilter::FilterWithBitmapCache(
+    const pcl_util::PointCloudPtr& cloud, const Eigen::Affine3d& vel_pose,
+    const HdmapStructConstPtr& hdmap_struct_ptr,
+    pcl_util::PointIndices* roi_indices) {
+  if (hdmap_struct_ptr->road_boundary.empty() &&
+      hdmap_struct_ptr->junction.empty()) {
+    return false;
+  }
+
+  // 1. Draw the tiles entering the window, the polygons are only merged when
+  // there are some.
+  const Eigen::Vector3d vel_location = vel_pose.translation();
+  const Eigen::Vector2d center(vel_location.x(), vel_location.y());
+  if (bitmap_cache_.MoveWindow(center, range_)) {
+    std::vector<PolygonDType> polygons;
+    MergeHdmapStructToPolygons(hdmap_struct_ptr, &polygons);
+
+    std::vector<PolygonScanConverter::Polygon> raw_polygons(polygons.size());
+    for (size_t i = 0; i < polygons.size(); ++i) {
+      raw_polygons[i].resize(polygons[i].size());
+      for (size_t j = 0; j < polygons[i].size(); ++j) {
+        raw_polygons[i][j].x() = polygons[i][j].x;
+        raw_polygons[i][j].y() = polygons[i][j].y;
+      }
+    }
+    bitmap_cache_.Rasterize(raw_polygons, FLAGS_map_radius);
+    ADEBUG << "Rasterized " << bitmap_cache_.num_rasterized_tiles()
+           << " ROI tiles, " << bitmap_cache_.num_cached_tiles()
+           << " tiles cached.";
+  }
+
+  // 2. Check each point within [-range, range] around the vehicle in the
+  // cache, the points are rotated to world orientation as in TransformFrame.
+  const Eigen::Matrix3d vel_rot = vel_pose.linear();
+  const Eigen::Vector3d x_axis = vel_rot.row(0);
+  const Eigen::Vector3d y_axis = vel_rot.row(1);
+  roi_indices->indices.reserve(cloud->size());
+  for (size_t i = 0; i < cloud->size(); ++i) {
+    const auto& pt = cloud->points[i];
+    const Eigen::Vector3d e_pt(pt.x, pt.y, pt.z);
+    const double x = x_axis.dot(e_pt);
+    const double y = y_axis.dot(e_pt);
+    if (x < -range_ || x >= range_ || y < -range_ || y >= range_) {
+      continue;
+    }
+    if (bitmap_cache_.Check(x + center.x(), y + center.y())) {
+      roi_indices->indices.push_back(i);
+    }
+  }
+  return true;
+}
+
 MajorDirection HdmapROIFilter::GetMajorDirection(
     const std::vector<PolygonType>& map_polygons,
     std::vector<PolygonScanConverter::Polygon>* polygons) {
@@ -168,6 +225,7 @@ bool HdmapROIFilter::Init() {
       return false;
     }
   }
+  bitmap_cache_.Init(cell_size_, extend_dist_);
   return true;
 }
 
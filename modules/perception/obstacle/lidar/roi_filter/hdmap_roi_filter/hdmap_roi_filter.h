@@ -31,6 +31,7 @@
 #include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/bitmap2d.h"
 #include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/polygon_mask.h"
 #include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/polygon_scan_converter.h"
+#include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/tiled_bitmap_cache.h"
 #include "modules/perception/obstacle/onboard/hdmap_input.h"
 
 namespace apollo {
@@ -83,6 +84,16 @@ class HdmapROIFilter : public BaseROIFilter {
                              const std::vector<PolygonType>& map_polygons,
                              pcl_util::PointIndices* roi_indices);
 
+  /**
+   * @brief: Draw the polygons of the tiles entering the window around the
+   * vehicle into the world coordinates bitmap cache, and check each point
+   * in the cache.
+   */
+  bool FilterWithBitmapCache(const pcl_util::PointCloudPtr& cloud,
+                             const Eigen::Affine3d& vel_pose,
+                             const HdmapStructConstPtr& hdmap_struct_ptr,
+                             pcl_util::PointIndices* roi_indices);
+
   /**
    * @brief: Transform polygon points and cloud points from world coordinates
    * system to local.
@@ -125,6 +136,9 @@ class HdmapROIFilter : public BaseROIFilter {
 
   // The distance extended away from the ROI boundary
   double extend_dist_;
+
+  // The ROI grids in world coordinates kept across frames
+  TiledBitmapCache bitmap_cache_;
 };
 
 REGISTER_ROIFILTER(HdmapROIFilter);
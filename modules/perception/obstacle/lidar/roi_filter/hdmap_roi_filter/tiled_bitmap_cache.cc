@@ -0,0 +1,196 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/tiled_bitmap_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "modules/common/log.h"
+#include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/polygon_mask.h"
+
+namespace apollo {
+namespace perception {
+
+const int TiledBitmapCache::kTileGrids;
+
+void TiledBitmapCache::Init(const double cell_size, const double extend_dist) {
+  CHECK_GT(cell_size, 0.0);
+  cell_size_ = cell_size;
+  extend_dist_ = extend_dist;
+  tile_size_ = kTileGrids * cell_size;
+  Clear();
+}
+
+void TiledBitmapCache::Clear() {
+  tiles_.clear();
+  window_tiles_.clear();
+  pending_tiles_.clear();
+  window_width_ = 0;
+  window_height_ = 0;
+  num_rasterized_tiles_ = 0;
+}
+
+bool TiledBitmapCache::MoveWindow(const Eigen::Vector2d& center,
+                                  const double range) {
+  center_ = center;
+  range_ = range;
+  const int min_x = static_cast<int>(std::floor((center.x() - range) /
+                                                tile_size_));
+  const int min_y = static_cast<int>(std::floor((center.y() - range) /
+                                                tile_size_));
+  const int max_x = static_cast<int>(std::floor((center.x() + range) /
+                                                tile_size_));
+  const int max_y = static_cast<int>(std::floor((center.y() + range) /
+                                                tile_size_));
+
+  // Keep a margin of one tile, so that the tiles at the window border are
+  // not dropped and drawn again while the vehicle moves back and forth.
+  for (auto it = tiles_.begin(); it != tiles_.end();) {
+    const TileIndex& index = it->first;
+    if (index.first < min_x - 1 || index.first > max_x + 1 ||
+        index.second < min_y - 1 || index.second > max_y + 1) {
+      it = tiles_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  window_min_index_ = TileIndex(min_x, min_y);
+  window_min_p_ = Eigen::Vector2d(min_x * tile_size_, min_y * tile_size_);
+  window_width_ = static_cast<size_t>(max_x - min_x + 1);
+  window_height_ = static_cast<size_t>(max_y - min_y + 1);
+  window_tiles_.resize(window_width_ * window_height_);
+  pending_tiles_.clear();
+
+  const Eigen::Vector2d grid_size(cell_size_, cell_size_);
+  for (int y = min_y; y <= max_y; ++y) {
+    for (int x = min_x; x <= max_x; ++x) {
+      const TileIndex index(x, y);
+      auto& tile = tiles_[index];
+      if (tile == nullptr) {
+        // The bitmap is built by RasterizeTile().
+        tile.reset(new Tile(Bitmap2D(Eigen::Vector2d::Zero(), grid_size,
+                                     grid_size, Bitmap2D::XMAJOR)));
+      }
+      if (!tile->complete) {
+        pending_tiles_.push_back(index);
+      }
+      window_tiles_[(y - min_y) * window_width_ + (x - min_x)] = tile.get();
+    }
+  }
+  return !pending_tiles_.empty();
+}
+
+void TiledBitmapCache::Rasterize(const std::vector<Polygon>& polygons,
+                                 const double map_radius) {
+  num_rasterized_tiles_ = 0;
+  if (pending_tiles_.empty()) {
+    return;
+  }
+
+  std::vector<Eigen::Vector2d> polygons_min_p(polygons.size());
+  std::vector<Eigen::Vector2d> polygons_max_p(polygons.size());
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    polygons_min_p[i].setConstant(std::numeric_limits<double>::max());
+    polygons_max_p[i].setConstant(-std::numeric_limits<double>::max());
+    for (const auto& point : polygons[i]) {
+      polygons_min_p[i] = polygons_min_p[i].cwiseMin(point);
+      polygons_max_p[i] = polygons_max_p[i].cwiseMax(point);
+    }
+  }
+  const DirectionMajor major_dir = GetMajorDirection(polygons);
+
+  for (const auto& index : pending_tiles_) {
+    Tile* tile = tiles_[index].get();
+    RasterizeTile(index, polygons, polygons_min_p, polygons_max_p, major_dir,
+                  tile);
+
+    // The tile is complete if its farthest corner is within the map radius.
+    const Eigen::Vector2d tile_min_p(index.first * tile_size_,
+                                     index.second * tile_size_);
+    const Eigen::Vector2d tile_max_p(tile_min_p.x() + tile_size_,
+                                     tile_min_p.y() + tile_size_);
+    const double dx = std::max(std::abs(tile_min_p.x() - center_.x()),
+                               std::abs(tile_max_p.x() - center_.x()));
+    const double dy = std::max(std::abs(tile_min_p.y() - center_.y()),
+                               std::abs(tile_max_p.y() - center_.y()));
+    tile->complete = dx * dx + dy * dy <= map_radius * map_radius;
+    ++num_rasterized_tiles_;
+  }
+  pending_tiles_.clear();
+}
+
+void TiledBitmapCache::RasterizeTile(
+    const TileIndex& index, const std::vector<Polygon>& polygons,
+    const std::vector<Eigen::Vector2d>& polygons_min_p,
+    const std::vector<Eigen::Vector2d>& polygons_max_p,
+    DirectionMajor major_dir, Tile* tile) {
+  const Eigen::Vector2d tile_min_p(index.first * tile_size_,
+                                   index.second * tile_size_);
+  // Each tile is drawn in its own coordinates, with origin at its min corner,
+  // to keep the grids of all the tiles aligned. The polygon scan conversion
+  // drops the last scan before the max corner of a bitmap, so the tile
+  // bitmap has one more grid on each side.
+  const double bitmap_size = tile_size_ + cell_size_;
+  tile->bitmap = Bitmap2D(Eigen::Vector2d::Zero(),
+                          Eigen::Vector2d(bitmap_size, bitmap_size),
+                          Eigen::Vector2d(cell_size_, cell_size_), major_dir);
+  tile->bitmap.BuildMap();
+
+  const double margin = std::abs(extend_dist_);
+  Polygon tile_polygon;
+  for (size_t i = 0; i < polygons.size(); ++i) {
+    if (polygons_max_p[i].x() + margin < tile_min_p.x() ||
+        polygons_min_p[i].x() - margin > tile_min_p.x() + tile_size_ ||
+        polygons_max_p[i].y() + margin < tile_min_p.y() ||
+        polygons_min_p[i].y() - margin > tile_min_p.y() + tile_size_) {
+      continue;
+    }
+    tile_polygon.resize(polygons[i].size());
+    for (size_t j = 0; j < polygons[i].size(); ++j) {
+      tile_polygon[j] = polygons[i][j] - tile_min_p;
+    }
+    DrawPolygonInBitmap(tile_polygon, extend_dist_, &tile->bitmap);
+  }
+}
+
+TiledBitmapCache::DirectionMajor TiledBitmapCache::GetMajorDirection(
+    const std::vector<Polygon>& polygons) const {
+  // The same choice as HdmapROIFilter::GetMajorDirection(): the direction
+  // with the smaller range of the polygons within the window.
+  double min_x = center_.x() + range_, min_y = center_.y() + range_;
+  double max_x = center_.x() - range_, max_y = center_.y() - range_;
+  for (const auto& polygon : polygons) {
+    for (const auto& point : polygon) {
+      min_x = std::min(min_x, point.x());
+      max_x = std::max(max_x, point.x());
+      min_y = std::min(min_y, point.y());
+      max_y = std::max(max_y, point.y());
+    }
+  }
+  min_x = std::max(min_x, center_.x() - range_);
+  max_x = std::min(max_x, center_.x() + range_);
+  min_y = std::max(min_y, center_.y() - range_);
+  max_y = std::min(max_y, center_.y() + range_);
+
+  return (max_x - min_x) < (max_y - min_y) ? Bitmap2D::XMAJOR
+                                           : Bitmap2D::YMAJOR;
+}
+
+}  // namespace perception
+}  // namespace apollo
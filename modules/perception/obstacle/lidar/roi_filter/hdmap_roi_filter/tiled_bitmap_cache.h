@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#ifndef MODULES_PERCEPTION_OBSTACLE_LIDAR_ROI_FILTER_HDMAP_ROI_FILTER_TBC_H_
+#define MODULES_PERCEPTION_OBSTACLE_LIDAR_ROI_FILTER_HDMAP_ROI_FILTER_TBC_H_
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Eigen/Core"
+
+#include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/bitmap2d.h"
+#include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/polygon_scan_converter.h"
+
+namespace apollo {
+namespace perception {
+
+/**
+ * @class TiledBitmapCache
+ * @brief This is a ROI bitmap in world coordinates, split into square tiles
+ * of 64 * 64 grids aligned to the world origin. The tiles are kept across
+ * frames, so when the vehicle moves only the tiles entering the window around
+ * it are rasterized.
+ *
+ * @Note: A tile is kept only if it is completely inside the radius in which
+ * the map polygons are queried, otherwise some polygons crossing it may be
+ * missing and it is rasterized again in the next frame.
+ */
+class TiledBitmapCache {
+ public:
+  typedef PolygonScanConverter::Polygon Polygon;
+  typedef Bitmap2D::DirectionMajor DirectionMajor;
+
+  static const int kTileGrids = 64;
+
+  TiledBitmapCache() {}
+
+  void Init(const double cell_size, const double extend_dist);
+
+  /**
+   * @brief: Move the window to the square [center - range, center + range]
+   * in world coordinates. The tiles far away from the window are dropped.
+   * @return true if some tiles of the window have to be rasterized by
+   * Rasterize() before Check() is called.
+   */
+  bool MoveWindow(const Eigen::Vector2d& center, const double range);
+
+  /**
+   * @brief: Draw the polygons in world coordinates into the tiles of the
+   * window that are not cached yet.
+   * @params[In] polygons: The map polygons around the window center
+   * @params[In] map_radius: The radius around the window center in which
+   * the polygons are complete
+   */
+  void Rasterize(const std::vector<Polygon>& polygons,
+                 const double map_radius);
+
+  /**
+   * @brief: Check whether the point in world coordinates is in ROI. Points
+   * out of the window are never in ROI.
+   */
+  inline bool Check(const double x, const double y) const {
+    const double grid_x = (x - window_min_p_.x()) / cell_size_;
+    const double grid_y = (y - window_min_p_.y()) / cell_size_;
+    if (grid_x < 0.0 || grid_y < 0.0) {
+      return false;
+    }
+    const size_t x_id = static_cast<size_t>(grid_x);
+    const size_t y_id = static_cast<size_t>(grid_y);
+    const size_t tile_x = x_id / kTileGrids;
+    const size_t tile_y = y_id / kTileGrids;
+    if (tile_x >= window_width_ || tile_y >= window_height_) {
+      return false;
+    }
+    const Tile* tile = window_tiles_[tile_y * window_width_ + tile_x];
+    return tile->bitmap.CheckGrid(x_id % kTileGrids, y_id % kTileGrids);
+  }
+
+  /**
+   * @brief: Drop all the tiles.
+   */
+  void Clear();
+
+  size_t num_cached_tiles() const {
+    return tiles_.size();
+  }
+
+  /**
+   * @brief: Get the number of tiles drawn by the last Rasterize().
+   */
+  size_t num_rasterized_tiles() const {
+    return num_rasterized_tiles_;
+  }
+
+ private:
+  typedef std::pair<int, int> TileIndex;
+
+  struct Tile {
+    explicit Tile(const Bitmap2D& bm) : bitmap(bm) {}
+
+    Bitmap2D bitmap;
+    // Whether all the polygons crossing the tile have been drawn.
+    bool complete = false;
+  };
+
+  DirectionMajor GetMajorDirection(const std::vector<Polygon>& polygons) const;
+
+  void RasterizeTile(const TileIndex& index,
+                     const std::vector<Polygon>& polygons,
+                     const std::vector<Eigen::Vector2d>& polygons_min_p,
+                     const std::vector<Eigen::Vector2d>& polygons_max_p,
+                     DirectionMajor major_dir, Tile* tile);
+
+  double cell_size_ = 0.0;
+  double extend_dist_ = 0.0;
+  double tile_size_ = 0.0;
+
+  std::map<TileIndex, std::unique_ptr<Tile>> tiles_;
+
+  // The window of the last MoveWindow(), in tiles, and its tiles in row major
+  // order.
+  Eigen::Vector2d center_ = Eigen::Vector2d::Zero();
+  double range_ = 0.0;
+  TileIndex window_min_index_;
+  Eigen::Vector2d window_min_p_ = Eigen::Vector2d::Zero();
+  size_t window_width_ = 0;
+  size_t window_height_ = 0;
+  std::vector<Tile*> window_tiles_;
+  std::vector<TileIndex> pending_tiles_;
+
+  size_t num_rasterized_tiles_ = 0;
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_OBSTACLE_LIDAR_ROI_FILTER_HDMAP_ROI_FILTER_TBC_H_
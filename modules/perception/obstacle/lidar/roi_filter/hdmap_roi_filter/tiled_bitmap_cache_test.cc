@@ -0,0 +1,131 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/tiled_bitmap_cache.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/polygon_mask.h"
+
+namespace apollo {
+namespace perception {
+
+typedef TiledBitmapCache::Polygon Polygon;
+
+class TiledBitmapCacheTest : public testing::Test {
+ protected:
+  void SetUp() {
+    cache_.Init(kCellSize, 0.0);
+    // A road along the x axis and a junction, far from the world origin.
+    polygons_.resize(2);
+    AddPoint(-100.3, -4.1, &polygons_[0]);
+    AddPoint(100.7, -3.9, &polygons_[0]);
+    AddPoint(100.7, 4.2, &polygons_[0]);
+    AddPoint(-100.3, 3.8, &polygons_[0]);
+    AddPoint(10.1, -20.3, &polygons_[1]);
+    AddPoint(30.2, -10.1, &polygons_[1]);
+    AddPoint(20.3, 20.4, &polygons_[1]);
+  }
+
+  void AddPoint(const double x, const double y, Polygon* polygon) {
+    polygon->emplace_back(kOriginX + x, kOriginY + y);
+  }
+
+  static constexpr double kCellSize = 0.25;
+  static constexpr double kOriginX = 587123.0;
+  static constexpr double kOriginY = 4140567.0;
+
+  TiledBitmapCache cache_;
+  std::vector<Polygon> polygons_;
+};
+
+constexpr double TiledBitmapCacheTest::kCellSize;
+constexpr double TiledBitmapCacheTest::kOriginX;
+constexpr double TiledBitmapCacheTest::kOriginY;
+
+TEST_F(TiledBitmapCacheTest, SameAsBitmap) {
+  const Eigen::Vector2d center(kOriginX + 1.3, kOriginY - 2.6);
+  const double range = 40.0;
+  EXPECT_TRUE(cache_.MoveWindow(center, range));
+  cache_.Rasterize(polygons_, 1000.0);
+  EXPECT_GT(cache_.num_rasterized_tiles(), 0);
+
+  // A bitmap with the same grids as the tiles around the window.
+  const double tile_size = TiledBitmapCache::kTileGrids * kCellSize;
+  const Eigen::Vector2d min_p =
+      ((center.array() - range) / tile_size).floor() * tile_size;
+  const Eigen::Vector2d max_p =
+      min_p + Eigen::Vector2d::Constant(8 * tile_size);
+  Bitmap2D bitmap(min_p, max_p, Eigen::Vector2d(kCellSize, kCellSize),
+                  Bitmap2D::YMAJOR);
+  bitmap.BuildMap();
+  DrawPolygonInBitmap(polygons_, 0.0, &bitmap);
+
+  int num_in_roi = 0;
+  for (double x = -range + 0.5 * kCellSize; x < range; x += kCellSize) {
+    for (double y = -range + 0.5 * kCellSize; y < range; y += kCellSize) {
+      const Eigen::Vector2d p(center.x() + x, center.y() + y);
+      const bool in_roi = bitmap.Check(p);
+      EXPECT_EQ(in_roi, cache_.Check(p.x(), p.y())) << x << ", " << y;
+      num_in_roi += in_roi;
+    }
+  }
+  EXPECT_GT(num_in_roi, 0);
+
+  EXPECT_TRUE(cache_.Check(kOriginX, kOriginY));
+  EXPECT_FALSE(cache_.Check(kOriginX, kOriginY + 30.0));
+  // Out of the window.
+  EXPECT_FALSE(cache_.Check(kOriginX + 100.0, kOriginY));
+}
+
+TEST_F(TiledBitmapCacheTest, KeepCompleteTiles) {
+  const double map_radius = 100.0;
+  const double range = 30.0;
+  Eigen::Vector2d center(kOriginX, kOriginY);
+  EXPECT_TRUE(cache_.MoveWindow(center, range));
+  cache_.Rasterize(polygons_, map_radius);
+  const size_t num_tiles = cache_.num_rasterized_tiles();
+  EXPECT_EQ(num_tiles, cache_.num_cached_tiles());
+
+  // All the tiles are within the map radius, so nothing is drawn again.
+  EXPECT_FALSE(cache_.MoveWindow(center, range));
+  center.x() += 1.0;
+  EXPECT_FALSE(cache_.MoveWindow(center, range));
+
+  // Only the column of tiles entering the window is drawn.
+  center.x() += TiledBitmapCache::kTileGrids * kCellSize;
+  EXPECT_TRUE(cache_.MoveWindow(center, range));
+  cache_.Rasterize(polygons_, map_radius);
+  EXPECT_LT(cache_.num_rasterized_tiles(), num_tiles);
+  EXPECT_TRUE(cache_.Check(center.x(), kOriginY));
+
+  // Tiles out of the map radius are drawn in every frame.
+  TiledBitmapCache cache;
+  cache.Init(kCellSize, 0.0);
+  EXPECT_TRUE(cache.MoveWindow(center, range));
+  cache.Rasterize(polygons_, 1.0);
+  EXPECT_TRUE(cache.MoveWindow(center, range));
+  cache.Rasterize(polygons_, 1.0);
+  EXPECT_EQ(num_tiles, cache.num_rasterized_tiles());
+
+  cache_.Clear();
+  EXPECT_EQ(0, cache_.num_cached_tiles());
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/adaptive_net_selector.h"
+
+#include <algorithm>
+
+namespace apollo {
+namespace perception {
+namespace cnnseg {
+
+namespace {
+
+// Above this interval between two frames, their poses do not give the speed.
+const double kMaxPoseInterval = 1.0;
+
+int NumCells(const FeatureParam& feature_param) {
+  return static_cast<int>(feature_param.width() * feature_param.height());
+}
+
+}  // namespace
+
+void AdaptiveNetSelector::Init(const CNNSegParam& param) {
+  nets_.clear();
+  Net default_net;
+  default_net.num_cells = NumCells(param.feature_param());
+  nets_.push_back(default_net);
+  for (const auto& adaptive_net : param.adaptive_net()) {
+    Net net;
+    net.num_cells = NumCells(adaptive_net.feature_param());
+    net.max_speed = adaptive_net.max_speed();
+    net.max_speed_in_dense_traffic = adaptive_net.max_speed_in_dense_traffic();
+    nets_.push_back(net);
+  }
+  speed_hysteresis_ = param.adaptive_net_speed_hysteresis();
+  dense_traffic_min_objects_ =
+      static_cast<int>(param.dense_traffic_min_objects());
+
+  has_last_pose_ = false;
+  speed_ = -1.0;
+  dense_traffic_ = false;
+  net_index_ = 0;
+}
+
+int AdaptiveNetSelector::Select(double timestamp, const Eigen::Matrix4d* pose,
+                                int num_objects) {
+  UpdateSpeed(timestamp, pose);
+  if (dense_traffic_min_objects_ > 0) {
+    const int min_objects = dense_traffic_ ? dense_traffic_min_objects_ * 3 / 4
+                                           : dense_traffic_min_objects_;
+    dense_traffic_ = num_objects >= min_objects;
+  }
+  if (speed_ < 0.0) {
+    net_index_ = 0;
+    return net_index_;
+  }
+
+  int selected = 0;
+  for (size_t i = 1; i < nets_.size(); ++i) {
+    const Net& net = nets_[i];
+    float max_speed = net.max_speed;
+    if (dense_traffic_) {
+      max_speed = std::max(max_speed, net.max_speed_in_dense_traffic);
+    }
+    if (static_cast<int>(i) == net_index_) {
+      max_speed += speed_hysteresis_;
+    }
+    if (speed_ < max_speed && net.num_cells < nets_[selected].num_cells) {
+      selected = static_cast<int>(i);
+    }
+  }
+  net_index_ = selected;
+  return net_index_;
+}
+
+void AdaptiveNetSelector::UpdateSpeed(double timestamp,
+                                      const Eigen::Matrix4d* pose) {
+  if (pose == nullptr) {
+    has_last_pose_ = false;
+    speed_ = -1.0;
+    return;
+  }
+  const Eigen::Vector3d position = pose->block<3, 1>(0, 3);
+  const double interval = timestamp - last_timestamp_;
+  if (has_last_pose_ && interval > 0.0 && interval < kMaxPoseInterval) {
+    speed_ = (position - last_position_).norm() / interval;
+  } else {
+    speed_ = -1.0;
+  }
+  has_last_pose_ = true;
+  last_timestamp_ = timestamp;
+  last_position_ = position;
+}
+
+}  // namespace cnnseg
+}  // namespace perception
+}  // namespace apollo
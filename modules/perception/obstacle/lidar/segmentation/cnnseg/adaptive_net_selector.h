@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef MODULES_PERCEPTION_OBSTACLE_LIDAR_SEGMENTATION_CNNSEG_ADAPTIVE_NET_SELECTOR_H_  // NOLINT
+#define MODULES_PERCEPTION_OBSTACLE_LIDAR_SEGMENTATION_CNNSEG_ADAPTIVE_NET_SELECTOR_H_  // NOLINT
+
+#include <vector>
+
+#include "Eigen/Core"
+
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/proto/cnnseg.pb.h"
+
+namespace apollo {
+namespace perception {
+namespace cnnseg {
+
+/**
+ * @brief Selects the net CNNSegmentation runs on a frame, among the default
+ * net and the adaptive nets of its param, from the speed of the vehicle and
+ * the density of the traffic. The speed is estimated from the poses of the
+ * consecutive frames; while it is unknown, the default net runs.
+ */
+class AdaptiveNetSelector {
+ public:
+  AdaptiveNetSelector() = default;
+
+  void Init(const CNNSegParam& param);
+
+  /**
+   * @param timestamp The time of the frame, in seconds.
+   * @param pose The pose of the velodyne in the world, null if unknown.
+   * @param num_objects The number of objects of the last frame.
+   * @return 0 for the default net, i + 1 for the i-th adaptive net.
+   */
+  int Select(double timestamp, const Eigen::Matrix4d* pose, int num_objects);
+
+  // the speed of the vehicle at the last frame, in m/s, negative if unknown
+  double speed() const {
+    return speed_;
+  }
+
+  int net_index() const {
+    return net_index_;
+  }
+
+ private:
+  void UpdateSpeed(double timestamp, const Eigen::Matrix4d* pose);
+
+  struct Net {
+    int num_cells = 0;
+    float max_speed = 0.0;
+    float max_speed_in_dense_traffic = 0.0;
+  };
+  std::vector<Net> nets_;
+  float speed_hysteresis_ = 0.0;
+  int dense_traffic_min_objects_ = 0;
+
+  bool has_last_pose_ = false;
+  double last_timestamp_ = 0.0;
+  Eigen::Vector3d last_position_ = Eigen::Vector3d::Zero();
+  double speed_ = -1.0;
+
+  bool dense_traffic_ = false;
+  int net_index_ = 0;
+};
+
+}  // namespace cnnseg
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_OBSTACLE_LIDAR_SEGMENTATION_CNNSEG_ADAPTIVE_NET_SELECTOR_H_  // NOLINT
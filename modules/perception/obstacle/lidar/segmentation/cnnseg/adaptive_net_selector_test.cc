@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/adaptive_net_selector.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace cnnseg {
+
+class AdaptiveNetSelectorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    CNNSegParam param;
+    param.mutable_feature_param()->set_width(864);
+    param.mutable_feature_param()->set_height(864);
+    // a net of 40 m, and a smaller one of 20 m
+    AdaptiveNetParam* net = param.add_adaptive_net();
+    net->mutable_feature_param()->set_width(512);
+    net->mutable_feature_param()->set_height(512);
+    net->set_max_speed(10.0);
+    net->set_max_speed_in_dense_traffic(15.0);
+    net = param.add_adaptive_net();
+    net->mutable_feature_param()->set_width(256);
+    net->mutable_feature_param()->set_height(256);
+    net->set_max_speed(2.0);
+    param.set_adaptive_net_speed_hysteresis(1.0);
+    param.set_dense_traffic_min_objects(40);
+    selector_.Init(param);
+  }
+
+  // Moves the vehicle along x at the speed for 0.1 s, and selects the net.
+  int Drive(double speed, int num_objects = 0) {
+    timestamp_ += 0.1;
+    pose_(0, 3) += speed * 0.1;
+    return selector_.Select(timestamp_, &pose_, num_objects);
+  }
+
+  AdaptiveNetSelector selector_;
+  double timestamp_ = 100.0;
+  Eigen::Matrix4d pose_ = Eigen::Matrix4d::Identity();
+};
+
+TEST_F(AdaptiveNetSelectorTest, DefaultNetWithoutSpeed) {
+  EXPECT_EQ(0, selector_.Select(timestamp_, nullptr, 0));
+  EXPECT_LT(selector_.speed(), 0.0);
+  // the first pose does not give the speed
+  EXPECT_EQ(0, selector_.Select(timestamp_, &pose_, 0));
+  EXPECT_EQ(2, Drive(0.0));
+  EXPECT_DOUBLE_EQ(0.0, selector_.speed());
+  // nor does a pose after a gap
+  timestamp_ += 5.0;
+  EXPECT_EQ(0, Drive(0.0));
+}
+
+TEST_F(AdaptiveNetSelectorTest, SelectBySpeed) {
+  Drive(0.0);
+  EXPECT_EQ(2, Drive(1.0));
+  EXPECT_NEAR(1.0, selector_.speed(), 1e-9);
+  EXPECT_EQ(1, Drive(5.0));
+  EXPECT_EQ(0, Drive(20.0));
+}
+
+TEST_F(AdaptiveNetSelectorTest, Hysteresis) {
+  Drive(0.0);
+  EXPECT_EQ(1, Drive(9.0));
+  EXPECT_EQ(1, Drive(10.5));
+  EXPECT_EQ(0, Drive(11.5));
+  EXPECT_EQ(0, Drive(10.5));
+  EXPECT_EQ(1, Drive(9.5));
+  EXPECT_EQ(2, Drive(1.5));
+  EXPECT_EQ(2, Drive(2.5));
+  EXPECT_EQ(1, Drive(3.5));
+}
+
+TEST_F(AdaptiveNetSelectorTest, DenseTraffic) {
+  Drive(0.0);
+  EXPECT_EQ(0, Drive(12.0, 20));
+  EXPECT_EQ(1, Drive(12.0, 40));
+  // the traffic stays dense down to 30 objects
+  EXPECT_EQ(1, Drive(12.0, 30));
+  EXPECT_EQ(0, Drive(12.0, 29));
+}
+
+}  // namespace cnnseg
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/caffe_inference.h"
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace perception {
+namespace cnnseg {
+
+bool CaffeInference::Init(const CNNSegParam& param,
+                          const std::string& proto_file,
+                          const std::string& weight_file) {
+/// Instantiate Caffe net
+#ifndef USE_CAFFE_GPU
+  caffe::Caffe::set_mode(caffe::Caffe::CPU);
+#else
+  int gpu_id = param.has_gpu_id() ? static_cast<int>(param.gpu_id()) : 0;
+  CHECK_GE(gpu_id, 0);
+  caffe::Caffe::SetDevice(gpu_id);
+  caffe::Caffe::set_mode(caffe::Caffe::GPU);
+  caffe::Caffe::DeviceQuery();
+#endif
+
+  caffe_net_.reset(new caffe::Net<float>(proto_file, caffe::TEST));
+  caffe_net_->CopyTrainedLayersFrom(weight_file);
+
+#ifndef USE_CAFFE_GPU
+  AINFO << "using Caffe CPU mode";
+#else
+  AINFO << "using Caffe GPU mode";
+#endif
+  return true;
+}
+
+void CaffeInference::Infer() {
+#ifdef USE_CAFFE_GPU
+  caffe::Caffe::set_mode(caffe::Caffe::GPU);
+#endif
+  caffe_net_->Forward();
+}
+
+boost::shared_ptr<caffe::Blob<float>> CaffeInference::GetBlob(
+    const std::string& name) {
+  if (!caffe_net_->has_blob(name)) {
+    return nullptr;
+  }
+  return caffe_net_->blob_by_name(name);
+}
+
+}  // namespace cnnseg
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,63 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_OBSTACLE_LIDAR_SEGMENTATION_CNNSEG_CAFFE_INFERENCE_H_  // NOLINT
+#define MODULES_PERCEPTION_OBSTACLE_LIDAR_SEGMENTATION_CNNSEG_CAFFE_INFERENCE_H_  // NOLINT
+
+#include <memory>
+#include <string>
+
+#include "caffe/caffe.hpp"
+
+#include "modules/common/macro.h"
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/inference.h"
+
+namespace apollo {
+namespace perception {
+namespace cnnseg {
+
+/**
+ * @brief Runs the network in FP32 with Caffe, on the gpu when Caffe is built
+ * with USE_CAFFE_GPU.
+ */
+class CaffeInference : public Inference {
+ public:
+  CaffeInference() = default;
+  ~CaffeInference() = default;
+
+  bool Init(const CNNSegParam& param, const std::string& proto_file,
+            const std::string& weight_file) override;
+
+  void Infer() override;
+
+  boost::shared_ptr<caffe::Blob<float>> GetBlob(
+      const std::string& name) override;
+
+  std::string name() const override {
+    return "CaffeInference";
+  }
+
+ private:
+  std::shared_ptr<caffe::Net<float>> caffe_net_;
+
+  DISALLOW_COPY_AND_ASSIGN(CaffeInference);
+};
+
+}  // namespace cnnseg
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_OBSTACLE_LIDAR_SEGMENTATION_CNNSEG_CAFFE_INFERENCE_H_  // NOLINT
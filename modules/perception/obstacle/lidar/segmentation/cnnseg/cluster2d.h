@@ -18,10 +18,14 @@
 #define MODULES_PERCEPTION_OBSTACLE_LIDAR_SEGMENTATION_CNNSEG_CLUSTER2D_H_
 
 #include <algorithm>
+#include <functional>
+#include <memory>
 #include <vector>
 #include "caffe/caffe.hpp"
 #include "modules/common/log.h"
+#include "modules/common/util/work_stealing_thread_pool.h"
 #include "modules/perception/lib/pcl_util/pcl_types.h"
+#include "modules/perception/lib/pcl_util/soa_point_cloud.h"
 #include "modules/perception/obstacle/base/object.h"
 #include "modules/perception/obstacle/common/disjoint_set.h"
 #include "modules/perception/obstacle/lidar/segmentation/cnnseg/util.h"
@@ -49,7 +53,7 @@ struct Obstacle {
 
   Obstacle() {
     grids.clear();
-    cloud.reset(new apollo::perception::pcl_util::PointCloud);
+    cloud = apollo::perception::GetPooledPointCloud();
     score = 0.0;
     height = -5.0;
     meta_type = META_UNKNOWN;
@@ -62,7 +66,30 @@ class Cluster2D {
   Cluster2D() {}
   ~Cluster2D() {}
 
-  bool Init(int rows, int cols, float range) {
+  /**
+   * @brief Initialize the grid.
+   * @param rows The number of rows of the grid.
+   * @param cols The number of columns of the grid.
+   * @param range The range of the grid on each side, in meters.
+   * @param num_threads The number of worker threads of the per-grid and
+   * per-obstacle passes; 0 runs them in the calling thread only.
+   */
+  bool Init(int rows, int cols, float range, int num_threads = 0) {
+    ResizeGrid(rows, cols, range);
+    thread_pool_.reset();
+    if (num_threads > 0) {
+      thread_pool_.reset(
+          new apollo::common::util::WorkStealingThreadPool(num_threads));
+    }
+    return true;
+  }
+
+  /**
+   * @brief Changes the size of the grid, e.g. for the net of another range.
+   * The worker threads and the storage are kept, so that a grid no larger
+   * than the largest one so far does not allocate.
+   */
+  void ResizeGrid(int rows, int cols, float range) {
     rows_ = rows;
     cols_ = cols;
     grids_ = rows_ * cols_;
@@ -73,9 +100,9 @@ class Cluster2D {
     point2grid_.clear();
     obstacles_.clear();
     id_img_.assign(grids_, -1);
+    nodes_.assign(grids_, Node());
     pc_ptr_.reset();
-    valid_indices_in_pc_ = nullptr;
-    return true;
+    valid_points_ = apollo::perception::pcl_util::SoaPointCloudView();
   }
 
   void Cluster(const caffe::Blob<float>& category_pt_blob,
@@ -83,59 +110,80 @@ class Cluster2D {
                const apollo::perception::pcl_util::PointCloudPtr& pc_ptr,
                const apollo::perception::pcl_util::PointIndices& valid_indices,
                float objectness_thresh, bool use_all_grids_for_clustering) {
+    soa_cloud_.FromPcl(*pc_ptr);
+    Cluster(category_pt_blob, instance_pt_blob, pc_ptr,
+            apollo::perception::pcl_util::SoaPointCloudView(
+                soa_cloud_, valid_indices.indices),
+            objectness_thresh, use_all_grids_for_clustering);
+  }
+
+  // valid_points is a view of pc_ptr laid out as arrays, which must outlive
+  // GetObjects().
+  void Cluster(
+      const caffe::Blob<float>& category_pt_blob,
+      const caffe::Blob<float>& instance_pt_blob,
+      const apollo::perception::pcl_util::PointCloudPtr& pc_ptr,
+      const apollo::perception::pcl_util::SoaPointCloudView& valid_points,
+      float objectness_thresh, bool use_all_grids_for_clustering) {
     const float* category_pt_data = category_pt_blob.cpu_data();
     const float* instance_pt_x_data = instance_pt_blob.cpu_data();
     const float* instance_pt_y_data =
         instance_pt_blob.cpu_data() + instance_pt_blob.offset(0, 1);
 
     pc_ptr_ = pc_ptr;
-    std::vector<std::vector<Node>> nodes(rows_,
-                                         std::vector<Node>(cols_, Node()));
+    // the node buffer is reused from frame to frame
+    ForEachRow([this](const int row) {
+      std::fill(nodes_.begin() + RowCol2Grid(row, 0),
+                nodes_.begin() + RowCol2Grid(row + 1, 0), Node());
+    });
 
     // map points into grids
     size_t tot_point_num = pc_ptr_->size();
-    valid_indices_in_pc_ = &(valid_indices.indices);
-    CHECK_LE(valid_indices_in_pc_->size(), tot_point_num);
-    point2grid_.assign(valid_indices_in_pc_->size(), -1);
-
-    for (size_t i = 0; i < valid_indices_in_pc_->size(); ++i) {
-      int point_id = valid_indices_in_pc_->at(i);
+    valid_points_ = valid_points;
+    CHECK_EQ(valid_points_.cloud().size(), tot_point_num);
+    CHECK_LE(valid_points_.size(), tot_point_num);
+    point2grid_.assign(valid_points_.size(), -1);
+
+    const float* xs = valid_points_.cloud().x();
+    const float* ys = valid_points_.cloud().y();
+    for (size_t i = 0; i < valid_points_.size(); ++i) {
+      int point_id = valid_points_.index(i);
       CHECK_GE(point_id, 0);
       CHECK_LT(point_id, static_cast<int>(tot_point_num));
-      const auto& point = pc_ptr_->points[point_id];
       // * the coordinates of x and y have been exchanged in feature generation
       // step,
       // so we swap them back here.
-      int pos_x = F2I(point.y, range_, inv_res_x_);  // col
-      int pos_y = F2I(point.x, range_, inv_res_y_);  // row
+      int pos_x = F2I(ys[point_id], range_, inv_res_x_);  // col
+      int pos_y = F2I(xs[point_id], range_, inv_res_y_);  // row
       if (IsValidRowCol(pos_y, pos_x)) {
         // get grid index and count point number for corresponding node
         point2grid_[i] = RowCol2Grid(pos_y, pos_x);
-        nodes[pos_y][pos_x].point_num++;
+        nodes_[point2grid_[i]].point_num++;
       }
     }
 
-    // construct graph with center offset prediction and objectness
-    for (int row = 0; row < rows_; row++) {
+    // construct graph with center offset prediction and objectness; the
+    // nodes only point at each other, so the rows are independent
+    ForEachRow([&](const int row) {
       for (int col = 0; col < cols_; col++) {
         int grid = RowCol2Grid(row, col);
-        Node* node = &nodes[row][col];
+        Node* node = &nodes_[grid];
         apollo::perception::DisjointSetMakeSet(node);
         node->is_object =
-            (use_all_grids_for_clustering || nodes[row][col].point_num > 0) &&
+            (use_all_grids_for_clustering || node->point_num > 0) &&
             (*(category_pt_data + grid) >= objectness_thresh);
         int center_row = std::round(row + instance_pt_x_data[grid] * scale_);
         int center_col = std::round(col + instance_pt_y_data[grid] * scale_);
         center_row = std::min(std::max(center_row, 0), rows_ - 1);
         center_col = std::min(std::max(center_col, 0), cols_ - 1);
-        node->center_node = &nodes[center_row][center_col];
+        node->center_node = &nodes_[RowCol2Grid(center_row, center_col)];
       }
-    }
+    });
 
     // traverse nodes
     for (int row = 0; row < rows_; row++) {
       for (int col = 0; col < cols_; col++) {
-        Node* node = &nodes[row][col];
+        Node* node = &nodes_[RowCol2Grid(row, col)];
         if (node->is_object && node->traversed == 0) {
           Traverse(node);
         }
@@ -143,14 +191,14 @@ class Cluster2D {
     }
     for (int row = 0; row < rows_; row++) {
       for (int col = 0; col < cols_; col++) {
-        Node* node = &nodes[row][col];
+        Node* node = &nodes_[RowCol2Grid(row, col)];
         if (!node->is_center) {
           continue;
         }
         for (int row2 = row - 1; row2 <= row + 1; row2++) {
           for (int col2 = col - 1; col2 <= col + 1; col2++) {
             if ((row2 == row || col2 == col) && IsValidRowCol(row2, col2)) {
-              Node* node2 = &nodes[row2][col2];
+              Node* node2 = &nodes_[RowCol2Grid(row2, col2)];
               if (node2->is_center) {
                 apollo::perception::DisjointSetUnion(node, node2);
               }
@@ -162,11 +210,12 @@ class Cluster2D {
 
     int count_obstacles = 0;
     obstacles_.clear();
-    id_img_.assign(grids_, -1);
     for (int row = 0; row < rows_; row++) {
       for (int col = 0; col < cols_; col++) {
-        Node* node = &nodes[row][col];
+        int grid = RowCol2Grid(row, col);
+        Node* node = &nodes_[grid];
         if (!node->is_object) {
+          id_img_[grid] = -1;
           continue;
         }
         Node* root = apollo::perception::DisjointSetFind(node);
@@ -175,7 +224,6 @@ class Cluster2D {
           CHECK_EQ(static_cast<int>(obstacles_.size()), count_obstacles - 1);
           obstacles_.push_back(Obstacle());
         }
-        int grid = RowCol2Grid(row, col);
         CHECK_GE(root->obstacle_id, 0);
         id_img_[grid] = root->obstacle_id;
         obstacles_[root->obstacle_id].grids.push_back(grid);
@@ -188,8 +236,7 @@ class Cluster2D {
               const caffe::Blob<float>& height_pt_blob) {
     const float* confidence_pt_data = confidence_pt_blob.cpu_data();
     const float* height_pt_data = height_pt_blob.cpu_data();
-    for (size_t obstacle_id = 0; obstacle_id < obstacles_.size();
-         obstacle_id++) {
+    ForEachObstacle([&](const size_t obstacle_id) {
       Obstacle* obs = &obstacles_[obstacle_id];
       CHECK_GT(obs->grids.size(), 0);
       double score = 0.0;
@@ -200,15 +247,15 @@ class Cluster2D {
       }
       obs->score = score / static_cast<double>(obs->grids.size());
       obs->height = height / static_cast<double>(obs->grids.size());
-      obs->cloud.reset(new apollo::perception::pcl_util::PointCloud);
-    }
+      obs->cloud->clear();
+    });
   }
 
   void Classify(const caffe::Blob<float>& classify_pt_blob) {
     const float* classify_pt_data = classify_pt_blob.cpu_data();
     int num_classes = classify_pt_blob.channels();
     CHECK_EQ(num_classes, MAX_META_TYPE);
-    for (size_t obs_id = 0; obs_id < obstacles_.size(); obs_id++) {
+    ForEachObstacle([&](const size_t obs_id) {
       Obstacle* obs = &obstacles_[obs_id];
       for (size_t grid_id = 0; grid_id < obs->grids.size(); grid_id++) {
         int grid = obs->grids[grid_id];
@@ -224,12 +271,12 @@ class Cluster2D {
         }
       }
       obs->meta_type = static_cast<MetaType>(meta_type_id);
-    }
+    });
   }
 
   void GetObjects(const float confidence_thresh, const float height_thresh,
                   const int min_pts_num, std::vector<ObjectPtr>* objects) {
-    CHECK(valid_indices_in_pc_ != nullptr);
+    CHECK(valid_points_.valid());
 
     for (size_t i = 0; i < point2grid_.size(); ++i) {
       int grid = point2grid_[i];
@@ -241,14 +288,14 @@ class Cluster2D {
       CHECK_LT(grid, grids_);
       int obstacle_id = id_img_[grid];
 
-      int point_id = valid_indices_in_pc_->at(i);
+      int point_id = valid_points_.index(i);
       CHECK_GE(point_id, 0);
       CHECK_LT(point_id, static_cast<int>(pc_ptr_->size()));
 
       if (obstacle_id >= 0 &&
           obstacles_[obstacle_id].score >= confidence_thresh) {
         if (height_thresh < 0 ||
-            pc_ptr_->points[point_id].z <=
+            valid_points_.z(i) <=
                 obstacles_[obstacle_id].height + height_thresh) {
           obstacles_[obstacle_id].cloud->push_back(pc_ptr_->points[point_id]);
         }
@@ -261,8 +308,11 @@ class Cluster2D {
       if (static_cast<int>(obs->cloud->size()) < min_pts_num) {
         continue;
       }
-      apollo::perception::ObjectPtr out_obj(new apollo::perception::Object);
-      out_obj->cloud = obs->cloud;
+      // the points are moved to the pooled cloud of the object, and its
+      // storage is left to the obstacle for the next frame
+      apollo::perception::ObjectPtr out_obj =
+          apollo::perception::GetPooledObject();
+      out_obj->cloud->swap(*obs->cloud);
       out_obj->score = obs->score;
       out_obj->score_type = SCORE_CNN;
       out_obj->type = GetObjectType(obs->meta_type);
@@ -310,8 +360,35 @@ class Cluster2D {
     return row * cols_ + col;
   }
 
+  // Runs func(row) for every row, on the thread pool if there is one.
+  void ForEachRow(const std::function<void(int)>& func) {
+    if (thread_pool_ == nullptr) {
+      for (int row = 0; row < rows_; ++row) {
+        func(row);
+      }
+      return;
+    }
+    constexpr size_t kRowsPerTask = 16;
+    thread_pool_->ParallelFor(
+        0, rows_, [&func](const size_t row) { func(static_cast<int>(row)); },
+        kRowsPerTask);
+  }
+
+  // Runs func(obstacle_id) for every obstacle, on the thread pool if there
+  // is one.
+  void ForEachObstacle(const std::function<void(size_t)>& func) {
+    if (thread_pool_ == nullptr) {
+      for (size_t obstacle_id = 0; obstacle_id < obstacles_.size();
+           ++obstacle_id) {
+        func(obstacle_id);
+      }
+      return;
+    }
+    thread_pool_->ParallelFor(0, obstacles_.size(), func);
+  }
+
   void Traverse(Node* x) {
-    std::vector<Node*> p;
+    std::vector<Node*>& p = traverse_path_;
     p.clear();
     while (x->traversed == 0) {
       p.push_back(x);
@@ -370,11 +447,20 @@ class Cluster2D {
   float inv_res_y_;
 
   apollo::perception::pcl_util::PointCloudPtr pc_ptr_;
-  const std::vector<int>* valid_indices_in_pc_ = nullptr;
+  apollo::perception::pcl_util::SoaPointCloudView valid_points_;
+  // pc_ptr_ laid out as arrays, when it is not given so
+  apollo::perception::pcl_util::SoaPointCloud soa_cloud_;
 
   std::vector<int> point2grid_;
   std::vector<int> id_img_;
   std::vector<Obstacle> obstacles_;
+
+  // the graph of the grids, row by row, reused from frame to frame
+  std::vector<Node> nodes_;
+  // the path of the current traversal
+  std::vector<Node*> traverse_path_;
+
+  std::unique_ptr<apollo::common::util::WorkStealingThreadPool> thread_pool_;
 };
 
 }  // namespace cnnseg
@@ -41,97 +41,143 @@ bool CNNSegmentation::Init() {
     AERROR << "Failed to load config file of CNNSegmentation.";
   }
 
+  /// instantiate the default net, then the adaptive ones
+  nets_.clear();
+  nets_.resize(1 + cnnseg_param_.adaptive_net_size());
+  if (cnnseg_param_.has_calibration_table_file()) {
+    cnnseg_param_.set_calibration_table_file(GetAbsolutePath(
+        ConfigManager::instance()->work_root(),
+        cnnseg_param_.calibration_table_file()));
+  }
+  if (!InitNet(cnnseg_param_, cnnseg_param_.feature_param(), proto_file,
+               weight_file, &nets_[0])) {
+    return false;
+  }
+  const string& work_root = ConfigManager::instance()->work_root();
+  for (int i = 0; i < cnnseg_param_.adaptive_net_size(); ++i) {
+    const auto& adaptive_net = cnnseg_param_.adaptive_net(i);
+    cnnseg::CNNSegParam net_param = cnnseg_param_;
+    net_param.clear_adaptive_net();
+    net_param.clear_calibration_table_file();
+    if (adaptive_net.has_calibration_table_file()) {
+      net_param.set_calibration_table_file(GetAbsolutePath(
+          work_root, adaptive_net.calibration_table_file()));
+    }
+    if (!InitNet(net_param, adaptive_net.feature_param(),
+                 GetAbsolutePath(work_root, adaptive_net.proto_file()),
+                 GetAbsolutePath(work_root, adaptive_net.weight_file()),
+                 &nets_[i + 1])) {
+      AERROR << "Failed to Init adaptive net " << i << " of CNNSegmentation";
+      return false;
+    }
+  }
+  net_selector_.Init(cnnseg_param_);
+  num_last_objects_ = 0;
+
+  // the clustering grid is sized for the largest net first, so that it
+  // keeps the storage when it switches between the nets
+  int largest = 0;
+  for (size_t i = 1; i < nets_.size(); ++i) {
+    if (nets_[i].width * nets_[i].height >
+        nets_[largest].width * nets_[largest].height) {
+      largest = static_cast<int>(i);
+    }
+  }
+  cluster2d_.reset(new cnnseg::Cluster2D());
+  if (!cluster2d_->Init(
+          nets_[largest].height, nets_[largest].width, nets_[largest].range,
+          static_cast<int>(cnnseg_param_.num_cluster_threads()))) {
+    AERROR << "Fail to Init cluster2d for CNNSegmentation";
+  }
+  net_index_ = 0;
+  range_ = nets_[0].range;
+  width_ = nets_[0].width;
+  height_ = nets_[0].height;
+  cluster2d_->ResizeGrid(height_, width_, range_);
+
+  return true;
+}
+
+bool CNNSegmentation::InitNet(const cnnseg::CNNSegParam& param,
+                              const cnnseg::FeatureParam& feature_param,
+                              const string& proto_file,
+                              const string& weight_file, Net* net) {
   /// set parameters
-  auto network_param = cnnseg_param_.network_param();
-  auto feature_param = cnnseg_param_.feature_param();
+  auto network_param = param.network_param();
 
   if (feature_param.has_point_cloud_range()) {
-    range_ = static_cast<float>(feature_param.point_cloud_range());
+    net->range = static_cast<float>(feature_param.point_cloud_range());
   } else {
-    range_ = 60.0;
+    net->range = 60.0;
   }
   if (feature_param.has_width()) {
-    width_ = static_cast<int>(feature_param.width());
+    net->width = static_cast<int>(feature_param.width());
   } else {
-    width_ = 512;
+    net->width = 512;
   }
   if (feature_param.has_height()) {
-    height_ = static_cast<int>(feature_param.height());
+    net->height = static_cast<int>(feature_param.height());
   } else {
-    height_ = 512;
-  }
-
-/// Instantiate Caffe net
-#ifndef USE_CAFFE_GPU
-  caffe::Caffe::set_mode(caffe::Caffe::CPU);
-#else
-  int gpu_id =
-      cnnseg_param_.has_gpu_id() ? static_cast<int>(cnnseg_param_.gpu_id()) : 0;
-  CHECK_GE(gpu_id, 0);
-  caffe::Caffe::SetDevice(gpu_id);
-  caffe::Caffe::set_mode(caffe::Caffe::GPU);
-  caffe::Caffe::DeviceQuery();
-#endif
-
-  caffe_net_.reset(new caffe::Net<float>(proto_file, caffe::TEST));
-  caffe_net_->CopyTrainedLayersFrom(weight_file);
-
-#ifndef USE_CAFFE_GPU
-  AINFO << "using Caffe CPU mode";
-#else
-  AINFO << "using Caffe GPU mode";
-#endif
-
-  /// set related Caffe blobs
+    net->height = 512;
+  }
+
+  /// instantiate the engine of the network
+  net->inference.reset(cnnseg::CreateInference(param.inference_backend()));
+  if (net->inference == nullptr ||
+      !net->inference->Init(param, proto_file, weight_file)) {
+    AERROR << "Failed to Init the inference of backend "
+           << cnnseg::InferenceBackend_Name(param.inference_backend());
+    return false;
+  }
+  AINFO << "CNNSegmentation inference: " << net->inference->name()
+        << ", range " << net->range << ", grid " << net->width << "x"
+        << net->height;
+
+  /// set related blobs
   // center offset prediction
   string instance_pt_blob_name = network_param.has_instance_pt_blob()
                                      ? network_param.instance_pt_blob()
                                      : "instance_pt";
-  instance_pt_blob_ = caffe_net_->blob_by_name(instance_pt_blob_name);
-  CHECK(instance_pt_blob_ != nullptr) << "`" << instance_pt_blob_name
-                                      << "` not exists!";
+  net->instance_pt_blob = net->inference->GetBlob(instance_pt_blob_name);
+  CHECK(net->instance_pt_blob != nullptr) << "`" << instance_pt_blob_name
+                                          << "` not exists!";
   // objectness prediction
   string category_pt_blob_name = network_param.has_category_pt_blob()
                                      ? network_param.category_pt_blob()
                                      : "category_score";
-  category_pt_blob_ = caffe_net_->blob_by_name(category_pt_blob_name);
-  CHECK(category_pt_blob_ != nullptr) << "`" << category_pt_blob_name
-                                      << "` not exists!";
+  net->category_pt_blob = net->inference->GetBlob(category_pt_blob_name);
+  CHECK(net->category_pt_blob != nullptr) << "`" << category_pt_blob_name
+                                          << "` not exists!";
   // positiveness (foreground object probability) prediction
   string confidence_pt_blob_name = network_param.has_confidence_pt_blob()
                                        ? network_param.confidence_pt_blob()
                                        : "confidence_score";
-  confidence_pt_blob_ = caffe_net_->blob_by_name(confidence_pt_blob_name);
-  CHECK(confidence_pt_blob_ != nullptr) << "`" << confidence_pt_blob_name
-                                        << "` not exists!";
+  net->confidence_pt_blob = net->inference->GetBlob(confidence_pt_blob_name);
+  CHECK(net->confidence_pt_blob != nullptr) << "`" << confidence_pt_blob_name
+                                            << "` not exists!";
   // object height prediction
   string height_pt_blob_name = network_param.has_height_pt_blob()
                                    ? network_param.height_pt_blob()
                                    : "height_pt";
-  height_pt_blob_ = caffe_net_->blob_by_name(height_pt_blob_name);
-  CHECK(height_pt_blob_ != nullptr) << "`" << height_pt_blob_name
-                                    << "` not exists!";
+  net->height_pt_blob = net->inference->GetBlob(height_pt_blob_name);
+  CHECK(net->height_pt_blob != nullptr) << "`" << height_pt_blob_name
+                                        << "` not exists!";
   // raw feature data
   string feature_blob_name =
       network_param.has_feature_blob() ? network_param.feature_blob() : "data";
-  feature_blob_ = caffe_net_->blob_by_name(feature_blob_name);
-  CHECK(feature_blob_ != nullptr) << "`" << feature_blob_name
-                                  << "` not exists!";
+  net->feature_blob = net->inference->GetBlob(feature_blob_name);
+  CHECK(net->feature_blob != nullptr) << "`" << feature_blob_name
+                                      << "` not exists!";
   // class prediction
   string class_pt_blob_name = network_param.has_class_pt_blob()
                                   ? network_param.class_pt_blob()
                                   : "class_score";
-  class_pt_blob_ = caffe_net_->blob_by_name(class_pt_blob_name);
-  CHECK(class_pt_blob_ != nullptr) << "`" << class_pt_blob_name
-                                   << "` not exists!";
-
-  cluster2d_.reset(new cnnseg::Cluster2D());
-  if (!cluster2d_->Init(height_, width_, range_)) {
-    AERROR << "Fail to Init cluster2d for CNNSegmentation";
-  }
+  net->class_pt_blob = net->inference->GetBlob(class_pt_blob_name);
+  CHECK(net->class_pt_blob != nullptr) << "`" << class_pt_blob_name
+                                       << "` not exists!";
 
-  feature_generator_.reset(new cnnseg::FeatureGenerator<float>());
-  if (!feature_generator_->Init(feature_param, feature_blob_.get())) {
+  net->feature_generator.reset(new cnnseg::FeatureGenerator<float>());
+  if (!net->feature_generator->Init(feature_param, net->feature_blob.get())) {
     AERROR << "Fail to Init feature generator for CNNSegmentation";
     return false;
   }
@@ -139,6 +185,22 @@ bool CNNSegmentation::Init() {
   return true;
 }
 
+void CNNSegmentation::SelectNet(const SegmentationOptions& options) {
+  const int net_index = net_selector_.Select(
+      options.timestamp, options.velodyne_trans.get(), num_last_objects_);
+  if (net_index == net_index_) {
+    return;
+  }
+  net_index_ = net_index;
+  const Net& net = nets_[net_index_];
+  range_ = net.range;
+  width_ = net.width;
+  height_ = net.height;
+  cluster2d_->ResizeGrid(height_, width_, range_);
+  AINFO << "CNNSegmentation switches to the net of range " << range_
+        << " at speed " << net_selector_.speed();
+}
+
 bool CNNSegmentation::Segment(const pcl_util::PointCloudPtr& pc_ptr,
                               const pcl_util::PointIndices& valid_indices,
                               const SegmentationOptions& options,
@@ -156,19 +218,23 @@ bool CNNSegmentation::Segment(const pcl_util::PointCloudPtr& pc_ptr,
       (options.origin_cloud != nullptr);
   PERF_BLOCK_START();
 
+  SelectNet(options);
+  const Net& net = nets_[net_index_];
+
+  soa_cloud_.FromPcl(*pc_ptr);
+
   // generate raw features
   if (use_full_cloud_) {
-    feature_generator_->Generate(options.origin_cloud);
+    soa_origin_cloud_.FromPcl(*options.origin_cloud);
+    net.feature_generator->Generate(
+        pcl_util::SoaPointCloudView(soa_origin_cloud_));
   } else {
-    feature_generator_->Generate(pc_ptr);
+    net.feature_generator->Generate(pcl_util::SoaPointCloudView(soa_cloud_));
   }
   PERF_BLOCK_END("[CNNSeg] feature generation");
 
-// network forward process
-#ifdef USE_CAFFE_GPU
-  caffe::Caffe::set_mode(caffe::Caffe::GPU);
-#endif
-  caffe_net_->Forward();
+  // network forward process
+  net.inference->Infer();
   PERF_BLOCK_END("[CNNSeg] CNN forward");
 
   // clutser points and construct segments/objects
@@ -179,14 +245,15 @@ bool CNNSegmentation::Segment(const pcl_util::PointCloudPtr& pc_ptr,
       cnnseg_param_.has_use_all_grids_for_clustering()
           ? cnnseg_param_.use_all_grids_for_clustering()
           : false;
-  cluster2d_->Cluster(*category_pt_blob_, *instance_pt_blob_, pc_ptr,
-                      valid_indices, objectness_thresh,
-                      use_all_grids_for_clustering);
+  cluster2d_->Cluster(
+      *net.category_pt_blob, *net.instance_pt_blob, pc_ptr,
+      pcl_util::SoaPointCloudView(soa_cloud_, valid_indices.indices),
+      objectness_thresh, use_all_grids_for_clustering);
   PERF_BLOCK_END("[CNNSeg] clustering");
 
-  cluster2d_->Filter(*confidence_pt_blob_, *height_pt_blob_);
+  cluster2d_->Filter(*net.confidence_pt_blob, *net.height_pt_blob);
 
-  cluster2d_->Classify(*class_pt_blob_);
+  cluster2d_->Classify(*net.class_pt_blob);
 
   float confidence_thresh = cnnseg_param_.has_confidence_thresh()
                                 ? cnnseg_param_.confidence_thresh()
@@ -198,6 +265,7 @@ bool CNNSegmentation::Segment(const pcl_util::PointCloudPtr& pc_ptr,
                         : 3;
   cluster2d_->GetObjects(confidence_thresh, height_thresh, min_pts_num,
                          objects);
+  num_last_objects_ = static_cast<int>(objects->size());
   PERF_BLOCK_END("[CNNSeg] post-processing");
 
   return true;
@@ -28,10 +28,13 @@
 #include "modules/common/log.h"
 #include "modules/perception/lib/base/timer.h"
 #include "modules/perception/lib/pcl_util/pcl_types.h"
+#include "modules/perception/lib/pcl_util/soa_point_cloud.h"
 #include "modules/perception/obstacle/base/object.h"
 #include "modules/perception/obstacle/lidar/interface/base_segmentation.h"
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/adaptive_net_selector.h"
 #include "modules/perception/obstacle/lidar/segmentation/cnnseg/cluster2d.h"
 #include "modules/perception/obstacle/lidar/segmentation/cnnseg/feature_generator.h"
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/inference.h"
 
 namespace apollo {
 namespace perception {
@@ -63,39 +66,71 @@ class CNNSegmentation : public BaseSegmentation {
   }
 
  private:
+  // A net with the grid of its features, and the blobs it reads and writes.
+  struct Net {
+    // range of bird-view field (for each side)
+    float range = 0.0;
+    // number of cells in bird-view width
+    int width = 0;
+    // number of cells in bird-view height
+    int height = 0;
+
+    // the engine running the network
+    std::unique_ptr<cnnseg::Inference> inference;
+    // bird-view raw feature generator
+    std::shared_ptr<cnnseg::FeatureGenerator<float>> feature_generator;
+
+    // center offset prediction
+    boost::shared_ptr<caffe::Blob<float>> instance_pt_blob;
+    // objectness prediction
+    boost::shared_ptr<caffe::Blob<float>> category_pt_blob;
+    // fg probability prediction
+    boost::shared_ptr<caffe::Blob<float>> confidence_pt_blob;
+    // object height prediction
+    boost::shared_ptr<caffe::Blob<float>> height_pt_blob;
+    // raw features to be input into network
+    boost::shared_ptr<caffe::Blob<float>> feature_blob;
+    // class prediction
+    boost::shared_ptr<caffe::Blob<float>> class_pt_blob;
+  };
+
   bool GetConfigs(std::string* config_file, std::string* proto_file,
                   std::string* weight_file);
-  // range of bird-view field (for each side)
+
+  bool InitNet(const cnnseg::CNNSegParam& param,
+               const cnnseg::FeatureParam& feature_param,
+               const std::string& proto_file, const std::string& weight_file,
+               Net* net);
+
+  // Selects the net of the frame, and resizes the clustering grid to it.
+  void SelectNet(const SegmentationOptions& options);
+
+  // range of bird-view field (for each side), of the selected net
   float range_ = 0.0;
-  // number of cells in bird-view width
+  // number of cells in bird-view width, of the selected net
   int width_ = 0;
-  // number of cells in bird-view height
+  // number of cells in bird-view height, of the selected net
   int height_ = 0;
 
   // paramters of CNNSegmentation
   apollo::perception::cnnseg::CNNSegParam cnnseg_param_;
-  // Caffe network object
-  std::shared_ptr<caffe::Net<float>> caffe_net_;
-
-  // bird-view raw feature generator
-  std::shared_ptr<cnnseg::FeatureGenerator<float>> feature_generator_;
-
-  // center offset prediction
-  boost::shared_ptr<caffe::Blob<float>> instance_pt_blob_;
-  // objectness prediction
-  boost::shared_ptr<caffe::Blob<float>> category_pt_blob_;
-  // fg probability prediction
-  boost::shared_ptr<caffe::Blob<float>> confidence_pt_blob_;
-  // object height prediction
-  boost::shared_ptr<caffe::Blob<float>> height_pt_blob_;
-  // raw features to be input into network
-  boost::shared_ptr<caffe::Blob<float>> feature_blob_;
-  // class prediction
-  boost::shared_ptr<caffe::Blob<float>> class_pt_blob_;
+
+  // the default net, then the adaptive nets of cnnseg_param_, all of which
+  // are initialized once so that switching between them does not allocate
+  std::vector<Net> nets_;
+  int net_index_ = 0;
+  cnnseg::AdaptiveNetSelector net_selector_;
+  // the number of objects of the last frame
+  int num_last_objects_ = 0;
 
   // use all points of cloud to compute features
   bool use_full_cloud_ = false;
 
+  // the input clouds laid out as arrays, reused from frame to frame: they
+  // are converted once per frame for all the stages
+  pcl_util::SoaPointCloud soa_cloud_;
+  pcl_util::SoaPointCloud soa_origin_cloud_;
+
   // clustering model for post-processing
   std::shared_ptr<cnnseg::Cluster2D> cluster2d_;
 
@@ -57,7 +57,15 @@ bool FeatureGenerator<Dtype>::Init(const FeatureParam& feature_param,
   }
 
   Dtype* out_blob_data = nullptr;
+#ifdef USE_CAFFE_GPU
+  host_data_.resize(out_blob_->count());
+  out_blob_data = host_data_.data();
+#else
   out_blob_data = out_blob_->mutable_cpu_data();
+#endif
+  // all the cells start empty, i.e. zero in every channel
+  caffe::caffe_set(out_blob_->count(), Dtype(0), out_blob_data);
+  nonempty_cells_.clear();
 
   int channel_index = 0;
   max_height_data_ = out_blob_data + out_blob_->offset(0, channel_index++);
@@ -90,51 +98,96 @@ bool FeatureGenerator<Dtype>::Init(const FeatureParam& feature_param,
   caffe::caffe_copy(siz, direction_data.data(), direction_data_);
   caffe::caffe_copy(siz, distance_data.data(), distance_data_);
 
+#ifdef USE_CAFFE_GPU
+  // the direction and distance channels stay on the GPU from now on
+  caffe::caffe_gpu_memcpy(out_blob_->count() * sizeof(Dtype), out_blob_data,
+                          out_blob_->mutable_gpu_data());
+#endif
+
   return true;
 }
 
+template <typename Dtype>
+inline int FeatureGenerator<Dtype>::MapIndex(float x, float y, float z,
+                                             float inv_res_x,
+                                             float inv_res_y) const {
+  // * the coordinates of x and y are exchanged here
+  // (row <-> x, column <-> y)
+  const int col = F2I(y, range_, inv_res_x);
+  const int row = F2I(x, range_, inv_res_y);
+  const bool valid = z > min_height_ && z < max_height_ && col >= 0 &&
+                     col < width_ && row >= 0 && row < height_;
+  return valid ? row * width_ + col : -1;
+}
+
 template <typename Dtype>
 void FeatureGenerator<Dtype>::Generate(
     const apollo::perception::pcl_util::PointCloudConstPtr& pc_ptr) {
-  const auto& points = pc_ptr->points;
+  soa_cloud_.FromPcl(*pc_ptr);
+  Generate(apollo::perception::pcl_util::SoaPointCloudView(soa_cloud_));
+}
 
+template <typename Dtype>
+void FeatureGenerator<Dtype>::Generate(
+    const apollo::perception::pcl_util::SoaPointCloudView& points) {
+#ifndef USE_CAFFE_GPU
   // DO NOT remove this line!!!
   // Otherwise, the gpu_data will not be updated for the later frames.
   // It marks the head at cpu for blob.
   out_blob_->mutable_cpu_data();
+#endif
+
+  // Only the cells which were non-empty in the last frame are reset: the
+  // empty ones are zero in every channel already.
+  for (const int idx : nonempty_cells_) {
+    max_height_data_[idx] = Dtype(0);
+    mean_height_data_[idx] = Dtype(0);
+    count_data_[idx] = Dtype(0);
+    top_intensity_data_[idx] = Dtype(0);
+    mean_intensity_data_[idx] = Dtype(0);
+    nonempty_data_[idx] = Dtype(0);
+  }
+  nonempty_cells_.clear();
 
-  int siz = height_ * width_;
-  caffe::caffe_set(siz, Dtype(-5), max_height_data_);
-  caffe::caffe_set(siz, Dtype(0), mean_height_data_);
-  caffe::caffe_set(siz, Dtype(0), count_data_);
-  caffe::caffe_set(siz, Dtype(0), top_intensity_data_);
-  caffe::caffe_set(siz, Dtype(0), mean_intensity_data_);
-  caffe::caffe_set(siz, Dtype(0), nonempty_data_);
-
-  map_idx_.resize(points.size());
+  const size_t num_points = points.size();
+  map_idx_.resize(num_points);
   float inv_res_x =
       0.5 * static_cast<float>(width_) / static_cast<float>(range_);
   float inv_res_y =
       0.5 * static_cast<float>(height_) / static_cast<float>(range_);
 
-  for (size_t i = 0; i < points.size(); ++i) {
-    if (points[i].z <= min_height_ || points[i].z >= max_height_) {
-      map_idx_[i] = -1;
-      continue;
+  // The cells of the points are computed first, without branches, over the
+  // contiguous coordinates, so that the loop is vectorized when the view
+  // has no indices.
+  const float* xs = points.cloud().x();
+  const float* ys = points.cloud().y();
+  const float* zs = points.cloud().z();
+  const float* intensities = points.cloud().intensity();
+  if (points.has_indices()) {
+    for (size_t i = 0; i < num_points; ++i) {
+      const int id = points.index(i);
+      map_idx_[i] = MapIndex(xs[id], ys[id], zs[id], inv_res_x, inv_res_y);
     }
-    // * the coordinates of x and y are exchanged here
-    // (row <-> x, column <-> y)
-    int pos_x = F2I(points[i].y, range_, inv_res_x);  // col
-    int pos_y = F2I(points[i].x, range_, inv_res_y);  // row
-    if (pos_x >= width_ || pos_x < 0 || pos_y >= height_ || pos_y < 0) {
-      map_idx_[i] = -1;
-      continue;
+  } else {
+    int* map_idx = map_idx_.data();
+    for (size_t i = 0; i < num_points; ++i) {
+      map_idx[i] = MapIndex(xs[i], ys[i], zs[i], inv_res_x, inv_res_y);
     }
-    map_idx_[i] = pos_y * width_ + pos_x;
+  }
 
-    int idx = map_idx_[i];
-    float pz = points[i].z;
-    float pi = points[i].intensity / 255.0;
+  for (size_t i = 0; i < num_points; ++i) {
+    const int idx = map_idx_[i];
+    if (idx < 0) {
+      continue;
+    }
+    if (count_data_[idx] < EPS) {
+      // the first point of the cell
+      max_height_data_[idx] = Dtype(-5);
+      nonempty_cells_.push_back(idx);
+    }
+    const int id = points.index(i);
+    float pz = zs[id];
+    float pi = intensities[id] / 255.0;
     if (max_height_data_[idx] < pz) {
       max_height_data_[idx] = pz;
       top_intensity_data_[idx] = pi;
@@ -144,16 +197,35 @@ void FeatureGenerator<Dtype>::Generate(
     count_data_[idx] += Dtype(1);
   }
 
-  for (int i = 0; i < siz; ++i) {
-    if (count_data_[i] < EPS) {
-      max_height_data_[i] = Dtype(0);
-    } else {
-      mean_height_data_[i] /= count_data_[i];
-      mean_intensity_data_[i] /= count_data_[i];
-      nonempty_data_[i] = Dtype(1);
-    }
-    count_data_[i] = LogCount(static_cast<int>(count_data_[i]));
+  for (const int idx : nonempty_cells_) {
+    mean_height_data_[idx] /= count_data_[idx];
+    mean_intensity_data_[idx] /= count_data_[idx];
+    nonempty_data_[idx] = Dtype(1);
+    count_data_[idx] = LogCount(static_cast<int>(count_data_[idx]));
   }
+
+#ifdef USE_CAFFE_GPU
+  UploadToGpu();
+#endif
+}
+
+template <typename Dtype>
+void FeatureGenerator<Dtype>::UploadToGpu() {
+#ifdef USE_CAFFE_GPU
+  // It also marks the head at gpu for blob, so that the net does not upload
+  // its stale cpu data.
+  Dtype* gpu_data = out_blob_->mutable_gpu_data();
+  const Dtype* host_data = host_data_.data();
+  const size_t channel_bytes = height_ * width_ * sizeof(Dtype);
+  // max height, mean height and count are contiguous channels, as are top
+  // and mean intensity, between the direction and distance channels.
+  caffe::caffe_gpu_memcpy(3 * channel_bytes, max_height_data_,
+                          gpu_data + (max_height_data_ - host_data));
+  caffe::caffe_gpu_memcpy(2 * channel_bytes, top_intensity_data_,
+                          gpu_data + (top_intensity_data_ - host_data));
+  caffe::caffe_gpu_memcpy(channel_bytes, nonempty_data_,
+                          gpu_data + (nonempty_data_ - host_data));
+#endif
 }
 
 template bool FeatureGenerator<float>::Init(const FeatureParam& feature_param,
@@ -162,12 +234,18 @@ template bool FeatureGenerator<float>::Init(const FeatureParam& feature_param,
 template void FeatureGenerator<float>::Generate(
     const apollo::perception::pcl_util::PointCloudConstPtr& pc_ptr);
 
+template void FeatureGenerator<float>::Generate(
+    const apollo::perception::pcl_util::SoaPointCloudView& points);
+
 template bool FeatureGenerator<double>::Init(const FeatureParam& feature_param,
                                              caffe::Blob<double>* blob);
 
 template void FeatureGenerator<double>::Generate(
     const apollo::perception::pcl_util::PointCloudConstPtr& pc_ptr);
 
+template void FeatureGenerator<double>::Generate(
+    const apollo::perception::pcl_util::SoaPointCloudView& points);
+
 }  // namespace cnnseg
 }  // namespace perception
 }  // namespace apollo
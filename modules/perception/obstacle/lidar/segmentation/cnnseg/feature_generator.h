@@ -23,6 +23,7 @@
 #include "caffe/caffe.hpp"
 #include "modules/common/log.h"
 #include "modules/perception/lib/pcl_util/pcl_types.h"
+#include "modules/perception/lib/pcl_util/soa_point_cloud.h"
 #include "modules/perception/obstacle/lidar/segmentation/cnnseg/proto/cnnseg.pb.h"
 
 namespace apollo {
@@ -40,6 +41,9 @@ class FeatureGenerator {
 
   void Generate(const apollo::perception::pcl_util::PointCloudConstPtr& pc_ptr);
 
+  // Generates the features of the points of the view, laid out as arrays.
+  void Generate(const apollo::perception::pcl_util::SoaPointCloudView& points);
+
   inline std::string name() const {
     return "FeatureGenerator";
   }
@@ -52,6 +56,14 @@ class FeatureGenerator {
     return std::log(static_cast<Dtype>(1 + count));
   }
 
+  // Gets the index of the cell of a point, or -1 when the point is out of
+  // the feature map.
+  int MapIndex(float x, float y, float z, float inv_res_x,
+               float inv_res_y) const;
+
+  // Upload the channels that change from frame to frame to the GPU blob.
+  void UploadToGpu();
+
   std::vector<Dtype> log_table_;
 
   int width_ = 0;
@@ -74,6 +86,16 @@ class FeatureGenerator {
   // point index in feature map
   std::vector<int> map_idx_;
 
+  // the PCL clouds are converted into this one, reused from frame to frame
+  apollo::perception::pcl_util::SoaPointCloud soa_cloud_;
+
+  // the non-empty cells of the last frame, the only ones to reset
+  std::vector<int> nonempty_cells_;
+
+  // In GPU mode, the features are generated in this host buffer, laid out
+  // as the blob, and only the channels that change are uploaded.
+  std::vector<Dtype> host_data_;
+
   // output Caffe blob
   caffe::Blob<Dtype>* out_blob_ = nullptr;
 };
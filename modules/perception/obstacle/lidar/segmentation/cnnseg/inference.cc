@@ -0,0 +1,48 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/inference.h"
+
+#include "modules/common/log.h"
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/caffe_inference.h"
+#ifdef USE_TENSORRT
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/tensorrt_inference.h"
+#endif
+
+namespace apollo {
+namespace perception {
+namespace cnnseg {
+
+Inference* CreateInference(InferenceBackend backend) {
+  switch (backend) {
+    case CAFFE:
+      return new CaffeInference();
+    case TENSORRT:
+#ifdef USE_TENSORRT
+      return new TensorRTInference();
+#else
+      AERROR << "TensorRT inference is not built in, build with "
+             << "--define INFERENCE=tensorrt.";
+      return nullptr;
+#endif
+  }
+  AERROR << "unknown inference backend: " << backend;
+  return nullptr;
+}
+
+}  // namespace cnnseg
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_OBSTACLE_LIDAR_SEGMENTATION_CNNSEG_INFERENCE_H_
+#define MODULES_PERCEPTION_OBSTACLE_LIDAR_SEGMENTATION_CNNSEG_INFERENCE_H_
+
+#include <string>
+
+#include "caffe/caffe.hpp"
+
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/proto/cnnseg.pb.h"
+
+namespace apollo {
+namespace perception {
+namespace cnnseg {
+
+/**
+ * @brief Runs the network of CNNSegmentation. Whatever the engine, the
+ * features are written to the input blob and the predictions are read from
+ * the output blobs as Caffe blobs of the layout of the Caffe network, so the
+ * feature generator and the clustering do not depend on the engine.
+ */
+class Inference {
+ public:
+  Inference() = default;
+  virtual ~Inference() = default;
+
+  /**
+   * @param param The inputs and outputs of the network are the blobs named
+   * in network_param.
+   * @param proto_file The Caffe prototxt of the network.
+   * @param weight_file The Caffe weights of the network.
+   */
+  virtual bool Init(const CNNSegParam& param, const std::string& proto_file,
+                    const std::string& weight_file) = 0;
+
+  /**
+   * @brief Computes the output blobs from the input blob, synchronously.
+   */
+  virtual void Infer() = 0;
+
+  /**
+   * @brief Gets the input or the output blob of the name, null if not found.
+   */
+  virtual boost::shared_ptr<caffe::Blob<float>> GetBlob(
+      const std::string& name) = 0;
+
+  virtual std::string name() const = 0;
+};
+
+/**
+ * @brief Creates the inference of the backend, null if the backend is not
+ * built in.
+ */
+Inference* CreateInference(InferenceBackend backend);
+
+}  // namespace cnnseg
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_OBSTACLE_LIDAR_SEGMENTATION_CNNSEG_INFERENCE_H_
@@ -0,0 +1,247 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/tensorrt_inference.h"
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+
+#include "NvCaffeParser.h"
+#include "NvInfer.h"
+
+#include "modules/common/log.h"
+
+#ifndef USE_CAFFE_GPU
+#error "TensorRTInference needs the gpu blobs of Caffe built with USE_CAFFE_GPU"
+#endif
+
+namespace apollo {
+namespace perception {
+namespace cnnseg {
+
+namespace {
+
+class Logger : public nvinfer1::ILogger {
+ public:
+  void log(Severity severity, const char* msg) override {
+    switch (severity) {
+      case Severity::kINTERNAL_ERROR:
+      case Severity::kERROR:
+        AERROR << "TensorRT: " << msg;
+        break;
+      case Severity::kWARNING:
+        AWARN << "TensorRT: " << msg;
+        break;
+      default:
+        ADEBUG << "TensorRT: " << msg;
+        break;
+    }
+  }
+};
+
+// the engines use the logger until they are destroyed
+Logger* GetLogger() {
+  static Logger logger;
+  return &logger;
+}
+
+// Gives TensorRT the calibration table computed offline for the network, so
+// the INT8 engine is built without calibration batches.
+class CalibrationTable : public nvinfer1::IInt8EntropyCalibrator {
+ public:
+  explicit CalibrationTable(const std::string& file) : file_(file) {}
+
+  bool Load() {
+    std::ifstream fin(file_, std::ios::binary);
+    if (!fin) {
+      return false;
+    }
+    table_.assign(std::istreambuf_iterator<char>(fin),
+                  std::istreambuf_iterator<char>());
+    return !table_.empty();
+  }
+
+  int getBatchSize() const override {
+    return 1;
+  }
+
+  bool getBatch(void* bindings[], const char* names[],
+                int num_bindings) override {
+    return false;
+  }
+
+  const void* readCalibrationCache(size_t& length) override {  // NOLINT
+    length = table_.size();
+    return table_.data();
+  }
+
+  void writeCalibrationCache(const void* cache, size_t length) override {}
+
+ private:
+  std::string file_;
+  std::vector<char> table_;
+};
+
+template <typename T>
+struct Destroyer {
+  void operator()(T* object) const {
+    if (object != nullptr) {
+      object->destroy();
+    }
+  }
+};
+
+template <typename T>
+using TensorRTPtr = std::unique_ptr<T, Destroyer<T>>;
+
+}  // namespace
+
+TensorRTInference::~TensorRTInference() {
+  if (context_ != nullptr) {
+    context_->destroy();
+  }
+  if (engine_ != nullptr) {
+    engine_->destroy();
+  }
+}
+
+bool TensorRTInference::Init(const CNNSegParam& param,
+                             const std::string& proto_file,
+                             const std::string& weight_file) {
+  caffe::Caffe::SetDevice(static_cast<int>(param.gpu_id()));
+  caffe::Caffe::set_mode(caffe::Caffe::GPU);
+
+  TensorRTPtr<nvinfer1::IBuilder> builder(
+      nvinfer1::createInferBuilder(*GetLogger()));
+  TensorRTPtr<nvinfer1::INetworkDefinition> network(builder->createNetwork());
+  TensorRTPtr<nvcaffeparser1::ICaffeParser> parser(
+      nvcaffeparser1::createCaffeParser());
+
+  const InferencePrecision precision = param.inference_precision();
+  if (precision == FP16 && !builder->platformHasFastFp16()) {
+    AWARN << "the gpu has no fast FP16, the engine may be slower than FP32.";
+  }
+  if (precision == INT8 && !builder->platformHasFastInt8()) {
+    AWARN << "the gpu has no fast INT8, the engine may be slower than FP32.";
+  }
+  // the FP16 engine keeps the weights in FP16 too
+  const nvinfer1::DataType weight_type = precision == FP16
+                                             ? nvinfer1::DataType::kHALF
+                                             : nvinfer1::DataType::kFLOAT;
+  const nvcaffeparser1::IBlobNameToTensor* tensors = parser->parse(
+      proto_file.c_str(), weight_file.c_str(), *network, weight_type);
+  if (tensors == nullptr) {
+    AERROR << "failed to parse the network: " << proto_file;
+    return false;
+  }
+  const NetworkParam& network_param = param.network_param();
+  const std::vector<std::string> outputs = {
+      network_param.instance_pt_blob(), network_param.category_pt_blob(),
+      network_param.confidence_pt_blob(), network_param.height_pt_blob(),
+      network_param.class_pt_blob()};
+  for (const std::string& output : outputs) {
+    nvinfer1::ITensor* tensor = tensors->find(output.c_str());
+    if (tensor == nullptr) {
+      AERROR << "`" << output << "` not exists!";
+      return false;
+    }
+    network->markOutput(*tensor);
+  }
+
+  builder->setMaxBatchSize(1);
+  builder->setMaxWorkspaceSize(
+      static_cast<size_t>(param.max_workspace_size_in_mb()) << 20);
+  std::unique_ptr<CalibrationTable> calibration_table;
+  if (precision == FP16) {
+    builder->setFp16Mode(true);
+  } else if (precision == INT8) {
+    calibration_table.reset(
+        new CalibrationTable(param.calibration_table_file()));
+    if (!calibration_table->Load()) {
+      AERROR << "failed to load the INT8 calibration table: "
+             << param.calibration_table_file();
+      return false;
+    }
+    builder->setInt8Mode(true);
+    builder->setInt8Calibrator(calibration_table.get());
+  }
+  engine_ = builder->buildCudaEngine(*network);
+  if (engine_ == nullptr) {
+    AERROR << "failed to build the TensorRT engine of " << proto_file;
+    return false;
+  }
+  context_ = engine_->createExecutionContext();
+  if (context_ == nullptr) {
+    AERROR << "failed to create the TensorRT execution context.";
+    return false;
+  }
+  if (!InitBindings()) {
+    return false;
+  }
+  AINFO << "using TensorRT " << InferencePrecision_Name(precision)
+        << " engine";
+  return true;
+}
+
+bool TensorRTInference::InitBindings() {
+  const int num_bindings = engine_->getNbBindings();
+  bindings_.resize(num_bindings);
+  buffers_.assign(num_bindings, nullptr);
+  for (int i = 0; i < num_bindings; ++i) {
+    const nvinfer1::Dims dims = engine_->getBindingDimensions(i);
+    if (dims.nbDims != 3) {
+      AERROR << "the binding " << engine_->getBindingName(i)
+             << " is not in CHW.";
+      return false;
+    }
+    Binding& binding = bindings_[i];
+    binding.blob.reset(
+        new caffe::Blob<float>(1, dims.d[0], dims.d[1], dims.d[2]));
+    binding.count = binding.blob->count();
+    binding.is_input = engine_->bindingIsInput(i);
+    blobs_[engine_->getBindingName(i)] = binding.blob;
+  }
+  return true;
+}
+
+void TensorRTInference::Infer() {
+  caffe::Caffe::set_mode(caffe::Caffe::GPU);
+  for (size_t i = 0; i < bindings_.size(); ++i) {
+    caffe::Blob<float>* blob = bindings_[i].blob.get();
+    CHECK_EQ(bindings_[i].count, blob->count())
+        << "the blob of the binding " << i << " is reshaped.";
+    // the input is synced to the gpu and the outputs are read back to the
+    // host when the clustering reads them
+    buffers_[i] = bindings_[i].is_input ? const_cast<float*>(blob->gpu_data())
+                                        : blob->mutable_gpu_data();
+  }
+  CHECK(context_->execute(1, buffers_.data()))
+      << "failed to run the TensorRT engine.";
+}
+
+boost::shared_ptr<caffe::Blob<float>> TensorRTInference::GetBlob(
+    const std::string& name) {
+  auto iter = blobs_.find(name);
+  if (iter == blobs_.end()) {
+    return nullptr;
+  }
+  return iter->second;
+}
+
+}  // namespace cnnseg
+}  // namespace perception
+}  // namespace apollo
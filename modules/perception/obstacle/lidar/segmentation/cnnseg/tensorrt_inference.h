@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_OBSTACLE_LIDAR_SEGMENTATION_CNNSEG_TENSORRT_INFERENCE_H_  // NOLINT
+#define MODULES_PERCEPTION_OBSTACLE_LIDAR_SEGMENTATION_CNNSEG_TENSORRT_INFERENCE_H_  // NOLINT
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "caffe/caffe.hpp"
+
+#include "modules/common/macro.h"
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/inference.h"
+
+namespace nvinfer1 {
+class ICudaEngine;
+class IExecutionContext;
+}  // namespace nvinfer1
+
+namespace apollo {
+namespace perception {
+namespace cnnseg {
+
+/**
+ * @brief Runs the network with a TensorRT engine built from the Caffe
+ * network, in the precision of inference_precision. INT8 needs the
+ * calibration table of the network in calibration_table_file. The engine
+ * reads and writes the gpu memory of the blobs, so the blobs are synced
+ * with the host as Caffe blobs are.
+ */
+class TensorRTInference : public Inference {
+ public:
+  TensorRTInference() = default;
+  ~TensorRTInference();
+
+  bool Init(const CNNSegParam& param, const std::string& proto_file,
+            const std::string& weight_file) override;
+
+  void Infer() override;
+
+  boost::shared_ptr<caffe::Blob<float>> GetBlob(
+      const std::string& name) override;
+
+  std::string name() const override {
+    return "TensorRTInference";
+  }
+
+ private:
+  struct Binding {
+    boost::shared_ptr<caffe::Blob<float>> blob;
+    int count = 0;
+    bool is_input = false;
+  };
+
+  bool InitBindings();
+
+  nvinfer1::ICudaEngine* engine_ = nullptr;
+  nvinfer1::IExecutionContext* context_ = nullptr;
+  // in the order of the binding indexes of the engine
+  std::vector<Binding> bindings_;
+  std::vector<void*> buffers_;
+  std::map<std::string, boost::shared_ptr<caffe::Blob<float>>> blobs_;
+
+  DISALLOW_COPY_AND_ASSIGN(TensorRTInference);
+};
+
+}  // namespace cnnseg
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_OBSTACLE_LIDAR_SEGMENTATION_CNNSEG_TENSORRT_INFERENCE_H_  // NOLINT
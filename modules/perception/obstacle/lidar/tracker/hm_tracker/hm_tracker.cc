@@ -457,9 +457,10 @@ void HmObjectTracker::ConstructTrackedObjects(
   tracked_objects->clear();
   tracked_objects->resize(num_objects);
   for (int i = 0; i < num_objects; ++i) {
-    ObjectPtr obj(new Object());
+    ObjectPtr obj = GetPooledObject();
     obj->clone(*objects[i]);
-    (*tracked_objects)[i].reset(new TrackedObject(obj));
+    (*tracked_objects)[i] = GetPooledTrackedObject();
+    *(*tracked_objects)[i] = TrackedObject(obj);
     // Computing shape featrue
     if (use_histogram_for_match_) {
       ComputeShapeFeatures(&((*tracked_objects)[i]));
@@ -589,7 +590,7 @@ void HmObjectTracker::CollectTrackedResults(
         collect_consecutive_invisible_maximum_)
       continue;
     if (tracks[i]->age_ < collect_age_minimum_) continue;
-    ObjectPtr obj(new Object);
+    ObjectPtr obj = GetPooledObject();
     TrackedObjectPtr result_obj = tracks[i]->current_object_;
     obj->clone(*(result_obj->object_ptr));
     // fill tracked information of object
@@ -14,10 +14,14 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "modules/common/log.h"
+#include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/obstacle/common/geometry_util.h"
 #include "modules/perception/obstacle/common/graph_util.h"
 #include "modules/perception/obstacle/common/hungarian_bigraph_matcher.h"
@@ -29,6 +33,13 @@ namespace perception {
 
 float HungarianMatcher::s_match_distance_maximum_ = 4.0f;
 
+HungarianMatcher::HungarianMatcher() {
+  if (FLAGS_hm_tracker_num_matching_threads > 0) {
+    thread_pool_.reset(new apollo::common::util::WorkStealingThreadPool(
+        FLAGS_hm_tracker_num_matching_threads));
+  }
+}
+
 bool HungarianMatcher::SetMatchDistanceMaximum(
     const float& match_distance_maximum) {
   if (match_distance_maximum >= 0) {
@@ -47,47 +58,55 @@ void HungarianMatcher::Match(std::vector<TrackedObjectPtr>* objects,
                              std::vector<TrackObjectPair>* assignments,
                              std::vector<int>* unassigned_tracks,
                              std::vector<int>* unassigned_objects) {
-  // A. computing association matrix
-  Eigen::MatrixXf association_mat(tracks.size(), objects->size());
-  ComputeAssociateMatrix(tracks, tracks_predict, (*objects), &association_mat);
+  // A. computing association graph
+  std::vector<std::vector<int>> association_graph;
+  ComputeAssociateGraph(tracks, tracks_predict, (*objects), &association_graph);
 
   // B. computing connected components
   std::vector<std::vector<int>> object_components;
   std::vector<std::vector<int>> track_components;
-  ComputeConnectedComponents(association_mat, s_match_distance_maximum_,
+  ComputeConnectedComponents(association_graph, tracks.size(),
                              &track_components, &object_components);
   ADEBUG << "HungarianMatcher: partition graph into " << track_components.size()
          << " sub-graphs.";
 
-  // C. matching each sub-graph
+  // C. matching each sub-graph, sub-graphs are independent of each other
+  size_t no_component = track_components.size();
+  std::vector<std::vector<TrackObjectPair>> sub_assignments(no_component);
+  std::vector<std::vector<int>> sub_unassigned_tracks(no_component);
+  std::vector<std::vector<int>> sub_unassigned_objects(no_component);
+  auto match_component = [&](const size_t i) {
+    MatchInComponents(tracks, tracks_predict, (*objects), track_components[i],
+                      object_components[i], &sub_assignments[i],
+                      &sub_unassigned_tracks[i], &sub_unassigned_objects[i]);
+  };
+  if (thread_pool_ == nullptr) {
+    for (size_t i = 0; i < no_component; ++i) {
+      match_component(i);
+    }
+  } else {
+    thread_pool_->ParallelFor(0, no_component, match_component);
+  }
+
   assignments->clear();
   unassigned_tracks->clear();
   unassigned_objects->clear();
-  for (size_t i = 0; i < track_components.size(); i++) {
-    std::vector<TrackObjectPair> sub_assignments;
-    std::vector<int> sub_unassigned_tracks;
-    std::vector<int> sub_unassigned_objects;
-    MatchInComponents(association_mat, track_components[i],
-                      object_components[i], &sub_assignments,
-                      &sub_unassigned_tracks, &sub_unassigned_objects);
-    for (size_t j = 0; j < sub_assignments.size(); ++j) {
-      int track_id = sub_assignments[j].first;
-      int object_id = sub_assignments[j].second;
-      assignments->push_back(sub_assignments[j]);
-      float association_score = association_mat(track_id, object_id);
-      (*objects)[object_id]->association_score = association_score;
-    }
-    for (size_t j = 0; j < sub_unassigned_tracks.size(); ++j) {
-      unassigned_tracks->push_back(sub_unassigned_tracks[j]);
-    }
-    for (size_t j = 0; j < sub_unassigned_objects.size(); ++j) {
-      unassigned_objects->push_back(sub_unassigned_objects[j]);
-    }
+  for (size_t i = 0; i < no_component; i++) {
+    assignments->insert(assignments->end(), sub_assignments[i].begin(),
+                        sub_assignments[i].end());
+    unassigned_tracks->insert(unassigned_tracks->end(),
+                              sub_unassigned_tracks[i].begin(),
+                              sub_unassigned_tracks[i].end());
+    unassigned_objects->insert(unassigned_objects->end(),
+                               sub_unassigned_objects[i].begin(),
+                               sub_unassigned_objects[i].end());
   }
 }
 
 void HungarianMatcher::MatchInComponents(
-    const Eigen::MatrixXf& association_mat,
+    const std::vector<ObjectTrackPtr>& tracks,
+    const std::vector<Eigen::VectorXf>& tracks_predict,
+    const std::vector<TrackedObjectPtr>& objects,
     const std::vector<int>& track_component,
     const std::vector<int>& object_component,
     std::vector<TrackObjectPair>* sub_assignments,
@@ -112,8 +131,11 @@ void HungarianMatcher::MatchInComponents(
   if (track_component.size() == 1 && object_component.size() == 1) {
     int track_id = track_component[0];
     int object_id = object_component[0];
-    if (association_mat(track_id, object_id) <= s_match_distance_maximum_) {
+    float association_score = TrackObjectDistance::ComputeDistance(
+        tracks[track_id], tracks_predict[track_id], objects[object_id]);
+    if (association_score <= s_match_distance_maximum_) {
       sub_assignments->push_back(std::make_pair(track_id, object_id));
+      objects[object_id]->association_score = association_score;
     } else {
       sub_unassigned_objects->push_back(object_id);
       sub_unassigned_tracks->push_back(track_id);
@@ -140,7 +162,8 @@ void HungarianMatcher::MatchInComponents(
     for (size_t j = 0; j < object_component.size(); ++j) {
       int track_id = track_component[i];
       int object_id = object_component[j];
-      local_association_mat(i, j) = association_mat(track_id, object_id);
+      local_association_mat(i, j) = TrackObjectDistance::ComputeDistance(
+          tracks[track_id], tracks_predict[track_id], objects[object_id]);
     }
   }
   local_assignments.resize(local_association_mat.cols());
@@ -154,6 +177,8 @@ void HungarianMatcher::MatchInComponents(
     int global_object_id = object_local2global[local_assignments[i].second];
     sub_assignments->push_back(
         std::make_pair(global_track_id, global_object_id));
+    objects[global_object_id]->association_score = local_association_mat(
+        local_assignments[i].first, local_assignments[i].second);
   }
   for (size_t i = 0; i < local_unassigned_tracks.size(); ++i) {
     int global_track_id = track_local2global[local_unassigned_tracks[i]];
@@ -165,40 +190,89 @@ void HungarianMatcher::MatchInComponents(
   }
 }
 
-void HungarianMatcher::ComputeAssociateMatrix(
+void HungarianMatcher::ComputeAssociateGraph(
     const std::vector<ObjectTrackPtr>& tracks,
     const std::vector<Eigen::VectorXf>& tracks_predict,
     const std::vector<TrackedObjectPtr>& new_objects,
-    Eigen::MatrixXf* association_mat) {
-  // Compute matrix of association distance
-  for (size_t i = 0; i < tracks.size(); ++i) {
-    for (size_t j = 0; j < new_objects.size(); ++j) {
-      (*association_mat)(i, j) = TrackObjectDistance::ComputeDistance(
+    std::vector<std::vector<int>>* association_graph) {
+  int no_track = tracks.size();
+  int no_object = new_objects.size();
+  association_graph->clear();
+  association_graph->resize(no_track + no_object);
+
+  // Objects are put into a grid with cells of gating radius, so that only the
+  // objects in the 3 x 3 cells around the predicted location of a track are
+  // evaluated. Pairs out of gating radius, or with non-finite locations, are
+  // farther than match distance maximum anyway.
+  float gating_radius = TrackObjectDistance::ComputeLocationGatingRadius(
+      s_match_distance_maximum_);
+  bool use_grid = std::isfinite(gating_radius) && gating_radius > 0;
+  auto cell_key = [gating_radius](const float x, const float y) {
+    int64_t cell_x = static_cast<int64_t>(std::floor(x / gating_radius));
+    int64_t cell_y = static_cast<int64_t>(std::floor(y / gating_radius));
+    return (cell_x << 32) ^ (cell_y & 0xffffffff);
+  };
+  std::unordered_map<int64_t, std::vector<int>> grid;
+  if (use_grid) {
+    for (int j = 0; j < no_object; ++j) {
+      const Eigen::Vector3f& anchor_point = new_objects[j]->anchor_point;
+      if (std::isfinite(anchor_point(0)) && std::isfinite(anchor_point(1))) {
+        grid[cell_key(anchor_point(0), anchor_point(1))].push_back(j);
+      }
+    }
+  }
+
+  std::vector<int> candidates;
+  for (int i = 0; i < no_track; i++) {
+    candidates.clear();
+    Eigen::Vector2f predicted_anchor_point = tracks_predict[i].head(2);
+    if (!use_grid) {
+      for (int j = 0; j < no_object; ++j) {
+        candidates.push_back(j);
+      }
+    } else if (std::isfinite(predicted_anchor_point(0)) &&
+               std::isfinite(predicted_anchor_point(1))) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        for (int dy = -1; dy <= 1; ++dy) {
+          auto it = grid.find(
+              cell_key(predicted_anchor_point(0) + dx * gating_radius,
+                       predicted_anchor_point(1) + dy * gating_radius));
+          if (it != grid.end()) {
+            candidates.insert(candidates.end(), it->second.begin(),
+                              it->second.end());
+          }
+        }
+      }
+      // keep the neighbors in the order of the dense association matrix
+      std::sort(candidates.begin(), candidates.end());
+      candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                       candidates.end());
+    }
+    for (int j : candidates) {
+      if (use_grid) {
+        Eigen::Vector2f diff =
+            new_objects[j]->anchor_point.head(2) - predicted_anchor_point;
+        if (diff.norm() > gating_radius) {
+          continue;
+        }
+      }
+      float distance = TrackObjectDistance::ComputeDistance(
           tracks[i], tracks_predict[i], new_objects[j]);
+      if (distance <= s_match_distance_maximum_) {
+        (*association_graph)[i].push_back(no_track + j);
+        (*association_graph)[no_track + j].push_back(i);
+      }
     }
   }
 }
 
 void HungarianMatcher::ComputeConnectedComponents(
-    const Eigen::MatrixXf& association_mat, const float& connected_threshold,
+    const std::vector<std::vector<int>>& association_graph, const int no_track,
     std::vector<std::vector<int>>* track_components,
     std::vector<std::vector<int>>* object_components) {
   // Compute connected components within given threshold
-  int no_track = association_mat.rows();
-  int no_object = association_mat.cols();
-  std::vector<std::vector<int>> nb_graph;
-  nb_graph.resize(no_track + no_object);
-  for (int i = 0; i < no_track; i++) {
-    for (int j = 0; j < no_object; j++) {
-      if (association_mat(i, j) <= connected_threshold) {
-        nb_graph[i].push_back(no_track + j);
-        nb_graph[j + no_track].push_back(i);
-      }
-    }
-  }
-
   std::vector<std::vector<int>> components;
-  ConnectedComponentAnalysis(nb_graph, &components);
+  ConnectedComponentAnalysis(association_graph, &components);
   track_components->clear();
   track_components->resize(components.size());
   object_components->clear();
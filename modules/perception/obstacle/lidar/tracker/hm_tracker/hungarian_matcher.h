@@ -17,9 +17,11 @@
 #ifndef MODULES_PERCEPTION_LIDAR_TRACKER_HM_TRACKER_HUNGARIAN_MATCHER_H_
 #define MODULES_PERCEPTION_LIDAR_TRACKER_HM_TRACKER_HUNGARIAN_MATCHER_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "modules/common/util/work_stealing_thread_pool.h"
 #include "modules/perception/obstacle/lidar/tracker/hm_tracker/base_matcher.h"
 
 namespace apollo {
@@ -27,7 +29,7 @@ namespace perception {
 
 class HungarianMatcher : public BaseMatcher {
  public:
-  HungarianMatcher() {}
+  HungarianMatcher();
   ~HungarianMatcher() {}
 
   // @brief set match distance maximum for matcher
@@ -50,15 +52,20 @@ class HungarianMatcher : public BaseMatcher {
              std::vector<int>* unassigned_tracks,
              std::vector<int>* unassigned_objects);
 
-  // @brief match detected objects to tracks in component level
-  // @params[IN] association_mat: association matrix of all objects to tracks
+  // @brief match detected objects to tracks in component level, and set
+  // association score of matched objects
+  // @params[IN] tracks: maintaining tracks for matching
+  // @params[IN] tracks_predict: predicted state of maintained tracks
+  // @params[IN] objects: new detected objects for matching
   // @params[IN] track_component: component of track
   // @params[IN] object_component: component of object
   // @params[OUT] sub_assignments: component assignment pair of object & track
   // @params[OUT] sub_unassigned_tracks: component tracks not matched
   // @params[OUT] sub_unasgined_objects: component objects not matched
   // @return nothing
-  void MatchInComponents(const Eigen::MatrixXf& association_mat,
+  void MatchInComponents(const std::vector<ObjectTrackPtr>& tracks,
+                         const std::vector<Eigen::VectorXf>& tracks_predict,
+                         const std::vector<TrackedObjectPtr>& objects,
                          const std::vector<int>& track_component,
                          const std::vector<int>& obj_component,
                          std::vector<TrackObjectPair>* sub_assignments,
@@ -70,27 +77,30 @@ class HungarianMatcher : public BaseMatcher {
   }
 
  protected:
-  // @brief compute association matrix
+  // @brief compute association graph of the <track, object> pairs within
+  // match distance maximum. Only objects within gating radius of predicted
+  // location of each track are evaluated
   // @params[IN] tracks: maintained tracks for matching
   // @params[IN] tracks_predict: predicted states of maintained tracks
   // @params[IN] new_objects: recently detected objects
-  // @params[OUT] association_mat: matrix of association distance
+  // @params[OUT] association_graph: neighbors of tracks & objects, object j
+  // is node (tracks.size() + j)
   // @return nothing
-  void ComputeAssociateMatrix(
+  void ComputeAssociateGraph(
       const std::vector<ObjectTrackPtr>& tracks,
       const std::vector<Eigen::VectorXf>& tracks_predict,
       const std::vector<TrackedObjectPtr>& new_objects,
-      Eigen::MatrixXf* association_mat);
+      std::vector<std::vector<int>>* association_graph);
 
-  // @brief compute connected components within given threshold
-  // @params[IN] association_mat: matrix of association distance
-  // @params[IN] connected_threshold: threshold of connected components
+  // @brief compute connected components of association graph
+  // @params[IN] association_graph: neighbors of tracks & objects
+  // @params[IN] no_track: number of tracks
   // @params[OUT] track_components: connected objects of given tracks
   // @params[OUT] obj_components: connected tracks of given objects
   // @return nothing
   void ComputeConnectedComponents(
-      const Eigen::MatrixXf& association_mat, const float& connected_threshold,
-      std::vector<std::vector<int>>* track_components,
+      const std::vector<std::vector<int>>& association_graph,
+      const int no_track, std::vector<std::vector<int>>* track_components,
       std::vector<std::vector<int>>* obj_components);
 
   // @brief assign objects to tracks using components
@@ -110,6 +120,10 @@ class HungarianMatcher : public BaseMatcher {
   // threshold of matching
   static float s_match_distance_maximum_;
 
+  // workers matching components in parallel, null if matched in the calling
+  // thread
+  std::unique_ptr<apollo::common::util::WorkStealingThreadPool> thread_pool_;
+
   DISALLOW_COPY_AND_ASSIGN(HungarianMatcher);
 };  // class HmMatcher
 
@@ -190,7 +190,7 @@ void ObjectTrack::UpdateWithObject(TrackedObjectPtr* new_object,
 
 void ObjectTrack::UpdateWithoutObject(const double& time_diff) {
   // A. update object of track
-  TrackedObjectPtr new_obj(new TrackedObject());
+  TrackedObjectPtr new_obj = GetPooledTrackedObject();
   new_obj->clone(*current_object_);
   Eigen::Vector3f predicted_shift = belief_velocity_ * time_diff;
   new_obj->anchor_point = current_object_->anchor_point + predicted_shift;
@@ -239,7 +239,7 @@ void ObjectTrack::UpdateWithoutObject(const double& time_diff) {
 void ObjectTrack::UpdateWithoutObject(const Eigen::VectorXf& predict_state,
                                       const double& time_diff) {
   // A. update object of track
-  TrackedObjectPtr new_obj(new TrackedObject());
+  TrackedObjectPtr new_obj = GetPooledTrackedObject();
   new_obj->clone(*current_object_);
   Eigen::Vector3f predicted_shift = predict_state.tail(3) * time_diff;
   new_obj->anchor_point = current_object_->anchor_point + predicted_shift;
@@ -15,6 +15,7 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 #include "modules/common/log.h"
@@ -110,6 +111,18 @@ float TrackObjectDistance::ComputeDistance(const ObjectTrackPtr& track,
   return result_distance;
 }
 
+float TrackObjectDistance::ComputeLocationGatingRadius(
+    const float& distance_maximum) {
+  // All the distances are non-negative, and the location distance is at least
+  // half of the anchor point difference, since ComputeLocationDistance() at
+  // most halves it in the motion direction. The radius is relaxed by 1% for
+  // rounding errors.
+  if (s_location_distance_weight_ <= 0) {
+    return std::numeric_limits<float>::infinity();
+  }
+  return 2.0 * distance_maximum / s_location_distance_weight_ * 1.01;
+}
+
 float TrackObjectDistance::ComputeLocationDistance(
     const ObjectTrackPtr& track, const Eigen::VectorXf& track_predict,
     const TrackedObjectPtr& new_object) {
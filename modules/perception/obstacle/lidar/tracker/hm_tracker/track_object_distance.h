@@ -70,6 +70,13 @@ class TrackObjectDistance {
                                const Eigen::VectorXf& track_predict,
                                const TrackedObjectPtr& new_object);
 
+  // @brief compute gating radius of location for given distance maximum
+  // @params[IN] distance_maximum: maximum of <track, object> distance
+  // @return radius around predicted anchor point of track, out of which the
+  // <track, object> distance is always greater than distance_maximum.
+  // Infinity if location distance has no weight
+  static float ComputeLocationGatingRadius(const float& distance_maximum);
+
   std::string Name() const {
     return "TrackObjectDistance";
   }
@@ -16,11 +16,19 @@
 
 #include "modules/perception/obstacle/lidar/tracker/hm_tracker/tracked_object.h"
 
+#include "modules/perception/lib/base/object_pool.h"
 #include "modules/perception/obstacle/common/geometry_util.h"
 
 namespace apollo {
 namespace perception {
 
+namespace {
+
+// Maximum number of idle tracked objects kept for the next frames.
+const size_t kTrackedObjectPoolCapacity = 4096;
+
+}  // namespace
+
 TrackedObject::TrackedObject(ObjectPtr obj_ptr) : object_ptr(obj_ptr) {
   if (object_ptr != nullptr) {
     barycenter = GetCloudBarycenter<apollo::perception::pcl_util::Point>(
@@ -39,9 +47,16 @@ TrackedObject::TrackedObject(ObjectPtr obj_ptr) : object_ptr(obj_ptr) {
   }
 }
 
+TrackedObjectPtr GetPooledTrackedObject() {
+  static ObjectPool<TrackedObject> pool(
+      kTrackedObjectPoolCapacity,
+      [](TrackedObject* tracked_object) { *tracked_object = TrackedObject(); });
+  return pool.Get();
+}
+
 void TrackedObject::clone(const TrackedObject& rhs) {
   *this = rhs;
-  object_ptr.reset(new Object());
+  object_ptr = GetPooledObject();
   object_ptr->clone(*rhs.object_ptr);
 }
 
@@ -66,6 +66,10 @@ struct TrackedObject {
 typedef std::shared_ptr<TrackedObject> TrackedObjectPtr;
 typedef std::shared_ptr<const TrackedObject> TrackedObjectConstPtr;
 
+// Gets a tracked object in the state of TrackedObject() from a pool of tracked
+// objects recycled across frames. Thread safe.
+TrackedObjectPtr GetPooledTrackedObject();
+
 }  // namespace perception
 }  // namespace apollo
 
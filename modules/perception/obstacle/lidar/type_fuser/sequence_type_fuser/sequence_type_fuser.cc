@@ -103,8 +103,7 @@ bool SequenceTypeFuser::FuseType(const TypeFuserOptions& options,
     return false;
   }
   if (options.timestamp > 0.0) {
-    sequence_.AddTrackedFrameObjects(*objects, options.timestamp);
-    ObjectSequence::TrackedObjects tracked_objects;
+    RemoveStaleTrackStates(options.timestamp);
     for (auto& object : *objects) {
       if (object->is_background) {
         object->type_probs.assign(MAX_OBJECT_TYPE, 0);
@@ -112,72 +111,81 @@ bool SequenceTypeFuser::FuseType(const TypeFuserOptions& options,
         continue;
       }
       const int& track_id = object->track_id;
-      sequence_.GetTrackInTemporalWindow(track_id, &tracked_objects,
-                                         temporal_window_);
-      if (tracked_objects.size() == 0) {
-        AERROR << "Find zero-length track, so skip.";
-        continue;
-      }
-      if (object != tracked_objects.rbegin()->second) {
-        AERROR << "There must exist some timestamp in disorder, so skip.";
-        continue;
+      auto iter = track_states_.find(track_id);
+      const TrackState* state = nullptr;
+      if (iter != track_states_.end()) {
+        if (options.timestamp <= iter->second.timestamp) {
+          AERROR << "There must exist some timestamp in disorder, so skip.";
+          continue;
+        }
+        state = &iter->second;
       }
-      if (!FuseWithCCRF(&tracked_objects)) {
+      TrackState new_state;
+      new_state.timestamp = options.timestamp;
+      if (!FuseWithCCRF(object, state, &new_state)) {
         AERROR << "Failed to fuse types, so break.";
         break;
       }
+      track_states_[track_id] = new_state;
     }
   }
   return true;
 }
 
-bool SequenceTypeFuser::FuseWithCCRF(TrackedObjects* tracked_objects) {
-  if (tracked_objects == nullptr || tracked_objects->size() == 0) {
+bool SequenceTypeFuser::FuseWithCCRF(const ObjectPtr& object,
+                                     const TrackState* state,
+                                     TrackState* new_state) {
+  if (object == nullptr || new_state == nullptr) {
     return false;
   }
 
   /// rectify object type with smooth matrices
-  fused_oneshot_probs_.resize(tracked_objects->size());
-  std::size_t i = 0;
-  for (auto& pair : *tracked_objects) {
-    ObjectPtr& object = pair.second;
-    if (!RectifyObjectType(object, &fused_oneshot_probs_[i++])) {
-      AERROR << "Failed to fuse one shot probs in sequence.";
-      return false;
-    }
+  Vectord oneshot_log_probs;
+  if (!RectifyObjectType(object, &oneshot_log_probs)) {
+    AERROR << "Failed to fuse one shot probs in sequence.";
+    return false;
   }
 
   /// use Viterbi algorithm to infer the state
-  std::size_t length = tracked_objects->size();
-  fused_sequence_probs_.resize(length);
-  state_back_trace_.resize(length);
-  fused_sequence_probs_[0] = fused_oneshot_probs_[0];
-  /// add prior knowledge to suppress the sudden-appeared object types.
-  fused_sequence_probs_[0] += transition_matrix_.row(0).transpose();
-  for (std::size_t i = 1; i < length; ++i) {
+  Vectord& sequence_log_probs = new_state->sequence_log_probs;
+  if (state == nullptr) {
+    sequence_log_probs = oneshot_log_probs;
+    /// add prior knowledge to suppress the sudden-appeared object types.
+    sequence_log_probs += transition_matrix_.row(0).transpose();
+  } else {
     for (std::size_t right = 0; right < VALID_OBJECT_TYPE; ++right) {
       double max_prob = -DBL_MAX;
-      std::size_t id = 0;
       for (std::size_t left = 0; left < VALID_OBJECT_TYPE; ++left) {
-        const double prob = fused_sequence_probs_[i - 1](left) +
+        const double prob = state->sequence_log_probs(left) +
                             transition_matrix_(left, right) * s_alpha_ +
-                            fused_oneshot_probs_[i](right);
+                            oneshot_log_probs(right);
         if (prob > max_prob) {
           max_prob = prob;
-          id = left;
         }
       }
-      fused_sequence_probs_[i](right) = max_prob;
-      state_back_trace_[i](right) = id;
+      sequence_log_probs(right) = max_prob;
     }
   }
-  ObjectPtr object = tracked_objects->rbegin()->second;
-  RecoverFromLogProb(&fused_sequence_probs_.back(), &object->type_probs,
-                     &object->type);
+  /// the shift keeps the log probabilities of long tracks bounded, it
+  /// changes neither the argmax nor the normalized probabilities
+  sequence_log_probs.array() -= sequence_log_probs.maxCoeff();
+
+  Vectord probs = sequence_log_probs;
+  RecoverFromLogProb(&probs, &object->type_probs, &object->type);
 
   return true;
 }
 
+void SequenceTypeFuser::RemoveStaleTrackStates(double timestamp) {
+  for (auto iter = track_states_.begin(); iter != track_states_.end();) {
+    if (timestamp - iter->second.timestamp > temporal_window_) {
+      iter = track_states_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
 bool SequenceTypeFuser::RectifyObjectType(const ObjectPtr& object,
                                           Vectord* log_prob) {
   if (object == nullptr || log_prob == nullptr) {
@@ -20,7 +20,6 @@
 #include <string>
 #include <vector>
 
-#include "modules/perception/obstacle/common/object_sequence.h"
 #include "modules/perception/obstacle/lidar/interface/base_type_fuser.h"
 #include "modules/perception/obstacle/lidar/type_fuser/sequence_type_fuser/util.h"
 
@@ -29,8 +28,6 @@ namespace perception {
 
 class SequenceTypeFuser : public BaseTypeFuser {
  public:
-  typedef ObjectSequence::TrackedObjects TrackedObjects;
-
   /**
    * @brief Constructor
    */
@@ -63,6 +60,16 @@ class SequenceTypeFuser : public BaseTypeFuser {
   std::string name() const override { return "SequenceTypeFuser"; }
 
  protected:
+  /**
+   * @brief The state of the type inference of a track at its latest step
+   */
+  struct TrackState {
+    double timestamp = 0.0;
+    // Max log probabilities of the sequences ending with each type, shifted
+    // so that the max one is zero
+    Vectord sequence_log_probs;
+  };
+
   /**
    * @brief Fuse type over object sequence by a linear-chain CRF.
    * The fusion problem is modeled as inferring the discrete state 
@@ -71,11 +78,21 @@ class SequenceTypeFuser : public BaseTypeFuser {
    * E_unary(X_i,O) = sigma{logP(classifier)},
    * E_pairwise(X_i,X_j) = log{Transition(X_i,X_j)}.
    * Maximize the sequence probability P(X_t|{X}^opt,O) based on the
-   * Viterbi algorithm.
-   * @param tracked_objects The tracked objects as a sequence
+   * Viterbi algorithm. Only the step of the newest object is computed,
+   * from the state of the track at its previous step.
+   * @param object The newest object of the track
+   * @param state The state of the track, null if the track starts
+   * @param new_state The output state of the track at the object
    * @return True if fuse successfully, false otherwise
    */
-  bool FuseWithCCRF(TrackedObjects* tracked_objects);
+  bool FuseWithCCRF(const ObjectPtr& object, const TrackState* state,
+                    TrackState* new_state);
+
+  /**
+   * @brief Remove the states of the tracks not seen in the temporal window
+   * @param timestamp Current timestamp
+   */
+  void RemoveStaleTrackStates(double timestamp);
 
   /**
    * @brief Rectify the initial object type based on smooth matrices
@@ -97,7 +114,7 @@ class SequenceTypeFuser : public BaseTypeFuser {
                           ObjectType* type);
 
  protected:
-  ObjectSequence sequence_;
+  std::map<int, TrackState> track_states_;
 
   double temporal_window_;
 
@@ -105,11 +122,6 @@ class SequenceTypeFuser : public BaseTypeFuser {
   Matrixd confidence_smooth_matrix_;
   std::map<std::string, Matrixd> smooth_matrices_;
 
-  // Note all probabilities are in the log space
-  std::vector<Vectord> fused_oneshot_probs_;
-  std::vector<Vectord> fused_sequence_probs_;
-  std::vector<Vectori> state_back_trace_;
-
   static constexpr double s_alpha_ = 1.8;
 
  private:
@@ -106,5 +106,49 @@ TEST_F(SequenceTypeFuserTest, TestFuseType) {
   }
 }
 
+TEST_F(SequenceTypeFuserTest, TestFuseTypeIncrementally) {
+  EXPECT_TRUE(fuser_->Init());
+  TypeFuserOptions options;
+  std::vector<ObjectPtr> objects(1);
+  // the track is seen as the first type, then as the last one
+  for (std::size_t i = 0; i < 2 * s_sequence_length_; ++i) {
+    const std::size_t id = i < s_sequence_length_ ? 0 : VALID_OBJECT_TYPE - 1;
+    objects[0].reset(new Object);
+    objects[0]->track_id = 0;
+    objects[0]->score = 0.95;
+    objects[0]->type_probs.resize(MAX_OBJECT_TYPE, 0.0);
+    GenerateSmoothProb(&objects[0]->type_probs, id, 0.7);
+    options.timestamp = static_cast<double>(i + 1) * 0.1;
+    EXPECT_TRUE(fuser_->FuseType(options, &objects));
+    if (i == s_sequence_length_ - 1) {
+      EXPECT_EQ(static_cast<std::size_t>(objects[0]->type), IdMap(0));
+    }
+  }
+  EXPECT_EQ(static_cast<std::size_t>(objects[0]->type),
+            IdMap(VALID_OBJECT_TYPE - 1));
+  const std::vector<float> type_probs = objects[0]->type_probs;
+
+  // an object in disorder is skipped
+  objects[0].reset(new Object);
+  objects[0]->track_id = 0;
+  objects[0]->score = 0.95;
+  objects[0]->type_probs.resize(MAX_OBJECT_TYPE, 0.0);
+  GenerateSmoothProb(&objects[0]->type_probs, 0, 0.7);
+  const std::vector<float> skipped_type_probs = objects[0]->type_probs;
+  EXPECT_TRUE(fuser_->FuseType(options, &objects));
+  EXPECT_EQ(objects[0]->type_probs, skipped_type_probs);
+
+  // the skipped object did not change the state of the track
+  objects[0]->type_probs.assign(MAX_OBJECT_TYPE, 0.0);
+  GenerateSmoothProb(&objects[0]->type_probs, VALID_OBJECT_TYPE - 1, 0.7);
+  options.timestamp += 0.1;
+  EXPECT_TRUE(fuser_->FuseType(options, &objects));
+  EXPECT_EQ(static_cast<std::size_t>(objects[0]->type),
+            IdMap(VALID_OBJECT_TYPE - 1));
+  for (std::size_t i = 0; i < MAX_OBJECT_TYPE; ++i) {
+    EXPECT_NEAR(objects[0]->type_probs[i], type_probs[i], 1e-5);
+  }
+}
+
 }  // namespace perception
 }  // namespace apollo
@@ -44,27 +44,29 @@ void FrameContent::SetLidarPose(const Eigen::Matrix4d &pose) {
   pose_v2w_(2, 3) += global_offset_[2];
 }
 
-Eigen::Matrix4d FrameContent::GetPoseV2w() {
+Eigen::Matrix4d FrameContent::GetPoseV2w() const {
   return pose_v2w_;
 }
 
 void FrameContent::SetLidarCloud(pcl_util::PointCloudPtr cloud) {
+  cloud_.reset(new pcl_util::PointCloud);
   pcl::transformPointCloud(*cloud, *(cloud_), pose_v2w_);
 }
 
 void FrameContent::SetLidarRoiCloud(pcl_util::PointCloudPtr cloud) {
+  roi_cloud_.reset(new pcl_util::PointCloud);
   pcl::transformPointCloud(*cloud, *(roi_cloud_), pose_v2w_);
 }
 
-pcl_util::PointCloudPtr FrameContent::GetCloud() {
+pcl_util::PointCloudPtr FrameContent::GetCloud() const {
   return cloud_;
 }
 
-pcl_util::PointCloudPtr FrameContent::GetRoiCloud() {
+pcl_util::PointCloudPtr FrameContent::GetRoiCloud() const {
   return roi_cloud_;
 }
 
-bool FrameContent::HasCloud() {
+bool FrameContent::HasCloud() const {
   if ((cloud_ == nullptr || cloud_->size() == 0)) {
     return false;
   }
@@ -109,7 +111,7 @@ void FrameContent::SetTrackedObjects(
   }
 }
 
-std::vector<ObjectPtr> FrameContent::GetTrackedObjects() {
+std::vector<ObjectPtr> FrameContent::GetTrackedObjects() const {
   return tracked_objects_;
 }
 
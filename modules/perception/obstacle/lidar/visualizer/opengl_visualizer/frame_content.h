@@ -36,17 +36,19 @@ class FrameContent {
   ~FrameContent();
 
   void SetLidarPose(const Eigen::Matrix4d &pose);
-  Eigen::Matrix4d GetPoseV2w();
+  Eigen::Matrix4d GetPoseV2w() const;
 
+  // The clouds are transformed into new clouds, so that the copies of a
+  // content keep the clouds they were made with.
   void SetLidarCloud(pcl_util::PointCloudPtr cloud);
   void SetLidarRoiCloud(pcl_util::PointCloudPtr cloud);
-  pcl_util::PointCloudPtr GetCloud();
-  pcl_util::PointCloudPtr GetRoiCloud();
+  pcl_util::PointCloudPtr GetCloud() const;
+  pcl_util::PointCloudPtr GetRoiCloud() const;
 
-  bool HasCloud();
+  bool HasCloud() const;
 
   void SetTrackedObjects(const std::vector<ObjectPtr> &objects);
-  std::vector<ObjectPtr> GetTrackedObjects();
+  std::vector<ObjectPtr> GetTrackedObjects() const;
 
  protected:
   // coordinate transform utilities
@@ -0,0 +1,221 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/perception/obstacle/lidar/visualizer/opengl_visualizer/frame_geometry.h"
+
+#include <cmath>
+
+namespace apollo {
+namespace perception {
+
+FrameGeometry::FrameGeometry() {
+  for (int i = 0; i < 16; ++i) {
+    pose_v2w[i] = i % 5 == 0 ? 1.0 : 0.0;
+  }
+}
+
+void FrameGeometry::Build(const FrameContent &content) {
+  Eigen::Matrix4d v2w_pose = content.GetPoseV2w();
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      pose_v2w[col * 4 + row] = v2w_pose(row, col);
+    }
+  }
+
+  cloud_verts.clear();
+  roi_cloud_verts.clear();
+  if (content.GetCloud() != nullptr) {
+    AddCloud(*content.GetCloud(), &cloud_verts);
+  }
+  if (content.GetRoiCloud() != nullptr) {
+    AddCloud(*content.GetRoiCloud(), &roi_cloud_verts);
+  }
+
+  line_verts.clear();
+  std::vector<ObjectPtr> objects = content.GetTrackedObjects();
+  boxes.first = NumLineVerts();
+  for (const auto &obj : objects) {
+    AddBox(*obj);
+  }
+  boxes.count = NumLineVerts() - boxes.first;
+  polygons.first = NumLineVerts();
+  for (const auto &obj : objects) {
+    AddPolygon(*obj);
+  }
+  polygons.count = NumLineVerts() - polygons.first;
+  velocities.first = NumLineVerts();
+  for (const auto &obj : objects) {
+    AddVelocity(*obj);
+  }
+  velocities.count = NumLineVerts() - velocities.first;
+  directions.first = NumLineVerts();
+  for (const auto &obj : objects) {
+    AddDirection(*obj);
+  }
+  directions.count = NumLineVerts() - directions.first;
+}
+
+void FrameGeometry::AddCloud(const pcl_util::PointCloud &cloud,
+                             std::vector<float> *verts) {
+  verts->resize(cloud.points.size() * 3);
+  float *vert = verts->data();
+  for (const auto &point : cloud.points) {
+    vert[0] = point.x;
+    vert[1] = point.y;
+    vert[2] = point.z;
+    vert += 3;
+  }
+}
+
+void FrameGeometry::AddLine(const Eigen::Vector3d &start,
+                            const Eigen::Vector3d &end, const float rgb[3]) {
+  const float verts[12] = {static_cast<float>(start[0]),
+                           static_cast<float>(start[1]),
+                           static_cast<float>(start[2]),
+                           rgb[0],
+                           rgb[1],
+                           rgb[2],
+                           static_cast<float>(end[0]),
+                           static_cast<float>(end[1]),
+                           static_cast<float>(end[2]),
+                           rgb[0],
+                           rgb[1],
+                           rgb[2]};
+  line_verts.insert(line_verts.end(), verts, verts + 12);
+}
+
+void FrameGeometry::AddVolumn(const Eigen::Vector3d *polygon_points,
+                              int polygon_size, double h, const float rgb[3]) {
+  const Eigen::Vector3d offset(0.0, 0.0, h);
+  for (int i = 0; i < polygon_size; ++i) {
+    const Eigen::Vector3d &point = polygon_points[i];
+    const Eigen::Vector3d &next = polygon_points[(i + 1) % polygon_size];
+    AddLine(point, next, rgb);
+    AddLine(point + offset, next + offset, rgb);
+    AddLine(point, point + offset, rgb);
+  }
+}
+
+void FrameGeometry::AddBox(const Object &obj) {
+  float type_color[3] = {0, 0, 0};
+  GetClassColor(obj.type, type_color);
+  Eigen::Vector3d dir(cos(obj.theta), sin(obj.theta), 0);
+  Eigen::Vector3d odir(-dir[1], dir[0], 0);
+  Eigen::Vector3d bottom_quad[4];
+  double half_l = obj.length / 2;
+  double half_w = obj.width / 2;
+  bottom_quad[0] = obj.center - dir * half_l - odir * half_w;
+  bottom_quad[1] = obj.center + dir * half_l - odir * half_w;
+  bottom_quad[2] = obj.center + dir * half_l + odir * half_w;
+  bottom_quad[3] = obj.center - dir * half_l + odir * half_w;
+  AddVolumn(bottom_quad, 4, obj.height, type_color);
+}
+
+void FrameGeometry::AddPolygon(const Object &obj) {
+  if (obj.polygon.points.empty()) {
+    return;
+  }
+  float type_color[3] = {0, 0, 0};
+  GetClassColor(obj.type, type_color);
+  std::vector<Eigen::Vector3d> polygon_points;
+  polygon_points.reserve(obj.polygon.points.size());
+  for (const auto &point : obj.polygon.points) {
+    polygon_points.emplace_back(point.x, point.y, point.z);
+  }
+  AddVolumn(polygon_points.data(), static_cast<int>(polygon_points.size()),
+            obj.height, type_color);
+}
+
+void FrameGeometry::AddVelocity(const Object &obj) {
+  const float color[3] = {1, 0, 0};
+  const Eigen::Vector3d &center = obj.center;
+  const Eigen::Vector3d &velocity = obj.velocity;
+  Eigen::Vector3d dir(cos(obj.theta), sin(obj.theta), 0);
+  Eigen::Vector3d start_point;
+  if (dir.dot(velocity) < 0) {
+    start_point = center - dir * (obj.length / 2);
+  } else {
+    start_point = center + dir * (obj.length / 2);
+  }
+  AddLine(start_point, start_point + velocity, color);
+}
+
+void FrameGeometry::AddDirection(const Object &obj) {
+  const float color[3] = {0, 0, 1};
+  Eigen::Vector3d dir(cos(obj.theta), sin(obj.theta), 0);
+  Eigen::Vector3d odir(-dir[1], dir[0], 0);
+  Eigen::Vector3d start_point =
+      obj.center + dir * (obj.length / 2) + odir * (obj.width / 2);
+  AddLine(start_point, start_point + dir * 3, color);
+}
+
+int FrameGeometry::NumLineVerts() const {
+  return static_cast<int>(line_verts.size() / 6);
+}
+
+void FrameGeometry::GetClassColor(int cls, float rgb[3]) {
+  switch (cls) {
+    case 0:
+      rgb[0] = 0.5;
+      rgb[1] = 0;
+      rgb[2] = 1;  // purple
+      break;
+    case 1:
+      rgb[0] = 0;
+      rgb[1] = 1;
+      rgb[2] = 1;  // cryan
+      break;
+    case 2:
+      rgb[0] = 1;
+      rgb[1] = 1;
+      rgb[2] = 0;  // yellow
+      break;
+    case 3:
+      rgb[0] = 1;
+      rgb[1] = 0.5;
+      rgb[2] = 0.5;  // red
+      break;
+    case 4:
+      rgb[0] = 0;
+      rgb[1] = 0;
+      rgb[2] = 1;  // blue
+      break;
+    case 5:
+      rgb[0] = 0;
+      rgb[1] = 1;
+      rgb[2] = 0;  // green
+      break;
+    case 6:
+      rgb[0] = 1;
+      rgb[1] = 0.5;
+      rgb[2] = 0;  // orange
+      break;
+    case 7:
+      rgb[0] = 1;
+      rgb[1] = 0;
+      rgb[2] = 0;  // red
+      break;
+    default:
+      rgb[0] = 1;
+      rgb[1] = 1;
+      rgb[2] = 1;  // white
+      break;
+  }
+}
+
+}  // namespace perception
+}  // namespace apollo
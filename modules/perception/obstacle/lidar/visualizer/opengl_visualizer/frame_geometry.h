@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#ifndef MODULES_PERCEPTION_OBSTACLE_LIDAR_VISUALIZER_FRAME_GEOMETRY_H_
+#define MODULES_PERCEPTION_OBSTACLE_LIDAR_VISUALIZER_FRAME_GEOMETRY_H_
+
+#include <vector>
+
+#include "modules/perception/obstacle/lidar/visualizer/opengl_visualizer/frame_content.h"
+
+namespace apollo {
+namespace perception {
+
+/**
+ * @class FrameGeometry
+ * @brief The vertices of a frame content, packed the way the vertex buffers
+ * of GLFWViewer take them, so that a frame is prepared away from the thread
+ * which renders it.
+ */
+class FrameGeometry {
+ public:
+  // A range of the line vertices, in vertices.
+  struct Range {
+    int first = 0;
+    int count = 0;
+  };
+
+  FrameGeometry();
+
+  /**
+   * @brief Fills the geometry with the clouds and the objects of a content.
+   */
+  void Build(const FrameContent &content);
+
+  // The vehicle to world pose, as a column major opengl matrix.
+  double pose_v2w[16];
+
+  // x, y, z of each point.
+  std::vector<float> cloud_verts;
+  std::vector<float> roi_cloud_verts;
+
+  // x, y, z, r, g, b of each vertex of the line segments of the objects.
+  std::vector<float> line_verts;
+  Range boxes;
+  Range polygons;
+  Range velocities;
+  Range directions;
+
+ private:
+  void AddCloud(const pcl_util::PointCloud &cloud, std::vector<float> *verts);
+  void AddLine(const Eigen::Vector3d &start, const Eigen::Vector3d &end,
+               const float rgb[3]);
+  void AddVolumn(const Eigen::Vector3d *polygon_points, int polygon_size,
+                 double h, const float rgb[3]);
+  void AddBox(const Object &obj);
+  void AddPolygon(const Object &obj);
+  void AddVelocity(const Object &obj);
+  void AddDirection(const Object &obj);
+  int NumLineVerts() const;
+
+  static void GetClassColor(int cls, float rgb[3]);
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_OBSTACLE_LIDAR_VISUALIZER_FRAME_GEOMETRY_H_
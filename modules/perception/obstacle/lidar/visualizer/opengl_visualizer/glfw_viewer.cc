@@ -14,9 +14,11 @@
  * limitations under the License.
  *****************************************************************************/
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
+#include <utility>
 #include <vector>
 
 #include "pcl/io/pcd_io.h"
@@ -82,6 +84,7 @@ bool GLFWViewer::Initialize() {
     return false;
   }
 
+  prepare_thread_ = std::thread(&GLFWViewer::PrepareFrames, this);
   init_ = true;
 
   show_cloud_ = 1;
@@ -105,7 +108,16 @@ void GLFWViewer::SpinOnce() {
   glfwSwapBuffers(window_);
 }
 
-void GLFWViewer::Close() { glfwTerminate(); }
+void GLFWViewer::Close() {
+  StopPreparingFrames();
+  if (init_) {
+    DeleteStreamBuffer(&cloud_buffer_);
+    DeleteStreamBuffer(&roi_cloud_buffer_);
+    DeleteStreamBuffer(&line_buffer_);
+    init_ = false;
+  }
+  glfwTerminate();
+}
 
 void GLFWViewer::SetSize(int w, int h) {
   win_width_ = w;
@@ -189,40 +201,10 @@ bool GLFWViewer::OpenglInit() {
   }
 
   // allocation of vbo
-  // point cloud
-  {
-    GLfloat cloud_colors[kPoint_Num_Per_Cloud_VAO_][3];
-    GLuint cloud_indices[kPoint_Num_Per_Cloud_VAO_];
-    for (int i = 0; i < kPoint_Num_Per_Cloud_VAO_; i++) {
-      cloud_colors[i][0] = 0.7;
-      cloud_colors[i][1] = 0.7;
-      cloud_colors[i][2] = 0.7;
-      cloud_indices[i] = GLuint(i);
-    }
-
-    glGenVertexArrays(kCloud_VAO_Num_, cloud_VAO_buf_ids_);
-    for (int i = 0; i < kCloud_VAO_Num_; i++) {
-      glBindVertexArray(cloud_VAO_buf_ids_[i]);
-
-      glGenBuffers(NUM_VBO_TYPE, cloud_VBO_buf_ids_[i]);
-      glBindBuffer(GL_ARRAY_BUFFER, cloud_VBO_buf_ids_[i][VBO_VERTICES]);
-      glBufferData(GL_ARRAY_BUFFER, sizeof(cloud_verts_), cloud_verts_,
-                   GL_STREAM_DRAW);
-      glVertexPointer(3, GL_FLOAT, 0, BUFFER_OFFSET(0));
-      glEnableClientState(GL_VERTEX_ARRAY);
-
-      glBindBuffer(GL_ARRAY_BUFFER, cloud_VBO_buf_ids_[i][VBO_COLORS]);
-      glBufferData(GL_ARRAY_BUFFER, sizeof(cloud_colors), cloud_colors,
-                   GL_STREAM_DRAW);
-      glColorPointer(3, GL_FLOAT, 0, BUFFER_OFFSET(0));
-      glEnableClientState(GL_COLOR_ARRAY);
-
-      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,
-                   cloud_VBO_buf_ids_[i][VBO_ELEMENTS]);
-      glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(cloud_indices),
-                   cloud_indices, GL_STREAM_DRAW);
-    }
-  }
+  // point cloud and objects
+  InitStreamBuffer(false, &cloud_buffer_);
+  InitStreamBuffer(false, &roi_cloud_buffer_);
+  InitStreamBuffer(true, &line_buffer_);
   // circle
   {
     GLfloat circle_verts[kPoint_Num_Per_Circle_VAO_][3];
@@ -272,6 +254,103 @@ bool GLFWViewer::OpenglInit() {
   return true;
 }
 
+void GLFWViewer::InitStreamBuffer(bool with_colors, StreamBuffer *buffer) {
+  glGenVertexArrays(1, &buffer->vao);
+  glBindVertexArray(buffer->vao);
+  glGenBuffers(1, &buffer->vbo);
+  glBindBuffer(GL_ARRAY_BUFFER, buffer->vbo);
+  const GLsizei stride = (with_colors ? 6 : 3) * sizeof(GLfloat);
+  glVertexPointer(3, GL_FLOAT, stride, BUFFER_OFFSET(0));
+  glEnableClientState(GL_VERTEX_ARRAY);
+  if (with_colors) {
+    glColorPointer(3, GL_FLOAT, stride, BUFFER_OFFSET(3 * sizeof(GLfloat)));
+    glEnableClientState(GL_COLOR_ARRAY);
+  } else {
+    glDisableClientState(GL_COLOR_ARRAY);
+  }
+  glBindVertexArray(0);
+}
+
+void GLFWViewer::UploadStreamBuffer(const std::vector<float> &data,
+                                    StreamBuffer *buffer) {
+  const size_t size = data.size() * sizeof(float);
+  if (size == 0) {
+    return;
+  }
+  if (size > buffer->capacity) {
+    buffer->capacity = std::max(size, 2 * buffer->capacity);
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, buffer->vbo);
+  glBufferData(GL_ARRAY_BUFFER, buffer->capacity, nullptr, GL_STREAM_DRAW);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, size, data.data());
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void GLFWViewer::DeleteStreamBuffer(StreamBuffer *buffer) {
+  glDeleteBuffers(1, &buffer->vbo);
+  glDeleteVertexArrays(1, &buffer->vao);
+  buffer->capacity = 0;
+}
+
+void GLFWViewer::SetFrameContent(const FrameContent &frame_content) {
+  {
+    std::lock_guard<std::mutex> lock(frame_mutex_);
+    pending_content_ = frame_content;
+    has_pending_content_ = true;
+  }
+  frame_cv_.notify_one();
+}
+
+void GLFWViewer::PrepareFrames() {
+  FrameContent content;
+  FrameGeometry geometry;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(frame_mutex_);
+      frame_cv_.wait(lock, [this] {
+        return has_pending_content_ || stop_preparing_;
+      });
+      if (stop_preparing_) {
+        return;
+      }
+      content = pending_content_;
+      has_pending_content_ = false;
+    }
+    geometry.Build(content);
+    {
+      std::lock_guard<std::mutex> lock(frame_mutex_);
+      std::swap(ready_geometry_, geometry);
+      has_ready_geometry_ = true;
+    }
+  }
+}
+
+void GLFWViewer::StopPreparingFrames() {
+  if (!prepare_thread_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(frame_mutex_);
+    stop_preparing_ = true;
+  }
+  frame_cv_.notify_one();
+  prepare_thread_.join();
+}
+
+void GLFWViewer::UpdateGeometry() {
+  {
+    std::lock_guard<std::mutex> lock(frame_mutex_);
+    if (!has_ready_geometry_) {
+      return;
+    }
+    std::swap(geometry_, ready_geometry_);
+    has_ready_geometry_ = false;
+  }
+  UploadStreamBuffer(geometry_.cloud_verts, &cloud_buffer_);
+  UploadStreamBuffer(geometry_.roi_cloud_verts, &roi_cloud_buffer_);
+  UploadStreamBuffer(geometry_.line_verts, &line_buffer_);
+}
+
 void GLFWViewer::PreDraw() {
   Eigen::Matrix4d e_proj_mat = pers_camera_->GetProjectionMat();
 
@@ -307,6 +386,7 @@ void GLFWViewer::PreDraw() {
 void GLFWViewer::Render() {
   glClear(GL_COLOR_BUFFER_BIT);
   PreDraw();
+  UpdateGeometry();
 
   if (show_cloud_) DrawCloud();
   DrawObstacles();
@@ -315,75 +395,33 @@ void GLFWViewer::Render() {
 }
 
 void GLFWViewer::DrawCloud() {
-  pcl_util::PointCloudPtr cloud;
-  pcl_util::PointCloudPtr roi_cloud;
-
-  if (show_cloud_state_ == 0) {  // only show original point cloud
-    cloud = frame_content_.GetCloud();
-  } else if (show_cloud_state_ == 1) {  // show roi
-    roi_cloud = frame_content_.GetRoiCloud();
-  } else {  // show both
-    cloud = frame_content_.GetCloud();
-    roi_cloud = frame_content_.GetRoiCloud();
-  }
+  // 0: only show original point cloud, 1: show roi, 2: show both
+  const bool show_cloud = show_cloud_state_ != 1;
+  const bool show_roi_cloud = show_cloud_state_ != 0;
 
   // draw original point cloud
-  if (cloud && !cloud->points.empty()) {
+  if (show_cloud && !geometry_.cloud_verts.empty()) {
     glPointSize(1);
-    int count = 0;
-    int p_num = 0;
-    int vao_num = (cloud->points.size() / kPoint_Num_Per_Cloud_VAO_) + 1;
-    for (int vao = 0; vao < vao_num; vao++) {
-      for (p_num = 0; p_num < kPoint_Num_Per_Cloud_VAO_; ++p_num) {
-        cloud_verts_[p_num][0] = cloud->points[count].x;
-        cloud_verts_[p_num][1] = cloud->points[count].y;
-        cloud_verts_[p_num][2] = cloud->points[count].z;
-        count++;
-
-        if (count >= static_cast<int>(cloud->points.size())) {
-          break;
-        }
-      }
-
-      glBindVertexArray(cloud_VAO_buf_ids_[vao]);
-      glBindBuffer(GL_ARRAY_BUFFER, cloud_VBO_buf_ids_[vao][VBO_VERTICES]);
-      glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(cloud_verts_), cloud_verts_);
-      glDrawElements(GL_POINTS, p_num, GL_UNSIGNED_INT, BUFFER_OFFSET(0));
-      glBindVertexArray(0);
-
-      if (count >= static_cast<int>(cloud->points.size())) {
-        break;
-      }
-    }
-
-    if (count < static_cast<int>(cloud->points.size())) {
-      AINFO << "VAO_num * VBO_num < cloud->points.size()";
-    }
+    glColor3f(0.7, 0.7, 0.7);
+    glBindVertexArray(cloud_buffer_.vao);
+    glDrawArrays(GL_POINTS, 0, geometry_.cloud_verts.size() / 3);
+    glBindVertexArray(0);
   }
 
   // draw roi point cloud
-  if (roi_cloud && !roi_cloud->points.empty()) {
+  if (show_roi_cloud && !geometry_.roi_cloud_verts.empty()) {
     glPointSize(3);
     glColor3f(0, 0.8, 0);
-    glBegin(GL_POINTS);
-    for (const auto &point : roi_cloud->points) {
-      glVertex3f(point.x, point.y, point.z);
-    }
-    glEnd();
+    glBindVertexArray(roi_cloud_buffer_.vao);
+    glDrawArrays(GL_POINTS, 0, geometry_.roi_cloud_verts.size() / 3);
+    glBindVertexArray(0);
   }
 }
 
 void GLFWViewer::DrawCircle() {
-  Eigen::Matrix4d v2w_pose = frame_content_.GetPoseV2w();
-  GLdouble mat[16] = {
-      v2w_pose(0, 0), v2w_pose(1, 0), v2w_pose(2, 0), v2w_pose(3, 0),
-      v2w_pose(0, 1), v2w_pose(1, 1), v2w_pose(2, 1), v2w_pose(3, 1),
-      v2w_pose(0, 2), v2w_pose(1, 2), v2w_pose(2, 2), v2w_pose(3, 2),
-      v2w_pose(0, 3), v2w_pose(1, 3), v2w_pose(2, 3), v2w_pose(3, 3)};
-
   glMatrixMode(GL_MODELVIEW);
   glPushMatrix();
-  glMultMatrixd(mat);
+  glMultMatrixd(geometry_.pose_v2w);
   int vao = 0;
   for (vao = 0; vao < kCircle_VAO_Num_; vao++) {
     glBindVertexArray(circle_VAO_buf_ids_[vao]);
@@ -405,166 +443,21 @@ void GLFWViewer::DrawCarForwardDir() {
   glLineWidth(1);
 }
 
-void GLFWViewer::DrawObstacle(const ObjectPtr obj, bool show_cloud,
-                              bool show_polygon, bool show_velocity,
-                              bool show_direction) {
-  float type_color[3] = {0, 0, 0};
-  GetClassColor(obj->type, type_color);
-  if (show_polygon) {
-    double h = obj->height;
-    glColor3f(type_color[0], type_color[1], type_color[2]);
-    glBegin(GL_LINE_LOOP);
-    for (auto point : obj->polygon.points) {
-      glVertex3f(point.x, point.y, point.z);
-    }
-    glEnd();
-
-    glBegin(GL_LINE_LOOP);
-    for (auto point : obj->polygon.points) {
-      glVertex3f(point.x, point.y, point.z + h);
-    }
-    glEnd();
-
-    glBegin(GL_LINES);
-    for (auto point : obj->polygon.points) {
-      glVertex3f(point.x, point.y, point.z);
-      glVertex3f(point.x, point.y, point.z + h);
-    }
-    glEnd();
-  } else {
-    glColor3f(type_color[0], type_color[1], type_color[2]);
-    Eigen::Vector3d dir(cos(obj->theta), sin(obj->theta), 0);
-    Eigen::Vector3d odir(-dir[1], dir[0], 0);
-    Eigen::Vector3d bottom_quad[4];
-    double half_l = obj->length / 2;
-    double half_w = obj->width / 2;
-    double h = obj->height;
-    bottom_quad[0] = obj->center - dir * half_l - odir * half_w;
-    bottom_quad[1] = obj->center + dir * half_l - odir * half_w;
-    bottom_quad[2] = obj->center + dir * half_l + odir * half_w;
-    bottom_quad[3] = obj->center - dir * half_l + odir * half_w;
-
-    DrawOffsetVolumn(bottom_quad, h, 4);
-  }
-
-  if (show_velocity) {
-    glColor3f(1, 0, 0);
-    const Eigen::Vector3d &center = obj->center;
-    const Eigen::Vector3d &velocity = obj->velocity;
-    Eigen::Vector3d dir(cos(obj->theta), sin(obj->theta), 0);
-    Eigen::Vector3d start_point;
-    if (dir.dot(velocity) < 0) {
-      start_point = center - dir * (obj->length / 2);
-    } else {
-      start_point = center + dir * (obj->length / 2);
-    }
-    Eigen::Vector3d end_point = start_point + velocity;
-    glBegin(GL_LINES);
-    glVertex3f(start_point[0], start_point[1], start_point[2]);
-    glVertex3f(end_point[0], end_point[1], end_point[2]);
-    glEnd();
-  }
-
-  if (show_direction) {
-    glColor3f(0, 0, 1);
-    const Eigen::Vector3d &center = obj->center;
-    Eigen::Vector3d dir(cos(obj->theta), sin(obj->theta), 0);
-    Eigen::Vector3d odir(-dir[1], dir[0], 0);
-    Eigen::Vector3d start_point =
-        center + dir * (obj->length / 2) + odir * (obj->width / 2);
-    Eigen::Vector3d end_point = start_point + dir * 3;
-    glBegin(GL_LINES);
-    glVertex3f(start_point[0], start_point[1], start_point[2]);
-    glVertex3f(end_point[0], end_point[1], end_point[2]);
-    glEnd();
-  }
-}
-
 void GLFWViewer::DrawObstacles() {
-  std::vector<ObjectPtr> tracked_objects = frame_content_.GetTrackedObjects();
-  for (std::size_t i = 0; i < tracked_objects.size(); i++) {
-    DrawObstacle(tracked_objects[i], true, show_polygon_, show_velocity_,
-                 show_direction_);
-  }
-}
-
-void GLFWViewer::DrawOffsetVolumn(Eigen::Vector3d *polygon_points, double h,
-                                  int polygon_size) {
-  if (polygon_points == nullptr) {
-    return;
+  glBindVertexArray(line_buffer_.vao);
+  DrawLines(show_polygon_ ? geometry_.polygons : geometry_.boxes);
+  if (show_velocity_) {
+    DrawLines(geometry_.velocities);
   }
-
-  glBegin(GL_LINE_LOOP);
-  for (int i = 0; i < polygon_size; i++) {
-    glVertex3d(polygon_points[i][0], polygon_points[i][1],
-               polygon_points[i][2]);
-  }
-  glEnd();
-
-  glBegin(GL_LINE_LOOP);
-  for (int i = 0; i < polygon_size; i++) {
-    glVertex3d(polygon_points[i][0], polygon_points[i][1],
-               polygon_points[i][2] + h);
-  }
-  glEnd();
-
-  glBegin(GL_LINES);
-  for (int i = 0; i < polygon_size; i++) {
-    glVertex3d(polygon_points[i][0], polygon_points[i][1],
-               polygon_points[i][2]);
-    glVertex3d(polygon_points[i][0], polygon_points[i][1],
-               polygon_points[i][2] + h);
+  if (show_direction_) {
+    DrawLines(geometry_.directions);
   }
-  glEnd();
+  glBindVertexArray(0);
 }
 
-void GLFWViewer::GetClassColor(int cls, float rgb[3]) {
-  switch (cls) {
-    case 0:
-      rgb[0] = 0.5;
-      rgb[1] = 0;
-      rgb[2] = 1;  // purple
-      break;
-    case 1:
-      rgb[0] = 0;
-      rgb[1] = 1;
-      rgb[2] = 1;  // cryan
-      break;
-    case 2:
-      rgb[0] = 1;
-      rgb[1] = 1;
-      rgb[2] = 0;  // yellow
-      break;
-    case 3:
-      rgb[0] = 1;
-      rgb[1] = 0.5;
-      rgb[2] = 0.5;  // red
-      break;
-    case 4:
-      rgb[0] = 0;
-      rgb[1] = 0;
-      rgb[2] = 1;  // blue
-      break;
-    case 5:
-      rgb[0] = 0;
-      rgb[1] = 1;
-      rgb[2] = 0;  // green
-      break;
-    case 6:
-      rgb[0] = 1;
-      rgb[1] = 0.5;
-      rgb[2] = 0;  // orange
-      break;
-    case 7:
-      rgb[0] = 1;
-      rgb[1] = 0;
-      rgb[2] = 0;  // red
-      break;
-    default:
-      rgb[0] = 1;
-      rgb[1] = 1;
-      rgb[2] = 1;  // white
-      break;
+void GLFWViewer::DrawLines(const FrameGeometry::Range &range) {
+  if (range.count > 0) {
+    glDrawArrays(GL_LINES, range.first, range.count);
   }
 }
 
@@ -20,9 +20,15 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include "Eigen/Dense"
 #include "modules/perception/obstacle/lidar/visualizer/opengl_visualizer/camera.h"
 #include "modules/perception/obstacle/lidar/visualizer/opengl_visualizer/frame_content.h"
+#include "modules/perception/obstacle/lidar/visualizer/opengl_visualizer/frame_geometry.h"
 
 namespace apollo {
 namespace perception {
@@ -33,9 +39,10 @@ class GLFWViewer {
 
   bool Initialize();
 
-  void SetFrameContent(const FrameContent &frame_content) {
-    frame_content_ = frame_content;
-  }
+  // The vertices of the content are prepared on a worker thread, and the
+  // frames render the latest content which is ready, the former ones being
+  // dropped.
+  void SetFrameContent(const FrameContent &frame_content);
   void Spin();
   void SpinOnce();
   void Close();
@@ -77,15 +84,28 @@ class GLFWViewer {
   void PreDraw();
   void Render();
 
-  void GetClassColor(int cls, float rgb[3]);
+  // A vertex buffer which is kept from frame to frame. Its storage is
+  // orphaned before each upload, so that the upload does not wait for the
+  // draws of the former frame, and only grows.
+  struct StreamBuffer {
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    size_t capacity = 0;
+  };
+  void InitStreamBuffer(bool with_colors, StreamBuffer *buffer);
+  void UploadStreamBuffer(const std::vector<float> &data,
+                          StreamBuffer *buffer);
+  void DeleteStreamBuffer(StreamBuffer *buffer);
+
+  void PrepareFrames();
+  void StopPreparingFrames();
+  void UpdateGeometry();
+
   void DrawCloud();
   void DrawCircle();
   void DrawCarForwardDir();
   void DrawObstacles();
-  void DrawObstacle(const ObjectPtr obj, bool show_cloud, bool show_polygon,
-                    bool show_velocity, bool show_direction);
-  void DrawOffsetVolumn(Eigen::Vector3d *polygon_points, double h,
-                        int polygon_size);
+  void DrawLines(const FrameGeometry::Range &range);
 
  private:
   bool init_;
@@ -93,7 +113,6 @@ class GLFWViewer {
   GLFWwindow *window_;
   Camera *pers_camera_;
 
-  FrameContent frame_content_;
   Eigen::Vector3d forward_dir_;
   Eigen::Vector3d scn_center_;
   Eigen::Vector3d bg_color_;
@@ -127,13 +146,22 @@ class GLFWViewer {
     NUM_VBO_TYPE = 3
   };
 
-  // cloud
-  static const int kCloud_VAO_Num_ = 35;
-  static const int kPoint_Num_Per_Cloud_VAO_ = 10000;
-  GLuint cloud_VAO_buf_ids_[kCloud_VAO_Num_];
-  GLuint cloud_VBO_buf_ids_[kCloud_VAO_Num_][NUM_VBO_TYPE];  // each VAO has
-  // NUM_VBO_TYPE VBOs
-  GLfloat cloud_verts_[kPoint_Num_Per_Cloud_VAO_][3];
+  // frame preparation
+  std::thread prepare_thread_;
+  std::mutex frame_mutex_;
+  std::condition_variable frame_cv_;
+  FrameContent pending_content_;
+  bool has_pending_content_ = false;
+  FrameGeometry ready_geometry_;
+  bool has_ready_geometry_ = false;
+  bool stop_preparing_ = false;
+  // the geometry being rendered, only used by the rendering thread
+  FrameGeometry geometry_;
+
+  // cloud and objects
+  StreamBuffer cloud_buffer_;
+  StreamBuffer roi_cloud_buffer_;
+  StreamBuffer line_buffer_;
 
   // circle
   static const int kCircle_VAO_Num_ = 3;
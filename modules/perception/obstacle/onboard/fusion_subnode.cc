@@ -19,8 +19,10 @@
 #include <map>
 
 #include "modules/common/log.h"
+#include "modules/common/trace/trace.h"
 #include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/onboard/event_manager.h"
+#include "modules/perception/onboard/latency_tracer.h"
 #include "modules/perception/onboard/shared_data_manager.h"
 #include "modules/perception/onboard/subnode_helper.h"
 
@@ -120,10 +122,13 @@ Status FusionSubnode::ProcEvents() {
       continue;
     }
     // public obstacle message
+    LatencyTraceFrame trace(timestamp_);
     PerceptionObstacles obstacles;
     if (GeneratePbMsg(&obstacles)) {
       common::adapter::AdapterManager::PublishPerceptionObstacles(obstacles);
     }
+    // the latency since the sensor is the end-to-end latency of the frame
+    trace.Mark("fusion_publish");
     AINFO << "Publish 3d perception fused msg. timestamp:"
           << GLOG_TIMESTAMP(timestamp_) << " obj_cnt:" << objects_.size();
   }
@@ -139,6 +144,7 @@ Status FusionSubnode::Process(const EventMeta &event_meta,
     return Status(ErrorCode::PERCEPTION_ERROR, "Failed to build_sensor_objs.");
   }
   PERF_BLOCK_START();
+  LatencyTraceFrame trace(sensor_objs[0].timestamp);
   objects_.clear();
   if (!fusion_->Fuse(sensor_objs, &objects_)) {
     AWARN << "Failed to call fusion plugin."
@@ -150,10 +156,13 @@ Status FusionSubnode::Process(const EventMeta &event_meta,
   }
   if (event_meta.event_id == lidar_event_id_) {
     PERF_BLOCK_END("fusion_lidar");
+    trace.Mark("fusion_lidar");
   } else if (event_meta.event_id == radar_event_id_) {
     PERF_BLOCK_END("fusion_radar");
+    trace.Mark("fusion_radar");
   }
   timestamp_ = sensor_objs[0].timestamp;
+  origin_sensor_ = sensor_objs[0].sensor_id;
   error_code_ = common::OK;
   return Status::OK();
 }
@@ -227,6 +236,7 @@ bool FusionSubnode::GeneratePbMsg(PerceptionObstacles *obstacles) {
   header->set_lidar_timestamp(timestamp_ * 1e9);  // in ns
   header->set_camera_timestamp(0);
   header->set_radar_timestamp(0);
+  common::trace::StartTrace(origin_sensor_, timestamp_, header);
 
   obstacles->set_error_code(error_code_);
 
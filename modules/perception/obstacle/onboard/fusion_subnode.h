@@ -65,6 +65,8 @@ class FusionSubnode : public Subnode {
   void RegistAllAlgorithm();
 
   double timestamp_;
+  // the sensor of the data fused last, at the origin of its trace
+  std::string origin_sensor_;
   std::vector<ObjectPtr> objects_;
   common::ErrorCode error_code_ = common::OK;
   std::unique_ptr<BaseFusion> fusion_;
@@ -24,15 +24,19 @@
 
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/log.h"
+#include "modules/common/trace/trace.h"
 #include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/base/timer.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/obstacle/lidar/dummy/dummy_algorithms.h"
+#include "modules/perception/obstacle/lidar/ground_detector/range_image_ground_detector/range_image_ground_detector.h"
 #include "modules/perception/obstacle/lidar/object_builder/min_box/min_box.h"
 #include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/hdmap_roi_filter.h"
 #include "modules/perception/obstacle/lidar/segmentation/cnnseg/cnn_segmentation.h"
 #include "modules/perception/obstacle/lidar/tracker/hm_tracker/hm_tracker.h"
 #include "modules/perception/obstacle/lidar/type_fuser/sequence_type_fuser/sequence_type_fuser.h"
+#include "modules/perception/obstacle/onboard/point_cloud_util.h"
+#include "modules/perception/onboard/latency_tracer.h"
 
 namespace apollo {
 namespace perception {
@@ -40,7 +44,6 @@ namespace perception {
 using apollo::common::adapter::AdapterManager;
 using pcl_util::Point;
 using pcl_util::PointD;
-using pcl_util::PointCloud;
 using pcl_util::PointCloudPtr;
 using pcl_util::PointIndices;
 using pcl_util::PointIndicesPtr;
@@ -85,8 +88,8 @@ bool LidarProcess::Process(const sensor_msgs::PointCloud2& message) {
   ADEBUG << "get trans pose succ.";
   PERF_BLOCK_END("lidar_get_velodyne2world_transfrom");
 
-  PointCloudPtr point_cloud(new PointCloud);
-  TransPointCloudToPCL(message, &point_cloud);
+  PointCloudPtr point_cloud = GetPooledPointCloud();
+  TransPointCloudToPCL(message, point_cloud.get());
   ADEBUG << "transform pointcloud success. points num is: "
          << point_cloud->points.size();
   PERF_BLOCK_END("lidar_transform_poindcloud");
@@ -102,6 +105,7 @@ bool LidarProcess::Process(const sensor_msgs::PointCloud2& message) {
 bool LidarProcess::Process(const double timestamp, PointCloudPtr point_cloud,
                            std::shared_ptr<Matrix4d> velodyne_trans) {
   PERF_BLOCK_START();
+  LatencyTraceFrame trace(timestamp);
   /// call hdmap to get ROI
   HdmapStructPtr hdmap = nullptr;
   if (hdmap_input_) {
@@ -111,10 +115,11 @@ bool LidarProcess::Process(const double timestamp, PointCloudPtr point_cloud,
     hdmap.reset(new HdmapStruct);
     hdmap_input_->GetROI(velodyne_pose_world, FLAGS_map_radius, &hdmap);
     PERF_BLOCK_END("lidar_get_roi_from_hdmap");
+    trace.Mark("lidar_get_roi_from_hdmap");
   }
 
   /// call roi_filter
-  PointCloudPtr roi_cloud(new PointCloud);
+  PointCloudPtr roi_cloud = GetPooledPointCloud();
   if (roi_filter_ != nullptr) {
     PointIndicesPtr roi_indices(new PointIndices);
     ROIFilterOptions roi_filter_options;
@@ -133,19 +138,36 @@ bool LidarProcess::Process(const double timestamp, PointCloudPtr point_cloud,
   ADEBUG << "call roi_filter succ. The num of roi_cloud is: "
          << roi_cloud->points.size();
   PERF_BLOCK_END("lidar_roi_filter");
+  trace.Mark("lidar_roi_filter");
+
+  /// call ground detector
+  PointIndicesPtr non_ground_indices(new PointIndices);
+  if (ground_detector_ != nullptr) {
+    GroundDetectorOptions ground_detector_options;
+    if (!ground_detector_->Detect(ground_detector_options, roi_cloud,
+                                  non_ground_indices)) {
+      AERROR << "failed to call ground detector.";
+      error_code_ = common::PERCEPTION_ERROR_PROCESS;
+      return false;
+    }
+  } else {
+    non_ground_indices->indices.resize(roi_cloud->points.size());
+    std::iota(non_ground_indices->indices.begin(),
+              non_ground_indices->indices.end(), 0);
+  }
+  ADEBUG << "call ground_detector succ. The num of non-ground points is: "
+         << non_ground_indices->indices.size();
+  PERF_BLOCK_END("lidar_ground_detector");
+  trace.Mark("lidar_ground_detector");
 
   /// call segmentor
   std::vector<ObjectPtr> objects;
   if (segmentor_ != nullptr) {
     SegmentationOptions segmentation_options;
     segmentation_options.origin_cloud = point_cloud;
-    PointIndices non_ground_indices;
-    non_ground_indices.indices.resize(roi_cloud->points.size());
-    // non_ground_indices.indices.resize(point_cloud->points.size());
-
-    std::iota(non_ground_indices.indices.begin(),
-              non_ground_indices.indices.end(), 0);
-    if (!segmentor_->Segment(roi_cloud, non_ground_indices,
+    segmentation_options.timestamp = timestamp;
+    segmentation_options.velodyne_trans = velodyne_trans;
+    if (!segmentor_->Segment(roi_cloud, *non_ground_indices,
                              segmentation_options, &objects)) {
       AERROR << "failed to call segmention.";
       error_code_ = common::PERCEPTION_ERROR_PROCESS;
@@ -154,6 +176,7 @@ bool LidarProcess::Process(const double timestamp, PointCloudPtr point_cloud,
   }
   ADEBUG << "call segmentation succ. The num of objects is: " << objects.size();
   PERF_BLOCK_END("lidar_segmentation");
+  trace.Mark("lidar_segmentation");
 
   /// call object builder
   if (object_builder_ != nullptr) {
@@ -166,6 +189,7 @@ bool LidarProcess::Process(const double timestamp, PointCloudPtr point_cloud,
   }
   ADEBUG << "call object_builder succ.";
   PERF_BLOCK_END("lidar_object_builder");
+  trace.Mark("lidar_object_builder");
 
   /// call tracker
   if (tracker_ != nullptr) {
@@ -182,6 +206,7 @@ bool LidarProcess::Process(const double timestamp, PointCloudPtr point_cloud,
   ADEBUG << "call tracker succ, there are " << objects_.size()
          << " tracked objects.";
   PERF_BLOCK_END("lidar_tracker");
+  trace.Mark("lidar_tracker");
 
   /// call type fuser
   if (type_fuser_ != nullptr) {
@@ -195,18 +220,21 @@ bool LidarProcess::Process(const double timestamp, PointCloudPtr point_cloud,
   }
   ADEBUG << "lidar process succ.";
   PERF_BLOCK_END("lidar_type_fuser");
+  trace.Mark("lidar_type_fuser");
 
   return true;
 }
 
 void LidarProcess::RegistAllAlgorithm() {
   RegisterFactoryDummyROIFilter();
+  RegisterFactoryDummyGroundDetector();
   RegisterFactoryDummySegmentation();
   RegisterFactoryDummyObjectBuilder();
   RegisterFactoryDummyTracker();
   RegisterFactoryDummyTypeFuser();
 
   RegisterFactoryHdmapROIFilter();
+  RegisterFactoryRangeImageGroundDetector();
   RegisterFactoryCNNSegmentation();
   RegisterFactoryMinBoxObjectBuilder();
   RegisterFactoryHmObjectTracker();
@@ -258,6 +286,20 @@ bool LidarProcess::InitAlgorithmPlugin() {
   AINFO << "Init algorithm plugin successfully, roi_filter_: "
         << roi_filter_->name();
 
+  /// init ground detector
+  ground_detector_.reset(BaseGroundDetectorRegisterer::GetInstanceByName(
+      FLAGS_onboard_ground_detector));
+  if (!ground_detector_) {
+    AERROR << "Failed to get instance: " << FLAGS_onboard_ground_detector;
+    return false;
+  }
+  if (!ground_detector_->Init()) {
+    AERROR << "Failed to Init ground detector: " << ground_detector_->name();
+    return false;
+  }
+  AINFO << "Init algorithm plugin successfully, ground detector: "
+        << ground_detector_->name();
+
   /// init segmentation
   segmentor_.reset(
       BaseSegmentationRegisterer::GetInstanceByName(FLAGS_onboard_segmentor));
@@ -316,40 +358,21 @@ bool LidarProcess::InitAlgorithmPlugin() {
   return true;
 }
 
-void LidarProcess::TransPointCloudToPCL(const sensor_msgs::PointCloud2& in_msg,
-                                        PointCloudPtr* out_cloud) {
-  // transform from ros to pcl
-  pcl::PointCloud<pcl_util::PointXYZIT> in_cloud;
-  pcl::fromROSMsg(in_msg, in_cloud);
-  // transform from xyzit to xyzi
-  PointCloudPtr& cloud = *out_cloud;
-  cloud->header = in_cloud.header;
-  cloud->width = in_cloud.width;
-  cloud->height = in_cloud.height;
-  cloud->is_dense = in_cloud.is_dense;
-  cloud->sensor_origin_ = in_cloud.sensor_origin_;
-  cloud->sensor_orientation_ = in_cloud.sensor_orientation_;
-  cloud->points.resize(in_cloud.points.size());
-  size_t points_num = 0;
-  for (size_t idx = 0; idx < in_cloud.size(); ++idx) {
-    pcl_util::PointXYZIT& pt = in_cloud.points[idx];
-    if (!isnan(pt.x) && !isnan(pt.y) && !isnan(pt.z) && !isnan(pt.intensity)) {
-      cloud->points[points_num].x = pt.x;
-      cloud->points[points_num].y = pt.y;
-      cloud->points[points_num].z = pt.z;
-      cloud->points[points_num].intensity = pt.intensity;
-      points_num++;
-    }
-  }
-  cloud->points.resize(points_num);
-}
-
 bool LidarProcess::GetVelodyneTrans(const double query_time, Matrix4d* trans) {
   if (!trans) {
     AERROR << "failed to get trans, the trans ptr can not be nullptr";
     return false;
   }
 
+  // The transform cache takes no lock, unlike the tf2 buffer.
+  Affine3d affine_3d;
+  if (AdapterManager::Tf2Cache().LookupTransform(
+          FLAGS_lidar_tf2_frame_id, FLAGS_lidar_tf2_child_frame_id, query_time,
+          &affine_3d)) {
+    *trans = affine_3d.matrix();
+    return true;
+  }
+
   ros::Time query_stamp(query_time);
   const auto& tf2_buffer = AdapterManager::Tf2Buffer();
 
@@ -373,7 +396,6 @@ bool LidarProcess::GetVelodyneTrans(const double query_time, Matrix4d* trans) {
     AERROR << "Exception: " << ex.what();
     return false;
   }
-  Affine3d affine_3d;
   tf::transformMsgToEigen(transform_stamped.transform, affine_3d);
   *trans = affine_3d.matrix();
 
@@ -387,6 +409,7 @@ void LidarProcess::GeneratePbMsg(PerceptionObstacles* obstacles) {
   header->set_lidar_timestamp(timestamp_ * 1e9);  // in ns
   header->set_camera_timestamp(0);
   header->set_radar_timestamp(0);
+  common::trace::StartTrace("lidar", timestamp_, header);
 
   obstacles->set_error_code(error_code_);
 
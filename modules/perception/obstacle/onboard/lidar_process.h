@@ -27,6 +27,7 @@
 
 #include "modules/perception/lib/pcl_util/pcl_types.h"
 #include "modules/perception/obstacle/base/object.h"
+#include "modules/perception/obstacle/lidar/interface/base_ground_detector.h"
 #include "modules/perception/obstacle/lidar/interface/base_object_builder.h"
 #include "modules/perception/obstacle/lidar/interface/base_roi_filter.h"
 #include "modules/perception/obstacle/lidar/interface/base_segmentation.h"
@@ -62,8 +63,6 @@ class LidarProcess {
   bool InitFrameDependence();
   bool InitAlgorithmPlugin();
 
-  void TransPointCloudToPCL(const sensor_msgs::PointCloud2& in_msg,
-                            pcl_util::PointCloudPtr* out_cloud);
   bool GetVelodyneTrans(const double query_time, Eigen::Matrix4d* trans);
 
   bool inited_ = false;
@@ -72,6 +71,7 @@ class LidarProcess {
   std::vector<ObjectPtr> objects_;
   HDMapInput* hdmap_input_ = nullptr;
   std::unique_ptr<BaseROIFilter> roi_filter_;
+  std::unique_ptr<BaseGroundDetector> ground_detector_;
   std::unique_ptr<BaseSegmentation> segmentor_;
   std::unique_ptr<BaseObjectBuilder> object_builder_;
   std::unique_ptr<BaseTracker> tracker_;
@@ -16,6 +16,7 @@
 
 #include "modules/perception/obstacle/onboard/lidar_process_subnode.h"
 
+#include <algorithm>
 #include <map>
 
 #include "eigen_conversions/eigen_msg.h"
@@ -23,16 +24,20 @@
 #include "ros/include/ros/ros.h"
 
 #include "modules/common/log.h"
+#include "modules/common/util/string_tokenizer.h"
 #include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/base/time_util.h"
 #include "modules/perception/lib/base/timer.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/obstacle/lidar/dummy/dummy_algorithms.h"
+#include "modules/perception/obstacle/lidar/ground_detector/range_image_ground_detector/range_image_ground_detector.h"
 #include "modules/perception/obstacle/lidar/object_builder/min_box/min_box.h"
 #include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/hdmap_roi_filter.h"
 #include "modules/perception/obstacle/lidar/segmentation/cnnseg/cnn_segmentation.h"
 #include "modules/perception/obstacle/lidar/tracker/hm_tracker/hm_tracker.h"
 #include "modules/perception/obstacle/lidar/type_fuser/sequence_type_fuser/sequence_type_fuser.h"
+#include "modules/perception/obstacle/onboard/point_cloud_util.h"
+#include "modules/perception/onboard/latency_tracer.h"
 #include "modules/perception/onboard/subnode_helper.h"
 #include "modules/perception/onboard/transform_input.h"
 
@@ -40,9 +45,9 @@ namespace apollo {
 namespace perception {
 
 using apollo::common::adapter::AdapterManager;
+using apollo::common::util::StringTokenizer;
 using pcl_util::Point;
 using pcl_util::PointD;
-using pcl_util::PointCloud;
 using pcl_util::PointCloudPtr;
 using pcl_util::PointIndices;
 using pcl_util::PointIndicesPtr;
@@ -80,6 +85,15 @@ bool LidarProcessSubnode::InitInternal() {
   }
   device_id_ = reserve_field_map["device_id"];
 
+  if (!InitAuxLidars()) {
+    AERROR << "failed to Init the other lidars.";
+    return false;
+  }
+
+  if (FLAGS_enable_lidar_pipeline) {
+    StartPipeline();
+  }
+
   CHECK(AdapterManager::GetPointCloud()) << "PointCloud is not initialized.";
   AdapterManager::AddPointCloudCallback(&LidarProcessSubnode::OnPointCloud,
                                         this);
@@ -88,6 +102,14 @@ bool LidarProcessSubnode::InitInternal() {
   return true;
 }
 
+LidarProcessSubnode::~LidarProcessSubnode() {
+  if (segment_queue_ != nullptr) {
+    segment_queue_->push(nullptr);
+    segment_stage_->Join();
+    track_stage_->Join();
+  }
+}
+
 void LidarProcessSubnode::OnPointCloud(
     const sensor_msgs::PointCloud2& message) {
   AINFO << "process OnPointCloud.";
@@ -97,149 +119,288 @@ void LidarProcessSubnode::OnPointCloud(
     return;
   }
   const double kTimeStamp = message.header.stamp.toSec();
+  LatencyTraceFrame trace(kTimeStamp);
   timestamp_ = kTimeStamp;
   ++seq_num_;
 
-  std::shared_ptr<SensorObjects> out_sensor_objects(new SensorObjects);
-  out_sensor_objects->timestamp = timestamp_;
-  out_sensor_objects->sensor_type = VELODYNE_64;
-  out_sensor_objects->sensor_id = device_id_;
-  out_sensor_objects->seq_num = seq_num_;
+  LidarFramePtr frame(new LidarFrame);
+  frame->timestamp = kTimeStamp;
+  frame->sensor_objects.reset(new SensorObjects);
+  frame->sensor_objects->timestamp = kTimeStamp;
+  frame->sensor_objects->sensor_type = VELODYNE_64;
+  frame->sensor_objects->sensor_id = device_id_;
+  frame->sensor_objects->seq_num = seq_num_;
 
   PERF_BLOCK_START();
   /// get velodyne2world transfrom
-  std::shared_ptr<Matrix4d> velodyne_trans = std::make_shared<Matrix4d>();
-  if (!GetVelodyneTrans(kTimeStamp, velodyne_trans.get())) {
+  frame->velodyne_trans = std::make_shared<Matrix4d>();
+  if (GetVelodyneTrans(kTimeStamp, frame->velodyne_trans.get())) {
+    frame->sensor_objects->sensor2world_pose = *frame->velodyne_trans;
+    AINFO << "get lidar trans pose succ. pose: \n" << *frame->velodyne_trans;
+    PERF_BLOCK_END("lidar_get_velodyne2world_transfrom");
+    trace.Mark("lidar_velodyne2world_trans");
+
+    frame->point_cloud = GetPooledPointCloud();
+    TransPointCloudToPCL(message, frame->point_cloud.get());
+    ADEBUG << "transform pointcloud success. points num is: "
+           << frame->point_cloud->points.size();
+    PERF_BLOCK_END("lidar_transform_poindcloud");
+    trace.Mark("lidar_transform_point_cloud");
+
+    if (point_cloud_merger_ != nullptr) {
+      const int num_merged = point_cloud_merger_->Merge(
+          kTimeStamp, *frame->velodyne_trans, frame->point_cloud.get());
+      ADEBUG << "merge the point clouds of " << num_merged
+             << " other lidars, points num is: "
+             << frame->point_cloud->points.size();
+      PERF_BLOCK_END("lidar_merge_point_clouds");
+      trace.Mark("lidar_merge_point_clouds");
+    }
+  } else {
     AERROR << "failed to get trans at timestamp: "
            << GLOG_TIMESTAMP(kTimeStamp);
-    out_sensor_objects->error_code = common::PERCEPTION_ERROR_TF;
-    PublishDataAndEvent(timestamp_, out_sensor_objects);
+    frame->sensor_objects->error_code = common::PERCEPTION_ERROR_TF;
+  }
+
+  if (segment_queue_ != nullptr) {
+    // blocks while the pipeline is full
+    segment_queue_->push(frame);
     return;
   }
-  out_sensor_objects->sensor2world_pose = *velodyne_trans;
-  AINFO << "get lidar trans pose succ. pose: \n" << *velodyne_trans;
-  PERF_BLOCK_END("lidar_get_velodyne2world_transfrom");
+  if (SegmentFrame(frame.get())) {
+    TrackFrame(frame.get());
+  }
+  PublishDataAndEvent(frame->timestamp, frame->sensor_objects);
+}
+
+bool LidarProcessSubnode::InitAuxLidars() {
+  const std::vector<string> topics =
+      StringTokenizer::Split(FLAGS_onboard_aux_lidar_topics, ",");
+  aux_lidar_frame_ids_ =
+      StringTokenizer::Split(FLAGS_onboard_aux_lidar_tf2_child_frame_ids, ",");
+  if (topics.size() != aux_lidar_frame_ids_.size()) {
+    AERROR << "the other lidars have " << topics.size() << " topics but "
+           << aux_lidar_frame_ids_.size() << " tf2 child frame ids.";
+    return false;
+  }
+  if (topics.empty()) {
+    return true;
+  }
 
-  PointCloudPtr point_cloud(new PointCloud);
-  TransPointCloudToPCL(message, &point_cloud);
-  ADEBUG << "transform pointcloud success. points num is: "
-         << point_cloud->points.size();
-  PERF_BLOCK_END("lidar_transform_poindcloud");
+  point_cloud_merger_.reset(
+      new PointCloudMerger(topics.size(), FLAGS_lidar_merge_sync_window));
+  ros::NodeHandle node_handle;
+  for (size_t i = 0; i < topics.size(); ++i) {
+    aux_lidar_subscribers_.push_back(
+        node_handle.subscribe<sensor_msgs::PointCloud2>(
+            topics[i], 1,
+            [this, i](const sensor_msgs::PointCloud2ConstPtr& message) {
+              OnAuxPointCloud(message, i);
+            }));
+    AINFO << "merge the point clouds of " << topics[i] << " in frame "
+          << aux_lidar_frame_ids_[i];
+  }
+  return true;
+}
 
-  // error_code_ = common::OK;
+void LidarProcessSubnode::OnAuxPointCloud(
+    const sensor_msgs::PointCloud2ConstPtr& message, size_t lidar_index) {
+  if (!inited_) {
+    return;
+  }
+  // the pose at the timestamp of each cloud compensates the motion of the
+  // vehicle until the main one
+  const double timestamp = message->header.stamp.toSec();
+  Matrix4d lidar2world;
+  if (!GetLidarTrans(timestamp, aux_lidar_frame_ids_[lidar_index],
+                     &lidar2world)) {
+    AWARN_EVERY(100) << "failed to get trans of "
+                     << aux_lidar_frame_ids_[lidar_index]
+                     << " at timestamp: " << GLOG_TIMESTAMP(timestamp);
+    return;
+  }
+  PointCloudPtr cloud = GetPooledPointCloud();
+  TransPointCloudToPCL(*message, cloud.get());
+  point_cloud_merger_->AddCloud(lidar_index, timestamp, lidar2world, cloud);
+}
 
+bool LidarProcessSubnode::SegmentFrame(LidarFrame* frame) {
+  if (frame->sensor_objects->error_code != common::OK) {
+    return false;
+  }
+  PERF_BLOCK_START();
+  LatencyTraceFrame trace(frame->timestamp);
   /// call hdmap to get ROI
-  HdmapStructPtr hdmap = nullptr;
   if (hdmap_input_) {
     PointD velodyne_pose = {0.0, 0.0, 0.0, 0};  // (0,0,0)
-    Affine3d temp_trans(*velodyne_trans);
+    Affine3d temp_trans(*frame->velodyne_trans);
     PointD velodyne_pose_world = pcl::transformPoint(velodyne_pose, temp_trans);
-    hdmap.reset(new HdmapStruct);
-    hdmap_input_->GetROI(velodyne_pose_world, FLAGS_map_radius, &hdmap);
+    frame->hdmap.reset(new HdmapStruct);
+    hdmap_input_->GetROI(velodyne_pose_world, FLAGS_map_radius, &frame->hdmap);
     PERF_BLOCK_END("lidar_get_roi_from_hdmap");
+    trace.Mark("lidar_get_roi_from_hdmap");
   }
 
   /// call roi_filter
-  PointCloudPtr roi_cloud(new PointCloud);
+  PointCloudPtr roi_cloud = GetPooledPointCloud();
   if (roi_filter_ != nullptr) {
     PointIndicesPtr roi_indices(new PointIndices);
     ROIFilterOptions roi_filter_options;
-    roi_filter_options.velodyne_trans = velodyne_trans;
-    roi_filter_options.hdmap = hdmap;
-    if (roi_filter_->Filter(point_cloud, roi_filter_options,
+    roi_filter_options.velodyne_trans = frame->velodyne_trans;
+    roi_filter_options.hdmap = frame->hdmap;
+    if (roi_filter_->Filter(frame->point_cloud, roi_filter_options,
                             roi_indices.get())) {
-      pcl::copyPointCloud(*point_cloud, *roi_indices, *roi_cloud);
+      pcl::copyPointCloud(*frame->point_cloud, *roi_indices, *roi_cloud);
       roi_indices_ = roi_indices;
     } else {
       AERROR << "failed to call roi filter.";
-      out_sensor_objects->error_code = common::PERCEPTION_ERROR_PROCESS;
-      PublishDataAndEvent(timestamp_, out_sensor_objects);
-      return;
+      frame->sensor_objects->error_code = common::PERCEPTION_ERROR_PROCESS;
+      return false;
     }
   }
   ADEBUG << "call roi_filter succ. The num of roi_cloud is: "
          << roi_cloud->points.size();
   PERF_BLOCK_END("lidar_roi_filter");
+  trace.Mark("lidar_roi_filter");
+
+  /// call ground detector
+  PointIndicesPtr non_ground_indices(new PointIndices);
+  if (ground_detector_ != nullptr) {
+    GroundDetectorOptions ground_detector_options;
+    if (!ground_detector_->Detect(ground_detector_options, roi_cloud,
+                                  non_ground_indices)) {
+      AERROR << "failed to call ground detector.";
+      frame->sensor_objects->error_code = common::PERCEPTION_ERROR_PROCESS;
+      return false;
+    }
+  } else {
+    non_ground_indices->indices.resize(roi_cloud->points.size());
+    std::iota(non_ground_indices->indices.begin(),
+              non_ground_indices->indices.end(), 0);
+  }
+  ADEBUG << "call ground_detector succ. The num of non-ground points is: "
+         << non_ground_indices->indices.size();
+  PERF_BLOCK_END("lidar_ground_detector");
+  trace.Mark("lidar_ground_detector");
 
   /// call segmentor
-  std::vector<ObjectPtr> objects;
   if (segmentor_ != nullptr) {
     SegmentationOptions segmentation_options;
-    segmentation_options.origin_cloud = point_cloud;
-    PointIndices non_ground_indices;
-    non_ground_indices.indices.resize(roi_cloud->points.size());
-    // non_ground_indices.indices.resize(point_cloud->points.size());
-
-    std::iota(non_ground_indices.indices.begin(),
-              non_ground_indices.indices.end(), 0);
-    if (!segmentor_->Segment(roi_cloud, non_ground_indices,
-                             segmentation_options, &objects)) {
+    segmentation_options.origin_cloud = frame->point_cloud;
+    if (!segmentor_->Segment(roi_cloud, *non_ground_indices,
+                             segmentation_options, &frame->objects)) {
       AERROR << "failed to call segmention.";
-      out_sensor_objects->error_code = common::PERCEPTION_ERROR_PROCESS;
-      PublishDataAndEvent(timestamp_, out_sensor_objects);
-      return;
+      frame->sensor_objects->error_code = common::PERCEPTION_ERROR_PROCESS;
+      return false;
     }
   }
-  ADEBUG << "call segmentation succ. The num of objects is: " << objects.size();
+  ADEBUG << "call segmentation succ. The num of objects is: "
+         << frame->objects.size();
   PERF_BLOCK_END("lidar_segmentation");
+  trace.Mark("lidar_segmentation");
 
   /// call object builder
   if (object_builder_ != nullptr) {
     ObjectBuilderOptions object_builder_options;
-    if (!object_builder_->Build(object_builder_options, &objects)) {
+    if (!object_builder_->Build(object_builder_options, &frame->objects)) {
       AERROR << "failed to call object builder.";
-      out_sensor_objects->error_code = common::PERCEPTION_ERROR_PROCESS;
-      PublishDataAndEvent(timestamp_, out_sensor_objects);
-      return;
+      frame->sensor_objects->error_code = common::PERCEPTION_ERROR_PROCESS;
+      return false;
     }
   }
   ADEBUG << "call object_builder succ.";
   PERF_BLOCK_END("lidar_object_builder");
+  trace.Mark("lidar_object_builder");
+  return true;
+}
 
+bool LidarProcessSubnode::TrackFrame(LidarFrame* frame) {
+  if (frame->sensor_objects->error_code != common::OK) {
+    return false;
+  }
+  PERF_BLOCK_START();
+  LatencyTraceFrame trace(frame->timestamp);
   /// call tracker
   if (tracker_ != nullptr) {
     TrackerOptions tracker_options;
-    tracker_options.velodyne_trans = velodyne_trans;
-    tracker_options.hdmap = hdmap;
+    tracker_options.velodyne_trans = frame->velodyne_trans;
+    tracker_options.hdmap = frame->hdmap;
     tracker_options.hdmap_input = hdmap_input_;
-    if (!tracker_->Track(objects, timestamp_, tracker_options,
-                         &(out_sensor_objects->objects))) {
+    if (!tracker_->Track(frame->objects, frame->timestamp, tracker_options,
+                         &(frame->sensor_objects->objects))) {
       AERROR << "failed to call tracker.";
-      out_sensor_objects->error_code = common::PERCEPTION_ERROR_PROCESS;
-      PublishDataAndEvent(timestamp_, out_sensor_objects);
-      return;
+      frame->sensor_objects->error_code = common::PERCEPTION_ERROR_PROCESS;
+      return false;
     }
   }
   ADEBUG << "call tracker succ, there are "
-         << out_sensor_objects->objects.size() << " tracked objects.";
+         << frame->sensor_objects->objects.size() << " tracked objects.";
   PERF_BLOCK_END("lidar_tracker");
+  trace.Mark("lidar_tracker");
 
   /// call type fuser
   if (type_fuser_ != nullptr) {
     TypeFuserOptions type_fuser_options;
-    type_fuser_options.timestamp = timestamp_;
+    type_fuser_options.timestamp = frame->timestamp;
     if (!type_fuser_->FuseType(type_fuser_options,
-                               &(out_sensor_objects->objects))) {
-      out_sensor_objects->error_code = common::PERCEPTION_ERROR_PROCESS;
-      PublishDataAndEvent(timestamp_, out_sensor_objects);
-      return;
+                               &(frame->sensor_objects->objects))) {
+      frame->sensor_objects->error_code = common::PERCEPTION_ERROR_PROCESS;
+      return false;
     }
   }
   ADEBUG << "lidar process succ.";
   PERF_BLOCK_END("lidar_type_fuser");
+  trace.Mark("lidar_type_fuser");
+  return true;
+}
 
-  PublishDataAndEvent(timestamp_, out_sensor_objects);
-  return;
+void LidarProcessSubnode::StartPipeline() {
+  const size_t queue_size =
+      static_cast<size_t>(std::max(1, FLAGS_lidar_pipeline_queue_size));
+  segment_queue_.reset(new FixedSizeConQueue<LidarFramePtr>(queue_size));
+  track_queue_.reset(new FixedSizeConQueue<LidarFramePtr>(queue_size));
+  segment_stage_.reset(new PipelineStage(
+      "LidarSegmentStage", [this]() { RunSegmentStage(); }));
+  track_stage_.reset(
+      new PipelineStage("LidarTrackStage", [this]() { RunTrackStage(); }));
+  ApplySchedConfig(segment_stage_.get());
+  ApplySchedConfig(track_stage_.get());
+  segment_stage_->Start();
+  track_stage_->Start();
+  AINFO << "Lidar pipeline started, queue size: " << queue_size;
+}
+
+void LidarProcessSubnode::RunSegmentStage() {
+  LidarFramePtr frame;
+  do {
+    segment_queue_->pop(&frame);
+    if (frame != nullptr) {
+      SegmentFrame(frame.get());
+    }
+    // a failed frame is published in order by the track stage
+    track_queue_->push(frame);
+  } while (frame != nullptr);
+}
+
+void LidarProcessSubnode::RunTrackStage() {
+  LidarFramePtr frame;
+  for (track_queue_->pop(&frame); frame != nullptr;
+       track_queue_->pop(&frame)) {
+    TrackFrame(frame.get());
+    PublishDataAndEvent(frame->timestamp, frame->sensor_objects);
+  }
 }
 
 void LidarProcessSubnode::RegistAllAlgorithm() {
   RegisterFactoryDummyROIFilter();
+  RegisterFactoryDummyGroundDetector();
   RegisterFactoryDummySegmentation();
   RegisterFactoryDummyObjectBuilder();
   RegisterFactoryDummyTracker();
   RegisterFactoryDummyTypeFuser();
 
   RegisterFactoryHdmapROIFilter();
+  RegisterFactoryRangeImageGroundDetector();
   RegisterFactoryCNNSegmentation();
   RegisterFactoryMinBoxObjectBuilder();
   RegisterFactoryHmObjectTracker();
@@ -292,6 +453,20 @@ bool LidarProcessSubnode::InitAlgorithmPlugin() {
   AINFO << "Init algorithm plugin successfully, roi_filter_: "
         << roi_filter_->name();
 
+  /// init ground detector
+  ground_detector_.reset(BaseGroundDetectorRegisterer::GetInstanceByName(
+      FLAGS_onboard_ground_detector));
+  if (!ground_detector_) {
+    AERROR << "Failed to get instance: " << FLAGS_onboard_ground_detector;
+    return false;
+  }
+  if (!ground_detector_->Init()) {
+    AERROR << "Failed to Init ground detector: " << ground_detector_->name();
+    return false;
+  }
+  AINFO << "Init algorithm plugin successfully, ground detector: "
+        << ground_detector_->name();
+
   /// init segmentation
   segmentor_.reset(
       BaseSegmentationRegisterer::GetInstanceByName(FLAGS_onboard_segmentor));
@@ -350,34 +525,6 @@ bool LidarProcessSubnode::InitAlgorithmPlugin() {
   return true;
 }
 
-void LidarProcessSubnode::TransPointCloudToPCL(
-    const sensor_msgs::PointCloud2& in_msg, PointCloudPtr* out_cloud) {
-  // transform from ros to pcl
-  pcl::PointCloud<pcl_util::PointXYZIT> in_cloud;
-  pcl::fromROSMsg(in_msg, in_cloud);
-  // transform from xyzit to xyzi
-  PointCloudPtr& cloud = *out_cloud;
-  cloud->header = in_cloud.header;
-  cloud->width = in_cloud.width;
-  cloud->height = in_cloud.height;
-  cloud->is_dense = in_cloud.is_dense;
-  cloud->sensor_origin_ = in_cloud.sensor_origin_;
-  cloud->sensor_orientation_ = in_cloud.sensor_orientation_;
-  cloud->points.resize(in_cloud.points.size());
-  size_t points_num = 0;
-  for (size_t idx = 0; idx < in_cloud.size(); ++idx) {
-    pcl_util::PointXYZIT& pt = in_cloud.points[idx];
-    if (!isnan(pt.x) && !isnan(pt.y) && !isnan(pt.z) && !isnan(pt.intensity)) {
-      cloud->points[points_num].x = pt.x;
-      cloud->points[points_num].y = pt.y;
-      cloud->points[points_num].z = pt.z;
-      cloud->points[points_num].intensity = pt.intensity;
-      ++points_num;
-    }
-  }
-  cloud->points.resize(points_num);
-}
-
 void LidarProcessSubnode::PublishDataAndEvent(
     double timestamp, const SharedDataPtr<SensorObjects>& data) {
   // set shared data
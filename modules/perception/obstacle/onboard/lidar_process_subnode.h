@@ -17,19 +17,24 @@
 #ifndef MODULES_PERCEPTION_OBSTACLE_ONBORAD_LIDAR_PROCESS_SUBNODE_H_
 #define MODULES_PERCEPTION_OBSTACLE_ONBORAD_LIDAR_PROCESS_SUBNODE_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "Eigen/Core"
 #include "gtest/gtest_prod.h"
+#include "ros/include/ros/ros.h"
 #include "sensor_msgs/PointCloud2.h"
 
 #include "modules/perception/proto/perception_obstacle.pb.h"
 
 #include "modules/common/adapters/adapter_manager.h"
+#include "modules/perception/lib/base/concurrent_queue.h"
+#include "modules/perception/lib/base/thread.h"
 #include "modules/perception/lib/pcl_util/pcl_types.h"
 #include "modules/perception/obstacle/base/object.h"
+#include "modules/perception/obstacle/lidar/interface/base_ground_detector.h"
 #include "modules/perception/obstacle/lidar/interface/base_object_builder.h"
 #include "modules/perception/obstacle/lidar/interface/base_roi_filter.h"
 #include "modules/perception/obstacle/lidar/interface/base_segmentation.h"
@@ -39,6 +44,7 @@
 #include "modules/perception/obstacle/lidar/visualizer/opengl_visualizer/opengl_visualizer.h"
 #include "modules/perception/obstacle/onboard/hdmap_input.h"
 #include "modules/perception/obstacle/onboard/object_shared_data.h"
+#include "modules/perception/obstacle/onboard/point_cloud_merger.h"
 #include "modules/perception/onboard/subnode.h"
 
 namespace apollo {
@@ -47,26 +53,80 @@ namespace perception {
 class LidarProcessSubnode : public Subnode {
  public:
   LidarProcessSubnode() = default;
-  ~LidarProcessSubnode() = default;
+  ~LidarProcessSubnode();
 
   apollo::common::Status ProcEvents() override {
     return apollo::common::Status::OK();
   }
 
  private:
+  /**
+   * @brief A point cloud on its way through the stages of the processing.
+   * A stage skips a frame whose sensor objects have an error code already.
+   */
+  struct LidarFrame {
+    double timestamp = 0.0;
+    std::shared_ptr<SensorObjects> sensor_objects;
+    std::shared_ptr<Eigen::Matrix4d> velodyne_trans;
+    pcl_util::PointCloudPtr point_cloud;
+    HdmapStructPtr hdmap;
+    std::vector<ObjectPtr> objects;
+  };
+  typedef std::shared_ptr<LidarFrame> LidarFramePtr;
+
+  /**
+   * @brief A thread running one stage of the pipeline.
+   */
+  class PipelineStage : public Thread {
+   public:
+    PipelineStage(const std::string& name, std::function<void()> loop)
+        : Thread(true, name), loop_(loop) {}
+
+   protected:
+    void Run() override { loop_(); }
+
+   private:
+    std::function<void()> loop_;
+  };
+
   bool InitInternal() override;
 
   void OnPointCloud(const sensor_msgs::PointCloud2& message);
 
+  /**
+   * @brief Subscribes to the point clouds of the other lidars, which are
+   * merged into the point cloud of the main lidar.
+   */
+  bool InitAuxLidars();
+  void OnAuxPointCloud(const sensor_msgs::PointCloud2ConstPtr& message,
+                       size_t lidar_index);
+
+  /**
+   * @brief The ROI filter, the segmentation and the object builder.
+   */
+  bool SegmentFrame(LidarFrame* frame);
+
+  /**
+   * @brief The tracker and the type fuser, which keep the state of the
+   * previous frames, so the frames must come in order.
+   */
+  bool TrackFrame(LidarFrame* frame);
+
+  /**
+   * @brief In pipeline mode, the segmentation of a frame overlaps the
+   * tracking of the previous one. The frames go through bounded queues, in
+   * order; a null frame stops the stages.
+   */
+  void StartPipeline();
+  void RunSegmentStage();
+  void RunTrackStage();
+
   pcl_util::PointIndicesPtr GetROIIndices() { return roi_indices_; }
 
   void RegistAllAlgorithm();
   bool InitFrameDependence();
   bool InitAlgorithmPlugin();
 
-  void TransPointCloudToPCL(const sensor_msgs::PointCloud2& in_msg,
-                            pcl_util::PointCloudPtr* out_cloud);
-
   void PublishDataAndEvent(double timestamp,
                            const SharedDataPtr<SensorObjects>& data);
 
@@ -79,11 +139,21 @@ class LidarProcessSubnode : public Subnode {
 
   HDMapInput* hdmap_input_ = nullptr;
   std::unique_ptr<BaseROIFilter> roi_filter_;
+  std::unique_ptr<BaseGroundDetector> ground_detector_;
   std::unique_ptr<BaseSegmentation> segmentor_;
   std::unique_ptr<BaseObjectBuilder> object_builder_;
   std::unique_ptr<BaseTracker> tracker_;
   std::unique_ptr<BaseTypeFuser> type_fuser_;
   pcl_util::PointIndicesPtr roi_indices_;
+
+  std::vector<std::string> aux_lidar_frame_ids_;
+  std::vector<ros::Subscriber> aux_lidar_subscribers_;
+  std::unique_ptr<PointCloudMerger> point_cloud_merger_;
+
+  std::unique_ptr<FixedSizeConQueue<LidarFramePtr>> segment_queue_;
+  std::unique_ptr<FixedSizeConQueue<LidarFramePtr>> track_queue_;
+  std::unique_ptr<PipelineStage> segment_stage_;
+  std::unique_ptr<PipelineStage> track_stage_;
 };
 
 REGISTER_SUBNODE(LidarProcessSubnode);
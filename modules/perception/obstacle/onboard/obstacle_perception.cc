@@ -24,6 +24,7 @@
 #include "modules/perception/obstacle/radar/dummy/dummy_algorithms.h"
 #include "modules/perception/obstacle/radar/modest/modest_radar_detector.h"
 #include "modules/perception/obstacle/fusion/probabilistic_fusion/probabilistic_fusion.h"
+#include "modules/perception/onboard/latency_tracer.h"
 
 DEFINE_string(obstacle_show_type, "fused",
               "show obstacle from lidar/radar/fused");
@@ -171,6 +172,7 @@ bool ObstaclePerception::Process(SensorRawFrame* frame,
   sensor_objects->sensor2world_pose = frame->pose_;
 
   /// fusion
+  LatencyTraceFrame trace(frame->timestamp_);
   std::vector<SensorObjects> multi_sensor_objs;
   multi_sensor_objs.push_back(*sensor_objects);
   std::vector<ObjectPtr> fused_objects;
@@ -181,6 +183,7 @@ bool ObstaclePerception::Process(SensorRawFrame* frame,
   *out_objects = fused_objects;
   AINFO << "fused objects size: " << fused_objects.size();
   PERF_BLOCK_END("sensor_fusion");
+  trace.Mark("sensor_fusion");
   /// set frame content
   if (FLAGS_enable_visualization) {
     if (obstacle_show_type_ == SHOW_FUSED) {
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/onboard/point_cloud_merger.h"
+
+#include <cmath>
+
+#include "Eigen/Geometry"
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace perception {
+
+using pcl_util::Point;
+using pcl_util::PointCloud;
+
+const size_t PointCloudMerger::kMaxCloudsPerLidar;
+
+PointCloudMerger::PointCloudMerger(size_t num_lidars, double sync_window)
+    : sync_window_(sync_window), lidar_clouds_(num_lidars) {}
+
+void PointCloudMerger::AddCloud(size_t lidar_index, double timestamp,
+                                const Eigen::Matrix4d& lidar2world,
+                                pcl_util::PointCloudConstPtr cloud) {
+  if (lidar_index >= lidar_clouds_.size() || cloud == nullptr) {
+    AERROR << "invalid cloud of lidar " << lidar_index;
+    return;
+  }
+  LidarCloud lidar_cloud;
+  lidar_cloud.timestamp = timestamp;
+  lidar_cloud.lidar2world = lidar2world;
+  lidar_cloud.cloud = cloud;
+  MutexLock lock(&mutex_);
+  LidarClouds& clouds = lidar_clouds_[lidar_index];
+  clouds.push_back(lidar_cloud);
+  if (clouds.size() > kMaxCloudsPerLidar) {
+    clouds.pop_front();
+  }
+}
+
+int PointCloudMerger::Merge(double timestamp,
+                            const Eigen::Matrix4d& main2world,
+                            PointCloud* cloud) {
+  // the clouds are picked under the lock and transformed out of it
+  LidarClouds synced_clouds;
+  {
+    MutexLock lock(&mutex_);
+    for (const LidarClouds& clouds : lidar_clouds_) {
+      const LidarCloud* closest = nullptr;
+      for (const LidarCloud& lidar_cloud : clouds) {
+        const double time_diff = std::fabs(lidar_cloud.timestamp - timestamp);
+        if (time_diff <= sync_window_ &&
+            (closest == nullptr ||
+             time_diff < std::fabs(closest->timestamp - timestamp))) {
+          closest = &lidar_cloud;
+        }
+      }
+      if (closest != nullptr) {
+        synced_clouds.push_back(*closest);
+      }
+    }
+  }
+  if (synced_clouds.empty()) {
+    return 0;
+  }
+
+  size_t num_points = cloud->points.size();
+  for (const LidarCloud& lidar_cloud : synced_clouds) {
+    num_points += lidar_cloud.cloud->points.size();
+  }
+  cloud->points.reserve(num_points);
+  const Eigen::Matrix4d world2main = main2world.inverse();
+  for (const LidarCloud& lidar_cloud : synced_clouds) {
+    // the relative pose is small, so the points are moved in float
+    const Eigen::Matrix4f lidar2main =
+        (world2main * lidar_cloud.lidar2world).cast<float>();
+    const Eigen::Matrix3f rotation = lidar2main.topLeftCorner<3, 3>();
+    const Eigen::Vector3f translation = lidar2main.topRightCorner<3, 1>();
+    for (const Point& point : lidar_cloud.cloud->points) {
+      const Eigen::Vector3f merged =
+          rotation * Eigen::Vector3f(point.x, point.y, point.z) + translation;
+      Point merged_point = point;
+      merged_point.x = merged.x();
+      merged_point.y = merged.y();
+      merged_point.z = merged.z();
+      cloud->points.push_back(merged_point);
+    }
+  }
+  cloud->width = cloud->points.size();
+  cloud->height = 1;
+  return static_cast<int>(synced_clouds.size());
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_OBSTACLE_ONBOARD_POINT_CLOUD_MERGER_H_
+#define MODULES_PERCEPTION_OBSTACLE_ONBOARD_POINT_CLOUD_MERGER_H_
+
+#include <deque>
+#include <vector>
+
+#include "Eigen/Core"
+
+#include "modules/common/macro.h"
+#include "modules/perception/lib/base/mutex.h"
+#include "modules/perception/lib/pcl_util/pcl_types.h"
+
+namespace apollo {
+namespace perception {
+
+/**
+ * @brief Merges the clouds of the other lidars of the vehicle into the cloud
+ * of the main lidar, so the segmentation runs once per merged sweep. The
+ * cloud of every other lidar is moved into the main lidar frame by the world
+ * poses of both lidars at their own timestamps, which compensates the motion
+ * of the vehicle between them. Thread-safe.
+ */
+class PointCloudMerger {
+ public:
+  /**
+   * @param num_lidars The number of the other lidars.
+   * @param sync_window The maximum difference in seconds between the
+   * timestamp of a merged cloud and the one of the main cloud.
+   */
+  PointCloudMerger(size_t num_lidars, double sync_window);
+
+  /**
+   * @brief Keep the cloud of another lidar until it is merged or replaced by
+   * newer clouds of the lidar.
+   * @param lidar_index The index of the lidar, lower than num_lidars.
+   * @param timestamp The timestamp of the cloud.
+   * @param lidar2world The pose of the lidar at the timestamp.
+   * @param cloud The points in the lidar frame, not modified afterwards.
+   */
+  void AddCloud(size_t lidar_index, double timestamp,
+                const Eigen::Matrix4d& lidar2world,
+                pcl_util::PointCloudConstPtr cloud);
+
+  /**
+   * @brief Append to the main cloud the points of the cloud of every other
+   * lidar of the timestamp closest to the main one within the sync window.
+   * The merged cloud is unorganized.
+   * @param timestamp The timestamp of the main cloud.
+   * @param main2world The pose of the main lidar at the timestamp.
+   * @param cloud The main cloud, in the main lidar frame.
+   * @return The number of lidars merged.
+   */
+  int Merge(double timestamp, const Eigen::Matrix4d& main2world,
+            pcl_util::PointCloud* cloud);
+
+ private:
+  struct LidarCloud {
+    double timestamp = 0.0;
+    Eigen::Matrix4d lidar2world;
+    pcl_util::PointCloudConstPtr cloud;
+  };
+  typedef std::deque<LidarCloud, Eigen::aligned_allocator<LidarCloud>>
+      LidarClouds;
+
+  // the number of the last clouds kept per lidar
+  static const size_t kMaxCloudsPerLidar = 4;
+
+  const double sync_window_;
+  Mutex mutex_;
+  std::vector<LidarClouds> lidar_clouds_;
+
+  DISALLOW_COPY_AND_ASSIGN(PointCloudMerger);
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_OBSTACLE_ONBOARD_POINT_CLOUD_MERGER_H_
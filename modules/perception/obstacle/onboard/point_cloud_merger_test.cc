@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/onboard/point_cloud_merger.h"
+
+#include "Eigen/Geometry"
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+
+namespace {
+
+pcl_util::PointCloudPtr MakeCloud(const int num_points, const float intensity) {
+  pcl_util::PointCloudPtr cloud(new pcl_util::PointCloud);
+  for (int i = 0; i < num_points; ++i) {
+    pcl_util::Point point;
+    point.x = i;
+    point.y = 1.0f;
+    point.z = -1.0f;
+    point.intensity = intensity;
+    cloud->points.push_back(point);
+  }
+  cloud->width = num_points;
+  cloud->height = 1;
+  return cloud;
+}
+
+Eigen::Matrix4d MakePose(const double yaw, const Eigen::Vector3d& position) {
+  Eigen::Affine3d pose = Eigen::Translation3d(position) *
+                         Eigen::AngleAxisd(yaw, Eigen::Vector3d::UnitZ());
+  return pose.matrix();
+}
+
+}  // namespace
+
+TEST(PointCloudMergerTest, Merge) {
+  PointCloudMerger merger(2, 0.05);
+  const Eigen::Vector3d origin(4.0e5, 3.0e6, 10.0);
+  const Eigen::Matrix4d main2world = MakePose(0.3, origin);
+  // the vehicle moved 1m forward between the clouds of the first lidar, the
+  // second one is mounted 2m ahead of the main lidar and turned by 90 degrees
+  merger.AddCloud(0, 9.9, MakePose(0.3, origin), MakeCloud(3, 1.0f));
+  const Eigen::Vector3d forward(std::cos(0.3), std::sin(0.3), 0.0);
+  merger.AddCloud(0, 10.01, MakePose(0.3, origin + forward),
+                  MakeCloud(4, 2.0f));
+  merger.AddCloud(1, 10.02, MakePose(0.3 + M_PI_2, origin + 2.0 * forward),
+                  MakeCloud(2, 3.0f));
+  // out of the sync window
+  merger.AddCloud(1, 10.2, MakePose(0.3, origin), MakeCloud(5, 4.0f));
+
+  pcl_util::PointCloudPtr cloud = MakeCloud(10, 0.0f);
+  cloud->height = 2;
+  cloud->width = 5;
+  EXPECT_EQ(2, merger.Merge(10.0, main2world, cloud.get()));
+  ASSERT_EQ(16u, cloud->points.size());
+  EXPECT_EQ(16u, cloud->width);
+  EXPECT_EQ(1u, cloud->height);
+  for (int i = 0; i < 4; ++i) {
+    const pcl_util::Point& point = cloud->points[10 + i];
+    EXPECT_FLOAT_EQ(2.0f, point.intensity);
+    EXPECT_NEAR(i + 1.0, point.x, 1e-4);
+    EXPECT_NEAR(1.0, point.y, 1e-4);
+    EXPECT_NEAR(-1.0, point.z, 1e-4);
+  }
+  for (int i = 0; i < 2; ++i) {
+    const pcl_util::Point& point = cloud->points[14 + i];
+    EXPECT_FLOAT_EQ(3.0f, point.intensity);
+    EXPECT_NEAR(2.0 - 1.0, point.x, 1e-4);
+    EXPECT_NEAR(i, point.y, 1e-4);
+    EXPECT_NEAR(-1.0, point.z, 1e-4);
+  }
+
+  pcl_util::PointCloudPtr late_cloud = MakeCloud(1, 0.0f);
+  EXPECT_EQ(1, merger.Merge(10.2, main2world, late_cloud.get()));
+  EXPECT_EQ(6u, late_cloud->points.size());
+  EXPECT_EQ(0, merger.Merge(11.0, main2world, late_cloud.get()));
+  EXPECT_EQ(6u, late_cloud->points.size());
+}
+
+TEST(PointCloudMergerTest, KeepLastClouds) {
+  PointCloudMerger merger(1, 0.5);
+  for (int i = 0; i < 10; ++i) {
+    merger.AddCloud(0, i * 0.1, Eigen::Matrix4d::Identity(),
+                    MakeCloud(i + 1, 0.0f));
+  }
+  // only the last four clouds are kept
+  pcl_util::PointCloud cloud;
+  EXPECT_EQ(0, merger.Merge(0.0, Eigen::Matrix4d::Identity(), &cloud));
+  EXPECT_EQ(1, merger.Merge(0.62, Eigen::Matrix4d::Identity(), &cloud));
+  EXPECT_EQ(7u, cloud.points.size());
+  // an invalid lidar index is ignored
+  merger.AddCloud(1, 0.0, Eigen::Matrix4d::Identity(), MakeCloud(1, 0.0f));
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/onboard/point_cloud_util.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "pcl_conversions/pcl_conversions.h"
+
+namespace apollo {
+namespace perception {
+
+namespace {
+
+// Byte offsets in a point of the message of the fields of
+// pcl_util::PointXYZIT used by the output cloud.
+struct PointXYZIOffsets {
+  int x = -1;
+  int y = -1;
+  int z = -1;
+  int intensity = -1;
+};
+
+// The fields are matched as pcl::fromROSMsg() does, by name and data type.
+bool GetPointXYZIOffsets(const sensor_msgs::PointCloud2& msg,
+                         PointXYZIOffsets* offsets) {
+  for (const auto& field : msg.fields) {
+    if (field.count > 1) {
+      continue;
+    }
+    // the first matching field is used
+    int* offset = nullptr;
+    if (field.datatype == sensor_msgs::PointField::FLOAT32) {
+      if (field.name == "x") {
+        offset = &offsets->x;
+      } else if (field.name == "y") {
+        offset = &offsets->y;
+      } else if (field.name == "z") {
+        offset = &offsets->z;
+      }
+    } else if (field.datatype == sensor_msgs::PointField::UINT8 &&
+               field.name == "intensity") {
+      offset = &offsets->intensity;
+    }
+    if (offset != nullptr && *offset < 0) {
+      *offset = field.offset;
+    }
+  }
+  const int float_end =
+      static_cast<int>(msg.point_step) - static_cast<int>(sizeof(float));
+  if (offsets->x < 0 || offsets->x > float_end || offsets->y < 0 ||
+      offsets->y > float_end || offsets->z < 0 || offsets->z > float_end ||
+      offsets->intensity < 0 ||
+      offsets->intensity >= static_cast<int>(msg.point_step)) {
+    return false;
+  }
+  // every row must hold its points
+  return static_cast<uint64_t>(msg.point_step) * msg.width <= msg.row_step &&
+         static_cast<uint64_t>(msg.row_step) * msg.height <= msg.data.size();
+}
+
+inline float ReadFloat(const uint8_t* data) {
+  float value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+void SetCloudInfo(const sensor_msgs::PointCloud2& msg,
+                  pcl_util::PointCloud* cloud) {
+  pcl_conversions::toPCL(msg.header, cloud->header);
+  cloud->width = msg.width;
+  cloud->height = msg.height;
+  cloud->is_dense = msg.is_dense == 1;
+  cloud->sensor_origin_ = Eigen::Vector4f::Zero();
+  cloud->sensor_orientation_ = Eigen::Quaternionf::Identity();
+}
+
+}  // namespace
+
+void TransPointCloudToPCL(const sensor_msgs::PointCloud2& in_msg,
+                          pcl_util::PointCloud* out_cloud) {
+  PointXYZIOffsets offsets;
+  out_cloud->points.clear();
+  if (GetPointXYZIOffsets(in_msg, &offsets)) {
+    // read the points in place and drop the ones with NaN coordinates
+    SetCloudInfo(in_msg, out_cloud);
+    out_cloud->points.reserve(static_cast<size_t>(in_msg.width) *
+                              in_msg.height);
+    for (uint32_t row = 0; row < in_msg.height; ++row) {
+      const uint8_t* point_data =
+          in_msg.data.data() + static_cast<size_t>(row) * in_msg.row_step;
+      for (uint32_t col = 0; col < in_msg.width;
+           ++col, point_data += in_msg.point_step) {
+        pcl_util::Point point;
+        point.x = ReadFloat(point_data + offsets.x);
+        point.y = ReadFloat(point_data + offsets.y);
+        point.z = ReadFloat(point_data + offsets.z);
+        if (std::isnan(point.x) || std::isnan(point.y) ||
+            std::isnan(point.z)) {
+          continue;
+        }
+        point.intensity = point_data[offsets.intensity];
+        out_cloud->points.push_back(point);
+      }
+    }
+    return;
+  }
+
+  // transform from ros to pcl
+  pcl::PointCloud<pcl_util::PointXYZIT> in_cloud;
+  pcl::fromROSMsg(in_msg, in_cloud);
+  // transform from xyzit to xyzi
+  out_cloud->header = in_cloud.header;
+  out_cloud->width = in_cloud.width;
+  out_cloud->height = in_cloud.height;
+  out_cloud->is_dense = in_cloud.is_dense;
+  out_cloud->sensor_origin_ = in_cloud.sensor_origin_;
+  out_cloud->sensor_orientation_ = in_cloud.sensor_orientation_;
+  out_cloud->points.resize(in_cloud.points.size());
+  size_t points_num = 0;
+  for (size_t idx = 0; idx < in_cloud.size(); ++idx) {
+    pcl_util::PointXYZIT& pt = in_cloud.points[idx];
+    if (!std::isnan(pt.x) && !std::isnan(pt.y) && !std::isnan(pt.z)) {
+      out_cloud->points[points_num].x = pt.x;
+      out_cloud->points[points_num].y = pt.y;
+      out_cloud->points[points_num].z = pt.z;
+      out_cloud->points[points_num].intensity = pt.intensity;
+      ++points_num;
+    }
+  }
+  out_cloud->points.resize(points_num);
+}
+
+}  // namespace perception
+}  // namespace apollo
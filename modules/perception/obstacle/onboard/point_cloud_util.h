@@ -0,0 +1,42 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_OBSTACLE_ONBOARD_POINT_CLOUD_UTIL_H_
+#define MODULES_PERCEPTION_OBSTACLE_ONBOARD_POINT_CLOUD_UTIL_H_
+
+#include "sensor_msgs/PointCloud2.h"
+
+#include "modules/perception/lib/pcl_util/pcl_types.h"
+
+namespace apollo {
+namespace perception {
+
+/**
+ * @brief Convert a lidar message of pcl_util::PointXYZIT points to a cloud of
+ * the points without NaN coordinates, as pcl::fromROSMsg() followed by the
+ * NaN filtering would do. The points are read in place from the buffer of
+ * the message when it has the fields of pcl_util::PointXYZIT, so no
+ * intermediate cloud is built, and the storage of out_cloud is reused.
+ * @param in_msg The lidar message.
+ * @param out_cloud The output cloud.
+ */
+void TransPointCloudToPCL(const sensor_msgs::PointCloud2& in_msg,
+                          pcl_util::PointCloud* out_cloud);
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_OBSTACLE_ONBOARD_POINT_CLOUD_UTIL_H_
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/obstacle/onboard/point_cloud_util.h"
+
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+
+namespace {
+
+void AddField(const std::string& name, const uint32_t offset,
+              const uint8_t datatype, sensor_msgs::PointCloud2* msg) {
+  sensor_msgs::PointField field;
+  field.name = name;
+  field.offset = offset;
+  field.datatype = datatype;
+  field.count = 1;
+  msg->fields.push_back(field);
+}
+
+void SetFloat(const float value, uint8_t* data) {
+  memcpy(data, &value, sizeof(value));
+}
+
+// A message in the layout of the velodyne driver, with padded rows. Every
+// third point has a NaN coordinate.
+sensor_msgs::PointCloud2 MakeMessage(const uint8_t intensity_datatype) {
+  sensor_msgs::PointCloud2 msg;
+  msg.header.frame_id = "velodyne64";
+  msg.height = 4;
+  msg.width = 30;
+  AddField("x", 0, sensor_msgs::PointField::FLOAT32, &msg);
+  AddField("y", 4, sensor_msgs::PointField::FLOAT32, &msg);
+  AddField("z", 8, sensor_msgs::PointField::FLOAT32, &msg);
+  AddField("intensity", 16, intensity_datatype, &msg);
+  AddField("timestamp", 24, sensor_msgs::PointField::FLOAT64, &msg);
+  msg.point_step = 32;
+  msg.row_step = msg.point_step * msg.width + 8;
+  msg.is_dense = false;
+  msg.data.assign(msg.row_step * msg.height, 0);
+  for (uint32_t row = 0; row < msg.height; ++row) {
+    for (uint32_t col = 0; col < msg.width; ++col) {
+      const uint32_t index = row * msg.width + col;
+      uint8_t* point = &msg.data[row * msg.row_step + col * msg.point_step];
+      SetFloat(index, point);
+      SetFloat(index % 3 == 0 ? std::numeric_limits<float>::quiet_NaN()
+                              : 2.0f * index,
+               point + 4);
+      SetFloat(-1.0f, point + 8);
+      point[16] = index % 256;
+    }
+  }
+  return msg;
+}
+
+}  // namespace
+
+TEST(PointCloudUtilTest, TransPointCloudToPCL) {
+  sensor_msgs::PointCloud2 msg = MakeMessage(sensor_msgs::PointField::UINT8);
+  pcl_util::PointCloud cloud;
+  // the previous points are dropped
+  cloud.push_back(pcl_util::Point(1.0f));
+  TransPointCloudToPCL(msg, &cloud);
+
+  EXPECT_EQ("velodyne64", cloud.header.frame_id);
+  EXPECT_EQ(msg.width, cloud.width);
+  EXPECT_EQ(msg.height, cloud.height);
+  EXPECT_FALSE(cloud.is_dense);
+  ASSERT_EQ(80, cloud.points.size());
+  size_t i = 0;
+  for (uint32_t index = 0; index < msg.width * msg.height; ++index) {
+    if (index % 3 == 0) {
+      continue;
+    }
+    const pcl_util::Point& point = cloud.points[i++];
+    EXPECT_FLOAT_EQ(index, point.x);
+    EXPECT_FLOAT_EQ(2.0f * index, point.y);
+    EXPECT_FLOAT_EQ(-1.0f, point.z);
+    EXPECT_FLOAT_EQ(index % 256, point.intensity);
+    EXPECT_FLOAT_EQ(0.0f, point.h);
+  }
+}
+
+TEST(PointCloudUtilTest, TransPointCloudToPCLWithOtherLayout) {
+  // the intensity of pcl_util::PointXYZIT is not found, so the message is
+  // converted by pcl::fromROSMsg()
+  sensor_msgs::PointCloud2 msg = MakeMessage(sensor_msgs::PointField::FLOAT32);
+  pcl_util::PointCloud cloud;
+  TransPointCloudToPCL(msg, &cloud);
+  ASSERT_EQ(80, cloud.points.size());
+  EXPECT_FLOAT_EQ(1.0f, cloud.points[0].x);
+  EXPECT_FLOAT_EQ(2.0f, cloud.points[0].y);
+  EXPECT_FLOAT_EQ(119.0f, cloud.points.back().x);
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -32,6 +32,7 @@
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/obstacle/base/object.h"
 #include "modules/perception/obstacle/radar/dummy/dummy_algorithms.h"
+#include "modules/perception/onboard/latency_tracer.h"
 #include "modules/perception/onboard/subnode_helper.h"
 #include "modules/perception/onboard/transform_input.h"
 
@@ -118,6 +119,7 @@ void RadarProcessSubnode::OnRadar(const ContiRadar &radar_obs) {
         << start_latency << "]";
   // 0. correct radar timestamp
   timestamp -= 0.07;
+  LatencyTraceFrame trace(timestamp);
   auto *header = radar_obs_proto.mutable_header();
   header->set_timestamp_sec(timestamp);
   header->set_radar_timestamp(timestamp * 1e9);
@@ -172,6 +174,8 @@ void RadarProcessSubnode::OnRadar(const ContiRadar &radar_obs) {
     return;
   }
 
+  trace.Mark("radar_preprocess");
+
   // 4. Call RadarDetector::detect.
   PERF_BLOCK_START();
   options.radar2world_pose = &(*radar2world_pose);
@@ -192,6 +196,7 @@ void RadarProcessSubnode::OnRadar(const ContiRadar &radar_obs) {
     return;
   }
   PERF_BLOCK_END("radar_detect");
+  trace.Mark("radar_detect");
   PublishDataAndEvent(timestamp, radar_objects);
 
   const double end_timestamp = common::time::Clock::NowInSeconds();
@@ -16,7 +16,9 @@
 
 #include "modules/perception/obstacle/radar/modest/modest_radar_detector.h"
 
+#include <cmath>
 #include <memory>
+#include "modules/perception/lib/base/timer.h"
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/obstacle/radar/modest/conti_radar_util.h"
 #include "modules/perception/obstacle/radar/modest/object_builder.h"
@@ -38,6 +40,18 @@ bool ModestRadarDetector::Init() {
     AERROR << "use_had_map not found.";
     return false;
   }
+  if (!model_config->GetValue("use_roi_bitmap", &use_roi_bitmap_)) {
+    AERROR << "use_roi_bitmap not found.";
+    return false;
+  }
+  if (!model_config->GetValue("roi_bitmap_cell_size",
+                              &roi_bitmap_cell_size_)) {
+    AERROR << "roi_bitmap_cell_size not found.";
+    return false;
+  }
+  if (use_roi_bitmap_) {
+    roi_bitmap_.Init(roi_bitmap_cell_size_, 0.0);
+  }
   if (!model_config->GetValue("max_theta", &max_theta_)) {
     AERROR << "max_theta not found.";
     return false;
@@ -181,21 +195,30 @@ bool ModestRadarDetector::Detect(const ContiRadar &raw_obstacles,
   main_velocity[1] = options.car_linear_speed[1];
   // preparation
 
+  PERF_BLOCK_START();
   SensorObjects radar_objects;
   object_builder_.Build(
     raw_obstacles, radar_pose, main_velocity, &radar_objects);
   radar_objects.timestamp = static_cast<double>(
     raw_obstacles.header().timestamp_sec());
   radar_objects.sensor_type = RADAR;
+  PERF_BLOCK_END("[ModestRadarDetector] build objects");
 
   // roi filter
+  if (use_had_map_ && use_roi_bitmap_ && !map_polygons.empty()) {
+    UpdateRoiBitmap(map_polygons,
+                    Eigen::Vector2d(radar_pose(0, 3), radar_pose(1, 3)));
+  }
   auto &filter_objects = radar_objects.objects;
   RoiFilter(map_polygons, &filter_objects);
+  PERF_BLOCK_END("[ModestRadarDetector] roi filter");
   // treatment
   radar_tracker_->Process(radar_objects);
   AINFO << "After process, object size: " << radar_objects.objects.size();
+  PERF_BLOCK_END("[ModestRadarDetector] track");
   CollectRadarResult(objects);
   AINFO << "radar object size: " << objects->size();
+  PERF_BLOCK_END("[ModestRadarDetector] collect result");
   return true;
 }
 
@@ -206,11 +229,11 @@ bool ModestRadarDetector::CollectRadarResult(std::vector<ObjectPtr> *objects) {
     return false;
   }
   for (size_t i = 0; i < obs_track.size(); ++i) {
-    ObjectPtr object_ptr = ObjectPtr(new Object());
     const ObjectPtr &object_radar_ptr = obs_track[i].GetObsRadar();
     if (use_fp_filter_ && object_radar_ptr->is_background) {
       continue;
     }
+    ObjectPtr object_ptr = GetPooledObject();
     object_ptr->clone(*object_radar_ptr);
     object_ptr->tracking_time = obs_track[i].GetTrackingTime();
     object_ptr->track_id = obs_track[i].GetObsId();
@@ -229,12 +252,7 @@ void ModestRadarDetector::RoiFilter(
     if (!map_polygons.empty()) {
       int obs_number = 0;
       for (size_t i = 0; i < filter_objects->size(); i++) {
-        pcl_util::PointD obs_position;
-        obs_position.x = filter_objects->at(i)->center(0);
-        obs_position.y = filter_objects->at(i)->center(1);
-        obs_position.z = filter_objects->at(i)->center(2);
-        if (RadarUtil::IsXyPointInHdmap<pcl_util::PointD>(obs_position,
-                                                          map_polygons)) {
+        if (IsInRoi(map_polygons, *(filter_objects->at(i)))) {
           filter_objects->at(obs_number) = filter_objects->at(i);
           obs_number++;
         }
@@ -248,5 +266,42 @@ void ModestRadarDetector::RoiFilter(
   AINFO << "After using hdmap, object size:" << filter_objects->size();
 }
 
+void ModestRadarDetector::UpdateRoiBitmap(
+    const std::vector<PolygonDType> &map_polygons,
+    const Eigen::Vector2d &radar_location) {
+  roi_bitmap_center_ = radar_location;
+  roi_bitmap_range_ = FLAGS_front_radar_forward_distance * M_SQRT1_2;
+  if (!roi_bitmap_.MoveWindow(roi_bitmap_center_, roi_bitmap_range_)) {
+    return;
+  }
+  std::vector<TiledBitmapCache::Polygon> raw_polygons(map_polygons.size());
+  for (size_t i = 0; i < map_polygons.size(); ++i) {
+    raw_polygons[i].resize(map_polygons[i].size());
+    for (size_t j = 0; j < map_polygons[i].size(); ++j) {
+      raw_polygons[i][j].x() = map_polygons[i][j].x;
+      raw_polygons[i][j].y() = map_polygons[i][j].y;
+    }
+  }
+  roi_bitmap_.Rasterize(raw_polygons, FLAGS_front_radar_forward_distance);
+  ADEBUG << "Rasterized " << roi_bitmap_.num_rasterized_tiles()
+         << " radar ROI tiles, " << roi_bitmap_.num_cached_tiles()
+         << " tiles cached.";
+}
+
+bool ModestRadarDetector::IsInRoi(const std::vector<PolygonDType> &map_polygons,
+                                  const Object &object) const {
+  if (use_roi_bitmap_ &&
+      std::abs(object.center(0) - roi_bitmap_center_.x()) < roi_bitmap_range_ &&
+      std::abs(object.center(1) - roi_bitmap_center_.y()) < roi_bitmap_range_) {
+    return roi_bitmap_.Check(object.center(0), object.center(1));
+  }
+  pcl_util::PointD obs_position;
+  obs_position.x = object.center(0);
+  obs_position.y = object.center(1);
+  obs_position.z = object.center(2);
+  return RadarUtil::IsXyPointInHdmap<pcl_util::PointD>(obs_position,
+                                                       map_polygons);
+}
+
 }  // namespace perception
 }  // namespace apollo
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "modules/perception/obstacle/lidar/roi_filter/hdmap_roi_filter/tiled_bitmap_cache.h"
 #include "modules/perception/obstacle/radar/interface/base_radar_detector.h"
 #include "modules/perception/obstacle/radar/modest/object_builder.h"
 #include "modules/perception/obstacle/radar/modest/radar_track_manager.h"
@@ -58,6 +59,19 @@ class ModestRadarDetector : public BaseRadarDetector {
   void RoiFilter(const std::vector<PolygonDType> &map_polygons,
                  std::vector<ObjectPtr>* filter_objects);
 
+  // @brief: draw the map polygons entering the window around the radar into
+  // the ROI bitmap, the window is the largest square in the circle in which
+  // the polygons are queried, so that its tiles are complete
+  // @param [in]: roi map polygons, using world frame.
+  // @param [in]: radar location, using world frame.
+  void UpdateRoiBitmap(const std::vector<PolygonDType> &map_polygons,
+                       const Eigen::Vector2d &radar_location);
+
+  // @brief: whether the object center is in the roi map polygons, the ROI
+  // bitmap is checked when it is used and the center is in its window
+  bool IsInRoi(const std::vector<PolygonDType> &map_polygons,
+               const Object &object) const;
+
   // for unit test
   bool result_init_ = true;
   bool result_detect_ = true;
@@ -65,11 +79,19 @@ class ModestRadarDetector : public BaseRadarDetector {
   bool use_had_map_;
   double max_theta_;
   bool use_fp_filter_;
+  // check the roi in a bitmap of world tiles cached across frames, rather
+  // than in the polygons, as HdmapROIFilter does for the lidar
+  bool use_roi_bitmap_;
+  double roi_bitmap_cell_size_;
+  TiledBitmapCache roi_bitmap_;
+  Eigen::Vector2d roi_bitmap_center_ = Eigen::Vector2d::Zero();
+  double roi_bitmap_range_ = 0.0;
   int delay_frames_;
   ContiParams conti_params_;
   ObjectBuilder object_builder_;
   boost::shared_ptr<RadarTrackManager> radar_tracker_;
   FRIEND_TEST(ModestRadarDetectorTest, modest_radar_detector_test);
+  FRIEND_TEST(ModestRadarDetectorTest, roi_filter_test);
   DISALLOW_COPY_AND_ASSIGN(ModestRadarDetector);
 };
 
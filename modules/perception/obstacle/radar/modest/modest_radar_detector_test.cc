@@ -98,5 +98,47 @@ TEST(ModestRadarDetectorTest, modest_radar_detector_test) {
   delete radar_detector;
 }
 
+TEST(ModestRadarDetectorTest, roi_filter_test) {
+  FLAGS_work_root = "modules/perception";
+  FLAGS_config_manager_path = "./conf/config_manager.config";
+  ModestRadarDetector radar_detector;
+  EXPECT_TRUE(radar_detector.Init());
+  radar_detector.use_had_map_ = true;
+  radar_detector.use_roi_bitmap_ = true;
+  radar_detector.roi_bitmap_.Init(0.25, 0.0);
+
+  // the second square is out of the bitmap window around the radar
+  std::vector<PolygonDType> map_polygons(2);
+  const double centers[2] = {0.0, 100.0};
+  for (int i = 0; i < 2; ++i) {
+    map_polygons[i].points.resize(4);
+    map_polygons[i].points[0].x = centers[i] - 20;
+    map_polygons[i].points[0].y = -20;
+    map_polygons[i].points[1].x = centers[i] - 20;
+    map_polygons[i].points[1].y = 20;
+    map_polygons[i].points[2].x = centers[i] + 20;
+    map_polygons[i].points[2].y = 20;
+    map_polygons[i].points[3].x = centers[i] + 20;
+    map_polygons[i].points[3].y = -20;
+  }
+  radar_detector.UpdateRoiBitmap(map_polygons, Eigen::Vector2d(0.0, 0.0));
+  EXPECT_GT(radar_detector.roi_bitmap_.num_cached_tiles(), 0);
+
+  const double xs[5] = {0.0, 10.5, 40.0, 100.0, 100.0};
+  const double ys[5] = {0.0, -15.0, 0.0, 0.0, 30.0};
+  std::vector<ObjectPtr> objects;
+  for (int i = 0; i < 5; ++i) {
+    ObjectPtr object(new Object());
+    object->center = Eigen::Vector3d(xs[i], ys[i], 0.0);
+    objects.push_back(object);
+  }
+  radar_detector.RoiFilter(map_polygons, &objects);
+  ASSERT_EQ(objects.size(), 3);
+  EXPECT_DOUBLE_EQ(objects[0]->center(0), 0.0);
+  EXPECT_DOUBLE_EQ(objects[1]->center(0), 10.5);
+  EXPECT_DOUBLE_EQ(objects[2]->center(0), 100.0);
+  EXPECT_DOUBLE_EQ(objects[2]->center(1), 0.0);
+}
+
 }  // namespace perception
 }  // namespace apollo
@@ -34,8 +34,28 @@ void ObjectBuilder::Build(const ContiRadar &raw_obstacles,
   }
   std::map<int, int> current_con_ids;
   auto objects = &(radar_objects->objects);
-  for (int i = 0; i < raw_obstacles.contiobs_size(); i++) {
-    ObjectPtr object_ptr = ObjectPtr(new Object());
+
+  // transform the locations and velocities of all the obstacles to the world
+  // frame at once, one column per obstacle
+  const int num_obstacles = raw_obstacles.contiobs_size();
+  Eigen::Matrix<double, 4, Eigen::Dynamic> locations_r(4, num_obstacles);
+  Eigen::Matrix<double, 3, Eigen::Dynamic> velocities_r(3, num_obstacles);
+  for (int i = 0; i < num_obstacles; ++i) {
+    const ContiRadarObs &obstacle = raw_obstacles.contiobs(i);
+    locations_r.col(i) << obstacle.longitude_dist(), obstacle.lateral_dist(),
+        0.0, 1.0;
+    velocities_r.col(i) << obstacle.longitude_vel(), obstacle.lateral_vel(),
+        0.0;
+  }
+  const Eigen::Matrix3d radar_rotation = radar_pose.topLeftCorner(3, 3);
+  const Eigen::Matrix<double, 4, Eigen::Dynamic> locations_w =
+      radar_pose * locations_r;
+  const Eigen::Matrix<double, 3, Eigen::Dynamic> velocities_w =
+      radar_rotation * velocities_r;
+
+  objects->reserve(objects->size() + num_obstacles);
+  for (int i = 0; i < num_obstacles; i++) {
+    ObjectPtr object_ptr = GetPooledObject();
     int obstacle_id = raw_obstacles.contiobs(i).obstacle_id();
     std::map<int, int>::iterator continuous_id_it =
         continuous_ids_.find(obstacle_id);
@@ -54,21 +74,12 @@ void ObjectBuilder::Build(const ContiRadar &raw_obstacles,
       object_ptr->is_background = true;
     }
     object_ptr->track_id = obstacle_id;
-    Eigen::Matrix<double, 4, 1> location_r;
-    Eigen::Matrix<double, 4, 1> location_w;
-    location_r << raw_obstacles.contiobs(i).longitude_dist(),
-        raw_obstacles.contiobs(i).lateral_dist(), 0.0, 1.0;
-    location_w = radar_pose * location_r;
+    const auto location_r = locations_r.col(i);
+    const auto velocity_w = velocities_w.col(i);
     Eigen::Vector3d point;
-    point = location_w.topLeftCorner(3, 1);
+    point = locations_w.col(i).head(3);
     object_ptr->center = point;
     object_ptr->anchor_point = object_ptr->center;
-    Eigen::Matrix<double, 3, 1> velocity_r;
-    Eigen::Matrix<double, 3, 1> velocity_w;
-    velocity_r << raw_obstacles.contiobs(i).longitude_vel(),
-                  raw_obstacles.contiobs(i).lateral_vel(),
-                  0.0;
-    velocity_w = radar_pose.topLeftCorner(3, 3) * velocity_r;
 
     //  calculate the absolute velodity
     object_ptr->velocity(0) = velocity_w[0] + main_velocity(0);
@@ -97,18 +108,18 @@ void ObjectBuilder::Build(const ContiRadar &raw_obstacles,
     dist_rms(1, 1) = raw_obstacles.contiobs(i).lateral_dist_rms();
     vel_rms(0, 0) = raw_obstacles.contiobs(i).longitude_vel_rms();
     vel_rms(1, 1) = raw_obstacles.contiobs(i).lateral_vel_rms();
-    object_ptr->position_uncertainty =
-        radar_pose.topLeftCorner(3, 3) * dist_rms * dist_rms.transpose() *
-        radar_pose.topLeftCorner(3, 3).transpose();
-    object_ptr->velocity_uncertainty =
-        radar_pose.topLeftCorner(3, 3) * vel_rms * vel_rms.transpose() *
-        radar_pose.topLeftCorner(3, 3).transpose();
+    object_ptr->position_uncertainty = radar_rotation * dist_rms *
+                                       dist_rms.transpose() *
+                                       radar_rotation.transpose();
+    object_ptr->velocity_uncertainty = radar_rotation * vel_rms *
+                                       vel_rms.transpose() *
+                                       radar_rotation.transpose();
 
     double local_theta =
         raw_obstacles.contiobs(i).oritation_angle() / 180.0 * M_PI;
     Eigen::Vector3f direction =
         Eigen::Vector3f(cos(local_theta), sin(local_theta), 0);
-    direction = radar_pose.topLeftCorner(3, 3).cast<float>() * direction;
+    direction = radar_rotation.cast<float>() * direction;
     object_ptr->direction = direction.cast<double>();
     //  the avg time diff is from manual
     object_ptr->tracking_time = current_con_ids[obstacle_id] * 0.074;
@@ -42,6 +42,16 @@ RadarTrack::RadarTrack(const Object &obs, const double &timestamp) {
   id_tracked_ = false;
 }
 
+RadarTrack::RadarTrack(ObjectPtr obs, const double &timestamp) {
+  s_current_idx_ %= MAX_RADAR_IDX;
+  obs_id_ = s_current_idx_++;
+  obs_radar_ = obs;
+  timestamp_ = timestamp;
+  tracked_times_ = 1;
+  tracking_time_ = 0.0;
+  id_tracked_ = false;
+}
+
 RadarTrack::RadarTrack(const RadarTrack &track) {
   obs_id_ = track.obs_id_;
   obs_radar_ = track.obs_radar_;
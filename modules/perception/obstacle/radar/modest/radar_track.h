@@ -33,6 +33,9 @@ class RadarTrack {
 
   RadarTrack(const Object &obs, const double &timestamp);
 
+  // shares the observation, which is not modified afterwards
+  RadarTrack(ObjectPtr obs, const double &timestamp);
+
   RadarTrack(const RadarTrack &track);
 
   RadarTrack &operator=(const RadarTrack &track);
@@ -16,6 +16,7 @@
 
 #include "modules/perception/obstacle/radar/modest/radar_track_manager.h"
 
+#include <cmath>
 #include <memory>
 #include <utility>
 
@@ -44,24 +45,49 @@ void RadarTrackManager::AssignTrackObsIdMatch(
     std::vector<std::pair<int, int>> *assignment,
     std::vector<int> *unassigned_track,
     std::vector<int> *unassigned_obs) {
-  assignment->resize(obs_tracks_.size() * 2);
-  int assignment_num = 0;
+  const int num_obs = radar_obs.objects.size();
+  obs_x_.resize(num_obs);
+  obs_y_.resize(num_obs);
+  next_obs_of_id_.resize(num_obs);
+  first_obs_of_id_.clear();
+  // the observations of an id are chained in index order
+  for (int j = num_obs - 1; j >= 0; j--) {
+    const Object &obs = *(radar_obs.objects[j]);
+    obs_x_[j] = obs.center[0];
+    obs_y_[j] = obs.center[1];
+    auto it = first_obs_of_id_.find(obs.track_id);
+    if (it == first_obs_of_id_.end()) {
+      next_obs_of_id_[j] = -1;
+      first_obs_of_id_.emplace(obs.track_id, j);
+    } else {
+      next_obs_of_id_[j] = it->second;
+      it->second = j;
+    }
+  }
+
+  assignment->clear();
+  assignment->reserve(obs_tracks_.size());
   std::vector<bool> track_used(obs_tracks_.size(), false);
-  std::vector<bool> obs_used(radar_obs.objects.size(), false);
+  std::vector<bool> obs_used(num_obs, false);
+  const double timestamp_obs = radar_obs.timestamp;
   for (size_t i = 0; i < obs_tracks_.size(); i++) {
-    std::shared_ptr<Object> obs;
-    obs = obs_tracks_[i].GetObsRadar();
+    const ObjectPtr &obs = obs_tracks_[i].GetObsRadar();
     if (obs == nullptr) {
       continue;
     }
-    double timestamp_track = obs_tracks_[i].GetTimestamp();
-    double timestamp_obs = radar_obs.timestamp;
-    for (size_t j = 0; j < radar_obs.objects.size(); j++) {
-      double distance = DistanceBetweenObs(
-          *obs, timestamp_track, *(radar_obs.objects[j]), timestamp_obs);
-      if (obs->track_id == radar_obs.objects[j]->track_id &&
-          distance < RADAR_TRACK_THRES) {
-        assignment->at(assignment_num++) = std::make_pair(i, j);
+    auto it = first_obs_of_id_.find(obs->track_id);
+    if (it == first_obs_of_id_.end()) {
+      continue;
+    }
+    // the track position predicted at the observation time
+    const double time_diff = timestamp_obs - obs_tracks_[i].GetTimestamp();
+    const double track_x = obs->center[0] + obs->velocity[0] * time_diff;
+    const double track_y = obs->center[1] + obs->velocity[1] * time_diff;
+    for (int j = it->second; j >= 0; j = next_obs_of_id_[j]) {
+      const double distance =
+          std::hypot(obs_x_[j] - track_x, obs_y_[j] - track_y);
+      if (distance < RADAR_TRACK_THRES) {
+        assignment->push_back(std::make_pair(i, j));
         track_used[i] = true;
         obs_used[j] = true;
         obs_tracks_[i].IncreaseTrackedTimes();
@@ -69,7 +95,6 @@ void RadarTrackManager::AssignTrackObsIdMatch(
     }
   }
 
-  assignment->resize(assignment_num);
   unassigned_track->resize(obs_tracks_.size());
   int unassigned_track_num = 0;
   for (size_t i = 0; i < track_used.size(); i++) {
@@ -125,20 +150,10 @@ void RadarTrackManager::DeleteLostTrack() {
 void RadarTrackManager::CreateNewTrack(const SensorObjects &radar_obs,
                                        const std::vector<int>& unassigned_obs) {
   for (size_t i = 0; i < unassigned_obs.size(); i++) {
-    obs_tracks_.push_back(RadarTrack(
-                         *(radar_obs.objects[unassigned_obs[i]]),
-                           radar_obs.timestamp));
+    obs_tracks_.push_back(RadarTrack(radar_obs.objects[unassigned_obs[i]],
+                                     radar_obs.timestamp));
   }
 }
 
-double RadarTrackManager::DistanceBetweenObs(const Object &obs1,
-                                             double timestamp1,
-                                             const Object &obs2,
-                                             double timestamp2) {
-  double time_diff = timestamp2 - timestamp1;
-  return (obs2.center - obs1.center
-          - obs1.velocity * time_diff).head(2).norm();
-}
-
 }  // namespace perception
 }  // namespace apollo
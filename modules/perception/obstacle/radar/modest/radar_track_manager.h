@@ -18,6 +18,7 @@
 #define MODULES_PERCEPTION_OBSTACLE_RADAR_MODEST_RADAR_TRACK_MANAGER_H_
 
 #include <mutex>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -45,7 +46,7 @@ class RadarTrackManager {
   void Update(SensorObjects* radar_obs);
 
   // @brief match observation obstacles to existed tracking states by
-  //            tracking id
+  //            tracking id, gated by a hash of the observation ids
   // @param [out]: assigement index pairs of observations and tracking states
   // @param [out]: indexs of unassigend tracking state
   // @param [out]: indexs of unassigned observation obstacles
@@ -90,10 +91,16 @@ class RadarTrackManager {
   }
 
  private:
-  double DistanceBetweenObs(const Object &obs1, double timestamp1,
-                            const Object &obs2, double timestamp2);
   SensorObjects radar_obs_;
   std::vector<RadarTrack> obs_tracks_;
+
+  // observation positions, as structure of arrays kept across the frames
+  std::vector<double> obs_x_;
+  std::vector<double> obs_y_;
+  // first observation index of a tracking id
+  std::unordered_map<int, int> first_obs_of_id_;
+  // next observation index of the same tracking id, -1 for none
+  std::vector<int> next_obs_of_id_;
 };
 
 }  // namespace perception
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+#include "modules/perception/obstacle/radar/modest/conti_radar_util.h"
+#include "modules/perception/obstacle/radar/modest/radar_track_manager.h"
+
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+namespace apollo {
+namespace perception {
+
+namespace {
+
+ObjectPtr MakeObs(int track_id, double x, double y) {
+  ObjectPtr obs(new Object());
+  obs->track_id = track_id;
+  obs->center = Eigen::Vector3d(x, y, 0.0);
+  obs->velocity = Eigen::Vector3d(10.0, 0.0, 0.0);
+  return obs;
+}
+
+}  // namespace
+
+TEST(RadarTrackManagerTest, AssignTrackObsIdMatch) {
+  RadarTrackManager manager;
+  SensorObjects radar_obs;
+  radar_obs.timestamp = 1.0;
+  radar_obs.objects.push_back(MakeObs(1, 0.0, 0.0));
+  radar_obs.objects.push_back(MakeObs(2, 10.0, 0.0));
+  radar_obs.objects.push_back(MakeObs(3, 20.0, 0.0));
+  manager.Process(radar_obs);
+  ASSERT_EQ(3, manager.GetTracks().size());
+  EXPECT_EQ(radar_obs.objects[0], manager.GetTracks()[0].GetObsRadar());
+
+  // the tracks are predicted 1m ahead: the id 2 is too far, the id 4 is new
+  radar_obs.timestamp = 1.1;
+  radar_obs.objects.clear();
+  radar_obs.objects.push_back(MakeObs(4, 12.0, 0.0));
+  radar_obs.objects.push_back(MakeObs(3, 21.5, 0.0));
+  radar_obs.objects.push_back(MakeObs(2, 14.0, 0.0));
+  radar_obs.objects.push_back(MakeObs(1, 1.0, 0.5));
+  std::vector<std::pair<int, int>> assignment;
+  std::vector<int> unassigned_track;
+  std::vector<int> unassigned_obs;
+  manager.AssignTrackObsIdMatch(radar_obs, &assignment, &unassigned_track,
+                                &unassigned_obs);
+  ASSERT_EQ(2, assignment.size());
+  EXPECT_EQ(std::make_pair(0, 3), assignment[0]);
+  EXPECT_EQ(std::make_pair(2, 1), assignment[1]);
+  ASSERT_EQ(1, unassigned_track.size());
+  EXPECT_EQ(1, unassigned_track[0]);
+  ASSERT_EQ(2, unassigned_obs.size());
+  EXPECT_EQ(0, unassigned_obs[0]);
+  EXPECT_EQ(2, unassigned_obs[1]);
+}
+
+TEST(RadarTrackManagerTest, DuplicatedObsIds) {
+  RadarTrackManager manager;
+  SensorObjects radar_obs;
+  radar_obs.timestamp = 1.0;
+  radar_obs.objects.push_back(MakeObs(1, 0.0, 0.0));
+  manager.Process(radar_obs);
+
+  radar_obs.timestamp = 1.0;
+  radar_obs.objects.clear();
+  radar_obs.objects.push_back(MakeObs(1, 0.5, 0.0));
+  radar_obs.objects.push_back(MakeObs(1, 5.0, 0.0));
+  radar_obs.objects.push_back(MakeObs(1, 0.0, 0.5));
+  std::vector<std::pair<int, int>> assignment;
+  std::vector<int> unassigned_track;
+  std::vector<int> unassigned_obs;
+  manager.AssignTrackObsIdMatch(radar_obs, &assignment, &unassigned_track,
+                                &unassigned_obs);
+  ASSERT_EQ(2, assignment.size());
+  EXPECT_EQ(std::make_pair(0, 0), assignment[0]);
+  EXPECT_EQ(std::make_pair(0, 2), assignment[1]);
+  EXPECT_TRUE(unassigned_track.empty());
+  ASSERT_EQ(1, unassigned_obs.size());
+  EXPECT_EQ(1, unassigned_obs[0]);
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -18,6 +18,7 @@
 #define MODEULES_PERCEPTION_ONBOARD_COMMON_SHARED_DATA_H_
 
 #include <boost/format.hpp>
+#include <functional>
 #include <map>
 #include <memory>
 #include <sstream>
@@ -74,7 +75,7 @@ struct CommonSharedDataStat {
 template <class M>
 class CommonSharedData : public SharedData {
  public:
-  CommonSharedData() {}
+  CommonSharedData() : shards_(1) {}
   virtual ~CommonSharedData() {}
 
   bool Init() override {
@@ -84,6 +85,11 @@ class CommonSharedData : public SharedData {
   // @return: name of your own class
   virtual std::string name() const = 0;
 
+  // @brief: split the data by key into num_shards maps, each guarded by its
+  // own mutex, so that accesses to different keys seldom wait for each
+  // other. must be called before the data is used.
+  bool SetNumShards(int num_shards) override;
+
   // @brief: reset the shared data, clear data
   void Reset() override;
 
@@ -122,13 +128,9 @@ class CommonSharedData : public SharedData {
 
   // @brief: num of data stored in shared data
   // @return: num of data
-  unsigned Size() const {
-    return data_map_.size();
-  }
+  unsigned Size() const;
 
-  CommonSharedDataStat GetStat() const {
-    return stat_;
-  }
+  CommonSharedDataStat GetStat() const;
 
  private:
   typedef std::map<std::string, SharedDataPtr<M>> SharedDataMap;
@@ -137,62 +139,91 @@ class CommonSharedData : public SharedData {
       DataAddedTimeMap;  // precision in second
   typedef std::pair<std::string, uint64_t> DataKeyTimestampPair;
 
-  SharedDataMap data_map_;
-  Mutex mutex_;
-  CommonSharedDataStat stat_;
-  DataAddedTimeMap data_added_time_map_;
+  struct Shard {
+    SharedDataMap data_map;
+    mutable Mutex mutex;
+    CommonSharedDataStat stat;
+    DataAddedTimeMap data_added_time_map;
+  };
+
+  Shard *GetShard(const std::string &key) {
+    if (shards_.size() == 1) {
+      return &shards_[0];
+    }
+    return &shards_[std::hash<std::string>()(key) % shards_.size()];
+  }
+
+  std::vector<Shard> shards_;
 
   DISALLOW_COPY_AND_ASSIGN(CommonSharedData);
 };
 
+template <class M>
+bool CommonSharedData<M>::SetNumShards(int num_shards) {
+  if (num_shards < 1) {
+    AERROR << "invalid num_shards: " << num_shards << " of " << name();
+    return false;
+  }
+  std::vector<Shard>(num_shards).swap(shards_);
+  return true;
+}
+
 template <class M>
 void CommonSharedData<M>::Reset() {
-  MutexLock lock(&mutex_);
-  AINFO << "Reset " << name() << ", map size: " << data_map_.size();
-  data_map_.clear();
-  data_added_time_map_.clear();
+  size_t map_size = 0;
+  for (Shard &shard : shards_) {
+    MutexLock lock(&shard.mutex);
+    map_size += shard.data_map.size();
+    shard.data_map.clear();
+    shard.data_added_time_map.clear();
+  }
+  AINFO << "Reset " << name() << ", map size: " << map_size;
 }
 
 template <class M>
 void CommonSharedData<M>::RemoveStaleData() {
-  MutexLock lock(&mutex_);
   const uint64_t now = ::time(NULL);
   bool has_change = false;
-  for (auto iter = data_added_time_map_.begin();
-       iter != data_added_time_map_.end();) {
-    if (now - iter->second > FLAGS_shared_data_stale_time) {
-      const size_t erase_cnt = data_map_.erase(iter->first);
-      if (erase_cnt != 1u) {
-        AWARN << "_data_map erase cnt:" << erase_cnt << " key:" << iter->first;
-        return;
+  for (Shard &shard : shards_) {
+    MutexLock lock(&shard.mutex);
+    for (auto iter = shard.data_added_time_map.begin();
+         iter != shard.data_added_time_map.end();) {
+      if (now - iter->second > FLAGS_shared_data_stale_time) {
+        const size_t erase_cnt = shard.data_map.erase(iter->first);
+        if (erase_cnt != 1u) {
+          AWARN << "_data_map erase cnt:" << erase_cnt
+                << " key:" << iter->first;
+          return;
+        }
+        iter = shard.data_added_time_map.erase(iter);
+        ++shard.stat.remove_cnt;
+        has_change = true;
+      } else {
+        ++iter;
       }
-      iter = data_added_time_map_.erase(iter);
-      ++stat_.remove_cnt;
-      has_change = true;
-    } else {
-      ++iter;
     }
   }
   if (has_change) {
     AINFO << "SharedData remove_stale_data name:" << name() << " stat:["
-          << stat_.ToString() << "]";
+          << GetStat().ToString() << "]";
   }
 }
 
 template <class M>
 bool CommonSharedData<M>::Add(const std::string &key,
                               const SharedDataPtr<M> &data) {
-  MutexLock lock(&mutex_);
-  auto ret = data_map_.emplace(SharedDataPair(key, data));
+  Shard *shard = GetShard(key);
+  MutexLock lock(&shard->mutex);
+  auto ret = shard->data_map.emplace(SharedDataPair(key, data));
   if (!ret.second) {
     AWARN << "Duplicate key: " << key;
     return false;
   }
 
   const uint64_t timestamp = ::time(NULL);
-  data_added_time_map_.emplace(DataKeyTimestampPair(key, timestamp));
+  shard->data_added_time_map.emplace(DataKeyTimestampPair(key, timestamp));
 
-  ++stat_.add_cnt;
+  ++shard->stat.add_cnt;
   return true;
 }
 
@@ -204,14 +235,15 @@ bool CommonSharedData<M>::Add(const CommonSharedDataKey &key,
 
 template <class M>
 bool CommonSharedData<M>::Get(const std::string &key, SharedDataPtr<M> *data) {
-  MutexLock lock(&mutex_);
-  auto citer = data_map_.find(key);
-  if (citer == data_map_.end()) {
+  Shard *shard = GetShard(key);
+  MutexLock lock(&shard->mutex);
+  auto citer = shard->data_map.find(key);
+  if (citer == shard->data_map.end()) {
     AWARN << "Failed to get shared data. key: " << key;
     return false;
   }
   *data = citer->second;
-  ++stat_.get_cnt;
+  ++shard->stat.get_cnt;
   return true;
 }
 
@@ -223,20 +255,21 @@ bool CommonSharedData<M>::Get(const CommonSharedDataKey &key,
 
 template <class M>
 bool CommonSharedData<M>::Remove(const std::string &key) {
-  MutexLock lock(&mutex_);
-  const size_t num = data_map_.erase(key);
+  Shard *shard = GetShard(key);
+  MutexLock lock(&shard->mutex);
+  const size_t num = shard->data_map.erase(key);
   if (num != 1u) {
     AWARN << "Only one element should be deleted with key: " << key
           << ", but num: " << num;
     return false;
   }
 
-  const size_t erase_cnt = data_added_time_map_.erase(key);
+  const size_t erase_cnt = shard->data_added_time_map.erase(key);
   if (erase_cnt != 1u) {
     AWARN << "_data_added_time_map erase cnt:" << erase_cnt << " key:" << key;
     return false;
   }
-  ++stat_.remove_cnt;
+  ++shard->stat.remove_cnt;
   return true;
 }
 
@@ -247,26 +280,27 @@ bool CommonSharedData<M>::Remove(const CommonSharedDataKey &key) {
 
 template <class M>
 bool CommonSharedData<M>::Pop(const std::string &key, SharedDataPtr<M> *data) {
-  MutexLock lock(&mutex_);
-  auto citer = data_map_.find(key);
-  if (citer == data_map_.end()) {
+  Shard *shard = GetShard(key);
+  MutexLock lock(&shard->mutex);
+  auto citer = shard->data_map.find(key);
+  if (citer == shard->data_map.end()) {
     AWARN << "Failed to get shared data. key: " << key;
     return false;
   }
   *data = citer->second;
-  const size_t num = data_map_.erase(key);
+  const size_t num = shard->data_map.erase(key);
   if (num != 1u) {
     AWARN << "Only one element should be deleted with key: " << key
           << ", but num: " << num;
     return false;
   }
-  const size_t erase_cnt = data_added_time_map_.erase(key);
+  const size_t erase_cnt = shard->data_added_time_map.erase(key);
   if (erase_cnt != 1u) {
     AWARN << "_data_added_time_map erase cnt:" << erase_cnt << " key:" << key;
     return false;
   }
-  ++stat_.get_cnt;
-  ++stat_.remove_cnt;
+  ++shard->stat.get_cnt;
+  ++shard->stat.remove_cnt;
   return true;
 }
 
@@ -276,6 +310,28 @@ bool CommonSharedData<M>::Pop(const CommonSharedDataKey &key,
   return Pop(key.ToString(), data);
 }
 
+template <class M>
+unsigned CommonSharedData<M>::Size() const {
+  unsigned size = 0;
+  for (const Shard &shard : shards_) {
+    MutexLock lock(&shard.mutex);
+    size += shard.data_map.size();
+  }
+  return size;
+}
+
+template <class M>
+CommonSharedDataStat CommonSharedData<M>::GetStat() const {
+  CommonSharedDataStat stat;
+  for (const Shard &shard : shards_) {
+    MutexLock lock(&shard.mutex);
+    stat.add_cnt += shard.stat.add_cnt;
+    stat.remove_cnt += shard.stat.remove_cnt;
+    stat.get_cnt += shard.stat.get_cnt;
+  }
+  return stat;
+}
+
 }  // namespace perception
 }  // namespace apollo
 
@@ -22,6 +22,10 @@
 #include <vector>
 
 #include "modules/common/log.h"
+#include "modules/perception/lib/base/concurrent_queue.h"
+#include "modules/perception/lib/base/lock_free_queue.h"
+#include "modules/perception/lib/base/time_util.h"
+#include "modules/perception/onboard/latency_tracer.h"
 
 namespace apollo {
 namespace perception {
@@ -31,6 +35,78 @@ using std::string;
 
 DEFINE_int32(max_event_queue_size, 1000, "The max size of event queue.");
 
+template <typename Queue>
+class EventManager::EventQueueImpl : public EventManager::EventQueue {
+ public:
+  explicit EventQueueImpl(int max_count) : queue_(max_count) {}
+
+  bool TryPush(const Event &event) override {
+    if (!queue_.try_push(event)) {
+      return false;
+    }
+    OnPush();
+    return true;
+  }
+
+  void Pop(Event *event) override {
+    queue_.pop(event);
+    ++pop_cnt_;
+  }
+
+  bool TryPop(Event *event) override {
+    if (!queue_.try_pop(event)) {
+      return false;
+    }
+    ++pop_cnt_;
+    return true;
+  }
+
+  int Size() override {
+    return queue_.size();
+  }
+
+  int Clear() override {
+    int num_cleared = 0;
+    Event event;
+    while (queue_.try_pop(&event)) {
+      ++num_cleared;
+    }
+    drop_cnt_ += num_cleared;
+    return num_cleared;
+  }
+
+ private:
+  Queue queue_;
+};
+
+EventQueueStat EventManager::EventQueue::GetStat() {
+  EventQueueStat stat;
+  stat.push_cnt = push_cnt_.load();
+  stat.pop_cnt = pop_cnt_.load();
+  stat.drop_cnt = drop_cnt_.load();
+  stat.stale_cnt = stale_cnt_.load();
+  stat.len = Size();
+  stat.max_len = max_len_.load();
+  return stat;
+}
+
+void EventManager::EventQueue::OnPush() {
+  ++push_cnt_;
+  const int len = Size();
+  int max_len = max_len_.load();
+  while (len > max_len && !max_len_.compare_exchange_weak(max_len, len)) {
+  }
+}
+
+bool EventManager::EventQueue::CheckStale(const Event &event) {
+  if (deadline_ <= 0.0 ||
+      TimeUtil::GetCurrentTime() - event.local_timestamp <= deadline_) {
+    return false;
+  }
+  ++stale_cnt_;
+  return true;
+}
+
 bool EventManager::Init(const DAGConfig::EdgeConfig &edge_config) {
   if (inited_) {
     AWARN << "EventManager Init twice.";
@@ -45,8 +121,15 @@ bool EventManager::Init(const DAGConfig::EdgeConfig &edge_config) {
         return false;
       }
 
-      event_queue_map_[event_pb.id()].reset(
-          new EventQueue(FLAGS_max_event_queue_size));
+      if (edge.queue_type() == DAGConfig::LOCK_FREE_QUEUE) {
+        event_queue_map_[event_pb.id()].reset(
+            new EventQueueImpl<LockFreeBoundedQueue<Event>>(
+                FLAGS_max_event_queue_size));
+      } else {
+        event_queue_map_[event_pb.id()].reset(
+            new EventQueueImpl<FixedSizeConQueue<Event>>(
+                FLAGS_max_event_queue_size));
+      }
 
       EventMeta event_meta;
       event_meta.event_id = event_pb.id();
@@ -68,16 +151,24 @@ bool EventManager::Publish(const Event &event) {
     return false;
   }
 
-  if (!queue->try_push(event)) {
+  // the event is only copied to be stamped when the latency is traced
+  const Event *pushed = &event;
+  Event stamped;
+  if (LatencyTracer::Enabled()) {
+    stamped = event;
+    stamped.publish_timestamp = TimeUtil::GetCurrentTime();
+    pushed = &stamped;
+  }
+  if (!queue->TryPush(*pushed)) {
     // Critical errors: queue is full.
     AERROR << "EventQueue is FULL. id: " << event.event_id;
     // Clear all blocked data.
+    const int num_cleared = queue->Clear();
     AERROR << "clear EventQueue. id: " << event.event_id
-           << " size: " << queue->size();
-    queue->clear();
+           << " size: " << num_cleared;
 
     // try second time.
-    queue->try_push(event);
+    queue->TryPush(*pushed);
   }
 
   return true;
@@ -89,15 +180,42 @@ bool EventManager::Subscribe(EventID event_id, Event *event, bool nonblocking) {
     return false;
   }
 
-  if (nonblocking) {
-    return queue->try_pop(event);
+  while (true) {
+    if (nonblocking) {
+      if (!queue->TryPop(event)) {
+        return false;
+      }
+    } else {
+      ADEBUG << "EVENT_ID: " << event_id << "QUEUE LENGTH:" << queue->Size();
+      queue->Pop(event);
+    }
+    if (!queue->CheckStale(*event)) {
+      break;
+    }
+    // drop the stale event at the head of the queue and take the next one
+    AWARN_EVERY(100) << "drop stale event: <" << event->to_string() << ">";
+  }
+  if (LatencyTracer::Enabled()) {
+    TraceQueueLatency(*event);
   }
-
-  ADEBUG << "EVENT_ID: " << event_id << "QUEUE LENGTH:" << queue->size();
-  queue->pop(event);
   return true;
 }
 
+void EventManager::TraceQueueLatency(const Event &event) const {
+  if (event.publish_timestamp <= 0.0) {
+    // published before the trace was enabled
+    return;
+  }
+  EventMetaMapConstIterator citer = event_meta_map_.find(event.event_id);
+  const string stage =
+      "queue:" + (citer == event_meta_map_.end() || citer->second.name.empty()
+                      ? std::to_string(event.event_id)
+                      : citer->second.name);
+  LatencyTracer::instance()->Record(stage, event.timestamp,
+                                    event.publish_timestamp,
+                                    TimeUtil::GetCurrentTime());
+}
+
 bool EventManager::Subscribe(EventID event_id, Event *event) {
   return Subscribe(event_id, event, false);
 }
@@ -160,6 +278,26 @@ bool EventManager::GetEventMeta(const vector<EventID> &event_ids,
   return true;
 }
 
+bool EventManager::GetEventQueueStat(EventID event_id,
+                                     EventQueueStat *stat) const {
+  EventQueueMapConstIterator citer = event_queue_map_.find(event_id);
+  if (citer == event_queue_map_.end()) {
+    AWARN << "event not found in EventManager. id: " << event_id;
+    return false;
+  }
+  *stat = citer->second->GetStat();
+  return true;
+}
+
+bool EventManager::SetEventDeadline(EventID event_id, double deadline) {
+  EventQueue *queue = NULL;
+  if (!GetEventQueue(event_id, &queue)) {
+    return false;
+  }
+  queue->set_deadline(deadline);
+  return true;
+}
+
 int EventManager::AvgLenOfEventQueues() const {
   if (event_queue_map_.empty()) {
     return 0;
@@ -167,7 +305,7 @@ int EventManager::AvgLenOfEventQueues() const {
 
   int total_length = 0;
   for (const auto &event : event_queue_map_) {
-    total_length += event.second->size();
+    total_length += event.second->Size();
   }
   return total_length / event_queue_map_.size();
 }
@@ -175,7 +313,7 @@ int EventManager::AvgLenOfEventQueues() const {
 int EventManager::MaxLenOfEventQueues() const {
   int max_length = 0;
   for (const auto &event : event_queue_map_) {
-    max_length = std::max(max_length, event.second->size());
+    max_length = std::max(max_length, event.second->Size());
   }
   return max_length;
 }
@@ -183,7 +321,7 @@ int EventManager::MaxLenOfEventQueues() const {
 void EventManager::Reset() {
   EventQueueMapIterator iter = event_queue_map_.begin();
   for (; iter != event_queue_map_.end(); ++iter) {
-    iter->second->clear();
+    iter->second->Clear();
   }
 }
 
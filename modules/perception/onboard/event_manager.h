@@ -17,6 +17,7 @@
 #ifndef MODEULES_PERCEPTION_ONBOARD_EVENT_MANAGER_H_
 #define MODEULES_PERCEPTION_ONBOARD_EVENT_MANAGER_H_
 
+#include <atomic>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -30,6 +31,26 @@
 namespace apollo {
 namespace perception {
 
+// Counters of the queue of an event, updated at every publish and subscribe.
+struct EventQueueStat {
+  std::string ToString() const {
+    std::ostringstream oss;
+    oss << "push_cnt:" << push_cnt << " pop_cnt:" << pop_cnt
+        << " drop_cnt:" << drop_cnt << " stale_cnt:" << stale_cnt
+        << " len:" << len << " max_len:" << max_len;
+    return oss.str();
+  }
+
+  uint64_t push_cnt = 0;
+  uint64_t pop_cnt = 0;
+  // events cleared because the queue was full
+  uint64_t drop_cnt = 0;
+  // popped events dropped because they missed the deadline of the queue
+  uint64_t stale_cnt = 0;
+  int len = 0;
+  int max_len = 0;
+};
+
 class EventManager {
  public:
   EventManager() = default;
@@ -64,12 +85,58 @@ class EventManager {
   bool GetEventMeta(const std::vector<EventID> &event_id,
                     std::vector<std::string> *str_list) const;
 
+  // @brief get the counters of the queue of an event, thread-safe.
+  bool GetEventQueueStat(EventID event_id, EventQueueStat *stat) const;
+
+  // @brief the subscribers of the event drop the events older than the
+  //        deadline, in seconds since their local_timestamp, instead of
+  //        returning them. 0 disables it. not thread-safe.
+  bool SetEventDeadline(EventID event_id, double deadline);
+
   int NumEvents() const {
     return event_queue_map_.size();
   }
 
  private:
-  using EventQueue = FixedSizeConQueue<Event>;
+  // The queue of an event, a FixedSizeConQueue or a LockFreeBoundedQueue as
+  // the queue_type of its edge in the DAGConfig says.
+  class EventQueue {
+   public:
+    EventQueue() = default;
+    virtual ~EventQueue() = default;
+
+    virtual bool TryPush(const Event &event) = 0;
+    virtual void Pop(Event *event) = 0;
+    virtual bool TryPop(Event *event) = 0;
+    virtual int Size() = 0;
+    // @brief clear the queue and return the number of events cleared
+    virtual int Clear() = 0;
+
+    EventQueueStat GetStat();
+
+    void set_deadline(double deadline) {
+      deadline_ = deadline;
+    }
+
+    // @brief count the event as stale if it missed the deadline.
+    bool CheckStale(const Event &event);
+
+   protected:
+    void OnPush();
+
+    std::atomic<uint64_t> push_cnt_{0};
+    std::atomic<uint64_t> pop_cnt_{0};
+    std::atomic<uint64_t> drop_cnt_{0};
+    std::atomic<uint64_t> stale_cnt_{0};
+    std::atomic<int> max_len_{0};
+    double deadline_ = 0.0;
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(EventQueue);
+  };
+  template <typename Queue>
+  class EventQueueImpl;
+
   using EventQueueMap =
       std::unordered_map<EventID, std::unique_ptr<EventQueue>>;
   using EventQueueMapIterator = EventQueueMap::iterator;
@@ -80,6 +147,9 @@ class EventManager {
 
   bool GetEventQueue(EventID event_id, EventQueue **queue);
 
+  // @brief record the wait of the event in its queue to the LatencyTracer.
+  void TraceQueueLatency(const Event &event) const;
+
   EventQueueMap event_queue_map_;
   // for debug.
   EventMetaMap event_meta_map_;
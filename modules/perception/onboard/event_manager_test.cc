@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/onboard/event_manager.h"
+
+#include <gtest/gtest.h>
+
+#include <google/protobuf/text_format.h>
+
+#include <thread>
+
+#include "gflags/gflags.h"
+
+#include "modules/perception/onboard/proto/dag_config.pb.h"
+
+namespace apollo {
+namespace perception {
+
+using google::protobuf::TextFormat;
+
+DECLARE_int32(max_event_queue_size);
+
+class EventManagerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_max_event_queue_size = 4;
+    const char *config =
+        "edges { id: 101 from_node: 1 to_node: 2 events { id: 1001 } } "
+        "edges { id: 102 from_node: 1 to_node: 2 queue_type: LOCK_FREE_QUEUE "
+        "events { id: 1002 } }";
+    ASSERT_TRUE(TextFormat::ParseFromString(config, &edge_config_));
+    ASSERT_TRUE(event_manager_.Init(edge_config_));
+  }
+
+  DAGConfig::EdgeConfig edge_config_;
+  EventManager event_manager_;
+};
+
+TEST_F(EventManagerTest, PublishSubscribe) {
+  EXPECT_EQ(2, event_manager_.NumEvents());
+  for (EventID event_id : {1001, 1002}) {
+    Event event;
+    EXPECT_FALSE(event_manager_.Subscribe(event_id, &event, true));
+    // the full queue is cleared before the fifth event is pushed
+    for (int i = 0; i < 6; ++i) {
+      event.event_id = event_id;
+      event.timestamp = i;
+      ASSERT_TRUE(event_manager_.Publish(event));
+    }
+    EXPECT_EQ(2, event_manager_.MaxLenOfEventQueues());
+
+    Event subscribed;
+    ASSERT_TRUE(event_manager_.Subscribe(event_id, &subscribed));
+    EXPECT_EQ(event_id, subscribed.event_id);
+    EXPECT_DOUBLE_EQ(4.0, subscribed.timestamp);
+
+    EventQueueStat stat;
+    ASSERT_TRUE(event_manager_.GetEventQueueStat(event_id, &stat));
+    EXPECT_EQ(6u, stat.push_cnt);
+    EXPECT_EQ(1u, stat.pop_cnt);
+    EXPECT_EQ(4u, stat.drop_cnt);
+    EXPECT_EQ(1, stat.len);
+    EXPECT_EQ(4, stat.max_len);
+  }
+  EventQueueStat stat;
+  EXPECT_FALSE(event_manager_.GetEventQueueStat(1003, &stat));
+}
+
+TEST_F(EventManagerTest, StaleEvents) {
+  EXPECT_FALSE(event_manager_.SetEventDeadline(1003, 0.1));
+  for (EventID event_id : {1001, 1002}) {
+    ASSERT_TRUE(event_manager_.SetEventDeadline(event_id, 0.1));
+    Event event;
+    event.event_id = event_id;
+    event.timestamp = 1.0;
+    event.local_timestamp -= 1.0;
+    ASSERT_TRUE(event_manager_.Publish(event));
+    event.timestamp = 2.0;
+    ASSERT_TRUE(event_manager_.Publish(event));
+    event.timestamp = 3.0;
+    event.local_timestamp += 1.0;
+    ASSERT_TRUE(event_manager_.Publish(event));
+
+    // the two stale events at the head of the queue are dropped
+    Event subscribed;
+    ASSERT_TRUE(event_manager_.Subscribe(event_id, &subscribed));
+    EXPECT_DOUBLE_EQ(3.0, subscribed.timestamp);
+    EventQueueStat stat;
+    ASSERT_TRUE(event_manager_.GetEventQueueStat(event_id, &stat));
+    EXPECT_EQ(3u, stat.pop_cnt);
+    EXPECT_EQ(2u, stat.stale_cnt);
+
+    event.local_timestamp -= 1.0;
+    ASSERT_TRUE(event_manager_.Publish(event));
+    EXPECT_FALSE(event_manager_.Subscribe(event_id, &subscribed, true));
+    ASSERT_TRUE(event_manager_.GetEventQueueStat(event_id, &stat));
+    EXPECT_EQ(3u, stat.stale_cnt);
+    EXPECT_EQ(0, stat.len);
+  }
+}
+
+TEST_F(EventManagerTest, BlockingSubscribe) {
+  for (EventID event_id : {1001, 1002}) {
+    std::thread subscriber([this, event_id]() {
+      for (int i = 0; i < 100; ++i) {
+        Event event;
+        ASSERT_TRUE(event_manager_.Subscribe(event_id, &event));
+        EXPECT_DOUBLE_EQ(i, event.timestamp);
+      }
+    });
+    for (int i = 0; i < 100; ++i) {
+      Event event;
+      event.event_id = event_id;
+      event.timestamp = i;
+      // the subscriber keeps up, so no event is dropped
+      while (event_manager_.MaxLenOfEventQueues() >= 4) {
+        std::this_thread::yield();
+      }
+      ASSERT_TRUE(event_manager_.Publish(event));
+    }
+    subscriber.join();
+  }
+}
+
+}  // namespace perception
+}  // namespace apollo
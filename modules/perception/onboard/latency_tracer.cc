@@ -0,0 +1,219 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/onboard/latency_tracer.h"
+
+#include <algorithm>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#include "modules/common/log.h"
+#include "modules/perception/lib/base/time_util.h"
+
+namespace apollo {
+namespace perception {
+
+using std::string;
+using std::vector;
+
+DEFINE_bool(enable_latency_trace, false,
+            "trace the latencies of the stages of the perception frames");
+DEFINE_string(latency_trace_file, "",
+              "the Chrome trace file the spans of the stages are written to, "
+              "empty to only log the percentiles");
+DEFINE_int32(latency_trace_window, 200,
+             "the number of last frames the latency percentiles cover");
+DEFINE_int32(latency_trace_report_interval, 100,
+             "log the latency percentiles of a stage every this number of "
+             "its frames, 0 to never log them");
+
+namespace {
+
+// the spans are written to the trace file by chunks of this size
+const size_t kTraceBufferSize = 64 * 1024;
+
+LatencyPercentiles ComputePercentiles(vector<double> latencies) {
+  LatencyPercentiles percentiles;
+  if (latencies.empty()) {
+    return percentiles;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  const size_t last = latencies.size() - 1;
+  percentiles.p50 = latencies[last * 50 / 100];
+  percentiles.p90 = latencies[last * 90 / 100];
+  percentiles.p99 = latencies[last * 99 / 100];
+  percentiles.max = latencies[last];
+  return percentiles;
+}
+
+void PushLatency(double latency, uint64_t count, vector<double> *ring) {
+  const size_t window =
+      static_cast<size_t>(std::max(FLAGS_latency_trace_window, 1));
+  if (ring->size() < window) {
+    ring->push_back(latency);
+  } else {
+    (*ring)[count % window] = latency;
+  }
+}
+
+}  // namespace
+
+string StageLatencyStat::ToString() const {
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(2) << "count:" << count
+      << " duration_ms[p50:" << duration.p50 << " p90:" << duration.p90
+      << " p99:" << duration.p99 << " max:" << duration.max << "]"
+      << " since_sensor_ms[p50:" << since_sensor.p50
+      << " p90:" << since_sensor.p90 << " p99:" << since_sensor.p99
+      << " max:" << since_sensor.max << "]";
+  return oss.str();
+}
+
+LatencyTracer::LatencyTracer() {}
+
+LatencyTracer::~LatencyTracer() {
+  MutexLock lock(&mutex_);
+  CloseLocked();
+}
+
+void LatencyTracer::Record(const string &stage, double sensor_timestamp,
+                           double begin, double end) {
+  const double duration = (end - begin) * 1e3;
+  const double since_sensor = (end - sensor_timestamp) * 1e3;
+  bool report = false;
+  StageLatencyStat stat;
+  {
+    MutexLock lock(&mutex_);
+    StageState &state = stages_[stage];
+    PushLatency(duration, state.count, &state.durations);
+    PushLatency(since_sensor, state.count, &state.since_sensors);
+    ++state.count;
+    AppendTraceEvent(stage, sensor_timestamp, begin, end);
+    report = FLAGS_latency_trace_report_interval > 0 &&
+             state.count % FLAGS_latency_trace_report_interval == 0;
+    if (report) {
+      GetStat(state, &stat);
+    }
+  }
+  if (report) {
+    AINFO << "LATENCY_STATISTICS:" << stage << ":" << stat.ToString();
+  }
+}
+
+bool LatencyTracer::GetStat(const string &stage,
+                            StageLatencyStat *stat) const {
+  MutexLock lock(&mutex_);
+  const auto iter = stages_.find(stage);
+  if (iter == stages_.end()) {
+    return false;
+  }
+  GetStat(iter->second, stat);
+  return true;
+}
+
+void LatencyTracer::GetStat(const StageState &state,
+                            StageLatencyStat *stat) const {
+  stat->count = state.count;
+  stat->duration = ComputePercentiles(state.durations);
+  stat->since_sensor = ComputePercentiles(state.since_sensors);
+}
+
+void LatencyTracer::Flush() {
+  MutexLock lock(&mutex_);
+  FlushLocked();
+}
+
+void LatencyTracer::Reset() {
+  MutexLock lock(&mutex_);
+  CloseLocked();
+  stages_.clear();
+  trace_file_failed_ = false;
+}
+
+void LatencyTracer::AppendTraceEvent(const string &stage,
+                                     double sensor_timestamp, double begin,
+                                     double end) {
+  if (FLAGS_latency_trace_file.empty() || trace_file_failed_) {
+    return;
+  }
+  // a complete event of the Chrome trace format, in us
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(3)
+      << (first_trace_event_ ? "[\n" : ",\n") << "{\"name\":\"" << stage
+      << "\",\"cat\":\"perception\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+      << std::hash<std::thread::id>()(std::this_thread::get_id()) % 100000
+      << ",\"ts\":" << begin * 1e6 << ",\"dur\":" << (end - begin) * 1e6
+      << ",\"args\":{\"sensor_timestamp\":" << std::setprecision(6)
+      << sensor_timestamp << "}}";
+  first_trace_event_ = false;
+  trace_buffer_ += oss.str();
+  if (trace_buffer_.size() >= kTraceBufferSize) {
+    FlushLocked();
+  }
+}
+
+void LatencyTracer::FlushLocked() {
+  if (trace_buffer_.empty()) {
+    return;
+  }
+  if (trace_file_ == nullptr) {
+    trace_file_ = fopen(FLAGS_latency_trace_file.c_str(), "w");
+    if (trace_file_ == nullptr) {
+      AERROR << "failed to open latency trace file: "
+             << FLAGS_latency_trace_file;
+      trace_file_failed_ = true;
+      trace_buffer_.clear();
+      return;
+    }
+  }
+  fwrite(trace_buffer_.data(), 1, trace_buffer_.size(), trace_file_);
+  fflush(trace_file_);
+  trace_buffer_.clear();
+}
+
+void LatencyTracer::CloseLocked() {
+  if (!first_trace_event_) {
+    trace_buffer_ += "\n]\n";
+    FlushLocked();
+  }
+  if (trace_file_ != nullptr) {
+    fclose(trace_file_);
+    trace_file_ = nullptr;
+  }
+  trace_buffer_.clear();
+  first_trace_event_ = true;
+}
+
+LatencyTraceFrame::LatencyTraceFrame(double sensor_timestamp)
+    : enabled_(LatencyTracer::Enabled()), sensor_timestamp_(sensor_timestamp) {
+  if (enabled_) {
+    begin_ = TimeUtil::GetCurrentTime();
+  }
+}
+
+void LatencyTraceFrame::Mark(const char *stage) {
+  if (!enabled_) {
+    return;
+  }
+  const double end = TimeUtil::GetCurrentTime();
+  LatencyTracer::instance()->Record(stage, sensor_timestamp_, begin_, end);
+  begin_ = end;
+}
+
+}  // namespace perception
+}  // namespace apollo
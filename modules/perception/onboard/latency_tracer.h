@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODEULES_PERCEPTION_ONBOARD_LATENCY_TRACER_H_
+#define MODEULES_PERCEPTION_ONBOARD_LATENCY_TRACER_H_
+
+#include <stdio.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/macro.h"
+#include "modules/perception/lib/base/mutex.h"
+
+namespace apollo {
+namespace perception {
+
+DECLARE_bool(enable_latency_trace);
+
+// Percentiles of the latencies of the last frames of a stage, in ms.
+struct LatencyPercentiles {
+  double p50 = 0.0;
+  double p90 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+};
+
+struct StageLatencyStat {
+  std::string ToString() const;
+
+  // frames recorded since the start, the percentiles only cover the last
+  // FLAGS_latency_trace_window ones
+  uint64_t count = 0;
+  // from the begin to the end of the stage
+  LatencyPercentiles duration;
+  // from the sensor timestamp of the frame to the end of the stage
+  LatencyPercentiles since_sensor;
+};
+
+// Records the spans of the stages every frame goes through in the DAG, the
+// waits in the event queues and the runs of the algorithms, when
+// FLAGS_enable_latency_trace is set. The spans are appended to
+// FLAGS_latency_trace_file in the Chrome trace format (load it in
+// chrome://tracing), and the rolling percentiles of every stage are logged
+// every FLAGS_latency_trace_report_interval frames of the stage.
+// thread-safe.
+class LatencyTracer {
+ public:
+  ~LatencyTracer();
+
+  static bool Enabled() {
+    return FLAGS_enable_latency_trace;
+  }
+
+  // @brief record the span of a stage of the frame of the sensor timestamp,
+  //        all the times are unix times in seconds.
+  void Record(const std::string &stage, double sensor_timestamp, double begin,
+              double end);
+
+  bool GetStat(const std::string &stage, StageLatencyStat *stat) const;
+
+  // @brief write the buffered spans to the trace file.
+  void Flush();
+
+  // @brief close the trace file and clear the statistics, the next span
+  //        starts a new trace file.
+  void Reset();
+
+ private:
+  struct StageState {
+    uint64_t count = 0;
+    // rings of the last latencies, in ms
+    std::vector<double> durations;
+    std::vector<double> since_sensors;
+  };
+
+  void GetStat(const StageState &state, StageLatencyStat *stat) const;
+  void AppendTraceEvent(const std::string &stage, double sensor_timestamp,
+                        double begin, double end);
+  void FlushLocked();
+  void CloseLocked();
+
+  mutable Mutex mutex_;
+  std::map<std::string, StageState> stages_;
+  FILE *trace_file_ = nullptr;
+  bool trace_file_failed_ = false;
+  std::string trace_buffer_;
+  bool first_trace_event_ = true;
+
+  DECLARE_SINGLETON(LatencyTracer);
+};
+
+// Records the consecutive stages of a frame in a subnode, each Mark() ends
+// the stage begun by the previous one or by the construction. Does nothing
+// when the trace is disabled.
+class LatencyTraceFrame {
+ public:
+  explicit LatencyTraceFrame(double sensor_timestamp);
+
+  void Mark(const char *stage);
+
+ private:
+  const bool enabled_;
+  const double sensor_timestamp_;
+  double begin_ = 0.0;
+
+  DISALLOW_COPY_AND_ASSIGN(LatencyTraceFrame);
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODEULES_PERCEPTION_ONBOARD_LATENCY_TRACER_H_
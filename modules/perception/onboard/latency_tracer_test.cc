@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/onboard/latency_tracer.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gflags/gflags.h"
+
+#include "modules/perception/onboard/event_manager.h"
+#include "modules/perception/onboard/proto/dag_config.pb.h"
+
+namespace apollo {
+namespace perception {
+
+DECLARE_string(latency_trace_file);
+DECLARE_int32(latency_trace_window);
+DECLARE_int32(latency_trace_report_interval);
+
+class LatencyTracerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_enable_latency_trace = true;
+    FLAGS_latency_trace_file = "";
+    FLAGS_latency_trace_window = 100;
+    FLAGS_latency_trace_report_interval = 0;
+    tracer_ = LatencyTracer::instance();
+    tracer_->Reset();
+  }
+
+  void TearDown() override {
+    tracer_->Reset();
+    FLAGS_enable_latency_trace = false;
+    FLAGS_latency_trace_file = "";
+  }
+
+  LatencyTracer *tracer_ = nullptr;
+};
+
+TEST_F(LatencyTracerTest, Percentiles) {
+  StageLatencyStat stat;
+  EXPECT_FALSE(tracer_->GetStat("stage", &stat));
+  // the first 100 spans are pushed out of the window by the last 100 ones
+  for (int i = 1; i <= 200; ++i) {
+    const double begin = 10.0 + i;
+    const double duration = (i > 100 ? i - 100 : 1000) * 1e-3;
+    tracer_->Record("stage", begin - 0.1, begin, begin + duration);
+  }
+  ASSERT_TRUE(tracer_->GetStat("stage", &stat));
+  EXPECT_EQ(200u, stat.count);
+  EXPECT_NEAR(50.0, stat.duration.p50, 1e-6);
+  EXPECT_NEAR(90.0, stat.duration.p90, 1e-6);
+  EXPECT_NEAR(99.0, stat.duration.p99, 1e-6);
+  EXPECT_NEAR(100.0, stat.duration.max, 1e-6);
+  EXPECT_NEAR(150.0, stat.since_sensor.p50, 1e-6);
+  EXPECT_NEAR(200.0, stat.since_sensor.max, 1e-6);
+  EXPECT_FALSE(tracer_->GetStat("other_stage", &stat));
+}
+
+TEST_F(LatencyTracerTest, TraceFile) {
+  const std::string trace_file = "./latency_tracer_test.json";
+  FLAGS_latency_trace_file = trace_file;
+  LatencyTraceFrame trace(1.0);
+  trace.Mark("first_stage");
+  trace.Mark("second_stage");
+  tracer_->Record("third_stage", 1.0, 2.0, 2.5);
+  tracer_->Reset();
+
+  std::ifstream fin(trace_file);
+  ASSERT_TRUE(fin.is_open());
+  std::stringstream ss;
+  ss << fin.rdbuf();
+  const std::string trace_str = ss.str();
+  ASSERT_FALSE(trace_str.empty());
+  EXPECT_EQ('[', trace_str.front());
+  EXPECT_EQ("]\n", trace_str.substr(trace_str.size() - 2));
+  EXPECT_NE(std::string::npos, trace_str.find("\"name\":\"first_stage\""));
+  EXPECT_NE(std::string::npos, trace_str.find("\"name\":\"second_stage\""));
+  EXPECT_NE(std::string::npos,
+            trace_str.find("\"ts\":2000000.000,\"dur\":500000.000"));
+  std::remove(trace_file.c_str());
+}
+
+TEST_F(LatencyTracerTest, Disabled) {
+  FLAGS_enable_latency_trace = false;
+  LatencyTraceFrame trace(1.0);
+  trace.Mark("stage");
+  StageLatencyStat stat;
+  EXPECT_FALSE(tracer_->GetStat("stage", &stat));
+}
+
+TEST_F(LatencyTracerTest, EventQueue) {
+  DAGConfig::EdgeConfig edge_config;
+  DAGConfig::Edge *edge = edge_config.add_edges();
+  edge->set_id(101);
+  edge->set_from_node(1);
+  edge->set_to_node(2);
+  DAGConfig::Event *event_pb = edge->add_events();
+  event_pb->set_id(1001);
+  event_pb->set_name("lidar_fusion");
+  EventManager event_manager;
+  ASSERT_TRUE(event_manager.Init(edge_config));
+
+  Event event;
+  event.event_id = 1001;
+  event.timestamp = 1.0;
+  ASSERT_TRUE(event_manager.Publish(event));
+  Event subscribed;
+  ASSERT_TRUE(event_manager.Subscribe(1001, &subscribed));
+  EXPECT_GT(subscribed.publish_timestamp, 0.0);
+  StageLatencyStat stat;
+  ASSERT_TRUE(tracer_->GetStat("queue:lidar_fusion", &stat));
+  EXPECT_EQ(1u, stat.count);
+  EXPECT_GE(stat.duration.max, 0.0);
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -33,6 +33,13 @@ class SharedData {
 
   virtual bool Init() = 0;
 
+  // @brief: set the number of shards the data is split into, each guarded
+  // by its own lock. called by SharedDataManager before Init(), with the
+  // num_shards of the DAGConfig. unsharded data only accepts one shard.
+  virtual bool SetNumShards(int num_shards) {
+    return num_shards == 1;
+  }
+
   // this api should clear all the memory used,
   // and would be called by SharedDataManager when reset DAGStreaming.
   virtual void Reset() {
@@ -38,6 +38,11 @@ bool SharedDataManager::Init(const DAGConfig::SharedDataConfig &data_config) {
       AERROR << "failed to get SharedData instance: " << proto.name();
       return false;
     }
+    if (!shared_data->SetNumShards(proto.num_shards())) {
+      AERROR << "failed to set num_shards of SharedData. name: "
+             << proto.name() << " num_shards: " << proto.num_shards();
+      return false;
+    }
     if (!shared_data->Init()) {
       AERROR << "failed to Init SharedData. name: " << proto.name();
       return false;
@@ -20,6 +20,7 @@
 #include <string>
 #include <vector>
 
+#include "modules/common/alloc_tracker/alloc_tracker.h"
 #include "modules/common/log.h"
 #include "modules/perception/onboard/event_manager.h"
 
@@ -38,11 +39,18 @@ bool Subnode::Init(const DAGConfig::Subnode &subnode_config,
                    const vector<EventID> &sub_events,
                    const vector<EventID> &pub_events) {
   name_ = subnode_config.name();
+  set_thread_name(name_);
   id_ = subnode_config.id();
   reserve_ = subnode_config.reserve();
   if (subnode_config.has_type()) {
     type_ = subnode_config.type();
   }
+  sched_priority_ = subnode_config.thread_priority();
+  cpu_affinity_.assign(subnode_config.cpu_affinity().begin(),
+                       subnode_config.cpu_affinity().end());
+  if (type_ != DAGConfig::SUBNODE_IN) {
+    ApplySchedConfig(this);
+  }
 
   CHECK(event_manager != NULL) << "event_manager == NULL";
   event_manager_ = event_manager;
@@ -62,6 +70,10 @@ bool Subnode::Init(const DAGConfig::Subnode &subnode_config,
     return false;
   }
 
+  for (EventID event_id : sub_events) {
+    event_manager_->SetEventDeadline(event_id, subnode_config.event_deadline());
+  }
+
   if (!InitInternal()) {
     AERROR << "failed to Init inner members.";
     return false;
@@ -84,7 +96,11 @@ void Subnode::Run() {
   }
 
   while (!stop_) {
-    Status status = ProcEvents();
+    Status status = Status::OK();
+    {
+      common::alloc_tracker::ScopedAllocRegion alloc_region(name_);
+      status = ProcEvents();
+    }
     ++total_count_;
     if (status.code() == ErrorCode::PERCEPTION_ERROR) {
       ++failed_count_;
@@ -104,6 +120,11 @@ void Subnode::Run() {
   }
 }
 
+void Subnode::ApplySchedConfig(Thread *thread) const {
+  thread->set_sched_priority(sched_priority_);
+  thread->set_cpu_affinity(cpu_affinity_);
+}
+
 string Subnode::DebugString() const {
   ostringstream oss;
   oss << "{id: " << id_ << ", name: " << name_ << ", reserve: " << reserve_
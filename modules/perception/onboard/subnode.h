@@ -99,6 +99,12 @@ class Subnode : public Thread {
   // @brief inner run
   void Run() override;
 
+  // @brief give the thread the priority and the cpu affinity of the subnode
+  //        in the DAGConfig, for the threads a derived subnode starts itself.
+  //        It is applied to the thread of the subnode unless it is a
+  //        SUBNODE_IN, whose thread exits at once.
+  void ApplySchedConfig(Thread *thread) const;
+
   // following variable can be accessed by Derived Class.
   SubnodeID id_;
   std::string name_;
@@ -113,6 +119,8 @@ class Subnode : public Thread {
  private:
   volatile bool stop_;
   bool inited_;
+  int sched_priority_ = 0;
+  std::vector<int> cpu_affinity_;
   int total_count_;
   int failed_count_;
   DISALLOW_COPY_AND_ASSIGN(Subnode);
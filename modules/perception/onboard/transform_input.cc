@@ -26,10 +26,18 @@
 namespace apollo {
 namespace perception {
 
-bool GetVelodyneTrans(const double query_time, Eigen::Matrix4d* trans) {
-  if (!trans) {
-    AERROR << "failed to get trans, the trans ptr can not be NULL";
-    return false;
+namespace {
+
+// Looks the transform up in the transform cache, which takes no lock, then
+// in the tf2 buffer, which waits for --tf2_buff_in_ms at most.
+bool GetTrans(const double query_time, const std::string& frame_id,
+              const std::string& child_frame_id, Eigen::Matrix4d* trans) {
+  const auto& tf2_cache = common::adapter::AdapterManager::Tf2Cache();
+  Eigen::Affine3d affine_3d;
+  if (tf2_cache.LookupTransform(frame_id, child_frame_id, query_time,
+                                &affine_3d)) {
+    *trans = affine_3d.matrix();
+    return true;
   }
 
   ros::Time query_stamp(query_time);
@@ -37,52 +45,53 @@ bool GetVelodyneTrans(const double query_time, Eigen::Matrix4d* trans) {
 
   const double kTf2BuffSize = FLAGS_tf2_buff_in_ms / 1000.0;
   std::string err_msg;
-  if (!tf2_buffer.canTransform(FLAGS_lidar_tf2_frame_id,
-                               FLAGS_lidar_tf2_child_frame_id, query_stamp,
+  if (!tf2_buffer.canTransform(frame_id, child_frame_id, query_stamp,
                                ros::Duration(kTf2BuffSize), &err_msg)) {
-    AERROR << "Cannot transform frame: " << FLAGS_lidar_tf2_frame_id
-           << " to frame " << FLAGS_lidar_tf2_child_frame_id
-           << " , err: " << err_msg
+    AERROR << "Cannot transform frame: " << frame_id << " to frame "
+           << child_frame_id << " , err: " << err_msg
            << ". Frames: " << tf2_buffer.allFramesAsString();
     return false;
   }
 
   geometry_msgs::TransformStamped transform_stamped;
   try {
-    transform_stamped = tf2_buffer.lookupTransform(
-        FLAGS_lidar_tf2_frame_id, FLAGS_lidar_tf2_child_frame_id, query_stamp);
+    transform_stamped =
+        tf2_buffer.lookupTransform(frame_id, child_frame_id, query_stamp);
   } catch (tf2::TransformException& ex) {
     AERROR << "Exception: " << ex.what();
     return false;
   }
-  Eigen::Affine3d affine_lidar_3d;
-  tf::transformMsgToEigen(transform_stamped.transform, affine_lidar_3d);
-  Eigen::Matrix4d lidar2novatel_trans = affine_lidar_3d.matrix();
-  ADEBUG << "get " << FLAGS_lidar_tf2_frame_id << " to "
-         << FLAGS_lidar_tf2_child_frame_id << " trans: " << lidar2novatel_trans;
+  tf::transformMsgToEigen(transform_stamped.transform, affine_3d);
+  *trans = affine_3d.matrix();
+  return true;
+}
 
+}  // namespace
 
-  if (!tf2_buffer.canTransform(FLAGS_localization_tf2_frame_id,
-                               FLAGS_localization_tf2_child_frame_id,
-                               query_stamp,
-                               ros::Duration(kTf2BuffSize), &err_msg)) {
-    AERROR << "Cannot transform frame: " << FLAGS_localization_tf2_frame_id
-           << " to frame " << FLAGS_localization_tf2_child_frame_id
-           << " , err: " << err_msg
-           << ". Frames: " << tf2_buffer.allFramesAsString();
+bool GetVelodyneTrans(const double query_time, Eigen::Matrix4d* trans) {
+  return GetLidarTrans(query_time, FLAGS_lidar_tf2_child_frame_id, trans);
+}
+
+bool GetLidarTrans(const double query_time, const std::string& child_frame_id,
+                   Eigen::Matrix4d* trans) {
+  if (!trans) {
+    AERROR << "failed to get trans, the trans ptr can not be NULL";
     return false;
   }
-  try {
-    transform_stamped = tf2_buffer.lookupTransform(
-        FLAGS_localization_tf2_frame_id,
-        FLAGS_localization_tf2_child_frame_id, query_stamp);
-  } catch (tf2::TransformException& ex) {
-    AERROR << "Exception: " << ex.what();
+
+  Eigen::Matrix4d lidar2novatel_trans;
+  if (!GetTrans(query_time, FLAGS_lidar_tf2_frame_id, child_frame_id,
+                &lidar2novatel_trans)) {
+    return false;
+  }
+  ADEBUG << "get " << FLAGS_lidar_tf2_frame_id << " to " << child_frame_id
+         << " trans: " << lidar2novatel_trans;
+
+  Eigen::Matrix4d novatel2world_trans;
+  if (!GetTrans(query_time, FLAGS_localization_tf2_frame_id,
+                FLAGS_localization_tf2_child_frame_id, &novatel2world_trans)) {
     return false;
   }
-  Eigen::Affine3d affine_localization_3d;
-  tf::transformMsgToEigen(transform_stamped.transform, affine_localization_3d);
-  Eigen::Matrix4d novatel2world_trans = affine_localization_3d.matrix();
 
   *trans = novatel2world_trans * lidar2novatel_trans;
   ADEBUG << "get " << FLAGS_lidar_tf2_frame_id << " to "
@@ -96,57 +105,19 @@ bool GetRadarTrans(const double query_time, Eigen::Matrix4d *trans) {
     return false;
   }
 
-  ros::Time query_stamp(query_time);
-  const auto& tf2_buffer = common::adapter::AdapterManager::Tf2Buffer();
-
-  const double kTf2BuffSize = FLAGS_tf2_buff_in_ms / 1000.0;
-  std::string err_msg;
-  if (!tf2_buffer.canTransform(FLAGS_radar_tf2_frame_id,
-                               FLAGS_radar_tf2_child_frame_id, query_stamp,
-                               ros::Duration(kTf2BuffSize), &err_msg)) {
-    AERROR << "Cannot transform frame: " << FLAGS_radar_tf2_frame_id
-           << " to frame " << FLAGS_radar_tf2_child_frame_id
-           << " , err: " << err_msg
-           << ". Frames: " << tf2_buffer.allFramesAsString();
+  Eigen::Matrix4d radar2novatel_trans;
+  if (!GetTrans(query_time, FLAGS_radar_tf2_frame_id,
+                FLAGS_radar_tf2_child_frame_id, &radar2novatel_trans)) {
     return false;
   }
-
-  geometry_msgs::TransformStamped transform_stamped;
-  try {
-    transform_stamped = tf2_buffer.lookupTransform(
-        FLAGS_radar_tf2_frame_id, FLAGS_radar_tf2_child_frame_id, query_stamp);
-  } catch (tf2::TransformException& ex) {
-    AERROR << "Exception: " << ex.what();
-    return false;
-  }
-  Eigen::Affine3d affine_radar_3d;
-  tf::transformMsgToEigen(transform_stamped.transform, affine_radar_3d);
-  Eigen::Matrix4d radar2novatel_trans = affine_radar_3d.matrix();
   ADEBUG << "get " << FLAGS_radar_tf2_frame_id << " to "
          << FLAGS_radar_tf2_child_frame_id << " trans: " << radar2novatel_trans;
 
-
-  if (!tf2_buffer.canTransform(FLAGS_localization_tf2_frame_id,
-                               FLAGS_localization_tf2_child_frame_id,
-                               query_stamp,
-                               ros::Duration(kTf2BuffSize), &err_msg)) {
-    AERROR << "Cannot transform frame: " << FLAGS_localization_tf2_frame_id
-           << " to frame " << FLAGS_localization_tf2_child_frame_id
-           << " , err: " << err_msg
-           << ". Frames: " << tf2_buffer.allFramesAsString();
-    return false;
-  }
-  try {
-    transform_stamped = tf2_buffer.lookupTransform(
-        FLAGS_localization_tf2_frame_id,
-        FLAGS_localization_tf2_child_frame_id, query_stamp);
-  } catch (tf2::TransformException& ex) {
-    AERROR << "Exception: " << ex.what();
+  Eigen::Matrix4d novatel2world_trans;
+  if (!GetTrans(query_time, FLAGS_localization_tf2_frame_id,
+                FLAGS_localization_tf2_child_frame_id, &novatel2world_trans)) {
     return false;
   }
-  Eigen::Affine3d affine_localization_3d;
-  tf::transformMsgToEigen(transform_stamped.transform, affine_localization_3d);
-  Eigen::Matrix4d novatel2world_trans = affine_localization_3d.matrix();
 
   *trans = novatel2world_trans * radar2novatel_trans;
   ADEBUG << "get " << FLAGS_radar_tf2_frame_id << " to "
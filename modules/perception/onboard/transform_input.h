@@ -16,6 +16,8 @@
 #ifndef MODULES_PERCEPTION_ONBOARD_TRANSFORM_INPUT_H_
 #define MODULES_PERCEPTION_ONBOARD_TRANSFORM_INPUT_H_
 
+#include <string>
+
 #include "Eigen/Core"
 
 namespace apollo {
@@ -23,6 +25,11 @@ namespace perception {
 
 bool GetVelodyneTrans(const double query_time, Eigen::Matrix4d* trans);
 
+// @brief gets the lidar to world transform of the lidar of the tf2 child frame
+// id, GetVelodyneTrans() gets the one of the main lidar
+bool GetLidarTrans(const double query_time, const std::string& child_frame_id,
+                   Eigen::Matrix4d* trans);
+
 bool GetRadarTrans(const double query_time, Eigen::Matrix4d *trans);
 
 }  // namespace perception
@@ -35,6 +35,9 @@ struct Event {
   std::string reserve;
   // TODO(Yangguang Li):
   double local_timestamp = 0.0;  // local timestamp to compute process delay.
+  // local timestamp of the last publish, only set when the latency trace is
+  // enabled.
+  double publish_timestamp = 0.0;
 
   Event() {
     local_timestamp = TimeUtil::GetCurrentTime();
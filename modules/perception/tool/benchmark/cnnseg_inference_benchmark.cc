@@ -0,0 +1,370 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "pcl/io/pcd_io.h"
+
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/perception/lib/base/time_util.h"
+#include "modules/perception/lib/config_manager/config_manager.h"
+#include "modules/perception/lib/pcl_util/pcl_types.h"
+#include "modules/perception/obstacle/common/file_system_util.h"
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/cluster2d.h"
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/feature_generator.h"
+#include "modules/perception/obstacle/lidar/segmentation/cnnseg/inference.h"
+
+DECLARE_string(flagfile);
+DEFINE_string(pcd_path, "./pcd/", "pcd path");
+DEFINE_int32(max_frames, 0,
+             "the number of frames loaded from the pcd path, 0 for all");
+DEFINE_int32(warmup_frames, 5,
+             "the number of first frames left out of the latencies");
+DEFINE_string(cnnseg_test_config, "",
+              "the cnnseg config of the inference compared to the Caffe FP32 "
+              "one of the model config, relative to the work root");
+DEFINE_string(benchmark_report_file, "",
+              "the file the report is written to, besides the log");
+
+namespace apollo {
+namespace perception {
+
+using apollo::common::util::GetAbsolutePath;
+using apollo::common::util::GetProtoFromFile;
+
+namespace {
+
+// the output blobs of the network and the clustering
+const int kNumOutputs = 5;
+const char* const kOutputNames[kNumOutputs] = {
+    "instance_pt", "category_pt", "confidence_pt", "height_pt", "class_pt"};
+
+double Percentile(std::vector<double> values, double ratio) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  const size_t index = std::min(
+      values.size() - 1, static_cast<size_t>(ratio * (values.size() - 1)));
+  std::nth_element(values.begin(), values.begin() + index, values.end());
+  return values[index];
+}
+
+}  // namespace
+
+// Runs the Caffe FP32 network of the CNNSegmentation model config and the
+// network of --cnnseg_test_config on the features of the same point clouds,
+// and reports the latencies of both and the differences of their outputs and
+// their objects, e.g. for a TensorRT FP16 or INT8 engine.
+class CNNSegInferenceBenchmark {
+ public:
+  bool Init() {
+    ConfigManager* config_manager = ConfigManager::instance();
+    if (!config_manager->Init()) {
+      AERROR << "failed to Init ConfigManager";
+      return false;
+    }
+    const ModelConfig* model_config = nullptr;
+    if (!config_manager->GetModelConfig("CNNSegmentation", &model_config)) {
+      AERROR << "Failed to get model config for CNNSegmentation";
+      return false;
+    }
+    const std::string& work_root = config_manager->work_root();
+    std::string config_file;
+    std::string proto_file;
+    std::string weight_file;
+    if (!model_config->GetValue("config_file", &config_file) ||
+        !model_config->GetValue("proto_file", &proto_file) ||
+        !model_config->GetValue("weight_file", &weight_file)) {
+      AERROR << "Failed to get the files of CNNSegmentation.";
+      return false;
+    }
+    proto_file = GetAbsolutePath(work_root, proto_file);
+    weight_file = GetAbsolutePath(work_root, weight_file);
+
+    cnnseg::CNNSegParam reference_param;
+    if (!GetProtoFromFile(GetAbsolutePath(work_root, config_file),
+                          &reference_param)) {
+      AERROR << "Failed to load config file of CNNSegmentation.";
+      return false;
+    }
+    reference_param.set_inference_backend(cnnseg::CAFFE);
+    reference_param.set_inference_precision(cnnseg::FP32);
+    cnnseg::CNNSegParam test_param;
+    if (!GetProtoFromFile(GetAbsolutePath(work_root, FLAGS_cnnseg_test_config),
+                          &test_param)) {
+      AERROR << "Failed to load the test config: " << FLAGS_cnnseg_test_config;
+      return false;
+    }
+    if (test_param.has_calibration_table_file()) {
+      test_param.set_calibration_table_file(
+          GetAbsolutePath(work_root, test_param.calibration_table_file()));
+    }
+    cluster_param_ = reference_param;
+
+    if (!reference_.Init(reference_param, proto_file, weight_file) ||
+        !test_.Init(test_param, proto_file, weight_file)) {
+      return false;
+    }
+    if (reference_.feature->count() != test_.feature->count()) {
+      AERROR << "the networks have different inputs.";
+      return false;
+    }
+    if (!feature_generator_.Init(reference_param.feature_param(),
+                                 reference_.feature.get())) {
+      AERROR << "Fail to Init feature generator";
+      return false;
+    }
+    const cnnseg::FeatureParam& feature_param = reference_param.feature_param();
+    for (Network* network : {&reference_, &test_}) {
+      network->cluster2d.Init(
+          static_cast<int>(feature_param.height()),
+          static_cast<int>(feature_param.width()),
+          static_cast<float>(feature_param.point_cloud_range()));
+    }
+    return true;
+  }
+
+  bool LoadFrames(const std::string& pcd_folder) {
+    std::vector<std::string> pcd_file_names;
+    GetFileNamesInFolderById(pcd_folder, ".pcd", &pcd_file_names);
+    size_t num_frames = pcd_file_names.size();
+    if (FLAGS_max_frames > 0) {
+      num_frames = std::min(num_frames, static_cast<size_t>(FLAGS_max_frames));
+    }
+    clouds_.resize(num_frames);
+    for (size_t i = 0; i < num_frames; ++i) {
+      clouds_[i].reset(new pcl_util::PointCloud);
+      if (pcl::io::loadPCDFile<pcl_util::Point>(pcd_folder + pcd_file_names[i],
+                                                *clouds_[i]) != 0) {
+        AERROR << "failed to load pcd file " << pcd_file_names[i];
+        return false;
+      }
+    }
+    AINFO << "loaded " << clouds_.size() << " frames.";
+    return !clouds_.empty();
+  }
+
+  void Run() {
+    const int warmup_frames = std::max(FLAGS_warmup_frames, 0);
+    for (size_t i = 0; i < clouds_.size(); ++i) {
+      const pcl_util::PointCloudPtr& cloud = clouds_[i];
+      feature_generator_.Generate(cloud);
+      caffe::caffe_copy(reference_.feature->count(),
+                        reference_.feature->cpu_data(),
+                        test_.feature->mutable_cpu_data());
+
+      const bool warm = static_cast<int>(i) >= warmup_frames;
+      reference_.Infer(warm);
+      test_.Infer(warm);
+      CompareOutputs();
+
+      pcl_util::PointIndices valid_indices;
+      valid_indices.indices.resize(cloud->points.size());
+      std::iota(valid_indices.indices.begin(), valid_indices.indices.end(), 0);
+      const size_t num_reference_objects =
+          reference_.GetObjects(cloud, valid_indices, cluster_param_);
+      const size_t num_test_objects =
+          test_.GetObjects(cloud, valid_indices, cluster_param_);
+      num_reference_objects_ += num_reference_objects;
+      num_object_diffs_ += num_reference_objects > num_test_objects
+                               ? num_reference_objects - num_test_objects
+                               : num_test_objects - num_reference_objects;
+      ++num_frames_;
+    }
+  }
+
+  std::string Report() const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(3) << "frames: " << num_frames_
+        << "\n";
+    for (const Network* network : {&reference_, &test_}) {
+      oss << std::left << std::setw(20) << network->name
+          << " mean:" << network->MeanLatency()
+          << "ms p50:" << Percentile(network->latencies, 0.5)
+          << "ms p90:" << Percentile(network->latencies, 0.9)
+          << "ms max:" << Percentile(network->latencies, 1.0) << "ms\n";
+    }
+    for (int i = 0; i < kNumOutputs; ++i) {
+      oss << std::left << std::setw(20) << kOutputNames[i]
+          << " max_abs_diff:" << max_abs_diffs_[i] << " mean_abs_diff:"
+          << (num_values_[i] > 0 ? sum_abs_diffs_[i] / num_values_[i] : 0.0)
+          << "\n";
+    }
+    oss << "objectness_mismatch_cells: "
+        << (num_cells_ > 0 ? 100.0 * num_objectness_mismatches_ / num_cells_
+                           : 0.0)
+        << "%\nobjects: " << num_reference_objects_
+        << " object_count_diff: " << num_object_diffs_ << "\n";
+    return oss.str();
+  }
+
+ private:
+  struct Network {
+    bool Init(const cnnseg::CNNSegParam& param, const std::string& proto_file,
+              const std::string& weight_file) {
+      inference.reset(cnnseg::CreateInference(param.inference_backend()));
+      if (inference == nullptr ||
+          !inference->Init(param, proto_file, weight_file)) {
+        AERROR << "Failed to Init the inference of backend "
+               << cnnseg::InferenceBackend_Name(param.inference_backend());
+        return false;
+      }
+      name = inference->name() + "/" +
+             cnnseg::InferencePrecision_Name(param.inference_precision());
+      const cnnseg::NetworkParam& network_param = param.network_param();
+      const std::string output_names[kNumOutputs] = {
+          network_param.instance_pt_blob(), network_param.category_pt_blob(),
+          network_param.confidence_pt_blob(), network_param.height_pt_blob(),
+          network_param.class_pt_blob()};
+      for (int i = 0; i < kNumOutputs; ++i) {
+        outputs[i] = inference->GetBlob(output_names[i]);
+        if (outputs[i] == nullptr) {
+          AERROR << "`" << output_names[i] << "` not exists!";
+          return false;
+        }
+      }
+      feature = inference->GetBlob(network_param.feature_blob());
+      if (feature == nullptr) {
+        AERROR << "`" << network_param.feature_blob() << "` not exists!";
+        return false;
+      }
+      return true;
+    }
+
+    // the latency includes the read back of the outputs the clustering does
+    void Infer(bool record) {
+      const double begin = TimeUtil::GetCurrentTime();
+      inference->Infer();
+      for (const auto& output : outputs) {
+        output->cpu_data();
+      }
+      if (record) {
+        latencies.push_back((TimeUtil::GetCurrentTime() - begin) * 1e3);
+      }
+    }
+
+    size_t GetObjects(const pcl_util::PointCloudPtr& cloud,
+                      const pcl_util::PointIndices& valid_indices,
+                      const cnnseg::CNNSegParam& param) {
+      cluster2d.Cluster(*outputs[1], *outputs[0], cloud, valid_indices,
+                        param.objectness_thresh(),
+                        param.use_all_grids_for_clustering());
+      cluster2d.Filter(*outputs[2], *outputs[3]);
+      cluster2d.Classify(*outputs[4]);
+      std::vector<ObjectPtr> objects;
+      cluster2d.GetObjects(param.confidence_thresh(), param.height_thresh(),
+                           static_cast<int>(param.min_pts_num()), &objects);
+      return objects.size();
+    }
+
+    double MeanLatency() const {
+      if (latencies.empty()) {
+        return 0.0;
+      }
+      return std::accumulate(latencies.begin(), latencies.end(), 0.0) /
+             latencies.size();
+    }
+
+    std::string name;
+    std::unique_ptr<cnnseg::Inference> inference;
+    boost::shared_ptr<caffe::Blob<float>> feature;
+    boost::shared_ptr<caffe::Blob<float>> outputs[kNumOutputs];
+    cnnseg::Cluster2D cluster2d;
+    std::vector<double> latencies;
+  };
+
+  void CompareOutputs() {
+    for (int i = 0; i < kNumOutputs; ++i) {
+      const caffe::Blob<float>& reference = *reference_.outputs[i];
+      const caffe::Blob<float>& test = *test_.outputs[i];
+      CHECK_EQ(reference.count(), test.count())
+          << "the networks have different " << kOutputNames[i] << " blobs.";
+      const float* reference_data = reference.cpu_data();
+      const float* test_data = test.cpu_data();
+      for (int j = 0; j < reference.count(); ++j) {
+        const double diff = std::fabs(reference_data[j] - test_data[j]);
+        max_abs_diffs_[i] = std::max(max_abs_diffs_[i], diff);
+        sum_abs_diffs_[i] += diff;
+      }
+      num_values_[i] += reference.count();
+    }
+    // the cells the clustering starts from
+    const float objectness_thresh = cluster_param_.objectness_thresh();
+    const float* reference_category = reference_.outputs[1]->cpu_data();
+    const float* test_category = test_.outputs[1]->cpu_data();
+    const int num_cells = reference_.outputs[1]->count();
+    for (int j = 0; j < num_cells; ++j) {
+      if ((reference_category[j] >= objectness_thresh) !=
+          (test_category[j] >= objectness_thresh)) {
+        ++num_objectness_mismatches_;
+      }
+    }
+    num_cells_ += num_cells;
+  }
+
+  cnnseg::CNNSegParam cluster_param_;
+  cnnseg::FeatureGenerator<float> feature_generator_;
+  Network reference_;
+  Network test_;
+  std::vector<pcl_util::PointCloudPtr> clouds_;
+
+  size_t num_frames_ = 0;
+  double max_abs_diffs_[kNumOutputs] = {0.0};
+  double sum_abs_diffs_[kNumOutputs] = {0.0};
+  size_t num_values_[kNumOutputs] = {0};
+  size_t num_objectness_mismatches_ = 0;
+  size_t num_cells_ = 0;
+  size_t num_reference_objects_ = 0;
+  size_t num_object_diffs_ = 0;
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+int main(int argc, char* argv[]) {
+  FLAGS_flagfile =
+      "./modules/perception/tool/benchmark/conf/"
+      "cnnseg_inference_benchmark.flag";
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  apollo::perception::CNNSegInferenceBenchmark benchmark;
+  if (!benchmark.Init() || !benchmark.LoadFrames(FLAGS_pcd_path)) {
+    return 1;
+  }
+  benchmark.Run();
+  const std::string report = benchmark.Report();
+  AINFO << "cnnseg inference benchmark:\n" << report;
+  std::cout << report;
+  if (!FLAGS_benchmark_report_file.empty()) {
+    std::ofstream fout(FLAGS_benchmark_report_file);
+    if (!fout) {
+      AERROR << "failed to open " << FLAGS_benchmark_report_file;
+      return 1;
+    }
+    fout << report;
+  }
+  return 0;
+}
@@ -0,0 +1,352 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Eigen/StdVector"
+#include "pcl/io/pcd_io.h"
+
+#include "modules/common/log.h"
+#include "modules/perception/common/perception_gflags.h"
+#include "modules/perception/lib/base/mutex.h"
+#include "modules/perception/lib/base/thread.h"
+#include "modules/perception/lib/base/time_util.h"
+#include "modules/perception/lib/config_manager/config_manager.h"
+#include "modules/perception/lib/pcl_util/pcl_types.h"
+#include "modules/perception/obstacle/common/file_system_util.h"
+#include "modules/perception/obstacle/common/pose_util.h"
+#include "modules/perception/obstacle/onboard/lidar_process.h"
+#include "modules/perception/obstacle/onboard/obstacle_perception.h"
+#include "modules/perception/obstacle/onboard/sensor_raw_frame.h"
+#include "modules/perception/onboard/latency_tracer.h"
+
+DECLARE_string(flagfile);
+DECLARE_bool(enable_visualization);
+DEFINE_string(pcd_path, "./pcd/", "pcd path");
+DEFINE_string(pose_path, "./pose/", "pose path");
+DEFINE_bool(benchmark_fusion, false,
+            "run the fusion on the lidar objects of every frame too");
+DEFINE_int32(max_frames, 0,
+             "the number of frames loaded from the pcd path, 0 for all");
+DEFINE_int32(warmup_frames, 5,
+             "the number of first frames left out of the statistics");
+DEFINE_int32(repeat_times, 1, "the number of times the frames are run");
+DEFINE_bool(sample_gpu_utilization, true,
+            "sample the utilization of the gpu with nvidia-smi");
+DEFINE_int32(gpu_sample_interval_in_ms, 100,
+             "the interval between two samples of the gpu utilization");
+DEFINE_string(benchmark_report_file, "",
+              "the file the report is written to, besides the log");
+
+namespace apollo {
+namespace perception {
+
+DECLARE_int32(latency_trace_window);
+DECLARE_int32(latency_trace_report_interval);
+
+namespace {
+
+// the stages the lidar process and the obstacle perception trace
+const char *const kStages[] = {
+    "lidar_get_roi_from_hdmap", "lidar_roi_filter", "lidar_segmentation",
+    "lidar_object_builder",     "lidar_tracker",    "lidar_type_fuser",
+    "sensor_fusion",            "benchmark_frame"};
+
+}  // namespace
+
+// Samples the utilization and the used memory of the first gpu with
+// nvidia-smi, so the benchmark does not depend on the nvml library.
+class GpuUtilizationSampler : public Thread {
+ public:
+  GpuUtilizationSampler() : Thread(true, "GpuUtilizationSampler") {}
+
+  void Stop() {
+    stop_ = true;
+  }
+
+  std::string ToString() {
+    MutexLock lock(&mutex_);
+    if (utilizations_.empty()) {
+      return "gpu utilization: n/a";
+    }
+    double sum = 0.0;
+    for (const double utilization : utilizations_) {
+      sum += utilization;
+    }
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(1)
+        << "gpu utilization: mean:" << sum / utilizations_.size() << "% max:"
+        << *std::max_element(utilizations_.begin(), utilizations_.end())
+        << "% samples:" << utilizations_.size()
+        << " max_memory_used:" << max_memory_used_ << "MiB";
+    return oss.str();
+  }
+
+ protected:
+  void Run() override {
+    while (!stop_) {
+      double utilization = 0.0;
+      double memory_used = 0.0;
+      if (!Sample(&utilization, &memory_used)) {
+        AWARN << "failed to sample the gpu utilization with nvidia-smi.";
+        return;
+      }
+      {
+        MutexLock lock(&mutex_);
+        utilizations_.push_back(utilization);
+        max_memory_used_ = std::max(max_memory_used_, memory_used);
+      }
+      usleep(FLAGS_gpu_sample_interval_in_ms * 1000);
+    }
+  }
+
+ private:
+  bool Sample(double *utilization, double *memory_used) {
+    FILE *pipe = popen(
+        "nvidia-smi --id=0 --query-gpu=utilization.gpu,memory.used "
+        "--format=csv,noheader,nounits 2>/dev/null",
+        "r");
+    if (pipe == nullptr) {
+      return false;
+    }
+    const int num_read = fscanf(pipe, "%lf, %lf", utilization, memory_used);
+    return pclose(pipe) == 0 && num_read == 2;
+  }
+
+  volatile bool stop_ = false;
+  Mutex mutex_;
+  std::vector<double> utilizations_;
+  double max_memory_used_ = 0.0;
+};
+
+// Runs the lidar pipeline, and optionally the fusion, over the recorded
+// point clouds and poses, without ROS. The frames are loaded before the run
+// so the statistics leave the io out.
+class OfflineLidarBenchmark {
+ public:
+  bool Init() {
+    if (!ConfigManager::instance()->Init()) {
+      AERROR << "failed to Init ConfigManager";
+      return false;
+    }
+    if (FLAGS_benchmark_fusion) {
+      obstacle_perception_.reset(new ObstaclePerception());
+      if (!obstacle_perception_->Init()) {
+        AERROR << "failed to Init obstacle_perception.";
+        return false;
+      }
+    } else {
+      lidar_process_.reset(new LidarProcess());
+      if (!lidar_process_->Init()) {
+        AERROR << "failed to Init lidar_process.";
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool LoadFrames(const std::string &pcd_folder,
+                  const std::string &pose_folder) {
+    std::vector<std::string> pcd_file_names;
+    std::vector<std::string> pose_file_names;
+    GetFileNamesInFolderById(pcd_folder, ".pcd", &pcd_file_names);
+    GetFileNamesInFolderById(pose_folder, ".pose", &pose_file_names);
+    if (pcd_file_names.size() != pose_file_names.size()) {
+      AERROR << "pcd file number " << pcd_file_names.size()
+             << " does not match pose file number " << pose_file_names.size();
+      return false;
+    }
+    size_t num_frames = pcd_file_names.size();
+    if (FLAGS_max_frames > 0) {
+      num_frames = std::min(num_frames, static_cast<size_t>(FLAGS_max_frames));
+    }
+    frames_.resize(num_frames);
+    for (size_t i = 0; i < num_frames; ++i) {
+      Frame &frame = frames_[i];
+      frame.cloud.reset(new pcl_util::PointCloud);
+      if (pcl::io::loadPCDFile<pcl_util::Point>(
+              pcd_folder + pcd_file_names[i], *frame.cloud) != 0) {
+        AERROR << "failed to load pcd file " << pcd_file_names[i];
+        return false;
+      }
+      int frame_id = -1;
+      if (!ReadPoseFile(pose_folder + pose_file_names[i], &frame.pose,
+                        &frame_id, &frame.timestamp)) {
+        AERROR << "failed to read pose file " << pose_file_names[i];
+        return false;
+      }
+    }
+    AINFO << "loaded " << frames_.size() << " frames.";
+    return !frames_.empty();
+  }
+
+  void Run() {
+    // every frame is kept in the latency percentiles
+    const int num_runs =
+        static_cast<int>(frames_.size()) * std::max(FLAGS_repeat_times, 1);
+    FLAGS_enable_latency_trace = true;
+    FLAGS_latency_trace_window = num_runs;
+    FLAGS_latency_trace_report_interval = 0;
+    LatencyTracer *tracer = LatencyTracer::instance();
+    tracer->Reset();
+
+    const int warmup_frames = std::max(FLAGS_warmup_frames, 0);
+    GpuUtilizationSampler gpu_sampler;
+    bool gpu_sampling = false;
+    // the timestamps of the frames have to increase for the tracker
+    double timestamp_offset = 0.0;
+    const double sequence_duration =
+        frames_.back().timestamp - frames_.front().timestamp + 0.1;
+    for (int run = 0; run < num_runs; ++run) {
+      const size_t index = run % frames_.size();
+      if (run > 0 && index == 0) {
+        timestamp_offset += sequence_duration;
+      }
+      if (run == warmup_frames) {
+        tracer->Reset();
+        num_frames_ = 0;
+        num_objects_ = 0;
+        num_points_ = 0;
+        process_time_ = 0.0;
+        if (FLAGS_sample_gpu_utilization) {
+          gpu_sampler.Start();
+          gpu_sampling = true;
+        }
+      }
+
+      const Frame &frame = frames_[index];
+      const double timestamp = frame.timestamp + timestamp_offset;
+      LatencyTraceFrame trace(timestamp);
+      const double begin = TimeUtil::GetCurrentTime();
+      size_t num_objects = 0;
+      if (!ProcessFrame(frame, timestamp, &num_objects)) {
+        AERROR << "failed to process frame " << index;
+        continue;
+      }
+      process_time_ += TimeUtil::GetCurrentTime() - begin;
+      trace.Mark("benchmark_frame");
+      ++num_frames_;
+      num_objects_ += num_objects;
+      num_points_ += frame.cloud->size();
+    }
+    if (gpu_sampling) {
+      gpu_sampler.Stop();
+      gpu_sampler.Join();
+    }
+    gpu_utilization_ = gpu_sampler.ToString();
+  }
+
+  std::string Report() const {
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2) << "frames: " << num_frames_
+        << " process_time: " << process_time_ << "s";
+    if (process_time_ > 0.0) {
+      oss << " frames/s: " << num_frames_ / process_time_
+          << " objects/s: " << num_objects_ / process_time_
+          << " points/s: " << num_points_ / process_time_;
+    }
+    oss << "\n" << gpu_utilization_ << "\n";
+    for (const char *stage : kStages) {
+      StageLatencyStat stat;
+      if (!LatencyTracer::instance()->GetStat(stage, &stat)) {
+        continue;
+      }
+      oss << std::left << std::setw(28) << stage << " count:" << stat.count
+          << " p50:" << stat.duration.p50 << "ms p90:" << stat.duration.p90
+          << "ms p99:" << stat.duration.p99 << "ms max:" << stat.duration.max
+          << "ms\n";
+    }
+    return oss.str();
+  }
+
+ private:
+  struct Frame {
+    double timestamp = 0.0;
+    Eigen::Matrix4d pose = Eigen::Matrix4d::Identity();
+    pcl_util::PointCloudPtr cloud;
+  };
+
+  bool ProcessFrame(const Frame &frame, double timestamp,
+                    size_t *num_objects) {
+    if (obstacle_perception_ != nullptr) {
+      VelodyneRawFrame raw_frame;
+      raw_frame.sensor_type_ = VELODYNE_64;
+      raw_frame.timestamp_ = timestamp;
+      raw_frame.pose_ = frame.pose;
+      raw_frame.cloud_ = frame.cloud;
+      std::vector<ObjectPtr> fused_objects;
+      if (!obstacle_perception_->Process(&raw_frame, &fused_objects)) {
+        return false;
+      }
+      *num_objects = fused_objects.size();
+      return true;
+    }
+    auto velodyne_trans = std::make_shared<Eigen::Matrix4d>(frame.pose);
+    if (!lidar_process_->Process(timestamp, frame.cloud, velodyne_trans)) {
+      return false;
+    }
+    *num_objects = lidar_process_->GetObjects().size();
+    return true;
+  }
+
+  std::vector<Frame, Eigen::aligned_allocator<Frame>> frames_;
+  std::unique_ptr<LidarProcess> lidar_process_;
+  std::unique_ptr<ObstaclePerception> obstacle_perception_;
+
+  size_t num_frames_ = 0;
+  size_t num_objects_ = 0;
+  size_t num_points_ = 0;
+  double process_time_ = 0.0;
+  std::string gpu_utilization_;
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+int main(int argc, char *argv[]) {
+  FLAGS_flagfile =
+      "./modules/perception/tool/benchmark/conf/offline_lidar_benchmark.flag";
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  FLAGS_enable_visualization = false;
+  apollo::perception::OfflineLidarBenchmark benchmark;
+  if (!benchmark.Init() ||
+      !benchmark.LoadFrames(FLAGS_pcd_path, FLAGS_pose_path)) {
+    return 1;
+  }
+  benchmark.Run();
+  const std::string report = benchmark.Report();
+  AINFO << "offline lidar benchmark:\n" << report;
+  std::cout << report;
+  if (!FLAGS_benchmark_report_file.empty()) {
+    std::ofstream fout(FLAGS_benchmark_report_file);
+    if (!fout) {
+      AERROR << "failed to open " << FLAGS_benchmark_report_file;
+      return 1;
+    }
+    fout << report;
+  }
+  return 0;
+}
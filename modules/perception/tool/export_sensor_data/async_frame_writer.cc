@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/tool/export_sensor_data/async_frame_writer.h"
+
+#include <algorithm>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace perception {
+
+AsyncFrameWriter::AsyncFrameWriter(int num_threads, size_t max_queued_frames)
+    : queue_(std::max<size_t>(max_queued_frames, 1)) {
+  num_threads = std::max(num_threads, 1);
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.emplace_back(
+        new WriterThread("FrameWriter" + std::to_string(i), this));
+    threads_.back()->Start();
+  }
+}
+
+AsyncFrameWriter::~AsyncFrameWriter() {
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    queue_.push(WriteJob());
+  }
+  for (auto& thread : threads_) {
+    thread->Join();
+  }
+  AINFO << "AsyncFrameWriter wrote " << num_written_frames_ << " frames, "
+        << num_failed_frames_ << " failed and " << num_dropped_frames_
+        << " dropped.";
+}
+
+bool AsyncFrameWriter::Push(const WriteJob& job) {
+  if (!queue_.try_push(job)) {
+    ++num_dropped_frames_;
+    return false;
+  }
+  return true;
+}
+
+void AsyncFrameWriter::RunWriter() {
+  while (true) {
+    WriteJob job;
+    queue_.pop(&job);
+    if (!job) {
+      return;
+    }
+    if (job()) {
+      ++num_written_frames_;
+    } else {
+      ++num_failed_frames_;
+    }
+  }
+}
+
+}  // namespace perception
+}  // namespace apollo
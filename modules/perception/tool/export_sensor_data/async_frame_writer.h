@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_TOOL_EXPORT_SENSOR_DATA_ASYNC_FRAME_WRITER_H_
+#define MODULES_PERCEPTION_TOOL_EXPORT_SENSOR_DATA_ASYNC_FRAME_WRITER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/common/macro.h"
+#include "modules/perception/lib/base/concurrent_queue.h"
+#include "modules/perception/lib/base/thread.h"
+
+namespace apollo {
+namespace perception {
+
+/**
+ * @class AsyncFrameWriter
+ * @brief Writes the files of the exported frames in a pool of threads, so
+ * that the callbacks only queue them. When the queue is full, the new frames
+ * are dropped and counted, instead of blocking the callbacks.
+ */
+class AsyncFrameWriter {
+ public:
+  // Writes all the files of a frame, returns false on failure.
+  typedef std::function<bool()> WriteJob;
+
+  AsyncFrameWriter(int num_threads, size_t max_queued_frames);
+
+  // Writes the queued frames before stopping the threads.
+  ~AsyncFrameWriter();
+
+  /**
+   * @brief Queues a frame to write.
+   * @return false if the queue is full and the frame is dropped.
+   */
+  bool Push(const WriteJob& job);
+
+  uint64_t num_written_frames() const { return num_written_frames_; }
+  uint64_t num_failed_frames() const { return num_failed_frames_; }
+  uint64_t num_dropped_frames() const { return num_dropped_frames_; }
+
+ private:
+  class WriterThread : public Thread {
+   public:
+    WriterThread(const std::string& name, AsyncFrameWriter* writer)
+        : Thread(true, name), writer_(writer) {}
+
+   protected:
+    void Run() override { writer_->RunWriter(); }
+
+   private:
+    AsyncFrameWriter* writer_;
+  };
+
+  void RunWriter();
+
+  // an empty job stops a writer thread
+  FixedSizeConQueue<WriteJob> queue_;
+  std::vector<std::unique_ptr<WriterThread>> threads_;
+
+  std::atomic<uint64_t> num_written_frames_{0};
+  std::atomic<uint64_t> num_failed_frames_{0};
+  std::atomic<uint64_t> num_dropped_frames_{0};
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncFrameWriter);
+};
+
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_TOOL_EXPORT_SENSOR_DATA_ASYNC_FRAME_WRITER_H_
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/tool/export_sensor_data/async_frame_writer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+
+TEST(AsyncFrameWriterTest, WriteAll) {
+  std::atomic<int> num_calls(0);
+  {
+    AsyncFrameWriter writer(3, 100);
+    for (int i = 0; i < 50; ++i) {
+      EXPECT_TRUE(writer.Push([&num_calls, i]() {
+        ++num_calls;
+        return i % 10 != 0;
+      }));
+    }
+  }
+  // the queued frames are written before the writer is destroyed
+  EXPECT_EQ(50, num_calls);
+}
+
+TEST(AsyncFrameWriterTest, DropWhenFull) {
+  std::mutex mutex;
+  std::condition_variable cvar;
+  bool blocked = true;
+  std::atomic<int> num_started(0);
+  AsyncFrameWriter writer(1, 2);
+  auto blocking_job = [&]() {
+    ++num_started;
+    std::unique_lock<std::mutex> lock(mutex);
+    cvar.wait(lock, [&blocked]() { return !blocked; });
+    return true;
+  };
+  ASSERT_TRUE(writer.Push(blocking_job));
+  while (num_started == 0) {
+    std::this_thread::yield();
+  }
+  // the writer is busy: two frames are queued, the next ones dropped
+  EXPECT_TRUE(writer.Push(blocking_job));
+  EXPECT_TRUE(writer.Push([]() { return false; }));
+  EXPECT_FALSE(writer.Push(blocking_job));
+  EXPECT_FALSE(writer.Push(blocking_job));
+  EXPECT_EQ(2u, writer.num_dropped_frames());
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    blocked = false;
+  }
+  cvar.notify_all();
+  while (writer.num_written_frames() + writer.num_failed_frames() < 3) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(2u, writer.num_written_frames());
+  EXPECT_EQ(1u, writer.num_failed_frames());
+}
+
+}  // namespace perception
+}  // namespace apollo
@@ -36,6 +36,13 @@ DEFINE_string(lidar_path,
   "modules/perception/tool/export_sensor_data/lidar/", "lidar path");
 DEFINE_string(radar_path,
   "modules/perception/tool/export_sensor_data/radar/", "radar path");
+DEFINE_string(pcd_format, "binary",
+  "the format of the pcd files: ascii, binary or binary_compressed");
+DEFINE_int32(num_frame_writer_threads, 2,
+  "the number of threads writing the exported frames");
+DEFINE_int32(max_queued_frames, 32,
+  "the number of frames waiting to be written, beyond which the new frames "
+  "are dropped");
 
 namespace apollo {
 namespace perception {
@@ -85,27 +92,37 @@ Status ExportSensorData::Init() {
   radar2velodyne_extrinsic_ = short_camera_extrinsic.matrix()
                               * radar_extrinsic.matrix();
 
+  if (FLAGS_pcd_format != "ascii" && FLAGS_pcd_format != "binary" &&
+      FLAGS_pcd_format != "binary_compressed") {
+    AERROR << "Unknown pcd format: " << FLAGS_pcd_format;
+    return Status(ErrorCode::PERCEPTION_ERROR, "Unknown pcd format");
+  }
+  frame_writer_.reset(new AsyncFrameWriter(FLAGS_num_frame_writer_threads,
+                                           FLAGS_max_queued_frames));
+
   return Status::OK();
 }
 
-void ExportSensorData::WriteRadar(const std::string &file_pre,
+bool ExportSensorData::WriteRadar(const std::string &file_pre,
   const ContiRadar &radar_obs) {
   std::string filename = file_pre + ".radar";
   std::fstream fout(filename.c_str(), std::ios::out | std::ios::binary);
   if (!radar_obs.SerializeToOstream(&fout)) {
     AERROR << "Failed to write radar msg.";
-    return;
+    return false;
   }
   fout.close();
+  return true;
 }
 
-void ExportSensorData::WritePose(const std::string &file_pre,
+bool ExportSensorData::WritePose(const std::string &file_pre,
   const double timestamp, const int seq_num,
   const Eigen::Matrix4d& pose) {
   std::string filename = file_pre + ".pose";
   std::fstream fout(filename.c_str(), std::ios::out | std::ios::binary);
   if (!fout.is_open()) {
-    AINFO << "Failed to write pose.";
+    AERROR << "Failed to write pose.";
+    return false;
   }
   Eigen::Matrix3f mat3f = pose.block<3, 3>(0, 0).cast<float>();
   Eigen::Quaternionf quaternion(mat3f);
@@ -114,32 +131,47 @@ void ExportSensorData::WritePose(const std::string &file_pre,
        << quaternion.x() << " " << quaternion.y() << " "
        << quaternion.z() << " " << quaternion.w() << std::endl;
   fout.close();
+  return true;
 }
 
-void ExportSensorData::WriteVelocityInfo(const std::string &file_pre,
+bool ExportSensorData::WriteVelocityInfo(const std::string &file_pre,
   const double& timestamp, const int seq_num,
   const Eigen::Vector3f& velocity) {
   std::string filename = file_pre + ".velocity";
   std::fstream fout(filename.c_str(), std::ios::out | std::ios::binary);
   if (!fout.is_open()) {
-    AINFO << "Failed to write velocity.";
+    AERROR << "Failed to write velocity.";
+    return false;
   }
   fout << std::setprecision(16) << seq_num << " " << timestamp << " "
        << velocity(0) << " " << velocity(1) << " " << velocity(2) << std::endl;
   fout.close();
+  return true;
 }
 
-void ExportSensorData::WritePCD(const std::string &file_pre,
+bool ExportSensorData::WritePCD(const std::string &file_pre,
    const sensor_msgs::PointCloud2& in_msg) {
   pcl_util::PointCloudPtr cloud(new pcl_util::PointCloud);
   TransPointCloudToPCL(in_msg, &cloud);
   std::string filename = file_pre + ".pcd";
+  int result = 0;
   try {
-    pcl::io::savePCDFileASCII(filename, *cloud);
+    if (FLAGS_pcd_format == "ascii") {
+      result = pcl::io::savePCDFileASCII(filename, *cloud);
+    } else if (FLAGS_pcd_format == "binary_compressed") {
+      result = pcl::io::savePCDFileBinaryCompressed(filename, *cloud);
+    } else {
+      result = pcl::io::savePCDFileBinary(filename, *cloud);
+    }
   } catch (const std::exception& e) {
     AERROR << "Something wrong, check the file path first.";
-    return;
+    return false;
+  }
+  if (result != 0) {
+    AERROR << "Failed to write " << filename;
+    return false;
   }
+  return true;
 }
 
 void ExportSensorData::TransPointCloudToPCL(
@@ -190,9 +222,20 @@ void ExportSensorData::OnPointCloud(
   std::string str = boost::lexical_cast<std::string>(kTimeStamp);
   std::string file_pre = FLAGS_lidar_path + str;
   AINFO << "lidar file pre: " << file_pre;
-  // save point cloud and pose
-  WritePCD(file_pre, message);
-  WritePose(file_pre, kTimeStamp, seq_num, *velodyne_trans);
+  // save point cloud and pose in the writer threads, the message is copied
+  // as it is only valid in the callback
+  std::shared_ptr<sensor_msgs::PointCloud2> cloud_msg =
+    std::make_shared<sensor_msgs::PointCloud2>(message);
+  const int kSeqNum = seq_num;
+  if (!frame_writer_->Push([this, file_pre, cloud_msg, kTimeStamp, kSeqNum,
+                            velodyne_trans]() {
+        return WritePCD(file_pre, *cloud_msg) &&
+               WritePose(file_pre, kTimeStamp, kSeqNum, *velodyne_trans);
+      })) {
+    AWARN << "Dropped lidar frame at timestamp " << GLOG_TIMESTAMP(kTimeStamp)
+          << ", the writers are behind; " << frame_writer_->num_dropped_frames()
+          << " frames dropped.";
+  }
 }
 
 void ExportSensorData::OnRadar(const ContiRadar &radar_obs) {
@@ -247,9 +290,20 @@ void ExportSensorData::OnRadar(const ContiRadar &radar_obs) {
   std::string file_pre = FLAGS_radar_path + str;
   // save radar, pose, odometry
   AINFO << "radar file pre: " << file_pre;
-  WriteRadar(file_pre, radar_obs_proto);
-  WritePose(file_pre, timestamp, seq_num, *radar2world_pose);
-  WriteVelocityInfo(file_pre, timestamp, seq_num, car_linear_speed);
+  std::shared_ptr<ContiRadar> radar_msg =
+    std::make_shared<ContiRadar>(radar_obs_proto);
+  const int kSeqNum = seq_num;
+  if (!frame_writer_->Push([this, file_pre, radar_msg, timestamp, kSeqNum,
+                            radar2world_pose, car_linear_speed]() {
+        return WriteRadar(file_pre, *radar_msg) &&
+               WritePose(file_pre, timestamp, kSeqNum, *radar2world_pose) &&
+               WriteVelocityInfo(file_pre, timestamp, kSeqNum,
+                                 car_linear_speed);
+      })) {
+    AWARN << "Dropped radar frame at timestamp " << GLOG_TIMESTAMP(timestamp)
+          << ", the writers are behind; " << frame_writer_->num_dropped_frames()
+          << " frames dropped.";
+  }
 }
 
 void ExportSensorData::OnLocalization(
@@ -32,6 +32,7 @@
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/localization/proto/localization.pb.h"
 #include "modules/perception/lib/pcl_util/pcl_types.h"
+#include "modules/perception/tool/export_sensor_data/async_frame_writer.h"
 
 /**
  * @namespace apollo::perception
@@ -52,14 +53,15 @@ class ExportSensorData{
     const apollo::localization::LocalizationEstimate &localization);
   bool GetCarLinearSpeed(double timestamp,
     Eigen::Vector3f *car_linear_speed);
-  void WriteRadar(const std::string &file_pre, const ContiRadar &radar_obs);
-  void WritePose(const std::string &file_pre,
+  // The writers run in the threads of frame_writer_.
+  bool WriteRadar(const std::string &file_pre, const ContiRadar &radar_obs);
+  bool WritePose(const std::string &file_pre,
     const double timestamp, const int seq_num,
     const Eigen::Matrix4d& pose);
-  void WriteVelocityInfo(const std::string &file_pre,
+  bool WriteVelocityInfo(const std::string &file_pre,
     const double& timestamp, const int seq_num,
     const Eigen::Vector3f& velocity);
-  void WritePCD(const std::string &file_pre,
+  bool WritePCD(const std::string &file_pre,
      const sensor_msgs::PointCloud2& in_msg);
   void TransPointCloudToPCL(
     const sensor_msgs::PointCloud2& in_msg,
@@ -70,6 +72,9 @@ class ExportSensorData{
   ContiRadarIDExpansion _conti_id_expansion;
   Mutex mutex_;
   Eigen::Matrix4d radar2velodyne_extrinsic_;
+  // the last member, so that the queued frames are written before the
+  // others are destroyed
+  std::unique_ptr<AsyncFrameWriter> frame_writer_;
 };
 
 }  // namespace perception
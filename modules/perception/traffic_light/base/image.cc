@@ -61,8 +61,8 @@ bool Image::GenerateMat() {
       if (image_data_->encoding.compare("yuyv") == 0) {
         unsigned char *yuv = (unsigned char *)&(image_data_->data[0]);
         mat_ = cv::Mat(image_data_->height, image_data_->width, CV_8UC3);
-        Yuyv2rgbAvx(yuv, mat_.data, image_data_->height * image_data_->width);
-        cv::cvtColor(mat_, mat_, CV_RGB2BGR);
+        // converted to BGR in one pass, without a cv::cvtColor() after
+        Yuyv2bgrAvx(yuv, mat_.data, image_data_->height * image_data_->width);
       }
 
       contain_mat_ = true;
@@ -19,6 +19,7 @@
 
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/perception/common/perception_gflags.h"
+#include "modules/perception/onboard/latency_tracer.h"
 #include "modules/perception/onboard/transform_input.h"
 #include "modules/perception/traffic_light/base/utils.h"
 #include "modules/perception/traffic_light/projection/projection.h"
@@ -171,6 +172,7 @@ void TLPreprocessorSubnode::SubCameraImage(
   std::shared_ptr<Image> image(new Image);
   cv::Mat cv_mat;
   double timestamp = msg->header.stamp.toSec();
+  LatencyTraceFrame trace(timestamp);
   image->Init(timestamp, camera_id, msg);
   if (FLAGS_output_raw_img) {
     // user should create folders
@@ -202,6 +204,8 @@ void TLPreprocessorSubnode::SubCameraImage(
     return;
   }
 
+  trace.Mark("tl_camera_selection");
+
   // sync image and publish data
   const double before_sync_image_ts = TimeUtil::GetCurrentTime();
   std::shared_ptr<ImageLights> image_lights(new ImageLights);
@@ -215,6 +219,7 @@ void TLPreprocessorSubnode::SubCameraImage(
   }
   const double sync_image_latency =
       TimeUtil::GetCurrentTime() - before_sync_image_ts;
+  trace.Mark("tl_sync_image");
 
   // Monitor image time and system time difference
   int max_cached_lights_size = preprocessor_.max_cached_lights_size();
@@ -251,6 +256,8 @@ void TLPreprocessorSubnode::SubCameraImage(
     return;
   }
 
+  trace.Mark("tl_verify_lights_projection");
+
   // record current frame timestamp
   last_proc_image_ts_ = sub_camera_image_start_ts;
 
@@ -280,6 +287,17 @@ bool TLPreprocessorSubnode::GetSignals(double ts, CarPose *pose,
   AINFO << "camera_selection get position\n " << std::setprecision(12)
         << pose->pose();
 
+  // the signals ahead stay the same while the car stays close to where they
+  // were queried, e.g. when it waits at a red light
+  if (last_signals_ts_ >= 0.0 &&
+      preprocessor_.IsCloseToPose(last_signals_pose_, *pose)) {
+    *signals = last_signals_;
+    last_signals_ts_ = ts;
+    ADEBUG << "camera_selection reuses the last signals info. ts:"
+           << GLOG_TIMESTAMP(ts);
+    return true;
+  }
+
   // get signals
   if (!hd_map_->GetSignals(pose->pose(), signals)) {
     if (ts - last_signals_ts_ < valid_hdmap_interval_) {
@@ -295,6 +313,7 @@ bool TLPreprocessorSubnode::GetSignals(double ts, CarPose *pose,
   } else {
     last_signals_ = *signals;
     last_signals_ts_ = ts;
+    last_signals_pose_ = *pose;
   }
   return true;
 }
@@ -99,6 +99,7 @@ class TLPreprocessorSubnode : public Subnode {
   // signals
   float last_signals_ts_ = -1.0;
   std::vector<apollo::hdmap::Signal> last_signals_;
+  CarPose last_signals_pose_;
   float valid_hdmap_interval_ = 1.5;
 
   // tf
@@ -20,6 +20,7 @@
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/perception/common/perception_gflags.h"
 #include "modules/perception/lib/base/timer.h"
+#include "modules/perception/onboard/latency_tracer.h"
 #include "modules/perception/onboard/subnode_helper.h"
 #include "modules/perception/traffic_light/base/tl_shared_data.h"
 #include "modules/perception/traffic_light/base/utils.h"
@@ -94,6 +95,7 @@ bool TLProcSubnode::ProcEvent(const Event &event) {
   // get up-stream data
   const double timestamp = event.timestamp;
   const std::string device_id = event.reserve;
+  LatencyTraceFrame trace(timestamp);
 
   AINFO << "Detect Start ts:" << GLOG_TIMESTAMP(timestamp);
   std::string key;
@@ -135,6 +137,8 @@ bool TLProcSubnode::ProcEvent(const Event &event) {
     AERROR << "TLProcSubnode failed to generate mat";
     return false;
   }
+  trace.Mark("tl_generate_mat");
+
   // using rectifier to rectify the region.
   const double before_rectify_ts = TimeUtil::GetCurrentTime();
   if (!rectifier_->Rectify(*(image_lights->image), rectify_option,
@@ -146,6 +150,7 @@ bool TLProcSubnode::ProcEvent(const Event &event) {
   }
   const double detection_latency =
       TimeUtil::GetCurrentTime() - before_rectify_ts;
+  trace.Mark("tl_rectify");
 
   // update image_border
   MutexLock lock(&mutex_);
@@ -158,6 +163,8 @@ bool TLProcSubnode::ProcEvent(const Event &event) {
         << " CameraId: " << image_lights->camera_id;
   image_lights->offset = image_border_size[image_lights->camera_id];
 
+  trace.Mark("tl_compute_image_border");
+
   // recognize_status
   const double before_recognization_ts = TimeUtil::GetCurrentTime();
   if (!recognizer_->RecognizeStatus(*(image_lights->image), RecognizeOption(),
@@ -169,6 +176,7 @@ bool TLProcSubnode::ProcEvent(const Event &event) {
   }
   const double recognization_latency =
       TimeUtil::GetCurrentTime() - before_recognization_ts;
+  trace.Mark("tl_recognize");
 
   // revise status
   const double before_revise_ts = TimeUtil::GetCurrentTime();
@@ -179,7 +187,9 @@ bool TLProcSubnode::ProcEvent(const Event &event) {
     return false;
   }
   const double revise_latency = TimeUtil::GetCurrentTime() - before_revise_ts;
+  trace.Mark("tl_revise");
   PublishMessage(image_lights);
+  trace.Mark("tl_publish");
   AINFO << "TLProcSubnode process traffic_light, "
         << " msg_ts: " << GLOG_TIMESTAMP(timestamp)
         << " from device_id: " << device_id << " get "
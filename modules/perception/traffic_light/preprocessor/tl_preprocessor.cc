@@ -16,6 +16,8 @@
 
 #include "modules/perception/traffic_light/preprocessor/tl_preprocessor.h"
 
+#include "Eigen/Geometry"
+
 #include "modules/perception/lib/base/time_util.h"
 #include "modules/perception/onboard/transform_input.h"
 #include "modules/perception/traffic_light/base/tl_shared_data.h"
@@ -59,6 +61,16 @@ bool TLPreprocessor::Init() {
     AERROR << "no_signals_interval_seconds not found." << name();
     return false;
   }
+  if (!model_config->GetValue("projection_cache_translation_threshold",
+                              &projection_cache_translation_threshold_)) {
+    AERROR << "projection_cache_translation_threshold not found." << name();
+    return false;
+  }
+  if (!model_config->GetValue("projection_cache_rotation_threshold",
+                              &projection_cache_rotation_threshold_)) {
+    AERROR << "projection_cache_rotation_threshold not found." << name();
+    return false;
+  }
 
   // init projection
   if (!projection_.Init()) {
@@ -345,19 +357,85 @@ bool TLPreprocessor::ProjectLights(const CarPose &pose,
     return false;
   }
 
-  for (size_t i = 0; i < signals.size(); ++i) {
-    LightPtr light(new Light);
-    light->info = signals[i];
-    if (!projection_.Project(pose, ProjectOption(camera_id), light.get())) {
-      lights_outside_image->push_back(light);
-    } else {
-      lights_on_image->push_back(light);
+  MutexLock lock(&projection_cache_mutex_);
+  if (!IsProjectionCacheValid(pose, signals)) {
+    ResetProjectionCache(pose, signals);
+  }
+  if (!is_projection_cached_[cam_id]) {
+    for (size_t i = 0; i < signals.size(); ++i) {
+      LightPtr light(new Light);
+      light->info = signals[i];
+      if (!projection_.Project(projection_cache_pose_, ProjectOption(camera_id),
+                               light.get())) {
+        cached_lights_outside_image_[cam_id]->push_back(light);
+      } else {
+        cached_lights_on_image_[cam_id]->push_back(light);
+      }
     }
+    is_projection_cached_[cam_id] = true;
+  } else {
+    ADEBUG << "project_lights reuses the cached projections on "
+           << kCameraIdToStr.at(camera_id);
+  }
+
+  // the lights are copied, as the later stages write their regions
+  for (const LightPtr &light : *cached_lights_on_image_[cam_id]) {
+    lights_on_image->push_back(std::make_shared<Light>(*light));
+  }
+  for (const LightPtr &light : *cached_lights_outside_image_[cam_id]) {
+    lights_outside_image->push_back(std::make_shared<Light>(*light));
   }
 
   return true;
 }
 
+bool TLPreprocessor::IsCloseToPose(const CarPose &pose,
+                                   const CarPose &other_pose) const {
+  const Eigen::Matrix4d matrix = pose.pose();
+  const Eigen::Matrix4d other_matrix = other_pose.pose();
+  const Eigen::Vector3d translation =
+      other_matrix.block<3, 1>(0, 3) - matrix.block<3, 1>(0, 3);
+  if (translation.norm() > projection_cache_translation_threshold_) {
+    return false;
+  }
+  const Eigen::Matrix3d rotation =
+      matrix.block<3, 3>(0, 0).transpose() * other_matrix.block<3, 3>(0, 0);
+  return Eigen::AngleAxisd(rotation).angle() <=
+         projection_cache_rotation_threshold_;
+}
+
+bool TLPreprocessor::IsProjectionCacheValid(
+    const CarPose &pose, const std::vector<Signal> &signals) const {
+  if (is_projection_cached_.empty() ||
+      signals.size() != projection_cache_signal_ids_.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < signals.size(); ++i) {
+    if (signals[i].id().id() != projection_cache_signal_ids_[i]) {
+      return false;
+    }
+  }
+  // compared with the pose of the projections, so that small moves do not
+  // add up
+  return IsCloseToPose(projection_cache_pose_, pose);
+}
+
+void TLPreprocessor::ResetProjectionCache(const CarPose &pose,
+                                          const std::vector<Signal> &signals) {
+  projection_cache_pose_ = pose;
+  projection_cache_signal_ids_.clear();
+  for (const auto &signal : signals) {
+    projection_cache_signal_ids_.push_back(signal.id().id());
+  }
+  is_projection_cached_.assign(kCountCameraId, false);
+  cached_lights_on_image_.resize(kCountCameraId);
+  cached_lights_outside_image_.resize(kCountCameraId);
+  for (int cam_id = 0; cam_id < kCountCameraId; ++cam_id) {
+    cached_lights_on_image_[cam_id].reset(new LightPtrs);
+    cached_lights_outside_image_[cam_id].reset(new LightPtrs);
+  }
+}
+
 bool TLPreprocessor::IsOnBorder(const cv::Size size, const cv::Rect &roi,
                                 const int border_size) const {
   if (roi.x < border_size || roi.y < border_size) {
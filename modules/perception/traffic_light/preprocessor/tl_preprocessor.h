@@ -113,6 +113,16 @@ class TLPreprocessor : public BasePreprocessor {
   bool IsOnBorder(const cv::Size size, const cv::Rect &roi,
                   const int border_size) const;
 
+  /**
+   * @brief whether the car moved and turned less than the projection cache
+   *        thresholds between two poses, so that the lights projected at one
+   *        still hold at the other
+   * @param pose
+   * @param other_pose
+   * @return
+   */
+  bool IsCloseToPose(const CarPose &pose, const CarPose &other_pose) const;
+
   int GetMinFocalLenCameraId();
   int GetMaxFocalLenCameraId();
 
@@ -129,12 +139,29 @@ class TLPreprocessor : public BasePreprocessor {
 
   Mutex mutex_;
 
+  // The lights projected on each camera at projection_cache_pose_. They are
+  // copied out while the signals are the same and the car stays close to
+  // that pose, e.g. when it waits at a red light.
+  bool IsProjectionCacheValid(const CarPose &pose,
+                              const std::vector<Signal> &signals) const;
+  void ResetProjectionCache(const CarPose &pose,
+                            const std::vector<Signal> &signals);
+
+  Mutex projection_cache_mutex_;
+  CarPose projection_cache_pose_;
+  std::vector<std::string> projection_cache_signal_ids_;
+  std::vector<bool> is_projection_cached_;
+  LightsArray cached_lights_on_image_;
+  LightsArray cached_lights_outside_image_;
+
   // some parameters from config file
   int max_cached_lights_size_ = 100;
   int projection_image_cols_ = 1920;
   int projection_image_rows_ = 1080;
   float sync_interval_seconds_ = 0.1;
   float no_signals_interval_seconds_ = 0.5;
+  float projection_cache_translation_threshold_ = 0.0;
+  float projection_cache_rotation_threshold_ = 0.0;
 
   DISALLOW_COPY_AND_ASSIGN(TLPreprocessor);
 };
@@ -47,12 +47,25 @@ bool BoundaryProjection::Project(const CameraCoeffient &camera_coeffient,
     return false;
   }
 
+  // move all the boundary points into the camera frame with one product,
+  // the pose is only inverted once for the light
+  Eigen::Matrix<double, 4, Eigen::Dynamic> points(4, bound_size);
+  for (int i = 0; i < bound_size; ++i) {
+    const common::PointENU &point = tl_info.boundary().point(i);
+    points.col(i) << point.x(), point.y(),
+        point.z() + FLAGS_light_height_adjust, 1.0;
+  }
+  const Eigen::Matrix4d transform =
+      camera_coeffient.camera_extrinsic * pose.inverse();
+  const Eigen::Matrix<double, 4, Eigen::Dynamic> points_camera =
+      transform * points;
+
   std::vector<int> x(bound_size);
   std::vector<int> y(bound_size);
 
   for (int i = 0; i < bound_size; ++i) {
-    if (!ProjectPointDistort(camera_coeffient, pose,
-                             tl_info.boundary().point(i), &x[i], &y[i])) {
+    if (!ProjectPointDistort(camera_coeffient, points_camera.col(i), &x[i],
+                             &y[i])) {
       return false;
     }
   }
@@ -102,18 +115,10 @@ bool BoundaryProjection::ProjectPoint(const CameraCoeffient &coeffient,
   return true;
 }
 
-bool BoundaryProjection::ProjectPointDistort(const CameraCoeffient &coeffient,
-                                             const Eigen::Matrix4d &pose,
-                                             const common::PointENU &point,
-                                             int *center_x,
-                                             int *center_y) const {
-  Eigen::Matrix<double, 4, 1> TL_loc_LTM;
-  Eigen::Matrix<double, 3, 1> TL_loc_cam;
-
-  TL_loc_LTM << point.x(), point.y(), point.z() + FLAGS_light_height_adjust,
-      1.0;
-  TL_loc_LTM = coeffient.camera_extrinsic * pose.inverse() * TL_loc_LTM;
-
+bool BoundaryProjection::ProjectPointDistort(
+    const CameraCoeffient &coeffient,
+    const Eigen::Matrix<double, 4, 1> &TL_loc_LTM, int *center_x,
+    int *center_y) const {
   if (TL_loc_LTM(2) < 0) {
     AWARN << "Compute a light behind the car. light to car Pose:\n"
           << TL_loc_LTM;
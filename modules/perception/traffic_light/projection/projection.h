@@ -41,10 +41,10 @@ class BoundaryProjection : public BaseProjection {
                     const apollo::common::Point3D &point, int *center_x,
                     int *center_y) const;
 
+  // @brief project a point given in the camera frame, with distortion
   bool ProjectPointDistort(const CameraCoeffient &coeffient,
-                           const Eigen::Matrix4d &pose,
-                           const apollo::common::PointENU &point, int *center_x,
-                           int *center_y) const;
+                           const Eigen::Matrix<double, 4, 1> &TL_loc_LTM,
+                           int *center_x, int *center_y) const;
 
   Eigen::Matrix<double, 2, 1> PixelDenormalize(
       const Eigen::Matrix<double, 2, 1> &pt2d,
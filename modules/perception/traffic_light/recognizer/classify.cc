@@ -51,23 +51,40 @@ void ClassifyBySimple::Init(const std::string &_class_net,
 
 void ClassifyBySimple::Perform(const cv::Mat &ros_image,
                                std::vector<LightPtr> *lights) {
+  std::vector<LightPtr> candidates;
+  for (LightPtr light : *lights) {
+    if (light->region.is_detected &&
+        BoxIsValid(light->region.rectified_roi, ros_image.size())) {
+      candidates.push_back(light);
+    }
+  }
+  if (candidates.empty()) {
+    return;
+  }
+
+  // all the lights are packed into one input blob and classified by a single
+  // forward pass
   caffe::Blob<float> *input_blob_recog = classify_net_ptr_->input_blobs()[0];
+  const int num_lights = static_cast<int>(candidates.size());
+  if (input_blob_recog->num() != num_lights) {
+    input_blob_recog->Reshape(num_lights, 3, resize_height_, resize_width_);
+    classify_net_ptr_->Reshape();
+  }
   caffe::Blob<float> *output_blob_recog =
       classify_net_ptr_->top_vecs()[classify_net_ptr_->top_vecs().size() - 1]
                                    [0];
-  cv::Mat img = ros_image(crop_box_);
-  for (LightPtr light : *lights) {
-    if (!light->region.is_detected ||
-        !BoxIsValid(light->region.rectified_roi, ros_image.size())) {
-      continue;
-    }
 
-    cv::Mat img_light = img(light->region.rectified_roi).clone();
-    assert(img_light.rows > 0);
-    assert(img_light.cols > 0);
+  const int input_size = 3 * resize_height_ * resize_width_;
+  float *input_data = input_blob_recog->mutable_cpu_data();
+  cv::Mat img = ros_image(crop_box_);
+  cv::Mat img_light;
+  for (int i = 0; i < num_lights; ++i) {
+    const cv::Mat roi = img(candidates[i]->region.rectified_roi);
+    assert(roi.rows > 0);
+    assert(roi.cols > 0);
 
-    cv::resize(img_light, img_light, cv::Size(resize_width_, resize_height_));
-    float *data = input_blob_recog->mutable_cpu_data();
+    cv::resize(roi, img_light, cv::Size(resize_width_, resize_height_));
+    float *data = input_data + i * input_size;
     uchar *pdata = img_light.data;
     for (int h = 0; h < resize_height_; ++h) {
       pdata = img_light.data + h * img_light.step;
@@ -79,10 +96,14 @@ void ClassifyBySimple::Perform(const cv::Mat &ros_image,
         }
       }
     }
+  }
 
-    classify_net_ptr_->ForwardFrom(0);
-    float *out_put_data = output_blob_recog->mutable_cpu_data();
-    ProbToColor(out_put_data, unknown_threshold_, light);
+  classify_net_ptr_->ForwardFrom(0);
+  const float *out_put_data = output_blob_recog->cpu_data();
+  const int output_size = output_blob_recog->count() / num_lights;
+  for (int i = 0; i < num_lights; ++i) {
+    ProbToColor(out_put_data + i * output_size, unknown_threshold_,
+                candidates[i]);
   }
 }
 
@@ -44,6 +44,7 @@ class ClassifyBySimple : public IRefine {
             float threshold, unsigned int resize_width,
             unsigned int resize_height);
 
+  // @brief classify the detected lights, all in one forward pass
   virtual void Perform(const cv::Mat &ros_image, std::vector<LightPtr> *lights);
 
   void SetCropBox(const cv::Rect &box) override;
@@ -111,16 +111,16 @@ bool UnityRecognize::RecognizeStatus(const Image &image,
   cbox = cv::Rect(0, 0, ros_image.cols, ros_image.rows);
   classify_night_->SetCropBox(cbox);
   classify_day_->SetCropBox(cbox);
-  std::vector<LightPtr> candidate(1);
+  // the lights of each class are recognized together, so each model runs
+  // once per image
+  std::vector<LightPtr> night_candidates;
+  std::vector<LightPtr> day_candidates;
   for (LightPtr light : *lights) {
     if (light->region.is_detected) {
-      candidate[0] = light;
       if (light->region.detect_class_id == QUADRATE_CLASS) {
-        AINFO << "Recognize Use Night Model!";
-        classify_night_->Perform(ros_image, &candidate);
+        night_candidates.push_back(light);
       } else if (light->region.detect_class_id == VERTICAL_CLASS) {
-        AINFO << "Recognize Use Day Model!";
-        classify_day_->Perform(ros_image, &candidate);
+        day_candidates.push_back(light);
       } else {
         AINFO << "Not support yet!";
       }
@@ -132,6 +132,15 @@ bool UnityRecognize::RecognizeStatus(const Image &image,
             << ". Not perform recognition.";
     }
   }
+  if (!night_candidates.empty()) {
+    AINFO << "Recognize " << night_candidates.size()
+          << " lights Use Night Model!";
+    classify_night_->Perform(ros_image, &night_candidates);
+  }
+  if (!day_candidates.empty()) {
+    AINFO << "Recognize " << day_candidates.size() << " lights Use Day Model!";
+    classify_day_->Perform(ros_image, &day_candidates);
+  }
   return true;
 }
 
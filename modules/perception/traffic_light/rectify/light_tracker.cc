@@ -0,0 +1,139 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/traffic_light/rectify/light_tracker.h"
+
+#include "modules/common/log.h"
+#include "modules/perception/traffic_light/base/utils.h"
+
+namespace apollo {
+namespace perception {
+namespace traffic_light {
+
+namespace {
+
+cv::Mat ToGray(const cv::Mat &image) {
+  if (image.channels() == 1) {
+    return image;
+  }
+  cv::Mat gray;
+  cv::cvtColor(image, gray, cv::COLOR_BGR2GRAY);
+  return gray;
+}
+
+}  // namespace
+
+LightTracker::LightTracker(int search_margin, float min_score)
+    : search_margin_(search_margin), min_score_(min_score) {}
+
+bool LightTracker::Init(const cv::Mat &image, CameraId camera_id,
+                        const std::vector<LightPtr> &lights) {
+  Reset();
+  if (lights.empty()) {
+    return false;
+  }
+  std::vector<Target> targets;
+  for (const auto &light : lights) {
+    const LightRegion &region = light->region;
+    if (!region.is_detected || !region.is_selected ||
+        region.rectified_roi.area() <= 0) {
+      return false;
+    }
+    // a patch cut by the image border would not match where the light is
+    if (RefinedBox(region.rectified_roi, image.size()) !=
+        region.rectified_roi) {
+      return false;
+    }
+    Target target;
+    target.id = light->info.id().id();
+    target.projection_roi = region.projection_roi;
+    target.roi = region.rectified_roi;
+    target.patch = ToGray(image(region.rectified_roi)).clone();
+    target.detect_class_id = region.detect_class_id;
+    target.detect_score = region.detect_score;
+    targets.push_back(target);
+  }
+  camera_id_ = camera_id;
+  image_size_ = image.size();
+  targets_.swap(targets);
+  return true;
+}
+
+void LightTracker::Reset() {
+  camera_id_ = UNKNOWN;
+  targets_.clear();
+}
+
+bool LightTracker::Track(const cv::Mat &image, CameraId camera_id,
+                         std::vector<LightPtr> *lights) {
+  if (targets_.empty() || camera_id != camera_id_ ||
+      image.size() != image_size_ || lights->size() != targets_.size()) {
+    return false;
+  }
+  std::vector<cv::Rect> rois(targets_.size());
+  for (size_t i = 0; i < targets_.size(); ++i) {
+    const LightPtr &light = (*lights)[i];
+    if (light->info.id().id() != targets_[i].id ||
+        !Match(image, targets_[i], light->region.projection_roi, &rois[i])) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < targets_.size(); ++i) {
+    LightRegion *region = &(*lights)[i]->region;
+    region->rectified_roi = rois[i];
+    region->detect_class_id = targets_[i].detect_class_id;
+    region->detect_score = targets_[i].detect_score;
+    region->is_detected = true;
+    region->is_selected = true;
+    targets_[i].projection_roi = region->projection_roi;
+    targets_[i].roi = rois[i];
+  }
+  return true;
+}
+
+bool LightTracker::Match(const cv::Mat &image, const Target &target,
+                         const cv::Rect &projection_roi, cv::Rect *roi) const {
+  // the light is expected to move on the image as its projection does
+  cv::Rect expected = target.roi;
+  expected.x += projection_roi.x - target.projection_roi.x;
+  expected.y += projection_roi.y - target.projection_roi.y;
+  cv::Rect window(expected.x - search_margin_, expected.y - search_margin_,
+                  expected.width + 2 * search_margin_,
+                  expected.height + 2 * search_margin_);
+  window = RefinedBox(window, image.size());
+  if (window.width < target.patch.cols || window.height < target.patch.rows) {
+    return false;
+  }
+
+  cv::Mat scores;
+  cv::matchTemplate(ToGray(image(window)), target.patch, scores,
+                    cv::TM_CCOEFF_NORMED);
+  double max_score = 0.0;
+  cv::Point max_location;
+  cv::minMaxLoc(scores, nullptr, &max_score, nullptr, &max_location);
+  // a flat patch gives no score, which is lost as well
+  if (!(max_score >= min_score_)) {
+    ADEBUG << "lost light " << target.id << ", score " << max_score;
+    return false;
+  }
+  *roi = cv::Rect(window.x + max_location.x, window.y + max_location.y,
+                  target.patch.cols, target.patch.rows);
+  return true;
+}
+
+}  // namespace traffic_light
+}  // namespace perception
+}  // namespace apollo
@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#ifndef MODULES_PERCEPTION_TRAFFIC_LIGHT_RECTIFY_LIGHT_TRACKER_H_
+#define MODULES_PERCEPTION_TRAFFIC_LIGHT_RECTIFY_LIGHT_TRACKER_H_
+
+#include <string>
+#include <vector>
+
+#include "opencv2/opencv.hpp"
+
+#include "modules/perception/traffic_light/base/image.h"
+#include "modules/perception/traffic_light/base/light.h"
+
+namespace apollo {
+namespace perception {
+namespace traffic_light {
+
+/**
+ * @class LightTracker
+ * @brief Follows the lights rectified by the detector on the next images, by
+ *        matching the patch of each light within a small window around the
+ *        place it is expected at, which is far cheaper than a detection.
+ */
+class LightTracker {
+ public:
+  /**
+   * @param search_margin how far in pixels the matching window extends
+   *        beyond the box of a light
+   * @param min_score the lowest normalized correlation of a match, below
+   *        which the light is lost
+   */
+  LightTracker(int search_margin, float min_score);
+
+  /**
+   * @brief starts to track the lights rectified on the image, they must all
+   *        be detected and selected
+   * @return false if a light can not be tracked, then nothing is tracked
+   */
+  bool Init(const cv::Mat &image, CameraId camera_id,
+            const std::vector<LightPtr> &lights);
+
+  /**
+   * @brief stops tracking
+   */
+  void Reset();
+
+  /**
+   * @brief finds the tracked lights on a new image of the same camera, the
+   *        lights must be the tracked ones in the same order. Their rectified
+   *        regions are set only if all of them are found.
+   * @return false if a light is lost, then the detector is needed
+   */
+  bool Track(const cv::Mat &image, CameraId camera_id,
+             std::vector<LightPtr> *lights);
+
+  bool empty() const { return targets_.empty(); }
+
+ private:
+  struct Target {
+    std::string id;
+    // projection of the light on the image of the patch, its move tells the
+    // move of the light caused by the motion of the car
+    cv::Rect projection_roi;
+    cv::Rect roi;
+    // gray patch of the light on the image of the last detection
+    cv::Mat patch;
+    DetectionClassId detect_class_id = UNKNOWN_CLASS;
+    float detect_score = 0.0f;
+  };
+
+  // finds a target, its new box is written to roi
+  bool Match(const cv::Mat &image, const Target &target,
+             const cv::Rect &projection_roi, cv::Rect *roi) const;
+
+  int search_margin_ = 0;
+  float min_score_ = 0.0f;
+  CameraId camera_id_ = UNKNOWN;
+  cv::Size image_size_;
+  std::vector<Target> targets_;
+};
+
+}  // namespace traffic_light
+}  // namespace perception
+}  // namespace apollo
+
+#endif  // MODULES_PERCEPTION_TRAFFIC_LIGHT_RECTIFY_LIGHT_TRACKER_H_
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/perception/traffic_light/rectify/light_tracker.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace perception {
+namespace traffic_light {
+
+class LightTrackerTest : public ::testing::Test {
+ protected:
+  // draws a light of three lamps, the top one lit, on a dark image
+  static cv::Mat DrawLight(const cv::Rect &box) {
+    cv::Mat image(480, 640, CV_8UC3, cv::Scalar(20, 20, 20));
+    cv::rectangle(image, box, cv::Scalar(60, 60, 60), CV_FILLED);
+    const int radius = box.width / 3;
+    for (int i = 0; i < 3; ++i) {
+      const cv::Point center(box.x + box.width / 2,
+                             box.y + box.height * (2 * i + 1) / 6);
+      const cv::Scalar color =
+          i == 0 ? cv::Scalar(30, 30, 230) : cv::Scalar(10, 10, 10);
+      cv::circle(image, center, radius, color, CV_FILLED);
+    }
+    return image;
+  }
+
+  static LightPtr MakeLight(const cv::Rect &projection_roi,
+                            const cv::Rect &rectified_roi) {
+    LightPtr light(new Light);
+    light->info.mutable_id()->set_id("light");
+    light->region.projection_roi = projection_roi;
+    light->region.rectified_roi = rectified_roi;
+    light->region.is_detected = true;
+    light->region.is_selected = true;
+    light->region.detect_class_id = VERTICAL_CLASS;
+    light->region.detect_score = 0.9f;
+    return light;
+  }
+
+  LightTracker tracker_{20, 0.8f};
+};
+
+TEST_F(LightTrackerTest, Track) {
+  const cv::Rect box(300, 200, 21, 54);
+  std::vector<LightPtr> lights = {MakeLight(cv::Rect(280, 180, 60, 90), box)};
+  ASSERT_TRUE(tracker_.Init(DrawLight(box), LONG_FOCUS, lights));
+  EXPECT_FALSE(tracker_.empty());
+
+  // the light moved by 8 pixels, of which 4 are told by its projection
+  const cv::Rect moved(308, 206, 21, 54);
+  std::vector<LightPtr> next = {
+      MakeLight(cv::Rect(284, 182, 60, 90), cv::Rect(284, 182, 60, 90))};
+  next[0]->region.is_detected = false;
+  ASSERT_TRUE(tracker_.Track(DrawLight(moved), LONG_FOCUS, &next));
+  EXPECT_EQ(moved, next[0]->region.rectified_roi);
+  EXPECT_TRUE(next[0]->region.is_detected);
+  EXPECT_TRUE(next[0]->region.is_selected);
+  EXPECT_EQ(VERTICAL_CLASS, next[0]->region.detect_class_id);
+  EXPECT_FLOAT_EQ(0.9f, next[0]->region.detect_score);
+}
+
+TEST_F(LightTrackerTest, Lost) {
+  const cv::Rect box(300, 200, 21, 54);
+  const cv::Rect projection_roi(280, 180, 60, 90);
+  std::vector<LightPtr> lights = {MakeLight(projection_roi, box)};
+  ASSERT_TRUE(tracker_.Init(DrawLight(box), LONG_FOCUS, lights));
+
+  // the light left the window
+  std::vector<LightPtr> next = {MakeLight(projection_roi, projection_roi)};
+  EXPECT_FALSE(
+      tracker_.Track(DrawLight(cv::Rect(400, 300, 21, 54)), LONG_FOCUS, &next));
+  EXPECT_EQ(projection_roi, next[0]->region.rectified_roi);
+
+  // the image of another camera
+  EXPECT_FALSE(tracker_.Track(DrawLight(box), SHORT_FOCUS, &next));
+
+  // other lights
+  next[0]->info.mutable_id()->set_id("other");
+  EXPECT_FALSE(tracker_.Track(DrawLight(box), LONG_FOCUS, &next));
+}
+
+TEST_F(LightTrackerTest, InitUndetected) {
+  const cv::Rect box(300, 200, 21, 54);
+  std::vector<LightPtr> lights = {MakeLight(cv::Rect(280, 180, 60, 90), box)};
+  lights[0]->region.is_selected = false;
+  EXPECT_FALSE(tracker_.Init(DrawLight(box), LONG_FOCUS, lights));
+  EXPECT_TRUE(tracker_.empty());
+
+  // a light cut by the border of the image
+  lights = {MakeLight(cv::Rect(600, 180, 60, 90), cv::Rect(630, 200, 21, 54))};
+  EXPECT_FALSE(tracker_.Init(DrawLight(box), LONG_FOCUS, lights));
+}
+
+}  // namespace traffic_light
+}  // namespace perception
+}  // namespace apollo
@@ -45,6 +45,18 @@ bool UnityRectify::Init() {
 
   select_.reset(new GaussianSelect);
 
+  // the tracking between detections is optional
+  if (model_config->GetValue("detect_interval", &detect_interval_) &&
+      detect_interval_ > 1) {
+    int track_search_margin = 20;
+    float min_track_score = 0.8f;
+    model_config->GetValue("track_search_margin", &track_search_margin);
+    model_config->GetValue("min_track_score", &min_track_score);
+    tracker_.reset(new LightTracker(track_search_margin, min_track_score));
+    AINFO << "detect lights every " << detect_interval_
+          << " images and track them in between";
+  }
+
   return true;
 }
 
@@ -115,17 +127,38 @@ bool UnityRectify::InitDetection(const ConfigManager *config_manager,
 bool UnityRectify::Rectify(const Image &image, const RectifyOption &option,
                            std::vector<LightPtr> *lights) {
   cv::Mat ros_image = image.mat();
-  std::vector<LightPtr> &lights_ref = *lights;
-  std::vector<LightPtr> selected_bboxes;
-  std::vector<LightPtr> detected_bboxes;
 
-  for (auto &light : lights_ref) {
+  for (auto &light : *lights) {
     // By default, the first debug ros is crop roi. (Reserve a position here).
     light->region.rectified_roi = light->region.projection_roi;
     light->region.debug_roi.push_back(cv::Rect(0, 0, 0, 0));
     light->region.debug_roi_detect_scores.push_back(0.0f);
   }
 
+  if (tracker_ != nullptr && num_since_detection_ < detect_interval_ &&
+      tracker_->Track(ros_image, option.camera_id, lights)) {
+    ++num_since_detection_;
+    AINFO << "track " << lights->size() << " lights";
+    return true;
+  }
+
+  Detect(ros_image, lights);
+  if (tracker_ != nullptr) {
+    num_since_detection_ = 1;
+    // lights partly detected are detected again on the next image
+    if (!tracker_->Init(ros_image, option.camera_id, *lights)) {
+      tracker_->Reset();
+    }
+  }
+  return true;
+}
+
+void UnityRectify::Detect(const cv::Mat &ros_image,
+                          std::vector<LightPtr> *lights) {
+  std::vector<LightPtr> &lights_ref = *lights;
+  std::vector<LightPtr> selected_bboxes;
+  std::vector<LightPtr> detected_bboxes;
+
   cv::Rect cbox;
   crop_->GetCropBox(ros_image.size(), lights_ref, &cbox);
   AINFO << ros_image.size();
@@ -171,7 +204,6 @@ bool UnityRectify::Rectify(const Image &image, const RectifyOption &option,
     lights_ref[i]->region.is_selected = selected_bboxes[i]->region.is_selected;
     AINFO << region;
   }
-  return true;
 }
 
 std::string UnityRectify::name() const { return "UnityRectify"; }
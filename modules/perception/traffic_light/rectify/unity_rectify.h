@@ -23,6 +23,7 @@
 #include "modules/perception/lib/config_manager/config_manager.h"
 #include "modules/perception/traffic_light/interface/base_rectifier.h"
 #include "modules/perception/traffic_light/interface/green_interface.h"
+#include "modules/perception/traffic_light/rectify/light_tracker.h"
 
 namespace apollo {
 namespace perception {
@@ -34,6 +35,9 @@ namespace traffic_light {
  *         While the region may be too large or not accuray.
  *         Rectifier should rectify the region,
  *         send the accuray regions to classifier.
+ *         With a detect_interval above 1, the detector only runs every
+ *         detect_interval images or when a light is lost, and the lights
+ *         are tracked on the images in between.
  */
 class UnityRectify : public BaseRectifier {
  public:
@@ -62,9 +66,17 @@ class UnityRectify : public BaseRectifier {
   std::string name() const override;
 
  private:
+  // runs the detector on the image
+  void Detect(const cv::Mat &ros_image, std::vector<LightPtr> *lights);
+
   std::shared_ptr<ISelectLight> select_;
   std::shared_ptr<IRefine> detect_;
   std::shared_ptr<IGetBox> crop_;
+
+  int detect_interval_ = 1;
+  // images rectified since the last detection, included
+  int num_since_detection_ = 0;
+  std::unique_ptr<LightTracker> tracker_;
 };
 
 REGISTER_RECTIFIER(UnityRectify);
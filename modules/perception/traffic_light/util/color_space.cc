@@ -37,6 +37,7 @@
 
 #include <cassert>
 #include <cstdint>
+#include <utility>
 
 #include "modules/common/log.h"
 
@@ -93,11 +94,15 @@ SIMD_INLINE void YuvSeperateAvx2(uint8_t *y, __m256i *y0, __m256i *y1,
       U_SHUFFLE4);
 }
 
-template <bool align>
+// writes the pixels as RGB, or as BGR if bgr is set
+template <bool align, bool bgr>
 void Yuv2rgbAvx2(__m256i y0, __m256i u0, __m256i v0, uint8_t *rgb) {
   __m256i r0 = YuvToRed(y0, v0);
   __m256i g0 = YuvToGreen(y0, u0, v0);
   __m256i b0 = YuvToBlue(y0, u0);
+  if (bgr) {
+    std::swap(r0, b0);
+  }
 
   Store<align>(reinterpret_cast<__m256i *>(rgb) + 0,
                InterleaveBgr<0>(r0, g0, b0));
@@ -107,21 +112,22 @@ void Yuv2rgbAvx2(__m256i y0, __m256i u0, __m256i v0, uint8_t *rgb) {
                InterleaveBgr<2>(r0, g0, b0));
 }
 
-template <bool align>
+template <bool align, bool bgr>
 void Yuv2rgbAvx2(uint8_t *yuv, uint8_t *rgb) {
   __m256i y0, y1, u0, v0;
 
   YuvSeperateAvx2<align>(yuv, &y0, &y1, &u0, &v0);
   __m256i u0_u0 = _mm256_permute4x64_epi64(u0, 0xD8);
   __m256i v0_v0 = _mm256_permute4x64_epi64(v0, 0xD8);
-  Yuv2rgbAvx2<align>(y0, _mm256_unpacklo_epi8(u0_u0, u0_u0),
-                     _mm256_unpacklo_epi8(v0_v0, v0_v0), rgb);
-  Yuv2rgbAvx2<align>(y1, _mm256_unpackhi_epi8(u0_u0, u0_u0),
-                     _mm256_unpackhi_epi8(v0_v0, v0_v0),
-                     rgb + 3 * sizeof(__m256i));
+  Yuv2rgbAvx2<align, bgr>(y0, _mm256_unpacklo_epi8(u0_u0, u0_u0),
+                          _mm256_unpacklo_epi8(v0_v0, v0_v0), rgb);
+  Yuv2rgbAvx2<align, bgr>(y1, _mm256_unpackhi_epi8(u0_u0, u0_u0),
+                          _mm256_unpackhi_epi8(v0_v0, v0_v0),
+                          rgb + 3 * sizeof(__m256i));
 }
 
-void Yuyv2rgbAvx(unsigned char *YUV, unsigned char *RGB, int NumPixels) {
+template <bool bgr>
+void YuyvConvertAvx(unsigned char *YUV, unsigned char *RGB, int NumPixels) {
   assert(NumPixels == (1920 * 1080));
   bool align = Aligned(YUV) & Aligned(RGB);
   uint8_t *yuv_offset = YUV;
@@ -130,17 +136,25 @@ void Yuyv2rgbAvx(unsigned char *YUV, unsigned char *RGB, int NumPixels) {
     for (int i = 0; i < NumPixels; i = i + (2 * sizeof(__m256i)),
              yuv_offset += 4 * sizeof(__m256i),
              rgb_offset += 6 * sizeof(__m256i)) {
-      Yuv2rgbAvx2<true>(yuv_offset, rgb_offset);
+      Yuv2rgbAvx2<true, bgr>(yuv_offset, rgb_offset);
     }
   } else {
     for (int i = 0; i < NumPixels; i = i + (2 * sizeof(__m256i)),
              yuv_offset += 4 * sizeof(__m256i),
              rgb_offset += 6 * sizeof(__m256i)) {
-      Yuv2rgbAvx2<false>(yuv_offset, rgb_offset);
+      Yuv2rgbAvx2<false, bgr>(yuv_offset, rgb_offset);
     }
   }
 }
 
+void Yuyv2rgbAvx(unsigned char *YUV, unsigned char *RGB, int NumPixels) {
+  YuyvConvertAvx<false>(YUV, RGB, NumPixels);
+}
+
+void Yuyv2bgrAvx(unsigned char *YUV, unsigned char *BGR, int NumPixels) {
+  YuyvConvertAvx<true>(YUV, BGR, NumPixels);
+}
+
 }  // namespace traffic_light
 }  // namespace perception
 }  // namespace apollo
@@ -46,6 +46,9 @@ namespace traffic_light {
 
 void Yuyv2rgbAvx(unsigned char *YUV, unsigned char *RGB, int NumPixels);
 
+// same as Yuyv2rgbAvx, but with the channels in the BGR order of OpenCV
+void Yuyv2bgrAvx(unsigned char *YUV, unsigned char *BGR, int NumPixels);
+
 #define SIMD_INLINE inline __attribute__((always_inline))
 
 template <class T>
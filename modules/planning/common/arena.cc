@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file arena.cc
+ **/
+
+#include "modules/planning/common/arena.h"
+
+#include <algorithm>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// Blocks are allocated with new[], which is aligned for any fundamental
+// type, so larger alignments are not supported.
+constexpr std::size_t kMaxAlignment = alignof(long double);
+
+}  // namespace
+
+Arena::Arena(const std::size_t block_size) : block_size_(block_size) {
+  CHECK_GT(block_size, 0);
+}
+
+void* Arena::Allocate(const std::size_t size, const std::size_t alignment) {
+  CHECK_LE(alignment, kMaxAlignment);
+  CHECK_EQ(alignment & (alignment - 1), 0) << "alignment: " << alignment;
+  while (current_block_ < blocks_.size()) {
+    const Block& block = blocks_[current_block_];
+    const std::size_t offset = (offset_ + alignment - 1) & ~(alignment - 1);
+    if (offset + size <= block.size) {
+      offset_ = offset + size;
+      allocated_bytes_ += size;
+      return block.data.get() + offset;
+    }
+    // The rest of the block is wasted until the next Reset().
+    ++current_block_;
+    offset_ = 0;
+  }
+  Block block;
+  block.size = std::max(size, block_size_);
+  block.data.reset(new char[block.size]);
+  reserved_bytes_ += block.size;
+  blocks_.push_back(std::move(block));
+  current_block_ = blocks_.size() - 1;
+  offset_ = size;
+  allocated_bytes_ += size;
+  return blocks_.back().data.get();
+}
+
+void Arena::Reset() {
+  current_block_ = 0;
+  offset_ = 0;
+  allocated_bytes_ = 0;
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file arena.h
+ **/
+
+#ifndef MODULES_PLANNING_COMMON_ARENA_H_
+#define MODULES_PLANNING_COMMON_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class Arena
+ * @brief A monotonic memory arena. Allocations are carved out of large
+ * blocks and are never freed one by one; Reset() releases all of them at
+ * once and keeps the blocks for the next round, so a steady workload stops
+ * calling malloc after its first round.
+ *
+ * \par
+ * An Arena is not thread safe. Objects allocated from it must be destroyed
+ * before Reset() is called.
+ */
+class Arena {
+ public:
+  /**
+   * @brief Constructor
+   * @param block_size The size of each block in bytes. A larger allocation
+   * gets a block of its own size.
+   */
+  explicit Arena(const std::size_t block_size = 64 * 1024);
+
+  /**
+   * @brief Allocate uninitialized memory.
+   * @param size The size in bytes.
+   * @param alignment The alignment in bytes, a power of two.
+   * @return The allocated memory, valid until Reset() or destruction.
+   */
+  void* Allocate(const std::size_t size, const std::size_t alignment);
+
+  /**
+   * @brief Release all the allocations, and keep the blocks for reuse.
+   */
+  void Reset();
+
+  /**
+   * @brief Get the number of bytes allocated since the last Reset().
+   */
+  std::size_t allocated_bytes() const { return allocated_bytes_; }
+
+  /**
+   * @brief Get the total size of the blocks owned by the arena.
+   */
+  std::size_t reserved_bytes() const { return reserved_bytes_; }
+
+ private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    std::size_t size = 0;
+  };
+
+  std::size_t block_size_ = 0;
+  std::vector<Block> blocks_;
+  // The block being allocated from, and the offset of its free space.
+  std::size_t current_block_ = 0;
+  std::size_t offset_ = 0;
+
+  std::size_t allocated_bytes_ = 0;
+  std::size_t reserved_bytes_ = 0;
+};
+
+/**
+ * @class ArenaAllocator
+ * @brief A standard allocator that allocates from an Arena and never frees,
+ * for containers whose elements all die together, e.g.
+ * std::list<T, ArenaAllocator<T>>.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  template <typename U>
+  struct rebind {
+    using other = ArenaAllocator<U>;
+  };
+
+  explicit ArenaAllocator(Arena* arena) : arena_(arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other)  // NOLINT
+      : arena_(other.arena()) {}
+
+  T* allocate(const std::size_t n) {
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T*, std::size_t) {}
+
+  template <typename U, typename... Args>
+  void construct(U* p, Args&&... args) {
+    ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+  }
+
+  template <typename U>
+  void destroy(U* p) {
+    p->~U();
+  }
+
+  std::size_t max_size() const {
+    return static_cast<std::size_t>(-1) / sizeof(T);
+  }
+
+  Arena* arena() const { return arena_; }
+
+ private:
+  Arena* arena_ = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+  return lhs.arena() == rhs.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+  return !(lhs == rhs);
+}
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_COMMON_ARENA_H_
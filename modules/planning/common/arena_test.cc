@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/common/arena.h"
+
+#include <cstdint>
+#include <list>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+TEST(Arena, Allocate) {
+  Arena arena(128);
+  auto* c = static_cast<char*>(arena.Allocate(1, 1));
+  auto* d = static_cast<double*>(arena.Allocate(sizeof(double), 8));
+  EXPECT_NE(nullptr, c);
+  EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(d) % 8);
+  EXPECT_EQ(1 + sizeof(double), arena.allocated_bytes());
+  EXPECT_EQ(128, arena.reserved_bytes());
+
+  // A larger allocation gets a block of its own.
+  arena.Allocate(1000, 1);
+  EXPECT_EQ(128 + 1000, arena.reserved_bytes());
+
+  // Reset keeps the blocks.
+  arena.Reset();
+  EXPECT_EQ(0, arena.allocated_bytes());
+  EXPECT_EQ(c, arena.Allocate(1, 1));
+  arena.Allocate(500, 1);
+  EXPECT_EQ(128 + 1000, arena.reserved_bytes());
+}
+
+TEST(ArenaAllocator, List) {
+  Arena arena;
+  ArenaAllocator<int> allocator(&arena);
+  {
+    std::list<int, ArenaAllocator<int>> values(allocator);
+    for (int i = 0; i < 100; ++i) {
+      values.push_back(i);
+    }
+    EXPECT_EQ(100, values.size());
+    EXPECT_EQ(99, values.back());
+  }
+  const std::size_t reserved_bytes = arena.reserved_bytes();
+  EXPECT_LT(0, arena.allocated_bytes());
+
+  arena.Reset();
+  {
+    std::list<int, ArenaAllocator<int>> values(allocator);
+    for (int i = 0; i < 100; ++i) {
+      values.push_back(i);
+    }
+  }
+  EXPECT_EQ(reserved_bytes, arena.reserved_bytes());
+}
+
+}  // namespace planning
+}  // namespace apollo
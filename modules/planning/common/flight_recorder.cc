@@ -0,0 +1,173 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file flight_recorder.cc
+ **/
+
+#include "modules/planning/common/flight_recorder.h"
+
+#include <fstream>
+#include <limits>
+#include <utility>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+FlightRecorder::FlightRecorder(const size_t capacity_bytes,
+                               const size_t max_records, const double duration)
+    : buffer_(capacity_bytes), entries_(max_records), duration_(duration) {}
+
+bool FlightRecorder::Add(const int type, const double timestamp,
+                         const google::protobuf::Message& message) {
+  auto iter = last_timestamps_.find(type);
+  if (iter == last_timestamps_.end()) {
+    iter = last_timestamps_
+               .emplace(type, std::numeric_limits<double>::lowest())
+               .first;
+  }
+  if (timestamp <= iter->second) {
+    return false;
+  }
+  const size_t size = message.ByteSize();
+  if (size > buffer_.size() || entries_.empty()) {
+    AWARN << "Cannot record a message of " << size << " bytes";
+    return false;
+  }
+  iter->second = timestamp;
+
+  while (num_entries_ > 0 && (num_entries_ == entries_.size() ||
+                              Front().timestamp < timestamp - duration_)) {
+    PopFront();
+  }
+  size_t offset = write_offset_;
+  if (offset + size > buffer_.size()) {
+    // The records after the newest one are the oldest, drop them to wrap.
+    while (num_entries_ > 0 && Front().offset >= write_offset_) {
+      PopFront();
+    }
+    offset = 0;
+  }
+  while (num_entries_ > 0 && Front().offset >= offset &&
+         Front().offset < offset + size) {
+    PopFront();
+  }
+  message.SerializeWithCachedSizesToArray(buffer_.data() + offset);
+
+  auto& entry = entries_[(first_entry_ + num_entries_) % entries_.size()];
+  entry.timestamp = timestamp;
+  entry.type = type;
+  entry.offset = offset;
+  entry.size = size;
+  ++num_entries_;
+  num_bytes_ += size;
+  write_offset_ = offset + size;
+  return true;
+}
+
+void FlightRecorder::SetLatest(const int type, const double timestamp,
+                               const google::protobuf::Message& message) {
+  auto& record = latest_records_[type];
+  record.timestamp = timestamp;
+  record.type = type;
+  message.SerializeToString(&record.data);
+}
+
+void FlightRecorder::PopFront() {
+  num_bytes_ -= Front().size;
+  first_entry_ = (first_entry_ + 1) % entries_.size();
+  --num_entries_;
+}
+
+void FlightRecorder::Clear() {
+  first_entry_ = 0;
+  num_entries_ = 0;
+  num_bytes_ = 0;
+  write_offset_ = 0;
+  last_timestamps_.clear();
+  latest_records_.clear();
+}
+
+namespace {
+
+void WriteRecord(const double timestamp, const int32_t type,
+                 const uint32_t size, const uint8_t* data,
+                 std::ofstream* out) {
+  out->write(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp));
+  out->write(reinterpret_cast<const char*>(&type), sizeof(type));
+  out->write(reinterpret_cast<const char*>(&size), sizeof(size));
+  out->write(reinterpret_cast<const char*>(data), size);
+}
+
+}  // namespace
+
+bool FlightRecorder::Dump(const std::string& file_name) const {
+  std::ofstream out(file_name, std::ios::binary);
+  if (!out) {
+    AERROR << "Failed to open " << file_name;
+    return false;
+  }
+  for (const auto& pair : latest_records_) {
+    const auto& record = pair.second;
+    WriteRecord(record.timestamp, record.type, record.data.size(),
+                reinterpret_cast<const uint8_t*>(record.data.data()), &out);
+  }
+  for (size_t i = 0; i < num_entries_; ++i) {
+    const auto& entry = entries_[(first_entry_ + i) % entries_.size()];
+    WriteRecord(entry.timestamp, entry.type, entry.size,
+                buffer_.data() + entry.offset, &out);
+  }
+  out.close();
+  if (!out) {
+    AERROR << "Failed to write " << file_name;
+    return false;
+  }
+  return true;
+}
+
+bool FlightRecorder::Load(const std::string& file_name,
+                          std::vector<FlightRecord>* records) {
+  CHECK_NOTNULL(records);
+  std::ifstream in(file_name, std::ios::binary);
+  if (!in) {
+    AERROR << "Failed to open " << file_name;
+    return false;
+  }
+  records->clear();
+  while (in.peek() != std::ifstream::traits_type::eof()) {
+    FlightRecord record;
+    int32_t type = 0;
+    uint32_t size = 0;
+    in.read(reinterpret_cast<char*>(&record.timestamp),
+            sizeof(record.timestamp));
+    in.read(reinterpret_cast<char*>(&type), sizeof(type));
+    in.read(reinterpret_cast<char*>(&size), sizeof(size));
+    record.type = type;
+    record.data.resize(size);
+    in.read(&record.data[0], size);
+    if (!in) {
+      AERROR << "Truncated record in " << file_name;
+      return false;
+    }
+    records->push_back(std::move(record));
+  }
+  return true;
+}
+
+}  // namespace planning
+}  // namespace apollo
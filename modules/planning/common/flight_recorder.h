@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file flight_recorder.h
+ **/
+
+#ifndef MODULES_PLANNING_COMMON_FLIGHT_RECORDER_H_
+#define MODULES_PLANNING_COMMON_FLIGHT_RECORDER_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "google/protobuf/message.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class FlightRecorder
+ *
+ * @brief Keeps the latest serialized planning inputs and outputs in a
+ * preallocated ring of bytes, and writes them to a file only when asked to,
+ * e.g. after a takeover or a planning failure.
+ *
+ * The messages are serialized straight into the ring, where the oldest
+ * records are overwritten, so recording allocates no memory once every
+ * message type has been seen. The class is not thread safe.
+ */
+class FlightRecorder {
+ public:
+  struct FlightRecord {
+    double timestamp = 0.0;
+    int type = 0;
+    std::string data;
+  };
+
+  /**
+   * @param capacity_bytes the size of the ring of serialized messages.
+   * @param max_records the number of records the ring can hold.
+   * @param duration the records more than this duration (in seconds) older
+   * than the newest one are dropped.
+   */
+  FlightRecorder(const size_t capacity_bytes, const size_t max_records,
+                 const double duration);
+
+  /**
+   * @brief Record a message, dropping the oldest records to make room for it.
+   * @param type the type of the message, e.g. an AdapterConfig::MessageType.
+   * @param timestamp the timestamp of the message, usually of its header.
+   * @return false if the message is larger than the ring, or if it is not
+   * newer than the last recorded message of its type.
+   */
+  bool Add(const int type, const double timestamp,
+           const google::protobuf::Message& message);
+
+  /**
+   * @brief Keep the latest message of a type out of the ring, so that it is
+   * in every dump however long ago it was received, e.g. the routing.
+   */
+  void SetLatest(const int type, const double timestamp,
+                 const google::protobuf::Message& message);
+
+  size_t NumRecords() const { return num_entries_; }
+
+  size_t NumBytes() const { return num_bytes_; }
+
+  void Clear();
+
+  /**
+   * @brief Write the messages set by SetLatest() and then the recorded
+   * messages from the oldest to the newest. Every message is written as a
+   * double timestamp, an int32 type, a uint32 size and the serialized bytes.
+   */
+  bool Dump(const std::string& file_name) const;
+
+  /**
+   * @brief Read the messages written by Dump().
+   */
+  static bool Load(const std::string& file_name,
+                   std::vector<FlightRecord>* records);
+
+ private:
+  struct Entry {
+    double timestamp = 0.0;
+    int type = 0;
+    size_t offset = 0;
+    size_t size = 0;
+  };
+
+  const Entry& Front() const { return entries_[first_entry_]; }
+  void PopFront();
+
+ private:
+  std::vector<uint8_t> buffer_;
+  std::vector<Entry> entries_;
+  const double duration_;
+
+  size_t first_entry_ = 0;
+  size_t num_entries_ = 0;
+  size_t num_bytes_ = 0;
+  // Where the next message is written, right after the newest one.
+  size_t write_offset_ = 0;
+
+  std::unordered_map<int, double> last_timestamps_;
+  std::map<int, FlightRecord> latest_records_;
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_COMMON_FLIGHT_RECORDER_H_
@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file flight_recorder_test.cc
+ **/
+
+#include "modules/planning/common/flight_recorder.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/proto/header.pb.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+common::Header MakeHeader(const std::string& module_name,
+                          const uint32_t sequence_num) {
+  common::Header header;
+  header.set_module_name(module_name);
+  header.set_sequence_num(sequence_num);
+  return header;
+}
+
+}  // namespace
+
+TEST(FlightRecorderTest, Add) {
+  const auto header = MakeHeader("planning", 1);
+  const size_t size = header.ByteSize();
+  // Room for four messages of the same size.
+  FlightRecorder recorder(size * 4 + 1, 100, 100.0);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(recorder.Add(1, i, header));
+    EXPECT_EQ(std::min(i + 1, 4), static_cast<int>(recorder.NumRecords()));
+    EXPECT_EQ(recorder.NumRecords() * size, recorder.NumBytes());
+  }
+  // Not newer than the last message of the same type.
+  EXPECT_FALSE(recorder.Add(1, 9.0, header));
+  EXPECT_TRUE(recorder.Add(2, 9.0, header));
+
+  FlightRecorder small_recorder(size - 1, 100, 100.0);
+  EXPECT_FALSE(small_recorder.Add(1, 0.0, header));
+  EXPECT_EQ(0u, small_recorder.NumRecords());
+}
+
+TEST(FlightRecorderTest, Limits) {
+  const auto header = MakeHeader("planning", 1);
+  FlightRecorder recorder(1024, 3, 100.0);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(recorder.Add(1, i, header));
+  }
+  EXPECT_EQ(3u, recorder.NumRecords());
+
+  FlightRecorder short_recorder(1024, 100, 2.0);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(short_recorder.Add(1, i, header));
+  }
+  // Records at 7, 8 and 9 seconds.
+  EXPECT_EQ(3u, short_recorder.NumRecords());
+}
+
+TEST(FlightRecorderTest, DumpAndLoad) {
+  // Messages of various sizes wrap around the ring many times.
+  FlightRecorder recorder(256, 100, 100.0);
+  std::vector<std::string> expected;
+  for (uint32_t i = 0; i < 100; ++i) {
+    const auto header = MakeHeader(std::string(i % 7 * 5, 'a'), i);
+    ASSERT_TRUE(recorder.Add(1, i, header));
+    expected.push_back(header.SerializeAsString());
+  }
+  const auto routing = MakeHeader("routing", 0);
+  recorder.SetLatest(17, 0.5, routing);
+
+  const std::string file_name = "flight_recorder_test.bin";
+  ASSERT_TRUE(recorder.Dump(file_name));
+  std::vector<FlightRecorder::FlightRecord> records;
+  ASSERT_TRUE(FlightRecorder::Load(file_name, &records));
+  std::remove(file_name.c_str());
+
+  ASSERT_EQ(recorder.NumRecords() + 1, records.size());
+  EXPECT_EQ(17, records[0].type);
+  EXPECT_DOUBLE_EQ(0.5, records[0].timestamp);
+  EXPECT_EQ(routing.SerializeAsString(), records[0].data);
+  size_t num_bytes = 0;
+  for (size_t i = 1; i < records.size(); ++i) {
+    const size_t index = expected.size() - records.size() + i;
+    EXPECT_EQ(1, records[i].type);
+    EXPECT_DOUBLE_EQ(index, records[i].timestamp);
+    EXPECT_EQ(expected[index], records[i].data);
+    num_bytes += records[i].data.size();
+  }
+  EXPECT_EQ(recorder.NumBytes(), num_bytes);
+  EXPECT_LE(num_bytes, 256u);
+
+  recorder.Clear();
+  EXPECT_EQ(0u, recorder.NumRecords());
+  EXPECT_EQ(0u, recorder.NumBytes());
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -25,7 +25,9 @@
 #include <limits>
 #include <list>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "modules/routing/proto/routing.pb.h"
 
@@ -33,6 +35,8 @@
 #include "modules/common/configs/vehicle_config_helper.h"
 #include "modules/common/log.h"
 #include "modules/common/math/vec2d.h"
+#include "modules/common/util/string_util.h"
+#include "modules/common/util/util.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -58,7 +62,10 @@ Frame::Frame(uint32_t sequence_num,
     : sequence_num_(sequence_num),
       planning_start_point_(planning_start_point),
       start_time_(start_time),
-      vehicle_state_(vehicle_state) {
+      vehicle_state_(vehicle_state),
+      trajectory_(google::protobuf::Arena::CreateMessage<ADCTrajectory>(
+          &trajectory_arena_)),
+      record_debug_(FLAGS_enable_record_debug) {
   if (FLAGS_enable_lag_prediction) {
     lag_predictor_.reset(
         new LagPrediction(FLAGS_lag_prediction_min_appear_num,
@@ -185,12 +192,105 @@ bool Frame::CreateReferenceLineInfo() {
     reference_line_info_.back().SetOffsetToOtherReferenceLine(-offset);
   }
 
+  const auto *last_frame = FrameHistory::instance()->Latest();
+  if (FLAGS_enable_incremental_frame && last_frame != nullptr) {
+    LinkLastReferenceLineInfo(*last_frame);
+  }
+
   // delay the time-consumping reference_line_info init() step to planner.
   return true;
 }
 
+namespace {
+bool IsSameReferenceLine(const ReferenceLine &line1,
+                         const ReferenceLine &line2) {
+  const auto &points1 = line1.reference_points();
+  const auto &points2 = line2.reference_points();
+  if (points1.size() != points2.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < points1.size(); ++i) {
+    if (points1[i].x() != points2[i].x() || points1[i].y() != points2[i].y() ||
+        points1[i].heading() != points2[i].heading() ||
+        points1[i].kappa() != points2[i].kappa()) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+void Frame::LinkLastReferenceLineInfo(const Frame &last_frame) {
+  for (auto &reference_line_info : reference_line_info_) {
+    for (const auto &last_reference_line_info :
+         last_frame.reference_line_info_) {
+      if (IsSameReferenceLine(reference_line_info.reference_line(),
+                              last_reference_line_info.reference_line())) {
+        reference_line_info.SetLastReferenceLineInfo(
+            &last_reference_line_info);
+        break;
+      }
+    }
+  }
+}
+
+void Frame::AddObstaclesIncrementally(const Frame &last_frame) {
+  std::unordered_map<int, const prediction::PredictionObstacle *>
+      last_predictions;
+  for (const auto &prediction_obstacle :
+       last_frame.prediction_.prediction_obstacle()) {
+    last_predictions[prediction_obstacle.perception_obstacle().id()] =
+        &prediction_obstacle;
+  }
+
+  int num_reused = 0;
+  for (const auto &prediction_obstacle : prediction_.prediction_obstacle()) {
+    const auto iter =
+        last_predictions.find(prediction_obstacle.perception_obstacle().id());
+    if (iter != last_predictions.end() &&
+        common::util::IsProtoEqual(*iter->second, prediction_obstacle)) {
+      // The same prediction makes the same obstacles with the same ids, see
+      // Obstacle::AppendObstacles().
+      const auto perception_id =
+          std::to_string(prediction_obstacle.perception_obstacle().id());
+      std::vector<const Obstacle *> last_obstacles;
+      if (prediction_obstacle.trajectory().empty()) {
+        const auto *last_obstacle = last_frame.obstacles_.Find(perception_id);
+        if (last_obstacle != nullptr) {
+          last_obstacles.push_back(last_obstacle);
+        }
+      } else {
+        for (int i = 0;; ++i) {
+          const auto *last_obstacle = last_frame.obstacles_.Find(
+              common::util::StrCat(perception_id, "_", i));
+          if (last_obstacle == nullptr) {
+            break;
+          }
+          last_obstacles.push_back(last_obstacle);
+        }
+      }
+      if (!last_obstacles.empty()) {
+        for (const auto *last_obstacle : last_obstacles) {
+          AddObstacle(*last_obstacle);
+        }
+        ++num_reused;
+        continue;
+      }
+    }
+    std::list<std::unique_ptr<Obstacle>> obstacles;
+    Obstacle::AppendObstacles(prediction_obstacle, &obstacles);
+    for (auto &ptr : obstacles) {
+      AddObstacle(*ptr);
+    }
+  }
+  ADEBUG << "Reused " << num_reused << " of "
+         << prediction_.prediction_obstacle_size()
+         << " prediction obstacles from the last frame.";
+}
+
 const Obstacle *Frame::AddStaticVirtualObstacle(const std::string &id,
                                                 const Box2d &box) {
+  std::lock_guard<std::mutex> lock(virtual_obstacle_mutex_);
   const auto *object = obstacles_.Find(id);
   if (object) {
     AWARN << "obstacle " << id << " already exist.";
@@ -260,8 +360,13 @@ Status Frame::Init() {
     if (FLAGS_align_prediction_time) {
       AlignPredictionTime(vehicle_state_.timestamp(), &prediction_);
     }
-    for (auto &ptr : Obstacle::CreateObstacles(prediction_)) {
-      AddObstacle(*ptr);
+    const auto *last_frame = FrameHistory::instance()->Latest();
+    if (FLAGS_enable_incremental_frame && last_frame != nullptr) {
+      AddObstaclesIncrementally(*last_frame);
+    } else {
+      for (auto &ptr : Obstacle::CreateObstacles(prediction_)) {
+        AddObstacle(*ptr);
+      }
     }
   }
   const auto *collision_obstacle = FindCollisionObstacle();
@@ -24,9 +24,12 @@
 #include <cstdint>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "google/protobuf/arena.h"
+
 #include "modules/common/proto/geometry.pb.h"
 #include "modules/common/proto/vehicle_state.pb.h"
 #include "modules/localization/proto/pose.pb.h"
@@ -65,6 +68,11 @@ class Frame {
 
   uint32_t SequenceNum() const;
 
+  /**
+   * @brief the time in seconds when the planning cycle of the frame started.
+   */
+  double start_time() const { return start_time_; }
+
   std::string DebugString() const;
 
   const PublishableTrajectory &ComputedTrajectory() const;
@@ -94,9 +102,19 @@ class Frame {
       const double planning_start_time,
       prediction::PredictionObstacles *prediction_obstacles);
 
-  ADCTrajectory *mutable_trajectory() { return &trajectory_; }
+  ADCTrajectory *mutable_trajectory() { return trajectory_; }
+
+  const ADCTrajectory &trajectory() const { return *trajectory_; }
+
+  /**
+   * @brief whether the planning debug of this frame is recorded. It is
+   * FLAGS_enable_record_debug unless set otherwise.
+   */
+  bool record_debug() const { return record_debug_; }
 
-  const ADCTrajectory &trajectory() const { return trajectory_; }
+  void set_record_debug(const bool record_debug) {
+    record_debug_ = record_debug;
+  }
 
  private:
   bool CreateReferenceLineInfo();
@@ -118,6 +136,19 @@ class Frame {
    */
   int CreateDestinationObstacle();
 
+  /**
+   * @brief adds the obstacles of prediction_. The obstacles whose prediction
+   * did not change since last_frame are copied from it instead of being
+   * built again.
+   */
+  void AddObstaclesIncrementally(const Frame &last_frame);
+
+  /**
+   * @brief lets every reference line info reuse the SL boundaries of the
+   * reference line info of last_frame that has the same reference line.
+   */
+  void LinkLastReferenceLineInfo(const Frame &last_frame);
+
  private:
   uint32_t sequence_num_ = 0;
   const hdmap::HDMap *hdmap_ = nullptr;
@@ -136,9 +167,18 @@ class Frame {
 
   ThreadSafeIndexedObstacles obstacles_;
 
+  /// Makes AddStaticVirtualObstacle() atomic when reference lines are
+  /// planned concurrently.
+  std::mutex virtual_obstacle_mutex_;
+
   ChangeLaneDecider change_lane_decider_;
 
-  ADCTrajectory trajectory_;  // last published trajectory
+  /// The published trajectory and its debug hold thousands of small
+  /// messages, so they are allocated from an arena and released at once
+  /// with the frame.
+  google::protobuf::Arena trajectory_arena_;
+  ADCTrajectory *trajectory_ = nullptr;  // last published trajectory
+  bool record_debug_ = false;
 
   std::unique_ptr<LagPrediction> lag_predictor_;
 };
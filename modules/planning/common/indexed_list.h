@@ -21,8 +21,10 @@
 #ifndef MODULES_PLANNING_COMMON_INDEXED_LIST_H_
 #define MODULES_PLANNING_COMMON_INDEXED_LIST_H_
 
+#include <algorithm>
+#include <deque>
+#include <functional>
 #include <memory>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -30,14 +32,44 @@
 #include "boost/thread/shared_mutex.hpp"
 
 #include "modules/common/log.h"
-#include "modules/common/util/map_util.h"
 
 namespace apollo {
 namespace planning {
 
+/**
+ * @class IndexedList
+ *
+ * @brief A container of objects indexed by id, listed in insertion order.
+ *
+ * The objects are stored in a deque, so they are contiguous in chunks and
+ * never move once added. The ids are looked up in an open addressing table
+ * of handles, the positions of the objects in the insertion order, which
+ * keeps the hash of every id so a probe compares ids only on equal hashes.
+ */
 template <typename I, typename T>
 class IndexedList {
  public:
+  IndexedList() = default;
+
+  IndexedList(const IndexedList& other)
+      : ids_(other.ids_),
+        hashes_(other.hashes_),
+        objects_(other.objects_),
+        table_(other.table_) {
+    RebuildObjectList();
+  }
+
+  IndexedList& operator=(const IndexedList& other) {
+    if (this != &other) {
+      ids_ = other.ids_;
+      hashes_ = other.hashes_;
+      objects_ = other.objects_;
+      table_ = other.table_;
+      RebuildObjectList();
+    }
+    return *this;
+  }
+
   /**
    * @brief copy object into the container. If the id is already exist,
    * overwrite the object in the container.
@@ -46,18 +78,24 @@ class IndexedList {
    * container.
    * @return The pointer to the object in the container.
    */
-  T* Add(const I id, const T& object) {
-    auto obs = Find(id);
-    if (obs) {
+  T* Add(const I& id, const T& object) {
+    const size_t hash = std::hash<I>()(id);
+    const int handle = FindHandle(id, hash);
+    if (handle >= 0) {
       AWARN << "object " << id << " is already in container";
-      *obs = object;
-      return obs;
-    } else {
-      object_dict_.insert({id, object});
-      auto* ptr = &object_dict_.at(id);
-      object_list_.push_back(ptr);
-      return ptr;
+      objects_[handle] = object;
+      return &objects_[handle];
+    }
+    if ((ids_.size() + 1) * 2 > table_.size()) {
+      Rehash(std::max<size_t>(kMinTableSize, table_.size() * 2));
     }
+    const int new_handle = static_cast<int>(objects_.size());
+    ids_.push_back(id);
+    hashes_.push_back(hash);
+    objects_.push_back(object);
+    object_list_.push_back(&objects_.back());
+    InsertHandle(new_handle);
+    return &objects_.back();
   }
 
   /**
@@ -66,8 +104,9 @@ class IndexedList {
    * @return the raw pointer to the object if found.
    * @return nullptr if the object is not found.
    */
-  T* Find(const I id) {
-    return apollo::common::util::FindOrNull(object_dict_, id);
+  T* Find(const I& id) {
+    const int handle = FindHandle(id);
+    return handle < 0 ? nullptr : &objects_[handle];
   }
 
   /**
@@ -76,30 +115,114 @@ class IndexedList {
    * @return the raw pointer to the object if found.
    * @return nullptr if the object is not found.
    */
-  const T* Find(const I id) const {
-    return apollo::common::util::FindOrNull(object_dict_, id);
+  const T* Find(const I& id) const {
+    const int handle = FindHandle(id);
+    return handle < 0 ? nullptr : &objects_[handle];
+  }
+
+  /**
+   * @brief Find the handle of an object, its position in Items(), which
+   * stays valid as long as the container lives.
+   * @param id the id of the object
+   * @return the handle, or -1 if the object is not found.
+   */
+  int FindHandle(const I& id) const {
+    return FindHandle(id, std::hash<I>()(id));
+  }
+
+  /**
+   * @brief Get the object of a handle without hashing its id.
+   * @param handle a handle in [0, Items().size()).
+   */
+  T* At(const int handle) {
+    DCHECK(handle >= 0 && handle < static_cast<int>(objects_.size()));
+    return &objects_[handle];
+  }
+
+  const T* At(const int handle) const {
+    DCHECK(handle >= 0 && handle < static_cast<int>(objects_.size()));
+    return &objects_[handle];
   }
 
   /**
    * @brief List all the items in the container.
    * @return the list of const raw pointers of the objects in the container.
    */
-  const std::vector<const T*>& Items() const { return object_list_; }
+  const std::vector<const T* >& Items() const { return object_list_; }
 
  private:
-  std::vector<const T*> object_list_;
-  std::unordered_map<I, T> object_dict_;
+  static constexpr size_t kMinTableSize = 16;
+  static constexpr int kEmptySlot = -1;
+
+  int FindHandle(const I& id, const size_t hash) const {
+    if (table_.empty()) {
+      return -1;
+    }
+    const size_t mask = table_.size() - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+      const int handle = table_[i];
+      if (handle == kEmptySlot) {
+        return -1;
+      }
+      if (hashes_[handle] == hash && ids_[handle] == id) {
+        return handle;
+      }
+    }
+  }
+
+  void InsertHandle(const int handle) {
+    const size_t mask = table_.size() - 1;
+    size_t i = hashes_[handle] & mask;
+    while (table_[i] != kEmptySlot) {
+      i = (i + 1) & mask;
+    }
+    table_[i] = handle;
+  }
+
+  // The table size is a power of two, at least twice the number of ids.
+  void Rehash(const size_t table_size) {
+    table_.assign(table_size, kEmptySlot);
+    for (size_t handle = 0; handle < ids_.size(); ++handle) {
+      InsertHandle(static_cast<int>(handle));
+    }
+  }
+
+  void RebuildObjectList() {
+    object_list_.clear();
+    object_list_.reserve(objects_.size());
+    for (const auto& object : objects_) {
+      object_list_.push_back(&object);
+    }
+  }
+
+  std::vector<I> ids_;
+  std::vector<size_t> hashes_;
+  std::deque<T> objects_;
+  std::vector<const T* > object_list_;
+  // The handles of the ids, kEmptySlot for the empty slots.
+  std::vector<int> table_;
 };
 
+template <typename I, typename T>
+constexpr size_t IndexedList<I, T>::kMinTableSize;
+
+template <typename I, typename T>
+constexpr int IndexedList<I, T>::kEmptySlot;
+
 template <typename I, typename T>
 class ThreadSafeIndexedList : public IndexedList<I, T> {
  public:
-  T* Add(const I id, const T& object) {
+  T* Add(const I& id, const T& object) {
     boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
     return IndexedList<I, T>::Add(id, object);
   }
 
-  T* Find(const I id) {
+  T* Find(const I& id) {
+    boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
+    return IndexedList<I, T>::Find(id);
+  }
+
+  const T* Find(const I& id) const {
     boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
     return IndexedList<I, T>::Find(id);
   }
@@ -19,6 +19,7 @@
  **/
 
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -67,5 +68,41 @@ TEST(IndexedList, Find) {
   ASSERT_EQ(nullptr, object.Find(2));
 }
 
+TEST(IndexedList, Handle) {
+  IndexedList<std::string, int> object;
+  std::vector<const int*> added;
+  for (int i = 0; i < 100; ++i) {
+    added.push_back(object.Add(std::to_string(i), i));
+  }
+  ASSERT_EQ(100, object.Items().size());
+  for (int i = 0; i < 100; ++i) {
+    const int handle = object.FindHandle(std::to_string(i));
+    ASSERT_EQ(i, handle);
+    // the objects do not move when the container grows
+    EXPECT_EQ(added[i], object.At(handle));
+    EXPECT_EQ(added[i], object.Find(std::to_string(i)));
+    EXPECT_EQ(added[i], object.Items()[i]);
+  }
+  EXPECT_EQ(-1, object.FindHandle("100"));
+  EXPECT_EQ(nullptr, object.Find("100"));
+}
+
+TEST(IndexedList, Copy) {
+  IndexedList<std::string, int> object;
+  object.Add("one", 1);
+  object.Add("two", 2);
+  IndexedList<std::string, int> copy(object);
+  *copy.Find("one") = 10;
+  EXPECT_EQ(1, *object.Find("one"));
+  ASSERT_EQ(2, copy.Items().size());
+  EXPECT_EQ(copy.Find("one"), copy.Items()[0]);
+  EXPECT_EQ(10, *copy.Items()[0]);
+
+  object = copy;
+  EXPECT_EQ(10, *object.Find("one"));
+  EXPECT_EQ(object.Find("two"), object.Items()[1]);
+  EXPECT_NE(copy.Items()[1], object.Items()[1]);
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -181,38 +181,45 @@ std::list<std::unique_ptr<Obstacle>> Obstacle::CreateObstacles(
     const prediction::PredictionObstacles& predictions) {
   std::list<std::unique_ptr<Obstacle>> obstacles;
   for (const auto& prediction_obstacle : predictions.prediction_obstacle()) {
-    const auto perception_id =
-        std::to_string(prediction_obstacle.perception_obstacle().id());
-    if (prediction_obstacle.trajectory().empty()) {
-      obstacles.emplace_back(new Obstacle(
-          perception_id, prediction_obstacle.perception_obstacle()));
-      continue;
-    }
+    AppendObstacles(prediction_obstacle, &obstacles);
+  }
+  return obstacles;
+}
 
-    int trajectory_index = 0;
-    for (const auto& trajectory : prediction_obstacle.trajectory()) {
-      bool is_valid_trajectory = true;
-      for (const auto& point : trajectory.trajectory_point()) {
-        if (!IsValidTrajectoryPoint(point)) {
-          AERROR << "obj:" << perception_id
-                 << " TrajectoryPoint: " << trajectory.ShortDebugString()
-                 << " is NOT valid.";
-          is_valid_trajectory = false;
-          break;
-        }
-      }
-      if (!is_valid_trajectory) {
-        continue;
-      }
+void Obstacle::AppendObstacles(
+    const prediction::PredictionObstacle& prediction_obstacle,
+    std::list<std::unique_ptr<Obstacle>>* obstacles) {
+  CHECK_NOTNULL(obstacles);
+  const auto perception_id =
+      std::to_string(prediction_obstacle.perception_obstacle().id());
+  if (prediction_obstacle.trajectory().empty()) {
+    obstacles->emplace_back(
+        new Obstacle(perception_id, prediction_obstacle.perception_obstacle()));
+    return;
+  }
 
-      const std::string obstacle_id =
-          apollo::common::util::StrCat(perception_id, "_", trajectory_index);
-      obstacles.emplace_back(new Obstacle(
-          obstacle_id, prediction_obstacle.perception_obstacle(), trajectory));
-      ++trajectory_index;
+  int trajectory_index = 0;
+  for (const auto& trajectory : prediction_obstacle.trajectory()) {
+    bool is_valid_trajectory = true;
+    for (const auto& point : trajectory.trajectory_point()) {
+      if (!IsValidTrajectoryPoint(point)) {
+        AERROR << "obj:" << perception_id
+               << " TrajectoryPoint: " << trajectory.ShortDebugString()
+               << " is NOT valid.";
+        is_valid_trajectory = false;
+        break;
+      }
+    }
+    if (!is_valid_trajectory) {
+      continue;
     }
+
+    const std::string obstacle_id =
+        apollo::common::util::StrCat(perception_id, "_", trajectory_index);
+    obstacles->emplace_back(new Obstacle(
+        obstacle_id, prediction_obstacle.perception_obstacle(), trajectory));
+    ++trajectory_index;
   }
-  return obstacles;
 }
 
 bool Obstacle::IsValidTrajectoryPoint(const common::TrajectoryPoint& point) {
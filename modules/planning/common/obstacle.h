@@ -94,6 +94,16 @@ class Obstacle {
   static std::list<std::unique_ptr<Obstacle>> CreateObstacles(
       const prediction::PredictionObstacles &predictions);
 
+  /**
+   * @brief Creates the obstacles of one prediction obstacle the same way as
+   * CreateObstacles(), and appends them to obstacles.
+   * @param prediction_obstacle The prediction of one perception obstacle
+   * @param obstacles The list the created obstacles are appended to
+   */
+  static void AppendObstacles(
+      const prediction::PredictionObstacle &prediction_obstacle,
+      std::list<std::unique_ptr<Obstacle>> *obstacles);
+
   static std::unique_ptr<Obstacle> CreateStaticVirtualObstacles(
       const std::string &id, const common::math::Box2d &obstacle_box);
 
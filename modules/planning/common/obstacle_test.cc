@@ -96,6 +96,26 @@ TEST_F(ObstacleTest, CreateObstacles) {
   EXPECT_TRUE(indexed_obstacles_.Find("2161"));
 }
 
+TEST_F(ObstacleTest, AppendObstacles) {
+  prediction::PredictionObstacles prediction_obstacles;
+  ASSERT_TRUE(common::util::GetProtoFromFile(
+      "modules/planning/common/testdata/sample_prediction.pb.txt",
+      &prediction_obstacles));
+  std::list<std::unique_ptr<Obstacle>> obstacles;
+  for (const auto& prediction_obstacle :
+       prediction_obstacles.prediction_obstacle()) {
+    Obstacle::AppendObstacles(prediction_obstacle, &obstacles);
+  }
+  ASSERT_EQ(indexed_obstacles_.Items().size(), obstacles.size());
+  auto iter = obstacles.begin();
+  for (const auto* obstacle : indexed_obstacles_.Items()) {
+    EXPECT_EQ(obstacle->Id(), (*iter)->Id());
+    EXPECT_EQ(obstacle->Trajectory().trajectory_point_size(),
+              (*iter)->Trajectory().trajectory_point_size());
+    ++iter;
+  }
+}
+
 TEST_F(ObstacleTest, Id) {
   const auto* obstacle = indexed_obstacles_.Find("2156_0");
   ASSERT_TRUE(obstacle);
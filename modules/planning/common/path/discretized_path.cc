@@ -61,8 +61,14 @@ double DiscretizedPath::Length() const {
 
 common::PathPoint DiscretizedPath::EvaluateUsingLinearApproximation(
     const double path_s) const {
+  std::size_t index_hint = 0;
+  return EvaluateUsingLinearApproximation(path_s, &index_hint);
+}
+
+common::PathPoint DiscretizedPath::EvaluateUsingLinearApproximation(
+    const double path_s, std::size_t *index_hint) const {
   CHECK(!path_points_.empty());
-  auto it_lower = QueryLowerBound(path_s);
+  auto it_lower = QueryLowerBound(path_s, index_hint);
   if (it_lower == path_points_.begin()) {
     return path_points_.front();
   }
@@ -73,6 +79,18 @@ common::PathPoint DiscretizedPath::EvaluateUsingLinearApproximation(
                                                    path_s);
 }
 
+void DiscretizedPath::EvaluateManyUsingLinearApproximation(
+    const std::vector<double> &path_s,
+    std::vector<common::PathPoint> *const path_points) const {
+  CHECK_NOTNULL(path_points);
+  path_points->clear();
+  path_points->reserve(path_s.size());
+  std::size_t index_hint = 0;
+  for (const double s : path_s) {
+    path_points->push_back(EvaluateUsingLinearApproximation(s, &index_hint));
+  }
+}
+
 const std::vector<common::PathPoint> &DiscretizedPath::path_points() const {
   return path_points_;
 }
@@ -102,5 +120,14 @@ std::vector<common::PathPoint>::const_iterator DiscretizedPath::QueryLowerBound(
                           func);
 }
 
+std::vector<common::PathPoint>::const_iterator DiscretizedPath::QueryLowerBound(
+    const double path_s, std::size_t *index_hint) const {
+  auto func = [](const common::PathPoint &tp, const double path_s) {
+    return tp.s() < path_s;
+  };
+  return util::LowerBoundWithHint(path_points_.begin(), path_points_.end(),
+                                  path_s, func, index_hint);
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -21,6 +21,7 @@
 #ifndef MODULES_PLANNING_COMMON_PATH_DISCRETIZED_PATH_H_
 #define MODULES_PLANNING_COMMON_PATH_DISCRETIZED_PATH_H_
 
+#include <cstddef>
 #include <vector>
 
 #include "modules/common/proto/pnc_point.pb.h"
@@ -48,6 +49,21 @@ class DiscretizedPath {
 
   common::PathPoint EvaluateUsingLinearApproximation(const double path_s) const;
 
+  /**
+   * @brief Evaluates the path at path_s, searching it from *index_hint, which
+   * is updated. Evaluating an increasing or decreasing sequence of s with the
+   * same hint costs an amortized constant time per point.
+   */
+  common::PathPoint EvaluateUsingLinearApproximation(
+      const double path_s, std::size_t* index_hint) const;
+
+  /**
+   * @brief Evaluates the path at each of the sorted path_s.
+   */
+  void EvaluateManyUsingLinearApproximation(
+      const std::vector<double>& path_s,
+      std::vector<common::PathPoint>* const path_points) const;
+
   const std::vector<common::PathPoint>& path_points() const;
 
   std::uint32_t NumOfPoints() const;
@@ -58,6 +74,9 @@ class DiscretizedPath {
   std::vector<common::PathPoint>::const_iterator QueryLowerBound(
       const double path_s) const;
 
+  std::vector<common::PathPoint>::const_iterator QueryLowerBound(
+      const double path_s, std::size_t* index_hint) const;
+
   std::vector<common::PathPoint> path_points_;
 };
 
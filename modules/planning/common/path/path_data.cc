@@ -205,14 +205,20 @@ bool PathData::XYToSL(const DiscretizedPath &discretized_path,
                       FrenetFramePath *const frenet_path) {
   CHECK_NOTNULL(frenet_path);
   CHECK_NOTNULL(reference_line_);
+  std::vector<common::math::Vec2d> xy_points;
+  xy_points.reserve(discretized_path.path_points().size());
+  for (const auto &path_point : discretized_path.path_points()) {
+    xy_points.emplace_back(path_point.x(), path_point.y());
+  }
+  std::vector<SLPoint> sl_points;
+  if (!reference_line_->XYToSL(xy_points, true, &sl_points)) {
+    AERROR << "Fail to transfer cartesian point to frenet point.";
+    return false;
+  }
   std::vector<common::FrenetFramePoint> frenet_frame_points;
+  frenet_frame_points.reserve(sl_points.size());
   const double max_len = reference_line_->Length();
-  for (const auto &path_point : discretized_path.path_points()) {
-    SLPoint sl_point;
-    if (!reference_line_->XYToSL({path_point.x(), path_point.y()}, &sl_point)) {
-      AERROR << "Fail to transfer cartesian point to frenet point.";
-      return false;
-    }
+  for (const auto &sl_point : sl_points) {
     common::FrenetFramePoint frenet_point;
     // NOTICE: does not set dl and ddl here. Add if needed.
     frenet_point.set_s(std::max(0.0, std::min(sl_point.s(), max_len)));
@@ -71,9 +71,10 @@ bool PathDecision::AddLateralDecision(const std::string &tag,
 }
 
 void PathDecision::EraseStBoundaries() {
-  for (const auto *path_obstacle : path_obstacles_.Items()) {
-    auto *obstacle_ptr = path_obstacles_.Find(path_obstacle->Id());
-    obstacle_ptr->EraseStBoundary();
+  const int num_obstacles =
+      static_cast<int>(path_obstacles_.Items().size());
+  for (int handle = 0; handle < num_obstacles; ++handle) {
+    path_obstacles_.At(handle)->EraseStBoundary();
   }
 }
 
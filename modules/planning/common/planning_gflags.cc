@@ -86,6 +86,15 @@ DEFINE_double(spiral_smoother_piecewise_length, 10.0,
               "The piecewise length of spiral smoother.");
 DEFINE_double(spiral_reference_line_resolution, 0.02,
               "The output resolution for reference line.");
+DEFINE_bool(enable_spiral_smoother_warm_start, false,
+            "Initialize the spiral smoother with the heading and curvature of "
+            "the last smoothed reference line.");
+DEFINE_bool(enable_reference_line_smoothing_cache, false,
+            "Reuse the smoothed reference line of the last cycle when the "
+            "route segment lane ranges are unchanged.");
+DEFINE_bool(enable_reference_line_path_cache, true,
+            "Share the map path created in the last cycle when the route "
+            "segment lane ranges are unchanged.");
 DEFINE_bool(prioritize_change_lane, false,
             "change lane strategy has higher priority, always use a valid "
             "change lane path if such path exists");
@@ -301,6 +310,9 @@ DEFINE_int32(trajectory_point_num_for_debug, 10,
 
 DEFINE_bool(enable_record_debug, true,
             "True to enable record debug into debug protobuf.");
+DEFINE_bool(record_debug_without_subscriber, false,
+            "True to record debug into debug protobuf even when the planning "
+            "topic has no subscriber.");
 DEFINE_bool(enable_prediction, true, "True to enable prediction input.");
 
 DEFINE_bool(enable_lag_prediction, true,
@@ -330,13 +342,68 @@ DEFINE_bool(enable_follow_accel_constraint, true,
 
 // SQP solver
 DEFINE_bool(enable_sqp_solver, true, "True to enable SQP solver.");
+DEFINE_bool(enable_sparse_qp_solver, false,
+            "True to solve the spline QPs with the sparse ADMM solver, warm "
+            "started from the last solution, instead of qpOASES.");
 
 /// thread pool
 
 DEFINE_int32(num_thread_planning_thread_pool, 5,
              "num of thread used in planning thread pool.");
+DEFINE_string(planning_thread_pool_cpu_ids, "",
+              "Comma separated cpu ids the planning thread pool workers are "
+              "pinned to, e.g. \"2,3\". Empty means no pinning.");
 DEFINE_bool(
     enable_multi_thread_in_dp_poly_path, false,
     "Enable multiple thread to calculation curve cost in dp_poly_path.");
+DEFINE_bool(enable_parallel_reference_line_planning, false,
+            "Plan all the reference lines concurrently on the planning "
+            "thread pool.");
+DEFINE_bool(enable_incremental_frame, false,
+            "Reuse the obstacles and SL boundaries of the last frame when "
+            "their prediction and reference line did not change.");
+DEFINE_bool(enable_parallel_st_boundary_mapping, false,
+            "Map the st boundaries of the obstacles concurrently on the "
+            "planning thread pool.");
 DEFINE_bool(enable_multi_thread_in_dp_st_graph, false,
             "Enable multiple thread to calculation curve cost in dp_st_graph.");
+DEFINE_bool(enable_dp_st_graph_warm_start, false,
+            "Search dp_st_graph around the speed profile of the last cycle "
+            "first, and search the whole graph only if that fails.");
+DEFINE_double(dp_st_graph_warm_start_band, 10.0,
+              "The half width in meters of the band around the last speed "
+              "profile searched by a warm started dp_st_graph.");
+DEFINE_bool(enable_multi_thread_in_poly_st_graph, false,
+            "Enable multiple thread to evaluate the speed profiles in "
+            "poly_st_graph.");
+DEFINE_bool(enable_multi_thread_in_qp_frenet_frame, false,
+            "Enable multiple thread to map the obstacles in qp_frenet_frame.");
+
+DEFINE_bool(enable_task_profiler, false,
+            "Profile every planning task and record the per-task latency "
+            "with its rolling p50/p99 into the planning debug.");
+DEFINE_int32(task_profiler_window_size, 200,
+             "Number of the latest runs of each task used to compute the "
+             "rolling latency percentiles.");
+
+DEFINE_bool(enable_anytime_planning, false,
+            "Lower the quality of the remaining tasks of a planning cycle "
+            "when their predicted run time, from their rolling latency p99, "
+            "would overrun the deadline of the cycle.");
+DEFINE_double(anytime_planning_deadline_ms, 100.0,
+              "The deadline of a planning cycle in ms since the start of "
+              "the cycle, used by the anytime planning.");
+
+DEFINE_bool(enable_planning_flight_recorder, false,
+            "Keep the latest planning inputs and outputs in memory and dump "
+            "them to a file on a takeover, an estop or a planning failure.");
+DEFINE_int32(planning_flight_recorder_size_mb, 64,
+             "Memory of the serialized messages kept by the flight recorder.");
+DEFINE_int32(planning_flight_recorder_max_records, 4096,
+             "Number of the messages kept by the flight recorder.");
+DEFINE_double(planning_flight_recorder_duration, 10.0,
+              "Seconds of the latest messages kept by the flight recorder.");
+DEFINE_double(planning_flight_recorder_min_dump_interval, 10.0,
+              "Minimal seconds between two flight recorder dumps.");
+DEFINE_string(planning_flight_recorder_dir, "/apollo/data/log",
+              "Directory of the flight recorder dumps.");
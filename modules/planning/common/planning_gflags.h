@@ -45,6 +45,9 @@ DECLARE_double(spiral_smoother_max_deviation);
 DECLARE_int32(spiral_smoother_num_iteration);
 DECLARE_double(spiral_smoother_piecewise_length);
 DECLARE_double(spiral_reference_line_resolution);
+DECLARE_bool(enable_spiral_smoother_warm_start);
+DECLARE_bool(enable_reference_line_smoothing_cache);
+DECLARE_bool(enable_reference_line_path_cache);
 
 DECLARE_bool(prioritize_change_lane);
 DECLARE_bool(reckless_change_lane);
@@ -133,6 +136,7 @@ DECLARE_double(lag_prediction_protection_distance);
 DECLARE_double(perception_confidence_threshold);
 
 DECLARE_bool(enable_record_debug);
+DECLARE_bool(record_debug_without_subscriber);
 DECLARE_bool(enable_prediction);
 DECLARE_bool(enable_traffic_light);
 
@@ -173,10 +177,35 @@ DECLARE_string(stop_sign_virtual_object_id_prefix);
 DECLARE_double(stop_duration_for_stop_sign);
 
 DECLARE_bool(enable_sqp_solver);
+DECLARE_bool(enable_sparse_qp_solver);
 
 /// thread pool
 DECLARE_int32(num_thread_planning_thread_pool);
+DECLARE_string(planning_thread_pool_cpu_ids);
 DECLARE_bool(enable_multi_thread_in_dp_poly_path);
 DECLARE_bool(enable_multi_thread_in_dp_st_graph);
+DECLARE_bool(enable_multi_thread_in_poly_st_graph);
+DECLARE_bool(enable_multi_thread_in_qp_frenet_frame);
+DECLARE_bool(enable_dp_st_graph_warm_start);
+DECLARE_double(dp_st_graph_warm_start_band);
+DECLARE_bool(enable_parallel_reference_line_planning);
+DECLARE_bool(enable_parallel_st_boundary_mapping);
+DECLARE_bool(enable_incremental_frame);
+
+/// task profiler
+DECLARE_bool(enable_task_profiler);
+DECLARE_int32(task_profiler_window_size);
+
+/// anytime planning
+DECLARE_bool(enable_anytime_planning);
+DECLARE_double(anytime_planning_deadline_ms);
+
+/// flight recorder
+DECLARE_bool(enable_planning_flight_recorder);
+DECLARE_int32(planning_flight_recorder_size_mb);
+DECLARE_int32(planning_flight_recorder_max_records);
+DECLARE_double(planning_flight_recorder_duration);
+DECLARE_double(planning_flight_recorder_min_dump_interval);
+DECLARE_string(planning_flight_recorder_dir);
 
 #endif  // MODULES_PLANNING_COMMON_PLANNING_GFLAGS_H
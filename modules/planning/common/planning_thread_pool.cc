@@ -20,6 +20,11 @@
 
 #include "modules/planning/common/planning_thread_pool.h"
 
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "modules/common/util/string_tokenizer.h"
 #include "modules/planning/common/planning_gflags.h"
 
 namespace apollo {
@@ -31,8 +36,13 @@ void PlanningThreadPool::Init() {
   if (is_initialized) {
     return;
   }
-  thread_pool_.reset(
-      new common::util::ThreadPool(FLAGS_num_thread_planning_thread_pool));
+  std::vector<int> cpu_ids;
+  for (const std::string& cpu_id : common::util::StringTokenizer::Split(
+           FLAGS_planning_thread_pool_cpu_ids, ", ")) {
+    cpu_ids.push_back(std::atoi(cpu_id.c_str()));
+  }
+  thread_pool_.reset(new common::util::WorkStealingThreadPool(
+      FLAGS_num_thread_planning_thread_pool, cpu_ids));
   is_initialized = true;
 }
 
@@ -24,7 +24,7 @@
 #include <memory>
 
 #include "modules/common/macro.h"
-#include "modules/common/util/ctpl_stl.h"
+#include "modules/common/util/work_stealing_thread_pool.h"
 
 namespace apollo {
 namespace planning {
@@ -38,17 +38,17 @@ namespace planning {
 class PlanningThreadPool {
  public:
   void Init();
-  common::util::ThreadPool* mutable_thread_pool() {
+  common::util::WorkStealingThreadPool* mutable_thread_pool() {
     return thread_pool_.get();
   }
   void Stop() {
     if (thread_pool_) {
-      thread_pool_->Stop(false);
+      thread_pool_->Stop();
     }
   }
 
  private:
-  std::unique_ptr<common::util::ThreadPool> thread_pool_;
+  std::unique_ptr<common::util::WorkStealingThreadPool> thread_pool_;
   bool is_initialized = false;
 
   DECLARE_SINGLETON(PlanningThreadPool);
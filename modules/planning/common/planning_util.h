@@ -21,6 +21,8 @@
 #ifndef MODULES_PLANNING_UTIL_PLANNING_UTIL_H_
 #define MODULES_PLANNING_UTIL_PLANNING_UTIL_H_
 
+#include <algorithm>
+#include <cstddef>
 #include <string>
 
 #include "modules/common/proto/pnc_point.pb.h"
@@ -53,6 +55,40 @@ common::TrajectoryPoint InterpolateUsingLinearApproximation(
 
 void DumpPlanningContext();
 
+/**
+ * @brief Finds the lower bound of value in the sorted range [begin, end) like
+ * std::lower_bound, but searching from *hint, the index found by a previous
+ * search, which is then updated. The search gallops from the hint, so that
+ * the searches of a monotone sequence of values cost an amortized constant
+ * time each.
+ */
+template <typename Iterator, typename T, typename Less>
+Iterator LowerBoundWithHint(Iterator begin, Iterator end, const T &value,
+                            Less less, std::size_t *hint) {
+  const std::size_t size = std::distance(begin, end);
+  const std::size_t index = std::min(*hint, size);
+  Iterator first;
+  Iterator last;
+  std::size_t bound = 1;
+  if (index > 0 && !less(*(begin + index - 1), value)) {
+    // the lower bound is before the hint
+    while (bound < index && !less(*(begin + index - 1 - bound), value)) {
+      bound *= 2;
+    }
+    first = begin + (bound < index ? index - bound : 0);
+    last = begin + index - bound / 2;
+  } else {
+    while (index + bound <= size && less(*(begin + index + bound - 1), value)) {
+      bound *= 2;
+    }
+    first = begin + index + bound / 2;
+    last = begin + std::min(size, index + bound);
+  }
+  const Iterator it = std::lower_bound(first, last, value, less);
+  *hint = std::distance(begin, it);
+  return it;
+}
+
 }  // namespace util
 }  // namespace planning
 }  // namespace apollo
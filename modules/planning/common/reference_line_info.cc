@@ -61,6 +61,13 @@ namespace {
 std::string junction_dropbox_id(const std::string& junction_id) {
   return "junction_protection_" + junction_id;
 }
+
+bool IsSameBox(const Box2d& box1, const Box2d& box2) {
+  return box1.center_x() == box2.center_x() &&
+         box1.center_y() == box2.center_y() &&
+         box1.heading() == box2.heading() && box1.length() == box2.length() &&
+         box1.width() == box2.width();
+}
 }
 
 bool ReferenceLineInfo::Init(const std::vector<const Obstacle*>& obstacles) {
@@ -89,7 +96,9 @@ bool ReferenceLineInfo::Init(const std::vector<const Obstacle*>& obstacles) {
     return false;
   }
   is_on_reference_line_ = reference_line_.IsOnRoad(adc_sl_boundary_);
-  if (!AddObstacles(obstacles)) {
+  const bool added = AddObstacles(obstacles);
+  last_reference_line_info_ = nullptr;
+  if (!added) {
     AERROR << "Failed to add obstacles to reference line";
     return false;
   }
@@ -120,9 +129,10 @@ ADCTrajectory::RightOfWayStatus ReferenceLineInfo::GetRightOfWayStatus() const {
     if (overlap.end_s < adc_sl_boundary_.start_s()) {
       junction_store->Remove(junction_dropbox_id(overlap.object_id));
     } else if (WithinOverlap(overlap, adc_sl_boundary_.end_s())) {
-      auto* is_protected =
-          junction_store->Get(junction_dropbox_id(overlap.object_id));
-      if (is_protected != nullptr && *is_protected) {
+      bool is_protected = false;
+      if (junction_store->Get(junction_dropbox_id(overlap.object_id),
+                              &is_protected) &&
+          is_protected) {
         return ADCTrajectory::PROTECTED;
       } else {
         double junction_s = (overlap.end_s + overlap.start_s) / 2.0;
@@ -184,7 +194,8 @@ PathObstacle* ReferenceLineInfo::AddObstacle(const Obstacle* obstacle) {
   }
 
   SLBoundary perception_sl;
-  if (!reference_line_.GetSLBoundary(obstacle->PerceptionBoundingBox(),
+  if (!GetLastPerceptionSLBoundary(*obstacle, &perception_sl) &&
+      !reference_line_.GetSLBoundary(obstacle->PerceptionBoundingBox(),
                                      &perception_sl)) {
     AERROR << "Failed to get sl boundary for obstacle: " << obstacle->Id();
     return path_obstacle;
@@ -210,6 +221,28 @@ PathObstacle* ReferenceLineInfo::AddObstacle(const Obstacle* obstacle) {
   return path_obstacle;
 }
 
+void ReferenceLineInfo::SetLastReferenceLineInfo(
+    const ReferenceLineInfo* last_reference_line_info) {
+  last_reference_line_info_ = last_reference_line_info;
+}
+
+bool ReferenceLineInfo::GetLastPerceptionSLBoundary(
+    const Obstacle& obstacle, SLBoundary* sl_boundary) const {
+  if (last_reference_line_info_ == nullptr) {
+    return false;
+  }
+  const auto* last_path_obstacle =
+      last_reference_line_info_->path_decision().Find(obstacle.Id());
+  if (last_path_obstacle == nullptr ||
+      !last_path_obstacle->PerceptionSLBoundary().has_start_s() ||
+      !IsSameBox(last_path_obstacle->obstacle()->PerceptionBoundingBox(),
+                 obstacle.PerceptionBoundingBox())) {
+    return false;
+  }
+  *sl_boundary = last_path_obstacle->PerceptionSLBoundary();
+  return true;
+}
+
 bool ReferenceLineInfo::AddObstacles(
     const std::vector<const Obstacle*>& obstacles) {
   for (const auto* obstacle : obstacles) {
@@ -282,11 +315,16 @@ bool ReferenceLineInfo::CombinePathAndSpeedProfile(
     AWARN << "path data is empty";
     return false;
   }
+  // both the time and the path s increase, so the searches go on from the
+  // last points
+  std::size_t speed_index = 0;
+  std::size_t path_index = 0;
   for (double cur_rel_time = 0.0; cur_rel_time < speed_data_.TotalTime();
        cur_rel_time += (cur_rel_time < kDenseTimeSec ? kDenseTimeResoltuion
                                                      : kSparseTimeResolution)) {
     common::SpeedPoint speed_point;
-    if (!speed_data_.EvaluateByTime(cur_rel_time, &speed_point)) {
+    if (!speed_data_.EvaluateByTime(cur_rel_time, &speed_point,
+                                    &speed_index)) {
       AERROR << "Fail to get speed point with relative time " << cur_rel_time;
       return false;
     }
@@ -294,12 +332,9 @@ bool ReferenceLineInfo::CombinePathAndSpeedProfile(
     if (speed_point.s() > path_data_.discretized_path().Length()) {
       break;
     }
-    common::PathPoint path_point;
-    if (!path_data_.GetPathPointWithPathS(speed_point.s(), &path_point)) {
-      AERROR << "Fail to get path data with s " << speed_point.s()
-             << "path total length " << path_data_.discretized_path().Length();
-      return false;
-    }
+    common::PathPoint path_point =
+        path_data_.discretized_path().EvaluateUsingLinearApproximation(
+            speed_point.s(), &path_index);
     path_point.set_s(path_point.s() + start_s);
 
     common::TrajectoryPoint trajectory_point;
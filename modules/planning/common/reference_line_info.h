@@ -60,6 +60,14 @@ class ReferenceLineInfo {
   bool AddObstacles(const std::vector<const Obstacle*>& obstacles);
   PathObstacle* AddObstacle(const Obstacle* obstacle);
 
+  /**
+   * @brief sets the reference line info of the last frame that has the same
+   * reference line, so that Init() reuses the SL boundaries of the obstacles
+   * that did not move. It must stay alive until Init() returns.
+   */
+  void SetLastReferenceLineInfo(
+      const ReferenceLineInfo* last_reference_line_info);
+
   PathDecision* path_decision();
   const PathDecision& path_decision() const;
   const ReferenceLine& reference_line() const;
@@ -139,6 +147,13 @@ class ReferenceLineInfo {
 
   bool IsUnrelaventObstacle(PathObstacle* path_obstacle);
 
+  /**
+   * @brief gets the perception SL boundary of obstacle from the last
+   * reference line info if the obstacle box did not change.
+   */
+  bool GetLastPerceptionSLBoundary(const Obstacle& obstacle,
+                                   SLBoundary* sl_boundary) const;
+
   void MakeDecision(DecisionResult* decision_result) const;
   int MakeMainStopDecision(DecisionResult* decision_result) const;
   void MakeMainMissionCompleteDecision(DecisionResult* decision_result) const;
@@ -174,6 +189,8 @@ class ReferenceLineInfo {
 
   bool is_on_reference_line_ = false;
 
+  const ReferenceLineInfo* last_reference_line_info_ = nullptr;
+
   ADCTrajectory::RightOfWayStatus status_ = ADCTrajectory::UNPROTECTED;
 
   double offset_to_other_reference_line_ = 0.0;
@@ -27,6 +27,7 @@
 #include "modules/common/util/string_util.h"
 #include "modules/common/util/util.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_util.h"
 
 namespace apollo {
 namespace planning {
@@ -53,6 +54,13 @@ void SpeedData::set_speed_vector(std::vector<common::SpeedPoint> speed_points) {
 
 bool SpeedData::EvaluateByTime(const double t,
                                common::SpeedPoint* const speed_point) const {
+  std::size_t index_hint = 0;
+  return EvaluateByTime(t, speed_point, &index_hint);
+}
+
+bool SpeedData::EvaluateByTime(const double t,
+                               common::SpeedPoint* const speed_point,
+                               std::size_t* index_hint) const {
   if (speed_vector_.size() < 2) {
     return false;
   }
@@ -65,8 +73,8 @@ bool SpeedData::EvaluateByTime(const double t,
     return sp.t() < t;
   };
 
-  auto it_lower =
-      std::lower_bound(speed_vector_.begin(), speed_vector_.end(), t, comp);
+  auto it_lower = util::LowerBoundWithHint(
+      speed_vector_.begin(), speed_vector_.end(), t, comp, index_hint);
   if (it_lower == speed_vector_.end()) {
     *speed_point = speed_vector_.back();
   } else if (it_lower == speed_vector_.begin()) {
@@ -87,6 +95,20 @@ bool SpeedData::EvaluateByTime(const double t,
   return true;
 }
 
+bool SpeedData::EvaluateManyByTime(
+    const std::vector<double>& times,
+    std::vector<common::SpeedPoint>* const speed_points) const {
+  CHECK_NOTNULL(speed_points);
+  speed_points->resize(times.size());
+  std::size_t index_hint = 0;
+  for (std::size_t i = 0; i < times.size(); ++i) {
+    if (!EvaluateByTime(times[i], &(*speed_points)[i], &index_hint)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 double SpeedData::TotalTime() const {
   if (speed_vector_.empty()) {
     return 0.0;
@@ -20,6 +20,7 @@
 #ifndef MODULES_PLANNING_COMMON_SPEED_SPEED_DATA_H_
 #define MODULES_PLANNING_COMMON_SPEED_SPEED_DATA_H_
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -46,6 +47,22 @@ class SpeedData {
   bool EvaluateByTime(const double time,
                       common::SpeedPoint* const speed_point) const;
 
+  /**
+   * @brief Evaluates the speed at time, searching it from *index_hint, which
+   * is updated. Evaluating an increasing or decreasing sequence of time with
+   * the same hint costs an amortized constant time per point.
+   */
+  bool EvaluateByTime(const double time, common::SpeedPoint* const speed_point,
+                      std::size_t* index_hint) const;
+
+  /**
+   * @brief Evaluates the speed at each of the sorted times.
+   * @return false if some time is out of the speed data.
+   */
+  bool EvaluateManyByTime(
+      const std::vector<double>& times,
+      std::vector<common::SpeedPoint>* const speed_points) const;
+
   double TotalTime() const;
 
   bool Empty() const { return speed_vector_.empty(); }
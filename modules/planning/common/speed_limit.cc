@@ -23,6 +23,7 @@
 #include <algorithm>
 
 #include "modules/common/log.h"
+#include "modules/planning/common/planning_util.h"
 
 namespace apollo {
 namespace planning {
@@ -40,6 +41,12 @@ const std::vector<std::pair<double, double>>& SpeedLimit::speed_limit_points()
 }
 
 double SpeedLimit::GetSpeedLimitByS(const double s) const {
+  std::size_t index_hint = 0;
+  return GetSpeedLimitByS(s, &index_hint);
+}
+
+double SpeedLimit::GetSpeedLimitByS(const double s,
+                                    std::size_t* index_hint) const {
   DCHECK_GE(speed_limit_points_.size(), 2);
   DCHECK_GE(s, speed_limit_points_.front().first);
 
@@ -47,8 +54,10 @@ double SpeedLimit::GetSpeedLimitByS(const double s) const {
     return point.first < s;
   };
 
-  auto it_lower = std::lower_bound(speed_limit_points_.begin(),
-                                   speed_limit_points_.end(), s, compare_s);
+  auto it_lower =
+      util::LowerBoundWithHint(speed_limit_points_.begin(),
+                               speed_limit_points_.end(), s, compare_s,
+                               index_hint);
 
   if (it_lower == speed_limit_points_.end()) {
     return (it_lower - 1)->second;
@@ -56,6 +65,18 @@ double SpeedLimit::GetSpeedLimitByS(const double s) const {
   return it_lower->second;
 }
 
+void SpeedLimit::GetSpeedLimitsByS(
+    const std::vector<double>& s,
+    std::vector<double>* const speed_limits) const {
+  CHECK_NOTNULL(speed_limits);
+  speed_limits->clear();
+  speed_limits->reserve(s.size());
+  std::size_t index_hint = 0;
+  for (const double point_s : s) {
+    speed_limits->push_back(GetSpeedLimitByS(point_s, &index_hint));
+  }
+}
+
 void SpeedLimit::Clear() { speed_limit_points_.clear(); }
 
 }  // namespace planning
@@ -21,6 +21,7 @@
 #ifndef MODULES_PLANNING_COMMON_SPEED_LIMIT_H_
 #define MODULES_PLANNING_COMMON_SPEED_LIMIT_H_
 
+#include <cstddef>
 #include <utility>
 #include <vector>
 
@@ -37,6 +38,19 @@ class SpeedLimit {
 
   double GetSpeedLimitByS(const double s) const;
 
+  /**
+   * @brief Gets the speed limit at s, searching it from *index_hint, which
+   * is updated. Getting an increasing or decreasing sequence of s with the
+   * same hint costs an amortized constant time per point.
+   */
+  double GetSpeedLimitByS(const double s, std::size_t* index_hint) const;
+
+  /**
+   * @brief Gets the speed limits at each of the sorted s.
+   */
+  void GetSpeedLimitsByS(const std::vector<double>& s,
+                         std::vector<double>* const speed_limits) const;
+
   void Clear();
 
  private:
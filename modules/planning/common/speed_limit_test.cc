@@ -20,6 +20,9 @@
 
 #include "modules/planning/common/speed_limit.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 namespace apollo {
@@ -66,5 +69,29 @@ TEST_F(SpeedLimitTest, GetSpeedLimitByS) {
   }
 }
 
+TEST_F(SpeedLimitTest, GetSpeedLimitBySWithHint) {
+  std::vector<double> s;
+  for (double curr_s = 0.0; curr_s < 101.0; curr_s += 0.37) {
+    s.push_back(curr_s);
+  }
+  std::vector<double> speed_limits;
+  speed_limit_.GetSpeedLimitsByS(s, &speed_limits);
+  ASSERT_EQ(s.size(), speed_limits.size());
+  for (size_t i = 0; i < s.size(); ++i) {
+    EXPECT_DOUBLE_EQ(speed_limit_.GetSpeedLimitByS(s[i]), speed_limits[i]);
+  }
+
+  // the hint also works backward and with jumps
+  std::size_t index_hint = 0;
+  for (auto it = s.rbegin(); it != s.rend(); ++it) {
+    EXPECT_DOUBLE_EQ(speed_limit_.GetSpeedLimitByS(*it),
+                     speed_limit_.GetSpeedLimitByS(*it, &index_hint));
+  }
+  for (const double curr_s : {50.0, 3.5, 98.2, 98.2, 0.0, 120.0, 17.0}) {
+    EXPECT_DOUBLE_EQ(speed_limit_.GetSpeedLimitByS(curr_s),
+                     speed_limit_.GetSpeedLimitByS(curr_s, &index_hint));
+  }
+}
+
 }  // namespace planning
 }  // namespace apollo
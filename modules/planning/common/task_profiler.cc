@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file task_profiler.cc
+ **/
+
+#include "modules/planning/common/task_profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+// nearest-rank percentile of the sorted samples
+double NearestRank(const std::vector<double>& sorted, const double ratio) {
+  const size_t rank = static_cast<size_t>(std::ceil(ratio * sorted.size()));
+  return sorted[std::min(std::max(rank, size_t(1)), sorted.size()) - 1];
+}
+
+}  // namespace
+
+TaskProfiler::TaskProfiler() {}
+
+TaskProfiler::Percentiles TaskProfiler::Add(const std::string& task_name,
+                                            const double time_ms) {
+  const size_t window_size =
+      static_cast<size_t>(std::max(FLAGS_task_profiler_window_size, 1));
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& samples = samples_[task_name];
+  samples.push_back(time_ms);
+  while (samples.size() > window_size) {
+    samples.pop_front();
+  }
+  return ComputePercentiles(samples);
+}
+
+TaskProfiler::Percentiles TaskProfiler::GetPercentiles(
+    const std::string& task_name) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = samples_.find(task_name);
+  if (iter == samples_.end()) {
+    return Percentiles();
+  }
+  return ComputePercentiles(iter->second);
+}
+
+void TaskProfiler::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  samples_.clear();
+}
+
+TaskProfiler::Percentiles TaskProfiler::ComputePercentiles(
+    const std::deque<double>& samples) {
+  Percentiles percentiles;
+  if (samples.empty()) {
+    return percentiles;
+  }
+  std::vector<double> sorted(samples.begin(), samples.end());
+  std::sort(sorted.begin(), sorted.end());
+  percentiles.p50_ms = NearestRank(sorted, 0.5);
+  percentiles.p99_ms = NearestRank(sorted, 0.99);
+  percentiles.num_samples = sorted.size();
+  return percentiles;
+}
+
+}  // namespace planning
+}  // namespace apollo
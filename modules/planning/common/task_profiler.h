@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file task_profiler.h
+ **/
+
+#ifndef MODULES_PLANNING_COMMON_TASK_PROFILER_H_
+#define MODULES_PLANNING_COMMON_TASK_PROFILER_H_
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "modules/common/macro.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class TaskProfiler
+ *
+ * @brief A singleton class that keeps the latest run times of every planning
+ * task and reports their rolling latency percentiles.
+ */
+class TaskProfiler {
+ public:
+  struct Percentiles {
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+    size_t num_samples = 0;
+  };
+
+  /**
+   * @brief Record one run of a task. Only the latest
+   * FLAGS_task_profiler_window_size runs of each task are kept.
+   * @return the percentiles of the task including this run.
+   */
+  Percentiles Add(const std::string& task_name, const double time_ms);
+
+  /**
+   * @brief Get the rolling percentiles of a task. All fields are zero if the
+   * task has not been recorded.
+   */
+  Percentiles GetPercentiles(const std::string& task_name) const;
+
+  void Clear();
+
+ private:
+  static Percentiles ComputePercentiles(const std::deque<double>& samples);
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::deque<double>> samples_;
+
+  DECLARE_SINGLETON(TaskProfiler);
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_COMMON_TASK_PROFILER_H_
@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file task_profiler_test.cc
+ **/
+
+#include "modules/planning/common/task_profiler.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/common/planning_gflags.h"
+
+namespace apollo {
+namespace planning {
+
+class TaskProfilerTest : public ::testing::Test {
+ public:
+  virtual void SetUp() { TaskProfiler::instance()->Clear(); }
+  virtual void TearDown() { TaskProfiler::instance()->Clear(); }
+};
+
+TEST_F(TaskProfilerTest, Empty) {
+  auto percentiles = TaskProfiler::instance()->GetPercentiles("DpStGraph");
+  EXPECT_EQ(0, percentiles.num_samples);
+  EXPECT_DOUBLE_EQ(0.0, percentiles.p50_ms);
+  EXPECT_DOUBLE_EQ(0.0, percentiles.p99_ms);
+}
+
+TEST_F(TaskProfilerTest, Percentiles) {
+  auto* profiler = TaskProfiler::instance();
+  TaskProfiler::Percentiles percentiles;
+  for (int i = 100; i >= 1; --i) {
+    percentiles = profiler->Add("DpPolyPathOptimizer", i);
+  }
+  EXPECT_EQ(100, percentiles.num_samples);
+  EXPECT_DOUBLE_EQ(50.0, percentiles.p50_ms);
+  EXPECT_DOUBLE_EQ(99.0, percentiles.p99_ms);
+
+  percentiles = profiler->Add("TrafficDecider", 3.0);
+  EXPECT_EQ(1, percentiles.num_samples);
+  EXPECT_DOUBLE_EQ(3.0, percentiles.p50_ms);
+  EXPECT_DOUBLE_EQ(3.0, percentiles.p99_ms);
+
+  percentiles = profiler->GetPercentiles("DpPolyPathOptimizer");
+  EXPECT_EQ(100, percentiles.num_samples);
+  EXPECT_DOUBLE_EQ(99.0, percentiles.p99_ms);
+}
+
+TEST_F(TaskProfilerTest, RollingWindow) {
+  const int window_size = FLAGS_task_profiler_window_size;
+  FLAGS_task_profiler_window_size = 10;
+  auto* profiler = TaskProfiler::instance();
+  for (int i = 0; i < 10; ++i) {
+    profiler->Add("QpSplinePathOptimizer", 100.0);
+  }
+  TaskProfiler::Percentiles percentiles;
+  for (int i = 0; i < 10; ++i) {
+    percentiles = profiler->Add("QpSplinePathOptimizer", 1.0);
+  }
+  EXPECT_EQ(10, percentiles.num_samples);
+  EXPECT_DOUBLE_EQ(1.0, percentiles.p50_ms);
+  EXPECT_DOUBLE_EQ(1.0, percentiles.p99_ms);
+  FLAGS_task_profiler_window_size = window_size;
+}
+
+}  // namespace planning
+}  // namespace apollo
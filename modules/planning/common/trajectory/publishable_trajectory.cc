@@ -40,8 +40,14 @@ double PublishableTrajectory::header_time() const { return header_time_; }
 void PublishableTrajectory::PopulateTrajectoryProtobuf(
     ADCTrajectory* trajectory_pb) const {
   trajectory_pb->mutable_header()->set_timestamp_sec(header_time_);
-  trajectory_pb->mutable_trajectory_point()->CopyFrom(
-      {trajectory_points_.begin(), trajectory_points_.end()});
+  // Copies the points once, directly into the message, instead of through a
+  // temporary repeated field.
+  auto* trajectory_points = trajectory_pb->mutable_trajectory_point();
+  trajectory_points->Clear();
+  trajectory_points->Reserve(static_cast<int>(trajectory_points_.size()));
+  for (const auto& trajectory_point : trajectory_points_) {
+    trajectory_points->Add()->CopyFrom(trajectory_point);
+  }
   if (!trajectory_points_.empty()) {
     const auto& last_tp = trajectory_points_.back();
     trajectory_pb->set_total_path_length(last_tp.path_point().s());
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file collision_checker.cc
+ **/
+
+#include "modules/planning/constraint_checker/collision_checker.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+using common::VehicleConfigHelper;
+using common::math::AABoxKDTreeParams;
+using common::math::Box2d;
+using common::math::Vec2d;
+
+CollisionChecker::CollisionChecker(
+    const std::vector<const Obstacle*>& obstacles,
+    const double time_resolution, const double time_length)
+    : time_resolution_(time_resolution) {
+  CHECK_GT(time_resolution, 0.0);
+  const std::size_t num_time_slices =
+      static_cast<std::size_t>(std::max(0.0, time_length) / time_resolution +
+                               1e-6) +
+      1;
+
+  std::vector<const Obstacle*> static_obstacles;
+  std::vector<const Obstacle*> dynamic_obstacles;
+  for (const auto* obstacle : obstacles) {
+    CHECK_NOTNULL(obstacle);
+    if (obstacle->HasTrajectory()) {
+      dynamic_obstacles.push_back(obstacle);
+    } else {
+      static_obstacles.push_back(obstacle);
+      static_boxes_.push_back(obstacle->PerceptionBoundingBox());
+    }
+  }
+  static_kdtree_ =
+      BuildKDTree(static_boxes_, static_obstacles, &static_obstacle_boxes_);
+
+  dynamic_boxes_.resize(num_time_slices);
+  dynamic_obstacle_boxes_.resize(num_time_slices);
+  dynamic_kdtrees_.resize(num_time_slices);
+  for (std::size_t k = 0; k < num_time_slices; ++k) {
+    const double relative_time = k * time_resolution;
+    dynamic_boxes_[k].reserve(dynamic_obstacles.size());
+    for (const auto* obstacle : dynamic_obstacles) {
+      dynamic_boxes_[k].push_back(
+          obstacle->GetBoundingBox(obstacle->GetPointAtTime(relative_time)));
+    }
+    dynamic_kdtrees_[k] = BuildKDTree(dynamic_boxes_[k], dynamic_obstacles,
+                                      &dynamic_obstacle_boxes_[k]);
+  }
+}
+
+std::unique_ptr<CollisionChecker::ObstacleBoxKDTree>
+CollisionChecker::BuildKDTree(const std::vector<Box2d>& boxes,
+                              const std::vector<const Obstacle*>& obstacles,
+                              std::vector<ObstacleBox>* const obstacle_boxes) {
+  CHECK_EQ(boxes.size(), obstacles.size());
+  // The KD-tree keeps pointers to the obstacle boxes, which keep pointers to
+  // the boxes, so neither of them may reallocate after this point.
+  obstacle_boxes->reserve(boxes.size());
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    obstacle_boxes->emplace_back(obstacles[i], &boxes[i]);
+  }
+  AABoxKDTreeParams params;
+  params.max_leaf_dimension = 5.0;  // meters.
+  params.max_leaf_size = 4;
+  return std::unique_ptr<ObstacleBoxKDTree>(
+      new ObstacleBoxKDTree(*obstacle_boxes, params));
+}
+
+bool CollisionChecker::HasOverlap(const ObstacleBoxKDTree* kdtree,
+                                  const Box2d& box) {
+  // Any box overlapping the query box is within half of its diagonal from
+  // its center.
+  for (const auto* obstacle_box :
+       kdtree->GetObjects(box.center(), box.diagonal() / 2.0)) {
+    if (box.HasOverlap(obstacle_box->box())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CollisionChecker::InCollision(const Box2d& box,
+                                   const double relative_time) const {
+  if (HasOverlap(static_kdtree_.get(), box)) {
+    return true;
+  }
+  const double slice = std::round(relative_time / time_resolution_);
+  const std::size_t index =
+      slice <= 0.0 ? 0 : std::min(static_cast<std::size_t>(slice),
+                                  dynamic_kdtrees_.size() - 1);
+  return HasOverlap(dynamic_kdtrees_[index].get(), box);
+}
+
+bool CollisionChecker::InCollision(const DiscretizedTrajectory& trajectory,
+                                   const double buffer) const {
+  const auto& vehicle_param =
+      VehicleConfigHelper::instance()->GetConfig().vehicle_param();
+  const double length = vehicle_param.length() + 2.0 * buffer;
+  const double width = vehicle_param.width() + 2.0 * buffer;
+  const double shift_distance =
+      vehicle_param.length() / 2.0 - vehicle_param.back_edge_to_center();
+  for (std::size_t i = 0; i < trajectory.NumOfPoints(); ++i) {
+    const auto& trajectory_point = trajectory.TrajectoryPointAt(i);
+    const auto& path_point = trajectory_point.path_point();
+    const double theta = path_point.theta();
+    const Vec2d center(path_point.x() + shift_distance * std::cos(theta),
+                       path_point.y() + shift_distance * std::sin(theta));
+    if (InCollision(Box2d(center, theta, length, width),
+                    trajectory_point.relative_time())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file collision_checker.h
+ **/
+
+#ifndef MODULES_PLANNING_CONSTRAINT_CHECKER_COLLISION_CHECKER_H_
+#define MODULES_PLANNING_CONSTRAINT_CHECKER_COLLISION_CHECKER_H_
+
+#include <memory>
+#include <vector>
+
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/box2d.h"
+#include "modules/common/math/vec2d.h"
+#include "modules/planning/common/obstacle.h"
+#include "modules/planning/common/trajectory/discretized_trajectory.h"
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class CollisionChecker
+ * @brief CollisionChecker indexes the predicted bounding boxes of a set of
+ * obstacles once, and answers whether an ADC box at a relative time overlaps
+ * any of them. Static obstacles are kept in one KD-tree; every obstacle with
+ * a predicted trajectory is sampled every time_resolution seconds up to
+ * time_length, and each time slice has its own KD-tree.
+ */
+class CollisionChecker {
+ public:
+  /**
+   * @brief Constructor
+   * @param obstacles The obstacles to check against. The obstacles must
+   * outlive the checker.
+   * @param time_resolution The time between two slices of predicted boxes.
+   * @param time_length The time of the last slice of predicted boxes.
+   */
+  CollisionChecker(const std::vector<const Obstacle*>& obstacles,
+                   const double time_resolution, const double time_length);
+
+  /**
+   * @brief Check whether a box at a time overlaps any obstacle. A time after
+   * the last slice is checked against the last slice.
+   * @param box The box to check.
+   * @param relative_time The time of the box, relative to the planning start
+   * time.
+   * @return true if the box overlaps an obstacle.
+   */
+  bool InCollision(const common::math::Box2d& box,
+                   const double relative_time) const;
+
+  /**
+   * @brief Check whether the ADC footprint, inflated by buffer on each side,
+   * overlaps any obstacle along a trajectory. The relative time of every
+   * trajectory point is used as the time of the footprint.
+   * @param trajectory The trajectory to check.
+   * @param buffer The lateral and longitudinal buffer of the footprint.
+   * @return true if one of the footprints overlaps an obstacle.
+   */
+  bool InCollision(const DiscretizedTrajectory& trajectory,
+                   const double buffer) const;
+
+ private:
+  /**
+   * @class ObstacleBox
+   * @brief A predicted obstacle box, in the form indexed by AABoxKDTree2d.
+   */
+  class ObstacleBox {
+   public:
+    ObstacleBox(const Obstacle* obstacle, const common::math::Box2d* box)
+        : obstacle_(obstacle), box_(box), aabox_(box->GetAABox()) {}
+    const common::math::AABox2d& aabox() const { return aabox_; }
+    double DistanceTo(const common::math::Vec2d& point) const {
+      return box_->DistanceTo(point);
+    }
+    double DistanceSquareTo(const common::math::Vec2d& point) const {
+      const double distance = box_->DistanceTo(point);
+      return distance * distance;
+    }
+    const Obstacle* obstacle() const { return obstacle_; }
+    const common::math::Box2d& box() const { return *box_; }
+
+   private:
+    const Obstacle* obstacle_;
+    const common::math::Box2d* box_;
+    common::math::AABox2d aabox_;
+  };
+
+  using ObstacleBoxKDTree = common::math::AABoxKDTree2d<ObstacleBox>;
+
+  static std::unique_ptr<ObstacleBoxKDTree> BuildKDTree(
+      const std::vector<common::math::Box2d>& boxes,
+      const std::vector<const Obstacle*>& obstacles,
+      std::vector<ObstacleBox>* const obstacle_boxes);
+
+  static bool HasOverlap(const ObstacleBoxKDTree* kdtree,
+                         const common::math::Box2d& box);
+
+  double time_resolution_ = 0.0;
+
+  std::vector<common::math::Box2d> static_boxes_;
+  std::vector<ObstacleBox> static_obstacle_boxes_;
+  std::unique_ptr<ObstacleBoxKDTree> static_kdtree_;
+
+  std::vector<std::vector<common::math::Box2d>> dynamic_boxes_;
+  std::vector<std::vector<ObstacleBox>> dynamic_obstacle_boxes_;
+  std::vector<std::unique_ptr<ObstacleBoxKDTree>> dynamic_kdtrees_;
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_CONSTRAINT_CHECKER_COLLISION_CHECKER_H_
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/constraint_checker/collision_checker.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/perception/proto/perception_obstacle.pb.h"
+#include "modules/prediction/proto/prediction_obstacle.pb.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::math::Box2d;
+using apollo::common::math::Vec2d;
+using apollo::perception::PerceptionObstacle;
+
+namespace {
+
+PerceptionObstacle MakePerceptionObstacle(const double x, const double y) {
+  PerceptionObstacle perception_obstacle;
+  perception_obstacle.mutable_position()->set_x(x);
+  perception_obstacle.mutable_position()->set_y(y);
+  perception_obstacle.set_theta(0.0);
+  perception_obstacle.set_length(4.0);
+  perception_obstacle.set_width(2.0);
+  std::vector<Vec2d> corners;
+  Box2d({x, y}, 0.0, perception_obstacle.length(), perception_obstacle.width())
+      .GetAllCorners(&corners);
+  for (const auto& corner : corners) {
+    auto* point = perception_obstacle.add_polygon_point();
+    point->set_x(corner.x());
+    point->set_y(corner.y());
+  }
+  return perception_obstacle;
+}
+
+}  // namespace
+
+TEST(CollisionChecker, InCollision) {
+  // A static obstacle at (10, 0) and an obstacle driving along y = 5 at
+  // 10 m/s from (0, 5).
+  const Obstacle static_obstacle("static", MakePerceptionObstacle(10.0, 0.0));
+  prediction::Trajectory trajectory;
+  for (int i = 0; i <= 50; ++i) {
+    const double t = i * 0.1;
+    auto* point = trajectory.add_trajectory_point();
+    point->mutable_path_point()->set_x(10.0 * t);
+    point->mutable_path_point()->set_y(5.0);
+    point->mutable_path_point()->set_theta(0.0);
+    point->set_v(10.0);
+    point->set_relative_time(t);
+  }
+  const Obstacle dynamic_obstacle(
+      "dynamic", MakePerceptionObstacle(0.0, 5.0), trajectory);
+  const std::vector<const Obstacle*> obstacles = {&static_obstacle,
+                                                  &dynamic_obstacle};
+  const CollisionChecker collision_checker(obstacles, 0.1, 4.0);
+
+  EXPECT_TRUE(collision_checker.InCollision(Box2d({11.0, 1.0}, 0.0, 2, 1), 0));
+  EXPECT_TRUE(collision_checker.InCollision(Box2d({11.0, 1.0}, 0.0, 2, 1), 3));
+  EXPECT_FALSE(collision_checker.InCollision(Box2d({20.0, 0.0}, 0.0, 2, 1), 0));
+  EXPECT_FALSE(collision_checker.InCollision(Box2d({10.0, 2.0}, 0.0, 2, 1), 0));
+
+  EXPECT_TRUE(collision_checker.InCollision(Box2d({10.0, 5.0}, 0.0, 2, 1), 1));
+  EXPECT_FALSE(collision_checker.InCollision(Box2d({10.0, 5.0}, 0.0, 2, 1), 3));
+  EXPECT_TRUE(collision_checker.InCollision(Box2d({30.0, 5.0}, 0.0, 2, 1), 3));
+
+  // A time after the last slice is checked against the last slice.
+  EXPECT_TRUE(collision_checker.InCollision(Box2d({40.0, 5.0}, 0.0, 2, 1), 8));
+  EXPECT_FALSE(
+      collision_checker.InCollision(Box2d({50.0, 5.0}, 0.0, 2, 1), 8));
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,185 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file planning_benchmark.cc
+ * @brief Replays the recorded inputs of a directory through
+ * Planning::RunOnce() as fast as possible, and reports the cycle latency,
+ * the time of every task and the number of heap allocations per cycle.
+ *
+ * \par
+ * The directory holds frames in the layout described in recorded_frames.h.
+ *
+ * \par
+ * bazel run //modules/planning/integration_tests:planning_benchmark --
+ *     --benchmark_data_dir=modules/planning/testdata/sunnyvale_loop_test
+ *     --map_dir=modules/map/data/sunnyvale_loop
+ *     --test_base_map_filename=base_map_test.bin
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/log.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/integration_tests/recorded_frames.h"
+#include "modules/planning/planning.h"
+
+DEFINE_string(benchmark_data_dir,
+              "modules/planning/testdata/sunnyvale_loop_test",
+              "The directory of the recorded frames to replay.");
+DEFINE_int32(benchmark_num_iterations, 10,
+             "The number of times all the frames are replayed.");
+DEFINE_int32(benchmark_num_warmup_iterations, 1,
+             "The number of replays before the measured ones.");
+
+namespace {
+
+std::atomic<std::uint64_t> num_allocations(0);
+
+}  // namespace
+
+// Every heap allocation of the process is counted. operator new[] and the
+// nothrow versions forward to this one by default.
+void* operator new(std::size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::adapter::AdapterManager;
+
+namespace {
+
+void PrintStats(const std::string& name, std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  double sum = 0.0;
+  for (const double value : values) {
+    sum += value;
+  }
+  const double mean = values.empty() ? 0.0 : sum / values.size();
+  std::printf("%-32s %8zu %10.3f %10.3f %10.3f %10.3f\n", name.c_str(),
+              values.size(), mean, Percentile(values, 0.5),
+              Percentile(values, 0.99),
+              values.empty() ? 0.0 : values.back());
+}
+
+int RunBenchmark() {
+  std::vector<RecordedFrame> frames;
+  if (!LoadFrames(FLAGS_benchmark_data_dir, &frames)) {
+    return EXIT_FAILURE;
+  }
+  AdapterManager::Init(FLAGS_planning_adapter_config_filename);
+  if (!AdapterManager::GetLocalization() || !AdapterManager::GetChassis() ||
+      !AdapterManager::GetRoutingResponse() || !AdapterManager::GetPlanning()) {
+    AERROR << "Adapters are not configured in "
+           << FLAGS_planning_adapter_config_filename;
+    return EXIT_FAILURE;
+  }
+  Planning planning;
+  if (!planning.Init().ok()) {
+    AERROR << "Failed to init planning";
+    return EXIT_FAILURE;
+  }
+
+  std::vector<double> cycle_time_ms;
+  std::vector<double> cycle_allocations;
+  std::map<std::string, std::vector<double>> task_time_ms;
+  const int num_iterations =
+      FLAGS_benchmark_num_warmup_iterations + FLAGS_benchmark_num_iterations;
+  for (int iteration = 0; iteration < num_iterations; ++iteration) {
+    const bool is_measured =
+        iteration >= FLAGS_benchmark_num_warmup_iterations;
+    for (const auto& frame : frames) {
+      FeedFrame(frame);
+      const std::uint64_t start_allocations = num_allocations.load();
+      const auto start_time = std::chrono::steady_clock::now();
+      planning.RunOnce();
+      const auto end_time = std::chrono::steady_clock::now();
+      const std::uint64_t end_allocations = num_allocations.load();
+      if (!is_measured) {
+        continue;
+      }
+      cycle_time_ms.push_back(
+          std::chrono::duration<double, std::milli>(end_time - start_time)
+              .count());
+      cycle_allocations.push_back(
+          static_cast<double>(end_allocations - start_allocations));
+      const auto* trajectory =
+          AdapterManager::GetPlanning()->GetLatestPublished();
+      if (trajectory == nullptr) {
+        continue;
+      }
+      for (const auto& task : trajectory->latency_stats().task_stats()) {
+        task_time_ms[task.name()].push_back(task.time_ms());
+      }
+    }
+  }
+  planning.Stop();
+
+  std::printf("%zu frames, %d iterations\n", frames.size(),
+              FLAGS_benchmark_num_iterations);
+  std::printf("%-32s %8s %10s %10s %10s %10s\n", "", "count", "mean", "p50",
+              "p99", "max");
+  PrintStats("cycle time (ms)", cycle_time_ms);
+  PrintStats("allocations per cycle", cycle_allocations);
+  for (const auto& task : task_time_ms) {
+    PrintStats(task.first + " (ms)", task.second);
+  }
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  // The defaults of the integration tests; all of them can be overridden on
+  // the command line.
+  FLAGS_planning_config_file = "modules/planning/conf/planning_config.pb.txt";
+  FLAGS_planning_adapter_config_filename =
+      "modules/planning/testdata/conf/adapter.conf";
+  FLAGS_map_dir = "modules/map/data/sunnyvale_loop";
+  FLAGS_test_base_map_filename = "base_map_test.bin";
+  FLAGS_align_prediction_time = false;
+  FLAGS_estimate_current_vehicle_state = false;
+  FLAGS_enable_reference_line_provider_thread = false;
+  FLAGS_planning_test_mode = true;
+  FLAGS_enable_lag_prediction = false;
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  return apollo::planning::RunBenchmark();
+}
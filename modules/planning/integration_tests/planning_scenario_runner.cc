@@ -0,0 +1,342 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file planning_scenario_runner.cc
+ * @brief Replays many scenarios of recorded frames through
+ * Planning::RunOnce() in parallel, checks the trajectories against the
+ * expected ones, and reports the results and the cycle latency.
+ *
+ * \par
+ * Each scenario is a directory of frames in the layout described in
+ * recorded_frames.h, and runs in a forked worker process, since Planning and
+ * the AdapterManager are process-wide singletons. The map is loaded once in
+ * the parent before forking, so the workers share it copy-on-write instead of
+ * loading it each.
+ *
+ * \par
+ * bazel run //modules/planning/integration_tests:planning_scenario_runner --
+ *     --scenario_root=modules/planning/testdata
+ *     --map_dir=modules/map/data/sunnyvale_loop
+ *     --test_base_map_filename=base_map_test.bin
+ */
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/common/util/util.h"
+#include "modules/map/hdmap/hdmap_util.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/integration_tests/recorded_frames.h"
+#include "modules/planning/planning.h"
+
+DEFINE_string(scenario_root, "",
+              "The directory whose subdirectories are the scenarios to run.");
+DEFINE_string(scenario_dirs, "",
+              "Comma separated directories of the scenarios to run, besides "
+              "the ones of --scenario_root.");
+DEFINE_int32(num_workers, 0,
+             "The number of scenarios run at the same time, 0 for the number "
+             "of cores.");
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::adapter::AdapterManager;
+
+namespace {
+
+struct ScenarioResult {
+  std::string dir;
+  bool passed = false;
+  int num_frames = 0;
+  double mean_ms = 0.0;
+  double p50_ms = 0.0;
+  double p99_ms = 0.0;
+  double max_ms = 0.0;
+  std::string message;
+};
+
+// The summary a worker writes to its pipe: passed, frames, mean, p50, p99,
+// max, then the message up to the end.
+std::string SerializeResult(const ScenarioResult& result) {
+  std::ostringstream out;
+  out << result.passed << " " << result.num_frames << " " << result.mean_ms
+      << " " << result.p50_ms << " " << result.p99_ms << " " << result.max_ms
+      << " " << result.message;
+  return out.str();
+}
+
+bool DeserializeResult(const std::string& summary, ScenarioResult* result) {
+  std::istringstream in(summary);
+  if (!(in >> result->passed >> result->num_frames >> result->mean_ms >>
+        result->p50_ms >> result->p99_ms >> result->max_ms)) {
+    return false;
+  }
+  in.get();
+  std::getline(in, result->message);
+  return true;
+}
+
+// Runs in the worker process.
+ScenarioResult RunScenario(const std::string& dir) {
+  ScenarioResult result;
+  result.dir = dir;
+  std::vector<RecordedFrame> frames;
+  if (!LoadFrames(dir, &frames)) {
+    result.message = "failed to load the frames";
+    return result;
+  }
+  AdapterManager::Init(FLAGS_planning_adapter_config_filename);
+  if (!AdapterManager::GetLocalization() || !AdapterManager::GetChassis() ||
+      !AdapterManager::GetRoutingResponse() || !AdapterManager::GetPlanning()) {
+    result.message = "adapters are not configured";
+    return result;
+  }
+  Planning planning;
+  if (!planning.Init().ok()) {
+    result.message = "failed to init planning";
+    return result;
+  }
+
+  std::vector<double> cycle_time_ms;
+  for (size_t i = 0; i < frames.size() && result.message.empty(); ++i) {
+    FeedFrame(frames[i]);
+    const auto start_time = std::chrono::steady_clock::now();
+    planning.RunOnce();
+    const auto end_time = std::chrono::steady_clock::now();
+    cycle_time_ms.push_back(
+        std::chrono::duration<double, std::milli>(end_time - start_time)
+            .count());
+
+    const auto* published =
+        AdapterManager::GetPlanning()->GetLatestPublished();
+    if (published == nullptr) {
+      result.message = "no trajectory at frame " + std::to_string(i + 1);
+    } else if (frames[i].has_result) {
+      ADCTrajectory trajectory = *published;
+      TrimTrajectory(&trajectory);
+      ADCTrajectory expected = frames[i].result;
+      TrimTrajectory(&expected);
+      if (!common::util::IsProtoEqual(trajectory, expected)) {
+        result.message =
+            "unexpected trajectory at frame " + std::to_string(i + 1);
+      }
+    }
+  }
+  planning.Stop();
+
+  result.passed = result.message.empty();
+  result.num_frames = static_cast<int>(cycle_time_ms.size());
+  std::sort(cycle_time_ms.begin(), cycle_time_ms.end());
+  double sum = 0.0;
+  for (const double time_ms : cycle_time_ms) {
+    sum += time_ms;
+  }
+  if (!cycle_time_ms.empty()) {
+    result.mean_ms = sum / cycle_time_ms.size();
+    result.p50_ms = Percentile(cycle_time_ms, 0.5);
+    result.p99_ms = Percentile(cycle_time_ms, 0.99);
+    result.max_ms = cycle_time_ms.back();
+  }
+  return result;
+}
+
+struct Worker {
+  pid_t pid = -1;
+  int fd = -1;
+  size_t scenario = 0;
+};
+
+bool StartWorker(const std::string& dir, const size_t scenario,
+                 Worker* worker) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    AERROR << "Failed to create the pipe of " << dir;
+    return false;
+  }
+  const pid_t pid = fork();
+  if (pid < 0) {
+    AERROR << "Failed to fork the worker of " << dir;
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+  if (pid == 0) {
+    close(fds[0]);
+    const std::string summary = SerializeResult(RunScenario(dir));
+    size_t written = 0;
+    while (written < summary.size()) {
+      const ssize_t n =
+          write(fds[1], summary.data() + written, summary.size() - written);
+      if (n <= 0) {
+        break;
+      }
+      written += n;
+    }
+    close(fds[1]);
+    // Skips the destructors of the singletons copied from the parent.
+    _exit(EXIT_SUCCESS);
+  }
+  close(fds[1]);
+  worker->pid = pid;
+  worker->fd = fds[0];
+  worker->scenario = scenario;
+  return true;
+}
+
+// Reads the summary of the worker until it exits, and waits for it.
+void FinishWorker(const Worker& worker, ScenarioResult* result) {
+  std::string summary;
+  char buffer[256];
+  ssize_t n = 0;
+  while ((n = read(worker.fd, buffer, sizeof(buffer))) > 0) {
+    summary.append(buffer, n);
+  }
+  close(worker.fd);
+  int status = 0;
+  waitpid(worker.pid, &status, 0);
+  if (!DeserializeResult(summary, result)) {
+    result->passed = false;
+    result->message = WIFSIGNALED(status)
+                          ? "worker killed by signal " +
+                                std::to_string(WTERMSIG(status))
+                          : "worker exited without a result";
+  }
+}
+
+std::vector<std::string> ListScenarios() {
+  std::vector<std::string> dirs;
+  if (!FLAGS_scenario_root.empty()) {
+    for (const auto& name :
+         common::util::ListSubDirectories(FLAGS_scenario_root)) {
+      dirs.push_back(FLAGS_scenario_root + "/" + name);
+    }
+    std::sort(dirs.begin(), dirs.end());
+  }
+  std::istringstream in(FLAGS_scenario_dirs);
+  std::string dir;
+  while (std::getline(in, dir, ',')) {
+    if (!dir.empty()) {
+      dirs.push_back(dir);
+    }
+  }
+  return dirs;
+}
+
+int RunScenarios() {
+  const std::vector<std::string> dirs = ListScenarios();
+  if (dirs.empty()) {
+    AERROR << "No scenario given by --scenario_root or --scenario_dirs";
+    return EXIT_FAILURE;
+  }
+  if (apollo::hdmap::HDMapUtil::BaseMapPtr() == nullptr) {
+    AERROR << "Failed to load the map";
+    return EXIT_FAILURE;
+  }
+  size_t num_workers = FLAGS_num_workers > 0
+                           ? FLAGS_num_workers
+                           : std::thread::hardware_concurrency();
+  num_workers = std::max<size_t>(num_workers, 1);
+
+  // The workers run one scenario each, at most num_workers at a time, and
+  // are waited for in the order they started.
+  std::vector<ScenarioResult> results(dirs.size());
+  std::vector<Worker> workers;
+  const auto start_time = std::chrono::steady_clock::now();
+  size_t next = 0;
+  while (next < dirs.size() || !workers.empty()) {
+    while (next < dirs.size() && workers.size() < num_workers) {
+      results[next].dir = dirs[next];
+      Worker worker;
+      if (StartWorker(dirs[next], next, &worker)) {
+        workers.push_back(worker);
+      } else {
+        results[next].message = "failed to start the worker";
+      }
+      ++next;
+    }
+    if (!workers.empty()) {
+      FinishWorker(workers.front(), &results[workers.front().scenario]);
+      workers.erase(workers.begin());
+    }
+  }
+  const double elapsed_s = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - start_time)
+                               .count();
+
+  std::printf("%-48s %6s %8s %10s %10s %10s %10s\n", "scenario", "result",
+              "frames", "mean", "p50", "p99", "max");
+  int num_passed = 0;
+  std::vector<double> max_ms;
+  for (const auto& result : results) {
+    std::printf("%-48s %6s %8d %10.3f %10.3f %10.3f %10.3f %s\n",
+                result.dir.c_str(), result.passed ? "PASS" : "FAIL",
+                result.num_frames, result.mean_ms, result.p50_ms,
+                result.p99_ms, result.max_ms, result.message.c_str());
+    if (result.passed) {
+      ++num_passed;
+      max_ms.push_back(result.max_ms);
+    }
+  }
+  std::sort(max_ms.begin(), max_ms.end());
+  std::printf(
+      "%d passed, %d failed in %.1f s with %zu workers; worst cycle time of "
+      "the passed scenarios: p50 %.3f ms, max %.3f ms\n",
+      num_passed, static_cast<int>(results.size()) - num_passed, elapsed_s,
+      num_workers, Percentile(max_ms, 0.5),
+      max_ms.empty() ? 0.0 : max_ms.back());
+  return num_passed == static_cast<int>(results.size()) ? EXIT_SUCCESS
+                                                        : EXIT_FAILURE;
+}
+
+}  // namespace
+}  // namespace planning
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  // The defaults of the integration tests; all of them can be overridden on
+  // the command line.
+  FLAGS_planning_config_file = "modules/planning/conf/planning_config.pb.txt";
+  FLAGS_planning_adapter_config_filename =
+      "modules/planning/testdata/conf/adapter.conf";
+  FLAGS_map_dir = "modules/map/data/sunnyvale_loop";
+  FLAGS_test_base_map_filename = "base_map_test.bin";
+  FLAGS_align_prediction_time = false;
+  FLAGS_estimate_current_vehicle_state = false;
+  FLAGS_enable_reference_line_provider_thread = false;
+  FLAGS_planning_test_mode = true;
+  FLAGS_enable_lag_prediction = false;
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  return apollo::planning::RunScenarios();
+}
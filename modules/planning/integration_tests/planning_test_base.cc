@@ -22,6 +22,7 @@
 #include "modules/common/log.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/integration_tests/recorded_frames.h"
 
 namespace apollo {
 namespace planning {
@@ -128,13 +129,7 @@ void PlanningTestBase::SetUp() {
 }
 
 void PlanningTestBase::TrimPlanning(ADCTrajectory* origin) {
-  origin->clear_latency_stats();
-  origin->clear_debug();
-  origin->mutable_header()->clear_radar_timestamp();
-  origin->mutable_header()->clear_lidar_timestamp();
-  origin->mutable_header()->clear_timestamp_sec();
-  origin->mutable_header()->clear_camera_timestamp();
-  origin->mutable_header()->clear_sequence_num();
+  TrimTrajectory(origin);
 }
 
 bool PlanningTestBase::RunPlanning(const std::string& test_case_name,
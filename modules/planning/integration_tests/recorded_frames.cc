@@ -0,0 +1,118 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/planning/integration_tests/recorded_frames.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+#include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::adapter::AdapterManager;
+
+namespace {
+
+std::string FramePath(const std::string& dir, const int index,
+                      const std::string& name) {
+  return dir + "/" + std::to_string(index) + "_" + name + ".pb.txt";
+}
+
+template <typename MessageType>
+bool LoadOptional(const std::string& file, MessageType* message,
+                  bool* loaded) {
+  *loaded = common::util::PathExists(file);
+  if (*loaded && !common::util::GetProtoFromFile(file, message)) {
+    AERROR << "Failed to load " << file;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool LoadFrames(const std::string& dir, std::vector<RecordedFrame>* frames) {
+  for (int index = 1;; ++index) {
+    const std::string localization_file =
+        FramePath(dir, index, "localization");
+    if (!common::util::PathExists(localization_file)) {
+      break;
+    }
+    RecordedFrame frame;
+    if (!common::util::GetProtoFromFile(localization_file,
+                                        &frame.localization) ||
+        !common::util::GetProtoFromFile(FramePath(dir, index, "chassis"),
+                                        &frame.chassis)) {
+      AERROR << "Failed to load frame " << index << " from " << dir;
+      return false;
+    }
+    bool has_prediction = false;
+    if (!LoadOptional(FramePath(dir, index, "routing"), &frame.routing,
+                      &frame.has_routing) ||
+        !LoadOptional(FramePath(dir, index, "prediction"), &frame.prediction,
+                      &has_prediction) ||
+        !LoadOptional(FramePath(dir, index, "result"), &frame.result,
+                      &frame.has_result)) {
+      return false;
+    }
+    frames->push_back(std::move(frame));
+  }
+  if (frames->empty() || !frames->front().has_routing) {
+    AERROR << "No frame with routing found in " << dir;
+    return false;
+  }
+  return true;
+}
+
+void FeedFrame(const RecordedFrame& frame) {
+  AdapterManager::GetLocalization()->FeedData(frame.localization);
+  AdapterManager::GetChassis()->FeedData(frame.chassis);
+  if (frame.has_routing) {
+    AdapterManager::GetRoutingResponse()->FeedData(frame.routing);
+  }
+  if (AdapterManager::GetPrediction()) {
+    AdapterManager::GetPrediction()->FeedData(frame.prediction);
+  }
+}
+
+void TrimTrajectory(ADCTrajectory* trajectory) {
+  trajectory->clear_latency_stats();
+  trajectory->clear_debug();
+  auto* header = trajectory->mutable_header();
+  header->clear_radar_timestamp();
+  header->clear_lidar_timestamp();
+  header->clear_timestamp_sec();
+  header->clear_camera_timestamp();
+  header->clear_sequence_num();
+}
+
+double Percentile(const std::vector<double>& sorted_values,
+                  const double percentile) {
+  if (sorted_values.empty()) {
+    return 0.0;
+  }
+  const std::size_t index = static_cast<std::size_t>(
+      percentile * (sorted_values.size() - 1) + 0.5);
+  return sorted_values[std::min(index, sorted_values.size() - 1)];
+}
+
+}  // namespace planning
+}  // namespace apollo
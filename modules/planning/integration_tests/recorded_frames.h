@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file recorded_frames.h
+ * @brief The recorded inputs of planning replayed by the benchmark and the
+ * scenario runner.
+ *
+ * \par
+ * A directory holds frames in the layout of the integration test data:
+ * <n>_localization.pb.txt and <n>_chassis.pb.txt, and optionally
+ * <n>_routing.pb.txt, <n>_prediction.pb.txt and the expected trajectory
+ * <n>_result.pb.txt, for n = 1, 2, ...
+ * A frame without routing keeps the routing of the previous frame; a frame
+ * without prediction has no obstacles.
+ */
+
+#ifndef MODULES_PLANNING_INTEGRATION_TESTS_RECORDED_FRAMES_H_
+#define MODULES_PLANNING_INTEGRATION_TESTS_RECORDED_FRAMES_H_
+
+#include <string>
+#include <vector>
+
+#include "modules/canbus/proto/chassis.pb.h"
+#include "modules/localization/proto/localization.pb.h"
+#include "modules/planning/proto/planning.pb.h"
+#include "modules/prediction/proto/prediction_obstacle.pb.h"
+#include "modules/routing/proto/routing.pb.h"
+
+namespace apollo {
+namespace planning {
+
+struct RecordedFrame {
+  apollo::localization::LocalizationEstimate localization;
+  apollo::canbus::Chassis chassis;
+  bool has_routing = false;
+  apollo::routing::RoutingResponse routing;
+  apollo::prediction::PredictionObstacles prediction;
+  bool has_result = false;
+  ADCTrajectory result;
+};
+
+/**
+ * @brief Loads the frames of the directory.
+ * @param dir the directory
+ * @param frames the loaded frames
+ * @return False if a file fails to be loaded, or if the first frame has no
+ * routing.
+ */
+bool LoadFrames(const std::string& dir, std::vector<RecordedFrame>* frames);
+
+/**
+ * @brief Feeds the inputs of the frame to the adapters.
+ */
+void FeedFrame(const RecordedFrame& frame);
+
+/**
+ * @brief Clears the fields of the trajectory which change from run to run,
+ * like the timestamps and the latency.
+ */
+void TrimTrajectory(ADCTrajectory* trajectory);
+
+/**
+ * @brief The value at the percentile, in [0, 1], of the sorted values.
+ */
+double Percentile(const std::vector<double>& sorted_values,
+                  const double percentile);
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_INTEGRATION_TESTS_RECORDED_FRAMES_H_
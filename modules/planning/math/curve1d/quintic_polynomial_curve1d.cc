@@ -86,6 +86,52 @@ double QuinticPolynomialCurve1d::Evaluate(const uint32_t order,
   }
 }
 
+void QuinticPolynomialCurve1d::BatchEvaluate(
+    const std::vector<double>& params, std::vector<double>* const values,
+    std::vector<double>* const first_derivatives,
+    std::vector<double>* const second_derivatives) const {
+  const std::size_t num_params = params.size();
+  const double* p = params.data();
+  const double a0 = coef_[0];
+  const double a1 = coef_[1];
+  const double a2 = coef_[2];
+  const double a3 = coef_[3];
+  const double a4 = coef_[4];
+  const double a5 = coef_[5];
+  if (values != nullptr) {
+    values->resize(num_params);
+    double* out = values->data();
+    for (std::size_t i = 0; i < num_params; ++i) {
+      const double x = p[i];
+      out[i] = ((((a5 * x + a4) * x + a3) * x + a2) * x + a1) * x + a0;
+    }
+  }
+  if (first_derivatives != nullptr) {
+    first_derivatives->resize(num_params);
+    double* out = first_derivatives->data();
+    const double b1 = 2.0 * a2;
+    const double b2 = 3.0 * a3;
+    const double b3 = 4.0 * a4;
+    const double b4 = 5.0 * a5;
+    for (std::size_t i = 0; i < num_params; ++i) {
+      const double x = p[i];
+      out[i] = (((b4 * x + b3) * x + b2) * x + b1) * x + a1;
+    }
+  }
+  if (second_derivatives != nullptr) {
+    second_derivatives->resize(num_params);
+    double* out = second_derivatives->data();
+    const double c0 = 2.0 * a2;
+    const double c1 = 6.0 * a3;
+    const double c2 = 12.0 * a4;
+    const double c3 = 20.0 * a5;
+    for (std::size_t i = 0; i < num_params; ++i) {
+      const double x = p[i];
+      out[i] = ((c3 * x + c2) * x + c1) * x + c0;
+    }
+  }
+}
+
 void QuinticPolynomialCurve1d::ComputeCoefficients(
     const double x0, const double dx0, const double ddx0, const double x1,
     const double dx1, const double ddx1, const double p) {
@@ -23,6 +23,7 @@
 
 #include <array>
 #include <string>
+#include <vector>
 
 #include "modules/planning/math/curve1d/polynomial_curve1d.h"
 
@@ -49,6 +50,21 @@ class QuinticPolynomialCurve1d : public PolynomialCurve1d {
 
   double Evaluate(const std::uint32_t order, const double p) const override;
 
+  /**
+   * @brief Evaluate the value and the first two derivatives at each of the
+   * params without virtual dispatch. Each requested output is filled by its
+   * own branch free Horner loop so that the compiler can vectorize it.
+   * @param params The params to evaluate at.
+   * @param values The values, not computed if nullptr.
+   * @param first_derivatives The first derivatives, not computed if nullptr.
+   * @param second_derivatives The second derivatives, not computed if
+   *        nullptr.
+   */
+  void BatchEvaluate(const std::vector<double>& params,
+                     std::vector<double>* const values,
+                     std::vector<double>* const first_derivatives,
+                     std::vector<double>* const second_derivatives) const;
+
   double ParamLength() const { return param_; }
   std::string ToString() const override;
 
@@ -23,11 +23,16 @@
 #include <cmath>
 
 #include "modules/common/log.h"
+#include "modules/common/math/fast_trig.h"
 #include "modules/common/math/math_utils.h"
 
 namespace apollo {
 namespace planning {
 
+using apollo::common::math::FastAtan2;
+using apollo::common::math::FastCos;
+using apollo::common::math::FastNormalizeAngle;
+using apollo::common::math::FastSinCos;
 using apollo::common::math::Vec2d;
 
 void CartesianFrenetConverter::cartesian_to_frenet(
@@ -39,16 +44,19 @@ void CartesianFrenetConverter::cartesian_to_frenet(
   const double dx = x - rx;
   const double dy = y - ry;
 
-  const double cos_theta_r = std::cos(rtheta);
-  const double sin_theta_r = std::sin(rtheta);
+  double sin_theta_r = 0.0;
+  double cos_theta_r = 0.0;
+  FastSinCos(rtheta, &sin_theta_r, &cos_theta_r);
 
   const double cross_rd_nd = cos_theta_r * dy - sin_theta_r * dx;
   ptr_d_condition->at(0) =
       std::copysign(std::sqrt(dx * dx + dy * dy), cross_rd_nd);
 
   const double delta_theta = theta - rtheta;
-  const double tan_delta_theta = std::tan(delta_theta);
-  const double cos_delta_theta = std::cos(delta_theta);
+  double sin_delta_theta = 0.0;
+  double cos_delta_theta = 0.0;
+  FastSinCos(delta_theta, &sin_delta_theta, &cos_delta_theta);
+  const double tan_delta_theta = sin_delta_theta / cos_delta_theta;
 
   const double one_minus_kappa_r_d = 1 - rkappa * ptr_d_condition->at(0);
   ptr_d_condition->at(1) = one_minus_kappa_r_d * tan_delta_theta;
@@ -85,8 +93,9 @@ void CartesianFrenetConverter::frenet_to_cartesian(
   CHECK(std::abs(rs - s_condition[0]) < 1.0e-6)
       << "The reference point s and s_condition[0] don't match";
 
-  const double cos_theta_r = std::cos(rtheta);
-  const double sin_theta_r = std::sin(rtheta);
+  double sin_theta_r = 0.0;
+  double cos_theta_r = 0.0;
+  FastSinCos(rtheta, &sin_theta_r, &cos_theta_r);
 
   *ptr_x = rx - sin_theta_r * d_condition[0];
   *ptr_y = ry + cos_theta_r * d_condition[0];
@@ -94,10 +103,10 @@ void CartesianFrenetConverter::frenet_to_cartesian(
   const double one_minus_kappa_r_d = 1 - rkappa * d_condition[0];
 
   const double tan_delta_theta = d_condition[1] / one_minus_kappa_r_d;
-  const double delta_theta = std::atan2(d_condition[1], one_minus_kappa_r_d);
-  const double cos_delta_theta = std::cos(delta_theta);
+  const double delta_theta = FastAtan2(d_condition[1], one_minus_kappa_r_d);
+  const double cos_delta_theta = FastCos(delta_theta);
 
-  *ptr_theta = common::math::NormalizeAngle(delta_theta + rtheta);
+  *ptr_theta = FastNormalizeAngle(delta_theta + rtheta);
 
   const double kappa_r_d_prime =
       rdkappa * d_condition[0] + rkappa * d_condition[1];
@@ -124,7 +133,7 @@ double CartesianFrenetConverter::CalculateTheta(const double rtheta,
                                                 const double rkappa,
                                                 const double l,
                                                 const double dl) {
-  return common::math::NormalizeAngle(rtheta + std::atan2(dl, 1 - l * rkappa));
+  return FastNormalizeAngle(rtheta + FastAtan2(dl, 1 - l * rkappa));
 }
 
 double CartesianFrenetConverter::CalculateKappa(const double rkappa,
@@ -145,8 +154,11 @@ double CartesianFrenetConverter::CalculateKappa(const double rkappa,
 Vec2d CartesianFrenetConverter::CalculateCartesianPoint(const double rtheta,
                                                         const Vec2d& rpoint,
                                                         const double l) {
-  const double x = rpoint.x() - l * std::sin(rtheta);
-  const double y = rpoint.y() + l * std::cos(rtheta);
+  double sin_theta_r = 0.0;
+  double cos_theta_r = 0.0;
+  FastSinCos(rtheta, &sin_theta_r, &cos_theta_r);
+  const double x = rpoint.x() - l * sin_theta_r;
+  const double y = rpoint.y() + l * cos_theta_r;
   return Vec2d(x, y);
 }
 
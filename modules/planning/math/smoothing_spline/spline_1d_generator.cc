@@ -30,6 +30,7 @@
 
 #include "modules/common/log.h"
 #include "modules/common/math/qp_solver/active_set_qp_solver.h"
+#include "modules/common/math/qp_solver/admm_qp_solver.h"
 #include "modules/common/math/qp_solver/qp_solver_gflags.h"
 #include "modules/common/time/time.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -84,6 +85,10 @@ bool Spline1dGenerator::Solve() {
     return false;
   }
 
+  if (FLAGS_enable_sparse_qp_solver) {
+    return SolveWithSparseSolver();
+  }
+
   int num_param = kernel_matrix.rows();
   int num_constraint =
       equality_constraint_matrix.rows() + inequality_constraint_matrix.rows();
@@ -222,6 +227,43 @@ bool Spline1dGenerator::Solve() {
   return spline_.SetSplineSegs(solved_params, spline_.spline_order());
 }
 
+bool Spline1dGenerator::SolveWithSparseSolver() {
+  const MatrixXd& kernel_matrix = spline_kernel_.kernel_matrix();
+  const MatrixXd& offset = spline_kernel_.offset();
+  const auto& inequality_constraint =
+      spline_constraint_.inequality_constraint();
+  const auto& equality_constraint = spline_constraint_.equality_constraint();
+
+  apollo::common::math::AdmmQpSolver solver(
+      kernel_matrix, offset, inequality_constraint.constraint_matrix(),
+      inequality_constraint.constraint_boundary(),
+      equality_constraint.constraint_matrix(),
+      equality_constraint.constraint_boundary());
+  solver.set_l_lower_bound(-kMaxBound);
+  solver.set_l_upper_bound(kMaxBound);
+  solver.set_constraint_upper_bound(kMaxBound);
+  // the knots usually move little between two planning cycles, so the last
+  // solution is a good initial guess when the problem size is unchanged.
+  solver.SetWarmStart(last_primal_, last_dual_);
+
+  const double start_timestamp = Clock::NowInSeconds();
+  const bool success = solver.Solve();
+  const double end_timestamp = Clock::NowInSeconds();
+  ADEBUG << "Spline1dGenerator sparse QP solve time: "
+         << (end_timestamp - start_timestamp) * 1000 << " ms, "
+         << solver.num_iteration() << " iterations.";
+
+  if (!success) {
+    AERROR << "Sparse QP solver failed to solve spline 1d.";
+    last_primal_.resize(0, 0);
+    last_dual_.resize(0, 0);
+    return false;
+  }
+  last_primal_ = solver.params();
+  last_dual_ = solver.dual_params();
+  return spline_.SetSplineSegs(solver.params(), spline_.spline_order());
+}
+
 const Spline1d& Spline1dGenerator::spline() const { return spline_; }
 
 }  // namespace planning
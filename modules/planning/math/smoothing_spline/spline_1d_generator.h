@@ -79,6 +79,10 @@ class Spline1dGenerator {
   // output
   const Spline1d& spline() const;
 
+ private:
+  // solve with common::math::AdmmQpSolver warm started from the last solution
+  bool SolveWithSparseSolver();
+
  private:
   Spline1d spline_;
   Spline1dConstraint spline_constraint_;
@@ -86,6 +90,10 @@ class Spline1dGenerator {
 
   std::unique_ptr<::qpOASES::SQProblem> sqp_solver_;
 
+  // solution of the last sparse solve, used to warm start the next one
+  Eigen::MatrixXd last_primal_;
+  Eigen::MatrixXd last_dual_;
+
   int last_num_constraint_ = 0;
   int last_num_param_ = 0;
   bool last_problem_success_ = false;
@@ -26,6 +26,7 @@
 
 #include "modules/common/log.h"
 #include "modules/common/math/qp_solver/active_set_qp_solver.h"
+#include "modules/common/math/qp_solver/admm_qp_solver.h"
 #include "modules/common/math/qp_solver/qp_solver_gflags.h"
 #include "modules/common/time/time.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -81,6 +82,10 @@ bool Spline2dSolver::Solve() {
     return false;
   }
 
+  if (FLAGS_enable_sparse_qp_solver) {
+    return SolveWithSparseSolver();
+  }
+
   int num_param = kernel_matrix.rows();
   int num_constraint =
       equality_constraint_matrix.rows() + inequality_constraint_matrix.rows();
@@ -223,6 +228,42 @@ bool Spline2dSolver::Solve() {
   return spline_.set_splines(solved_params, spline_.spline_order());
 }
 
+bool Spline2dSolver::SolveWithSparseSolver() {
+  const MatrixXd& kernel_matrix = kernel_.kernel_matrix();
+  const MatrixXd& offset = kernel_.offset();
+  const auto& inequality_constraint = constraint_.inequality_constraint();
+  const auto& equality_constraint = constraint_.equality_constraint();
+
+  apollo::common::math::AdmmQpSolver solver(
+      kernel_matrix, offset, inequality_constraint.constraint_matrix(),
+      inequality_constraint.constraint_boundary(),
+      equality_constraint.constraint_matrix(),
+      equality_constraint.constraint_boundary());
+  solver.set_l_lower_bound(-kRoadBound);
+  solver.set_l_upper_bound(kRoadBound);
+  solver.set_constraint_upper_bound(kRoadBound);
+  // the knots usually move little between two planning cycles, so the last
+  // solution is a good initial guess when the problem size is unchanged.
+  solver.SetWarmStart(last_primal_, last_dual_);
+
+  const double start_timestamp = Clock::NowInSeconds();
+  const bool success = solver.Solve();
+  const double end_timestamp = Clock::NowInSeconds();
+  ADEBUG << "Spline2dSolver sparse QP solve time: "
+         << (end_timestamp - start_timestamp) * 1000 << " ms, "
+         << solver.num_iteration() << " iterations.";
+
+  if (!success) {
+    AERROR << "Sparse QP solver failed to solve spline 2d.";
+    last_primal_.resize(0, 0);
+    last_dual_.resize(0, 0);
+    return false;
+  }
+  last_primal_ = solver.params();
+  last_dual_ = solver.dual_params();
+  return spline_.set_splines(solver.params(), spline_.spline_order());
+}
+
 // extract
 const Spline2d& Spline2dSolver::spline() const { return spline_; }
 }  // namespace planning
@@ -51,12 +51,20 @@ class Spline2dSolver {
   // extract
   const Spline2d& spline() const;
 
+ private:
+  // solve with common::math::AdmmQpSolver warm started from the last solution
+  bool SolveWithSparseSolver();
+
  private:
   Spline2d spline_;
   Spline2dKernel kernel_;
   Spline2dConstraint constraint_;
   std::unique_ptr<::qpOASES::SQProblem> sqp_solver_;
 
+  // solution of the last sparse solve, used to warm start the next one
+  Eigen::MatrixXd last_primal_;
+  Eigen::MatrixXd last_dual_;
+
   int last_num_constraint_ = 0;
   int last_num_param_ = 0;
   bool last_problem_success_ = false;
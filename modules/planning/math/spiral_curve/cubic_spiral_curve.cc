@@ -26,6 +26,7 @@
 #include "modules/common/log.h"
 #include "modules/common/math/integral.h"
 #include "modules/planning/math/spiral_curve/spiral_formula.h"
+#include "modules/planning/math/spiral_curve/spiral_solution_table.h"
 
 namespace apollo {
 namespace planning {
@@ -34,6 +35,42 @@ using apollo::common::ErrorCode;
 using apollo::common::PathPoint;
 using apollo::common::Status;
 
+namespace {
+
+// The cubic spiral solutions with zero end curvatures, solved with a tight
+// tolerance once, on first use.
+const SpiralSolutionTable& SolutionTable() {
+  static const SpiralSolutionTable table([](
+      const double x, const double y, const double theta,
+      const SpiralSolutionTable::Solution* guess,
+      SpiralSolutionTable::Solution* solution) {
+    PathPoint start;
+    PathPoint end;
+    end.set_x(x);
+    end.set_y(y);
+    end.set_theta(theta);
+    SpiralCurveConfig config;
+    config.set_newton_raphson_tol(1e-6);
+    config.set_newton_raphson_max_iter(50);
+    config.set_use_solution_table(false);
+    CubicSpiralCurve curve(start, end);
+    curve.SetSpiralConfig(config);
+    if (guess != nullptr) {
+      curve.SetInitialGuess(*guess);
+    }
+    if (!curve.CalculatePath()) {
+      return false;
+    }
+    (*solution)[0] = curve.p_params()[1];
+    (*solution)[1] = curve.p_params()[2];
+    (*solution)[2] = curve.sg();
+    return true;
+  });
+  return table;
+}
+
+}  // namespace
+
 CubicSpiralCurve::CubicSpiralCurve(const PathPoint& s, const PathPoint& e)
     : SpiralCurve(s, e, 3) {
   // generate an order 3 cubic spiral path with four parameters
@@ -73,6 +110,13 @@ bool CubicSpiralCurve::CalculatePath() {
   p_shoot[2] = 0.0;
   p_shoot[3] = end_point().kappa();
 
+  SpiralSolutionTable::Solution guess;
+  if (GetInitialGuess(x_g, y_g, theta_g, &SolutionTable, &guess)) {
+    p_shoot[1] = guess[0];
+    p_shoot[2] = guess[1];
+    sg = guess[2];
+  }
+
   // intermediate params
   Eigen::Matrix<double, 3, 1> q_g;
   q_g << x_g, y_g, theta_g;            // goal, x(p, sg), y(p, sg), theta(p, sg)
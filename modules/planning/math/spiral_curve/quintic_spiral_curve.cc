@@ -26,6 +26,7 @@
 #include "modules/common/log.h"
 #include "modules/common/math/integral.h"
 #include "modules/planning/math/spiral_curve/spiral_formula.h"
+#include "modules/planning/math/spiral_curve/spiral_solution_table.h"
 
 namespace apollo {
 namespace planning {
@@ -34,6 +35,42 @@ using apollo::common::ErrorCode;
 using apollo::common::PathPoint;
 using apollo::common::Status;
 
+namespace {
+
+// The quintic spiral solutions with zero end curvatures, solved with a tight
+// tolerance once, on first use.
+const SpiralSolutionTable& SolutionTable() {
+  static const SpiralSolutionTable table([](
+      const double x, const double y, const double theta,
+      const SpiralSolutionTable::Solution* guess,
+      SpiralSolutionTable::Solution* solution) {
+    PathPoint start;
+    PathPoint end;
+    end.set_x(x);
+    end.set_y(y);
+    end.set_theta(theta);
+    SpiralCurveConfig config;
+    config.set_newton_raphson_tol(1e-6);
+    config.set_newton_raphson_max_iter(50);
+    config.set_use_solution_table(false);
+    QuinticSpiralCurve curve(start, end);
+    curve.SetSpiralConfig(config);
+    if (guess != nullptr) {
+      curve.SetInitialGuess(*guess);
+    }
+    if (!curve.CalculatePath()) {
+      return false;
+    }
+    (*solution)[0] = curve.p_params()[3];
+    (*solution)[1] = curve.p_params()[4];
+    (*solution)[2] = curve.sg();
+    return true;
+  });
+  return table;
+}
+
+}  // namespace
+
 QuinticSpiralCurve::QuinticSpiralCurve(const common::PathPoint& s,
                                        const common::PathPoint& e)
     : SpiralCurve(s, e, 5) {
@@ -76,6 +113,13 @@ bool QuinticSpiralCurve::CalculatePath() {
   p_shoot[4] = 0.0;
   p_shoot[5] = end_point().kappa();
 
+  SpiralSolutionTable::Solution guess;
+  if (GetInitialGuess(x_g, y_g, theta_g, &SolutionTable, &guess)) {
+    p_shoot[3] = guess[0];
+    p_shoot[4] = guess[1];
+    sg = guess[2];
+  }
+
   // intermediate params
   Eigen::Matrix<double, 3, 1> q_g;
   q_g << x_g, y_g, theta_g;            // goal, x(p, sg), y(p, sg), theta(p, sg)
@@ -39,6 +39,23 @@ void SpiralCurve::SetSpiralConfig(const SpiralCurveConfig& spiral_config) {
   spiral_config_ = spiral_config;
 }
 
+void SpiralCurve::SetInitialGuess(const SpiralSolutionTable::Solution& guess) {
+  has_initial_guess_ = true;
+  initial_guess_ = guess;
+}
+
+bool SpiralCurve::GetInitialGuess(
+    const double x_g, const double y_g, const double theta_g,
+    const SpiralSolutionTable& (*solution_table)(),
+    SpiralSolutionTable::Solution* guess) const {
+  if (has_initial_guess_) {
+    *guess = initial_guess_;
+    return true;
+  }
+  return spiral_config_.use_solution_table() &&
+         solution_table().Interpolate(x_g, y_g, theta_g, guess);
+}
+
 // output params
 const PathPoint& SpiralCurve::start_point() const {
   return *start_point_;
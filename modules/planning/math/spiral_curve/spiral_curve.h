@@ -30,6 +30,8 @@
 #include "modules/common/status/status.h"
 #include "modules/planning/proto/spiral_curve_config.pb.h"
 
+#include "modules/planning/math/spiral_curve/spiral_solution_table.h"
+
 namespace apollo {
 namespace planning {
 
@@ -44,6 +46,13 @@ class SpiralCurve {
    * constructor)
    **/
   void SetSpiralConfig(const SpiralCurveConfig& spiral_config);
+
+  /**
+   * @brief Starts the newton method of the next CalculatePath() from the two
+   * free curvature parameters and the length in guess, instead of the
+   * solution table.
+   **/
+  void SetInitialGuess(const SpiralSolutionTable::Solution& guess);
   /**
    * @brief Default process of calculating path without lookup table
    * @return errors of final state: fitted value vs true end point
@@ -82,6 +91,8 @@ class SpiralCurve {
   double sg_;
   double error_;
   SpiralCurveConfig spiral_config_;
+  bool has_initial_guess_ = false;
+  SpiralSolutionTable::Solution initial_guess_;
 
  protected:
   void set_sg(const double sg);
@@ -89,6 +100,17 @@ class SpiralCurve {
 
   bool ResultSanityCheck() const;
 
+  /**
+   * @brief Gets the initial guess of the newton method to the goal (x_g, y_g)
+   * with heading theta_g relative to the start point, from the guess set or
+   * from the table returned by solution_table.
+   * @return false if there is none, to start from the default guess
+   **/
+  bool GetInitialGuess(const double x_g, const double y_g,
+                       const double theta_g,
+                       const SpiralSolutionTable& (*solution_table)(),
+                       SpiralSolutionTable::Solution* guess) const;
+
   template <typename T>
   void PrependToPParams(T begin, T end) {
     std::copy(begin, end, p_params_.begin());
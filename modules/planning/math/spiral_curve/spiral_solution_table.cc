@@ -0,0 +1,119 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file: spiral_solution_table.cc
+ **/
+#include "modules/planning/math/spiral_curve/spiral_solution_table.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <utility>
+
+namespace apollo {
+namespace planning {
+
+namespace {
+// The goals beyond this angle off the start heading are left to the solver.
+constexpr double kMaxPhi = M_PI / 2.0;
+constexpr double kMinDistance = 1e-6;
+}  // namespace
+
+constexpr int SpiralSolutionTable::kNumPhi;
+constexpr int SpiralSolutionTable::kNumTheta;
+
+SpiralSolutionTable::SpiralSolutionTable(const Solver& solver)
+    : solutions_(kNumPhi * kNumTheta), is_solved_(kNumPhi * kNumTheta) {
+  std::vector<bool> is_visited(kNumPhi * kNumTheta);
+  std::queue<std::pair<int, int>> cells;
+  cells.emplace(kNumPhi / 2, kNumTheta / 2);
+  is_visited[Index(kNumPhi / 2, kNumTheta / 2)] = true;
+  constexpr int kNeighbors[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+  while (!cells.empty()) {
+    const int i_phi = cells.front().first;
+    const int i_theta = cells.front().second;
+    cells.pop();
+
+    const Solution* guess = nullptr;
+    for (const auto& neighbor : kNeighbors) {
+      const int n_phi = i_phi + neighbor[0];
+      const int n_theta = i_theta + neighbor[1];
+      if (n_phi < 0 || n_phi >= kNumPhi || n_theta < 0 ||
+          n_theta >= kNumTheta) {
+        continue;
+      }
+      const int n_index = Index(n_phi, n_theta);
+      if (is_solved_[n_index] && guess == nullptr) {
+        guess = &solutions_[n_index];
+      }
+      if (!is_visited[n_index]) {
+        is_visited[n_index] = true;
+        cells.emplace(n_phi, n_theta);
+      }
+    }
+
+    const double phi = -kMaxPhi + 2.0 * kMaxPhi * i_phi / (kNumPhi - 1);
+    const double theta = -M_PI + 2.0 * M_PI * i_theta / (kNumTheta - 1);
+    const int index = Index(i_phi, i_theta);
+    is_solved_[index] = solver(std::cos(phi), std::sin(phi), theta, guess,
+                               &solutions_[index]);
+  }
+}
+
+bool SpiralSolutionTable::Interpolate(const double x, const double y,
+                                      const double theta,
+                                      Solution* solution) const {
+  const double distance = std::hypot(x, y);
+  if (distance < kMinDistance) {
+    return false;
+  }
+  const double phi = std::atan2(y, x);
+  if (std::fabs(phi) > kMaxPhi || std::fabs(theta) > M_PI) {
+    return false;
+  }
+
+  const double u_phi = (phi + kMaxPhi) / (2.0 * kMaxPhi) * (kNumPhi - 1);
+  const double u_theta = (theta + M_PI) / (2.0 * M_PI) * (kNumTheta - 1);
+  const int i_phi = std::min(static_cast<int>(u_phi), kNumPhi - 2);
+  const int i_theta = std::min(static_cast<int>(u_theta), kNumTheta - 2);
+  const double r_phi = u_phi - i_phi;
+  const double r_theta = u_theta - i_theta;
+
+  Solution result = {{0.0, 0.0, 0.0}};
+  for (int d_phi = 0; d_phi < 2; ++d_phi) {
+    for (int d_theta = 0; d_theta < 2; ++d_theta) {
+      const int index = Index(i_phi + d_phi, i_theta + d_theta);
+      if (!is_solved_[index]) {
+        return false;
+      }
+      const double weight = (d_phi == 0 ? 1.0 - r_phi : r_phi) *
+                            (d_theta == 0 ? 1.0 - r_theta : r_theta);
+      for (std::size_t k = 0; k < result.size(); ++k) {
+        result[k] += weight * solutions_[index][k];
+      }
+    }
+  }
+
+  // scale the unit distance solution to the goal
+  (*solution)[0] = result[0] / distance;
+  (*solution)[1] = result[1] / distance;
+  (*solution)[2] = result[2] * distance;
+  return true;
+}
+
+}  // namespace planning
+}  // namespace apollo
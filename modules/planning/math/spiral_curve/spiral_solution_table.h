@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file: spiral_solution_table.h
+ * @brief: precomputed spiral solutions used as initial guesses
+ **/
+
+#ifndef MODULES_PLANNING_MATH_SPIRAL_CURVE_SPIRAL_SOLUTION_TABLE_H_
+#define MODULES_PLANNING_MATH_SPIRAL_CURVE_SPIRAL_SOLUTION_TABLE_H_
+
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @class SpiralSolutionTable
+ * @brief The solutions of the spirals from (0, 0) with heading 0 to the goals
+ * (cos(phi), sin(phi)) with heading theta, on a grid of phi and theta, with
+ * zero curvature at both ends.
+ *
+ * A solution is the two free curvature parameters and the length of the
+ * spiral. A spiral scaled by d keeps its headings, with curvatures scaled
+ * by 1 / d and length scaled by d, so the table covers the goals at any
+ * distance.
+ **/
+class SpiralSolutionTable {
+ public:
+  typedef std::array<double, 3> Solution;
+
+  /**
+   * @brief Solves the spiral to a goal, starting from the guess if it is not
+   * nullptr.
+   * @return false if the solver did not converge
+   **/
+  typedef std::function<bool(const double x, const double y,
+                             const double theta, const Solution* guess,
+                             Solution* solution)>
+      Solver;
+
+  /**
+   * @brief Fills the table by solving the spiral at every grid point. The
+   * grid points are solved outwards from the straight goal, each one starting
+   * from the solution of a solved neighbor, so the solver converges on the
+   * sharp goals it does not reach from a blind guess.
+   **/
+  explicit SpiralSolutionTable(const Solver& solver);
+
+  /**
+   * @brief Interpolates the solution to the goal (x, y) with heading theta
+   * in [-pi, pi], relative to the start point.
+   * @return false if the goal is out of the table or next to a grid point
+   * where the solver did not converge
+   **/
+  bool Interpolate(const double x, const double y, const double theta,
+                   Solution* solution) const;
+
+ private:
+  static constexpr int kNumPhi = 17;
+  static constexpr int kNumTheta = 33;
+
+  int Index(const int i_phi, const int i_theta) const {
+    return i_phi * kNumTheta + i_theta;
+  }
+
+  std::vector<Solution> solutions_;
+  std::vector<bool> is_solved_;
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_MATH_SPIRAL_CURVE_SPIRAL_SOLUTION_TABLE_H_
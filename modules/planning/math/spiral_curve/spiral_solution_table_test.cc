@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ **/
+
+#include "modules/planning/math/spiral_curve/spiral_solution_table.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/planning/math/spiral_curve/cubic_spiral_curve.h"
+#include "modules/planning/math/spiral_curve/quintic_spiral_curve.h"
+
+namespace apollo {
+namespace planning {
+
+using apollo::common::PathPoint;
+
+TEST(SpiralSolutionTable, Interpolate) {
+  // the straight line of length 1 at every grid point
+  SpiralSolutionTable table(
+      [](const double x, const double y, const double theta,
+         const SpiralSolutionTable::Solution* guess,
+         SpiralSolutionTable::Solution* solution) {
+        *solution = {{x, y, theta}};
+        return std::fabs(theta) < 3.0;
+      });
+  SpiralSolutionTable::Solution solution;
+  ASSERT_TRUE(table.Interpolate(4.0, 0.0, 0.0, &solution));
+  EXPECT_NEAR(0.25, solution[0], 1e-9);
+  EXPECT_NEAR(0.0, solution[1], 1e-9);
+  EXPECT_NEAR(0.0, solution[2], 1e-9);
+
+  // behind the start point, or next to a grid point not solved
+  EXPECT_FALSE(table.Interpolate(-1.0, 0.0, 0.0, &solution));
+  EXPECT_FALSE(table.Interpolate(1.0, 0.0, 3.1, &solution));
+  EXPECT_FALSE(table.Interpolate(0.0, 0.0, 0.0, &solution));
+}
+
+template <typename Curve>
+void ExpectReachGoal(const double x, const double y, const double theta) {
+  PathPoint start;
+  PathPoint end;
+  end.set_x(x);
+  end.set_y(y);
+  end.set_theta(theta);
+
+  SpiralCurveConfig config;
+  config.set_simpson_size(33);
+  config.set_use_solution_table(false);
+  Curve blind_curve(start, end);
+  blind_curve.SetSpiralConfig(config);
+  EXPECT_FALSE(blind_curve.CalculatePath());
+
+  // the table guess is close enough to converge
+  config.set_use_solution_table(true);
+  Curve curve(start, end);
+  curve.SetSpiralConfig(config);
+  ASSERT_TRUE(curve.CalculatePath());
+  std::vector<PathPoint> path_points;
+  ASSERT_TRUE(curve.GetPathVec(100, &path_points).ok());
+  EXPECT_NEAR(x, path_points.back().x(), 0.1);
+  EXPECT_NEAR(y, path_points.back().y(), 0.1);
+  EXPECT_NEAR(theta, path_points.back().theta(), 0.01);
+}
+
+TEST(SpiralSolutionTable, CubicSpiralCurve) {
+  ExpectReachGoal<CubicSpiralCurve>(2.0, -20.0, -1.5);
+}
+
+TEST(SpiralSolutionTable, QuinticSpiralCurve) {
+  ExpectReachGoal<QuinticSpiralCurve>(2.0, -20.0, -1.5);
+}
+
+}  // namespace planning
+}  // namespace apollo
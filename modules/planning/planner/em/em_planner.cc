@@ -21,6 +21,7 @@
 #include <utility>
 
 #include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/alloc_tracker/alloc_tracker.h"
 #include "modules/common/log.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/time/time.h"
@@ -31,8 +32,10 @@
 #include "modules/map/hdmap/hdmap_common.h"
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/task_profiler.h"
 #include "modules/planning/constraint_checker/constraint_checker.h"
 #include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
+#include "modules/planning/planner/em/task_quality_scheduler.h"
 #include "modules/planning/tasks/dp_poly_path/dp_poly_path_optimizer.h"
 #include "modules/planning/tasks/dp_st_speed/dp_st_speed_optimizer.h"
 #include "modules/planning/tasks/path_decider/path_decider.h"
@@ -46,6 +49,9 @@ namespace apollo {
 namespace planning {
 
 using common::Status;
+using common::alloc_tracker::AllocCounts;
+using common::alloc_tracker::AllocTracker;
+using common::alloc_tracker::ScopedAllocRegion;
 using common::adapter::AdapterManager;
 using common::time::Clock;
 using common::ErrorCode;
@@ -54,6 +60,29 @@ using common::SLPoint;
 using common::TrajectoryPoint;
 using common::math::Vec2d;
 
+namespace {
+
+// the name a task is profiled under, one per quality level
+std::string TaskProfileName(const std::string& name, const int quality_level) {
+  if (quality_level == 0) {
+    return name;
+  }
+  return common::util::StrCat(name, "@quality_", quality_level);
+}
+
+// the rolling p99 run time of a task at a quality level. A level with no
+// runs yet is assumed to take half the time of the level before it.
+double PredictTaskTimeMs(const std::string& name, const int quality_level) {
+  const auto percentiles = TaskProfiler::instance()->GetPercentiles(
+      TaskProfileName(name, quality_level));
+  if (percentiles.num_samples > 0 || quality_level == 0) {
+    return percentiles.p99_ms;
+  }
+  return 0.5 * PredictTaskTimeMs(name, quality_level - 1);
+}
+
+}  // namespace
+
 void EMPlanner::RegisterTasks() {
   task_factory_.Register(TRAFFIC_DECIDER,
                          []() -> Task* { return new TrafficDecider(); });
@@ -75,13 +104,24 @@ void EMPlanner::RegisterTasks() {
 Status EMPlanner::Init(const PlanningConfig& config) {
   AINFO << "In EMPlanner::Init()";
   RegisterTasks();
-  for (const auto task : config.em_planner_config().task()) {
-    tasks_.emplace_back(
+  config_ = config;
+  std::unique_ptr<TaskChain> tasks(new TaskChain());
+  const auto status = CreateTasks(tasks.get());
+  if (!status.ok()) {
+    return status;
+  }
+  ReleaseTasks(std::move(tasks));
+  return Status::OK();
+}
+
+Status EMPlanner::CreateTasks(TaskChain* tasks) {
+  for (const auto task : config_.em_planner_config().task()) {
+    tasks->emplace_back(
         task_factory_.CreateObject(static_cast<TaskType>(task)));
-    AINFO << "Created task:" << tasks_.back()->Name();
+    AINFO << "Created task:" << tasks->back()->Name();
   }
-  for (auto& task : tasks_) {
-    if (!task->Init(config)) {
+  for (auto& task : *tasks) {
+    if (!task->Init(config_)) {
       std::string msg(
           common::util::StrCat("Init task[", task->Name(), "] failed."));
       AERROR << msg;
@@ -91,12 +131,29 @@ Status EMPlanner::Init(const PlanningConfig& config) {
   return Status::OK();
 }
 
+std::unique_ptr<EMPlanner::TaskChain> EMPlanner::AcquireTasks() {
+  {
+    std::lock_guard<std::mutex> lock(tasks_mutex_);
+    if (!idle_tasks_.empty()) {
+      std::unique_ptr<TaskChain> tasks = std::move(idle_tasks_.back());
+      idle_tasks_.pop_back();
+      return tasks;
+    }
+  }
+  std::unique_ptr<TaskChain> tasks(new TaskChain());
+  if (!CreateTasks(tasks.get()).ok()) {
+    return nullptr;
+  }
+  return tasks;
+}
+
+void EMPlanner::ReleaseTasks(std::unique_ptr<TaskChain> tasks) {
+  std::lock_guard<std::mutex> lock(tasks_mutex_);
+  idle_tasks_.push_back(std::move(tasks));
+}
+
 void EMPlanner::RecordObstacleDebugInfo(
     ReferenceLineInfo* reference_line_info) {
-  if (!FLAGS_enable_record_debug) {
-    ADEBUG << "Skip record debug info";
-    return;
-  }
   auto ptr_debug = reference_line_info->mutable_debug();
 
   const auto path_decision = reference_line_info->path_decision();
@@ -119,9 +176,47 @@ void EMPlanner::RecordObstacleDebugInfo(
   }
 }
 
+void EMPlanner::ScheduleTaskQuality(const Frame& frame,
+                                    const size_t first_task, TaskChain* tasks,
+                                    ReferenceLineInfo* reference_line_info) {
+  const double time_left_ms =
+      FLAGS_anytime_planning_deadline_ms -
+      (Clock::NowInSeconds() - frame.start_time()) * 1000.0;
+  std::vector<TaskCost> costs(tasks->size() - first_task);
+  for (size_t i = 0; i < costs.size(); ++i) {
+    const auto& task = (*tasks)[first_task + i];
+    costs[i].quality_level = task->quality_level();
+    for (int level = 0; level < task->NumQualityLevels(); ++level) {
+      costs[i].time_ms.push_back(PredictTaskTimeMs(task->Name(), level));
+    }
+  }
+  const double predicted_time_ms = PredictedTimeMs(costs);
+  std::vector<size_t> degraded;
+  if (!DegradeTasksToFit(time_left_ms, &costs, &degraded)) {
+    AWARN << "Planning tasks are predicted to overrun the cycle deadline "
+          << FLAGS_anytime_planning_deadline_ms
+          << " ms even at their lowest quality.";
+  }
+  for (const size_t i : degraded) {
+    auto& task = (*tasks)[first_task + i];
+    task->SetQualityLevel(task->quality_level() + 1);
+    AWARN << "Degrade task " << task->Name() << " to quality level "
+          << task->quality_level() << ": " << predicted_time_ms
+          << " ms predicted with " << time_left_ms << " ms left.";
+    auto* degradation = reference_line_info->mutable_debug()
+                            ->mutable_planning_data()
+                            ->add_quality_degradation();
+    degradation->set_name(task->Name());
+    degradation->set_quality_level(task->quality_level());
+    degradation->set_time_left_ms(time_left_ms);
+    degradation->set_predicted_time_ms(predicted_time_ms);
+  }
+}
+
 void EMPlanner::RecordDebugInfo(ReferenceLineInfo* reference_line_info,
-                                const std::string& name,
-                                const double time_diff_ms) {
+                                const Task& task,
+                                const double time_diff_ms,
+                                const AllocCounts& alloc_counts) {
   if (!FLAGS_enable_record_debug) {
     ADEBUG << "Skip record debug info";
     return;
@@ -134,8 +229,50 @@ void EMPlanner::RecordDebugInfo(ReferenceLineInfo* reference_line_info,
   auto ptr_latency_stats = reference_line_info->mutable_latency_stats();
 
   auto ptr_stats = ptr_latency_stats->add_task_stats();
-  ptr_stats->set_name(name);
+  ptr_stats->set_name(task.Name());
   ptr_stats->set_time_ms(time_diff_ms);
+  ptr_stats->set_quality_level(task.quality_level());
+  if (AllocTracker::enabled()) {
+    ptr_stats->set_num_allocs(alloc_counts.num_allocs);
+    ptr_stats->set_alloc_bytes(alloc_counts.num_bytes);
+  }
+}
+
+void EMPlanner::RecordTaskProfile(ReferenceLineInfo* reference_line_info,
+                                  const Task& task,
+                                  const double time_diff_ms) {
+  // the anytime planning predicts the run times of the tasks from their
+  // profiles
+  if (!FLAGS_enable_task_profiler && !FLAGS_enable_anytime_planning) {
+    return;
+  }
+  if (reference_line_info == nullptr) {
+    AERROR << "Reference line info is null.";
+    return;
+  }
+  const std::string& name = task.Name();
+  const auto percentiles = TaskProfiler::instance()->Add(
+      TaskProfileName(name, task.quality_level()), time_diff_ms);
+  const int num_obstacles = static_cast<int>(
+      reference_line_info->path_decision()->path_obstacles().Items().size());
+  if (percentiles.num_samples >=
+          static_cast<size_t>(FLAGS_task_profiler_window_size) &&
+      time_diff_ms > percentiles.p99_ms) {
+    AWARN << "Task " << name << " takes " << time_diff_ms
+          << " ms, above its p99 " << percentiles.p99_ms << " ms, with "
+          << num_obstacles << " obstacles.";
+  }
+
+  auto* task_profile = reference_line_info->mutable_debug()
+                           ->mutable_planning_data()
+                           ->add_task_profile();
+  task_profile->set_name(name);
+  task_profile->set_time_ms(time_diff_ms);
+  task_profile->set_num_obstacles(num_obstacles);
+  task_profile->set_p50_time_ms(percentiles.p50_ms);
+  task_profile->set_p99_time_ms(percentiles.p99_ms);
+  task_profile->set_num_samples(static_cast<int>(percentiles.num_samples));
+  task_profile->set_quality_level(task.quality_level());
 }
 
 Status EMPlanner::Plan(const TrajectoryPoint& planning_start_point,
@@ -163,8 +300,21 @@ Status EMPlanner::Plan(const TrajectoryPoint& planning_start_point,
 
   auto ret = Status::OK();
 
-  for (auto& optimizer : tasks_) {
+  std::unique_ptr<TaskChain> tasks = AcquireTasks();
+  if (!tasks) {
+    reference_line_info->AddCost(std::numeric_limits<double>::infinity());
+    return Status(ErrorCode::PLANNING_ERROR, "Failed to create tasks");
+  }
+  for (auto& task : *tasks) {
+    task->SetQualityLevel(0);
+  }
+  for (size_t i = 0; i < tasks->size(); ++i) {
+    auto& optimizer = (*tasks)[i];
+    if (FLAGS_enable_anytime_planning) {
+      ScheduleTaskQuality(*frame, i, tasks.get(), reference_line_info);
+    }
     const double start_timestamp = Clock::NowInSeconds();
+    ScopedAllocRegion alloc_region(optimizer->Name());
     ret = optimizer->Execute(frame, reference_line_info);
     if (!ret.ok()) {
       reference_line_info->AddCost(std::numeric_limits<double>::infinity());
@@ -179,10 +329,15 @@ Status EMPlanner::Plan(const TrajectoryPoint& planning_start_point,
            << reference_line_info->PathSpeedDebugString() << std::endl;
     ADEBUG << optimizer->Name() << " time spend: " << time_diff_ms << " ms.";
 
-    RecordDebugInfo(reference_line_info, optimizer->Name(), time_diff_ms);
+    RecordDebugInfo(reference_line_info, *optimizer, time_diff_ms,
+                    alloc_region.Elapsed());
+    RecordTaskProfile(reference_line_info, *optimizer, time_diff_ms);
   }
+  ReleaseTasks(std::move(tasks));
 
-  RecordObstacleDebugInfo(reference_line_info);
+  if (frame->record_debug()) {
+    RecordObstacleDebugInfo(reference_line_info);
+  }
 
   DiscretizedTrajectory trajectory;
   if (!reference_line_info->CombinePathAndSpeedProfile(
@@ -18,6 +18,7 @@
 #define MODULES_PLANNING_PLANNER_EM_EM_PLANNER_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,7 @@
 #include "modules/planning/proto/planning.pb.h"
 #include "modules/planning/proto/planning_config.pb.h"
 
+#include "modules/common/alloc_tracker/alloc_tracker.h"
 #include "modules/common/status/status.h"
 #include "modules/common/util/factory.h"
 #include "modules/planning/common/reference_line_info.h"
@@ -43,6 +45,10 @@ namespace planning {
 /**
  * @class EMPlanner
  * @brief EMPlanner is an expectation maximization planner.
+ *
+ * \par
+ * Plan() can be called concurrently on different reference lines of the
+ * same frame: every call runs its own chain of tasks.
  */
 
 class EMPlanner : public Planner {
@@ -71,8 +77,24 @@ class EMPlanner : public Planner {
                       ReferenceLineInfo* reference_line_info) override;
 
  private:
+  typedef std::vector<std::unique_ptr<Task>> TaskChain;
+
   void RegisterTasks();
 
+  /**
+   * @brief creates and initializes the tasks listed in the config.
+   */
+  common::Status CreateTasks(TaskChain* tasks);
+
+  /**
+   * @brief takes an idle task chain, or creates one if all of them are
+   * in use by concurrent Plan() calls.
+   * @return nullptr if a new chain fails to initialize.
+   */
+  std::unique_ptr<TaskChain> AcquireTasks();
+
+  void ReleaseTasks(std::unique_ptr<TaskChain> tasks);
+
   std::vector<common::SpeedPoint> GenerateInitSpeedProfile(
       const common::TrajectoryPoint& planning_init_point,
       const ReferenceLineInfo* reference_line_info);
@@ -85,11 +107,28 @@ class EMPlanner : public Planner {
 
   void RecordObstacleDebugInfo(ReferenceLineInfo* reference_line_info);
 
+  /**
+   * @brief lowers the quality levels of the tasks from first_task on when
+   * their predicted run time would overrun the deadline of the cycle of the
+   * frame, and records the degradations in the debug.
+   */
+  void ScheduleTaskQuality(const Frame& frame, const size_t first_task,
+                           TaskChain* tasks,
+                           ReferenceLineInfo* reference_line_info);
+
   void RecordDebugInfo(ReferenceLineInfo* reference_line_info,
-                       const std::string& name, const double time_diff_ms);
+                       const Task& task, const double time_diff_ms,
+                       const common::alloc_tracker::AllocCounts& alloc_counts);
+
+  void RecordTaskProfile(ReferenceLineInfo* reference_line_info,
+                         const Task& task, const double time_diff_ms);
 
   apollo::common::util::Factory<TaskType, Task> task_factory_;
-  std::vector<std::unique_ptr<Task>> tasks_;
+  PlanningConfig config_;
+
+  /// Task chains not used by any running Plan() call.
+  std::vector<std::unique_ptr<TaskChain>> idle_tasks_;
+  std::mutex tasks_mutex_;
 };
 
 }  // namespace planning
@@ -0,0 +1,71 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file task_quality_scheduler.cc
+ **/
+
+#include "modules/planning/planner/em/task_quality_scheduler.h"
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace planning {
+
+double PredictedTimeMs(const std::vector<TaskCost>& tasks) {
+  double time_ms = 0.0;
+  for (const auto& task : tasks) {
+    if (task.quality_level < static_cast<int>(task.time_ms.size())) {
+      time_ms += task.time_ms[task.quality_level];
+    }
+  }
+  return time_ms;
+}
+
+bool DegradeTasksToFit(const double time_left_ms, std::vector<TaskCost>* tasks,
+                       std::vector<size_t>* degraded) {
+  CHECK_NOTNULL(tasks);
+  CHECK_NOTNULL(degraded);
+  double time_ms = PredictedTimeMs(*tasks);
+  while (time_ms > time_left_ms) {
+    size_t best_task = tasks->size();
+    double best_saving_ms = 0.0;
+    for (size_t i = 0; i < tasks->size(); ++i) {
+      const auto& task = (*tasks)[i];
+      const size_t next_level = static_cast<size_t>(task.quality_level) + 1;
+      if (next_level >= task.time_ms.size()) {
+        continue;
+      }
+      const double saving_ms =
+          task.time_ms[next_level - 1] - task.time_ms[next_level];
+      if (saving_ms > best_saving_ms) {
+        best_saving_ms = saving_ms;
+        best_task = i;
+      }
+    }
+    if (best_task == tasks->size()) {
+      return false;
+    }
+    ++(*tasks)[best_task].quality_level;
+    degraded->push_back(best_task);
+    time_ms -= best_saving_ms;
+  }
+  return true;
+}
+
+}  // namespace planning
+}  // namespace apollo
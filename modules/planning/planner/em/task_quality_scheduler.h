@@ -0,0 +1,60 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file task_quality_scheduler.h
+ **/
+
+#ifndef MODULES_PLANNING_PLANNER_EM_TASK_QUALITY_SCHEDULER_H_
+#define MODULES_PLANNING_PLANNER_EM_TASK_QUALITY_SCHEDULER_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace apollo {
+namespace planning {
+
+/**
+ * @brief the predicted cost of a task still to run in a planning cycle.
+ */
+struct TaskCost {
+  /// the predicted run time of the task at every quality level
+  std::vector<double> time_ms;
+  /// the quality level the task will run at
+  int quality_level = 0;
+};
+
+/**
+ * @brief the predicted run time of the tasks at their quality levels.
+ */
+double PredictedTimeMs(const std::vector<TaskCost>& tasks);
+
+/**
+ * @brief raises the quality levels of the tasks until their predicted run
+ * time fits in time_left_ms. Every step degrades by one level the task
+ * whose next level saves the most time, and it stops when no level saves
+ * time any more.
+ * @param degraded the indices of the tasks degraded at every step, in order.
+ * @return true if the predicted run time fits in time_left_ms.
+ */
+bool DegradeTasksToFit(const double time_left_ms, std::vector<TaskCost>* tasks,
+                       std::vector<size_t>* degraded);
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_PLANNER_EM_TASK_QUALITY_SCHEDULER_H_
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file task_quality_scheduler_test.cc
+ **/
+
+#include "modules/planning/planner/em/task_quality_scheduler.h"
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace planning {
+
+namespace {
+
+TaskCost MakeTaskCost(const std::vector<double>& time_ms) {
+  TaskCost cost;
+  cost.time_ms = time_ms;
+  return cost;
+}
+
+}  // namespace
+
+TEST(TaskQualitySchedulerTest, NoDegradationWhenTasksFit) {
+  std::vector<TaskCost> tasks = {MakeTaskCost({10.0, 5.0}),
+                                 MakeTaskCost({20.0, 8.0, 4.0})};
+  std::vector<size_t> degraded;
+  EXPECT_DOUBLE_EQ(30.0, PredictedTimeMs(tasks));
+  EXPECT_TRUE(DegradeTasksToFit(30.0, &tasks, &degraded));
+  EXPECT_TRUE(degraded.empty());
+  EXPECT_EQ(0, tasks[0].quality_level);
+  EXPECT_EQ(0, tasks[1].quality_level);
+}
+
+TEST(TaskQualitySchedulerTest, DegradesTheLargestSavingFirst) {
+  std::vector<TaskCost> tasks = {MakeTaskCost({10.0, 5.0}),
+                                 MakeTaskCost({20.0, 8.0, 4.0})};
+  std::vector<size_t> degraded;
+  EXPECT_TRUE(DegradeTasksToFit(15.0, &tasks, &degraded));
+  ASSERT_EQ(2, degraded.size());
+  EXPECT_EQ(1, degraded[0]);
+  EXPECT_EQ(0, degraded[1]);
+  EXPECT_EQ(1, tasks[0].quality_level);
+  EXPECT_EQ(1, tasks[1].quality_level);
+  EXPECT_DOUBLE_EQ(13.0, PredictedTimeMs(tasks));
+}
+
+TEST(TaskQualitySchedulerTest, StopsAtTheCoarsestLevels) {
+  std::vector<TaskCost> tasks = {MakeTaskCost({10.0, 5.0}),
+                                 MakeTaskCost({20.0, 8.0, 4.0}),
+                                 MakeTaskCost({3.0})};
+  std::vector<size_t> degraded;
+  EXPECT_FALSE(DegradeTasksToFit(5.0, &tasks, &degraded));
+  EXPECT_EQ(3, degraded.size());
+  EXPECT_EQ(1, tasks[0].quality_level);
+  EXPECT_EQ(2, tasks[1].quality_level);
+  EXPECT_EQ(0, tasks[2].quality_level);
+  EXPECT_DOUBLE_EQ(12.0, PredictedTimeMs(tasks));
+}
+
+}  // namespace planning
+}  // namespace apollo
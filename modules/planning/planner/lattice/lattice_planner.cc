@@ -0,0 +1,442 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file lattice_planner.cc
+ **/
+
+#include "modules/planning/planner/lattice/lattice_planner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+#include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/log.h"
+#include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/constraint_checker/collision_checker.h"
+#include "modules/planning/constraint_checker/constraint_checker.h"
+#include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
+#include "modules/planning/math/frame_conversion/cartesian_frenet_conversion.h"
+
+namespace apollo {
+namespace planning {
+
+using common::ErrorCode;
+using common::SLPoint;
+using common::Status;
+using common::TrajectoryPoint;
+using common::VehicleConfigHelper;
+using common::math::Vec2d;
+
+namespace {
+
+constexpr double kLatSampleDistance = 1.0;
+constexpr double kEpsilon = 1e-6;
+
+// The vehicle keeps the end speed of a longitudinal curve after it ends.
+double EvaluateLon(const Curve1d& curve, const std::uint32_t order,
+                   const double t) {
+  const double param = curve.ParamLength();
+  if (t <= param) {
+    return curve.Evaluate(order, t);
+  }
+  switch (order) {
+    case 0:
+      return curve.Evaluate(0, param) + curve.Evaluate(1, param) * (t - param);
+    case 1:
+      return curve.Evaluate(1, param);
+    default:
+      return 0.0;
+  }
+}
+
+// The vehicle keeps the end offset of a lateral curve after it ends.
+double EvaluateLat(const QuinticPolynomialCurve1d& curve,
+                   const std::uint32_t order, const double s) {
+  const double param = curve.ParamLength();
+  if (s <= param) {
+    return curve.Evaluate(order, std::max(s, 0.0));
+  }
+  return order == 0 ? curve.Evaluate(0, param) : 0.0;
+}
+
+struct Candidate {
+  double cost = 0.0;
+  std::size_t lon_index = 0;
+  std::size_t lat_index = 0;
+};
+
+struct CandidateComparator {
+  bool operator()(const Candidate& lhs, const Candidate& rhs) const {
+    return lhs.cost > rhs.cost;
+  }
+};
+
+}  // namespace
+
+Status LatticePlanner::Init(const PlanningConfig& config) {
+  config_ = config.lattice_planner_config();
+  return Status::OK();
+}
+
+Status LatticePlanner::Plan(const TrajectoryPoint& planning_init_point,
+                            Frame* frame,
+                            ReferenceLineInfo* reference_line_info) {
+  if (!reference_line_info->IsInited()) {
+    if (!reference_line_info->Init(frame->obstacles())) {
+      AERROR << "Failed to init reference line";
+      return Status(ErrorCode::PLANNING_ERROR, "Init reference line failed");
+    }
+  }
+  if (!reference_line_info->IsChangeLanePath()) {
+    const double kStraightForwardLineCost = 10.0;
+    reference_line_info->AddCost(kStraightForwardLineCost);
+  }
+
+  // 1. project the planning init point onto the reference line.
+  const auto& reference_line = reference_line_info->reference_line();
+  const auto& init_path_point = planning_init_point.path_point();
+  SLPoint init_sl;
+  if (!reference_line.XYToSL(Vec2d(init_path_point.x(), init_path_point.y()),
+                             &init_sl)) {
+    reference_line_info->AddCost(std::numeric_limits<double>::infinity());
+    std::string msg("Fail to project planning init point to reference line.");
+    AERROR << msg;
+    return Status(ErrorCode::PLANNING_ERROR, msg);
+  }
+  const auto init_ref_point = reference_line.GetReferencePoint(init_sl.s());
+  std::array<double, 3> init_s;
+  std::array<double, 3> init_d;
+  CartesianFrenetConverter::cartesian_to_frenet(
+      init_sl.s(), init_ref_point.x(), init_ref_point.y(),
+      init_ref_point.heading(), init_ref_point.kappa(),
+      init_ref_point.dkappa(), init_path_point.x(), init_path_point.y(),
+      planning_init_point.v(), planning_init_point.a(),
+      init_path_point.theta(), init_path_point.kappa(), &init_s, &init_d);
+
+  // 2. sample the longitudinal and lateral curves and cost them separately.
+  const double cruise_speed =
+      std::min(FLAGS_planning_upper_speed_limit,
+               reference_line.GetSpeedLimitFromS(init_s[0]));
+  const double stop_s = GetStopS(*reference_line_info);
+  std::vector<std::shared_ptr<Curve1d>> lon_curves;
+  SampleLonCurves(init_s, cruise_speed, stop_s, &lon_curves);
+  std::vector<QuinticPolynomialCurve1d> lat_curves;
+  SampleLatCurves(init_s, init_d, reference_line, &lat_curves);
+  if (lon_curves.empty() || lat_curves.empty()) {
+    reference_line_info->AddCost(std::numeric_limits<double>::infinity());
+    std::string msg("No valid lattice trajectory sample.");
+    AERROR << msg;
+    return Status(ErrorCode::PLANNING_ERROR, msg);
+  }
+
+  double max_lat_distance = 0.0;
+  for (const auto& lat_curve : lat_curves) {
+    max_lat_distance = std::max(max_lat_distance, lat_curve.ParamLength());
+  }
+  std::vector<double> lat_costs;
+  lat_costs.reserve(lat_curves.size());
+  for (const auto& lat_curve : lat_curves) {
+    lat_costs.push_back(LatCost(lat_curve, max_lat_distance));
+  }
+  std::priority_queue<Candidate, std::vector<Candidate>, CandidateComparator>
+      candidates;
+  for (std::size_t i = 0; i < lon_curves.size(); ++i) {
+    const double lon_cost = LonCost(*lon_curves[i], cruise_speed, stop_s);
+    for (std::size_t j = 0; j < lat_curves.size(); ++j) {
+      Candidate candidate;
+      candidate.cost = lon_cost + lat_costs[j];
+      candidate.lon_index = i;
+      candidate.lat_index = j;
+      candidates.push(candidate);
+    }
+  }
+
+  // 3. index the predicted obstacle boxes once for all candidates.
+  std::vector<const Obstacle*> obstacles;
+  for (const auto* path_obstacle :
+       reference_line_info->path_decision()->path_obstacles().Items()) {
+    obstacles.push_back(path_obstacle->obstacle());
+  }
+  const CollisionChecker collision_checker(
+      obstacles, config_.trajectory_time_resolution(),
+      FLAGS_trajectory_time_length);
+
+  // 4. check the candidates lazily from the cheapest one.
+  std::uint32_t num_checks = 0;
+  while (!candidates.empty() &&
+         num_checks < config_.max_num_trajectory_checks()) {
+    const Candidate candidate = candidates.top();
+    candidates.pop();
+    ++num_checks;
+    DiscretizedTrajectory trajectory;
+    if (!CombineTrajectory(planning_init_point, reference_line, init_s[0],
+                           *lon_curves[candidate.lon_index],
+                           lat_curves[candidate.lat_index], &trajectory)) {
+      continue;
+    }
+    if (!ConstraintChecker::ValidTrajectory(trajectory)) {
+      continue;
+    }
+    if (collision_checker.InCollision(trajectory,
+                                      config_.collision_buffer())) {
+      continue;
+    }
+    ADEBUG << "Lattice trajectory found after " << num_checks
+           << " checks, cost: " << candidate.cost;
+    reference_line_info->AddCost(candidate.cost);
+    reference_line_info->SetTrajectory(trajectory);
+    reference_line_info->SetDrivable(true);
+    return Status::OK();
+  }
+
+  reference_line_info->AddCost(std::numeric_limits<double>::infinity());
+  std::string msg("No collision free lattice trajectory found.");
+  AERROR << msg << " Checked " << num_checks << " candidates.";
+  return Status(ErrorCode::PLANNING_ERROR, msg);
+}
+
+void LatticePlanner::SampleLonCurves(
+    const std::array<double, 3>& init_s, const double cruise_speed,
+    const double stop_s,
+    std::vector<std::shared_ptr<Curve1d>>* const lon_curves) const {
+  CHECK_NOTNULL(lon_curves);
+  lon_curves->clear();
+  const std::uint32_t num_speeds = config_.num_lon_speed_samples();
+  for (std::uint32_t k = 1; k <= config_.num_lon_time_steps(); ++k) {
+    const double end_t = k * config_.lon_time_step();
+    for (std::uint32_t j = 0; j < num_speeds; ++j) {
+      const double end_v =
+          num_speeds > 1 ? cruise_speed * j / (num_speeds - 1) : cruise_speed;
+      std::shared_ptr<Curve1d> curve(new QuarticPolynomialCurve1d(
+          init_s[0], init_s[1], init_s[2], end_v, 0.0, end_t));
+      if (IsValidLonCurve(*curve)) {
+        lon_curves->push_back(curve);
+      }
+    }
+    if (std::isfinite(stop_s) && stop_s > init_s[0]) {
+      std::shared_ptr<Curve1d> curve(new QuinticPolynomialCurve1d(
+          init_s[0], init_s[1], init_s[2], stop_s, 0.0, 0.0, end_t));
+      if (IsValidLonCurve(*curve)) {
+        lon_curves->push_back(curve);
+      }
+    }
+  }
+}
+
+void LatticePlanner::SampleLatCurves(
+    const std::array<double, 3>& init_s, const std::array<double, 3>& init_d,
+    const ReferenceLine& reference_line,
+    std::vector<QuinticPolynomialCurve1d>* const lat_curves) const {
+  CHECK_NOTNULL(lat_curves);
+  lat_curves->clear();
+  const double half_width =
+      VehicleConfigHelper::instance()->GetConfig().vehicle_param().width() /
+      2.0;
+  const int num_offsets_per_side =
+      static_cast<int>(config_.num_lateral_offsets_per_side());
+  for (std::uint32_t k = 1; k <= config_.num_lateral_time_steps(); ++k) {
+    const double distance =
+        std::max(config_.min_lateral_distance(),
+                 init_s[1] * k * config_.lateral_time_step());
+    double left_width = 0.0;
+    double right_width = 0.0;
+    const bool has_width = reference_line.GetLaneWidth(
+        init_s[0] + distance, &left_width, &right_width);
+    for (int i = -num_offsets_per_side; i <= num_offsets_per_side; ++i) {
+      const double end_l = i * config_.lateral_offset_resolution();
+      // Always keep the lane center, and only keep the other offsets that
+      // stay in the lane.
+      if (i != 0 && (!has_width || end_l + half_width > left_width ||
+                     end_l - half_width < -right_width)) {
+        continue;
+      }
+      lat_curves->emplace_back(init_d[0], init_d[1], init_d[2], end_l, 0.0,
+                               0.0, distance);
+    }
+  }
+}
+
+bool LatticePlanner::IsValidLonCurve(const Curve1d& lon_curve) const {
+  const double time_resolution = config_.trajectory_time_resolution();
+  for (double t = 0.0; t < lon_curve.ParamLength() + kEpsilon;
+       t += time_resolution) {
+    const double v = lon_curve.Evaluate(1, t);
+    if (v < FLAGS_speed_lower_bound || v > FLAGS_speed_upper_bound) {
+      return false;
+    }
+    const double a = lon_curve.Evaluate(2, t);
+    if (a < FLAGS_longitudinal_acceleration_lower_bound ||
+        a > FLAGS_longitudinal_acceleration_upper_bound) {
+      return false;
+    }
+  }
+  return true;
+}
+
+double LatticePlanner::LonCost(const Curve1d& lon_curve,
+                               const double cruise_speed,
+                               const double stop_s) const {
+  const double time_resolution = config_.trajectory_time_resolution();
+  double speed_cost = 0.0;
+  double jerk_cost = 0.0;
+  for (double t = 0.0; t < FLAGS_trajectory_time_length + kEpsilon;
+       t += time_resolution) {
+    // The reference speed is the cruise speed, limited by a comfortable
+    // deceleration to the stop point.
+    double reference_speed = cruise_speed;
+    if (std::isfinite(stop_s)) {
+      const double distance_to_stop =
+          std::max(0.0, stop_s - EvaluateLon(lon_curve, 0, t));
+      reference_speed = std::min(
+          reference_speed,
+          std::sqrt(2.0 * config_.reference_deceleration() * distance_to_stop));
+    }
+    const double speed_diff = reference_speed - EvaluateLon(lon_curve, 1, t);
+    speed_cost += speed_diff * speed_diff;
+    const double jerk = EvaluateLon(lon_curve, 3, t);
+    jerk_cost += jerk * jerk;
+  }
+  return (config_.weight_lon_speed() * speed_cost +
+          config_.weight_lon_jerk() * jerk_cost) *
+         time_resolution;
+}
+
+double LatticePlanner::LatCost(const QuinticPolynomialCurve1d& lat_curve,
+                               const double max_lat_distance) const {
+  std::vector<double> s_samples;
+  for (double s = 0.0; s < lat_curve.ParamLength(); s += kLatSampleDistance) {
+    s_samples.push_back(s);
+  }
+  std::vector<double> l;
+  std::vector<double> dl;
+  std::vector<double> ddl;
+  lat_curve.BatchEvaluate(s_samples, &l, &dl, &ddl);
+  double offset_cost = 0.0;
+  double comfort_cost = 0.0;
+  for (std::size_t i = 0; i < s_samples.size(); ++i) {
+    offset_cost += l[i] * l[i];
+    comfort_cost += dl[i] * dl[i] + ddl[i] * ddl[i];
+  }
+  // Compare all curves over the same distance.
+  const double end_l = lat_curve.Evaluate(0, lat_curve.ParamLength());
+  offset_cost += end_l * end_l *
+                 std::max(0.0, max_lat_distance - lat_curve.ParamLength()) /
+                 kLatSampleDistance;
+  return (config_.weight_lat_offset() * offset_cost +
+          config_.weight_lat_comfort() * comfort_cost) *
+         kLatSampleDistance;
+}
+
+double LatticePlanner::GetStopS(
+    const ReferenceLineInfo& reference_line_info) const {
+  const auto& reference_line = reference_line_info.reference_line();
+  const double adc_end_s = reference_line_info.AdcSlBoundary().end_s();
+  const auto& vehicle_param =
+      VehicleConfigHelper::instance()->GetConfig().vehicle_param();
+  const double min_pass_width =
+      vehicle_param.width() + 2.0 * config_.collision_buffer();
+  double stop_s = std::numeric_limits<double>::infinity();
+  for (const auto* path_obstacle :
+       reference_line_info.path_decision().path_obstacles().Items()) {
+    const auto* obstacle = path_obstacle->obstacle();
+    if (!obstacle->IsStatic() && !obstacle->IsVirtual()) {
+      continue;
+    }
+    const auto& sl_boundary = path_obstacle->PerceptionSLBoundary();
+    if (sl_boundary.start_s() < adc_end_s) {
+      continue;
+    }
+    double left_width = 0.0;
+    double right_width = 0.0;
+    if (!reference_line.GetLaneWidth(sl_boundary.start_s(), &left_width,
+                                     &right_width)) {
+      continue;
+    }
+    // The obstacle blocks the lane if the vehicle can pass it on neither
+    // side.
+    const double left_space = left_width - sl_boundary.end_l();
+    const double right_space = sl_boundary.start_l() + right_width;
+    if (std::max(left_space, right_space) > min_pass_width) {
+      continue;
+    }
+    stop_s = std::min(stop_s, sl_boundary.start_s() - config_.stop_distance() -
+                                  vehicle_param.front_edge_to_center());
+  }
+  return stop_s;
+}
+
+bool LatticePlanner::CombineTrajectory(
+    const TrajectoryPoint& planning_init_point,
+    const ReferenceLine& reference_line, const double init_s,
+    const Curve1d& lon_curve, const QuinticPolynomialCurve1d& lat_curve,
+    DiscretizedTrajectory* const trajectory) const {
+  CHECK_NOTNULL(trajectory);
+  const double time_resolution = config_.trajectory_time_resolution();
+  double accumulated_s = planning_init_point.path_point().s();
+  double prev_x = 0.0;
+  double prev_y = 0.0;
+  for (std::size_t k = 0;
+       k * time_resolution < FLAGS_trajectory_time_length + kEpsilon; ++k) {
+    const double t = k * time_resolution;
+    const double s = EvaluateLon(lon_curve, 0, t);
+    if (s > reference_line.Length()) {
+      break;
+    }
+    const std::array<double, 3> s_condition = {
+        {s, EvaluateLon(lon_curve, 1, t), EvaluateLon(lon_curve, 2, t)}};
+    const double relative_s = s - init_s;
+    const std::array<double, 3> d_condition = {
+        {EvaluateLat(lat_curve, 0, relative_s),
+         EvaluateLat(lat_curve, 1, relative_s),
+         EvaluateLat(lat_curve, 2, relative_s)}};
+    const auto ref_point = reference_line.GetReferencePoint(s);
+    double x = 0.0;
+    double y = 0.0;
+    double theta = 0.0;
+    double kappa = 0.0;
+    double v = 0.0;
+    double a = 0.0;
+    CartesianFrenetConverter::frenet_to_cartesian(
+        s, ref_point.x(), ref_point.y(), ref_point.heading(), ref_point.kappa(),
+        ref_point.dkappa(), s_condition, d_condition, &x, &y, &theta, &kappa,
+        &v, &a);
+    if (k > 0) {
+      accumulated_s += std::hypot(x - prev_x, y - prev_y);
+    }
+    prev_x = x;
+    prev_y = y;
+
+    TrajectoryPoint trajectory_point;
+    auto* path_point = trajectory_point.mutable_path_point();
+    path_point->set_x(x);
+    path_point->set_y(y);
+    path_point->set_theta(theta);
+    path_point->set_kappa(kappa);
+    path_point->set_s(accumulated_s);
+    trajectory_point.set_v(v);
+    trajectory_point.set_a(a);
+    trajectory_point.set_relative_time(planning_init_point.relative_time() +
+                                       t);
+    trajectory->AppendTrajectoryPoint(trajectory_point);
+  }
+  return trajectory->NumOfPoints() >= 2;
+}
+
+}  // namespace planning
+}  // namespace apollo
@@ -0,0 +1,120 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file lattice_planner.h
+ **/
+
+#ifndef MODULES_PLANNING_PLANNER_LATTICE_LATTICE_PLANNER_H_
+#define MODULES_PLANNING_PLANNER_LATTICE_LATTICE_PLANNER_H_
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "modules/common/proto/pnc_point.pb.h"
+#include "modules/planning/proto/lattice_planner_config.pb.h"
+#include "modules/planning/proto/planning_config.pb.h"
+
+#include "modules/common/status/status.h"
+#include "modules/planning/common/reference_line_info.h"
+#include "modules/planning/common/trajectory/discretized_trajectory.h"
+#include "modules/planning/math/curve1d/curve1d.h"
+#include "modules/planning/math/curve1d/quintic_polynomial_curve1d.h"
+#include "modules/planning/planner/planner.h"
+#include "modules/planning/reference_line/reference_line.h"
+
+/**
+ * @namespace apollo::planning
+ * @brief apollo::planning
+ */
+namespace apollo {
+namespace planning {
+
+/**
+ * @class LatticePlanner
+ * @brief LatticePlanner samples longitudinal s(t) and lateral l(s) end
+ * conditions in the Frenet frame of the reference line, ranks every
+ * longitudinal and lateral pair by the sum of their separable costs, and
+ * returns the cheapest pair that passes the constraint and collision checks.
+ * Candidates are only combined and checked when they are popped from the
+ * cost queue, and at most max_num_trajectory_checks of them are checked, so
+ * the planning time is bounded by the configuration.
+ *
+ * \par
+ * Plan() keeps no state between calls, so it can be called concurrently on
+ * different reference lines of the same frame.
+ */
+class LatticePlanner : public Planner {
+ public:
+  /**
+   * @brief Constructor
+   */
+  LatticePlanner() = default;
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~LatticePlanner() = default;
+
+  common::Status Init(const PlanningConfig& config) override;
+
+  /**
+   * @brief Overrode function Plan in parent class Planner.
+   * @param planning_init_point The trajectory point where planning starts.
+   * @param frame Current planning frame.
+   * @param reference_line_info The computed reference line.
+   * @return OK if planning succeeds; error otherwise.
+   */
+  common::Status Plan(const common::TrajectoryPoint& planning_init_point,
+                      Frame* frame,
+                      ReferenceLineInfo* reference_line_info) override;
+
+ private:
+  void SampleLonCurves(const std::array<double, 3>& init_s,
+                       const double cruise_speed, const double stop_s,
+                       std::vector<std::shared_ptr<Curve1d>>* const lon_curves)
+      const;
+
+  void SampleLatCurves(const std::array<double, 3>& init_s,
+                       const std::array<double, 3>& init_d,
+                       const ReferenceLine& reference_line,
+                       std::vector<QuinticPolynomialCurve1d>* const lat_curves)
+      const;
+
+  bool IsValidLonCurve(const Curve1d& lon_curve) const;
+
+  double LonCost(const Curve1d& lon_curve, const double cruise_speed,
+                 const double stop_s) const;
+
+  double LatCost(const QuinticPolynomialCurve1d& lat_curve,
+                 const double max_lat_distance) const;
+
+  double GetStopS(const ReferenceLineInfo& reference_line_info) const;
+
+  bool CombineTrajectory(const common::TrajectoryPoint& planning_init_point,
+                         const ReferenceLine& reference_line,
+                         const double init_s, const Curve1d& lon_curve,
+                         const QuinticPolynomialCurve1d& lat_curve,
+                         DiscretizedTrajectory* const trajectory) const;
+
+  LatticePlannerConfig config_;
+};
+
+}  // namespace planning
+}  // namespace apollo
+
+#endif  // MODULES_PLANNING_PLANNER_LATTICE_LATTICE_PLANNER_H_
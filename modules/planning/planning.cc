@@ -22,13 +22,18 @@
 #include "google/protobuf/repeated_field.h"
 
 #include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/alloc_tracker/alloc_tracker.h"
 #include "modules/common/time/time.h"
+#include "modules/common/trace/trace.h"
+#include "modules/common/util/file.h"
+#include "modules/common/util/string_util.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/planning/common/planning_gflags.h"
 #include "modules/planning/common/planning_thread_pool.h"
 #include "modules/planning/common/trajectory/trajectory_stitcher.h"
 #include "modules/planning/planner/em/em_planner.h"
+#include "modules/planning/planner/lattice/lattice_planner.h"
 #include "modules/planning/planner/rtk/rtk_replay_planner.h"
 #include "modules/planning/reference_line/reference_line_provider.h"
 
@@ -40,7 +45,10 @@ using apollo::common::Status;
 using apollo::common::TrajectoryPoint;
 using apollo::common::VehicleStateProvider;
 using apollo::common::VehicleState;
+using apollo::common::adapter::AdapterConfig;
 using apollo::common::adapter::AdapterManager;
+using apollo::common::alloc_tracker::AllocTracker;
+using apollo::common::alloc_tracker::ScopedAllocRegion;
 using apollo::common::time::Clock;
 
 std::string Planning::Name() const {
@@ -52,6 +60,8 @@ void Planning::RegisterPlanners() {
       PlanningConfig::RTK, []() -> Planner* { return new RTKReplayPlanner(); });
   planner_factory_.Register(PlanningConfig::EM,
                             []() -> Planner* { return new EMPlanner(); });
+  planner_factory_.Register(PlanningConfig::LATTICE,
+                            []() -> Planner* { return new LatticePlanner(); });
 }
 
 Status Planning::InitFrame(const uint32_t sequence_num,
@@ -116,6 +126,13 @@ Status Planning::Init() {
   ReferenceLineProvider::instance()->Init(
       hdmap_, config_.qp_spline_reference_line_smoother_config());
 
+  if (FLAGS_enable_planning_flight_recorder) {
+    flight_recorder_.reset(new FlightRecorder(
+        static_cast<size_t>(FLAGS_planning_flight_recorder_size_mb) << 20,
+        FLAGS_planning_flight_recorder_max_records,
+        FLAGS_planning_flight_recorder_duration));
+  }
+
   RegisterPlanners();
   planner_ = planner_factory_.CreateObject(config_.planner_type());
   if (!planner_) {
@@ -165,6 +182,14 @@ void Planning::PublishPlanningPb(ADCTrajectory* trajectory_pb,
     trajectory_pb->mutable_routing_header()->CopyFrom(
         AdapterManager::GetRoutingResponse()->GetLatestObserved().header());
   }
+  if (AdapterManager::GetPrediction() &&
+      !AdapterManager::GetPrediction()->Empty()) {
+    common::trace::PropagateTrace(
+        AdapterManager::GetPrediction()->GetLatestObserved().header(),
+        trajectory_pb->mutable_header());
+  } else {
+    trajectory_pb->mutable_header()->clear_trace();
+  }
 
   // NOTICE:
   // Since we are using the time at each cycle beginning as timestamp, the
@@ -179,13 +204,117 @@ void Planning::PublishPlanningPb(ADCTrajectory* trajectory_pb,
     }
   }
   Publish(trajectory_pb);
+  if (flight_recorder_) {
+    RecordFlightOutput(trajectory_pb);
+  }
+}
+
+void Planning::RequestFlightRecordDump(const std::string& reason) {
+  std::lock_guard<std::mutex> lock(flight_dump_mutex_);
+  flight_dump_reason_ = reason;
+}
+
+void Planning::RecordFlightInputs() {
+  // The messages are only recorded when they are new.
+  if (!AdapterManager::GetLocalization()->Empty()) {
+    const auto& localization =
+        AdapterManager::GetLocalization()->GetLatestObserved();
+    flight_recorder_->Add(AdapterConfig::LOCALIZATION,
+                          localization.header().timestamp_sec(), localization);
+  }
+  if (!AdapterManager::GetChassis()->Empty()) {
+    const auto& chassis = AdapterManager::GetChassis()->GetLatestObserved();
+    flight_recorder_->Add(AdapterConfig::CHASSIS,
+                          chassis.header().timestamp_sec(), chassis);
+    const bool is_auto_driving =
+        chassis.driving_mode() == canbus::Chassis::COMPLETE_AUTO_DRIVE;
+    if (is_auto_driving_ && !is_auto_driving) {
+      RequestFlightRecordDump("takeover");
+    }
+    is_auto_driving_ = is_auto_driving;
+  }
+  if (FLAGS_enable_prediction && !AdapterManager::GetPrediction()->Empty()) {
+    const auto& prediction =
+        AdapterManager::GetPrediction()->GetLatestObserved();
+    flight_recorder_->Add(AdapterConfig::PREDICTION,
+                          prediction.header().timestamp_sec(), prediction);
+  }
+  if (FLAGS_enable_traffic_light &&
+      !AdapterManager::GetTrafficLightDetection()->Empty()) {
+    const auto& traffic_light =
+        AdapterManager::GetTrafficLightDetection()->GetLatestObserved();
+    flight_recorder_->Add(AdapterConfig::TRAFFIC_LIGHT_DETECTION,
+                          traffic_light.header().timestamp_sec(),
+                          traffic_light);
+  }
+  // The routing is kept out of the ring, as it is rarely received.
+  if (!AdapterManager::GetRoutingResponse()->Empty()) {
+    const auto& routing =
+        AdapterManager::GetRoutingResponse()->GetLatestObserved();
+    flight_recorder_->SetLatest(AdapterConfig::ROUTING_RESPONSE,
+                                routing.header().timestamp_sec(), routing);
+  }
+}
+
+void Planning::RecordFlightOutput(ADCTrajectory* trajectory_pb) {
+  // The debug is not recorded, as it is derived from the inputs. It is
+  // released instead of copied to keep the recording free of allocation.
+  planning_internal::Debug* debug =
+      trajectory_pb->has_debug() ? trajectory_pb->release_debug() : nullptr;
+  flight_recorder_->Add(AdapterConfig::PLANNING_TRAJECTORY,
+                        trajectory_pb->header().timestamp_sec(),
+                        *trajectory_pb);
+  if (debug != nullptr) {
+    trajectory_pb->set_allocated_debug(debug);
+  }
+
+  const bool is_planning_failed =
+      trajectory_pb->has_estop() ||
+      trajectory_pb->header().status().error_code() != ErrorCode::OK;
+  std::string reason;
+  {
+    std::lock_guard<std::mutex> lock(flight_dump_mutex_);
+    reason.swap(flight_dump_reason_);
+  }
+  if (reason.empty() && is_planning_failed && !is_planning_failed_) {
+    reason = trajectory_pb->has_estop() ? "estop" : "planning_failure";
+  }
+  is_planning_failed_ = is_planning_failed;
+  if (reason.empty()) {
+    return;
+  }
+
+  const double now = Clock::NowInSeconds();
+  if (now - last_flight_dump_time_ <
+      FLAGS_planning_flight_recorder_min_dump_interval) {
+    AWARN << "Skip the flight record dump on " << reason
+          << " right after the previous one";
+    return;
+  }
+  last_flight_dump_time_ = now;
+  if (!apollo::common::util::EnsureDirectory(
+          FLAGS_planning_flight_recorder_dir)) {
+    AERROR << "Failed to create " << FLAGS_planning_flight_recorder_dir;
+    return;
+  }
+  const std::string file_name = apollo::common::util::StrCat(
+      FLAGS_planning_flight_recorder_dir, "/planning_flight_record_",
+      static_cast<int64_t>(now), "_", reason, ".bin");
+  if (flight_recorder_->Dump(file_name)) {
+    AINFO << "Dumped " << flight_recorder_->NumRecords()
+          << " flight records on " << reason << " to " << file_name;
+  }
 }
 
 void Planning::RunOnce() {
   const double start_timestamp = Clock::NowInSeconds();
+  ScopedAllocRegion alloc_region("planning_cycle");
 
   // snapshot all coming data
   AdapterManager::Observe();
+  if (flight_recorder_) {
+    RecordFlightInputs();
+  }
 
   ADCTrajectory not_ready_pb;
   auto* not_ready = not_ready_pb.mutable_decision()
@@ -277,7 +406,13 @@ void Planning::RunOnce() {
     return;
   }
   auto* trajectory_pb = frame_->mutable_trajectory();
-  if (FLAGS_enable_record_debug) {
+  // The debug is the largest part of the planning message; skip it when
+  // nobody receives the message.
+  frame_->set_record_debug(
+      FLAGS_enable_record_debug &&
+      (FLAGS_record_debug_without_subscriber ||
+       AdapterManager::HasPlanningSubscribers()));
+  if (frame_->record_debug()) {
     frame_->RecordInputDebug(trajectory_pb->mutable_debug());
   }
   trajectory_pb->mutable_latency_stats()->set_init_frame_time_ms(
@@ -308,6 +443,13 @@ void Planning::RunOnce() {
   ADEBUG << "total planning time spend: " << time_diff_ms << " ms.";
 
   trajectory_pb->mutable_latency_stats()->set_total_time_ms(time_diff_ms);
+  if (AllocTracker::enabled()) {
+    const auto alloc_counts = alloc_region.Elapsed();
+    trajectory_pb->mutable_latency_stats()->set_num_allocs(
+        alloc_counts.num_allocs);
+    trajectory_pb->mutable_latency_stats()->set_alloc_bytes(
+        alloc_counts.num_bytes);
+  }
   ADEBUG << "Planning latency: "
          << trajectory_pb->latency_stats().DebugString();
 
@@ -349,7 +491,7 @@ void Planning::SetLastPublishableTrajectory(
 }
 
 void Planning::ExportReferenceLineDebug(planning_internal::Debug* debug) {
-  if (!FLAGS_enable_record_debug) {
+  if (!frame_->record_debug()) {
     return;
   }
   for (auto& reference_line_info : frame_->reference_line_info()) {
@@ -364,39 +506,105 @@ void Planning::ExportReferenceLineDebug(planning_internal::Debug* debug) {
   }
 }
 
+Status Planning::PlanInParallel(const TrajectoryPoint& planning_start_point) {
+  auto status = Status::OK();
+  // As in the sequential planning, only the first change lane path is
+  // planned, and when it is prioritized, it is planned alone first so that
+  // the lane keeping lines leave no virtual obstacles or traffic rule states
+  // behind when it wins.
+  auto change_lane_it = std::find_if(
+      frame_->reference_line_info().begin(),
+      frame_->reference_line_info().end(),
+      [](const ReferenceLineInfo& ref) { return ref.IsChangeLanePath(); });
+  std::vector<ReferenceLineInfo*> reference_line_infos;
+  if (change_lane_it != frame_->reference_line_info().end()) {
+    if (FLAGS_prioritize_change_lane) {
+      status = planner_->Plan(planning_start_point, frame_.get(),
+                              &(*change_lane_it));
+      if (change_lane_it->IsDrivable() &&
+          change_lane_it->TrajectoryLength() > FLAGS_change_lane_min_length) {
+        return status;
+      }
+      AERROR << "Fail to plan for lane change.";
+    } else {
+      reference_line_infos.push_back(&(*change_lane_it));
+    }
+  }
+  for (auto& reference_line_info : frame_->reference_line_info()) {
+    if (!reference_line_info.IsChangeLanePath()) {
+      reference_line_infos.push_back(&reference_line_info);
+    }
+  }
+
+  std::vector<Status> statuses(reference_line_infos.size(), Status::OK());
+  common::util::TaskGroup task_group(
+      PlanningThreadPool::instance()->mutable_thread_pool());
+  for (size_t i = 0; i < reference_line_infos.size(); ++i) {
+    task_group.Run([this, &planning_start_point, &reference_line_infos,
+                    &statuses, i]() {
+      statuses[i] = planner_->Plan(planning_start_point, frame_.get(),
+                                   reference_line_infos[i]);
+    });
+  }
+  task_group.Wait();
+
+  // Report the results in the order of the sequential planning, so that the
+  // status is the one of the last lane keeping line.
+  for (size_t i = 0; i < reference_line_infos.size(); ++i) {
+    const auto* reference_line_info = reference_line_infos[i];
+    if (reference_line_info->IsChangeLanePath()) {
+      if (!reference_line_info->IsDrivable() ||
+          reference_line_info->TrajectoryLength() <=
+              FLAGS_change_lane_min_length) {
+        AERROR << "Fail to plan for lane change.";
+      }
+    } else if (statuses[i] != Status::OK()) {
+      AERROR << "planner failed to make a driving plan for: "
+             << reference_line_info->Lanes().Id();
+    }
+    status = statuses[i];
+  }
+  return status;
+}
+
 Status Planning::Plan(const double current_time_stamp,
                       const std::vector<TrajectoryPoint>& stitching_trajectory,
                       ADCTrajectory* trajectory_pb) {
   auto* ptr_debug = trajectory_pb->mutable_debug();
-  if (FLAGS_enable_record_debug) {
+  if (frame_->record_debug()) {
     ptr_debug->mutable_planning_data()->mutable_init_point()->CopyFrom(
         stitching_trajectory.back());
   }
   auto status = Status::OK();
-  bool has_plan = false;
-  auto it = std::find_if(
-      frame_->reference_line_info().begin(),
-      frame_->reference_line_info().end(),
-      [](const ReferenceLineInfo& ref) { return ref.IsChangeLanePath(); });
-  if (it != frame_->reference_line_info().end()) {
-    status = planner_->Plan(stitching_trajectory.back(), frame_.get(), &(*it));
-    has_plan = (it->IsDrivable() && it->IsChangeLanePath() &&
-                it->TrajectoryLength() > FLAGS_change_lane_min_length);
-    if (!has_plan) {
-      AERROR << "Fail to plan for lane change.";
+  if (FLAGS_enable_parallel_reference_line_planning) {
+    status = PlanInParallel(stitching_trajectory.back());
+  } else {
+    bool has_plan = false;
+    auto it = std::find_if(
+        frame_->reference_line_info().begin(),
+        frame_->reference_line_info().end(),
+        [](const ReferenceLineInfo& ref) { return ref.IsChangeLanePath(); });
+    if (it != frame_->reference_line_info().end()) {
+      status =
+          planner_->Plan(stitching_trajectory.back(), frame_.get(), &(*it));
+      has_plan = (it->IsDrivable() && it->IsChangeLanePath() &&
+                  it->TrajectoryLength() > FLAGS_change_lane_min_length);
+      if (!has_plan) {
+        AERROR << "Fail to plan for lane change.";
+      }
     }
-  }
 
-  if (!has_plan || !FLAGS_prioritize_change_lane) {
-    for (auto& reference_line_info : frame_->reference_line_info()) {
-      if (reference_line_info.IsChangeLanePath()) {
-        continue;
-      }
-      status = planner_->Plan(stitching_trajectory.back(), frame_.get(),
-                              &reference_line_info);
-      if (status != Status::OK()) {
-        AERROR << "planner failed to make a driving plan for: "
-               << reference_line_info.Lanes().Id();
+    if (!has_plan || !FLAGS_prioritize_change_lane) {
+      for (auto& reference_line_info : frame_->reference_line_info()) {
+        if (reference_line_info.IsChangeLanePath()) {
+          continue;
+        }
+        status = planner_->Plan(stitching_trajectory.back(), frame_.get(),
+                                &reference_line_info);
+        if (status != Status::OK()) {
+          AERROR << "planner failed to make a driving plan for: "
+                 << reference_line_info.Lanes().Id();
+        }
       }
     }
   }
@@ -414,7 +622,9 @@ Status Planning::Plan(const double current_time_stamp,
     }
     return Status(ErrorCode::PLANNING_ERROR, msg);
   }
-  ptr_debug->MergeFrom(best_reference_line->debug());
+  if (frame_->record_debug()) {
+    ptr_debug->MergeFrom(best_reference_line->debug());
+  }
   trajectory_pb->mutable_latency_stats()->MergeFrom(
       best_reference_line->latency_stats());
   // set right of way status
@@ -427,7 +637,7 @@ Status Planning::Plan(const double current_time_stamp,
   best_reference_line->ExportDecision(trajectory_pb->mutable_decision());
 
   // Add debug information.
-  if (FLAGS_enable_record_debug) {
+  if (frame_->record_debug()) {
     auto* reference_line = ptr_debug->mutable_planning_data()->add_path();
     reference_line->set_name("planning_reference_line");
     const auto& reference_points =
@@ -18,6 +18,7 @@
 #define MODULES_PLANNING_PLANNING_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -29,6 +30,7 @@
 #include "modules/common/status/status.h"
 #include "modules/common/util/factory.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
+#include "modules/planning/common/flight_recorder.h"
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/trajectory/publishable_trajectory.h"
 #include "modules/planning/planner/planner.h"
@@ -83,6 +85,12 @@ class Planning : public PlanningInterface {
    */
   void SetLastPublishableTrajectory(const ADCTrajectory& adc_trajectory);
 
+  /**
+   * @brief dump the flight recorder at the end of the current planning
+   * cycle, e.g. on a monitor alert. It can be called from any thread.
+   */
+  void RequestFlightRecordDump(const std::string& reason);
+
  private:
   // Watch dog timer
   void OnTimer(const ros::TimerEvent&);
@@ -99,6 +107,16 @@ class Planning : public PlanningInterface {
       const std::vector<common::TrajectoryPoint>& stitching_trajectory,
       ADCTrajectory* trajectory);
 
+  /**
+   * @brief Plan all the reference lines of the frame concurrently on the
+   * planning thread pool. The result is the same as planning them one
+   * after another: when the change lane path is prioritized, it is planned
+   * first, and the lane keeping lines are planned only if it is not
+   * drivable.
+   */
+  common::Status PlanInParallel(
+      const common::TrajectoryPoint& planning_start_point);
+
   common::Status InitFrame(const uint32_t sequence_num,
                            const common::TrajectoryPoint& planning_start_point,
                            const double start_time,
@@ -107,6 +125,18 @@ class Planning : public PlanningInterface {
   bool IsVehicleStateValid(const common::VehicleState& vehicle_state);
   void ExportReferenceLineDebug(planning_internal::Debug* debug);
 
+  /**
+   * @brief Record the observed inputs into the flight recorder.
+   */
+  void RecordFlightInputs();
+
+  /**
+   * @brief Record the published trajectory into the flight recorder, and
+   * dump the recorder on a takeover, a new estop or planning failure, or a
+   * requested dump.
+   */
+  void RecordFlightOutput(ADCTrajectory* trajectory_pb);
+
   double start_time_ = 0.0;
 
   apollo::common::util::Factory<PlanningConfig::PlannerType, Planner>
@@ -122,6 +152,14 @@ class Planning : public PlanningInterface {
 
   std::unique_ptr<PublishableTrajectory> last_publishable_trajectory_;
 
+  std::unique_ptr<FlightRecorder> flight_recorder_;
+  // Why the flight recorder is dumped after the current cycle.
+  std::string flight_dump_reason_;
+  std::mutex flight_dump_mutex_;
+  double last_flight_dump_time_ = 0.0;
+  bool is_auto_driving_ = false;
+  bool is_planning_failed_ = false;
+
   ros::Timer timer_;
 };
 
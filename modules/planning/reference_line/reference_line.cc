@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -46,21 +47,26 @@ using apollo::hdmap::InterpolatedIndex;
 ReferenceLine::ReferenceLine(
     const std::vector<ReferencePoint>& reference_points)
     : reference_points_(reference_points),
-      map_path_(MapPath(std::vector<hdmap::MapPathPoint>(
-          reference_points.begin(), reference_points.end()))) {
-  CHECK_EQ(map_path_.num_points(), reference_points_.size());
+      map_path_(std::make_shared<const MapPath>(
+          std::vector<hdmap::MapPathPoint>(reference_points.begin(),
+                                           reference_points.end()))) {
+  CHECK_EQ(map_path_->num_points(), reference_points_.size());
 }
 
 ReferenceLine::ReferenceLine(const MapPath& hdmap_path)
-    : map_path_(hdmap_path) {
-  for (const auto& point : hdmap_path.path_points()) {
+    : ReferenceLine(std::make_shared<const MapPath>(hdmap_path)) {}
+
+ReferenceLine::ReferenceLine(std::shared_ptr<const MapPath> hdmap_path)
+    : map_path_(std::move(hdmap_path)) {
+  CHECK(map_path_ != nullptr);
+  for (const auto& point : map_path_->path_points()) {
     DCHECK(!point.lane_waypoints().empty());
     const auto& lane_waypoint = point.lane_waypoints()[0];
     reference_points_.emplace_back(
         hdmap::MapPathPoint(point, point.heading(), lane_waypoint), 0.0, 0.0,
         0.0, 0.0);
   }
-  CHECK_EQ(map_path_.num_points(), reference_points_.size());
+  CHECK_EQ(map_path_->num_points(), reference_points_.size());
 }
 
 bool ReferenceLine::Stitch(const ReferenceLine& other) {
@@ -117,7 +123,7 @@ bool ReferenceLine::Stitch(const ReferenceLine& other) {
     reference_points_.insert(reference_points_.end(),
                              other_points.begin() + end_i, other_points.end());
   }
-  map_path_ = MapPath(std::vector<hdmap::MapPathPoint>(
+  map_path_ = std::make_shared<const MapPath>(std::vector<hdmap::MapPathPoint>(
       reference_points_.begin(), reference_points_.end()));
   return true;
 }
@@ -129,7 +135,7 @@ bool ReferenceLine::Shrink(const common::math::Vec2d& point,
     AERROR << "Failed to project point: " << point.DebugString();
     return false;
   }
-  const auto& accumulated_s = map_path_.accumulated_s();
+  const auto& accumulated_s = map_path_->accumulated_s();
   size_t start_index = 0;
   if (sl.s() > look_backward) {
     auto it_lower = std::lower_bound(accumulated_s.begin(), accumulated_s.end(),
@@ -152,13 +158,13 @@ bool ReferenceLine::Shrink(const common::math::Vec2d& point,
     AERROR << "Too few reference points after shrinking.";
     return false;
   }
-  map_path_ = MapPath(std::vector<hdmap::MapPathPoint>(
+  map_path_ = std::make_shared<const MapPath>(std::vector<hdmap::MapPathPoint>(
       reference_points_.begin(), reference_points_.end()));
   return true;
 }
 
 ReferencePoint ReferenceLine::GetNearestReferencepoint(const double s) const {
-  const auto& accumulated_s = map_path_.accumulated_s();
+  const auto& accumulated_s = map_path_->accumulated_s();
   if (s < accumulated_s.front() - 1e-2) {
     AWARN << "The requested s " << s << " < 0";
     return reference_points_.front();
@@ -184,7 +190,7 @@ ReferencePoint ReferenceLine::GetNearestReferencepoint(const double s) const {
 }
 
 ReferencePoint ReferenceLine::GetReferencePoint(const double s) const {
-  const auto& accumulated_s = map_path_.accumulated_s();
+  const auto& accumulated_s = map_path_->accumulated_s();
   if (s < accumulated_s.front() - 1e-2) {
     AWARN << "The requested s " << s << " < 0";
     return reference_points_.front();
@@ -195,7 +201,7 @@ ReferencePoint ReferenceLine::GetReferencePoint(const double s) const {
     return reference_points_.back();
   }
 
-  auto interpolate_index = map_path_.GetIndexFromS(s);
+  auto interpolate_index = map_path_->GetIndexFromS(s);
 
   uint32_t index = interpolate_index.id;
   uint32_t next_index = index + 1;
@@ -257,8 +263,8 @@ ReferencePoint ReferenceLine::GetReferencePoint(const double x,
     return reference_points_[index_start];
   }
 
-  double s0 = map_path_.accumulated_s()[index_start];
-  double s1 = map_path_.accumulated_s()[index_end];
+  double s0 = map_path_->accumulated_s()[index_start];
+  double s1 = map_path_->accumulated_s()[index_end];
 
   double s = ReferenceLine::FindMinDistancePoint(
       reference_points_[index_start], s0, reference_points_[index_end], s1, x,
@@ -271,7 +277,7 @@ ReferencePoint ReferenceLine::GetReferencePoint(const double x,
 bool ReferenceLine::SLToXY(const SLPoint& sl_point,
                            common::math::Vec2d* const xy_point) const {
   CHECK_NOTNULL(xy_point);
-  if (map_path_.num_points() < 2) {
+  if (map_path_->num_points() < 2) {
     AERROR << "The reference line has too few points.";
     return false;
   }
@@ -288,7 +294,24 @@ bool ReferenceLine::XYToSL(const common::math::Vec2d& xy_point,
   DCHECK_NOTNULL(sl_point);
   double s = 0.0;
   double l = 0.0;
-  if (!map_path_.GetProjection(xy_point, &s, &l)) {
+  if (!map_path_->GetProjection(xy_point, &s, &l)) {
+    AERROR << "Can't get nearest point from path.";
+    return false;
+  }
+  sl_point->set_s(s);
+  sl_point->set_l(l);
+  return true;
+}
+
+bool ReferenceLine::XYToSL(const common::math::Vec2d& xy_point,
+                           const double warm_start_s,
+                           SLPoint* const sl_point) const {
+  DCHECK_NOTNULL(sl_point);
+  double s = 0.0;
+  double l = 0.0;
+  double distance = 0.0;
+  if (!map_path_->GetProjectionWithWarmStartS(xy_point, warm_start_s, &s, &l,
+                                             &distance)) {
     AERROR << "Can't get nearest point from path.";
     return false;
   }
@@ -297,6 +320,36 @@ bool ReferenceLine::XYToSL(const common::math::Vec2d& xy_point,
   return true;
 }
 
+bool ReferenceLine::XYToSL(const std::vector<common::math::Vec2d>& xy_points,
+                           const bool is_monotone_s,
+                           std::vector<SLPoint>* const sl_points) const {
+  CHECK_NOTNULL(sl_points);
+  sl_points->resize(xy_points.size());
+  for (size_t i = 0; i < xy_points.size(); ++i) {
+    const bool success =
+        (is_monotone_s && i > 0)
+            ? XYToSL(xy_points[i], (*sl_points)[i - 1].s(), &(*sl_points)[i])
+            : XYToSL(xy_points[i], &(*sl_points)[i]);
+    if (!success) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ReferenceLine::SLToXY(const std::vector<SLPoint>& sl_points,
+                           std::vector<common::math::Vec2d>* const xy_points)
+    const {
+  CHECK_NOTNULL(xy_points);
+  xy_points->resize(sl_points.size());
+  for (size_t i = 0; i < sl_points.size(); ++i) {
+    if (!SLToXY(sl_points[i], &(*xy_points)[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
 ReferencePoint ReferenceLine::InterpolateWithMatchedIndex(
     const ReferencePoint& p0, const double s0, const ReferencePoint& p1,
     const double s1, const InterpolatedIndex& index) const {
@@ -309,10 +362,10 @@ ReferencePoint ReferenceLine::InterpolateWithMatchedIndex(
   CHECK(!p0.lane_waypoints().empty());
   CHECK(!p1.lane_waypoints().empty());
 
-  auto map_path_point = map_path_.GetSmoothPoint(index);
+  auto map_path_point = map_path_->GetSmoothPoint(index);
   double upper_bound = 0.0;
   double lower_bound = 0.0;
-  map_path_.GetWidth(s, &upper_bound, &lower_bound);
+  map_path_->GetWidth(s, &upper_bound, &lower_bound);
 
   const double kappa = common::math::lerp(p0.kappa(), s0, p1.kappa(), s1, s);
   const double dkappa = common::math::lerp(p0.dkappa(), s0, p1.dkappa(), s1, s);
@@ -368,11 +421,11 @@ const std::vector<ReferencePoint>& ReferenceLine::reference_points() const {
   return reference_points_;
 }
 
-const MapPath& ReferenceLine::map_path() const { return map_path_; }
+const MapPath& ReferenceLine::map_path() const { return *map_path_; }
 
 bool ReferenceLine::GetLaneWidth(const double s, double* const left_width,
                                  double* const right_width) const {
-  return map_path_.GetWidth(s, left_width, right_width);
+  return map_path_->GetWidth(s, left_width, right_width);
 }
 
 bool ReferenceLine::IsOnRoad(const common::math::Vec2d& vec2d_point) const {
@@ -390,18 +443,18 @@ bool ReferenceLine::IsOnRoad(const SLBoundary& sl_boundary) const {
   double middle_s = (sl_boundary.start_s() + sl_boundary.end_s()) / 2.0;
   double left_width = 0.0;
   double right_width = 0.0;
-  map_path_.GetWidth(middle_s, &left_width, &right_width);
+  map_path_->GetWidth(middle_s, &left_width, &right_width);
   return sl_boundary.start_l() >= -right_width &&
          sl_boundary.end_l() <= left_width;
 }
 
 bool ReferenceLine::IsBlockRoad(const common::math::Box2d& box2d,
                                 double gap) const {
-  return map_path_.OverlapWith(box2d, gap);
+  return map_path_->OverlapWith(box2d, gap);
 }
 
 bool ReferenceLine::IsOnRoad(const SLPoint& sl_point) const {
-  if (sl_point.s() <= 0 || sl_point.s() > map_path_.length()) {
+  if (sl_point.s() <= 0 || sl_point.s() > map_path_->length()) {
     return false;
   }
   double left_width = 0.0;
@@ -426,13 +479,13 @@ bool ReferenceLine::GetApproximateSLBoundary(
   double s = 0.0;
   double l = 0.0;
   double distance = 0.0;
-  if (!map_path_.GetProjectionWithHueristicParams(box.center(), start_s, end_s,
+  if (!map_path_->GetProjectionWithHueristicParams(box.center(), start_s, end_s,
                                                   &s, &l, &distance)) {
     AERROR << "Can't get projection point from path.";
     return false;
   }
 
-  auto projected_point = map_path_.GetSmoothPoint(s);
+  auto projected_point = map_path_->GetSmoothPoint(s);
   auto rotated_box = box;
   rotated_box.RotateFromCenter(-projected_point.heading());
 
@@ -467,13 +520,13 @@ bool ReferenceLine::GetSLBoundary(const common::math::Box2d& box,
   double end_l(std::numeric_limits<double>::lowest());
   std::vector<common::math::Vec2d> corners;
   box.GetAllCorners(&corners);
-  for (const auto& point : corners) {
-    SLPoint sl_point;
-    if (!XYToSL(point, &sl_point)) {
-      AERROR << "failed to get projection for point: " << point.DebugString()
-             << " on reference line.";
-      return false;
-    }
+  std::vector<SLPoint> sl_corners;
+  if (!XYToSL(corners, false, &sl_corners)) {
+    AERROR << "failed to get projection for box: " << box.DebugString()
+           << " on reference line.";
+    return false;
+  }
+  for (const auto& sl_point : sl_corners) {
     start_s = std::fmin(start_s, sl_point.s());
     end_s = std::fmax(end_s, sl_point.s());
     start_l = std::fmin(start_l, sl_point.l());
@@ -506,7 +559,7 @@ bool ReferenceLine::HasOverlap(const common::math::Box2d& box) const {
     ADEBUG << "ref_s out of range:" << mid_s;
     return false;
   }
-  if (!map_path_.GetWidth(mid_s, &left_width, &right_width)) {
+  if (!map_path_->GetWidth(mid_s, &left_width, &right_width)) {
     AERROR << "failed to get width at s = " << mid_s;
     return false;
   }
@@ -21,6 +21,7 @@
 #ifndef MODULES_PLANNING_REFERENCE_LINE_REFERENCE_LINE_H_
 #define MODULES_PLANNING_REFERENCE_LINE_REFERENCE_LINE_H_
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -43,9 +44,15 @@ class ReferenceLine {
   template <typename Iterator>
   explicit ReferenceLine(const Iterator begin, const Iterator end)
       : reference_points_(begin, end),
-        map_path_(hdmap::Path(std::vector<hdmap::MapPathPoint>(begin, end))) {}
+        map_path_(std::make_shared<const hdmap::Path>(
+            std::vector<hdmap::MapPathPoint>(begin, end))) {}
   explicit ReferenceLine(const std::vector<ReferencePoint>& reference_points);
   explicit ReferenceLine(const hdmap::Path& hdmap_path);
+  /**
+   * @brief Builds the reference line on a shared map path, which is not
+   * copied, e.g. a path of the hdmap::PathCache.
+   */
+  explicit ReferenceLine(std::shared_ptr<const hdmap::Path> hdmap_path);
 
   /** Stitch current reference line with the other reference line
    * The stitching strategy is to use current reference points as much as
@@ -95,6 +102,27 @@ class ReferenceLine {
   bool XYToSL(const XYPoint& xy, common::SLPoint* const sl_point) const {
     return XYToSL(common::math::Vec2d(xy.x(), xy.y()), sl_point);
   }
+  /**
+   * @brief Transform a point to sl, starting the projection search around
+   * warm_start_s, e.g. the s of the previous point in a sequence of nearby
+   * points.
+   */
+  bool XYToSL(const common::math::Vec2d& xy_point, const double warm_start_s,
+              common::SLPoint* const sl_point) const;
+
+  /**
+   * @brief Transform a batch of points to sl. When is_monotone_s is true,
+   * e.g. for points sampled along a trajectory, each projection after the
+   * first one starts its search from the previous result.
+   */
+  bool XYToSL(const std::vector<common::math::Vec2d>& xy_points,
+              const bool is_monotone_s,
+              std::vector<common::SLPoint>* const sl_points) const;
+  /**
+   * @brief Transform a batch of sl points to xy.
+   */
+  bool SLToXY(const std::vector<common::SLPoint>& sl_points,
+              std::vector<common::math::Vec2d>* const xy_points) const;
 
   bool GetLaneWidth(const double s, double* const left_width,
                     double* const right_width) const;
@@ -121,7 +149,7 @@ class ReferenceLine {
    */
   bool HasOverlap(const common::math::Box2d& box) const;
 
-  double Length() const { return map_path_.length(); }
+  double Length() const { return map_path_->length(); }
 
   std::string DebugString() const;
 
@@ -159,7 +187,10 @@ class ReferenceLine {
 
  private:
   std::vector<ReferencePoint> reference_points_;
-  hdmap::Path map_path_;
+  // The map path is immutable: the copies of a reference line share it, and
+  // a change of the reference points replaces it.
+  std::shared_ptr<const hdmap::Path> map_path_ =
+      std::make_shared<const hdmap::Path>();
 };
 
 }  // namespace planning
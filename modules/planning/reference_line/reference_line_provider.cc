@@ -23,9 +23,11 @@
 #include <algorithm>
 #include <chrono>
 #include <limits>
+#include <memory>
 #include <utility>
 
 #include "modules/common/configs/vehicle_config_helper.h"
+#include "modules/common/scheduling/scheduler.h"
 #include "modules/common/time/time.h"
 #include "modules/map/pnc_map/path.h"
 #include "modules/planning/common/planning_gflags.h"
@@ -157,6 +159,8 @@ void ReferenceLineProvider::UpdateReferenceLine(
 }
 
 void ReferenceLineProvider::GenerateThread() {
+  common::scheduling::Scheduler::instance()->ApplyToCurrentThread(
+      "ReferenceLineProvider");
   constexpr int32_t kSleepTime = 50;  // milliseconds
   while (!is_stop_) {
     std::this_thread::yield();
@@ -302,7 +306,6 @@ bool ReferenceLineProvider::CreateReferenceLine(
         ++iter;
       }
     }
-    return true;
   } else {  // stitching reference line
     for (auto iter = segments->begin(); iter != segments->end();) {
       reference_lines->emplace_back();
@@ -316,6 +319,9 @@ bool ReferenceLineProvider::CreateReferenceLine(
       }
     }
   }
+  smoothed_segments_cache_.swap(next_smoothed_segments_cache_);
+  next_smoothed_segments_cache_.clear();
+  path_cache_.NextCycle();
   return true;
 }
 
@@ -381,9 +387,7 @@ bool ReferenceLineProvider::ExtendReferenceLine(const VehicleState &state,
     ADEBUG << "Could not further extend reference line";
     return true;
   }
-  hdmap::Path path;
-  hdmap::PncMap::CreatePathFromLaneSegments(shifted_segments, &path);
-  ReferenceLine new_ref(path);
+  ReferenceLine new_ref(CreatePath(shifted_segments));
   if (!SmoothPrefixedReferenceLine(*prev_ref, new_ref, reference_line)) {
     AWARN << "Failed to smooth forward shifted reference line";
     return SmoothRouteSegment(*segments, reference_line);
@@ -488,9 +492,36 @@ void ReferenceLineProvider::GetAnchorPoints(
 
 bool ReferenceLineProvider::SmoothRouteSegment(const RouteSegments &segments,
                                                ReferenceLine *reference_line) {
-  hdmap::Path path;
-  hdmap::PncMap::CreatePathFromLaneSegments(segments, &path);
-  return SmoothReferenceLine(ReferenceLine(path), reference_line);
+  std::string key;
+  if (FLAGS_enable_reference_line_smoothing_cache) {
+    key = hdmap::PathCache::Key(segments);
+    auto iter = smoothed_segments_cache_.find(key);
+    if (iter != smoothed_segments_cache_.end()) {
+      ADEBUG << "Reuse smoothed reference line of segments " << key;
+      *reference_line = iter->second;
+      next_smoothed_segments_cache_[key] = iter->second;
+      return true;
+    }
+  }
+  if (!SmoothReferenceLine(ReferenceLine(CreatePath(segments)),
+                           reference_line)) {
+    return false;
+  }
+  if (FLAGS_enable_reference_line_smoothing_cache) {
+    next_smoothed_segments_cache_[key] = *reference_line;
+  }
+  return true;
+}
+
+std::shared_ptr<const hdmap::Path> ReferenceLineProvider::CreatePath(
+    const RouteSegments &segments) {
+  if (FLAGS_enable_reference_line_path_cache) {
+    auto path = path_cache_.GetPath(segments);
+    return path != nullptr ? path : std::make_shared<const hdmap::Path>();
+  }
+  auto path = std::make_shared<hdmap::Path>();
+  hdmap::PncMap::CreatePathFromLaneSegments(segments, path.get());
+  return path;
 }
 
 bool ReferenceLineProvider::SmoothPrefixedReferenceLine(
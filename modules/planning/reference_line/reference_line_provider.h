@@ -35,6 +35,7 @@
 #include "modules/common/proto/vehicle_state.pb.h"
 
 #include "modules/common/util/util.h"
+#include "modules/map/pnc_map/path_cache.h"
 #include "modules/map/pnc_map/pnc_map.h"
 #include "modules/planning/math/smoothing_spline/spline_2d_solver.h"
 #include "modules/planning/reference_line/qp_spline_reference_line_smoother.h"
@@ -123,6 +124,13 @@ class ReferenceLineProvider {
   bool SmoothRouteSegment(const hdmap::RouteSegments& segments,
                           ReferenceLine* reference_line);
 
+  /**
+   * @brief Creates the map path of the segments, shared with the last cycle
+   * when the path cache is enabled.
+   */
+  std::shared_ptr<const hdmap::Path> CreatePath(
+      const hdmap::RouteSegments& segments);
+
   /**
    * @brief This function creates a smoothed forward reference line
    * based on the given segments.
@@ -158,6 +166,14 @@ class ReferenceLineProvider {
   std::list<ReferenceLine> reference_lines_;
   std::list<hdmap::RouteSegments> route_segments_;
   double last_calculation_time_ = 0.0;
+
+  /// smoothed reference lines keyed by the lane ranges of their route
+  /// segments. An entry is kept as long as it is used in the next cycle.
+  std::unordered_map<std::string, ReferenceLine> smoothed_segments_cache_;
+  std::unordered_map<std::string, ReferenceLine> next_smoothed_segments_cache_;
+
+  /// raw map paths of the route segments, kept the same way.
+  hdmap::PathCache path_cache_;
 };
 
 }  // namespace planning
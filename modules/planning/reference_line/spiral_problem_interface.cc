@@ -58,6 +58,11 @@ SpiralProblemInterface::SpiralProblemInterface(
   }
 
   piecewise_paths_.resize(num_of_points_ - 1);
+
+  has_warm_start_.resize(num_of_points_, false);
+  warm_start_theta_.resize(num_of_points_, 0.0);
+  warm_start_kappa_.resize(num_of_points_, 0.0);
+  warm_start_dkappa_.resize(num_of_points_, 0.0);
 }
 
 void SpiralProblemInterface::get_optimization_results(
@@ -236,6 +241,19 @@ bool SpiralProblemInterface::get_starting_point(int n, bool init_x, double* x,
   }
   x[1] = x[6];
 
+  for (std::size_t i = 0; i < num_of_points_; ++i) {
+    if (!has_warm_start_[i]) {
+      continue;
+    }
+    std::size_t index = i * 5;
+    // keep the guessed heading continuous with the relative headings
+    const double theta_diff =
+        common::math::AngleDiff(relative_theta_[i], warm_start_theta_[i]);
+    x[index] = relative_theta_[i] + theta_diff;
+    x[index + 1] = warm_start_kappa_[i];
+    x[index + 2] = warm_start_dkappa_[i];
+  }
+
   if (has_fixed_start_point_) {
     x[0] = start_theta_;
     x[1] = start_kappa_;
@@ -780,5 +798,16 @@ void SpiralProblemInterface::set_end_point(const double x, const double y,
   end_dkappa_ = dkappa;
 }
 
+void SpiralProblemInterface::set_warm_start_point(const std::size_t index,
+                                                  const double theta,
+                                                  const double kappa,
+                                                  const double dkappa) {
+  CHECK_LT(index, num_of_points_);
+  has_warm_start_[index] = true;
+  warm_start_theta_[index] = theta;
+  warm_start_kappa_[index] = kappa;
+  warm_start_dkappa_[index] = dkappa;
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -45,6 +45,13 @@ class SpiralProblemInterface : public Ipopt::TNLP {
   void set_end_point(const double x, const double y, const double theta,
                      const double kappa, const double dkappa);
 
+  /**
+   * @brief Use the given heading, curvature and curvature derivative as the
+   * initial guess of the point at index instead of the chord estimation.
+   */
+  void set_warm_start_point(const std::size_t index, const double theta,
+                            const double kappa, const double dkappa);
+
   void get_optimization_results(std::vector<double>* ptr_theta,
                                 std::vector<double>* ptr_kappa,
                                 std::vector<double>* ptr_dkappa,
@@ -135,6 +142,14 @@ class SpiralProblemInterface : public Ipopt::TNLP {
 
   std::vector<QuinticSpiralPath> piecewise_paths_;
 
+  std::vector<bool> has_warm_start_;
+
+  std::vector<double> warm_start_theta_;
+
+  std::vector<double> warm_start_kappa_;
+
+  std::vector<double> warm_start_dkappa_;
+
   bool has_fixed_start_point_ = false;
 
   double start_x_ = 0.0;
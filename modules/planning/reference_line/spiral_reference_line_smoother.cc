@@ -71,8 +71,8 @@ bool SpiralReferenceLineSmoother::Smooth(
       raw_point2d.emplace_back(rlp.x(), rlp.y());
     }
 
-    Smooth(raw_point2d, &opt_theta, &opt_kappa, &opt_dkappa, &opt_s, &opt_x,
-           &opt_y);
+    Smooth(raw_point2d, Eigen::Vector2d::Zero(), &opt_theta, &opt_kappa,
+           &opt_dkappa, &opt_s, &opt_x, &opt_y);
   } else {
     std::size_t start_index = 0;
     for (const auto& anchor_point : anchor_points_) {
@@ -123,8 +123,8 @@ bool SpiralReferenceLineSmoother::Smooth(
       fixed_start_kappa_ = anchor_points_[start_index - 1].path_point.kappa();
       fixed_start_dkappa_ = anchor_points_[start_index - 1].path_point.dkappa();
 
-      Smooth(raw_point2d, &opt_theta, &opt_kappa, &opt_dkappa, &opt_s, &opt_x,
-             &opt_y);
+      Smooth(raw_point2d, Eigen::Vector2d(zero_x_, zero_y_), &opt_theta,
+             &opt_kappa, &opt_dkappa, &opt_s, &opt_x, &opt_y);
 
       opt_theta.insert(opt_theta.begin(), overhead_theta.begin(),
                        overhead_theta.end());
@@ -178,6 +178,10 @@ bool SpiralReferenceLineSmoother::Smooth(
     return false;
   }
   *smoothed_reference_line = ReferenceLine(ref_points);
+  if (FLAGS_enable_spiral_smoother_warm_start) {
+    last_smoothed_reference_line_.reset(
+        new ReferenceLine(*smoothed_reference_line));
+  }
   const double end_timestamp = Clock::NowInSeconds();
   ADEBUG << "Spiral reference line smoother time: "
          << (end_timestamp - start_timestamp) * 1000 << " ms.";
@@ -185,6 +189,7 @@ bool SpiralReferenceLineSmoother::Smooth(
 }
 
 bool SpiralReferenceLineSmoother::Smooth(std::vector<Eigen::Vector2d> point2d,
+                                         const Eigen::Vector2d& point_offset,
                                          std::vector<double>* ptr_theta,
                                          std::vector<double>* ptr_kappa,
                                          std::vector<double>* ptr_dkappa,
@@ -195,6 +200,9 @@ bool SpiralReferenceLineSmoother::Smooth(std::vector<Eigen::Vector2d> point2d,
 
   SpiralProblemInterface* ptop = new SpiralProblemInterface(point2d);
   ptop->set_default_max_point_deviation(default_max_point_deviation_);
+  if (FLAGS_enable_spiral_smoother_warm_start) {
+    SetWarmStart(point2d, point_offset, ptop);
+  }
   if (fixed_start_point_) {
     ptop->set_start_point(fixed_start_x_, fixed_start_y_, fixed_start_theta_,
                           fixed_start_kappa_, fixed_start_dkappa_);
@@ -244,6 +252,36 @@ bool SpiralReferenceLineSmoother::Smooth(std::vector<Eigen::Vector2d> point2d,
          status == Ipopt::Solved_To_Acceptable_Level;
 }
 
+void SpiralReferenceLineSmoother::SetWarmStart(
+    const std::vector<Eigen::Vector2d>& point2d,
+    const Eigen::Vector2d& point_offset,
+    SpiralProblemInterface* const problem) const {
+  if (!last_smoothed_reference_line_) {
+    return;
+  }
+  // points further away are likely on another lane, e.g. after lane change
+  constexpr double kMaxWarmStartLateralDistance = 0.5;
+  const auto& last_ref = *last_smoothed_reference_line_;
+  std::size_t num_warm_start_points = 0;
+  for (std::size_t i = 0; i < point2d.size(); ++i) {
+    const Eigen::Vector2d point = point2d[i] + point_offset;
+    common::SLPoint sl_point;
+    if (!last_ref.XYToSL({point.x(), point.y()}, &sl_point)) {
+      continue;
+    }
+    if (sl_point.s() < 0.0 || sl_point.s() > last_ref.Length() ||
+        std::fabs(sl_point.l()) > kMaxWarmStartLateralDistance) {
+      continue;
+    }
+    const auto ref_point = last_ref.GetReferencePoint(sl_point.s());
+    problem->set_warm_start_point(i, ref_point.heading(), ref_point.kappa(),
+                                  ref_point.dkappa());
+    ++num_warm_start_points;
+  }
+  ADEBUG << "Spiral smoother warm starts " << num_warm_start_points << " of "
+         << point2d.size() << " points.";
+}
+
 std::vector<common::PathPoint> SpiralReferenceLineSmoother::Interpolate(
     const std::vector<double>& theta, const std::vector<double>& kappa,
     const std::vector<double>& dkappa, const std::vector<double>& s,
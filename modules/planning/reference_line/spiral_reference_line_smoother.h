@@ -21,6 +21,7 @@
 #ifndef MODULES_PLANNING_REFERENCE_LINE_SPIRAL_REFERENCE_LINE_SMOOTHER_H_
 #define MODULES_PLANNING_REFERENCE_LINE_SPIRAL_REFERENCE_LINE_SMOOTHER_H_
 
+#include <memory>
 #include <vector>
 
 #include "Eigen/Dense"
@@ -34,6 +35,8 @@
 namespace apollo {
 namespace planning {
 
+class SpiralProblemInterface;
+
 class SpiralReferenceLineSmoother : public ReferenceLineSmoother {
  public:
   explicit SpiralReferenceLineSmoother(
@@ -48,10 +51,19 @@ class SpiralReferenceLineSmoother : public ReferenceLineSmoother {
 
  private:
   bool Smooth(std::vector<Eigen::Vector2d> point2d,
+              const Eigen::Vector2d& point_offset,
               std::vector<double>* ptr_theta, std::vector<double>* ptr_kappa,
               std::vector<double>* ptr_dkappa, std::vector<double>* ptr_s,
               std::vector<double>* ptr_x, std::vector<double>* ptr_y) const;
 
+  /**
+   * @brief Guess the heading and curvature of the points, shifted by
+   * point_offset, from the last smoothed reference line.
+   */
+  void SetWarmStart(const std::vector<Eigen::Vector2d>& point2d,
+                    const Eigen::Vector2d& point_offset,
+                    SpiralProblemInterface* const problem) const;
+
   std::vector<common::PathPoint> Interpolate(const std::vector<double>& theta,
                                              const std::vector<double>& kappa,
                                              const std::vector<double>& dkappa,
@@ -90,6 +102,8 @@ class SpiralReferenceLineSmoother : public ReferenceLineSmoother {
   double zero_x_ = 0.0;
 
   double zero_y_ = 0.0;
+
+  std::unique_ptr<ReferenceLine> last_smoothed_reference_line_;
 };
 
 }  // namespace planning
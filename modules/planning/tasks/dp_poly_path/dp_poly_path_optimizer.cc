@@ -20,6 +20,7 @@
 
 #include "modules/planning/tasks/dp_poly_path/dp_poly_path_optimizer.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
@@ -38,11 +39,26 @@ DpPolyPathOptimizer::DpPolyPathOptimizer()
     : PathOptimizer("DpPolyPathOptimizer") {}
 
 bool DpPolyPathOptimizer::Init(const PlanningConfig &config) {
-  config_ = config.em_planner_config().dp_poly_path_config();
+  full_quality_config_ = config.em_planner_config().dp_poly_path_config();
+  ApplyQualityLevel();
   is_init_ = true;
   return true;
 }
 
+int DpPolyPathOptimizer::NumQualityLevels() const { return 3; }
+
+void DpPolyPathOptimizer::ApplyQualityLevel() {
+  constexpr uint32_t kMinSamplePointsNum = 3;
+  config_ = full_quality_config_;
+  uint32_t sample_points_num = config_.sample_points_num_each_level();
+  for (int level = 0; level < quality_level_; ++level) {
+    sample_points_num =
+        std::max(kMinSamplePointsNum, (sample_points_num + 1) / 2);
+  }
+  config_.set_sample_points_num_each_level(
+      std::min(sample_points_num, config_.sample_points_num_each_level()));
+}
+
 Status DpPolyPathOptimizer::Process(const SpeedData &speed_data,
                                     const ReferenceLine &,
                                     const common::TrajectoryPoint &init_point,
@@ -42,13 +42,23 @@ class DpPolyPathOptimizer : public PathOptimizer {
 
   bool Init(const PlanningConfig &config) override;
 
+  /**
+   * @brief every quality level halves the lateral samples of each level of
+   * the road graph, keeping at least 3 of them.
+   */
+  int NumQualityLevels() const override;
+
  private:
+  void ApplyQualityLevel() override;
+
   apollo::common::Status Process(const SpeedData &speed_data,
                                  const ReferenceLine &reference_line,
                                  const common::TrajectoryPoint &init_point,
                                  PathData *const path_data) override;
 
  private:
+  /// the config at quality level 0
+  DpPolyPathConfig full_quality_config_;
   DpPolyPathConfig config_;
 };
 
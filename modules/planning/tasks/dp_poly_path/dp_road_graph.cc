@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -45,6 +46,39 @@ namespace planning {
 using apollo::common::ErrorCode;
 using apollo::common::Status;
 
+namespace {
+
+// The graph nodes of a search all die when the search returns, so they are
+// allocated from an arena of the planning thread, which is rewound at the
+// start of every search and keeps its memory between planning cycles. A
+// search may run a pending task of the thread pool while it waits for its
+// edges, and that task may start another search on the same thread, so every
+// nesting depth has an arena of its own.
+class ScopedSearchArena {
+ public:
+  ScopedSearchArena() {
+    if (depth_ == arenas_.size()) {
+      arenas_.emplace_back(new Arena());
+    }
+    arena_ = arenas_[depth_++].get();
+    arena_->Reset();
+  }
+
+  ~ScopedSearchArena() { --depth_; }
+
+  Arena *arena() const { return arena_; }
+
+ private:
+  static thread_local std::vector<std::unique_ptr<Arena>> arenas_;
+  static thread_local std::size_t depth_;
+  Arena *arena_ = nullptr;
+};
+
+thread_local std::vector<std::unique_ptr<Arena>> ScopedSearchArena::arenas_;
+thread_local std::size_t ScopedSearchArena::depth_ = 0;
+
+}  // namespace
+
 DPRoadGraph::DPRoadGraph(const DpPolyPathConfig &config,
                          const ReferenceLineInfo &reference_line_info,
                          const SpeedData &speed_data)
@@ -90,17 +124,22 @@ bool DPRoadGraph::FindPathTunnel(
     const double path_length = cur_node.sl_point.s() - prev_node.sl_point.s();
     double current_s = 0.0;
     const auto &curve = cur_node.min_cost_curve;
+    std::vector<double> s_samples;
     while (current_s + path_resolution / 2.0 < path_length) {
-      const double l = curve.Evaluate(0, current_s);
-      const double dl = curve.Evaluate(1, current_s);
-      const double ddl = curve.Evaluate(2, current_s);
+      s_samples.push_back(current_s);
+      current_s += path_resolution;
+    }
+    std::vector<double> l;
+    std::vector<double> dl;
+    std::vector<double> ddl;
+    curve.BatchEvaluate(s_samples, &l, &dl, &ddl);
+    for (std::size_t j = 0; j < s_samples.size(); ++j) {
       common::FrenetFramePoint frenet_frame_point;
-      frenet_frame_point.set_s(accumulated_s + current_s);
-      frenet_frame_point.set_l(l);
-      frenet_frame_point.set_dl(dl);
-      frenet_frame_point.set_ddl(ddl);
+      frenet_frame_point.set_s(accumulated_s + s_samples[j]);
+      frenet_frame_point.set_l(l[j]);
+      frenet_frame_point.set_dl(dl[j]);
+      frenet_frame_point.set_ddl(ddl[j]);
       frenet_path.push_back(std::move(frenet_frame_point));
-      current_s += path_resolution;
     }
     if (i == min_cost_path.size() - 1) {
       accumulated_s += current_s;
@@ -148,8 +187,11 @@ bool DPRoadGraph::GenerateMinCostPath(
       config_, reference_line_, reference_line_info_.IsChangeLanePath(),
       obstacles, vehicle_config.vehicle_param(), speed_data_, init_sl_point_);
 
-  std::list<std::list<DPRoadGraphNode>> graph_nodes;
-  graph_nodes.emplace_back();
+  const ScopedSearchArena search_arena;
+  const ArenaAllocator<DPRoadGraphNode> allocator(search_arena.arena());
+  std::list<DPRoadGraphNodeList, ArenaAllocator<DPRoadGraphNodeList>>
+      graph_nodes(allocator);
+  graph_nodes.emplace_back(allocator);
   graph_nodes.back().emplace_back(init_sl_point_, nullptr, ComparableCost());
   auto &front = graph_nodes.front().front();
   size_t total_level = path_waypoints.size();
@@ -158,25 +200,20 @@ bool DPRoadGraph::GenerateMinCostPath(
     const auto &prev_dp_nodes = graph_nodes.back();
     const auto &level_points = path_waypoints[level];
 
-    graph_nodes.emplace_back();
+    graph_nodes.emplace_back(allocator);
 
     for (size_t i = 0; i < level_points.size(); ++i) {
       const auto &cur_point = level_points[i];
 
       graph_nodes.back().emplace_back(cur_point, nullptr);
-      auto &cur_node = graph_nodes.back().back();
-      if (FLAGS_enable_multi_thread_in_dp_poly_path) {
-        PlanningThreadPool::instance()->mutable_thread_pool()->Push(std::bind(
-            &DPRoadGraph::UpdateNode, this, std::ref(prev_dp_nodes), level,
-            total_level, &trajectory_cost, &(front), &(cur_node)));
-
-      } else {
+      if (!FLAGS_enable_multi_thread_in_dp_poly_path) {
         UpdateNode(prev_dp_nodes, level, total_level, &trajectory_cost, &front,
-                   &cur_node);
+                   &graph_nodes.back().back());
       }
     }
     if (FLAGS_enable_multi_thread_in_dp_poly_path) {
-      PlanningThreadPool::instance()->mutable_thread_pool()->JoinAll();
+      UpdateLevelInParallel(prev_dp_nodes, level, total_level,
+                            &trajectory_cost, &front, &graph_nodes.back());
     }
   }
 
@@ -208,7 +245,7 @@ bool DPRoadGraph::GenerateMinCostPath(
   return true;
 }
 
-void DPRoadGraph::UpdateNode(const std::list<DPRoadGraphNode> &prev_nodes,
+void DPRoadGraph::UpdateNode(const DPRoadGraphNodeList &prev_nodes,
                              const uint32_t level, const uint32_t total_level,
                              TrajectoryCost *trajectory_cost,
                              DPRoadGraphNode *front,
@@ -257,6 +294,97 @@ void DPRoadGraph::UpdateNode(const std::list<DPRoadGraphNode> &prev_nodes,
   }
 }
 
+void DPRoadGraph::UpdateLevelInParallel(
+    const DPRoadGraphNodeList &prev_nodes, const uint32_t level,
+    const uint32_t total_level, TrajectoryCost *trajectory_cost,
+    DPRoadGraphNode *front, DPRoadGraphNodeList *cur_nodes) {
+  DCHECK_NOTNULL(trajectory_cost);
+  DCHECK_NOTNULL(front);
+  DCHECK_NOTNULL(cur_nodes);
+  std::vector<const DPRoadGraphNode *> prev_node_ptrs;
+  for (const auto &prev_node : prev_nodes) {
+    prev_node_ptrs.push_back(&prev_node);
+  }
+  std::vector<DPRoadGraphNode *> cur_node_ptrs;
+  for (auto &cur_node : *cur_nodes) {
+    cur_node_ptrs.push_back(&cur_node);
+  }
+  const size_t num_prev = prev_node_ptrs.size();
+  const size_t num_cur = cur_node_ptrs.size();
+
+  double init_dl = 0.0;
+  double init_ddl = 0.0;
+  if (level == 1) {
+    init_dl = init_frenet_frame_point_.dl();
+    init_ddl = init_frenet_frame_point_.ddl();
+  }
+
+  // Edge (i, j) connects prev node i to cur node j, and the j-th direct
+  // edge connects the first node to cur node j.
+  std::vector<EdgeCost> edges(num_prev * num_cur);
+  std::vector<EdgeCost> direct_edges(level >= 2 ? num_cur : 0);
+  auto *thread_pool = PlanningThreadPool::instance()->mutable_thread_pool();
+  const auto evaluate_edge = [&](const size_t index) {
+    if (index >= edges.size()) {
+      // A direct edge.
+      const size_t j = index - edges.size();
+      const auto &cur_point = cur_node_ptrs[j]->sl_point;
+      EdgeCost &edge = direct_edges[j];
+      edge.curve = QuinticPolynomialCurve1d(
+          init_sl_point_.l(), init_frenet_frame_point_.dl(),
+          init_frenet_frame_point_.ddl(), cur_point.l(), 0.0, 0.0,
+          cur_point.s() - init_sl_point_.s());
+      edge.is_valid = IsValidCurve(edge.curve);
+      if (edge.is_valid) {
+        edge.cost = trajectory_cost->Calculate(
+            edge.curve, init_sl_point_.s(), cur_point.s(), level, total_level);
+      }
+      return;
+    }
+    const auto &prev_node = *prev_node_ptrs[index / num_cur];
+    const auto &prev_sl_point = prev_node.sl_point;
+    const auto &cur_point = cur_node_ptrs[index % num_cur]->sl_point;
+    EdgeCost &edge = edges[index];
+    edge.curve = QuinticPolynomialCurve1d(prev_sl_point.l(), init_dl, init_ddl,
+                                          cur_point.l(), 0.0, 0.0,
+                                          cur_point.s() - prev_sl_point.s());
+    edge.is_valid = IsValidCurve(edge.curve);
+    if (edge.is_valid) {
+      edge.cost = trajectory_cost->Calculate(edge.curve, prev_sl_point.s(),
+                                             cur_point.s(), level,
+                                             total_level) +
+                  prev_node.min_cost;
+    }
+  };
+  if (thread_pool != nullptr) {
+    thread_pool->ParallelFor(0, edges.size() + direct_edges.size(),
+                             evaluate_edge);
+  } else {
+    for (size_t index = 0; index < edges.size() + direct_edges.size();
+         ++index) {
+      evaluate_edge(index);
+    }
+  }
+
+  // Same order as UpdateNode(): the direct edge, which is tried after every
+  // valid edge there, wins if it is not worse than the best of them.
+  for (size_t j = 0; j < num_cur; ++j) {
+    bool has_valid_edge = false;
+    for (size_t i = 0; i < num_prev; ++i) {
+      const EdgeCost &edge = edges[i * num_cur + j];
+      if (!edge.is_valid) {
+        continue;
+      }
+      has_valid_edge = true;
+      cur_node_ptrs[j]->UpdateCost(prev_node_ptrs[i], edge.curve, edge.cost);
+    }
+    if (has_valid_edge && level >= 2 && direct_edges[j].is_valid) {
+      cur_node_ptrs[j]->UpdateCost(front, direct_edges[j].curve,
+                                   direct_edges[j].cost);
+    }
+  }
+}
+
 bool DPRoadGraph::SamplePathWaypoints(
     const common::TrajectoryPoint &init_point,
     std::vector<std::vector<common::SLPoint>> *const points) {
@@ -432,9 +560,14 @@ bool DPRoadGraph::CalculateFrenetPoint(
 
 bool DPRoadGraph::IsValidCurve(const QuinticPolynomialCurve1d &curve) const {
   constexpr double kMaxLateralDistance = 20.0;
+  std::vector<double> s_samples;
   for (double s = 0.0; s < curve.ParamLength(); s += 2.0) {
-    const double l = curve.Evaluate(0, s);
-    if (std::fabs(l) > kMaxLateralDistance) {
+    s_samples.push_back(s);
+  }
+  std::vector<double> l;
+  curve.BatchEvaluate(s_samples, &l, nullptr, nullptr);
+  for (const double curr_l : l) {
+    if (std::fabs(curr_l) > kMaxLateralDistance) {
       return false;
     }
   }
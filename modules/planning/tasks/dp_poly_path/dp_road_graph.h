@@ -31,6 +31,7 @@
 #include "modules/planning/proto/dp_poly_path_config.pb.h"
 
 #include "modules/common/status/status.h"
+#include "modules/planning/common/arena.h"
 #include "modules/planning/common/path/path_data.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/path_obstacle.h"
@@ -95,6 +96,12 @@ class DPRoadGraph {
     QuinticPolynomialCurve1d min_cost_curve;
   };
 
+  /**
+   * the nodes of one level of the graph, allocated from the search arena.
+   */
+  using DPRoadGraphNodeList =
+      std::list<DPRoadGraphNode, ArenaAllocator<DPRoadGraphNode>>;
+
   bool GenerateMinCostPath(const std::vector<const PathObstacle *> &obstacles,
                            std::vector<DPRoadGraphNode> *min_cost_path);
 
@@ -113,11 +120,31 @@ class DPRoadGraph {
                     const double end_s, const uint32_t curr_level,
                     const uint32_t total_level, ComparableCost *cost);
 
-  void UpdateNode(const std::list<DPRoadGraphNode> &prev_nodes,
+  void UpdateNode(const DPRoadGraphNodeList &prev_nodes,
                   const uint32_t level, const uint32_t total_level,
                   TrajectoryCost *trajectory_cost, DPRoadGraphNode *front,
                   DPRoadGraphNode *cur_node);
 
+  /**
+   * @brief the cost of one curve of the graph.
+   */
+  struct EdgeCost {
+    bool is_valid = false;
+    QuinticPolynomialCurve1d curve;
+    ComparableCost cost;
+  };
+
+  /**
+   * @brief updates all the nodes of a level the same way as UpdateNode(),
+   * but evaluates the curves of all the (prev, cur) pairs concurrently on
+   * the planning thread pool, then picks the best ones in order.
+   */
+  void UpdateLevelInParallel(const DPRoadGraphNodeList &prev_nodes,
+                             const uint32_t level, const uint32_t total_level,
+                             TrajectoryCost *trajectory_cost,
+                             DPRoadGraphNode *front,
+                             DPRoadGraphNodeList *cur_nodes);
+
  private:
   DpPolyPathConfig config_;
   common::TrajectoryPoint init_point_;
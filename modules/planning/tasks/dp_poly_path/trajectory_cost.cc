@@ -24,6 +24,7 @@
 #include <cmath>
 #include <limits>
 #include <utility>
+#include <vector>
 
 #include "modules/common/proto/pnc_point.pb.h"
 
@@ -126,45 +127,124 @@ TrajectoryCost::TrajectoryCost(
       dynamic_obstacle_boxes_.push_back(std::move(box_by_time));
     }
   }
+  BuildObstacleIndex();
 }
 
-ComparableCost TrajectoryCost::CalculatePathCost(
-    const QuinticPolynomialCurve1d &curve, const double start_s,
-    const double end_s, const uint32_t curr_level, const uint32_t total_level) {
-  ComparableCost cost;
-  double path_cost = 0.0;
-  for (double path_s = 0.0; path_s < (end_s - start_s);
-       path_s += config_.path_resolution()) {
-    const double l = curve.Evaluate(0, path_s);
+void TrajectoryCost::BuildObstacleIndex() {
+  // Static obstacles only have a cost when the ADC overlaps them laterally,
+  // see GetCostFromObsSL().
+  const auto &vehicle_param =
+      common::VehicleConfigHelper::instance()->GetConfig().vehicle_param();
+  std::vector<std::pair<double, double>> l_ranges;
+  for (const auto &sl_boundary : static_obstacle_sl_boundaries_) {
+    l_ranges.emplace_back(sl_boundary.start_l() -
+                              vehicle_param.left_edge_to_center() -
+                              FLAGS_lateral_ignore_buffer,
+                          sl_boundary.end_l() +
+                              vehicle_param.right_edge_to_center() +
+                              FLAGS_lateral_ignore_buffer);
+    static_obstacle_l_breaks_.push_back(l_ranges.back().first);
+    static_obstacle_l_breaks_.push_back(l_ranges.back().second);
+  }
+  std::sort(static_obstacle_l_breaks_.begin(), static_obstacle_l_breaks_.end());
+  static_obstacle_l_breaks_.erase(
+      std::unique(static_obstacle_l_breaks_.begin(),
+                  static_obstacle_l_breaks_.end()),
+      static_obstacle_l_breaks_.end());
+  static_obstacles_by_slab_.resize(static_obstacle_l_breaks_.size() + 1);
+  for (size_t i = 0; i < l_ranges.size(); ++i) {
+    const size_t first_slab =
+        std::lower_bound(static_obstacle_l_breaks_.begin(),
+                         static_obstacle_l_breaks_.end(), l_ranges[i].first) -
+        static_obstacle_l_breaks_.begin() + 1;
+    const size_t last_slab =
+        std::lower_bound(static_obstacle_l_breaks_.begin(),
+                         static_obstacle_l_breaks_.end(), l_ranges[i].second) -
+        static_obstacle_l_breaks_.begin() + 1;
+    for (size_t slab = first_slab; slab <= last_slab; ++slab) {
+      static_obstacles_by_slab_[slab].push_back(i);
+    }
+  }
 
-    std::function<double(const double)> quasi_softmax = [this](const double x) {
-      const double l0 = this->config_.path_l_cost_param_l0();
-      const double b = this->config_.path_l_cost_param_b();
-      const double k = this->config_.path_l_cost_param_k();
-      return (b + std::exp(-k * (x - l0))) / (1.0 + std::exp(-k * (x - l0)));
-    };
+  // The speed profile and the obstacle boxes only depend on the time index,
+  // so they are the same for every curve.
+  double time_stamp = 0.0;
+  std::size_t speed_index = 0;
+  for (uint32_t index = 0; index < num_of_time_stamps_;
+       ++index, time_stamp += config_.eval_time_interval()) {
+    common::SpeedPoint speed_point;
+    heuristic_speed_data_.EvaluateByTime(time_stamp, &speed_point,
+                                         &speed_index);
+    heuristic_s_by_time_.push_back(speed_point.s());
 
-    path_cost += l * l * config_.path_l_cost() * quasi_softmax(std::fabs(l));
+    dynamic_obstacle_aaboxes_by_time_.emplace_back();
+    for (const auto &obstacle_trajectory : dynamic_obstacle_boxes_) {
+      dynamic_obstacle_aaboxes_by_time_.back().push_back(
+          obstacle_trajectory[index].GetAABox());
+    }
+  }
+}
 
-    double left_width = 0.0;
-    double right_width = 0.0;
-    reference_line_->GetLaneWidth(path_s, &left_width, &right_width);
+const std::vector<size_t> &TrajectoryCost::StaticObstacleCandidates(
+    const double l) const {
+  const size_t slab =
+      std::upper_bound(static_obstacle_l_breaks_.begin(),
+                       static_obstacle_l_breaks_.end(), l) -
+      static_obstacle_l_breaks_.begin();
+  return static_obstacles_by_slab_[slab];
+}
 
-    const auto &vehicle_config =
-        common::VehicleConfigHelper::instance()->GetConfig();
-    const double width = vehicle_config.vehicle_param().width();
+ComparableCost TrajectoryCost::CalculatePathCost(
+    const QuinticPolynomialCurve1d &curve, const double start_s,
+    const double end_s, const uint32_t curr_level, const uint32_t total_level) {
+  // Sample the curve into contiguous arrays first, then accumulate the cost
+  // over them, so that the cost loop does not interleave curve evaluation.
+  const double length = end_s - start_s;
+  const double resolution = config_.path_resolution();
+  std::vector<double> path_s_samples;
+  for (double path_s = 0.0; path_s < length; path_s += resolution) {
+    path_s_samples.push_back(path_s);
+  }
+  const size_t num_samples = path_s_samples.size();
+  std::vector<double> l;
+  std::vector<double> dl;
+  std::vector<double> ddl;
+  curve.BatchEvaluate(path_s_samples, &l, &dl, &ddl);
+
+  const double l0 = config_.path_l_cost_param_l0();
+  const double b = config_.path_l_cost_param_b();
+  const double k = config_.path_l_cost_param_k();
+  const double l_cost = config_.path_l_cost();
+  const double dl_cost = config_.path_dl_cost();
+  const double ddl_cost = config_.path_ddl_cost();
+  double path_cost = 0.0;
+  for (size_t i = 0; i < num_samples; ++i) {
+    const double exp_term = std::exp(-k * (std::fabs(l[i]) - l0));
+    const double quasi_softmax = (b + exp_term) / (1.0 + exp_term);
+    path_cost += l[i] * l[i] * l_cost * quasi_softmax;
+    path_cost += dl[i] * dl[i] * dl_cost;
+    path_cost += ddl[i] * ddl[i] * ddl_cost;
+  }
 
+  ComparableCost cost;
+  if (!is_change_lane_path_) {
+    const double half_width =
+        common::VehicleConfigHelper::instance()->GetConfig()
+            .vehicle_param()
+            .width() /
+        2.0;
     constexpr double kBuff = 0.2;
-    if (!is_change_lane_path_ && (l + width / 2.0 + kBuff > left_width ||
-                                  l - width / 2.0 - kBuff < -right_width)) {
-      cost.out_of_boundary = true;
+    for (size_t i = 0; i < num_samples; ++i) {
+      double left_width = 0.0;
+      double right_width = 0.0;
+      reference_line_->GetLaneWidth(path_s_samples[i], &left_width,
+                                    &right_width);
+      if (l[i] + half_width + kBuff > left_width ||
+          l[i] - half_width - kBuff < -right_width) {
+        cost.out_of_boundary = true;
+        break;
+      }
     }
-
-    const double dl = std::fabs(curve.Evaluate(1, path_s));
-    path_cost += dl * dl * config_.path_dl_cost();
-
-    const double ddl = std::fabs(curve.Evaluate(2, path_s));
-    path_cost += ddl * ddl * config_.path_ddl_cost();
   }
   path_cost *= config_.path_resolution();
 
@@ -181,11 +261,19 @@ ComparableCost TrajectoryCost::CalculateStaticObstacleCost(
     const QuinticPolynomialCurve1d &curve, const double start_s,
     const double end_s) {
   ComparableCost obstacle_cost;
+  std::vector<double> curr_s_samples;
+  std::vector<double> path_s_samples;
   for (double curr_s = start_s; curr_s <= end_s;
        curr_s += config_.path_resolution()) {
-    const double curr_l = curve.Evaluate(0, curr_s - start_s);
-    for (const auto &obs_sl_boundary : static_obstacle_sl_boundaries_) {
-      obstacle_cost += GetCostFromObsSL(curr_s, curr_l, obs_sl_boundary);
+    curr_s_samples.push_back(curr_s);
+    path_s_samples.push_back(curr_s - start_s);
+  }
+  std::vector<double> l;
+  curve.BatchEvaluate(path_s_samples, &l, nullptr, nullptr);
+  for (size_t i = 0; i < curr_s_samples.size(); ++i) {
+    for (const size_t index : StaticObstacleCandidates(l[i])) {
+      obstacle_cost += GetCostFromObsSL(curr_s_samples[i], l[i],
+                                        static_obstacle_sl_boundaries_[index]);
     }
   }
   obstacle_cost.safety_cost *= config_.path_resolution();
@@ -196,29 +284,35 @@ ComparableCost TrajectoryCost::CalculateDynamicObstacleCost(
     const QuinticPolynomialCurve1d &curve, const double start_s,
     const double end_s) const {
   ComparableCost obstacle_cost;
-  double time_stamp = 0.0;
-  for (size_t index = 0; index < num_of_time_stamps_;
-       ++index, time_stamp += config_.eval_time_interval()) {
-    common::SpeedPoint speed_point;
-    heuristic_speed_data_.EvaluateByTime(time_stamp, &speed_point);
-    if (speed_point.s() < start_s - init_sl_point_.s()) {
+  // The distance between the bounding boxes never exceeds the distance
+  // between the boxes, so a far bounding box means no cost.
+  constexpr double kEpsilon = 1e-6;
+  const double ignore_distance = config_.obstacle_ignore_distance() + kEpsilon;
+  for (size_t index = 0; index < heuristic_s_by_time_.size(); ++index) {
+    const double speed_point_s = heuristic_s_by_time_[index];
+    if (speed_point_s < start_s - init_sl_point_.s()) {
       continue;
     }
-    if (speed_point.s() > end_s - init_sl_point_.s()) {
+    if (speed_point_s > end_s - init_sl_point_.s()) {
       break;
     }
 
     const double s =
-        init_sl_point_.s() + speed_point.s() - start_s;  // s on spline curve
+        init_sl_point_.s() + speed_point_s - start_s;  // s on spline curve
     const double l = curve.Evaluate(0, s);
     const double dl = curve.Evaluate(1, s);
 
     const common::SLPoint sl =
-        common::util::MakeSLPoint(init_sl_point_.s() + speed_point.s(), l);
+        common::util::MakeSLPoint(init_sl_point_.s() + speed_point_s, l);
     const Box2d ego_box = GetBoxFromSLPoint(sl, dl);
-    for (const auto &obstacle_trajectory : dynamic_obstacle_boxes_) {
+    const common::math::AABox2d ego_aabox = ego_box.GetAABox();
+    const auto &obstacle_aaboxes = dynamic_obstacle_aaboxes_by_time_[index];
+    for (size_t i = 0; i < dynamic_obstacle_boxes_.size(); ++i) {
+      if (obstacle_aaboxes[i].DistanceTo(ego_aabox) > ignore_distance) {
+        continue;
+      }
       obstacle_cost +=
-          GetCostBetweenObsBoxes(ego_box, obstacle_trajectory.at(index));
+          GetCostBetweenObsBoxes(ego_box, dynamic_obstacle_boxes_[i][index]);
     }
   }
   constexpr double kDynamicObsWeight = 1e-6;
@@ -313,7 +407,6 @@ Box2d TrajectoryCost::GetBoxFromSLPoint(const common::SLPoint &sl,
                vehicle_param_.width());
 }
 
-// TODO(All): optimize obstacle cost calculation time
 ComparableCost TrajectoryCost::Calculate(const QuinticPolynomialCurve1d &curve,
                                          const double start_s,
                                          const double end_s,
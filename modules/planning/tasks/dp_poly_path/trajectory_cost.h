@@ -26,6 +26,7 @@
 #include "modules/common/configs/proto/vehicle_config.pb.h"
 #include "modules/planning/proto/dp_poly_path_config.pb.h"
 
+#include "modules/common/math/aabox2d.h"
 #include "modules/common/math/box2d.h"
 #include "modules/planning/common/obstacle.h"
 #include "modules/planning/common/path_decision.h"
@@ -136,6 +137,18 @@ class TrajectoryCost {
   common::math::Box2d GetBoxFromSLPoint(const common::SLPoint &sl,
                                         const double dl) const;
 
+  /**
+   * @brief builds the lateral index of static obstacles and the time index
+   * of dynamic obstacle boxes. Called once the obstacles are collected.
+   */
+  void BuildObstacleIndex();
+
+  /**
+   * @brief the indices of the static obstacles that may have a cost for an
+   * ADC at lateral position l, in increasing order.
+   */
+  const std::vector<size_t> &StaticObstacleCandidates(const double l) const;
+
   const DpPolyPathConfig config_;
   const ReferenceLine *reference_line_ = nullptr;
   bool is_change_lane_path_ = false;
@@ -147,6 +160,19 @@ class TrajectoryCost {
   std::vector<double> obstacle_probabilities_;
 
   std::vector<SLBoundary> static_obstacle_sl_boundaries_;
+
+  // The sorted lateral positions where the set of static obstacles that
+  // affect the ADC changes. Slab i covers [breaks[i - 1], breaks[i]], and
+  // static_obstacles_by_slab_[i] holds the obstacles relevant in it.
+  std::vector<double> static_obstacle_l_breaks_;
+  std::vector<std::vector<size_t>> static_obstacles_by_slab_;
+
+  // heuristic_s_by_time_[t] is the heuristic speed profile s at time index t.
+  std::vector<double> heuristic_s_by_time_;
+  // dynamic_obstacle_aaboxes_by_time_[t][i] bounds dynamic obstacle i at
+  // time index t, which is used to skip obstacles that are too far away.
+  std::vector<std::vector<common::math::AABox2d>>
+      dynamic_obstacle_aaboxes_by_time_;
 };
 
 }  // namespace planning
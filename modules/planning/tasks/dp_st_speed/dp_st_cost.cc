@@ -28,6 +28,13 @@ namespace apollo {
 namespace planning {
 namespace {
 constexpr double kInf = std::numeric_limits<double>::infinity();
+
+// The accel and jerk costs are tabulated with these resolutions, and the
+// keys are shifted to keep them non-negative.
+constexpr double kAccelKeyResolution = 0.1;
+constexpr size_t kAccelKeyShift = 100;
+constexpr double kJerkKeyResolution = 0.1;
+constexpr size_t kJerkKeyShift = 200;
 }
 
 DpStCost::DpStCost(const DpStSpeedConfig& config,
@@ -45,17 +52,44 @@ DpStCost::DpStCost(const DpStSpeedConfig& config,
   for (auto& vec : boundary_cost_) {
     vec.resize(config_.matrix_dimension_t(), std::make_pair(-1.0, -1.0));
   }
-  accel_cost_.fill(-1.0);
-  jerk_cost_.fill(-1.0);
+  // The tables are filled once here, so that looking them up is read only.
+  for (size_t key = 0; key < accel_cost_.size(); ++key) {
+    accel_cost_[key] = ComputeAccelCost(
+        (static_cast<double>(key) - kAccelKeyShift) * kAccelKeyResolution);
+  }
+  for (size_t key = 0; key < jerk_cost_.size(); ++key) {
+    jerk_cost_[key] = ComputeJerkCost(
+        (static_cast<double>(key) - kJerkKeyShift) * kJerkKeyResolution);
+  }
 }
 
 double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
-  const double s = st_graph_point.point().s();
-  const double t = st_graph_point.point().t();
+  return GetObstacleCost(st_graph_point.point(), st_graph_point.index_t());
+}
+
+void DpStCost::CacheBoundarySRanges(const uint32_t index_t, const double t) {
+  for (const auto* obstacle : obstacles_) {
+    const auto& boundary = obstacle->st_boundary();
+    if (t < boundary.min_t() || t > boundary.max_t()) {
+      continue;
+    }
+    auto& s_range = boundary_cost_[boundary_map_.at(boundary.id())][index_t];
+    if (s_range.first < 0.0) {
+      double s_upper = 0.0;
+      double s_lower = 0.0;
+      boundary.GetBoundarySRange(t, &s_upper, &s_lower);
+      s_range = std::make_pair(s_upper, s_lower);
+    }
+  }
+}
+
+double DpStCost::GetObstacleCost(const STPoint& point, const uint32_t index_t) {
+  const double s = point.s();
+  const double t = point.t();
 
   double cost = 0.0;
   for (const auto* obstacle : obstacles_) {
-    auto boundary = obstacle->st_boundary();
+    const auto& boundary = obstacle->st_boundary();
     const double kIgnoreDistance = 200.0;
     if (boundary.min_s() > kIgnoreDistance) {
       continue;
@@ -70,14 +104,14 @@ double DpStCost::GetObstacleCost(const StGraphPoint& st_graph_point) {
     double s_upper = 0.0;
     double s_lower = 0.0;
 
-    int boundary_index = boundary_map_[boundary.id()];
-    if (boundary_cost_[boundary_index][st_graph_point.index_t()].first < 0.0) {
+    const int boundary_index = boundary_map_.at(boundary.id());
+    if (boundary_cost_[boundary_index][index_t].first < 0.0) {
       boundary.GetBoundarySRange(t, &s_upper, &s_lower);
-      boundary_cost_[boundary_index][st_graph_point.index_t()] =
+      boundary_cost_[boundary_index][index_t] =
           std::make_pair(s_upper, s_lower);
     } else {
-      s_upper = boundary_cost_[boundary_index][st_graph_point.index_t()].first;
-      s_lower = boundary_cost_[boundary_index][st_graph_point.index_t()].second;
+      s_upper = boundary_cost_[boundary_index][index_t].first;
+      s_lower = boundary_cost_[boundary_index][index_t].second;
     }
     if (s < s_lower) {
       constexpr double kSafeTimeBuffer = 3.0;
@@ -127,37 +161,34 @@ double DpStCost::GetSpeedCost(const STPoint& first, const STPoint& second,
   return cost;
 }
 
-double DpStCost::GetAccelCost(const double accel) {
+double DpStCost::ComputeAccelCost(const double accel) const {
   double cost = 0.0;
-  constexpr double kEpsilon = 0.1;
-  constexpr size_t kShift = 100;
-  const size_t accel_key = static_cast<size_t>(accel / kEpsilon + 0.5 + kShift);
+  const double accel_sq = accel * accel;
+  double max_acc = config_.max_acceleration();
+  double max_dec = config_.max_deceleration();
+  double accel_penalty = config_.accel_penalty();
+  double decel_penalty = config_.decel_penalty();
+
+  if (accel > 0.0) {
+    cost = accel_penalty * accel_sq;
+  } else {
+    cost = decel_penalty * accel_sq;
+  }
+  cost += accel_sq * decel_penalty * decel_penalty /
+              (1 + std::exp(1.0 * (accel - max_dec))) +
+          accel_sq * accel_penalty * accel_penalty /
+              (1 + std::exp(-1.0 * (accel - max_acc)));
+  return cost;
+}
+
+double DpStCost::GetAccelCost(const double accel) {
+  const size_t accel_key = static_cast<size_t>(
+      accel / kAccelKeyResolution + 0.5 + kAccelKeyShift);
   DCHECK_LT(accel_key, accel_cost_.size());
   if (accel_key >= accel_cost_.size()) {
     return kInf;
   }
-
-  if (accel_cost_.at(accel_key) < 0.0) {
-    const double accel_sq = accel * accel;
-    double max_acc = config_.max_acceleration();
-    double max_dec = config_.max_deceleration();
-    double accel_penalty = config_.accel_penalty();
-    double decel_penalty = config_.decel_penalty();
-
-    if (accel > 0.0) {
-      cost = accel_penalty * accel_sq;
-    } else {
-      cost = decel_penalty * accel_sq;
-    }
-    cost += accel_sq * decel_penalty * decel_penalty /
-                (1 + std::exp(1.0 * (accel - max_dec))) +
-            accel_sq * accel_penalty * accel_penalty /
-                (1 + std::exp(-1.0 * (accel - max_acc)));
-    accel_cost_.at(accel_key) = cost;
-  } else {
-    cost = accel_cost_.at(accel_key);
-  }
-  return cost * unit_t_;
+  return accel_cost_[accel_key] * unit_t_;
 }
 
 double DpStCost::GetAccelCostByThreePoints(const STPoint& first,
@@ -175,30 +206,24 @@ double DpStCost::GetAccelCostByTwoPoints(const double pre_speed,
   return GetAccelCost(accel);
 }
 
+double DpStCost::ComputeJerkCost(const double jerk) const {
+  const double jerk_sq = jerk * jerk;
+  if (jerk > 0) {
+    return config_.positive_jerk_coeff() * jerk_sq * unit_t_;
+  }
+  return config_.negative_jerk_coeff() * jerk_sq * unit_t_;
+}
+
 double DpStCost::JerkCost(const double jerk) {
-  double cost = 0.0;
-  constexpr double kEpsilon = 0.1;
-  constexpr size_t kShift = 200;
-  const size_t jerk_key = static_cast<size_t>(jerk / kEpsilon + 0.5 + kShift);
+  const size_t jerk_key =
+      static_cast<size_t>(jerk / kJerkKeyResolution + 0.5 + kJerkKeyShift);
   DCHECK_LT(jerk_key, jerk_cost_.size());
   if (jerk_key >= jerk_cost_.size()) {
     return kInf;
   }
 
-  if (jerk_cost_.at(jerk_key) < 0.0) {
-    double jerk_sq = jerk * jerk;
-    if (jerk > 0) {
-      cost = config_.positive_jerk_coeff() * jerk_sq * unit_t_;
-    } else {
-      cost = config_.negative_jerk_coeff() * jerk_sq * unit_t_;
-    }
-    jerk_cost_.at(jerk_key) = cost;
-  } else {
-    cost = jerk_cost_.at(jerk_key);
-  }
-
   // TODO(All): normalize to unit_t_
-  return cost;
+  return jerk_cost_[jerk_key];
 }
 
 double DpStCost::GetJerkCostByFourPoints(const STPoint& first,
@@ -21,6 +21,7 @@
 #ifndef MODULES_PLANNING_TASKS_DP_ST_SPEED_DP_ST_COST_H_
 #define MODULES_PLANNING_TASKS_DP_ST_SPEED_DP_ST_COST_H_
 
+#include <array>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -45,6 +46,19 @@ class DpStCost {
 
   double GetObstacleCost(const StGraphPoint& point);
 
+  /**
+   * @brief the obstacle cost at point, which is in column index_t of the
+   * graph. Only reads the caches once CacheBoundarySRanges(index_t, ...) has
+   * been called, so the points of that column can be evaluated concurrently.
+   */
+  double GetObstacleCost(const STPoint& point, const uint32_t index_t);
+
+  /**
+   * @brief caches the s range of every obstacle boundary at time t, the time
+   * of column index_t of the graph.
+   */
+  void CacheBoundarySRanges(const uint32_t index_t, const double t);
+
   double GetReferenceCost(const STPoint& point,
                           const STPoint& reference_point) const;
 
@@ -71,6 +85,9 @@ class DpStCost {
   double GetAccelCost(const double accel);
   double JerkCost(const double jerk);
 
+  double ComputeAccelCost(const double accel) const;
+  double ComputeJerkCost(const double jerk) const;
+
   const DpStSpeedConfig& config_;
   const std::vector<const PathObstacle*>& obstacles_;
   const common::TrajectoryPoint& init_point_;
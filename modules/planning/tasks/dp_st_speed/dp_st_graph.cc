@@ -21,6 +21,7 @@
 #include "modules/planning/tasks/dp_st_speed/dp_st_graph.h"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <string>
 
@@ -42,10 +43,11 @@ using apollo::common::VehicleParam;
 
 namespace {
 constexpr double kInf = std::numeric_limits<double>::infinity();
+constexpr int32_t kNoPreRow = -1;
 
 bool CheckOverlapOnDpStGraph(const std::vector<const StBoundary*>& boundaries,
-                             const StGraphPoint& p1, const StGraphPoint& p2) {
-  const common::math::LineSegment2d seg(p1.point(), p2.point());
+                             const STPoint& p1, const STPoint& p2) {
+  const common::math::LineSegment2d seg(p1, p2);
   for (const auto* boundary : boundaries) {
     if (boundary->HasOverlap(seg)) {
       return true;
@@ -71,6 +73,12 @@ DpStGraph::DpStGraph(const StGraphData& st_graph_data,
                 st_graph_data_.path_data_length()));
 }
 
+void DpStGraph::SetWarmStartProfile(const SpeedData& warm_start_profile,
+                                    const double band_half_width) {
+  warm_start_profile_ = &warm_start_profile;
+  warm_start_band_ = band_half_width;
+}
+
 Status DpStGraph::Search(SpeedData* const speed_data) {
   constexpr double kBounadryEpsilon = 1e-2;
   for (const auto& boundary : st_graph_data_.st_boundaries()) {
@@ -114,6 +122,19 @@ Status DpStGraph::Search(SpeedData* const speed_data) {
     return Status(ErrorCode::PLANNING_ERROR, msg);
   }
 
+  if (warm_start_profile_ != nullptr &&
+      !warm_start_profile_->speed_vector().empty()) {
+    InitWarmStartBand();
+    if (CalculateTotalCost().ok() && RetrieveSpeedProfile(speed_data).ok()) {
+      return Status::OK();
+    }
+    ADEBUG << "No speed profile around the warm start profile, search the "
+              "whole graph.";
+    band_low_rows_.clear();
+    band_high_rows_.clear();
+    ResetCostTable();
+  }
+
   if (!CalculateTotalCost().ok()) {
     const std::string msg = "Calculate total cost failed.";
     AERROR << msg;
@@ -136,48 +157,90 @@ Status DpStGraph::InitCostTable() {
             dp_st_speed_config_.matrix_dimension_t();
   DCHECK_GT(dim_s, 2);
   DCHECK_GT(dim_t, 2);
-  cost_table_ = std::vector<std::vector<StGraphPoint>>(
-      dim_t, std::vector<StGraphPoint>(dim_s, StGraphPoint()));
+  dim_s_ = dim_s;
+  dim_t_ = dim_t;
 
+  s_values_.clear();
+  double curr_s = 0.0;
+  for (uint32_t r = 0; r < dim_s_; ++r, curr_s += unit_s_) {
+    s_values_.push_back(curr_s);
+  }
+  t_values_.clear();
   double curr_t = 0.0;
-  for (uint32_t i = 0; i < cost_table_.size(); ++i, curr_t += unit_t_) {
-    auto& cost_table_i = cost_table_[i];
-    double curr_s = 0.0;
-    for (uint32_t j = 0; j < cost_table_i.size(); ++j, curr_s += unit_s_) {
-      cost_table_i[j].Init(i, j, STPoint(curr_s, curr_t));
-    }
+  for (uint32_t c = 0; c < dim_t_; ++c, curr_t += unit_t_) {
+    t_values_.push_back(curr_t);
   }
+
+  ResetCostTable();
   return Status::OK();
 }
 
+void DpStGraph::ResetCostTable() {
+  const size_t num_points = static_cast<size_t>(dim_s_) * dim_t_;
+  obstacle_costs_.assign(num_points, 0.0);
+  total_costs_.assign(num_points, kInf);
+  pre_rows_.assign(num_points, kNoPreRow);
+}
+
+void DpStGraph::InitWarmStartBand() {
+  // The cols the warm start profile does not reach are searched in full.
+  band_low_rows_.assign(dim_t_, 0);
+  band_high_rows_.assign(dim_t_, dim_s_ - 1);
+  const uint32_t band_rows =
+      static_cast<uint32_t>(std::ceil(warm_start_band_ / unit_s_));
+  std::size_t index_hint = 0;
+  for (uint32_t c = 0; c < dim_t_; ++c) {
+    SpeedPoint speed_point;
+    if (!warm_start_profile_->EvaluateByTime(t_values_[c], &speed_point,
+                                             &index_hint)) {
+      continue;
+    }
+    const double s = std::fmax(0.0, speed_point.s());
+    const uint32_t r =
+        std::min(static_cast<uint32_t>(s / unit_s_ + 0.5), dim_s_ - 1);
+    band_low_rows_[c] = r > band_rows ? r - band_rows : 0;
+    band_high_rows_[c] = std::min(r + band_rows, dim_s_ - 1);
+  }
+}
+
 Status DpStGraph::CalculateTotalCost() {
   // t corresponding to col
   // s corresponding to row
   uint32_t next_highest_row = 0;
   uint32_t next_lowest_row = 0;
 
-  for (size_t c = 0; c < cost_table_.size(); ++c) {
+  for (uint32_t c = 0; c < dim_t_; ++c) {
     uint32_t highest_row = 0;
-    uint32_t lowest_row = cost_table_.back().size() - 1;
-
-    for (uint32_t r = next_lowest_row; r <= next_highest_row; ++r) {
-      if (FLAGS_enable_multi_thread_in_dp_st_graph) {
-        PlanningThreadPool::instance()->mutable_thread_pool()->Push(
-            std::bind(&DpStGraph::CalculateCostAt, this, c, r));
-      } else {
-        CalculateCostAt(c, r);
+    uint32_t lowest_row = dim_s_ - 1;
+
+    dp_st_cost_.CacheBoundarySRanges(c, t_values_[c]);
+    const uint32_t r_end = next_highest_row + 1;
+    const uint32_t band_begin =
+        band_low_rows_.empty() ? next_lowest_row
+                               : std::max(next_lowest_row, band_low_rows_[c]);
+    const uint32_t band_end =
+        band_high_rows_.empty() ? r_end
+                                : std::min(r_end, band_high_rows_[c] + 1);
+    if (band_begin < band_end) {
+      CalculateCostsInRows(c, band_begin, band_end);
+      // The rows out of the band are searched only if the band is blocked.
+      bool is_band_blocked = true;
+      for (uint32_t r = band_begin; r < band_end && is_band_blocked; ++r) {
+        is_band_blocked = std::isinf(total_costs_[Index(c, r)]);
       }
-    }
-    if (FLAGS_enable_multi_thread_in_dp_st_graph) {
-      PlanningThreadPool::instance()->mutable_thread_pool()->JoinAll();
+      if (is_band_blocked) {
+        CalculateCostsInRows(c, next_lowest_row, band_begin);
+        CalculateCostsInRows(c, band_end, r_end);
+      }
+    } else {
+      CalculateCostsInRows(c, next_lowest_row, r_end);
     }
 
     for (uint32_t r = next_lowest_row; r <= next_highest_row; ++r) {
-      const auto& cost_cr = cost_table_[c][r];
       uint32_t h_r = 0;
       uint32_t l_r = 0;
-      if (cost_cr.total_cost() < std::numeric_limits<double>::infinity()) {
-        GetRowRange(cost_cr, &h_r, &l_r);
+      if (total_costs_[Index(c, r)] < std::numeric_limits<double>::infinity()) {
+        GetRowRange(c, r, &h_r, &l_r);
         highest_row = std::max(highest_row, h_r);
         lowest_row = std::min(lowest_row, l_r);
       }
@@ -189,24 +252,44 @@ Status DpStGraph::CalculateTotalCost() {
   return Status::OK();
 }
 
-void DpStGraph::GetRowRange(const StGraphPoint& point,
+void DpStGraph::CalculateCostsInRows(const uint32_t c, const uint32_t r_begin,
+                                     const uint32_t r_end) {
+  if (r_begin >= r_end) {
+    return;
+  }
+  // The rows of a column only read the previous columns, so they are
+  // independent of each other.
+  auto* thread_pool = PlanningThreadPool::instance()->mutable_thread_pool();
+  if (FLAGS_enable_multi_thread_in_dp_st_graph && thread_pool != nullptr) {
+    constexpr size_t kRowsPerTask = 8;
+    thread_pool->ParallelFor(
+        r_begin, r_end, [this, c](const size_t r) { CalculateCostAt(c, r); },
+        kRowsPerTask);
+  } else {
+    for (uint32_t r = r_begin; r < r_end; ++r) {
+      CalculateCostAt(c, r);
+    }
+  }
+}
+
+void DpStGraph::GetRowRange(const uint32_t c, const uint32_t r,
                             uint32_t* next_highest_row,
                             uint32_t* next_lowest_row) {
   double v0 = 0.0;
-  if (!point.pre_point()) {
+  const int32_t pre_row = pre_rows_[Index(c, r)];
+  if (pre_row == kNoPreRow) {
     v0 = init_point_.v();
   } else {
-    v0 = (point.index_s() - point.pre_point()->index_s()) * unit_s_ / unit_t_;
+    v0 = (r - pre_row) * unit_s_ / unit_t_;
   }
 
-  const size_t max_s_size = cost_table_.back().size() - 1;
+  const size_t max_s_size = dim_s_ - 1;
 
   const double speed_coeff = unit_t_ * unit_t_;
 
   const double delta_s_upper_bound =
       v0 * unit_t_ + vehicle_param_.max_acceleration() * speed_coeff;
-  *next_highest_row =
-      point.index_s() + static_cast<uint32_t>(delta_s_upper_bound / unit_s_);
+  *next_highest_row = r + static_cast<uint32_t>(delta_s_upper_bound / unit_s_);
   if (*next_highest_row >= max_s_size) {
     *next_highest_row = max_s_size;
   }
@@ -220,16 +303,16 @@ void DpStGraph::GetRowRange(const StGraphPoint& point,
 }
 
 void DpStGraph::CalculateCostAt(const uint32_t c, const uint32_t r) {
-  auto& cost_cr = cost_table_[c][r];
-  cost_cr.SetObstacleCost(dp_st_cost_.GetObstacleCost(cost_cr));
-  if (cost_cr.obstacle_cost() > std::numeric_limits<double>::max()) {
+  const size_t index_cr = Index(c, r);
+  const STPoint curr_point = PointAt(c, r);
+  obstacle_costs_[index_cr] = dp_st_cost_.GetObstacleCost(curr_point, c);
+  if (obstacle_costs_[index_cr] > std::numeric_limits<double>::max()) {
     return;
   }
 
-  const auto& cost_init = cost_table_[0][0];
   if (c == 0) {
     DCHECK_EQ(r, 0) << "Incorrect. Row should be 0 with col = 0. row: " << r;
-    cost_cr.SetTotalCost(0.0);
+    total_costs_[index_cr] = 0.0;
     return;
   }
 
@@ -242,13 +325,14 @@ void DpStGraph::CalculateCostAt(const uint32_t c, const uint32_t r) {
       return;
     }
 
-    if (CheckOverlapOnDpStGraph(st_graph_data_.st_boundaries(), cost_cr,
-                                cost_init)) {
+    if (CheckOverlapOnDpStGraph(st_graph_data_.st_boundaries(), curr_point,
+                                PointAt(0, 0))) {
       return;
     }
-    cost_cr.SetTotalCost(cost_cr.obstacle_cost() + cost_init.total_cost() +
-                         CalculateEdgeCostForSecondCol(r, speed_limit));
-    cost_cr.SetPrePoint(cost_init);
+    total_costs_[index_cr] = obstacle_costs_[index_cr] +
+                             total_costs_[Index(0, 0)] +
+                             CalculateEdgeCostForSecondCol(r, speed_limit);
+    pre_rows_[index_cr] = 0;
     return;
   }
 
@@ -258,8 +342,6 @@ void DpStGraph::CalculateCostAt(const uint32_t c, const uint32_t r) {
                             (1 + kSpeedRangeBuffer) * unit_t_ / unit_s_);
   const uint32_t r_low = (max_s_diff < r ? r - max_s_diff : 0);
 
-  const auto& pre_col = cost_table_[c - 1];
-
   if (c == 2) {
     for (uint32_t r_pre = r_low; r_pre <= r; ++r_pre) {
       const double acc =
@@ -269,99 +351,106 @@ void DpStGraph::CalculateCostAt(const uint32_t c, const uint32_t r) {
         continue;
       }
 
-      if (CheckOverlapOnDpStGraph(st_graph_data_.st_boundaries(), cost_cr,
-                                  pre_col[r_pre])) {
+      if (CheckOverlapOnDpStGraph(st_graph_data_.st_boundaries(), curr_point,
+                                  PointAt(c - 1, r_pre))) {
         continue;
       }
 
-      const double cost = cost_cr.obstacle_cost() +
-                          pre_col[r_pre].total_cost() +
+      const double cost = obstacle_costs_[index_cr] +
+                          total_costs_[Index(c - 1, r_pre)] +
                           CalculateEdgeCostForThirdCol(r, r_pre, speed_limit);
 
-      if (cost < cost_cr.total_cost()) {
-        cost_cr.SetTotalCost(cost);
-        cost_cr.SetPrePoint(pre_col[r_pre]);
+      if (cost < total_costs_[index_cr]) {
+        total_costs_[index_cr] = cost;
+        pre_rows_[index_cr] = r_pre;
       }
     }
     return;
   }
   for (uint32_t r_pre = r_low; r_pre <= r; ++r_pre) {
-    if (std::isinf(pre_col[r_pre].total_cost()) ||
-        pre_col[r_pre].pre_point() == nullptr) {
+    const size_t index_pre = Index(c - 1, r_pre);
+    if (std::isinf(total_costs_[index_pre]) ||
+        pre_rows_[index_pre] == kNoPreRow) {
       continue;
     }
 
+    const uint32_t r_prepre = pre_rows_[index_pre];
     const double curr_a =
-        (cost_cr.index_s() + pre_col[r_pre].pre_point()->index_s() -
-         2 * pre_col[r_pre].index_s()) *
-        unit_s_ / (unit_t_ * unit_t_);
+        (r + r_prepre - 2 * r_pre) * unit_s_ / (unit_t_ * unit_t_);
     if (curr_a > vehicle_param_.max_acceleration() ||
         curr_a < vehicle_param_.max_deceleration()) {
       continue;
     }
-    if (CheckOverlapOnDpStGraph(st_graph_data_.st_boundaries(), cost_cr,
-                                pre_col[r_pre])) {
+    const STPoint pre_point = PointAt(c - 1, r_pre);
+    if (CheckOverlapOnDpStGraph(st_graph_data_.st_boundaries(), curr_point,
+                                pre_point)) {
       continue;
     }
 
-    uint32_t r_prepre = pre_col[r_pre].pre_point()->index_s();
-    const StGraphPoint& prepre_graph_point = cost_table_[c - 2][r_prepre];
-    if (std::isinf(prepre_graph_point.total_cost())) {
+    const size_t index_prepre = Index(c - 2, r_prepre);
+    if (std::isinf(total_costs_[index_prepre])) {
       continue;
     }
 
-    if (!prepre_graph_point.pre_point()) {
+    if (pre_rows_[index_prepre] == kNoPreRow) {
       continue;
     }
-    const STPoint& triple_pre_point = prepre_graph_point.pre_point()->point();
-    const STPoint& prepre_point = prepre_graph_point.point();
-    const STPoint& pre_point = pre_col[r_pre].point();
-    const STPoint& curr_point = cost_cr.point();
-    double cost = cost_cr.obstacle_cost() + pre_col[r_pre].total_cost() +
+    const STPoint triple_pre_point = PointAt(c - 3, pre_rows_[index_prepre]);
+    const STPoint prepre_point = PointAt(c - 2, r_prepre);
+    double cost = obstacle_costs_[index_cr] + total_costs_[index_pre] +
                   CalculateEdgeCost(triple_pre_point, prepre_point, pre_point,
                                     curr_point, speed_limit);
 
-    if (cost < cost_cr.total_cost()) {
-      cost_cr.SetTotalCost(cost);
-      cost_cr.SetPrePoint(pre_col[r_pre]);
+    if (cost < total_costs_[index_cr]) {
+      total_costs_[index_cr] = cost;
+      pre_rows_[index_cr] = r_pre;
     }
   }
 }
 
 Status DpStGraph::RetrieveSpeedProfile(SpeedData* const speed_data) {
   double min_cost = std::numeric_limits<double>::infinity();
-  const StGraphPoint* best_end_point = nullptr;
-  for (const StGraphPoint& cur_point : cost_table_.back()) {
-    if (!std::isinf(cur_point.total_cost()) &&
-        cur_point.total_cost() < min_cost) {
-      best_end_point = &cur_point;
-      min_cost = cur_point.total_cost();
+  uint32_t best_end_c = 0;
+  uint32_t best_end_r = 0;
+  bool has_best_end_point = false;
+  const uint32_t last_c = dim_t_ - 1;
+  for (uint32_t r = 0; r < dim_s_; ++r) {
+    const double total_cost = total_costs_[Index(last_c, r)];
+    if (!std::isinf(total_cost) && total_cost < min_cost) {
+      best_end_c = last_c;
+      best_end_r = r;
+      has_best_end_point = true;
+      min_cost = total_cost;
     }
   }
 
-  for (const auto& row : cost_table_) {
-    const StGraphPoint& cur_point = row.back();
-    if (!std::isinf(cur_point.total_cost()) &&
-        cur_point.total_cost() < min_cost) {
-      best_end_point = &cur_point;
-      min_cost = cur_point.total_cost();
+  const uint32_t last_r = dim_s_ - 1;
+  for (uint32_t c = 0; c < dim_t_; ++c) {
+    const double total_cost = total_costs_[Index(c, last_r)];
+    if (!std::isinf(total_cost) && total_cost < min_cost) {
+      best_end_c = c;
+      best_end_r = last_r;
+      has_best_end_point = true;
+      min_cost = total_cost;
     }
   }
 
-  if (best_end_point == nullptr) {
+  if (!has_best_end_point) {
     const std::string msg = "Fail to find the best feasible trajectory.";
     AERROR << msg;
     return Status(ErrorCode::PLANNING_ERROR, msg);
   }
 
   std::vector<SpeedPoint> speed_profile;
-  const StGraphPoint* cur_point = best_end_point;
-  while (cur_point != nullptr) {
+  int64_t c = best_end_c;
+  int32_t r = best_end_r;
+  while (c >= 0 && r != kNoPreRow) {
     SpeedPoint speed_point;
-    speed_point.set_s(cur_point->point().s());
-    speed_point.set_t(cur_point->point().t());
+    speed_point.set_s(s_values_[r]);
+    speed_point.set_t(t_values_[c]);
     speed_profile.emplace_back(speed_point);
-    cur_point = cur_point->pre_point();
+    r = pre_rows_[Index(c, r)];
+    --c;
   }
   std::reverse(speed_profile.begin(), speed_profile.end());
 
@@ -388,8 +477,8 @@ double DpStGraph::CalculateEdgeCostForSecondCol(const uint32_t row,
                                                 const double speed_limit) {
   double init_speed = init_point_.v();
   double init_acc = init_point_.a();
-  const STPoint& pre_point = cost_table_[0][0].point();
-  const STPoint& curr_point = cost_table_[1][row].point();
+  const STPoint pre_point = PointAt(0, 0);
+  const STPoint curr_point = PointAt(1, row);
   return dp_st_cost_.GetSpeedCost(pre_point, curr_point, speed_limit) +
          dp_st_cost_.GetAccelCostByTwoPoints(init_speed, pre_point,
                                              curr_point) +
@@ -401,9 +490,9 @@ double DpStGraph::CalculateEdgeCostForThirdCol(const uint32_t curr_row,
                                                const uint32_t pre_row,
                                                const double speed_limit) {
   double init_speed = init_point_.v();
-  const STPoint& first = cost_table_[0][0].point();
-  const STPoint& second = cost_table_[1][pre_row].point();
-  const STPoint& third = cost_table_[2][curr_row].point();
+  const STPoint first = PointAt(0, 0);
+  const STPoint second = PointAt(1, pre_row);
+  const STPoint third = PointAt(2, curr_row);
   return dp_st_cost_.GetSpeedCost(second, third, speed_limit) +
          dp_st_cost_.GetAccelCostByThreePoints(first, second, third) +
          dp_st_cost_.GetJerkCostByThreePoints(init_speed, first, second, third);
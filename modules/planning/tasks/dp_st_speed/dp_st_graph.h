@@ -48,14 +48,31 @@ class DpStGraph {
             const common::TrajectoryPoint& init_point,
             const SLBoundary& adc_sl_boundary);
 
+  /**
+   * @brief seeds the next searches with the given speed profile, usually
+   * the one of the last cycle stitched to the current init point. Only the
+   * points within a band around it are searched, the band of a col grows
+   * to all the reachable rows when its points are all blocked, and the
+   * whole graph is searched if no profile is found in the band.
+   */
+  void SetWarmStartProfile(const SpeedData& warm_start_profile,
+                           const double band_half_width);
+
   apollo::common::Status Search(SpeedData* const speed_data);
 
  private:
   apollo::common::Status InitCostTable();
 
+  void ResetCostTable();
+
+  void InitWarmStartBand();
+
   apollo::common::Status RetrieveSpeedProfile(SpeedData* const speed_data);
 
   apollo::common::Status CalculateTotalCost();
+  // Calculates the costs of col c for the rows in [r_begin, r_end).
+  void CalculateCostsInRows(const uint32_t c, const uint32_t r_begin,
+                            const uint32_t r_end);
   void CalculateCostAt(const uint32_t r, const uint32_t c);
 
   double CalculateEdgeCost(const STPoint& first, const STPoint& second,
@@ -67,9 +84,16 @@ class DpStGraph {
                                       const uint32_t pre_r,
                                       const double speed_limit);
 
-  void GetRowRange(const StGraphPoint& point, uint32_t* highest_row,
+  void GetRowRange(const uint32_t c, const uint32_t r, uint32_t* highest_row,
                    uint32_t* lowest_row);
 
+  size_t Index(const uint32_t c, const uint32_t r) const {
+    return static_cast<size_t>(c) * dim_s_ + r;
+  }
+  STPoint PointAt(const uint32_t c, const uint32_t r) const {
+    return STPoint(s_values_[r], t_values_[c]);
+  }
+
  private:
   const StGraphData& st_graph_data_;
 
@@ -94,9 +118,26 @@ class DpStGraph {
   double unit_s_ = 0.0;
   double unit_t_ = 0.0;
 
-  // cost_table_[t][s]
+  uint32_t dim_s_ = 0;
+  uint32_t dim_t_ = 0;
+
+  // The cost table as flat arrays, the point of col c and row r is at
+  // Index(c, r), so the rows of a col are contiguous.
   // row: s, col: t --- NOTICE: Please do NOT change.
-  std::vector<std::vector<StGraphPoint>> cost_table_;
+  std::vector<double> s_values_;
+  std::vector<double> t_values_;
+  std::vector<double> obstacle_costs_;
+  std::vector<double> total_costs_;
+  // The row of the previous point in col c - 1, or -1 if there is none.
+  std::vector<int32_t> pre_rows_;
+
+  // The speed profile seeding the search, if any.
+  const SpeedData* warm_start_profile_ = nullptr;
+  double warm_start_band_ = 0.0;
+  // The rows [band_low_rows_[c], band_high_rows_[c]] of col c are within the
+  // band, empty if the search is not warm started.
+  std::vector<uint32_t> band_low_rows_;
+  std::vector<uint32_t> band_high_rows_;
 };
 
 }  // namespace planning
@@ -115,5 +115,58 @@ TEST_F(DpStGraphTest, simple) {
   EXPECT_TRUE(ret.ok());
 }
 
+TEST_F(DpStGraphTest, warm_start) {
+  Obstacle o1;
+  o1.SetId("o1");
+  obstacle_list_.push_back(o1);
+  path_obstacle_list_.emplace_back(&(obstacle_list_.back()));
+
+  std::vector<const PathObstacle*> obstacles_;
+  obstacles_.emplace_back(&(path_obstacle_list_.back()));
+
+  std::vector<std::pair<STPoint, STPoint>> point_pairs;
+  point_pairs.emplace_back(STPoint(30.0, 4.0), STPoint(45.0, 4.0));
+  point_pairs.emplace_back(STPoint(30.0, 6.0), STPoint(45.0, 6.0));
+  path_obstacle_list_.back().SetStBoundary(StBoundary(point_pairs));
+
+  std::vector<const StBoundary*> boundaries;
+  boundaries.push_back(&(obstacles_.back()->st_boundary()));
+
+  init_point_.set_v(10.0);
+  init_point_.set_a(0.0);
+  st_graph_data_ = StGraphData(boundaries, init_point_, speed_limit_, 120.0);
+
+  DpStGraph full_graph(st_graph_data_, dp_config_, obstacles_, init_point_,
+                       adc_sl_boundary_);
+  SpeedData full_speed_data;
+  ASSERT_TRUE(full_graph.Search(&full_speed_data).ok());
+
+  // seeded with the optimal profile, the band holds the same profile
+  DpStGraph warm_graph(st_graph_data_, dp_config_, obstacles_, init_point_,
+                       adc_sl_boundary_);
+  warm_graph.SetWarmStartProfile(full_speed_data, 10.0);
+  SpeedData warm_speed_data;
+  ASSERT_TRUE(warm_graph.Search(&warm_speed_data).ok());
+  ASSERT_EQ(full_speed_data.speed_vector().size(),
+            warm_speed_data.speed_vector().size());
+  for (size_t i = 0; i < full_speed_data.speed_vector().size(); ++i) {
+    EXPECT_DOUBLE_EQ(full_speed_data.speed_vector()[i].s(),
+                     warm_speed_data.speed_vector()[i].s());
+    EXPECT_DOUBLE_EQ(full_speed_data.speed_vector()[i].t(),
+                     warm_speed_data.speed_vector()[i].t());
+  }
+
+  // a profile running into the obstacle still gives a feasible profile
+  SpeedData blocked_speed_data;
+  for (double t = 0.0; t < 8.0; t += 1.0) {
+    blocked_speed_data.AppendSpeedPoint(t * 8.0, t, 8.0, 0.0, 0.0);
+  }
+  DpStGraph blocked_graph(st_graph_data_, dp_config_, obstacles_, init_point_,
+                          adc_sl_boundary_);
+  blocked_graph.SetWarmStartProfile(blocked_speed_data, 1.0);
+  SpeedData speed_data;
+  EXPECT_TRUE(blocked_graph.Search(&speed_data).ok());
+}
+
 }  // namespace planning
 }  // namespace apollo
@@ -47,12 +47,26 @@ DpStSpeedOptimizer::DpStSpeedOptimizer()
     : SpeedOptimizer("DpStSpeedOptimizer") {}
 
 bool DpStSpeedOptimizer::Init(const PlanningConfig& config) {
-  dp_st_speed_config_ = config.em_planner_config().dp_st_speed_config();
-  st_boundary_config_ = dp_st_speed_config_.st_boundary_config();
+  full_quality_config_ = config.em_planner_config().dp_st_speed_config();
+  st_boundary_config_ = full_quality_config_.st_boundary_config();
+  ApplyQualityLevel();
   is_init_ = true;
   return true;
 }
 
+int DpStSpeedOptimizer::NumQualityLevels() const { return 3; }
+
+void DpStSpeedOptimizer::ApplyQualityLevel() {
+  constexpr int32_t kMinMatrixDimensionS = 3;
+  dp_st_speed_config_ = full_quality_config_;
+  int32_t dimension_s = dp_st_speed_config_.matrix_dimension_s();
+  for (int level = 0; level < quality_level_; ++level) {
+    dimension_s = std::max(kMinMatrixDimensionS, dimension_s / 2);
+  }
+  dp_st_speed_config_.set_matrix_dimension_s(
+      std::min(dimension_s, dp_st_speed_config_.matrix_dimension_s()));
+}
+
 bool DpStSpeedOptimizer::SearchStGraph(const StBoundaryMapper& boundary_mapper,
                                        const PathData& path_data,
                                        SpeedData* speed_data,
@@ -116,6 +130,10 @@ bool DpStSpeedOptimizer::SearchStGraph(const StBoundaryMapper& boundary_mapper,
       st_graph_data, dp_st_speed_config_,
       reference_line_info_->path_decision()->path_obstacles().Items(),
       init_point_, adc_sl_boundary_);
+  if (FLAGS_enable_dp_st_graph_warm_start) {
+    st_graph.SetWarmStartProfile(warm_start_speed_data_,
+                                 FLAGS_dp_st_graph_warm_start_band);
+  }
 
   if (!st_graph.Search(speed_data).ok()) {
     const std::string msg(
@@ -170,6 +188,11 @@ Status DpStSpeedOptimizer::Process(const SLBoundary& adc_sl_boundary,
   adc_sl_boundary_ = adc_sl_boundary;
   reference_line_ = &reference_line;
   path_decision_ = *path_decision;
+  // speed_data may be the same object as reference_speed_data, so the
+  // profile is copied before any search writes to it.
+  if (FLAGS_enable_dp_st_graph_warm_start) {
+    warm_start_speed_data_ = reference_speed_data;
+  }
 
   if (path_data.discretized_path().NumOfPoints() == 0) {
     std::string msg("Empty path data");
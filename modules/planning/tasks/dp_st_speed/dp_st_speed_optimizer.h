@@ -44,7 +44,15 @@ class DpStSpeedOptimizer : public SpeedOptimizer {
 
   bool Init(const PlanningConfig& config) override;
 
+  /**
+   * @brief every quality level halves the rows of the s dimension of the ST
+   * grid, keeping at least 3 of them.
+   */
+  int NumQualityLevels() const override;
+
  private:
+  void ApplyQualityLevel() override;
+
   apollo::common::Status Process(const SLBoundary& adc_sl_boundary,
                                  const PathData& path_data,
                                  const common::TrajectoryPoint& init_point,
@@ -66,10 +74,15 @@ class DpStSpeedOptimizer : public SpeedOptimizer {
   common::TrajectoryPoint init_point_;
   const ReferenceLine* reference_line_ = nullptr;
   SLBoundary adc_sl_boundary_;
+  /// the config at quality level 0
+  DpStSpeedConfig full_quality_config_;
   DpStSpeedConfig dp_st_speed_config_;
   StBoundaryConfig st_boundary_config_;
 
   PathDecision path_decision_;
+
+  // The speed profile of the last cycle, seeding the graph search.
+  SpeedData warm_start_speed_data_;
 };
 
 }  // namespace planning
@@ -21,6 +21,8 @@
 #include "modules/planning/tasks/poly_st_speed/poly_st_graph.h"
 
 #include <algorithm>
+#include <atomic>
+#include <limits>
 
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/planning/proto/planning_internal.pb.h"
@@ -29,6 +31,7 @@
 #include "modules/common/log.h"
 #include "modules/common/util/util.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_thread_pool.h"
 #include "modules/planning/math/curve1d/quartic_polynomial_curve1d.h"
 #include "modules/planning/tasks/poly_st_speed/speed_profile_cost.h"
 
@@ -94,26 +97,63 @@ bool PolyStGraph::GenerateMinCostSpeedProfile(
   PolyStGraphNode start_node = {STPoint(0.0, 0.0), init_point_.v(),
                                 init_point_.a()};
   SpeedProfileCost cost(config_, obstacles, speed_limit_, init_point_);
-  double min_cost = std::numeric_limits<double>::max();
+
+  // The end conditions of the candidate profiles.
+  std::vector<PolyStGraphNode> nodes;
   for (const auto &level : points) {
     for (const auto &st_point : level) {
       const double speed_limit = speed_limit_.GetSpeedLimitByS(st_point.s());
       constexpr int num_speed = 10;
-      for (double v = 0; v < speed_limit + kEpsilon;
-           v += speed_limit / num_speed) {
-        PolyStGraphNode node = {st_point, v, 0.0};
-        node.speed_profile = QuarticPolynomialCurve1d(
-            0.0, start_node.speed, start_node.accel, node.st_point.s(),
-            node.speed, node.st_point.t());
-        const double c =
-            cost.Calculate(node.speed_profile, st_point.t(), min_cost);
-        if (c < min_cost) {
-          *min_cost_node = node;
-          min_cost = c;
-        }
+      for (int i = 0; i <= num_speed; ++i) {
+        nodes.emplace_back(st_point, speed_limit * i / num_speed, 0.0);
       }
     }
   }
+
+  // The candidates are independent of each other, and each one stops its
+  // evaluation once it costs more than the best one found so far by any
+  // of them.
+  std::vector<double> costs(nodes.size());
+  std::atomic<double> min_cost(std::numeric_limits<double>::max());
+  auto evaluate = [&](const size_t i) {
+    const auto &node = nodes[i];
+    const QuarticPolynomialCurve1d curve(0.0, start_node.speed,
+                                         start_node.accel, node.st_point.s(),
+                                         node.speed, node.st_point.t());
+    const double c = cost.Calculate(curve, node.st_point.t(),
+                                    min_cost.load(std::memory_order_relaxed));
+    costs[i] = c;
+    double curr_min_cost = min_cost.load(std::memory_order_relaxed);
+    while (c < curr_min_cost &&
+           !min_cost.compare_exchange_weak(curr_min_cost, c)) {
+    }
+  };
+  auto *thread_pool = PlanningThreadPool::instance()->mutable_thread_pool();
+  if (FLAGS_enable_multi_thread_in_poly_st_graph && thread_pool != nullptr) {
+    constexpr size_t kNodesPerTask = 16;
+    thread_pool->ParallelFor(0, nodes.size(), evaluate, kNodesPerTask);
+  } else {
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      evaluate(i);
+    }
+  }
+
+  // A stopped evaluation costs more than the least cost, so the first
+  // candidate of the least cost is the one a serial search would pick.
+  size_t min_index = nodes.size();
+  double curr_min_cost = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (costs[i] < curr_min_cost) {
+      min_index = i;
+      curr_min_cost = costs[i];
+    }
+  }
+  if (min_index < nodes.size()) {
+    *min_cost_node = nodes[min_index];
+    min_cost_node->speed_profile = QuarticPolynomialCurve1d(
+        0.0, start_node.speed, start_node.accel, min_cost_node->st_point.s(),
+        min_cost_node->speed, min_cost_node->st_point.t());
+  }
   return true;
 }
 
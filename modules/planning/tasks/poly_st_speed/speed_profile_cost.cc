@@ -29,6 +29,8 @@ namespace planning {
 namespace {
 constexpr auto kInfCost = std::numeric_limits<double>::infinity();
 constexpr double kEpsilon = 1e-6;
+// Obstacles starting farther away than this do not add to the cost.
+constexpr double kIgnoreDistance = 100.0;
 }
 
 using apollo::common::TrajectoryPoint;
@@ -37,27 +39,34 @@ SpeedProfileCost::SpeedProfileCost(
     const PolyStSpeedConfig &config,
     const std::vector<const PathObstacle *> &obstacles,
     const SpeedLimit &speed_limit, const common::TrajectoryPoint &init_point)
-    : config_(config),
-      obstacles_(obstacles),
-      speed_limit_(speed_limit),
-      init_point_(init_point) {}
+    : config_(config), speed_limit_(speed_limit), init_point_(init_point) {
+  for (const auto *obstacle : obstacles) {
+    if (obstacle->st_boundary().min_s() <= kIgnoreDistance) {
+      obstacles_.push_back(obstacle);
+    }
+  }
+}
 
 double SpeedProfileCost::Calculate(const QuarticPolynomialCurve1d &curve,
                                    const double end_time,
                                    const double curr_min_cost) const {
   double cost = 0.0;
   constexpr double kDeltaT = 0.5;
+  // s mostly grows with t, so the speed limit lookups start from the
+  // segment found for the previous sample.
+  std::size_t speed_limit_hint = 0;
   for (double t = kDeltaT; t < end_time + kEpsilon; t += kDeltaT) {
     if (cost > curr_min_cost) {
       return cost;
     }
-    cost += CalculatePointCost(curve, t);
+    cost += CalculatePointCost(curve, t, &speed_limit_hint);
   }
   return cost;
 }
 
 double SpeedProfileCost::CalculatePointCost(
-    const QuarticPolynomialCurve1d &curve, const double t) const {
+    const QuarticPolynomialCurve1d &curve, const double t,
+    std::size_t *speed_limit_hint) const {
   const double s = curve.Evaluate(0, t);
   const double v = curve.Evaluate(1, t);
   const double a = curve.Evaluate(2, t);
@@ -67,7 +76,8 @@ double SpeedProfileCost::CalculatePointCost(
     return kInfCost;
   }
 
-  const double speed_limit = speed_limit_.GetSpeedLimitByS(s);
+  const double speed_limit =
+      speed_limit_.GetSpeedLimitByS(s, speed_limit_hint);
   if (v < 0.0 || v > speed_limit * (1.0 + config_.speed_limit_buffer())) {
     return kInfCost;
   }
@@ -77,11 +87,7 @@ double SpeedProfileCost::CalculatePointCost(
 
   double cost = 0.0;
   for (const auto *obstacle : obstacles_) {
-    auto boundary = obstacle->st_boundary();
-    const double kIgnoreDistance = 100.0;
-    if (boundary.min_s() > kIgnoreDistance) {
-      continue;
-    }
+    const auto &boundary = obstacle->st_boundary();
     if (t < boundary.min_t() || t > boundary.max_t()) {
       continue;
     }
@@ -21,6 +21,7 @@
 #ifndef MODULES_PLANNING_TASKS_POLY_ST_SPEED_SPEED_PROFILE_COST_H_
 #define MODULES_PLANNING_TASKS_POLY_ST_SPEED_SPEED_PROFILE_COST_H_
 
+#include <cstddef>
 #include <vector>
 
 #include "modules/common/proto/pnc_point.pb.h"
@@ -41,15 +42,21 @@ class SpeedProfileCost {
                             const SpeedLimit &speed_limit,
                             const common::TrajectoryPoint &init_point);
 
+  /**
+   * @brief sums the costs of the curve sampled up to end_time, and stops
+   * early once the sum exceeds curr_min_cost. Thread safe.
+   */
   double Calculate(const QuarticPolynomialCurve1d &curve, const double end_time,
                    const double curr_min_cost) const;
 
  private:
   double CalculatePointCost(const QuarticPolynomialCurve1d &curve,
-                            const double t) const;
+                            const double t,
+                            std::size_t *speed_limit_hint) const;
 
   const PolyStSpeedConfig config_;
-  const std::vector<const PathObstacle *> &obstacles_;
+  // The obstacles close enough to add to the cost.
+  std::vector<const PathObstacle *> obstacles_;
   const SpeedLimit &speed_limit_;
   const common::TrajectoryPoint &init_point_;
 };
@@ -30,6 +30,7 @@
 #include "modules/common/macro.h"
 #include "modules/common/util/util.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_thread_pool.h"
 #include "modules/planning/common/planning_util.h"
 
 namespace apollo {
@@ -122,10 +123,11 @@ QpFrenetFrame::GetDynamicObstacleBound() const {
 }
 
 bool QpFrenetFrame::CalculateDiscretizedVehicleLocation() {
+  std::size_t speed_index = 0;
   for (double relative_time = 0.0; relative_time < speed_data_.TotalTime();
        relative_time += time_resolution_) {
     SpeedPoint veh_point;
-    if (!speed_data_.EvaluateByTime(relative_time, &veh_point)) {
+    if (!speed_data_.EvaluateByTime(relative_time, &veh_point, &speed_index)) {
       AERROR << "Fail to get speed point at relative time " << relative_time;
       return false;
     }
@@ -136,7 +138,7 @@ bool QpFrenetFrame::CalculateDiscretizedVehicleLocation() {
 }
 
 bool QpFrenetFrame::MapDynamicObstacleWithDecision(
-    const PathObstacle& path_obstacle) {
+    const PathObstacle& path_obstacle, ObstacleEdges* const edges) const {
   const Obstacle* ptr_obstacle = path_obstacle.obstacle();
   if (!path_obstacle.HasLateralDecision()) {
     ADEBUG << "object has no lateral decision";
@@ -158,19 +160,29 @@ bool QpFrenetFrame::MapDynamicObstacleWithDecision(
     std::vector<common::math::Vec2d> corners;
     obs_box.GetAllCorners(&corners);
     std::vector<common::SLPoint> sl_corners;
-
-    for (const auto& corner_xy : corners) {
-      common::SLPoint cur_point;
-      if (!reference_line_.XYToSL(corner_xy, &cur_point)) {
-        AERROR << "Fail to map xy point " << corner_xy.DebugString() << " to "
-               << cur_point.ShortDebugString();
-        return false;
-      }
+    if (!reference_line_.XYToSL(corners, false, &sl_corners)) {
+      AERROR << "Fail to map box " << obs_box.DebugString()
+             << " to reference line";
+      return false;
+    }
+    for (auto& cur_point : sl_corners) {
       // shift box base on buffer
       cur_point.set_l(cur_point.l() + nudge.distance_l());
-      sl_corners.push_back(std::move(cur_point));
     }
 
+    // the bound only depends on the time step, not on the corners
+    double s_resolution = std::fabs(veh_point.v() * time_resolution_);
+    double updated_start_s =
+        init_frenet_point_.s() + veh_point.s() - s_resolution;
+    double updated_end_s =
+        init_frenet_point_.s() + veh_point.s() + s_resolution;
+    if (updated_end_s > evaluated_s_.back() ||
+        updated_start_s < evaluated_s_.front()) {
+      continue;
+    }
+    const std::pair<uint32_t, uint32_t> update_index_range =
+        FindInterval(updated_start_s, updated_end_s);
+
     for (uint32_t i = 0; i < sl_corners.size(); ++i) {
       common::SLPoint sl_first = sl_corners[i % sl_corners.size()];
       common::SLPoint sl_second = sl_corners[(i + 1) % sl_corners.size()];
@@ -178,38 +190,18 @@ bool QpFrenetFrame::MapDynamicObstacleWithDecision(
         std::swap(sl_first, sl_second);
       }
 
-      std::pair<double, double> bound = MapLateralConstraint(
+      edges->index_ranges.push_back(update_index_range);
+      edges->bounds.push_back(MapLateralConstraint(
           sl_first, sl_second, nudge.type(),
           veh_point.s() - vehicle_param_.back_edge_to_center(),
-          veh_point.s() + vehicle_param_.front_edge_to_center());
-
-      // update bound map
-      double s_resolution = std::fabs(veh_point.v() * time_resolution_);
-      double updated_start_s =
-          init_frenet_point_.s() + veh_point.s() - s_resolution;
-      double updated_end_s =
-          init_frenet_point_.s() + veh_point.s() + s_resolution;
-      if (updated_end_s > evaluated_s_.back() ||
-          updated_start_s < evaluated_s_.front()) {
-        continue;
-      }
-      std::pair<uint32_t, uint32_t> update_index_range =
-          FindInterval(updated_start_s, updated_end_s);
-
-      for (uint32_t j = update_index_range.first;
-           j <= update_index_range.second; ++j) {
-        dynamic_obstacle_bound_[j].first =
-            std::max(bound.first, dynamic_obstacle_bound_[j].first);
-        dynamic_obstacle_bound_[j].second =
-            std::min(bound.second, dynamic_obstacle_bound_[j].second);
-      }
+          veh_point.s() + vehicle_param_.front_edge_to_center()));
     }
   }
   return true;
 }
 
 bool QpFrenetFrame::MapStaticObstacleWithDecision(
-    const PathObstacle& path_obstacle) {
+    const PathObstacle& path_obstacle, ObstacleEdges* const edges) const {
   const auto ptr_obstacle = path_obstacle.obstacle();
   if (!path_obstacle.HasLateralDecision()) {
     ADEBUG << "obstacle has no lateral decision";
@@ -222,7 +214,7 @@ bool QpFrenetFrame::MapStaticObstacleWithDecision(
   }
   if (!MapNudgePolygon(
           common::math::Polygon2d(ptr_obstacle->PerceptionBoundingBox()),
-          decision.nudge(), &static_obstacle_bound_)) {
+          decision.nudge(), edges)) {
     AERROR << "fail to map polygon with id " << path_obstacle.Id()
            << " in qp frenet frame";
     return false;
@@ -230,38 +222,46 @@ bool QpFrenetFrame::MapStaticObstacleWithDecision(
   return true;
 }
 
-bool QpFrenetFrame::MapNudgePolygon(
-    const common::math::Polygon2d& polygon, const ObjectNudge& nudge,
-    std::vector<std::pair<double, double>>* const bound_map) {
-  std::vector<common::SLPoint> sl_corners;
-  for (const auto& corner_xy : polygon.points()) {
-    common::SLPoint corner_sl;
-    if (!reference_line_.XYToSL(corner_xy, &corner_sl)) {
-      AERROR << "Fail to map xy point " << corner_xy.DebugString() << " to "
-             << corner_sl.DebugString();
-      return false;
-    }
+bool QpFrenetFrame::MapNudgePolygon(const common::math::Polygon2d& polygon,
+                                    const ObjectNudge& nudge,
+                                    ObstacleEdges* const edges) const {
+  if (!reference_line_.XYToSL(polygon.points(), false, &edges->sl_corners)) {
+    AERROR << "Fail to map polygon " << polygon.DebugString()
+           << " to reference line";
+    return false;
+  }
+  for (auto& corner_sl : edges->sl_corners) {
     // shift box based on buffer
     // nudge decision buffer:
     // --- position for left nudge
     // --- negative for right nudge
     corner_sl.set_l(corner_sl.l() + nudge.distance_l());
-    sl_corners.push_back(std::move(corner_sl));
   }
+  edges->nudge_type = nudge.type();
+  return true;
+}
 
+void QpFrenetFrame::ApplyObstacleEdges(const ObstacleEdges& edges) {
+  const auto& sl_corners = edges.sl_corners;
   const auto corner_size = sl_corners.size();
   for (uint32_t i = 0; i < corner_size; ++i) {
-    if (!MapNudgeLine(sl_corners[i], sl_corners[(i + 1) % corner_size],
-                      nudge.type(), bound_map)) {
-      AERROR << "Map box line (sl) " << sl_corners[i].DebugString() << "->"
-             << sl_corners[(i + 1) % corner_size].DebugString();
-      return false;
+    MapNudgeLine(sl_corners[i], sl_corners[(i + 1) % corner_size],
+                 edges.nudge_type, &static_obstacle_bound_);
+  }
+
+  for (size_t k = 0; k < edges.bounds.size(); ++k) {
+    const auto& bound = edges.bounds[k];
+    for (uint32_t j = edges.index_ranges[k].first;
+         j <= edges.index_ranges[k].second; ++j) {
+      dynamic_obstacle_bound_[j].first =
+          std::max(bound.first, dynamic_obstacle_bound_[j].first);
+      dynamic_obstacle_bound_[j].second =
+          std::min(bound.second, dynamic_obstacle_bound_[j].second);
     }
   }
-  return true;
 }
 
-bool QpFrenetFrame::MapNudgeLine(
+void QpFrenetFrame::MapNudgeLine(
     const common::SLPoint& start, const common::SLPoint& end,
     const ObjectNudge::Type nudge_type,
     std::vector<std::pair<double, double>>* const constraint) {
@@ -274,7 +274,7 @@ bool QpFrenetFrame::MapNudgeLine(
 
   if (further_point.s() < start_s_ - vehicle_param_.back_edge_to_center() ||
       near_point.s() > end_s_ + vehicle_param_.front_edge_to_center()) {
-    return true;
+    return;
   }
 
   const double distance =
@@ -303,7 +303,7 @@ bool QpFrenetFrame::MapNudgeLine(
                      feasible_longitudinal_upper_bound_);
       } else {
         feasible_longitudinal_upper_bound_ = start_s_;
-        return true;
+        return;
       }
 
       ADEBUG << "current mapping constraint, sl point impact index "
@@ -314,14 +314,12 @@ bool QpFrenetFrame::MapNudgeLine(
       break;
     }
   }
-
-  return true;
 }
 
 std::pair<double, double> QpFrenetFrame::MapLateralConstraint(
     const common::SLPoint& start, const common::SLPoint& end,
     const ObjectNudge::Type nudge_type, const double s_start,
-    const double s_end) {
+    const double s_end) const {
   constexpr double inf = std::numeric_limits<double>::infinity();
   std::pair<double, double> result = std::make_pair(-inf, inf);
 
@@ -408,23 +406,40 @@ bool QpFrenetFrame::CalculateHDMapBound() {
 
 bool QpFrenetFrame::CalculateObstacleBound(
     const std::vector<const PathObstacle*>& path_obstacles) {
+  std::vector<const PathObstacle*> nudge_obstacles;
   for (const auto ptr_path_obstacle : path_obstacles) {
-    if (!ptr_path_obstacle->HasLateralDecision()) {
-      continue;
+    if (ptr_path_obstacle->HasLateralDecision()) {
+      nudge_obstacles.push_back(ptr_path_obstacle);
     }
-    if (ptr_path_obstacle->obstacle()->IsStatic()) {
-      if (!MapStaticObstacleWithDecision(*ptr_path_obstacle)) {
-        AERROR << "mapping obstacle with id [" << ptr_path_obstacle->Id()
-               << "] failed in qp frenet frame.";
-        return false;
-      }
-    } else {
-      if (!MapDynamicObstacleWithDecision(*ptr_path_obstacle)) {
-        AERROR << "mapping obstacle with id [" << ptr_path_obstacle->Id()
-               << "] failed in qp frenet frame.";
-        return false;
-      }
+  }
+
+  // The obstacles are projected on the reference line independently of each
+  // other, then their edges are applied on the bounds in order.
+  std::vector<ObstacleEdges> edges(nudge_obstacles.size());
+  std::vector<char> is_mapped(nudge_obstacles.size(), 0);
+  auto map_obstacle = [&](const size_t i) {
+    const auto& path_obstacle = *nudge_obstacles[i];
+    is_mapped[i] =
+        path_obstacle.obstacle()->IsStatic()
+            ? MapStaticObstacleWithDecision(path_obstacle, &edges[i])
+            : MapDynamicObstacleWithDecision(path_obstacle, &edges[i]);
+  };
+  auto* thread_pool = PlanningThreadPool::instance()->mutable_thread_pool();
+  if (FLAGS_enable_multi_thread_in_qp_frenet_frame && thread_pool != nullptr) {
+    thread_pool->ParallelFor(0, nudge_obstacles.size(), map_obstacle);
+  } else {
+    for (size_t i = 0; i < nudge_obstacles.size(); ++i) {
+      map_obstacle(i);
+    }
+  }
+
+  for (size_t i = 0; i < nudge_obstacles.size(); ++i) {
+    if (!is_mapped[i]) {
+      AERROR << "mapping obstacle with id [" << nudge_obstacles[i]->Id()
+             << "] failed in qp frenet frame.";
+      return false;
     }
+    ApplyObstacleEdges(edges[i]);
   }
   return true;
 }
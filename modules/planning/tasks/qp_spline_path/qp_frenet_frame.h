@@ -59,22 +59,39 @@ class QpFrenetFrame {
  private:
   bool CalculateDiscretizedVehicleLocation();
 
-  bool MapDynamicObstacleWithDecision(const PathObstacle& path_obstacle);
-
-  bool MapStaticObstacleWithDecision(const PathObstacle& path_obstacle);
+  // The sl edges of an obstacle with a nudge decision, mapped on the
+  // reference line independently of the other obstacles.
+  struct ObstacleEdges {
+    // The corners of a static obstacle, whose edges bound the evaluated s
+    // covered by them.
+    std::vector<common::SLPoint> sl_corners;
+    ObjectNudge::Type nudge_type = ObjectNudge::LEFT_NUDGE;
+    // The lateral bounds of the edges of a dynamic obstacle at every time
+    // step, over the index ranges of evaluated s that time step covers.
+    std::vector<std::pair<uint32_t, uint32_t>> index_ranges;
+    std::vector<std::pair<double, double>> bounds;
+  };
+
+  bool MapDynamicObstacleWithDecision(const PathObstacle& path_obstacle,
+                                      ObstacleEdges* const edges) const;
+
+  bool MapStaticObstacleWithDecision(const PathObstacle& path_obstacle,
+                                     ObstacleEdges* const edges) const;
 
   bool MapNudgePolygon(const common::math::Polygon2d& polygon,
                        const ObjectNudge& nudge,
-                       std::vector<std::pair<double, double>>* const bound_map);
+                       ObstacleEdges* const edges) const;
+
+  void ApplyObstacleEdges(const ObstacleEdges& edges);
 
-  bool MapNudgeLine(const common::SLPoint& start, const common::SLPoint& end,
+  void MapNudgeLine(const common::SLPoint& start, const common::SLPoint& end,
                     const ObjectNudge::Type type,
                     std::vector<std::pair<double, double>>* const constraint);
 
   std::pair<double, double> MapLateralConstraint(
       const common::SLPoint& start, const common::SLPoint& end,
       const ObjectNudge::Type nudge_type, const double s_start,
-      const double s_end);
+      const double s_end) const;
 
   std::pair<uint32_t, uint32_t> FindInterval(const double start,
                                              const double end) const;
@@ -34,7 +34,8 @@ QpSplinePathOptimizer::QpSplinePathOptimizer()
     : PathOptimizer("QpSplinePathOptimizer") {}
 
 bool QpSplinePathOptimizer::Init(const PlanningConfig& config) {
-  qp_spline_path_config_ = config.em_planner_config().qp_spline_path_config();
+  full_quality_config_ = config.em_planner_config().qp_spline_path_config();
+  ApplyQualityLevel();
   std::vector<double> init_knots;
   spline_generator_.reset(
       new Spline1dGenerator(init_knots, qp_spline_path_config_.spline_order()));
@@ -42,6 +43,14 @@ bool QpSplinePathOptimizer::Init(const PlanningConfig& config) {
   return true;
 }
 
+int QpSplinePathOptimizer::NumQualityLevels() const { return 3; }
+
+void QpSplinePathOptimizer::ApplyQualityLevel() {
+  qp_spline_path_config_ = full_quality_config_;
+  qp_spline_path_config_.set_max_spline_length(
+      qp_spline_path_config_.max_spline_length() * (1 << quality_level_));
+}
+
 Status QpSplinePathOptimizer::Process(const SpeedData& speed_data,
                                       const ReferenceLine& reference_line,
                                       const common::TrajectoryPoint& init_point,
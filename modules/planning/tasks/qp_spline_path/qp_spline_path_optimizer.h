@@ -40,13 +40,23 @@ class QpSplinePathOptimizer : public PathOptimizer {
   QpSplinePathOptimizer();
   bool Init(const PlanningConfig& config) override;
 
+  /**
+   * @brief every quality level doubles the max length of a spline, which
+   * halves the knots of the path.
+   */
+  int NumQualityLevels() const override;
+
  private:
+  void ApplyQualityLevel() override;
+
   apollo::common::Status Process(const SpeedData& speed_data,
                                  const ReferenceLine& reference_line,
                                  const common::TrajectoryPoint& init_point,
                                  PathData* const path_data) override;
 
  private:
+  /// the config at quality level 0
+  QpSplinePathConfig full_quality_config_;
   QpSplinePathConfig qp_spline_path_config_;
   std::unique_ptr<Spline1dGenerator> spline_generator_;
 };
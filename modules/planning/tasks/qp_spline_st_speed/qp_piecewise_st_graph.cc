@@ -385,6 +385,8 @@ Status QpPiecewiseStGraph::EstimateSpeedUpperBound(
     uint32_t i = 0;
     uint32_t j = 0;
     const double kDistanceEpsilon = 1e-6;
+    // the distance increases with the evaluated time
+    std::size_t speed_limit_index = 0;
     while (i < t_evaluated_.size() &&
            j + 1 < speed_limit.speed_limit_points().size()) {
       const double distance = v * t_evaluated_[i];
@@ -397,7 +399,8 @@ Status QpPiecewiseStGraph::EstimateSpeedUpperBound(
       } else if (distance < speed_limit.speed_limit_points()[j].first) {
         ++i;
       } else if (distance <= speed_limit.speed_limit_points()[j + 1].first) {
-        speed_upper_bound->push_back(speed_limit.GetSpeedLimitByS(distance));
+        speed_upper_bound->push_back(
+            speed_limit.GetSpeedLimitByS(distance, &speed_limit_index));
         ADEBUG << "speed upper bound:" << speed_upper_bound->back();
         ++i;
       } else {
@@ -28,6 +28,7 @@
 #include "modules/common/log.h"
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_util.h"
 
 namespace apollo {
 namespace planning {
@@ -541,13 +542,16 @@ Status QpSplineStGraph::EstimateSpeedUpperBound(
                                 speed_limit.speed_limit_points().size()))) {
     uint32_t i = 0;
     uint32_t j = 0;
+    // the evaluated time and the distance increase
+    std::size_t speed_index = 0;
+    std::size_t speed_limit_index = 0;
     while (i < t_evaluated_.size() &&
            j + 1 < speed_limit.speed_limit_points().size()) {
       double distance = v * t_evaluated_[i];
       if (!last_speed_data.Empty() &&
           distance < last_speed_data.speed_vector().back().s()) {
         SpeedPoint p;
-        last_speed_data.EvaluateByTime(t_evaluated_[i], &p);
+        last_speed_data.EvaluateByTime(t_evaluated_[i], &p, &speed_index);
         distance = p.s();
       }
       constexpr double kDistanceEpsilon = 1e-6;
@@ -559,7 +563,8 @@ Status QpSplineStGraph::EstimateSpeedUpperBound(
       } else if (distance < speed_limit.speed_limit_points()[j].first) {
         ++i;
       } else if (distance <= speed_limit.speed_limit_points()[j + 1].first) {
-        speed_upper_bound->push_back(speed_limit.GetSpeedLimitByS(distance));
+        speed_upper_bound->push_back(
+            speed_limit.GetSpeedLimitByS(distance, &speed_limit_index));
         ++i;
       } else {
         ++j;
@@ -576,24 +581,23 @@ Status QpSplineStGraph::EstimateSpeedUpperBound(
     };
 
     const auto& speed_limit_points = speed_limit.speed_limit_points();
+    std::size_t speed_index = 0;
+    std::size_t speed_limit_index = 0;
     for (const double t : t_evaluated_) {
       double s = v * t;
       if (!last_speed_data.Empty() &&
           s < last_speed_data.speed_vector().back().s()) {
         SpeedPoint p;
-        last_speed_data.EvaluateByTime(t, &p);
+        last_speed_data.EvaluateByTime(t, &p, &speed_index);
         s = p.s();
       }
 
-      // NOTICE: we are using binary search here based on two assumptions:
-      // (1) The s in speed_limit_points increase monotonically.
-      // (2) The evaluated_t_.size() << number of speed_limit_points.size()
-      //
-      // If either of the two assumption is failed, a new algorithm must be
-      // used to replace the binary search.
-
-      const auto& it = std::lower_bound(speed_limit_points.begin(),
-                                        speed_limit_points.end(), s, cmp);
+      // NOTICE: the search relies on the s in speed_limit_points increasing
+      // monotonically. It goes on from the last lower bound, since s also
+      // increases with t.
+      const auto it = util::LowerBoundWithHint(
+          speed_limit_points.begin(), speed_limit_points.end(), s, cmp,
+          &speed_limit_index);
       if (it != speed_limit_points.end()) {
         speed_upper_bound->push_back(it->second);
       } else {
@@ -46,14 +46,30 @@ QpSplineStSpeedOptimizer::QpSplineStSpeedOptimizer()
     : SpeedOptimizer("QpSplineStSpeedOptimizer") {}
 
 bool QpSplineStSpeedOptimizer::Init(const PlanningConfig& config) {
-  qp_st_speed_config_ = config.em_planner_config().qp_st_speed_config();
-  st_boundary_config_ = qp_st_speed_config_.st_boundary_config();
+  full_quality_config_ = config.em_planner_config().qp_st_speed_config();
+  st_boundary_config_ = full_quality_config_.st_boundary_config();
+  ApplyQualityLevel();
   std::vector<double> init_knots;
   spline_generator_.reset(new Spline1dGenerator(init_knots, 5));
   is_init_ = true;
   return true;
 }
 
+int QpSplineStSpeedOptimizer::NumQualityLevels() const { return 3; }
+
+void QpSplineStSpeedOptimizer::ApplyQualityLevel() {
+  constexpr int kMinNumberOfKnots = 2;
+  qp_st_speed_config_ = full_quality_config_;
+  auto* qp_spline_config = qp_st_speed_config_.mutable_qp_spline_config();
+  const int number_of_knots =
+      static_cast<int>(qp_spline_config->number_of_discrete_graph_t());
+  if (number_of_knots <= kMinNumberOfKnots) {
+    return;
+  }
+  qp_spline_config->set_number_of_discrete_graph_t(
+      std::max(kMinNumberOfKnots, number_of_knots - quality_level_));
+}
+
 Status QpSplineStSpeedOptimizer::Process(const SLBoundary& adc_sl_boundary,
                                          const PathData& path_data,
                                          const TrajectoryPoint& init_point,
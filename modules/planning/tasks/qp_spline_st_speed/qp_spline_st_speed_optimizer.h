@@ -43,7 +43,15 @@ class QpSplineStSpeedOptimizer : public SpeedOptimizer {
 
   bool Init(const PlanningConfig& config) override;
 
+  /**
+   * @brief every quality level drops one knot of the speed spline, keeping
+   * at least 2 of them.
+   */
+  int NumQualityLevels() const override;
+
  private:
+  void ApplyQualityLevel() override;
+
   common::Status Process(const SLBoundary& adc_sl_boundary,
                          const PathData& path_data,
                          const apollo::common::TrajectoryPoint& init_point,
@@ -52,6 +60,8 @@ class QpSplineStSpeedOptimizer : public SpeedOptimizer {
                          PathDecision* const path_decision,
                          SpeedData* const speed_data) override;
 
+  /// the config at quality level 0
+  QpStSpeedConfig full_quality_config_;
   QpStSpeedConfig qp_st_speed_config_;
   StBoundaryConfig st_boundary_config_;
   std::unique_ptr<Spline1dGenerator> spline_generator_;
@@ -35,9 +35,11 @@
 #include "modules/common/util/file.h"
 #include "modules/common/util/string_util.h"
 #include "modules/common/util/util.h"
+#include "modules/common/util/work_stealing_thread_pool.h"
 #include "modules/common/vehicle_state/vehicle_state_provider.h"
 #include "modules/planning/common/frame.h"
 #include "modules/planning/common/planning_gflags.h"
+#include "modules/planning/common/planning_thread_pool.h"
 
 namespace apollo {
 namespace planning {
@@ -55,6 +57,7 @@ using apollo::common::util::StrCat;
 namespace {
 constexpr double boundary_t_buffer = 0.1;
 constexpr double boundary_s_buffer = 1.0;
+constexpr int kDefaultNumPoint = 50;
 }
 
 StBoundaryMapper::StBoundaryMapper(const SLBoundary& adc_sl_boundary,
@@ -71,7 +74,97 @@ StBoundaryMapper::StBoundaryMapper(const SLBoundary& adc_sl_boundary,
       vehicle_param_(common::VehicleConfigHelper::GetConfig().vehicle_param()),
       planning_distance_(planning_distance),
       planning_time_(planning_time),
-      is_change_lane_(is_change_lane) {}
+      is_change_lane_(is_change_lane) {
+  BuildPathIndex();
+}
+
+void StBoundaryMapper::BuildPathIndex() {
+  const auto& path_points = path_data_.discretized_path().path_points();
+  if (path_points.empty()) {
+    return;
+  }
+  if (path_points.size() > 2 * kDefaultNumPoint) {
+    const int ratio = path_points.size() / kDefaultNumPoint;
+    std::vector<PathPoint> sampled_path_points;
+    for (size_t i = 0; i < path_points.size(); ++i) {
+      if (i % ratio == 0) {
+        sampled_path_points.push_back(path_points[i]);
+      }
+    }
+    sampled_path_.set_path_points(sampled_path_points);
+  } else {
+    sampled_path_.set_path_points(path_points);
+  }
+
+  const double step_length = vehicle_param_.front_edge_to_center();
+  std::size_t path_index = 0;
+  for (double path_s = 0.0; path_s < sampled_path_.Length();
+       path_s += step_length) {
+    coarse_sample_s_.push_back(path_s);
+    coarse_sample_points_.push_back(
+        sampled_path_.EvaluateUsingLinearApproximation(
+            path_s + sampled_path_.StartPoint().s(), &path_index));
+    coarse_sample_boxes_.emplace_back(
+        GetAdcBox(coarse_sample_points_.back(),
+                  st_boundary_config_.boundary_buffer())
+            .GetAABox(),
+        coarse_sample_boxes_.size());
+  }
+  if (!coarse_sample_boxes_.empty()) {
+    common::math::AABoxKDTreeParams params;
+    params.max_leaf_size = 4;
+    coarse_sample_kdtree_.reset(new common::math::AABoxKDTree2d<PathSampleBox>(
+        coarse_sample_boxes_, params));
+  }
+}
+
+std::vector<size_t> StBoundaryMapper::GetCandidatePathSamples(
+    const Box2d& obs_box) const {
+  std::vector<size_t> candidates;
+  if (coarse_sample_kdtree_ == nullptr) {
+    return candidates;
+  }
+  // Any ADC box overlapping obs_box has its bounding box within half of the
+  // diagonal of obs_box from its center.
+  constexpr double kEpsilon = 1e-6;
+  for (const auto* sample_box : coarse_sample_kdtree_->GetObjects(
+           obs_box.center(), obs_box.diagonal() / 2.0 + kEpsilon)) {
+    candidates.push_back(sample_box->index());
+  }
+  std::sort(candidates.begin(), candidates.end());
+  return candidates;
+}
+
+void StBoundaryMapper::ComputeOverlaps(const PathDecision& path_decision,
+                                       OverlapMap* overlaps) const {
+  CHECK_NOTNULL(overlaps);
+  std::vector<const PathObstacle*> path_obstacles;
+  for (const auto* path_obstacle : path_decision.path_obstacles().Items()) {
+    if (path_obstacle->HasLongitudinalDecision()) {
+      const auto& decision = path_obstacle->LongitudinalDecision();
+      if (!decision.has_follow() && !decision.has_overtake() &&
+          !decision.has_yield()) {
+        continue;
+      }
+    }
+    path_obstacles.push_back(path_obstacle);
+    (*overlaps)[path_obstacle->Id()];
+  }
+
+  // Every task only writes the entry of its own obstacle, which was created
+  // above.
+  common::util::TaskGroup task_group(
+      PlanningThreadPool::instance()->mutable_thread_pool());
+  for (const auto* path_obstacle : path_obstacles) {
+    auto* overlap = &overlaps->at(path_obstacle->Id());
+    task_group.Run([this, path_obstacle, overlap]() {
+      overlap->has_overlap = GetOverlapBoundaryPoints(
+          *path_obstacle->obstacle(), &overlap->upper_points,
+          &overlap->lower_points);
+    });
+  }
+  task_group.Wait();
+}
 
 Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
   const auto& path_obstacles = path_decision->path_obstacles();
@@ -89,6 +182,11 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
                   "Fail to get params because of too few path points");
   }
 
+  OverlapMap overlaps;
+  if (FLAGS_enable_parallel_st_boundary_mapping) {
+    ComputeOverlaps(*path_decision, &overlaps);
+  }
+
   PathObstacle* stop_obstacle = nullptr;
   ObjectDecisionType stop_decision;
   double min_stop_s = std::numeric_limits<double>::max();
@@ -96,7 +194,7 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
   for (const auto* const_path_obstacle : path_obstacles.Items()) {
     auto* path_obstacle = path_decision->Find(const_path_obstacle->Id());
     if (!path_obstacle->HasLongitudinalDecision()) {
-      if (!MapWithoutDecision(path_obstacle).ok()) {
+      if (!MapWithoutDecision(path_obstacle, overlaps).ok()) {
         std::string msg = StrCat("Fail to map obstacle ", path_obstacle->Id(),
                                  " without decision.");
         AERROR << msg;
@@ -125,7 +223,7 @@ Status StBoundaryMapper::CreateStBoundary(PathDecision* path_decision) const {
       }
     } else if (decision.has_follow() || decision.has_overtake() ||
                decision.has_yield()) {
-      if (!MapWithDecision(path_obstacle, decision).ok()) {
+      if (!MapWithDecision(path_obstacle, decision, overlaps).ok()) {
         AERROR << "Fail to map obstacle " << path_obstacle->Id()
                << " with decision: " << decision.DebugString();
         return Status(ErrorCode::PLANNING_ERROR,
@@ -176,6 +274,11 @@ Status StBoundaryMapper::CreateStBoundaryWithHistory(
     }
   }
 
+  OverlapMap overlaps;
+  if (FLAGS_enable_parallel_st_boundary_mapping) {
+    ComputeOverlaps(*path_decision, &overlaps);
+  }
+
   PathObstacle* stop_obstacle = nullptr;
   ObjectDecisionType stop_decision;
   double min_stop_s = std::numeric_limits<double>::max();
@@ -190,7 +293,7 @@ Status StBoundaryMapper::CreateStBoundaryWithHistory(
       decision = iter->second;
     }
     if (!path_obstacle->HasLongitudinalDecision()) {
-      if (!MapWithoutDecision(path_obstacle).ok()) {
+      if (!MapWithoutDecision(path_obstacle, overlaps).ok()) {
         std::string msg = StrCat("Fail to map obstacle ", path_obstacle->Id(),
                                  " without decision.");
         AERROR << msg;
@@ -223,7 +326,7 @@ Status StBoundaryMapper::CreateStBoundaryWithHistory(
       }
     } else if (decision.has_follow() || decision.has_overtake() ||
                decision.has_yield()) {
-      if (!MapWithDecision(path_obstacle, decision).ok()) {
+      if (!MapWithDecision(path_obstacle, decision, overlaps).ok()) {
         AERROR << "Fail to map obstacle " << path_obstacle->Id()
                << " with decision: " << decision.DebugString();
         return Status(ErrorCode::PLANNING_ERROR,
@@ -294,13 +397,13 @@ bool StBoundaryMapper::MapStopDecision(
   return true;
 }
 
-Status StBoundaryMapper::MapWithoutDecision(PathObstacle* path_obstacle) const {
+Status StBoundaryMapper::MapWithoutDecision(PathObstacle* path_obstacle,
+                                            const OverlapMap& overlaps) const {
   std::vector<STPoint> lower_points;
   std::vector<STPoint> upper_points;
 
-  if (!GetOverlapBoundaryPoints(path_data_.discretized_path().path_points(),
-                                *(path_obstacle->obstacle()), &upper_points,
-                                &lower_points)) {
+  if (!GetOverlapBoundaryPoints(*(path_obstacle->obstacle()), overlaps,
+                                &upper_points, &lower_points)) {
     return Status::OK();
   }
 
@@ -317,9 +420,22 @@ Status StBoundaryMapper::MapWithoutDecision(PathObstacle* path_obstacle) const {
 }
 
 bool StBoundaryMapper::GetOverlapBoundaryPoints(
-    const std::vector<PathPoint>& path_points, const Obstacle& obstacle,
+    const Obstacle& obstacle, const OverlapMap& overlaps,
     std::vector<STPoint>* upper_points,
     std::vector<STPoint>* lower_points) const {
+  const auto iter = overlaps.find(obstacle.Id());
+  if (iter == overlaps.end()) {
+    return GetOverlapBoundaryPoints(obstacle, upper_points, lower_points);
+  }
+  *upper_points = iter->second.upper_points;
+  *lower_points = iter->second.lower_points;
+  return iter->second.has_overlap;
+}
+
+bool StBoundaryMapper::GetOverlapBoundaryPoints(
+    const Obstacle& obstacle, std::vector<STPoint>* upper_points,
+    std::vector<STPoint>* lower_points) const {
+  const auto& path_points = path_data_.discretized_path().path_points();
   DCHECK_NOTNULL(upper_points);
   DCHECK_NOTNULL(lower_points);
   DCHECK(upper_points->empty());
@@ -354,20 +470,7 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
       }
     }
   } else {
-    const int default_num_point = 50;
-    DiscretizedPath discretized_path;
-    if (path_points.size() > 2 * default_num_point) {
-      const int ratio = path_points.size() / default_num_point;
-      std::vector<PathPoint> sampled_path_points;
-      for (size_t i = 0; i < path_points.size(); ++i) {
-        if (i % ratio == 0) {
-          sampled_path_points.push_back(path_points[i]);
-        }
-      }
-      discretized_path.set_path_points(sampled_path_points);
-    } else {
-      discretized_path.set_path_points(path_points);
-    }
+    const auto& discretized_path = sampled_path_;
     for (int i = 0; i < trajectory.trajectory_point_size(); ++i) {
       const auto& trajectory_point = trajectory.trajectory_point(i);
       const Box2d obs_box = obstacle.GetBoundingBox(trajectory_point);
@@ -378,13 +481,12 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
         continue;
       }
 
+      // Only the coarse samples whose ADC box may overlap with obs_box are
+      // checked, in the order of s.
       const double step_length = vehicle_param_.front_edge_to_center();
-      for (double path_s = 0.0; path_s < discretized_path.Length();
-           path_s += step_length) {
-        const auto curr_adc_path_point =
-            discretized_path.EvaluateUsingLinearApproximation(
-                path_s + discretized_path.StartPoint().s());
-        if (CheckOverlap(curr_adc_path_point, obs_box,
+      for (const size_t sample : GetCandidatePathSamples(obs_box)) {
+        const double path_s = coarse_sample_s_[sample];
+        if (CheckOverlap(coarse_sample_points_[sample], obs_box,
                          st_boundary_config_.boundary_buffer())) {
           // found overlap, start searching with higher resolution
           const double backward_distance = -step_length;
@@ -393,13 +495,16 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
                                           obs_box.length() + obs_box.width();
           const double default_min_step = 0.1;  // in meters
           const double fine_tuning_step_length = std::fmin(
-              default_min_step, discretized_path.Length() / default_num_point);
+              default_min_step, discretized_path.Length() / kDefaultNumPoint);
 
           bool find_low = false;
           bool find_high = false;
           double low_s = std::fmax(0.0, path_s + backward_distance);
           double high_s =
               std::fmin(discretized_path.Length(), path_s + forward_distance);
+          // low_s increases and high_s decreases, step by step
+          std::size_t low_index = 0;
+          std::size_t high_index = discretized_path.NumOfPoints();
 
           while (low_s < high_s) {
             if (find_low && find_high) {
@@ -408,7 +513,7 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
             if (!find_low) {
               const auto& point_low =
                   discretized_path.EvaluateUsingLinearApproximation(
-                      low_s + discretized_path.StartPoint().s());
+                      low_s + discretized_path.StartPoint().s(), &low_index);
               if (!CheckOverlap(point_low, obs_box,
                                 st_boundary_config_.boundary_buffer())) {
                 low_s += fine_tuning_step_length;
@@ -419,7 +524,8 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
             if (!find_high) {
               const auto& point_high =
                   discretized_path.EvaluateUsingLinearApproximation(
-                      high_s + discretized_path.StartPoint().s());
+                      high_s + discretized_path.StartPoint().s(),
+                      &high_index);
               if (!CheckOverlap(point_high, obs_box,
                                 st_boundary_config_.boundary_buffer())) {
                 high_s -= fine_tuning_step_length;
@@ -445,8 +551,9 @@ bool StBoundaryMapper::GetOverlapBoundaryPoints(
   return (lower_points->size() > 1 && upper_points->size() > 1);
 }
 
-Status StBoundaryMapper::MapWithDecision(
-    PathObstacle* path_obstacle, const ObjectDecisionType& decision) const {
+Status StBoundaryMapper::MapWithDecision(PathObstacle* path_obstacle,
+                                         const ObjectDecisionType& decision,
+                                         const OverlapMap& overlaps) const {
   DCHECK(decision.has_follow() || decision.has_yield() ||
          decision.has_overtake())
       << "decision is " << decision.DebugString()
@@ -455,9 +562,8 @@ Status StBoundaryMapper::MapWithDecision(
   std::vector<STPoint> lower_points;
   std::vector<STPoint> upper_points;
 
-  if (!GetOverlapBoundaryPoints(path_data_.discretized_path().path_points(),
-                                *(path_obstacle->obstacle()), &upper_points,
-                                &lower_points)) {
+  if (!GetOverlapBoundaryPoints(*(path_obstacle->obstacle()), overlaps,
+                                &upper_points, &lower_points)) {
     return Status::OK();
   }
 
@@ -506,6 +612,11 @@ Status StBoundaryMapper::MapWithDecision(
 bool StBoundaryMapper::CheckOverlap(const PathPoint& path_point,
                                     const Box2d& obs_box,
                                     const double buffer) const {
+  return obs_box.HasOverlap(GetAdcBox(path_point, buffer));
+}
+
+Box2d StBoundaryMapper::GetAdcBox(const PathPoint& path_point,
+                                  const double buffer) const {
   double left_delta_l = 0.0;
   double right_delta_l = 0.0;
   if (is_change_lane_) {
@@ -527,10 +638,8 @@ bool StBoundaryMapper::CheckOverlap(const PathPoint& path_point,
           .rotate(path_point.theta());
   Vec2d center = Vec2d(path_point.x(), path_point.y()) + vec_to_center;
 
-  const Box2d adc_box =
-      Box2d(center, path_point.theta(), vehicle_param_.length() + 2 * buffer,
-            vehicle_param_.width() + 2 * buffer);
-  return obs_box.HasOverlap(adc_box);
+  return Box2d(center, path_point.theta(), vehicle_param_.length() + 2 * buffer,
+               vehicle_param_.width() + 2 * buffer);
 }
 
 void StBoundaryMapper::GetAvgKappa(
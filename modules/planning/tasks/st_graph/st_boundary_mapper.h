@@ -21,13 +21,19 @@
 #ifndef MODULES_PLANNING_TASKS_ST_GRAPH_ST_BOUNDARY_MAPPER_H_
 #define MODULES_PLANNING_TASKS_ST_GRAPH_ST_BOUNDARY_MAPPER_H_
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "modules/common/configs/proto/vehicle_config.pb.h"
 #include "modules/planning/proto/st_boundary_config.pb.h"
 
+#include "modules/common/math/aabox2d.h"
+#include "modules/common/math/aaboxkdtree2d.h"
+#include "modules/common/math/box2d.h"
 #include "modules/common/status/status.h"
+#include "modules/planning/common/path/discretized_path.h"
 #include "modules/planning/common/path/path_data.h"
 #include "modules/planning/common/path_decision.h"
 #include "modules/planning/common/speed/st_boundary.h"
@@ -62,28 +68,94 @@ class StBoundaryMapper {
       SpeedLimit* const speed_limit_data) const;
 
  private:
+  /**
+   * @brief the ADC box at a coarse sample of the path, used to find the
+   * samples that may overlap with an obstacle box.
+   */
+  class PathSampleBox {
+   public:
+    PathSampleBox(const apollo::common::math::AABox2d& aabox,
+                  const size_t index)
+        : aabox_(aabox), index_(index) {}
+    const apollo::common::math::AABox2d& aabox() const { return aabox_; }
+    double DistanceTo(const apollo::common::math::Vec2d& point) const {
+      return aabox_.DistanceTo(point);
+    }
+    double DistanceSquareTo(const apollo::common::math::Vec2d& point) const {
+      const double distance = aabox_.DistanceTo(point);
+      return distance * distance;
+    }
+    size_t index() const { return index_; }
+
+   private:
+    apollo::common::math::AABox2d aabox_;
+    size_t index_ = 0;
+  };
+
+  /**
+   * @brief the overlap boundary points of one obstacle.
+   */
+  struct OverlapBoundaryPoints {
+    bool has_overlap = false;
+    std::vector<STPoint> upper_points;
+    std::vector<STPoint> lower_points;
+  };
+  typedef std::unordered_map<std::string, OverlapBoundaryPoints> OverlapMap;
+
   FRIEND_TEST(StBoundaryMapperTest, check_overlap_test);
   bool CheckOverlap(const apollo::common::PathPoint& path_point,
                     const apollo::common::math::Box2d& obs_box,
                     const double buffer) const;
 
+  apollo::common::math::Box2d GetAdcBox(
+      const apollo::common::PathPoint& path_point, const double buffer) const;
+
+  /**
+   * @brief samples the path and indexes the ADC boxes along it.
+   */
+  void BuildPathIndex();
+
+  /**
+   * @brief the indices of the coarse path samples whose ADC box may overlap
+   * with obs_box, in increasing order.
+   */
+  std::vector<size_t> GetCandidatePathSamples(
+      const apollo::common::math::Box2d& obs_box) const;
+
   /**
    * Creates valid st boundary upper_points and lower_points
    * If return true, upper_points.size() > 1 and
    * upper_points.size() = lower_points.size()
    */
-  bool GetOverlapBoundaryPoints(
-      const std::vector<apollo::common::PathPoint>& path_points,
-      const Obstacle& obstacle, std::vector<STPoint>* upper_points,
-      std::vector<STPoint>* lower_points) const;
+  bool GetOverlapBoundaryPoints(const Obstacle& obstacle,
+                                std::vector<STPoint>* upper_points,
+                                std::vector<STPoint>* lower_points) const;
+
+  /**
+   * @brief gets the overlap boundary points of an obstacle from overlaps if
+   * they are there, or computes them.
+   */
+  bool GetOverlapBoundaryPoints(const Obstacle& obstacle,
+                                const OverlapMap& overlaps,
+                                std::vector<STPoint>* upper_points,
+                                std::vector<STPoint>* lower_points) const;
 
-  apollo::common::Status MapWithoutDecision(PathObstacle* path_obstacle) const;
+  /**
+   * @brief computes the overlap boundary points of all the obstacles that
+   * will be mapped with overlaps, concurrently on the planning thread pool.
+   */
+  void ComputeOverlaps(const PathDecision& path_decision,
+                       OverlapMap* overlaps) const;
+
+  apollo::common::Status MapWithoutDecision(PathObstacle* path_obstacle,
+                                            const OverlapMap& overlaps) const;
 
   bool MapStopDecision(PathObstacle* stop_obstacle,
                        const ObjectDecisionType& decision) const;
 
-  apollo::common::Status MapWithDecision(
-      PathObstacle* path_obstacle, const ObjectDecisionType& decision) const;
+  apollo::common::Status MapWithDecision(PathObstacle* path_obstacle,
+                                         const ObjectDecisionType& decision,
+                                         const OverlapMap& overlaps) const;
 
   FRIEND_TEST(StBoundaryMapperTest, get_centric_acc_limit);
   double GetCentricAccLimit(const double kappa) const;
@@ -100,6 +172,15 @@ class StBoundaryMapper {
   const double planning_distance_;
   const double planning_time_;
   bool is_change_lane_ = false;
+
+  // The path sampled to at most about kDefaultNumPoint points, and the
+  // coarse samples on it where overlaps are first searched.
+  DiscretizedPath sampled_path_;
+  std::vector<double> coarse_sample_s_;
+  std::vector<apollo::common::PathPoint> coarse_sample_points_;
+  std::vector<PathSampleBox> coarse_sample_boxes_;
+  std::unique_ptr<apollo::common::math::AABoxKDTree2d<PathSampleBox>>
+      coarse_sample_kdtree_;
 };
 
 }  // namespace planning
@@ -20,6 +20,8 @@
 
 #include "modules/planning/tasks/task.h"
 
+#include <algorithm>
+
 #include "modules/planning/proto/planning_config.pb.h"
 
 namespace apollo {
@@ -33,6 +35,20 @@ const std::string& Task::Name() const { return name_; }
 
 bool Task::Init(const PlanningConfig&) { return true; }
 
+int Task::NumQualityLevels() const { return 1; }
+
+void Task::SetQualityLevel(const int level) {
+  const int clamped_level =
+      std::max(0, std::min(level, NumQualityLevels() - 1));
+  if (clamped_level == quality_level_) {
+    return;
+  }
+  quality_level_ = clamped_level;
+  ApplyQualityLevel();
+}
+
+int Task::quality_level() const { return quality_level_; }
+
 Status Task::Execute(Frame* frame, ReferenceLineInfo* reference_line_info) {
   frame_ = frame;
   reference_line_info_ = reference_line_info;
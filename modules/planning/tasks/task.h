@@ -43,8 +43,30 @@ class Task {
 
   virtual bool Init(const PlanningConfig& config);
 
+  /**
+   * @brief the number of quality levels of the task. Level 0 runs the task
+   * as configured, and every next level runs a coarser and cheaper version
+   * of it. A task without quality knobs only has level 0.
+   */
+  virtual int NumQualityLevels() const;
+
+  /**
+   * @brief sets the quality level of the next Execute() calls, clamped to
+   * [0, NumQualityLevels()).
+   */
+  void SetQualityLevel(const int level);
+
+  int quality_level() const;
+
  protected:
+  /**
+   * @brief applies the knobs of quality_level() to the task. It is called
+   * whenever the quality level changes.
+   */
+  virtual void ApplyQualityLevel() {}
+
   bool is_init_ = false;
+  int quality_level_ = 0;
   Frame* frame_ = nullptr;
   ReferenceLineInfo* reference_line_info_ = nullptr;
 
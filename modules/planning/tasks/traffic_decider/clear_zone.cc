@@ -43,7 +43,12 @@ bool ClearZone::ApplyRule(Frame* frame,
   frame_ = frame;
   reference_line_info_ = reference_line_info;
   const auto& map_path = reference_line_info_->reference_line().map_path();
-  for (const auto& clear_zone : map_path.clear_area_overlaps()) {
+  // the clear zones the adc is already inside are skipped
+  const auto clear_zones_ahead = hdmap::Path::GetOverlapsStartingIn(
+      map_path.clear_area_overlaps(),
+      reference_line_info_->AdcSlBoundary().end_s(),
+      std::numeric_limits<double>::infinity());
+  for (const auto& clear_zone : clear_zones_ahead) {
     if (!BuildClearZoneObstacle(clear_zone)) {
       AERROR << "Failed to build clear zone : " << clear_zone.object_id;
       return false;
@@ -177,7 +177,12 @@ bool Crosswalk::FindCrosswalks(ReferenceLineInfo* const reference_line_info) {
   crosswalk_overlaps_.clear();
   const std::vector<hdmap::PathOverlap>& crosswalk_overlaps =
       reference_line_info->reference_line().map_path().crosswalk_overlaps();
-  for (const hdmap::PathOverlap& crosswalk_overlap : crosswalk_overlaps) {
+  // the crosswalks whose stop line and buffer are passed are skipped anyway
+  const auto crosswalks_ahead = hdmap::Path::GetOverlapsStartingIn(
+      crosswalk_overlaps, reference_line_info->AdcSlBoundary().end_s() -
+                              FLAGS_stop_max_distance_buffer,
+      std::numeric_limits<double>::infinity());
+  for (const hdmap::PathOverlap& crosswalk_overlap : crosswalks_ahead) {
     crosswalk_overlaps_.push_back(&crosswalk_overlap);
   }
   return crosswalk_overlaps_.size() > 0;
@@ -187,7 +192,7 @@ double Crosswalk::GetStopDeceleration(
     ReferenceLineInfo* const reference_line_info,
     const hdmap::PathOverlap* crosswalk_overlap) {
   double adc_speed =
-      common::VehicleStateProvider::instance()->linear_velocity();
+      common::VehicleStateProvider::instance()->snapshot()->linear_velocity;
   if (adc_speed < FLAGS_stop_min_speed) {
     return 0.0;
   }
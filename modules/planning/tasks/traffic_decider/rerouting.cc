@@ -75,8 +75,8 @@ bool Rerouting::ChangeLaneFailRerouting() {
   // 5. If the end of current passage region is further than kPrepareRoutingTime
   // * speed, no rerouting
   double adc_s = reference_line_info_->AdcSlBoundary().end_s();
-  const auto* vehicle_state = common::VehicleStateProvider::instance();
-  double speed = vehicle_state->linear_velocity();
+  double speed =
+      common::VehicleStateProvider::instance()->snapshot()->linear_velocity;
   const double prepare_distance = speed * FLAGS_prepare_rerouting_time;
   if (sl_point.s() > adc_s + prepare_distance) {
     ADEBUG << "No need rerouting now because still can drive for time: "
@@ -86,11 +86,12 @@ bool Rerouting::ChangeLaneFailRerouting() {
   // 6. Check if we have done rerouting before
   const std::string last_rerouting_time_key =
       "kLastReroutingTime_" + segments.Id();
-  double* last_routing_time =
-      common::util::Dropbox<double>::Open()->Get(last_rerouting_time_key);
+  double last_routing_time = 0.0;
+  const bool has_rerouted = common::util::Dropbox<double>::Open()->Get(
+      last_rerouting_time_key, &last_routing_time);
   double current_time = Clock::NowInSeconds();
-  if (last_routing_time != nullptr &&
-      current_time - *last_routing_time < FLAGS_rerouting_cooldown_time) {
+  if (has_rerouted &&
+      current_time - last_routing_time < FLAGS_rerouting_cooldown_time) {
     ADEBUG << "Skip rerouting and wait for previous rerouting result";
     return true;
   }
@@ -80,12 +80,12 @@ bool SignalLight::FindValidSignalLight(
     return false;
   }
   signal_lights_from_path_.clear();
-  for (const hdmap::PathOverlap& signal_light : signal_lights) {
-    if (signal_light.start_s + FLAGS_stop_max_distance_buffer >
-        reference_line_info->AdcSlBoundary().end_s()) {
-      signal_lights_from_path_.push_back(signal_light);
-    }
-  }
+  const auto signal_lights_ahead = hdmap::Path::GetOverlapsStartingIn(
+      signal_lights, reference_line_info->AdcSlBoundary().end_s() -
+                         FLAGS_stop_max_distance_buffer,
+      std::numeric_limits<double>::infinity());
+  signal_lights_from_path_.assign(signal_lights_ahead.begin(),
+                                  signal_lights_ahead.end());
   return signal_lights_from_path_.size() > 0;
 }
 
@@ -98,7 +98,7 @@ void SignalLight::MakeDecisions(Frame* frame,
   signal_light_debug->set_adc_front_s(
       reference_line_info->AdcSlBoundary().end_s());
   signal_light_debug->set_adc_speed(
-      common::VehicleStateProvider::instance()->linear_velocity());
+      common::VehicleStateProvider::instance()->snapshot()->linear_velocity);
 
   bool has_stop = false;
   for (auto& signal_light : signal_lights_from_path_) {
@@ -184,7 +184,7 @@ double SignalLight::GetStopDeceleration(
     ReferenceLineInfo* const reference_line_info,
     const hdmap::PathOverlap* signal_light) {
   double adc_speed =
-      common::VehicleStateProvider::instance()->linear_velocity();
+      common::VehicleStateProvider::instance()->snapshot()->linear_velocity;
   if (adc_speed < FLAGS_stop_min_speed) {
     return 0.0;
   }
@@ -139,20 +139,17 @@ bool StopSign::FindNextStopSign(
   const std::vector<PathOverlap>& stop_sign_overlaps =
       reference_line_info->reference_line().map_path().stop_sign_overlaps();
 
+  // the overlaps are sorted by start s, so the next one is the first one
+  // not passed yet
   double adc_front_edge_s = reference_line_info->AdcSlBoundary().end_s();
-  double min_start_s = std::numeric_limits<double>::max();
-  for (const PathOverlap& stop_sign_overlap : stop_sign_overlaps) {
-    if (stop_sign_overlap.start_s + FLAGS_stop_max_distance_buffer
-        > adc_front_edge_s &&
-        stop_sign_overlap.start_s < min_start_s ) {
-      min_start_s = stop_sign_overlap.start_s;
-      next_stop_sign_overlap_ = const_cast<PathOverlap*>(&stop_sign_overlap);
-    }
-  }
-
-  if (next_stop_sign_overlap_ == nullptr) {
+  const auto stop_signs_ahead = hdmap::Path::GetOverlapsStartingIn(
+      stop_sign_overlaps, adc_front_edge_s - FLAGS_stop_max_distance_buffer,
+      std::numeric_limits<double>::infinity());
+  if (stop_signs_ahead.empty()) {
     return false;
   }
+  next_stop_sign_overlap_ =
+      const_cast<PathOverlap*>(&(*stop_signs_ahead.begin()));
 
   auto next_stop_sign_ptr = HDMapUtil::BaseMap().GetStopSignById(
       hdmap::MakeMapId(next_stop_sign_overlap_->object_id));
@@ -192,10 +189,8 @@ int StopSign::ProcessStopStatus(
   std::string stop_sign_id = stop_sign_info.id().id();
   std::string db_key_stop_status =
       db_key_stop_sign_stop_status_prefix_ + stop_sign_id;
-  StopSignStopStatus* status = Dropbox<StopSignStopStatus>::Open()->Get(
-      db_key_stop_status);
-  stop_status_ = (status == nullptr) ?
-      StopSignStopStatus::TO_STOP : *status;
+  stop_status_ = StopSignStopStatus::TO_STOP;
+  Dropbox<StopSignStopStatus>::Open()->Get(db_key_stop_status, &stop_status_);
   ADEBUG << "get stop_status_: "
       << static_cast<typename std::underlying_type<StopSignStopStatus>::type>(
           stop_status_);
@@ -203,10 +198,8 @@ int StopSign::ProcessStopStatus(
   // get stop start time from dropbox
   std::string db_key_stop_starttime =
       db_key_stop_sign_stop_starttime_prefix_ + stop_sign_id;
-  double* start_time = Dropbox<double>::Open()->Get(
-      db_key_stop_starttime);
-  double stop_start_time =  (start_time == nullptr) ?
-      Clock::NowInSeconds() + 1 : *start_time;
+  double stop_start_time = Clock::NowInSeconds() + 1;
+  Dropbox<double>::Open()->Get(db_key_stop_starttime, &stop_start_time);
   double wait_time = Clock::NowInSeconds() - stop_start_time;
   ADEBUG << "stop_start_time: " << stop_start_time
       << "; wait_time: " << wait_time;
@@ -294,13 +287,9 @@ int StopSign::GetWatchVehicles(
       // get watch vehicles for associate_lanes from dropbox
       std::string db_key_watch_vehicle =
           db_key_stop_sign_watch_vehicle_prefix_ + associate_lane_id;
-      std::vector<std::string> *value =
-          Dropbox<std::vector<std::string>>::Open()->Get(
-              db_key_watch_vehicle);
       std::vector<std::string> watch_vehicle_ids;
-      if (value != nullptr) {
-        watch_vehicle_ids = *value;
-      }
+      Dropbox<std::vector<std::string>>::Open()->Get(db_key_watch_vehicle,
+                                                     &watch_vehicle_ids);
 
       ADEBUG << "watch_vehicle: lane_id[" << associate_lane_id << "] vehicle["
           << accumulate(watch_vehicle_ids.begin(),
@@ -496,7 +485,7 @@ double StopSign::GetStopDeceleration(
     ReferenceLineInfo* const reference_line_info,
     const PathOverlap* stop_sign_overlap) {
   double adc_speed =
-      common::VehicleStateProvider::instance()->linear_velocity();
+      common::VehicleStateProvider::instance()->snapshot()->linear_velocity;
   if (adc_speed < FLAGS_stop_min_speed) {
     return 0.0;
   }
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/prediction/common/feature_chunk_writer.h"
+
+#include <fstream>
+
+#include "google/protobuf/io/gzip_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl.h"
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace prediction {
+
+using google::protobuf::io::GzipInputStream;
+using google::protobuf::io::GzipOutputStream;
+using google::protobuf::io::IstreamInputStream;
+using google::protobuf::io::OstreamOutputStream;
+
+FeatureChunkWriter::FeatureChunkWriter(const std::string& path_prefix,
+                                       const int chunk_size)
+    : path_prefix_(path_prefix), chunk_size_(chunk_size) {
+  CHECK_GT(chunk_size, 0);
+}
+
+void FeatureChunkWriter::AppendLaneSequence(
+    const LaneSequence& lane_sequence,
+    const std::vector<double>& feature_values) {
+  if (!chunk_.has_feature_dim()) {
+    chunk_.set_feature_dim(static_cast<int>(feature_values.size()));
+  }
+  CHECK_EQ(chunk_.feature_dim(), static_cast<int>(feature_values.size()));
+  chunk_.add_lane_sequence_id(lane_sequence.lane_sequence_id());
+  chunk_.add_lane_sequence_label(lane_sequence.label());
+  for (const double value : feature_values) {
+    chunk_.add_lane_sequence_feature(static_cast<float>(value));
+  }
+  ++num_pending_lane_sequences_;
+}
+
+bool FeatureChunkWriter::AppendFeature(const Feature& feature) {
+  chunk_.add_id(feature.id());
+  chunk_.add_timestamp(feature.timestamp());
+  chunk_.add_position_x(feature.position().x());
+  chunk_.add_position_y(feature.position().y());
+  chunk_.add_velocity_x(feature.velocity().x());
+  chunk_.add_velocity_y(feature.velocity().y());
+  chunk_.add_velocity_heading(feature.velocity_heading());
+  chunk_.add_speed(feature.speed());
+  chunk_.add_acc(feature.acc());
+  chunk_.add_theta(feature.theta());
+  chunk_.add_length(feature.length());
+  chunk_.add_width(feature.width());
+  chunk_.add_is_still(feature.is_still());
+  chunk_.add_num_lane_sequences(num_pending_lane_sequences_);
+  num_pending_lane_sequences_ = 0;
+  if (chunk_.id_size() < chunk_size_) {
+    return true;
+  }
+  return WriteChunk();
+}
+
+bool FeatureChunkWriter::Close() {
+  if (chunk_.id_size() == 0) {
+    return true;
+  }
+  return WriteChunk();
+}
+
+bool FeatureChunkWriter::WriteChunk() {
+  const std::string file =
+      path_prefix_ + "." + std::to_string(num_chunks_) + ".bin.gz";
+  std::ofstream stream(file, std::ios::binary);
+  if (!stream) {
+    AERROR << "Failed to open " << file;
+    return false;
+  }
+  {
+    OstreamOutputStream raw_output(&stream);
+    GzipOutputStream gzip_output(&raw_output);
+    if (!chunk_.SerializeToZeroCopyStream(&gzip_output) ||
+        !gzip_output.Close()) {
+      AERROR << "Failed to write " << file;
+      return false;
+    }
+  }
+  stream.close();
+  if (!stream) {
+    AERROR << "Failed to write " << file;
+    return false;
+  }
+  ++num_chunks_;
+  // Clear() keeps the memory of the columns for the next chunk.
+  const bool has_feature_dim = chunk_.has_feature_dim();
+  const int feature_dim = chunk_.feature_dim();
+  chunk_.Clear();
+  if (has_feature_dim) {
+    chunk_.set_feature_dim(feature_dim);
+  }
+  return true;
+}
+
+bool FeatureChunkWriter::ReadChunk(const std::string& file,
+                                   FeatureChunk* chunk) {
+  CHECK_NOTNULL(chunk);
+  std::ifstream stream(file, std::ios::binary);
+  if (!stream) {
+    AERROR << "Failed to open " << file;
+    return false;
+  }
+  IstreamInputStream raw_input(&stream);
+  GzipInputStream gzip_input(&raw_input);
+  if (!chunk->ParseFromZeroCopyStream(&gzip_input)) {
+    AERROR << "Failed to parse " << file;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Write the features of obstacles in compressed columnar chunks
+ */
+
+#ifndef MODULES_PREDICTION_COMMON_FEATURE_CHUNK_WRITER_H_
+#define MODULES_PREDICTION_COMMON_FEATURE_CHUNK_WRITER_H_
+
+#include <string>
+#include <vector>
+
+#include "modules/prediction/proto/feature.pb.h"
+#include "modules/prediction/proto/feature_chunk.pb.h"
+#include "modules/prediction/proto/lane_graph.pb.h"
+
+namespace apollo {
+namespace prediction {
+
+/**
+ * @class FeatureChunkWriter
+ * @brief Accumulate the features of obstacles by column in a FeatureChunk,
+ *        and write every full chunk to a gzip compressed file
+ *        <path_prefix>.<chunk index>.bin.gz.
+ *
+ * \par
+ * A writer is not thread safe; use one writer per recording.
+ */
+class FeatureChunkWriter {
+ public:
+  /**
+   * @brief Constructor
+   * @param path_prefix The prefix of the paths of the chunk files
+   * @param chunk_size The number of obstacle features of a full chunk
+   */
+  FeatureChunkWriter(const std::string& path_prefix, const int chunk_size);
+
+  /**
+   * @brief Append a lane sequence of the next obstacle feature, with its
+   *        evaluator feature values. All the lane sequences take as many
+   *        values as the first one.
+   * @param lane_sequence The lane sequence
+   * @param feature_values The evaluator feature values of the lane sequence
+   */
+  void AppendLaneSequence(const LaneSequence& lane_sequence,
+                          const std::vector<double>& feature_values);
+
+  /**
+   * @brief Append an obstacle feature, with the lane sequences appended
+   *        since the previous one, and write the chunk once it is full.
+   * @param feature The obstacle feature
+   * @return False if writing the chunk failed
+   */
+  bool AppendFeature(const Feature& feature);
+
+  /**
+   * @brief Write the last chunk if it is not empty. The destructor does
+   *        not write anything.
+   * @return False if writing the chunk failed
+   */
+  bool Close();
+
+  /**
+   * @brief Get the number of chunks written
+   */
+  int num_chunks() const { return num_chunks_; }
+
+  /**
+   * @brief Read a chunk file
+   * @param file The path of the chunk file
+   * @param chunk The chunk
+   * @return False if the file cannot be read or parsed
+   */
+  static bool ReadChunk(const std::string& file, FeatureChunk* chunk);
+
+ private:
+  bool WriteChunk();
+
+  std::string path_prefix_;
+  int chunk_size_ = 0;
+  int num_chunks_ = 0;
+  int num_pending_lane_sequences_ = 0;
+  FeatureChunk chunk_;
+};
+
+}  // namespace prediction
+}  // namespace apollo
+
+#endif  // MODULES_PREDICTION_COMMON_FEATURE_CHUNK_WRITER_H_
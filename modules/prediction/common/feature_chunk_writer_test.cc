@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/prediction/common/feature_chunk_writer.h"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace prediction {
+
+TEST(FeatureChunkWriterTest, WriteAndRead) {
+  const char* tmp_dir = std::getenv("TEST_TMPDIR");
+  const std::string prefix =
+      std::string(tmp_dir == nullptr ? "/tmp" : tmp_dir) + "/features";
+  FeatureChunkWriter writer(prefix, 2);
+
+  // Three obstacle features, of which the second has two lane sequences.
+  for (int i = 0; i < 3; ++i) {
+    if (i == 1) {
+      for (int j = 0; j < 2; ++j) {
+        LaneSequence lane_sequence;
+        lane_sequence.set_lane_sequence_id(j);
+        lane_sequence.set_label(1 - j);
+        writer.AppendLaneSequence(lane_sequence, {0.5 * j, 1.0, 2.0});
+      }
+    }
+    Feature feature;
+    feature.set_id(i);
+    feature.set_timestamp(10.0 + i);
+    feature.mutable_position()->set_x(i);
+    feature.mutable_position()->set_y(-i);
+    feature.set_speed(2.0 * i);
+    EXPECT_TRUE(writer.AppendFeature(feature));
+  }
+  EXPECT_EQ(1, writer.num_chunks());
+  EXPECT_TRUE(writer.Close());
+  EXPECT_EQ(2, writer.num_chunks());
+
+  FeatureChunk chunk;
+  ASSERT_TRUE(FeatureChunkWriter::ReadChunk(prefix + ".0.bin.gz", &chunk));
+  ASSERT_EQ(2, chunk.id_size());
+  EXPECT_EQ(1, chunk.id(1));
+  EXPECT_DOUBLE_EQ(11.0, chunk.timestamp(1));
+  EXPECT_DOUBLE_EQ(-1.0, chunk.position_y(1));
+  EXPECT_DOUBLE_EQ(2.0, chunk.speed(1));
+  EXPECT_EQ(0, chunk.num_lane_sequences(0));
+  EXPECT_EQ(2, chunk.num_lane_sequences(1));
+  EXPECT_EQ(3, chunk.feature_dim());
+  ASSERT_EQ(2, chunk.lane_sequence_id_size());
+  EXPECT_EQ(1, chunk.lane_sequence_id(1));
+  EXPECT_EQ(0, chunk.lane_sequence_label(1));
+  ASSERT_EQ(6, chunk.lane_sequence_feature_size());
+  EXPECT_FLOAT_EQ(0.5, chunk.lane_sequence_feature(3));
+
+  ASSERT_TRUE(FeatureChunkWriter::ReadChunk(prefix + ".1.bin.gz", &chunk));
+  ASSERT_EQ(1, chunk.id_size());
+  EXPECT_EQ(2, chunk.id(0));
+  EXPECT_EQ(0, chunk.lane_sequence_id_size());
+
+  EXPECT_FALSE(FeatureChunkWriter::ReadChunk(prefix + ".2.bin.gz", &chunk));
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/lane_graph_cache.h"
+
+#include <cmath>
+
+#include "modules/common/util/string_util.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_map.h"
+
+namespace apollo {
+namespace prediction {
+
+using apollo::hdmap::LaneInfo;
+
+LaneGraphCache::LaneGraphCache() : cache_(FLAGS_lane_graph_cache_capacity) {}
+
+std::shared_ptr<const LaneGraphCache::LaneSequences>
+LaneGraphCache::GetLaneSequences(std::shared_ptr<const LaneInfo> lane_info_ptr,
+                                 const double distance) {
+  CHECK_NOTNULL(lane_info_ptr);
+  const double resolution = FLAGS_lane_graph_cache_resolution;
+  CHECK_GT(resolution, 0.0);
+  const double bucket = std::floor(distance / resolution);
+  const std::string key =
+      common::util::StrCat(lane_info_ptr->id().id(), "/", bucket);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_ptr<const LaneSequences>* lane_sequences = cache_.Get(key);
+    if (lane_sequences != nullptr) {
+      return *lane_sequences;
+    }
+  }
+
+  // Searched out of the lock. The sequences go one bucket further than the
+  // bucket of the distance, so that they cover all the distances of the
+  // bucket whatever the rounding of the lengths.
+  const double search_distance = (bucket + 2.0) * resolution;
+  std::shared_ptr<LaneSequences> lane_sequences(new LaneSequences());
+  std::vector<Lane> lanes;
+  SearchLaneSequences(lane_info_ptr, 0.0, search_distance, &lanes,
+                      lane_sequences.get());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.Put(key, lane_sequences);
+  return lane_sequences;
+}
+
+void LaneGraphCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.Clear();
+}
+
+void LaneGraphCache::SearchLaneSequences(
+    std::shared_ptr<const LaneInfo> lane_info_ptr,
+    const double accumulated_length, const double distance,
+    std::vector<Lane>* lanes, LaneSequences* lane_sequences) const {
+  PredictionMap* map = PredictionMap::instance();
+  Lane lane;
+  lane.lane_info = lane_info_ptr;
+  lane.turn_type = map->LaneTurnType(lane_info_ptr->id().id());
+  lanes->push_back(std::move(lane));
+
+  const double length = accumulated_length + lane_info_ptr->total_length();
+  const std::size_t num_lane_sequences = lane_sequences->size();
+  if (length < distance) {
+    for (const auto& successor_lane_id : lane_info_ptr->lane().successor_id()) {
+      auto successor_lane = map->LaneById(successor_lane_id.id());
+      if (successor_lane == nullptr) {
+        AERROR << "Invalid lane [" << successor_lane_id.id() << "].";
+        continue;
+      }
+      SearchLaneSequences(successor_lane, length, distance, lanes,
+                          lane_sequences);
+    }
+  }
+  // The lane ends a sequence when the search stops on it. The sequence is
+  // kept when its successors are invalid too, for the searches of the
+  // shorter distances that would have stopped on it.
+  if (lane_sequences->size() == num_lane_sequences) {
+    lane_sequences->push_back(*lanes);
+  }
+  lanes->pop_back();
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief A cache of the lane sequences searched from the lanes of the map
+ */
+
+#ifndef MODULES_PREDICTION_COMMON_LANE_GRAPH_CACHE_H_
+#define MODULES_PREDICTION_COMMON_LANE_GRAPH_CACHE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "modules/common/macro.h"
+#include "modules/common/util/lru_cache.h"
+#include "modules/map/hdmap/hdmap_common.h"
+
+/**
+ * @namespace apollo::prediction
+ * @brief apollo::prediction
+ */
+namespace apollo {
+namespace prediction {
+
+/**
+ * @class LaneGraphCache
+ * @brief Caches the search of the lane sequences starting on a lane.
+ *
+ * \par
+ * The lanes of the sequences found from a lane, for a length from a start
+ * s, only depend on the lane and on the distance start s + length from the
+ * start of the lane. A search is cached for a range of such distances, and
+ * holds the sequences of the longest of them: every sequence of a shorter
+ * distance is a prefix of one of them. The searches are shared and
+ * immutable, so the obstacles of all the frames reuse them concurrently.
+ */
+class LaneGraphCache {
+ public:
+  /**
+   * @brief A lane of a cached sequence
+   */
+  struct Lane {
+    std::shared_ptr<const hdmap::LaneInfo> lane_info;
+    int turn_type = 0;
+  };
+
+  /**
+   * @brief The sequences of a search, in depth first order. A sequence ends
+   *        on the lane reaching the distance, or on a lane without a
+   *        successor in the map.
+   */
+  typedef std::vector<std::vector<Lane>> LaneSequences;
+
+  /**
+   * @brief Get the lane sequences from a lane, searched for at least a
+   *        distance, from the cache or from the map
+   * @param The starting lane
+   * @param The distance from the start of the lane
+   * @return The shared lane sequences
+   */
+  std::shared_ptr<const LaneSequences> GetLaneSequences(
+      std::shared_ptr<const hdmap::LaneInfo> lane_info_ptr,
+      const double distance);
+
+  /**
+   * @brief Drop all the cached searches, e.g. when the map changes
+   */
+  void Clear();
+
+ private:
+  void SearchLaneSequences(std::shared_ptr<const hdmap::LaneInfo> lane_info_ptr,
+                           const double accumulated_length,
+                           const double distance, std::vector<Lane>* lanes,
+                           LaneSequences* lane_sequences) const;
+
+  std::mutex mutex_;
+  common::util::LRUCache<std::string, std::shared_ptr<const LaneSequences>>
+      cache_;
+
+  DECLARE_SINGLETON(LaneGraphCache);
+};
+
+}  // namespace prediction
+}  // namespace apollo
+
+#endif  // MODULES_PREDICTION_COMMON_LANE_GRAPH_CACHE_H_
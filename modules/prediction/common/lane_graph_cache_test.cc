@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/lane_graph_cache.h"
+
+#include "gtest/gtest.h"
+
+#include "modules/prediction/common/kml_map_based_test.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_map.h"
+
+namespace apollo {
+namespace prediction {
+
+class LaneGraphCacheTest : public KMLMapBasedTest {
+ public:
+  virtual void SetUp() { LaneGraphCache::instance()->Clear(); }
+};
+
+TEST_F(LaneGraphCacheTest, General) {
+  auto lane = PredictionMap::instance()->LaneById("l20");
+  EXPECT_TRUE(lane != nullptr);
+  LaneGraphCache* cache = LaneGraphCache::instance();
+
+  auto lane_sequences = cache->GetLaneSequences(lane, 400.0);
+  ASSERT_TRUE(lane_sequences != nullptr);
+  EXPECT_EQ(2, lane_sequences->size());
+  for (const auto& lanes : *lane_sequences) {
+    ASSERT_FALSE(lanes.empty());
+    EXPECT_EQ("l20", lanes.front().lane_info->id().id());
+    double length = 0.0;
+    for (const auto& lane : lanes) {
+      length += lane.lane_info->total_length();
+    }
+    EXPECT_TRUE(length >= 400.0 ||
+                lanes.back().lane_info->lane().successor_id_size() == 0);
+  }
+
+  // A distance of the same bucket shares the search, another one does not.
+  EXPECT_EQ(lane_sequences,
+            cache->GetLaneSequences(
+                lane, 400.0 + 0.5 * FLAGS_lane_graph_cache_resolution));
+  EXPECT_NE(lane_sequences,
+            cache->GetLaneSequences(
+                lane, 400.0 + 1.5 * FLAGS_lane_graph_cache_resolution));
+
+  cache->Clear();
+  EXPECT_NE(lane_sequences, cache->GetLaneSequences(lane, 400.0));
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -32,6 +32,9 @@ DEFINE_double(
     prediction_test_duration, -1.0,
     "The runtime duration in test mode (in seconds). Negative value will not "
     "restrict the runtime duration.");
+DEFINE_bool(enable_async_prediction, false,
+            "Run prediction in a worker thread on the latest perception "
+            "obstacles, instead of in the callback of every message");
 
 DEFINE_double(prediction_duration, 5.0, "Prediction duration (in seconds)");
 DEFINE_double(prediction_period, 0.1, "Prediction period (in seconds");
@@ -46,6 +49,14 @@ DEFINE_double(replay_timestamp_gap, 10.0,
 // Map
 DEFINE_double(lane_search_radius, 3.0, "Search radius for a candidate lane");
 DEFINE_double(junction_search_radius, 1.0, "Search radius for a junction");
+DEFINE_bool(enable_lane_graph_cache, true,
+            "Share the lane sequences searched from a lane between obstacles "
+            "and frames");
+DEFINE_int32(lane_graph_cache_capacity, 1000,
+             "Max number of lane sequence searches kept in the cache");
+DEFINE_double(lane_graph_cache_resolution, 10.0,
+              "Resolution (in meters) of the search distance of the cached "
+              "lane sequence searches");
 
 // Obstacle features
 DEFINE_bool(enable_kf_tracking, false, "Use measurements with KF tracking");
@@ -68,6 +79,8 @@ DEFINE_double(still_pedestrian_speed_threshold, 0.5,
 DEFINE_double(still_obstacle_position_std, 1.0,
               "Position standard deviation for still obstacles");
 DEFINE_double(max_history_time, 7.0, "Obstacles' maximal historical time.");
+DEFINE_int32(max_obstacle_history_size, 100,
+             "Max # historical frames kept for an obstacle");
 DEFINE_double(target_lane_gap, 2.0, "gap between two lane points.");
 DEFINE_int32(max_num_current_lane, 1, "Max number to search current lanes");
 DEFINE_int32(max_num_nearby_lane, 2, "Max number to search nearby lanes");
@@ -79,6 +92,9 @@ DEFINE_double(pedestrian_max_speed, 10.0, "speed upper bound for pedestrian");
 DEFINE_double(pedestrian_max_acc, 2.0, "maximum pedestrian acceleration");
 DEFINE_double(prediction_pedestrian_total_time, 10.0,
               "Total prediction time for pedestrians");
+DEFINE_int32(max_num_pedestrian_regions, 0,
+             "Max number of regions sampled along a pedestrian trajectory, "
+             "0 for one region per prediction period");
 DEFINE_double(still_speed, 0.01, "speed considered to be still");
 DEFINE_string(evaluator_vehicle_mlp_file,
               "modules/prediction/data/mlp_vehicle_model.bin",
@@ -86,6 +102,22 @@ DEFINE_string(evaluator_vehicle_mlp_file,
 DEFINE_string(evaluator_vehicle_rnn_file,
               "modules/prediction/data/rnn_vehicle_model.bin",
               "rnn model file for vehicle evaluator");
+DEFINE_bool(enable_batched_mlp_evaluator, true,
+            "evaluate the lane sequences of all the obstacles of a frame "
+            "in one batch with the mlp vehicle evaluator");
+DEFINE_int32(prediction_thread_pool_size, 4,
+             "number of threads updating and evaluating the obstacles of a "
+             "frame in parallel; 0 processes them in the calling thread");
+DEFINE_bool(enable_obstacles_prioritization, false,
+            "evaluate and predict in full only the obstacles closest to "
+            "the ADC trajectory, and predict the others by free move");
+DEFINE_int32(max_num_prioritized_obstacles, 30,
+             "maximal number of obstacles of a frame predicted in full "
+             "when the obstacles are prioritized");
+DEFINE_double(prediction_time_budget, 0.05,
+              "time in seconds to evaluate and predict the obstacles of a "
+              "frame, after which the remaining prioritized obstacles are "
+              "predicted by free move");
 DEFINE_int32(max_num_obstacles, 100,
              "maximal number of obstacles stored in obstacles container.");
 DEFINE_double(valid_position_diff_threshold, 0.5,
@@ -26,6 +26,7 @@ DECLARE_string(prediction_adapter_config_filename);
 
 DECLARE_bool(prediction_test_mode);
 DECLARE_double(prediction_test_duration);
+DECLARE_bool(enable_async_prediction);
 
 DECLARE_double(prediction_duration);
 DECLARE_double(prediction_period);
@@ -38,6 +39,9 @@ DECLARE_double(replay_timestamp_gap);
 // Map
 DECLARE_double(lane_search_radius);
 DECLARE_double(junction_search_radius);
+DECLARE_bool(enable_lane_graph_cache);
+DECLARE_int32(lane_graph_cache_capacity);
+DECLARE_double(lane_graph_cache_resolution);
 
 // Obstacle features
 DECLARE_bool(enable_kf_tracking);
@@ -54,6 +58,7 @@ DECLARE_double(still_obstacle_speed_threshold);
 DECLARE_double(still_pedestrian_speed_threshold);
 DECLARE_double(still_obstacle_position_std);
 DECLARE_double(max_history_time);
+DECLARE_int32(max_obstacle_history_size);
 DECLARE_double(target_lane_gap);
 DECLARE_int32(max_num_current_lane);
 DECLARE_int32(max_num_nearby_lane);
@@ -63,9 +68,15 @@ DECLARE_double(coeff_mul_sigma);
 DECLARE_double(pedestrian_max_speed);
 DECLARE_double(pedestrian_max_acc);
 DECLARE_double(prediction_pedestrian_total_time);
+DECLARE_int32(max_num_pedestrian_regions);
 DECLARE_double(still_speed);
 DECLARE_string(evaluator_vehicle_mlp_file);
 DECLARE_string(evaluator_vehicle_rnn_file);
+DECLARE_bool(enable_batched_mlp_evaluator);
+DECLARE_int32(prediction_thread_pool_size);
+DECLARE_bool(enable_obstacles_prioritization);
+DECLARE_int32(max_num_prioritized_obstacles);
+DECLARE_double(prediction_time_budget);
 DECLARE_int32(max_num_obstacles);
 DECLARE_double(valid_position_diff_threshold);
 DECLARE_double(valid_position_diff_rate_threshold);
@@ -18,14 +18,22 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <deque>
 #include <iomanip>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "boost/thread/locks.hpp"
+#include "boost/thread/shared_mutex.hpp"
+
 #include "modules/common/configs/config_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/math/fast_trig.h"
 #include "modules/common/math/linear_interpolation.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/map/hdmap/hdmap_util.h"
@@ -35,12 +43,206 @@
 namespace apollo {
 namespace prediction {
 
+using apollo::hdmap::HDMap;
 using apollo::hdmap::HDMapUtil;
 using apollo::hdmap::Id;
 using apollo::hdmap::JunctionInfo;
 using apollo::hdmap::LaneInfo;
 using apollo::hdmap::MapPathPoint;
 
+namespace {
+
+// The relations of a lane to one of its adjacent lanes, as bits.
+enum LaneRelation : uint8_t {
+  LEFT_NEIGHBOR = 1,
+  RIGHT_NEIGHBOR = 2,
+  SUCCESSOR = 4,
+  PREDECESSOR = 8,
+};
+
+// The lanes of the base map looked up so far, indexed in lookup order. The
+// adjacent lanes of a lane are resolved to indices on its first relation
+// check, so the checks compare integers instead of lane IDs.
+class LaneTable {
+ public:
+  int Index(const std::string& id) {
+    const HDMap* map = HDMapUtil::BaseMapPtr();
+    if (map == nullptr) {
+      return -1;
+    }
+    {
+      boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
+      if (map_ == map) {
+        const auto iter = index_by_id_.find(id);
+        if (iter != index_by_id_.end()) {
+          return iter->second;
+        }
+      }
+    }
+    auto lane = map->GetLaneById(hdmap::MakeMapId(id));
+    if (lane == nullptr) {
+      return -1;
+    }
+    boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
+    return Insert(map, std::move(lane));
+  }
+
+  int Index(const std::shared_ptr<const LaneInfo>& lane) {
+    const HDMap* map = HDMapUtil::BaseMapPtr();
+    {
+      boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
+      if (map_ == map) {
+        const auto iter = index_by_lane_.find(lane.get());
+        if (iter != index_by_lane_.end()) {
+          return iter->second;
+        }
+      }
+    }
+    const int index = Index(lane->id().id());
+    if (index >= 0) {
+      boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
+      if (map_ == map) {
+        index_by_lane_.emplace(lane.get(), index);
+      }
+    }
+    return index;
+  }
+
+  std::shared_ptr<const LaneInfo> Lane(const int index) {
+    boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
+    if (index < 0 || index >= static_cast<int>(entries_.size())) {
+      return nullptr;
+    }
+    return entries_[index].lane;
+  }
+
+  // Whether the lane at other_index has the relation to the lane at index.
+  bool HasRelation(const int other_index, const int index,
+                   const LaneRelation relation) {
+    if (index < 0 || other_index < 0) {
+      return false;
+    }
+    std::shared_ptr<const LaneInfo> lane;
+    {
+      boost::shared_lock<boost::shared_mutex> reader_lock(mutex_);
+      if (index >= static_cast<int>(entries_.size())) {
+        return false;
+      }
+      const Entry& entry = entries_[index];
+      if (entry.resolved) {
+        return HasAdjacentRelation(entry.adjacent_lanes, other_index, relation);
+      }
+      lane = entry.lane;
+    }
+    // The adjacent lanes are looked up without the lock, as they may be
+    // inserted into the table.
+    std::vector<std::pair<int, uint8_t>> adjacent_lanes;
+    AddAdjacentLanes(lane->lane().left_neighbor_forward_lane_id(),
+                     LEFT_NEIGHBOR, &adjacent_lanes);
+    AddAdjacentLanes(lane->lane().right_neighbor_forward_lane_id(),
+                     RIGHT_NEIGHBOR, &adjacent_lanes);
+    AddAdjacentLanes(lane->lane().successor_id(), SUCCESSOR, &adjacent_lanes);
+    AddAdjacentLanes(lane->lane().predecessor_id(), PREDECESSOR,
+                     &adjacent_lanes);
+    const bool has_relation =
+        HasAdjacentRelation(adjacent_lanes, other_index, relation);
+
+    boost::unique_lock<boost::shared_mutex> writer_lock(mutex_);
+    // The table is renewed if the map has been reloaded meanwhile.
+    if (index < static_cast<int>(entries_.size()) &&
+        entries_[index].lane == lane) {
+      entries_[index].adjacent_lanes = std::move(adjacent_lanes);
+      entries_[index].resolved = true;
+    }
+    return has_relation;
+  }
+
+ private:
+  struct Entry {
+    std::shared_ptr<const LaneInfo> lane;
+    bool resolved = false;
+    // The indices of the adjacent lanes with their relation bits.
+    std::vector<std::pair<int, uint8_t>> adjacent_lanes;
+  };
+
+  static bool HasAdjacentRelation(
+      const std::vector<std::pair<int, uint8_t>>& adjacent_lanes,
+      const int other_index, const LaneRelation relation) {
+    for (const auto& adjacent : adjacent_lanes) {
+      if (adjacent.first == other_index) {
+        return (adjacent.second & relation) != 0;
+      }
+    }
+    return false;
+  }
+
+  void AddAdjacentLanes(
+      const google::protobuf::RepeatedPtrField<Id>& ids,
+      const LaneRelation relation,
+      std::vector<std::pair<int, uint8_t>>* adjacent_lanes) {
+    for (const auto& id : ids) {
+      const int index = Index(id.id());
+      if (index < 0) {
+        continue;
+      }
+      auto iter = std::find_if(
+          adjacent_lanes->begin(), adjacent_lanes->end(),
+          [index](const std::pair<int, uint8_t>& adjacent) {
+            return adjacent.first == index;
+          });
+      if (iter == adjacent_lanes->end()) {
+        adjacent_lanes->emplace_back(index, relation);
+      } else {
+        iter->second |= relation;
+      }
+    }
+  }
+
+  // Called with the writer lock held.
+  int Insert(const HDMap* map, std::shared_ptr<const LaneInfo> lane) {
+    if (map_ != map) {
+      map_ = map;
+      entries_.clear();
+      index_by_id_.clear();
+      index_by_lane_.clear();
+    }
+    const auto iter = index_by_id_.find(lane->id().id());
+    if (iter != index_by_id_.end()) {
+      return iter->second;
+    }
+    const int index = static_cast<int>(entries_.size());
+    index_by_id_.emplace(lane->id().id(), index);
+    index_by_lane_.emplace(lane.get(), index);
+    entries_.emplace_back();
+    entries_.back().lane = std::move(lane);
+    return index;
+  }
+
+  boost::shared_mutex mutex_;
+  const HDMap* map_ = nullptr;
+  std::deque<Entry> entries_;
+  std::unordered_map<std::string, int> index_by_id_;
+  std::unordered_map<const LaneInfo*, int> index_by_lane_;
+};
+
+LaneTable* GetLaneTable() {
+  static LaneTable lane_table;
+  return &lane_table;
+}
+
+bool IsVirtual(const LaneInfo& lane_info) {
+  const apollo::hdmap::Lane& lane = lane_info.lane();
+  bool left_virtual = lane.has_left_boundary() &&
+                      lane.left_boundary().has_virtual_() &&
+                      lane.left_boundary().virtual_();
+  bool right_virtual = lane.has_right_boundary() &&
+                       lane.right_boundary().has_virtual_() &&
+                       lane.right_boundary().virtual_();
+  return left_virtual && right_virtual;
+}
+
+}  // namespace
+
 PredictionMap::PredictionMap() {}
 
 bool PredictionMap::Ready() { return HDMapUtil::BaseMapPtr() != nullptr; }
@@ -66,7 +268,22 @@ double PredictionMap::LaneTotalWidth(
 
 std::shared_ptr<const LaneInfo> PredictionMap::LaneById(
     const std::string& str_id) {
-  return HDMapUtil::BaseMap().GetLaneById(hdmap::MakeMapId(str_id));
+  return LaneByIndex(LaneIndex(str_id));
+}
+
+int PredictionMap::LaneIndex(const std::string& id) {
+  return GetLaneTable()->Index(id);
+}
+
+int PredictionMap::LaneIndex(std::shared_ptr<const LaneInfo> lane_info) {
+  if (lane_info == nullptr) {
+    return -1;
+  }
+  return GetLaneTable()->Index(lane_info);
+}
+
+std::shared_ptr<const LaneInfo> PredictionMap::LaneByIndex(const int index) {
+  return GetLaneTable()->Lane(index);
 }
 
 bool PredictionMap::GetProjection(const Eigen::Vector2d& position,
@@ -94,19 +311,8 @@ bool PredictionMap::ProjectionFromLane(
 }
 
 bool PredictionMap::IsVirtualLane(const std::string& lane_id) {
-  std::shared_ptr<const LaneInfo> lane_info =
-      HDMapUtil::BaseMap().GetLaneById(hdmap::MakeMapId(lane_id));
-  if (lane_info == nullptr) {
-    return false;
-  }
-  const apollo::hdmap::Lane& lane = lane_info->lane();
-  bool left_virtual = lane.has_left_boundary() &&
-                      lane.left_boundary().has_virtual_() &&
-                      lane.left_boundary().virtual_();
-  bool right_virtual = lane.has_right_boundary() &&
-                       lane.right_boundary().has_virtual_() &&
-                       lane.right_boundary().virtual_();
-  return left_virtual && right_virtual;
+  std::shared_ptr<const LaneInfo> lane_info = LaneById(lane_id);
+  return lane_info != nullptr && IsVirtual(*lane_info);
 }
 
 bool PredictionMap::OnVirtualLane(const Eigen::Vector2d& point,
@@ -117,7 +323,7 @@ bool PredictionMap::OnVirtualLane(const Eigen::Vector2d& point,
   hdmap_point.set_y(point[1]);
   HDMapUtil::BaseMap().GetLanes(hdmap_point, radius, &lanes);
   for (const auto& lane : lanes) {
-    if (IsVirtualLane(lane->id().id())) {
+    if (lane != nullptr && IsVirtual(*lane)) {
       return true;
     }
   }
@@ -214,11 +420,71 @@ bool PredictionMap::SmoothPointFromLane(const std::string& id, const double s,
   std::shared_ptr<const LaneInfo> lane = LaneById(id);
   common::PointENU hdmap_point = lane->GetSmoothPoint(s);
   *heading = PathHeading(lane, hdmap_point);
-  point->operator[](0) = hdmap_point.x() - std::sin(*heading) * l;
-  point->operator[](1) = hdmap_point.y() + std::cos(*heading) * l;
+  double sin_heading = 0.0;
+  double cos_heading = 0.0;
+  common::math::FastSinCos(*heading, &sin_heading, &cos_heading);
+  point->operator[](0) = hdmap_point.x() - sin_heading * l;
+  point->operator[](1) = hdmap_point.y() + cos_heading * l;
   return true;
 }
 
+void PredictionMap::SmoothPointsFromLanes(
+    const std::vector<std::shared_ptr<const LaneInfo>>& lanes,
+    const std::vector<int>& lane_indices, const Eigen::ArrayXd& lane_s,
+    const Eigen::ArrayXd& lane_l, Eigen::ArrayXd* xs, Eigen::ArrayXd* ys,
+    Eigen::ArrayXd* headings) {
+  CHECK_NOTNULL(xs);
+  CHECK_NOTNULL(ys);
+  CHECK_NOTNULL(headings);
+  const int num = static_cast<int>(lane_indices.size());
+  CHECK_EQ(lane_s.size(), num);
+  CHECK_EQ(lane_l.size(), num);
+
+  // The points on the central curves, interpolated as in
+  // LaneInfo::GetSmoothPoint(), and the headings there, slerped as in
+  // LaneInfo::Heading().
+  Eigen::ArrayXd center_xs(num);
+  Eigen::ArrayXd center_ys(num);
+  headings->resize(num);
+  for (int i = 0; i < num; ++i) {
+    const LaneInfo& lane = *lanes[lane_indices[i]];
+    const std::vector<double>& accumulated_s = lane.accumulate_s();
+    const std::vector<common::math::Vec2d>& points = lane.points();
+    const std::vector<double>& lane_headings = lane.headings();
+    const double s = lane_s(i);
+    common::math::Vec2d center;
+    if (s <= 0.0) {
+      center = points.front();
+      (*headings)(i) = lane_headings.front();
+    } else if (s >= lane.total_length()) {
+      center = points.back();
+      (*headings)(i) = lane_headings.back();
+    } else {
+      const std::size_t index =
+          std::lower_bound(accumulated_s.begin(), accumulated_s.end(), s) -
+          accumulated_s.begin();
+      const double delta_s = accumulated_s[index] - s;
+      if (delta_s < common::math::kMathEpsilon) {
+        center = points[index];
+        (*headings)(i) = lane_headings[index];
+      } else {
+        center = points[index] - lane.unit_directions()[index - 1] * delta_s;
+        (*headings)(i) = common::math::slerp(
+            lane_headings[index - 1], accumulated_s[index - 1],
+            lane_headings[index], accumulated_s[index], s);
+      }
+    }
+    center_xs(i) = center.x();
+    center_ys(i) = center.y();
+  }
+  Eigen::ArrayXd sin_headings(num);
+  Eigen::ArrayXd cos_headings(num);
+  common::math::FastSinCos(headings->data(), num, sin_headings.data(),
+                           cos_headings.data());
+  *xs = center_xs - sin_headings * lane_l;
+  *ys = center_ys + cos_headings * lane_l;
+}
+
 void PredictionMap::NearbyLanesByCurrentLanes(
     const Eigen::Vector2d& point, const double heading, const double radius,
     const std::vector<std::shared_ptr<const LaneInfo>>& lanes,
@@ -289,6 +555,12 @@ bool PredictionMap::IsLeftNeighborLane(
   if (left_lane == nullptr) {
     return false;
   }
+  const int left_lane_index = LaneIndex(left_lane);
+  const int curr_lane_index = LaneIndex(curr_lane);
+  if (left_lane_index >= 0 && curr_lane_index >= 0) {
+    return IsLeftNeighborLane(left_lane_index, curr_lane_index);
+  }
+  // The lanes not in the base map are related by their IDs.
   for (const auto& left_lane_id :
        curr_lane->lane().left_neighbor_forward_lane_id()) {
     if (left_lane->id().id() == left_lane_id.id()) {
@@ -298,6 +570,12 @@ bool PredictionMap::IsLeftNeighborLane(
   return false;
 }
 
+bool PredictionMap::IsLeftNeighborLane(const int left_lane_index,
+                                       const int curr_lane_index) {
+  return GetLaneTable()->HasRelation(left_lane_index, curr_lane_index,
+                                     LEFT_NEIGHBOR);
+}
+
 bool PredictionMap::IsLeftNeighborLane(
     std::shared_ptr<const LaneInfo> left_lane,
     const std::vector<std::shared_ptr<const LaneInfo>>& lanes) {
@@ -321,6 +599,12 @@ bool PredictionMap::IsRightNeighborLane(
   if (right_lane == nullptr) {
     return false;
   }
+  const int right_lane_index = LaneIndex(right_lane);
+  const int curr_lane_index = LaneIndex(curr_lane);
+  if (right_lane_index >= 0 && curr_lane_index >= 0) {
+    return IsRightNeighborLane(right_lane_index, curr_lane_index);
+  }
+  // The lanes not in the base map are related by their IDs.
   for (auto& right_lane_id :
        curr_lane->lane().right_neighbor_forward_lane_id()) {
     if (right_lane->id().id() == right_lane_id.id()) {
@@ -330,6 +614,12 @@ bool PredictionMap::IsRightNeighborLane(
   return false;
 }
 
+bool PredictionMap::IsRightNeighborLane(const int right_lane_index,
+                                        const int curr_lane_index) {
+  return GetLaneTable()->HasRelation(right_lane_index, curr_lane_index,
+                                     RIGHT_NEIGHBOR);
+}
+
 bool PredictionMap::IsRightNeighborLane(
     std::shared_ptr<const LaneInfo> right_lane,
     const std::vector<std::shared_ptr<const LaneInfo>>& lanes) {
@@ -352,6 +642,12 @@ bool PredictionMap::IsSuccessorLane(std::shared_ptr<const LaneInfo> succ_lane,
   if (succ_lane == nullptr) {
     return false;
   }
+  const int succ_lane_index = LaneIndex(succ_lane);
+  const int curr_lane_index = LaneIndex(curr_lane);
+  if (succ_lane_index >= 0 && curr_lane_index >= 0) {
+    return IsSuccessorLane(succ_lane_index, curr_lane_index);
+  }
+  // The lanes not in the base map are related by their IDs.
   for (auto& successor_lane_id : curr_lane->lane().successor_id()) {
     if (succ_lane->id().id() == successor_lane_id.id()) {
       return true;
@@ -360,6 +656,12 @@ bool PredictionMap::IsSuccessorLane(std::shared_ptr<const LaneInfo> succ_lane,
   return false;
 }
 
+bool PredictionMap::IsSuccessorLane(const int succ_lane_index,
+                                    const int curr_lane_index) {
+  return GetLaneTable()->HasRelation(succ_lane_index, curr_lane_index,
+                                     SUCCESSOR);
+}
+
 bool PredictionMap::IsSuccessorLane(
     std::shared_ptr<const LaneInfo> succ_lane,
     const std::vector<std::shared_ptr<const LaneInfo>>& lanes) {
@@ -383,6 +685,12 @@ bool PredictionMap::IsPredecessorLane(
   if (pred_lane == nullptr) {
     return false;
   }
+  const int pred_lane_index = LaneIndex(pred_lane);
+  const int curr_lane_index = LaneIndex(curr_lane);
+  if (pred_lane_index >= 0 && curr_lane_index >= 0) {
+    return IsPredecessorLane(pred_lane_index, curr_lane_index);
+  }
+  // The lanes not in the base map are related by their IDs.
   for (auto& predecessor_lane_id : curr_lane->lane().predecessor_id()) {
     if (pred_lane->id().id() == predecessor_lane_id.id()) {
       return true;
@@ -391,6 +699,12 @@ bool PredictionMap::IsPredecessorLane(
   return false;
 }
 
+bool PredictionMap::IsPredecessorLane(const int pred_lane_index,
+                                      const int curr_lane_index) {
+  return GetLaneTable()->HasRelation(pred_lane_index, curr_lane_index,
+                                     PREDECESSOR);
+}
+
 bool PredictionMap::IsPredecessorLane(
     std::shared_ptr<const LaneInfo> pred_lane,
     const std::vector<std::shared_ptr<const LaneInfo>>& lanes) {
@@ -410,7 +724,8 @@ bool PredictionMap::IsIdenticalLane(std::shared_ptr<const LaneInfo> other_lane,
   if (curr_lane == nullptr || other_lane == nullptr) {
     return true;
   }
-  return other_lane->id().id() == curr_lane->id().id();
+  return other_lane == curr_lane ||
+         other_lane->id().id() == curr_lane->id().id();
 }
 
 bool PredictionMap::IsIdenticalLane(
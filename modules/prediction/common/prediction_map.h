@@ -73,6 +73,30 @@ class PredictionMap {
    */
   static std::shared_ptr<const hdmap::LaneInfo> LaneById(const std::string& id);
 
+  /**
+   * @brief Get the index of a lane, a dense integer which identifies the lane
+   *        and relates it to its neighbors much faster than its ID. The lanes
+   *        are indexed as they are looked up, and the indices are renewed
+   *        when the base map is reloaded.
+   * @param id The ID of the lane.
+   * @return The index of the lane, or -1 if the lane is not in the map.
+   */
+  static int LaneIndex(const std::string& id);
+
+  /**
+   * @brief Get the index of a lane, as LaneIndex(id) does.
+   * @param lane_info The lane.
+   * @return The index of the lane, or -1 if the lane is not in the map.
+   */
+  static int LaneIndex(std::shared_ptr<const hdmap::LaneInfo> lane_info);
+
+  /**
+   * @brief Get a shared pointer to a lane by its index.
+   * @param index The index of the lane from LaneIndex().
+   * @return A shared pointer to the lane, nullptr for an unknown index.
+   */
+  static std::shared_ptr<const hdmap::LaneInfo> LaneByIndex(const int index);
+
   /**
    * @brief Get the frenet coordinates (s, l) on a lane by a position.
    * @param position The position to get its frenet coordinates.
@@ -164,6 +188,25 @@ class PredictionMap {
                            const double l, Eigen::Vector2d* point,
                            double* heading);
 
+  /**
+   * @brief Get the smooth points on the lanes of a lane sequence for many
+   *        positions at once, as SmoothPointFromLane does for one position.
+   *        The lanes are looked up once for all the positions, and no
+   *        position is projected back onto its lane.
+   * @param lanes The lanes of the lane sequence.
+   * @param lane_indices The index in lanes of the lane of every position.
+   * @param lane_s The longitudinal coordinates along the lanes.
+   * @param lane_l The lateral coordinates of the positions.
+   * @param xs The x coordinates of the points.
+   * @param ys The y coordinates of the points.
+   * @param headings The lane headings on the points.
+   */
+  static void SmoothPointsFromLanes(
+      const std::vector<std::shared_ptr<const hdmap::LaneInfo>>& lanes,
+      const std::vector<int>& lane_indices, const Eigen::ArrayXd& lane_s,
+      const Eigen::ArrayXd& lane_l, Eigen::ArrayXd* xs, Eigen::ArrayXd* ys,
+      Eigen::ArrayXd* headings);
+
   /**
    * @brief Get nearby lanes by a position and current lanes.
    * @param point The position to search its nearby lanes.
@@ -206,6 +249,16 @@ class PredictionMap {
       std::shared_ptr<const hdmap::LaneInfo> left_lane,
       const std::vector<std::shared_ptr<const hdmap::LaneInfo>>& lanes);
 
+  /**
+   * @brief Check if a lane is a left neighbor of another lane.
+   *        The lanes are given by their indices.
+   * @param left_lane_index The index of the lane to check.
+   * @param curr_lane_index The index of the current lane.
+   * @return If the first lane is a left neighbor of the current lane.
+   */
+  static bool IsLeftNeighborLane(const int left_lane_index,
+                                 const int curr_lane_index);
+
   /**
    * @brief Check if a lane is a right neighbor of another lane.
    * @param right_lane The lane to check if it is a right neighbor.
@@ -226,6 +279,16 @@ class PredictionMap {
       std::shared_ptr<const hdmap::LaneInfo> right_lane,
       const std::vector<std::shared_ptr<const hdmap::LaneInfo>>& lanes);
 
+  /**
+   * @brief Check if a lane is a right neighbor of another lane.
+   *        The lanes are given by their indices.
+   * @param right_lane_index The index of the lane to check.
+   * @param curr_lane_index The index of the current lane.
+   * @return If the first lane is a right neighbor of the current lane.
+   */
+  static bool IsRightNeighborLane(const int right_lane_index,
+                                  const int curr_lane_index);
+
   /**
    * @brief Check if a lane is a successor of another lane.
    * @param succ_lane The lane to check if it is a successor.
@@ -245,6 +308,16 @@ class PredictionMap {
       std::shared_ptr<const hdmap::LaneInfo> succ_lane,
       const std::vector<std::shared_ptr<const hdmap::LaneInfo>>& lanes);
 
+  /**
+   * @brief Check if a lane is a successor of another lane.
+   *        The lanes are given by their indices.
+   * @param succ_lane_index The index of the lane to check.
+   * @param curr_lane_index The index of the current lane.
+   * @return If the first lane is a successor of the current lane.
+   */
+  static bool IsSuccessorLane(const int succ_lane_index,
+                              const int curr_lane_index);
+
   /**
    * @brief Check if a lane is a predecessor of another lane.
    * @param pred_lane The lane to check if it is a predecessor.
@@ -265,6 +338,16 @@ class PredictionMap {
       std::shared_ptr<const hdmap::LaneInfo> pred_lane,
       const std::vector<std::shared_ptr<const hdmap::LaneInfo>>& lanes);
 
+  /**
+   * @brief Check if a lane is a predecessor of another lane.
+   *        The lanes are given by their indices.
+   * @param pred_lane_index The index of the lane to check.
+   * @param curr_lane_index The index of the current lane.
+   * @return If the first lane is a predecessor of the current lane.
+   */
+  static bool IsPredecessorLane(const int pred_lane_index,
+                                const int curr_lane_index);
+
   /**
    * @brief Check if two lanes are identical.
    * @param other_lane The other lane.
@@ -16,6 +16,10 @@
 
 #include "modules/prediction/common/prediction_map.h"
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "modules/prediction/common/kml_map_based_test.h"
@@ -159,6 +163,43 @@ TEST_F(PredictionMapTest, get_smooth_point_from_lane) {
   EXPECT_DOUBLE_EQ(-0.066794953844859783, heading);
 }
 
+TEST_F(PredictionMapTest, get_smooth_points_from_lanes) {
+  const std::vector<std::string> ids = {"l20", "l21"};
+  std::vector<std::shared_ptr<const LaneInfo>> lanes;
+  for (const std::string &id : ids) {
+    lanes.push_back(map_->LaneById(id));
+  }
+
+  // Before, inside and past the end of both lanes.
+  const std::vector<double> s = {-1.0, 0.0, 10.0, 37.5, 1000.0};
+  const int num = static_cast<int>(ids.size() * s.size());
+  std::vector<int> lane_indices(num);
+  Eigen::ArrayXd lane_s(num);
+  Eigen::ArrayXd lane_l(num);
+  for (int i = 0; i < num; ++i) {
+    lane_indices[i] = i % static_cast<int>(ids.size());
+    lane_s(i) = s[i / ids.size()];
+    lane_l(i) = 0.5 * (i % 3) - 0.5;
+  }
+  Eigen::ArrayXd xs;
+  Eigen::ArrayXd ys;
+  Eigen::ArrayXd headings;
+  map_->SmoothPointsFromLanes(lanes, lane_indices, lane_s, lane_l, &xs, &ys,
+                              &headings);
+  ASSERT_EQ(num, xs.size());
+  ASSERT_EQ(num, ys.size());
+  ASSERT_EQ(num, headings.size());
+  for (int i = 0; i < num; ++i) {
+    Eigen::Vector2d point;
+    double heading = M_PI;
+    EXPECT_TRUE(map_->SmoothPointFromLane(ids[lane_indices[i]], lane_s(i),
+                                          lane_l(i), &point, &heading));
+    EXPECT_NEAR(point.x(), xs(i), 1e-6);
+    EXPECT_NEAR(point.y(), ys(i), 1e-6);
+    EXPECT_NEAR(heading, headings(i), 1e-6);
+  }
+}
+
 TEST_F(PredictionMapTest, get_nearby_lanes_by_current_lanes) {
   std::vector<std::shared_ptr<const LaneInfo>> curr_lanes(0);
   curr_lanes.emplace_back(map_->LaneById("l20"));
@@ -229,6 +270,28 @@ TEST_F(PredictionMapTest, neighbor_lane_detection) {
   EXPECT_FALSE(map_->IsIdenticalLane(map_->LaneById("l99"), curr_lanes));
 }
 
+TEST_F(PredictionMapTest, lane_index) {
+  const int index = map_->LaneIndex("l21");
+  EXPECT_GE(index, 0);
+  EXPECT_EQ(index, map_->LaneIndex("l21"));
+  EXPECT_EQ(index, map_->LaneIndex(map_->LaneById("l21")));
+  EXPECT_EQ(map_->LaneById("l21"), map_->LaneByIndex(index));
+  EXPECT_NE(index, map_->LaneIndex("l22"));
+
+  EXPECT_EQ(-1, map_->LaneIndex("l500"));
+  EXPECT_EQ(-1, map_->LaneIndex(std::shared_ptr<const LaneInfo>()));
+  EXPECT_TRUE(map_->LaneByIndex(-1) == nullptr);
+
+  const int curr_index = map_->LaneIndex("l21");
+  EXPECT_TRUE(map_->IsLeftNeighborLane(map_->LaneIndex("l22"), curr_index));
+  EXPECT_FALSE(map_->IsRightNeighborLane(map_->LaneIndex("l22"), curr_index));
+  EXPECT_TRUE(map_->IsRightNeighborLane(map_->LaneIndex("l20"), curr_index));
+  EXPECT_TRUE(map_->IsPredecessorLane(map_->LaneIndex("l18"), curr_index));
+  EXPECT_FALSE(map_->IsSuccessorLane(map_->LaneIndex("l18"), curr_index));
+  EXPECT_TRUE(map_->IsSuccessorLane(map_->LaneIndex("l99"), curr_index));
+  EXPECT_FALSE(map_->IsSuccessorLane(-1, curr_index));
+}
+
 TEST_F(PredictionMapTest, lane_turn_type) {
   // Valid lane
   EXPECT_EQ(1, map_->LaneTurnType("l20"));
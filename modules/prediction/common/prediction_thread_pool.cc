@@ -0,0 +1,54 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+#include "modules/prediction/common/prediction_thread_pool.h"
+
+#include "modules/prediction/common/prediction_gflags.h"
+
+namespace apollo {
+namespace prediction {
+
+using apollo::common::util::WorkStealingThreadPool;
+
+PredictionThreadPool::PredictionThreadPool() {}
+
+void PredictionThreadPool::Init() {
+  if (thread_pool_ != nullptr) {
+    return;
+  }
+  thread_pool_.reset(
+      new WorkStealingThreadPool(FLAGS_prediction_thread_pool_size));
+}
+
+void PredictionThreadPool::ParallelFor(
+    const std::size_t size, const std::function<void(std::size_t)>& func) {
+  if (thread_pool_ == nullptr) {
+    for (std::size_t i = 0; i < size; ++i) {
+      func(i);
+    }
+    return;
+  }
+  thread_pool_->ParallelFor(0, size, func);
+}
+
+void PredictionThreadPool::Stop() {
+  if (thread_pool_ != nullptr) {
+    thread_pool_->Stop();
+  }
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file
+ * @brief The thread pool shared by the stages of prediction
+ */
+
+#ifndef MODULES_PREDICTION_COMMON_PREDICTION_THREAD_POOL_H_
+#define MODULES_PREDICTION_COMMON_PREDICTION_THREAD_POOL_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include "modules/common/macro.h"
+#include "modules/common/util/work_stealing_thread_pool.h"
+
+/**
+ * @namespace apollo::prediction
+ * @brief apollo::prediction
+ */
+namespace apollo {
+namespace prediction {
+
+/**
+ * @class PredictionThreadPool
+ * @brief A singleton holding the thread pool over which the obstacles of a
+ * frame are updated and evaluated.
+ */
+class PredictionThreadPool {
+ public:
+  /**
+   * @brief Create the thread pool, once
+   */
+  void Init();
+
+  /**
+   * @brief Get the thread pool
+   * @return The thread pool, null before Init()
+   */
+  common::util::WorkStealingThreadPool* mutable_thread_pool() {
+    return thread_pool_.get();
+  }
+
+  /**
+   * @brief Run func(i) for every i in [0, size) over the thread pool, or in
+   *        the calling thread before Init()
+   * @param Number of indices
+   * @param Function to run
+   */
+  void ParallelFor(const std::size_t size,
+                   const std::function<void(std::size_t)>& func);
+
+  /**
+   * @brief Run the pending tasks and join the threads
+   */
+  void Stop();
+
+ private:
+  std::unique_ptr<common::util::WorkStealingThreadPool> thread_pool_;
+
+  DECLARE_SINGLETON(PredictionThreadPool);
+};
+
+}  // namespace prediction
+}  // namespace apollo
+
+#endif  // MODULES_PREDICTION_COMMON_PREDICTION_THREAD_POOL_H_
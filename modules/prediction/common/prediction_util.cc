@@ -18,7 +18,9 @@
 
 #include <cmath>
 #include <limits>
+#include <memory>
 #include <string>
+#include <utility>
 
 #include "modules/common/log.h"
 #include "modules/prediction/common/prediction_gflags.h"
@@ -65,6 +67,7 @@ namespace predictor_util {
 
 using ::apollo::common::PathPoint;
 using ::apollo::common::TrajectoryPoint;
+using ::apollo::hdmap::LaneInfo;
 
 void TranslatePoint(const double translate_x, const double translate_y,
                     TrajectoryPoint* point) {
@@ -158,23 +161,24 @@ void GenerateLaneSequenceTrajectoryPoints(
     Eigen::Matrix<double, 4, 1>* state, Eigen::Matrix<double, 4, 4>* transition,
     const LaneSequence& sequence, const size_t num, const double period,
     std::vector<TrajectoryPoint>* points) {
-  PredictionMap* map = PredictionMap::instance();
+  std::vector<std::shared_ptr<const LaneInfo>> lanes;
+  if (!GetLanesOfSequence(sequence, &lanes)) {
+    return;
+  }
   double lane_s = (*state)(0, 0);
   double lane_l = (*state)(1, 0);
   double lane_speed = (*state)(2, 0);
   double lane_acc = (*state)(3, 0);
 
+  // Run the kinematic model for all the points first, and then look up the
+  // points on the lanes all at once.
+  std::vector<int> lane_indices(num);
+  Eigen::ArrayXd points_s(num);
+  Eigen::ArrayXd points_l(num);
+  Eigen::ArrayXd points_speed(num);
+  Eigen::ArrayXd points_acc(num);
   int lane_segment_index = 0;
-  std::string lane_id = sequence.lane_segment(lane_segment_index).lane_id();
   for (size_t i = 0; i < num; ++i) {
-    Eigen::Vector2d point;
-    double theta = M_PI;
-    if (!map->SmoothPointFromLane(lane_id, lane_s, lane_l, &point, &theta)) {
-      AERROR << "Unable to get smooth point from lane [" << lane_id
-             << "] with s [" << lane_s << "] and l [" << lane_l << "]";
-      break;
-    }
-
     // update state
     if (lane_speed <= 0.0) {
       ADEBUG << "Non-positive lane_speed tacked : " << lane_speed;
@@ -186,19 +190,11 @@ void GenerateLaneSequenceTrajectoryPoints(
       lane_acc = 0.0;
     }
 
-    // add trajectory point
-    TrajectoryPoint trajectory_point;
-    PathPoint path_point;
-    path_point.set_x(point.x());
-    path_point.set_y(point.y());
-    path_point.set_z(0.0);
-    path_point.set_theta(theta);
-    path_point.set_lane_id(lane_id);
-    trajectory_point.mutable_path_point()->CopyFrom(path_point);
-    trajectory_point.set_v(lane_speed);
-    trajectory_point.set_a(lane_acc);
-    trajectory_point.set_relative_time(static_cast<double>(i) * period);
-    points->emplace_back(std::move(trajectory_point));
+    lane_indices[i] = lane_segment_index;
+    points_s(i) = lane_s;
+    points_l(i) = lane_l;
+    points_speed(i) = lane_speed;
+    points_acc(i) = lane_acc;
 
     (*state)(2, 0) = lane_speed;
     (*state)(3, 0) = lane_acc;
@@ -217,14 +213,53 @@ void GenerateLaneSequenceTrajectoryPoints(
     lane_acc = (*state)(3, 0);
 
     // find next lane id
-    while (lane_s > map->LaneById(lane_id)->total_length() &&
+    while (lane_s > lanes[lane_segment_index]->total_length() &&
            lane_segment_index + 1 < sequence.lane_segment_size()) {
+      lane_s = lane_s - lanes[lane_segment_index]->total_length();
       lane_segment_index += 1;
-      lane_s = lane_s - map->LaneById(lane_id)->total_length();
       (*state)(0, 0) = lane_s;
-      lane_id = sequence.lane_segment(lane_segment_index).lane_id();
     }
   }
+
+  Eigen::ArrayXd xs;
+  Eigen::ArrayXd ys;
+  Eigen::ArrayXd headings;
+  PredictionMap::SmoothPointsFromLanes(lanes, lane_indices, points_s,
+                                       points_l, &xs, &ys, &headings);
+
+  // add trajectory points
+  points->reserve(points->size() + num);
+  for (size_t i = 0; i < num; ++i) {
+    TrajectoryPoint trajectory_point;
+    PathPoint* path_point = trajectory_point.mutable_path_point();
+    path_point->set_x(xs(i));
+    path_point->set_y(ys(i));
+    path_point->set_z(0.0);
+    path_point->set_theta(headings(i));
+    path_point->set_lane_id(
+        sequence.lane_segment(lane_indices[i]).lane_id());
+    trajectory_point.set_v(points_speed(i));
+    trajectory_point.set_a(points_acc(i));
+    trajectory_point.set_relative_time(static_cast<double>(i) * period);
+    points->emplace_back(std::move(trajectory_point));
+  }
+}
+
+bool GetLanesOfSequence(const LaneSequence& sequence,
+                        std::vector<std::shared_ptr<const LaneInfo>>* lanes) {
+  CHECK_NOTNULL(lanes);
+  lanes->clear();
+  lanes->reserve(sequence.lane_segment_size());
+  for (const auto& lane_segment : sequence.lane_segment()) {
+    std::shared_ptr<const LaneInfo> lane =
+        PredictionMap::LaneById(lane_segment.lane_id());
+    if (lane == nullptr) {
+      AERROR << "Lane [" << lane_segment.lane_id() << "] is not in the map.";
+      return false;
+    }
+    lanes->push_back(std::move(lane));
+  }
+  return !lanes->empty();
 }
 
 }  // namespace predictor_util
@@ -16,11 +16,13 @@
 #ifndef MODULES_PREDICTION_COMMON_PREDICTION_UTIL_H_
 #define MODULES_PREDICTION_COMMON_PREDICTION_UTIL_H_
 
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "Eigen/Dense"
 #include "modules/common/proto/pnc_point.pb.h"
+#include "modules/map/hdmap/hdmap_common.h"
 #include "modules/prediction/proto/lane_graph.pb.h"
 
 namespace apollo {
@@ -99,6 +101,16 @@ void GenerateLaneSequenceTrajectoryPoints(
     const LaneSequence& sequence, const size_t num, const double period,
     std::vector<::apollo::common::TrajectoryPoint>* points);
 
+/**
+ * @brief Look up the lanes of a lane sequence in the map.
+ * @param sequence The lane sequence.
+ * @param lanes The lanes, one per lane segment of the sequence.
+ * @return If the sequence has lanes and all of them are in the map.
+ */
+bool GetLanesOfSequence(
+    const LaneSequence& sequence,
+    std::vector<std::shared_ptr<const hdmap::LaneInfo>>* lanes);
+
 }  // namespace predictor_util
 }  // namespace prediction
 }  // namespace apollo
@@ -20,6 +20,8 @@
 #include <utility>
 
 #include "modules/common/util/string_util.h"
+#include "modules/prediction/common/lane_graph_cache.h"
+#include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/prediction_map.h"
 
 namespace apollo {
@@ -48,6 +50,13 @@ Status RoadGraph::BuildLaneGraph(LaneGraph* const lane_graph_ptr) {
     return Status(ErrorCode::PREDICTION_ERROR, error_msg);
   }
 
+  if (FLAGS_enable_lane_graph_cache) {
+    ComputeLaneSequences(*LaneGraphCache::instance()->GetLaneSequences(
+                             lane_info_ptr_, start_s_ + length_),
+                         lane_graph_ptr);
+    return Status::OK();
+  }
+
   std::vector<LaneSegment> lane_segments;
   double accumulated_s = 0.0;
   ComputeLaneSequence(accumulated_s, start_s_, lane_info_ptr_, &lane_segments,
@@ -115,5 +124,65 @@ void RoadGraph::ComputeLaneSequence(
   lane_segments->pop_back();
 }
 
+void RoadGraph::ComputeLaneSequences(
+    const LaneGraphCache::LaneSequences& cached_lane_sequences,
+    LaneGraph* const lane_graph_ptr) const {
+  // The cached sequences are cut with the arithmetic of ComputeLaneSequence.
+  // The sequences cut on the same lane share the prefix, and are adjacent.
+  const std::vector<LaneGraphCache::Lane>* last_lanes = nullptr;
+  std::size_t last_num_lanes = 0;
+  for (const auto& lanes : cached_lane_sequences) {
+    double accumulated_s = 0.0;
+    double start_s = start_s_;
+    std::size_t num_lanes = 0;
+    bool is_cut = false;
+    while (num_lanes < lanes.size()) {
+      const double total_length = lanes[num_lanes].lane_info->total_length();
+      ++num_lanes;
+      if (accumulated_s + total_length - start_s >= length_) {
+        is_cut = true;
+        break;
+      }
+      accumulated_s += total_length - start_s;
+      start_s = 0.0;
+    }
+    if (!is_cut &&
+        lanes.back().lane_info->lane().successor_id_size() > 0) {
+      // The successors of the last lane are not in the map.
+      continue;
+    }
+    if (last_lanes != nullptr && num_lanes == last_num_lanes &&
+        std::equal(lanes.begin(), lanes.begin() + num_lanes,
+                   last_lanes->begin(),
+                   [](const LaneGraphCache::Lane& lane,
+                      const LaneGraphCache::Lane& other_lane) {
+                     return lane.lane_info == other_lane.lane_info;
+                   })) {
+      continue;
+    }
+    last_lanes = &lanes;
+    last_num_lanes = num_lanes;
+
+    LaneSequence* sequence = lane_graph_ptr->add_lane_sequence();
+    accumulated_s = 0.0;
+    start_s = start_s_;
+    for (std::size_t i = 0; i < num_lanes; ++i) {
+      const double total_length = lanes[i].lane_info->total_length();
+      LaneSegment* lane_segment = sequence->add_lane_segment();
+      lane_segment->set_lane_id(lanes[i].lane_info->id().id());
+      lane_segment->set_start_s(start_s);
+      lane_segment->set_lane_turn_type(lanes[i].turn_type);
+      if (is_cut && i + 1 == num_lanes) {
+        lane_segment->set_end_s(length_ - accumulated_s + start_s);
+      } else {
+        lane_segment->set_end_s(total_length);
+      }
+      accumulated_s += total_length - start_s;
+      start_s = 0.0;
+    }
+    sequence->set_label(0);
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -24,6 +24,7 @@
 
 #include "modules/common/status/status.h"
 #include "modules/map/hdmap/hdmap_common.h"
+#include "modules/prediction/common/lane_graph_cache.h"
 
 namespace apollo {
 namespace prediction {
@@ -62,6 +63,15 @@ class RoadGraph {
                            std::vector<LaneSegment>* const lane_segments,
                            LaneGraph* const lane_graph_ptr) const;
 
+  /**
+   * @brief Build the lane sequences of the road graph from the cached ones
+   * @param The cached lane sequences, searched far enough
+   * @param The lane graph to add the lane sequences to
+   */
+  void ComputeLaneSequences(
+      const LaneGraphCache::LaneSequences& cached_lane_sequences,
+      LaneGraph* const lane_graph_ptr) const;
+
  private:
   double start_s_ = 0;
   double length_ = -1.0;
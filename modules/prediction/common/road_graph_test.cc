@@ -137,5 +137,26 @@ TEST_F(RoadGraphTest, MultipleLaneSequence) {
   EXPECT_EQ("l95", lane_graph.lane_sequence(1).lane_segment(2).lane_id());
 }
 
+TEST_F(RoadGraphTest, CachedLaneSequences) {
+  for (const std::string lane_id : {"l9", "l20", "l22"}) {
+    auto lane = map_->LaneById(lane_id);
+    EXPECT_TRUE(lane != nullptr);
+    for (double start_s = -10.0; start_s < 250.0; start_s += 23.0) {
+      for (double length = 0.0; length < 300.0; length += 17.0) {
+        RoadGraph road_graph(start_s, length, lane);
+        FLAGS_enable_lane_graph_cache = false;
+        LaneGraph expected_lane_graph;
+        EXPECT_TRUE(road_graph.BuildLaneGraph(&expected_lane_graph).ok());
+        FLAGS_enable_lane_graph_cache = true;
+        LaneGraph lane_graph;
+        EXPECT_TRUE(road_graph.BuildLaneGraph(&lane_graph).ok());
+        EXPECT_EQ(expected_lane_graph.SerializeAsString(),
+                  lane_graph.SerializeAsString())
+            << lane_id << " " << start_s << " " << length;
+      }
+    }
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
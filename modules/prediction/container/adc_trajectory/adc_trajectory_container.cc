@@ -16,6 +16,9 @@
 
 #include "modules/prediction/container/adc_trajectory/adc_trajectory_container.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -36,10 +39,6 @@ using ::apollo::planning::ADCTrajectory;
 
 void ADCTrajectoryContainer::Insert(
     const ::google::protobuf::Message& message) {
-  adc_lane_ids_.clear();
-  adc_lane_seq_.clear();
-  adc_junction_polygon_ = Polygon2d{};
-
   adc_trajectory_.CopyFrom(dynamic_cast<const ADCTrajectory&>(message));
   ADEBUG << "Received a planning message ["
          << adc_trajectory_.ShortDebugString() << "].";
@@ -47,32 +46,39 @@ void ADCTrajectoryContainer::Insert(
   // Find junction
   if (IsProtected()) {
     SetJunctionPolygon();
+  } else {
+    has_adc_junction_polygon_ = false;
+  }
+  if (has_adc_junction_polygon_) {
+    ADEBUG << "Generate a polygon [" << adc_junction_polygon_.DebugString()
+           << "].";
   }
-  ADEBUG << "Generate a polygon [" << adc_junction_polygon_.DebugString()
-         << "].";
 
   // Find ADC lane sequence
   SetLaneSequence();
-  ADEBUG << "Generate an ADC lane id sequence [" << ToString(adc_lane_seq_)
-         << "].";
+  ADEBUG << "Generate an ADC lane id sequence ["
+         << ToString(adc_lane_seq_.begin(), adc_lane_seq_.end()) << "].";
 }
 
 bool ADCTrajectoryContainer::IsPointInJunction(const PathPoint& point) const {
-  if (adc_junction_polygon_.num_points() < 3) {
+  if (!has_adc_junction_polygon_) {
+    return false;
+  }
+  const Polygon2d& polygon = adc_junction_polygon_;
+  if (point.x() < polygon.min_x() || point.x() > polygon.max_x() ||
+      point.y() < polygon.min_y() || point.y() > polygon.max_y()) {
+    return false;
+  }
+  if (!polygon.IsPointIn({point.x(), point.y()})) {
     return false;
   }
-  bool in_polygon = adc_junction_polygon_.IsPointIn({point.x(), point.y()});
 
   PredictionMap* map = PredictionMap::instance();
-  bool on_virtual_lane = false;
-  if (point.has_lane_id()) {
-    on_virtual_lane = map->IsVirtualLane(point.lane_id());
-  }
-  if (!on_virtual_lane) {
-    on_virtual_lane =
-        map->OnVirtualLane({point.x(), point.y()}, FLAGS_virtual_lane_radius);
+  if (point.has_lane_id() && map->IsVirtualLane(point.lane_id())) {
+    return true;
   }
-  return in_polygon && on_virtual_lane;
+  return map->OnVirtualLane({point.x(), point.y()},
+                            FLAGS_virtual_lane_radius);
 }
 
 bool ADCTrajectoryContainer::IsProtected() const {
@@ -84,95 +90,139 @@ void ADCTrajectoryContainer::SetJunctionPolygon() {
   std::shared_ptr<const JunctionInfo> junction_info(nullptr);
 
   for (int i = 0; i < adc_trajectory_.trajectory_point_size(); ++i) {
-    double s = adc_trajectory_.trajectory_point(i).path_point().s();
-
-    if (s > FLAGS_adc_trajectory_search_length) {
+    const PathPoint& path_point =
+        adc_trajectory_.trajectory_point(i).path_point();
+    if (path_point.s() > FLAGS_adc_trajectory_search_length) {
       break;
     }
 
-    if (junction_info != nullptr) {
-      break;
-    }
-
-    double x = adc_trajectory_.trajectory_point(i).path_point().x();
-    double y = adc_trajectory_.trajectory_point(i).path_point().y();
     std::vector<std::shared_ptr<const JunctionInfo>> junctions =
-        PredictionMap::instance()->GetJunctions({x, y},
-                                                FLAGS_junction_search_radius);
+        PredictionMap::instance()->GetJunctions(
+            {path_point.x(), path_point.y()}, FLAGS_junction_search_radius);
     if (!junctions.empty() && junctions.front() != nullptr) {
       junction_info = junctions.front();
+      break;
     }
   }
 
-  if (junction_info != nullptr && junction_info->junction().has_polygon()) {
-    std::vector<Vec2d> vertices;
-    for (const auto& point : junction_info->junction().polygon().point()) {
-      vertices.emplace_back(point.x(), point.y());
-    }
-    if (vertices.size() >= 3) {
-      adc_junction_polygon_ = Polygon2d{vertices};
-    }
+  if (junction_info == nullptr || !junction_info->junction().has_polygon() ||
+      junction_info->polygon().num_points() < 3) {
+    has_adc_junction_polygon_ = false;
+    return;
+  }
+  const std::string& junction_id = junction_info->id().id();
+  if (!has_adc_junction_polygon_ || junction_id != adc_junction_id_) {
+    adc_junction_id_ = junction_id;
+    adc_junction_polygon_ = junction_info->polygon();
   }
+  has_adc_junction_polygon_ = true;
 }
 
 void ADCTrajectoryContainer::SetLaneSequence() {
+  adc_lane_start_ = 0;
+
+  int num_lanes = 0;
+  bool changed = false;
   for (const auto& lane : adc_trajectory_.lane_id()) {
-    if (!lane.id().empty()) {
-      adc_lane_seq_.emplace_back(lane.id());
+    if (lane.id().empty()) {
+      continue;
+    }
+    if (static_cast<size_t>(num_lanes) >= adc_lane_seq_.size() ||
+        adc_lane_seq_[num_lanes] != lane.id()) {
+      changed = true;
+      break;
     }
+    ++num_lanes;
   }
-  adc_lane_ids_.clear();
-  adc_lane_ids_.insert(adc_lane_seq_.begin(), adc_lane_seq_.end());
-}
-
-std::string ADCTrajectoryContainer::ToString(
-    const std::unordered_set<std::string>& lane_ids) {
-  std::string str_lane_sequence = "";
-  auto it = lane_ids.begin();
-  if (it != lane_ids.end()) {
-    str_lane_sequence += (*it);
-    ++it;
+  if (!changed && static_cast<size_t>(num_lanes) == adc_lane_seq_.size()) {
+    return;
   }
-  for (; it != lane_ids.end(); ++it) {
-    str_lane_sequence += ("->" + *it);
+
+  adc_lane_seq_.clear();
+  adc_lane_index_.clear();
+  for (const auto& lane : adc_trajectory_.lane_id()) {
+    if (!lane.id().empty()) {
+      adc_lane_index_[lane.id()] = adc_lane_seq_.size();
+      adc_lane_seq_.emplace_back(lane.id());
+    }
   }
-  return str_lane_sequence;
 }
 
 std::string ADCTrajectoryContainer::ToString(
-    const std::vector<std::string>& lane_ids) {
+    std::vector<std::string>::const_iterator begin,
+    std::vector<std::string>::const_iterator end) const {
   std::string str_lane_sequence = "";
-  auto it = lane_ids.begin();
-  if (it != lane_ids.end()) {
+  auto it = begin;
+  if (it != end) {
     str_lane_sequence += (*it);
     ++it;
   }
-  for (; it != lane_ids.end(); ++it) {
+  for (; it != end; ++it) {
     str_lane_sequence += ("->" + *it);
   }
   return str_lane_sequence;
 }
 
-bool ADCTrajectoryContainer::HasOverlap(const LaneSequence& lane_sequence) {
+bool ADCTrajectoryContainer::HasOverlap(
+    const LaneSequence& lane_sequence) const {
   for (const auto& lane_segment : lane_sequence.lane_segment()) {
-    std::string lane_id = lane_segment.lane_id();
-    if (adc_lane_ids_.find(lane_id) != adc_lane_ids_.end()) {
+    auto it = adc_lane_index_.find(lane_segment.lane_id());
+    if (it != adc_lane_index_.end() && it->second >= adc_lane_start_) {
       return true;
     }
   }
   return false;
 }
 
+void ADCTrajectoryContainer::HasOverlaps(const LaneGraph& lane_graph,
+                                         std::vector<bool>* overlaps) const {
+  CHECK_NOTNULL(overlaps);
+  overlaps->assign(lane_graph.lane_sequence_size(), false);
+  if (adc_lane_start_ >= adc_lane_seq_.size()) {
+    return;
+  }
+  for (int i = 0; i < lane_graph.lane_sequence_size(); ++i) {
+    (*overlaps)[i] = HasOverlap(lane_graph.lane_sequence(i));
+  }
+}
+
 void ADCTrajectoryContainer::SetPosition(const Vec2d& position) {
-  for (auto it = adc_lane_seq_.begin(); it != adc_lane_seq_.end(); ++it) {
-    auto lane_info = PredictionMap::instance()->LaneById(*it);
+  adc_position_ = position;
+  has_adc_position_ = true;
+  for (size_t i = adc_lane_start_; i < adc_lane_seq_.size(); ++i) {
+    auto lane_info = PredictionMap::instance()->LaneById(adc_lane_seq_[i]);
     if (lane_info != nullptr && lane_info->IsOnLane(position)) {
-      adc_lane_ids_.clear();
-      adc_lane_ids_.insert(it, adc_lane_seq_.end());
+      adc_lane_start_ = i;
+      break;
+    }
+  }
+  ADEBUG << "Generate an ADC lane ids ["
+         << ToString(adc_lane_seq_.begin() + adc_lane_start_,
+                     adc_lane_seq_.end())
+         << "].";
+}
+
+double ADCTrajectoryContainer::InteractionDistance(
+    const Vec2d& position, const Vec2d& velocity) const {
+  double min_distance = std::numeric_limits<double>::infinity();
+  for (const auto& trajectory_point : adc_trajectory_.trajectory_point()) {
+    const double relative_time = trajectory_point.relative_time();
+    if (relative_time < 0.0) {
+      continue;
+    }
+    if (relative_time > FLAGS_prediction_duration) {
       break;
     }
+    const Vec2d adc_point(trajectory_point.path_point().x(),
+                          trajectory_point.path_point().y());
+    min_distance = std::min(
+        min_distance,
+        adc_point.DistanceTo(position + velocity * relative_time));
+  }
+  if (std::isinf(min_distance) && has_adc_position_) {
+    min_distance = adc_position_.DistanceTo(position);
   }
-  ADEBUG << "Generate an ADC lane ids [" << ToString(adc_lane_ids_) << "].";
+  return min_distance;
 }
 
 }  // namespace prediction
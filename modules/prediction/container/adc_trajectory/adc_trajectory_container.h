@@ -24,7 +24,7 @@
 
 #include <memory>
 #include <string>
-#include <unordered_set>
+#include <unordered_map>
 #include <vector>
 
 #include "Eigen/Dense"
@@ -74,27 +74,57 @@ class ADCTrajectoryContainer : public Container {
    * @brief Has overlap with ADC trajectory
    * @return True if a target lane sequence has overlap with ADC trajectory
    */
-  bool HasOverlap(const LaneSequence& lane_sequence);
+  bool HasOverlap(const LaneSequence& lane_sequence) const;
+
+  /**
+   * @brief Check which lane sequences of a lane graph have overlap with ADC
+   *        trajectory
+   * @param lane_graph The lane graph
+   * @param overlaps Filled with whether each lane sequence has overlap
+   */
+  void HasOverlaps(const LaneGraph& lane_graph,
+                   std::vector<bool>* overlaps) const;
 
   /**
    * @brief Set ADC position
    */
   void SetPosition(const ::apollo::common::math::Vec2d& position);
 
+  /**
+   * @brief Get the closest distance between an obstacle moving at a constant
+   *        velocity and the ADC along its trajectory, at the same times.
+   *        Without a trajectory, the distance to the ADC position is used.
+   * @param position The position of the obstacle
+   * @param velocity The velocity of the obstacle
+   * @return The closest distance, or infinity if the ADC is unknown
+   */
+  double InteractionDistance(
+      const ::apollo::common::math::Vec2d& position,
+      const ::apollo::common::math::Vec2d& velocity) const;
+
  private:
   void SetJunctionPolygon();
 
   void SetLaneSequence();
 
-  std::string ToString(const std::unordered_set<std::string>& lane_ids);
-
-  std::string ToString(const std::vector<std::string>& lane_ids);
+  std::string ToString(std::vector<std::string>::const_iterator begin,
+                       std::vector<std::string>::const_iterator end) const;
 
  private:
   ::apollo::planning::ADCTrajectory adc_trajectory_;
+  // The polygon of the first junction is kept with its id, so that it is not
+  // rebuilt while the trajectories run into the same junction.
+  std::string adc_junction_id_;
   ::apollo::common::math::Polygon2d adc_junction_polygon_;
-  std::unordered_set<std::string> adc_lane_ids_;
+  bool has_adc_junction_polygon_ = false;
+  // The lane ids of the trajectory, each mapped to its last index in the
+  // sequence. It is only rebuilt when the sequence of a trajectory changes;
+  // the lanes the ADC has passed are those before adc_lane_start_.
   std::vector<std::string> adc_lane_seq_;
+  std::unordered_map<std::string, size_t> adc_lane_index_;
+  size_t adc_lane_start_ = 0;
+  ::apollo::common::math::Vec2d adc_position_;
+  bool has_adc_position_ = false;
 };
 
 }  // namespace prediction
@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/prediction/container/adc_trajectory/adc_trajectory_container.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace apollo {
+namespace prediction {
+
+using apollo::common::PathPoint;
+using apollo::planning::ADCTrajectory;
+
+class ADCTrajectoryContainerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    ADCTrajectory adc_trajectory;
+    adc_trajectory.add_lane_id()->set_id("l1");
+    adc_trajectory.add_lane_id()->set_id("");
+    adc_trajectory.add_lane_id()->set_id("l2");
+    container_.Insert(adc_trajectory);
+  }
+
+ protected:
+  static LaneSequence MakeLaneSequence(const std::vector<std::string>& ids) {
+    LaneSequence lane_sequence;
+    for (const auto& id : ids) {
+      lane_sequence.add_lane_segment()->set_lane_id(id);
+    }
+    return lane_sequence;
+  }
+
+  ADCTrajectoryContainer container_;
+};
+
+TEST_F(ADCTrajectoryContainerTest, HasOverlap) {
+  EXPECT_TRUE(container_.HasOverlap(MakeLaneSequence({"l0", "l2"})));
+  EXPECT_TRUE(container_.HasOverlap(MakeLaneSequence({"l1"})));
+  EXPECT_FALSE(container_.HasOverlap(MakeLaneSequence({"l0", "l3"})));
+  EXPECT_FALSE(container_.HasOverlap(MakeLaneSequence({""})));
+
+  // A new lane sequence replaces the lane ids of the former trajectory.
+  ADCTrajectory adc_trajectory;
+  adc_trajectory.add_lane_id()->set_id("l3");
+  container_.Insert(adc_trajectory);
+  EXPECT_FALSE(container_.HasOverlap(MakeLaneSequence({"l1", "l2"})));
+  EXPECT_TRUE(container_.HasOverlap(MakeLaneSequence({"l0", "l3"})));
+}
+
+TEST_F(ADCTrajectoryContainerTest, HasOverlaps) {
+  LaneGraph lane_graph;
+  *lane_graph.add_lane_sequence() = MakeLaneSequence({"l0"});
+  *lane_graph.add_lane_sequence() = MakeLaneSequence({"l0", "l1"});
+  *lane_graph.add_lane_sequence() = MakeLaneSequence({"l2", "l3"});
+  lane_graph.add_lane_sequence();
+
+  std::vector<bool> overlaps;
+  container_.HasOverlaps(lane_graph, &overlaps);
+  EXPECT_EQ(std::vector<bool>({false, true, true, false}), overlaps);
+
+  container_.Insert(ADCTrajectory());
+  container_.HasOverlaps(lane_graph, &overlaps);
+  EXPECT_EQ(std::vector<bool>(4, false), overlaps);
+}
+
+TEST_F(ADCTrajectoryContainerTest, NoJunctionWithoutRightOfWay) {
+  EXPECT_FALSE(container_.IsProtected());
+  PathPoint point;
+  point.set_x(1.0);
+  point.set_y(2.0);
+  EXPECT_FALSE(container_.IsPointInJunction(point));
+}
+
+}  // namespace prediction
+}  // namespace apollo
@@ -37,6 +37,7 @@ namespace prediction {
 using ::apollo::common::ErrorCode;
 using ::apollo::common::Point3D;
 using ::apollo::common::math::KalmanFilter;
+using ::apollo::common::math::KalmanFilterBatch;
 using ::apollo::common::util::FindOrDie;
 using ::apollo::common::util::FindOrNull;
 using ::apollo::hdmap::LaneInfo;
@@ -50,7 +51,7 @@ double Damp(const double x, const double sigma) {
 
 }  // namespace
 
-Obstacle::Obstacle() {
+Obstacle::Obstacle() : feature_history_(FLAGS_max_obstacle_history_size) {
   double heading_filter_param = FLAGS_heading_filter_param;
   if (FLAGS_heading_filter_param < 0.0 || FLAGS_heading_filter_param > 1.0) {
     heading_filter_param = 0.98;
@@ -93,9 +94,12 @@ Feature* Obstacle::mutable_latest_feature() {
 
 size_t Obstacle::history_size() const { return feature_history_.size(); }
 
-const KalmanFilter<double, 4, 2, 0>& Obstacle::kf_lane_tracker(
-    const std::string& lane_id) {
-  return FindOrDie(kf_lane_trackers_, lane_id);
+const KalmanFilterBatch<double, 4, 2>& Obstacle::kf_lane_trackers() const {
+  return kf_lane_trackers_;
+}
+
+size_t Obstacle::kf_lane_tracker_index(const std::string& lane_id) const {
+  return FindOrDie(kf_lane_tracker_indices_, lane_id);
 }
 
 const KalmanFilter<double, 6, 2, 0>& Obstacle::kf_motion_tracker() const {
@@ -140,8 +144,11 @@ void Obstacle::Insert(const PerceptionObstacle& perception_obstacle,
     return;
   }
 
-  Feature feature;
-  if (SetId(perception_obstacle, &feature) == ErrorCode::PREDICTION_ERROR) {
+  // The feature is written in place in the slot it takes in the history,
+  // which keeps the memory of the feature it held before.
+  Feature* feature = feature_history_.next_front();
+  feature->Clear();
+  if (SetId(perception_obstacle, feature) == ErrorCode::PREDICTION_ERROR) {
     return;
   }
   if (SetType(perception_obstacle) == ErrorCode::PREDICTION_ERROR) {
@@ -149,33 +156,33 @@ void Obstacle::Insert(const PerceptionObstacle& perception_obstacle,
   }
 
   // Set obstacle observation for KF tracking
-  SetStatus(perception_obstacle, timestamp, &feature);
+  SetStatus(perception_obstacle, timestamp, feature);
 
   // Update KF
   if (!kf_motion_tracker_.IsInitialized()) {
-    InitKFMotionTracker(feature);
+    InitKFMotionTracker(*feature);
   }
-  UpdateKFMotionTracker(feature);
+  UpdateKFMotionTracker(*feature);
   if (type_ == PerceptionObstacle::PEDESTRIAN) {
     if (!kf_pedestrian_tracker_.IsInitialized()) {
-      InitKFPedestrianTracker(feature);
+      InitKFPedestrianTracker(*feature);
     }
-    UpdateKFPedestrianTracker(feature);
+    UpdateKFPedestrianTracker(*feature);
   }
 
   // Update obstacle status based on KF if enabled
   if (FLAGS_enable_kf_tracking) {
-    UpdateStatus(&feature);
+    UpdateStatus(feature);
   }
 
   // Set obstacle lane features
-  SetCurrentLanes(&feature);
-  SetNearbyLanes(&feature);
-  SetLaneGraphFeature(&feature);
-  UpdateKFLaneTrackers(&feature);
+  SetCurrentLanes(feature);
+  SetNearbyLanes(feature);
+  SetLaneGraphFeature(feature);
+  UpdateKFLaneTrackers(feature);
 
   // Insert obstacle feature to history
-  InsertFeatureToHistory(feature);
+  InsertFeatureToHistory();
 
   // Set obstacle motion status
   SetMotionStatus();
@@ -588,41 +595,59 @@ void Obstacle::UpdateKFMotionTracker(const Feature& feature) {
 }
 
 void Obstacle::InitKFLaneTracker(const std::string& lane_id,
-                                 const double beta) {
-  KalmanFilter<double, 4, 2, 0> kf;
-
+                                 const double lane_s, const double lane_l,
+                                 const double lane_speed,
+                                 const double lane_acc, const double beta) {
   // transition matrix: update delta_t at each processing step
   Eigen::Matrix<double, 4, 4> F;
   F.setIdentity();
   F(1, 1) = beta;
-  kf.SetTransitionMatrix(F);
 
   // observation matrix
   Eigen::Matrix<double, 2, 4> H;
   H.setZero();
   H(0, 0) = 1.0;
   H(1, 1) = 1.0;
-  kf.SetObservationMatrix(H);
+  kf_lane_trackers_.SetObservationMatrix(H);
 
   // Set covariance of transition noise matrix Q
   Eigen::Matrix<double, 4, 4> Q;
   Q.setIdentity();
   Q *= FLAGS_q_var;
-  kf.SetTransitionNoise(Q);
+  kf_lane_trackers_.SetTransitionNoise(Q);
 
   // Set observation noise matrix R
   Eigen::Matrix<double, 2, 2> R;
   R.setIdentity();
   R *= FLAGS_r_var;
-  kf.SetObservationNoise(R);
+  kf_lane_trackers_.SetObservationNoise(R);
 
   // Set current state covariance matrix P
   Eigen::Matrix<double, 4, 4> P;
   P.setIdentity();
   P *= FLAGS_p_var;
-  kf.SetStateCovariance(P);
 
-  kf_lane_trackers_.emplace(lane_id, std::move(kf));
+  Eigen::Matrix<double, 4, 1> state;
+  state.setZero();
+  state(0, 0) = lane_s;
+  state(1, 0) = lane_l;
+  state(2, 0) = lane_speed;
+  state(3, 0) = lane_acc;
+
+  kf_lane_tracker_indices_.emplace(lane_id,
+                                   kf_lane_trackers_.Add(F, state, P));
+  kf_lane_tracker_ids_.push_back(lane_id);
+}
+
+void Obstacle::RemoveKFLaneTracker(const size_t index) {
+  // the last tracker takes the index of the removed one
+  kf_lane_tracker_indices_.erase(kf_lane_tracker_ids_[index]);
+  kf_lane_trackers_.Remove(index);
+  if (index + 1 < kf_lane_tracker_ids_.size()) {
+    kf_lane_tracker_ids_[index] = std::move(kf_lane_tracker_ids_.back());
+    kf_lane_tracker_indices_[kf_lane_tracker_ids_[index]] = index;
+  }
+  kf_lane_tracker_ids_.pop_back();
 }
 
 void Obstacle::UpdateKFLaneTrackers(Feature* feature) {
@@ -644,36 +669,56 @@ void Obstacle::UpdateKFLaneTrackers(Feature* feature) {
     return;
   }
 
-  auto iter = kf_lane_trackers_.begin();
-  while (iter != kf_lane_trackers_.end()) {
-    if (lane_ids.find(iter->first) == lane_ids.end()) {
-      iter = kf_lane_trackers_.erase(iter);
+  size_t index = 0;
+  while (index < kf_lane_tracker_ids_.size()) {
+    if (lane_ids.find(kf_lane_tracker_ids_[index]) == lane_ids.end()) {
+      RemoveKFLaneTracker(index);
     } else {
-      ++iter;
+      ++index;
+    }
+  }
+
+  // All the remaining trackers have a lane feature, and are stepped
+  // together before the trackers of the new lanes are added.
+  double delta_ts = 0.0;
+  if (feature_history_.size() > 0) {
+    delta_ts = feature->timestamp() - feature_history_.front().timestamp();
+  }
+  if (delta_ts > FLAGS_double_precision && kf_lane_trackers_.size() > 0) {
+    for (auto& lane_feature : feature->lane().current_lane_feature()) {
+      SetKFLaneObservation(lane_feature.lane_id(), lane_feature.lane_s(),
+                           lane_feature.lane_l());
+    }
+    for (auto& nearby_lane_feature : feature->lane().nearby_lane_feature()) {
+      SetKFLaneObservation(nearby_lane_feature.lane_id(),
+                           nearby_lane_feature.lane_s(),
+                           nearby_lane_feature.lane_l());
     }
+    kf_lane_trackers_.SetTransitionCoeff(0, 2, delta_ts);
+    kf_lane_trackers_.SetTransitionCoeff(0, 3, 0.5 * delta_ts * delta_ts);
+    kf_lane_trackers_.SetTransitionCoeff(2, 3, delta_ts);
+    kf_lane_trackers_.Predict();
+    kf_lane_trackers_.Correct();
   }
 
-  double ts = feature->timestamp();
   double speed = feature->speed();
   double acc = feature->acc();
   for (auto& lane_feature : feature->lane().current_lane_feature()) {
-    std::string lane_id = lane_feature.lane_id();
-    if (lane_id.empty()) {
+    const std::string& lane_id = lane_feature.lane_id();
+    if (lane_id.empty() || kf_lane_tracker_indices_.count(lane_id) > 0) {
       continue;
     }
-    double s = lane_feature.lane_s();
-    double l = lane_feature.lane_l();
-    UpdateKFLaneTracker(lane_id, s, l, speed, acc, ts, FLAGS_go_approach_rate);
+    InitKFLaneTracker(lane_id, lane_feature.lane_s(), lane_feature.lane_l(),
+                      speed, acc, FLAGS_go_approach_rate);
   }
   for (auto& nearby_lane_feature : feature->lane().nearby_lane_feature()) {
-    std::string lane_id = nearby_lane_feature.lane_id();
-    if (lane_id.empty()) {
+    const std::string& lane_id = nearby_lane_feature.lane_id();
+    if (lane_id.empty() || kf_lane_tracker_indices_.count(lane_id) > 0) {
       continue;
     }
-    double s = nearby_lane_feature.lane_s();
-    double l = nearby_lane_feature.lane_l();
-    UpdateKFLaneTracker(lane_id, s, l, speed, acc, ts,
-                        FLAGS_cutin_approach_rate);
+    InitKFLaneTracker(lane_id, nearby_lane_feature.lane_s(),
+                      nearby_lane_feature.lane_l(), speed, acc,
+                      FLAGS_cutin_approach_rate);
   }
 
   if (FLAGS_enable_kf_tracking && id_ >= 0) {
@@ -681,43 +726,17 @@ void Obstacle::UpdateKFLaneTrackers(Feature* feature) {
   }
 }
 
-void Obstacle::UpdateKFLaneTracker(const std::string& lane_id,
-                                   const double lane_s, const double lane_l,
-                                   const double lane_speed,
-                                   const double lane_acc,
-                                   const double timestamp, const double beta) {
-  auto* kf_ptr = FindOrNull(kf_lane_trackers_, lane_id);
-  if (kf_ptr != nullptr) {
-    double delta_ts = 0.0;
-    if (feature_history_.size() > 0) {
-      delta_ts = timestamp - feature_history_.front().timestamp();
-    }
-    if (delta_ts > FLAGS_double_precision) {
-      auto F = kf_ptr->GetTransitionMatrix();
-      F(0, 2) = delta_ts;
-      F(0, 3) = 0.5 * delta_ts * delta_ts;
-      F(2, 3) = delta_ts;
-      kf_ptr->SetTransitionMatrix(F);
-      kf_ptr->Predict();
-
-      Eigen::Matrix<double, 2, 1> z;
-      z(0, 0) = lane_s;
-      z(1, 0) = lane_l;
-      kf_ptr->Correct(z);
-    }
-  } else {
-    InitKFLaneTracker(lane_id, beta);
-    auto& kf = FindOrDie(kf_lane_trackers_, lane_id);
-    Eigen::Matrix<double, 4, 1> state;
-    state.setZero();
-    state(0, 0) = lane_s;
-    state(1, 0) = lane_l;
-    state(2, 0) = lane_speed;
-    state(3, 0) = lane_acc;
-
-    auto P = kf.GetStateCovariance();
-    kf.SetStateEstimate(state, P);
+void Obstacle::SetKFLaneObservation(const std::string& lane_id,
+                                    const double lane_s,
+                                    const double lane_l) {
+  const size_t* index = FindOrNull(kf_lane_tracker_indices_, lane_id);
+  if (index == nullptr) {
+    return;
   }
+  Eigen::Matrix<double, 2, 1> z;
+  z(0, 0) = lane_s;
+  z(1, 0) = lane_l;
+  kf_lane_trackers_.SetObservation(*index, z);
 }
 
 void Obstacle::UpdateLaneBelief(Feature* feature) {
@@ -729,14 +748,15 @@ void Obstacle::UpdateLaneBelief(Feature* feature) {
     return;
   }
 
-  auto* kf_ptr = FindOrNull(kf_lane_trackers_, lane_id);
-  if (kf_ptr == nullptr) {
+  const size_t* index = FindOrNull(kf_lane_tracker_indices_, lane_id);
+  if (index == nullptr) {
     return;
   }
 
-  double lane_speed = kf_ptr->GetStateEstimate()(2, 0);
-  double lane_acc = common::math::Clamp(kf_ptr->GetStateEstimate()(3, 0),
-                                        FLAGS_min_acc, FLAGS_max_acc);
+  const auto state = kf_lane_trackers_.GetStateEstimate(*index);
+  double lane_speed = state(2, 0);
+  double lane_acc =
+      common::math::Clamp(state(3, 0), FLAGS_min_acc, FLAGS_max_acc);
 
   ADEBUG << "Obstacle [" << id_ << "] has tracked lane speed [" << std::fixed
          << std::setprecision(6) << lane_speed << "]";
@@ -829,7 +849,9 @@ void Obstacle::SetCurrentLanes(Feature* feature) {
   current_lanes_ = current_lanes;
   if (current_lanes_.empty()) {
     ADEBUG << "Obstacle [" << id_ << "] has no current lanes.";
-    kf_lane_trackers_.clear();
+    kf_lane_trackers_.Clear();
+    kf_lane_tracker_ids_.clear();
+    kf_lane_tracker_indices_.clear();
     return;
   }
   Lane lane;
@@ -1100,14 +1122,12 @@ void Obstacle::SetMotionStatus() {
   int len = std::min(history_size, FLAGS_still_obstacle_history_length);
   CHECK_GT(len, 1);
 
-  auto feature_riter = feature_history_.rbegin();
-  start_x = feature_riter->position().x();
-  start_y = feature_riter->position().y();
-  ++feature_riter;
-  while (feature_riter != feature_history_.rend()) {
-    avg_drift_x += (feature_riter->position().x() - start_x) / (len - 1);
-    avg_drift_y += (feature_riter->position().y() - start_y) / (len - 1);
-    ++feature_riter;
+  start_x = feature_history_.back().position().x();
+  start_y = feature_history_.back().position().y();
+  for (int i = history_size - 2; i >= 0; --i) {
+    const Feature& feature = feature_history_[i];
+    avg_drift_x += (feature.position().x() - start_x) / (len - 1);
+    avg_drift_y += (feature.position().y() - start_y) / (len - 1);
   }
 
   double delta_ts = feature_history_.front().timestamp() -
@@ -1142,8 +1162,8 @@ void Obstacle::SetMotionStatus() {
   }
 }
 
-void Obstacle::InsertFeatureToHistory(const Feature& feature) {
-  feature_history_.emplace_front(feature);
+void Obstacle::InsertFeatureToHistory() {
+  feature_history_.PushFront();
   ADEBUG << "Obstacle [" << id_ << "] inserted a frame into the history.";
 }
 
@@ -1156,7 +1176,7 @@ void Obstacle::Trim() {
   while (!feature_history_.empty() &&
          latest_ts - feature_history_.back().timestamp() >=
              FLAGS_max_history_time) {
-    feature_history_.pop_back();
+    feature_history_.PopBack();
     ++count;
   }
   if (count > 0) {
@@ -22,7 +22,6 @@
 #ifndef MODULES_PREDICTION_CONTAINER_OBSTACLES_OBSTACLE_H_
 #define MODULES_PREDICTION_CONTAINER_OBSTACLES_OBSTACLE_H_
 
-#include <deque>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -36,6 +35,8 @@
 #include "modules/prediction/proto/feature.pb.h"
 
 #include "modules/common/math/kalman_filter.h"
+#include "modules/common/math/kalman_filter_batch.h"
+#include "modules/common/util/ring_buffer.h"
 #include "modules/map/hdmap/hdmap_common.h"
 
 /**
@@ -120,12 +121,18 @@ class Obstacle {
   size_t history_size() const;
 
   /**
-   * @brief Get the lane Kalman filter by lane ID.
+   * @brief Get the lane Kalman filters, stepped together.
+   * @return The lane Kalman filters.
+   */
+  const common::math::KalmanFilterBatch<double, 4, 2>& kf_lane_trackers()
+      const;
+
+  /**
+   * @brief Get the index of the lane Kalman filter by lane ID.
    * @param lane_id The lane ID.
-   * @return The lane Kalman filter.
+   * @return The index of the lane Kalman filter in kf_lane_trackers().
    */
-  const common::math::KalmanFilter<double, 4, 2, 0>& kf_lane_tracker(
-      const std::string& lane_id);
+  size_t kf_lane_tracker_index(const std::string& lane_id) const;
 
   /**
    * @brief Get the motion Kalman filter.
@@ -214,14 +221,16 @@ class Obstacle {
 
   void UpdateKFMotionTracker(const Feature& feature);
 
-  void InitKFLaneTracker(const std::string& lane_id, const double beta);
+  void InitKFLaneTracker(const std::string& lane_id, const double lane_s,
+                         const double lane_l, const double lane_speed,
+                         const double lane_acc, const double beta);
+
+  void RemoveKFLaneTracker(const size_t index);
 
   void UpdateKFLaneTrackers(Feature* feature);
 
-  void UpdateKFLaneTracker(const std::string& lane_id, const double lane_s,
-                           const double lane_l, const double lane_speed,
-                           const double lane_acc, const double timestamp,
-                           const double beta);
+  void SetKFLaneObservation(const std::string& lane_id, const double lane_s,
+                            const double lane_l);
 
   void UpdateLaneBelief(Feature* feature);
 
@@ -239,7 +248,7 @@ class Obstacle {
 
   void SetMotionStatus();
 
-  void InsertFeatureToHistory(const Feature& feature);
+  void InsertFeatureToHistory();
 
   void Trim();
 
@@ -247,12 +256,17 @@ class Obstacle {
   int id_ = -1;
   perception::PerceptionObstacle::Type type_ =
       perception::PerceptionObstacle::UNKNOWN_UNMOVABLE;
-  std::deque<Feature> feature_history_;
+  // The newest feature at the front. The features are reused from frame to
+  // frame instead of being reallocated.
+  common::util::RingBuffer<Feature> feature_history_;
   common::math::KalmanFilter<double, 6, 2, 0> kf_motion_tracker_;
   common::math::KalmanFilter<double, 2, 2, 4> kf_pedestrian_tracker_;
   common::DigitalFilter heading_filter_;
-  std::unordered_map<std::string, common::math::KalmanFilter<double, 4, 2, 0>>
-      kf_lane_trackers_;
+  // The lane trackers, stepped together, with their lane IDs by index and
+  // their indices by lane ID.
+  common::math::KalmanFilterBatch<double, 4, 2> kf_lane_trackers_;
+  std::vector<std::string> kf_lane_tracker_ids_;
+  std::unordered_map<std::string, size_t> kf_lane_tracker_indices_;
   std::vector<std::shared_ptr<const hdmap::LaneInfo>> current_lanes_;
   std::vector<Eigen::MatrixXf> rnn_states_;
   bool rnn_enabled_ = false;
@@ -16,10 +16,13 @@
 
 #include "modules/prediction/container/obstacles/obstacles_container.h"
 
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "modules/common/math/math_utils.h"
 #include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_thread_pool.h"
 
 namespace apollo {
 namespace prediction {
@@ -51,14 +54,51 @@ void ObstaclesContainer::Insert(const ::google::protobuf::Message& message) {
 
   timestamp_ = timestamp;
   ADEBUG << "Current timestamp is [" << timestamp_ << "]";
+
+  // The container is only changed here, in the calling thread: the new
+  // obstacles are added first, so that no pointer looked up afterwards is
+  // invalidated by an eviction.
+  std::vector<const PerceptionObstacle*> insertables;
   for (const PerceptionObstacle& perception_obstacle :
        perception_obstacles.perception_obstacle()) {
     ADEBUG << "Perception obstacle [" << perception_obstacle.id() << "] "
            << "was detected";
-    InsertPerceptionObstacle(perception_obstacle, timestamp_);
-    ADEBUG << "Perception obstacle [" << perception_obstacle.id() << "] "
-           << "was inserted";
+    if (!IsInsertable(perception_obstacle)) {
+      continue;
+    }
+    insertables.push_back(&perception_obstacle);
+    if (obstacles_.GetSilently(perception_obstacle.id()) == nullptr) {
+      obstacles_.Put(perception_obstacle.id(), Obstacle());
+    }
+  }
+
+  // The obstacles are then updated in parallel; they share nothing but the
+  // map, which is only read. The perception obstacles of one id are all
+  // inserted, in order, by the same task.
+  std::vector<Obstacle*> obstacle_ptrs;
+  std::vector<std::vector<const PerceptionObstacle*>> updates;
+  std::unordered_map<Obstacle*, std::size_t> update_indices;
+  for (const PerceptionObstacle* perception_obstacle : insertables) {
+    Obstacle* obstacle_ptr = obstacles_.GetSilently(perception_obstacle->id());
+    if (obstacle_ptr == nullptr) {
+      // Evicted by the obstacles added after it.
+      continue;
+    }
+    auto result = update_indices.emplace(obstacle_ptr, obstacle_ptrs.size());
+    if (result.second) {
+      obstacle_ptrs.push_back(obstacle_ptr);
+      updates.emplace_back();
+    }
+    updates[result.first->second].push_back(perception_obstacle);
   }
+  PredictionThreadPool::instance()->ParallelFor(
+      obstacle_ptrs.size(), [&](const std::size_t i) {
+        for (const PerceptionObstacle* perception_obstacle : updates[i]) {
+          obstacle_ptrs[i]->Insert(*perception_obstacle, timestamp_);
+          ADEBUG << "Perception obstacle [" << perception_obstacle->id()
+                 << "] was inserted";
+        }
+      });
 }
 
 Obstacle* ObstaclesContainer::GetObstacle(const int id) {
@@ -72,15 +112,10 @@ void ObstaclesContainer::Clear() {
 
 void ObstaclesContainer::InsertPerceptionObstacle(
     const PerceptionObstacle& perception_obstacle, const double timestamp) {
-  const int id = perception_obstacle.id();
-  if (id < -1) {
-    AERROR << "Invalid ID [" << id << "]";
-    return;
-  }
-  if (!IsPredictable(perception_obstacle)) {
-    ADEBUG << "Perception obstacle [" << id << "] is not predictable.";
+  if (!IsInsertable(perception_obstacle)) {
     return;
   }
+  const int id = perception_obstacle.id();
   Obstacle* obstacle_ptr = obstacles_.GetSilently(id);
   if (obstacle_ptr != nullptr) {
     obstacle_ptr->Insert(perception_obstacle, timestamp);
@@ -91,6 +126,20 @@ void ObstaclesContainer::InsertPerceptionObstacle(
   }
 }
 
+bool ObstaclesContainer::IsInsertable(
+    const PerceptionObstacle& perception_obstacle) {
+  const int id = perception_obstacle.id();
+  if (id < -1) {
+    AERROR << "Invalid ID [" << id << "]";
+    return false;
+  }
+  if (!IsPredictable(perception_obstacle)) {
+    ADEBUG << "Perception obstacle [" << id << "] is not predictable.";
+    return false;
+  }
+  return true;
+}
+
 bool ObstaclesContainer::IsPredictable(
     const PerceptionObstacle& perception_obstacle) {
   if (!perception_obstacle.has_type() ||
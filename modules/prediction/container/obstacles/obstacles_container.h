@@ -70,6 +70,13 @@ class ObstaclesContainer : public Container {
   void Clear();
 
  private:
+  /**
+   * @brief Check if a perception obstacle has a valid id and is predictable
+   * @param A perception obstacle
+   * @return True if the perception obstacle can be inserted
+   */
+  bool IsInsertable(const perception::PerceptionObstacle& perception_obstacle);
+
   /**
    * @brief Check if an obstacle is predictable
    * @param An obstacle
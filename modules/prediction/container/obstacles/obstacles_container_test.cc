@@ -26,6 +26,7 @@
 #include "modules/map/hdmap/hdmap.h"
 #include "modules/prediction/common/kml_map_based_test.h"
 #include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_thread_pool.h"
 #include "modules/prediction/container/obstacles/obstacle.h"
 
 namespace apollo {
@@ -91,5 +92,24 @@ TEST_F(ObstaclesContainerTest, ClearAll) {
   EXPECT_TRUE(container_.GetObstacle(102) == nullptr);
 }
 
+TEST_F(ObstaclesContainerTest, ParallelInsert) {
+  // container_ was filled in the calling thread, before the pool exists.
+  PredictionThreadPool::instance()->Init();
+  std::string file =
+      "modules/prediction/testdata/perception_vehicles_pedestrians.pb.txt";
+  perception::PerceptionObstacles perception_obstacles;
+  common::util::GetProtoFromFile(file, &perception_obstacles);
+  ObstaclesContainer container;
+  container.Insert(perception_obstacles);
+  for (const int id : {0, 1, 2, 3, 101, 102}) {
+    Obstacle* expected_obstacle_ptr = container_.GetObstacle(id);
+    Obstacle* obstacle_ptr = container.GetObstacle(id);
+    ASSERT_TRUE(expected_obstacle_ptr != nullptr);
+    ASSERT_TRUE(obstacle_ptr != nullptr);
+    EXPECT_EQ(expected_obstacle_ptr->latest_feature().SerializeAsString(),
+              obstacle_ptr->latest_feature().SerializeAsString());
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/prediction/container/obstacles_prioritizer.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "modules/common/log.h"
+#include "modules/common/math/vec2d.h"
+#include "modules/common/time/time.h"
+#include "modules/prediction/common/prediction_gflags.h"
+
+namespace apollo {
+namespace prediction {
+
+using apollo::common::math::Vec2d;
+using apollo::common::time::Clock;
+using apollo::perception::PerceptionObstacles;
+
+ObstaclesPrioritizer::ObstaclesPrioritizer() {}
+
+void ObstaclesPrioritizer::Prioritize(
+    const PerceptionObstacles& perception_obstacles,
+    ObstaclesContainer* obstacles_container,
+    const ADCTrajectoryContainer& adc_trajectory_container) {
+  CHECK_NOTNULL(obstacles_container);
+  start_time_ = Clock::NowInSeconds();
+  ranks_.clear();
+
+  std::vector<std::pair<double, int>> distances;
+  for (const auto& perception_obstacle :
+       perception_obstacles.perception_obstacle()) {
+    if (!perception_obstacle.has_id() || perception_obstacle.id() < 0) {
+      continue;
+    }
+    const int id = perception_obstacle.id();
+    const Obstacle* obstacle = obstacles_container->GetObstacle(id);
+    if (obstacle == nullptr || obstacle->history_size() == 0) {
+      continue;
+    }
+    const Feature& feature = obstacle->latest_feature();
+    const Vec2d position(feature.position().x(), feature.position().y());
+    const Vec2d velocity(feature.velocity().x(), feature.velocity().y());
+    distances.emplace_back(
+        adc_trajectory_container.InteractionDistance(position, velocity), id);
+  }
+
+  // Obstacles at the same distance keep the order of perception.
+  std::stable_sort(distances.begin(), distances.end(),
+                   [](const std::pair<double, int>& lhs,
+                      const std::pair<double, int>& rhs) {
+                     return lhs.first < rhs.first;
+                   });
+  const int num_prioritized =
+      std::min(static_cast<int>(distances.size()),
+               std::max(0, FLAGS_max_num_prioritized_obstacles));
+  for (int i = 0; i < num_prioritized; ++i) {
+    ranks_[distances[i].second] = i;
+  }
+  ADEBUG << "Prioritized " << num_prioritized << " of " << distances.size()
+         << " obstacles.";
+}
+
+bool ObstaclesPrioritizer::IsPrioritized(const int id) const {
+  return ranks_.find(id) != ranks_.end();
+}
+
+int ObstaclesPrioritizer::Rank(const int id) const {
+  auto it = ranks_.find(id);
+  return it != ranks_.end() ? it->second : static_cast<int>(ranks_.size());
+}
+
+bool ObstaclesPrioritizer::IsOverBudget() const {
+  return Clock::NowInSeconds() - start_time_ > FLAGS_prediction_time_budget;
+}
+
+}  // namespace prediction
+}  // namespace apollo
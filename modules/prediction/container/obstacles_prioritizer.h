@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ * @brief Rank the obstacles of a frame by their interaction with the ADC
+ */
+
+#ifndef MODULES_PREDICTION_CONTAINER_OBSTACLES_PRIORITIZER_H_
+#define MODULES_PREDICTION_CONTAINER_OBSTACLES_PRIORITIZER_H_
+
+#include <unordered_map>
+
+#include "modules/perception/proto/perception_obstacle.pb.h"
+
+#include "modules/common/macro.h"
+#include "modules/prediction/container/adc_trajectory/adc_trajectory_container.h"
+#include "modules/prediction/container/obstacles/obstacles_container.h"
+
+namespace apollo {
+namespace prediction {
+
+class ObstaclesPrioritizer {
+ public:
+  /**
+   * @brief Rank the obstacles of a frame by their interaction distance with
+   *        the ADC trajectory, keep the closest ones as prioritized, and
+   *        start the time budget of the frame.
+   * @param perception_obstacles The perception obstacles of the frame
+   * @param obstacles_container The container of the obstacles
+   * @param adc_trajectory_container The container of the ADC trajectory
+   */
+  void Prioritize(
+      const perception::PerceptionObstacles& perception_obstacles,
+      ObstaclesContainer* obstacles_container,
+      const ADCTrajectoryContainer& adc_trajectory_container);
+
+  /**
+   * @brief Check if an obstacle is prioritized in the current frame
+   * @param id The obstacle id
+   * @return True if the obstacle is prioritized
+   */
+  bool IsPrioritized(const int id) const;
+
+  /**
+   * @brief Get the rank of an obstacle in the current frame
+   * @param id The obstacle id
+   * @return The rank, from 0 for the closest obstacle, or the number of
+   *         prioritized obstacles if the obstacle is not prioritized
+   */
+  int Rank(const int id) const;
+
+  /**
+   * @brief Check if the time budget of the current frame is used up
+   * @return True if the time budget is used up
+   */
+  bool IsOverBudget() const;
+
+ private:
+  // The ranks of the prioritized obstacles, by id.
+  std::unordered_map<int, int> ranks_;
+  double start_time_ = 0.0;
+
+  DECLARE_SINGLETON(ObstaclesPrioritizer)
+};
+
+}  // namespace prediction
+}  // namespace apollo
+
+#endif  // MODULES_PREDICTION_CONTAINER_OBSTACLES_PRIORITIZER_H_
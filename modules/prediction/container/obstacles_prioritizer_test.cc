@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/prediction/container/obstacles_prioritizer.h"
+
+#include <cmath>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "modules/common/util/file.h"
+#include "modules/planning/proto/planning.pb.h"
+#include "modules/prediction/common/kml_map_based_test.h"
+#include "modules/prediction/common/prediction_gflags.h"
+
+namespace apollo {
+namespace prediction {
+
+using apollo::common::math::Vec2d;
+using apollo::perception::PerceptionObstacles;
+using apollo::planning::ADCTrajectory;
+
+class ObstaclesPrioritizerTest : public KMLMapBasedTest {
+ public:
+  void SetUp() override {
+    std::string file =
+        "modules/prediction/testdata/perception_vehicles_pedestrians.pb.txt";
+    CHECK(apollo::common::util::GetProtoFromFile(file, &perception_obstacles_));
+    obstacles_container_.Insert(perception_obstacles_);
+  }
+
+ protected:
+  PerceptionObstacles perception_obstacles_;
+  ObstaclesContainer obstacles_container_;
+  ADCTrajectoryContainer adc_trajectory_container_;
+};
+
+TEST_F(ObstaclesPrioritizerTest, InteractionDistance) {
+  const Vec2d position(-438.879, -161.931);
+  const Vec2d velocity(1.0, 0.0);
+  EXPECT_TRUE(std::isinf(
+      adc_trajectory_container_.InteractionDistance(position, velocity)));
+
+  adc_trajectory_container_.SetPosition({-438.879, -156.931});
+  EXPECT_NEAR(5.0,
+              adc_trajectory_container_.InteractionDistance(position, velocity),
+              1e-9);
+
+  // The obstacle reaches the trajectory point at the time of the point.
+  ADCTrajectory adc_trajectory;
+  auto* trajectory_point = adc_trajectory.add_trajectory_point();
+  trajectory_point->set_relative_time(-1.0);
+  trajectory_point->mutable_path_point()->set_x(-438.879);
+  trajectory_point->mutable_path_point()->set_y(-161.931);
+  trajectory_point = adc_trajectory.add_trajectory_point();
+  trajectory_point->set_relative_time(2.0);
+  trajectory_point->mutable_path_point()->set_x(-436.879);
+  trajectory_point->mutable_path_point()->set_y(-160.931);
+  adc_trajectory_container_.Insert(adc_trajectory);
+  EXPECT_NEAR(1.0,
+              adc_trajectory_container_.InteractionDistance(position, velocity),
+              1e-9);
+}
+
+TEST_F(ObstaclesPrioritizerTest, Prioritize) {
+  FLAGS_max_num_prioritized_obstacles = 2;
+  // Next to the pedestrian 101, then the vehicles 0 and 3.
+  adc_trajectory_container_.SetPosition({-438.879, -161.931});
+  ObstaclesPrioritizer* prioritizer = ObstaclesPrioritizer::instance();
+  prioritizer->Prioritize(perception_obstacles_, &obstacles_container_,
+                          adc_trajectory_container_);
+
+  EXPECT_TRUE(prioritizer->IsPrioritized(101));
+  EXPECT_TRUE(prioritizer->IsPrioritized(0));
+  EXPECT_FALSE(prioritizer->IsPrioritized(3));
+  EXPECT_FALSE(prioritizer->IsPrioritized(102));
+  EXPECT_EQ(0, prioritizer->Rank(101));
+  EXPECT_EQ(1, prioritizer->Rank(0));
+  EXPECT_EQ(2, prioritizer->Rank(3));
+
+  FLAGS_prediction_time_budget = 1e3;
+  EXPECT_FALSE(prioritizer->IsOverBudget());
+  FLAGS_prediction_time_budget = -1.0;
+  EXPECT_TRUE(prioritizer->IsOverBudget());
+}
+
+}  // namespace prediction
+}  // namespace apollo
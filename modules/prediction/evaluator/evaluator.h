@@ -51,6 +51,17 @@ class Evaluator {
    * @param Obstacle pointer
    */
   virtual void Evaluate(Obstacle* obstacle) = 0;
+
+  /**
+   * @brief Evaluate the obstacles of a frame together, so that an evaluator
+   *        can batch its work. Evaluates them one by one by default.
+   * @param Obstacle pointers
+   */
+  virtual void BatchEvaluate(const std::vector<Obstacle*>& obstacles) {
+    for (Obstacle* obstacle : obstacles) {
+      Evaluate(obstacle);
+    }
+  }
 };
 
 }  // namespace prediction
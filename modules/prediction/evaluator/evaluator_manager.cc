@@ -16,9 +16,15 @@
 
 #include "modules/prediction/evaluator/evaluator_manager.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "modules/common/log.h"
+#include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/container/container_manager.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
+#include "modules/prediction/container/obstacles_prioritizer.h"
 #include "modules/prediction/evaluator/vehicle/mlp_evaluator.h"
 #include "modules/prediction/evaluator/vehicle/rnn_evaluator.h"
 
@@ -94,6 +100,8 @@ void EvaluatorManager::Run(
           AdapterConfig::PERCEPTION_OBSTACLES));
   CHECK_NOTNULL(container);
 
+  // The obstacles of every evaluator, in the order the evaluators are met.
+  std::vector<std::pair<Evaluator*, std::vector<Obstacle*>>> batches;
   Evaluator* evaluator = nullptr;
   for (const auto& perception_obstacle :
        perception_obstacles.perception_obstacle()) {
@@ -112,6 +120,12 @@ void EvaluatorManager::Run(
     if (obstacle == nullptr) {
       continue;
     }
+    // Only the prioritized obstacles are predicted by the predictors which
+    // use the evaluations.
+    if (FLAGS_enable_obstacles_prioritization &&
+        !ObstaclesPrioritizer::instance()->IsPrioritized(id)) {
+      continue;
+    }
 
     switch (perception_obstacle.type()) {
       case PerceptionObstacle::VEHICLE: {
@@ -139,9 +153,22 @@ void EvaluatorManager::Run(
         break;
       }
     }
-    if (evaluator != nullptr) {
-      evaluator->Evaluate(obstacle);
+    if (evaluator == nullptr) {
+      continue;
     }
+    auto it = std::find_if(
+        batches.begin(), batches.end(),
+        [evaluator](const std::pair<Evaluator*, std::vector<Obstacle*>>&
+                        batch) { return batch.first == evaluator; });
+    if (it == batches.end()) {
+      batches.emplace_back(evaluator, std::vector<Obstacle*>());
+      it = batches.end() - 1;
+    }
+    it->second.push_back(obstacle);
+  }
+
+  for (const auto& batch : batches) {
+    batch.first->BatchEvaluate(batch.second);
   }
 }
 
@@ -19,11 +19,14 @@
 #include <cmath>
 #include <limits>
 #include <numeric>
+#include <string>
+#include <utility>
 
 #include "modules/common/math/math_utils.h"
 #include "modules/common/util/file.h"
 #include "modules/map/proto/map_lane.pb.h"
 #include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/common/prediction_thread_pool.h"
 #include "modules/prediction/common/prediction_util.h"
 
 namespace apollo {
@@ -51,12 +54,101 @@ void MLPEvaluator::Clear() { obstacle_feature_values_map_.clear(); }
 
 void MLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
   Clear();
+  LaneGraph* lane_graph_ptr = GetLaneGraph(obstacle_ptr);
+  if (lane_graph_ptr == nullptr) {
+    return;
+  }
+
+  for (int i = 0; i < lane_graph_ptr->lane_sequence_size(); ++i) {
+    LaneSequence* lane_sequence_ptr = lane_graph_ptr->mutable_lane_sequence(i);
+    CHECK(lane_sequence_ptr != nullptr);
+    std::vector<double> feature_values;
+    ExtractFeatureValues(obstacle_ptr, lane_sequence_ptr, &feature_values);
+    double probability = ComputeProbability(feature_values);
+    lane_sequence_ptr->set_probability(probability);
+  }
+}
+
+void MLPEvaluator::BatchEvaluate(const std::vector<Obstacle*>& obstacles) {
+  if (!FLAGS_enable_batched_mlp_evaluator) {
+    Evaluator::BatchEvaluate(obstacles);
+    return;
+  }
+  Clear();
+  CHECK_NOTNULL(model_ptr_.get());
+  const int dim_input = model_ptr_->dim_input();
+
+  // Gather the feature vectors of the lane sequences, in parallel over the
+  // obstacles, which only read the map. A lane sequence whose features are
+  // incomplete gets probability 0, as in ComputeProbability.
+  struct ObstacleRows {
+    std::vector<LaneSequence*> lane_sequences;
+    std::vector<float> rows;
+  };
+  std::vector<ObstacleRows> obstacle_rows(obstacles.size());
+  PredictionThreadPool::instance()->ParallelFor(
+      obstacles.size(), [&](const std::size_t index) {
+        Obstacle* obstacle_ptr = obstacles[index];
+        LaneGraph* lane_graph_ptr = GetLaneGraph(obstacle_ptr);
+        if (lane_graph_ptr == nullptr) {
+          return;
+        }
+        std::vector<double> obstacle_feature_values;
+        SetObstacleFeatureValues(obstacle_ptr, &obstacle_feature_values);
+        std::vector<double> lane_feature_values;
+        ObstacleRows* result = &obstacle_rows[index];
+        for (int i = 0; i < lane_graph_ptr->lane_sequence_size(); ++i) {
+          LaneSequence* lane_sequence_ptr =
+              lane_graph_ptr->mutable_lane_sequence(i);
+          CHECK(lane_sequence_ptr != nullptr);
+          SetLaneFeatureValues(obstacle_ptr, lane_sequence_ptr,
+                               &lane_feature_values);
+          if (obstacle_feature_values.size() != OBSTACLE_FEATURE_SIZE ||
+              lane_feature_values.size() != LANE_FEATURE_SIZE ||
+              static_cast<int>(OBSTACLE_FEATURE_SIZE + LANE_FEATURE_SIZE) !=
+                  dim_input) {
+            lane_sequence_ptr->set_probability(0.0);
+            continue;
+          }
+          result->lane_sequences.push_back(lane_sequence_ptr);
+          result->rows.insert(result->rows.end(),
+                              obstacle_feature_values.begin(),
+                              obstacle_feature_values.end());
+          result->rows.insert(result->rows.end(), lane_feature_values.begin(),
+                              lane_feature_values.end());
+        }
+      });
+
+  std::vector<LaneSequence*> lane_sequences;
+  std::vector<float> rows;
+  for (const ObstacleRows& result : obstacle_rows) {
+    lane_sequences.insert(lane_sequences.end(), result.lane_sequences.begin(),
+                          result.lane_sequences.end());
+    rows.insert(rows.end(), result.rows.begin(), result.rows.end());
+  }
+  if (lane_sequences.empty()) {
+    return;
+  }
+
+  const int num_rows = static_cast<int>(lane_sequences.size());
+  batch_feature_values_ =
+      Eigen::Map<const Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic,
+                                     Eigen::RowMajor>>(rows.data(), num_rows,
+                                                       dim_input);
+  Eigen::VectorXf probabilities;
+  ComputeProbabilities(&batch_feature_values_, &probabilities);
+  for (int i = 0; i < num_rows; ++i) {
+    lane_sequences[i]->set_probability(probabilities(i));
+  }
+}
+
+LaneGraph* MLPEvaluator::GetLaneGraph(Obstacle* obstacle_ptr) {
   CHECK_NOTNULL(obstacle_ptr);
 
   int id = obstacle_ptr->id();
   if (!obstacle_ptr->latest_feature().IsInitialized()) {
     AERROR << "Obstacle [" << id << "] has no latest feature.";
-    return;
+    return nullptr;
   }
 
   Feature* latest_feature_ptr = obstacle_ptr->mutable_latest_feature();
@@ -64,7 +156,7 @@ void MLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
   if (!latest_feature_ptr->has_lane() ||
       !latest_feature_ptr->lane().has_lane_graph()) {
     ADEBUG << "Obstacle [" << id << "] has no lane graph.";
-    return;
+    return nullptr;
   }
 
   LaneGraph* lane_graph_ptr =
@@ -72,17 +164,9 @@ void MLPEvaluator::Evaluate(Obstacle* obstacle_ptr) {
   CHECK_NOTNULL(lane_graph_ptr);
   if (lane_graph_ptr->lane_sequence_size() == 0) {
     AERROR << "Obstacle [" << id << "] has no lane sequences.";
-    return;
-  }
-
-  for (int i = 0; i < lane_graph_ptr->lane_sequence_size(); ++i) {
-    LaneSequence* lane_sequence_ptr = lane_graph_ptr->mutable_lane_sequence(i);
-    CHECK(lane_sequence_ptr != nullptr);
-    std::vector<double> feature_values;
-    ExtractFeatureValues(obstacle_ptr, lane_sequence_ptr, &feature_values);
-    double probability = ComputeProbability(feature_values);
-    lane_sequence_ptr->set_probability(probability);
+    return nullptr;
   }
+  return lane_graph_ptr;
 }
 
 void MLPEvaluator::ExtractFeatureValues(Obstacle* obstacle_ptr,
@@ -313,6 +397,49 @@ void MLPEvaluator::LoadModel(const std::string& model_file) {
       << "Unable to load model file: " << model_file << ".";
 
   AINFO << "Succeeded in loading the model file: " << model_file << ".";
+
+  const int dim_input = model_ptr_->dim_input();
+  samples_mean_.resize(dim_input);
+  samples_std_inverse_.resize(dim_input);
+  for (int i = 0; i < dim_input; ++i) {
+    // The same epsilon as math_util::Normalize.
+    samples_mean_(i) = model_ptr_->samples_mean().columns(i);
+    samples_std_inverse_(i) =
+        1.0 / (model_ptr_->samples_std().columns(i) + 1e-10);
+  }
+  batch_layers_.clear();
+  is_quantized_ = false;
+  for (const Layer& layer : model_ptr_->layer()) {
+    BatchLayer batch_layer;
+    batch_layer.bias.resize(layer.layer_output_dim());
+    for (int col = 0; col < layer.layer_output_dim(); ++col) {
+      batch_layer.bias(col) = layer.layer_bias().columns(col);
+    }
+    if (layer.has_layer_quantized_weight()) {
+      network::QuantizedMatrix* weights = &batch_layer.quantized_weights;
+      weights->rows = layer.layer_input_dim();
+      weights->cols = layer.layer_output_dim();
+      weights->scale = layer.layer_weight_scale();
+      const std::string& data = layer.layer_quantized_weight();
+      CHECK_EQ(data.size(),
+               static_cast<size_t>(weights->rows) * weights->cols)
+          << "Incorrect quantized weights in " << model_file;
+      weights->data.assign(data.begin(), data.end());
+      batch_layer.quantized = true;
+      is_quantized_ = true;
+    } else {
+      batch_layer.weights.resize(layer.layer_input_dim(),
+                                 layer.layer_output_dim());
+      for (int col = 0; col < layer.layer_output_dim(); ++col) {
+        for (int row = 0; row < layer.layer_input_dim(); ++row) {
+          batch_layer.weights(row, col) =
+              layer.layer_input_weight().rows(row).columns(col);
+        }
+      }
+    }
+    batch_layer.activation_func = layer.layer_activation_func();
+    batch_layers_.push_back(std::move(batch_layer));
+  }
 }
 
 double MLPEvaluator::ComputeProbability(
@@ -326,6 +453,16 @@ double MLPEvaluator::ComputeProbability(
            << "; feature value size = " << feature_values.size();
     return probability;
   }
+  // The int8 weights are only multiplied in batches.
+  if (is_quantized_) {
+    Eigen::MatrixXf sample(1, feature_values.size());
+    for (size_t i = 0; i < feature_values.size(); ++i) {
+      sample(0, i) = feature_values[i];
+    }
+    Eigen::VectorXf probabilities;
+    ComputeProbabilities(&sample, &probabilities);
+    return probabilities(0);
+  }
   std::vector<double> layer_input;
   layer_input.reserve(model_ptr_->dim_input());
   std::vector<double> layer_output;
@@ -376,5 +513,73 @@ double MLPEvaluator::ComputeProbability(
   return probability;
 }
 
+void MLPEvaluator::ComputeProbabilities(Eigen::MatrixXf* const feature_values,
+                                        Eigen::VectorXf* const probabilities) {
+  // normalization
+  Eigen::MatrixXf* layer_input = feature_values;
+  *layer_input = ((layer_input->rowwise() - samples_mean_).array().rowwise() *
+                  samples_std_inverse_.array())
+                     .matrix();
+
+  Eigen::MatrixXf* layer_output = &batch_layer_output_;
+  for (const BatchLayer& layer : batch_layers_) {
+    if (layer.quantized) {
+      network::QuantizedMultiply(*layer_input, layer.quantized_weights,
+                                 layer_output);
+    } else {
+      layer_output->noalias() = *layer_input * layer.weights;
+    }
+    // The bias and the activation are applied in one pass.
+    auto neuron_output = layer_output->rowwise() + layer.bias;
+    if (layer.activation_func == Layer::RELU) {
+      *layer_output = neuron_output.cwiseMax(0.0f);
+    } else if (layer.activation_func == Layer::TANH) {
+      // tanh(x) = 1 - 2 / (exp(2x) + 1), as Eigen 3.2 has no array tanh.
+      *layer_output =
+          (1.0f - 2.0f * ((2.0f * neuron_output.array()).exp() + 1.0f)
+                             .inverse())
+              .matrix();
+    } else {
+      if (layer.activation_func != Layer::SIGMOID) {
+        AERROR << "Undefined activation function [" << layer.activation_func
+               << "]. A default sigmoid will be used instead.";
+      }
+      *layer_output =
+          (1.0f + (-neuron_output.array()).exp()).inverse().matrix();
+    }
+    std::swap(layer_input, layer_output);
+  }
+
+  if (layer_input->cols() != 1) {
+    AERROR << "Model output layer has incorrect # outputs: "
+           << layer_input->cols();
+    probabilities->setZero(layer_input->rows());
+  } else {
+    *probabilities = layer_input->col(0);
+  }
+}
+
+void MLPEvaluator::QuantizeModel(FnnVehicleModel* model) {
+  CHECK_NOTNULL(model);
+  for (Layer& layer : *model->mutable_layer()) {
+    if (layer.has_layer_quantized_weight()) {
+      continue;
+    }
+    Eigen::MatrixXf weights(layer.layer_input_dim(), layer.layer_output_dim());
+    for (int row = 0; row < layer.layer_input_dim(); ++row) {
+      for (int col = 0; col < layer.layer_output_dim(); ++col) {
+        weights(row, col) = layer.layer_input_weight().rows(row).columns(col);
+      }
+    }
+    network::QuantizedMatrix quantized;
+    network::QuantizeMatrix(weights, &quantized);
+    layer.set_layer_quantized_weight(
+        reinterpret_cast<const char*>(quantized.data.data()),
+        quantized.data.size());
+    layer.set_layer_weight_scale(quantized.scale);
+    layer.clear_layer_input_weight();
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
@@ -22,8 +22,11 @@
 #include <unordered_map>
 #include <vector>
 
+#include "Eigen/Dense"
+
 #include "modules/prediction/container/obstacles/obstacle.h"
 #include "modules/prediction/evaluator/evaluator.h"
+#include "modules/prediction/network/net_util.h"
 #include "modules/prediction/proto/fnn_vehicle_model.pb.h"
 #include "modules/prediction/proto/lane_graph.pb.h"
 
@@ -48,6 +51,15 @@ class MLPEvaluator : public Evaluator {
    */
   void Evaluate(Obstacle* obstacle_ptr) override;
 
+  /**
+   * @brief Override BatchEvaluate. With FLAGS_enable_batched_mlp_evaluator,
+   *        the feature vectors of all the lane sequences of the obstacles
+   *        are stacked into one matrix, and every layer of the model runs
+   *        once on the matrix instead of once per lane sequence.
+   * @param Obstacle pointers
+   */
+  void BatchEvaluate(const std::vector<Obstacle*>& obstacles) override;
+
   /**
    * @brief Extract feature vector
    * @param Obstacle pointer
@@ -62,7 +74,30 @@ class MLPEvaluator : public Evaluator {
    */
   void Clear();
 
+  /**
+   * @brief Compute the probabilities of a batch, with the float or the int8
+   *        weights of the model
+   * @param Feature values, a row per sample, overwritten by the layers
+   *        Probabilities, one per row of the feature values
+   */
+  void ComputeProbabilities(Eigen::MatrixXf* const feature_values,
+                            Eigen::VectorXf* const probabilities);
+
+  /**
+   * @brief Quantize the weights of a model to int8 in place, replacing the
+   *        float weights of every layer by layer_quantized_weight
+   * @param Model
+   */
+  static void QuantizeModel(FnnVehicleModel* model);
+
  private:
+  /**
+   * @brief Get the lane graph of an obstacle to evaluate
+   * @param Obstacle pointer
+   * @return The lane graph, nullptr if the obstacle has no lane sequence
+   */
+  LaneGraph* GetLaneGraph(Obstacle* obstacle_ptr);
+
   /**
    * @brief Set obstacle feature vector
    * @param Obstacle pointer
@@ -93,11 +128,32 @@ class MLPEvaluator : public Evaluator {
   double ComputeProbability(const std::vector<double>& feature_values);
 
  private:
+  /**
+   * @brief A layer of the model in float or int8 matrices, for batches.
+   */
+  struct BatchLayer {
+    Eigen::MatrixXf weights;  // input_dim x output_dim
+    // The int8 weights which replace the float weights of a quantized model.
+    bool quantized = false;
+    network::QuantizedMatrix quantized_weights;
+    Eigen::RowVectorXf bias;
+    Layer::ActivationFunc activation_func;
+  };
+
   std::unordered_map<int, std::vector<double>> obstacle_feature_values_map_;
   static const size_t OBSTACLE_FEATURE_SIZE = 22;
   static const size_t LANE_FEATURE_SIZE = 40;
 
   std::unique_ptr<FnnVehicleModel> model_ptr_;
+
+  // The normalization and the layers of the model for batches, and the
+  // buffers of a batch, which are kept from frame to frame.
+  Eigen::RowVectorXf samples_mean_;
+  Eigen::RowVectorXf samples_std_inverse_;
+  std::vector<BatchLayer> batch_layers_;
+  bool is_quantized_ = false;
+  Eigen::MatrixXf batch_feature_values_;
+  Eigen::MatrixXf batch_layer_output_;
 };
 
 }  // namespace prediction
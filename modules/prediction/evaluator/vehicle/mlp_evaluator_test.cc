@@ -16,6 +16,7 @@
 
 #include "modules/prediction/evaluator/vehicle/mlp_evaluator.h"
 
+#include <cstdio>
 #include <string>
 #include <vector>
 
@@ -64,5 +65,69 @@ TEST_F(MLPEvaluatorTest, OnLaneCase) {
   }
 }
 
+TEST_F(MLPEvaluatorTest, BatchOnLaneCase) {
+  MLPEvaluator mlp_evaluator;
+  ObstaclesContainer container;
+  container.Insert(perception_obstacles_);
+  Obstacle* obstacle_ptr = container.GetObstacle(1);
+  EXPECT_TRUE(obstacle_ptr != nullptr);
+  mlp_evaluator.Evaluate(obstacle_ptr);
+  const LaneGraph expected_lane_graph =
+      obstacle_ptr->latest_feature().lane().lane_graph();
+
+  FLAGS_enable_batched_mlp_evaluator = true;
+  mlp_evaluator.BatchEvaluate({obstacle_ptr});
+  const LaneGraph& lane_graph =
+      obstacle_ptr->latest_feature().lane().lane_graph();
+  EXPECT_EQ(expected_lane_graph.lane_sequence_size(),
+            lane_graph.lane_sequence_size());
+  for (int i = 0; i < lane_graph.lane_sequence_size(); ++i) {
+    EXPECT_TRUE(lane_graph.lane_sequence(i).has_probability());
+    EXPECT_NEAR(expected_lane_graph.lane_sequence(i).probability(),
+                lane_graph.lane_sequence(i).probability(), 1e-5);
+  }
+}
+
+TEST_F(MLPEvaluatorTest, QuantizedOnLaneCase) {
+  MLPEvaluator mlp_evaluator;
+  ObstaclesContainer container;
+  container.Insert(perception_obstacles_);
+  Obstacle* obstacle_ptr = container.GetObstacle(1);
+  EXPECT_TRUE(obstacle_ptr != nullptr);
+  mlp_evaluator.Evaluate(obstacle_ptr);
+  const LaneGraph expected_lane_graph =
+      obstacle_ptr->latest_feature().lane().lane_graph();
+
+  FnnVehicleModel model;
+  ASSERT_TRUE(apollo::common::util::GetProtoFromFile(
+      FLAGS_evaluator_vehicle_mlp_file, &model));
+  MLPEvaluator::QuantizeModel(&model);
+  for (const auto& layer : model.layer()) {
+    EXPECT_FALSE(layer.has_layer_input_weight());
+    EXPECT_EQ(layer.layer_input_dim() * layer.layer_output_dim(),
+              static_cast<int>(layer.layer_quantized_weight().size()));
+  }
+  const std::string float_model_file = FLAGS_evaluator_vehicle_mlp_file;
+  FLAGS_evaluator_vehicle_mlp_file = "mlp_evaluator_test_int8_model.bin";
+  ASSERT_TRUE(apollo::common::util::SetProtoToBinaryFile(
+      model, FLAGS_evaluator_vehicle_mlp_file));
+  MLPEvaluator quantized_evaluator;
+  std::remove(FLAGS_evaluator_vehicle_mlp_file.c_str());
+  FLAGS_evaluator_vehicle_mlp_file = float_model_file;
+
+  for (const bool batched : {false, true}) {
+    FLAGS_enable_batched_mlp_evaluator = batched;
+    quantized_evaluator.BatchEvaluate({obstacle_ptr});
+    const LaneGraph& lane_graph =
+        obstacle_ptr->latest_feature().lane().lane_graph();
+    ASSERT_EQ(expected_lane_graph.lane_sequence_size(),
+              lane_graph.lane_sequence_size());
+    for (int i = 0; i < lane_graph.lane_sequence_size(); ++i) {
+      EXPECT_NEAR(expected_lane_graph.lane_sequence(i).probability(),
+                  lane_graph.lane_sequence(i).probability(), 0.05);
+    }
+  }
+}
+
 }  // namespace prediction
 }  // namespace apollo
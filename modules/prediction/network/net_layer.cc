@@ -67,9 +67,11 @@ bool Dense::Load(const LayerParameter& layer_pb) {
   }
   if (!dense_pb.has_activation()) {
     ADEBUG << "Set activation as linear function";
-    kactivation_ = serialize_to_function("linear");
-  } else {
-    kactivation_ = serialize_to_function(dense_pb.activation());
+    activation_ = ActivationType::LINEAR;
+  } else if (!serialize_to_activation_type(dense_pb.activation(),
+                                           &activation_)) {
+    AERROR << "Fail to Load activation!";
+    return false;
   }
   units_ = dense_pb.units();
   return true;
@@ -78,12 +80,21 @@ bool Dense::Load(const LayerParameter& layer_pb) {
 void Dense::Run(const std::vector<Eigen::MatrixXf>& inputs,
                 Eigen::MatrixXf* output) {
   CHECK_EQ(inputs.size(), 1);
-  Eigen::MatrixXf prod = inputs[0] * weights_;
-  if (use_bias_) {
-    Eigen::MatrixXf sum = prod.rowwise() + bias_.transpose();
-    prod = sum;
+  RunSingle(inputs[0], output);
+}
+
+void Dense::RunSingle(const Eigen::MatrixXf& input, Eigen::MatrixXf* output) {
+  CHECK_NE(&input, output);
+  output->noalias() = input * weights_;
+  if (use_bias_ && output->rows() == 1) {
+    ApplyActivation(activation_, bias_.array(),
+                    Eigen::Map<Eigen::ArrayXf>(output->data(), units_));
+  } else {
+    if (use_bias_) {
+      output->rowwise() += bias_.transpose();
+    }
+    ApplyActivation(activation_, output);
   }
-  *output = prod.unaryExpr(kactivation_);
   CHECK_EQ(output->cols(), units_);
 }
 
@@ -93,10 +104,11 @@ bool Activation::Load(const LayerParameter& layer_pb) {
     return false;
   }
   if (!layer_pb.has_activation()) {
-    kactivation_ = serialize_to_function("linear");
-  } else {
-    ActivationParameter activation_pb = layer_pb.activation();
-    kactivation_ = serialize_to_function(activation_pb.activation());
+    activation_ = ActivationType::LINEAR;
+  } else if (!serialize_to_activation_type(
+                 layer_pb.activation().activation(), &activation_)) {
+    AERROR << "Fail to Load activation!";
+    return false;
   }
   return true;
 }
@@ -104,7 +116,13 @@ bool Activation::Load(const LayerParameter& layer_pb) {
 void Activation::Run(const std::vector<Eigen::MatrixXf>& inputs,
                      Eigen::MatrixXf* output) {
   CHECK_EQ(inputs.size(), 1);
-  *output = inputs[0].unaryExpr(kactivation_);
+  RunSingle(inputs[0], output);
+}
+
+void Activation::RunSingle(const Eigen::MatrixXf& input,
+                           Eigen::MatrixXf* output) {
+  *output = input;
+  ApplyActivation(activation_, output);
 }
 
 bool BatchNormalization::Load(const LayerParameter& layer_pb) {
@@ -139,22 +157,28 @@ bool BatchNormalization::Load(const LayerParameter& layer_pb) {
       return false;
     }
   }
+  folded_scale_ =
+      (sigma_.array().sqrt() + epsilon_).inverse().matrix().transpose();
+  if (scale_) {
+    folded_scale_ = folded_scale_.cwiseProduct(gamma_.transpose());
+  }
+  folded_shift_ = -mu_.transpose().cwiseProduct(folded_scale_);
+  if (center_) {
+    folded_shift_ += beta_.transpose();
+  }
   return true;
 }
 
 void BatchNormalization::Run(const std::vector<Eigen::MatrixXf>& inputs,
                              Eigen::MatrixXf* output) {
   CHECK_EQ(inputs.size(), 1);
-  Eigen::MatrixXf temp = (inputs[0].rowwise() - mu_.transpose());
-  Eigen::MatrixXf norm =
-      temp.array().rowwise() / (sigma_.array().sqrt() + epsilon_).transpose();
-  if (scale_) {
-    norm = norm.array().rowwise() * gamma_.transpose().array();
-  }
-  if (center_) {
-    norm = norm.rowwise() + beta_.transpose();
-  }
-  *output = norm;
+  RunSingle(inputs[0], output);
+}
+
+void BatchNormalization::RunSingle(const Eigen::MatrixXf& input,
+                                   Eigen::MatrixXf* output) {
+  *output = (input.array().rowwise() * folded_scale_.array()).matrix();
+  output->rowwise() += folded_shift_;
 }
 
 bool LSTM::Load(const LayerParameter& layer_pb) {
@@ -183,16 +207,19 @@ bool LSTM::Load(const LayerParameter& layer_pb) {
   }
   if (!lstm_pb.has_activation()) {
     ADEBUG << "Set activation function as tanh.";
-    kactivation_ = serialize_to_function("tanh");
-  } else {
-    kactivation_ = serialize_to_function(lstm_pb.activation());
+    activation_ = ActivationType::TANH;
+  } else if (!serialize_to_activation_type(lstm_pb.activation(),
+                                           &activation_)) {
+    AERROR << "Fail to Load activation!";
+    return false;
   }
   if (!lstm_pb.has_recurrent_activation()) {
-    ADEBUG << "Set recurrent_activation function as hard_tanh.";
-    krecurrent_activation_ = serialize_to_function("hard_tanh");
-  } else {
-    krecurrent_activation_ =
-        serialize_to_function(lstm_pb.recurrent_activation());
+    ADEBUG << "Set recurrent_activation function as hard_sigmoid.";
+    recurrent_activation_ = ActivationType::HARD_SIGMOID;
+  } else if (!serialize_to_activation_type(lstm_pb.recurrent_activation(),
+                                           &recurrent_activation_)) {
+    AERROR << "Fail to Load recurrent activation!";
+    return false;
   }
   if (!lstm_pb.has_use_bias()) {
     ADEBUG << "Set use_bias as true.";
@@ -262,43 +289,82 @@ bool LSTM::Load(const LayerParameter& layer_pb) {
     AERROR << "Fail to Load reccurent output weights!";
     return false;
   }
+
+  const int input_dim = static_cast<int>(wi_.rows());
+  for (const Eigen::MatrixXf* weights : {&wi_, &wf_, &wc_, &wo_}) {
+    if (weights->rows() != input_dim || weights->cols() != units_) {
+      AERROR << "Fail to Load weights of shape (" << input_dim << ", "
+             << units_ << ")!";
+      return false;
+    }
+  }
+  for (const Eigen::MatrixXf* weights : {&r_wi_, &r_wf_, &r_wc_, &r_wo_}) {
+    if (weights->rows() != units_ || weights->cols() != units_) {
+      AERROR << "Fail to Load recurrent weights of shape (" << units_ << ", "
+             << units_ << ")!";
+      return false;
+    }
+  }
+  for (const Eigen::VectorXf* bias : {&bi_, &bf_, &bc_, &bo_}) {
+    if (bias->size() != units_) {
+      AERROR << "Fail to Load bias of size " << units_ << "!";
+      return false;
+    }
+  }
+  gate_weights_.resize(input_dim, 4 * units_);
+  gate_weights_ << wi_, wf_, wc_, wo_;
+  gate_recurrent_weights_.resize(units_, 4 * units_);
+  gate_recurrent_weights_ << r_wi_, r_wf_, r_wc_, r_wo_;
+  gate_bias_.resize(4 * units_);
+  gate_bias_ << bi_.transpose(), bf_.transpose(), bc_.transpose(),
+      bo_.transpose();
   ResetState();
   return true;
 }
 
-void LSTM::Step(const Eigen::MatrixXf& input, Eigen::MatrixXf* output,
+void LSTM::Step(const Eigen::Ref<const Eigen::RowVectorXf>& input_projection,
                 Eigen::MatrixXf* ht_1, Eigen::MatrixXf* ct_1) {
-  Eigen::MatrixXf x_i = input * wi_ + bi_.transpose();
-  Eigen::MatrixXf x_f = input * wf_ + bf_.transpose();
-  Eigen::MatrixXf x_c = input * wc_ + bc_.transpose();
-  Eigen::MatrixXf x_o = input * wo_ + bo_.transpose();
-
-  Eigen::MatrixXf i = (x_i + (*ht_1) * r_wi_).unaryExpr(krecurrent_activation_);
-  Eigen::MatrixXf f = (x_f + (*ht_1) * r_wf_).unaryExpr(krecurrent_activation_);
-  Eigen::MatrixXf c =
-      f.array() * ct_1->array() +
-      i.array() * ((x_c + (*ht_1) * r_wc_).unaryExpr(kactivation_)).array();
-  Eigen::MatrixXf o = (x_o + (*ht_1) * r_wo_).unaryExpr(krecurrent_activation_);
-  Eigen::MatrixXf h = o.array() * (c.unaryExpr(kactivation_)).array();
-
-  *ht_1 = h;
-  *ct_1 = c;
-  *output = h;
+  const int n = units_;
+  gates_.noalias() = (*ht_1) * gate_recurrent_weights_;
+  // The gates i, f, c and o of the step, each n wide.
+  Eigen::Map<Eigen::ArrayXf> gates(gates_.data(), 4 * n);
+  const Eigen::Map<const Eigen::ArrayXf> projection(input_projection.data(),
+                                                    4 * n);
+  ApplyActivation(recurrent_activation_, projection.head(2 * n),
+                  gates.head(2 * n));
+  ApplyActivation(activation_, projection.segment(2 * n, n),
+                  gates.segment(2 * n, n));
+  ApplyActivation(recurrent_activation_, projection.tail(n), gates.tail(n));
+
+  Eigen::Map<Eigen::ArrayXf> c(ct_1->data(), n);
+  c = gates.segment(n, n) * c + gates.head(n) * gates.segment(2 * n, n);
+  cell_activation_ = c;
+  ApplyActivation(activation_, cell_activation_);
+  Eigen::Map<Eigen::ArrayXf>(ht_1->data(), n) =
+      gates.tail(n) * cell_activation_;
 }
 
 void LSTM::Run(const std::vector<Eigen::MatrixXf>& inputs,
                Eigen::MatrixXf* output) {
   CHECK_EQ(inputs.size(), 1);
-  Eigen::MatrixXf sequences(inputs[0].rows(), units_);
-  Eigen::MatrixXf temp;
-  for (int i = 0; i < inputs[0].rows(); ++i) {
-    Step(inputs[0].row(i), &temp, &ht_1_, &ct_1_);
-    sequences.row(i) = temp.row(0);
-  }
+  RunSingle(inputs[0], output);
+}
+
+void LSTM::RunSingle(const Eigen::MatrixXf& input, Eigen::MatrixXf* output) {
+  // The input products of all the steps in one matrix product.
+  input_projections_.noalias() = input * gate_weights_;
+  input_projections_.rowwise() += gate_bias_;
   if (return_sequences_) {
-    *output = sequences;
-  } else {
-    *output = temp.row(0);
+    output->resize(input.rows(), units_);
+  }
+  for (int i = 0; i < input_projections_.rows(); ++i) {
+    Step(input_projections_.row(i), &ht_1_, &ct_1_);
+    if (return_sequences_) {
+      output->row(i) = ht_1_;
+    }
+  }
+  if (!return_sequences_) {
+    *output = ht_1_;
   }
 }
 
@@ -336,10 +402,17 @@ bool Flatten::Load(const LayerParameter& layer_pb) {
 void Flatten::Run(const std::vector<Eigen::MatrixXf>& inputs,
                   Eigen::MatrixXf* output) {
   CHECK_EQ(inputs.size(), 1);
-  Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> inp(
-      inputs[0]);
-  inp.resize(1, inp.size());
-  *output = inp;
+  RunSingle(inputs[0], output);
+}
+
+void Flatten::RunSingle(const Eigen::MatrixXf& input,
+                        Eigen::MatrixXf* output) {
+  CHECK_NE(&input, output);
+  // The rows of the input one after another.
+  output->resize(1, input.size());
+  Eigen::Map<
+      Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>>(
+      output->data(), input.rows(), input.cols()) = input;
 }
 
 bool Input::Load(const LayerParameter& layer_pb) {
@@ -375,8 +448,12 @@ bool Input::Load(const LayerParameter& layer_pb) {
 void Input::Run(const std::vector<Eigen::MatrixXf>& inputs,
                 Eigen::MatrixXf* output) {
   CHECK_EQ(inputs.size(), 1);
-  CHECK_EQ(inputs[0].cols(), input_shape_.back());
-  *output = inputs[0];
+  RunSingle(inputs[0], output);
+}
+
+void Input::RunSingle(const Eigen::MatrixXf& input, Eigen::MatrixXf* output) {
+  CHECK_EQ(input.cols(), input_shape_.back());
+  *output = input;
 }
 
 bool Concatenate::Load(const LayerParameter& layer_pb) {
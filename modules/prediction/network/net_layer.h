@@ -84,6 +84,19 @@ class Layer {
   virtual void Run(const std::vector<Eigen::MatrixXf>& inputs,
                    Eigen::MatrixXf* output) = 0;
 
+  /**
+   * @brief Compute the layer output from a single input, without copying
+   *        the input into a vector. The output keeps its memory if its
+   *        shape does not change, so it can be reused from run to run;
+   *        it must not be the input.
+   * @param Input to a network layer
+   * @param Output of a network layer will be returned
+   */
+  virtual void RunSingle(const Eigen::MatrixXf& input,
+                         Eigen::MatrixXf* output) {
+    Run(std::vector<Eigen::MatrixXf>{input}, output);
+  }
+
   /**
    * @brief Name of a layer
    * @reture Name of a layer
@@ -127,12 +140,20 @@ class Dense : public Layer {
   void Run(const std::vector<Eigen::MatrixXf>& inputs,
            Eigen::MatrixXf* output) override;
 
+  /**
+   * @brief Compute the layer output from a single input
+   * @param Input to a network layer
+   * @param Output of a network layer will be returned
+   */
+  void RunSingle(const Eigen::MatrixXf& input,
+                 Eigen::MatrixXf* output) override;
+
  private:
   int units_;
   bool use_bias_;
   Eigen::MatrixXf weights_;
   Eigen::VectorXf bias_;
-  std::function<float(float)> kactivation_;
+  ActivationType activation_ = ActivationType::LINEAR;
 };
 
 /**
@@ -160,8 +181,16 @@ class Activation : public Layer {
   void Run(const std::vector<Eigen::MatrixXf>& inputs,
            Eigen::MatrixXf* output) override;
 
+  /**
+   * @brief Compute the layer output from a single input
+   * @param Input to a network layer
+   * @param Output of a network layer will be returned
+   */
+  void RunSingle(const Eigen::MatrixXf& input,
+                 Eigen::MatrixXf* output) override;
+
  private:
-  std::function<float(float)> kactivation_;
+  ActivationType activation_ = ActivationType::LINEAR;
 };
 
 /**
@@ -186,6 +215,14 @@ class BatchNormalization : public Layer {
   void Run(const std::vector<Eigen::MatrixXf>& inputs,
            Eigen::MatrixXf* output) override;
 
+  /**
+   * @brief Compute the layer output from a single input
+   * @param Input to a network layer
+   * @param Output of a network layer will be returned
+   */
+  void RunSingle(const Eigen::MatrixXf& input,
+                 Eigen::MatrixXf* output) override;
+
  private:
   Eigen::VectorXf mu_;
   Eigen::VectorXf sigma_;
@@ -196,6 +233,10 @@ class BatchNormalization : public Layer {
   int axis_ = 0;
   bool center_ = false;
   bool scale_ = false;
+
+  // The normalization folded into y = x * scale + shift, by column.
+  Eigen::RowVectorXf folded_scale_;
+  Eigen::RowVectorXf folded_shift_;
 };
 
 /**
@@ -220,6 +261,14 @@ class LSTM : public Layer {
   void Run(const std::vector<Eigen::MatrixXf>& inputs,
            Eigen::MatrixXf* output) override;
 
+  /**
+   * @brief Compute the layer output from a single input
+   * @param Input to a network layer
+   * @param Output of a network layer will be returned
+   */
+  void RunSingle(const Eigen::MatrixXf& input,
+                 Eigen::MatrixXf* output) override;
+
   /**
    * @brief Reset the internal state and memory cell state as zero-matrix
    */
@@ -240,12 +289,12 @@ class LSTM : public Layer {
  private:
   /**
    * @brief Compute the output of LSTM step by step
-   * @param Input of current step
-   * @param Output of current step
+   * @param Row of the input projections x * w + b of the current step, with
+   *        the input, forget, cell and output gates side by side
    * @param Hidden state of previous step and return current hidden state
    * @param Cell state of previous step and return current cell state
    */
-  void Step(const Eigen::MatrixXf& input, Eigen::MatrixXf* output,
+  void Step(const Eigen::Ref<const Eigen::RowVectorXf>& input_projection,
             Eigen::MatrixXf* ht_1, Eigen::MatrixXf* ct_1);
 
   Eigen::MatrixXf wi_;
@@ -262,10 +311,22 @@ class LSTM : public Layer {
   Eigen::MatrixXf r_wc_;
   Eigen::MatrixXf r_wo_;
 
+  // The weights and the biases of the four gates side by side, so that a
+  // step runs one recurrent product, and the input products of all the
+  // steps run as one matrix product.
+  Eigen::MatrixXf gate_weights_;
+  Eigen::MatrixXf gate_recurrent_weights_;
+  Eigen::RowVectorXf gate_bias_;
+  // Buffers kept from run to run.
+  Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      input_projections_;
+  Eigen::RowVectorXf gates_;
+  Eigen::ArrayXf cell_activation_;
+
   Eigen::MatrixXf ht_1_;
   Eigen::MatrixXf ct_1_;
-  std::function<float(float)> kactivation_;
-  std::function<float(float)> krecurrent_activation_;
+  ActivationType activation_ = ActivationType::TANH;
+  ActivationType recurrent_activation_ = ActivationType::HARD_SIGMOID;
   int units_ = 0;
   bool return_sequences_ = false;
   bool stateful_ = false;
@@ -292,6 +353,14 @@ class Flatten : public Layer {
    */
   void Run(const std::vector<Eigen::MatrixXf>& inputs,
            Eigen::MatrixXf* output) override;
+
+  /**
+   * @brief Compute the layer output from a single input
+   * @param Input to a network layer
+   * @param Output of a network layer will be returned
+   */
+  void RunSingle(const Eigen::MatrixXf& input,
+                 Eigen::MatrixXf* output) override;
 };
 
 /**
@@ -315,6 +384,14 @@ class Input : public Layer {
   void Run(const std::vector<Eigen::MatrixXf>& inputs,
            Eigen::MatrixXf* output) override;
 
+  /**
+   * @brief Compute the layer output from a single input
+   * @param Input to a network layer
+   * @param Output of a network layer will be returned
+   */
+  void RunSingle(const Eigen::MatrixXf& input,
+                 Eigen::MatrixXf* output) override;
+
  private:
   std::vector<int> input_shape_;
   std::string dtype_;
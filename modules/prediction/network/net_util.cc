@@ -16,6 +16,7 @@
 
 #include "modules/prediction/network/net_util.h"
 
+#include <cmath>
 #include <unordered_map>
 
 #include "modules/common/log.h"
@@ -24,6 +25,35 @@ namespace apollo {
 namespace prediction {
 namespace network {
 
+namespace {
+
+// Only uses the array functions of Eigen 3.2, which has no array tanh:
+// tanh(x) = 1 - 2 / (exp(2x) + 1). The values are plain arrays, so that
+// Eigen vectorizes the pass whatever the shape of the matrix they are from.
+template <typename Derived>
+void Activate(const ActivationType type, const Eigen::ArrayBase<Derived>& x,
+              Eigen::Ref<Eigen::ArrayXf> output) {
+  switch (type) {
+    case ActivationType::LINEAR:
+      output = x;
+      break;
+    case ActivationType::TANH:
+      output = 1.0f - 2.0f * ((2.0f * x).exp() + 1.0f).inverse();
+      break;
+    case ActivationType::SIGMOID:
+      output = (1.0f + (-x).exp()).inverse();
+      break;
+    case ActivationType::HARD_SIGMOID:
+      output = (0.2f * x + 0.5f).matrix().cwiseMax(0.0f).cwiseMin(1.0f).array();
+      break;
+    case ActivationType::RELU:
+      output = x.matrix().cwiseMax(0.0f).array();
+      break;
+  }
+}
+
+}  // namespace
+
 float sigmoid(const float x) { return 1 / (1 + exp(-x)); }
 
 float tanh(const float x) { return std::tanh(x); }
@@ -47,6 +77,40 @@ std::function<float(float)> serialize_to_function(const std::string& str) {
   return func_map.at(str);
 }
 
+bool serialize_to_activation_type(const std::string& str,
+                                  ActivationType* type) {
+  static const std::unordered_map<std::string, ActivationType> type_map(
+      {{"linear", ActivationType::LINEAR},
+       {"tanh", ActivationType::TANH},
+       {"sigmoid", ActivationType::SIGMOID},
+       {"hard_sigmoid", ActivationType::HARD_SIGMOID},
+       {"relu", ActivationType::RELU}});
+  const auto it = type_map.find(str);
+  if (it == type_map.end()) {
+    AERROR << "Unknown activation function: " << str;
+    return false;
+  }
+  *type = it->second;
+  return true;
+}
+
+void ApplyActivation(const ActivationType type,
+                     Eigen::Ref<Eigen::ArrayXf> values) {
+  Activate(type, values, values);
+}
+
+void ApplyActivation(const ActivationType type,
+                     const Eigen::Ref<const Eigen::ArrayXf>& bias,
+                     Eigen::Ref<Eigen::ArrayXf> values) {
+  CHECK_EQ(bias.size(), values.size());
+  Activate(type, values + bias, values);
+}
+
+void ApplyActivation(const ActivationType type, Eigen::MatrixXf* matrix) {
+  ApplyActivation(type,
+                  Eigen::Map<Eigen::ArrayXf>(matrix->data(), matrix->size()));
+}
+
 bool LoadTensor(const TensorParameter& tensor_pb, Eigen::MatrixXf* matrix) {
   if (tensor_pb.data_size() == 0 || tensor_pb.shape_size() == 0) {
     AERROR << "Fail to load the necessary fields!";
@@ -89,6 +153,50 @@ bool LoadTensor(const TensorParameter& tensor_pb, Eigen::VectorXf* vector) {
   return true;
 }
 
+void QuantizeMatrix(const Eigen::MatrixXf& matrix, QuantizedMatrix* quantized) {
+  CHECK_NOTNULL(quantized);
+  quantized->rows = static_cast<int>(matrix.rows());
+  quantized->cols = static_cast<int>(matrix.cols());
+  const float max_abs = matrix.size() > 0 ? matrix.cwiseAbs().maxCoeff() : 0.0f;
+  quantized->scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+  const float inverse_scale = 1.0f / quantized->scale;
+  quantized->data.resize(matrix.size());
+  // Eigen matrices are column major, as the quantized data.
+  for (int i = 0; i < matrix.size(); ++i) {
+    quantized->data[i] =
+        static_cast<int8_t>(std::round(matrix.data()[i] * inverse_scale));
+  }
+}
+
+void QuantizedMultiply(const Eigen::MatrixXf& input,
+                       const QuantizedMatrix& weights,
+                       Eigen::MatrixXf* output) {
+  CHECK_NOTNULL(output);
+  CHECK_EQ(input.cols(), weights.rows);
+  const int depth = weights.rows;
+  output->resize(input.rows(), weights.cols);
+  std::vector<int8_t> row(depth);
+  for (int r = 0; r < input.rows(); ++r) {
+    const float max_abs =
+        depth > 0 ? input.row(r).cwiseAbs().maxCoeff() : 0.0f;
+    const float row_scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+    const float inverse_scale = 1.0f / row_scale;
+    for (int i = 0; i < depth; ++i) {
+      row[i] = static_cast<int8_t>(std::round(input(r, i) * inverse_scale));
+    }
+    const float output_scale = row_scale * weights.scale;
+    for (int c = 0; c < weights.cols; ++c) {
+      const int8_t* column = weights.data.data() + c * depth;
+      // A plain loop of int32 products, which the compiler vectorizes.
+      int32_t sum = 0;
+      for (int i = 0; i < depth; ++i) {
+        sum += static_cast<int32_t>(row[i]) * static_cast<int32_t>(column[i]);
+      }
+      (*output)(r, c) = static_cast<float>(sum) * output_scale;
+    }
+  }
+}
+
 }  // namespace network
 }  // namespace prediction
 }  // namespace apollo
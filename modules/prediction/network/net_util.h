@@ -22,8 +22,10 @@
 #ifndef MODULES_PREDICTION_NETWORK_NET_UTIL_H_
 #define MODULES_PREDICTION_NETWORK_NET_UTIL_H_
 
+#include <cstdint>
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "Eigen/Dense"
 
@@ -78,6 +80,46 @@ float relu(const float x);
  */
 std::function<float(float)> serialize_to_function(const std::string& str);
 
+/**
+ * @brief network activation functions applied to whole matrices
+ */
+enum class ActivationType { LINEAR, TANH, SIGMOID, HARD_SIGMOID, RELU };
+
+/**
+ * @brief translate a string into a network activation type
+ * @param string
+ * @param activation type will be returned
+ * @return False if the string names no activation function
+ */
+bool serialize_to_activation_type(const std::string& str,
+                                  ActivationType* type);
+
+/**
+ * @brief apply an activation function in place, in one vectorized pass
+ * @param activation type
+ * @param contiguous values to activate
+ */
+void ApplyActivation(const ActivationType type,
+                     Eigen::Ref<Eigen::ArrayXf> values);
+
+/**
+ * @brief add a bias and apply an activation function, in place and in one
+ *        vectorized pass: values = f(values + bias)
+ * @param activation type
+ * @param bias of the size of the values
+ * @param contiguous values to activate
+ */
+void ApplyActivation(const ActivationType type,
+                     const Eigen::Ref<const Eigen::ArrayXf>& bias,
+                     Eigen::Ref<Eigen::ArrayXf> values);
+
+/**
+ * @brief apply an activation function to all the coefficients of a matrix
+ * @param activation type
+ * @param matrix to activate
+ */
+void ApplyActivation(const ActivationType type, Eigen::MatrixXf* matrix);
+
 /**
  * @brief load matrix value from a protobuf message
  * @param protobuf message in the form of TensorParameter
@@ -94,6 +136,37 @@ bool LoadTensor(const TensorParameter& tensor_pb, Eigen::MatrixXf* matrix);
  */
 bool LoadTensor(const TensorParameter& tensor_pb, Eigen::VectorXf* vector);
 
+/**
+ * @brief int8 weights of a dense layer, with one scale for the layer:
+ *        weight(row, col) = scale * data[col * rows + row]
+ *        Every column is contiguous, as it is multiplied by the input rows.
+ */
+struct QuantizedMatrix {
+  int rows = 0;
+  int cols = 0;
+  float scale = 1.0f;
+  std::vector<int8_t> data;
+};
+
+/**
+ * @brief quantize a matrix to int8 symmetrically, the largest absolute
+ *        value being mapped to 127
+ * @param matrix to quantize
+ * @param quantized matrix will be returned
+ */
+void QuantizeMatrix(const Eigen::MatrixXf& matrix, QuantizedMatrix* quantized);
+
+/**
+ * @brief multiply a float matrix by int8 weights: output = input * weights.
+ *        Every input row is quantized to int8 with its own scale, and the
+ *        products are accumulated in int32.
+ * @param input matrix of |rows| x |weights.rows|
+ * @param int8 weights
+ * @param output matrix of |rows| x |weights.cols| will be returned
+ */
+void QuantizedMultiply(const Eigen::MatrixXf& input,
+                       const QuantizedMatrix& weights, Eigen::MatrixXf* output);
+
 }  // namespace network
 }  // namespace prediction
 }  // namespace apollo
@@ -81,6 +81,33 @@ TEST(NetworkUtil, LoadTensor_test) {
   EXPECT_FLOAT_EQ(mat(1, 1), 4.0);
 }
 
+TEST(NetworkUtil, QuantizedMultiply_test) {
+  Eigen::MatrixXf weights(3, 2);
+  weights << 1.0, -0.5, 0.25, 2.0, -1.5, 0.0;
+  QuantizedMatrix quantized;
+  QuantizeMatrix(weights, &quantized);
+  EXPECT_EQ(quantized.rows, 3);
+  EXPECT_EQ(quantized.cols, 2);
+  EXPECT_FLOAT_EQ(quantized.scale, 2.0 / 127.0);
+  // Column major: weights(1, 1) is the largest.
+  EXPECT_EQ(static_cast<int>(quantized.data[4]), 127);
+  EXPECT_EQ(static_cast<int>(quantized.data[3]), -32);
+
+  Eigen::MatrixXf input = Eigen::MatrixXf::Random(8, 3);
+  input.row(1).setZero();
+  Eigen::MatrixXf output;
+  QuantizedMultiply(input, quantized, &output);
+  const Eigen::MatrixXf expected = input * weights;
+  ASSERT_EQ(output.rows(), 8);
+  ASSERT_EQ(output.cols(), 2);
+  for (int r = 0; r < output.rows(); ++r) {
+    for (int c = 0; c < output.cols(); ++c) {
+      EXPECT_NEAR(output(r, c), expected(r, c), 0.05);
+    }
+  }
+  EXPECT_FLOAT_EQ(output(1, 0), 0.0);
+}
+
 }  // namespace network
 }  // namespace prediction
 }  // namespace apollo
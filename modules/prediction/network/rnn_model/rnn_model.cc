@@ -26,39 +26,39 @@ RnnModel::RnnModel() {}
 
 void RnnModel::Run(const std::vector<Eigen::MatrixXf>& inputs,
                    Eigen::MatrixXf* output) const {
-  Eigen::MatrixXf inp1;
-  Eigen::MatrixXf inp2;
-  layers_[0]->Run({inputs[0]}, &inp1);
-  layers_[1]->Run({inputs[1]}, &inp2);
+  Eigen::MatrixXf& inp1 = buffers_[0];
+  Eigen::MatrixXf& inp2 = buffers_[1];
+  layers_[0]->RunSingle(inputs[0], &inp1);
+  layers_[1]->RunSingle(inputs[1], &inp2);
 
-  Eigen::MatrixXf bn1;
-  Eigen::MatrixXf bn2;
-  layers_[2]->Run({inp1}, &bn1);
-  layers_[3]->Run({inp2}, &bn2);
+  Eigen::MatrixXf& bn1 = buffers_[2];
+  Eigen::MatrixXf& bn2 = buffers_[3];
+  layers_[2]->RunSingle(inp1, &bn1);
+  layers_[3]->RunSingle(inp2, &bn2);
 
-  Eigen::MatrixXf lstm1;
-  Eigen::MatrixXf lstm2;
-  layers_[4]->Run({bn1}, &lstm1);
-  layers_[5]->Run({bn2}, &lstm2);
+  Eigen::MatrixXf& lstm1 = buffers_[4];
+  Eigen::MatrixXf& lstm2 = buffers_[5];
+  layers_[4]->RunSingle(bn1, &lstm1);
+  layers_[5]->RunSingle(bn2, &lstm2);
 
-  Eigen::MatrixXf merge;
-  Eigen::MatrixXf dense1;
-  Eigen::MatrixXf act1;
+  Eigen::MatrixXf& merge = buffers_[6];
+  Eigen::MatrixXf& dense1 = buffers_[7];
+  Eigen::MatrixXf& act1 = buffers_[8];
   layers_[6]->Run({lstm1, lstm2}, &merge);
-  layers_[7]->Run({merge}, &dense1);
-  layers_[8]->Run({dense1}, &bn1);
-  layers_[9]->Run({bn1}, &act1);
+  layers_[7]->RunSingle(merge, &dense1);
+  layers_[8]->RunSingle(dense1, &bn1);
+  layers_[9]->RunSingle(bn1, &act1);
 
-  Eigen::MatrixXf dense2;
-  Eigen::MatrixXf prob;
-  layers_[10]->Run({act1}, &dense2);
-  layers_[12]->Run({dense2}, &bn1);
-  layers_[14]->Run({bn1}, &prob);
+  Eigen::MatrixXf& dense2 = buffers_[9];
+  Eigen::MatrixXf& prob = buffers_[10];
+  layers_[10]->RunSingle(act1, &dense2);
+  layers_[12]->RunSingle(dense2, &bn1);
+  layers_[14]->RunSingle(bn1, &prob);
 
-  Eigen::MatrixXf acc;
-  layers_[11]->Run({act1}, &dense2);
-  layers_[13]->Run({dense2}, &bn1);
-  layers_[15]->Run({bn1}, &acc);
+  Eigen::MatrixXf& acc = buffers_[11];
+  layers_[11]->RunSingle(act1, &dense2);
+  layers_[13]->RunSingle(dense2, &bn1);
+  layers_[15]->RunSingle(bn1, &acc);
 
   output->resize(1, 2);
   *output << prob, acc;
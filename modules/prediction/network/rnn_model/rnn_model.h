@@ -66,6 +66,11 @@ class RnnModel : public NetModel {
    */
   void ResetState() const override;
 
+ private:
+  // The outputs of the layers, kept from run to run so that a run does not
+  // allocate once the shapes of the inputs settle.
+  mutable Eigen::MatrixXf buffers_[12];
+
   DECLARE_SINGLETON(RnnModel);
 };
 
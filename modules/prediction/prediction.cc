@@ -19,13 +19,17 @@
 #include <cmath>
 
 #include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/alloc_tracker/alloc_tracker.h"
 #include "modules/common/math/vec2d.h"
 #include "modules/common/time/time.h"
+#include "modules/common/trace/trace.h"
 #include "modules/common/util/file.h"
 #include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/common/prediction_map.h"
+#include "modules/prediction/common/prediction_thread_pool.h"
 #include "modules/prediction/container/container_manager.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
+#include "modules/prediction/container/obstacles_prioritizer.h"
 #include "modules/prediction/container/pose/pose_container.h"
 #include "modules/prediction/evaluator/evaluator_manager.h"
 #include "modules/prediction/predictor/predictor_manager.h"
@@ -72,6 +76,7 @@ Status Prediction::Init() {
   }
 
   // Initialization of all managers
+  PredictionThreadPool::instance()->Init();
   AdapterManager::Init(adapter_conf_);
   ContainerManager::instance()->Init(adapter_conf_);
   EvaluatorManager::instance()->Init(prediction_conf_);
@@ -80,12 +85,20 @@ Status Prediction::Init() {
   CHECK(AdapterManager::GetLocalization()) << "Localization is not ready.";
   CHECK(AdapterManager::GetPerceptionObstacles()) << "Perception is not ready.";
 
-  // Set perception obstacle callback function
-  AdapterManager::AddPerceptionObstaclesCallback(&Prediction::RunOnce, this);
-  // Set localization callback function
-  AdapterManager::AddLocalizationCallback(&Prediction::OnLocalization, this);
-  // Set planning callback function
-  AdapterManager::AddPlanningCallback(&Prediction::OnPlanning, this);
+  if (FLAGS_enable_async_prediction) {
+    AdapterManager::AddPerceptionObstaclesCallback(
+        &Prediction::EnqueuePerceptionObstacles, this);
+    AdapterManager::AddLocalizationCallback(&Prediction::EnqueueLocalization,
+                                            this);
+    AdapterManager::AddPlanningCallback(&Prediction::EnqueuePlanning, this);
+  } else {
+    // Set perception obstacle callback function
+    AdapterManager::AddPerceptionObstaclesCallback(&Prediction::RunOnce, this);
+    // Set localization callback function
+    AdapterManager::AddLocalizationCallback(&Prediction::OnLocalization, this);
+    // Set planning callback function
+    AdapterManager::AddPlanningCallback(&Prediction::OnPlanning, this);
+  }
 
   if (!PredictionMap::instance()->Ready()) {
     return OnError("Map cannot be loaded.");
@@ -94,9 +107,58 @@ Status Prediction::Init() {
   return Status::OK();
 }
 
-Status Prediction::Start() { return Status::OK(); }
+Status Prediction::Start() {
+  if (FLAGS_enable_async_prediction) {
+    worker_ = std::thread(&Prediction::RunWorker, this);
+  }
+  return Status::OK();
+}
+
+void Prediction::Stop() {
+  if (worker_.joinable()) {
+    perception_obstacles_mailbox_.Close();
+    localization_mailbox_.Close();
+    planning_mailbox_.Close();
+    worker_.join();
+    AINFO << "Dropped " << perception_obstacles_mailbox_.num_dropped()
+          << " of " << perception_obstacles_mailbox_.num_put()
+          << " perception messages, "
+          << localization_mailbox_.num_dropped() << " of "
+          << localization_mailbox_.num_put() << " localization messages and "
+          << planning_mailbox_.num_dropped() << " of "
+          << planning_mailbox_.num_put() << " planning messages.";
+  }
+  PredictionThreadPool::instance()->Stop();
+}
+
+void Prediction::EnqueuePerceptionObstacles(
+    const PerceptionObstacles& perception_obstacles) {
+  perception_obstacles_mailbox_.Put(perception_obstacles);
+}
+
+void Prediction::EnqueueLocalization(const LocalizationEstimate& localization) {
+  localization_mailbox_.Put(localization);
+}
 
-void Prediction::Stop() {}
+void Prediction::EnqueuePlanning(
+    const planning::ADCTrajectory& adc_trajectory) {
+  planning_mailbox_.Put(adc_trajectory);
+}
+
+void Prediction::RunWorker() {
+  PerceptionObstacles perception_obstacles;
+  LocalizationEstimate localization;
+  planning::ADCTrajectory adc_trajectory;
+  while (perception_obstacles_mailbox_.Take(&perception_obstacles)) {
+    if (localization_mailbox_.TryTake(&localization)) {
+      OnLocalization(localization);
+    }
+    if (planning_mailbox_.TryTake(&adc_trajectory)) {
+      OnPlanning(adc_trajectory);
+    }
+    RunOnce(perception_obstacles);
+  }
+}
 
 void Prediction::OnLocalization(const LocalizationEstimate& localization) {
   ObstaclesContainer* obstacles_container = dynamic_cast<ObstaclesContainer*>(
@@ -136,6 +198,9 @@ void Prediction::RunOnce(const PerceptionObstacles& perception_obstacles) {
          << perception_obstacles.ShortDebugString() << "].";
 
   double start_timestamp = Clock::NowInSeconds();
+  double stage_start_time = start_timestamp;
+  stage_time_ms_.clear();
+  common::alloc_tracker::ScopedAllocRegion alloc_region("prediction_cycle");
 
   // Insert obstacle
   ObstaclesContainer* obstacles_container = dynamic_cast<ObstaclesContainer*>(
@@ -163,15 +228,27 @@ void Prediction::RunOnce(const PerceptionObstacles& perception_obstacles) {
     Vec2d adc_position(x, y);
     adc_container->SetPosition(adc_position);
   }
+  RecordStageTime("container", &stage_start_time);
+
+  // Prioritize obstacles
+  if (FLAGS_enable_obstacles_prioritization) {
+    ObstaclesPrioritizer::instance()->Prioritize(
+        perception_obstacles, obstacles_container, *adc_container);
+    RecordStageTime("prioritizer", &stage_start_time);
+  }
 
   // Make predictions
   EvaluatorManager::instance()->Run(perception_obstacles);
+  RecordStageTime("evaluator", &stage_start_time);
   PredictorManager::instance()->Run(perception_obstacles);
+  RecordStageTime("predictor", &stage_start_time);
 
   auto prediction_obstacles =
       PredictorManager::instance()->prediction_obstacles();
   prediction_obstacles.set_start_timestamp(start_timestamp);
   prediction_obstacles.set_end_timestamp(Clock::NowInSeconds());
+  common::trace::PropagateTrace(perception_obstacles.header(),
+                                prediction_obstacles.mutable_header());
 
   if (FLAGS_prediction_test_mode) {
     for (auto const& prediction_obstacle :
@@ -200,6 +277,13 @@ Status Prediction::OnError(const std::string& error_msg) {
   return Status(ErrorCode::PREDICTION_ERROR, error_msg);
 }
 
+void Prediction::RecordStageTime(const std::string& name,
+                                 double* stage_start_time) {
+  const double now = Clock::NowInSeconds();
+  stage_time_ms_.emplace_back(name, (now - *stage_start_time) * 1000.0);
+  *stage_start_time = now;
+}
+
 bool Prediction::IsValidTrajectoryPoint(
     const TrajectoryPoint& trajectory_point) {
   return trajectory_point.has_path_point() &&
@@ -22,9 +22,13 @@
 #define MODULES_PREDICTION_PREDICTION_H_
 
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "modules/common/adapters/proto/adapter_config.pb.h"
 #include "modules/common/proto/pnc_point.pb.h"
+#include "modules/common/util/latest_mailbox.h"
 #include "modules/localization/proto/localization.pb.h"
 #include "modules/perception/proto/perception_obstacle.pb.h"
 #include "modules/planning/proto/planning.pb.h"
@@ -75,6 +79,15 @@ class Prediction : public PredictionInterface {
   void RunOnce(
       const perception::PerceptionObstacles &perception_obstacles) override;
 
+  /**
+   * @brief Get the time spent in every stage of the last RunOnce()
+   * @return The names of the stages and their time in milliseconds, in the
+   * order the stages ran.
+   */
+  const std::vector<std::pair<std::string, double>> &stage_time_ms() const {
+    return stage_time_ms_;
+  }
+
  private:
   common::Status OnError(const std::string &error_msg);
 
@@ -85,10 +98,41 @@ class Prediction : public PredictionInterface {
   bool IsValidTrajectoryPoint(
       const ::apollo::common::TrajectoryPoint &trajectory_point);
 
+  void RecordStageTime(const std::string &name, double *stage_start_time);
+
+  /**
+   * @brief The callbacks of the async mode: they put the messages into the
+   * mailboxes of the worker and return at once.
+   */
+  void EnqueuePerceptionObstacles(
+      const perception::PerceptionObstacles &perception_obstacles);
+
+  void EnqueueLocalization(
+      const localization::LocalizationEstimate &localization);
+
+  void EnqueuePlanning(const planning::ADCTrajectory &adc_trajectory);
+
+  /**
+   * @brief The loop of the worker of the async mode: it runs on the latest
+   * perception obstacles, after applying the latest localization and
+   * planning, until the mailboxes are closed.
+   */
+  void RunWorker();
+
  private:
   double start_time_ = 0.0;
   PredictionConf prediction_conf_;
   common::adapter::AdapterManagerConfig adapter_conf_;
+  std::vector<std::pair<std::string, double>> stage_time_ms_;
+
+  // The async mode: the messages of every topic are coalesced to the latest
+  // one, and all the containers are updated by the worker only.
+  common::util::LatestMailbox<perception::PerceptionObstacles>
+      perception_obstacles_mailbox_;
+  common::util::LatestMailbox<localization::LocalizationEstimate>
+      localization_mailbox_;
+  common::util::LatestMailbox<planning::ADCTrajectory> planning_mailbox_;
+  std::thread worker_;
 };
 
 }  // namespace prediction
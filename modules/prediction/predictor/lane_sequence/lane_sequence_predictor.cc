@@ -30,7 +30,6 @@ namespace prediction {
 
 using apollo::common::PathPoint;
 using apollo::common::TrajectoryPoint;
-using apollo::common::math::KalmanFilter;
 using apollo::hdmap::LaneInfo;
 
 void LaneSequencePredictor::Predict(Obstacle* obstacle) {
@@ -80,9 +79,12 @@ void LaneSequencePredictor::Predict(Obstacle* obstacle) {
     std::string curr_lane_id = sequence.lane_segment(0).lane_id();
     std::vector<TrajectoryPoint> points;
     double prediction_total_time = FLAGS_prediction_pedestrian_total_time;
+    const auto& kf_lane_trackers = obstacle->kf_lane_trackers();
+    const size_t kf_index = obstacle->kf_lane_tracker_index(curr_lane_id);
     DrawLaneSequenceTrajectoryPoints(
-        feature, curr_lane_id, obstacle->kf_lane_tracker(curr_lane_id),
-        sequence, prediction_total_time, FLAGS_prediction_period, &points);
+        feature, curr_lane_id, kf_lane_trackers.GetStateEstimate(kf_index),
+        kf_lane_trackers.GetTransitionMatrix(kf_index), sequence,
+        prediction_total_time, FLAGS_prediction_period, &points);
 
     Trajectory trajectory = GenerateTrajectory(points);
     trajectory.set_probability(sequence.probability());
@@ -95,9 +97,11 @@ void LaneSequencePredictor::Predict(Obstacle* obstacle) {
 
 void LaneSequencePredictor::DrawLaneSequenceTrajectoryPoints(
     const Feature& feature, const std::string& lane_id,
-    const KalmanFilter<double, 4, 2, 0>& kf, const LaneSequence& sequence,
-    double total_time, double period, std::vector<TrajectoryPoint>* points) {
-  Eigen::Matrix<double, 4, 1> state(kf.GetStateEstimate());
+    const Eigen::Matrix<double, 4, 1>& kf_state,
+    const Eigen::Matrix<double, 4, 4>& kf_transition,
+    const LaneSequence& sequence, double total_time, double period,
+    std::vector<TrajectoryPoint>* points) {
+  Eigen::Matrix<double, 4, 1> state(kf_state);
 
   Eigen::Vector2d position(feature.position().x(), feature.position().y());
   std::shared_ptr<const LaneInfo> lane_info =
@@ -114,7 +118,7 @@ void LaneSequencePredictor::DrawLaneSequenceTrajectoryPoints(
   if (FLAGS_enable_lane_sequence_acc && sequence.has_acceleration()) {
     state(3, 0) = sequence.acceleration();
   }
-  Eigen::Matrix<double, 4, 4> transition(kf.GetTransitionMatrix());
+  Eigen::Matrix<double, 4, 4> transition(kf_transition);
   transition(0, 2) = period;
   transition(0, 3) = 0.5 * period * period;
   transition(2, 3) = period;
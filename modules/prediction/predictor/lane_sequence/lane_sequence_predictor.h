@@ -24,7 +24,8 @@
 #include <string>
 #include <vector>
 
-#include "modules/common/math/kalman_filter.h"
+#include "Eigen/Dense"
+
 #include "modules/common/proto/pnc_point.pb.h"
 #include "modules/prediction/predictor/sequence/sequence_predictor.h"
 #include "modules/prediction/proto/lane_graph.pb.h"
@@ -53,7 +54,8 @@ class LaneSequencePredictor : public SequencePredictor {
  protected:
   /**
    * @brief Draw lane sequence trajectory points
-   * @param Kalman filter
+   * @param State of the lane Kalman filter
+   * @param Transition matrix of the lane Kalman filter
    * @param Lane sequence
    * @param Total prediction time
    * @param Prediction period
@@ -61,7 +63,8 @@ class LaneSequencePredictor : public SequencePredictor {
    */
   void DrawLaneSequenceTrajectoryPoints(
       const Feature& feature, const std::string& lane_id,
-      const common::math::KalmanFilter<double, 4, 2, 0>& kf,
+      const Eigen::Matrix<double, 4, 1>& kf_state,
+      const Eigen::Matrix<double, 4, 4>& kf_transition,
       const LaneSequence& sequence, double total_time, double period,
       std::vector<common::TrajectoryPoint>* points);
 };
@@ -25,6 +25,7 @@
 #include "Eigen/Dense"
 #include "modules/common/adapters/proto/adapter_config.pb.h"
 #include "modules/common/log.h"
+#include "modules/common/math/fast_trig.h"
 #include "modules/common/math/math_utils.h"
 #include "modules/common/util/file.h"
 #include "modules/map/hdmap/hdmap_util.h"
@@ -43,6 +44,9 @@ using ::apollo::common::PathPoint;
 using ::apollo::common::Point3D;
 using ::apollo::common::TrajectoryPoint;
 using ::apollo::common::adapter::AdapterConfig;
+using ::apollo::common::math::FastCos;
+using ::apollo::common::math::FastSin;
+using ::apollo::common::math::FastSinCos;
 using ::apollo::common::math::KalmanFilter;
 using ::apollo::hdmap::LaneInfo;
 
@@ -136,26 +140,29 @@ void MoveSequencePredictor::DrawManeuverTrajectoryPoints(
   GetLongitudinalPolynomial(obstacle, lane_sequence, time_to_lane_center,
                             &longitudinal_coeffs);
 
-  int lane_segment_index = 0;
-  std::string lane_id =
-      lane_sequence.lane_segment(lane_segment_index).lane_id();
-
-  PredictionMap* map = PredictionMap::instance();
-  std::shared_ptr<const LaneInfo> lane_info = map->LaneById(lane_id);
+  std::vector<std::shared_ptr<const LaneInfo>> lanes;
+  if (!predictor_util::GetLanesOfSequence(lane_sequence, &lanes)) {
+    return;
+  }
   double lane_s = 0.0;
   double lane_l = 0.0;
-  if (!map->GetProjection(position, lane_info, &lane_s, &lane_l)) {
+  if (!PredictionMap::GetProjection(position, lanes.front(), &lane_s,
+                                    &lane_l)) {
     AERROR << "Failed in getting lane s and lane l";
     return;
   }
   double prev_lane_l = lane_l;
 
+  // Evaluate the polynomials for all the points first, and then look up the
+  // points on the lanes all at once.
   size_t total_num = static_cast<size_t>(total_time / period);
   size_t num_to_center = static_cast<size_t>(time_to_lane_center / period);
+  std::vector<int> lane_indices(total_num);
+  Eigen::ArrayXd points_s(total_num);
+  Eigen::ArrayXd points_l(total_num);
+  int lane_segment_index = 0;
   for (size_t i = 0; i < total_num; ++i) {
     double relative_time = static_cast<double>(i) * period;
-    Eigen::Vector2d point;
-    double theta = M_PI;
     if (i < num_to_center) {
       lane_l = EvaluateLateralPolynomial(lateral_coeffs, relative_time, 0);
     } else {
@@ -171,37 +178,44 @@ void MoveSequencePredictor::DrawManeuverTrajectoryPoints(
     if (curr_s + FLAGS_double_precision < prev_s) {
       lane_l = prev_lane_l;
     }
-    if (!map->SmoothPointFromLane(lane_id, lane_s, lane_l, &point, &theta)) {
-      AERROR << "Unable to get smooth point from lane [" << lane_id
-             << "] with s [" << lane_s << "] and l [" << lane_l << "]";
-      break;
+    lane_indices[i] = lane_segment_index;
+    points_s(i) = lane_s;
+    points_l(i) = lane_l;
+    prev_lane_l = lane_l;
+
+    while (lane_s > lanes[lane_segment_index]->total_length() &&
+           lane_segment_index + 1 < lane_sequence.lane_segment_size()) {
+      lane_s = lane_s - lanes[lane_segment_index]->total_length();
+      lane_segment_index += 1;
     }
+  }
 
-    prev_lane_l = lane_l;
+  Eigen::ArrayXd xs;
+  Eigen::ArrayXd ys;
+  Eigen::ArrayXd headings;
+  PredictionMap::SmoothPointsFromLanes(lanes, lane_indices, points_s,
+                                       points_l, &xs, &ys, &headings);
+
+  points->reserve(points->size() + total_num);
+  for (size_t i = 0; i < total_num; ++i) {
+    double relative_time = static_cast<double>(i) * period;
     double lane_speed =
         EvaluateLongitudinalPolynomial(longitudinal_coeffs, relative_time, 1);
     double lane_acc =
         EvaluateLongitudinalPolynomial(longitudinal_coeffs, relative_time, 2);
 
     TrajectoryPoint trajectory_point;
-    PathPoint path_point;
-    path_point.set_x(point.x());
-    path_point.set_y(point.y());
-    path_point.set_z(0.0);
-    path_point.set_theta(theta);
-    path_point.set_lane_id(lane_id);
-    trajectory_point.mutable_path_point()->CopyFrom(path_point);
+    PathPoint* path_point = trajectory_point.mutable_path_point();
+    path_point->set_x(xs(i));
+    path_point->set_y(ys(i));
+    path_point->set_z(0.0);
+    path_point->set_theta(headings(i));
+    path_point->set_lane_id(
+        lane_sequence.lane_segment(lane_indices[i]).lane_id());
     trajectory_point.set_v(lane_speed);
     trajectory_point.set_a(lane_acc);
     trajectory_point.set_relative_time(relative_time);
     points->emplace_back(std::move(trajectory_point));
-
-    while (lane_s > map->LaneById(lane_id)->total_length() &&
-           lane_segment_index + 1 < lane_sequence.lane_segment_size()) {
-      lane_segment_index += 1;
-      lane_s = lane_s - map->LaneById(lane_id)->total_length();
-      lane_id = lane_sequence.lane_segment(lane_segment_index).lane_id();
-    }
   }
 }
 
@@ -222,8 +236,9 @@ void MoveSequencePredictor::GetLongitudinalPolynomial(
   double lane_heading = lane_sequence.lane_segment(0).lane_point(0).heading();
 
   double s0 = 0.0;
-  double ds0 = v * std::cos(theta - lane_heading);
-  double dds0 = a * std::cos(theta - lane_heading);
+  double cos_heading_diff = FastCos(theta - lane_heading);
+  double ds0 = v * cos_heading_diff;
+  double dds0 = a * cos_heading_diff;
   double min_end_speed = std::min(FLAGS_still_obstacle_speed_threshold, ds0);
   double ds1 = std::max(min_end_speed, ds0 + dds0 * time_to_lane_center);
   double dds1 = 0.0;
@@ -256,15 +271,17 @@ void MoveSequencePredictor::GetLateralPolynomial(
       lane_sequence.lane_segment(0).lane_point(0);
   double pos_delta_x = position.x() - start_lane_point.position().x();
   double pos_delta_y = position.y() - start_lane_point.position().y();
-  double lane_heading_x = std::cos(start_lane_point.heading());
-  double lane_heading_y = std::sin(start_lane_point.heading());
+  double lane_heading_x = 0.0;
+  double lane_heading_y = 0.0;
+  FastSinCos(start_lane_point.heading(), &lane_heading_y, &lane_heading_x);
   double cross_prod =
       lane_heading_x * pos_delta_y - lane_heading_y * pos_delta_x;
   double shift = std::hypot(pos_delta_x, pos_delta_y);
 
   double l0 = (cross_prod > 0) ? shift : -shift;
-  double dl0 = v * std::sin(theta - start_lane_point.heading());
-  double ddl0 = a * std::sin(theta - start_lane_point.heading());
+  double sin_heading_diff = FastSin(theta - start_lane_point.heading());
+  double dl0 = v * sin_heading_diff;
+  double ddl0 = a * sin_heading_diff;
   double l1 = 0.0;
   double dl1 = 0.0;
   double ddl1 = 0.0;
@@ -385,7 +402,10 @@ double MoveSequencePredictor::ComputeTimeToLaneCenterByVelocity(
 
   double lane_heading = first_lane_point.heading();
   double lane_l = first_lane_point.relative_l();
-  double v_l = v_y * std::cos(lane_heading) - v_x * std::sin(lane_heading);
+  double sin_lane_heading = 0.0;
+  double cos_lane_heading = 0.0;
+  FastSinCos(lane_heading, &sin_lane_heading, &cos_lane_heading);
+  double v_l = v_y * cos_lane_heading - v_x * sin_lane_heading;
   if (std::fabs(v_l) < FLAGS_default_lateral_approach_speed ||
       lane_l * v_l < 0.0) {
     return std::fabs(lane_l / FLAGS_default_lateral_approach_speed);
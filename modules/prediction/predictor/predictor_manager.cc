@@ -16,12 +16,16 @@
 
 #include "modules/prediction/predictor/predictor_manager.h"
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
+#include <vector>
 
 #include "modules/prediction/common/prediction_gflags.h"
 #include "modules/prediction/container/adc_trajectory/adc_trajectory_container.h"
 #include "modules/prediction/container/container_manager.h"
 #include "modules/prediction/container/obstacles/obstacles_container.h"
+#include "modules/prediction/container/obstacles_prioritizer.h"
 #include "modules/prediction/predictor/free_move/free_move_predictor.h"
 #include "modules/prediction/predictor/lane_sequence/lane_sequence_predictor.h"
 #include "modules/prediction/predictor/move_sequence/move_sequence_predictor.h"
@@ -135,24 +139,66 @@ void PredictorManager::Run(const PerceptionObstacles& perception_obstacles) {
   CHECK_NOTNULL(obstacles_container);
   CHECK_NOTNULL(adc_trajectory_container);
 
-  Predictor* predictor = nullptr;
-  for (const auto& perception_obstacle :
-       perception_obstacles.perception_obstacle()) {
-    if (!perception_obstacle.has_id()) {
-      AERROR << "A perception obstacle has no id.";
-      continue;
+  // With prioritization, the obstacles are predicted from the highest
+  // priority down, so that the time budget runs out on the lowest ones. The
+  // prediction obstacles keep the order of the perception obstacles.
+  const int num_obstacles = perception_obstacles.perception_obstacle_size();
+  std::vector<int> order(num_obstacles);
+  std::iota(order.begin(), order.end(), 0);
+  if (FLAGS_enable_obstacles_prioritization) {
+    std::vector<int> ranks(num_obstacles);
+    for (int i = 0; i < num_obstacles; ++i) {
+      ranks[i] = ObstaclesPrioritizer::instance()->Rank(
+          perception_obstacles.perception_obstacle(i).id());
     }
+    std::stable_sort(order.begin(), order.end(),
+                     [&ranks](const int lhs, const int rhs) {
+                       return ranks[lhs] < ranks[rhs];
+                     });
+  }
 
-    int id = perception_obstacle.id();
-    if (id < 0) {
-      AERROR << "A perception obstacle has invalid id [" << id << "].";
-      continue;
+  std::vector<PredictionObstacle> prediction_obstacles(num_obstacles);
+  std::vector<bool> is_predicted(num_obstacles, false);
+  for (const int index : order) {
+    is_predicted[index] = PredictObstacle(
+        perception_obstacles.perception_obstacle(index), obstacles_container,
+        adc_trajectory_container, &prediction_obstacles[index]);
+  }
+  for (int i = 0; i < num_obstacles; ++i) {
+    if (is_predicted[i]) {
+      prediction_obstacles_.add_prediction_obstacle()->Swap(
+          &prediction_obstacles[i]);
     }
+  }
+  prediction_obstacles_.set_perception_error_code(
+      perception_obstacles.error_code());
+}
 
-    PredictionObstacle prediction_obstacle;
-    prediction_obstacle.set_timestamp(perception_obstacle.timestamp());
-    Obstacle* obstacle = obstacles_container->GetObstacle(id);
-    if (obstacle != nullptr) {
+bool PredictorManager::PredictObstacle(
+    const PerceptionObstacle& perception_obstacle,
+    ObstaclesContainer* obstacles_container,
+    ADCTrajectoryContainer* adc_trajectory_container,
+    PredictionObstacle* prediction_obstacle) {
+  if (!perception_obstacle.has_id()) {
+    AERROR << "A perception obstacle has no id.";
+    return false;
+  }
+
+  int id = perception_obstacle.id();
+  if (id < 0) {
+    AERROR << "A perception obstacle has invalid id [" << id << "].";
+    return false;
+  }
+
+  prediction_obstacle->set_timestamp(perception_obstacle.timestamp());
+  Obstacle* obstacle = obstacles_container->GetObstacle(id);
+  if (obstacle != nullptr) {
+    Predictor* predictor = nullptr;
+    const ObstaclesPrioritizer* prioritizer = ObstaclesPrioritizer::instance();
+    if (FLAGS_enable_obstacles_prioritization &&
+        (!prioritizer->IsPrioritized(id) || prioritizer->IsOverBudget())) {
+      predictor = GetPredictor(ObstacleConf::FREE_MOVE_PREDICTOR);
+    } else {
       switch (perception_obstacle.type()) {
         case PerceptionObstacle::VEHICLE: {
           if (obstacle->IsOnLane()) {
@@ -183,29 +229,25 @@ void PredictorManager::Run(const PerceptionObstacles& perception_obstacles) {
           break;
         }
       }
+    }
 
-      if (predictor != nullptr) {
-        predictor->Predict(obstacle);
-        if (FLAGS_enable_trim_prediction_trajectory &&
-            obstacle->type() == PerceptionObstacle::VEHICLE) {
-          predictor->TrimTrajectories(obstacle, adc_trajectory_container);
-        }
-        for (const auto& trajectory : predictor->trajectories()) {
-          prediction_obstacle.add_trajectory()->CopyFrom(trajectory);
-        }
+    if (predictor != nullptr) {
+      predictor->Predict(obstacle);
+      if (FLAGS_enable_trim_prediction_trajectory &&
+          obstacle->type() == PerceptionObstacle::VEHICLE) {
+        predictor->TrimTrajectories(obstacle, adc_trajectory_container);
+      }
+      for (const auto& trajectory : predictor->trajectories()) {
+        prediction_obstacle->add_trajectory()->CopyFrom(trajectory);
       }
-      prediction_obstacle.set_timestamp(obstacle->timestamp());
     }
-
-    prediction_obstacle.set_predicted_period(FLAGS_prediction_duration);
-    prediction_obstacle.mutable_perception_obstacle()->CopyFrom(
-        perception_obstacle);
-
-    prediction_obstacles_.add_prediction_obstacle()->CopyFrom(
-        prediction_obstacle);
+    prediction_obstacle->set_timestamp(obstacle->timestamp());
   }
-  prediction_obstacles_.set_perception_error_code(
-      perception_obstacles.error_code());
+
+  prediction_obstacle->set_predicted_period(FLAGS_prediction_duration);
+  prediction_obstacle->mutable_perception_obstacle()->CopyFrom(
+      perception_obstacle);
+  return true;
 }
 
 std::unique_ptr<Predictor> PredictorManager::CreatePredictor(
@@ -30,6 +30,8 @@
 #include "modules/prediction/proto/prediction_obstacle.pb.h"
 
 #include "modules/common/macro.h"
+#include "modules/prediction/container/adc_trajectory/adc_trajectory_container.h"
+#include "modules/prediction/container/obstacles/obstacles_container.h"
 #include "modules/prediction/predictor/predictor.h"
 
 /**
@@ -90,6 +92,20 @@ class PredictorManager {
    */
   void RegisterPredictors();
 
+  /**
+   * @brief Predict a perception obstacle
+   * @param perception_obstacle The perception obstacle
+   * @param obstacles_container The container of the obstacles
+   * @param adc_trajectory_container The container of the ADC trajectory
+   * @param prediction_obstacle The prediction of the obstacle
+   * @return False if the perception obstacle has no valid id
+   */
+  bool PredictObstacle(
+      const perception::PerceptionObstacle& perception_obstacle,
+      ObstaclesContainer* obstacles_container,
+      ADCTrajectoryContainer* adc_trajectory_container,
+      PredictionObstacle* prediction_obstacle);
+
  private:
   std::map<ObstacleConf::PredictorType, std::unique_ptr<Predictor>> predictors_;
 
@@ -33,10 +33,10 @@ using apollo::common::math::KalmanFilter;
 
 namespace {
 
-Eigen::Vector2d GetUnitVector2d(const TrajectoryPoint& from_point,
-                                const TrajectoryPoint& to_point) {
-  double delta_x = to_point.path_point().x() - from_point.path_point().x();
-  double delta_y = to_point.path_point().y() - from_point.path_point().y();
+Eigen::Vector2d GetUnitVector2d(const Eigen::Vector2d& from_point,
+                                const Eigen::Vector2d& to_point) {
+  double delta_x = to_point[0] - from_point[0];
+  double delta_y = to_point[1] - from_point[1];
   if (std::fabs(delta_x) <= std::numeric_limits<double>::epsilon()) {
     delta_x = 0.0;
   }
@@ -52,6 +52,17 @@ Eigen::Vector2d GetUnitVector2d(const TrajectoryPoint& from_point,
   return {delta_x, delta_y};
 }
 
+Eigen::Vector2d ToVector2d(const TrajectoryPoint& point) {
+  return {point.path_point().x(), point.path_point().y()};
+}
+
+TrajectoryPoint ToTrajectoryPoint(const Eigen::Vector2d& point) {
+  TrajectoryPoint trajectory_point;
+  trajectory_point.mutable_path_point()->set_x(point[0]);
+  trajectory_point.mutable_path_point()->set_y(point[1]);
+  return trajectory_point;
+}
+
 void CompressVector2d(const double to_length, Eigen::Vector2d* vec) {
   const double norm = std::hypot(vec->operator[](0), vec->operator[](1));
   if (norm > to_length) {
@@ -178,7 +189,15 @@ void RegionalPredictor::DrawMovingTrajectory(
     const apollo::common::math::KalmanFilter<double, 2, 2, 4>& kf,
     const double total_time, std::vector<TrajectoryPoint>* left_points,
     std::vector<TrajectoryPoint>* right_points) {
+  // one region per prediction period, unless over the regions budget
   double delta_ts = FLAGS_prediction_period;
+  int num_regions = static_cast<int>(total_time / delta_ts);
+  if (FLAGS_max_num_pedestrian_regions > 0 &&
+      num_regions > FLAGS_max_num_pedestrian_regions) {
+    num_regions = FLAGS_max_num_pedestrian_regions;
+    delta_ts = total_time / num_regions;
+  }
+
   Eigen::Vector2d vel = velocity;
   CompressVector2d(FLAGS_pedestrian_max_speed, &vel);
   Eigen::Vector2d acc = acceleration;
@@ -186,8 +205,8 @@ void RegionalPredictor::DrawMovingTrajectory(
   double speed = std::hypot(vel[0], vel[1]);
 
   // candidate point sequences
-  std::vector<TrajectoryPoint> middle_points;
-  std::vector<TrajectoryPoint> boundary_points;
+  Eigen::Matrix2Xd middle_points;
+  Eigen::Matrix2Xd boundary_points;
 
   TrajectoryPoint starting_point;
   starting_point.mutable_path_point()->set_x(0.0);
@@ -195,10 +214,10 @@ void RegionalPredictor::DrawMovingTrajectory(
   starting_point.set_v(speed);
 
   Eigen::Vector2d translated_vec(0.0, 0.0);
-  GetTrajectoryCandidatePoints(translated_vec, vel, acc, kf, total_time,
-                               &middle_points, &boundary_points);
+  GetTrajectoryCandidatePoints(translated_vec, vel, acc, kf, num_regions,
+                               delta_ts, &middle_points, &boundary_points);
 
-  if (middle_points.empty() || boundary_points.size() < 2) {
+  if (middle_points.cols() == 0 || boundary_points.cols() < 2) {
     ADEBUG << "No valid points found.";
     return;
   }
@@ -219,16 +238,16 @@ void RegionalPredictor::GetTrajectoryCandidatePoints(
     const Eigen::Vector2d& position, const Eigen::Vector2d& velocity,
     const Eigen::Vector2d& acceleration,
     const KalmanFilter<double, 2, 2, 4>& kf_pedestrian_tracker,
-    const double total_time, std::vector<TrajectoryPoint>* middle_points,
-    std::vector<TrajectoryPoint>* boundary_points) {
-  double delta_ts = FLAGS_prediction_period;
-  KalmanFilter<double, 2, 2, 4> kf = kf_pedestrian_tracker;
-  // set the control matrix and control vector
-  Eigen::Matrix<double, 2, 2> P = kf.GetStateCovariance();
-  Eigen::Matrix<double, 2, 1> x;
-  x.setZero();
-  kf.SetStateEstimate(x, P);
+    const int num_regions, const double delta_ts,
+    Eigen::Matrix2Xd* middle_points, Eigen::Matrix2Xd* boundary_points) {
+  // The prediction steps of the tracker are run on its matrices, without
+  // copying the filter. The transition noise is that of a prediction period,
+  // scaled to the time between two regions.
+  const Eigen::Matrix2d& F = kf_pedestrian_tracker.GetTransitionMatrix();
+  const Eigen::Matrix2d Q = kf_pedestrian_tracker.GetTransitionNoise() *
+                            (delta_ts / FLAGS_prediction_period);
 
+  // set the control matrix and control vector
   Eigen::Matrix<double, 2, 4> B;
   B.setZero();
   B(0, 0) = delta_ts;
@@ -243,83 +262,83 @@ void RegionalPredictor::GetTrajectoryCandidatePoints(
     u(2, 0) = acceleration.x();
     u(3, 0) = acceleration.y();
   }
+  const Eigen::Vector2d control = B * u;
+
+  // the region centers and variances, one column per region
+  middle_points->resize(2, num_regions);
+  Eigen::Array2Xd variances(2, num_regions);
+  Eigen::Vector2d x = Eigen::Vector2d::Zero();
+  Eigen::Matrix2d P = kf_pedestrian_tracker.GetStateCovariance();
+  for (int i = 0; i < num_regions; ++i) {
+    x = F * x + control;
+    P = F * P * F.transpose() + Q;
+    middle_points->col(i) = x;
+    variances.col(i) = P.diagonal();
+  }
+  const Eigen::Array2Xd ellipse_lens =
+      variances.abs().sqrt() * FLAGS_coeff_mul_sigma;
 
-  kf.SetControlMatrix(B);
-
-  TrajectoryPoint prev_middle_point;
-  prev_middle_point.mutable_path_point()->set_x(position[0]);
-  prev_middle_point.mutable_path_point()->set_y(position[1]);
-
-  for (int i = 0; i < static_cast<int>(total_time / delta_ts); ++i) {
-    kf.Predict(u);
-    Eigen::Matrix<double, 2, 2> P = kf.GetStateCovariance();
-    double ellipse_len_x = std::sqrt(std::fabs(P(0, 0)));
-    double ellipse_len_y = std::sqrt(std::fabs(P(1, 1)));
-    ellipse_len_x *= FLAGS_coeff_mul_sigma;
-    ellipse_len_y *= FLAGS_coeff_mul_sigma;
-
-    Eigen::Matrix<double, 2, 1> state = kf.GetStateEstimate();
-    double middle_point_x = state(0, 0);
-    double middle_point_y = state(1, 0);
-    TrajectoryPoint middle_point;
-    middle_point.mutable_path_point()->set_x(middle_point_x);
-    middle_point.mutable_path_point()->set_y(middle_point_y);
-    TrajectoryPoint boundary_point_1;
-    TrajectoryPoint boundary_point_2;
+  boundary_points->resize(2, 2 * num_regions);
+  Eigen::Vector2d prev_middle_point = position;
+  for (int i = 0; i < num_regions; ++i) {
+    const Eigen::Vector2d middle_point = middle_points->col(i);
     Eigen::Vector2d direction =
         GetUnitVector2d(prev_middle_point, middle_point);
-    GetTwoEllipsePoints(middle_point_x, middle_point_y, direction[0],
-                        direction[1], ellipse_len_x, ellipse_len_y,
+    Eigen::Vector2d boundary_point_1;
+    Eigen::Vector2d boundary_point_2;
+    GetTwoEllipsePoints(middle_point[0], middle_point[1], direction[0],
+                        direction[1], ellipse_lens(0, i), ellipse_lens(1, i),
                         &boundary_point_1, &boundary_point_2);
+    boundary_points->col(2 * i) = boundary_point_1;
+    boundary_points->col(2 * i + 1) = boundary_point_2;
     prev_middle_point = middle_point;
-
-    middle_points->push_back(std::move(middle_point));
-    boundary_points->push_back(std::move(boundary_point_1));
-    boundary_points->push_back(std::move(boundary_point_2));
   }
 }
 
 void RegionalPredictor::UpdateTrajectoryPoints(
     const TrajectoryPoint& starting_point, const Eigen::Vector2d& velocity,
-    const double delta_ts, const std::vector<TrajectoryPoint>& middle_points,
-    const std::vector<TrajectoryPoint>& boundary_points,
+    const double delta_ts, const Eigen::Matrix2Xd& middle_points,
+    const Eigen::Matrix2Xd& boundary_points,
     std::vector<TrajectoryPoint>* left_points,
     std::vector<TrajectoryPoint>* right_points) {
-  if (2 * middle_points.size() != boundary_points.size()) {
+  if (2 * middle_points.cols() != boundary_points.cols()) {
     AWARN << "Middle and ellipse points sizes not match";
   }
   double speed = std::hypot(velocity[0], velocity[1]);
   double left_heading = std::atan2(velocity[1], velocity[0]);
   double right_heading = std::atan2(velocity[1], velocity[0]);
 
+  left_points->reserve(boundary_points.cols() + 1);
+  right_points->reserve(boundary_points.cols() + 1);
   TrajectoryPoint left_starting_point = starting_point;
   left_points->push_back(std::move(left_starting_point));
   TrajectoryPoint right_starting_point = starting_point;
   right_points->push_back(std::move(right_starting_point));
 
+  const Eigen::Vector2d starting_position = ToVector2d(starting_point);
   int left_i = 0;
   int right_i = 0;
-  for (size_t i = 0; i < middle_points.size(); ++i) {
-    TrajectoryPoint prev_middle_point = starting_point;
+  for (int i = 0; i < middle_points.cols(); ++i) {
+    Eigen::Vector2d prev_middle_point = starting_position;
     if (i > 0) {
-      prev_middle_point = middle_points[i - 1];
+      prev_middle_point = middle_points.col(i - 1);
     }
     Eigen::Vector2d middle_direction =
-        GetUnitVector2d(prev_middle_point, middle_points[i]);
-    if (2 * i > boundary_points.size()) {
+        GetUnitVector2d(prev_middle_point, middle_points.col(i));
+    if (2 * i > boundary_points.cols()) {
       break;
     }
-    TrajectoryPoint boundary_point_1 = boundary_points[2 * i];
-    InsertTrajectoryPoint(prev_middle_point, middle_direction, boundary_point_1,
-                          speed, delta_ts, &left_i, &right_i, &left_heading,
-                          &right_heading, left_points, right_points);
-    if (2 * i + 1 >= boundary_points.size()) {
+    InsertTrajectoryPoint(prev_middle_point, middle_direction,
+                          boundary_points.col(2 * i), speed, delta_ts, &left_i,
+                          &right_i, &left_heading, &right_heading, left_points,
+                          right_points);
+    if (2 * i + 1 >= boundary_points.cols()) {
       break;
     }
-    TrajectoryPoint boundary_point_2 = boundary_points[2 * i + 1];
-    InsertTrajectoryPoint(prev_middle_point, middle_direction, boundary_point_2,
-                          speed, delta_ts, &left_i, &right_i, &left_heading,
-                          &right_heading, left_points, right_points);
+    InsertTrajectoryPoint(prev_middle_point, middle_direction,
+                          boundary_points.col(2 * i + 1), speed, delta_ts,
+                          &left_i, &right_i, &left_heading, &right_heading,
+                          left_points, right_points);
   }
 
   left_points->back().set_v(speed);
@@ -332,9 +351,9 @@ void RegionalPredictor::UpdateTrajectoryPoints(
 }
 
 void RegionalPredictor::InsertTrajectoryPoint(
-    const TrajectoryPoint& prev_middle_point,
+    const Eigen::Vector2d& prev_middle_point,
     const Eigen::Vector2d& middle_direction,
-    const TrajectoryPoint& boundary_point, const double speed,
+    const Eigen::Vector2d& boundary_point, const double speed,
     const double delta_ts, int* left_i, int* right_i, double* left_heading,
     double* right_heading, std::vector<TrajectoryPoint>* left_points,
     std::vector<TrajectoryPoint>* right_points) {
@@ -344,47 +363,45 @@ void RegionalPredictor::InsertTrajectoryPoint(
   if (cross_product < 0.0) {
     if (!left_points->empty()) {
       TrajectoryPoint& prev_point = left_points->back();
-      Eigen::Vector2d dir = GetUnitVector2d(prev_point, boundary_point);
+      Eigen::Vector2d dir =
+          GetUnitVector2d(ToVector2d(prev_point), boundary_point);
       *left_heading = std::atan2(dir[1], dir[0]);
       prev_point.mutable_path_point()->set_theta(*left_heading);
       prev_point.set_v(speed);
       prev_point.set_relative_time((*left_i) * delta_ts);
       ++(*left_i);
     }
-    left_points->push_back(boundary_point);
+    left_points->push_back(ToTrajectoryPoint(boundary_point));
   } else {
     if (!right_points->empty()) {
       TrajectoryPoint& prev_point = right_points->back();
-      Eigen::Vector2d dir = GetUnitVector2d(prev_point, boundary_point);
+      Eigen::Vector2d dir =
+          GetUnitVector2d(ToVector2d(prev_point), boundary_point);
       *right_heading = std::atan2(dir[1], dir[0]);
       prev_point.mutable_path_point()->set_theta(*right_heading);
       prev_point.set_v(speed);
       prev_point.set_relative_time((*right_i) * delta_ts);
       ++(*right_i);
     }
-    right_points->push_back(boundary_point);
+    right_points->push_back(ToTrajectoryPoint(boundary_point));
   }
 }
 
 void RegionalPredictor::GetTwoEllipsePoints(
     const double position_x, const double position_y, const double direction_x,
     const double direction_y, const double ellipse_len_x,
-    const double ellipse_len_y, TrajectoryPoint* ellipse_point_1,
-    TrajectoryPoint* ellipse_point_2) {
+    const double ellipse_len_y, Eigen::Vector2d* ellipse_point_1,
+    Eigen::Vector2d* ellipse_point_2) {
   // vertical case
   if (std::fabs(direction_x) <= std::numeric_limits<double>::epsilon()) {
-    ellipse_point_1->mutable_path_point()->set_x(position_x - ellipse_len_x);
-    ellipse_point_1->mutable_path_point()->set_y(position_y);
-    ellipse_point_2->mutable_path_point()->set_x(position_x + ellipse_len_x);
-    ellipse_point_2->mutable_path_point()->set_y(position_y);
+    *ellipse_point_1 << position_x - ellipse_len_x, position_y;
+    *ellipse_point_2 << position_x + ellipse_len_x, position_y;
     return;
   }
   // horizontal case
   if (std::fabs(direction_y) <= std::numeric_limits<double>::epsilon()) {
-    ellipse_point_1->mutable_path_point()->set_x(position_x);
-    ellipse_point_1->mutable_path_point()->set_y(position_y + ellipse_len_y);
-    ellipse_point_2->mutable_path_point()->set_x(position_x);
-    ellipse_point_2->mutable_path_point()->set_y(position_y - ellipse_len_y);
+    *ellipse_point_1 << position_x, position_y + ellipse_len_y;
+    *ellipse_point_2 << position_x, position_y - ellipse_len_y;
     return;
   }
   // general case
@@ -402,10 +419,8 @@ void RegionalPredictor::GetTwoEllipsePoints(
   const double ellipse_point_1_y = temp_p * ellipse_point_1_x + temp_q;
   const double ellipse_point_2_y = temp_p * ellipse_point_2_x + temp_q;
 
-  ellipse_point_1->mutable_path_point()->set_x(ellipse_point_1_x);
-  ellipse_point_1->mutable_path_point()->set_y(ellipse_point_1_y);
-  ellipse_point_2->mutable_path_point()->set_x(ellipse_point_2_x);
-  ellipse_point_2->mutable_path_point()->set_y(ellipse_point_2_y);
+  *ellipse_point_1 << ellipse_point_1_x, ellipse_point_1_y;
+  *ellipse_point_2 << ellipse_point_2_x, ellipse_point_2_y;
 }
 
 void RegionalPredictor::GetQuadraticCoefficients(
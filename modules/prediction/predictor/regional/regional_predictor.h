@@ -69,26 +69,30 @@ class RegionalPredictor : public Predictor {
       std::vector<apollo::common::TrajectoryPoint>* left_points,
       std::vector<apollo::common::TrajectoryPoint>* right_points);
 
+  /**
+   * @brief Get the centers and boundary points of the regions along the
+   *        trajectory, one column per point, with two boundary points per
+   *        region.
+   */
   void GetTrajectoryCandidatePoints(
       const Eigen::Vector2d& position, const Eigen::Vector2d& velocity,
       const Eigen::Vector2d& acceleration,
       const apollo::common::math::KalmanFilter<double, 2, 2, 4>& kf,
-      const double total_time,
-      std::vector<apollo::common::TrajectoryPoint>* middle_points,
-      std::vector<apollo::common::TrajectoryPoint>* boundary_points);
+      const int num_regions, const double delta_ts,
+      Eigen::Matrix2Xd* middle_points, Eigen::Matrix2Xd* boundary_points);
 
   void UpdateTrajectoryPoints(
       const apollo::common::TrajectoryPoint& starting_point,
       const Eigen::Vector2d& velocity, const double delta_ts,
-      const std::vector<apollo::common::TrajectoryPoint>& middle_points,
-      const std::vector<apollo::common::TrajectoryPoint>& boundary_points,
+      const Eigen::Matrix2Xd& middle_points,
+      const Eigen::Matrix2Xd& boundary_points,
       std::vector<apollo::common::TrajectoryPoint>* left_points,
       std::vector<apollo::common::TrajectoryPoint>* right_points);
 
   void InsertTrajectoryPoint(
-      const apollo::common::TrajectoryPoint& prev_middle_point,
+      const Eigen::Vector2d& prev_middle_point,
       const Eigen::Vector2d& middle_direction,
-      const apollo::common::TrajectoryPoint& boundary_point, const double speed,
+      const Eigen::Vector2d& boundary_point, const double speed,
       const double delta_ts, int* left_i, int* right_i, double* left_heading,
       double* right_heading,
       std::vector<apollo::common::TrajectoryPoint>* left_points,
@@ -98,8 +102,8 @@ class RegionalPredictor : public Predictor {
                            const double direction_x, const double direction_y,
                            const double ellipse_len_x,
                            const double ellipse_len_y,
-                           apollo::common::TrajectoryPoint* ellipse_point_1,
-                           apollo::common::TrajectoryPoint* ellipse_point_2);
+                           Eigen::Vector2d* ellipse_point_1,
+                           Eigen::Vector2d* ellipse_point_2);
 
   void GetQuadraticCoefficients(const double position_x,
                                 const double position_y,
@@ -81,6 +81,28 @@ TEST_F(RegionalPredictorTest, MovingPedestrian) {
               0.001);
 }
 
+TEST_F(RegionalPredictorTest, MovingPedestrianRegionsBudget) {
+  FLAGS_max_num_pedestrian_regions = 20;
+  ObstaclesContainer container;
+  container.Insert(perception_obstacles_);
+  Obstacle* obstacle_ptr = container.GetObstacle(101);
+  EXPECT_TRUE(obstacle_ptr != nullptr);
+  RegionalPredictor predictor;
+  predictor.Predict(obstacle_ptr);
+  FLAGS_max_num_pedestrian_regions = 0;
+  const std::vector<Trajectory>& trajectories = predictor.trajectories();
+  EXPECT_EQ(trajectories.size(), 2);
+  // two boundary points per region, plus the two starting points
+  EXPECT_EQ(trajectories[0].trajectory_point_size() +
+                trajectories[1].trajectory_point_size(),
+            42);
+  for (const Trajectory& trajectory : trajectories) {
+    const int size = trajectory.trajectory_point_size();
+    EXPECT_LE(trajectory.trajectory_point(size - 1).relative_time(),
+              FLAGS_prediction_pedestrian_total_time);
+  }
+}
+
 TEST_F(RegionalPredictorTest, StationaryPedestrian) {
   EXPECT_DOUBLE_EQ(perception_obstacles_.header().timestamp_sec(),
                    1501183430.161906);
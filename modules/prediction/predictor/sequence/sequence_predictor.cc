@@ -69,6 +69,13 @@ void SequencePredictor::FilterLaneSequences(
   std::pair<int, double> change(-1, -1.0);
   std::pair<int, double> all(-1, -1.0);
 
+  ADCTrajectoryContainer* adc_container = dynamic_cast<ADCTrajectoryContainer*>(
+      ContainerManager::instance()->GetContainer(
+          AdapterConfig::PLANNING_TRAJECTORY));
+  CHECK_NOTNULL(adc_container);
+  std::vector<bool> adc_overlaps;
+  adc_container->HasOverlaps(lane_graph, &adc_overlaps);
+
   for (int i = 0; i < num_lane_sequence; ++i) {
     const LaneSequence& sequence = lane_graph.lane_sequence(i);
     lane_change_type[i] = GetLaneChangeType(lane_id, sequence);
@@ -80,6 +87,12 @@ void SequencePredictor::FilterLaneSequences(
       continue;
     }
 
+    if (!adc_overlaps[i]) {
+      ADEBUG << "The sequence [" << ToString(sequence)
+             << "] has no overlap with ADC.";
+      continue;
+    }
+
     // The obstacle has interference with ADC within a small distance
     double distance = GetLaneChangeDistanceWithADC(sequence);
     ADEBUG << "Distance to ADC " << std::fixed << std::setprecision(6)
@@ -158,17 +171,7 @@ double SequencePredictor::GetLaneChangeDistanceWithADC(
     const LaneSequence& lane_sequence) {
   PoseContainer* pose_container = dynamic_cast<PoseContainer*>(
       ContainerManager::instance()->GetContainer(AdapterConfig::LOCALIZATION));
-  ADCTrajectoryContainer* adc_container = dynamic_cast<ADCTrajectoryContainer*>(
-      ContainerManager::instance()->GetContainer(
-          AdapterConfig::PLANNING_TRAJECTORY));
   CHECK_NOTNULL(pose_container);
-  CHECK_NOTNULL(adc_container);
-
-  if (!adc_container->HasOverlap(lane_sequence)) {
-    ADEBUG << "The sequence [" << ToString(lane_sequence)
-           << "] has no overlap with ADC.";
-    return std::numeric_limits<double>::max();
-  }
 
   Eigen::Vector2d adc_position;
   if (pose_container->ToPerceptionObstacle() != nullptr) {
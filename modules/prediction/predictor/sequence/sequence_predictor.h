@@ -84,7 +84,7 @@ class SequencePredictor : public Predictor {
 
   /**
    * @brief Get lane change distance with ADC
-   * @param Target lane sequence
+   * @param Target lane sequence, which has overlap with ADC trajectory
    * @return Lane change distance with ADC
    */
   double GetLaneChangeDistanceWithADC(const LaneSequence& lane_sequence);
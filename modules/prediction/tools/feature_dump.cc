@@ -0,0 +1,164 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file feature_dump.cc
+ * @brief Replays recorded perception obstacles through the obstacles
+ * container as fast as possible, without ROS spinning, and writes the
+ * obstacle features and the MLP evaluator features of their lane sequences
+ * in compressed columnar chunks for training. The recordings are processed
+ * in parallel, each into chunks <dump dir>/<recording name>.<n>.bin.gz.
+ *
+ * \par
+ * bazel run //modules/prediction/tools:feature_dump --
+ *     --feature_dump_recordings=/data/bag/a.bag,/data/bag/b.bag
+ *     --feature_dump_dir=/data/features
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "gflags/gflags.h"
+#include "rosbag/bag.h"
+#include "rosbag/view.h"
+
+#include "modules/common/adapters/adapter_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/util/parallel_for.h"
+#include "modules/common/util/string_tokenizer.h"
+#include "modules/perception/proto/perception_obstacle.pb.h"
+#include "modules/prediction/common/feature_chunk_writer.h"
+#include "modules/prediction/container/obstacles/obstacles_container.h"
+#include "modules/prediction/evaluator/vehicle/mlp_evaluator.h"
+
+DEFINE_string(feature_dump_recordings, "",
+              "Comma separated rosbag files of recorded perception obstacles.");
+DEFINE_string(feature_dump_dir, "/tmp",
+              "The directory of the feature chunk files.");
+DEFINE_int32(feature_dump_chunk_size, 10000,
+             "The number of obstacle features of a chunk.");
+DEFINE_int32(feature_dump_num_threads, 0,
+             "The number of recordings processed in parallel; 0 for one per "
+             "hardware thread.");
+
+namespace apollo {
+namespace prediction {
+namespace {
+
+using apollo::perception::PerceptionObstacles;
+
+std::string RecordingName(const std::string& recording) {
+  const std::size_t begin = recording.find_last_of('/') + 1;
+  const std::size_t end = recording.find_last_of('.');
+  return recording.substr(
+      begin, end == std::string::npos || end < begin ? std::string::npos
+                                                     : end - begin);
+}
+
+bool DumpRecording(const std::string& recording) {
+  rosbag::Bag bag;
+  try {
+    bag.open(recording, rosbag::bagmode::Read);
+  } catch (const rosbag::BagException& e) {
+    AERROR << "Failed to open " << recording << ": " << e.what();
+    return false;
+  }
+  rosbag::View view(bag, rosbag::TopicQuery(std::vector<std::string>{
+                             FLAGS_perception_obstacle_topic}));
+
+  FeatureChunkWriter writer(
+      FLAGS_feature_dump_dir + "/" + RecordingName(recording),
+      FLAGS_feature_dump_chunk_size);
+  ObstaclesContainer container;
+  MLPEvaluator evaluator;
+  std::vector<double> feature_values;
+  for (const rosbag::MessageInstance& message : view) {
+    const auto perception_obstacles =
+        message.instantiate<PerceptionObstacles>();
+    if (perception_obstacles == nullptr) {
+      continue;
+    }
+    container.Insert(*perception_obstacles);
+    evaluator.Clear();
+    for (const auto& perception_obstacle :
+         perception_obstacles->perception_obstacle()) {
+      Obstacle* obstacle = container.GetObstacle(perception_obstacle.id());
+      if (obstacle == nullptr || obstacle->history_size() == 0) {
+        continue;
+      }
+      Feature* feature = obstacle->mutable_latest_feature();
+      if (obstacle->IsOnLane()) {
+        for (auto& lane_sequence :
+             *feature->mutable_lane()->mutable_lane_graph()
+                  ->mutable_lane_sequence()) {
+          feature_values.clear();
+          evaluator.ExtractFeatureValues(obstacle, &lane_sequence,
+                                         &feature_values);
+          if (!feature_values.empty()) {
+            writer.AppendLaneSequence(lane_sequence, feature_values);
+          }
+        }
+      }
+      if (!writer.AppendFeature(*feature)) {
+        return false;
+      }
+    }
+  }
+  bag.close();
+  if (!writer.Close()) {
+    return false;
+  }
+  AINFO << "Dumped " << recording << " in " << writer.num_chunks()
+        << " chunks.";
+  return true;
+}
+
+int Run() {
+  const std::vector<std::string> recordings =
+      common::util::StringTokenizer::Split(FLAGS_feature_dump_recordings, ",");
+  if (recordings.empty()) {
+    AERROR << "No recording given in --feature_dump_recordings.";
+    return EXIT_FAILURE;
+  }
+
+  std::atomic<int> num_failures(0);
+  common::util::ParallelFor(
+      static_cast<int>(recordings.size()), FLAGS_feature_dump_num_threads,
+      [&recordings, &num_failures](const int i) {
+        if (!DumpRecording(recordings[i])) {
+          ++num_failures;
+        }
+      });
+  if (num_failures > 0) {
+    AERROR << num_failures << " of " << recordings.size()
+           << " recordings failed.";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace prediction
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  return apollo::prediction::Run();
+}
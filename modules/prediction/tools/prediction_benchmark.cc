@@ -0,0 +1,249 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file prediction_benchmark.cc
+ * @brief Replays recorded perception obstacles through Prediction::RunOnce()
+ * as fast as possible, and reports the cycle latency and the time of every
+ * stage: the container insertion, the evaluators and the predictors.
+ *
+ * \par
+ * The directory holds frames frame_<n>.pb.txt of perception obstacles, for
+ * n = 1, 2, ..., as in the frame sequence test data. To measure how the
+ * latency scales with the number of obstacles, every frame is padded with
+ * copies of its obstacles, shifted along their heading, up to
+ * --benchmark_num_obstacles obstacles.
+ *
+ * \par
+ * bazel run //modules/prediction/tools:prediction_benchmark --
+ *     --benchmark_data_dir=modules/prediction/testdata/frame_sequence
+ *     --benchmark_num_obstacles=100
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/configs/config_gflags.h"
+#include "modules/common/log.h"
+#include "modules/common/time/time.h"
+#include "modules/common/util/file.h"
+#include "modules/perception/proto/perception_obstacle.pb.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/prediction.h"
+
+DEFINE_string(benchmark_data_dir, "modules/prediction/testdata/frame_sequence",
+              "The directory of the recorded frames to replay.");
+DEFINE_int32(benchmark_num_obstacles, 0,
+             "The number of obstacles of every frame, reached by copying the "
+             "recorded ones; 0 to replay the frames as recorded.");
+DEFINE_double(benchmark_obstacle_spacing, 8.0,
+              "The distance in meters between the copies of an obstacle.");
+DEFINE_int32(benchmark_num_iterations, 10,
+             "The number of times all the frames are replayed.");
+DEFINE_int32(benchmark_num_warmup_iterations, 1,
+             "The number of replays before the measured ones.");
+
+namespace apollo {
+namespace prediction {
+
+using apollo::common::adapter::AdapterManager;
+using apollo::common::time::Clock;
+using apollo::perception::PerceptionObstacle;
+using apollo::perception::PerceptionObstacles;
+
+namespace {
+
+// The ids of the copies of an obstacle are offset by multiples of this.
+constexpr int kCopyIdStride = 100000;
+
+std::string FramePath(const int index) {
+  return FLAGS_benchmark_data_dir + "/frame_" + std::to_string(index) +
+         ".pb.txt";
+}
+
+bool LoadFrames(std::vector<PerceptionObstacles>* frames) {
+  for (int index = 1;; ++index) {
+    const std::string frame_file = FramePath(index);
+    if (!common::util::PathExists(frame_file)) {
+      break;
+    }
+    PerceptionObstacles frame;
+    if (!common::util::GetProtoFromFile(frame_file, &frame)) {
+      AERROR << "Failed to load " << frame_file;
+      return false;
+    }
+    frames->push_back(std::move(frame));
+  }
+  if (frames->empty()) {
+    AERROR << "No frame found in " << FLAGS_benchmark_data_dir;
+    return false;
+  }
+  return true;
+}
+
+// Pads the frame with copies of its obstacles up to num_obstacles. The k-th
+// copy of an obstacle is shifted along its heading, alternately forward and
+// backward, so that it stays on the lanes of the original.
+void AddObstacleCopies(const int num_obstacles, PerceptionObstacles* frame) {
+  const int num_recorded = frame->perception_obstacle_size();
+  for (int copy = 1;
+       num_recorded > 0 && frame->perception_obstacle_size() < num_obstacles;
+       ++copy) {
+    const double shift = FLAGS_benchmark_obstacle_spacing * ((copy + 1) / 2) *
+                         (copy % 2 == 1 ? 1.0 : -1.0);
+    for (int i = 0;
+         i < num_recorded && frame->perception_obstacle_size() < num_obstacles;
+         ++i) {
+      PerceptionObstacle* obstacle = frame->add_perception_obstacle();
+      obstacle->CopyFrom(frame->perception_obstacle(i));
+      obstacle->set_id(obstacle->id() + copy * kCopyIdStride);
+      obstacle->mutable_position()->set_x(obstacle->position().x() +
+                                          shift * std::cos(obstacle->theta()));
+      obstacle->mutable_position()->set_y(obstacle->position().y() +
+                                          shift * std::sin(obstacle->theta()));
+    }
+  }
+}
+
+// Shifts the timestamps of the frame, so that every replay looks like a new
+// recording to the obstacles container.
+void ShiftTimestamps(const double offset, PerceptionObstacles* frame) {
+  frame->mutable_header()->set_timestamp_sec(frame->header().timestamp_sec() +
+                                             offset);
+  for (auto& obstacle : *frame->mutable_perception_obstacle()) {
+    if (obstacle.timestamp() > 0.0) {
+      obstacle.set_timestamp(obstacle.timestamp() + offset);
+    }
+  }
+}
+
+double Percentile(const std::vector<double>& sorted_values,
+                  const double percentile) {
+  if (sorted_values.empty()) {
+    return 0.0;
+  }
+  const std::size_t index = static_cast<std::size_t>(
+      percentile * (sorted_values.size() - 1) + 0.5);
+  return sorted_values[std::min(index, sorted_values.size() - 1)];
+}
+
+void PrintStats(const std::string& name, std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  double sum = 0.0;
+  for (const double value : values) {
+    sum += value;
+  }
+  const double mean = values.empty() ? 0.0 : sum / values.size();
+  std::printf("%-32s %8zu %10.3f %10.3f %10.3f %10.3f\n", name.c_str(),
+              values.size(), mean, Percentile(values, 0.5),
+              Percentile(values, 0.99),
+              values.empty() ? 0.0 : values.back());
+}
+
+int RunBenchmark() {
+  std::vector<PerceptionObstacles> frames;
+  if (!LoadFrames(&frames)) {
+    return EXIT_FAILURE;
+  }
+  for (auto& frame : frames) {
+    AddObstacleCopies(FLAGS_benchmark_num_obstacles, &frame);
+  }
+  Prediction prediction;
+  if (!prediction.Init().ok()) {
+    AERROR << "Failed to init prediction";
+    return EXIT_FAILURE;
+  }
+  if (!AdapterManager::GetPrediction()) {
+    AERROR << "Prediction adapter is not configured in "
+           << FLAGS_prediction_adapter_config_filename;
+    return EXIT_FAILURE;
+  }
+
+  // A gap larger than the replay gap makes the obstacles container start
+  // over at every replay, as it does at the start of a recording.
+  const double replay_offset = frames.back().header().timestamp_sec() -
+                               frames.front().header().timestamp_sec() +
+                               FLAGS_replay_timestamp_gap + 1.0;
+  std::vector<double> cycle_time_ms;
+  std::vector<double> num_predicted_obstacles;
+  std::map<std::string, std::vector<double>> stage_time_ms;
+  const int num_iterations =
+      FLAGS_benchmark_num_warmup_iterations + FLAGS_benchmark_num_iterations;
+  for (int iteration = 0; iteration < num_iterations; ++iteration) {
+    const bool is_measured =
+        iteration >= FLAGS_benchmark_num_warmup_iterations;
+    for (const auto& recorded_frame : frames) {
+      PerceptionObstacles frame = recorded_frame;
+      ShiftTimestamps(iteration * replay_offset, &frame);
+      const double start_time = Clock::NowInSeconds();
+      prediction.RunOnce(frame);
+      const double end_time = Clock::NowInSeconds();
+      if (!is_measured) {
+        continue;
+      }
+      cycle_time_ms.push_back((end_time - start_time) * 1000.0);
+      for (const auto& stage : prediction.stage_time_ms()) {
+        stage_time_ms[stage.first].push_back(stage.second);
+      }
+      const auto* prediction_obstacles =
+          AdapterManager::GetPrediction()->GetLatestPublished();
+      if (prediction_obstacles != nullptr) {
+        num_predicted_obstacles.push_back(
+            prediction_obstacles->prediction_obstacle_size());
+      }
+    }
+  }
+  prediction.Stop();
+
+  std::printf("%zu frames of %d obstacles, %d iterations\n", frames.size(),
+              frames.front().perception_obstacle_size(),
+              FLAGS_benchmark_num_iterations);
+  std::printf("%-32s %8s %10s %10s %10s %10s\n", "", "count", "mean", "p50",
+              "p99", "max");
+  PrintStats("cycle time (ms)", cycle_time_ms);
+  for (const auto& stage : stage_time_ms) {
+    PrintStats(stage.first + " (ms)", stage.second);
+  }
+  PrintStats("predicted obstacles", num_predicted_obstacles);
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace prediction
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  // The defaults of the prediction tests; all of them can be overridden on
+  // the command line.
+  FLAGS_prediction_conf_file = "modules/prediction/conf/prediction_conf.pb.txt";
+  FLAGS_prediction_adapter_config_filename =
+      "modules/prediction/testdata/benchmark_adapter_conf.pb.txt";
+  FLAGS_map_dir = "modules/prediction/testdata";
+  FLAGS_base_map_filename = "kml_map.bin";
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  return apollo::prediction::RunBenchmark();
+}
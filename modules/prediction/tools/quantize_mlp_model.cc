@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+/**
+ * @file quantize_mlp_model.cc
+ * @brief Converts the float weights of the MLP vehicle model to int8 with a
+ * scale per layer, and validates the converted model: the lane sequence
+ * probabilities of random samples drawn from the feature distribution of
+ * the model are compared with the ones of the float model.
+ *
+ * \par
+ * bazel run //modules/prediction/tools:quantize_mlp_model --
+ *     --quantized_mlp_file=/apollo/modules/prediction/data/mlp_model_int8.bin
+ */
+
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "Eigen/Dense"
+#include "gflags/gflags.h"
+
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "modules/prediction/common/prediction_gflags.h"
+#include "modules/prediction/evaluator/vehicle/mlp_evaluator.h"
+#include "modules/prediction/proto/fnn_vehicle_model.pb.h"
+
+DEFINE_string(quantized_mlp_file, "",
+              "The file of the int8 model converted from "
+              "--evaluator_vehicle_mlp_file.");
+DEFINE_int32(quantize_num_validation_samples, 10000,
+             "The number of random samples to compare the probabilities of "
+             "the int8 and the float models.");
+DEFINE_double(quantize_max_probability_error, 0.05,
+              "The largest probability error of the int8 model accepted.");
+
+namespace apollo {
+namespace prediction {
+namespace {
+
+int Run() {
+  if (FLAGS_quantized_mlp_file.empty()) {
+    AERROR << "No --quantized_mlp_file given";
+    return EXIT_FAILURE;
+  }
+  FnnVehicleModel model;
+  if (!common::util::GetProtoFromFile(FLAGS_evaluator_vehicle_mlp_file,
+                                      &model)) {
+    AERROR << "Failed to load " << FLAGS_evaluator_vehicle_mlp_file;
+    return EXIT_FAILURE;
+  }
+  const int dim_input = model.dim_input();
+  if (model.samples_mean().columns_size() != dim_input ||
+      model.samples_std().columns_size() != dim_input) {
+    AERROR << "Incorrect normalization in "
+           << FLAGS_evaluator_vehicle_mlp_file;
+    return EXIT_FAILURE;
+  }
+  MLPEvaluator float_evaluator;
+
+  MLPEvaluator::QuantizeModel(&model);
+  if (!common::util::SetProtoToBinaryFile(model, FLAGS_quantized_mlp_file)) {
+    AERROR << "Failed to write " << FLAGS_quantized_mlp_file;
+    return EXIT_FAILURE;
+  }
+  FLAGS_evaluator_vehicle_mlp_file = FLAGS_quantized_mlp_file;
+  MLPEvaluator quantized_evaluator;
+
+  // The samples follow the normal distributions of the training features.
+  const int num_samples = FLAGS_quantize_num_validation_samples;
+  std::mt19937 generator(0);
+  std::normal_distribution<float> normal;
+  Eigen::MatrixXf samples(num_samples, dim_input);
+  for (int col = 0; col < dim_input; ++col) {
+    const float mean = model.samples_mean().columns(col);
+    const float std = model.samples_std().columns(col);
+    for (int row = 0; row < num_samples; ++row) {
+      samples(row, col) = mean + std * normal(generator);
+    }
+  }
+  Eigen::MatrixXf float_samples = samples;
+  Eigen::VectorXf float_probabilities;
+  float_evaluator.ComputeProbabilities(&float_samples, &float_probabilities);
+  Eigen::VectorXf quantized_probabilities;
+  quantized_evaluator.ComputeProbabilities(&samples, &quantized_probabilities);
+
+  const Eigen::ArrayXf errors =
+      (quantized_probabilities - float_probabilities).array().abs();
+  const float max_error = num_samples > 0 ? errors.maxCoeff() : 0.0f;
+  const float mean_error = num_samples > 0 ? errors.mean() : 0.0f;
+  AINFO << "Probability errors of the int8 model over " << num_samples
+        << " samples: mean " << mean_error << ", max " << max_error;
+  if (max_error > FLAGS_quantize_max_probability_error) {
+    AERROR << "The int8 model " << FLAGS_quantized_mlp_file
+           << " is not accurate enough";
+    return EXIT_FAILURE;
+  }
+  AINFO << "Wrote the int8 model " << FLAGS_quantized_mlp_file;
+  return EXIT_SUCCESS;
+}
+
+}  // namespace
+}  // namespace prediction
+}  // namespace apollo
+
+int main(int argc, char** argv) {
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  return apollo::prediction::Run();
+}
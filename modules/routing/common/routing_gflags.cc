@@ -34,3 +34,27 @@ DEFINE_double(min_length_for_lane_change, 30.48,
 
 DEFINE_bool(enable_change_lane_in_result, true,
             "contain change lane operator in result");
+
+DEFINE_int32(routing_num_landmarks, 16,
+             "the number of landmarks whose distance tables topo_creator adds "
+             "to the topo graph, 0 for none");
+DEFINE_bool(enable_landmark_heuristic, true,
+            "search with the landmark distance tables of the topo graph "
+            "when it has them");
+DEFINE_bool(enable_incremental_rerouting, false,
+            "reroute a request for the waypoints of the last route by a "
+            "detour from the new start that rejoins the last route; the "
+            "detour may change lanes at other points than a full search");
+DEFINE_int32(routing_cache_capacity, 64,
+             "the number of routes kept for the repeated requests, 0 for "
+             "none");
+DEFINE_double(routing_cache_s_resolution, 0.5,
+              "meters, the waypoints of two requests closer than this on the "
+              "same lanes may share a cached route");
+
+DEFINE_int32(routing_num_worker_threads, 4,
+             "the number of threads searching routing requests concurrently, "
+             "0 to search them on the thread receiving them");
+DEFINE_int32(topo_creator_num_threads, 0,
+             "the number of threads topo_creator creates the nodes and edges "
+             "of the lanes on, 0 for the number of hardware threads");
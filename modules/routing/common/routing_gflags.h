@@ -28,4 +28,13 @@ DECLARE_bool(use_road_id);
 DECLARE_double(min_length_for_lane_change);
 DECLARE_bool(enable_change_lane_in_result);
 
+DECLARE_int32(routing_num_landmarks);
+DECLARE_bool(enable_landmark_heuristic);
+DECLARE_bool(enable_incremental_rerouting);
+DECLARE_int32(routing_cache_capacity);
+DECLARE_double(routing_cache_s_resolution);
+
+DECLARE_int32(routing_num_worker_threads);
+DECLARE_int32(topo_creator_num_threads);
+
 #endif  // MODULES_ROUTING_COMMON_ROUTING_GFLAGS_H_
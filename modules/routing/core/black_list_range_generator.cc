@@ -151,5 +151,21 @@ void BlackListRangeGenerator::AddBlackMapFromTerminal(
   range_manager->SortAndMerge();
 }
 
+void BlackListRangeGenerator::AddBlackMapFromStart(
+    const TopoNode* src_node, double start_s,
+    TopoRangeManager* const range_manager) const {
+  double start_length = src_node->Length();
+  if (start_s < 0.0 || start_s > start_length) {
+    AERROR << "Illegal start_s: " << start_s << ", length: " << start_length;
+    return;
+  }
+
+  double start_cut_s = MoveSBackward(start_s, 0.0);
+  range_manager->Add(src_node, start_cut_s, start_cut_s);
+  AddBlackMapFromOutParallel(src_node, start_cut_s / start_length,
+                             range_manager);
+  range_manager->SortAndMerge();
+}
+
 }  // namespace routing
 }  // namespace apollo
@@ -41,6 +41,10 @@ class BlackListRangeGenerator {
                                const TopoNode* dest_node, double start_s,
                                double end_s,
                                TopoRangeManager* const range_manager) const;
+
+  // Cuts the start node only, as a search to several destinations needs.
+  void AddBlackMapFromStart(const TopoNode* src_node, double start_s,
+                            TopoRangeManager* const range_manager) const;
 };
 
 }  // namespace routing
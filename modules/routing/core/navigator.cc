@@ -17,15 +17,19 @@
 #include "modules/routing/core/navigator.h"
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
+#include <utility>
 
 #include "modules/common/proto/error_code.pb.h"
 
 #include "modules/common/log.h"
 #include "modules/common/util/file.h"
+#include "modules/common/util/string_util.h"
 #include "modules/routing/common/routing_gflags.h"
 #include "modules/routing/graph/sub_topo_graph.h"
 #include "modules/routing/strategy/a_star_strategy.h"
+#include "modules/routing/strategy/alt_strategy.h"
 
 namespace apollo {
 namespace routing {
@@ -34,6 +38,9 @@ namespace {
 
 using common::ErrorCode;
 
+// Waypoints closer than this on the same lane are the same, in meters.
+constexpr double kWaypointSEpsilon = 1e-3;
+
 bool ShowRequestInfo(const RoutingRequest& request, const TopoGraph* graph) {
   for (const auto& wp : request.waypoint()) {
     const auto* node = graph->GetNode(wp.id());
@@ -87,6 +94,69 @@ void SetErrorCode(const common::ErrorCode& error_code_id,
   }
 }
 
+std::unique_ptr<Strategy> CreateStrategy(const TopoGraph* graph) {
+  if (FLAGS_enable_landmark_heuristic && graph->HasLandmarks()) {
+    return std::unique_ptr<Strategy>(
+        new AltStrategy(FLAGS_enable_change_lane_in_result));
+  }
+  return std::unique_ptr<Strategy>(
+      new AStarStrategy(FLAGS_enable_change_lane_in_result));
+}
+
+bool IsSameWaypoint(const LaneWaypoint& waypoint,
+                    const LaneWaypoint& other_waypoint) {
+  return waypoint.id() == other_waypoint.id() &&
+         std::fabs(waypoint.s() - other_waypoint.s()) < kWaypointSEpsilon;
+}
+
+bool IsBlackListed(const NodeWithRange& node,
+                   const TopoRangeManager& range_manager) {
+  const auto& range_map = range_manager.RangeMap();
+  const auto iter = range_map.find(node.GetTopoNode());
+  if (iter == range_map.end()) {
+    return false;
+  }
+  for (const auto& range : iter->second) {
+    if (range.StartS() <= node.EndS() && range.EndS() >= node.StartS()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string GetRouteCacheKey(const RoutingRequest& request,
+                             const std::string& map_version) {
+  const double resolution = FLAGS_routing_cache_s_resolution;
+  CHECK_GT(resolution, 0.0);
+  std::string key = map_version;
+  for (const auto& waypoint : request.waypoint()) {
+    common::util::StrAppend(&key, "|", waypoint.id(), "@",
+                            std::floor(waypoint.s() / resolution));
+  }
+  // The black list changes the routes at any s, so it is exact.
+  for (const auto& lane : request.blacklisted_lane()) {
+    common::util::StrAppend(
+        &key, "|-", lane.id(), "@",
+        common::util::StringPrintf("%.17g,%.17g", lane.start_s(),
+                                   lane.end_s()));
+  }
+  for (const auto& road : request.blacklisted_road()) {
+    common::util::StrAppend(&key, "|-", road);
+  }
+  return key;
+}
+
+RoutingRequest MakePairRequest(const RoutingCostMatrixRequest& request,
+                              const LaneWaypoint& origin,
+                              const LaneWaypoint& destination) {
+  RoutingRequest pair_request;
+  *pair_request.add_waypoint() = origin;
+  *pair_request.add_waypoint() = destination;
+  *pair_request.mutable_blacklisted_lane() = request.blacklisted_lane();
+  *pair_request.mutable_blacklisted_road() = request.blacklisted_road();
+  return pair_request;
+}
+
 void PrintDebugData(const std::vector<NodeWithRange>& nodes) {
   AINFO << "Route lane id\tis virtual\tstart s\tend s";
   for (const auto& node : nodes) {
@@ -98,41 +168,54 @@ void PrintDebugData(const std::vector<NodeWithRange>& nodes) {
 
 }  // namespace
 
-Navigator::Navigator(const std::string& topo_file_path) {
+Navigator::Navigator(const std::string& topo_file_path)
+    : route_cache_(std::max(FLAGS_routing_cache_capacity, 0)) {
   Graph graph;
   if (!common::util::GetProtoFromFile(topo_file_path, &graph)) {
     AERROR << "Failed to read topology graph from " << topo_file_path;
     return;
   }
 
-  graph_.reset(new TopoGraph());
-  if (!graph_->LoadGraph(graph)) {
+  std::shared_ptr<TopoGraph> topo_graph(new TopoGraph());
+  if (!topo_graph->LoadGraph(graph)) {
     AINFO << "Failed to init navigator graph failed! File path: "
           << topo_file_path;
     return;
   }
+  graph_ = topo_graph;
   black_list_generator_.reset(new BlackListRangeGenerator);
   result_generator_.reset(new ResultGenerator);
   is_ready_ = true;
   AINFO << "The navigator is ready.";
 }
 
+Navigator::Navigator(std::shared_ptr<const TopoGraph> graph)
+    : graph_(std::move(graph)),
+      route_cache_(std::max(FLAGS_routing_cache_capacity, 0)) {
+  if (graph_ == nullptr) {
+    AERROR << "The topology graph of the navigator is nullptr.";
+    return;
+  }
+  black_list_generator_.reset(new BlackListRangeGenerator);
+  result_generator_.reset(new ResultGenerator);
+  is_ready_ = true;
+}
+
 Navigator::~Navigator() {}
 
 bool Navigator::IsReady() const { return is_ready_; }
 
-void Navigator::Clear() { topo_range_manager_.Clear(); }
-
 bool Navigator::Init(const RoutingRequest& request, const TopoGraph* graph,
                      std::vector<const TopoNode*>* const way_nodes,
-                     std::vector<double>* const way_s) {
-  Clear();
-  if (!GetWayNodes(request, graph_.get(), way_nodes, way_s)) {
+                     std::vector<double>* const way_s,
+                     TopoRangeManager* const range_manager) const {
+  range_manager->Clear();
+  if (!GetWayNodes(request, graph, way_nodes, way_s)) {
     AERROR << "Failed to find search terminal point in graph!";
     return false;
   }
-  black_list_generator_->GenerateBlackMapFromRequest(request, graph_.get(),
-                                                     &topo_range_manager_);
+  black_list_generator_->GenerateBlackMapFromRequest(request, graph,
+                                                     range_manager);
   return true;
 }
 
@@ -155,97 +238,264 @@ bool Navigator::MergeRoute(
   return true;
 }
 
+bool Navigator::SearchLeg(const TopoGraph* graph, const TopoNode* way_start,
+                          const TopoNode* way_end, double way_start_s,
+                          double way_end_s,
+                          const TopoRangeManager& range_manager,
+                          Strategy* const strategy,
+                          std::vector<NodeWithRange>* const leg) const {
+  TopoRangeManager full_range_manager = range_manager;
+  black_list_generator_->AddBlackMapFromTerminal(
+      way_start, way_end, way_start_s, way_end_s, &full_range_manager);
+
+  SubTopoGraph sub_graph(full_range_manager.RangeMap());
+  const auto* start = sub_graph.GetSubNodeWithS(way_start, way_start_s);
+  if (start == nullptr) {
+    AERROR << "Sub graph node is nullptr, origin node id: "
+           << way_start->LaneId() << ", s:" << way_start_s;
+    return false;
+  }
+  const auto* end = sub_graph.GetSubNodeWithS(way_end, way_end_s);
+  if (end == nullptr) {
+    AERROR << "Sub graph node is nullptr, origin node id: "
+           << way_end->LaneId() << ", s:" << way_end_s;
+    return false;
+  }
+
+  if (!strategy->Search(graph, &sub_graph, start, end, leg)) {
+    AERROR << "Failed to search route with waypoint from " << start->LaneId()
+           << " to " << end->LaneId();
+    return false;
+  }
+  return true;
+}
+
 bool Navigator::SearchRouteByStrategy(
     const TopoGraph* graph, const std::vector<const TopoNode*>& way_nodes,
-    const std::vector<double>& way_s,
-    std::vector<NodeWithRange>* const result_nodes) const {
-  std::unique_ptr<Strategy> strategy_ptr;
-  strategy_ptr.reset(new AStarStrategy(FLAGS_enable_change_lane_in_result));
+    const std::vector<double>& way_s, const TopoRangeManager& range_manager,
+    std::vector<std::vector<NodeWithRange>>* const legs) const {
+  std::unique_ptr<Strategy> strategy_ptr = CreateStrategy(graph);
 
-  result_nodes->clear();
-  std::vector<NodeWithRange> node_vec;
+  legs->clear();
   for (size_t i = 1; i < way_nodes.size(); ++i) {
-    const auto* way_start = way_nodes[i - 1];
-    const auto* way_end = way_nodes[i];
-    double way_start_s = way_s[i - 1];
-    double way_end_s = way_s[i];
-
-    TopoRangeManager full_range_manager = topo_range_manager_;
-    black_list_generator_->AddBlackMapFromTerminal(
-        way_start, way_end, way_start_s, way_end_s, &full_range_manager);
-
-    SubTopoGraph sub_graph(full_range_manager.RangeMap());
-    const auto* start = sub_graph.GetSubNodeWithS(way_start, way_start_s);
-    if (start == nullptr) {
-      AERROR << "Sub graph node is nullptr, origin node id: "
-             << way_start->LaneId() << ", s:" << way_start_s;
+    legs->emplace_back();
+    if (!SearchLeg(graph, way_nodes[i - 1], way_nodes[i], way_s[i - 1],
+                   way_s[i], range_manager, strategy_ptr.get(),
+                   &legs->back())) {
       return false;
     }
-    const auto* end = sub_graph.GetSubNodeWithS(way_end, way_end_s);
-    if (end == nullptr) {
-      AERROR << "Sub graph node is nullptr, origin node id: "
-             << way_end->LaneId() << ", s:" << way_end_s;
+  }
+  return true;
+}
+
+bool Navigator::SearchRouteIncrementally(
+    const RoutingRequest& request, const LastRoute& last_route,
+    const TopoGraph* graph, const std::vector<const TopoNode*>& way_nodes,
+    const std::vector<double>& way_s, const TopoRangeManager& range_manager,
+    std::vector<std::vector<NodeWithRange>>* const legs) const {
+  const auto& last_legs = last_route.legs;
+  // The waypoints after the start must be the last ones of the last request,
+  // so the new legs map to the last legs from leg_offset on.
+  const int num_legs = static_cast<int>(way_nodes.size()) - 1;
+  const int leg_offset = static_cast<int>(last_legs.size()) - num_legs;
+  if (num_legs <= 0 || leg_offset < 0) {
+    return false;
+  }
+  for (int i = 1; i <= num_legs; ++i) {
+    if (!IsSameWaypoint(request.waypoint(i),
+                        last_route.request.waypoint(leg_offset + i))) {
       return false;
     }
+  }
 
-    std::vector<NodeWithRange> cur_result_nodes;
-    if (!strategy_ptr->Search(graph, &sub_graph, start, end,
-                              &cur_result_nodes)) {
-      AERROR << "Failed to search route with waypoint from " << start->LaneId()
-             << " to " << end->LaneId();
-      return false;
+  // Find where the start is along the first leg: on a lane of it, or on a
+  // lane of the same road, e.g. after a missed lane change.
+  const auto& last_leg = last_legs[leg_offset];
+  const TopoNode* start_node = way_nodes.front();
+  int start_index = -1;
+  for (size_t i = 0; i < last_leg.size(); ++i) {
+    const auto* node = last_leg[i].GetTopoNode();
+    if (node == start_node || node->RoadId() == start_node->RoadId()) {
+      start_index = i;
+      if (node == start_node && way_s.front() <= last_leg[i].EndS()) {
+        break;
+      }
+    } else if (start_index >= 0) {
+      break;
     }
+  }
+  if (start_index < 0) {
+    ADEBUG << "The start " << start_node->LaneId()
+           << " is not along the last route.";
+    return false;
+  }
 
-    node_vec.insert(node_vec.end(), cur_result_nodes.begin(),
-                    cur_result_nodes.end());
+  // The detour rejoins the last leg at the first road after both the start
+  // and the last black listed range on the leg.
+  int rejoin_index = start_index;
+  for (size_t i = start_index; i < last_leg.size(); ++i) {
+    if (IsBlackListed(last_leg[i], range_manager)) {
+      rejoin_index = i;
+    }
+  }
+  const std::string& rejoin_after_road =
+      last_leg[rejoin_index].GetTopoNode()->RoadId();
+  while (rejoin_index < static_cast<int>(last_leg.size()) &&
+         last_leg[rejoin_index].GetTopoNode()->RoadId() == rejoin_after_road) {
+    ++rejoin_index;
   }
 
-  if (!MergeRoute(node_vec, result_nodes)) {
-    AERROR << "Failed to merge route.";
-    return false;
+  std::unique_ptr<Strategy> strategy_ptr = CreateStrategy(graph);
+  legs->clear();
+  legs->emplace_back();
+  auto* first_leg = &legs->back();
+  if (rejoin_index == static_cast<int>(last_leg.size())) {
+    // The leg ends on the same road, so all of it is searched again.
+    if (!SearchLeg(graph, start_node, way_nodes[1], way_s[0], way_s[1],
+                   range_manager, strategy_ptr.get(), first_leg)) {
+      return false;
+    }
+  } else {
+    const auto& rejoin = last_leg[rejoin_index];
+    const double rejoin_s = (rejoin.StartS() + rejoin.EndS()) / 2.0;
+    if (!SearchLeg(graph, start_node, rejoin.GetTopoNode(), way_s[0],
+                   rejoin_s, range_manager, strategy_ptr.get(), first_leg)) {
+      AINFO << "Failed to find a detour to " << rejoin.GetTopoNode()->LaneId()
+            << ", s: " << rejoin_s;
+      return false;
+    }
+    first_leg->emplace_back(rejoin.GetTopoNode(), rejoin_s, rejoin.EndS());
+    first_leg->insert(first_leg->end(), last_leg.begin() + rejoin_index + 1,
+                      last_leg.end());
+  }
+
+  for (int i = 1; i < num_legs; ++i) {
+    const auto& last_next_leg = last_legs[leg_offset + i];
+    legs->push_back(last_next_leg);
+    if (std::any_of(last_next_leg.begin(), last_next_leg.end(),
+                    [&range_manager](const NodeWithRange& node) {
+                      return IsBlackListed(node, range_manager);
+                    }) &&
+        !SearchLeg(graph, way_nodes[i], way_nodes[i + 1], way_s[i],
+                   way_s[i + 1], range_manager, strategy_ptr.get(),
+                   &legs->back())) {
+      return false;
+    }
   }
   return true;
 }
 
+std::shared_ptr<const Navigator::CachedRoute> Navigator::GetCachedRoute(
+    const std::string& key, const std::vector<const TopoNode*>& way_nodes,
+    const std::vector<double>& way_s) {
+  std::shared_ptr<const CachedRoute> route;
+  {
+    std::lock_guard<std::mutex> lock(route_cache_mutex_);
+    if (route_cache_.capacity() == 0) {
+      return nullptr;
+    }
+    auto* cached_route = route_cache_.Get(key);
+    if (cached_route == nullptr) {
+      return nullptr;
+    }
+    route = *cached_route;
+  }
+
+  // The waypoints are in the same buckets as the ones the route was searched
+  // for, but the ends must still be on the lanes and in the right order.
+  const auto& front = route->nodes.front();
+  const auto& back = route->nodes.back();
+  const double start_s = way_s.front();
+  const double end_s = way_s.back();
+  if (front.GetTopoNode() != way_nodes.front() ||
+      back.GetTopoNode() != way_nodes.back() || start_s < 0.0 ||
+      start_s > front.EndS() || end_s < back.StartS() ||
+      end_s > back.GetTopoNode()->Length() ||
+      (route->nodes.size() == 1 && start_s > end_s)) {
+    ADEBUG << "The cached route doesn't fit the waypoints of the request.";
+    return nullptr;
+  }
+  return route;
+}
+
 bool Navigator::SearchRoute(const RoutingRequest& request,
                             RoutingResponse* const response) {
-  if (!ShowRequestInfo(request, graph_.get())) {
-    SetErrorCode(ErrorCode::ROUTING_ERROR_REQUEST,
-                 "Error encountered when reading request point!",
+  if (!IsReady()) {
+    SetErrorCode(ErrorCode::ROUTING_ERROR_NOT_READY, "Navigator is not ready!",
                  response->mutable_status());
     return false;
   }
-
-  if (!IsReady()) {
-    SetErrorCode(ErrorCode::ROUTING_ERROR_NOT_READY, "Navigator is not ready!",
+  const TopoGraph* graph = graph_.get();
+  if (!ShowRequestInfo(request, graph)) {
+    SetErrorCode(ErrorCode::ROUTING_ERROR_REQUEST,
+                 "Error encountered when reading request point!",
                  response->mutable_status());
     return false;
   }
+
   std::vector<const TopoNode*> way_nodes;
   std::vector<double> way_s;
-  if (!Init(request, graph_.get(), &way_nodes, &way_s)) {
+  TopoRangeManager range_manager;
+  if (!Init(request, graph, &way_nodes, &way_s, &range_manager)) {
     SetErrorCode(ErrorCode::ROUTING_ERROR_NOT_READY,
                  "Failed to initialize navigator!", response->mutable_status());
     return false;
   }
 
+  const std::string cache_key = GetRouteCacheKey(request, graph->MapVersion());
+  std::vector<std::vector<NodeWithRange>> legs;
   std::vector<NodeWithRange> result_nodes;
-  if (!SearchRouteByStrategy(graph_.get(), way_nodes, way_s, &result_nodes)) {
-    SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE,
-                 "Failed to find route with request!",
-                 response->mutable_status());
-    return false;
-  }
-  if (result_nodes.empty()) {
-    SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE, "Failed to result nodes!",
-                 response->mutable_status());
-    return false;
+  const auto cached_route = GetCachedRoute(cache_key, way_nodes, way_s);
+  if (cached_route != nullptr) {
+    AINFO << "Routed from the cache.";
+    legs = cached_route->legs;
+    result_nodes = cached_route->nodes;
+  } else {
+    std::shared_ptr<const LastRoute> last_route;
+    if (FLAGS_enable_incremental_rerouting) {
+      std::lock_guard<std::mutex> lock(last_route_mutex_);
+      last_route = last_route_;
+    }
+    const bool is_incremental =
+        last_route != nullptr &&
+        SearchRouteIncrementally(request, *last_route, graph, way_nodes, way_s,
+                                 range_manager, &legs);
+    if (!is_incremental && !SearchRouteByStrategy(graph, way_nodes, way_s,
+                                                  range_manager, &legs)) {
+      SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE,
+                   "Failed to find route with request!",
+                   response->mutable_status());
+      return false;
+    }
+    AINFO << (is_incremental ? "Rerouted incrementally."
+                             : "Routed from scratch.");
+    std::vector<NodeWithRange> node_vec;
+    for (const auto& leg : legs) {
+      node_vec.insert(node_vec.end(), leg.begin(), leg.end());
+    }
+    if (!MergeRoute(node_vec, &result_nodes)) {
+      SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE, "Failed to merge route.",
+                   response->mutable_status());
+      return false;
+    }
+    if (result_nodes.empty()) {
+      SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE,
+                   "Failed to result nodes!", response->mutable_status());
+      return false;
+    }
+    std::shared_ptr<CachedRoute> new_cached_route(new CachedRoute());
+    new_cached_route->legs = legs;
+    new_cached_route->nodes = result_nodes;
+    std::lock_guard<std::mutex> lock(route_cache_mutex_);
+    if (route_cache_.capacity() > 0) {
+      route_cache_.Put(cache_key, std::move(new_cached_route));
+    }
   }
   result_nodes.front().SetStartS(request.waypoint().begin()->s());
   result_nodes.back().SetEndS(request.waypoint().rbegin()->s());
 
   if (!result_generator_->GeneratePassageRegion(
-          graph_->MapVersion(), request, result_nodes, topo_range_manager_,
+          graph->MapVersion(), request, result_nodes, range_manager,
           response)) {
     SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE,
                  "Failed to generate passage regions based on result lanes",
@@ -253,10 +503,155 @@ bool Navigator::SearchRoute(const RoutingRequest& request,
     return false;
   }
   SetErrorCode(ErrorCode::OK, "Success!", response->mutable_status());
+  std::shared_ptr<LastRoute> new_last_route(new LastRoute());
+  new_last_route->request = request;
+  new_last_route->legs = std::move(legs);
+  {
+    std::lock_guard<std::mutex> lock(last_route_mutex_);
+    last_route_ = std::move(new_last_route);
+  }
 
   PrintDebugData(result_nodes);
   return true;
 }
 
+bool Navigator::SearchCostsFromOrigin(
+    const RoutingCostMatrixRequest& request, int origin_index,
+    const std::vector<const TopoNode*>& dest_nodes,
+    const TopoRangeManager& range_manager,
+    RoutingCostMatrixResponse* const response) {
+  const TopoGraph* graph = graph_.get();
+  const auto& origin = request.origin(origin_index);
+  const auto* origin_node = graph->GetNode(origin.id());
+  const int num_dests = request.destination_size();
+  // The row of the origin in the costs and the routes, sized by the caller.
+  const int row = origin_index * num_dests;
+  if (origin_node == nullptr) {
+    AERROR << "Can't find origin in graph! Id: " << origin.id();
+    return false;
+  }
+
+  TopoRangeManager full_range_manager = range_manager;
+  black_list_generator_->AddBlackMapFromStart(origin_node, origin.s(),
+                                              &full_range_manager);
+  SubTopoGraph sub_graph(full_range_manager.RangeMap());
+  const auto* start = sub_graph.GetSubNodeWithS(origin_node, origin.s());
+  if (start == nullptr) {
+    AERROR << "Sub graph node is nullptr, origin node id: "
+           << origin_node->LaneId() << ", s:" << origin.s();
+    return false;
+  }
+  // The destinations that aren't in the graph are left unreachable.
+  std::vector<const TopoNode*> ends;
+  std::vector<int> end_dest_indices;
+  for (int i = 0; i < num_dests; ++i) {
+    if (dest_nodes[i] == nullptr) {
+      continue;
+    }
+    const auto* end =
+        sub_graph.GetSubNodeWithS(dest_nodes[i], request.destination(i).s());
+    if (end != nullptr) {
+      ends.push_back(end);
+      end_dest_indices.push_back(i);
+    }
+  }
+
+  AStarStrategy strategy(FLAGS_enable_change_lane_in_result);
+  std::vector<double> end_costs;
+  std::vector<std::vector<NodeWithRange>> end_routes;
+  strategy.SearchCosts(graph, &sub_graph, start, ends, &end_costs,
+                       request.with_routes() ? &end_routes : nullptr);
+  for (size_t i = 0; i < ends.size(); ++i) {
+    if (std::isfinite(end_costs[i])) {
+      response->set_cost(row + end_dest_indices[i], end_costs[i]);
+    }
+  }
+  if (!request.with_routes()) {
+    return true;
+  }
+
+  for (size_t i = 0; i < ends.size(); ++i) {
+    const int dest_index = end_dest_indices[i];
+    auto* route = response->mutable_route(row + dest_index);
+    std::vector<NodeWithRange> result_nodes;
+    if (!std::isfinite(end_costs[i]) ||
+        !MergeRoute(end_routes[i], &result_nodes) || result_nodes.empty()) {
+      continue;
+    }
+    const auto pair_request =
+        MakePairRequest(request, origin, request.destination(dest_index));
+    result_nodes.front().SetStartS(origin.s());
+    result_nodes.back().SetEndS(request.destination(dest_index).s());
+    if (!result_generator_->GeneratePassageRegion(
+            graph->MapVersion(), pair_request, result_nodes, range_manager,
+            route)) {
+      SetErrorCode(ErrorCode::ROUTING_ERROR_RESPONSE,
+                   "Failed to generate passage regions based on result lanes",
+                   route->mutable_status());
+      continue;
+    }
+    SetErrorCode(ErrorCode::OK, "Success!", route->mutable_status());
+  }
+  return true;
+}
+
+bool Navigator::SearchCostMatrix(
+    const RoutingCostMatrixRequest& request,
+    common::util::WorkStealingThreadPool* thread_pool,
+    RoutingCostMatrixResponse* const response) {
+  if (!IsReady()) {
+    SetErrorCode(ErrorCode::ROUTING_ERROR_NOT_READY, "Navigator is not ready!",
+                 response->mutable_status());
+    return false;
+  }
+  const TopoGraph* graph = graph_.get();
+  const int num_origins = request.origin_size();
+  const int num_dests = request.destination_size();
+  std::vector<const TopoNode*> dest_nodes;
+  for (const auto& destination : request.destination()) {
+    dest_nodes.push_back(graph->GetNode(destination.id()));
+    if (dest_nodes.back() == nullptr) {
+      AERROR << "Can't find destination in graph! Id: " << destination.id();
+    }
+  }
+
+  // The black list is the same for all the pairs, only the origin is cut
+  // for each search.
+  RoutingRequest black_list_request;
+  *black_list_request.mutable_blacklisted_lane() = request.blacklisted_lane();
+  *black_list_request.mutable_blacklisted_road() = request.blacklisted_road();
+  TopoRangeManager range_manager;
+  black_list_generator_->GenerateBlackMapFromRequest(black_list_request, graph,
+                                                     &range_manager);
+
+  // The costs and the routes are sized up front, so that the searches of
+  // the origins fill their rows concurrently.
+  response->clear_cost();
+  response->clear_route();
+  response->mutable_cost()->Resize(num_origins * num_dests, -1.0);
+  if (request.with_routes()) {
+    for (int i = 0; i < num_origins * num_dests; ++i) {
+      auto* status = response->add_route()->mutable_status();
+      status->set_error_code(ErrorCode::ROUTING_ERROR_RESPONSE);
+      status->set_msg("Failed to find route with request!");
+    }
+  }
+  auto search_origin = [&](size_t i) {
+    SearchCostsFromOrigin(request, static_cast<int>(i), dest_nodes,
+                          range_manager, response);
+  };
+  if (thread_pool != nullptr) {
+    thread_pool->ParallelFor(0, num_origins, search_origin);
+  } else {
+    for (int i = 0; i < num_origins; ++i) {
+      search_origin(i);
+    }
+  }
+
+  response->set_map_version(graph->MapVersion());
+  SetErrorCode(ErrorCode::OK, "Success!", response->mutable_status());
+  return true;
+}
+
 }  // namespace routing
 }  // namespace apollo
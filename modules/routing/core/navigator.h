@@ -18,53 +18,135 @@
 #define MODULES_ROUTING_CORE_NAVIGATOR_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
+#include "modules/common/util/lru_cache.h"
+#include "modules/common/util/work_stealing_thread_pool.h"
 #include "modules/routing/core/black_list_range_generator.h"
 #include "modules/routing/core/result_generator.h"
 #include "modules/routing/graph/node_with_range.h"
 #include "modules/routing/graph/topo_graph.h"
 #include "modules/routing/graph/topo_range_manager.h"
 #include "modules/routing/proto/routing.pb.h"
+#include "modules/routing/strategy/strategy.h"
 
 namespace apollo {
 namespace routing {
 
+// SearchRoute can be called from several threads at once: the topo graph is
+// read only, and the state of a request lives on the stack of its call.
 class Navigator {
  public:
   explicit Navigator(const std::string& topo_file_path);
+  // Shares a loaded topo graph, e.g. with other navigators.
+  explicit Navigator(std::shared_ptr<const TopoGraph> graph);
   ~Navigator();
 
   bool IsReady() const;
 
+  std::shared_ptr<const TopoGraph> graph() const { return graph_; }
+
   bool SearchRoute(const RoutingRequest& request,
                    RoutingResponse* const response);
 
+  // Searches the costs from every origin to every destination of the
+  // request, by one search from each origin to all the destinations, run in
+  // parallel on the thread pool if it is not nullptr. A destination is
+  // reached on the node holding it, as the origins are cut out of their
+  // lanes but the destinations are not. The routes are only made if the
+  // request asks for them.
+  bool SearchCostMatrix(const RoutingCostMatrixRequest& request,
+                        common::util::WorkStealingThreadPool* thread_pool,
+                        RoutingCostMatrixResponse* const response);
+
  private:
+  // A request that succeeded, and its route by legs: leg i goes from
+  // waypoint i to waypoint i + 1.
+  struct LastRoute {
+    RoutingRequest request;
+    std::vector<std::vector<NodeWithRange>> legs;
+  };
+
+  // A route searched for a request, before the ends are moved to the
+  // waypoints of the request.
+  struct CachedRoute {
+    std::vector<std::vector<NodeWithRange>> legs;
+    std::vector<NodeWithRange> nodes;
+  };
+
   bool Init(const RoutingRequest& request, const TopoGraph* graph,
             std::vector<const TopoNode*>* const way_nodes,
-            std::vector<double>* const way_s);
-
-  void Clear();
+            std::vector<double>* const way_s,
+            TopoRangeManager* const range_manager) const;
 
   bool SearchRouteByStrategy(
       const TopoGraph* graph, const std::vector<const TopoNode*>& way_nodes,
       const std::vector<double>& way_s,
-      std::vector<NodeWithRange>* const result_nodes) const;
+      const TopoRangeManager& range_manager,
+      std::vector<std::vector<NodeWithRange>>* const legs) const;
+
+  // Searches the route between two adjacent waypoints.
+  bool SearchLeg(const TopoGraph* graph, const TopoNode* way_start,
+                 const TopoNode* way_end, double way_start_s, double way_end_s,
+                 const TopoRangeManager& range_manager,
+                 Strategy* const strategy,
+                 std::vector<NodeWithRange>* const leg) const;
+
+  // Reroutes by reusing the last route, when the request heads for the same
+  // waypoints from a new start, e.g. a reroute from planning. The legs to
+  // the later waypoints are kept unless they run into the black list; in the
+  // first leg only a detour from the start to the next road of the last route
+  // is searched, and the rest of the leg is kept. Returns false if the last
+  // route can't be reused, and the route must be searched from scratch.
+  bool SearchRouteIncrementally(
+      const RoutingRequest& request, const LastRoute& last_route,
+      const TopoGraph* graph,
+      const std::vector<const TopoNode*>& way_nodes,
+      const std::vector<double>& way_s,
+      const TopoRangeManager& range_manager,
+      std::vector<std::vector<NodeWithRange>>* const legs) const;
 
   bool MergeRoute(const std::vector<NodeWithRange>& node_vec,
                   std::vector<NodeWithRange>* const result_node_vec) const;
 
+  // Searches the row of the cost matrix of an origin, and its routes if the
+  // request asks for them.
+  bool SearchCostsFromOrigin(const RoutingCostMatrixRequest& request,
+                             int origin_index,
+                             const std::vector<const TopoNode*>& dest_nodes,
+                             const TopoRangeManager& range_manager,
+                             RoutingCostMatrixResponse* const response);
+
+  // Gets the route cached for the request, if its ends can be moved to the
+  // waypoints of the request.
+  std::shared_ptr<const CachedRoute> GetCachedRoute(
+      const std::string& key, const std::vector<const TopoNode*>& way_nodes,
+      const std::vector<double>& way_s);
+
  private:
   bool is_ready_ = false;
-  std::unique_ptr<TopoGraph> graph_;
-
-  TopoRangeManager topo_range_manager_;
+  std::shared_ptr<const TopoGraph> graph_;
 
   std::unique_ptr<BlackListRangeGenerator> black_list_generator_;
   std::unique_ptr<ResultGenerator> result_generator_;
+
+  // The last route, replaced as a whole by every request that succeeds so
+  // that the concurrent requests can keep reading the one they took.
+  std::mutex last_route_mutex_;
+  std::shared_ptr<const LastRoute> last_route_;
+
+  // The routes of the recent requests, keyed by the map version, the
+  // waypoints with their s quantized and the black list, so that the
+  // repeated requests are not searched again. A cached route has its ends
+  // moved to the waypoints of the request; the ranges to change lanes next
+  // to the ends stay the ones of the cached waypoints, which are less than
+  // the resolution away.
+  std::mutex route_cache_mutex_;
+  common::util::LRUCache<std::string, std::shared_ptr<const CachedRoute>>
+      route_cache_;
 };
 
 }  // namespace routing
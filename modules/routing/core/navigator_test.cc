@@ -0,0 +1,168 @@
+/******************************************************************************
+  * Copyright 2017 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+
+#include "modules/routing/core/navigator.h"
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "modules/routing/common/routing_gflags.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+RoutingRequest GetRequestForTest(const double start_s, const double end_s) {
+  RoutingRequest request;
+  auto* start = request.add_waypoint();
+  start->set_id(TEST_L1);
+  start->set_s(start_s);
+  auto* end = request.add_waypoint();
+  end->set_id(TEST_L5);
+  end->set_s(end_s);
+  return request;
+}
+
+RoutingCostMatrixRequest GetCostMatrixRequestForTest() {
+  RoutingCostMatrixRequest request;
+  auto* origin = request.add_origin();
+  origin->set_id(TEST_L1);
+  origin->set_s(10.0);
+  origin = request.add_origin();
+  origin->set_id(TEST_L2);
+  origin->set_s(20.0);
+  auto* destination = request.add_destination();
+  destination->set_id(TEST_L5);
+  destination->set_s(50.0);
+  destination = request.add_destination();
+  destination->set_id(TEST_L6);
+  destination->set_s(30.0);
+  // behind the origins
+  destination = request.add_destination();
+  destination->set_id(TEST_L1);
+  destination->set_s(5.0);
+  return request;
+}
+
+}  // namespace
+
+class NavigatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    FLAGS_enable_incremental_rerouting = false;
+    Graph graph;
+    GetGraph3ForTest(&graph);
+    std::shared_ptr<TopoGraph> topo_graph(new TopoGraph());
+    ASSERT_TRUE(topo_graph->LoadGraph(graph));
+    FLAGS_routing_cache_capacity = 0;
+    navigator_.reset(new Navigator(topo_graph));
+    FLAGS_routing_cache_capacity = 2;
+    cached_navigator_.reset(new Navigator(topo_graph));
+  }
+
+  // The route of the caching navigator must be the one searched for the
+  // request, but for the lane change ranges next to the ends, which can be
+  // off by less than the resolution.
+  void ExpectSameRoute(const RoutingRequest& request) {
+    RoutingResponse expected_response;
+    ASSERT_TRUE(navigator_->SearchRoute(request, &expected_response));
+    RoutingResponse response;
+    ASSERT_TRUE(cached_navigator_->SearchRoute(request, &response));
+    EXPECT_NEAR(expected_response.measurement().distance(),
+                response.measurement().distance(),
+                FLAGS_routing_cache_s_resolution);
+    expected_response.clear_measurement();
+    response.clear_measurement();
+    EXPECT_EQ(expected_response.DebugString(), response.DebugString());
+  }
+
+  std::unique_ptr<Navigator> navigator_;
+  std::unique_ptr<Navigator> cached_navigator_;
+};
+
+TEST_F(NavigatorTest, RepeatedRequests) {
+  ExpectSameRoute(GetRequestForTest(10.0, 50.0));
+  ExpectSameRoute(GetRequestForTest(10.0, 50.0));
+  // The waypoints in the same buckets share the route, moved to them.
+  ExpectSameRoute(GetRequestForTest(10.2, 50.3));
+  ExpectSameRoute(GetRequestForTest(30.0, 50.0));
+  ExpectSameRoute(GetRequestForTest(10.1, 50.1));
+}
+
+TEST_F(NavigatorTest, BlackListedRequests) {
+  const RoutingRequest request = GetRequestForTest(10.0, 50.0);
+  ExpectSameRoute(request);
+  RoutingRequest black_listed_request = request;
+  auto* black_listed_lane = black_listed_request.add_blacklisted_lane();
+  black_listed_lane->set_id(TEST_L3);
+  black_listed_lane->set_start_s(0.0);
+  black_listed_lane->set_end_s(TEST_LANE_LENGTH);
+  ExpectSameRoute(black_listed_request);
+  ExpectSameRoute(request);
+}
+
+TEST_F(NavigatorTest, CostMatrix) {
+  const RoutingCostMatrixRequest request = GetCostMatrixRequestForTest();
+  RoutingCostMatrixResponse response;
+  ASSERT_TRUE(navigator_->SearchCostMatrix(request, nullptr, &response));
+  ASSERT_EQ(6, response.cost_size());
+  EXPECT_EQ(0, response.route_size());
+  EXPECT_EQ(TEST_MAP_VERSION, response.map_version());
+  for (int i = 0; i < request.origin_size(); ++i) {
+    EXPECT_GE(response.cost(i * 3), 0.0);
+    EXPECT_GE(response.cost(i * 3 + 1), 0.0);
+    EXPECT_LT(response.cost(i * 3 + 2), 0.0);
+  }
+  // staying on the lane is cheaper than changing it
+  EXPECT_LT(response.cost(0), response.cost(1));
+  EXPECT_LT(response.cost(4), response.cost(3));
+
+  // the origins searched in parallel fill the same matrix
+  common::util::WorkStealingThreadPool thread_pool(2);
+  RoutingCostMatrixRequest routes_request = request;
+  routes_request.set_with_routes(true);
+  RoutingCostMatrixResponse routes_response;
+  ASSERT_TRUE(navigator_->SearchCostMatrix(routes_request, &thread_pool,
+                                           &routes_response));
+  ASSERT_EQ(6, routes_response.cost_size());
+  ASSERT_EQ(6, routes_response.route_size());
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_DOUBLE_EQ(response.cost(i), routes_response.cost(i));
+    const auto error_code = response.cost(i) >= 0.0
+                                ? common::ErrorCode::OK
+                                : common::ErrorCode::ROUTING_ERROR_RESPONSE;
+    EXPECT_EQ(error_code, routes_response.route(i).status().error_code());
+  }
+
+  // the route to a destination ends on it as the route of the pair does
+  RoutingResponse pair_response;
+  ASSERT_TRUE(navigator_->SearchRoute(GetRequestForTest(10.0, 50.0),
+                                      &pair_response));
+  const auto& route = routes_response.route(0);
+  ASSERT_EQ(pair_response.road_size(), route.road_size());
+  const auto& last_passage = route.road(route.road_size() - 1).passage(0);
+  const auto& last_segment =
+      last_passage.segment(last_passage.segment_size() - 1);
+  EXPECT_EQ(TEST_L5, last_segment.id());
+  EXPECT_DOUBLE_EQ(50.0, last_segment.end_s());
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -22,7 +22,6 @@
 #include <utility>
 #include <vector>
 
-#include "modules/common/adapters/adapter_manager.h"
 #include "modules/common/log.h"
 #include "modules/common/time/time.h"
 #include "modules/common/util/map_util.h"
@@ -34,7 +33,6 @@ namespace apollo {
 namespace routing {
 namespace {
 
-using apollo::common::adapter::AdapterManager;
 using apollo::common::util::ContainsKey;
 
 bool IsCloseEnough(double value_1, double value_2) {
@@ -378,8 +376,6 @@ bool ResultGenerator::GeneratePassageRegion(
     const std::string& map_version, const RoutingRequest& request,
     const std::vector<NodeWithRange>& nodes,
     const TopoRangeManager& range_manager, RoutingResponse* const result) {
-  AdapterManager::FillRoutingResponseHeader(FLAGS_routing_node_name, result);
-
   if (!GeneratePassageRegion(nodes, range_manager, result)) {
     return false;
   }
@@ -422,7 +418,7 @@ bool ResultGenerator::GeneratePassageRegion(
     }
     road_segment.mutable_passage()->rbegin()->set_can_exit(true);
     result->add_road()->CopyFrom(road_segment);
-    PrintDebugInfo(road_id, nodes_of_ways);
+    PrintDebugInfo(road_id, nodes_of_passages);
   }
 
   return true;
@@ -171,6 +171,8 @@ const TopoNode* SubTopoGraph::GetSubNodeWithS(const TopoNode* topo_node,
   return sorted_vec[index].GetTopoNode();
 }
 
+int SubTopoGraph::NumSubNodes() const { return topo_nodes_.size(); }
+
 void SubTopoGraph::InitSubNodeByValidRange(
     const TopoNode* topo_node, const std::vector<NodeSRange>& valid_range) {
   // Attention: no matter topo node has valid_range or not,
@@ -185,6 +187,7 @@ void SubTopoGraph::InitSubNodeByValidRange(
     }
     std::shared_ptr<TopoNode> sub_topo_node_ptr;
     sub_topo_node_ptr.reset(new TopoNode(topo_node, range));
+    sub_topo_node_ptr->SetIndex(topo_nodes_.size());
     sub_node_vec.emplace_back(sub_topo_node_ptr.get(), range);
     sub_node_set.insert(sub_topo_node_ptr.get());
     sub_node_sorted_vec.push_back(sub_topo_node_ptr.get());
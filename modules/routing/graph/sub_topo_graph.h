@@ -72,6 +72,10 @@ class SubTopoGraph {
 
   const TopoNode* GetSubNodeWithS(const TopoNode* topo_node, double s) const;
 
+  // The sub nodes are indexed from 0 to NumSubNodes() - 1, see
+  // TopoNode::Index().
+  int NumSubNodes() const;
+
  private:
   void InitSubNodeByValidRange(const TopoNode* topo_node,
                                const std::vector<NodeSRange>& valid_range);
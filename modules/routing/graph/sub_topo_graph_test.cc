@@ -126,6 +126,10 @@ TEST(SubTopoGraphTestSuit, one_sub_graph_all_valid) {
   ASSERT_EQ(node_2, sub_node_in_2->OriginNode());
   ASSERT_DOUBLE_EQ(TEST_LANE_LENGTH, sub_node_in_2->Length());
   ASSERT_TRUE(sub_node_in_2->IsSubNode());
+
+  // The sub nodes are indexed by their s in the origin node.
+  ASSERT_EQ(2, sub_topo_graph.NumSubNodes());
+  ASSERT_EQ(1, sub_node_in_2->Index());
 }
 
 TEST(SubTopoGraphTestSuit, one_sub_graph_pre_valid) {
@@ -16,6 +16,8 @@
 
 #include "modules/routing/graph/topo_graph.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "modules/common/util/file.h"
@@ -28,6 +30,8 @@ void TopoGraph::Clear() {
   topo_nodes_.clear();
   topo_edges_.clear();
   node_index_map_.clear();
+  num_landmarks_ = 0;
+  landmark_distances_.clear();
 }
 
 bool TopoGraph::LoadNodes(const Graph& graph) {
@@ -39,6 +43,7 @@ bool TopoGraph::LoadNodes(const Graph& graph) {
     node_index_map_[node.lane_id()] = topo_nodes_.size();
     std::shared_ptr<TopoNode> topo_node;
     topo_node.reset(new TopoNode(node));
+    topo_node->SetIndex(topo_nodes_.size());
     road_node_map_[node.road_id()].insert(topo_node.get());
     topo_nodes_.push_back(std::move(topo_node));
   }
@@ -69,6 +74,36 @@ bool TopoGraph::LoadEdges(const Graph& graph) {
   return true;
 }
 
+bool TopoGraph::LoadLandmarks(const Graph& graph) {
+  const int num_nodes = topo_nodes_.size();
+  for (const auto& landmark : graph.landmark()) {
+    if (landmark.distance_from_size() != num_nodes ||
+        landmark.distance_to_size() != num_nodes) {
+      AERROR << "Landmark " << landmark.lane_id() << " has "
+             << landmark.distance_from_size() << " and "
+             << landmark.distance_to_size() << " distances for " << num_nodes
+             << " nodes.";
+      return false;
+    }
+  }
+  num_landmarks_ = graph.landmark_size();
+  landmark_distances_.resize(2 * num_landmarks_ * num_nodes);
+  const double kInfinity = std::numeric_limits<double>::infinity();
+  for (int j = 0; j < num_landmarks_; ++j) {
+    const auto& landmark = graph.landmark(j);
+    for (int i = 0; i < num_nodes; ++i) {
+      const int index = 2 * (i * num_landmarks_ + j);
+      const double distance_from = landmark.distance_from(i);
+      const double distance_to = landmark.distance_to(i);
+      landmark_distances_[index] = distance_from < 0.0 ? kInfinity
+                                                       : distance_from;
+      landmark_distances_[index + 1] = distance_to < 0.0 ? kInfinity
+                                                         : distance_to;
+    }
+  }
+  return true;
+}
+
 bool TopoGraph::LoadGraph(const Graph& graph) {
   Clear();
 
@@ -83,6 +118,10 @@ bool TopoGraph::LoadGraph(const Graph& graph) {
     AERROR << "Failed to load edges from topology graph.";
     return false;
   }
+  if (!LoadLandmarks(graph)) {
+    AERROR << "Failed to load landmarks from topology graph.";
+    return false;
+  }
   AINFO << "Load Topo data succesful.";
   return true;
 }
@@ -99,6 +138,40 @@ const TopoNode* TopoGraph::GetNode(const std::string& id) const {
   return topo_nodes_[iter->second].get();
 }
 
+int TopoGraph::NumNodes() const { return topo_nodes_.size(); }
+
+bool TopoGraph::HasLandmarks() const { return num_landmarks_ > 0; }
+
+double TopoGraph::LandmarkLowerBound(const TopoNode* from_node,
+                                     const TopoNode* to_node) const {
+  if (num_landmarks_ == 0) {
+    return 0.0;
+  }
+  const double* from_distances =
+      landmark_distances_.data() +
+      2 * from_node->OriginNode()->Index() * num_landmarks_;
+  const double* to_distances =
+      landmark_distances_.data() +
+      2 * to_node->OriginNode()->Index() * num_landmarks_;
+  double lower_bound = 0.0;
+  for (int j = 0; j < 2 * num_landmarks_; j += 2) {
+    // With the reweighted costs d of the tables, which are not negative,
+    // d(from, to) >= d(landmark, to) - d(landmark, from), and
+    // d(from, to) >= d(from, landmark) - d(to, landmark). A difference of two
+    // infinite costs tells nothing.
+    if (from_distances[j] != to_distances[j]) {
+      lower_bound = std::max(lower_bound, to_distances[j] - from_distances[j]);
+    }
+    if (from_distances[j + 1] != to_distances[j + 1]) {
+      lower_bound =
+          std::max(lower_bound, from_distances[j + 1] - to_distances[j + 1]);
+    }
+  }
+  // Back to the routing cost, which may be negative over lane changes.
+  return lower_bound - from_node->OriginNode()->Cost() / 2 +
+         to_node->OriginNode()->Cost() / 2;
+}
+
 void TopoGraph::GetNodesByRoadId(
     const std::string& road_id,
     std::unordered_set<const TopoNode*>* const node_in_road) const {
@@ -40,6 +40,17 @@ class TopoGraph {
   const std::string& MapVersion() const;
   const std::string& MapDistrict() const;
   const TopoNode* GetNode(const std::string& id) const;
+  // The nodes are indexed from 0 to NumNodes() - 1, see TopoNode::Index().
+  int NumNodes() const;
+
+  // Whether the graph has the landmark distance tables from topo_creator.
+  bool HasLandmarks() const;
+  // A lower bound of the routing cost from from_node to to_node, by the
+  // triangle inequality over the landmarks on the reweighted costs of the
+  // tables, see LandmarkCreator; 0 if the graph has none. A sub node is
+  // bounded as its origin node.
+  double LandmarkLowerBound(const TopoNode* from_node,
+                            const TopoNode* to_node) const;
   void GetNodesByRoadId(
       const std::string& road_id,
       std::unordered_set<const TopoNode*>* const node_in_road) const;
@@ -48,6 +59,7 @@ class TopoGraph {
   void Clear();
   bool LoadNodes(const Graph& graph);
   bool LoadEdges(const Graph& graph);
+  bool LoadLandmarks(const Graph& graph);
 
  private:
   std::string map_version_;
@@ -57,6 +69,10 @@ class TopoGraph {
   std::unordered_map<std::string, int> node_index_map_;
   std::unordered_map<std::string, std::unordered_set<const TopoNode*> >
       road_node_map_;
+  // The costs from and to every landmark, interleaved per node: the ones of
+  // node i and landmark j are at 2 * (i * num_landmarks_ + j) and the next.
+  int num_landmarks_ = 0;
+  std::vector<double> landmark_distances_;
 };
 
 }  // namespace routing
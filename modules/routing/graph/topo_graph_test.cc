@@ -33,6 +33,7 @@ TEST(TopoGraphTestSuit, test_graph_1) {
 
   ASSERT_EQ(TEST_MAP_VERSION, topo_graph.MapVersion());
   ASSERT_EQ(TEST_MAP_DISTRICT, topo_graph.MapDistrict());
+  ASSERT_EQ(4, topo_graph.NumNodes());
 
   const TopoNode* node_1 = topo_graph.GetNode(TEST_L1);
   ASSERT_TRUE(node_1 != nullptr);
@@ -49,6 +50,7 @@ TEST(TopoGraphTestSuit, test_graph_1) {
   ASSERT_DOUBLE_EQ(TEST_LANE_LENGTH, node_1->EndS());
   ASSERT_DOUBLE_EQ(TEST_LANE_LENGTH, node_1->Length());
   ASSERT_FALSE(node_1->IsSubNode());
+  ASSERT_EQ(0, node_1->Index());
 
   const TopoNode* node_4 = topo_graph.GetNode(TEST_L4);
   ASSERT_TRUE(node_4 != nullptr);
@@ -65,6 +67,7 @@ TEST(TopoGraphTestSuit, test_graph_1) {
   ASSERT_DOUBLE_EQ(TEST_LANE_LENGTH, node_4->EndS());
   ASSERT_DOUBLE_EQ(TEST_LANE_LENGTH, node_4->Length());
   ASSERT_FALSE(node_4->IsSubNode());
+  ASSERT_EQ(3, node_4->Index());
 }
 
 }  // namespace routing
@@ -72,6 +72,10 @@ class TopoNode {
   double StartS() const;
   double EndS() const;
   bool IsSubNode() const;
+  // The dense index of the node in its TopoGraph, or in its SubTopoGraph for
+  // a sub node; -1 if the node belongs to neither.
+  int Index() const;
+  void SetIndex(int index);
   bool IsInFromPreEdgeValid() const;
   bool IsOutToSucEdgeValid() const;
   bool IsOverlapEnough(const TopoNode* sub_node,
@@ -112,6 +116,7 @@ class TopoNode {
   std::unordered_map<const TopoNode*, const TopoEdge*> in_edge_map_;
 
   const TopoNode* origin_node_;
+  int index_ = -1;
 };
 
 enum TopoEdgeType {
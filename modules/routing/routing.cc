@@ -16,6 +16,8 @@
 
 #include "modules/routing/routing.h"
 
+#include <algorithm>
+
 #include "modules/common/adapters/adapter_manager.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/routing/common/routing_gflags.h"
@@ -39,6 +41,8 @@ apollo::common::Status Routing::Init() {
   const auto routing_map_file = apollo::hdmap::RoutingMapFile();
   AINFO << "Use routing topology graph path: " << routing_map_file;
   navigator_ptr_.reset(new Navigator(routing_map_file));
+  thread_pool_.reset(new common::util::WorkStealingThreadPool(
+      std::max(FLAGS_routing_num_worker_threads, 0)));
   CHECK(common::util::GetProtoFromFile(FLAGS_routing_conf_file, &routing_conf_))
       << "Unable to load routing conf file: " + FLAGS_routing_conf_file;
 
@@ -98,21 +102,47 @@ RoutingRequest Routing::FillLaneInfoIfMissing(
 void Routing::OnRoutingRequest(
     const RoutingRequest &routing_request) {
   AINFO << "Get new routing request:" << routing_request.DebugString();
+  const uint64_t request_num = ++num_requests_;
+  thread_pool_->Schedule([this, routing_request, request_num]() {
+    HandleRoutingRequest(routing_request, request_num);
+  });
+}
+
+void Routing::HandleRoutingRequest(const RoutingRequest &routing_request,
+                                   const uint64_t request_num) {
   RoutingResponse routing_response;
-  apollo::common::monitor::MonitorLogBuffer buffer(&monitor_logger_);
   const auto& fixed_request = FillLaneInfoIfMissing(routing_request);
-  if (!navigator_ptr_->SearchRoute(fixed_request, &routing_response)) {
+  const bool is_found =
+      navigator_ptr_->SearchRoute(fixed_request, &routing_response);
+
+  // The headers of the published messages are numbered, so the workers
+  // publish one at a time. The buffer publishes before the lock is released.
+  std::lock_guard<std::mutex> lock(publish_mutex_);
+  apollo::common::monitor::MonitorLogBuffer buffer(&monitor_logger_);
+  if (!is_found) {
     AERROR << "Failed to search route with navigator.";
 
     buffer.WARN("Routing failed! " + routing_response.status().msg());
     return;
   }
+  if (request_num < last_published_request_num_) {
+    AWARN << "Drop the response of request " << request_num
+          << ", request " << last_published_request_num_
+          << " has been answered already.";
+    return;
+  }
+  last_published_request_num_ = request_num;
   buffer.INFO("Routing success!");
+  AdapterManager::FillRoutingResponseHeader(FLAGS_routing_node_name,
+                                            &routing_response);
   AdapterManager::PublishRoutingResponse(routing_response);
-  return;
 }
 
-void Routing::Stop() {}
+void Routing::Stop() {
+  if (thread_pool_) {
+    thread_pool_->Stop();
+  }
+}
 
 }  // namespace routing
 }  // namespace apollo
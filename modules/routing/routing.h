@@ -17,7 +17,9 @@
 #ifndef MODULES_ROUTING_ROUTING_H_
 #define MODULES_ROUTING_ROUTING_H_
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "modules/routing/proto/routing.pb.h"
@@ -26,6 +28,7 @@
 #include "modules/common/apollo_app.h"
 #include "modules/common/monitor_log/monitor_log_buffer.h"
 #include "modules/common/status/status.h"
+#include "modules/common/util/work_stealing_thread_pool.h"
 #include "modules/map/hdmap/hdmap_util.h"
 #include "modules/routing/core/navigator.h"
 
@@ -67,14 +70,30 @@ class Routing : public apollo::common::ApolloApp {
  private:
   void OnRoutingRequest(const RoutingRequest &routing_request);
 
+  // Searches and publishes the route of a request. Runs on the workers, so
+  // that a slow request doesn't hold up the next ones.
+  void HandleRoutingRequest(const RoutingRequest &routing_request,
+                            const uint64_t request_num);
+
   RoutingRequest FillLaneInfoIfMissing(const RoutingRequest &routing_request);
 
  private:
   std::unique_ptr<Navigator> navigator_ptr_;
+
+  // Requests are numbered in the order they arrive. A response is dropped
+  // if the response of a later request has been published already.
+  uint64_t num_requests_ = 0;
+  uint64_t last_published_request_num_ = 0;
+  std::mutex publish_mutex_;
+
   apollo::common::monitor::MonitorLogger monitor_logger_;
 
   RoutingConfig routing_conf_;
   const hdmap::HDMap* hdmap_ = nullptr;
+
+  // Declared last, so that the pending requests are done before the members
+  // they use are destroyed.
+  std::unique_ptr<common::util::WorkStealingThreadPool> thread_pool_;
 };
 
 }  // namespace routing
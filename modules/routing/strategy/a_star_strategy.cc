@@ -17,8 +17,9 @@
 #include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <cstdint>
 #include <limits>
-#include <queue>
+#include <unordered_set>
 
 #include "modules/common/log.h"
 #include "modules/routing/common/routing_gflags.h"
@@ -31,25 +32,6 @@ namespace apollo {
 namespace routing {
 namespace {
 
-struct SearchNode {
-  const TopoNode* topo_node = nullptr;
-  double f = std::numeric_limits<double>::max();
-
-  SearchNode() = default;
-  explicit SearchNode(const TopoNode* node)
-      : topo_node(node), f(std::numeric_limits<double>::max()) {}
-  SearchNode(const SearchNode& search_node) = default;
-
-  bool operator<(const SearchNode& node) const {
-    // in order to let the top of priority queue is the smallest one!
-    return f > node.f;
-  }
-
-  bool operator==(const SearchNode& node) const {
-    return topo_node == node.topo_node;
-  }
-};
-
 double GetCostToNeighbor(const TopoEdge* edge) {
   return (edge->Cost() + edge->ToNode()->Cost());
 }
@@ -178,24 +160,14 @@ bool AdjustLaneChange(std::vector<const TopoNode*>* const result_node_vec) {
   return true;
 }
 
-bool Reconstruct(
-    const std::unordered_map<const TopoNode*, const TopoNode*>& came_from,
-    const TopoNode* dest_node, std::vector<NodeWithRange>* result_nodes) {
-  std::vector<const TopoNode*> result_node_vec;
-  result_node_vec.push_back(dest_node);
-
-  auto iter = came_from.find(dest_node);
-  while (iter != came_from.end()) {
-    result_node_vec.push_back(iter->second);
-    iter = came_from.find(iter->second);
-  }
-  std::reverse(result_node_vec.begin(), result_node_vec.end());
-  if (!AdjustLaneChange(&result_node_vec)) {
+bool Reconstruct(std::vector<const TopoNode*>* const result_node_vec,
+                 std::vector<NodeWithRange>* const result_nodes) {
+  if (!AdjustLaneChange(result_node_vec)) {
     AERROR << "Failed to adjust lane change";
     return false;
   }
   result_nodes->clear();
-  for (const auto* node : result_node_vec) {
+  for (const auto* node : *result_node_vec) {
     result_nodes->emplace_back(node->OriginNode(), node->StartS(),
                                node->EndS());
   }
@@ -204,18 +176,154 @@ bool Reconstruct(
 
 }  // namespace
 
+struct AStarStrategy::NodeState {
+  const TopoNode* node = nullptr;
+  // The state belongs to the search with this id, and is reset when it is
+  // first touched by a later search.
+  uint32_t search_id = 0;
+  bool is_closed = false;
+  // Whether the node is a destination of the search.
+  bool is_dest = false;
+  // The position in the open set, -1 if the node is not in it.
+  int heap_index = -1;
+  const TopoNode* came_from = nullptr;
+  double g_score = 0.0;
+  double f_score = 0.0;
+  double enter_s = 0.0;
+};
+
+struct AStarStrategy::SearchBuffers {
+  // The states of the nodes of the graph by TopoNode::Index(), followed by
+  // the ones of the sub nodes of the sub graph.
+  std::vector<NodeState> states;
+  int num_graph_nodes = 0;
+  uint32_t search_id = 0;
+  std::vector<NodeState*> open_set;
+  std::vector<const TopoEdge*> next_edges;
+  std::unordered_set<const TopoEdge*> sub_edges;
+  std::vector<const TopoNode*> route;
+};
+
 AStarStrategy::AStarStrategy(bool enable_change)
     : change_lane_enabled_(enable_change) {}
 
-void AStarStrategy::Clear() {
-  closed_set_.clear();
-  open_set_.clear();
-  came_from_.clear();
-  enter_s_.clear();
-  g_score_.clear();
+void AStarStrategy::Clear(const TopoGraph* graph,
+                          const SubTopoGraph* sub_graph) {
+  static thread_local SearchBuffers thread_buffers;
+  buffers_ = &thread_buffers;
+
+  buffers_->num_graph_nodes = graph->NumNodes();
+  const size_t num_nodes = graph->NumNodes() + sub_graph->NumSubNodes();
+  if (buffers_->states.size() < num_nodes) {
+    buffers_->states.resize(num_nodes);
+  }
+  ++buffers_->search_id;
+  if (buffers_->search_id == 0) {
+    // The id wrapped around, so the states of old searches may look current.
+    for (auto& state : buffers_->states) {
+      state.search_id = 0;
+    }
+    buffers_->search_id = 1;
+  }
+  buffers_->open_set.clear();
 }
 
-double AStarStrategy::HeuristicCost(const TopoNode* src_node,
+AStarStrategy::NodeState* AStarStrategy::GetState(const TopoNode* node) {
+  DCHECK_GE(node->Index(), 0) << "lane " << node->LaneId() << " has no index";
+  const size_t slot = node->IsSubNode()
+                          ? buffers_->num_graph_nodes + node->Index()
+                          : node->Index();
+  DCHECK_LT(slot, buffers_->states.size());
+  NodeState* state = &buffers_->states[slot];
+  if (state->search_id != buffers_->search_id) {
+    *state = NodeState();
+    state->node = node;
+    state->search_id = buffers_->search_id;
+  }
+  return state;
+}
+
+const AStarStrategy::NodeState* AStarStrategy::FindState(
+    const TopoNode* node) {
+  if (node->Index() < 0) {
+    return nullptr;
+  }
+  const size_t slot = node->IsSubNode()
+                          ? buffers_->num_graph_nodes + node->Index()
+                          : node->Index();
+  if (slot >= buffers_->states.size() ||
+      buffers_->states[slot].search_id != buffers_->search_id) {
+    return nullptr;
+  }
+  return &buffers_->states[slot];
+}
+
+void AStarStrategy::PushOpenSet(NodeState* state) {
+  state->heap_index = buffers_->open_set.size();
+  buffers_->open_set.push_back(state);
+  SiftUp(state->heap_index);
+}
+
+void AStarStrategy::DecreaseKey(NodeState* state) {
+  SiftUp(state->heap_index);
+}
+
+AStarStrategy::NodeState* AStarStrategy::PopOpenSet() {
+  auto& open_set = buffers_->open_set;
+  NodeState* top = open_set.front();
+  top->heap_index = -1;
+  NodeState* last = open_set.back();
+  open_set.pop_back();
+  if (!open_set.empty()) {
+    open_set.front() = last;
+    last->heap_index = 0;
+    SiftDown(0);
+  }
+  return top;
+}
+
+void AStarStrategy::SiftUp(int heap_index) {
+  auto& open_set = buffers_->open_set;
+  NodeState* state = open_set[heap_index];
+  while (heap_index > 0) {
+    const int parent = (heap_index - 1) / 2;
+    if (open_set[parent]->f_score <= state->f_score) {
+      break;
+    }
+    open_set[heap_index] = open_set[parent];
+    open_set[heap_index]->heap_index = heap_index;
+    heap_index = parent;
+  }
+  open_set[heap_index] = state;
+  state->heap_index = heap_index;
+}
+
+void AStarStrategy::SiftDown(int heap_index) {
+  auto& open_set = buffers_->open_set;
+  const int size = open_set.size();
+  NodeState* state = open_set[heap_index];
+  while (true) {
+    int child = 2 * heap_index + 1;
+    if (child >= size) {
+      break;
+    }
+    if (child + 1 < size &&
+        open_set[child + 1]->f_score < open_set[child]->f_score) {
+      ++child;
+    }
+    if (open_set[child]->f_score >= state->f_score) {
+      break;
+    }
+    open_set[heap_index] = open_set[child];
+    open_set[heap_index]->heap_index = heap_index;
+    heap_index = child;
+  }
+  open_set[heap_index] = state;
+  state->heap_index = heap_index;
+}
+
+double AStarStrategy::HeuristicCost(const TopoGraph* graph,
+                                    const TopoNode* src_node,
                                     const TopoNode* dest_node) {
   const auto& src_point = src_node->AnchorPoint();
   const auto& dest_point = dest_node->AnchorPoint();
@@ -228,113 +336,180 @@ bool AStarStrategy::Search(const TopoGraph* graph,
                            const SubTopoGraph* sub_graph,
                            const TopoNode* src_node, const TopoNode* dest_node,
                            std::vector<NodeWithRange>* const result_nodes) {
-  Clear();
+  Clear(graph, sub_graph);
   AINFO << "Start A* search algorithm.";
 
-  std::priority_queue<SearchNode> open_set_detail;
-
-  SearchNode src_search_node(src_node);
-  src_search_node.f = HeuristicCost(src_node, dest_node);
-  open_set_detail.push(src_search_node);
-
-  open_set_.insert(src_node);
-  g_score_[src_node] = 0.0;
-  enter_s_[src_node] = src_node->StartS();
+  NodeState* src_state = GetState(src_node);
+  src_state->g_score = 0.0;
+  src_state->f_score = HeuristicCost(graph, src_node, dest_node);
+  src_state->enter_s = src_node->StartS();
+  GetState(dest_node)->is_dest = true;
+  PushOpenSet(src_state);
 
-  SearchNode current_node;
-  std::unordered_set<const TopoEdge*> next_edge_set;
-  std::unordered_set<const TopoEdge*> sub_edge_set;
-  while (!open_set_detail.empty()) {
-    current_node = open_set_detail.top();
-    const auto* from_node = current_node.topo_node;
-    if (current_node.topo_node == dest_node) {
-      if (!Reconstruct(came_from_, from_node, result_nodes)) {
+  while (!buffers_->open_set.empty()) {
+    NodeState* current_state = buffers_->open_set.front();
+    if (current_state->node == dest_node) {
+      if (!ReconstructRoute(dest_node, result_nodes)) {
         AERROR << "Failed to reconstruct route.";
         return false;
       }
       return true;
     }
-    open_set_.erase(from_node);
-    open_set_detail.pop();
+    PopOpenSet();
+    current_state->is_closed = true;
+    ExpandNeighbors(graph, sub_graph, current_state, dest_node);
+  }
+  AERROR << "Failed to find goal lane with id: " << dest_node->LaneId();
+  return false;
+}
+
+bool AStarStrategy::SearchCosts(
+    const TopoGraph* graph, const SubTopoGraph* sub_graph,
+    const TopoNode* src_node, const std::vector<const TopoNode*>& dest_nodes,
+    std::vector<double>* const costs,
+    std::vector<std::vector<NodeWithRange>>* const result_nodes) {
+  Clear(graph, sub_graph);
+  costs->assign(dest_nodes.size(), std::numeric_limits<double>::infinity());
+  if (result_nodes != nullptr) {
+    result_nodes->assign(dest_nodes.size(), std::vector<NodeWithRange>());
+  }
 
-    if (closed_set_.count(from_node) != 0) {
-      // if showed before, just skip...
+  int num_open_dests = 0;
+  for (const auto* dest_node : dest_nodes) {
+    NodeState* dest_state = GetState(dest_node);
+    if (!dest_state->is_dest) {
+      dest_state->is_dest = true;
+      ++num_open_dests;
+    }
+  }
+  NodeState* src_state = GetState(src_node);
+  src_state->g_score = 0.0;
+  src_state->f_score = 0.0;
+  src_state->enter_s = src_node->StartS();
+  PushOpenSet(src_state);
+
+  // Without a heuristic the nodes are closed by their cost, so the search
+  // may stop once every destination is closed.
+  while (!buffers_->open_set.empty() && num_open_dests > 0) {
+    NodeState* current_state = PopOpenSet();
+    current_state->is_closed = true;
+    if (current_state->is_dest) {
+      --num_open_dests;
+    }
+    ExpandNeighbors(graph, sub_graph, current_state, nullptr);
+  }
+
+  for (size_t i = 0; i < dest_nodes.size(); ++i) {
+    const NodeState* dest_state = FindState(dest_nodes[i]);
+    if (dest_state == nullptr || !dest_state->is_closed) {
       continue;
     }
-    closed_set_.emplace(from_node);
-
-    // if residual_s is less than FLAGS_min_length_for_lane_change, only move
-    // forward
-    const auto& neighbor_edges =
-        (GetResidualS(from_node) > FLAGS_min_length_for_lane_change &&
-         change_lane_enabled_)
-            ? from_node->OutToAllEdge()
-            : from_node->OutToSucEdge();
-    double tentative_g_score = 0.0;
-    next_edge_set.clear();
-    for (const auto* edge : neighbor_edges) {
-      sub_edge_set.clear();
-      sub_graph->GetSubInEdgesIntoSubGraph(edge, &sub_edge_set);
-      next_edge_set.insert(sub_edge_set.begin(), sub_edge_set.end());
+    (*costs)[i] = dest_state->g_score;
+    if (result_nodes != nullptr &&
+        !ReconstructRoute(dest_nodes[i], &(*result_nodes)[i])) {
+      AERROR << "Failed to reconstruct route to " << dest_nodes[i]->LaneId();
+      (*result_nodes)[i].clear();
     }
+  }
+  return num_open_dests == 0;
+}
 
-    for (const auto* edge : next_edge_set) {
-      const auto* to_node = edge->ToNode();
-      if (closed_set_.count(to_node) == 1) {
-        continue;
-      }
-      if (GetResidualS(edge, to_node) < FLAGS_min_length_for_lane_change) {
-        continue;
-      }
-      tentative_g_score =
-          g_score_[current_node.topo_node] + GetCostToNeighbor(edge);
-      if (edge->Type() != TopoEdgeType::TET_FORWARD) {
-        tentative_g_score -=
-            (edge->FromNode()->Cost() + edge->ToNode()->Cost()) / 2;
+bool AStarStrategy::ReconstructRoute(
+    const TopoNode* dest_node, std::vector<NodeWithRange>* const result_nodes) {
+  auto& route = buffers_->route;
+  route.clear();
+  for (const auto* node = dest_node; node != nullptr;
+       node = FindState(node)->came_from) {
+    route.push_back(node);
+  }
+  std::reverse(route.begin(), route.end());
+  return Reconstruct(&route, result_nodes);
+}
+
+void AStarStrategy::ExpandNeighbors(const TopoGraph* graph,
+                                    const SubTopoGraph* sub_graph,
+                                    NodeState* current_state,
+                                    const TopoNode* dest_node) {
+  auto& next_edges = buffers_->next_edges;
+  auto& sub_edges = buffers_->sub_edges;
+  const auto* from_node = current_state->node;
+  // if residual_s is less than FLAGS_min_length_for_lane_change, only move
+  // forward
+  const auto& neighbor_edges =
+      (GetResidualS(from_node) > FLAGS_min_length_for_lane_change &&
+       change_lane_enabled_)
+          ? from_node->OutToAllEdge()
+          : from_node->OutToSucEdge();
+  double tentative_g_score = 0.0;
+  next_edges.clear();
+  for (const auto* edge : neighbor_edges) {
+    sub_edges.clear();
+    sub_graph->GetSubInEdgesIntoSubGraph(edge, &sub_edges);
+    for (const auto* sub_edge : sub_edges) {
+      if (std::find(next_edges.begin(), next_edges.end(), sub_edge) ==
+          next_edges.end()) {
+        next_edges.push_back(sub_edge);
       }
-      if (open_set_.count(to_node) != 0 &&
-          tentative_g_score >= g_score_[to_node]) {
+    }
+  }
+
+  for (const auto* edge : next_edges) {
+    const auto* to_node = edge->ToNode();
+    NodeState* to_state = GetState(to_node);
+    if (to_state->is_closed) {
+      continue;
+    }
+    if (GetResidualS(edge, to_node) < FLAGS_min_length_for_lane_change) {
+      continue;
+    }
+    tentative_g_score = current_state->g_score + GetCostToNeighbor(edge);
+    if (edge->Type() != TopoEdgeType::TET_FORWARD) {
+      tentative_g_score -=
+          (edge->FromNode()->Cost() + edge->ToNode()->Cost()) / 2;
+    }
+    const bool is_open = to_state->heap_index >= 0;
+    if (is_open && tentative_g_score >= to_state->g_score) {
+      continue;
+    }
+    // if to_node is reached by forward, reset enter_s to start_s
+    if (edge->Type() == TopoEdgeType::TET_FORWARD) {
+      to_state->enter_s = to_node->StartS();
+    } else {
+      // else, add enter_s with FLAGS_min_length_for_lane_change
+      double to_node_enter_s =
+          (current_state->enter_s + FLAGS_min_length_for_lane_change) /
+          from_node->Length() * to_node->Length();
+      // enter s could be larger than end_s but should be less than length
+      to_node_enter_s = std::min(to_node_enter_s, to_node->Length());
+      // if enter_s is larger than end_s and to_node is a dest_node
+      if (to_node_enter_s > to_node->EndS() && to_state->is_dest) {
         continue;
       }
-      // if to_node is reached by forward, reset enter_s to start_s
-      if (edge->Type() == TopoEdgeType::TET_FORWARD) {
-        enter_s_[to_node] = to_node->StartS();
-      } else {
-        // else, add enter_s with FLAGS_min_length_for_lane_change
-        double to_node_enter_s =
-            (enter_s_[from_node] + FLAGS_min_length_for_lane_change) /
-            from_node->Length() * to_node->Length();
-        // enter s could be larger than end_s but should be less than length
-        to_node_enter_s = std::min(to_node_enter_s, to_node->Length());
-        // if enter_s is larger than end_s and to_node is dest_node
-        if (to_node_enter_s > to_node->EndS() && to_node == dest_node) {
-          continue;
-        }
-        enter_s_[to_node] = to_node_enter_s;
-      }
+      to_state->enter_s = to_node_enter_s;
+    }
 
-      g_score_[to_node] = tentative_g_score;
-      SearchNode next_node(to_node);
-      next_node.f = tentative_g_score + HeuristicCost(to_node, dest_node);
-      open_set_detail.push(next_node);
-      came_from_[to_node] = from_node;
-      if (open_set_.count(to_node) == 0) {
-        open_set_.insert(to_node);
-      }
+    to_state->g_score = tentative_g_score;
+    to_state->f_score =
+        dest_node == nullptr
+            ? tentative_g_score
+            : tentative_g_score + HeuristicCost(graph, to_node, dest_node);
+    to_state->came_from = from_node;
+    if (is_open) {
+      DecreaseKey(to_state);
+    } else {
+      PushOpenSet(to_state);
     }
   }
-  AERROR << "Failed to find goal lane with id: " << dest_node->LaneId();
-  return false;
 }
 
 double AStarStrategy::GetResidualS(const TopoNode* node) {
   double start_s = node->StartS();
-  const auto iter = enter_s_.find(node);
-  if (iter != enter_s_.end()) {
-    if (iter->second > node->EndS()) {
+  const NodeState* state = FindState(node);
+  if (state != nullptr) {
+    if (state->enter_s > node->EndS()) {
       return 0.0;
     }
-    start_s = iter->second;
+    start_s = state->enter_s;
   } else {
     AWARN << "lane " << node->LaneId() << "(" << node->StartS() << ", "
           << node->EndS() << "not found in enter_s map";
@@ -360,9 +535,9 @@ double AStarStrategy::GetResidualS(const TopoEdge* edge,
   }
   double start_s = to_node->StartS();
   const auto* from_node = edge->FromNode();
-  const auto iter = enter_s_.find(from_node);
-  if (iter != enter_s_.end()) {
-    double temp_s = iter->second / from_node->Length() * to_node->Length();
+  const NodeState* state = FindState(from_node);
+  if (state != nullptr) {
+    double temp_s = state->enter_s / from_node->Length() * to_node->Length();
     start_s = std::max(start_s, temp_s);
   } else {
     AWARN << "lane " << from_node->LaneId() << "(" << from_node->StartS()
@@ -17,8 +17,6 @@
 #ifndef MODULES_ROUTING_STRATEGY_A_STAR_STRATEGY_H_
 #define MODULES_ROUTING_STRATEGY_A_STAR_STRATEGY_H_
 
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "modules/routing/strategy/strategy.h"
@@ -35,19 +33,53 @@ class AStarStrategy : public Strategy {
                       const TopoNode* src_node, const TopoNode* dest_node,
                       std::vector<NodeWithRange>* const result_nodes);
 
+  // The costs from src_node to every node of dest_nodes, by one Dijkstra
+  // search that stops once all of them are reached, and their routes if
+  // result_nodes is not nullptr. The cost of a node that can't be reached is
+  // infinity and its route is empty. Returns false if a node can't be
+  // reached.
+  bool SearchCosts(const TopoGraph* graph, const SubTopoGraph* sub_graph,
+                   const TopoNode* src_node,
+                   const std::vector<const TopoNode*>& dest_nodes,
+                   std::vector<double>* const costs,
+                   std::vector<std::vector<NodeWithRange>>* const result_nodes);
+
+ protected:
+  // The estimated cost from src_node to dest_node, the anchor point
+  // Manhattan distance.
+  virtual double HeuristicCost(const TopoGraph* graph,
+                               const TopoNode* src_node,
+                               const TopoNode* dest_node);
+
  private:
-  void Clear();
-  double HeuristicCost(const TopoNode* src_node, const TopoNode* dest_node);
+  struct NodeState;
+  struct SearchBuffers;
+
+  void Clear(const TopoGraph* graph, const SubTopoGraph* sub_graph);
+  NodeState* GetState(const TopoNode* node);
+  const NodeState* FindState(const TopoNode* node);
   double GetResidualS(const TopoNode* node);
   double GetResidualS(const TopoEdge* edge, const TopoNode* to_node);
+  // Relaxes the edges out of the node of current_state. Without dest_node,
+  // the open set is ordered by cost alone.
+  void ExpandNeighbors(const TopoGraph* graph, const SubTopoGraph* sub_graph,
+                       NodeState* current_state, const TopoNode* dest_node);
+  bool ReconstructRoute(const TopoNode* dest_node,
+                        std::vector<NodeWithRange>* const result_nodes);
+
+  // The open set, a binary min heap of node states by f score. Every state
+  // keeps its position in the heap so its f score can be decreased in place.
+  void PushOpenSet(NodeState* state);
+  void DecreaseKey(NodeState* state);
+  NodeState* PopOpenSet();
+  void SiftUp(int heap_index);
+  void SiftDown(int heap_index);
 
  private:
   bool change_lane_enabled_;
-  std::unordered_set<const TopoNode*> open_set_;
-  std::unordered_set<const TopoNode*> closed_set_;
-  std::unordered_map<const TopoNode*, const TopoNode*> came_from_;
-  std::unordered_map<const TopoNode*, double> g_score_;
-  std::unordered_map<const TopoNode*, double> enter_s_;
+  // The buffers of the current search, owned by the searching thread and
+  // reused by its later searches.
+  SearchBuffers* buffers_ = nullptr;
 };
 
 }  // namespace routing
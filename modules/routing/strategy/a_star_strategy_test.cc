@@ -0,0 +1,102 @@
+/******************************************************************************
+  * Copyright 2017 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+
+#include "modules/routing/strategy/a_star_strategy.h"
+
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/routing/graph/sub_topo_graph.h"
+#include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/graph/topo_test_utils.h"
+
+namespace apollo {
+namespace routing {
+
+TEST(AStarStrategyTestSuit, search) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  const TopoNode* node_1 = topo_graph.GetNode(TEST_L1);
+  const TopoNode* node_5 = topo_graph.GetNode(TEST_L5);
+  ASSERT_TRUE(node_1 != nullptr);
+  ASSERT_TRUE(node_5 != nullptr);
+
+  const std::unordered_map<const TopoNode*, std::vector<NodeSRange>>
+      black_map;
+  const SubTopoGraph sub_graph(black_map);
+  AStarStrategy strategy(false);
+  std::vector<NodeWithRange> result_nodes;
+  ASSERT_TRUE(
+      strategy.Search(&topo_graph, &sub_graph, node_1, node_5, &result_nodes));
+  ASSERT_EQ(3, result_nodes.size());
+  EXPECT_EQ(TEST_L1, result_nodes[0].GetTopoNode()->LaneId());
+  EXPECT_EQ(TEST_L3, result_nodes[1].GetTopoNode()->LaneId());
+  EXPECT_EQ(TEST_L5, result_nodes[2].GetTopoNode()->LaneId());
+
+  // The buffers of the previous search are reused.
+  std::vector<NodeWithRange> repeated_result_nodes;
+  ASSERT_TRUE(strategy.Search(&topo_graph, &sub_graph, node_1, node_5,
+                              &repeated_result_nodes));
+  ASSERT_EQ(result_nodes.size(), repeated_result_nodes.size());
+  for (size_t i = 0; i < result_nodes.size(); ++i) {
+    EXPECT_EQ(result_nodes[i].GetTopoNode(),
+              repeated_result_nodes[i].GetTopoNode());
+  }
+
+  // There is no way back.
+  EXPECT_FALSE(
+      strategy.Search(&topo_graph, &sub_graph, node_5, node_1, &result_nodes));
+}
+
+TEST(AStarStrategyTestSuit, search_in_sub_graph) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  const TopoNode* node_1 = topo_graph.GetNode(TEST_L1);
+  const TopoNode* node_3 = topo_graph.GetNode(TEST_L3);
+  const TopoNode* node_5 = topo_graph.GetNode(TEST_L5);
+  ASSERT_TRUE(node_1 != nullptr);
+  ASSERT_TRUE(node_3 != nullptr);
+  ASSERT_TRUE(node_5 != nullptr);
+
+  // The route ends in a sub node of L5, which is indexed after the nodes of
+  // the graph.
+  std::unordered_map<const TopoNode*, std::vector<NodeSRange>> black_map;
+  black_map[node_5].push_back(NodeSRange(50.0, 60.0));
+  const SubTopoGraph sub_graph(black_map);
+  const TopoNode* sub_node_5 = sub_graph.GetSubNodeWithS(node_5, 10.0);
+  ASSERT_TRUE(sub_node_5 != nullptr);
+  ASSERT_TRUE(sub_node_5->IsSubNode());
+
+  AStarStrategy strategy(false);
+  std::vector<NodeWithRange> result_nodes;
+  ASSERT_TRUE(strategy.Search(&topo_graph, &sub_graph, node_1, sub_node_5,
+                              &result_nodes));
+  ASSERT_EQ(3, result_nodes.size());
+  EXPECT_EQ(node_3, result_nodes[1].GetTopoNode());
+  EXPECT_EQ(node_5, result_nodes[2].GetTopoNode());
+  EXPECT_DOUBLE_EQ(0.0, result_nodes[2].StartS());
+  EXPECT_DOUBLE_EQ(50.0, result_nodes[2].EndS());
+}
+
+}  // namespace routing
+}  // namespace apollo
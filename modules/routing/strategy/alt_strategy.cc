@@ -0,0 +1,31 @@
+/******************************************************************************
+  * Copyright 2017 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+#include "modules/routing/strategy/alt_strategy.h"
+
+namespace apollo {
+namespace routing {
+
+AltStrategy::AltStrategy(bool enable_change) : AStarStrategy(enable_change) {}
+
+double AltStrategy::HeuristicCost(const TopoGraph* graph,
+                                  const TopoNode* src_node,
+                                  const TopoNode* dest_node) {
+  return graph->LandmarkLowerBound(src_node, dest_node);
+}
+
+}  // namespace routing
+}  // namespace apollo
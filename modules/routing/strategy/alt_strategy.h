@@ -0,0 +1,42 @@
+/******************************************************************************
+  * Copyright 2017 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+#ifndef MODULES_ROUTING_STRATEGY_ALT_STRATEGY_H_
+#define MODULES_ROUTING_STRATEGY_ALT_STRATEGY_H_
+
+#include "modules/routing/strategy/a_star_strategy.h"
+
+namespace apollo {
+namespace routing {
+
+// The A* search with the landmark (ALT) heuristic: the cost to the
+// destination is bounded by the landmark distance tables of the graph, which
+// is much tighter than the anchor point distance on a large map. The graph
+// must have landmarks, see TopoGraph::HasLandmarks().
+class AltStrategy : public AStarStrategy {
+ public:
+  explicit AltStrategy(bool enable_change);
+  ~AltStrategy() = default;
+
+ protected:
+  double HeuristicCost(const TopoGraph* graph, const TopoNode* src_node,
+                       const TopoNode* dest_node) override;
+};
+
+}  // namespace routing
+}  // namespace apollo
+
+#endif  // MODULES_ROUTING_STRATEGY_ALT_STRATEGY_H_
@@ -0,0 +1,234 @@
+/******************************************************************************
+  * Copyright 2017 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+#include "modules/routing/strategy/alt_strategy.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "modules/routing/graph/sub_topo_graph.h"
+#include "modules/routing/graph/topo_graph.h"
+#include "modules/routing/graph/topo_test_utils.h"
+#include "modules/routing/strategy/a_star_strategy.h"
+#include "modules/routing/topo_creator/landmark_creator.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+// Two roads of a long and a short lane, by their costs, and a road of two
+// short lanes after them. A lane change from a long lane to a short one has
+// the negative cost 1 + (1 - 10) / 2.
+void GetLaneChangeGraph(Graph* graph) {
+  graph->set_hdmap_version(TEST_MAP_VERSION);
+  graph->set_hdmap_district(TEST_MAP_DISTRICT);
+  const std::vector<std::pair<std::string, double>> lanes = {
+      {TEST_L1, 10.0}, {TEST_L2, 1.0}, {TEST_L3, 10.0},
+      {TEST_L4, 1.0},  {TEST_L5, 1.0}, {TEST_L6, 1.0}};
+  const std::vector<std::string> roads = {TEST_R1, TEST_R1, TEST_R2,
+                                          TEST_R2, TEST_R3, TEST_R3};
+  for (size_t i = 0; i < lanes.size(); ++i) {
+    auto* node = graph->add_node();
+    GetNodeDetailForTest(node, lanes[i].first, roads[i]);
+    node->set_cost(lanes[i].second);
+  }
+  for (size_t i = 0; i < lanes.size(); i += 2) {
+    const std::string& left = lanes[i].first;
+    const std::string& right = lanes[i + 1].first;
+    GetEdgeForTest(graph->add_edge(), left, right, Edge::RIGHT);
+    GetEdgeForTest(graph->add_edge(), right, left, Edge::LEFT);
+    if (i + 2 < lanes.size()) {
+      GetEdgeForTest(graph->add_edge(), left, lanes[i + 2].first,
+                     Edge::FORWARD);
+      GetEdgeForTest(graph->add_edge(), right, lanes[i + 3].first,
+                     Edge::FORWARD);
+    }
+  }
+  for (auto& edge : *graph->mutable_edge()) {
+    edge.set_cost(edge.direction_type() == Edge::FORWARD ? 0.0 : 1.0);
+  }
+}
+
+// The routing costs of the A* search between all the nodes, by Bellman-Ford.
+std::vector<std::vector<double>> GetRoutingCosts(const Graph& graph) {
+  std::unordered_map<std::string, int> index;
+  for (int i = 0; i < graph.node_size(); ++i) {
+    index[graph.node(i).lane_id()] = i;
+  }
+  const double kInfinity = std::numeric_limits<double>::infinity();
+  std::vector<std::vector<double>> costs(
+      graph.node_size(), std::vector<double>(graph.node_size(), kInfinity));
+  for (int source = 0; source < graph.node_size(); ++source) {
+    auto& source_costs = costs[source];
+    source_costs[source] = 0.0;
+    for (int round = 0; round < graph.node_size(); ++round) {
+      for (const auto& edge : graph.edge()) {
+        const int from = index[edge.from_lane_id()];
+        const int to = index[edge.to_lane_id()];
+        double cost = edge.cost() + graph.node(to).cost();
+        if (edge.direction_type() != Edge::FORWARD) {
+          cost -= (graph.node(from).cost() + graph.node(to).cost()) / 2;
+        }
+        source_costs[to] =
+            std::min(source_costs[to], source_costs[from] + cost);
+      }
+    }
+  }
+  return costs;
+}
+
+void ExpectSameRoutes(const Graph& graph, const TopoGraph& topo_graph) {
+  const std::unordered_map<const TopoNode*, std::vector<NodeSRange>>
+      black_map;
+  const SubTopoGraph sub_graph(black_map);
+  AStarStrategy a_star_strategy(true);
+  AltStrategy alt_strategy(true);
+  for (const auto& src : graph.node()) {
+    for (const auto& dest : graph.node()) {
+      const TopoNode* src_node = topo_graph.GetNode(src.lane_id());
+      const TopoNode* dest_node = topo_graph.GetNode(dest.lane_id());
+      std::vector<NodeWithRange> expected_nodes;
+      std::vector<NodeWithRange> result_nodes;
+      const bool has_route = a_star_strategy.Search(
+          &topo_graph, &sub_graph, src_node, dest_node, &expected_nodes);
+      ASSERT_EQ(has_route,
+                alt_strategy.Search(&topo_graph, &sub_graph, src_node,
+                                    dest_node, &result_nodes))
+          << src.lane_id() << " -> " << dest.lane_id();
+      if (!has_route) {
+        continue;
+      }
+      ASSERT_EQ(expected_nodes.size(), result_nodes.size())
+          << src.lane_id() << " -> " << dest.lane_id();
+      for (size_t i = 0; i < expected_nodes.size(); ++i) {
+        EXPECT_EQ(expected_nodes[i].GetTopoNode(),
+                  result_nodes[i].GetTopoNode());
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(AltStrategyTestSuit, landmarks) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  LandmarkCreator::CreateLandmarks(3, &graph);
+  ASSERT_EQ(3, graph.landmark_size());
+  EXPECT_EQ(graph.node_size(), graph.landmark(0).distance_from_size());
+  EXPECT_EQ(graph.node_size(), graph.landmark(0).distance_to_size());
+
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+  ASSERT_TRUE(topo_graph.HasLandmarks());
+  const TopoNode* node_1 = topo_graph.GetNode(TEST_L1);
+  const TopoNode* node_5 = topo_graph.GetNode(TEST_L5);
+  ASSERT_TRUE(node_1 != nullptr);
+  ASSERT_TRUE(node_5 != nullptr);
+  EXPECT_DOUBLE_EQ(0.0, topo_graph.LandmarkLowerBound(node_1, node_1));
+  // The node potentials cancel out up to rounding.
+  EXPECT_LE(topo_graph.LandmarkLowerBound(node_1, node_5),
+            2 * TEST_LANE_COST + 2 * TEST_EDGE_COST + 1e-9);
+  // There is no way back.
+  EXPECT_EQ(std::numeric_limits<double>::infinity(),
+            topo_graph.LandmarkLowerBound(node_5, node_1));
+
+  // The tables must match the nodes.
+  graph.mutable_landmark(1)->mutable_distance_to()->RemoveLast();
+  EXPECT_FALSE(topo_graph.LoadGraph(graph));
+}
+
+TEST(AltStrategyTestSuit, search) {
+  Graph graph;
+  GetGraph3ForTest(&graph);
+  LandmarkCreator::CreateLandmarks(2, &graph);
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+
+  // The routes are the ones of the A* search.
+  const std::unordered_map<const TopoNode*, std::vector<NodeSRange>>
+      black_map;
+  const SubTopoGraph sub_graph(black_map);
+  AStarStrategy a_star_strategy(false);
+  AltStrategy alt_strategy(false);
+  for (const auto& src : graph.node()) {
+    for (const auto& dest : graph.node()) {
+      const TopoNode* src_node = topo_graph.GetNode(src.lane_id());
+      const TopoNode* dest_node = topo_graph.GetNode(dest.lane_id());
+      std::vector<NodeWithRange> expected_nodes;
+      std::vector<NodeWithRange> result_nodes;
+      const bool has_route = a_star_strategy.Search(
+          &topo_graph, &sub_graph, src_node, dest_node, &expected_nodes);
+      ASSERT_EQ(has_route,
+                alt_strategy.Search(&topo_graph, &sub_graph, src_node,
+                                    dest_node, &result_nodes))
+          << src.lane_id() << " -> " << dest.lane_id();
+      if (!has_route) {
+        continue;
+      }
+      ASSERT_EQ(expected_nodes.size(), result_nodes.size());
+      for (size_t i = 0; i < expected_nodes.size(); ++i) {
+        EXPECT_EQ(expected_nodes[i].GetTopoNode(),
+                  result_nodes[i].GetTopoNode());
+      }
+    }
+  }
+}
+
+TEST(AltStrategyTestSuit, negative_lane_change_cost) {
+  Graph graph;
+  GetLaneChangeGraph(&graph);
+  LandmarkCreator::CreateLandmarks(2, &graph);
+  ASSERT_EQ(2, graph.landmark_size());
+  TopoGraph topo_graph;
+  ASSERT_TRUE(topo_graph.LoadGraph(graph));
+
+  // The bounds never exceed the routing costs, negative or not.
+  const auto costs = GetRoutingCosts(graph);
+  for (int i = 0; i < graph.node_size(); ++i) {
+    for (int j = 0; j < graph.node_size(); ++j) {
+      const TopoNode* from_node = topo_graph.GetNode(graph.node(i).lane_id());
+      const TopoNode* to_node = topo_graph.GetNode(graph.node(j).lane_id());
+      EXPECT_LE(topo_graph.LandmarkLowerBound(from_node, to_node),
+                costs[i][j] + 1e-9)
+          << graph.node(i).lane_id() << " -> " << graph.node(j).lane_id();
+    }
+  }
+  // The cheapest route from L1 starts with the lane change to L2.
+  EXPECT_LT(costs[0][4], 0.0);
+  ExpectSameRoutes(graph, topo_graph);
+
+  // A negative forward edge cost stays negative when reweighted, so no
+  // landmarks are made.
+  for (auto& edge : *graph.mutable_edge()) {
+    if (edge.direction_type() == Edge::FORWARD) {
+      edge.set_cost(-20.0);
+      break;
+    }
+  }
+  LandmarkCreator::CreateLandmarks(2, &graph);
+  EXPECT_EQ(0, graph.landmark_size());
+}
+
+}  // namespace routing
+}  // namespace apollo
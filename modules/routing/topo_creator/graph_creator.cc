@@ -16,12 +16,16 @@
 
 #include "modules/routing/topo_creator/graph_creator.h"
 
+#include <vector>
+
 #include "glog/logging.h"
 
 #include "modules/common/util/file.h"
+#include "modules/common/util/parallel_for.h"
 #include "modules/map/hdmap/adapter/opendrive_adapter.h"
 #include "modules/routing/common/routing_gflags.h"
 #include "modules/routing/topo_creator/edge_creator.h"
+#include "modules/routing/topo_creator/landmark_creator.h"
 #include "modules/routing/topo_creator/node_creator.h"
 
 namespace apollo {
@@ -33,6 +37,7 @@ using apollo::hdmap::LaneBoundary;
 using apollo::hdmap::LaneBoundaryType;
 
 using apollo::common::util::EndWith;
+using apollo::common::util::ParallelFor;
 
 namespace {
 
@@ -88,6 +93,12 @@ bool GraphCreator::Create() {
 
   InitForbiddenLanes();
 
+  // The node indices are assigned in the order of the lanes, then the nodes
+  // and the edges of the lanes are created concurrently and merged in that
+  // order, so that the graph does not depend on the number of threads.
+  std::vector<const hdmap::Lane*> lanes;
+  std::vector<std::string> road_ids;
+  const int first_node_index = graph_.node_size();
   for (const auto& lane : pbmap_.lane()) {
     const auto& lane_id = lane.id().id();
     if (forbidden_lane_id_set_.find(lane_id) != forbidden_lane_id_set_.end()) {
@@ -96,40 +107,52 @@ bool GraphCreator::Create() {
       continue;
     }
     AINFO << "Current lane id: " << lane_id;
-    node_index_map_[lane_id] = graph_.node_size();
+    node_index_map_[lane_id] =
+        first_node_index + static_cast<int>(lanes.size());
+    lanes.push_back(&lane);
     const auto iter = road_id_map_.find(lane_id);
     if (iter != road_id_map_.end()) {
-      NodeCreator::GetPbNode(lane, iter->second, graph_.add_node(),
-                             routing_conf_);
+      road_ids.push_back(iter->second);
     } else {
       LOG(WARNING) << "Failed to find road id of lane " << lane_id;
-      NodeCreator::GetPbNode(lane, "", graph_.add_node(), routing_conf_);
+      road_ids.push_back("");
     }
   }
 
-  std::string edge_id = "";
-  for (const auto& lane : pbmap_.lane()) {
-    const auto& lane_id = lane.id().id();
-    if (forbidden_lane_id_set_.find(lane_id) != forbidden_lane_id_set_.end()) {
-      ADEBUG << "Ignored lane id: " << lane_id
-             << " because its type is NOT CITY_DRIVING.";
-      continue;
-    }
-    const auto& from_node = graph_.node(node_index_map_[lane_id]);
-
-    AddEdge(from_node, lane.successor_id(), Edge::FORWARD);
-    if (lane.length() < FLAGS_min_length_for_lane_change) {
-      continue;
-    }
-    if (lane.has_left_boundary() && IsAllowedToCross(lane.left_boundary())) {
-      AddEdge(from_node, lane.left_neighbor_forward_lane_id(), Edge::LEFT);
-    }
-
-    if (lane.has_right_boundary() && IsAllowedToCross(lane.right_boundary())) {
-      AddEdge(from_node, lane.right_neighbor_forward_lane_id(), Edge::RIGHT);
+  const int num_lanes = static_cast<int>(lanes.size());
+  graph_.mutable_node()->Reserve(first_node_index + num_lanes);
+  for (int i = 0; i < num_lanes; ++i) {
+    graph_.add_node();
+  }
+  ParallelFor(num_lanes, FLAGS_topo_creator_num_threads,
+              [this, &lanes, &road_ids, first_node_index](const int i) {
+                Node* node = graph_.mutable_node(first_node_index + i);
+                NodeCreator::GetPbNode(*lanes[i], road_ids[i], node,
+                                       routing_conf_);
+              });
+
+  // The edges of a lane listed twice start from its last node.
+  std::vector<std::vector<Edge>> lane_edges(lanes.size());
+  ParallelFor(num_lanes, FLAGS_topo_creator_num_threads,
+              [this, &lanes, &lane_edges](const int i) {
+                const auto& from_node =
+                    graph_.node(node_index_map_.at(lanes[i]->id().id()));
+                CreateLaneEdges(*lanes[i], from_node, &lane_edges[i]);
+              });
+
+  for (auto& edges : lane_edges) {
+    for (auto& edge : edges) {
+      const std::string edge_id =
+          GetEdgeID(edge.from_lane_id(), edge.to_lane_id());
+      if (!showed_edge_id_set_.insert(edge_id).second) {
+        continue;
+      }
+      graph_.add_edge()->Swap(&edge);
     }
   }
 
+  LandmarkCreator::CreateLandmarks(FLAGS_routing_num_landmarks, &graph_);
+
   if (!EndWith(dump_topo_file_path_, ".bin") &&
       !EndWith(dump_topo_file_path_, ".txt")) {
     AERROR << "Failed to dump topo data into file, incorrect file type "
@@ -157,26 +180,42 @@ std::string GraphCreator::GetEdgeID(const std::string& from_id,
   return from_id + "->" + to_id;
 }
 
+void GraphCreator::CreateLaneEdges(const hdmap::Lane& lane,
+                                   const Node& from_node,
+                                   std::vector<Edge>* edges) const {
+  AddEdge(from_node, lane.successor_id(), Edge::FORWARD, edges);
+  if (lane.length() < FLAGS_min_length_for_lane_change) {
+    return;
+  }
+  if (lane.has_left_boundary() && IsAllowedToCross(lane.left_boundary())) {
+    AddEdge(from_node, lane.left_neighbor_forward_lane_id(), Edge::LEFT,
+            edges);
+  }
+
+  if (lane.has_right_boundary() && IsAllowedToCross(lane.right_boundary())) {
+    AddEdge(from_node, lane.right_neighbor_forward_lane_id(), Edge::RIGHT,
+            edges);
+  }
+}
+
 void GraphCreator::AddEdge(const Node& from_node,
                            const RepeatedPtrField<Id>& to_node_vec,
-                           const Edge::DirectionType& type) {
+                           const Edge::DirectionType& type,
+                           std::vector<Edge>* edges) const {
+  // The edges are not deduplicated here but when they are merged in order.
   for (const auto& to_id : to_node_vec) {
     if (forbidden_lane_id_set_.find(to_id.id()) !=
         forbidden_lane_id_set_.end()) {
       ADEBUG << "Ignored lane [id = " << to_id.id();
       continue;
     }
-    const std::string edge_id = GetEdgeID(from_node.lane_id(), to_id.id());
-    if (showed_edge_id_set_.count(edge_id) != 0) {
-      continue;
-    }
-    showed_edge_id_set_.insert(edge_id);
     const auto& iter = node_index_map_.find(to_id.id());
     if (iter == node_index_map_.end()) {
       continue;
     }
     const auto& to_node = graph_.node(iter->second);
-    EdgeCreator::GetPbEdge(from_node, to_node, type, graph_.add_edge(),
+    edges->emplace_back();
+    EdgeCreator::GetPbEdge(from_node, to_node, type, &edges->back(),
                            routing_conf_);
   }
 }
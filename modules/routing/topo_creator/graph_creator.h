@@ -20,6 +20,7 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "modules/map/proto/map.pb.h"
 #include "modules/routing/proto/routing_config.pb.h"
@@ -42,10 +43,14 @@ class GraphCreator {
   void InitForbiddenLanes();
   std::string GetEdgeID(const std::string& from_id, const std::string& to_id);
 
+  // Creates the edges out of a lane, which only reads the nodes, so that the
+  // lanes are handled concurrently.
+  void CreateLaneEdges(const hdmap::Lane& lane, const Node& from_node,
+                       std::vector<Edge>* edges) const;
   void AddEdge(
       const Node& from_node,
       const ::google::protobuf::RepeatedPtrField<hdmap::Id>& to_node_vec,
-      const Edge::DirectionType& type);
+      const Edge::DirectionType& type, std::vector<Edge>* edges) const;
 
  private:
   std::string base_map_file_path_;
@@ -0,0 +1,177 @@
+/******************************************************************************
+  * Copyright 2017 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+#include "modules/routing/topo_creator/landmark_creator.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "modules/common/log.h"
+
+namespace apollo {
+namespace routing {
+
+namespace {
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+// The potential of a node for reweighting the edge costs, see
+// GetReweightedEdgeCost().
+double GetNodePotential(const Node& node) { return node.cost() / 2; }
+
+// The cost of an edge as the A* search adds it up, plus the potential of its
+// from node, minus the one of its to node. A lane change may have a negative
+// cost, edge.cost + (to.cost - from.cost) / 2, but the reweighted costs are
+// edge.cost for it and edge.cost + (from.cost + to.cost) / 2 for a forward
+// edge, so they can be searched by Dijkstra. The reweighting changes the cost
+// of every path by the potential of its source minus the one of its target,
+// so the shortest paths stay the same (Johnson's reweighting).
+double GetReweightedEdgeCost(const Node& from_node, const Node& to_node,
+                             const Edge& edge) {
+  double cost = edge.cost() + to_node.cost();
+  if (edge.direction_type() != Edge::FORWARD) {
+    cost -= (from_node.cost() + to_node.cost()) / 2;
+  }
+  return cost + GetNodePotential(from_node) - GetNodePotential(to_node);
+}
+
+void AddDistances(const std::vector<double>& distances,
+                  google::protobuf::RepeatedField<double>* const field) {
+  field->Reserve(distances.size());
+  for (const double distance : distances) {
+    field->Add(distance == kInfinity ? -1.0 : distance);
+  }
+}
+
+}  // namespace
+
+void LandmarkCreator::CreateLandmarks(const int num_landmarks,
+                                      Graph* const graph) {
+  graph->clear_landmark();
+  const int num_nodes = graph->node_size();
+  if (num_landmarks <= 0 || num_nodes == 0) {
+    return;
+  }
+  AdjacencyList out_arcs;
+  AdjacencyList in_arcs;
+  if (!GetAdjacencyLists(*graph, &out_arcs, &in_arcs)) {
+    AERROR << "The graph has negative costs, so no landmarks are created.";
+    return;
+  }
+
+  // The sum of the costs from and to the nearest landmark of every node. It
+  // starts from the distances to node 0, so the first landmark is far from
+  // it.
+  std::vector<double> nearest_landmark_distances;
+  GetDistances(out_arcs, 0, &nearest_landmark_distances);
+  std::vector<double> distances_from;
+  std::vector<double> distances_to;
+  std::vector<bool> is_landmark(num_nodes, false);
+  for (int i = 0; i < std::min(num_landmarks, num_nodes); ++i) {
+    int landmark = -1;
+    for (int node = 0; node < num_nodes; ++node) {
+      if (!is_landmark[node] &&
+          (landmark < 0 || nearest_landmark_distances[node] >
+                               nearest_landmark_distances[landmark])) {
+        landmark = node;
+      }
+    }
+    is_landmark[landmark] = true;
+    GetDistances(out_arcs, landmark, &distances_from);
+    GetDistances(in_arcs, landmark, &distances_to);
+    auto* pb_landmark = graph->add_landmark();
+    pb_landmark->set_lane_id(graph->node(landmark).lane_id());
+    AddDistances(distances_from, pb_landmark->mutable_distance_from());
+    AddDistances(distances_to, pb_landmark->mutable_distance_to());
+
+    for (int node = 0; node < num_nodes; ++node) {
+      const double distance = distances_from[node] + distances_to[node];
+      nearest_landmark_distances[node] =
+          i == 0 ? distance
+                 : std::min(nearest_landmark_distances[node], distance);
+    }
+  }
+  AINFO << "Created " << graph->landmark_size() << " landmarks for "
+        << num_nodes << " nodes.";
+}
+
+bool LandmarkCreator::GetAdjacencyLists(const Graph& graph,
+                                        AdjacencyList* const out_arcs,
+                                        AdjacencyList* const in_arcs) {
+  std::unordered_map<std::string, int> node_index_map;
+  for (int i = 0; i < graph.node_size(); ++i) {
+    node_index_map[graph.node(i).lane_id()] = i;
+  }
+  out_arcs->assign(graph.node_size(), std::vector<Arc>());
+  in_arcs->assign(graph.node_size(), std::vector<Arc>());
+  for (const auto& edge : graph.edge()) {
+    const auto from_iter = node_index_map.find(edge.from_lane_id());
+    const auto to_iter = node_index_map.find(edge.to_lane_id());
+    if (from_iter == node_index_map.end() || to_iter == node_index_map.end()) {
+      AWARN << "Ignored the edge " << edge.from_lane_id() << " -> "
+            << edge.to_lane_id() << " of unknown lanes.";
+      continue;
+    }
+    const int from = from_iter->second;
+    const int to = to_iter->second;
+    const double cost =
+        GetReweightedEdgeCost(graph.node(from), graph.node(to), edge);
+    if (cost < 0.0) {
+      AERROR << "The edge " << edge.from_lane_id() << " -> "
+             << edge.to_lane_id() << " has the reweighted cost " << cost
+             << ".";
+      return false;
+    }
+    (*out_arcs)[from].push_back({to, cost});
+    (*in_arcs)[to].push_back({from, cost});
+  }
+  return true;
+}
+
+void LandmarkCreator::GetDistances(const AdjacencyList& arcs,
+                                   const int source,
+                                   std::vector<double>* const distances) {
+  distances->assign(arcs.size(), kInfinity);
+  using QueueItem = std::pair<double, int>;
+  std::priority_queue<QueueItem, std::vector<QueueItem>,
+                      std::greater<QueueItem>>
+      queue;
+  (*distances)[source] = 0.0;
+  queue.emplace(0.0, source);
+  while (!queue.empty()) {
+    const QueueItem item = queue.top();
+    queue.pop();
+    const int node = item.second;
+    if (item.first > (*distances)[node]) {
+      continue;
+    }
+    for (const auto& arc : arcs[node]) {
+      const double distance = item.first + arc.cost;
+      if (distance < (*distances)[arc.to]) {
+        (*distances)[arc.to] = distance;
+        queue.emplace(distance, arc.to);
+      }
+    }
+  }
+}
+
+}  // namespace routing
+}  // namespace apollo
@@ -0,0 +1,60 @@
+/******************************************************************************
+  * Copyright 2017 The Apollo Authors. All Rights Reserved.
+  *
+  * Licensed under the Apache License, Version 2.0 (the "License");
+  * you may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at
+  *
+  * http://www.apache.org/licenses/LICENSE-2.0
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *****************************************************************************/
+
+#ifndef MODULES_ROUTING_TOPO_CREATOR_LANDMARK_CREATOR_H
+#define MODULES_ROUTING_TOPO_CREATOR_LANDMARK_CREATOR_H
+
+#include <vector>
+
+#include "modules/routing/proto/topo_graph.pb.h"
+
+namespace apollo {
+namespace routing {
+
+// Picks landmark nodes of a topo graph and adds their distance tables to it,
+// so the routing search can bound the cost to its destination by the
+// triangle inequality (the ALT heuristic).
+class LandmarkCreator {
+ public:
+  // Replaces the landmarks of the graph with num_landmarks new ones, or with
+  // as many as the graph has nodes. The landmarks are picked one by one, each
+  // the node farthest from the ones picked before. The distances of the
+  // tables are the costs of the A* search reweighted by the node potentials
+  // node.cost / 2, which makes the ones of the lane changes non negative. A
+  // graph with negative node or edge costs gets no landmarks.
+  static void CreateLandmarks(const int num_landmarks, Graph* const graph);
+
+ private:
+  struct Arc {
+    int to;
+    double cost;
+  };
+  using AdjacencyList = std::vector<std::vector<Arc>>;
+
+  // The arcs with the reweighted edge costs; false if one is still negative,
+  // which only negative node or edge costs can make.
+  static bool GetAdjacencyLists(const Graph& graph,
+                                AdjacencyList* const out_arcs,
+                                AdjacencyList* const in_arcs);
+  // The costs from the source to all the nodes, infinite if unreachable.
+  static void GetDistances(const AdjacencyList& arcs, const int source,
+                           std::vector<double>* const distances);
+};
+
+}  // namespace routing
+}  // namespace apollo
+
+#endif  // MODULES_ROUTING_TOPO_CREATOR_LANDMARK_CREATOR_H
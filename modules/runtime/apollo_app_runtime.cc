@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include "modules/runtime/apollo_app_runtime.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "gflags/gflags.h"
+#include "modules/common/adapters/adapter_manager.h"
+#include "modules/common/adapters/component_context.h"
+#include "modules/common/log.h"
+#include "modules/common/scheduling/scheduler.h"
+
+namespace apollo {
+namespace runtime {
+
+using apollo::common::adapter::AdapterManager;
+using apollo::common::adapter::ScopedComponent;
+using apollo::common::adapter::kMaxComponents;
+
+bool ApolloAppRuntime::Init(const RuntimeConfig &config) {
+  if (config.component_size() > kMaxComponents) {
+    AERROR << "At most " << kMaxComponents << " apps can run in a process, "
+           << config.component_size() << " are configured.";
+    return false;
+  }
+  receive_thread_num_ = std::max(config.receive_thread_num(), 1u);
+  if (!FLAGS_scheduling_config_file.empty()) {
+    common::scheduling::Scheduler::instance()->Init(
+        FLAGS_scheduling_config_file);
+  }
+  AdapterManager::EnableIntraProcess();
+  for (int i = 0; i < config.component_size(); ++i) {
+    Component component;
+    if (!InitComponent(i, config.component(i), &component)) {
+      return false;
+    }
+    components_.push_back(std::move(component));
+  }
+  if (!FLAGS_scheduling_config_file.empty()) {
+    AINFO << "Runtime scheduling:\n"
+          << common::scheduling::Scheduler::instance()->Report();
+  }
+  return true;
+}
+
+bool ApolloAppRuntime::InitComponent(int index, const ComponentConfig &config,
+                                     Component *component) {
+  for (const auto &flagfile : config.flagfile()) {
+    if (!gflags::ReadFromFlagsFile(flagfile, config.name().c_str(), false)) {
+      AERROR << "Cannot read the flag file " << flagfile << " of "
+             << config.name();
+      return false;
+    }
+  }
+  component->app = factory_.CreateObject(config.name());
+  if (!component->app) {
+    return false;
+  }
+
+  // The callbacks and the timers registered during the initialization go to
+  // the queue of the app, and run with the app as the current component.
+  component->callback_queue.reset(new ros::CallbackQueue());
+  ScopedComponent scoped_component(index);
+  AdapterManager::SetComponentCallbackQueue(component->callback_queue.get());
+  common::ApolloApp *app = component->app.get();
+  const bool started = StartApp(app);
+  AdapterManager::SetComponentCallbackQueue(nullptr);
+  if (!started) {
+    return false;
+  }
+  app->ExportFlags();
+  component->callback_thread_num = config.has_callback_thread_num()
+                                       ? config.callback_thread_num()
+                                       : app->callback_thread_num_;
+  component->callback_thread_num = std::max(component->callback_thread_num, 1u);
+  AINFO << app->Name() << " started as component " << index << " with "
+        << component->callback_thread_num << " callback threads.";
+  return true;
+}
+
+bool ApolloAppRuntime::StartApp(common::ApolloApp *app) {
+  auto status = app->Init();
+  if (!status.ok()) {
+    AERROR << app->Name() << " Init failed: " << status;
+    return false;
+  }
+  status = app->Start();
+  if (!status.ok()) {
+    AERROR << app->Name() << " Start failed: " << status;
+    return false;
+  }
+  return true;
+}
+
+int ApolloAppRuntime::Spin() {
+  // The global queue receives the messages of the external publishers, the
+  // queue of each app runs its callbacks and timers.
+  std::vector<std::unique_ptr<ros::AsyncSpinner>> spinners;
+  spinners.emplace_back(new ros::AsyncSpinner(receive_thread_num_));
+  for (auto &component : components_) {
+    spinners.emplace_back(new ros::AsyncSpinner(
+        component.callback_thread_num, component.callback_queue.get()));
+  }
+  for (auto &spinner : spinners) {
+    spinner->start();
+  }
+  ros::waitForShutdown();
+  for (auto &spinner : spinners) {
+    spinner->stop();
+  }
+  for (int i = static_cast<int>(components_.size()) - 1; i >= 0; --i) {
+    ScopedComponent scoped_component(i);
+    components_[i].app->Stop();
+    AINFO << components_[i].app->Name() << " exited.";
+  }
+  return 0;
+}
+
+}  // namespace runtime
+}  // namespace apollo
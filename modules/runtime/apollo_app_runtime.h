@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+/**
+ * @file
+ */
+
+#ifndef MODULES_RUNTIME_APOLLO_APP_RUNTIME_H_
+#define MODULES_RUNTIME_APOLLO_APP_RUNTIME_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/common/apollo_app.h"
+#include "modules/common/util/factory.h"
+#include "modules/runtime/proto/runtime_config.pb.h"
+
+#include "ros/include/ros/callback_queue.h"
+
+/**
+ * @namespace apollo::runtime
+ * @brief apollo::runtime
+ */
+namespace apollo {
+namespace runtime {
+
+/**
+ * @class ApolloAppRuntime
+ *
+ * @brief Runs several Apollo apps in one process. The messages between them
+ * are passed by pointer instead of being serialized, and each app keeps its
+ * own callback queue, threads and adapter observations, as if it ran alone.
+ */
+class ApolloAppRuntime {
+ public:
+  /**
+   * @brief Registers an app, so that the runtime config can name it.
+   */
+  template <typename App>
+  void RegisterApp(const std::string &name) {
+    CHECK(factory_.Register(
+        name, []() -> common::ApolloApp * { return new App(); }))
+        << "App " << name << " is registered twice.";
+  }
+
+  /**
+   * @brief Creates, initializes and starts the apps of the config in order.
+   * The flag files of an app are read right before it is initialized, so the
+   * flags read during the initialization are the ones of the app.
+   * @return false if an app is unknown or fails to start.
+   */
+  bool Init(const RuntimeConfig &config);
+
+  /**
+   * @brief Runs the apps until ROS has shutdown, then stops them in the
+   * reverse order.
+   */
+  int Spin();
+
+ private:
+  struct Component {
+    std::unique_ptr<common::ApolloApp> app;
+    std::unique_ptr<ros::CallbackQueue> callback_queue;
+    uint32_t callback_thread_num = 1;
+  };
+
+  bool InitComponent(int index, const ComponentConfig &config,
+                     Component *component);
+
+  bool StartApp(common::ApolloApp *app);
+
+  common::util::Factory<std::string, common::ApolloApp> factory_;
+  std::vector<Component> components_;
+  uint32_t receive_thread_num_ = 1;
+};
+
+}  // namespace runtime
+}  // namespace apollo
+
+#endif  // MODULES_RUNTIME_APOLLO_APP_RUNTIME_H_
@@ -0,0 +1,64 @@
+/******************************************************************************
+ * Copyright 2017 The Apollo Authors. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *****************************************************************************/
+
+
+#include <csignal>
+
+#include "gflags/gflags.h"
+#include "modules/common/apollo_app.h"
+#include "modules/common/async_logger.h"
+#include "modules/common/log.h"
+#include "modules/common/util/file.h"
+#include "ros/include/ros/ros.h"
+
+#include "modules/canbus/canbus.h"
+#include "modules/control/control.h"
+#include "modules/perception/perception.h"
+#include "modules/planning/planning.h"
+#include "modules/prediction/prediction.h"
+#include "modules/runtime/apollo_app_runtime.h"
+
+DEFINE_string(runtime_config_file,
+              "modules/runtime/conf/runtime_config.pb.txt",
+              "The apps to run in the process, as a RuntimeConfig.");
+
+int main(int argc, char **argv) {
+  google::InitGoogleLogging(argv[0]);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+  if (FLAGS_log_async) {
+    apollo::common::AsyncLogger::Install(
+        static_cast<size_t>(FLAGS_log_async_buffer_mb) * 1024 * 1024);
+  }
+  signal(SIGINT, apollo::common::apollo_app_sigint_handler);
+
+  apollo::runtime::RuntimeConfig config;
+  CHECK(apollo::common::util::GetProtoFromFile(FLAGS_runtime_config_file,
+                                               &config))
+      << "Cannot load the runtime config " << FLAGS_runtime_config_file;
+
+  apollo::runtime::ApolloAppRuntime runtime;
+  runtime.RegisterApp<apollo::perception::Perception>("perception");
+  runtime.RegisterApp<apollo::prediction::Prediction>("prediction");
+  runtime.RegisterApp<apollo::planning::Planning>("planning");
+  runtime.RegisterApp<apollo::control::Control>("control");
+  runtime.RegisterApp<apollo::canbus::Canbus>("canbus");
+
+  ros::init(argc, argv, "apollo_runtime");
+  if (!runtime.Init(config)) {
+    return -1;
+  }
+  return runtime.Spin();
+}
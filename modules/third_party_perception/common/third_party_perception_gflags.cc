@@ -26,6 +26,9 @@ DEFINE_string(adapter_config_filename, "", "Path for adapter configuration");
 
 DEFINE_double(third_party_perception_freq, 100,
               "third party perception timer frequency.");
+DEFINE_bool(third_party_perception_event_driven, true,
+            "publish the obstacles on every mobileye and radar message "
+            "instead of on the timer.");
 DEFINE_bool(enable_mobileye, true, "switch to turn on/off mobileye obstacles");
 DEFINE_bool(enable_delphi_esr, true,
             "switch to turn on/off delphi_esr obstacles");
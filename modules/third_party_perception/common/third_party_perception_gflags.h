@@ -26,6 +26,7 @@ DECLARE_string(module_name);
 DECLARE_string(adapter_config_filename);
 
 DECLARE_double(third_party_perception_freq);
+DECLARE_bool(third_party_perception_event_driven);
 DECLARE_bool(enable_mobileye);
 DECLARE_bool(enable_delphi_esr);
 
@@ -20,6 +20,9 @@
 
 #include "modules/third_party_perception/fusion.h"
 
+#include <algorithm>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "modules/common/math/polygon2d.h"
@@ -35,57 +38,91 @@ namespace apollo {
 namespace third_party_perception {
 namespace fusion {
 
+using apollo::common::math::Polygon2d;
 using apollo::common::math::Vec2d;
 using apollo::perception::PerceptionObstacles;
 using apollo::perception::PerceptionObstacle;
 
-std::vector<Vec2d> PerceptionObstacleToVectorVec2d(
+namespace {
+
+// The polygon of an obstacle, or none for an obstacle of less than three
+// points, which overlaps nothing.
+std::unique_ptr<Polygon2d> PerceptionObstacleToPolygon2d(
     const PerceptionObstacle& obstacle) {
-  std::vector<Vec2d> result;
+  if (obstacle.polygon_point_size() < 3) {
+    return nullptr;
+  }
+  std::vector<Vec2d> points;
+  points.reserve(obstacle.polygon_point_size());
   for (const auto& vertex : obstacle.polygon_point()) {
-    result.emplace_back(vertex.x(), vertex.y());
+    points.emplace_back(vertex.x(), vertex.y());
   }
-  return result;
+  return std::unique_ptr<Polygon2d>(new Polygon2d(std::move(points)));
 }
 
-bool HasOverlap(const PerceptionObstacle& obstacle_1,
-                const PerceptionObstacle& obstacle_2) {
-  common::math::Polygon2d polygon_1(
-      PerceptionObstacleToVectorVec2d(obstacle_1));
-  common::math::Polygon2d polygon_2(
-      PerceptionObstacleToVectorVec2d(obstacle_2));
-  return polygon_1.HasOverlap(polygon_2);
-}
-
-bool HasOverlap(const PerceptionObstacle& obstacle,
-                const PerceptionObstacles& obstacles) {
-  for (const auto& current_obstacle : obstacles.perception_obstacle()) {
-    if (HasOverlap(obstacle, current_obstacle)) {
-      return true;
-    }
-  }
-  return false;
-}
+}  // namespace
 
 PerceptionObstacles MobileyeRadarFusion(
     const PerceptionObstacles& mobileye_obstacles,
     const PerceptionObstacles& radar_obstacles) {
-  PerceptionObstacles mobileye_obstacles_fusion = mobileye_obstacles;
-  PerceptionObstacles radar_obstacles_fusion = radar_obstacles;
+  PerceptionObstacles obstacles_fusion;
+  MobileyeRadarFusion(mobileye_obstacles, radar_obstacles, &obstacles_fusion);
+  return obstacles_fusion;
+}
 
-  for (auto& mobileye_obstacle :
-       *(mobileye_obstacles_fusion.mutable_perception_obstacle())) {
-    for (auto& radar_obstacle :
-         *(radar_obstacles_fusion.mutable_perception_obstacle())) {
-      if (HasOverlap(mobileye_obstacle, radar_obstacle)) {
-        mobileye_obstacle.set_confidence(0.99);
-        radar_obstacle.set_confidence(0.99);
-      }
+void MobileyeRadarFusion(const PerceptionObstacles& mobileye_obstacles,
+                         const PerceptionObstacles& radar_obstacles,
+                         PerceptionObstacles* obstacles_fusion) {
+  // CopyFrom and MergeFrom reuse the obstacles allocated in the previous
+  // fusion.
+  obstacles_fusion->CopyFrom(mobileye_obstacles);
+  obstacles_fusion->MergeFrom(radar_obstacles);
+  const int mobileye_size = mobileye_obstacles.perception_obstacle_size();
+  const int radar_size = radar_obstacles.perception_obstacle_size();
+  if (mobileye_size == 0 || radar_size == 0) {
+    return;
+  }
+
+  // The radar polygons sorted by their lowest x, so that only the ones whose
+  // bounding boxes may overlap along x are compared with a mobileye polygon.
+  std::vector<std::unique_ptr<Polygon2d>> radar_polygons;
+  radar_polygons.reserve(radar_size);
+  double max_radar_length = 0.0;
+  for (const auto& radar_obstacle : radar_obstacles.perception_obstacle()) {
+    radar_polygons.push_back(PerceptionObstacleToPolygon2d(radar_obstacle));
+    const auto& polygon = radar_polygons.back();
+    if (polygon != nullptr) {
+      max_radar_length =
+          std::max(max_radar_length, polygon->max_x() - polygon->min_x());
+    }
+  }
+  std::vector<std::pair<double, int>> radar_min_x;
+  radar_min_x.reserve(radar_size);
+  for (int i = 0; i < radar_size; ++i) {
+    if (radar_polygons[i] != nullptr) {
+      radar_min_x.emplace_back(radar_polygons[i]->min_x(), i);
     }
   }
+  std::sort(radar_min_x.begin(), radar_min_x.end());
 
-  mobileye_obstacles_fusion.MergeFrom(radar_obstacles_fusion);
-  return mobileye_obstacles_fusion;
+  auto* fused = obstacles_fusion->mutable_perception_obstacle();
+  for (int i = 0; i < mobileye_size; ++i) {
+    const auto mobileye_polygon = PerceptionObstacleToPolygon2d(
+        mobileye_obstacles.perception_obstacle(i));
+    if (mobileye_polygon == nullptr) {
+      continue;
+    }
+    auto it = std::lower_bound(
+        radar_min_x.begin(), radar_min_x.end(),
+        std::make_pair(mobileye_polygon->min_x() - max_radar_length, -1));
+    for (; it != radar_min_x.end() && it->first <= mobileye_polygon->max_x();
+         ++it) {
+      if (mobileye_polygon->HasOverlap(*radar_polygons[it->second])) {
+        fused->Mutable(i)->set_confidence(0.99);
+        fused->Mutable(mobileye_size + it->second)->set_confidence(0.99);
+      }
+    }
+  }
 }
 
 }  // namespace fusion
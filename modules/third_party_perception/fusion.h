@@ -35,6 +35,17 @@ apollo::perception::PerceptionObstacles MobileyeRadarFusion(
     const apollo::perception::PerceptionObstacles& mobileye_obstacles,
     const apollo::perception::PerceptionObstacles& radar_obstacles);
 
+/**
+ * @brief Fuses the mobileye and the radar obstacles into obstacles_fusion,
+ * reusing the obstacles it holds. A mobileye and a radar obstacle which
+ * overlap both get a high confidence. Only the pairs whose bounding boxes
+ * overlap along x are compared.
+ */
+void MobileyeRadarFusion(
+    const apollo::perception::PerceptionObstacles& mobileye_obstacles,
+    const apollo::perception::PerceptionObstacles& radar_obstacles,
+    apollo::perception::PerceptionObstacles* obstacles_fusion);
+
 }  // namespace fusion
 }  // namespace third_party_perception
 }  // namespace apollo
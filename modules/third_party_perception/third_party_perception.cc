@@ -60,6 +60,10 @@ Status ThirdPartyPerception::Init() {
 }
 
 Status ThirdPartyPerception::Start() {
+  if (FLAGS_third_party_perception_event_driven) {
+    // the obstacles are published from the sensor callbacks
+    return Status::OK();
+  }
   const double duration = 1.0 / FLAGS_third_party_perception_freq;
   timer_ = AdapterManager::CreateTimer(ros::Duration(duration),
                                        &ThirdPartyPerception::OnTimer, this);
@@ -76,12 +80,16 @@ void ThirdPartyPerception::OnMobileye(const Mobileye& message) {
     mobileye_obstacles_ =
         conversion::MobileyeToPerceptionObstacles(message, localization_);
   }
+  if (FLAGS_third_party_perception_event_driven) {
+    PublishObstacles();
+  }
 }
 
 void ThirdPartyPerception::OnDelphiESR(const DelphiESR& message) {
   AINFO << "Received delphi esr data: run delphi esr callback.";
   std::lock_guard<std::mutex> lock(third_party_perception_mutex_);
-  last_radar_obstacles_.CopyFrom(current_radar_obstacles_);
+  // current_radar_obstacles_ is overwritten below
+  last_radar_obstacles_.Swap(&current_radar_obstacles_);
   current_radar_obstacles_ = conversion::DelphiToRadarObstacles(
       message, localization_, last_radar_obstacles_);
   RadarObstacles filtered_radar_obstacles =
@@ -90,6 +98,9 @@ void ThirdPartyPerception::OnDelphiESR(const DelphiESR& message) {
     delphi_esr_obstacles_ = conversion::RadarObstaclesToPerceptionObstacles(
         filtered_radar_obstacles);
   }
+  if (FLAGS_third_party_perception_event_driven) {
+    PublishObstacles();
+  }
 }
 
 void ThirdPartyPerception::OnLocalization(const LocalizationEstimate& message) {
@@ -102,13 +113,18 @@ void ThirdPartyPerception::OnTimer(const ros::TimerEvent&) {
   AINFO << "Timer is triggered: publish PerceptionObstacles";
 
   std::lock_guard<std::mutex> lock(third_party_perception_mutex_);
+  PublishObstacles();
+}
 
-  PerceptionObstacles obstacles =
-      fusion::MobileyeRadarFusion(mobileye_obstacles_, delphi_esr_obstacles_);
+void ThirdPartyPerception::PublishObstacles() {
+  fusion::MobileyeRadarFusion(mobileye_obstacles_, delphi_esr_obstacles_,
+                              &fused_obstacles_);
 
-  AdapterManager::FillPerceptionObstaclesHeader(FLAGS_node_name, &obstacles);
-  AdapterManager::PublishPerceptionObstacles(obstacles);
+  AdapterManager::FillPerceptionObstaclesHeader(FLAGS_node_name,
+                                                &fused_obstacles_);
+  AdapterManager::PublishPerceptionObstacles(fused_obstacles_);
 
+  // the obstacles are kept cleared for the next conversion to reuse them
   mobileye_obstacles_.Clear();
   delphi_esr_obstacles_.Clear();
 }
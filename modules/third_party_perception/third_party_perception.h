@@ -59,11 +59,17 @@ class ThirdPartyPerception : public apollo::common::ApolloApp {
       const apollo::localization::LocalizationEstimate& message);
   // publish perception obstacles when timer is triggered
   void OnTimer(const ros::TimerEvent&);
+  // Fuses and publishes the obstacles received since the last publication,
+  // called with third_party_perception_mutex_ held. Runs on the timer, or
+  // on every sensor message if third_party_perception_event_driven is set.
+  void PublishObstacles();
 
   ros::Timer timer_;
   std::mutex third_party_perception_mutex_;
   apollo::perception::PerceptionObstacles mobileye_obstacles_;
   apollo::perception::PerceptionObstacles delphi_esr_obstacles_;
+  // the obstacles published last, reused by the next fusion
+  apollo::perception::PerceptionObstacles fused_obstacles_;
   apollo::localization::LocalizationEstimate localization_;
   RadarObstacles current_radar_obstacles_;
   RadarObstacles last_radar_obstacles_;
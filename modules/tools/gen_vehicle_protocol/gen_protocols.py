@@ -131,24 +131,19 @@ def gen_report_value_offset_precision(var, p):
 
 def gen_parse_value_impl(var, byte_info):
     """
-        doc string:
+        doc string: every byte of the signal is extracted with
+        Byte::get_bits, whose shift and mask are compile time constants
     """
-    impl = ""
-    fmt = "\n  Byte t%d(bytes + %d);\n"
-    shift_bit = 0
+    impl = "\n"
+    fmt = "Byte::get_bits<%d, %d>(bytes[%d])"
     for i in range(0, len(byte_info)):
         info = byte_info[i]
-        impl = impl + fmt % (i, info["byte"])
+        get_bits = fmt % (info["start_bit"], info["len"], info["byte"])
         if i == 0:
-            impl = impl + "  int32_t x = t%d.get_byte(%d, %d);\n" %\
-                      (i, info["start_bit"], info["len"])
-        elif i == 1:
-            impl = impl + "  int32_t t = t%d.get_byte(%d, %d);\n  x <<= %d;\n  x |= t;\n" %\
-                      (i, info["start_bit"], info["len"], info["len"])
+            impl = impl + "  int32_t x = %s;\n" % get_bits
         else:
-            impl = impl + "  t = t%d.get_byte(%d, %d);\n  x <<= %d;\n  x |= t;\n" %\
-                      (i, info["start_bit"], info["len"], info["len"])
-        shift_bit = shift_bit + info["len"]
+            impl = impl + "  x <<= %d;\n  x |= %s;\n" % (info["len"],
+                                                          get_bits)
     return impl
 
 
@@ -19,13 +19,15 @@
 
 #include "glog/logging.h"
 
-#include "modules/canbus/common/byte.h"
-#include "modules/canbus/common/canbus_consts.h"
+#include "modules/drivers/canbus/common/byte.h"
+#include "modules/drivers/canbus/common/canbus_consts.h"
 
 namespace apollo {
 namespace canbus {
 namespace %(car_type_lower)s {
 
+using ::apollo::drivers::canbus::Byte;
+
 %(classname)s::%(classname)s() {}
 const int32_t %(classname)s::ID = 0x%(id_upper)s;
 
@@ -56,12 +56,25 @@ function compare_poses() {
     --compare_file "compare_fusion_odometry.txt"
 }
 
+# the bags are exported concurrently, at most EXPORT_JOBS at a time
+EXPORT_JOBS=${EXPORT_JOBS:-2}
+
 cd $IN_FOLDER
+DIR_NAMES=()
 for item in $(ls -l *.bag | awk '{print $9}')
 do
   DIR_NAME=$(echo $item | cut -d . -f 1)
   mkdir $DIR_NAME
-  data_exporter "${item}" "${DIR_NAME}"
+  DIR_NAMES+=("${DIR_NAME}")
+  while [ $(jobs -rp | wc -l) -ge ${EXPORT_JOBS} ]; do
+    wait -n
+  done
+  data_exporter "${item}" "${DIR_NAME}" &
+done
+wait
+
+for DIR_NAME in "${DIR_NAMES[@]}"
+do
   compare_poses "${DIR_NAME}/pcd"
 done
 